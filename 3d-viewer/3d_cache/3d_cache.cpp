@@ -24,11 +24,18 @@
 
 #define GLM_FORCE_RADIANS
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <fstream>
 #include <utility>
 #include <iterator>
+#include <set>
+#include <stdint.h>
+#include <vector>
 
 #include <wx/datetime.h>
 #include <wx/filename.h>
@@ -49,10 +56,13 @@
 #include "common.h"
 #include "3d_cache.h"
 #include "3d_info.h"
+#include "3d_model_lod.h"
 #include "sg/scenegraph.h"
 #include "filename_resolver.h"
 #include "3d_plugin_manager.h"
 #include "plugins/3dapi/ifsg_api.h"
+#include "streamwrapper.h"
+#include "thread_pool.h"
 
 
 #define MASK_3D_CACHE "3D_CACHE"
@@ -131,11 +141,15 @@ public:
     void SetSHA1( const unsigned char* aSHA1Sum );
     const wxString GetCacheBaseName( void );
 
+    // destroys the levels of detail of the render data
+    void ClearLODs( void );
+
     wxDateTime    modTime;      // file modification time
     unsigned char sha1sum[20];
     std::string   pluginInfo;   // PluginName:Version string
     SCENEGRAPH*   sceneData;
     S3DMODEL*     renderData;
+    std::vector<S3DMODEL*> lodData;     // levels of detail, empty until they are built
 };
 
 
@@ -154,6 +168,20 @@ S3D_CACHE_ENTRY::~S3D_CACHE_ENTRY()
 
     if( NULL != renderData )
         S3D::Destroy3DModel( &renderData );
+
+    ClearLODs();
+}
+
+
+void S3D_CACHE_ENTRY::ClearLODs( void )
+{
+    for( S3DMODEL*& lod : lodData )
+    {
+        if( NULL != lod )
+            S3D::Destroy3DModel( &lod );
+    }
+
+    lodData.clear();
 }
 
 
@@ -168,6 +196,7 @@ void S3D_CACHE_ENTRY::SetSHA1( const unsigned char* aSHA1Sum )
     }
 
     memcpy( sha1sum, aSHA1Sum, 20 );
+    m_CacheBaseName.clear();
     return;
 }
 
@@ -205,7 +234,8 @@ S3D_CACHE::~S3D_CACHE()
 }
 
 
-SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCachePtr )
+SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCachePtr,
+                             bool aRenderDataOnly )
 {
     if( aCachePtr )
         *aCachePtr = NULL;
@@ -258,10 +288,21 @@ SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCach
                 if( NULL != mi->second->renderData )
                     S3D::Destroy3DModel( &mi->second->renderData );
 
+                mi->second->ClearLODs();
+
                 mi->second->sceneData = m_Plugins->Load3DModel( full3Dpath, mi->second->pluginInfo );
             }
         }
 
+        // only the render data was loaded from the mesh cache; load the scene data now
+        if( !aRenderDataOnly && NULL == mi->second->sceneData
+            && NULL != mi->second->renderData )
+        {
+            if( !loadCacheData( mi->second ) )
+                mi->second->sceneData = m_Plugins->Load3DModel( full3Dpath,
+                                                                mi->second->pluginInfo );
+        }
+
         if( NULL != aCachePtr )
             *aCachePtr = mi->second;
 
@@ -269,7 +310,7 @@ SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCach
     }
 
     // a cache item does not exist; search the Filename->Cachename map
-    return checkCache( full3Dpath, aCachePtr );
+    return checkCache( full3Dpath, aCachePtr, aRenderDataOnly );
 }
 
 
@@ -279,75 +320,78 @@ SCENEGRAPH* S3D_CACHE::Load( const wxString& aModelFile )
 }
 
 
-SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr )
+SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr,
+                                   bool aRenderDataOnly )
 {
     if( aCachePtr )
         *aCachePtr = NULL;
 
-    unsigned char sha1sum[20];
+    S3D_CACHE_ENTRY* ep = loadEntry( aFileName, aRenderDataOnly );
 
-    if( !getSHA1( aFileName, sha1sum ) || m_CacheDir.empty() )
+    if( !addEntry( aFileName, ep ) )
     {
-        // just in case we can't get a hash digest (for example, on access issues)
-        // or we do not have a configured cache file directory, we create an
-        // entry to prevent further attempts at loading the file
-        S3D_CACHE_ENTRY* ep = new S3D_CACHE_ENTRY;
-        m_CacheList.push_back( ep );
-        wxFileName fname( aFileName );
-        ep->modTime = fname.GetModificationTime();
+        wxLogTrace( MASK_3D_CACHE, "%s:%s:%d\n * [BUG] duplicate entry in map file; key = '%s'",
+                    __FILE__, __FUNCTION__, __LINE__, aFileName );
 
-        if( m_CacheMap.insert( std::pair< wxString, S3D_CACHE_ENTRY* >
-            ( aFileName, ep ) ).second == false )
-        {
-            wxLogTrace( MASK_3D_CACHE, "%s:%s:%d\n * [BUG] duplicate entry in map file; key = '%s'",
-                        __FILE__, __FUNCTION__, __LINE__, aFileName );
+        return NULL;
+    }
 
-            m_CacheList.pop_back();
-            delete ep;
-        }
-        else
-        {
-            if( aCachePtr )
-                *aCachePtr = ep;
+    if( aCachePtr )
+        *aCachePtr = ep;
 
-        }
+    return ep->sceneData;
+}
 
-        return NULL;
-    }
 
+S3D_CACHE_ENTRY* S3D_CACHE::loadEntry( const wxString& aFileName, bool aRenderDataOnly,
+                                       const unsigned char* aSHA1Sum )
+{
     S3D_CACHE_ENTRY* ep = new S3D_CACHE_ENTRY;
-    m_CacheList.push_back( ep );
     wxFileName fname( aFileName );
     ep->modTime = fname.GetModificationTime();
 
-    if( m_CacheMap.insert( std::pair< wxString, S3D_CACHE_ENTRY* >
-                               ( aFileName, ep ) ).second == false )
-    {
-        wxLogTrace( MASK_3D_CACHE, "%s:%s:%d\n * [BUG] duplicate entry in map file; key = '%s'",
-                    __FILE__, __FUNCTION__, __LINE__, aFileName );
+    unsigned char sha1sum[20];
 
-        m_CacheList.pop_back();
-        delete ep;
-        return NULL;
-    }
+    if( aSHA1Sum )
+        memcpy( sha1sum, aSHA1Sum, 20 );
 
-    if( aCachePtr )
-        *aCachePtr = ep;
+    // just in case we can't get a hash digest (for example, on access issues)
+    // or we do not have a configured cache file directory, the entry has no
+    // data to prevent further attempts at loading the file
+    if( ( !aSHA1Sum && !getSHA1( aFileName, sha1sum ) ) || m_CacheDir.empty() )
+        return ep;
 
     ep->SetSHA1( sha1sum );
 
+    if( aRenderDataOnly && loadMeshData( ep ) )
+        return ep;
+
     wxString bname = ep->GetCacheBaseName();
     wxString cachename = m_CacheDir + bname + wxT( ".3dc" );
 
     if( wxFileName::FileExists( cachename ) && loadCacheData( ep ) )
-        return ep->sceneData;
+        return ep;
 
     ep->sceneData = m_Plugins->Load3DModel( aFileName, ep->pluginInfo );
 
     if( NULL != ep->sceneData )
         saveCacheData( ep );
 
-    return ep->sceneData;
+    return ep;
+}
+
+
+bool S3D_CACHE::addEntry( const wxString& aFileName, S3D_CACHE_ENTRY* aCacheItem )
+{
+    if( m_CacheMap.insert( std::pair< wxString, S3D_CACHE_ENTRY* >
+                               ( aFileName, aCacheItem ) ).second == false )
+    {
+        delete aCacheItem;
+        return false;
+    }
+
+    m_CacheList.push_back( aCacheItem );
+    return true;
 }
 
 
@@ -502,6 +546,299 @@ bool S3D_CACHE::saveCacheData( S3D_CACHE_ENTRY* aCacheItem )
 }
 
 
+// The mesh cache file (.3dm) holds the render data of a model, so that it is loaded without
+// the plugins nor the scene graph.  The arrays are stored as they are in memory, in the
+// byte order and layout of the machine which wrote them, each one aligned on 4 bytes:
+//
+//  header:    MESH_CACHE_HEADER, followed by the plugin tag padded to 4 bytes
+//  materials: m_MaterialsSize SMATERIAL
+//  meshes:    for each mesh, a MESH_CACHE_MESH followed by its positions, normals,
+//             texture coordinates and colors (when present) and face indices
+
+#define MESH_CACHE_VERSION 1
+
+static const char       meshCacheMagic[8] = { 'K', 'I', 'C', 'A', 'D', '3', 'D', 'M' };
+static const uint32_t   meshCacheByteOrder = 0x01020304;
+
+struct MESH_CACHE_HEADER
+{
+    char     m_magic[8];
+    uint32_t m_version;
+    uint32_t m_byteOrder;
+    uint32_t m_materialSize;    ///< sizeof( SMATERIAL ) of the writer
+    uint32_t m_tagLength;
+    uint32_t m_materialsCount;
+    uint32_t m_meshesCount;
+};
+
+struct MESH_CACHE_MESH
+{
+    uint32_t m_vertexCount;
+    uint32_t m_faceIdxCount;
+    uint32_t m_materialIdx;
+    uint32_t m_hasTexcoords;
+    uint32_t m_hasColors;
+};
+
+
+static inline size_t pad4( size_t aSize )
+{
+    return ( aSize + 3 ) & ~(size_t) 3;
+}
+
+
+/**
+ * Reads the consecutive blocks of a mesh cache file loaded in memory.
+ */
+class MESH_CACHE_READER
+{
+public:
+    MESH_CACHE_READER( const std::vector<char>& aData ) : m_data( aData ), m_pos( 0 ) {}
+
+    const char* Read( size_t aSize )
+    {
+        if( aSize > m_data.size() - m_pos )
+            return NULL;
+
+        const char* p = &m_data[m_pos];
+        m_pos += pad4( aSize );
+        m_pos = std::min( m_pos, m_data.size() );
+        return p;
+    }
+
+    ///> copies aCount elements in a new array, or returns false if the data is too short
+    template <typename T>
+    bool ReadArray( T*& aArray, size_t aCount )
+    {
+        const char* p = Read( sizeof( T ) * aCount );
+
+        if( !p )
+            return false;
+
+        aArray = new T[aCount];
+        memcpy( aArray, p, sizeof( T ) * aCount );
+        return true;
+    }
+
+private:
+    const std::vector<char>& m_data;
+    size_t                   m_pos;
+};
+
+
+bool S3D_CACHE::loadMeshData( S3D_CACHE_ENTRY* aCacheItem )
+{
+    wxString bname = aCacheItem->GetCacheBaseName();
+
+    if( bname.empty() || m_CacheDir.empty() )
+        return false;
+
+    wxString fname = m_CacheDir + bname + wxT( ".3dm" );
+
+    if( !wxFileName::FileExists( fname ) )
+        return false;
+
+    std::vector<char> data;
+
+    {
+        OPEN_ISTREAM( file, fname.ToUTF8() );
+
+        if( file.fail() )
+            return false;
+
+        file.seekg( 0, std::ios::end );
+        std::streamoff size = file.tellg();
+        file.seekg( 0, std::ios::beg );
+
+        if( size <= 0 )
+        {
+            CLOSE_STREAM( file );
+            return false;
+        }
+
+        data.resize( (size_t) size );
+        file.read( data.data(), size );
+        bool ok = !file.fail();
+        CLOSE_STREAM( file );
+
+        if( !ok )
+            return false;
+    }
+
+    MESH_CACHE_READER reader( data );
+    const MESH_CACHE_HEADER* header =
+            (const MESH_CACHE_HEADER*) reader.Read( sizeof( MESH_CACHE_HEADER ) );
+
+    if( !header || memcmp( header->m_magic, meshCacheMagic, sizeof( meshCacheMagic ) )
+        || header->m_version != MESH_CACHE_VERSION
+        || header->m_byteOrder != meshCacheByteOrder
+        || header->m_materialSize != sizeof( SMATERIAL ) )
+    {
+        wxLogTrace( MASK_3D_CACHE, " * [3D model] mesh cache file '%s' has a different format",
+                    fname );
+
+        return false;
+    }
+
+    const char* tag = reader.Read( header->m_tagLength );
+
+    if( !tag )
+        return false;
+
+    // the same check as the scene cache: the plugin which made the model must be unchanged
+    std::string pluginInfo( tag, header->m_tagLength );
+
+    if( !checkTag( pluginInfo.c_str(), m_Plugins ) )
+        return false;
+
+    S3DMODEL* model = S3D::New3DModel();
+    bool      ok = header->m_materialsCount > 0 && header->m_meshesCount > 0
+                   && reader.ReadArray( model->m_Materials, header->m_materialsCount );
+
+    if( ok )
+    {
+        model->m_MaterialsSize = header->m_materialsCount;
+        model->m_Meshes = new SMESH[header->m_meshesCount];
+
+        for( uint32_t i = 0; i < header->m_meshesCount; ++i )
+            S3D::Init3DMesh( model->m_Meshes[i] );
+
+        model->m_MeshesSize = header->m_meshesCount;
+    }
+
+    for( uint32_t i = 0; ok && i < header->m_meshesCount; ++i )
+    {
+        const MESH_CACHE_MESH* meshHeader =
+                (const MESH_CACHE_MESH*) reader.Read( sizeof( MESH_CACHE_MESH ) );
+
+        if( !meshHeader || meshHeader->m_materialIdx >= model->m_MaterialsSize )
+        {
+            ok = false;
+            break;
+        }
+
+        SMESH& mesh = model->m_Meshes[i];
+
+        mesh.m_VertexSize = meshHeader->m_vertexCount;
+        mesh.m_FaceIdxSize = meshHeader->m_faceIdxCount;
+        mesh.m_MaterialIdx = meshHeader->m_materialIdx;
+
+        ok = reader.ReadArray( mesh.m_Positions, mesh.m_VertexSize )
+             && reader.ReadArray( mesh.m_Normals, mesh.m_VertexSize )
+             && ( !meshHeader->m_hasTexcoords
+                  || reader.ReadArray( mesh.m_Texcoords, mesh.m_VertexSize ) )
+             && ( !meshHeader->m_hasColors
+                  || reader.ReadArray( mesh.m_Color, mesh.m_VertexSize ) )
+             && reader.ReadArray( mesh.m_FaceIdx, mesh.m_FaceIdxSize );
+
+        // the renderers index the vertex arrays with the faces without checking them
+        for( unsigned int j = 0; ok && j < mesh.m_FaceIdxSize; ++j )
+            ok = mesh.m_FaceIdx[j] < mesh.m_VertexSize;
+    }
+
+    if( !ok )
+    {
+        wxLogTrace( MASK_3D_CACHE, " * [3D model] corrupt mesh cache file '%s'", fname );
+        S3D::Destroy3DModel( &model );
+        return false;
+    }
+
+    if( NULL != aCacheItem->renderData )
+        S3D::Destroy3DModel( &aCacheItem->renderData );
+
+    aCacheItem->renderData = model;
+    aCacheItem->pluginInfo = pluginInfo;
+
+    return true;
+}
+
+
+bool S3D_CACHE::saveMeshData( S3D_CACHE_ENTRY* aCacheItem )
+{
+    const S3DMODEL* model = aCacheItem->renderData;
+    wxString        bname = aCacheItem->GetCacheBaseName();
+
+    if( NULL == model || bname.empty() || m_CacheDir.empty() )
+        return false;
+
+    wxString fname = m_CacheDir + bname + wxT( ".3dm" );
+
+    if( wxFileName::Exists( fname ) && !wxFileName::FileExists( fname ) )
+    {
+        wxLogTrace( MASK_3D_CACHE, " * [3D model] path exists but is not a regular file '%s'",
+                    fname );
+
+        return false;
+    }
+
+    // as in the scene cache, a model without plugin information was made internally
+    std::string pluginInfo = aCacheItem->pluginInfo.empty() ? std::string( "INTERNAL:0.0.0.0" )
+                                                            : aCacheItem->pluginInfo;
+
+    OPEN_OSTREAM( file, fname.ToUTF8() );
+
+    if( file.fail() )
+        return false;
+
+    const char padding[4] = { 0, 0, 0, 0 };
+
+    auto write = [&]( const void* aData, size_t aSize )
+    {
+        file.write( (const char*) aData, aSize );
+
+        if( pad4( aSize ) != aSize )
+            file.write( padding, pad4( aSize ) - aSize );
+    };
+
+    MESH_CACHE_HEADER header;
+
+    memcpy( header.m_magic, meshCacheMagic, sizeof( meshCacheMagic ) );
+    header.m_version = MESH_CACHE_VERSION;
+    header.m_byteOrder = meshCacheByteOrder;
+    header.m_materialSize = sizeof( SMATERIAL );
+    header.m_tagLength = pluginInfo.size();
+    header.m_materialsCount = model->m_MaterialsSize;
+    header.m_meshesCount = model->m_MeshesSize;
+
+    write( &header, sizeof( header ) );
+    write( pluginInfo.data(), pluginInfo.size() );
+    write( model->m_Materials, sizeof( SMATERIAL ) * model->m_MaterialsSize );
+
+    for( unsigned int i = 0; i < model->m_MeshesSize; ++i )
+    {
+        const SMESH&    mesh = model->m_Meshes[i];
+        MESH_CACHE_MESH meshHeader;
+
+        meshHeader.m_vertexCount = mesh.m_VertexSize;
+        meshHeader.m_faceIdxCount = mesh.m_FaceIdxSize;
+        meshHeader.m_materialIdx = mesh.m_MaterialIdx;
+        meshHeader.m_hasTexcoords = mesh.m_Texcoords != NULL;
+        meshHeader.m_hasColors = mesh.m_Color != NULL;
+
+        write( &meshHeader, sizeof( meshHeader ) );
+        write( mesh.m_Positions, sizeof( SFVEC3F ) * mesh.m_VertexSize );
+        write( mesh.m_Normals, sizeof( SFVEC3F ) * mesh.m_VertexSize );
+
+        if( mesh.m_Texcoords )
+            write( mesh.m_Texcoords, sizeof( SFVEC2F ) * mesh.m_VertexSize );
+
+        if( mesh.m_Color )
+            write( mesh.m_Color, sizeof( SFVEC3F ) * mesh.m_VertexSize );
+
+        write( mesh.m_FaceIdx, sizeof( unsigned int ) * mesh.m_FaceIdxSize );
+    }
+
+    bool ok = !file.fail();
+    CLOSE_STREAM( file );
+
+    // a partial file would only be rejected when it is read
+    if( !ok )
+        wxRemoveFile( fname );
+
+    return ok;
+}
+
+
 bool S3D_CACHE::Set3DConfigDir( const wxString& aConfigDir )
 {
     if( !m_ConfigDir.empty() )
@@ -723,9 +1060,22 @@ void S3D_CACHE::ClosePlugins( void )
 
 
 S3DMODEL* S3D_CACHE::GetModel( const wxString& aModelFileName )
+{
+    return getModel( aModelFileName, NULL );
+}
+
+
+S3DMODEL* S3D_CACHE::getModel( const wxString& aModelFileName, S3D_CACHE_ENTRY** aCachePtr )
 {
     S3D_CACHE_ENTRY* cp = NULL;
-    SCENEGRAPH* sp = load( aModelFileName, &cp );
+    SCENEGRAPH* sp = load( aModelFileName, &cp, true );
+
+    if( aCachePtr )
+        *aCachePtr = cp;
+
+    // the render data may come from the mesh cache, without scene data
+    if( cp && cp->renderData )
+        return cp->renderData;
 
     if( !sp )
         return NULL;
@@ -739,16 +1089,146 @@ S3DMODEL* S3D_CACHE::GetModel( const wxString& aModelFileName )
         return NULL;
     }
 
-    if( cp->renderData )
-        return cp->renderData;
-
     S3DMODEL* mp = S3D::GetModel( sp );
     cp->renderData = mp;
 
+    if( NULL != mp )
+        saveMeshData( cp );
+
     return mp;
 }
 
 
+S3DMODEL* S3D_CACHE::GetModelLOD( const wxString& aModelFileName, unsigned int aLevel )
+{
+    if( aLevel < 1 || aLevel > LOD_LEVELS )
+        return NULL;
+
+    S3D_CACHE_ENTRY* cp = NULL;
+    S3DMODEL* mp = getModel( aModelFileName, &cp );
+
+    if( !mp || !cp )
+        return NULL;
+
+    if( cp->lodData.empty() )
+    {
+        // each level is decimated from the model, so that the errors do not add up
+        for( unsigned int level = 1; level <= LOD_LEVELS; ++level )
+            cp->lodData.push_back( DecimateModel3D( *mp, GetLODGridSize( level ) ) );
+    }
+
+    return cp->lodData[aLevel - 1];
+}
+
+
+unsigned int S3D_CACHE::GetLODGridSize( unsigned int aLevel )
+{
+    // a level looks right while a cell of its grid is at most a few pixels on the screen
+    static const unsigned int gridSizes[LOD_LEVELS] = { 48, 12 };
+
+    if( aLevel < 1 || aLevel > LOD_LEVELS )
+        return 0;
+
+    return gridSizes[aLevel - 1];
+}
+
+
+void S3D_CACHE::LoadModels( const std::vector<wxString>& aModelFileNames, bool aWithLODs,
+                            const std::function<void( size_t, size_t )>& aProgress )
+{
+    std::set<wxString> paths;
+
+    for( const wxString& name : aModelFileNames )
+    {
+        wxString full3Dpath = name.empty() ? name : m_FNResolver->ResolvePath( name );
+
+        if( !full3Dpath.empty() )
+            paths.insert( full3Dpath );
+    }
+
+    std::vector<wxString> files;
+
+    {
+        wxCriticalSectionLocker lock( lock3D_cache );
+
+        // the models already in the cache are checked by GetModel()
+        for( const wxString& path : paths )
+        {
+            if( !m_CacheMap.count( path ) )
+                files.push_back( path );
+        }
+    }
+
+    if( files.empty() )
+        return;
+
+    THREAD_POOL&                               pool = THREAD_POOL::GetPool();
+    std::vector<std::array<unsigned char, 20>> sha1sums( files.size() );
+    std::vector<char>                          hashed( files.size(), 0 );
+
+    pool.ParallelFor( files.size(),
+            [&]( size_t i )
+            {
+                hashed[i] = getSHA1( files[i], sha1sums[i].data() );
+            },
+            1 );
+
+    // copies of a file are left to GetModel(), which then finds them in the cache files;
+    // loading them at once would write the same cache files from several threads
+    std::set<std::array<unsigned char, 20>> loadedSums;
+    std::vector<size_t>                     toLoad;
+
+    for( size_t i = 0; i < files.size(); ++i )
+    {
+        if( hashed[i] && loadedSums.insert( sha1sums[i] ).second )
+            toLoad.push_back( i );
+    }
+
+    std::vector<S3D_CACHE_ENTRY*> entries( toLoad.size(), NULL );
+    std::atomic<size_t>           loaded( 0 );
+
+    // the entries are loaded without the cache lock, and added once they are all loaded
+    pool.ParallelFor( toLoad.size(),
+            [&]( size_t i )
+            {
+                size_t           file = toLoad[i];
+                S3D_CACHE_ENTRY* ep = loadEntry( files[file], true, sha1sums[file].data() );
+
+                if( NULL == ep->renderData && NULL != ep->sceneData )
+                {
+                    ep->renderData = S3D::GetModel( ep->sceneData );
+
+                    if( NULL != ep->renderData )
+                        saveMeshData( ep );
+                }
+
+                if( aWithLODs && NULL != ep->renderData )
+                {
+                    for( unsigned int level = 1; level <= LOD_LEVELS; ++level )
+                    {
+                        ep->lodData.push_back( DecimateModel3D( *ep->renderData,
+                                                                GetLODGridSize( level ) ) );
+                    }
+                }
+
+                entries[i] = ep;
+                ++loaded;
+            },
+            1, 0,
+            [&]()
+            {
+                if( aProgress )
+                    aProgress( loaded, toLoad.size() );
+            } );
+
+    wxCriticalSectionLocker lock( lock3D_cache );
+
+    // a file loaded meanwhile by GetModel() keeps its entry
+    for( size_t i = 0; i < toLoad.size(); ++i )
+        addEntry( files[toLoad[i]], entries[i] );
+}
+
+
 wxString S3D_CACHE::GetModelHash( const wxString& aModelFileName )
 {
     wxString full3Dpath = m_FNResolver->ResolvePath( aModelFileName );
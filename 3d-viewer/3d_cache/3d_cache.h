@@ -29,8 +29,10 @@
 #ifndef CACHE_3D_H
 #define CACHE_3D_H
 
+#include <functional>
 #include <list>
 #include <map>
+#include <vector>
 #include <wx/string.h>
 #include "kicad_string.h"
 #include "filename_resolver.h"
@@ -81,10 +83,33 @@ private:
      *
      * @param[in]   aFileName   file name (full or partial path)
      * @param[out]  aCachePtr   optional return address for cache entry pointer
+     * @param[in]   aRenderDataOnly   true to only load the render data from the mesh
+     *              cache when it has the model
      * @return      SCENEGRAPH object associated with file name
-     * @retval      NULL    on error
+     * @retval      NULL    on error, or when only the render data was loaded
      */
-    SCENEGRAPH* checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr = NULL );
+    SCENEGRAPH* checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr = NULL,
+                            bool aRenderDataOnly = false );
+
+    /**
+     * Creates the cache entry of a file and loads its data, from the cache files or with
+     * the plugins.  It does not use the cache maps, so that entries may be loaded by
+     * several threads at once.
+     *
+     * @param[in]   aFileName   file name (full path)
+     * @param[in]   aRenderDataOnly   true to only load the render data from the mesh
+     *              cache when it has the model
+     * @param[in]   aSHA1Sum    optional SHA1 hash of the file, if already known
+     * @return      the new entry, without data if the model could not be loaded
+     */
+    S3D_CACHE_ENTRY* loadEntry( const wxString& aFileName, bool aRenderDataOnly,
+                                const unsigned char* aSHA1Sum = NULL );
+
+    /**
+     * Adds a new entry to the cache maps, or deletes it if the file has an entry already.
+     * @return true if the entry was added
+     */
+    bool addEntry( const wxString& aFileName, S3D_CACHE_ENTRY* aCacheItem );
 
     /**
      * Function getSHA1
@@ -103,10 +128,25 @@ private:
     // save scene data to a cache file
     bool saveCacheData( S3D_CACHE_ENTRY* aCacheItem );
 
+    // load render data from a mesh cache file
+    bool loadMeshData( S3D_CACHE_ENTRY* aCacheItem );
+
+    // save render data to a mesh cache file
+    bool saveMeshData( S3D_CACHE_ENTRY* aCacheItem );
+
     // the real load function (can supply a cache entry pointer to member functions)
-    SCENEGRAPH* load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCachePtr = NULL );
+    // when aRenderDataOnly is true, a model found in the mesh cache is loaded without its
+    // scene data, and NULL is returned with the entry holding the render data
+    SCENEGRAPH* load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCachePtr = NULL,
+                      bool aRenderDataOnly = false );
+
+    // the real GetModel function (can supply a cache entry pointer to member functions)
+    S3DMODEL* getModel( const wxString& aModelFileName, S3D_CACHE_ENTRY** aCachePtr );
 
 public:
+    /// number of decimated levels of detail of the models
+    static const unsigned int LOD_LEVELS = 2;
+
     S3D_CACHE();
     virtual ~S3D_CACHE();
 
@@ -193,13 +233,50 @@ public:
     /**
      * Function GetModel
      * attempts to load the scene data for a model and to translate it
-     * into an S3D_MODEL structure for display by a renderer
+     * into an S3D_MODEL structure for display by a renderer.  The render
+     * data is read from the mesh cache when it has the model, without the
+     * scene data and the plugins.
      *
      * @param aModelFileName is the full path to the model to be loaded
      * @return is a pointer to the render data or NULL if not available
      */
     S3DMODEL* GetModel( const wxString& aModelFileName );
 
+    /**
+     * Function GetModelLOD
+     * returns a decimated level of detail of the render data of a model.  The levels of a
+     * model are built from the data of GetModel() the first time one of them is asked for.
+     *
+     * @param aModelFileName is the full path to the model
+     * @param aLevel is the level of detail, from 1 to LOD_LEVELS
+     * @return the render data of the level, or NULL if the model has no such level, when
+     * the decimation does not make it much smaller than the model
+     */
+    S3DMODEL* GetModelLOD( const wxString& aModelFileName, unsigned int aLevel );
+
+    /**
+     * Function GetLODGridSize
+     * @return the number of cells along the longest side of a model of the grid in which the
+     * vertices of a level of detail are merged
+     */
+    static unsigned int GetLODGridSize( unsigned int aLevel );
+
+    /**
+     * Function LoadModels
+     * loads the render data of a list of models on the thread pool, so that the calls to
+     * GetModel() which follow return at once.  Models already in the cache are skipped,
+     * and the same file is loaded once.  The plugins which are not thread safe still load
+     * one model at a time, but the mesh cache, the scene cache and the conversion of the
+     * scene data are used by several threads.
+     *
+     * @param aModelFileNames are the names of the models, as given to GetModel()
+     * @param aWithLODs is true to build the levels of detail of the models too
+     * @param aProgress is called by the calling thread while the models are loading, with
+     * the count of loaded and of all the models
+     */
+    void LoadModels( const std::vector<wxString>& aModelFileNames, bool aWithLODs = false,
+                     const std::function<void( size_t, size_t )>& aProgress = nullptr );
+
     wxString GetModelHash( const wxString& aModelFileName );
 };
 
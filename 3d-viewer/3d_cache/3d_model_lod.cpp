@@ -0,0 +1,254 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cstring>
+#include <stdint.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "3d_model_lod.h"
+#include "plugins/3dapi/ifsg_api.h"
+
+
+/// The sums of the vertices merged in a cell of the grid
+struct VERTEX_CLUSTER
+{
+    SFVEC3F      m_position;
+    SFVEC3F      m_normal;
+    SFVEC2F      m_texcoord;
+    SFVEC3F      m_color;
+    unsigned int m_count;
+};
+
+
+/// Hashes a triangle of cluster indices, rotated to start with its smallest index
+struct TRIANGLE_HASH
+{
+    size_t operator()( const std::array<unsigned int, 3>& aTriangle ) const
+    {
+        return ( (size_t) aTriangle[0] * 73856093 ) ^ ( (size_t) aTriangle[1] * 19349663 )
+               ^ ( (size_t) aTriangle[2] * 83492791 );
+    }
+};
+
+
+static unsigned int normalAxis( const SFVEC3F& aNormal )
+{
+    const SFVEC3F a = glm::abs( aNormal );
+
+    if( a.x >= a.y && a.x >= a.z )
+        return aNormal.x < 0.0f ? 1 : 0;
+
+    if( a.y >= a.z )
+        return aNormal.y < 0.0f ? 3 : 2;
+
+    return aNormal.z < 0.0f ? 5 : 4;
+}
+
+
+/**
+ * Decimates one mesh of a model.
+ * @return false if all the triangles of the mesh collapsed
+ */
+static bool decimateMesh( const SMESH& aMesh, SMESH& aResult, const SFVEC3F& aOrigin,
+                          float aCellSize )
+{
+    std::unordered_map<uint64_t, unsigned int> clusterIndex;
+    std::vector<VERTEX_CLUSTER>                clusters;
+    std::vector<unsigned int>                  vertexCluster( aMesh.m_VertexSize );
+
+    clusterIndex.reserve( aMesh.m_VertexSize );
+
+    for( unsigned int i = 0; i < aMesh.m_VertexSize; ++i )
+    {
+        const SFVEC3F cell = glm::clamp( ( aMesh.m_Positions[i] - aOrigin ) / aCellSize,
+                                         SFVEC3F( 0.0f ), SFVEC3F( (float) 0xFFFFF ) );
+
+        // 20 bits for each coordinate and 3 bits for the direction of the normal
+        const uint64_t key = (uint64_t) cell.x
+                             | ( (uint64_t) cell.y << 20 )
+                             | ( (uint64_t) cell.z << 40 )
+                             | ( (uint64_t) normalAxis( aMesh.m_Normals[i] ) << 60 );
+
+        auto it = clusterIndex.emplace( key, (unsigned int) clusters.size() );
+
+        if( it.second )
+            clusters.push_back( { SFVEC3F( 0.0f ), SFVEC3F( 0.0f ), SFVEC2F( 0.0f ),
+                                  SFVEC3F( 0.0f ), 0 } );
+
+        VERTEX_CLUSTER& cluster = clusters[it.first->second];
+
+        cluster.m_position += aMesh.m_Positions[i];
+        cluster.m_normal += aMesh.m_Normals[i];
+
+        if( aMesh.m_Texcoords )
+            cluster.m_texcoord += aMesh.m_Texcoords[i];
+
+        if( aMesh.m_Color )
+            cluster.m_color += aMesh.m_Color[i];
+
+        cluster.m_count++;
+        vertexCluster[i] = it.first->second;
+    }
+
+    std::unordered_set<std::array<unsigned int, 3>, TRIANGLE_HASH> triangleSet;
+    std::vector<unsigned int>                                      faces;
+
+    for( unsigned int i = 0; i + 2 < aMesh.m_FaceIdxSize; i += 3 )
+    {
+        if( aMesh.m_FaceIdx[i] >= aMesh.m_VertexSize
+            || aMesh.m_FaceIdx[i + 1] >= aMesh.m_VertexSize
+            || aMesh.m_FaceIdx[i + 2] >= aMesh.m_VertexSize )
+            continue;
+
+        std::array<unsigned int, 3> t = { { vertexCluster[aMesh.m_FaceIdx[i]],
+                                            vertexCluster[aMesh.m_FaceIdx[i + 1]],
+                                            vertexCluster[aMesh.m_FaceIdx[i + 2]] } };
+
+        if( t[0] == t[1] || t[1] == t[2] || t[2] == t[0] )
+            continue;
+
+        // the rotation keeps the winding, so the back faces are not merged with the front ones
+        std::rotate( t.begin(), std::min_element( t.begin(), t.end() ), t.end() );
+
+        if( triangleSet.insert( t ).second )
+            faces.insert( faces.end(), t.begin(), t.end() );
+    }
+
+    if( faces.empty() )
+        return false;
+
+    S3D::Init3DMesh( aResult );
+
+    aResult.m_MaterialIdx = aMesh.m_MaterialIdx;
+    aResult.m_VertexSize = clusters.size();
+    aResult.m_Positions = new SFVEC3F[clusters.size()];
+    aResult.m_Normals = new SFVEC3F[clusters.size()];
+
+    if( aMesh.m_Texcoords )
+        aResult.m_Texcoords = new SFVEC2F[clusters.size()];
+
+    if( aMesh.m_Color )
+        aResult.m_Color = new SFVEC3F[clusters.size()];
+
+    for( size_t i = 0; i < clusters.size(); ++i )
+    {
+        const VERTEX_CLUSTER& cluster = clusters[i];
+        const float           scale = 1.0f / cluster.m_count;
+        const float           normalLength = glm::length( cluster.m_normal );
+
+        aResult.m_Positions[i] = cluster.m_position * scale;
+        aResult.m_Normals[i] = normalLength > FLT_EPSILON ? cluster.m_normal / normalLength
+                                                           : SFVEC3F( 0.0f, 0.0f, 1.0f );
+
+        if( aResult.m_Texcoords )
+            aResult.m_Texcoords[i] = cluster.m_texcoord * scale;
+
+        if( aResult.m_Color )
+            aResult.m_Color[i] = cluster.m_color * scale;
+    }
+
+    aResult.m_FaceIdxSize = faces.size();
+    aResult.m_FaceIdx = new unsigned int[faces.size()];
+    memcpy( aResult.m_FaceIdx, faces.data(), sizeof( unsigned int ) * faces.size() );
+
+    return true;
+}
+
+
+S3DMODEL* DecimateModel3D( const S3DMODEL& aModel, unsigned int aGridSize )
+{
+    if( !aModel.m_Meshes || !aModel.m_MeshesSize || !aModel.m_Materials
+        || !aModel.m_MaterialsSize || aGridSize == 0 )
+        return NULL;
+
+    SFVEC3F      bboxMin( FLT_MAX );
+    SFVEC3F      bboxMax( -FLT_MAX );
+    unsigned int faceIdxCount = 0;
+
+    for( unsigned int m = 0; m < aModel.m_MeshesSize; ++m )
+    {
+        const SMESH& mesh = aModel.m_Meshes[m];
+
+        if( !mesh.m_Positions || !mesh.m_Normals || !mesh.m_FaceIdx )
+            return NULL;
+
+        for( unsigned int i = 0; i < mesh.m_VertexSize; ++i )
+        {
+            bboxMin = glm::min( bboxMin, mesh.m_Positions[i] );
+            bboxMax = glm::max( bboxMax, mesh.m_Positions[i] );
+        }
+
+        faceIdxCount += mesh.m_FaceIdxSize;
+    }
+
+    const SFVEC3F extent = bboxMax - bboxMin;
+    const float   cellSize = std::max( extent.x, std::max( extent.y, extent.z ) ) / aGridSize;
+
+    if( !( cellSize > 0.0f ) )
+        return NULL;
+
+    std::vector<SMESH> meshes;
+    unsigned int       decimatedFaceIdxCount = 0;
+
+    for( unsigned int m = 0; m < aModel.m_MeshesSize; ++m )
+    {
+        const SMESH& mesh = aModel.m_Meshes[m];
+        SMESH        decimated;
+
+        if( mesh.m_VertexSize == 0 || mesh.m_FaceIdxSize == 0 )
+            continue;
+
+        if( decimateMesh( mesh, decimated, bboxMin, cellSize ) )
+        {
+            meshes.push_back( decimated );
+            decimatedFaceIdxCount += decimated.m_FaceIdxSize;
+        }
+    }
+
+    // a level which is almost as large as the model is not worth drawing instead of it
+    if( meshes.empty() || decimatedFaceIdxCount * 2 > faceIdxCount )
+    {
+        for( SMESH& mesh : meshes )
+            S3D::Free3DMesh( mesh );
+
+        return NULL;
+    }
+
+    S3DMODEL* model = S3D::New3DModel();
+
+    model->m_MaterialsSize = aModel.m_MaterialsSize;
+    model->m_Materials = new SMATERIAL[aModel.m_MaterialsSize];
+    std::copy( aModel.m_Materials, aModel.m_Materials + aModel.m_MaterialsSize,
+               model->m_Materials );
+
+    model->m_MeshesSize = meshes.size();
+    model->m_Meshes = new SMESH[meshes.size()];
+    std::copy( meshes.begin(), meshes.end(), model->m_Meshes );
+
+    return model;
+}
@@ -0,0 +1,48 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file 3d_model_lod.h
+ * builds the decimated levels of detail of the 3D models
+ */
+
+#ifndef MODEL_LOD_3D_H
+#define MODEL_LOD_3D_H
+
+#include <plugins/3dapi/c3dmodel.h>
+
+/**
+ * Function DecimateModel3D
+ * builds a coarser copy of a model by vertex clustering: the vertices of each mesh are
+ * merged in the cells of a grid over the bounding box of the model, and the triangles
+ * which collapse are dropped.  The vertices are clustered by the dominant axis of their
+ * normal too, so the hard edges of the packages stay sharp.
+ *
+ * @param aModel is the model to decimate
+ * @param aGridSize is the number of cells of the grid along the longest side of the model
+ * @return a new model, to destroy with S3D::Destroy3DModel(), or NULL if the decimation
+ * does not remove at least half of the triangles of the model
+ */
+S3DMODEL* DecimateModel3D( const S3DMODEL& aModel, unsigned int aGridSize );
+
+#endif  // MODEL_LOD_3D_H
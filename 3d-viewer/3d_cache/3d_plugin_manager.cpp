@@ -500,8 +500,13 @@ SCENEGRAPH* S3D_PLUGIN_MANAGER::Load3DModel( const wxString& aFileName, std::str
 
     while( sL != items.second )
     {
+        std::unique_lock<std::mutex> lock( m_LoadLock );
+
         if( sL->second->CanRender() )
         {
+            if( sL->second->IsThreadSafe() )
+                lock.unlock();
+
             SCENEGRAPH* sp = sL->second->Load( aFileName.ToUTF8() );
 
             if( NULL != sp )
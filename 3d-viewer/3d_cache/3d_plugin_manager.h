@@ -31,6 +31,7 @@
 
 #include <map>
 #include <list>
+#include <mutex>
 #include <string>
 #include <wx/string.h>
 
@@ -50,6 +51,9 @@ private:
     /// list of file filters
     std::list< wxString > m_FileFilters;
 
+    /// held while a plugin which is not thread safe loads a model
+    std::mutex m_LoadLock;
+
     /// load plugins
     void loadPlugins( void );
 
@@ -82,6 +86,12 @@ public:
      */
     std::list< wxString > const* GetFileFilters( void ) const;
 
+    /**
+     * Function Load3DModel
+     * loads a model with the first plugin which can read it.  It may be called by
+     * several threads: the plugins which are not thread safe load one model at a time,
+     * as they may share the locale of the process or have global state.
+     */
     SCENEGRAPH* Load3DModel( const wxString& aFileName, std::string& aPluginInfo );
 
     /**
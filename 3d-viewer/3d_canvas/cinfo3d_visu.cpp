@@ -450,6 +450,17 @@ void CINFO3D_VISU::InitSettings( REPORTER *aStatusTextReporter )
 }
 
 
+void CINFO3D_VISU::UpdateLayers( REPORTER *aStatusTextReporter, const LSET &aLayers )
+{
+    wxLogTrace( m_logTrace, wxT( "CINFO3D_VISU::UpdateLayers" ) );
+
+    if( aStatusTextReporter )
+        aStatusTextReporter->Report( _( "Update layers" ) );
+
+    createLayers( aStatusTextReporter, aLayers );
+}
+
+
 void CINFO3D_VISU::createBoardPolygon()
 {
     m_board_poly.RemoveAllContours();
@@ -134,6 +134,15 @@ class CINFO3D_VISU
      */
     void InitSettings( REPORTER *aStatusTextReporter );
 
+    /**
+     * @brief UpdateLayers - Rebuild only some layers of the board, when the board
+     * outline did not change since the last InitSettings.  The copper layers are
+     * rebuilt all together with the holes, if any of them is in aLayers.
+     * @param aStatusTextReporter: the pointer for the status reporter
+     * @param aLayers: the layers to rebuild
+     */
+    void UpdateLayers( REPORTER *aStatusTextReporter, const LSET &aLayers );
+
     /**
      * @brief BiuTo3Dunits - Board integer units To 3D units
      * @return the conversion factor to transform a position from the board to 3d units
@@ -419,8 +428,10 @@ class CINFO3D_VISU
 
  private:
     void createBoardPolygon();
-    void createLayers( REPORTER *aStatusTextReporter );
-    void destroyLayers();
+    void createLayers( REPORTER *aStatusTextReporter,
+                       const LSET &aLayers = LSET::AllLayersMask() );
+    void createCopperLayers( REPORTER *aStatusTextReporter );
+    void destroyLayers( const LSET &aLayers = LSET::AllLayersMask() );
 
     // Helper functions to create the board
     COBJECT2D *createNewTrack( const TRACK* aTrack , int aClearanceValue ) const;
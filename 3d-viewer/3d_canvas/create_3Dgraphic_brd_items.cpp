@@ -59,11 +59,12 @@
 // These variables are parameters used in addTextSegmToContainer.
 // But addTextSegmToContainer is a call-back function,
 // so we cannot send them as arguments.
-static int s_textWidth;
-static CGENERICCONTAINER2D *s_dstcontainer = NULL;
-static float s_biuTo3Dunits;
-static const CBBOX2D *s_boardBBox3DU = NULL;
-static const BOARD_ITEM *s_boardItem = NULL;
+// They are per thread, as the layers are built on several threads.
+static thread_local int s_textWidth;
+static thread_local CGENERICCONTAINER2D *s_dstcontainer = NULL;
+static thread_local float s_biuTo3Dunits;
+static thread_local const CBBOX2D *s_boardBBox3DU = NULL;
+static thread_local const BOARD_ITEM *s_boardItem = NULL;
 
 // This is a call back function, used by GRText to draw the 3D text shape:
 void addTextSegmToContainer( int x0, int y0, int xf, int yf, void* aData )
@@ -52,78 +52,44 @@
 #include <trigo.h>
 #include <utility>
 #include <vector>
-#include <thread>
 #include <algorithm>
-#include <atomic>
+#include <thread_pool.h>
 
 #include <profile.h>
 
-void CINFO3D_VISU::destroyLayers()
+/**
+ * Deletes the items of a map of layers which are on one of the given layers
+ */
+template <class MAP>
+static void destroyLayersOfMap( MAP& aMap, const LSET& aLayers )
 {
-    if( !m_layers_poly.empty() )
+    for( typename MAP::iterator ii = aMap.begin(); ii != aMap.end(); )
     {
-        for( MAP_POLY::iterator ii = m_layers_poly.begin();
-             ii != m_layers_poly.end();
-             ++ii )
+        if( aLayers[ii->first] )
         {
             delete ii->second;
-            ii->second = NULL;
+            ii = aMap.erase( ii );
         }
-
-        m_layers_poly.clear();
-    }
-
-    if( !m_layers_inner_holes_poly.empty() )
-    {
-        for( MAP_POLY::iterator ii = m_layers_inner_holes_poly.begin();
-             ii != m_layers_inner_holes_poly.end();
-             ++ii )
+        else
         {
-            delete ii->second;
-            ii->second = NULL;
+            ++ii;
         }
-
-        m_layers_inner_holes_poly.clear();
     }
+}
 
-    if( !m_layers_outer_holes_poly.empty() )
-    {
-        for( MAP_POLY::iterator ii = m_layers_outer_holes_poly.begin();
-             ii != m_layers_outer_holes_poly.end();
-             ++ii )
-        {
-            delete ii->second;
-            ii->second = NULL;
-        }
 
-        m_layers_outer_holes_poly.clear();
-    }
+void CINFO3D_VISU::destroyLayers( const LSET& aLayers )
+{
+    destroyLayersOfMap( m_layers_poly, aLayers );
+    destroyLayersOfMap( m_layers_container2D, aLayers );
 
-    if( !m_layers_container2D.empty() )
-    {
-        for( MAP_CONTAINER_2D::iterator ii = m_layers_container2D.begin();
-             ii != m_layers_container2D.end();
-             ++ii )
-        {
-            delete ii->second;
-            ii->second = NULL;
-        }
+    // The holes are only on copper layers, and are built with all of them
+    if( ( aLayers & LSET::AllCuMask() ).none() )
+        return;
 
-        m_layers_container2D.clear();
-    }
-
-    if( !m_layers_holes2D.empty() )
-    {
-        for( MAP_CONTAINER_2D::iterator ii = m_layers_holes2D.begin();
-             ii != m_layers_holes2D.end();
-             ++ii )
-        {
-            delete ii->second;
-            ii->second = NULL;
-        }
-
-        m_layers_holes2D.clear();
-    }
+    destroyLayersOfMap( m_layers_inner_holes_poly, LSET::AllCuMask() );
+    destroyLayersOfMap( m_layers_outer_holes_poly, LSET::AllCuMask() );
+    destroyLayersOfMap( m_layers_holes2D, LSET::AllCuMask() );
 
     m_through_holes_inner.Clear();
     m_through_holes_outer.Clear();
@@ -138,9 +104,9 @@ void CINFO3D_VISU::destroyLayers()
 }
 
 
-void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
+void CINFO3D_VISU::createCopperLayers( REPORTER *aStatusTextReporter )
 {
-    destroyLayers();
+    THREAD_POOL& pool = THREAD_POOL::GetPool();
 
     // Build Copper layers
     // Based on: https://github.com/KiCad/kicad-source-mirror/blob/master/3d-viewer/3d_draw.cpp#L692
@@ -208,6 +174,11 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     layer_id.clear();
     layer_id.reserve( m_copperLayersCount );
 
+    // The containers of the layers, by index in layer_id.  The layers are built on
+    // several threads, which must not look up the maps.
+    std::vector< CBVHCONTAINER2D *> layerContainers;
+    std::vector< SHAPE_POLY_SET *> layerPolys;
+
     for( unsigned i = 0; i < arrayDim( cu_seq ); ++i )
         cu_seq[i] = ToLAYER_ID( B_Cu - i );
 
@@ -222,12 +193,18 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 
         CBVHCONTAINER2D *layerContainer = new CBVHCONTAINER2D;
         m_layers_container2D[curr_layer_id] = layerContainer;
+        layerContainers.push_back( layerContainer );
 
         if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS ) &&
             (m_render_engine == RENDER_ENGINE_OPENGL_LEGACY) )
         {
             SHAPE_POLY_SET *layerPoly = new SHAPE_POLY_SET;
             m_layers_poly[curr_layer_id] = layerPoly;
+            layerPolys.push_back( layerPoly );
+        }
+        else
+        {
+            layerPolys.push_back( NULL );
         }
     }
 
@@ -241,13 +218,11 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 
     // Create tracks as objects and add it to container
     // /////////////////////////////////////////////////////////////////////////
-    for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
+    pool.ParallelFor( layer_id.size(), [&]( size_t lIdx )
     {
         const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
 
-        wxASSERT( m_layers_container2D.find( curr_layer_id ) != m_layers_container2D.end() );
-
-        CBVHCONTAINER2D *layerContainer = m_layers_container2D[curr_layer_id];
+        CBVHCONTAINER2D *layerContainer = layerContainers[lIdx];
 
         // ADD TRACKS
         unsigned int nTracks = trackList.size();
@@ -263,7 +238,7 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
             // Add object item to layer container
             layerContainer->Add( createNewTrack( track, 0.0f ) );
         }
-    }
+    }, 1 );
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
     printf( "T03: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
@@ -457,13 +432,11 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS ) &&
         (m_render_engine == RENDER_ENGINE_OPENGL_LEGACY) )
     {
-        for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
+        pool.ParallelFor( layer_id.size(), [&]( size_t lIdx )
         {
             const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
 
-            wxASSERT( m_layers_poly.find( curr_layer_id ) != m_layers_poly.end() );
-
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[curr_layer_id];
+            SHAPE_POLY_SET *layerPoly = layerPolys[lIdx];
 
             // ADD TRACKS
             unsigned int nTracks = trackList.size();
@@ -478,7 +451,7 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
                 // Add the track contour
                 track->TransformShapeWithClearanceToPolygon( *layerPoly, 0 );
             }
-        }
+        }, 1 );
     }
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
@@ -553,13 +526,11 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 
     // Add modules PADs objects to containers
     // /////////////////////////////////////////////////////////////////////////
-    for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
+    pool.ParallelFor( layer_id.size(), [&]( size_t lIdx )
     {
         const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
 
-        wxASSERT( m_layers_container2D.find( curr_layer_id ) != m_layers_container2D.end() );
-
-        CBVHCONTAINER2D *layerContainer = m_layers_container2D[curr_layer_id];
+        CBVHCONTAINER2D *layerContainer = layerContainers[lIdx];
 
         // ADD PADS
         for( auto module : m_board->Modules() )
@@ -578,7 +549,7 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
                                                        curr_layer_id,
                                                        0 );
         }
-    }
+    }, 1 );
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
     printf( "T09: %.3f ms\n", (float)( GetRunningMicroSecs()  - start_Time  ) / 1e3 );
@@ -590,13 +561,11 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS ) &&
         (m_render_engine == RENDER_ENGINE_OPENGL_LEGACY) )
     {
-        for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
+        pool.ParallelFor( layer_id.size(), [&]( size_t lIdx )
         {
             const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
 
-            wxASSERT( m_layers_poly.find( curr_layer_id ) != m_layers_poly.end() );
-
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[curr_layer_id];
+            SHAPE_POLY_SET *layerPoly = layerPolys[lIdx];
 
             // ADD PADS
             for( auto module : m_board->Modules() )
@@ -618,7 +587,7 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 
                 transformGraphicModuleEdgeToPolygonSet( module, curr_layer_id, *layerPoly );
             }
-        }
+        }, 1 );
     }
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
@@ -628,13 +597,11 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 
     // Add graphic item on copper layers to object containers
     // /////////////////////////////////////////////////////////////////////////
-    for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
+    pool.ParallelFor( layer_id.size(), [&]( size_t lIdx )
     {
         const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
 
-        wxASSERT( m_layers_container2D.find( curr_layer_id ) != m_layers_container2D.end() );
-
-        CBVHCONTAINER2D *layerContainer = m_layers_container2D[curr_layer_id];
+        CBVHCONTAINER2D *layerContainer = layerContainers[lIdx];
 
         // ADD GRAPHIC ITEMS ON COPPER LAYERS (texts)
         for( auto item : m_board->Drawings() )
@@ -674,7 +641,7 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
             break;
             }
         }
-    }
+    }, 1 );
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
     printf( "T11: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
@@ -686,13 +653,11 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS ) &&
         (m_render_engine == RENDER_ENGINE_OPENGL_LEGACY) )
     {
-        for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
+        pool.ParallelFor( layer_id.size(), [&]( size_t lIdx )
         {
             const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
 
-            wxASSERT( m_layers_poly.find( curr_layer_id ) != m_layers_poly.end() );
-
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[curr_layer_id];
+            SHAPE_POLY_SET *layerPoly = layerPolys[lIdx];
 
             // ADD GRAPHIC ITEMS ON COPPER LAYERS (texts)
             for( auto item : m_board->Drawings() )
@@ -716,7 +681,7 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
                     break;
                 }
             }
-        }
+        }, 1 );
     }
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
@@ -731,39 +696,21 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 
         // Add zones objects
         // /////////////////////////////////////////////////////////////////////
-        std::atomic<size_t> nextZone( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
-
-        size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        // The containers lock their additions, so the zones of a layer can be added together
+        pool.ParallelFor( m_board->GetAreaCount(), [&]( size_t areaId )
         {
-            std::thread t = std::thread( [&]()
-            {
-                for( size_t areaId = nextZone.fetch_add( 1 );
-                            areaId < static_cast<size_t>( m_board->GetAreaCount() );
-                            areaId = nextZone.fetch_add( 1 ) )
-                {
-                    const ZONE_CONTAINER* zone = m_board->GetArea( areaId );
-
-                    if( zone == nullptr )
-                        break;
-
-                    auto layerContainer = m_layers_container2D.find( zone->GetLayer() );
-
-                    if( layerContainer != m_layers_container2D.end() )
-                        AddSolidAreasShapesToContainer( zone, layerContainer->second,
-                                                        zone->GetLayer() );
-                }
-
-                threadsFinished++;
-            } );
+            const ZONE_CONTAINER* zone = m_board->GetArea( areaId );
 
-            t.detach();
-        }
+            // The containers of the tech layers may be kept from a previous build
+            if( zone == nullptr || !IsCopperLayer( zone->GetLayer() ) )
+                return;
 
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+            auto layerContainer = m_layers_container2D.find( zone->GetLayer() );
 
+            if( layerContainer != m_layers_container2D.end() )
+                AddSolidAreasShapesToContainer( zone, layerContainer->second,
+                                                zone->GetLayer() );
+        }, 1 );
     }
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
@@ -783,6 +730,9 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
             if( zone == nullptr )
                 break;
 
+            if( !IsCopperLayer( zone->GetLayer() ) )
+                continue;
+
             auto layerContainer = m_layers_poly.find( zone->GetLayer() );
 
             if( layerContainer != m_layers_poly.end() )
@@ -804,35 +754,12 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS ) &&
         (m_render_engine == RENDER_ENGINE_OPENGL_LEGACY) )
     {
-        std::atomic<size_t> nextItem( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
-
-        size_t parallelThreadCount = std::min<size_t>(
-                std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
-                layer_id.size() );
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        // Simplify() splits each union into bands on the pool too
+        pool.ParallelFor( layer_id.size(), [&]( size_t lIdx )
         {
-            std::thread t = std::thread( [&nextItem, &threadsFinished, &layer_id, this]()
-            {
-                for( size_t i = nextItem.fetch_add( 1 );
-                            i < layer_id.size();
-                            i = nextItem.fetch_add( 1 ) )
-                {
-                    auto layerPoly = m_layers_poly.find( layer_id[i] );
-
-                    if( layerPoly != m_layers_poly.end() )
-                        // This will make a union of all added contours
-                        layerPoly->second->Simplify( SHAPE_POLY_SET::PM_FAST );
-                }
-
-                threadsFinished++;
-            } );
-
-            t.detach();
-        }
-
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+            // This will make a union of all added contours
+            layerPolys[lIdx]->Simplify( SHAPE_POLY_SET::PM_FAST );
+        }, 1 );
     }
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
@@ -845,6 +772,8 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     if( aStatusTextReporter )
         aStatusTextReporter->Report( _( "Simplify holes contours" ) );
 
+    std::vector< SHAPE_POLY_SET *> holesPolys;
+
     for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
     {
         const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
@@ -853,33 +782,51 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
             m_layers_outer_holes_poly.end() )
         {
             // found
-            SHAPE_POLY_SET *polyLayer = m_layers_outer_holes_poly[curr_layer_id];
-            polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
+            holesPolys.push_back( m_layers_outer_holes_poly[curr_layer_id] );
 
             wxASSERT( m_layers_inner_holes_poly.find( curr_layer_id ) !=
                       m_layers_inner_holes_poly.end() );
 
-            polyLayer = m_layers_inner_holes_poly[curr_layer_id];
-            polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
+            holesPolys.push_back( m_layers_inner_holes_poly[curr_layer_id] );
         }
     }
 
+    // This will make a union of all added contourns
+    holesPolys.push_back( &m_through_inner_holes_poly );
+    holesPolys.push_back( &m_through_outer_holes_poly );
+    holesPolys.push_back( &m_through_outer_holes_poly_NPTH );
+    holesPolys.push_back( &m_through_outer_holes_vias_poly );
+    //holesPolys.push_back( &m_through_inner_holes_vias_poly ); // Not in use
+
+    pool.ParallelFor( holesPolys.size(), [&]( size_t aIdx )
+    {
+        holesPolys[aIdx]->Simplify( SHAPE_POLY_SET::PM_FAST );
+    }, 1 );
+
 #ifdef PRINT_STATISTICS_3D_VIEWER
     printf( "T16: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time ) / 1e3 );
 #endif
     // End Build Copper layers
 
-
-    // This will make a union of all added contourns
-    m_through_inner_holes_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_through_outer_holes_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_through_outer_holes_poly_NPTH.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_through_outer_holes_vias_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
-    //m_through_inner_holes_vias_poly.Simplify( SHAPE_POLY_SET::PM_FAST ); // Not in use
-
 #ifdef PRINT_STATISTICS_3D_VIEWER
     unsigned stats_endCopperLayersTime = GetRunningMicroSecs();
+
+    printf( "CINFO3D_VISU::createCopperLayers times\n" );
+    printf( "  Copper Layers:          %.3f ms\n",
+            (float)( stats_endCopperLayersTime  - stats_startCopperLayersTime  ) / 1e3 );
 #endif
+}
+
+
+void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter, const LSET& aLayers )
+{
+    destroyLayers( aLayers );
+
+    THREAD_POOL& pool = THREAD_POOL::GetPool();
+
+    // The copper layers and the holes are built together, or not at all
+    if( ( aLayers & LSET::AllCuMask() ).any() )
+        createCopperLayers( aStatusTextReporter );
 
     // Build Tech layers
     // Based on: https://github.com/KiCad/kicad-source-mirror/blob/master/3d-viewer/3d_draw.cpp#L1059
@@ -913,20 +860,37 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 
     // User layers are not drawn here, only technical layers
 
+    std::vector< PCB_LAYER_ID > tech_layer_id;
+    std::vector< CBVHCONTAINER2D *> layerContainers;
+    std::vector< SHAPE_POLY_SET *> layerPolys;
+
     for( LSEQ seq = LSET::AllNonCuMask().Seq( teckLayerList, arrayDim( teckLayerList ) );
          seq;
          ++seq )
     {
         const PCB_LAYER_ID curr_layer_id = *seq;
 
-        if( !Is3DLayerEnabled( curr_layer_id ) )
+        if( !aLayers[curr_layer_id] || !Is3DLayerEnabled( curr_layer_id ) )
                     continue;
 
+        tech_layer_id.push_back( curr_layer_id );
+
         CBVHCONTAINER2D *layerContainer = new CBVHCONTAINER2D;
         m_layers_container2D[curr_layer_id] = layerContainer;
+        layerContainers.push_back( layerContainer );
 
         SHAPE_POLY_SET *layerPoly = new SHAPE_POLY_SET;
         m_layers_poly[curr_layer_id] = layerPoly;
+        layerPolys.push_back( layerPoly );
+    }
+
+    // The layers are independent, and built together
+    pool.ParallelFor( tech_layer_id.size(), [&]( size_t lIdx )
+    {
+        const PCB_LAYER_ID curr_layer_id = tech_layer_id[lIdx];
+
+        CBVHCONTAINER2D *layerContainer = layerContainers[lIdx];
+        SHAPE_POLY_SET *layerPoly = layerPolys[lIdx];
 
         // Add drawing objects
         // /////////////////////////////////////////////////////////////////////
@@ -1072,7 +1036,7 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 
         // This will make a union of all added contours
         layerPoly->Simplify( SHAPE_POLY_SET::PM_FAST );
-    }
+    }, 1 );
     // End Build Tech layers
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
@@ -1089,33 +1053,34 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     if( aStatusTextReporter )
         aStatusTextReporter->Report( _( "Build BVH for holes and vias" ) );
 
-    m_through_holes_inner.BuildBVH();
-    m_through_holes_outer.BuildBVH();
-
-    if( !m_layers_holes2D.empty() )
+    if( ( aLayers & LSET::AllCuMask() ).any() )
     {
-        for( MAP_CONTAINER_2D::iterator ii = m_layers_holes2D.begin();
-             ii != m_layers_holes2D.end();
-             ++ii )
+        m_through_holes_inner.BuildBVH();
+        m_through_holes_outer.BuildBVH();
+
+        if( !m_layers_holes2D.empty() )
         {
-            ((CBVHCONTAINER2D *)(ii->second))->BuildBVH();
+            for( MAP_CONTAINER_2D::iterator ii = m_layers_holes2D.begin();
+                 ii != m_layers_holes2D.end();
+                 ++ii )
+            {
+                ((CBVHCONTAINER2D *)(ii->second))->BuildBVH();
+            }
         }
     }
 
     // We only need the Solder mask to initialize the BVH
     // because..?
-    if( (CBVHCONTAINER2D *)m_layers_container2D[B_Mask] )
+    if( aLayers[B_Mask] && (CBVHCONTAINER2D *)m_layers_container2D[B_Mask] )
         ((CBVHCONTAINER2D *)m_layers_container2D[B_Mask])->BuildBVH();
 
-    if( (CBVHCONTAINER2D *)m_layers_container2D[F_Mask] )
+    if( aLayers[F_Mask] && (CBVHCONTAINER2D *)m_layers_container2D[F_Mask] )
         ((CBVHCONTAINER2D *)m_layers_container2D[F_Mask])->BuildBVH();
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
     unsigned stats_endHolesBVHTime = GetRunningMicroSecs();
 
     printf( "CINFO3D_VISU::createLayers times\n" );
-    printf( "  Copper Layers:          %.3f ms\n",
-            (float)( stats_endCopperLayersTime  - stats_startCopperLayersTime  ) / 1e3 );
     printf( "  Holes BVH creation:     %.3f ms\n",
             (float)( stats_endHolesBVHTime      - stats_startHolesBVHTime      ) / 1e3 );
     printf( "  Tech Layers:            %.3f ms\n",
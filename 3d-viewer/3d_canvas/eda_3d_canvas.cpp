@@ -290,6 +290,13 @@ void EDA_3D_CANVAS::ReloadRequest( BOARD *aBoard , S3D_CACHE *aCachePointer )
 }
 
 
+void EDA_3D_CANVAS::ReloadLayersRequest( const LSET &aLayers )
+{
+    if( m_3d_render )
+        m_3d_render->ReloadLayersRequest( aLayers );
+}
+
+
 void EDA_3D_CANVAS::RenderRaytracingRequest()
 {
     m_3d_render = m_3d_render_raytracing;
@@ -74,6 +74,12 @@ class EDA_3D_CANVAS : public HIDPI_GL_CANVAS
 
     void ReloadRequest( BOARD *aBoard = NULL, S3D_CACHE *aCachePointer = NULL );
 
+    /**
+     * @brief ReloadLayersRequest - Request to rebuild only some layers of the board
+     * @param aLayers: the layers changed on the board
+     */
+    void ReloadLayersRequest( const LSET &aLayers );
+
     /**
      * @brief IsReloadRequestPending - Query if there is a pending reload request
      * @return true if it wants to reload, false if there is no reload pending
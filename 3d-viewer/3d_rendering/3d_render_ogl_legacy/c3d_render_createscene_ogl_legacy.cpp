@@ -35,6 +35,7 @@
 #include "../../3d_fastmath.h"
 #include <trigo.h>
 #include <project.h>
+#include <advanced_config.h>
 #include <profile.h>        // To use GetRunningMicroSecs or another profiling utility
 
 
@@ -338,6 +339,7 @@ CLAYERS_OGL_DISP_LISTS *C3D_RENDER_OGL_LEGACY::generate_holes_display_list(
 void C3D_RENDER_OGL_LEGACY::reload( REPORTER *aStatusTextReporter )
 {
     m_reloadRequested = false;
+    m_reloadLayers.reset();
 
     ogl_free_all_display_lists();
 
@@ -437,6 +439,118 @@ void C3D_RENDER_OGL_LEGACY::reload( REPORTER *aStatusTextReporter )
     if( aStatusTextReporter )
         aStatusTextReporter->Report( _( "Load OpenGL: holes and vias" ) );
 
+    generate_holes_display_lists();
+
+    // Generate vertical cylinders of vias and pads (copper)
+    generate_3D_Vias_and_Pads();
+
+    // Add layers maps
+
+    if( aStatusTextReporter )
+        aStatusTextReporter->Report( _( "Load OpenGL: layers" ) );
+
+    for( MAP_CONTAINER_2D::const_iterator ii = m_settings.GetMapLayers().begin();
+         ii != m_settings.GetMapLayers().end();
+         ++ii )
+    {
+        PCB_LAYER_ID layer_id = static_cast<PCB_LAYER_ID>(ii->first);
+
+        if( !m_settings.Is3DLayerEnabled( layer_id ) )
+            continue;
+
+        generate_layer_display_list( layer_id,
+                                     static_cast<const CBVHCONTAINER2D *>(ii->second) );
+    }// for each layer on map
+
+#ifdef PRINT_STATISTICS_3D_VIEWER
+    unsigned stats_end_OpenGL_Load_Time = GetRunningMicroSecs();
+#endif
+
+    // Load 3D models
+    // /////////////////////////////////////////////////////////////////////////
+#ifdef PRINT_STATISTICS_3D_VIEWER
+    unsigned stats_start_models_Load_Time = GetRunningMicroSecs();
+#endif
+
+    if( aStatusTextReporter )
+        aStatusTextReporter->Report( _( "Loading 3D models" ) );
+
+    load_3D_models( aStatusTextReporter );
+
+#ifdef PRINT_STATISTICS_3D_VIEWER
+    unsigned stats_end_models_Load_Time = GetRunningMicroSecs();
+
+
+    printf( "C3D_RENDER_OGL_LEGACY::reload times:\n" );
+    printf( "  Reload board:             %.3f ms\n",
+            (float)( stats_endReloadTime        - stats_startReloadTime        ) / 1000.0f );
+    printf( "  Loading to openGL:        %.3f ms\n",
+            (float)( stats_end_OpenGL_Load_Time - stats_start_OpenGL_Load_Time ) / 1000.0f );
+    printf( "  Loading 3D models:        %.3f ms\n",
+            (float)( stats_end_models_Load_Time - stats_start_models_Load_Time ) / 1000.0f );
+    COBJECT2D_STATS::Instance().PrintStats();
+#endif
+
+    if( aStatusTextReporter )
+    {
+        // Calculation time in seconds
+        const double calculation_time = (double)( GetRunningMicroSecs() -
+                                                  stats_startReloadTime) / 1e6;
+
+        aStatusTextReporter->Report( wxString::Format( _( "Reload time %.3f s" ),
+                                                       calculation_time ) );
+    }
+}
+
+
+void C3D_RENDER_OGL_LEGACY::reloadLayers( REPORTER *aStatusTextReporter )
+{
+    LSET layers = m_reloadLayers;
+
+    m_reloadLayers.reset();
+
+    // The copper layers are built all together with the holes
+    const bool reloadCopper = ( layers & LSET::AllCuMask() ).any();
+
+    if( reloadCopper )
+        layers |= LSET::AllCuMask();
+
+    m_settings.UpdateLayers( aStatusTextReporter, layers );
+
+    if( aStatusTextReporter )
+        aStatusTextReporter->Report( _( "Load OpenGL: layers" ) );
+
+    if( reloadCopper )
+    {
+        ogl_free_holes_display_lists();
+        generate_holes_display_lists();
+        generate_3D_Vias_and_Pads();
+    }
+
+    const MAP_CONTAINER_2D &map_layers = m_settings.GetMapLayers();
+
+    for( LSEQ seq = layers.Seq(); seq; ++seq )
+    {
+        const PCB_LAYER_ID layer_id = *seq;
+
+        ogl_free_layer_display_list( layer_id );
+
+        MAP_CONTAINER_2D::const_iterator ii = map_layers.find( layer_id );
+
+        if( ( ii != map_layers.end() ) && ii->second && m_settings.Is3DLayerEnabled( layer_id ) )
+            generate_layer_display_list( layer_id, ii->second );
+    }
+
+    // Only the models of new footprints are loaded, the others are in the map already
+    load_3D_models( NULL );
+
+    // The footprints may have been moved
+    m_3dmodel_batches_valid = false;
+}
+
+
+void C3D_RENDER_OGL_LEGACY::generate_holes_display_lists()
+{
     m_ogl_disp_list_through_holes_outer = generate_holes_display_list(
                 m_settings.GetThroughHole_Outer().GetList(),
                 m_settings.GetThroughHole_Outer_poly(),
@@ -518,140 +632,87 @@ void C3D_RENDER_OGL_LEGACY::reload( REPORTER *aStatusTextReporter )
                         container->GetList(), *poly, layer_z_top, layer_z_bot, false );
         }
     }
+}
 
-    // Generate vertical cylinders of vias and pads (copper)
-    generate_3D_Vias_and_Pads();
-
-    // Add layers maps
-
-    if( aStatusTextReporter )
-        aStatusTextReporter->Report( _( "Load OpenGL: layers" ) );
-
-    for( MAP_CONTAINER_2D::const_iterator ii = m_settings.GetMapLayers().begin();
-         ii != m_settings.GetMapLayers().end();
-         ++ii )
-    {
-        PCB_LAYER_ID layer_id = static_cast<PCB_LAYER_ID>(ii->first);
-
-        if( !m_settings.Is3DLayerEnabled( layer_id ) )
-            continue;
-
-        const CBVHCONTAINER2D *container2d = static_cast<const CBVHCONTAINER2D *>(ii->second);
-        const LIST_OBJECT2D &listObject2d = container2d->GetList();
-
-        if( listObject2d.size() == 0 )
-            continue;
-
-        float layer_z_bot = 0.0f;
-        float layer_z_top = 0.0f;
-
-        get_layer_z_pos( layer_id, layer_z_top, layer_z_bot );
-
-        // Calculate an estimation for the nr of triangles based on the nr of objects
-        unsigned int nrTrianglesEstimation = listObject2d.size() * 8;
-
-        CLAYER_TRIANGLES *layerTriangles = new CLAYER_TRIANGLES( nrTrianglesEstimation );
-
-        m_triangles[layer_id] = layerTriangles;
 
-        // Load the 2D (X,Y axis) component of shapes
-        for( LIST_OBJECT2D::const_iterator itemOnLayer = listObject2d.begin();
-             itemOnLayer != listObject2d.end();
-             ++itemOnLayer )
-        {
-            const COBJECT2D *object2d_A = static_cast<const COBJECT2D *>(*itemOnLayer);
+void C3D_RENDER_OGL_LEGACY::generate_layer_display_list( PCB_LAYER_ID aLayerID,
+                                                         const CBVHCONTAINER2D *aContainer )
+{
+    const LIST_OBJECT2D &listObject2d = aContainer->GetList();
 
-            switch( object2d_A->GetObjectType() )
-            {
-            case OBJ2D_FILLED_CIRCLE:
-                add_object_to_triangle_layer( (const CFILLEDCIRCLE2D *)object2d_A,
-                                              layerTriangles, layer_z_top, layer_z_bot );
-                break;
+    if( listObject2d.size() == 0 )
+        return;
 
-            case OBJ2D_POLYGON4PT:
-                add_object_to_triangle_layer( (const CPOLYGON4PTS2D *)object2d_A,
-                                              layerTriangles, layer_z_top, layer_z_bot );
-                break;
+    float layer_z_bot = 0.0f;
+    float layer_z_top = 0.0f;
 
-            case OBJ2D_RING:
-                add_object_to_triangle_layer( (const CRING2D *)object2d_A,
-                                              layerTriangles, layer_z_top, layer_z_bot );
-                break;
+    get_layer_z_pos( aLayerID, layer_z_top, layer_z_bot );
 
-            case OBJ2D_TRIANGLE:
-                add_object_to_triangle_layer( (const CTRIANGLE2D *)object2d_A,
-                                              layerTriangles, layer_z_top, layer_z_bot );
-                break;
+    // Calculate an estimation for the nr of triangles based on the nr of objects
+    unsigned int nrTrianglesEstimation = listObject2d.size() * 8;
 
-            case OBJ2D_ROUNDSEG:
-                add_object_to_triangle_layer( (const CROUNDSEGMENT2D *) object2d_A,
-                                              layerTriangles, layer_z_top, layer_z_bot );
-                break;
+    CLAYER_TRIANGLES *layerTriangles = new CLAYER_TRIANGLES( nrTrianglesEstimation );
 
-            default:
-                wxFAIL_MSG("C3D_RENDER_OGL_LEGACY: Object type is not implemented");
-                break;
-            }
-        }
+    m_triangles[aLayerID] = layerTriangles;
 
-        const MAP_POLY &map_poly = m_settings.GetPolyMap();
+    // Load the 2D (X,Y axis) component of shapes
+    for( LIST_OBJECT2D::const_iterator itemOnLayer = listObject2d.begin();
+         itemOnLayer != listObject2d.end();
+         ++itemOnLayer )
+    {
+        const COBJECT2D *object2d_A = static_cast<const COBJECT2D *>(*itemOnLayer);
 
-        // Load the vertical (Z axis)  component of shapes
-        if( map_poly.find( layer_id ) != map_poly.end() )
+        switch( object2d_A->GetObjectType() )
         {
-            const SHAPE_POLY_SET *polyList = map_poly.at( layer_id );
-
-            if( polyList->OutlineCount() > 0 )
-                layerTriangles->AddToMiddleContourns( *polyList, layer_z_bot, layer_z_top,
-                                                      m_settings.BiuTo3Dunits(), false );
+        case OBJ2D_FILLED_CIRCLE:
+            add_object_to_triangle_layer( (const CFILLEDCIRCLE2D *)object2d_A,
+                                          layerTriangles, layer_z_top, layer_z_bot );
+            break;
+
+        case OBJ2D_POLYGON4PT:
+            add_object_to_triangle_layer( (const CPOLYGON4PTS2D *)object2d_A,
+                                          layerTriangles, layer_z_top, layer_z_bot );
+            break;
+
+        case OBJ2D_RING:
+            add_object_to_triangle_layer( (const CRING2D *)object2d_A,
+                                          layerTriangles, layer_z_top, layer_z_bot );
+            break;
+
+        case OBJ2D_TRIANGLE:
+            add_object_to_triangle_layer( (const CTRIANGLE2D *)object2d_A,
+                                          layerTriangles, layer_z_top, layer_z_bot );
+            break;
+
+        case OBJ2D_ROUNDSEG:
+            add_object_to_triangle_layer( (const CROUNDSEGMENT2D *) object2d_A,
+                                          layerTriangles, layer_z_top, layer_z_bot );
+            break;
+
+        default:
+            wxFAIL_MSG("C3D_RENDER_OGL_LEGACY: Object type is not implemented");
+            break;
         }
+    }
 
-        // Create display list
-        // /////////////////////////////////////////////////////////////////////
-        m_ogl_disp_lists_layers[layer_id] = new CLAYERS_OGL_DISP_LISTS( *layerTriangles,
-                                                                        m_ogl_circle_texture,
-                                                                        layer_z_bot,
-                                                                        layer_z_top );
-    }// for each layer on map
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    unsigned stats_end_OpenGL_Load_Time = GetRunningMicroSecs();
-#endif
-
-    // Load 3D models
-    // /////////////////////////////////////////////////////////////////////////
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    unsigned stats_start_models_Load_Time = GetRunningMicroSecs();
-#endif
-
-    if( aStatusTextReporter )
-        aStatusTextReporter->Report( _( "Loading 3D models" ) );
-
-    load_3D_models( aStatusTextReporter );
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    unsigned stats_end_models_Load_Time = GetRunningMicroSecs();
-
-
-    printf( "C3D_RENDER_OGL_LEGACY::reload times:\n" );
-    printf( "  Reload board:             %.3f ms\n",
-            (float)( stats_endReloadTime        - stats_startReloadTime        ) / 1000.0f );
-    printf( "  Loading to openGL:        %.3f ms\n",
-            (float)( stats_end_OpenGL_Load_Time - stats_start_OpenGL_Load_Time ) / 1000.0f );
-    printf( "  Loading 3D models:        %.3f ms\n",
-            (float)( stats_end_models_Load_Time - stats_start_models_Load_Time ) / 1000.0f );
-    COBJECT2D_STATS::Instance().PrintStats();
-#endif
+    const MAP_POLY &map_poly = m_settings.GetPolyMap();
 
-    if( aStatusTextReporter )
+    // Load the vertical (Z axis)  component of shapes
+    if( map_poly.find( aLayerID ) != map_poly.end() )
     {
-        // Calculation time in seconds
-        const double calculation_time = (double)( GetRunningMicroSecs() -
-                                                  stats_startReloadTime) / 1e6;
+        const SHAPE_POLY_SET *polyList = map_poly.at( aLayerID );
 
-        aStatusTextReporter->Report( wxString::Format( _( "Reload time %.3f s" ),
-                                                       calculation_time ) );
+        if( polyList->OutlineCount() > 0 )
+            layerTriangles->AddToMiddleContourns( *polyList, layer_z_bot, layer_z_top,
+                                                  m_settings.BiuTo3Dunits(), false );
     }
+
+    // Create display list
+    // /////////////////////////////////////////////////////////////////////////
+    m_ogl_disp_lists_layers[aLayerID] = new CLAYERS_OGL_DISP_LISTS( *layerTriangles,
+                                                                    m_ogl_circle_texture,
+                                                                    layer_z_bot,
+                                                                    layer_z_top );
 }
 
 
@@ -902,6 +963,35 @@ void C3D_RENDER_OGL_LEGACY::load_3D_models( REPORTER *aStatusTextReporter )
         (!m_settings.GetFlag( FL_MODULE_ATTRIBUTES_VIRTUAL )) )
         return;
 
+    if( !m_settings.Get3DCacheManager() )
+        return;
+
+    std::vector<wxString> modelFiles;
+
+    for( auto module : m_settings.GetBoard()->Modules() )
+    {
+        for( const MODULE_3D_SETTINGS& model : module->Models() )
+        {
+            if( !model.m_Filename.empty()
+                && m_3dmodel_map.find( model.m_Filename ) == m_3dmodel_map.end() )
+                modelFiles.push_back( model.m_Filename );
+        }
+    }
+
+    const bool useLODs = ADVANCED_CFG::GetCfg().m_model3DLevelOfDetail;
+
+    // Load the model files on the thread pool first, the loop below gets them from the cache
+    m_settings.Get3DCacheManager()->LoadModels( modelFiles, useLODs,
+            [&]( size_t aLoaded, size_t aCount )
+            {
+                if( aStatusTextReporter )
+                {
+                    aStatusTextReporter->Report( wxString::Format( _( "Loading 3D models %u/%u" ),
+                                                                   (unsigned) aLoaded,
+                                                                   (unsigned) aCount ) );
+                }
+            } );
+
     // Go for all modules
     for( auto module : m_settings.GetBoard()->Modules() )
     {
@@ -942,6 +1032,26 @@ void C3D_RENDER_OGL_LEGACY::load_3D_models( REPORTER *aStatusTextReporter )
 
                             if( ogl_model )
                                 m_3dmodel_map[ sM->m_Filename ] = ogl_model;
+
+                            // Models drawn small on the screen use a decimated level
+                            std::vector<C_OGL_3DMODEL*> lods;
+
+                            for( unsigned int level = 1;
+                                 useLODs && level <= S3D_CACHE::LOD_LEVELS;
+                                 ++level )
+                            {
+                                const S3DMODEL *lodPtr =
+                                        m_settings.Get3DCacheManager()->GetModelLOD(
+                                                sM->m_Filename, level );
+
+                                lods.push_back( lodPtr ? new C_OGL_3DMODEL(
+                                                                 *lodPtr,
+                                                                 m_settings.MaterialModeGet() )
+                                                       : NULL );
+                            }
+
+                            if( !lods.empty() )
+                                m_3dmodel_lods[ sM->m_Filename ] = lods;
                         }
                     }
                 }
@@ -68,6 +68,7 @@ C3D_RENDER_OGL_LEGACY::C3D_RENDER_OGL_LEGACY( CINFO3D_VISU &aSettings ) :
     m_last_grid_type = GRID3D_NONE;
 
     m_3dmodel_map.clear();
+    m_3dmodel_batches_valid = false;
 }
 
 
@@ -460,6 +461,20 @@ void init_lights(void)
 }
 
 
+void C3D_RENDER_OGL_LEGACY::ReloadLayersRequest( const LSET &aLayers )
+{
+    // The board outline sets the body, the bounding box and the scale of the scene
+    if( aLayers[Edge_Cuts] || aLayers[Margin] )
+        m_reloadRequested = true;
+
+    // A pending full reload will rebuild these layers too
+    if( m_reloadRequested )
+        m_reloadLayers.reset();
+    else
+        m_reloadLayers |= aLayers;
+}
+
+
 bool C3D_RENDER_OGL_LEGACY::Redraw( bool aIsMoving,
                                     REPORTER *aStatusTextReporter )
 {
@@ -486,6 +501,14 @@ bool C3D_RENDER_OGL_LEGACY::Redraw( bool aIsMoving,
     }
     else
     {
+        // Only some layers were changed, the board outline and the models are kept
+        if( m_reloadLayers.any() )
+        {
+            std::unique_ptr<BUSY_INDICATOR> busy = CreateBusyIndicator();
+
+            reloadLayers( aStatusTextReporter );
+        }
+
         // Check if grid was changed
         if( m_settings.GridGet() != m_last_grid_type )
         {
@@ -849,28 +872,6 @@ void C3D_RENDER_OGL_LEGACY::ogl_free_all_display_lists()
 
     m_ogl_disp_lists_layers.clear();
 
-
-    for( MAP_OGL_DISP_LISTS::const_iterator ii = m_ogl_disp_lists_layers_holes_outer.begin();
-         ii != m_ogl_disp_lists_layers_holes_outer.end();
-         ++ii )
-    {
-        CLAYERS_OGL_DISP_LISTS *pLayerDispList = static_cast<CLAYERS_OGL_DISP_LISTS*>(ii->second);
-        delete pLayerDispList;
-    }
-
-    m_ogl_disp_lists_layers_holes_outer.clear();
-
-
-    for( MAP_OGL_DISP_LISTS::const_iterator ii = m_ogl_disp_lists_layers_holes_inner.begin();
-         ii != m_ogl_disp_lists_layers_holes_inner.end();
-         ++ii )
-    {
-        CLAYERS_OGL_DISP_LISTS *pLayerDispList = static_cast<CLAYERS_OGL_DISP_LISTS*>(ii->second);
-        delete pLayerDispList;
-    }
-
-    m_ogl_disp_lists_layers_holes_inner.clear();
-
     for( MAP_TRIANGLES::const_iterator ii = m_triangles.begin();
          ii != m_triangles.end();
          ++ii )
@@ -881,6 +882,7 @@ void C3D_RENDER_OGL_LEGACY::ogl_free_all_display_lists()
 
     m_triangles.clear();
 
+    ogl_free_holes_display_lists();
 
     for( MAP_3DMODEL::const_iterator ii = m_3dmodel_map.begin();
          ii != m_3dmodel_map.end();
@@ -892,9 +894,43 @@ void C3D_RENDER_OGL_LEGACY::ogl_free_all_display_lists()
 
     m_3dmodel_map.clear();
 
+    for( auto& lods : m_3dmodel_lods )
+    {
+        for( C_OGL_3DMODEL* lod : lods.second )
+            delete lod;
+    }
+
+    m_3dmodel_lods.clear();
+    m_3dmodel_batches_valid = false;
+
 
     delete m_ogl_disp_list_board;
     m_ogl_disp_list_board = 0;
+}
+
+
+void C3D_RENDER_OGL_LEGACY::ogl_free_holes_display_lists()
+{
+    for( MAP_OGL_DISP_LISTS::const_iterator ii = m_ogl_disp_lists_layers_holes_outer.begin();
+         ii != m_ogl_disp_lists_layers_holes_outer.end();
+         ++ii )
+    {
+        CLAYERS_OGL_DISP_LISTS *pLayerDispList = static_cast<CLAYERS_OGL_DISP_LISTS*>(ii->second);
+        delete pLayerDispList;
+    }
+
+    m_ogl_disp_lists_layers_holes_outer.clear();
+
+
+    for( MAP_OGL_DISP_LISTS::const_iterator ii = m_ogl_disp_lists_layers_holes_inner.begin();
+         ii != m_ogl_disp_lists_layers_holes_inner.end();
+         ++ii )
+    {
+        CLAYERS_OGL_DISP_LISTS *pLayerDispList = static_cast<CLAYERS_OGL_DISP_LISTS*>(ii->second);
+        delete pLayerDispList;
+    }
+
+    m_ogl_disp_lists_layers_holes_inner.clear();
 
     delete m_ogl_disp_list_through_holes_outer_with_npth;
     m_ogl_disp_list_through_holes_outer_with_npth = 0;
@@ -919,6 +955,26 @@ void C3D_RENDER_OGL_LEGACY::ogl_free_all_display_lists()
 }
 
 
+void C3D_RENDER_OGL_LEGACY::ogl_free_layer_display_list( PCB_LAYER_ID aLayerID )
+{
+    MAP_OGL_DISP_LISTS::iterator dispList = m_ogl_disp_lists_layers.find( aLayerID );
+
+    if( dispList != m_ogl_disp_lists_layers.end() )
+    {
+        delete dispList->second;
+        m_ogl_disp_lists_layers.erase( dispList );
+    }
+
+    MAP_TRIANGLES::iterator triangles = m_triangles.find( aLayerID );
+
+    if( triangles != m_triangles.end() )
+    {
+        delete triangles->second;
+        m_triangles.erase( triangles );
+    }
+}
+
+
 void C3D_RENDER_OGL_LEGACY::render_solder_mask_layer( PCB_LAYER_ID aLayerID,
                                                       float aZPosition,
                                                       bool aIsRenderingOnPreviewMode )
@@ -976,114 +1032,197 @@ void C3D_RENDER_OGL_LEGACY::render_solder_mask_layer( PCB_LAYER_ID aLayerID,
 }
 
 
-void C3D_RENDER_OGL_LEGACY::render_3D_models( bool aRenderTopOrBot,
-                                              bool aRenderTransparentOnly )
+void C3D_RENDER_OGL_LEGACY::build_3D_model_batches()
 {
+    m_3dmodel_batches.clear();
+    m_3dmodel_batches_valid = true;
+
+    // The index of the batch of each loaded model
+    std::map< const C_OGL_3DMODEL *, size_t > batchIndex;
+
+    const double modelunit_to_3d_units_factor = m_settings.BiuTo3Dunits() * UNITS3D_TO_UNITSPCB;
+
     // Go for all modules
     for( auto module : m_settings.GetBoard()->Modules() )
     {
-        if( !module->Models().empty() )
-            if( m_settings.ShouldModuleBeDisplayed( (MODULE_ATTR_T) module->GetAttributes() ) )
-                if( ( aRenderTopOrBot && !module->IsFlipped() )
-                        || ( !aRenderTopOrBot && module->IsFlipped() ) )
-                    render_3D_module( module, aRenderTransparentOnly );
-    }
-}
-
+        if( module->Models().empty() )
+            continue;
 
-void C3D_RENDER_OGL_LEGACY::render_3D_module( const MODULE* module,
-                                              bool aRenderTransparentOnly )
-{
-    if( !module->Models().empty() )
-    {
         const double zpos = m_settings.GetModulesZcoord3DIU( module->IsFlipped() );
+        const wxPoint pos = module->GetPosition();
 
-        glPushMatrix();
-
-        wxPoint pos = module->GetPosition();
-
-        glTranslatef(  pos.x * m_settings.BiuTo3Dunits(),
-                      -pos.y * m_settings.BiuTo3Dunits(),
-                       zpos );
+        // Same transform as the one of the openGL matrix stack, from the board to the model
+        glm::mat4 moduleMatrix = glm::translate( glm::mat4( 1.0f ),
+                                                 SFVEC3F(  pos.x * m_settings.BiuTo3Dunits(),
+                                                          -pos.y * m_settings.BiuTo3Dunits(),
+                                                           zpos ) );
 
         if( module->GetOrientation() )
-            glRotated( (double) module->GetOrientation() / 10.0, 0.0, 0.0, 1.0 );
+            moduleMatrix = glm::rotate( moduleMatrix,
+                                        glm::radians( (float)( module->GetOrientation() / 10.0 ) ),
+                                        SFVEC3F( 0.0f, 0.0f, 1.0f ) );
 
         if( module->IsFlipped() )
         {
-            glRotatef( 180.0f, 0.0f, 1.0f, 0.0f );
-            glRotatef( 180.0f, 0.0f, 0.0f, 1.0f );
+            moduleMatrix = glm::rotate( moduleMatrix, glm::pi<float>(),
+                                        SFVEC3F( 0.0f, 1.0f, 0.0f ) );
+            moduleMatrix = glm::rotate( moduleMatrix, glm::pi<float>(),
+                                        SFVEC3F( 0.0f, 0.0f, 1.0f ) );
         }
 
-        double modelunit_to_3d_units_factor = m_settings.BiuTo3Dunits() * UNITS3D_TO_UNITSPCB;
+        moduleMatrix = glm::scale( moduleMatrix, SFVEC3F( modelunit_to_3d_units_factor ) );
 
-        glScaled( modelunit_to_3d_units_factor,
-                  modelunit_to_3d_units_factor,
-                  modelunit_to_3d_units_factor );
+        for( const MODULE_3D_SETTINGS& sM : module->Models() )
+        {
+            if( sM.m_Filename.empty() )
+                continue;
 
-        // Get the list of model files for this model
-        auto sM = module->Models().begin();
-        auto eM = module->Models().end();
+            // Check if the model is present in our cache map
+            MAP_3DMODEL::const_iterator model = m_3dmodel_map.find( sM.m_Filename );
 
-        while( sM != eM )
-        {
-            if( !sM->m_Filename.empty() )
+            if( model == m_3dmodel_map.end() || !model->second )
+                continue;
+
+            MODEL_INSTANCE instance;
+
+            instance.m_transform = glm::translate( moduleMatrix, SFVEC3F( sM.m_Offset.x,
+                                                                          sM.m_Offset.y,
+                                                                          sM.m_Offset.z ) );
+
+            instance.m_transform = glm::rotate( instance.m_transform,
+                                                glm::radians( (float) -sM.m_Rotation.z ),
+                                                SFVEC3F( 0.0f, 0.0f, 1.0f ) );
+            instance.m_transform = glm::rotate( instance.m_transform,
+                                                glm::radians( (float) -sM.m_Rotation.y ),
+                                                SFVEC3F( 0.0f, 1.0f, 0.0f ) );
+            instance.m_transform = glm::rotate( instance.m_transform,
+                                                glm::radians( (float) -sM.m_Rotation.x ),
+                                                SFVEC3F( 1.0f, 0.0f, 0.0f ) );
+
+            instance.m_transform = glm::scale( instance.m_transform, SFVEC3F( sM.m_Scale.x,
+                                                                              sM.m_Scale.y,
+                                                                              sM.m_Scale.z ) );
+
+            instance.m_attributes = (MODULE_ATTR_T) module->GetAttributes();
+            instance.m_isFlipped = module->IsFlipped();
+
+            auto index = batchIndex.find( model->second );
+
+            if( index == batchIndex.end() )
             {
-                // Check if the model is present in our cache map
-                if( m_3dmodel_map.find( sM->m_Filename ) != m_3dmodel_map.end() )
+                index = batchIndex.emplace( model->second, m_3dmodel_batches.size() ).first;
+                m_3dmodel_batches.emplace_back();
+                m_3dmodel_batches.back().m_model = model->second;
+
+                MAP_3DMODEL_LODS::const_iterator lods = m_3dmodel_lods.find( sM.m_Filename );
+
+                if( lods != m_3dmodel_lods.end() )
                 {
-                    // It is not present, try get it from cache
-                    const C_OGL_3DMODEL *modelPtr = m_3dmodel_map[ sM->m_Filename ];
+                    m_3dmodel_batches.back().m_lods.assign( lods->second.begin(),
+                                                            lods->second.end() );
+                }
+            }
 
-                    if( modelPtr )
-                    {
-                        if( ( (!aRenderTransparentOnly) && modelPtr->Have_opaque() ) ||
-                            ( aRenderTransparentOnly && modelPtr->Have_transparent() ) )
-                        {
-                            glPushMatrix();
+            m_3dmodel_batches[index->second].m_instances.push_back( instance );
+        }
+    }
+}
 
-                            glTranslatef( sM->m_Offset.x, sM->m_Offset.y, sM->m_Offset.z );
 
-                            glRotatef( -sM->m_Rotation.z, 0.0f, 0.0f, 1.0f );
-                            glRotatef( -sM->m_Rotation.y, 0.0f, 1.0f, 0.0f );
-                            glRotatef( -sM->m_Rotation.x, 1.0f, 0.0f, 0.0f );
+void C3D_RENDER_OGL_LEGACY::render_3D_models( bool aRenderTopOrBot,
+                                              bool aRenderTransparentOnly )
+{
+    if( !m_3dmodel_batches_valid )
+        build_3D_model_batches();
 
-                            glScalef( sM->m_Scale.x, sM->m_Scale.y, sM->m_Scale.z );
+    const glm::mat4 viewProjection = m_settings.CameraGet().GetProjectionMatrix()
+                                     * m_settings.CameraGet().GetViewMatrix();
 
-                            if( aRenderTransparentOnly )
-                                modelPtr->Draw_transparent();
-                            else
-                                modelPtr->Draw_opaque();
+    // All the instances of a model are drawn together, so its display lists stay hot
+    for( const MODEL_BATCH& batch : m_3dmodel_batches )
+    {
+        const C_OGL_3DMODEL *modelPtr = batch.m_model;
 
-                            if( m_settings.GetFlag( FL_RENDER_OPENGL_SHOW_MODEL_BBOX ) )
-                            {
-                                glEnable( GL_BLEND );
-                                glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+        if( ( (!aRenderTransparentOnly) && !modelPtr->Have_opaque() ) ||
+            ( aRenderTransparentOnly && !modelPtr->Have_transparent() ) )
+            continue;
 
-                                glLineWidth( 1 );
-                                modelPtr->Draw_bboxes();
+        for( const MODEL_INSTANCE& instance : batch.m_instances )
+        {
+            if( instance.m_isFlipped == aRenderTopOrBot )
+                continue;
 
-                                glDisable( GL_LIGHTING );
+            if( !m_settings.ShouldModuleBeDisplayed( instance.m_attributes ) )
+                continue;
 
-                                glColor4f( 0.0f, 1.0f, 0.0f, 1.0f );
+            glPushMatrix();
 
-                                glLineWidth( 4 );
-                                modelPtr->Draw_bbox();
+            glMultMatrixf( glm::value_ptr( instance.m_transform ) );
 
-                                glEnable( GL_LIGHTING );
-                            }
+            const C_OGL_3DMODEL* lodPtr = get_3D_model_lod( batch, instance, viewProjection );
 
-                            glPopMatrix();
-                        }
-                    }
-                }
+            if( aRenderTransparentOnly )
+                lodPtr->Draw_transparent();
+            else
+                lodPtr->Draw_opaque();
+
+            if( m_settings.GetFlag( FL_RENDER_OPENGL_SHOW_MODEL_BBOX ) )
+            {
+                glEnable( GL_BLEND );
+                glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+
+                glLineWidth( 1 );
+                modelPtr->Draw_bboxes();
+
+                glDisable( GL_LIGHTING );
+
+                glColor4f( 0.0f, 1.0f, 0.0f, 1.0f );
+
+                glLineWidth( 4 );
+                modelPtr->Draw_bbox();
+
+                glEnable( GL_LIGHTING );
             }
 
-            ++sM;
+            glPopMatrix();
         }
+    }
+}
 
-        glPopMatrix();
+
+const C_OGL_3DMODEL* C3D_RENDER_OGL_LEGACY::get_3D_model_lod(
+        const MODEL_BATCH& aBatch, const MODEL_INSTANCE& aInstance,
+        const glm::mat4& aViewProjection ) const
+{
+    if( aBatch.m_lods.empty() )
+        return aBatch.m_model;
+
+    const CBBOX& bbox = aBatch.m_model->GetBBox();
+    const glm::vec4 center = aViewProjection * aInstance.m_transform
+                             * glm::vec4( bbox.GetCenter(), 1.0f );
+
+    // The model is behind the camera, or too close to use a level of detail
+    if( center.w <= FLT_EPSILON )
+        return aBatch.m_model;
+
+    const float scale = glm::max( glm::length( SFVEC3F( aInstance.m_transform[0] ) ),
+                                  glm::max( glm::length( SFVEC3F( aInstance.m_transform[1] ) ),
+                                            glm::length( SFVEC3F( aInstance.m_transform[2] ) ) ) );
+
+    // Diameter of the bounding sphere of the model, in pixels
+    const float diameter = glm::length( bbox.GetExtent() ) * scale
+                           * m_settings.CameraGet().GetProjectionMatrix()[1][1]
+                           * m_windowSize.y * 0.5f / center.w;
+
+    // The coarsest level whose grid cells are at most two pixels wide
+    for( unsigned int level = aBatch.m_lods.size(); level >= 1; --level )
+    {
+        if( aBatch.m_lods[level - 1]
+            && diameter <= 2.0f * S3D_CACHE::GetLODGridSize( level ) )
+            return aBatch.m_lods[level - 1];
     }
+
+    return aBatch.m_model;
 }
 
 
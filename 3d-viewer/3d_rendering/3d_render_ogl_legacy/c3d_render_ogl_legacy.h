@@ -45,11 +45,13 @@
 #include "3d_cache/3d_info.h"
 
 #include <map>
+#include <vector>
 
 
 typedef std::map< PCB_LAYER_ID, CLAYERS_OGL_DISP_LISTS* > MAP_OGL_DISP_LISTS;
 typedef std::map< PCB_LAYER_ID, CLAYER_TRIANGLES * > MAP_TRIANGLES;
 typedef std::map< wxString, C_OGL_3DMODEL * > MAP_3DMODEL;
+typedef std::map< wxString, std::vector<C_OGL_3DMODEL *> > MAP_3DMODEL_LODS;
 
 #define SIZE_OF_CIRCLE_TEXTURE 1024
 
@@ -66,6 +68,7 @@ public:
     // Imported from C3D_RENDER_BASE
     void SetCurWindowSize( const wxSize &aSize ) override;
     bool Redraw( bool aIsMoving, REPORTER *aStatusTextReporter ) override;
+    void ReloadLayersRequest( const LSET &aLayers ) override;
 
     int GetWaitForEditingTimeOut() override;
 
@@ -73,9 +76,17 @@ private:
     bool initializeOpenGL();
     void reload( REPORTER *aStatusTextReporter );
 
+    /**
+     * @brief reloadLayers - Rebuild the layers flagged by ReloadLayersRequest, and
+     * their display lists.  The board body and the 3D models are kept.
+     */
+    void reloadLayers( REPORTER *aStatusTextReporter );
+
     void ogl_set_arrow_material();
 
     void ogl_free_all_display_lists();
+    void ogl_free_holes_display_lists();
+    void ogl_free_layer_display_list( PCB_LAYER_ID aLayerID );
     MAP_OGL_DISP_LISTS      m_ogl_disp_lists_layers;
     MAP_OGL_DISP_LISTS      m_ogl_disp_lists_layers_holes_outer;
     MAP_OGL_DISP_LISTS      m_ogl_disp_lists_layers_holes_inner;
@@ -106,6 +117,29 @@ private:
 
     MAP_3DMODEL m_3dmodel_map;
 
+    /// The decimated levels of detail of the loaded models, from the finest to the
+    /// coarsest, NULL for the levels a model does not have
+    MAP_3DMODEL_LODS m_3dmodel_lods;
+
+    /// A loaded model placed on the board by a footprint
+    struct MODEL_INSTANCE
+    {
+        glm::mat4     m_transform;      ///< from the model to the board 3D units
+        MODULE_ATTR_T m_attributes;     ///< the attributes of the footprint
+        bool          m_isFlipped;      ///< the footprint is on the bottom side
+    };
+
+    /// All the instances of a loaded model, drawn one after another
+    struct MODEL_BATCH
+    {
+        const C_OGL_3DMODEL*              m_model;
+        std::vector<const C_OGL_3DMODEL*> m_lods;   ///< see m_3dmodel_lods
+        std::vector<MODEL_INSTANCE>       m_instances;
+    };
+
+    std::vector<MODEL_BATCH> m_3dmodel_batches;
+    bool                     m_3dmodel_batches_valid;  ///< false when the footprints changed
+
 private:
     void generate_through_outer_holes();
     void generate_through_inner_holes();
@@ -172,6 +206,11 @@ private:
                             unsigned int aNr_sides_per_circle,
                             CLAYER_TRIANGLES *aDstLayer );
 
+    void generate_holes_display_lists();
+
+    void generate_layer_display_list( PCB_LAYER_ID aLayerID,
+                                      const CBVHCONTAINER2D *aContainer );
+
     void generate_3D_Vias_and_Pads();
 
     void load_3D_models( REPORTER *aStatusTextReporter );
@@ -184,7 +223,21 @@ private:
      */
     void render_3D_models( bool aRenderTopOrBot, bool aRenderTransparentOnly );
 
-    void render_3D_module( const MODULE* module, bool aRenderTransparentOnly );
+    /**
+     * @brief build_3D_model_batches - group the models of the footprints by loaded
+     * model, and compute their transforms once for all the next renders
+     */
+    void build_3D_model_batches();
+
+    /**
+     * @brief get_3D_model_lod - choose the level of detail of a model instance, from the
+     * size of the model on the screen
+     * @param aViewProjection - the view and projection matrices of the camera
+     * @return the model to draw the instance with
+     */
+    const C_OGL_3DMODEL* get_3D_model_lod( const MODEL_BATCH& aBatch,
+                                           const MODEL_INSTANCE& aInstance,
+                                           const glm::mat4& aViewProjection ) const;
 
     void setLight_Front( bool enabled );
     void setLight_Top( bool enabled );
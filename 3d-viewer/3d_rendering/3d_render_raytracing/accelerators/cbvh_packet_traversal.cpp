@@ -28,6 +28,7 @@
  */
 
 #include "cbvh_pbrt.h"
+#include "../shapes3D/ctriangle.h"
 #include <wx/debug.h>
 
 
@@ -45,48 +46,47 @@ struct StackNode
 };
 
 
-static inline unsigned int getFirstHit( const RAYPACKET &aRayPacket,
-                                        const CBBOX &aBBox,
-                                        unsigned int ia,
-                                        HITINFO_PACKET *aHitInfoPacket )
-{
-    float hitT;
-
-    if( aBBox.Intersect( aRayPacket.m_ray[ia], &hitT ) )
-        if( hitT < aHitInfoPacket[ia].m_HitInfo.m_tHit )
-            return ia;
+#ifdef BVH_RANGED_TRAVERSAL
 
-    if( !aRayPacket.m_Frustum.Intersect( aBBox ) )
-        return RAYPACKET_RAYS_PER_PACKET;
+///> @return the index of the first ray of the non empty set aRays
+static inline unsigned int firstRay( uint64_t aRays )
+{
+#ifdef __GNUC__
+    return __builtin_ctzll( aRays );
+#else
+    unsigned int i = 0;
 
-    for( unsigned int i = ia + 1; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+    while( !( aRays & 1 ) )
     {
-        if( aBBox.Intersect( aRayPacket.m_ray[i], &hitT ) )
-            if( hitT < aHitInfoPacket[i].m_HitInfo.m_tHit )
-                return i;
+        aRays >>= 1;
+        ++i;
     }
 
-    return RAYPACKET_RAYS_PER_PACKET;
+    return i;
+#endif
 }
 
 
-#ifdef BVH_RANGED_TRAVERSAL
-
-static inline unsigned int getLastHit( const RAYPACKET &aRayPacket,
-                                       const CBBOX &aBBox,
-                                       unsigned int ia,
-                                       HITINFO_PACKET *aHitInfoPacket )
+///> @return the index of the last ray of the non empty set aRays
+static inline unsigned int lastRay( uint64_t aRays )
 {
-    for( unsigned int ie = (RAYPACKET_RAYS_PER_PACKET - 1); ie > ia; --ie )
-    {
-        float hitT;
+#ifdef __GNUC__
+    return 63 - __builtin_clzll( aRays );
+#else
+    unsigned int i = 63;
 
-        if( aBBox.Intersect( aRayPacket.m_ray[ie], &hitT ) )
-            if( hitT < aHitInfoPacket[ie].m_HitInfo.m_tHit )
-                return ie + 1;
-    }
+    while( !( aRays >> i ) )
+        --i;
 
-    return ia + 1;
+    return i;
+#endif
+}
+
+
+///> @return the set of the rays from aFirst to aLast
+static inline uint64_t rayRange( unsigned int aFirst, unsigned int aLast )
+{
+    return ( ~(uint64_t)0 << aFirst ) & ( ~(uint64_t)0 >> ( 63 - aLast ) );
 }
 
 
@@ -94,6 +94,9 @@ static inline unsigned int getLastHit( const RAYPACKET &aRayPacket,
 // http://cseweb.ucsd.edu/~ravir/whitted.pdf
 
 // Ranged Traversal
+// The rays are tested four at a time against the boxes of the nodes and against the
+// triangles, which are most of the primitives of a board with 3D models.  Only the
+// triangles found by the packet test are tested by the exact Intersect.
 bool CBVH_PBRT::Intersect( const RAYPACKET &aRayPacket,
                            HITINFO_PACKET *aHitInfoPacket ) const
 {
@@ -103,6 +106,8 @@ bool CBVH_PBRT::Intersect( const RAYPACKET &aRayPacket,
     if( (&m_nodes[0]) == NULL )
         return false;
 
+    RAYPACKET_SOA packet( aRayPacket, aHitInfoPacket );
+
     bool anyHitted = false;
     int todoOffset = 0, nodeNum = 0;
     StackNode todo[MAX_TODOS];
@@ -113,10 +118,16 @@ bool CBVH_PBRT::Intersect( const RAYPACKET &aRayPacket,
     {
         const LinearBVHNode *curCell = &m_nodes[nodeNum];
 
-        ia = getFirstHit( aRayPacket, curCell->bounds, ia, aHitInfoPacket );
+        uint64_t hitRays = 0;
 
-        if( ia < RAYPACKET_RAYS_PER_PACKET )
+        if( aRayPacket.m_Frustum.Intersect( curCell->bounds ) )
+            hitRays = curCell->bounds.Intersect( packet,
+                                                 rayRange( ia, RAYPACKET_RAYS_PER_PACKET - 1 ) );
+
+        if( hitRays )
         {
+            ia = firstRay( hitRays );
+
             if( curCell->nPrimitives == 0 )
             {
                 StackNode &node = todo[todoOffset++];
@@ -127,28 +138,33 @@ bool CBVH_PBRT::Intersect( const RAYPACKET &aRayPacket,
             }
             else
             {
-                const unsigned int ie = getLastHit( aRayPacket,
-                                                    curCell->bounds,
-                                                    ia,
-                                                    aHitInfoPacket );
+                const uint64_t rays = rayRange( ia, lastRay( hitRays ) );
 
                 for( int j = 0; j < curCell->nPrimitives; ++j )
                 {
                     const COBJECT *obj = m_primitives[curCell->primitivesOffset + j];
 
-                    if( aRayPacket.m_Frustum.Intersect( obj->GetBBox() ) )
+                    if( !aRayPacket.m_Frustum.Intersect( obj->GetBBox() ) )
+                        continue;
+
+                    uint64_t candidates = rays;
+
+                    if( obj->GetObjectType() == OBJ3D_TRIANGLE )
+                        candidates = static_cast<const CTRIANGLE *>( obj )->IntersectCandidates(
+                                packet, rays );
+
+                    while( candidates )
                     {
-                        for( unsigned int i = ia; i < ie; ++i )
-                        {
-                            const bool hitted = obj->Intersect( aRayPacket.m_ray[i],
-                                                                aHitInfoPacket[i].m_HitInfo );
+                        const unsigned int i = firstRay( candidates );
 
-                            if( hitted )
-                            {
-                                anyHitted |= hitted;
-                                aHitInfoPacket[i].m_hitresult |= hitted;
-                                aHitInfoPacket[i].m_HitInfo.m_acc_node_info = nodeNum;
-                            }
+                        candidates &= candidates - 1;
+
+                        if( obj->Intersect( aRayPacket.m_ray[i], aHitInfoPacket[i].m_HitInfo ) )
+                        {
+                            anyHitted = true;
+                            aHitInfoPacket[i].m_hitresult = true;
+                            aHitInfoPacket[i].m_HitInfo.m_acc_node_info = nodeNum;
+                            packet.m_tHit[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
                         }
                     }
                 }
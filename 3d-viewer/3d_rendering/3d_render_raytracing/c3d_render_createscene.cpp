@@ -1194,6 +1194,23 @@ void C3D_RENDER_RAYTRACING::add_3D_vias_and_pads_to_container()
 
 void C3D_RENDER_RAYTRACING::load_3D_models()
 {
+    if( !m_settings.Get3DCacheManager() )
+        return;
+
+    std::vector<wxString> modelFiles;
+
+    for( auto module : m_settings.GetBoard()->Modules() )
+    {
+        if( m_settings.ShouldModuleBeDisplayed( (MODULE_ATTR_T)module->GetAttributes() ) )
+        {
+            for( const MODULE_3D_SETTINGS& model : module->Models() )
+                modelFiles.push_back( model.m_Filename );
+        }
+    }
+
+    // Load the model files on the thread pool first, the loop below gets them from the cache
+    m_settings.Get3DCacheManager()->LoadModels( modelFiles );
+
     // Go for all modules
     for( auto module : m_settings.GetBoard()->Modules() )
     {
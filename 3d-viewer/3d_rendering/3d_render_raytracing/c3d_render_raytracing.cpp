@@ -32,7 +32,8 @@
 #include <atomic>
 #include <chrono>
 #include <climits>
-#include <thread>
+#include <thread_pool.h>
+#include <advanced_config.h>
 
 #include "c3d_render_raytracing.h"
 #include "mortoncodes.h"
@@ -298,6 +299,38 @@ bool C3D_RENDER_RAYTRACING::Redraw( bool aIsMoving, REPORTER *aStatusTextReporte
 }
 
 
+SFVEC2UI C3D_RENDER_RAYTRACING::RenderToBuffer( const wxSize &aSize,
+                                                std::vector<GLubyte> &aBuffer )
+{
+    if( m_reloadRequested )
+        reload( nullptr );
+
+    if( ( m_windowSize != aSize ) || ( m_oldWindowsSize != aSize ) )
+    {
+        m_windowSize = aSize;
+        m_oldWindowsSize = aSize;
+
+        initialize_block_positions();
+    }
+
+    aBuffer.resize( m_realBufferSize.x * m_realBufferSize.y * 4 );
+
+    if( m_camera_light )
+        m_camera_light->SetDirection( -m_settings.CameraGet().GetDir() );
+
+    // Start a new frame, then run all its stages
+    m_rt_render_state = RT_RENDER_STATE_MAX;
+
+    do
+    {
+        render( aBuffer.data(), nullptr );
+    }
+    while( m_rt_render_state != RT_RENDER_STATE_FINISH );
+
+    return m_realBufferSize;
+}
+
+
 void C3D_RENDER_RAYTRACING::render( GLubyte *ptrPBO , REPORTER *aStatusTextReporter )
 {
     if( (m_rt_render_state == RT_RENDER_STATE_FINISH) ||
@@ -334,6 +367,10 @@ void C3D_RENDER_RAYTRACING::render( GLubyte *ptrPBO , REPORTER *aStatusTextRepor
             rt_render_tracing( ptrPBO, aStatusTextReporter );
         break;
 
+    case RT_RENDER_STATE_ANTI_ALIASING:
+            rt_render_anti_aliasing( ptrPBO, aStatusTextReporter );
+        break;
+
     case RT_RENDER_STATE_POST_PROCESS_SHADE:
             rt_render_post_process_shade( ptrPBO, aStatusTextReporter );
         break;
@@ -360,69 +397,91 @@ void C3D_RENDER_RAYTRACING::render( GLubyte *ptrPBO , REPORTER *aStatusTextRepor
 }
 
 
+void C3D_RENDER_RAYTRACING::rt_render_blocks( const std::function<void( size_t )>& aRenderBlock )
+{
+    auto startTime = std::chrono::steady_clock::now();
+    std::atomic<bool> breakLoop( false );
+    std::atomic<size_t> numBlocksRendered( 0 );
+
+    THREAD_POOL::GetPool().ParallelFor( m_blockPositions.size(), [&]( size_t iBlock )
+    {
+        if( breakLoop || m_blockPositionsWasProcessed[iBlock] )
+            return;
+
+        aRenderBlock( iBlock );
+        numBlocksRendered++;
+        m_blockPositionsWasProcessed[iBlock] = 1;
+
+        // Check if it spend already some time render and request to exit
+        // to display the progress
+        if( std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - startTime ).count() > 150 )
+            breakLoop = true;
+    }, 1, ADVANCED_CFG::GetCfg().m_max3DThreads );
+
+    m_nrBlocksRenderProgress += numBlocksRendered;
+}
+
+
 void C3D_RENDER_RAYTRACING::rt_render_tracing( GLubyte *ptrPBO ,
                                                REPORTER *aStatusTextReporter )
 {
     m_isPreview = false;
 
-    auto startTime = std::chrono::steady_clock::now();
-    bool breakLoop = false;
+    rt_render_blocks( [&]( size_t iBlock )
+                      {
+                          rt_render_trace_block( ptrPBO, iBlock );
+                      } );
 
-    std::atomic<size_t> numBlocksRendered( 0 );
-    std::atomic<size_t> currentBlock( 0 );
-    std::atomic<size_t> threadsFinished( 0 );
+    if( aStatusTextReporter )
+        aStatusTextReporter->Report( wxString::Format( _( "Rendering: %.0f %%" ),
+                                                       (float)(m_nrBlocksRenderProgress * 100) /
+                                                       (float)m_blockPositions.size() ) );
 
-    size_t parallelThreadCount = std::min<size_t>(
-            std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
-            m_blockPositions.size() );
-    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    // Check if it finish the rendering and if should continue to the anti-aliasing,
+    // to a post processing or mark it as finished
+    if( m_nrBlocksRenderProgress >= m_blockPositions.size() )
     {
-        std::thread t = std::thread( [&]()
+        if( m_settings.GetFlag( FL_RENDER_RAYTRACING_ANTI_ALIASING ) )
         {
-            for( size_t iBlock = currentBlock.fetch_add( 1 );
-                        iBlock < m_blockPositions.size() && !breakLoop;
-                        iBlock = currentBlock.fetch_add( 1 ) )
-            {
-                if( !m_blockPositionsWasProcessed[iBlock] )
-                {
-                    rt_render_trace_block( ptrPBO, iBlock );
-                    numBlocksRendered++;
-                    m_blockPositionsWasProcessed[iBlock] = 1;
-
-                    // Check if it spend already some time render and request to exit
-                    // to display the progress
-                    if( std::chrono::duration_cast<std::chrono::milliseconds>(
-                            std::chrono::steady_clock::now() - startTime ).count() > 150 )
-                        breakLoop = true;
-                }
-            }
+            m_rt_render_state = RT_RENDER_STATE_ANTI_ALIASING;
 
-            threadsFinished++;
-        } );
+            // The blocks are refined in a second pass, once the full frame is shown
+            m_nrBlocksRenderProgress = 0;
 
-        t.detach();
+            std::fill( m_blockPositionsWasProcessed.begin(),
+                       m_blockPositionsWasProcessed.end(),
+                       0 );
+        }
+        else if( m_settings.GetFlag( FL_RENDER_RAYTRACING_POST_PROCESSING ) )
+            m_rt_render_state = RT_RENDER_STATE_POST_PROCESS_SHADE;
+        else
+        {
+            m_rt_render_state = RT_RENDER_STATE_FINISH;
+        }
     }
+}
 
-    while( threadsFinished < parallelThreadCount )
-        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
 
-    m_nrBlocksRenderProgress += numBlocksRendered;
+void C3D_RENDER_RAYTRACING::rt_render_anti_aliasing( GLubyte *ptrPBO,
+                                                     REPORTER *aStatusTextReporter )
+{
+    rt_render_blocks( [&]( size_t iBlock )
+                      {
+                          rt_render_AA_block( ptrPBO, iBlock );
+                      } );
 
     if( aStatusTextReporter )
-        aStatusTextReporter->Report( wxString::Format( _( "Rendering: %.0f %%" ),
+        aStatusTextReporter->Report( wxString::Format( _( "Rendering: anti-aliasing %.0f %%" ),
                                                        (float)(m_nrBlocksRenderProgress * 100) /
                                                        (float)m_blockPositions.size() ) );
 
-    // Check if it finish the rendering and if should continue to a post processing
-    // or mark it as finished
     if( m_nrBlocksRenderProgress >= m_blockPositions.size() )
     {
         if( m_settings.GetFlag( FL_RENDER_RAYTRACING_POST_PROCESSING ) )
             m_rt_render_state = RT_RENDER_STATE_POST_PROCESS_SHADE;
         else
-        {
             m_rt_render_state = RT_RENDER_STATE_FINISH;
-        }
     }
 }
 
@@ -528,133 +587,11 @@ void C3D_RENDER_RAYTRACING::rt_shades_packet(const SFVEC3F *bgColorY,
 }
 
 
-void C3D_RENDER_RAYTRACING::rt_trace_AA_packet( const SFVEC3F *aBgColorY,
-                                                const HITINFO_PACKET *aHitPck_X0Y0,
-                                                const HITINFO_PACKET *aHitPck_AA_X1Y1,
-                                                const RAY *aRayPck,
-                                                SFVEC3F *aOutHitColor )
-{
-    const bool is_testShadow =  m_settings.GetFlag( FL_RENDER_RAYTRACING_SHADOWS );
-
-    for( unsigned int y = 0, i = 0; y < RAYPACKET_DIM; ++y )
-    {
-        for( unsigned int x = 0; x < RAYPACKET_DIM; ++x, ++i )
-        {
-            const RAY &rayAA = aRayPck[i];
-
-            HITINFO hitAA;
-            hitAA.m_tHit = std::numeric_limits<float>::infinity();
-            hitAA.m_acc_node_info = 0;
-
-            bool hitted = false;
-
-            const unsigned int idx0y1 = ( x + 0 ) + RAYPACKET_DIM * ( y + 1 );
-            const unsigned int idx1y1 = ( x + 1 ) + RAYPACKET_DIM * ( y + 1 );
-
-            // Gets the node info from the hit.
-            const unsigned int nodex0y0 = aHitPck_X0Y0[ i ].m_HitInfo.m_acc_node_info;
-            const unsigned int node_AA_x0y0 = aHitPck_AA_X1Y1[ i ].m_HitInfo.m_acc_node_info;
-
-            unsigned int nodex1y0 = 0;
-
-            if( x < (RAYPACKET_DIM - 1) )
-                nodex1y0 = aHitPck_X0Y0[ i + 1 ].m_HitInfo.m_acc_node_info;
-
-            unsigned int nodex0y1 = 0;
-
-            if( y < (RAYPACKET_DIM - 1) )
-                    nodex0y1 = aHitPck_X0Y0[ idx0y1 ].m_HitInfo.m_acc_node_info;
-
-            unsigned int nodex1y1 = 0;
-
-            if(  ((x < (RAYPACKET_DIM - 1)) &&
-                  (y < (RAYPACKET_DIM - 1))) )
-                nodex1y1 = aHitPck_X0Y0[ idx1y1 ].m_HitInfo.m_acc_node_info;
-
-
-            if( ((nodex0y0 == nodex1y0) || (nodex1y0 == 0)) &&  // If all notes are equal we assume there was no change on the object hits
-                ((nodex0y0 == nodex0y1) || (nodex0y1 == 0)) &&
-                ((nodex0y0 == nodex1y1) || (nodex1y1 == 0)) &&
-                (nodex0y0 == node_AA_x0y0) )
-            {
-                // Option 1
-                // This option will give a very good quality on reflections (slow)
-                /*
-                if( m_accelerator->Intersect( rayAA, hitAA, nodex0y0 ) )
-                {
-                    aOutHitColor[i] += shadeHit( aBgColorY[y], rayAA, hitAA, false, 0 );
-                }
-                else
-                {
-                    if( m_accelerator->Intersect( rayAA, hitAA ) )
-                        aOutHitColor[i] += shadeHit( aBgColorY[y], rayAA, hitAA, false, 0 );
-                    else
-                        aOutHitColor[i] += hitColor[i];
-                }
-                */
-
-                // Option 2
-                // Trace again with the same node,
-                // then if miss just give the same color as before
-                //if( m_accelerator->Intersect( rayAA, hitAA, nodex0y0 ) )
-                //    aOutHitColor[i] += shadeHit( aBgColorY[y], rayAA, hitAA, false, 0 );
-
-                // Option 3
-                // Use same color
-
-            }
-            else
-            {
-                // Try to intersect the different nodes
-                // It tests the possible combination of hitted or not hitted points
-                // This will try to get the best hit for this ray
-
-                if( nodex0y0 != 0 )
-                    hitted |= m_accelerator->Intersect( rayAA, hitAA, nodex0y0 );
-
-                if( ( nodex1y0 != 0 ) &&
-                    ( nodex0y0 != nodex1y0 ) )
-                    hitted |= m_accelerator->Intersect( rayAA, hitAA, nodex1y0 );
-
-                if( ( nodex0y1 != 0 ) &&
-                    ( nodex0y0 != nodex0y1 ) &&
-                    ( nodex1y0 != nodex0y1 ) )
-                    hitted |= m_accelerator->Intersect( rayAA, hitAA, nodex0y1 );
-
-                if( (nodex1y1 != 0 ) &&
-                    ( nodex0y0 != nodex1y1 ) &&
-                    ( nodex0y1 != nodex1y1 ) &&
-                    ( nodex1y0 != nodex1y1 ) )
-                    hitted |= m_accelerator->Intersect( rayAA, hitAA, nodex1y1 );
-
-                if( (node_AA_x0y0 != 0 ) &&
-                    ( nodex0y0 != node_AA_x0y0 ) &&
-                    ( nodex0y1 != node_AA_x0y0 ) &&
-                    ( nodex1y0 != node_AA_x0y0 ) &&
-                    ( nodex1y1 != node_AA_x0y0 ) )
-                    hitted |= m_accelerator->Intersect( rayAA, hitAA, node_AA_x0y0 );
-
-                if( hitted )
-                {
-                    // If we got any result, shade it
-                    aOutHitColor[i] = shadeHit( aBgColorY[y], rayAA, hitAA, false, 0, is_testShadow );
-                }
-                else
-                {
-                    // Note: There are very few cases that will end on this situation
-                    // so it is not so expensive to trace a single ray from the beginning
-
-                    // It was missed the 'last nodes' so, trace a ray from the beginning
-                    if( m_accelerator->Intersect( rayAA, hitAA ) )
-                        aOutHitColor[i] = shadeHit( aBgColorY[y], rayAA, hitAA, false, 0, is_testShadow );
-                }
-            }
-        }
-    }
-}
-
 #define DISP_FACTOR 0.075f
 
+/// Minimum difference of color to a neighbour pixel which makes a pixel be anti-aliased
+#define AA_CONTRAST_THRESHOLD 0.05f
+
 void C3D_RENDER_RAYTRACING::rt_render_trace_block( GLubyte *ptrPBO ,
                                                    signed int iBlock )
 {
@@ -730,6 +667,9 @@ void C3D_RENDER_RAYTRACING::rt_render_trace_block( GLubyte *ptrPBO ,
             {
                 GLubyte *ptr = &ptrPBO[ (yConst + x) * 4 ];
 
+                m_pixelColor[yConst + x] = outColor;
+                m_pixelNode[yConst + x] = 0;
+
                 rt_final_color( ptr, outColor, isFinalColor );
             }
         }
@@ -750,101 +690,17 @@ void C3D_RENDER_RAYTRACING::rt_render_trace_block( GLubyte *ptrPBO ,
                       m_settings.GetFlag( FL_RENDER_RAYTRACING_SHADOWS ),
                       hitColor_X0Y0 );
 
-    if( m_settings.GetFlag( FL_RENDER_RAYTRACING_ANTI_ALIASING ) )
+    // Keep the results of this pass, to find later the pixels to anti-alias
+    // /////////////////////////////////////////////////////////////////////
+    for( unsigned int y = 0, i = 0; y < RAYPACKET_DIM; ++y )
     {
-        SFVEC3F hitColor_AA_X1Y1[RAYPACKET_RAYS_PER_PACKET];
-
-
-        // Intersect one blockPosI + (0.5, 0.5) used for anti aliasing calculation
-        // /////////////////////////////////////////////////////////////////////////
-        HITINFO_PACKET hitPacket_AA_X1Y1[RAYPACKET_RAYS_PER_PACKET];
-        HITINFO_PACKET_init( hitPacket_AA_X1Y1 );
-
-        RAYPACKET blockPacket_AA_X1Y1( m_settings.CameraGet(),
-                                       (SFVEC2F)blockPosI + SFVEC2F(0.5f, 0.5f),
-                                       SFVEC2F(DISP_FACTOR, DISP_FACTOR) // Displacement random factor
-                                       );
-
-        if( !m_accelerator->Intersect( blockPacket_AA_X1Y1, hitPacket_AA_X1Y1 ) )
-        {
-            // Missed all the package
-            for( unsigned int y = 0, i = 0; y < RAYPACKET_DIM; ++y )
-            {
-                const SFVEC3F &outColor = bgColor[y];
-
-                for( unsigned int x = 0; x < RAYPACKET_DIM; ++x, ++i )
-                {
-                    hitColor_AA_X1Y1[i] = outColor;
-                }
-            }
-        }
-        else
-        {
-            rt_shades_packet( bgColor,
-                              blockPacket_AA_X1Y1.m_ray,
-                              hitPacket_AA_X1Y1,
-                              m_settings.GetFlag( FL_RENDER_RAYTRACING_SHADOWS ),
-                              hitColor_AA_X1Y1
-                              );
-        }
-
-        SFVEC3F hitColor_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
-        SFVEC3F hitColor_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
-        SFVEC3F hitColor_AA_X0Y1_half[RAYPACKET_RAYS_PER_PACKET];
-
-        for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
-        {
-            const SFVEC3F color_average = ( hitColor_X0Y0[i] +
-                                            hitColor_AA_X1Y1[i] ) * SFVEC3F(0.5f);
-
-            hitColor_AA_X1Y0[i] = color_average;
-            hitColor_AA_X0Y1[i] = color_average;
-            hitColor_AA_X0Y1_half[i] = color_average;
-        }
+        const unsigned int yConst = blockPos.x + ( (y + blockPos.y) * m_realBufferSize.x );
 
-        RAY blockRayPck_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
-        RAY blockRayPck_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
-        RAY blockRayPck_AA_X1Y1_half[RAYPACKET_RAYS_PER_PACKET];
-
-        RAYPACKET_InitRays_with2DDisplacement( m_settings.CameraGet(),
-                                               (SFVEC2F)blockPosI + SFVEC2F(0.5f - DISP_FACTOR, DISP_FACTOR),
-                                               SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
-                                               blockRayPck_AA_X1Y0 );
-
-        RAYPACKET_InitRays_with2DDisplacement( m_settings.CameraGet(),
-                                               (SFVEC2F)blockPosI + SFVEC2F(DISP_FACTOR, 0.5f - DISP_FACTOR),
-                                               SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
-                                               blockRayPck_AA_X0Y1 );
-
-        RAYPACKET_InitRays_with2DDisplacement( m_settings.CameraGet(),
-                                               (SFVEC2F)blockPosI + SFVEC2F(0.25f - DISP_FACTOR, 0.25f - DISP_FACTOR),
-                                               SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
-                                               blockRayPck_AA_X1Y1_half );
-
-        rt_trace_AA_packet( bgColor,
-                            hitPacket_X0Y0, hitPacket_AA_X1Y1,
-                            blockRayPck_AA_X1Y0,
-                            hitColor_AA_X1Y0 );
-
-        rt_trace_AA_packet( bgColor,
-                            hitPacket_X0Y0, hitPacket_AA_X1Y1,
-                            blockRayPck_AA_X0Y1,
-                            hitColor_AA_X0Y1 );
-
-        rt_trace_AA_packet( bgColor,
-                            hitPacket_X0Y0, hitPacket_AA_X1Y1,
-                            blockRayPck_AA_X1Y1_half,
-                            hitColor_AA_X0Y1_half );
-
-        // Average the result
-        for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+        for( unsigned int x = 0; x < RAYPACKET_DIM; ++x, ++i )
         {
-            hitColor_X0Y0[i] = ( hitColor_X0Y0[i] +
-                                 hitColor_AA_X1Y1[i] +
-                                 hitColor_AA_X1Y0[i] +
-                                 hitColor_AA_X0Y1[i] +
-                                 hitColor_AA_X0Y1_half[i]
-                                 ) * SFVEC3F(1.0f / 5.0f);
+            m_pixelColor[yConst + x] = hitColor_X0Y0[i];
+            m_pixelNode[yConst + x] = hitPacket_X0Y0[i].m_hitresult ?
+                                      hitPacket_X0Y0[i].m_HitInfo.m_acc_node_info : 0;
         }
     }
 
@@ -912,45 +768,136 @@ void C3D_RENDER_RAYTRACING::rt_render_trace_block( GLubyte *ptrPBO ,
 }
 
 
-void C3D_RENDER_RAYTRACING::rt_render_post_process_shade( GLubyte *ptrPBO,
-                                                          REPORTER *aStatusTextReporter )
+bool C3D_RENDER_RAYTRACING::rt_pixel_needs_AA( unsigned int x, unsigned int y ) const
 {
-    (void)ptrPBO; // unused
+    const unsigned int idx = x + y * m_realBufferSize.x;
+    const unsigned int node = m_pixelNode[idx];
+    const SFVEC3F &color = m_pixelColor[idx];
 
-    if( m_settings.GetFlag( FL_RENDER_RAYTRACING_POST_PROCESSING ) )
+    // A pixel is refined if it is on the edge of an object or if its color
+    // differs from the one of any of its neighbours
+    for( int dy = -1; dy <= 1; ++dy )
     {
-        if( aStatusTextReporter )
-            aStatusTextReporter->Report( _("Rendering: Post processing shader") );
+        const int ny = (int)y + dy;
 
-        std::atomic<size_t> nextBlock( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
+        if( ( ny < 0 ) || ( ny >= (int)m_realBufferSize.y ) )
+            continue;
 
-        size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        for( int dx = -1; dx <= 1; ++dx )
         {
-            std::thread t = std::thread( [&]()
+            const int nx = (int)x + dx;
+
+            if( ( nx < 0 ) || ( nx >= (int)m_realBufferSize.x ) || ( ( dx == 0 ) && ( dy == 0 ) ) )
+                continue;
+
+            const unsigned int nIdx = nx + ny * m_realBufferSize.x;
+
+            if( m_pixelNode[nIdx] != node )
+                return true;
+
+            const SFVEC3F diff = glm::abs( m_pixelColor[nIdx] - color );
+
+            if( glm::max( diff.r, glm::max( diff.g, diff.b ) ) > AA_CONTRAST_THRESHOLD )
+                return true;
+        }
+    }
+
+    return false;
+}
+
+
+void C3D_RENDER_RAYTRACING::rt_render_AA_block( GLubyte *ptrPBO ,
+                                                signed int iBlock )
+{
+    const SFVEC2UI &blockPos = m_blockPositions[iBlock];
+    const SFVEC2I blockPosI = SFVEC2I( blockPos.x + m_xoffset,
+                                       blockPos.y + m_yoffset );
+
+    const bool is_testShadow = m_settings.GetFlag( FL_RENDER_RAYTRACING_SHADOWS );
+    const bool isPostProcessing = m_settings.GetFlag( FL_RENDER_RAYTRACING_POST_PROCESSING );
+
+    // The sub pixel positions of the extra samples, the first pass traced the pixels
+    // at (DISP_FACTOR, DISP_FACTOR)
+    const SFVEC2F subPixelPos[4] = { SFVEC2F( 0.5f, 0.5f ),
+                                     SFVEC2F( 0.5f - DISP_FACTOR, DISP_FACTOR ),
+                                     SFVEC2F( DISP_FACTOR, 0.5f - DISP_FACTOR ),
+                                     SFVEC2F( 0.25f - DISP_FACTOR, 0.25f - DISP_FACTOR ) };
+
+    for( unsigned int y = 0; y < RAYPACKET_DIM; ++y )
+    {
+        const unsigned int yPos = blockPos.y + y;
+        const float posYfactor = (float)(blockPosI.y + y) / (float)m_windowSize.y;
+
+        const SFVEC3F bgColor = m_BgColorTop_LinearRGB * SFVEC3F(posYfactor) +
+                                m_BgColorBot_LinearRGB * ( SFVEC3F(1.0f) - SFVEC3F(posYfactor) );
+
+        for( unsigned int x = 0; x < RAYPACKET_DIM; ++x )
+        {
+            const unsigned int xPos = blockPos.x + x;
+
+            if( !rt_pixel_needs_AA( xPos, yPos ) )
+                continue;
+
+            const unsigned int idx = xPos + yPos * m_realBufferSize.x;
+
+            SFVEC3F color = m_pixelColor[idx];
+
+            for( unsigned int s = 0; s < 4; ++s )
             {
-                for( size_t y = nextBlock.fetch_add( 1 );
-                            y < m_realBufferSize.y;
-                            y = nextBlock.fetch_add( 1 ) )
-                {
-                    SFVEC3F *ptr = &m_shaderBuffer[ y * m_realBufferSize.x ];
+                const SFVEC2F windowPos = SFVEC2F( blockPosI.x + x, blockPosI.y + y ) +
+                                          subPixelPos[s] +
+                                          SFVEC2F( Fast_RandFloat() * DISP_FACTOR,
+                                                   Fast_RandFloat() * DISP_FACTOR );
 
-                    for( signed int x = 0; x < (int)m_realBufferSize.x; ++x )
-                    {
-                        *ptr = m_postshader_ssao.Shade( SFVEC2I( x, y ) );
-                        ptr++;
-                    }
-                }
+                SFVEC3F rayOrigin;
+                SFVEC3F rayDir;
 
-                threadsFinished++;
-            } );
+                m_settings.CameraGet().MakeRay( windowPos, rayOrigin, rayDir );
+
+                RAY rayAA;
+                rayAA.Init( rayOrigin, rayDir );
+
+                HITINFO hitAA;
+                hitAA.m_tHit = std::numeric_limits<float>::infinity();
+                hitAA.m_acc_node_info = 0;
 
-            t.detach();
+                if( m_accelerator->Intersect( rayAA, hitAA ) )
+                    color += shadeHit( bgColor, rayAA, hitAA, false, 0, is_testShadow );
+                else
+                    color += bgColor;
+            }
+
+            color *= SFVEC3F( 1.0f / 5.0f );
+
+            if( isPostProcessing )
+                m_postshader_ssao.SetPixelColor( xPos, yPos, color );
+
+            rt_final_color( &ptrPBO[idx * 4], color, !isPostProcessing );
         }
+    }
+}
+
+
+void C3D_RENDER_RAYTRACING::rt_render_post_process_shade( GLubyte *ptrPBO,
+                                                          REPORTER *aStatusTextReporter )
+{
+    (void)ptrPBO; // unused
 
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    if( m_settings.GetFlag( FL_RENDER_RAYTRACING_POST_PROCESSING ) )
+    {
+        if( aStatusTextReporter )
+            aStatusTextReporter->Report( _("Rendering: Post processing shader") );
+
+        THREAD_POOL::GetPool().ParallelFor( m_realBufferSize.y, [&]( size_t y )
+        {
+            SFVEC3F *ptr = &m_shaderBuffer[ y * m_realBufferSize.x ];
+
+            for( signed int x = 0; x < (int)m_realBufferSize.x; ++x )
+            {
+                *ptr = m_postshader_ssao.Shade( SFVEC2I( x, y ) );
+                ptr++;
+            }
+        }, 1, ADVANCED_CFG::GetCfg().m_max3DThreads );
 
         // Set next state
         m_rt_render_state = RT_RENDER_STATE_POST_PROCESS_BLUR_AND_FINISH;
@@ -971,106 +918,87 @@ void C3D_RENDER_RAYTRACING::rt_render_post_process_blur_finish( GLubyte *ptrPBO,
     if( m_settings.GetFlag( FL_RENDER_RAYTRACING_POST_PROCESSING ) )
     {
         // Now blurs the shader result and compute the final color
-        std::atomic<size_t> nextBlock( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
-
-        size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        THREAD_POOL::GetPool().ParallelFor( m_realBufferSize.y, [&]( size_t y )
         {
-            std::thread t = std::thread( [&]()
+            GLubyte *ptr = &ptrPBO[ y * m_realBufferSize.x * 4 ];
+
+            const SFVEC3F *ptrShaderY0 =
+                    &m_shaderBuffer[ glm::max((int)y - 2, 0) * m_realBufferSize.x ];
+            const SFVEC3F *ptrShaderY1 =
+                    &m_shaderBuffer[ glm::max((int)y - 1, 0) * m_realBufferSize.x ];
+            const SFVEC3F *ptrShaderY2 =
+                    &m_shaderBuffer[ y * m_realBufferSize.x ];
+            const SFVEC3F *ptrShaderY3 =
+                    &m_shaderBuffer[ glm::min((int)y + 1, (int)(m_realBufferSize.y - 1)) *
+                                     m_realBufferSize.x ];
+            const SFVEC3F *ptrShaderY4 =
+                    &m_shaderBuffer[ glm::min((int)y + 2, (int)(m_realBufferSize.y - 1)) *
+                                     m_realBufferSize.x ];
+
+            for( signed int x = 0; x < (int)m_realBufferSize.x; ++x )
             {
-                for( size_t y = nextBlock.fetch_add( 1 );
-                            y < m_realBufferSize.y;
-                            y = nextBlock.fetch_add( 1 ) )
-                {
-                    GLubyte *ptr = &ptrPBO[ y * m_realBufferSize.x * 4 ];
-
-                    const SFVEC3F *ptrShaderY0 =
-                            &m_shaderBuffer[ glm::max((int)y - 2, 0) * m_realBufferSize.x ];
-                    const SFVEC3F *ptrShaderY1 =
-                            &m_shaderBuffer[ glm::max((int)y - 1, 0) * m_realBufferSize.x ];
-                    const SFVEC3F *ptrShaderY2 =
-                            &m_shaderBuffer[ y * m_realBufferSize.x ];
-                    const SFVEC3F *ptrShaderY3 =
-                            &m_shaderBuffer[ glm::min((int)y + 1, (int)(m_realBufferSize.y - 1)) *
-                                             m_realBufferSize.x ];
-                    const SFVEC3F *ptrShaderY4 =
-                            &m_shaderBuffer[ glm::min((int)y + 2, (int)(m_realBufferSize.y - 1)) *
-                                             m_realBufferSize.x ];
-
-                    for( signed int x = 0; x < (int)m_realBufferSize.x; ++x )
-                    {
-        // This #if should be 1, it is here that can be used for debug proposes during development
-        #if 1
-                        int idx = x > 1 ? -2 : 0;
-                        SFVEC3F bluredShadeColor = ptrShaderY0[idx] * 1.0f / 273.0f +
-                                                   ptrShaderY1[idx] * 4.0f / 273.0f +
-                                                   ptrShaderY2[idx] * 7.0f / 273.0f +
-                                                   ptrShaderY3[idx] * 4.0f / 273.0f +
-                                                   ptrShaderY4[idx] * 1.0f / 273.0f;
-
-                        idx = x > 0 ? -1 : 0;
-                        bluredShadeColor += ptrShaderY0[idx] *  4.0f / 273.0f +
-                                            ptrShaderY1[idx] * 16.0f / 273.0f +
-                                            ptrShaderY2[idx] * 26.0f / 273.0f +
-                                            ptrShaderY3[idx] * 16.0f / 273.0f +
-                                            ptrShaderY4[idx] *  4.0f / 273.0f;
-
-                        bluredShadeColor += (*ptrShaderY0) *  7.0f / 273.0f +
-                                            (*ptrShaderY1) * 26.0f / 273.0f +
-                                            (*ptrShaderY2) * 41.0f / 273.0f +
-                                            (*ptrShaderY3) * 26.0f / 273.0f +
-                                            (*ptrShaderY4) *  7.0f / 273.0f;
-
-                        idx = (x < (int)m_realBufferSize.x - 1) ? 1 : 0;
-                        bluredShadeColor += ptrShaderY0[idx] * 4.0f / 273.0f +
-                                            ptrShaderY1[idx] *16.0f / 273.0f +
-                                            ptrShaderY2[idx] *26.0f / 273.0f +
-                                            ptrShaderY3[idx] *16.0f / 273.0f +
-                                            ptrShaderY4[idx] * 4.0f / 273.0f;
-
-                        idx = (x < (int)m_realBufferSize.x - 2) ? 2 : 0;
-                        bluredShadeColor += ptrShaderY0[idx] * 1.0f / 273.0f +
-                                            ptrShaderY1[idx] * 4.0f / 273.0f +
-                                            ptrShaderY2[idx] * 7.0f / 273.0f +
-                                            ptrShaderY3[idx] * 4.0f / 273.0f +
-                                            ptrShaderY4[idx] * 1.0f / 273.0f;
-
-                        // process next pixel
-                        ++ptrShaderY0;
-                        ++ptrShaderY1;
-                        ++ptrShaderY2;
-                        ++ptrShaderY3;
-                        ++ptrShaderY4;
-
-        #ifdef USE_SRGB_SPACE
-                        const SFVEC3F originColor = convertLinearToSRGB( m_postshader_ssao.GetColorAtNotProtected( SFVEC2I( x,y ) ) );
-        #else
-                        const SFVEC3F originColor = m_postshader_ssao.GetColorAtNotProtected( SFVEC2I( x,y ) );
-        #endif
-
-                        const SFVEC3F shadedColor = m_postshader_ssao.ApplyShadeColor( SFVEC2I( x,y ), originColor, bluredShadeColor );
-        #else
-                        // Debug code
-                        //const SFVEC3F shadedColor =  SFVEC3F( 1.0f ) -
-                        //                             m_shaderBuffer[ y * m_realBufferSize.x + x];
-                        const SFVEC3F shadedColor =  m_shaderBuffer[ y * m_realBufferSize.x + x ];
-        #endif
-
-                        rt_final_color( ptr, shadedColor, false );
-
-                        ptr += 4;
-                    }
-                }
+// This #if should be 1, it is here that can be used for debug proposes during development
+#if 1
+                int idx = x > 1 ? -2 : 0;
+                SFVEC3F bluredShadeColor = ptrShaderY0[idx] * 1.0f / 273.0f +
+                                           ptrShaderY1[idx] * 4.0f / 273.0f +
+                                           ptrShaderY2[idx] * 7.0f / 273.0f +
+                                           ptrShaderY3[idx] * 4.0f / 273.0f +
+                                           ptrShaderY4[idx] * 1.0f / 273.0f;
+
+                idx = x > 0 ? -1 : 0;
+                bluredShadeColor += ptrShaderY0[idx] *  4.0f / 273.0f +
+                                    ptrShaderY1[idx] * 16.0f / 273.0f +
+                                    ptrShaderY2[idx] * 26.0f / 273.0f +
+                                    ptrShaderY3[idx] * 16.0f / 273.0f +
+                                    ptrShaderY4[idx] *  4.0f / 273.0f;
+
+                bluredShadeColor += (*ptrShaderY0) *  7.0f / 273.0f +
+                                    (*ptrShaderY1) * 26.0f / 273.0f +
+                                    (*ptrShaderY2) * 41.0f / 273.0f +
+                                    (*ptrShaderY3) * 26.0f / 273.0f +
+                                    (*ptrShaderY4) *  7.0f / 273.0f;
+
+                idx = (x < (int)m_realBufferSize.x - 1) ? 1 : 0;
+                bluredShadeColor += ptrShaderY0[idx] * 4.0f / 273.0f +
+                                    ptrShaderY1[idx] *16.0f / 273.0f +
+                                    ptrShaderY2[idx] *26.0f / 273.0f +
+                                    ptrShaderY3[idx] *16.0f / 273.0f +
+                                    ptrShaderY4[idx] * 4.0f / 273.0f;
+
+                idx = (x < (int)m_realBufferSize.x - 2) ? 2 : 0;
+                bluredShadeColor += ptrShaderY0[idx] * 1.0f / 273.0f +
+                                    ptrShaderY1[idx] * 4.0f / 273.0f +
+                                    ptrShaderY2[idx] * 7.0f / 273.0f +
+                                    ptrShaderY3[idx] * 4.0f / 273.0f +
+                                    ptrShaderY4[idx] * 1.0f / 273.0f;
+
+                // process next pixel
+                ++ptrShaderY0;
+                ++ptrShaderY1;
+                ++ptrShaderY2;
+                ++ptrShaderY3;
+                ++ptrShaderY4;
 
-                threadsFinished++;
-            } );
+#ifdef USE_SRGB_SPACE
+                const SFVEC3F originColor = convertLinearToSRGB( m_postshader_ssao.GetColorAtNotProtected( SFVEC2I( x,y ) ) );
+#else
+                const SFVEC3F originColor = m_postshader_ssao.GetColorAtNotProtected( SFVEC2I( x,y ) );
+#endif
 
-            t.detach();
-        }
+                const SFVEC3F shadedColor = m_postshader_ssao.ApplyShadeColor( SFVEC2I( x,y ), originColor, bluredShadeColor );
+#else
+                // Debug code
+                //const SFVEC3F shadedColor =  SFVEC3F( 1.0f ) -
+                //                             m_shaderBuffer[ y * m_realBufferSize.x + x];
+                const SFVEC3F shadedColor =  m_shaderBuffer[ y * m_realBufferSize.x + x ];
+#endif
 
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+                rt_final_color( ptr, shadedColor, false );
+
+                ptr += 4;
+            }
+        }, 1, ADVANCED_CFG::GetCfg().m_max3DThreads );
 
 
         // Debug code
@@ -1086,629 +1014,608 @@ void C3D_RENDER_RAYTRACING::render_preview( GLubyte *ptrPBO )
 {
     m_isPreview = true;
 
-    std::atomic<size_t> nextBlock( 0 );
-    std::atomic<size_t> threadsFinished( 0 );
-
-    size_t parallelThreadCount = std::min<size_t>(
-            std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
-            m_blockPositions.size() );
-    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    THREAD_POOL::GetPool().ParallelFor( m_blockPositionsFast.size(), [&]( size_t iBlock )
     {
-        std::thread t = std::thread( [&]()
+        const SFVEC2UI &windowPosUI = m_blockPositionsFast[ iBlock ];
+        const SFVEC2I windowsPos = SFVEC2I( windowPosUI.x + m_xoffset,
+                                            windowPosUI.y + m_yoffset );
+
+        RAYPACKET blockPacket( m_settings.CameraGet(), windowsPos, 4 );
+
+        HITINFO_PACKET hitPacket[RAYPACKET_RAYS_PER_PACKET];
+
+        // Initialize hitPacket with a "not hit" information
+        for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+        {
+            hitPacket[i].m_HitInfo.m_tHit = std::numeric_limits<float>::infinity();
+            hitPacket[i].m_HitInfo.m_acc_node_info = 0;
+            hitPacket[i].m_hitresult = false;
+        }
+
+        //  Intersect packet block
+        m_accelerator->Intersect( blockPacket, hitPacket );
+
+
+        // Calculate background gradient color
+        // /////////////////////////////////////////////////////////////////////
+        SFVEC3F bgColor[RAYPACKET_DIM];
+
+        for( unsigned int y = 0; y < RAYPACKET_DIM; ++y )
+        {
+            const float posYfactor = (float)(windowsPos.y + y * 4.0f) / (float)m_windowSize.y;
+
+            bgColor[y] = (SFVEC3F)m_settings.m_BgColorTop * SFVEC3F(posYfactor) +
+                         (SFVEC3F)m_settings.m_BgColorBot * ( SFVEC3F(1.0f) - SFVEC3F(posYfactor) );
+        }
+
+        CCOLORRGB hitColorShading[RAYPACKET_RAYS_PER_PACKET];
+
+        for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
         {
-            for( size_t iBlock = nextBlock.fetch_add( 1 );
-                        iBlock < m_blockPositionsFast.size();
-                        iBlock = nextBlock.fetch_add( 1 ) )
+            const SFVEC3F bhColorY = bgColor[i / RAYPACKET_DIM];
+
+            if( hitPacket[i].m_hitresult == true )
             {
-                const SFVEC2UI &windowPosUI = m_blockPositionsFast[ iBlock ];
-                const SFVEC2I windowsPos = SFVEC2I( windowPosUI.x + m_xoffset,
-                                                    windowPosUI.y + m_yoffset );
+                const SFVEC3F hitColor = shadeHit( bhColorY,
+                                                   blockPacket.m_ray[i],
+                                                   hitPacket[i].m_HitInfo,
+                                                   false,
+                                                   0,
+                                                   false );
 
-                RAYPACKET blockPacket( m_settings.CameraGet(), windowsPos, 4 );
+                hitColorShading[i] = CCOLORRGB( hitColor );
+            }
+            else
+                hitColorShading[i] = bhColorY;
+        }
 
-                HITINFO_PACKET hitPacket[RAYPACKET_RAYS_PER_PACKET];
+        CCOLORRGB cLRB_old[(RAYPACKET_DIM - 1)];
 
-                // Initialize hitPacket with a "not hit" information
-                for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
-                {
-                    hitPacket[i].m_HitInfo.m_tHit = std::numeric_limits<float>::infinity();
-                    hitPacket[i].m_HitInfo.m_acc_node_info = 0;
-                    hitPacket[i].m_hitresult = false;
-                }
+        for( unsigned int y = 0; y < (RAYPACKET_DIM - 1); ++y )
+        {
 
-                //  Intersect packet block
-                m_accelerator->Intersect( blockPacket, hitPacket );
+            const SFVEC3F     bgColorY = bgColor[y];
+            const CCOLORRGB   bgColorYRGB = CCOLORRGB( bgColorY );
 
+            // This stores cRTB from the last block to be reused next time in a cLTB pixel
+            CCOLORRGB cRTB_old;
 
-                // Calculate background gradient color
-                // /////////////////////////////////////////////////////////////////////
-                SFVEC3F bgColor[RAYPACKET_DIM];
+            //RAY       cRTB_ray;
+            //HITINFO   cRTB_hitInfo;
 
-                for( unsigned int y = 0; y < RAYPACKET_DIM; ++y )
-                {
-                    const float posYfactor = (float)(windowsPos.y + y * 4.0f) / (float)m_windowSize.y;
+            for( unsigned int x = 0; x < (RAYPACKET_DIM - 1); ++x )
+            {
+                //      pxl 0  pxl 1  pxl 2  pxl 3  pxl 4
+                //        x0                          x1  ...
+                //     .---------------------------.
+                // y0  | cLT  | cxxx | cLRT | cxxx | cRT  |
+                //     | cxxx | cLTC | cxxx | cRTC | cxxx |
+                //     | cLTB | cxxx | cC   | cxxx | cRTB |
+                //     | cxxx | cLBC | cxxx | cRBC | cxxx |
+                //     '---------------------------'
+                // y1  | cLB  | cxxx | cLRB | cxxx | cRB  |
 
-                    bgColor[y] = (SFVEC3F)m_settings.m_BgColorTop * SFVEC3F(posYfactor) +
-                                 (SFVEC3F)m_settings.m_BgColorBot * ( SFVEC3F(1.0f) - SFVEC3F(posYfactor) );
-                }
+                const unsigned int iLT = ((x + 0) + RAYPACKET_DIM * (y + 0));
+                const unsigned int iRT = ((x + 1) + RAYPACKET_DIM * (y + 0));
+                const unsigned int iLB = ((x + 0) + RAYPACKET_DIM * (y + 1));
+                const unsigned int iRB = ((x + 1) + RAYPACKET_DIM * (y + 1));
 
-                CCOLORRGB hitColorShading[RAYPACKET_RAYS_PER_PACKET];
+                // !TODO: skip when there are no hits
 
-                for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
-                {
-                    const SFVEC3F bhColorY = bgColor[i / RAYPACKET_DIM];
 
-                    if( hitPacket[i].m_hitresult == true )
-                    {
-                        const SFVEC3F hitColor = shadeHit( bhColorY,
-                                                           blockPacket.m_ray[i],
-                                                           hitPacket[i].m_HitInfo,
-                                                           false,
-                                                           0,
-                                                           false );
-
-                        hitColorShading[i] = CCOLORRGB( hitColor );
-                    }
-                    else
-                        hitColorShading[i] = bhColorY;
-                }
+                const CCOLORRGB &cLT = hitColorShading[ iLT ];
+                const CCOLORRGB &cRT = hitColorShading[ iRT ];
+                const CCOLORRGB &cLB = hitColorShading[ iLB ];
+                const CCOLORRGB &cRB = hitColorShading[ iRB ];
 
-                CCOLORRGB cLRB_old[(RAYPACKET_DIM - 1)];
+                // Trace and shade cC
+                // /////////////////////////////////////////////////////////////
+                CCOLORRGB cC = bgColorYRGB;
 
-                for( unsigned int y = 0; y < (RAYPACKET_DIM - 1); ++y )
-                {
+                const SFVEC3F &oriLT = blockPacket.m_ray[ iLT ].m_Origin;
+                const SFVEC3F &oriRB = blockPacket.m_ray[ iRB ].m_Origin;
 
-                    const SFVEC3F     bgColorY = bgColor[y];
-                    const CCOLORRGB   bgColorYRGB = CCOLORRGB( bgColorY );
+                const SFVEC3F &dirLT = blockPacket.m_ray[ iLT ].m_Dir;
+                const SFVEC3F &dirRB = blockPacket.m_ray[ iRB ].m_Dir;
 
-                    // This stores cRTB from the last block to be reused next time in a cLTB pixel
-                    CCOLORRGB cRTB_old;
+                SFVEC3F oriC;
+                SFVEC3F dirC;
 
-                    //RAY       cRTB_ray;
-                    //HITINFO   cRTB_hitInfo;
+                HITINFO centerHitInfo;
+                centerHitInfo.m_tHit = std::numeric_limits<float>::infinity();
 
-                    for( unsigned int x = 0; x < (RAYPACKET_DIM - 1); ++x )
-                    {
-                        //      pxl 0  pxl 1  pxl 2  pxl 3  pxl 4
-                        //        x0                          x1  ...
-                        //     .---------------------------.
-                        // y0  | cLT  | cxxx | cLRT | cxxx | cRT  |
-                        //     | cxxx | cLTC | cxxx | cRTC | cxxx |
-                        //     | cLTB | cxxx | cC   | cxxx | cRTB |
-                        //     | cxxx | cLBC | cxxx | cRBC | cxxx |
-                        //     '---------------------------'
-                        // y1  | cLB  | cxxx | cLRB | cxxx | cRB  |
+                bool hittedC = false;
 
-                        const unsigned int iLT = ((x + 0) + RAYPACKET_DIM * (y + 0));
-                        const unsigned int iRT = ((x + 1) + RAYPACKET_DIM * (y + 0));
-                        const unsigned int iLB = ((x + 0) + RAYPACKET_DIM * (y + 1));
-                        const unsigned int iRB = ((x + 1) + RAYPACKET_DIM * (y + 1));
+                if( (hitPacket[ iLT ].m_hitresult == true) ||
+                    (hitPacket[ iRT ].m_hitresult == true) ||
+                    (hitPacket[ iLB ].m_hitresult == true) ||
+                    (hitPacket[ iRB ].m_hitresult == true) )
+                {
 
-                        // !TODO: skip when there are no hits
+                    oriC = ( oriLT + oriRB ) * 0.5f;
+                    dirC = glm::normalize( ( dirLT + dirRB ) * 0.5f );
 
+                    // Trace the center ray
+                    RAY centerRay;
+                    centerRay.Init( oriC, dirC );
 
-                        const CCOLORRGB &cLT = hitColorShading[ iLT ];
-                        const CCOLORRGB &cRT = hitColorShading[ iRT ];
-                        const CCOLORRGB &cLB = hitColorShading[ iLB ];
-                        const CCOLORRGB &cRB = hitColorShading[ iRB ];
+                    const unsigned int nodeLT = hitPacket[ iLT ].m_HitInfo.m_acc_node_info;
+                    const unsigned int nodeRT = hitPacket[ iRT ].m_HitInfo.m_acc_node_info;
+                    const unsigned int nodeLB = hitPacket[ iLB ].m_HitInfo.m_acc_node_info;
+                    const unsigned int nodeRB = hitPacket[ iRB ].m_HitInfo.m_acc_node_info;
 
-                        // Trace and shade cC
-                        // /////////////////////////////////////////////////////////////
-                        CCOLORRGB cC = bgColorYRGB;
+                    if( nodeLT != 0 )
+                        hittedC |= m_accelerator->Intersect( centerRay, centerHitInfo, nodeLT );
 
-                        const SFVEC3F &oriLT = blockPacket.m_ray[ iLT ].m_Origin;
-                        const SFVEC3F &oriRB = blockPacket.m_ray[ iRB ].m_Origin;
+                    if( ( nodeRT != 0 ) &&
+                        ( nodeRT != nodeLT ) )
+                        hittedC |= m_accelerator->Intersect( centerRay, centerHitInfo, nodeRT );
 
-                        const SFVEC3F &dirLT = blockPacket.m_ray[ iLT ].m_Dir;
-                        const SFVEC3F &dirRB = blockPacket.m_ray[ iRB ].m_Dir;
+                    if( ( nodeLB != 0 ) &&
+                        ( nodeLB != nodeLT ) &&
+                        ( nodeLB != nodeRT ) )
+                            hittedC |= m_accelerator->Intersect( centerRay, centerHitInfo, nodeLB );
 
-                        SFVEC3F oriC;
-                        SFVEC3F dirC;
+                    if( ( nodeRB != 0 ) &&
+                        ( nodeRB != nodeLB ) &&
+                        ( nodeRB != nodeLT ) &&
+                        ( nodeRB != nodeRT ) )
+                            hittedC |= m_accelerator->Intersect( centerRay, centerHitInfo, nodeRB );
 
-                        HITINFO centerHitInfo;
+                    if( hittedC )
+                        cC = CCOLORRGB( shadeHit( bgColorY, centerRay, centerHitInfo, false, 0, false ) );
+                    else
+                    {
                         centerHitInfo.m_tHit = std::numeric_limits<float>::infinity();
+                        hittedC = m_accelerator->Intersect( centerRay, centerHitInfo );
+
+                        if( hittedC )
+                            cC = CCOLORRGB( shadeHit( bgColorY,
+                                                      centerRay,
+                                                      centerHitInfo,
+                                                      false,
+                                                      0,
+                                                      false ) );
+                    }
+                }
 
-                        bool hittedC = false;
+                // Trace and shade cLRT
+                // /////////////////////////////////////////////////////////////
+                CCOLORRGB cLRT = bgColorYRGB;
 
-                        if( (hitPacket[ iLT ].m_hitresult == true) ||
-                            (hitPacket[ iRT ].m_hitresult == true) ||
-                            (hitPacket[ iLB ].m_hitresult == true) ||
-                            (hitPacket[ iRB ].m_hitresult == true) )
-                        {
+                const SFVEC3F &oriRT = blockPacket.m_ray[ iRT ].m_Origin;
+                const SFVEC3F &dirRT = blockPacket.m_ray[ iRT ].m_Dir;
 
-                            oriC = ( oriLT + oriRB ) * 0.5f;
-                            dirC = glm::normalize( ( dirLT + dirRB ) * 0.5f );
+                if( y == 0 )
+                {
+                    // Trace the center ray
+                    RAY rayLRT;
+                    rayLRT.Init( ( oriLT + oriRT ) * 0.5f,
+                                    glm::normalize( ( dirLT + dirRT ) * 0.5f ) );
 
-                            // Trace the center ray
-                            RAY centerRay;
-                            centerRay.Init( oriC, dirC );
+                    HITINFO hitInfoLRT;
+                    hitInfoLRT.m_tHit = std::numeric_limits<float>::infinity();
 
+                    if( hitPacket[ iLT ].m_hitresult &&
+                        hitPacket[ iRT ].m_hitresult &&
+                        (hitPacket[ iLT ].m_HitInfo.pHitObject == hitPacket[ iRT ].m_HitInfo.pHitObject) )
+                    {
+                        hitInfoLRT.pHitObject = hitPacket[ iLT ].m_HitInfo.pHitObject;
+                        hitInfoLRT.m_tHit = ( hitPacket[ iLT ].m_HitInfo.m_tHit +
+                                              hitPacket[ iRT ].m_HitInfo.m_tHit ) * 0.5f;
+                        hitInfoLRT.m_HitNormal =
+                                glm::normalize( ( hitPacket[ iLT ].m_HitInfo.m_HitNormal +
+                                                  hitPacket[ iRT ].m_HitInfo.m_HitNormal ) * 0.5f );
+
+                        cLRT = CCOLORRGB( shadeHit( bgColorY, rayLRT, hitInfoLRT, false, 0, false ) );
+                        cLRT = BlendColor( cLRT, BlendColor( cLT, cRT) );
+                    }
+                    else
+                    {
+                        if( hitPacket[ iLT ].m_hitresult ||
+                            hitPacket[ iRT ].m_hitresult )                  // If any hits
+                        {
                             const unsigned int nodeLT = hitPacket[ iLT ].m_HitInfo.m_acc_node_info;
                             const unsigned int nodeRT = hitPacket[ iRT ].m_HitInfo.m_acc_node_info;
-                            const unsigned int nodeLB = hitPacket[ iLB ].m_HitInfo.m_acc_node_info;
-                            const unsigned int nodeRB = hitPacket[ iRB ].m_HitInfo.m_acc_node_info;
+
+                            bool hittedLRT = false;
 
                             if( nodeLT != 0 )
-                                hittedC |= m_accelerator->Intersect( centerRay, centerHitInfo, nodeLT );
+                                hittedLRT |= m_accelerator->Intersect( rayLRT, hitInfoLRT, nodeLT );
 
                             if( ( nodeRT != 0 ) &&
                                 ( nodeRT != nodeLT ) )
-                                hittedC |= m_accelerator->Intersect( centerRay, centerHitInfo, nodeRT );
-
-                            if( ( nodeLB != 0 ) &&
-                                ( nodeLB != nodeLT ) &&
-                                ( nodeLB != nodeRT ) )
-                                    hittedC |= m_accelerator->Intersect( centerRay, centerHitInfo, nodeLB );
-
-                            if( ( nodeRB != 0 ) &&
-                                ( nodeRB != nodeLB ) &&
-                                ( nodeRB != nodeLT ) &&
-                                ( nodeRB != nodeRT ) )
-                                    hittedC |= m_accelerator->Intersect( centerRay, centerHitInfo, nodeRB );
-
-                            if( hittedC )
-                                cC = CCOLORRGB( shadeHit( bgColorY, centerRay, centerHitInfo, false, 0, false ) );
+                                hittedLRT |= m_accelerator->Intersect( rayLRT,
+                                                                       hitInfoLRT,
+                                                                       nodeRT );
+
+                            if( hittedLRT )
+                                cLRT = CCOLORRGB( shadeHit( bgColorY,
+                                                            rayLRT,
+                                                            hitInfoLRT,
+                                                            false,
+                                                            0,
+                                                            false ) );
                             else
                             {
-                                centerHitInfo.m_tHit = std::numeric_limits<float>::infinity();
-                                hittedC = m_accelerator->Intersect( centerRay, centerHitInfo );
-
-                                if( hittedC )
-                                    cC = CCOLORRGB( shadeHit( bgColorY,
-                                                              centerRay,
-                                                              centerHitInfo,
-                                                              false,
-                                                              0,
-                                                              false ) );
+                                hitInfoLRT.m_tHit = std::numeric_limits<float>::infinity();
+
+                                if( m_accelerator->Intersect( rayLRT,hitInfoLRT ) )
+                                    cLRT = CCOLORRGB( shadeHit( bgColorY,
+                                                                rayLRT,
+                                                                hitInfoLRT,
+                                                                false,
+                                                                0,
+                                                                false ) );
                             }
                         }
+                    }
+                }
+                else
+                    cLRT = cLRB_old[x];
 
-                        // Trace and shade cLRT
-                        // /////////////////////////////////////////////////////////////
-                        CCOLORRGB cLRT = bgColorYRGB;
-
-                        const SFVEC3F &oriRT = blockPacket.m_ray[ iRT ].m_Origin;
-                        const SFVEC3F &dirRT = blockPacket.m_ray[ iRT ].m_Dir;
-
-                        if( y == 0 )
-                        {
-                            // Trace the center ray
-                            RAY rayLRT;
-                            rayLRT.Init( ( oriLT + oriRT ) * 0.5f,
-                                            glm::normalize( ( dirLT + dirRT ) * 0.5f ) );
 
-                            HITINFO hitInfoLRT;
-                            hitInfoLRT.m_tHit = std::numeric_limits<float>::infinity();
+                // Trace and shade cLTB
+                // /////////////////////////////////////////////////////////////
+                CCOLORRGB cLTB = bgColorYRGB;
 
-                            if( hitPacket[ iLT ].m_hitresult &&
-                                hitPacket[ iRT ].m_hitresult &&
-                                (hitPacket[ iLT ].m_HitInfo.pHitObject == hitPacket[ iRT ].m_HitInfo.pHitObject) )
-                            {
-                                hitInfoLRT.pHitObject = hitPacket[ iLT ].m_HitInfo.pHitObject;
-                                hitInfoLRT.m_tHit = ( hitPacket[ iLT ].m_HitInfo.m_tHit +
-                                                      hitPacket[ iRT ].m_HitInfo.m_tHit ) * 0.5f;
-                                hitInfoLRT.m_HitNormal =
-                                        glm::normalize( ( hitPacket[ iLT ].m_HitInfo.m_HitNormal +
-                                                          hitPacket[ iRT ].m_HitInfo.m_HitNormal ) * 0.5f );
-
-                                cLRT = CCOLORRGB( shadeHit( bgColorY, rayLRT, hitInfoLRT, false, 0, false ) );
-                                cLRT = BlendColor( cLRT, BlendColor( cLT, cRT) );
-                            }
-                            else
-                            {
-                                if( hitPacket[ iLT ].m_hitresult ||
-                                    hitPacket[ iRT ].m_hitresult )                  // If any hits
-                                {
-                                    const unsigned int nodeLT = hitPacket[ iLT ].m_HitInfo.m_acc_node_info;
-                                    const unsigned int nodeRT = hitPacket[ iRT ].m_HitInfo.m_acc_node_info;
-
-                                    bool hittedLRT = false;
-
-                                    if( nodeLT != 0 )
-                                        hittedLRT |= m_accelerator->Intersect( rayLRT, hitInfoLRT, nodeLT );
-
-                                    if( ( nodeRT != 0 ) &&
-                                        ( nodeRT != nodeLT ) )
-                                        hittedLRT |= m_accelerator->Intersect( rayLRT,
-                                                                               hitInfoLRT,
-                                                                               nodeRT );
-
-                                    if( hittedLRT )
-                                        cLRT = CCOLORRGB( shadeHit( bgColorY,
-                                                                    rayLRT,
-                                                                    hitInfoLRT,
-                                                                    false,
-                                                                    0,
-                                                                    false ) );
-                                    else
-                                    {
-                                        hitInfoLRT.m_tHit = std::numeric_limits<float>::infinity();
-
-                                        if( m_accelerator->Intersect( rayLRT,hitInfoLRT ) )
-                                            cLRT = CCOLORRGB( shadeHit( bgColorY,
-                                                                        rayLRT,
-                                                                        hitInfoLRT,
-                                                                        false,
-                                                                        0,
-                                                                        false ) );
-                                    }
-                                }
-                            }
-                        }
-                        else
-                            cLRT = cLRB_old[x];
+                if( x == 0 )
+                {
+                    const SFVEC3F &oriLB = blockPacket.m_ray[ iLB ].m_Origin;
+                    const SFVEC3F &dirLB = blockPacket.m_ray[ iLB ].m_Dir;
 
+                    // Trace the center ray
+                    RAY rayLTB;
+                    rayLTB.Init( ( oriLT + oriLB ) * 0.5f,
+                                    glm::normalize( ( dirLT + dirLB ) * 0.5f ) );
 
-                        // Trace and shade cLTB
-                        // /////////////////////////////////////////////////////////////
-                        CCOLORRGB cLTB = bgColorYRGB;
+                    HITINFO hitInfoLTB;
+                    hitInfoLTB.m_tHit = std::numeric_limits<float>::infinity();
 
-                        if( x == 0 )
+                    if( hitPacket[ iLT ].m_hitresult &&
+                        hitPacket[ iLB ].m_hitresult &&
+                        ( hitPacket[ iLT ].m_HitInfo.pHitObject ==
+                          hitPacket[ iLB ].m_HitInfo.pHitObject ) )
+                    {
+                        hitInfoLTB.pHitObject = hitPacket[ iLT ].m_HitInfo.pHitObject;
+                        hitInfoLTB.m_tHit = ( hitPacket[ iLT ].m_HitInfo.m_tHit +
+                                              hitPacket[ iLB ].m_HitInfo.m_tHit ) * 0.5f;
+                        hitInfoLTB.m_HitNormal =
+                                glm::normalize( ( hitPacket[ iLT ].m_HitInfo.m_HitNormal +
+                                                  hitPacket[ iLB ].m_HitInfo.m_HitNormal ) * 0.5f );
+                        cLTB = CCOLORRGB( shadeHit( bgColorY, rayLTB, hitInfoLTB, false, 0, false ) );
+                        cLTB = BlendColor( cLTB, BlendColor( cLT, cLB) );
+                    }
+                    else
+                    {
+                        if( hitPacket[ iLT ].m_hitresult ||
+                            hitPacket[ iLB ].m_hitresult )                  // If any hits
                         {
-                            const SFVEC3F &oriLB = blockPacket.m_ray[ iLB ].m_Origin;
-                            const SFVEC3F &dirLB = blockPacket.m_ray[ iLB ].m_Dir;
+                            const unsigned int nodeLT = hitPacket[ iLT ].m_HitInfo.m_acc_node_info;
+                            const unsigned int nodeLB = hitPacket[ iLB ].m_HitInfo.m_acc_node_info;
 
-                            // Trace the center ray
-                            RAY rayLTB;
-                            rayLTB.Init( ( oriLT + oriLB ) * 0.5f,
-                                            glm::normalize( ( dirLT + dirLB ) * 0.5f ) );
+                            bool hittedLTB = false;
 
-                            HITINFO hitInfoLTB;
-                            hitInfoLTB.m_tHit = std::numeric_limits<float>::infinity();
+                            if( nodeLT != 0 )
+                                hittedLTB |= m_accelerator->Intersect( rayLTB,
+                                                                       hitInfoLTB,
+                                                                       nodeLT );
 
-                            if( hitPacket[ iLT ].m_hitresult &&
-                                hitPacket[ iLB ].m_hitresult &&
-                                ( hitPacket[ iLT ].m_HitInfo.pHitObject ==
-                                  hitPacket[ iLB ].m_HitInfo.pHitObject ) )
-                            {
-                                hitInfoLTB.pHitObject = hitPacket[ iLT ].m_HitInfo.pHitObject;
-                                hitInfoLTB.m_tHit = ( hitPacket[ iLT ].m_HitInfo.m_tHit +
-                                                      hitPacket[ iLB ].m_HitInfo.m_tHit ) * 0.5f;
-                                hitInfoLTB.m_HitNormal =
-                                        glm::normalize( ( hitPacket[ iLT ].m_HitInfo.m_HitNormal +
-                                                          hitPacket[ iLB ].m_HitInfo.m_HitNormal ) * 0.5f );
-                                cLTB = CCOLORRGB( shadeHit( bgColorY, rayLTB, hitInfoLTB, false, 0, false ) );
-                                cLTB = BlendColor( cLTB, BlendColor( cLT, cLB) );
-                            }
+                            if( ( nodeLB != 0 ) &&
+                                ( nodeLB != nodeLT ) )
+                                hittedLTB |= m_accelerator->Intersect( rayLTB,
+                                                                       hitInfoLTB,
+                                                                       nodeLB );
+
+                            if( hittedLTB )
+                                cLTB = CCOLORRGB( shadeHit( bgColorY,
+                                                            rayLTB,
+                                                            hitInfoLTB,
+                                                            false,
+                                                            0,
+                                                            false ) );
                             else
                             {
-                                if( hitPacket[ iLT ].m_hitresult ||
-                                    hitPacket[ iLB ].m_hitresult )                  // If any hits
-                                {
-                                    const unsigned int nodeLT = hitPacket[ iLT ].m_HitInfo.m_acc_node_info;
-                                    const unsigned int nodeLB = hitPacket[ iLB ].m_HitInfo.m_acc_node_info;
-
-                                    bool hittedLTB = false;
-
-                                    if( nodeLT != 0 )
-                                        hittedLTB |= m_accelerator->Intersect( rayLTB,
-                                                                               hitInfoLTB,
-                                                                               nodeLT );
-
-                                    if( ( nodeLB != 0 ) &&
-                                        ( nodeLB != nodeLT ) )
-                                        hittedLTB |= m_accelerator->Intersect( rayLTB,
-                                                                               hitInfoLTB,
-                                                                               nodeLB );
-
-                                    if( hittedLTB )
-                                        cLTB = CCOLORRGB( shadeHit( bgColorY,
-                                                                    rayLTB,
-                                                                    hitInfoLTB,
-                                                                    false,
-                                                                    0,
-                                                                    false ) );
-                                    else
-                                    {
-                                        hitInfoLTB.m_tHit = std::numeric_limits<float>::infinity();
-
-                                        if( m_accelerator->Intersect( rayLTB, hitInfoLTB ) )
-                                            cLTB = CCOLORRGB( shadeHit( bgColorY,
-                                                                        rayLTB,
-                                                                        hitInfoLTB,
-                                                                        false,
-                                                                        0,
-                                                                        false ) );
-                                    }
-                                }
+                                hitInfoLTB.m_tHit = std::numeric_limits<float>::infinity();
+
+                                if( m_accelerator->Intersect( rayLTB, hitInfoLTB ) )
+                                    cLTB = CCOLORRGB( shadeHit( bgColorY,
+                                                                rayLTB,
+                                                                hitInfoLTB,
+                                                                false,
+                                                                0,
+                                                                false ) );
                             }
                         }
-                        else
-                            cLTB = cRTB_old;
+                    }
+                }
+                else
+                    cLTB = cRTB_old;
 
 
-                        // Trace and shade cRTB
-                        // /////////////////////////////////////////////////////////////
-                        CCOLORRGB cRTB = bgColorYRGB;
+                // Trace and shade cRTB
+                // /////////////////////////////////////////////////////////////
+                CCOLORRGB cRTB = bgColorYRGB;
 
-                        // Trace the center ray
-                        RAY rayRTB;
-                        rayRTB.Init( ( oriRT + oriRB ) * 0.5f,
-                                        glm::normalize( ( dirRT + dirRB ) * 0.5f ) );
+                // Trace the center ray
+                RAY rayRTB;
+                rayRTB.Init( ( oriRT + oriRB ) * 0.5f,
+                                glm::normalize( ( dirRT + dirRB ) * 0.5f ) );
 
-                        HITINFO hitInfoRTB;
-                        hitInfoRTB.m_tHit = std::numeric_limits<float>::infinity();
+                HITINFO hitInfoRTB;
+                hitInfoRTB.m_tHit = std::numeric_limits<float>::infinity();
 
-                        if( hitPacket[ iRT ].m_hitresult &&
-                            hitPacket[ iRB ].m_hitresult &&
-                            ( hitPacket[ iRT ].m_HitInfo.pHitObject ==
-                              hitPacket[ iRB ].m_HitInfo.pHitObject ) )
-                        {
-                            hitInfoRTB.pHitObject = hitPacket[ iRT ].m_HitInfo.pHitObject;
+                if( hitPacket[ iRT ].m_hitresult &&
+                    hitPacket[ iRB ].m_hitresult &&
+                    ( hitPacket[ iRT ].m_HitInfo.pHitObject ==
+                      hitPacket[ iRB ].m_HitInfo.pHitObject ) )
+                {
+                    hitInfoRTB.pHitObject = hitPacket[ iRT ].m_HitInfo.pHitObject;
 
-                            hitInfoRTB.m_tHit = ( hitPacket[ iRT ].m_HitInfo.m_tHit +
-                                                  hitPacket[ iRB ].m_HitInfo.m_tHit ) * 0.5f;
+                    hitInfoRTB.m_tHit = ( hitPacket[ iRT ].m_HitInfo.m_tHit +
+                                          hitPacket[ iRB ].m_HitInfo.m_tHit ) * 0.5f;
 
-                            hitInfoRTB.m_HitNormal =
-                                    glm::normalize( ( hitPacket[ iRT ].m_HitInfo.m_HitNormal +
-                                                      hitPacket[ iRB ].m_HitInfo.m_HitNormal ) * 0.5f );
+                    hitInfoRTB.m_HitNormal =
+                            glm::normalize( ( hitPacket[ iRT ].m_HitInfo.m_HitNormal +
+                                              hitPacket[ iRB ].m_HitInfo.m_HitNormal ) * 0.5f );
 
-                            cRTB = CCOLORRGB( shadeHit( bgColorY, rayRTB, hitInfoRTB, false, 0, false ) );
-                            cRTB = BlendColor( cRTB, BlendColor( cRT, cRB) );
-                        }
+                    cRTB = CCOLORRGB( shadeHit( bgColorY, rayRTB, hitInfoRTB, false, 0, false ) );
+                    cRTB = BlendColor( cRTB, BlendColor( cRT, cRB) );
+                }
+                else
+                {
+                    if( hitPacket[ iRT ].m_hitresult ||
+                        hitPacket[ iRB ].m_hitresult )                  // If any hits
+                    {
+                        const unsigned int nodeRT = hitPacket[ iRT ].m_HitInfo.m_acc_node_info;
+                        const unsigned int nodeRB = hitPacket[ iRB ].m_HitInfo.m_acc_node_info;
+
+                        bool hittedRTB = false;
+
+                        if( nodeRT != 0 )
+                            hittedRTB |= m_accelerator->Intersect( rayRTB, hitInfoRTB, nodeRT );
+
+                        if( ( nodeRB != 0 ) &&
+                            ( nodeRB != nodeRT ) )
+                            hittedRTB |= m_accelerator->Intersect( rayRTB, hitInfoRTB, nodeRB );
+
+                        if( hittedRTB )
+                            cRTB = CCOLORRGB( shadeHit( bgColorY,
+                                                        rayRTB,
+                                                        hitInfoRTB,
+                                                        false,
+                                                        0,
+                                                        false) );
                         else
                         {
-                            if( hitPacket[ iRT ].m_hitresult ||
-                                hitPacket[ iRB ].m_hitresult )                  // If any hits
-                            {
-                                const unsigned int nodeRT = hitPacket[ iRT ].m_HitInfo.m_acc_node_info;
-                                const unsigned int nodeRB = hitPacket[ iRB ].m_HitInfo.m_acc_node_info;
+                            hitInfoRTB.m_tHit = std::numeric_limits<float>::infinity();
+
+                            if( m_accelerator->Intersect( rayRTB, hitInfoRTB ) )
+                                cRTB = CCOLORRGB( shadeHit( bgColorY,
+                                                            rayRTB,
+                                                            hitInfoRTB,
+                                                            false,
+                                                            0,
+                                                            false ) );
+                        }
+                    }
+                }
 
-                                bool hittedRTB = false;
+                cRTB_old = cRTB;
 
-                                if( nodeRT != 0 )
-                                    hittedRTB |= m_accelerator->Intersect( rayRTB, hitInfoRTB, nodeRT );
 
-                                if( ( nodeRB != 0 ) &&
-                                    ( nodeRB != nodeRT ) )
-                                    hittedRTB |= m_accelerator->Intersect( rayRTB, hitInfoRTB, nodeRB );
+                // Trace and shade cLRB
+                // /////////////////////////////////////////////////////////////
+                CCOLORRGB cLRB = bgColorYRGB;
 
-                                if( hittedRTB )
-                                    cRTB = CCOLORRGB( shadeHit( bgColorY,
-                                                                rayRTB,
-                                                                hitInfoRTB,
-                                                                false,
-                                                                0,
-                                                                false) );
-                                else
-                                {
-                                    hitInfoRTB.m_tHit = std::numeric_limits<float>::infinity();
-
-                                    if( m_accelerator->Intersect( rayRTB, hitInfoRTB ) )
-                                        cRTB = CCOLORRGB( shadeHit( bgColorY,
-                                                                    rayRTB,
-                                                                    hitInfoRTB,
-                                                                    false,
-                                                                    0,
-                                                                    false ) );
-                                }
-                            }
-                        }
+                const SFVEC3F &oriLB = blockPacket.m_ray[ iLB ].m_Origin;
+                const SFVEC3F &dirLB = blockPacket.m_ray[ iLB ].m_Dir;
 
-                        cRTB_old = cRTB;
+                // Trace the center ray
+                RAY rayLRB;
+                rayLRB.Init( ( oriLB + oriRB ) * 0.5f,
+                                glm::normalize( ( dirLB + dirRB ) * 0.5f ) );
 
+                HITINFO hitInfoLRB;
+                hitInfoLRB.m_tHit = std::numeric_limits<float>::infinity();
 
-                        // Trace and shade cLRB
-                        // /////////////////////////////////////////////////////////////
-                        CCOLORRGB cLRB = bgColorYRGB;
+                if( hitPacket[ iLB ].m_hitresult &&
+                    hitPacket[ iRB ].m_hitresult &&
+                    ( hitPacket[ iLB ].m_HitInfo.pHitObject ==
+                      hitPacket[ iRB ].m_HitInfo.pHitObject ) )
+                {
+                    hitInfoLRB.pHitObject = hitPacket[ iLB ].m_HitInfo.pHitObject;
 
-                        const SFVEC3F &oriLB = blockPacket.m_ray[ iLB ].m_Origin;
-                        const SFVEC3F &dirLB = blockPacket.m_ray[ iLB ].m_Dir;
+                    hitInfoLRB.m_tHit = ( hitPacket[ iLB ].m_HitInfo.m_tHit +
+                                          hitPacket[ iRB ].m_HitInfo.m_tHit ) * 0.5f;
 
-                        // Trace the center ray
-                        RAY rayLRB;
-                        rayLRB.Init( ( oriLB + oriRB ) * 0.5f,
-                                        glm::normalize( ( dirLB + dirRB ) * 0.5f ) );
+                    hitInfoLRB.m_HitNormal =
+                            glm::normalize( ( hitPacket[ iLB ].m_HitInfo.m_HitNormal +
+                                              hitPacket[ iRB ].m_HitInfo.m_HitNormal ) * 0.5f );
 
-                        HITINFO hitInfoLRB;
-                        hitInfoLRB.m_tHit = std::numeric_limits<float>::infinity();
+                    cLRB = CCOLORRGB( shadeHit( bgColorY, rayLRB, hitInfoLRB, false, 0, false ) );
+                    cLRB = BlendColor( cLRB, BlendColor( cLB, cRB) );
+                }
+                else
+                {
+                    if( hitPacket[ iLB ].m_hitresult ||
+                        hitPacket[ iRB ].m_hitresult )                  // If any hits
+                    {
+                        const unsigned int nodeLB = hitPacket[ iLB ].m_HitInfo.m_acc_node_info;
+                        const unsigned int nodeRB = hitPacket[ iRB ].m_HitInfo.m_acc_node_info;
 
-                        if( hitPacket[ iLB ].m_hitresult &&
-                            hitPacket[ iRB ].m_hitresult &&
-                            ( hitPacket[ iLB ].m_HitInfo.pHitObject ==
-                              hitPacket[ iRB ].m_HitInfo.pHitObject ) )
-                        {
-                            hitInfoLRB.pHitObject = hitPacket[ iLB ].m_HitInfo.pHitObject;
+                        bool hittedLRB = false;
 
-                            hitInfoLRB.m_tHit = ( hitPacket[ iLB ].m_HitInfo.m_tHit +
-                                                  hitPacket[ iRB ].m_HitInfo.m_tHit ) * 0.5f;
+                        if( nodeLB != 0 )
+                            hittedLRB |= m_accelerator->Intersect( rayLRB, hitInfoLRB, nodeLB );
 
-                            hitInfoLRB.m_HitNormal =
-                                    glm::normalize( ( hitPacket[ iLB ].m_HitInfo.m_HitNormal +
-                                                      hitPacket[ iRB ].m_HitInfo.m_HitNormal ) * 0.5f );
+                        if( ( nodeRB != 0 ) &&
+                            ( nodeRB != nodeLB ) )
+                            hittedLRB |= m_accelerator->Intersect( rayLRB, hitInfoLRB, nodeRB );
 
+                        if( hittedLRB )
                             cLRB = CCOLORRGB( shadeHit( bgColorY, rayLRB, hitInfoLRB, false, 0, false ) );
-                            cLRB = BlendColor( cLRB, BlendColor( cLB, cRB) );
-                        }
                         else
                         {
-                            if( hitPacket[ iLB ].m_hitresult ||
-                                hitPacket[ iRB ].m_hitresult )                  // If any hits
-                            {
-                                const unsigned int nodeLB = hitPacket[ iLB ].m_HitInfo.m_acc_node_info;
-                                const unsigned int nodeRB = hitPacket[ iRB ].m_HitInfo.m_acc_node_info;
-
-                                bool hittedLRB = false;
-
-                                if( nodeLB != 0 )
-                                    hittedLRB |= m_accelerator->Intersect( rayLRB, hitInfoLRB, nodeLB );
-
-                                if( ( nodeRB != 0 ) &&
-                                    ( nodeRB != nodeLB ) )
-                                    hittedLRB |= m_accelerator->Intersect( rayLRB, hitInfoLRB, nodeRB );
-
-                                if( hittedLRB )
-                                    cLRB = CCOLORRGB( shadeHit( bgColorY, rayLRB, hitInfoLRB, false, 0, false ) );
-                                else
-                                {
-                                    hitInfoLRB.m_tHit = std::numeric_limits<float>::infinity();
-
-                                    if( m_accelerator->Intersect( rayLRB, hitInfoLRB ) )
-                                        cLRB = CCOLORRGB( shadeHit( bgColorY,
-                                                                    rayLRB,
-                                                                    hitInfoLRB,
-                                                                    false,
-                                                                    0,
-                                                                    false ) );
-                                }
-                            }
+                            hitInfoLRB.m_tHit = std::numeric_limits<float>::infinity();
+
+                            if( m_accelerator->Intersect( rayLRB, hitInfoLRB ) )
+                                cLRB = CCOLORRGB( shadeHit( bgColorY,
+                                                            rayLRB,
+                                                            hitInfoLRB,
+                                                            false,
+                                                            0,
+                                                            false ) );
                         }
+                    }
+                }
 
-                        cLRB_old[x] = cLRB;
-
+                cLRB_old[x] = cLRB;
 
-                        // Trace and shade cLTC
-                        // /////////////////////////////////////////////////////////////
-                        CCOLORRGB cLTC = BlendColor( cLT , cC );
 
-                        if( hitPacket[ iLT ].m_hitresult || hittedC )
-                        {
-                            // Trace the center ray
-                            RAY rayLTC;
-                            rayLTC.Init( ( oriLT + oriC ) * 0.5f,
-                                         glm::normalize( ( dirLT + dirC ) * 0.5f ) );
+                // Trace and shade cLTC
+                // /////////////////////////////////////////////////////////////
+                CCOLORRGB cLTC = BlendColor( cLT , cC );
 
-                            HITINFO hitInfoLTC;
-                            hitInfoLTC.m_tHit = std::numeric_limits<float>::infinity();
+                if( hitPacket[ iLT ].m_hitresult || hittedC )
+                {
+                    // Trace the center ray
+                    RAY rayLTC;
+                    rayLTC.Init( ( oriLT + oriC ) * 0.5f,
+                                 glm::normalize( ( dirLT + dirC ) * 0.5f ) );
 
-                            bool hitted = false;
+                    HITINFO hitInfoLTC;
+                    hitInfoLTC.m_tHit = std::numeric_limits<float>::infinity();
 
-                            if( hittedC )
-                                hitted = centerHitInfo.pHitObject->Intersect( rayLTC, hitInfoLTC );
-                            else
-                                if( hitPacket[ iLT ].m_hitresult )
-                                    hitted = hitPacket[ iLT ].m_HitInfo.pHitObject->Intersect( rayLTC,
-                                                                                               hitInfoLTC );
+                    bool hitted = false;
 
-                            if( hitted )
-                                cLTC = CCOLORRGB( shadeHit( bgColorY, rayLTC, hitInfoLTC, false, 0, false ) );
-                        }
+                    if( hittedC )
+                        hitted = centerHitInfo.pHitObject->Intersect( rayLTC, hitInfoLTC );
+                    else
+                        if( hitPacket[ iLT ].m_hitresult )
+                            hitted = hitPacket[ iLT ].m_HitInfo.pHitObject->Intersect( rayLTC,
+                                                                                       hitInfoLTC );
 
+                    if( hitted )
+                        cLTC = CCOLORRGB( shadeHit( bgColorY, rayLTC, hitInfoLTC, false, 0, false ) );
+                }
 
-                        // Trace and shade cRTC
-                        // /////////////////////////////////////////////////////////////
-                        CCOLORRGB cRTC = BlendColor( cRT , cC );
 
-                        if( hitPacket[ iRT ].m_hitresult || hittedC )
-                        {
-                            // Trace the center ray
-                            RAY rayRTC;
-                            rayRTC.Init( ( oriRT + oriC ) * 0.5f,
-                                         glm::normalize( ( dirRT + dirC ) * 0.5f ) );
+                // Trace and shade cRTC
+                // /////////////////////////////////////////////////////////////
+                CCOLORRGB cRTC = BlendColor( cRT , cC );
 
-                            HITINFO hitInfoRTC;
-                            hitInfoRTC.m_tHit = std::numeric_limits<float>::infinity();
+                if( hitPacket[ iRT ].m_hitresult || hittedC )
+                {
+                    // Trace the center ray
+                    RAY rayRTC;
+                    rayRTC.Init( ( oriRT + oriC ) * 0.5f,
+                                 glm::normalize( ( dirRT + dirC ) * 0.5f ) );
 
-                            bool hitted = false;
+                    HITINFO hitInfoRTC;
+                    hitInfoRTC.m_tHit = std::numeric_limits<float>::infinity();
 
-                            if( hittedC )
-                                hitted = centerHitInfo.pHitObject->Intersect( rayRTC, hitInfoRTC );
-                            else
-                                if( hitPacket[ iRT ].m_hitresult )
-                                    hitted = hitPacket[ iRT ].m_HitInfo.pHitObject->Intersect( rayRTC,
-                                                                                               hitInfoRTC );
+                    bool hitted = false;
 
-                            if( hitted )
-                                cRTC = CCOLORRGB( shadeHit( bgColorY, rayRTC, hitInfoRTC, false, 0, false ) );
-                        }
+                    if( hittedC )
+                        hitted = centerHitInfo.pHitObject->Intersect( rayRTC, hitInfoRTC );
+                    else
+                        if( hitPacket[ iRT ].m_hitresult )
+                            hitted = hitPacket[ iRT ].m_HitInfo.pHitObject->Intersect( rayRTC,
+                                                                                       hitInfoRTC );
 
+                    if( hitted )
+                        cRTC = CCOLORRGB( shadeHit( bgColorY, rayRTC, hitInfoRTC, false, 0, false ) );
+                }
 
-                        // Trace and shade cLBC
-                        // /////////////////////////////////////////////////////////////
-                        CCOLORRGB cLBC = BlendColor( cLB , cC );
 
-                        if( hitPacket[ iLB ].m_hitresult || hittedC )
-                        {
-                            // Trace the center ray
-                            RAY rayLBC;
-                            rayLBC.Init( ( oriLB + oriC ) * 0.5f,
-                                         glm::normalize( ( dirLB + dirC ) * 0.5f ) );
+                // Trace and shade cLBC
+                // /////////////////////////////////////////////////////////////
+                CCOLORRGB cLBC = BlendColor( cLB , cC );
 
-                            HITINFO hitInfoLBC;
-                            hitInfoLBC.m_tHit = std::numeric_limits<float>::infinity();
+                if( hitPacket[ iLB ].m_hitresult || hittedC )
+                {
+                    // Trace the center ray
+                    RAY rayLBC;
+                    rayLBC.Init( ( oriLB + oriC ) * 0.5f,
+                                 glm::normalize( ( dirLB + dirC ) * 0.5f ) );
 
-                            bool hitted = false;
+                    HITINFO hitInfoLBC;
+                    hitInfoLBC.m_tHit = std::numeric_limits<float>::infinity();
 
-                            if( hittedC )
-                                hitted = centerHitInfo.pHitObject->Intersect( rayLBC, hitInfoLBC );
-                            else
-                                if( hitPacket[ iLB ].m_hitresult )
-                                    hitted = hitPacket[ iLB ].m_HitInfo.pHitObject->Intersect( rayLBC,
-                                                                                               hitInfoLBC );
+                    bool hitted = false;
 
-                            if( hitted )
-                                cLBC = CCOLORRGB( shadeHit( bgColorY, rayLBC, hitInfoLBC, false, 0, false ) );
-                        }
+                    if( hittedC )
+                        hitted = centerHitInfo.pHitObject->Intersect( rayLBC, hitInfoLBC );
+                    else
+                        if( hitPacket[ iLB ].m_hitresult )
+                            hitted = hitPacket[ iLB ].m_HitInfo.pHitObject->Intersect( rayLBC,
+                                                                                       hitInfoLBC );
 
+                    if( hitted )
+                        cLBC = CCOLORRGB( shadeHit( bgColorY, rayLBC, hitInfoLBC, false, 0, false ) );
+                }
 
-                        // Trace and shade cRBC
-                        // /////////////////////////////////////////////////////////////
-                        CCOLORRGB cRBC = BlendColor( cRB , cC );
 
-                        if( hitPacket[ iRB ].m_hitresult || hittedC )
-                        {
-                            // Trace the center ray
-                            RAY rayRBC;
-                            rayRBC.Init( ( oriRB + oriC ) * 0.5f,
-                                         glm::normalize( ( dirRB + dirC ) * 0.5f ) );
+                // Trace and shade cRBC
+                // /////////////////////////////////////////////////////////////
+                CCOLORRGB cRBC = BlendColor( cRB , cC );
 
-                            HITINFO hitInfoRBC;
-                            hitInfoRBC.m_tHit = std::numeric_limits<float>::infinity();
+                if( hitPacket[ iRB ].m_hitresult || hittedC )
+                {
+                    // Trace the center ray
+                    RAY rayRBC;
+                    rayRBC.Init( ( oriRB + oriC ) * 0.5f,
+                                 glm::normalize( ( dirRB + dirC ) * 0.5f ) );
 
-                            bool hitted = false;
+                    HITINFO hitInfoRBC;
+                    hitInfoRBC.m_tHit = std::numeric_limits<float>::infinity();
 
-                            if( hittedC )
-                                hitted = centerHitInfo.pHitObject->Intersect( rayRBC, hitInfoRBC );
-                            else
-                                if( hitPacket[ iRB ].m_hitresult )
-                                    hitted = hitPacket[ iRB ].m_HitInfo.pHitObject->Intersect( rayRBC,
-                                                                                               hitInfoRBC );
-
-                            if( hitted )
-                                cRBC = CCOLORRGB( shadeHit( bgColorY, rayRBC, hitInfoRBC, false, 0, false ) );
-                        }
+                    bool hitted = false;
 
+                    if( hittedC )
+                        hitted = centerHitInfo.pHitObject->Intersect( rayRBC, hitInfoRBC );
+                    else
+                        if( hitPacket[ iRB ].m_hitresult )
+                            hitted = hitPacket[ iRB ].m_HitInfo.pHitObject->Intersect( rayRBC,
+                                                                                       hitInfoRBC );
 
-                        // Set pixel colors
-                        // /////////////////////////////////////////////////////////////
-
-                        GLubyte *ptr = &ptrPBO[ (4 * x + m_blockPositionsFast[iBlock].x +
-                                                 m_realBufferSize.x *
-                                                 (m_blockPositionsFast[iBlock].y + 4 * y)) * 4 ];
-                        SetPixel( ptr +  0, cLT );
-                        SetPixel( ptr +  4, BlendColor( cLT, cLRT, cLTC ) );
-                        SetPixel( ptr +  8, cLRT );
-                        SetPixel( ptr + 12, BlendColor( cLRT, cRT, cRTC ) );
-
-                        ptr += m_realBufferSize.x * 4;
-                        SetPixel( ptr +  0, BlendColor( cLT , cLTB, cLTC ) );
-                        SetPixel( ptr +  4, BlendColor( cLTC, BlendColor( cLT , cC ) ) );
-                        SetPixel( ptr +  8, BlendColor( cC, BlendColor( cLRT, cLTC, cRTC ) ) );
-                        SetPixel( ptr + 12, BlendColor( cRTC, BlendColor( cRT , cC ) ) );
-
-                        ptr += m_realBufferSize.x * 4;
-                        SetPixel( ptr +  0, cLTB );
-                        SetPixel( ptr +  4, BlendColor( cC, BlendColor( cLTB, cLTC, cLBC ) ) );
-                        SetPixel( ptr +  8, cC );
-                        SetPixel( ptr + 12, BlendColor( cC, BlendColor( cRTB, cRTC, cRBC ) ) );
-
-                        ptr += m_realBufferSize.x * 4;
-                        SetPixel( ptr +  0, BlendColor( cLB , cLTB, cLBC ) );
-                        SetPixel( ptr +  4, BlendColor( cLBC, BlendColor( cLB , cC ) ) );
-                        SetPixel( ptr +  8, BlendColor( cC, BlendColor( cLRB, cLBC, cRBC ) ) );
-                        SetPixel( ptr + 12, BlendColor( cRBC, BlendColor( cRB , cC ) ) );
-                    }
+                    if( hitted )
+                        cRBC = CCOLORRGB( shadeHit( bgColorY, rayRBC, hitInfoRBC, false, 0, false ) );
                 }
-            }
 
-            threadsFinished++;
-        } );
 
-        t.detach();
-    }
-
-    while( threadsFinished < parallelThreadCount )
-        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+                // Set pixel colors
+                // /////////////////////////////////////////////////////////////
+
+                GLubyte *ptr = &ptrPBO[ (4 * x + m_blockPositionsFast[iBlock].x +
+                                         m_realBufferSize.x *
+                                         (m_blockPositionsFast[iBlock].y + 4 * y)) * 4 ];
+                SetPixel( ptr +  0, cLT );
+                SetPixel( ptr +  4, BlendColor( cLT, cLRT, cLTC ) );
+                SetPixel( ptr +  8, cLRT );
+                SetPixel( ptr + 12, BlendColor( cLRT, cRT, cRTC ) );
+
+                ptr += m_realBufferSize.x * 4;
+                SetPixel( ptr +  0, BlendColor( cLT , cLTB, cLTC ) );
+                SetPixel( ptr +  4, BlendColor( cLTC, BlendColor( cLT , cC ) ) );
+                SetPixel( ptr +  8, BlendColor( cC, BlendColor( cLRT, cLTC, cRTC ) ) );
+                SetPixel( ptr + 12, BlendColor( cRTC, BlendColor( cRT , cC ) ) );
+
+                ptr += m_realBufferSize.x * 4;
+                SetPixel( ptr +  0, cLTB );
+                SetPixel( ptr +  4, BlendColor( cC, BlendColor( cLTB, cLTC, cLBC ) ) );
+                SetPixel( ptr +  8, cC );
+                SetPixel( ptr + 12, BlendColor( cC, BlendColor( cRTB, cRTC, cRBC ) ) );
+
+                ptr += m_realBufferSize.x * 4;
+                SetPixel( ptr +  0, BlendColor( cLB , cLTB, cLBC ) );
+                SetPixel( ptr +  4, BlendColor( cLBC, BlendColor( cLB , cC ) ) );
+                SetPixel( ptr +  8, BlendColor( cC, BlendColor( cLRB, cLBC, cRBC ) ) );
+                SetPixel( ptr + 12, BlendColor( cRBC, BlendColor( cRB , cC ) ) );
+            }
+        }
+    }, 1, ADVANCED_CFG::GetCfg().m_max3DThreads );
 }
 
 
@@ -2154,5 +2061,8 @@ void C3D_RENDER_RAYTRACING::initialize_block_positions()
     delete[] m_shaderBuffer;
     m_shaderBuffer = new SFVEC3F[m_realBufferSize.x * m_realBufferSize.y];
 
+    m_pixelColor.resize( m_realBufferSize.x * m_realBufferSize.y );
+    m_pixelNode.resize( m_realBufferSize.x * m_realBufferSize.y );
+
     opengl_init_pbo();
 }
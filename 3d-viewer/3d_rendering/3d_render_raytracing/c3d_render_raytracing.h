@@ -39,7 +39,9 @@
 #include "cmaterial.h"
 #include <plugins/3dapi/c3dmodel.h>
 
+#include <functional>
 #include <map>
+#include <vector>
 
 /// Vector of materials
 typedef std::vector< CBLINN_PHONG_MATERIAL > MODEL_MATERIALS;
@@ -50,6 +52,7 @@ typedef std::map< const S3DMODEL * , MODEL_MATERIALS > MAP_MODEL_MATERIALS;
 typedef enum
 {
     RT_RENDER_STATE_TRACING = 0,
+    RT_RENDER_STATE_ANTI_ALIASING,
     RT_RENDER_STATE_POST_PROCESS_SHADE,
     RT_RENDER_STATE_POST_PROCESS_BLUR_AND_FINISH,
     RT_RENDER_STATE_FINISH,
@@ -69,6 +72,15 @@ public:
 
     int GetWaitForEditingTimeOut() override;
 
+    /**
+     * @brief RenderToBuffer - render a whole frame in memory, without OpenGL, as seen by
+     * the current camera.  It is used to benchmark the raytracer.
+     * @param aSize - size of the frame, in pixels
+     * @param aBuffer - receives the RGBA pixels of the frame
+     * @return the size of the frame rendered, a bit smaller than aSize
+     */
+    SFVEC2UI RenderToBuffer( const wxSize &aSize, std::vector<GLubyte> &aBuffer );
+
 private:
     bool initializeOpenGL();
     void initializeNewWindowSize();
@@ -77,10 +89,14 @@ private:
     void reload( REPORTER *aStatusTextReporter );
 
     void restart_render_state();
+    void rt_render_blocks( const std::function<void( size_t )>& aRenderBlock );
     void rt_render_tracing( GLubyte *ptrPBO , REPORTER *aStatusTextReporter );
+    void rt_render_anti_aliasing( GLubyte *ptrPBO , REPORTER *aStatusTextReporter );
     void rt_render_post_process_shade( GLubyte *ptrPBO , REPORTER *aStatusTextReporter );
     void rt_render_post_process_blur_finish( GLubyte *ptrPBO , REPORTER *aStatusTextReporter );
     void rt_render_trace_block( GLubyte *ptrPBO , signed int iBlock );
+    void rt_render_AA_block( GLubyte *ptrPBO , signed int iBlock );
+    bool rt_pixel_needs_AA( unsigned int x, unsigned int y ) const;
     void rt_final_color( GLubyte *ptrPBO, const SFVEC3F &rgbColor, bool applyColorSpaceConversion );
 
     void rt_shades_packet( const SFVEC3F *bgColorY,
@@ -89,12 +105,6 @@ private:
                            bool is_testShadow,
                            SFVEC3F *aOutHitColor );
 
-    void rt_trace_AA_packet( const SFVEC3F *aBgColorY,
-                             const HITINFO_PACKET *aHitPck_X0Y0,
-                             const HITINFO_PACKET *aHitPck_AA_X1Y1,
-                             const RAY *aRayPck,
-                             SFVEC3F *aOutHitColor );
-
     // Materials
     void setupMaterials();
 
@@ -177,6 +187,12 @@ private:
 
     SFVEC3F *m_shaderBuffer;
 
+    /// Color of each pixel of the first pass, before the anti-aliasing one
+    std::vector< SFVEC3F > m_pixelColor;
+
+    /// Accelerator node hit by each pixel of the first pass (0 for the background)
+    std::vector< unsigned int > m_pixelNode;
+
     // Display Offset
     unsigned int m_xoffset;
     unsigned int m_yoffset;
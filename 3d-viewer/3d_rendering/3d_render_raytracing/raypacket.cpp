@@ -28,6 +28,7 @@
  */
 
 #include "raypacket.h"
+#include "hitinfo.h"
 #include "../3d_fastmath.h"
 #include <wx/debug.h>
 
@@ -193,3 +194,29 @@ void RAYPACKET_InitRays_with2DDisplacement( const CCAMERA &aCamera,
         }
     }
 }
+
+
+RAYPACKET_SOA::RAYPACKET_SOA( const RAYPACKET &aRayPacket,
+                              const HITINFO_PACKET *aHitInfoPacket )
+{
+    m_ray = aRayPacket.m_ray;
+
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+    {
+        const RAY &ray = aRayPacket.m_ray[i];
+
+        m_originX[i] = ray.m_Origin.x;
+        m_originY[i] = ray.m_Origin.y;
+        m_originZ[i] = ray.m_Origin.z;
+
+        m_dirX[i] = ray.m_Dir.x;
+        m_dirY[i] = ray.m_Dir.y;
+        m_dirZ[i] = ray.m_Dir.z;
+
+        m_invDirX[i] = ray.m_InvDir.x;
+        m_invDirY[i] = ray.m_InvDir.y;
+        m_invDirZ[i] = ray.m_InvDir.z;
+
+        m_tHit[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
+    }
+}
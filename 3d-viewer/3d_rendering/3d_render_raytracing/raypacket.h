@@ -33,6 +33,9 @@
 #include "ray.h"
 #include "cfrustum.h"
 #include "../ccamera.h"
+#include <stdint.h>
+
+struct HITINFO_PACKET;
 
 #define RAYPACKET_DIM (1 << 3)
 #define RAYPACKET_MASK    (unsigned int)( (RAYPACKET_DIM - 1))
@@ -64,6 +67,37 @@ struct RAYPACKET
                const SFVEC2F &a2DWindowsPosDisplacementFactor );
 };
 
+
+/**
+ * The rays of a RAYPACKET in a struct of arrays layout, used by the SIMD packet kernels of
+ * the boxes and triangles.  The sets of rays are masks of RAYPACKET_RAYS_PER_PACKET bits.
+ */
+struct RAYPACKET_SOA
+{
+    alignas( 16 ) float m_originX[RAYPACKET_RAYS_PER_PACKET];
+    alignas( 16 ) float m_originY[RAYPACKET_RAYS_PER_PACKET];
+    alignas( 16 ) float m_originZ[RAYPACKET_RAYS_PER_PACKET];
+
+    alignas( 16 ) float m_dirX[RAYPACKET_RAYS_PER_PACKET];
+    alignas( 16 ) float m_dirY[RAYPACKET_RAYS_PER_PACKET];
+    alignas( 16 ) float m_dirZ[RAYPACKET_RAYS_PER_PACKET];
+
+    alignas( 16 ) float m_invDirX[RAYPACKET_RAYS_PER_PACKET];
+    alignas( 16 ) float m_invDirY[RAYPACKET_RAYS_PER_PACKET];
+    alignas( 16 ) float m_invDirZ[RAYPACKET_RAYS_PER_PACKET];
+
+    /// Distance of the nearest hit of each ray, to be updated when a ray hits an object
+    alignas( 16 ) float m_tHit[RAYPACKET_RAYS_PER_PACKET];
+
+    /// The rays of the packet, used by the scalar versions of the kernels
+    const RAY *m_ray;
+
+    RAYPACKET_SOA( const RAYPACKET &aRayPacket, const HITINFO_PACKET *aHitInfoPacket );
+};
+
+static_assert( RAYPACKET_RAYS_PER_PACKET == 64, "the ray sets of a packet are 64 bit masks" );
+
+
 void RAYPACKET_InitRays( const CCAMERA &aCamera,
                          const SFVEC2F &aWindowsPosition,
                          RAY *aRayPck );
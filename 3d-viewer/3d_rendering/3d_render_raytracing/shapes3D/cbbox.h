@@ -31,8 +31,11 @@
 #define _CBBOX_H_
 
 #include "../ray.h"
+#include <stdint.h>
 #include <fctsys.h>     // For the DBG(
 
+struct RAYPACKET_SOA;
+
 /**
  * Class CBBOX
  * manages a bounding box defined by two SFVEC3F min max points.
@@ -250,6 +253,14 @@ public:
      */
     bool Intersect( const RAY &aRay, float *aOutHitt0, float *aOutHitt1 ) const;
 
+    /**
+     * Function Intersect - Tests several rays of a packet at once
+     * @param aPacket = the rays, with the distance of their nearest hit
+     * @param aRays = mask of the rays of the packet to test
+     * @return the mask of the rays of aRays which hit the box before their nearest hit
+     */
+    uint64_t Intersect( const RAYPACKET_SOA &aPacket, uint64_t aRays ) const;
+
 private:
 
     SFVEC3F m_min;  ///< (12) point of the lower position of the bounding box
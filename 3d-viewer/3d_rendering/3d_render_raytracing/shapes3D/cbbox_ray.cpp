@@ -28,9 +28,14 @@
  */
 
 #include "cbbox.h"
+#include "../raypacket.h"
 #include <fctsys.h>
 #include <wx/debug.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 // This BBOX Ray intersection test have the following credits:
 
 // "This source code accompanies the Journal of Graphics Tools paper:
@@ -966,3 +971,88 @@ bool CBBOX::Intersect( const RAY& aRay ) const
 
     return false;
 }
+
+
+#ifdef __SSE2__
+
+uint64_t CBBOX::Intersect( const RAYPACKET_SOA &aPacket, uint64_t aRays ) const
+{
+    // Slab test of four rays at a time.  A lane with a NaN, from a ray parallel to a face
+    // and starting on its plane, is reported as a hit: the callers only use the result to
+    // skip the rays which cannot hit the content of the box.
+    const __m128 zero = _mm_setzero_ps();
+
+    const __m128 minX = _mm_set1_ps( m_min.x );
+    const __m128 minY = _mm_set1_ps( m_min.y );
+    const __m128 minZ = _mm_set1_ps( m_min.z );
+    const __m128 maxX = _mm_set1_ps( m_max.x );
+    const __m128 maxY = _mm_set1_ps( m_max.y );
+    const __m128 maxZ = _mm_set1_ps( m_max.z );
+
+    uint64_t hits = 0;
+
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; i += 4 )
+    {
+        if( ( ( aRays >> i ) & 0xF ) == 0 )
+            continue;
+
+        __m128 origin = _mm_load_ps( &aPacket.m_originX[i] );
+        __m128 invDir = _mm_load_ps( &aPacket.m_invDirX[i] );
+
+        __m128 t0 = _mm_mul_ps( _mm_sub_ps( minX, origin ), invDir );
+        __m128 t1 = _mm_mul_ps( _mm_sub_ps( maxX, origin ), invDir );
+
+        __m128 tNear = _mm_min_ps( t0, t1 );
+        __m128 tFar = _mm_max_ps( t0, t1 );
+        __m128 undecided = _mm_cmpunord_ps( t0, t1 );
+
+        origin = _mm_load_ps( &aPacket.m_originY[i] );
+        invDir = _mm_load_ps( &aPacket.m_invDirY[i] );
+
+        t0 = _mm_mul_ps( _mm_sub_ps( minY, origin ), invDir );
+        t1 = _mm_mul_ps( _mm_sub_ps( maxY, origin ), invDir );
+
+        tNear = _mm_max_ps( tNear, _mm_min_ps( t0, t1 ) );
+        tFar = _mm_min_ps( tFar, _mm_max_ps( t0, t1 ) );
+        undecided = _mm_or_ps( undecided, _mm_cmpunord_ps( t0, t1 ) );
+
+        origin = _mm_load_ps( &aPacket.m_originZ[i] );
+        invDir = _mm_load_ps( &aPacket.m_invDirZ[i] );
+
+        t0 = _mm_mul_ps( _mm_sub_ps( minZ, origin ), invDir );
+        t1 = _mm_mul_ps( _mm_sub_ps( maxZ, origin ), invDir );
+
+        tNear = _mm_max_ps( tNear, _mm_min_ps( t0, t1 ) );
+        tFar = _mm_min_ps( tFar, _mm_max_ps( t0, t1 ) );
+        undecided = _mm_or_ps( undecided, _mm_cmpunord_ps( t0, t1 ) );
+
+        const __m128 hit = _mm_and_ps( _mm_cmpge_ps( tFar, _mm_max_ps( tNear, zero ) ),
+                                       _mm_cmplt_ps( tNear,
+                                                     _mm_load_ps( &aPacket.m_tHit[i] ) ) );
+
+        hits |= (uint64_t)_mm_movemask_ps( _mm_or_ps( hit, undecided ) ) << i;
+    }
+
+    return hits & aRays;
+}
+
+#else
+
+uint64_t CBBOX::Intersect( const RAYPACKET_SOA &aPacket, uint64_t aRays ) const
+{
+    uint64_t hits = 0;
+
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+    {
+        float hitT;
+
+        if( ( ( aRays >> i ) & 1 ) &&
+            Intersect( aPacket.m_ray[i], &hitT ) &&
+            ( hitT < aPacket.m_tHit[i] ) )
+            hits |= (uint64_t)1 << i;
+    }
+
+    return hits;
+}
+
+#endif
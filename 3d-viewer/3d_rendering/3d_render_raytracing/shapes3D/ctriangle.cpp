@@ -33,6 +33,10 @@
 
 #include "ctriangle.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 
 void CTRIANGLE::pre_calc_const()
 {
@@ -313,6 +317,107 @@ bool CTRIANGLE::IntersectP( const RAY &aRay,
 }
 
 
+#ifdef __SSE2__
+
+/// Margin of the packet test, so the rays on the edges of the triangle are tested by Intersect
+#define CANDIDATE_EPSILON 1.0e-4f
+
+uint64_t CTRIANGLE::IntersectCandidates( const RAYPACKET_SOA &aPacket, uint64_t aRays ) const
+{
+    // Same computation as Intersect, on four rays at a time
+    const float *origin[3] = { aPacket.m_originX, aPacket.m_originY, aPacket.m_originZ };
+    const float *dir[3]    = { aPacket.m_dirX, aPacket.m_dirY, aPacket.m_dirZ };
+
+    const unsigned int ku = s_modulo[m_k + 1];
+    const unsigned int kv = s_modulo[m_k + 2];
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one  = _mm_set1_ps( 1.0f );
+    const __m128 eps  = _mm_set1_ps( CANDIDATE_EPSILON );
+    const __m128 tMin = _mm_set1_ps( -CANDIDATE_EPSILON );
+    const __m128 tMaxFactor = _mm_set1_ps( 1.0f + CANDIDATE_EPSILON );
+
+    const __m128 nu  = _mm_set1_ps( m_nu );
+    const __m128 nv  = _mm_set1_ps( m_nv );
+    const __m128 nd  = _mm_set1_ps( m_nd );
+    const __m128 au  = _mm_set1_ps( m_vertex[0][ku] );
+    const __m128 av  = _mm_set1_ps( m_vertex[0][kv] );
+    const __m128 bnu = _mm_set1_ps( m_bnu );
+    const __m128 bnv = _mm_set1_ps( m_bnv );
+    const __m128 cnu = _mm_set1_ps( m_cnu );
+    const __m128 cnv = _mm_set1_ps( m_cnv );
+    const __m128 nx  = _mm_set1_ps( m_n.x );
+    const __m128 ny  = _mm_set1_ps( m_n.y );
+    const __m128 nz  = _mm_set1_ps( m_n.z );
+
+    uint64_t candidates = 0;
+
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; i += 4 )
+    {
+        if( ( ( aRays >> i ) & 0xF ) == 0 )
+            continue;
+
+        const __m128 ok = _mm_load_ps( &origin[m_k][i] );
+        const __m128 ou = _mm_load_ps( &origin[ku][i] );
+        const __m128 ov = _mm_load_ps( &origin[kv][i] );
+        const __m128 dk = _mm_load_ps( &dir[m_k][i] );
+        const __m128 du = _mm_load_ps( &dir[ku][i] );
+        const __m128 dv = _mm_load_ps( &dir[kv][i] );
+
+        const __m128 lnd = _mm_div_ps( one, _mm_add_ps( _mm_add_ps( dk, _mm_mul_ps( nu, du ) ),
+                                                        _mm_mul_ps( nv, dv ) ) );
+
+        const __m128 t = _mm_mul_ps( _mm_sub_ps( _mm_sub_ps( _mm_sub_ps( nd, ok ),
+                                                             _mm_mul_ps( nu, ou ) ),
+                                                 _mm_mul_ps( nv, ov ) ),
+                                     lnd );
+
+        const __m128 tHit = _mm_mul_ps( _mm_load_ps( &aPacket.m_tHit[i] ), tMaxFactor );
+
+        __m128 valid = _mm_and_ps( _mm_cmplt_ps( t, tHit ), _mm_cmpgt_ps( t, tMin ) );
+
+        const __m128 hu = _mm_sub_ps( _mm_add_ps( ou, _mm_mul_ps( t, du ) ), au );
+        const __m128 hv = _mm_sub_ps( _mm_add_ps( ov, _mm_mul_ps( t, dv ) ), av );
+
+        const __m128 beta  = _mm_add_ps( _mm_mul_ps( hv, bnu ), _mm_mul_ps( hu, bnv ) );
+        const __m128 gamma = _mm_add_ps( _mm_mul_ps( hu, cnu ), _mm_mul_ps( hv, cnv ) );
+
+        valid = _mm_and_ps( valid, _mm_cmpge_ps( _mm_add_ps( beta, eps ), zero ) );
+        valid = _mm_and_ps( valid, _mm_cmpge_ps( _mm_add_ps( gamma, eps ), zero ) );
+        valid = _mm_and_ps( valid, _mm_cmple_ps( _mm_add_ps( beta, gamma ),
+                                                 _mm_add_ps( one, eps ) ) );
+
+        // Back faces
+        const __m128 dotDN = _mm_add_ps( _mm_add_ps(
+                                            _mm_mul_ps( _mm_load_ps( &aPacket.m_dirX[i] ), nx ),
+                                            _mm_mul_ps( _mm_load_ps( &aPacket.m_dirY[i] ), ny ) ),
+                                         _mm_mul_ps( _mm_load_ps( &aPacket.m_dirZ[i] ), nz ) );
+
+        valid = _mm_and_ps( valid, _mm_cmple_ps( dotDN, eps ) );
+
+        // A NaN is left to the exact test
+        valid = _mm_or_ps( valid, _mm_cmpunord_ps( t, beta ) );
+        valid = _mm_or_ps( valid, _mm_cmpunord_ps( gamma, dotDN ) );
+
+        candidates |= (uint64_t)_mm_movemask_ps( valid ) << i;
+    }
+
+    return candidates & aRays;
+}
+
+#else
+
+uint64_t CTRIANGLE::IntersectCandidates( const RAYPACKET_SOA &aPacket, uint64_t aRays ) const
+{
+    (void)aPacket;
+
+    // Without SIMD, Intersect is the test
+    return aRays;
+}
+
+#endif
+
+
 bool CTRIANGLE::Intersects( const CBBOX &aBBox ) const
 {
     //!TODO: improove
@@ -69,6 +69,15 @@ public:
     bool Intersects( const CBBOX &aBBox ) const override;
     SFVEC3F GetDiffuseColor( const HITINFO &aHitInfo ) const override;
 
+    /**
+     * @brief IntersectCandidates - test several rays of a packet at once
+     * @param aPacket - the rays, with the distance of their nearest hit
+     * @param aRays - mask of the rays of the packet to test
+     * @return the mask of the rays of aRays which may hit the triangle: Intersect must be
+     * called for each of them, it is exact and sets the hit information
+     */
+    uint64_t IntersectCandidates( const RAYPACKET_SOA &aPacket, uint64_t aRays ) const;
+
 private:
     void pre_calc_const();
 
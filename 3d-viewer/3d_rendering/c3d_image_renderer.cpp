@@ -0,0 +1,203 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file c3d_image_renderer.cpp
+ */
+
+#include "c3d_image_renderer.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include <wx/filename.h>
+#include <wx/image.h>
+
+#include <class_board.h>
+#include <common.h>
+
+#include "../3d_cache/3d_cache.h"
+#include "../3d_canvas/cinfo3d_visu.h"
+#include "3d_render_raytracing/c3d_render_raytracing.h"
+
+
+C3D_IMAGE_RENDERER::C3D_IMAGE_RENDERER( BOARD* aBoard ) :
+    m_board( aBoard ),
+    m_size( 1024, 768 ),
+    m_view( VIEW_TOP ),
+    m_rotation{ 0.0, 0.0, 0.0 },
+    m_zoom( 1.0 ),
+    m_orthographic( false ),
+    m_antiAliasing( true ),
+    m_postProcessing( true ),
+    m_show3DModels( true )
+{
+    m_settings.reset( new CINFO3D_VISU() );
+    m_settings->SetBoard( aBoard );
+    m_settings->RenderEngineSet( RENDER_ENGINE_RAYTRACING );
+
+    m_renderer.reset( new C3D_RENDER_RAYTRACING( *m_settings ) );
+}
+
+
+C3D_IMAGE_RENDERER::~C3D_IMAGE_RENDERER()
+{
+    // The renderer uses the settings and the models of the cache
+    m_renderer.reset();
+}
+
+
+void C3D_IMAGE_RENDERER::SetSize( int aWidth, int aHeight )
+{
+    m_size.x = std::max( aWidth, 1 );
+    m_size.y = std::max( aHeight, 1 );
+}
+
+
+void C3D_IMAGE_RENDERER::SetView( VIEW aView, double aRotationX, double aRotationY,
+                                  double aRotationZ, double aZoom )
+{
+    m_view = aView;
+    m_rotation[0] = aRotationX;
+    m_rotation[1] = aRotationY;
+    m_rotation[2] = aRotationZ;
+    m_zoom = aZoom;
+}
+
+
+bool C3D_IMAGE_RENDERER::Render( const wxString& aFileName )
+{
+    if( !m_board )
+        return false;
+
+    // Changing the options which are baked in the scene rebuilds it
+    bool reload = false;
+
+    auto setFlag = [&]( DISPLAY3D_FLG aFlag, bool aState )
+    {
+        if( m_settings->GetFlag( aFlag ) != aState )
+        {
+            m_settings->SetFlag( aFlag, aState );
+            reload = true;
+        }
+    };
+
+    setFlag( FL_RENDER_RAYTRACING_ANTI_ALIASING, m_antiAliasing );
+    setFlag( FL_RENDER_RAYTRACING_POST_PROCESSING, m_postProcessing );
+    setFlag( FL_MODULE_ATTRIBUTES_NORMAL, m_show3DModels );
+    setFlag( FL_MODULE_ATTRIBUTES_NORMAL_INSERT, m_show3DModels );
+    setFlag( FL_MODULE_ATTRIBUTES_VIRTUAL, m_show3DModels );
+
+    if( m_show3DModels && !m_cache )
+    {
+        // The cache of the project uses the program settings, which scripts may not have
+        m_cache.reset( new S3D_CACHE() );
+
+        wxFileName cfgpath;
+        cfgpath.AssignDir( GetKicadConfigPath() );
+        cfgpath.AppendDir( wxT( "3d" ) );
+        m_cache->Set3DConfigDir( cfgpath.GetFullPath() );
+
+        wxFileName boardFile( m_board->GetFileName() );
+
+        if( boardFile.IsOk() && !boardFile.GetPath().IsEmpty() )
+            m_cache->SetProjectDir( boardFile.GetPath() );
+
+        m_settings->Set3DCacheManager( m_cache.get() );
+        reload = true;
+    }
+
+    if( reload )
+        m_renderer->ReloadRequest();
+
+    CCAMERA& camera = m_settings->CameraGet();
+
+    camera.SetCurWindowSize( m_size );
+    camera.SetProjection( m_orthographic ? PROJECTION_ORTHO : PROJECTION_PERSPECTIVE );
+    camera.Reset();
+
+    switch( m_view )
+    {
+    case VIEW_TOP:
+        break;
+
+    case VIEW_BOTTOM:
+        camera.RotateY( glm::radians( 180.0f ) );
+        break;
+
+    case VIEW_FRONT:
+        camera.RotateX( glm::radians( -90.0f ) );
+        break;
+
+    case VIEW_BACK:
+        camera.RotateX( glm::radians( -90.0f ) );
+        camera.RotateZ( glm::radians( -180.0f ) );
+        break;
+
+    case VIEW_LEFT:
+        camera.RotateZ( glm::radians( 90.0f ) );
+        camera.RotateX( glm::radians( -90.0f ) );
+        break;
+
+    case VIEW_RIGHT:
+        camera.RotateZ( glm::radians( -90.0f ) );
+        camera.RotateX( glm::radians( -90.0f ) );
+        break;
+    }
+
+    camera.RotateX( glm::radians( (float) m_rotation[0] ) );
+    camera.RotateY( glm::radians( (float) m_rotation[1] ) );
+    camera.RotateZ( glm::radians( (float) m_rotation[2] ) );
+
+    if( m_zoom > 0.0 )
+        camera.Zoom( (float) m_zoom );
+
+    std::vector<GLubyte> buffer;
+    const SFVEC2UI size = m_renderer->RenderToBuffer( m_size, buffer );
+
+    if( size.x == 0 || size.y == 0 )
+        return false;
+
+    // The buffer is RGBA with the rows from the bottom, as for glDrawPixels
+    wxImage image( size.x, size.y, false );
+    unsigned char* rgb = image.GetData();
+
+    for( unsigned int y = 0; y < size.y; ++y )
+    {
+        const GLubyte* src = &buffer[( size.y - 1 - y ) * size.x * 4];
+
+        for( unsigned int x = 0; x < size.x; ++x, src += 4, rgb += 3 )
+        {
+            rgb[0] = src[0];
+            rgb[1] = src[1];
+            rgb[2] = src[2];
+        }
+    }
+
+    // Scripts do not run the application, which adds the image handlers
+    static std::once_flag handlersAdded;
+    std::call_once( handlersAdded, [](){ wxInitAllImageHandlers(); } );
+
+    return image.SaveFile( aFileName );
+}
@@ -0,0 +1,113 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file c3d_image_renderer.h
+ * renders images of a board with the raytracer, without a window
+ */
+
+#ifndef C3D_IMAGE_RENDERER_H
+#define C3D_IMAGE_RENDERER_H
+
+#include <memory>
+
+#include <wx/gdicmn.h>
+#include <wx/string.h>
+
+class BOARD;
+class CINFO3D_VISU;
+class C3D_RENDER_RAYTRACING;
+class S3D_CACHE;
+
+/**
+ * Class C3D_IMAGE_RENDERER
+ *
+ * Renders a board with the raytracer of the 3D viewer to an image file, without the 3D
+ * canvas nor an OpenGL context, for instance to make the images of the documentation of
+ * a board from a script.  The tracing runs on the thread pool, and several renderers of
+ * different boards may be used by several threads at once.
+ *
+ * The 3D models are resolved from the directory of the board file, and from the paths
+ * and environment variables of the 3D configuration of KiCad.
+ */
+class C3D_IMAGE_RENDERER
+{
+public:
+    /// The views of the 3D viewer, from the same hotkeys
+    enum VIEW
+    {
+        VIEW_TOP,       ///< Z
+        VIEW_BOTTOM,    ///< Shift+Z
+        VIEW_FRONT,     ///< Y
+        VIEW_BACK,      ///< Shift+Y
+        VIEW_LEFT,      ///< Shift+X
+        VIEW_RIGHT      ///< X
+    };
+
+    C3D_IMAGE_RENDERER( BOARD* aBoard );
+    ~C3D_IMAGE_RENDERER();
+
+    /**
+     * Sets the size of the image in pixels.  The raytracer renders blocks of 8 x 8 pixels,
+     * so the image may be a few pixels smaller.
+     */
+    void SetSize( int aWidth, int aHeight );
+
+    /**
+     * Sets the camera to one of the views of the 3D viewer.
+     * @param aRotationX, aRotationY, aRotationZ are rotations of the board from the view,
+     * in degrees
+     * @param aZoom is the zoom factor from the view, greater than 1 to zoom in
+     */
+    void SetView( VIEW aView, double aRotationX = 0.0, double aRotationY = 0.0,
+                  double aRotationZ = 0.0, double aZoom = 1.0 );
+
+    void SetOrthographic( bool aOrthographic ) { m_orthographic = aOrthographic; }
+    void SetAntiAliasing( bool aAntiAliasing ) { m_antiAliasing = aAntiAliasing; }
+    void SetPostProcessing( bool aPostProcessing ) { m_postProcessing = aPostProcessing; }
+    void SetShow3DModels( bool aShow ) { m_show3DModels = aShow; }
+
+    /**
+     * Renders the board and saves the image, in the format of the extension of the file
+     * name (png, jpg, bmp, ...).
+     * @return true if the image was written
+     */
+    bool Render( const wxString& aFileName );
+
+private:
+    BOARD*   m_board;
+    wxSize   m_size;
+    VIEW     m_view;
+    double   m_rotation[3];
+    double   m_zoom;
+    bool     m_orthographic;
+    bool     m_antiAliasing;
+    bool     m_postProcessing;
+    bool     m_show3DModels;
+
+    std::unique_ptr<CINFO3D_VISU>          m_settings;
+    std::unique_ptr<C3D_RENDER_RAYTRACING> m_renderer;
+    std::unique_ptr<S3D_CACHE>             m_cache;   ///< created for the first render with models
+};
+
+#endif  // C3D_IMAGE_RENDERER_H
@@ -74,11 +74,21 @@ public:
      */
     void ReloadRequest() { m_reloadRequested = true; }
 
+    /**
+     * @brief ReloadLayersRequest - Ask to rebuild only some layers of the board.
+     * A render that cannot rebuild single layers will reload everything.
+     * @param aLayers: the layers changed on the board
+     */
+    virtual void ReloadLayersRequest( const LSET &aLayers ) { m_reloadRequested = true; }
+
     /**
      * @brief IsReloadRequestPending - Query if there is a pending reload request
      * @return true if it wants to reload, false if there is no reload pending
      */
-    bool IsReloadRequestPending() const { return m_reloadRequested; }
+    bool IsReloadRequestPending() const
+    {
+        return m_reloadRequested || m_reloadLayers.any();
+    }
 
     /**
      * @brief GetWaitForEditingTimeOut - Give the interface the time (in ms)
@@ -114,6 +124,9 @@ protected:
     /// !TODO: this must be reviewed in order to flag change types
     bool m_reloadRequested;
 
+    /// the layers to rebuild at the next redraw, when no full reload is requested
+    LSET m_reloadLayers;
+
     /// The window size that this camera is working.
     wxSize m_windowSize;
 
@@ -31,9 +31,8 @@
 #include "buffers_debug.h"
 #include <string.h> // For memcpy
 
-#include <atomic>
-#include <thread>
-#include <chrono>
+#include <advanced_config.h>
+#include <thread_pool.h>
 
 #ifndef CLAMP
 #define CLAMP(n, min, max) {if( n < min ) n=min; else if( n > max ) n = max;}
@@ -473,51 +472,31 @@ void CIMAGE::EfxFilter( CIMAGE *aInImg, E_FILTER aFilterType )
     aInImg->m_wraping = WRAP_CLAMP;
     m_wraping = WRAP_CLAMP;
 
-    std::atomic<size_t> nextRow( 0 );
-    std::atomic<size_t> threadsFinished( 0 );
-
-    size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
-
-    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    THREAD_POOL::GetPool().ParallelFor( m_height, [&]( size_t iy )
     {
-        std::thread t = std::thread( [&]()
+        for( size_t ix = 0; ix < m_width; ix++ )
         {
-            for( size_t iy = nextRow.fetch_add( 1 );
-                        iy < m_height;
-                        iy = nextRow.fetch_add( 1 ) )
+            int v = 0;
+
+            for( size_t sy = 0; sy < 5; sy++ )
             {
-                for( size_t ix = 0; ix < m_width; ix++ )
+                for( size_t sx = 0; sx < 5; sx++ )
                 {
-                    int v = 0;
-
-                    for( size_t sy = 0; sy < 5; sy++ )
-                    {
-                        for( size_t sx = 0; sx < 5; sx++ )
-                        {
-                            int factor = filter.kernel[sx][sy];
-                            unsigned char pixelv = aInImg->Getpixel( ix + sx - 2,
-                                                                     iy + sy - 2 );
-
-                            v += pixelv * factor;
-                        }
-                    }
-
-                    v /= filter.div;
-                    v += filter.offset;
-                    CLAMP(v, 0, 255);
-                    //TODO: This needs to write to a separate buffer
-                    m_pixels[ix + iy * m_width] = v;
+                    int factor = filter.kernel[sx][sy];
+                    unsigned char pixelv = aInImg->Getpixel( ix + sx - 2,
+                                                             iy + sy - 2 );
+
+                    v += pixelv * factor;
                 }
             }
 
-            threadsFinished++;
-        } );
-
-        t.detach();
-    }
-
-    while( threadsFinished < parallelThreadCount )
-        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+            v /= filter.div;
+            v += filter.offset;
+            CLAMP(v, 0, 255);
+            //TODO: This needs to write to a separate buffer
+            m_pixels[ix + iy * m_width] = v;
+        }
+    }, 1, ADVANCED_CFG::GetCfg().m_max3DThreads );
 }
 
 
@@ -61,6 +61,12 @@ public:
                        float aDepth,
                        float aShadowAttFactor );
 
+    /**
+     * @brief SetPixelColor - replace the color of a pixel set by SetPixelData,
+     * when it was refined by a later pass
+     */
+    void SetPixelColor( unsigned int x, unsigned int y, const SFVEC3F &aColor );
+
     const SFVEC3F &GetColorAtNotProtected( const SFVEC2I &aPos ) const;
 
     void DebugBuffersOutputAsImages() const;
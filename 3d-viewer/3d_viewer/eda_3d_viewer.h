@@ -78,6 +78,15 @@ class EDA_3D_VIEWER : public KIWAY_PLAYER
      */
     void ReloadRequest();
 
+    /**
+     * Request rebuilding only some layers of the 3D view, when the board outline
+     * did not change.  As for ReloadRequest, the layers are rebuilt only when the
+     * 3D canvas is refreshed.  A render that cannot rebuild single layers reloads
+     * the whole scene.
+     * @param aLayers = the layers of the changed board items
+     */
+    void ReloadLayersRequest( const LSET& aLayers );
+
     // !TODO: review this function: it need a way to tell what changed,
     // to only reload/rebuild things that have really changed
     /**
@@ -57,6 +57,12 @@
 #                  path as the token list file path, with a file name of *_lexer.h
 #
 # Use the max_lexer() CMake function from functions.cmake for invocation convenience.
+#
+# Besides the sorted keyword table, a perfect hash of the keywords is generated, so that
+# DSNLEXER finds a keyword with one hash computation and one string comparison (see struct
+# KEYWORD_HASH in dsnlexer.h).  It is a two level hash: the hash of a keyword selects a
+# bucket, and the displacement of the bucket moves its keywords to free slots of the table.
+# The hash function must stay the same as KEYWORD_HASH::Hash().
 
 
 #message( STATUS "TokenList2DsnLexer.cmake" )    # indicate we are running
@@ -199,6 +205,133 @@ if( NOT ( tokensBefore EQUAL tokensAfter ) )
     message( FATAL_ERROR "Duplicate tokens found in file <${inputFile}>." )
 endif()
 
+# Build the perfect hash of the tokens.
+#
+# The character codes: tokens only hold lower case letters, digits and underscores.
+set( letters "abcdefghijklmnopqrstuvwxyz" )
+set( digits "0123456789" )
+set( ord__ 95 )
+
+foreach( index RANGE 25 )
+    string( SUBSTRING "${letters}" ${index} 1 char )
+    math( EXPR ord_${char} "97 + ${index}" )
+endforeach()
+
+foreach( index RANGE 9 )
+    string( SUBSTRING "${digits}" ${index} 1 char )
+    math( EXPR ord_${char} "48 + ${index}" )
+endforeach()
+
+# h = ( h * 33 + c ) mod 16777213 over the characters, as KEYWORD_HASH::Hash().  The
+# values stay below 2^31, for the 32 bits math() of old CMakes.
+set( tokenIndex 0 )
+
+foreach( token ${tokens} )
+    set( hash 5381 )
+    string( LENGTH "${token}" tokenLength )
+    math( EXPR lastChar "${tokenLength} - 1" )
+
+    foreach( charIndex RANGE ${lastChar} )
+        string( SUBSTRING "${token}" ${charIndex} 1 char )
+        math( EXPR hash "( ${hash} * 33 + ${ord_${char}} ) % 16777213" )
+    endforeach()
+
+    set( hash_${tokenIndex} ${hash} )
+    math( EXPR tokenIndex "${tokenIndex} + 1" )
+endforeach()
+
+# About 4 tokens per bucket, and 25% of free slots, more if no displacement is found.
+math( EXPR bucketCount "${tokensAfter} / 4" )
+
+if( bucketCount LESS 1 )
+    set( bucketCount 1 )
+endif()
+
+math( EXPR slotCount "${tokensAfter} + ${tokensAfter} / 4 + 1" )
+math( EXPR lastToken "${tokensAfter} - 1" )
+math( EXPR lastBucket "${bucketCount} - 1" )
+
+set( hashDone FALSE )
+
+while( NOT hashDone )
+    math( EXPR lastSlot "${slotCount} - 1" )
+
+    foreach( slot RANGE ${lastSlot} )
+        set( slot_${slot} -1 )
+    endforeach()
+
+    foreach( bucket RANGE ${lastBucket} )
+        set( bucket_${bucket} "" )
+        set( displacement_${bucket} 0 )
+    endforeach()
+
+    set( maxBucketSize 0 )
+
+    foreach( tokenIndex RANGE ${lastToken} )
+        math( EXPR bucket "${hash_${tokenIndex}} % ${bucketCount}" )
+        list( APPEND bucket_${bucket} ${tokenIndex} )
+        list( LENGTH bucket_${bucket} bucketSize )
+
+        if( bucketSize GREATER maxBucketSize )
+            set( maxBucketSize ${bucketSize} )
+        endif()
+    endforeach()
+
+    set( hashDone TRUE )
+
+    # Place the biggest buckets first, while there are many free slots
+    foreach( sizeRank RANGE 1 ${maxBucketSize} )
+        math( EXPR size "${maxBucketSize} + 1 - ${sizeRank}" )
+
+        foreach( bucket RANGE ${lastBucket} )
+            list( LENGTH bucket_${bucket} bucketSize )
+
+            if( hashDone AND bucketSize EQUAL size )
+                set( placed FALSE )
+
+                foreach( displacement RANGE ${lastSlot} )
+                    set( bucketSlots "" )
+                    set( placed TRUE )
+
+                    foreach( tokenIndex ${bucket_${bucket}} )
+                        math( EXPR slot
+                              "( ${hash_${tokenIndex}} / ${bucketCount} + ${displacement} ) % ${slotCount}" )
+                        list( FIND bucketSlots ${slot} sameSlot )
+
+                        if( NOT slot_${slot} EQUAL -1 OR NOT sameSlot EQUAL -1 )
+                            set( placed FALSE )
+                            break()
+                        endif()
+
+                        list( APPEND bucketSlots ${slot} )
+                    endforeach()
+
+                    if( placed )
+                        set( displacement_${bucket} ${displacement} )
+
+                        foreach( slot ${bucketSlots} )
+                            list( FIND bucketSlots ${slot} slotRank )
+                            list( GET bucket_${bucket} ${slotRank} tokenIndex )
+                            set( slot_${slot} ${tokenIndex} )
+                        endforeach()
+
+                        break()
+                    endif()
+                endforeach()
+
+                if( NOT placed )
+                    set( hashDone FALSE )
+                endif()
+            endif()
+        endforeach()
+    endforeach()
+
+    # Two tokens of a bucket can also fall in the same slot for all the displacements
+    if( NOT hashDone )
+        math( EXPR slotCount "${slotCount} + 1" )
+    endif()
+endwhile()
+
 file( WRITE "${outHeaderFile}" "${includeFileHeader}" )
 file( WRITE "${outCppFile}" "${sourceFileHeader}" )
 
@@ -240,6 +373,9 @@ class ${LEXERCLASS} : public DSNLEXER
     static const KEYWORD  keywords[];
     static const unsigned keyword_count;
 
+    /// Auto generated perfect hash of the keywords table:
+    static const KEYWORD_HASH keywords_hash;
+
 public:
     /**
      * Constructor ( const std::string&, const wxString& )
@@ -248,7 +384,7 @@ public:
      *   If left empty, then _(\"clipboard\") is used.
      */
     ${LEXERCLASS}( const std::string& aSExpression, const wxString& aSource = wxEmptyString ) :
-        DSNLEXER( keywords, keyword_count, aSExpression, aSource )
+        DSNLEXER( keywords, keyword_count, aSExpression, aSource, &keywords_hash )
     {
     }
 
@@ -262,7 +398,7 @@ public:
      * @param aFilename is the name of the opened file, needed for error reporting.
      */
     ${LEXERCLASS}( FILE* aFile, const wxString& aFilename ) :
-        DSNLEXER( keywords, keyword_count, aFile, aFilename )
+        DSNLEXER( keywords, keyword_count, aFile, aFilename, &keywords_hash )
     {
     }
 
@@ -278,7 +414,7 @@ public:
      *  STRING_LINE_READER or FILE_LINE_READER.  No ownership is taken of aLineReader.
      */
     ${LEXERCLASS}( LINE_READER* aLineReader ) :
-        DSNLEXER( keywords, keyword_count, aLineReader )
+        DSNLEXER( keywords, keyword_count, aLineReader, &keywords_hash )
     {
     }
 
@@ -369,6 +505,46 @@ file( APPEND "${outCppFile}"
 
 const unsigned ${LEXERCLASS}::keyword_count = unsigned( sizeof( ${LEXERCLASS}::keywords )/sizeof( ${LEXERCLASS}::keywords[0] ) );
 
+"
+)
+
+# The perfect hash tables, 16 values per line
+set( hashTables "static const unsigned short keywords_hash_displacements[] = {" )
+
+foreach( bucket RANGE ${lastBucket} )
+    math( EXPR column "${bucket} % 16" )
+
+    if( column EQUAL 0 )
+        set( hashTables "${hashTables}\n   " )
+    endif()
+
+    set( hashTables "${hashTables} ${displacement_${bucket}}," )
+endforeach()
+
+set( hashTables "${hashTables}\n};\n\nstatic const short keywords_hash_slots[] = {" )
+
+foreach( slot RANGE ${lastSlot} )
+    math( EXPR column "${slot} % 16" )
+
+    if( column EQUAL 0 )
+        set( hashTables "${hashTables}\n   " )
+    endif()
+
+    set( hashTables "${hashTables} ${slot_${slot}}," )
+endforeach()
+
+set( hashTables "${hashTables}\n};\n" )
+
+file( APPEND "${outCppFile}"
+"
+${hashTables}
+const KEYWORD_HASH ${LEXERCLASS}::keywords_hash = {
+    ${bucketCount},
+    ${slotCount},
+    keywords_hash_displacements,
+    keywords_hash_slots
+};
+
 
 const char* ${LEXERCLASS}::TokenName( T aTok )
 {
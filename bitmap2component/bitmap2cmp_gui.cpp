@@ -39,6 +39,8 @@
 #include <wx/clipbrd.h>
 #include <wx/rawbmp.h>
 
+#include <algorithm>
+
 #include "bitmap2cmp_gui_base.h"
 
 
@@ -56,6 +58,8 @@
 
 #define DEFAULT_DPI 300     // the image DPI used in formats that do not define a DPI
 
+#define PREVIEW_TRACE_SIZE 256  // the largest side, in pixels, of the image traced for preview
+
 IMAGE_SIZE::IMAGE_SIZE()
 {
     m_outputSize = 0.0;
@@ -341,6 +345,15 @@ void BM2CMP_FRAME::OnPaintBW( wxPaintEvent& event )
     if( m_BN_Bitmap.IsOk() )
         nb_dc.DrawBitmap( m_BN_Bitmap, 0, 0, !!m_BN_Bitmap.GetMask() );
 
+    // Show the outlines of the quick trace over the image
+    nb_dc.SetPen( wxPen( *wxRED, 1 ) );
+
+    for( const std::vector<wxPoint>& outline : m_previewOutlines )
+    {
+        if( outline.size() > 1 )
+            nb_dc.DrawLines( outline.size(), outline.data() );
+    }
+
     event.Skip();
 }
 
@@ -640,6 +653,110 @@ void BM2CMP_FRAME::Binarize( double aThreshold )
 
     m_BN_Bitmap = wxBitmap( m_NB_Image );
 
+    updateTracePreview();
+}
+
+
+void BM2CMP_FRAME::updateTracePreview()
+{
+    m_previewOutlines.clear();
+
+    int h = m_NB_Image.GetHeight();
+    int w = m_NB_Image.GetWidth();
+
+    if( !m_NB_Image.IsOk() || w <= 0 || h <= 0 )
+        return;
+
+    // Each pixel of the traced bitmap is black if most of the step x step image pixels it
+    // covers are black
+    int step = std::max( 1, ( std::max( w, h ) + PREVIEW_TRACE_SIZE - 1 ) / PREVIEW_TRACE_SIZE );
+    int traceW = ( w + step - 1 ) / step;
+    int traceH = ( h + step - 1 ) / step;
+    potrace_bitmap_t* potrace_bitmap = bm_new( traceW, traceH );
+
+    if( !potrace_bitmap )
+        return;
+
+    const unsigned char* rgb = m_NB_Image.GetData();
+
+    for( int ty = 0; ty < traceH; ty++ )
+    {
+        for( int tx = 0; tx < traceW; tx++ )
+        {
+            int black = 0;
+            int count = 0;
+
+            for( int y = ty * step; y < std::min( h, ( ty + 1 ) * step ); y++ )
+            {
+                for( int x = tx * step; x < std::min( w, ( tx + 1 ) * step ); x++ )
+                {
+                    count++;
+
+                    if( !rgb[( y * w + x ) * 3 + 1] )
+                        black++;
+                }
+            }
+
+            BM_PUT( potrace_bitmap, tx, ty, black * 2 > count ? 1 : 0 );
+        }
+    }
+
+    // Same parameters as BITMAPCONV_INFO::ConvertBitmap()
+    potrace_param_t* param = potrace_param_default();
+
+    if( param )
+    {
+        param->turdsize = 0;
+        param->opttolerance = 0.2;
+
+        potrace_state_t* st = potrace_trace( param, potrace_bitmap );
+
+        if( st && st->status == POTRACE_STATUS_OK )
+        {
+            for( potrace_path_t* path = st->plist; path; path = path->next )
+            {
+                potrace_curve_t* curve = &path->curve;
+
+                if( curve->n < 1 )
+                    continue;
+
+                std::vector<potrace_dpoint_t> corners;
+                potrace_dpoint_t start = curve->c[curve->n - 1][2];
+                corners.push_back( start );
+
+                for( int i = 0; i < curve->n; i++ )
+                {
+                    if( curve->tag[i] == POTRACE_CORNER )
+                    {
+                        corners.push_back( curve->c[i][1] );
+                        corners.push_back( curve->c[i][2] );
+                    }
+                    else
+                    {
+                        BezierToPolyline( corners, start, curve->c[i][0], curve->c[i][1],
+                                          curve->c[i][2] );
+                    }
+
+                    start = curve->c[i][2];
+                }
+
+                std::vector<wxPoint> outline;
+                outline.reserve( corners.size() );
+
+                for( const potrace_dpoint_t& corner : corners )
+                    outline.emplace_back( KiROUND( corner.x * step ), KiROUND( corner.y * step ) );
+
+                m_previewOutlines.push_back( std::move( outline ) );
+            }
+        }
+
+        if( st )
+            potrace_state_free( st );
+
+        potrace_param_free( param );
+    }
+
+    bm_free( potrace_bitmap );
 }
 
 
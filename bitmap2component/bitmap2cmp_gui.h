@@ -130,6 +130,12 @@ private:
     void OnExportLogo();
 
     void Binarize( double aThreshold ); // aThreshold = 0.0 (black level) to 1.0 (white level)
+
+    /**
+     * Trace a reduced copy of the black and white image, to show the outlines the export
+     * will give at once, whatever the size of the image.
+     */
+    void updateTracePreview();
     void OnNegativeClicked( wxCommandEvent& event ) override;
     void OnThresholdChange( wxScrollEvent& event ) override;
 
@@ -162,6 +168,7 @@ private:
     wxBitmap m_Greyscale_Bitmap;
     wxImage  m_NB_Image;
     wxBitmap m_BN_Bitmap;
+    std::vector<std::vector<wxPoint>> m_previewOutlines; // outlines traced by updateTracePreview()
     IMAGE_SIZE                    m_outputSizeX;
     IMAGE_SIZE                    m_outputSizeY;
     bool                          m_Negative;
@@ -53,13 +53,6 @@ static void bm_free( potrace_bitmap_t* bm )
 }
 
 
-static void BezierToPolyline( std::vector <potrace_dpoint_t>& aCornersBuffer,
-                              potrace_dpoint_t                p1,
-                              potrace_dpoint_t                p2,
-                              potrace_dpoint_t                p3,
-                              potrace_dpoint_t                p4 );
-
-
 BITMAPCONV_INFO::BITMAPCONV_INFO( std::string& aData ):
     m_Data( aData )
 {
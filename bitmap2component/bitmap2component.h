@@ -110,4 +110,15 @@ private:
 
 };
 
+
+/**
+ * Append the points of the Bezier curve from p1 to p4 (p1 excluded) to aCornersBuffer,
+ * approximated by segments within a quarter of pixel of the curve.
+ */
+void BezierToPolyline( std::vector <potrace_dpoint_t>& aCornersBuffer,
+                       potrace_dpoint_t                p1,
+                       potrace_dpoint_t                p2,
+                       potrace_dpoint_t                p3,
+                       potrace_dpoint_t                p4 );
+
 #endif  // BITMAP2COMPONENT_H
@@ -77,6 +77,178 @@ static const wxChar AllowLegacyCanvasInGtk3[] = wxT( "AllowLegacyCanvasInGtk3" )
  */
 static const wxChar ForceThickZones[] = wxT( "ForceThickZones" );
 
+/**
+ * Test track clearances on all available cores.  Turning this off falls back to the
+ * single thread test, which can help to track down a DRC problem.
+ */
+static const wxChar ParallelTrackDrc[] = wxT( "ParallelTrackDRC" );
+
+/**
+ * Re-test the neighbourhood of the changed items after each commit, and refresh the
+ * DRC markers found there.
+ */
+static const wxChar RealtimeDrc[] = wxT( "RealtimeDRC" );
+
+/**
+ * Refill the zones whose fill depends on the changed items after each commit.
+ */
+static const wxChar AutoRefillZones[] = wxT( "AutoRefillZones" );
+
+/**
+ * Build the automatic zone refills in a worker thread, without blocking the editor.
+ */
+static const wxChar BackgroundZoneFill[] = wxT( "BackgroundZoneFill" );
+
+/**
+ * Limit the worker threads of the shared thread pool, for instance to keep some cores
+ * free for other programs.  0 uses one thread per core.
+ */
+static const wxChar MaxWorkerThreads[] = wxT( "MaxWorkerThreads" );
+
+/**
+ * Limit the threads taken from the shared thread pool by the zone fills, the connectivity
+ * updates, the DRC, the 3D viewer and the footprint library loading.  0 for no limit but
+ * the pool size.
+ */
+static const wxChar MaxZoneFillThreads[] = wxT( "MaxZoneFillThreads" );
+static const wxChar MaxConnectivityThreads[] = wxT( "MaxConnectivityThreads" );
+static const wxChar MaxDrcThreads[] = wxT( "MaxDrcThreads" );
+static const wxChar Max3DThreads[] = wxT( "Max3DThreads" );
+static const wxChar MaxLibraryLoadThreads[] = wxT( "MaxLibraryLoadThreads" );
+
+/**
+ * Pin each worker thread of the shared thread pool to one of the cores the program may run
+ * on (e.g. set with taskset), so that several batch runs sharing a server keep to their cores.
+ */
+static const wxChar PinWorkerThreads[] = wxT( "PinWorkerThreads" );
+
+/**
+ * Compute the ratsnest of a net only when it is drawn or read, instead of after each
+ * change.  The hidden and off-screen nets are then not computed at all.
+ */
+static const wxChar LazyRatsnest[] = wxT( "LazyRatsnest" );
+
+/**
+ * Show the time spent in each step of the last connectivity update, and the number of
+ * items it went through, in the message panel of the board.
+ */
+static const wxChar ShowConnectivityStats[] = wxT( "ShowConnectivityStats" );
+
+/**
+ * Split the polygon boolean operations with at least this number of points into spatial
+ * bands combined on several threads, such as the unions of whole layers when plotting.
+ * 0 runs all of them in a single thread.
+ */
+static const wxChar ParallelBooleanMinPoints[] = wxT( "ParallelBooleanMinPoints" );
+
+/**
+ * Parse the footprints, tracks and zones of the boards with at least this number of them
+ * on several threads.  0 parses all the boards in a single thread.
+ */
+static const wxChar ParallelBoardLoadMinItems[] = wxT( "ParallelBoardLoadMinItems" );
+
+/**
+ * Only list the footprint files when reading a footprint library, and parse each of them
+ * the first time its footprint is used.  The footprints which fail to parse are then only
+ * reported as missing when they are used.
+ */
+static const wxChar LazyFootprintLoad[] = wxT( "LazyFootprintLoad" );
+
+/**
+ * Write the auto save files of the boards as binary snapshots, which are much faster to
+ * write than s-expressions for the tracks and the zone fills.  A recovered snapshot is
+ * saved again as s-expression.
+ */
+static const wxChar SnapshotAutoSave[] = wxT( "SnapshotAutoSave" );
+
+/**
+ * Save the boards on a background thread, from a copy of the board, so that the editor
+ * stays responsive while the file is formatted and written.
+ */
+static const wxChar BackgroundSave[] = wxT( "BackgroundSave" );
+
+/**
+ * Keep the graphical connections of the schematic sheets which did not change when updating
+ * the connectivity, instead of finding them again on every sheet.
+ */
+static const wxChar IncrementalConnectivity[] = wxT( "IncrementalConnectivity" );
+
+/**
+ * Draw the frame time, the redraw statistics and the GPU usage of the last frame over the
+ * GAL canvases.
+ */
+static const wxChar ShowRenderStats[] = wxT( "ShowRenderStats" );
+
+/**
+ * Draw the cached items of the Cairo canvas in horizontal bands, on several threads.
+ */
+static const wxChar ParallelCairoDrawing[] = wxT( "ParallelCairoDrawing" );
+
+/**
+ * Keep the push and shove router world alive when a routing tool exits, and only resync the
+ * board items changed by the commits when the next routing tool starts.
+ */
+static const wxChar IncrementalRouterSync[] = wxT( "IncrementalRouterSync" );
+
+/**
+ * Let the walkaround of the router try the clockwise and the counter-clockwise paths around
+ * the obstacles on two threads.
+ */
+static const wxChar ParallelWalkaround[] = wxT( "ParallelWalkaround" );
+
+/**
+ * Rebuild only the layers of the board items changed by the commits in the 3D viewer,
+ * instead of reloading the whole scene.
+ */
+static const wxChar Incremental3DViewUpdate[] = wxT( "Incremental3DViewUpdate" );
+
+/**
+ * Draw the 3D models with decimated meshes when they are small on the screen, in the
+ * OpenGL 3D viewer.
+ */
+static const wxChar Model3DLevelOfDetail[] = wxT( "Model3DLevelOfDetail" );
+
+/**
+ * Merge only the clusters of close pads, vias and zones when plotting the solder mask with
+ * a min width, and flash the isolated pads and vias.
+ */
+static const wxChar FastSolderMaskPlot[] = wxT( "FastSolderMaskPlot" );
+
+/**
+ * The zlib compression level of the PDF page streams, from 0 (none) to 9 (best, slowest).
+ */
+static const wxChar PdfCompressionLevel[] = wxT( "PdfCompressionLevel" );
+
+/**
+ * Write smaller Gerber files: flash the rotated and round rect pads with aperture macros,
+ * remove the redundant polygon corners and omit the unchanged coordinates.
+ */
+static const wxChar OptimizedGerberOutput[] = wxT( "OptimizedGerberOutput" );
+
+/**
+ * Write the footprint graphics of the SVG plots once as a symbol, and the identical
+ * footprints as uses of this symbol.
+ */
+static const wxChar SvgPlotSymbols[] = wxT( "SvgPlotSymbols" );
+
+/**
+ * Coalesce the mouse motion events: the motion events waiting behind a slow tool are replaced
+ * by the last one instead of being dispatched one by one.
+ */
+static const wxChar CoalesceMouseMotion[] = wxT( "CoalesceMouseMotion" );
+
+/**
+ * Allocate the items of a board file being loaded in large chunks belonging to the board,
+ * instead of one by one.
+ */
+static const wxChar BoardItemArena[] = wxT( "BoardItemArena" );
+
+/**
+ * Let the autoplacer try the positions of a footprint every so many grid cells first, and
+ * then every grid cell only around the best of them.  1 tries all the grid positions.
+ */
+static const wxChar AutoplaceCoarseStep[] = wxT( "AutoplaceCoarseStep" );
+
 } // namespace KEYS
 
 
@@ -158,6 +330,38 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_allowLegacyCanvasInGtk3 = false;
     m_realTimeConnectivity = true;
     m_forceThickOutlinesInZones = true;
+    m_parallelTrackDrc = true;
+    m_realTimeDrc = false;
+    m_autoRefillZones = false;
+    m_backgroundZoneFill = false;
+    m_maxWorkerThreads = 0;
+    m_maxZoneFillThreads = 0;
+    m_maxConnectivityThreads = 0;
+    m_maxDrcThreads = 0;
+    m_max3DThreads = 0;
+    m_maxLibraryLoadThreads = 0;
+    m_pinWorkerThreads = false;
+    m_lazyRatsnest = false;
+    m_showConnectivityStats = false;
+    m_parallelBooleanMinPoints = 50000;
+    m_parallelBoardLoadMinItems = 1000;
+    m_lazyFootprintLoad = false;
+    m_snapshotAutoSave = false;
+    m_backgroundSave = false;
+    m_incrementalConnectivity = true;
+    m_showRenderStats = false;
+    m_parallelCairoDrawing = false;
+    m_incrementalRouterSync = true;
+    m_parallelWalkaround = true;
+    m_incremental3DViewUpdate = true;
+    m_model3DLevelOfDetail = true;
+    m_fastSolderMaskPlot = true;
+    m_pdfCompressionLevel = 6;
+    m_optimizedGerberOutput = false;
+    m_svgPlotSymbols = false;
+    m_coalesceMouseMotion = false;
+    m_boardItemArena = false;
+    m_autoplaceCoarseStep = 4;
 
     loadFromConfigFile();
 }
@@ -203,6 +407,102 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ForceThickZones,
                                                 &m_forceThickOutlinesInZones, true ) );
 
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelTrackDrc,
+                                                &m_parallelTrackDrc, true ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::RealtimeDrc,
+                                                &m_realTimeDrc, false ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::AutoRefillZones,
+                                                &m_autoRefillZones, false ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::BackgroundZoneFill,
+                                                &m_backgroundZoneFill, false ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::MaxWorkerThreads,
+                                               &m_maxWorkerThreads, 0, 0, 1024 ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::MaxZoneFillThreads,
+                                               &m_maxZoneFillThreads, 0, 0, 1024 ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::MaxConnectivityThreads,
+                                               &m_maxConnectivityThreads, 0, 0, 1024 ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::MaxDrcThreads,
+                                               &m_maxDrcThreads, 0, 0, 1024 ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::Max3DThreads,
+                                               &m_max3DThreads, 0, 0, 1024 ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::MaxLibraryLoadThreads,
+                                               &m_maxLibraryLoadThreads, 0, 0, 1024 ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::PinWorkerThreads,
+                                                &m_pinWorkerThreads, false ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::LazyRatsnest,
+                                                &m_lazyRatsnest, false ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ShowConnectivityStats,
+                                                &m_showConnectivityStats, false ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::ParallelBooleanMinPoints,
+                                               &m_parallelBooleanMinPoints, 50000, 0 ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::ParallelBoardLoadMinItems,
+                                               &m_parallelBoardLoadMinItems, 1000, 0 ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::LazyFootprintLoad,
+                                                &m_lazyFootprintLoad, false ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::SnapshotAutoSave,
+                                                &m_snapshotAutoSave, false ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::BackgroundSave,
+                                                &m_backgroundSave, false ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::IncrementalConnectivity,
+                                                &m_incrementalConnectivity, true ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ShowRenderStats,
+                                                &m_showRenderStats, false ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelCairoDrawing,
+                                                &m_parallelCairoDrawing, false ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::IncrementalRouterSync,
+                                                &m_incrementalRouterSync, true ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelWalkaround,
+                                                &m_parallelWalkaround, true ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::Incremental3DViewUpdate,
+                                                &m_incremental3DViewUpdate, true ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::Model3DLevelOfDetail,
+                                                &m_model3DLevelOfDetail, true ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::FastSolderMaskPlot,
+                                                &m_fastSolderMaskPlot, true ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::PdfCompressionLevel,
+                                               &m_pdfCompressionLevel, 6, 0, 9 ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::OptimizedGerberOutput,
+                                                &m_optimizedGerberOutput, false ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::SvgPlotSymbols,
+                                                &m_svgPlotSymbols, false ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::CoalesceMouseMotion,
+                                                &m_coalesceMouseMotion, false ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::BoardItemArena,
+                                                &m_boardItemArena, false ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::AutoplaceCoarseStep,
+                                               &m_autoplaceCoarseStep, 4, 1, 64 ) );
+
     wxConfigLoadSetups( &aCfg, configParams );
 
     dumpCfg( configParams );
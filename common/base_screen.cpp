@@ -46,6 +46,7 @@ BASE_SCREEN::BASE_SCREEN( KICAD_T aType ) :
     EDA_ITEM( aType )
 {
     m_UndoRedoCountMax = DEFAULT_MAX_UNDO_ITEMS;
+    m_UndoRedoMemoryMax = 0;
     m_Initialized      = false;
     m_ScreenNumber     = 1;
     m_NumberOfScreens  = 1;      // Hierarchy: Root: ScreenNumber = 1
@@ -295,6 +296,8 @@ void BASE_SCREEN::PushCommandToUndoList( PICKED_ITEMS_LIST* aNewitem )
         if( extraitems > 0 )
             ClearUndoORRedoList( m_UndoList, extraitems );
     }
+
+    trimUndoORRedoList( m_UndoList );
 }
 
 
@@ -310,6 +313,39 @@ void BASE_SCREEN::PushCommandToRedoList( PICKED_ITEMS_LIST* aNewitem )
         if( extraitems > 0 )
             ClearUndoORRedoList( m_RedoList, extraitems );
     }
+
+    trimUndoORRedoList( m_RedoList );
+}
+
+
+void BASE_SCREEN::trimUndoORRedoList( UNDO_REDO_CONTAINER& aList )
+{
+    if( m_UndoRedoMemoryMax <= 0 || aList.m_CommandsList.empty() )
+        return;
+
+    // The commands only change when pushed, so their size is estimated once here
+    PICKED_ITEMS_LIST* newest = aList.m_CommandsList.back();
+    newest->m_MemorySize = GetCommandMemorySize( *newest );
+
+    size_t budget = size_t( m_UndoRedoMemoryMax ) * 1024 * 1024;
+    size_t total = 0;
+    int    keptitems = 0;
+
+    // Keep the newest commands fitting in the budget, and always the last one
+    for( auto it = aList.m_CommandsList.rbegin(); it != aList.m_CommandsList.rend(); ++it )
+    {
+        total += (*it)->m_MemorySize;
+
+        if( keptitems > 0 && total > budget )
+            break;
+
+        keptitems++;
+    }
+
+    int extraitems = (int) aList.m_CommandsList.size() - keptitems;
+
+    if( extraitems > 0 )
+        ClearUndoORRedoList( aList, extraitems );
 }
 
 
@@ -92,12 +92,14 @@ void EDA_ITEM::initVars()
     SetTimeStamp( 0 );      // Time stamp used for logical links
     m_Status    = 0;
     m_forceVisible = false; // true to override the visibility setting of the item.
+    m_contentHash = 0;
 }
 
 
 void EDA_ITEM::SetModified()
 {
     SetFlags( IS_CHANGED );
+    m_contentHash = 0;
 
     // If this a child object, then the parent modification state also needs to be set.
     if( m_Parent )
@@ -105,6 +107,13 @@ void EDA_ITEM::SetModified()
 }
 
 
+void EDA_ITEM::InvalidateHash()
+{
+    for( EDA_ITEM* item = this; item; item = item->m_Parent )
+        item->m_contentHash = 0;
+}
+
+
 const EDA_RECT EDA_ITEM::GetBoundingBox() const
 {
 #if defined(DEBUG)
@@ -231,6 +240,11 @@ EDA_ITEM& EDA_ITEM::operator=( const EDA_ITEM& aItem )
     // A copy of an item cannot have the same time stamp as the original item.
     SetTimeStamp( GetNewTimeStamp() );
 
+    // The derived classes copy their contents after this.  Only this item is reset: the
+    // parents are the ones of the source item when copying, and can be read by other
+    // threads.  Changes made in place by an assignment are invalidated by the commits.
+    m_contentHash = 0;
+
     // do not copy list related fields (Pnext, Pback, m_List)
 
     return *this;
@@ -462,35 +462,121 @@ wxString GetAbbreviatedUnitsLabel( EDA_UNITS_T aUnit, bool aUseMils )
 }
 
 
-std::string FormatInternalUnits( int aValue )
+#ifndef EESCHEMA
+/**
+ * @return the number of decimals of the millimeters of one internal unit, when IU_PER_MM
+ * is a power of ten, or -1.
+ */
+static constexpr int iuDecimals( double aIuPerMm, int aDecimals = 0 )
 {
-    char    buf[50];
-    double  engUnits = aValue;
-    int     len;
+    return aIuPerMm == 1.0 ? aDecimals
+                           : ( aIuPerMm < 1.0 || aDecimals > 6 )
+                                   ? -1 : iuDecimals( aIuPerMm / 10.0, aDecimals + 1 );
+}
+#endif
 
-#ifndef EESCHEMA
-    engUnits /= IU_PER_MM;
+
+/**
+ * Writes @a aValue in @a aBuf as FormatInternalUnits() does, and returns its length.
+ *
+ * When the internal units are a power of ten of the millimeter, the integer and decimal
+ * digits are written directly: the value has at most 10 significant digits, which are
+ * the ones the %.10g and %.10f formats used for the other units give.
+ */
+static int formatInternalUnits( char* aBuf, size_t aSize, int aValue )
+{
+#ifdef EESCHEMA
+    constexpr int decimals = 0;
+#else
+    constexpr int decimals = iuDecimals( IU_PER_MM );
 #endif
 
-    if( engUnits != 0.0 && fabs( engUnits ) <= 0.0001 )
+    if( decimals < 0 )
     {
-        len = snprintf( buf, sizeof(buf), "%.10f", engUnits );
+        double  engUnits = aValue;
+        int     len;
 
-        while( --len > 0 && buf[len] == '0' )
-            buf[len] = '\0';
+#ifndef EESCHEMA
+        engUnits /= IU_PER_MM;
+#endif
+
+        if( engUnits != 0.0 && fabs( engUnits ) <= 0.0001 )
+        {
+            len = snprintf( aBuf, aSize, "%.10f", engUnits );
+
+            while( --len > 0 && aBuf[len] == '0' )
+                aBuf[len] = '\0';
 
 #ifndef EESCHEMA
-        if( buf[len] == '.' )
-            buf[len] = '\0';
-        else
+            if( aBuf[len] == '.' )
+                aBuf[len] = '\0';
+            else
 #endif
-            ++len;
+                ++len;
+        }
+        else
+        {
+            len = snprintf( aBuf, aSize, "%.10g", engUnits );
+        }
+
+        return len;
     }
-    else
+
+    static const unsigned powersOf10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000 };
+
+    char     digits[16];
+    char*    cur = aBuf;
+    unsigned absValue = aValue < 0 ? 0u - (unsigned) aValue : (unsigned) aValue;
+    unsigned scale = powersOf10[decimals < 0 ? 0 : decimals];
+    unsigned integer = absValue / scale;
+    unsigned fraction = absValue % scale;
+    int      count = 0;
+
+    if( aValue < 0 )
+        *cur++ = '-';
+
+    do
     {
-        len = snprintf( buf, sizeof(buf), "%.10g", engUnits );
+        digits[count++] = '0' + integer % 10;
+        integer /= 10;
+    } while( integer );
+
+    while( count )
+        *cur++ = digits[--count];
+
+    if( fraction )
+    {
+        int last = decimals;
+
+        // no trailing zeros
+        while( fraction % 10 == 0 )
+        {
+            fraction /= 10;
+            --last;
+        }
+
+        *cur++ = '.';
+
+        for( int ii = last - 1; ii >= 0; --ii )
+        {
+            cur[ii] = '0' + fraction % 10;
+            fraction /= 10;
+        }
+
+        cur += last;
     }
 
+    *cur = '\0';
+
+    return cur - aBuf;
+}
+
+
+std::string FormatInternalUnits( int aValue )
+{
+    char    buf[50];
+    int     len = formatInternalUnits( buf, sizeof( buf ), aValue );
+
     return std::string( buf, len );
 }
 
@@ -506,20 +592,35 @@ std::string FormatAngle( double aAngle )
 }
 
 
+/**
+ * Formats the two values of a point or a size in a single string.
+ */
+static std::string formatInternalUnits( int aX, int aY )
+{
+    char    buf[100];
+    int     len = formatInternalUnits( buf, 50, aX );
+
+    buf[len++] = ' ';
+    len += formatInternalUnits( buf + len, 50, aY );
+
+    return std::string( buf, len );
+}
+
+
 std::string FormatInternalUnits( const wxPoint& aPoint )
 {
-    return FormatInternalUnits( aPoint.x ) + " " + FormatInternalUnits( aPoint.y );
+    return formatInternalUnits( aPoint.x, aPoint.y );
 }
 
 
 std::string FormatInternalUnits( const VECTOR2I& aPoint )
 {
-    return FormatInternalUnits( aPoint.x ) + " " + FormatInternalUnits( aPoint.y );
+    return formatInternalUnits( aPoint.x, aPoint.y );
 }
 
 
 std::string FormatInternalUnits( const wxSize& aSize )
 {
-    return FormatInternalUnits( aSize.GetWidth() ) + " " + FormatInternalUnits( aSize.GetHeight() );
+    return formatInternalUnits( aSize.GetWidth(), aSize.GetHeight() );
 }
 
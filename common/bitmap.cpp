@@ -76,13 +76,45 @@ namespace std {
 }
 
 
-wxBitmap KiBitmap( BITMAP_DEF aBitmap )
+/**
+ * Return the bitmap aBitmap at aScale (in quarters, 4 being the size of the PNG), decoding
+ * it on its first use only.  The decoded bitmaps are kept for the whole process: menus and
+ * toolbars are rebuilt many times with the same icons, and wxBitmap copies share their data.
+ */
+static wxBitmap getCachedBitmap( BITMAP_DEF aBitmap, int aScale )
 {
+    // Bitmap conversions are cached because they can be slow.
+    static std::unordered_map<SCALED_BITMAP_ID, wxBitmap> bitmap_cache;
+    static std::mutex bitmap_cache_mutex;
+
+    SCALED_BITMAP_ID id = { aBitmap, aScale };
+
+    std::lock_guard<std::mutex> guard( bitmap_cache_mutex );
+    auto it = bitmap_cache.find( id );
+
+    if( it != bitmap_cache.end() )
+        return it->second;
+
     wxMemoryInputStream is( aBitmap->png, aBitmap->byteCount );
     wxImage image( is, wxBITMAP_TYPE_PNG );
-    wxBitmap bitmap( image );
 
-    return bitmap;
+    if( aScale != 4 )
+    {
+        // Bilinear seems to genuinely look better for these line-drawing icons
+        // than bicubic, despite claims in the wx documentation that bicubic is
+        // "highest quality". I don't recommend changing this. Bicubic looks
+        // blurry and makes me want an eye exam.
+        image.Rescale( aScale * image.GetWidth() / 4, aScale * image.GetHeight() / 4,
+                       wxIMAGE_QUALITY_BILINEAR );
+    }
+
+    return bitmap_cache.emplace( id, wxBitmap( image ) ).first->second;
+}
+
+
+wxBitmap KiBitmap( BITMAP_DEF aBitmap )
+{
+    return getCachedBitmap( aBitmap, 4 );
 }
 
 
@@ -115,33 +147,7 @@ static int get_scale_factor( EDA_BASE_FRAME* aWindow )
 
 wxBitmap KiScaledBitmap( BITMAP_DEF aBitmap, EDA_BASE_FRAME* aWindow )
 {
-    // Bitmap conversions are cached because they can be slow.
-    static std::unordered_map<SCALED_BITMAP_ID, wxBitmap> bitmap_cache;
-    static std::mutex bitmap_cache_mutex;
-    const int scale = get_scale_factor( aWindow );
-
-    SCALED_BITMAP_ID id = { aBitmap, scale };
-
-    std::lock_guard<std::mutex> guard( bitmap_cache_mutex );
-    auto it = bitmap_cache.find( id );
-
-    if( it != bitmap_cache.end() )
-    {
-        return it->second;
-    }
-    else
-    {
-        wxMemoryInputStream is( aBitmap->png, aBitmap->byteCount );
-        wxImage image( is, wxBITMAP_TYPE_PNG );
-
-        // Bilinear seems to genuinely look better for these line-drawing icons
-        // than bicubic, despite claims in the wx documentation that bicubic is
-        // "highest quality". I don't recommend changing this. Bicubic looks
-        // blurry and makes me want an eye exam.
-        image.Rescale( scale * image.GetWidth() / 4, scale * image.GetHeight() / 4,
-                wxIMAGE_QUALITY_BILINEAR );
-        return bitmap_cache.emplace( id, wxBitmap( image ) ).first->second;
-    }
+    return getCachedBitmap( aBitmap, get_scale_factor( aWindow ) );
 }
 
 
@@ -184,11 +190,7 @@ void KiScaledSeparator( wxAuiToolBar* aToolbar, EDA_BASE_FRAME* aWindow )
 
 wxBitmap* KiBitmapNew( BITMAP_DEF aBitmap )
 {
-    wxMemoryInputStream is( aBitmap->png, aBitmap->byteCount );
-    wxImage image( is, wxBITMAP_TYPE_PNG );
-    wxBitmap* bitmap = new wxBitmap( image );
-
-    return bitmap;
+    return new wxBitmap( KiBitmap( aBitmap ) );
 }
 
 
@@ -220,15 +222,21 @@ bool SaveCanvasImageToFile( EDA_DRAW_FRAME* aFrame, const wxString& aFileName,
 }
 
 
-void AddBitmapToMenuItem( wxMenuItem* aMenu, const wxBitmap& aImage )
+static bool use_images_in_menus()
 {
     // Retrieve the global applicaton show icon option:
     bool useImagesInMenus;
     Pgm().CommonSettings()->Read( USE_ICONS_IN_MENUS_KEY, &useImagesInMenus );
 
+    return useImagesInMenus;
+}
+
+
+void AddBitmapToMenuItem( wxMenuItem* aMenu, const wxBitmap& aImage )
+{
     wxItemKind menu_type = aMenu->GetKind();
 
-    if( useImagesInMenus )
+    if( use_images_in_menus() )
     {
         if( menu_type == wxITEM_CHECK || menu_type == wxITEM_RADIO )
         {
@@ -248,6 +256,14 @@ void AddBitmapToMenuItem( wxMenuItem* aMenu, const wxBitmap& aImage )
 }
 
 
+void AddBitmapToMenuItem( wxMenuItem* aMenu, BITMAP_DEF aImage )
+{
+    // The icon is not even decoded when the menus have no images
+    if( use_images_in_menus() )
+        AddBitmapToMenuItem( aMenu, KiBitmap( aImage ) );
+}
+
+
 wxMenuItem* AddMenuItem( wxMenu* aMenu, int aId, const wxString& aText,
                          const wxBitmap& aImage, wxItemKind aType = wxITEM_NORMAL )
 {
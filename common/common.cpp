@@ -80,8 +80,12 @@ std::atomic<unsigned int> LOCALE_IO::m_c_count( 0 );
 // in some cases (reading a bitmap for instance)
 // So we disable alerts during the time a file is read or written
 
-LOCALE_IO::LOCALE_IO()
+LOCALE_IO::LOCALE_IO() :
+        m_threadLocale( THREAD_LOCALE_IO::IsActive() )
 {
+    if( m_threadLocale )
+        return;
+
     // use thread safe, atomic operation
     if( m_c_count++ == 0 )
     {
@@ -99,6 +103,9 @@ LOCALE_IO::LOCALE_IO()
 
 LOCALE_IO::~LOCALE_IO()
 {
+    if( m_threadLocale )
+        return;
+
     // use thread safe, atomic operation
     if( --m_c_count == 0 )
     {
@@ -112,6 +119,45 @@ LOCALE_IO::~LOCALE_IO()
 }
 
 
+thread_local int THREAD_LOCALE_IO::m_depth = 0;
+
+
+THREAD_LOCALE_IO::THREAD_LOCALE_IO()
+{
+    if( m_depth++ > 0 )
+        return;
+
+#if defined( _WIN32 )
+    // setlocale() then changes the locale of this thread only
+    m_threadConfig = _configthreadlocale( _ENABLE_PER_THREAD_LOCALE );
+    m_user_locale = setlocale( LC_NUMERIC, nullptr );
+    setlocale( LC_NUMERIC, "C" );
+#else
+    // Only the numeric category of the thread locale is changed
+    m_cLocale = newlocale( LC_NUMERIC_MASK, "C", duplocale( uselocale( (locale_t) 0 ) ) );
+    m_userLocale = m_cLocale ? uselocale( m_cLocale ) : (locale_t) 0;
+#endif
+}
+
+
+THREAD_LOCALE_IO::~THREAD_LOCALE_IO()
+{
+    if( --m_depth > 0 )
+        return;
+
+#if defined( _WIN32 )
+    setlocale( LC_NUMERIC, m_user_locale.c_str() );
+    _configthreadlocale( m_threadConfig );
+#else
+    if( m_cLocale )
+    {
+        uselocale( m_userLocale );
+        freelocale( m_cLocale );
+    }
+#endif
+}
+
+
 wxSize GetTextSize( const wxString& aSingleLine, wxWindow* aWindow )
 {
     wxCoord width;
@@ -216,15 +262,19 @@ int ProcessExecute( const wxString& aCommandLine, int aFlags, wxProcess *callbac
 
 timestamp_t GetNewTimeStamp()
 {
-    static timestamp_t oldTimeStamp;
+    // Items may be created by several threads (e.g. when importing libraries)
+    static std::atomic<timestamp_t> oldTimeStamp( 0 );
+    timestamp_t now = time( NULL );
+    timestamp_t previous = oldTimeStamp.load();
     timestamp_t newTimeStamp;
 
-    newTimeStamp = time( NULL );
-
-    if( newTimeStamp <= oldTimeStamp )
-        newTimeStamp = oldTimeStamp + 1;
+    do
+    {
+        newTimeStamp = now;
 
-    oldTimeStamp = newTimeStamp;
+        if( newTimeStamp <= previous )
+            newTimeStamp = previous + 1;
+    } while( !oldTimeStamp.compare_exchange_weak( previous, newTimeStamp ) );
 
     return newTimeStamp;
 }
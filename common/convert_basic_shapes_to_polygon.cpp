@@ -32,6 +32,7 @@
 #include <common.h>
 #include <convert_basic_shapes_to_polygon.h>
 #include <geometry/geometry_utils.h>
+#include <thread_pool.h>
 
 
 void TransformCircleToPolygon( SHAPE_LINE_CHAIN& aBuffer,
@@ -84,6 +85,46 @@ void TransformCircleToPolygon( SHAPE_POLY_SET& aCornerBuffer,
 }
 
 
+/**
+ * Clips the convex polygon aPoints to the horizontal band -aHalfWidth <= y <= aHalfWidth.
+ * This is the intersection with a bounding box of the band height, computed directly
+ * (Sutherland-Hodgman) instead of using Clipper.
+ */
+static void clampToHorizontalBand( std::vector<wxPoint>& aPoints, int aHalfWidth )
+{
+    for( int side : { 1, -1 } )
+    {
+        std::vector<wxPoint> clipped;
+        size_t               count = aPoints.size();
+
+        for( size_t ii = 0; ii < count; ++ii )
+        {
+            const wxPoint& a = aPoints[ii];
+            const wxPoint& b = aPoints[( ii + 1 ) % count];
+            bool           aInside = side * a.y <= aHalfWidth;
+            bool           bInside = side * b.y <= aHalfWidth;
+
+            if( aInside )
+                clipped.push_back( a );
+
+            if( aInside != bInside )
+            {
+                double  t = double( side * aHalfWidth - a.y ) / ( b.y - a.y );
+                wxPoint crossing( KiROUND( a.x + t * ( b.x - a.x ) ), side * aHalfWidth );
+
+                if( clipped.empty() || clipped.back() != crossing )
+                    clipped.push_back( crossing );
+            }
+        }
+
+        if( clipped.size() > 1 && clipped.back() == clipped.front() )
+            clipped.pop_back();
+
+        aPoints.swap( clipped );
+    }
+}
+
+
 void TransformOvalClearanceToPolygon( SHAPE_POLY_SET& aCornerBuffer,
                                       wxPoint aStart, wxPoint aEnd, int aWidth,
                                       int aError )
@@ -104,9 +145,7 @@ void TransformOvalClearanceToPolygon( SHAPE_POLY_SET& aCornerBuffer,
     wxPoint endp    = aEnd - aStart;
     wxPoint startp  = aStart;
     wxPoint corner;
-    SHAPE_POLY_SET polyshape;
-
-    polyshape.NewOutline();
+    std::vector<wxPoint> polyshape;
 
     // normalize the position in order to have endp.x >= 0
     // it makes calculations more easy to understand
@@ -131,56 +170,112 @@ void TransformOvalClearanceToPolygon( SHAPE_POLY_SET& aCornerBuffer,
         corner = wxPoint( 0, radius );
         RotatePoint( &corner, delta * ii );
         corner.x += seg_len;
-        polyshape.Append( corner.x, corner.y );
+        polyshape.push_back( corner );
     }
 
     // Finish arc:
     corner = wxPoint( seg_len, -radius );
-    polyshape.Append( corner.x, corner.y );
+    polyshape.push_back( corner );
 
     // add left rounded end:
     for( int ii = 0; ii < numSegs / 2; ii++ )
     {
         corner = wxPoint( 0, -radius );
         RotatePoint( &corner, delta * ii );
-        polyshape.Append( corner.x, corner.y );
+        polyshape.push_back( corner );
     }
 
     // Finish arc:
     corner = wxPoint( 0, radius );
-    polyshape.Append( corner.x, corner.y );
+    polyshape.push_back( corner );
 
     // Now, clamp the polygonal shape (too big) with the segment bounding box
     // the polygonal shape bbox equivalent to the segment has a too big height,
-    // and the right width
+    // and the right width: use the exact segment width for the bbox height
     if( correction > 1.0 )
+        clampToHorizontalBand( polyshape, aWidth / 2 );
+
+    SHAPE_POLY_SET outline;
+    outline.NewOutline();
+
+    for( const wxPoint& pt : polyshape )
+        outline.Append( pt.x, pt.y );
+
+    // Rotate and move the polygon to its right location
+    outline.Rotate( delta_angle, VECTOR2I( 0, 0 ) );
+    outline.Move( startp );
+
+    aCornerBuffer.Append( outline );
+}
+
+
+void TransformConvexPolygonToRoundedPolygon( SHAPE_POLY_SET& aCornerBuffer,
+                                             const wxPoint* aCorners, int aCornerCount,
+                                             int aRadius, int aCircleSegmentsCount )
+{
+    // Skip the repeated corners, which have no edge direction
+    std::vector<VECTOR2D> corners;
+
+    for( int ii = 0; ii < aCornerCount; ++ii )
+    {
+        VECTOR2D corner( aCorners[ii].x, aCorners[ii].y );
+
+        if( corners.empty() || corner != corners.back() )
+            corners.push_back( corner );
+    }
+
+    while( corners.size() > 1 && corners.back() == corners.front() )
+        corners.pop_back();
+
+    aCornerBuffer.NewOutline();
+
+    if( aRadius <= 0 || corners.empty() )
     {
-        SHAPE_POLY_SET bbox;
-        bbox.NewOutline();
-        // Build the bbox (a horizontal rectangle).
-        int halfwidth = aWidth / 2;     // Use the exact segment width for the bbox height
-        corner.x = -radius - 2;         // use a bbox width slightly bigger to avoid
-                                        // creating useless corner at segment ends
-        corner.y = halfwidth;
-        bbox.Append( corner.x, corner.y );
-        corner.y = -halfwidth;
-        bbox.Append( corner.x, corner.y );
-        corner.x = radius + seg_len + 2;
-        bbox.Append( corner.x, corner.y );
-        corner.y = halfwidth;
-        bbox.Append( corner.x, corner.y );
-
-        // Now, clamp the shape
-        polyshape.BooleanIntersection( bbox, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
-        // Note the final polygon is a simple, convex polygon with no hole
-        // due to the shape of initial polygons
+        for( const VECTOR2D& corner : corners )
+            aCornerBuffer.Append( KiROUND( corner.x ), KiROUND( corner.y ) );
+
+        return;
     }
 
-    // Rotate and move the polygon to its right location
-    polyshape.Rotate( delta_angle, VECTOR2I( 0, 0 ) );
-    polyshape.Move( startp );
+    // Use the counterclockwise orientation (in the math sense), for which the outward normal
+    // of an edge is on its right, and the arcs go counterclockwise too
+    double area = 0.0;
 
-    aCornerBuffer.Append( polyshape);
+    for( size_t ii = 0; ii < corners.size(); ++ii )
+        area += corners[ii].Cross( corners[( ii + 1 ) % corners.size()] );
+
+    if( area < 0.0 )
+        std::reverse( corners.begin(), corners.end() );
+
+    int    numSegs = std::max( aCircleSegmentsCount, 6 );
+    size_t count = corners.size();
+
+    auto normalAngle = [&]( size_t aEdge ) -> double
+    {
+        VECTOR2D dir = corners[( aEdge + 1 ) % count] - corners[aEdge];
+        return atan2( -dir.x, dir.y );
+    };
+
+    for( size_t ii = 0; ii < count; ++ii )
+    {
+        // A single corner gives a full circle
+        double startAngle = count > 1 ? normalAngle( ( ii + count - 1 ) % count ) : 0.0;
+        double sweep = count > 1 ? normalAngle( ii ) - startAngle : 2.0 * M_PI;
+
+        if( sweep < 0.0 )
+            sweep += 2.0 * M_PI;
+
+        int steps = std::max( KiROUND( sweep * numSegs / ( 2.0 * M_PI ) ), 1 );
+        int last = count > 1 ? steps : steps - 1;
+
+        for( int jj = 0; jj <= last; ++jj )
+        {
+            double angle = startAngle + sweep * jj / steps;
+
+            aCornerBuffer.Append( KiROUND( corners[ii].x + aRadius * cos( angle ) ),
+                                  KiROUND( corners[ii].y + aRadius * sin( angle ) ) );
+        }
+    }
 }
 
 
@@ -238,14 +333,22 @@ void TransformRoundChamferedRectToPolygon( SHAPE_POLY_SET& aCornerBuffer,
                                aSize, aChamferCorners ? 0.0 : aRotation );
 
     SHAPE_POLY_SET outline;
-    outline.NewOutline();
-
-    for( int ii = 0; ii < 4; ++ii )
-        outline.Append( corners[ii].x, corners[ii].y );
-
     int     numSegs = std::max( GetArcToSegmentCount( aCornerRadius, aApproxErrorMax, 360.0 ),
                                                       aMinSegPerCircleCount );
-    outline.Inflate( aCornerRadius, numSegs );
+
+    if( aCornerRadius > 0 )
+    {
+        TransformConvexPolygonToRoundedPolygon( outline, corners, 4, aCornerRadius, numSegs );
+    }
+    else
+    {
+        outline.NewOutline();
+
+        for( int ii = 0; ii < 4; ++ii )
+            outline.Append( corners[ii].x, corners[ii].y );
+
+        outline.Inflate( aCornerRadius, numSegs );
+    }
 
     if( aChamferCorners == RECT_NO_CHAMFER )      // no chamfer
     {
@@ -450,3 +553,35 @@ void TransformRingToPolygon( SHAPE_POLY_SET& aCornerBuffer,
     buffer.Fracture( SHAPE_POLY_SET::PM_FAST );
     aCornerBuffer.Append( buffer );
 }
+
+
+void TransformShapesToPolygon( SHAPE_POLY_SET& aCornerBuffer, size_t aCount,
+        const std::function<void( size_t aIndex, SHAPE_POLY_SET& aBuffer )>& aTransform )
+{
+    // Shapes are converted by fixed size chunks, and appended in the index order
+    const size_t chunkSize = 256;
+    size_t       chunkCount = ( aCount + chunkSize - 1 ) / chunkSize;
+
+    if( chunkCount <= 1 )
+    {
+        for( size_t ii = 0; ii < aCount; ++ii )
+            aTransform( ii, aCornerBuffer );
+
+        return;
+    }
+
+    std::vector<SHAPE_POLY_SET> chunkBuffers( chunkCount );
+
+    THREAD_POOL::GetPool().ParallelFor( chunkCount,
+            [&]( size_t i )
+            {
+                size_t last = std::min( aCount, ( i + 1 ) * chunkSize );
+
+                for( size_t ii = i * chunkSize; ii < last; ++ii )
+                    aTransform( ii, chunkBuffers[i] );
+            },
+            1 );
+
+    for( const SHAPE_POLY_SET& buffer : chunkBuffers )
+        aCornerBuffer.Append( buffer );
+}
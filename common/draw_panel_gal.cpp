@@ -27,6 +27,8 @@
 #include <eda_draw_frame.h>
 #include <kiface_i.h>
 #include <confirm.h>
+#include <macros.h>
+#include <advanced_config.h>
 
 #include <class_draw_panel_gal.h>
 #include <view/view.h>
@@ -102,6 +104,8 @@ EDA_DRAW_PANEL_GAL::EDA_DRAW_PANEL_GAL( wxWindow* aParentWindow, wxWindowID aWin
     m_pendingRefresh = false;
     m_drawing = false;
     m_drawingEnabled = false;
+    m_lastFrameTime = 0.0;
+    m_lastRedrawTime = 0.0;
 
     // Set up timer that prevents too frequent redraw commands
     m_refreshTimer.SetOwner( this );
@@ -144,6 +148,57 @@ void EDA_DRAW_PANEL_GAL::SetFocus()
 }
 
 
+/**
+ * Draws the statistics of the last frame over the view (see ADVANCED_CFG::m_showRenderStats).
+ */
+static void drawRenderStats( KIGFX::GAL* aGal, KIGFX::VIEW* aView,
+                             const KIGFX::GAL::RENDER_STATS& aStats,
+                             double aFrameTime, double aRedrawTime )
+{
+    const KIGFX::VIEW::REDRAW_STATS& redraw = aView->GetRedrawStats();
+
+    const wxString lines[] =
+    {
+        wxString::Format( "Frame: %.1f ms, redraw: %.1f ms", aFrameTime, aRedrawTime ),
+        wxString::Format( "Layers: %d, items queried: %d, drawn: %d",
+                          redraw.m_layers, redraw.m_queriedItems, redraw.m_drawnItems ),
+        wxString::Format( "Draw calls: %d, vertices: %d",
+                          aStats.m_drawCalls, aStats.m_drawnVertices ),
+        wxString::Format( "Cached: %d / %d, noncached: %d, overlay: %d vertices",
+                          aStats.m_cachedVertices, aStats.m_cachedCapacity,
+                          aStats.m_noncachedVertices, aStats.m_overlayVertices ),
+        wxString::Format( "GPU memory: %.1f MB", aStats.m_gpuMemory / ( 1024.0 * 1024.0 ) )
+    };
+
+    // Text size and placement, in pixels
+    const double glyphSize = 10.0;
+    const double lineSpacing = 16.0;
+    const double margin = 8.0;
+
+    KIGFX::RENDER_TARGET oldTarget = aGal->GetTarget();
+
+    aGal->SetTarget( KIGFX::TARGET_OVERLAY );
+    aGal->SetIsFill( false );
+    aGal->SetIsStroke( true );
+    aGal->SetStrokeColor( KIGFX::COLOR4D( 1.0, 1.0, 0.0, 1.0 ) );
+    aGal->SetLineWidth( aView->ToWorld( 1.0 ) );
+    aGal->SetGlyphSize( VECTOR2D( aView->ToWorld( glyphSize ), aView->ToWorld( glyphSize ) ) );
+    aGal->SetFontBold( false );
+    aGal->SetFontItalic( false );
+    aGal->SetTextMirrored( false );
+    aGal->SetHorizontalJustify( GR_TEXT_HJUSTIFY_LEFT );
+    aGal->SetVerticalJustify( GR_TEXT_VJUSTIFY_TOP );
+
+    for( unsigned int i = 0; i < arrayDim( lines ); ++i )
+    {
+        VECTOR2D pos = aView->ToWorld( VECTOR2D( margin, margin + i * lineSpacing ) );
+        aGal->BitmapText( lines[i], pos, 0.0 );
+    }
+
+    aGal->SetTarget( oldTarget );
+}
+
+
 void EDA_DRAW_PANEL_GAL::onPaint( wxPaintEvent& WXUNUSED( aEvent ) )
 {
     m_viewControls->UpdateScrollbars();
@@ -164,19 +219,25 @@ void EDA_DRAW_PANEL_GAL::onPaint( wxPaintEvent& WXUNUSED( aEvent ) )
     if( m_drawing )
         return;
 
-#ifdef __WXDEBUG__
     PROF_COUNTER totalRealTime;
-#endif /* PROFILE */
 
     wxASSERT( m_painter );
 
     m_drawing = true;
     KIGFX::RENDER_SETTINGS* settings = static_cast<KIGFX::RENDER_SETTINGS*>( m_painter->GetSettings() );
+    bool showStats = ADVANCED_CFG::GetCfg().m_showRenderStats;
 
     try
     {
         m_view->UpdateItems();
 
+        // The GAL counters are reset when the drawing starts, so they describe the last frame
+        KIGFX::GAL::RENDER_STATS renderStats = m_gal->GetRenderStats();
+
+        // The statistics are drawn on the overlay, which has to be refreshed on every frame
+        if( showStats )
+            m_view->MarkTargetDirty( KIGFX::TARGET_OVERLAY );
+
         KIGFX::GAL_DRAWING_CONTEXT ctx( m_gal );
 
         m_gal->SetClearColor( settings->GetBackgroundColor() );
@@ -191,6 +252,10 @@ void EDA_DRAW_PANEL_GAL::onPaint( wxPaintEvent& WXUNUSED( aEvent ) )
 
         if( m_view->IsDirty() )
         {
+            // Restrict the redraw to the updated items if the GAL keeps the previous frame,
+            // ClearScreen(), ClearTargets() and Redraw() below are clipped to their area then
+            m_view->ClipToDirtyArea();
+
             if( m_backend != GAL_TYPE_OPENGL &&     // Already called in opengl
                 m_view->IsTargetDirty( KIGFX::TARGET_NONCACHED ) )
                 m_gal->ClearScreen();
@@ -201,7 +266,13 @@ void EDA_DRAW_PANEL_GAL::onPaint( wxPaintEvent& WXUNUSED( aEvent ) )
             if( m_view->IsTargetDirty( KIGFX::TARGET_NONCACHED ) )
                 m_gal->DrawGrid();
 
+            if( showStats )
+                drawRenderStats( m_gal, m_view, renderStats, m_lastFrameTime, m_lastRedrawTime );
+
+            PROF_COUNTER redrawTime;
             m_view->Redraw();
+            redrawTime.Stop();
+            m_lastRedrawTime = redrawTime.msecs();
         }
 
         m_gal->DrawCursor( m_viewControls->GetCursorPosition() );
@@ -217,9 +288,11 @@ void EDA_DRAW_PANEL_GAL::onPaint( wxPaintEvent& WXUNUSED( aEvent ) )
                             wxString( err.what() ) );
     }
 
-#ifdef __WXDEBUG__
     totalRealTime.Stop();
-    wxLogTrace( "GAL_PROFILE", "EDA_DRAW_PANEL_GAL::onPaint(): %.1f ms", totalRealTime.msecs() );
+    m_lastFrameTime = totalRealTime.msecs();
+
+#ifdef __WXDEBUG__
+    wxLogTrace( "GAL_PROFILE", "EDA_DRAW_PANEL_GAL::onPaint(): %.1f ms", m_lastFrameTime );
 #endif /* PROFILE */
 
     m_lastRefresh = wxGetLocalTimeMillis();
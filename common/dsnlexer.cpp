@@ -27,6 +27,7 @@
 #include <cstdarg>
 #include <cstdio>
 #include <cstdlib>         // bsearch()
+#include <cstring>
 #include <cctype>
 
 #include <macros.h>
@@ -54,6 +55,10 @@ void DSNLEXER::init()
 
     curOffset = 0;
 
+    // The generated lexers have a perfect hash of their keywords
+    if( keywordPerfectHash )
+        return;
+
 #if 1
     if( keywordCount > 11 )
     {
@@ -74,14 +79,16 @@ void DSNLEXER::init()
 
 
 DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
-                    FILE* aFile, const wxString& aFilename ) :
+                    FILE* aFile, const wxString& aFilename,
+                    const KEYWORD_HASH* aKeywordHash ) :
     iOwnReaders( true ),
     start( NULL ),
     next( NULL ),
     limit( NULL ),
     reader( NULL ),
     keywords( aKeywordTable ),
-    keywordCount( aKeywordCount )
+    keywordCount( aKeywordCount ),
+    keywordPerfectHash( aKeywordHash )
 {
     FILE_LINE_READER* fileReader = new FILE_LINE_READER( aFile, aFilename );
     PushReader( fileReader );
@@ -90,14 +97,16 @@ DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
 
 
 DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
-                    const std::string& aClipboardTxt, const wxString& aSource ) :
+                    const std::string& aClipboardTxt, const wxString& aSource,
+                    const KEYWORD_HASH* aKeywordHash ) :
     iOwnReaders( true ),
     start( NULL ),
     next( NULL ),
     limit( NULL ),
     reader( NULL ),
     keywords( aKeywordTable ),
-    keywordCount( aKeywordCount )
+    keywordCount( aKeywordCount ),
+    keywordPerfectHash( aKeywordHash )
 {
     STRING_LINE_READER* stringReader = new STRING_LINE_READER( aClipboardTxt, aSource.IsEmpty() ?
                                         wxString( FMT_CLIPBOARD ) : aSource );
@@ -107,14 +116,15 @@ DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
 
 
 DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
-                    LINE_READER* aLineReader ) :
+                    LINE_READER* aLineReader, const KEYWORD_HASH* aKeywordHash ) :
     iOwnReaders( false ),
     start( NULL ),
     next( NULL ),
     limit( NULL ),
     reader( NULL ),
     keywords( aKeywordTable ),
-    keywordCount( aKeywordCount )
+    keywordCount( aKeywordCount ),
+    keywordPerfectHash( aKeywordHash )
 {
     if( aLineReader )
         PushReader( aLineReader );
@@ -131,7 +141,8 @@ DSNLEXER::DSNLEXER( const std::string& aSExpression, const wxString& aSource ) :
     limit( NULL ),
     reader( NULL ),
     keywords( empty_keywords ),
-    keywordCount( 0 )
+    keywordCount( 0 ),
+    keywordPerfectHash( NULL )
 {
     STRING_LINE_READER* stringReader = new STRING_LINE_READER( aSExpression, aSource.IsEmpty() ?
                                         wxString( FMT_CLIPBOARD ) : aSource );
@@ -259,6 +270,16 @@ int DSNLEXER::findToken( const std::string& tok )
 
 inline int DSNLEXER::findToken( const std::string& tok )
 {
+    if( keywordPerfectHash )
+    {
+        int index = keywordPerfectHash->Slot( tok.c_str(), tok.size() );
+
+        if( index >= 0 && !strcmp( keywords[index].name, tok.c_str() ) )
+            return keywords[index].token;
+
+        return DSN_SYMBOL;      // not a keyword, some arbitrary symbol.
+    }
+
     KEYWORD_MAP::const_iterator it = keyword_hash.find( tok.c_str() );
     if( it != keyword_hash.end() )
         return it->second;
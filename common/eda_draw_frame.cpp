@@ -80,6 +80,20 @@ static const wxChar ReplaceStringHistoryEntry[] =   wxT( "ReplaceStringHistoryLi
  */
 static const wxString MaxUndoItemsEntry(wxT( "DevelMaxUndoItems" ) );
 
+/**
+ * Integer to set the memory budget of the undo stack, in megabytes.  The oldest undo items
+ * are dropped once the estimated memory held by the stack exceeds it.  If zero, the memory
+ * is unlimited.
+ *
+ * Present as:
+ *
+ * - PcbFrameDevelMaxUndoMemory (file: pcbnew)
+ * - ModEditFrameDevelMaxUndoMemory (file: pcbnew)
+ *
+ * \ingroup develconfig
+ */
+static const wxString MaxUndoMemoryEntry(wxT( "DevelMaxUndoMemory" ) );
+
 EDA_DRAW_FRAME::EDA_DRAW_FRAME( KIWAY* aKiway, wxWindow* aParent, FRAME_T aFrameType,
                                 const wxString& aTitle, const wxPoint& aPos, const wxSize& aSize,
                                 long aStyle, const wxString & aFrameName ) :
@@ -94,6 +108,7 @@ EDA_DRAW_FRAME::EDA_DRAW_FRAME( KIWAY* aKiway, wxWindow* aParent, FRAME_T aFrame
     m_zoomSelectBox       = NULL;
     m_firstRunDialogSetting = 0;
     m_UndoRedoCountMax    = DEFAULT_MAX_UNDO_ITEMS;
+    m_UndoRedoMemoryMax   = DEFAULT_MAX_UNDO_MEMORY;
 
     m_canvasType          = EDA_DRAW_PANEL_GAL::GAL_TYPE_NONE;
     m_canvas              = NULL;
@@ -480,6 +495,9 @@ void EDA_DRAW_FRAME::LoadSettings( wxConfigBase* aCfg )
     m_UndoRedoCountMax = aCfg->Read( baseCfgName + MaxUndoItemsEntry,
                                      long( DEFAULT_MAX_UNDO_ITEMS ) );
 
+    m_UndoRedoMemoryMax = aCfg->Read( baseCfgName + MaxUndoMemoryEntry,
+                                      long( DEFAULT_MAX_UNDO_MEMORY ) );
+
     aCfg->Read( baseCfgName + FirstRunShownKeyword, &m_firstRunDialogSetting, 0L );
 
     m_galDisplayOptions.ReadConfig( *cmnCfg, *aCfg, baseCfgName, this );
@@ -522,7 +540,10 @@ void EDA_DRAW_FRAME::SaveSettings( wxConfigBase* aCfg )
     aCfg->Write( baseCfgName + FirstRunShownKeyword, m_firstRunDialogSetting );
 
     if( GetScreen() )
+    {
         aCfg->Write( baseCfgName + MaxUndoItemsEntry, long( GetScreen()->GetMaxUndoItems() ) );
+        aCfg->Write( baseCfgName + MaxUndoMemoryEntry, long( GetScreen()->GetMaxUndoMemory() ) );
+    }
 
     m_galDisplayOptions.WriteConfig( *aCfg, baseCfgName );
 
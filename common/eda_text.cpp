@@ -88,7 +88,9 @@ EDA_TEXT_VJUSTIFY_T EDA_TEXT::MapVertJustify( int aVertJustify )
 
 EDA_TEXT::EDA_TEXT( const wxString& text ) :
     m_Text( text ),
-    m_e( 1<<TE_VISIBLE )
+    m_e( 1<<TE_VISIBLE ),
+    m_textBoxValid( false ),
+    m_textBoxItalic( false )
 {
     int sz = Mils2iu( DEFAULT_SIZE_TEXT );
     SetTextSize( wxSize( sz, sz ) );
@@ -98,7 +100,9 @@ EDA_TEXT::EDA_TEXT( const wxString& text ) :
 
 EDA_TEXT::EDA_TEXT( const EDA_TEXT& aText ) :
     m_Text( aText.m_Text ),
-    m_e( aText.m_e )
+    m_e( aText.m_e ),
+    m_textBoxValid( false ),
+    m_textBoxItalic( false )
 {
     m_shown_text = UnescapeString( m_Text );
 }
@@ -113,23 +117,29 @@ void EDA_TEXT::SetText( const wxString& aText )
 {
     m_Text = aText;
     m_shown_text = UnescapeString( aText );
+    m_textBoxValid = false;
 }
 
 
 void EDA_TEXT::SetEffects( const EDA_TEXT& aSrc )
 {
     m_e = aSrc.m_e;
+    m_textBoxValid = false;
 }
 
 
 void EDA_TEXT::SwapEffects( EDA_TEXT& aTradingPartner )
 {
     std::swap( m_e, aTradingPartner.m_e );
+    m_textBoxValid = false;
+    aTradingPartner.m_textBoxValid = false;
 }
 
 
 int EDA_TEXT::LenSize( const wxString& aLine, int aThickness ) const
 {
+    std::lock_guard<std::mutex> lock( basic_gal_lock );
+
     basic_gal.SetFontItalic( IsItalic() );
     basic_gal.SetFontBold( IsBold() );
     basic_gal.SetLineWidth( aThickness );
@@ -165,6 +175,43 @@ int EDA_TEXT::GetInterline( int aTextThickness ) const
 
 
 EDA_RECT EDA_TEXT::GetTextBox( int aLine, int aThickness, bool aInvertY ) const
+{
+    // The shown text of a derived class can be built from other data than the text (the
+    // reference of the footprint for instance): it is not cached then.  The width of the
+    // text depends on the italic state of the shared stroke font.
+    bool italic = basic_gal.IsFontItalic();
+
+    if( aLine >= 0 || aThickness >= 0 || GetShownText() != m_shown_text )
+        return calcTextBox( aLine, aThickness, aInvertY );
+
+    if( !m_textBoxValid || m_textBoxItalic != italic )
+    {
+        m_textBox = calcTextBox( -1, -1, false );
+        m_textBox.Move( -GetTextPos() );
+        m_textBoxValid = true;
+        m_textBoxItalic = italic;
+    }
+
+    wxPoint  pos = GetTextPos();
+    EDA_RECT rect = m_textBox;
+
+    if( aInvertY )
+        pos.y = -pos.y;
+
+    rect.Move( pos );
+
+#ifdef DEBUG
+    // A setter of the text effects not invalidating the cache would leave a stale box here
+    EDA_RECT check = calcTextBox( aLine, aThickness, aInvertY );
+    wxASSERT_MSG( rect.GetOrigin() == check.GetOrigin() && rect.GetSize() == check.GetSize(),
+                  wxT( "EDA_TEXT::GetTextBox(): stale cached text box" ) );
+#endif
+
+    return rect;
+}
+
+
+EDA_RECT EDA_TEXT::calcTextBox( int aLine, int aThickness, bool aInvertY ) const
 {
     EDA_RECT       rect;
     wxArrayString  strings;
@@ -20,6 +20,8 @@
 
 #include <footprint_filter.h>
 #include <make_unique.h>
+#include <thread_pool.h>
+#include <algorithm>
 #include <stdexcept>
 
 using FOOTPRINT_FILTER_IT = FOOTPRINT_FILTER::ITERATOR;
@@ -45,62 +47,18 @@ FOOTPRINT_FILTER::ITERATOR::ITERATOR( FOOTPRINT_FILTER& aFilter )
 
 void FOOTPRINT_FILTER_IT::increment()
 {
-    bool found = false;
-
     if( !m_filter || !m_filter->m_list || m_filter->m_list->GetCount() == 0 )
     {
         m_pos = 0;
         return;
     }
 
-    auto  filter_type       = m_filter->m_filter_type;
-    auto  list              = m_filter->m_list;
-    auto& lib_name          = m_filter->m_lib_name;
-    auto& filter_pattern    = m_filter->m_filter_pattern;
-    auto& filter            = m_filter->m_filter;
-
-    for( ++m_pos; m_pos < list->GetCount() && !found; ++m_pos )
-    {
-        found = true;
-
-        if( ( filter_type & FOOTPRINT_FILTER::FILTERING_BY_LIBRARY ) && !lib_name.IsEmpty()
-                && !list->GetItem( m_pos ).InLibrary( lib_name ) )
-            found = false;
-
-        if( ( filter_type & FOOTPRINT_FILTER::FILTERING_BY_COMPONENT_KEYWORD )
-                && !FootprintFilterMatch( list->GetItem( m_pos ) ) )
-            found = false;
+    m_filter->updateMatches();
 
-        if( ( filter_type & FOOTPRINT_FILTER::FILTERING_BY_PIN_COUNT )
-                && !PinCountMatch( list->GetItem( m_pos ) ) )
-            found = false;
+    const std::vector<char>& matches = m_filter->m_matches;
 
-        if( ( filter_type & FOOTPRINT_FILTER::FILTERING_BY_NAME ) && !filter_pattern.IsEmpty() )
-        {
-            wxString currname;
-
-            // If the search string contains a ':' character,
-            // include the library name in the search string
-            // e.g. LibName:FootprintName
-            if( filter_pattern.Contains( ":" ) )
-                currname = list->GetItem( m_pos ).GetLibNickname().Lower() + ":";
-
-            currname += list->GetItem( m_pos ).GetFootprintName().Lower();
-
-            if( filter.Find( currname ) == EDA_PATTERN_NOT_FOUND )
-                found = false;
-        }
-
-        if( filter_type == FOOTPRINT_FILTER::UNFILTERED_FP_LIST )
-        {
-            // override
-            found = true;
-        }
-    }
-
-    // for loop will stop one past the correct item
-    if( found )
-        --m_pos;
+    for( ++m_pos; m_pos < matches.size() && !matches[m_pos]; ++m_pos )
+        ;
 }
 
 
@@ -120,40 +78,93 @@ FOOTPRINT_INFO& FOOTPRINT_FILTER_IT::dereference() const
 }
 
 
-bool FOOTPRINT_FILTER_IT::FootprintFilterMatch( FOOTPRINT_INFO& aItem )
+void FOOTPRINT_FILTER::buildMatchers( MATCHERS& aMatchers ) const
 {
-    if( m_filter->m_footprint_filters.empty() )
+    aMatchers.m_filter.SetPattern( m_filter_pattern.Lower() );
+    aMatchers.m_footprint_filters.clear();
+
+    for( auto const& each_pattern : m_footprint_filters )
+    {
+        aMatchers.m_footprint_filters.push_back(
+                std::make_unique<EDA_PATTERN_MATCH_WILDCARD_EXPLICIT>() );
+        aMatchers.m_footprint_filters.back()->SetPattern( each_pattern );
+    }
+}
+
+
+bool FOOTPRINT_FILTER::match( FOOTPRINT_INFO& aItem, const MATCHERS& aMatchers ) const
+{
+    if( m_filter_type == UNFILTERED_FP_LIST )
         return true;
 
-    // The matching is case insensitive
-    wxString name;
+    if( ( m_filter_type & FILTERING_BY_LIBRARY ) && !m_lib_name.IsEmpty()
+            && !aItem.InLibrary( m_lib_name ) )
+        return false;
 
-    for( auto const& each_filter : m_filter->m_footprint_filters )
+    if( ( m_filter_type & FILTERING_BY_PIN_COUNT )
+            && ( m_pin_count < 0 || (unsigned) m_pin_count != aItem.GetUniquePadCount() ) )
+        return false;
+
+    // The matching is case insensitive: the footprint keys are in lowercase.
+    // If a pattern contains a ':' character, the library name is matched too.
+    if( ( m_filter_type & FILTERING_BY_COMPONENT_KEYWORD ) && !m_footprint_filters.empty() )
     {
-        name.Empty();
+        bool found = false;
 
-        // If the filter contains a ':' character, include the library name in the pattern
-        if( each_filter->GetPattern().Contains( ":" ) )
+        for( auto const& each_filter : aMatchers.m_footprint_filters )
         {
-            name = aItem.GetLibNickname().Lower() + ":";
+            const wxString& key = each_filter->GetPattern().Contains( ":" ) ?
+                                          aItem.GetFilterLibId() : aItem.GetFilterName();
+
+            if( each_filter->Find( key ) != EDA_PATTERN_NOT_FOUND )
+            {
+                found = true;
+                break;
+            }
         }
 
-        name += aItem.GetFootprintName().Lower();
+        if( !found )
+            return false;
+    }
 
-        if( each_filter->Find( name ) != EDA_PATTERN_NOT_FOUND )
-        {
-            return true;
-        }
+    if( ( m_filter_type & FILTERING_BY_NAME ) && !m_filter_pattern.IsEmpty() )
+    {
+        const wxString& key = m_filter_pattern.Contains( ":" ) ?
+                                      aItem.GetFilterLibId() : aItem.GetFilterName();
+
+        if( aMatchers.m_filter.Find( key ) == EDA_PATTERN_NOT_FOUND )
+            return false;
     }
 
-    return false;
+    return true;
 }
 
 
-bool FOOTPRINT_FILTER_IT::PinCountMatch( FOOTPRINT_INFO& aItem )
+void FOOTPRINT_FILTER::updateMatches()
 {
-    return m_filter->m_pin_count >= 0 &&
-        (unsigned) m_filter->m_pin_count == aItem.GetUniquePadCount();
+    if( m_matches_valid && m_matches.size() == m_list->GetCount() )
+        return;
+
+    size_t count = m_list->GetCount();
+    size_t chunkCount = std::max<size_t>( 1, THREAD_POOL::GetPool().GetThreadCount() * 4 );
+    size_t chunkSize = ( count + chunkCount - 1 ) / chunkCount;
+
+    m_matches.assign( count, 0 );
+
+    // Each chunk compiles its own patterns, the regular expressions being stateful
+    THREAD_POOL::GetPool().ParallelFor( ( count + chunkSize - 1 ) / chunkSize,
+            [&]( size_t aChunk )
+            {
+                MATCHERS matchers;
+                buildMatchers( matchers );
+
+                size_t end = std::min( count, ( aChunk + 1 ) * chunkSize );
+
+                for( size_t ii = aChunk * chunkSize; ii < end; ++ii )
+                    m_matches[ii] = match( m_list->GetItem( ii ), matchers );
+            }, 1 );
+
+    m_matches_valid = true;
 }
 
 
@@ -164,7 +175,8 @@ FOOTPRINT_FILTER::FOOTPRINT_FILTER( FOOTPRINT_LIST& aList ) : FOOTPRINT_FILTER()
 
 
 FOOTPRINT_FILTER::FOOTPRINT_FILTER()
-        : m_list( nullptr ), m_pin_count( -1 ), m_filter_type( UNFILTERED_FP_LIST )
+        : m_list( nullptr ), m_pin_count( -1 ), m_filter_type( UNFILTERED_FP_LIST ),
+          m_matches_valid( false )
 {
 }
 
@@ -172,12 +184,14 @@ FOOTPRINT_FILTER::FOOTPRINT_FILTER()
 void FOOTPRINT_FILTER::SetList( FOOTPRINT_LIST& aList )
 {
     m_list = &aList;
+    m_matches_valid = false;
 }
 
 
 void FOOTPRINT_FILTER::ClearFilters()
 {
     m_filter_type = UNFILTERED_FP_LIST;
+    m_matches_valid = false;
 }
 
 
@@ -185,6 +199,7 @@ void FOOTPRINT_FILTER::FilterByLibrary( wxString const& aLibName )
 {
     m_lib_name = aLibName;
     m_filter_type |= FILTERING_BY_LIBRARY;
+    m_matches_valid = false;
 }
 
 
@@ -192,28 +207,27 @@ void FOOTPRINT_FILTER::FilterByPinCount( int aPinCount )
 {
     m_pin_count = aPinCount;
     m_filter_type |= FILTERING_BY_PIN_COUNT;
+    m_matches_valid = false;
 }
 
 
 void FOOTPRINT_FILTER::FilterByFootprintFilters( wxArrayString const& aFilters )
 {
-    m_footprint_filters.clear();
+    m_footprint_filters.Clear();
 
     for( auto const& each_pattern : aFilters )
-    {
-        m_footprint_filters.push_back( std::make_unique<EDA_PATTERN_MATCH_WILDCARD_EXPLICIT>() );
-        m_footprint_filters.back()->SetPattern( each_pattern.Lower() );
-    }
+        m_footprint_filters.Add( each_pattern.Lower() );
 
     m_filter_type |= FILTERING_BY_COMPONENT_KEYWORD;
+    m_matches_valid = false;
 }
 
 
 void FOOTPRINT_FILTER::FilterByPattern( wxString const& aPattern )
 {
     m_filter_pattern = aPattern;
-    m_filter.SetPattern( aPattern.Lower() );
     m_filter_type |= FILTERING_BY_NAME;
+    m_matches_valid = false;
 }
 
 
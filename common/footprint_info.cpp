@@ -76,7 +76,7 @@ FOOTPRINT_INFO* FOOTPRINT_LIST::GetModuleInfo( const wxString& aFootprintName )
 
 bool FOOTPRINT_INFO::InLibrary( const wxString& aLibrary ) const
 {
-    return aLibrary == m_nickname;
+    return aLibrary == m_nickname.Get();
 }
 
 
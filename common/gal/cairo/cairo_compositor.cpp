@@ -29,8 +29,11 @@
  */
 
 #include <gal/cairo/cairo_compositor.h>
+#include <thread_pool.h>
 #include <wx/log.h>
 
+#include <algorithm>
+
 using namespace KIGFX;
 
 CAIRO_COMPOSITOR::CAIRO_COMPOSITOR( cairo_t** aMainContext ) :
@@ -41,6 +44,9 @@ CAIRO_COMPOSITOR::CAIRO_COMPOSITOR( cairo_t** aMainContext ) :
     cairo_matrix_init_identity( &m_matrix );
     m_stride = 0;
     m_bufferSize = 0;
+    m_clipped = false;
+    m_clipX = m_clipY = 0;
+    m_clipWidth = m_clipHeight = 0;
 }
 
 
@@ -137,12 +143,122 @@ void CAIRO_COMPOSITOR::SetBuffer( unsigned int aBufferHandle )
     cairo_set_matrix( *m_currentContext, &m_matrix );
 }
 
+void CAIRO_COMPOSITOR::SetClipRect( int aX, int aY, int aWidth, int aHeight )
+{
+    // Keep the rectangle inside the buffers
+    int x0 = std::max( aX, 0 );
+    int y0 = std::max( aY, 0 );
+    int x1 = std::min( aX + aWidth, (int) m_width );
+    int y1 = std::min( aY + aHeight, (int) m_height );
+
+    m_clipX      = x0;
+    m_clipY      = y0;
+    m_clipWidth  = std::max( x1 - x0, 0 );
+    m_clipHeight = std::max( y1 - y0, 0 );
+    m_clipped    = true;
+
+    for( const CAIRO_BUFFER& buffer : m_buffers )
+    {
+        cairo_t* context = buffer.context;
+
+        // cairo_clip() consumes the current path, so it has to be restored afterwards
+        cairo_matrix_t matrix;
+        cairo_get_matrix( context, &matrix );
+        cairo_path_t* path = cairo_copy_path( context );
+
+        cairo_new_path( context );
+        cairo_identity_matrix( context );
+        cairo_reset_clip( context );
+        cairo_rectangle( context, m_clipX, m_clipY, m_clipWidth, m_clipHeight );
+        cairo_clip( context );
+
+        cairo_set_matrix( context, &matrix );
+        cairo_append_path( context, path );
+        cairo_path_destroy( path );
+    }
+}
+
+
+void CAIRO_COMPOSITOR::ResetClip()
+{
+    for( const CAIRO_BUFFER& buffer : m_buffers )
+        cairo_reset_clip( buffer.context );
+
+    m_clipped = false;
+}
+
+
+void CAIRO_COMPOSITOR::DrawBands( const std::function<void( cairo_t* aContext )>& aDraw )
+{
+    // Bands lower than this are not worth the setup of their context
+    const int MIN_BAND_HEIGHT = 32;
+
+    int top = m_clipped ? m_clipY : 0;
+    int height = m_clipped ? m_clipHeight : (int) m_height;
+
+    if( height <= 0 )
+        return;
+
+    THREAD_POOL& pool = THREAD_POOL::GetPool();
+    size_t bandCount = std::min<size_t>( pool.GetThreadCount(), height / MIN_BAND_HEIGHT );
+    bandCount = std::max<size_t>( bandCount, 1 );
+
+    const CAIRO_BUFFER& buffer = m_buffers[m_current];
+    unsigned char* bitmap = (unsigned char*) buffer.bitmap.get();
+
+    // The bands write directly to the pixels of the buffer
+    cairo_surface_flush( buffer.surface );
+
+    pool.ParallelFor( bandCount, [&]( size_t aBand )
+            {
+                int y0 = top + height * aBand / bandCount;
+                int y1 = top + height * ( aBand + 1 ) / bandCount;
+
+                cairo_surface_t* surface = cairo_image_surface_create_for_data(
+                                                        bitmap + y0 * m_stride,
+                                                        CAIRO_FORMAT_ARGB32, m_width,
+                                                        y1 - y0, m_stride );
+
+                // Keep the coordinates of the whole buffer
+                cairo_surface_set_device_offset( surface, 0.0, -y0 );
+
+                cairo_t* context = cairo_create( surface );
+                cairo_set_antialias( context, m_currentAntialiasingMode );
+
+                if( m_clipped )
+                {
+                    cairo_rectangle( context, m_clipX, m_clipY, m_clipWidth, m_clipHeight );
+                    cairo_clip( context );
+                }
+
+                aDraw( context );
+
+                cairo_destroy( context );
+                cairo_surface_flush( surface );
+                cairo_surface_destroy( surface );
+            }, 1 );
+
+    cairo_surface_mark_dirty( buffer.surface );
+}
+
+
 void CAIRO_COMPOSITOR::Begin()
 {
 }
 
 void CAIRO_COMPOSITOR::ClearBuffer( const COLOR4D& aColor )
 {
+    if( m_clipped )
+    {
+        // Clear only the rows of the clip rectangle, the rest of the buffer is kept
+        unsigned char* bitmap = (unsigned char*) m_buffers[m_current].bitmap.get();
+
+        for( int y = m_clipY; y < m_clipY + m_clipHeight; ++y )
+            memset( bitmap + y * m_stride + m_clipX * 4, 0x00, m_clipWidth * 4 );
+
+        return;
+    }
+
     // Clear the pixel storage
     memset( m_buffers[m_current].bitmap.get(), 0x00, m_bufferSize * sizeof(int) );
 }
@@ -180,4 +296,5 @@ void CAIRO_COMPOSITOR::clean()
     }
 
     m_buffers.clear();
+    m_clipped = false;
 }
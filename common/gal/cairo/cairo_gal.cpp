@@ -34,6 +34,7 @@
 #include <gal/definitions.h>
 #include <geometry/shape_poly_set.h>
 #include <bitmap_base.h>
+#include <advanced_config.h>
 
 #include <limits>
 
@@ -761,91 +762,133 @@ void CAIRO_GAL_BASE::EndGroup()
 
 
 void CAIRO_GAL_BASE::DrawGroup( int aGroupNumber )
+{
+    storePath();
+
+    auto group = groups.find( aGroupNumber );
+
+    if( group == groups.end() )
+        return;
+
+    GROUP_STATE state = { isFillEnabled, isStrokeEnabled, fillColor, strokeColor };
+
+    drawGroup( currentContext, group->second, state );
+
+    isFillEnabled = state.isFillEnabled;
+    isStrokeEnabled = state.isStrokeEnabled;
+    fillColor = state.fillColor;
+    strokeColor = state.strokeColor;
+}
+
+
+void CAIRO_GAL_BASE::drawGroup( cairo_t* aContext, const GROUP& aGroup,
+                                GROUP_STATE& aState ) const
 {
     // This method implements a small Virtual Machine - all stored commands
     // are executed; nested calling is also possible
 
-    storePath();
-
-    for( GROUP::iterator it = groups[aGroupNumber].begin();
-         it != groups[aGroupNumber].end(); ++it )
+    for( GROUP::const_iterator it = aGroup.begin(); it != aGroup.end(); ++it )
     {
         switch( it->command )
         {
         case CMD_SET_FILL:
-            isFillEnabled = it->argument.boolArg;
+            aState.isFillEnabled = it->argument.boolArg;
             break;
 
         case CMD_SET_STROKE:
-            isStrokeEnabled = it->argument.boolArg;
+            aState.isStrokeEnabled = it->argument.boolArg;
             break;
 
         case CMD_SET_FILLCOLOR:
-            fillColor = COLOR4D( it->argument.dblArg[0], it->argument.dblArg[1], it->argument.dblArg[2],
-                                 it->argument.dblArg[3] );
+            aState.fillColor = COLOR4D( it->argument.dblArg[0], it->argument.dblArg[1],
+                                        it->argument.dblArg[2], it->argument.dblArg[3] );
             break;
 
         case CMD_SET_STROKECOLOR:
-            strokeColor = COLOR4D( it->argument.dblArg[0], it->argument.dblArg[1], it->argument.dblArg[2],
-                                   it->argument.dblArg[3] );
+            aState.strokeColor = COLOR4D( it->argument.dblArg[0], it->argument.dblArg[1],
+                                          it->argument.dblArg[2], it->argument.dblArg[3] );
             break;
 
-        case CMD_SET_LINE_WIDTH:
+        case CMD_CALL_GROUP:
             {
-                // Make lines appear at least 1 pixel wide, no matter of zoom
-                double x = 1.0, y = 1.0;
-                cairo_device_to_user_distance( currentContext, &x, &y );
-                double minWidth = std::min( fabs( x ), fabs( y ) );
-                cairo_set_line_width( currentContext, std::max( it->argument.dblArg[0], minWidth ) );
+                auto group = groups.find( it->argument.intArg );
+
+                if( group != groups.end() )
+                    drawGroup( aContext, group->second, aState );
             }
             break;
 
+        default:
+            // Without a context, only the drawing attributes are followed
+            if( aContext )
+                drawGroupElement( aContext, *it, aState );
 
-        case CMD_STROKE_PATH:
-            cairo_set_source_rgba( currentContext, strokeColor.r, strokeColor.g, strokeColor.b, strokeColor.a );
-            cairo_append_path( currentContext, it->cairoPath );
-            cairo_stroke( currentContext );
             break;
+        }
+    }
+}
 
-        case CMD_FILL_PATH:
-            cairo_set_source_rgba( currentContext, fillColor.r, fillColor.g, fillColor.b, strokeColor.a );
-            cairo_append_path( currentContext, it->cairoPath );
-            cairo_fill( currentContext );
-            break;
 
-            /*
-        case CMD_TRANSFORM:
-            cairo_matrix_t matrix;
-            cairo_matrix_init( &matrix, it->argument.dblArg[0], it->argument.dblArg[1], it->argument.dblArg[2],
-                               it->argument.dblArg[3], it->argument.dblArg[4], it->argument.dblArg[5] );
-            cairo_transform( currentContext, &matrix );
-            break;
-            */
+void CAIRO_GAL_BASE::drawGroupElement( cairo_t* aContext, const GROUP_ELEMENT& aElement,
+                                       const GROUP_STATE& aState ) const
+{
+    switch( aElement.command )
+    {
+    case CMD_SET_LINE_WIDTH:
+        {
+            // Make lines appear at least 1 pixel wide, no matter of zoom
+            double x = 1.0, y = 1.0;
+            cairo_device_to_user_distance( aContext, &x, &y );
+            double minWidth = std::min( fabs( x ), fabs( y ) );
+            cairo_set_line_width( aContext, std::max( aElement.argument.dblArg[0], minWidth ) );
+        }
+        break;
 
-        case CMD_ROTATE:
-            cairo_rotate( currentContext, it->argument.dblArg[0] );
-            break;
+    case CMD_STROKE_PATH:
+        cairo_set_source_rgba( aContext, aState.strokeColor.r, aState.strokeColor.g,
+                               aState.strokeColor.b, aState.strokeColor.a );
+        cairo_append_path( aContext, aElement.cairoPath );
+        cairo_stroke( aContext );
+        break;
 
-        case CMD_TRANSLATE:
-            cairo_translate( currentContext, it->argument.dblArg[0], it->argument.dblArg[1] );
-            break;
+    case CMD_FILL_PATH:
+        cairo_set_source_rgba( aContext, aState.fillColor.r, aState.fillColor.g,
+                               aState.fillColor.b, aState.strokeColor.a );
+        cairo_append_path( aContext, aElement.cairoPath );
+        cairo_fill( aContext );
+        break;
 
-        case CMD_SCALE:
-            cairo_scale( currentContext, it->argument.dblArg[0], it->argument.dblArg[1] );
-            break;
+        /*
+    case CMD_TRANSFORM:
+        cairo_matrix_t matrix;
+        cairo_matrix_init( &matrix, aElement.argument.dblArg[0], aElement.argument.dblArg[1], aElement.argument.dblArg[2],
+                           aElement.argument.dblArg[3], aElement.argument.dblArg[4], aElement.argument.dblArg[5] );
+        cairo_transform( aContext, &matrix );
+        break;
+        */
 
-        case CMD_SAVE:
-            cairo_save( currentContext );
-            break;
+    case CMD_ROTATE:
+        cairo_rotate( aContext, aElement.argument.dblArg[0] );
+        break;
 
-        case CMD_RESTORE:
-            cairo_restore( currentContext );
-            break;
+    case CMD_TRANSLATE:
+        cairo_translate( aContext, aElement.argument.dblArg[0], aElement.argument.dblArg[1] );
+        break;
 
-        case CMD_CALL_GROUP:
-            DrawGroup( it->argument.intArg );
-            break;
-        }
+    case CMD_SCALE:
+        cairo_scale( aContext, aElement.argument.dblArg[0], aElement.argument.dblArg[1] );
+        break;
+
+    case CMD_SAVE:
+        cairo_save( aContext );
+        break;
+
+    case CMD_RESTORE:
+        cairo_restore( aContext );
+        break;
+
+    default:
+        break;
     }
 }
 
@@ -1192,8 +1235,11 @@ CAIRO_GAL::CAIRO_GAL( GAL_DISPLAY_OPTIONS& aDisplayOptions,
     mainBuffer          = 0;
     overlayBuffer       = 0;
     validCompositor     = false;
+    emptyBuffers        = true;
     SetTarget( TARGET_NONCACHED );
 
+    parallelDrawing     = ADVANCED_CFG::GetCfg().m_parallelCairoDrawing;
+
     parentWindow  = aParent;
     mouseListener = aMouseListener;
     paintListener = aPaintListener;
@@ -1249,6 +1295,8 @@ void CAIRO_GAL::beginDrawing()
 
 void CAIRO_GAL::endDrawing()
 {
+    drawDeferredGroups();
+
     CAIRO_GAL_BASE::endDrawing();
 
     // Merge buffers on the screen
@@ -1366,6 +1414,10 @@ void CAIRO_GAL::SetTarget( RENDER_TARGET aTarget )
     if( isInitialized )
         storePath();
 
+    // The cached groups have to be drawn before the items of the other targets
+    if( aTarget != currentTarget )
+        drawDeferredGroups();
+
     switch( aTarget )
     {
     default:
@@ -1391,6 +1443,8 @@ RENDER_TARGET CAIRO_GAL::GetTarget() const
 
 void CAIRO_GAL::ClearTarget( RENDER_TARGET aTarget )
 {
+    drawDeferredGroups();
+
     // Save the current state
     unsigned int currentBuffer = compositor->GetBuffer();
 
@@ -1415,6 +1469,122 @@ void CAIRO_GAL::ClearTarget( RENDER_TARGET aTarget )
 }
 
 
+bool CAIRO_GAL::SetClipRect( const BOX2D& aRect )
+{
+    drawDeferredGroups();
+
+    // A new compositor has to be filled with a complete frame first
+    if( !validCompositor || emptyBuffers )
+    {
+        emptyBuffers = false;
+        return false;
+    }
+
+    VECTOR2D p0 = worldScreenMatrix * aRect.GetOrigin();
+    VECTOR2D p1 = worldScreenMatrix * aRect.GetEnd();
+
+    int x0 = std::floor( std::min( p0.x, p1.x ) );
+    int y0 = std::floor( std::min( p0.y, p1.y ) );
+    int x1 = std::ceil( std::max( p0.x, p1.x ) );
+    int y1 = std::ceil( std::max( p0.y, p1.y ) );
+
+    compositor->SetClipRect( x0, y0, x1 - x0, y1 - y0 );
+
+    return true;
+}
+
+
+void CAIRO_GAL::ResetClipRect()
+{
+    // The deferred groups are restricted to the clip rectangle as well
+    drawDeferredGroups();
+
+    if( validCompositor )
+        compositor->ResetClip();
+}
+
+
+void CAIRO_GAL::DrawGroup( int aGroupNumber )
+{
+    // Only the groups of the cached target are deferred, the other targets need them drawn
+    // in order with their immediately drawn items
+    if( !parallelDrawing || !validCompositor || currentTarget != TARGET_CACHED || isGrouping )
+    {
+        CAIRO_GAL_BASE::DrawGroup( aGroupNumber );
+        return;
+    }
+
+    storePath();
+
+    auto group = groups.find( aGroupNumber );
+
+    if( group == groups.end() )
+        return;
+
+    DEFERRED_GROUP deferred;
+    deferred.group = &group->second;
+    deferred.state = { isFillEnabled, isStrokeEnabled, fillColor, strokeColor };
+    cairo_get_matrix( currentContext, &deferred.matrix );
+    deferred.op = cairo_get_operator( currentContext );
+    deferredGroups.push_back( deferred );
+
+    // Follow the attributes set by the group, as if it was drawn now
+    GROUP_STATE state = deferred.state;
+    drawGroup( nullptr, group->second, state );
+
+    isFillEnabled = state.isFillEnabled;
+    isStrokeEnabled = state.isStrokeEnabled;
+    fillColor = state.fillColor;
+    strokeColor = state.strokeColor;
+}
+
+
+void CAIRO_GAL::ChangeGroupColor( int aGroupNumber, const COLOR4D& aNewColor )
+{
+    drawDeferredGroups();
+    CAIRO_GAL_BASE::ChangeGroupColor( aGroupNumber, aNewColor );
+}
+
+
+void CAIRO_GAL::DeleteGroup( int aGroupNumber )
+{
+    drawDeferredGroups();
+    CAIRO_GAL_BASE::DeleteGroup( aGroupNumber );
+}
+
+
+void CAIRO_GAL::drawDeferredGroups()
+{
+    if( deferredGroups.empty() )
+        return;
+
+    // The deferred groups did not touch the context, so it still has the line style
+    // the first of them would have been drawn with
+    double            width = cairo_get_line_width( currentContext );
+    cairo_line_cap_t  cap = cairo_get_line_cap( currentContext );
+    cairo_line_join_t join = cairo_get_line_join( currentContext );
+
+    // Every band runs through all the groups, Cairo skips the paths outside of its clip
+    compositor->DrawBands( [&]( cairo_t* aContext )
+            {
+                cairo_set_line_width( aContext, width );
+                cairo_set_line_cap( aContext, cap );
+                cairo_set_line_join( aContext, join );
+
+                for( const DEFERRED_GROUP& deferred : deferredGroups )
+                {
+                    GROUP_STATE state = deferred.state;
+
+                    cairo_set_matrix( aContext, &deferred.matrix );
+                    cairo_set_operator( aContext, deferred.op );
+                    drawGroup( aContext, *deferred.group, state );
+                }
+            } );
+
+    deferredGroups.clear();
+}
+
+
 void CAIRO_GAL::initSurface()
 {
     if( isInitialized )
@@ -1484,6 +1654,7 @@ void CAIRO_GAL::setCompositor()
     overlayBuffer = compositor->CreateBuffer();
 
     validCompositor = true;
+    emptyBuffers = true;
 }
 
 
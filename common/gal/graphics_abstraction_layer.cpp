@@ -75,7 +75,7 @@ GAL::GAL( GAL_DISPLAY_OPTIONS& aDisplayOptions ) :
     // Initialize text properties
     ResetTextAttributes();
 
-    strokeFont.LoadNewStrokeFont( newstroke_font, newstroke_font_bufsize );
+    strokeFont.LoadNewStrokeFont();
 
     // subscribe for settings updates
     observerLink = options.Subscribe( this );
@@ -34,8 +34,8 @@
 #include <gal/opengl/vertex_item.h>
 #include <gal/opengl/utils.h>
 
-#include <list>
 #include <cassert>
+#include <iterator>
 
 #ifdef __WXDEBUG__
 #include <wx/log.h>
@@ -48,7 +48,7 @@ CACHED_CONTAINER::CACHED_CONTAINER( unsigned int aSize ) :
     VERTEX_CONTAINER( aSize ), m_item( NULL ), m_chunkSize( 0 ), m_chunkOffset( 0 ), m_maxIndex( 0 )
 {
     // In the beginning there is only free space
-    m_freeChunks.insert( std::make_pair( aSize, 0 ) );
+    resetFreeChunks( 0, aSize );
 }
 
 
@@ -83,7 +83,6 @@ void CACHED_CONTAINER::FinishItem()
 
         // Add the not used memory back to the pool
         addFreeChunk( itemOffset + itemSize, m_chunkSize - itemSize );
-        // mergeFreeChunks();   // veery slow and buggy
 
         m_maxIndex = std::max( itemOffset + itemSize, m_maxIndex );
     }
@@ -202,8 +201,7 @@ void CACHED_CONTAINER::Clear()
     m_items.clear();
 
     // Now there is only free space left
-    m_freeChunks.clear();
-    m_freeChunks.insert( std::make_pair( m_freeSpace, 0 ) );
+    resetFreeChunks( 0, m_freeSpace );
 }
 
 
@@ -218,6 +216,24 @@ bool CACHED_CONTAINER::reallocate( unsigned int aSize )
     wxLogDebug( wxT( "Resize %p from %d to %d" ), m_item, itemSize, aSize );
 #endif
 
+    // Grow the chunk in place if it is followed by enough free space, so nothing is copied
+    if( itemSize > 0 )
+    {
+        FREE_CHUNK_OFFSETS::iterator next = m_freeChunkOffsets.find( m_chunkOffset + m_chunkSize );
+
+        if( next != m_freeChunkOffsets.end()
+                && m_chunkSize + getChunkSize( *next->second ) >= aSize )
+        {
+            unsigned int nextSize = getChunkSize( *next->second );
+
+            removeFreeChunk( next->second );
+            m_freeSpace -= nextSize;
+            m_chunkSize += nextSize;
+
+            return true;
+        }
+    }
+
     // Find a free space chunk >= aSize
     FREE_CHUNK_MAP::iterator newChunk = m_freeChunks.lower_bound( aSize );
 
@@ -252,6 +268,11 @@ bool CACHED_CONTAINER::reallocate( unsigned int aSize )
     assert( newChunkSize >= aSize );
     assert( newChunkOffset < m_currentSize );
 
+    // Remove the new allocated chunk from the free space pool, before the previous chunk is
+    // returned to it and possibly merged with its neighbours
+    removeFreeChunk( newChunk );
+    m_freeSpace -= newChunkSize;
+
     // Check if the item was previously stored in the container
     if( itemSize > 0 )
     {
@@ -266,10 +287,6 @@ bool CACHED_CONTAINER::reallocate( unsigned int aSize )
         addFreeChunk( m_chunkOffset, m_chunkSize );
     }
 
-    // Remove the new allocated chunk from the free space pool
-    m_freeChunks.erase( newChunk );
-    m_freeSpace -= newChunkSize;
-
     m_chunkSize = newChunkSize;
     m_chunkOffset = newChunkOffset;
 
@@ -313,72 +330,70 @@ void CACHED_CONTAINER::defragment( VERTEX* aTarget )
 }
 
 
-void CACHED_CONTAINER::mergeFreeChunks()
+void CACHED_CONTAINER::addFreeChunk( unsigned int aOffset, unsigned int aSize )
 {
-    if( m_freeChunks.size() <= 1 ) // There are no chunks that can be merged
-        return;
+    assert( aOffset + aSize <= m_currentSize );
+    assert( aSize > 0 );
 
-#ifdef __WXDEBUG__
-    PROF_COUNTER totalTime;
-#endif /* __WXDEBUG__ */
+    insertFreeChunk( aOffset, aSize );
+    m_freeSpace += aSize;
+}
 
-    // Reversed free chunks map - this one stores chunk size with its offset as the key
-    std::list<CHUNK> freeChunks;
 
-    FREE_CHUNK_MAP::const_iterator it, it_end;
+void CACHED_CONTAINER::resetFreeChunks( unsigned int aOffset, unsigned int aSize )
+{
+    m_freeChunks.clear();
+    m_freeChunkOffsets.clear();
 
-    for( it = m_freeChunks.begin(), it_end = m_freeChunks.end(); it != it_end; ++it )
+    if( aSize > 0 )
     {
-        freeChunks.push_back( std::make_pair( it->second, it->first ) );
+        FREE_CHUNK_MAP::iterator chunk = m_freeChunks.insert( std::make_pair( aSize, aOffset ) );
+        m_freeChunkOffsets.insert( std::make_pair( aOffset, chunk ) );
     }
+}
 
-    m_freeChunks.clear();
-    freeChunks.sort();
 
-    std::list<CHUNK>::const_iterator itf, itf_end;
-    unsigned int offset = freeChunks.front().first;
-    unsigned int size   = freeChunks.front().second;
-    freeChunks.pop_front();
+void CACHED_CONTAINER::insertFreeChunk( unsigned int aOffset, unsigned int aSize )
+{
+    FREE_CHUNK_OFFSETS::iterator next = m_freeChunkOffsets.lower_bound( aOffset );
 
-    for( itf = freeChunks.begin(), itf_end = freeChunks.end(); itf != itf_end; ++itf )
+    assert( next == m_freeChunkOffsets.end() || next->first >= aOffset + aSize );
+
+    // Merge with the chunk that directly follows
+    if( next != m_freeChunkOffsets.end() && next->first == aOffset + aSize )
     {
-        if( itf->first == offset + size )
-        {
-            // These chunks can be merged, so just increase the current chunk size and go on
-            size += itf->second;
-        }
-        else
-        {
-            // These chunks cannot be merged
-            // So store the previous one
-            m_freeChunks.insert( std::make_pair( size, offset ) );
-            // and let's check the next chunk
-            offset = itf->first;
-            size   = itf->second;
+        aSize += getChunkSize( *next->second );
+        removeFreeChunk( next->second );
+        next = m_freeChunkOffsets.lower_bound( aOffset );
+    }
 
+    // Merge with the chunk that directly precedes
+    if( next != m_freeChunkOffsets.begin() )
+    {
+        FREE_CHUNK_OFFSETS::iterator prev = std::prev( next );
+        unsigned int prevSize = getChunkSize( *prev->second );
+
+        assert( prev->first + prevSize <= aOffset );
+
+        if( prev->first + prevSize == aOffset )
+        {
+            aOffset = prev->first;
+            aSize += prevSize;
+            removeFreeChunk( prev->second );
         }
     }
 
-    // Add the last one
-    m_freeChunks.insert( std::make_pair( size, offset ) );
-
-#ifdef __WXDEBUG__
-    totalTime.Stop();
-    wxLogDebug( "Merged free chunks / %.1f ms", totalTime.msecs() );
-#endif /* __WXDEBUG__ */
-#if CACHED_CONTAINER_TEST > 0
-    test();
-#endif
+    FREE_CHUNK_MAP::iterator chunk = m_freeChunks.insert( std::make_pair( aSize, aOffset ) );
+    m_freeChunkOffsets.insert( std::make_pair( aOffset, chunk ) );
 }
 
 
-void CACHED_CONTAINER::addFreeChunk( unsigned int aOffset, unsigned int aSize )
+void CACHED_CONTAINER::removeFreeChunk( FREE_CHUNK_MAP::iterator aChunk )
 {
-    assert( aOffset + aSize <= m_currentSize );
-    assert( aSize > 0 );
+    assert( aChunk != m_freeChunks.end() );
 
-    m_freeChunks.insert( std::make_pair( aSize, aOffset ) );
-    m_freeSpace += aSize;
+    m_freeChunkOffsets.erase( getChunkOffset( *aChunk ) );
+    m_freeChunks.erase( aChunk );
 }
 
 
@@ -435,6 +450,18 @@ void CACHED_CONTAINER::test()
 
     assert( freeSpace == m_freeSpace );
 
+    // Both free chunk maps describe the same chunks, and adjacent chunks are always merged
+    assert( m_freeChunkOffsets.size() == m_freeChunks.size() );
+
+    unsigned int freeEnd = 0;
+
+    for( const auto& chunk : m_freeChunkOffsets )
+    {
+        assert( getChunkOffset( *chunk.second ) == chunk.first );
+        assert( chunk.first == 0 || chunk.first > freeEnd );
+        freeEnd = chunk.first + getChunkSize( *chunk.second );
+    }
+
     // Used space check
     unsigned int used_space = 0;
     ITEMS::iterator itr;
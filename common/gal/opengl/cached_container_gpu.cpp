@@ -190,8 +190,7 @@ bool CACHED_CONTAINER_GPU::defragmentResize( unsigned int aNewSize )
     m_currentSize = aNewSize;
 
     // Now there is only one big chunk of free memory
-    m_freeChunks.clear();
-    m_freeChunks.insert( std::make_pair( m_freeSpace, m_currentSize - m_freeSpace ) );
+    resetFreeChunks( m_currentSize - m_freeSpace, m_freeSpace );
 
     return true;
 }
@@ -256,8 +255,7 @@ bool CACHED_CONTAINER_GPU::defragmentResizeMemcpy( unsigned int aNewSize )
     m_currentSize = aNewSize;
 
     // Now there is only one big chunk of free memory
-    m_freeChunks.clear();
-    m_freeChunks.insert( std::make_pair( m_freeSpace, m_currentSize - m_freeSpace ) );
+    resetFreeChunks( m_currentSize - m_freeSpace, m_freeSpace );
 
     return true;
 }
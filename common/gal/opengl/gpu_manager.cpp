@@ -29,6 +29,7 @@
 #include <gal/opengl/shader.h>
 #include <gal/opengl/utils.h>
 
+#include <algorithm>
 #include <typeinfo>
 #include <confirm.h>
 
@@ -49,7 +50,8 @@ GPU_MANAGER* GPU_MANAGER::MakeManager( VERTEX_CONTAINER* aContainer )
 
 
 GPU_MANAGER::GPU_MANAGER( VERTEX_CONTAINER* aContainer ) :
-    m_isDrawing( false ), m_container( aContainer ), m_shader( NULL ), m_shaderAttrib( 0 ), m_enableDepthTest( true )
+    m_isDrawing( false ), m_container( aContainer ), m_shader( NULL ), m_shaderAttrib( 0 ), m_enableDepthTest( true ),
+    m_drawCalls( 0 ), m_drawnVertices( 0 )
 {
 }
 
@@ -105,6 +107,8 @@ void GPU_CACHED_MANAGER::BeginDrawing()
     if( m_container->IsDirty() )
         resizeIndices( m_container->GetSize() );
 
+    resetStats();
+
     // Number of vertices to be drawn in the EndDrawing()
     m_indicesSize = 0;
     // Set the indices pointer to the beginning of the indices-to-draw buffer
@@ -182,6 +186,9 @@ void GPU_CACHED_MANAGER::EndDrawing()
 
     glDrawElements( GL_TRIANGLES, m_indicesSize, GL_UNSIGNED_INT, 0 );
 
+    m_drawCalls++;
+    m_drawnVertices += m_indicesSize;
+
 #ifdef __WXDEBUG__
     wxLogTrace( "GAL_PROFILE", wxT( "Cached manager size: %d" ), m_indicesSize );
 #endif /* __WXDEBUG__ */
@@ -210,6 +217,13 @@ void GPU_CACHED_MANAGER::EndDrawing()
 }
 
 
+size_t GPU_CACHED_MANAGER::GetGpuMemory() const
+{
+    // The vertex buffer is sized to the container, the indices buffer to the last drawn frame
+    return (size_t) m_container->GetSize() * VERTEX_SIZE + (size_t) m_indicesSize * sizeof(GLuint);
+}
+
+
 void GPU_CACHED_MANAGER::resizeIndices( unsigned int aNewSize )
 {
     if( aNewSize > m_indicesCapacity )
@@ -222,14 +236,25 @@ void GPU_CACHED_MANAGER::resizeIndices( unsigned int aNewSize )
 
 // Noncached manager
 GPU_NONCACHED_MANAGER::GPU_NONCACHED_MANAGER( VERTEX_CONTAINER* aContainer ) :
-    GPU_MANAGER( aContainer )
+    GPU_MANAGER( aContainer ), m_vertexBuffer( 0 ), m_vertexBufferCapacity( 0 )
 {
 }
 
 
+GPU_NONCACHED_MANAGER::~GPU_NONCACHED_MANAGER()
+{
+    if( m_vertexBuffer )
+    {
+        glBindBuffer( GL_ARRAY_BUFFER, 0 );
+        glDeleteBuffers( 1, &m_vertexBuffer );
+    }
+}
+
+
 void GPU_NONCACHED_MANAGER::BeginDrawing()
 {
     // Nothing has to be prepared
+    resetStats();
 }
 
 
@@ -255,9 +280,7 @@ void GPU_NONCACHED_MANAGER::EndDrawing()
     if( m_container->GetSize() == 0 )
         return;
 
-    VERTEX*  vertices       = m_container->GetAllVertices();
-    GLfloat* coordinates    = (GLfloat*) ( vertices );
-    GLubyte* colors         = (GLubyte*) ( vertices ) + COLOR_OFFSET;
+    uploadVertices( m_container->GetAllVertices(), m_container->GetSize() );
 
     if( m_enableDepthTest )
         glEnable( GL_DEPTH_TEST );
@@ -268,21 +291,24 @@ void GPU_NONCACHED_MANAGER::EndDrawing()
     glEnableClientState( GL_VERTEX_ARRAY );
     glEnableClientState( GL_COLOR_ARRAY );
 
-    glVertexPointer( COORD_STRIDE, GL_FLOAT, VERTEX_SIZE, coordinates );
-    glColorPointer( COLOR_STRIDE, GL_UNSIGNED_BYTE, VERTEX_SIZE, colors );
+    glVertexPointer( COORD_STRIDE, GL_FLOAT, VERTEX_SIZE, (GLvoid*) COORD_OFFSET );
+    glColorPointer( COLOR_STRIDE, GL_UNSIGNED_BYTE, VERTEX_SIZE, (GLvoid*) COLOR_OFFSET );
 
     if( m_shader != NULL )    // Use shader if applicable
     {
-        GLfloat* shaders = (GLfloat*) ( vertices ) + SHADER_OFFSET / sizeof(GLfloat);
-
         m_shader->Use();
         glEnableVertexAttribArray( m_shaderAttrib );
         glVertexAttribPointer( m_shaderAttrib, SHADER_STRIDE, GL_FLOAT, GL_FALSE,
-                               VERTEX_SIZE, shaders );
+                               VERTEX_SIZE, (GLvoid*) SHADER_OFFSET );
     }
 
     glDrawArrays( GL_TRIANGLES, 0, m_container->GetSize() );
 
+    m_drawCalls++;
+    m_drawnVertices += m_container->GetSize();
+
+    glBindBuffer( GL_ARRAY_BUFFER, 0 );
+
 #ifdef __WXDEBUG__
     wxLogTrace( "GAL_PROFILE", wxT( "Noncached manager size: %d" ), m_container->GetSize() );
 #endif /* __WXDEBUG__ */
@@ -306,6 +332,35 @@ void GPU_NONCACHED_MANAGER::EndDrawing()
 #endif /* __WXDEBUG__ */
 }
 
+
+size_t GPU_NONCACHED_MANAGER::GetGpuMemory() const
+{
+    return (size_t) m_vertexBufferCapacity * VERTEX_SIZE;
+}
+
+
+void GPU_NONCACHED_MANAGER::uploadVertices( const VERTEX* aVertices, unsigned int aSize )
+{
+    if( !m_vertexBuffer )
+    {
+        glGenBuffers( 1, &m_vertexBuffer );
+        checkGlError( "generating streaming vertices buffer" );
+    }
+
+    glBindBuffer( GL_ARRAY_BUFFER, m_vertexBuffer );
+
+    // The buffer storage is replaced (orphaned) before writing, so the driver does not have to
+    // wait until the previous frame drawn from the buffer is finished.  The storage grows to
+    // the largest frame, so the driver can recycle the released storage of the same size.
+    if( aSize > m_vertexBufferCapacity )
+        m_vertexBufferCapacity = std::max( aSize, 2 * m_vertexBufferCapacity );
+
+    glBufferData( GL_ARRAY_BUFFER, m_vertexBufferCapacity * VERTEX_SIZE, NULL, GL_STREAM_DRAW );
+    glBufferSubData( GL_ARRAY_BUFFER, 0, aSize * VERTEX_SIZE, aVertices );
+    checkGlError( "transferring streaming vertices" );
+}
+
+
 void GPU_MANAGER::EnableDepthTest( bool aEnabled )
 {
     m_enableDepthTest = aEnabled;
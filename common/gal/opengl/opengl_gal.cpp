@@ -28,6 +28,7 @@
 
 #include <gal/opengl/opengl_gal.h>
 #include <gal/opengl/utils.h>
+#include <gal/opengl/gpu_manager.h>
 #include <gal/definitions.h>
 #include <gl_context_mgr.h>
 #include <geometry/shape_poly_set.h>
@@ -647,56 +648,36 @@ void OPENGL_GAL::DrawSegment( const VECTOR2D& aStartPoint, const VECTOR2D& aEndP
 
 void OPENGL_GAL::DrawCircle( const VECTOR2D& aCenterPoint, double aRadius )
 {
+    /* Draw a triangle that contains the circle, then shade it leaving only the circle.
+     *  The triangle vertices are given indices of the triangle's corners (if you want to
+     *  understand more, check the vertex shader source [shader.vert]) and, for the stroked
+     *  circle, the line width. Shader uses this coordinates to determine if fragments are
+     *  inside the circle or not.
+     *  Does the calculations in the vertex shader now (pixel alignment)
+     *       v2
+     *       /\
+     *      //\\
+     *  v0 /_\/_\ v1
+     *
+     *  Both the filled and the stroked triangles are stored in a single allocation.
+     */
+    if( !isFillEnabled && !isStrokeEnabled )
+        return;
+
+    currentManager->Reserve( ( isFillEnabled ? 3 : 0 ) + ( isStrokeEnabled ? 3 : 0 ) );
+
     if( isFillEnabled )
     {
-        currentManager->Reserve( 3 );
         currentManager->Color( fillColor.r, fillColor.g, fillColor.b, fillColor.a );
-
-        /* Draw a triangle that contains the circle, then shade it leaving only the circle.
-         *  Parameters given to Shader() are indices of the triangle's vertices
-         *  (if you want to understand more, check the vertex shader source [shader.vert]).
-         *  Shader uses this coordinates to determine if fragments are inside the circle or not.
-         *  Does the calculations in the vertex shader now (pixel alignment)
-         *       v2
-         *       /\
-         *      //\\
-         *  v0 /_\/_\ v1
-         */
-        currentManager->Shader( SHADER_FILLED_CIRCLE, 1.0, aRadius );
-        currentManager->Vertex( aCenterPoint.x, aCenterPoint.y, layerDepth );
-
-        currentManager->Shader( SHADER_FILLED_CIRCLE, 2.0, aRadius );
-        currentManager->Vertex( aCenterPoint.x, aCenterPoint.y, layerDepth );
-
-        currentManager->Shader( SHADER_FILLED_CIRCLE, 3.0, aRadius );
-        currentManager->Vertex( aCenterPoint.x, aCenterPoint.y, layerDepth );
+        currentManager->Circle( aCenterPoint.x, aCenterPoint.y, layerDepth,
+                                SHADER_FILLED_CIRCLE, aRadius );
     }
+
     if( isStrokeEnabled )
     {
-        currentManager->Reserve( 3 );
         currentManager->Color( strokeColor.r, strokeColor.g, strokeColor.b, strokeColor.a );
-
-        /* Draw a triangle that contains the circle, then shade it leaving only the circle.
-         *  Parameters given to Shader() are indices of the triangle's vertices
-         *  (if you want to understand more, check the vertex shader source [shader.vert]).
-         *  and the line width. Shader uses this coordinates to determine if fragments are
-         *  inside the circle or not.
-         *       v2
-         *       /\
-         *      //\\
-         *  v0 /_\/_\ v1
-         */
-        currentManager->Shader( SHADER_STROKED_CIRCLE, 1.0, aRadius, lineWidth );
-        currentManager->Vertex( aCenterPoint.x,            // v0
-                                aCenterPoint.y, layerDepth );
-
-        currentManager->Shader( SHADER_STROKED_CIRCLE, 2.0, aRadius, lineWidth );
-        currentManager->Vertex( aCenterPoint.x,            // v1
-                                aCenterPoint.y, layerDepth );
-
-        currentManager->Shader( SHADER_STROKED_CIRCLE, 3.0, aRadius, lineWidth );
-        currentManager->Vertex( aCenterPoint.x, aCenterPoint.y,    // v2
-                                layerDepth );
+        currentManager->Circle( aCenterPoint.x, aCenterPoint.y, layerDepth,
+                                SHADER_STROKED_CIRCLE, aRadius, lineWidth );
     }
 }
 
@@ -1566,6 +1547,33 @@ RENDER_TARGET OPENGL_GAL::GetTarget() const
 }
 
 
+GAL::RENDER_STATS OPENGL_GAL::GetRenderStats() const
+{
+    RENDER_STATS stats = RENDER_STATS();
+
+    // The managers are created with the OpenGL context, on the first drawing
+    if( !isInitialized )
+        return stats;
+
+    const GPU_MANAGER* cached = cachedManager->GetGpuManager();
+    const GPU_MANAGER* nonCached = nonCachedManager->GetGpuManager();
+    const GPU_MANAGER* overlay = overlayManager->GetGpuManager();
+
+    stats.m_drawCalls = cached->GetDrawCalls() + nonCached->GetDrawCalls()
+                        + overlay->GetDrawCalls();
+    stats.m_drawnVertices = cached->GetDrawnVertices() + nonCached->GetDrawnVertices()
+                            + overlay->GetDrawnVertices();
+    stats.m_cachedVertices = cachedManager->GetContainer()->GetUsedSize();
+    stats.m_cachedCapacity = cachedManager->GetContainer()->GetSize();
+    stats.m_noncachedVertices = nonCached->GetDrawnVertices();
+    stats.m_overlayVertices = overlay->GetDrawnVertices();
+    stats.m_gpuMemory = cached->GetGpuMemory() + nonCached->GetGpuMemory()
+                        + overlay->GetGpuMemory();
+
+    return stats;
+}
+
+
 void OPENGL_GAL::ClearTarget( RENDER_TARGET aTarget )
 {
     // Save the current state
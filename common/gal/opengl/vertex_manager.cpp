@@ -154,6 +154,55 @@ bool VERTEX_MANAGER::Vertices( const VERTEX aVertices[], unsigned int aSize )
 }
 
 
+bool VERTEX_MANAGER::Circle( GLfloat aX, GLfloat aY, GLfloat aZ, GLfloat aShaderType,
+                             GLfloat aRadius, GLfloat aWidth )
+{
+    // flag to avoid hanging by calling DisplayError too many times:
+    static bool show_err = true;
+
+    VERTEX* newVertices;
+
+    if( m_reservedSpace >= 3 )
+    {
+        newVertices = m_reserved;
+        m_reserved += 3;
+        m_reservedSpace -= 3;
+
+        if( m_reservedSpace == 0 )
+            m_reserved = NULL;
+    }
+    else
+    {
+        newVertices = m_container->Allocate( 3 );
+    }
+
+    if( newVertices == NULL )
+    {
+        if( show_err )
+        {
+            DisplayError( NULL, wxT( "VERTEX_MANAGER::Circle: Vertex allocation error" ) );
+            show_err = false;
+        }
+
+        return false;
+    }
+
+    // The triangle corners are numbered from 1 to 3 (see the vertex shader source)
+    Shader( aShaderType, 1.0f, aRadius, aWidth );
+    putVertex( newVertices[0], aX, aY, aZ );
+
+    for( unsigned int i = 1; i < 3; ++i )
+    {
+        newVertices[i] = newVertices[0];
+        newVertices[i].shader[1] = i + 1.0f;
+    }
+
+    m_shader[1] = 3.0f;
+
+    return true;
+}
+
+
 void VERTEX_MANAGER::SetItem( VERTEX_ITEM& aItem ) const
 {
     m_container->SetItem( &aItem );
@@ -28,6 +28,7 @@
 
 #include <gal/stroke_font.h>
 #include <gal/graphics_abstraction_layer.h>
+#include <newstroke_font.h>
 #include <text_utils.h>
 #include <wx/string.h>
 
@@ -41,83 +42,16 @@ const double STROKE_FONT::STROKE_FONT_SCALE = 1.0 / 21.0;
 const double STROKE_FONT::ITALIC_TILT = 1.0 / 8;
 
 STROKE_FONT::STROKE_FONT( GAL* aGal ) :
-    m_gal( aGal )
+    m_gal( aGal ), m_glyphCount( 0 ), m_scaledGeneration( 1 ), m_scaledItalic( false )
 {
 }
 
 
-bool STROKE_FONT::LoadNewStrokeFont( const char* const aNewStrokeFont[], int aNewStrokeFontSize )
+bool STROKE_FONT::LoadNewStrokeFont()
 {
-    m_glyphs.clear();
-    m_glyphBoundingBoxes.clear();
-    m_glyphs.resize( aNewStrokeFontSize );
-    m_glyphBoundingBoxes.resize( aNewStrokeFontSize );
-
-    for( int j = 0; j < aNewStrokeFontSize; j++ )
-    {
-        GLYPH&   glyph = m_glyphs[j];
-        double   glyphStartX = 0.0;
-        double   glyphEndX = 0.0;
-        VECTOR2D glyphBoundingX;
-
-        std::deque<VECTOR2D>* pointList = nullptr;
-
-        int i = 0;
-
-        while( aNewStrokeFont[j][i] )
-        {
-            VECTOR2D    point( 0.0, 0.0 );
-            char        coordinate[2] = { 0, };
-
-            for( int k = 0; k < 2; k++ )
-            {
-                coordinate[k] = aNewStrokeFont[j][i + k];
-            }
-
-            if( i < 2 )
-            {
-                // The first two values contain the width of the char
-                glyphStartX     = ( coordinate[0] - 'R' ) * STROKE_FONT_SCALE;
-                glyphEndX       = ( coordinate[1] - 'R' ) * STROKE_FONT_SCALE;
-                glyphBoundingX  = VECTOR2D( 0, glyphEndX - glyphStartX );
-            }
-            else if( ( coordinate[0] == ' ' ) && ( coordinate[1] == 'R' ) )
-            {
-                // Raise pen
-                pointList = nullptr;
-            }
-            else
-            {
-                // In stroke font, coordinates values are coded as <value> + 'R',
-                // <value> is an ASCII char.
-                // therefore every coordinate description of the Hershey format has an offset,
-                // it has to be subtracted
-                // Note:
-                //  * the stroke coordinates are stored in reduced form (-1.0 to +1.0),
-                //    and the actual size is stroke coordinate * glyph size
-                //  * a few shapes have a height slightly bigger than 1.0 ( like '{' '[' )
-                point.x = (double) ( coordinate[0] - 'R' ) * STROKE_FONT_SCALE - glyphStartX;
-                #define FONT_OFFSET -10
-				// FONT_OFFSET is here for historical reasons, due to the way the stroke font
-                // was built. It allows shapes coordinates like W M ... to be >= 0
-                // Only shapes like j y have coordinates < 0
-                point.y = (double) ( coordinate[1] - 'R' + FONT_OFFSET ) * STROKE_FONT_SCALE;
-
-                if( !pointList )
-                {
-                    glyph.emplace_back( std::deque<VECTOR2D>() );
-                    pointList = &glyph.back();
-                }
-
-                pointList->push_back( point );
-            }
-
-            i += 2;
-        }
-
-        // Compute the bounding box of the glyph
-        m_glyphBoundingBoxes[j] = computeBoundingBox( glyph, glyphBoundingX );
-    }
+    // The scaled glyphs are only made for the glyphs in use, see scaledGlyph()
+    m_glyphCount = newstroke_glyph_count;
+    m_scaledGlyphs.clear();
 
     return true;
 }
@@ -136,27 +70,13 @@ int STROKE_FONT::getInterline() const
 }
 
 
-BOX2D STROKE_FONT::computeBoundingBox( const GLYPH& aGLYPH, const VECTOR2D& aGLYPHBoundingX ) const
+BOX2D STROKE_FONT::glyphBoundingBox( int aIndex ) const
 {
-    BOX2D boundingBox;
-
-    std::deque<VECTOR2D> boundingPoints;
-
-    boundingPoints.emplace_back( VECTOR2D( aGLYPHBoundingX.x, 0 ) );
-    boundingPoints.emplace_back( VECTOR2D( aGLYPHBoundingX.y, 0 ) );
-
-    for( GLYPH::const_iterator pointListIt = aGLYPH.begin(); pointListIt != aGLYPH.end(); ++pointListIt )
-    {
-        for( std::deque<VECTOR2D>::const_iterator pointIt = pointListIt->begin();
-                pointIt != pointListIt->end(); ++pointIt )
-        {
-            boundingPoints.emplace_back( VECTOR2D( aGLYPHBoundingX.x, pointIt->y ) );
-        }
-    }
-
-    boundingBox.Compute( boundingPoints );
+    const NEWSTROKE_GLYPH& glyph = newstroke_glyphs[aIndex];
 
-    return boundingBox;
+    return BOX2D( VECTOR2D( std::min( glyph.m_Width, 0 ), glyph.m_MinY ) * STROKE_FONT_SCALE,
+                  VECTOR2D( std::abs( glyph.m_Width ), glyph.m_MaxY - glyph.m_MinY )
+                          * STROKE_FONT_SCALE );
 }
 
 
@@ -314,7 +234,7 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
         // The choice of spaces is somewhat arbitrary but sufficient for aligning text
         if( *chIt == '\t' )
         {
-            double fourSpaces = 4.0 * glyphSize.x * m_glyphBoundingBoxes[0].GetEnd().x;
+            double fourSpaces = 4.0 * glyphSize.x * glyphBoundingBox( 0 ).GetEnd().x;
             double addlSpace = fourSpaces - std::fmod( xOffset, fourSpaces );
 
             // Add the remaining space (between 0 and 3 spaces)
@@ -324,11 +244,10 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
             dd = 0;
         }
 
-        if( dd >= (int) m_glyphBoundingBoxes.size() || dd < 0 )
+        if( dd >= m_glyphCount || dd < 0 )
             dd = '?' - ' ';
 
-        GLYPH& glyph = m_glyphs[dd];
-        BOX2D& bbox  = m_glyphBoundingBoxes[dd];
+        BOX2D bbox = glyphBoundingBox( dd );
 
         if( overbars[overbar_index] )
         {
@@ -355,30 +274,18 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
             last_had_overbar = false;
         }
 
-        for( GLYPH::iterator pointListIt = glyph.begin(); pointListIt != glyph.end();
-             ++pointListIt )
+        const SCALED_GLYPH& scaled = scaledGlyph( dd, glyphSize, m_gal->IsFontItalic() );
+        const VECTOR2D*     stroke = scaled.points.data();
+
+        for( int run : scaled.runs )
         {
-            std::deque<VECTOR2D> pointListScaled;
+            m_strokeBuffer.resize( run );
 
-            for( std::deque<VECTOR2D>::iterator pointIt = pointListIt->begin();
-                 pointIt != pointListIt->end(); ++pointIt )
-            {
-                VECTOR2D pointPos( pointIt->x * glyphSize.x + xOffset, pointIt->y * glyphSize.y );
+            for( int i = 0; i < run; ++i )
+                m_strokeBuffer[i] = VECTOR2D( stroke[i].x + xOffset, stroke[i].y );
 
-                if( m_gal->IsFontItalic() )
-                {
-                    // FIXME should be done other way - referring to the lowest Y value of point
-                    // because now italic fonts are translated a bit
-                    if( m_gal->IsTextMirrored() )
-                        pointPos.x += pointPos.y * STROKE_FONT::ITALIC_TILT;
-                    else
-                        pointPos.x -= pointPos.y * STROKE_FONT::ITALIC_TILT;
-                }
-
-                pointListScaled.push_back( pointPos );
-            }
-
-            m_gal->DrawPolyline( pointListScaled );
+            m_gal->DrawPolyline( m_strokeBuffer.data(), run );
+            stroke += run;
         }
 
         xOffset += glyphSize.x * bbox.GetEnd().x;
@@ -389,6 +296,64 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
 }
 
 
+const STROKE_FONT::SCALED_GLYPH& STROKE_FONT::scaledGlyph( int aIndex, const VECTOR2D& aGlyphSize,
+                                                          bool aItalic )
+{
+    if( aGlyphSize != m_scaledSize || aItalic != m_scaledItalic )
+    {
+        // Invalidate all glyphs at once
+        ++m_scaledGeneration;
+        m_scaledSize = aGlyphSize;
+        m_scaledItalic = aItalic;
+    }
+
+    if( aIndex >= (int) m_scaledGlyphs.size() )
+        m_scaledGlyphs.resize( aIndex + 1, SCALED_GLYPH{ 0 } );
+
+    SCALED_GLYPH& scaled = m_scaledGlyphs[aIndex];
+
+    if( scaled.generation == m_scaledGeneration )
+        return scaled;
+
+    scaled.generation = m_scaledGeneration;
+    scaled.points.clear();
+    scaled.runs.clear();
+
+    const NEWSTROKE_GLYPH& glyph = newstroke_glyphs[aIndex];
+
+    for( int stroke = glyph.m_FirstStroke; stroke < glyph.m_FirstStroke + glyph.m_StrokeCount;
+            ++stroke )
+    {
+        int first = newstroke_strokes[stroke];
+        int last = newstroke_strokes[stroke + 1];
+
+        for( int i = first; i < last; ++i )
+        {
+            VECTOR2D point( newstroke_points[2 * i] * STROKE_FONT_SCALE,
+                            newstroke_points[2 * i + 1] * STROKE_FONT_SCALE );
+            VECTOR2D pointPos( point.x * aGlyphSize.x, point.y * aGlyphSize.y );
+
+            if( aItalic )
+            {
+                // FIXME should be done other way - referring to the lowest Y value of point
+                // because now italic fonts are translated a bit
+                // (mirrored text has a negative glyph width)
+                if( aGlyphSize.x < 0 )
+                    pointPos.x += pointPos.y * STROKE_FONT::ITALIC_TILT;
+                else
+                    pointPos.x -= pointPos.y * STROKE_FONT::ITALIC_TILT;
+            }
+
+            scaled.points.push_back( pointPos );
+        }
+
+        scaled.runs.push_back( last - first );
+    }
+
+    return scaled;
+}
+
+
 double STROKE_FONT::ComputeOverbarVerticalPosition( double aGlyphHeight, double aGlyphThickness ) const
 {
     // Static method.
@@ -440,10 +405,10 @@ VECTOR2D STROKE_FONT::ComputeStringBoundaryLimits( const UTF8& aText, const VECT
         // Index in the bounding boxes table
         int dd = *it - ' ';
 
-        if( dd >= (int) m_glyphBoundingBoxes.size() || dd < 0 )
+        if( dd >= m_glyphCount || dd < 0 )
             dd = '?' - ' ';
 
-        const BOX2D& box = m_glyphBoundingBoxes[dd];
+        BOX2D box = glyphBoundingBox( dd );
         curX += box.GetEnd().x;
     }
 
@@ -0,0 +1,336 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+#include <geometry/edge_kernels.h>
+#include <geometry/seg.h>
+#include <math/math_util.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+
+// The kernels load the coordinates of the points straight from the arrays
+static_assert( sizeof( VECTOR2I ) == 2 * sizeof( int ), "VECTOR2I must hold two packed ints" );
+
+
+static inline int nextPoint( int aPoint, int aCount )
+{
+    return aPoint + 1 == aCount ? 0 : aPoint + 1;
+}
+
+
+static inline bool crossesRay( const VECTOR2I& aP1, const VECTOR2I& aP2, const VECTOR2I& aP )
+{
+    const VECTOR2I diff = aP2 - aP1;
+
+    if( diff.y == 0 )
+        return false;
+
+    const int d = rescale( diff.x, ( aP.y - aP1.y ), diff.y );
+
+    return ( ( aP1.y > aP.y ) != ( aP2.y > aP.y ) ) && ( aP.x - aP1.x < d );
+}
+
+
+bool EDGE_KERNELS::OddRayCrossingsScalar( const VECTOR2I* aPoints, int aCount,
+                                          const VECTOR2I& aP )
+{
+    bool odd = false;
+
+    for( int i = 0; i < aCount; i++ )
+    {
+        if( crossesRay( aPoints[i], aPoints[nextPoint( i, aCount )], aP ) )
+            odd = !odd;
+    }
+
+    return odd;
+}
+
+
+int EDGE_KERNELS::MinDistanceScalar( const VECTOR2I* aPoints, int aCount, int aEdgeCount,
+                                     const VECTOR2I& aP )
+{
+    int d = INT_MAX;
+
+    for( int i = 0; i < aEdgeCount; i++ )
+        d = std::min( d, SEG( aPoints[i], aPoints[nextPoint( i, aCount )] ).Distance( aP ) );
+
+    return d;
+}
+
+
+#ifdef __SSE2__
+
+/**
+ * Loads the coordinates of aPoints[0..3] into the lanes of aX and aY.
+ */
+static inline void loadPoints( const VECTOR2I* aPoints, __m128i& aX, __m128i& aY )
+{
+    // x0 y0 x1 y1 and x2 y2 x3 y3, shuffled to x0 x1 y0 y1 and x2 x3 y2 y3
+    __m128i lo = _mm_loadu_si128( reinterpret_cast<const __m128i*>( aPoints ) );
+    __m128i hi = _mm_loadu_si128( reinterpret_cast<const __m128i*>( aPoints + 2 ) );
+
+    lo = _mm_shuffle_epi32( lo, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+    hi = _mm_shuffle_epi32( hi, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+
+    aX = _mm_unpacklo_epi64( lo, hi );
+    aY = _mm_unpackhi_epi64( lo, hi );
+}
+
+
+///> Converts lanes 0 and 1 (aHigh false) or 2 and 3 (aHigh true) of aValue to doubles
+static inline __m128d toDouble( __m128i aValue, bool aHigh )
+{
+    return _mm_cvtepi32_pd( aHigh ? _mm_shuffle_epi32( aValue, _MM_SHUFFLE( 1, 0, 3, 2 ) )
+                                  : aValue );
+}
+
+
+bool EDGE_KERNELS::OddRayCrossings( const VECTOR2I* aPoints, int aCount, const VECTOR2I& aP )
+{
+    // The crossing abscissa is computed in double with an error well below this margin for
+    // any int coordinate.  The edges crossing the ray within it are checked exactly.
+    const __m128d margin = _mm_set1_pd( 1.0 / 1024 );
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d one = _mm_set1_pd( 1.0 );
+    const __m128d absMask = _mm_castsi128_pd( _mm_set1_epi64x( INT64_MAX ) );
+    const __m128i px = _mm_set1_epi32( aP.x );
+    const __m128i py = _mm_set1_epi32( aP.y );
+
+    int odd = 0;
+    int i = 0;
+
+    for( ; i + 4 < aCount; i += 4 )
+    {
+        __m128i x1, y1, x2, y2;
+
+        loadPoints( aPoints + i, x1, y1 );
+        loadPoints( aPoints + i + 1, x2, y2 );
+
+        // The edges with one end above the ray and the other one not (exact)
+        __m128i straddle = _mm_xor_si128( _mm_cmpgt_epi32( y1, py ), _mm_cmpgt_epi32( y2, py ) );
+        int     straddleMask = _mm_movemask_ps( _mm_castsi128_ps( straddle ) );
+
+        if( !straddleMask )
+            continue;
+
+        __m128i dx = _mm_sub_epi32( x2, x1 );
+        __m128i dy = _mm_sub_epi32( y2, y1 );
+        __m128i wx = _mm_sub_epi32( px, x1 );
+        __m128i wy = _mm_sub_epi32( py, y1 );
+
+        int crossMask = 0;
+        int unsureMask = 0;
+
+        for( int high = 0; high < 2; high++ )
+        {
+            // The scalar test is wx < trunc( dx * wy / dy ), that is q >= wx + 1 for a
+            // positive wx, and q > wx for a negative one.  Horizontal edges give NaNs here,
+            // but they never straddle the ray.
+            __m128d q = _mm_div_pd( _mm_mul_pd( toDouble( dx, high ), toDouble( wy, high ) ),
+                                    toDouble( dy, high ) );
+            __m128d b = toDouble( wx, high );
+
+            b = _mm_add_pd( b, _mm_and_pd( _mm_cmpge_pd( b, zero ), one ) );
+
+            __m128d diff = _mm_sub_pd( q, b );
+
+            crossMask |= _mm_movemask_pd( _mm_cmpgt_pd( diff, margin ) ) << ( 2 * high );
+            unsureMask |= _mm_movemask_pd( _mm_cmple_pd( _mm_and_pd( diff, absMask ), margin ) )
+                          << ( 2 * high );
+        }
+
+        // 0x6996 is the parity of the numbers of bits of 0..15
+        odd ^= ( 0x6996 >> ( straddleMask & crossMask & ~unsureMask ) ) & 1;
+
+        for( int unsure = straddleMask & unsureMask, k = 0; unsure; unsure >>= 1, k++ )
+        {
+            if( ( unsure & 1 ) && crossesRay( aPoints[i + k], aPoints[i + k + 1], aP ) )
+                odd ^= 1;
+        }
+    }
+
+    for( ; i < aCount; i++ )
+    {
+        if( crossesRay( aPoints[i], aPoints[nextPoint( i, aCount )], aP ) )
+            odd ^= 1;
+    }
+
+    return odd != 0;
+}
+
+
+///> Lane by lane maximum of aA and aB (_mm_max_epi32 needs SSE4.1)
+static inline __m128i max32( __m128i aA, __m128i aB )
+{
+    __m128i greater = _mm_cmpgt_epi32( aA, aB );
+
+    return _mm_or_si128( _mm_and_si128( greater, aA ), _mm_andnot_si128( greater, aB ) );
+}
+
+
+///> Distance along one axis of aP to the ranges [aA, aB] (or [aB, aA]), 0 inside them
+static inline __m128i axisDistances( __m128i aA, __m128i aB, __m128i aP )
+{
+    __m128i da = _mm_sub_epi32( aA, aP );
+    __m128i db = _mm_sub_epi32( aB, aP );
+    __m128i zero = _mm_setzero_si128();
+
+    // The range is after aP if both ends are, before it if both ends are before
+    __m128i after = max32( zero, _mm_sub_epi32( zero, max32( _mm_sub_epi32( zero, da ),
+                                                             _mm_sub_epi32( zero, db ) ) ) );
+    __m128i before = max32( zero, _mm_sub_epi32( zero, max32( da, db ) ) );
+
+    return _mm_or_si128( after, before );
+}
+
+
+///> Lower bounds of the distances of aP to the edges aPoints[i..i+3] - aPoints[i+1..i+4]
+static inline __m128i edgeBounds( const VECTOR2I* aPoints, __m128i aPx, __m128i aPy )
+{
+    __m128i x1, y1, x2, y2;
+
+    loadPoints( aPoints, x1, y1 );
+    loadPoints( aPoints + 1, x2, y2 );
+
+    return max32( axisDistances( x1, x2, aPx ), axisDistances( y1, y2, aPy ) );
+}
+
+
+int EDGE_KERNELS::MinDistance( const VECTOR2I* aPoints, int aCount, int aEdgeCount,
+                               const VECTOR2I& aP )
+{
+    // The largest distance along the axes to the bounding box of an edge is a lower bound of
+    // its distance, cheap to compute four edges at a time.  SEG::Distance() rounds the nearest
+    // point to the grid and truncates its result, so it can be below the bound by less than
+    // this margin: the edges whose boxes are farther than the closest edge found plus the
+    // margin are skipped.
+    const int DISTANCE_MARGIN = 3;
+
+    // Below this count, the two passes cost more than the edges they skip
+    const int MIN_VECTOR_EDGES = 32;
+
+    if( aEdgeCount < MIN_VECTOR_EDGES )
+        return MinDistanceScalar( aPoints, aCount, aEdgeCount, aP );
+
+    const __m128i px = _mm_set1_epi32( aP.x );
+    const __m128i py = _mm_set1_epi32( aP.y );
+
+    // The last edges can wrap around to the first point, and are checked one by one
+    int vectorEdges = std::max( 0, std::min( aEdgeCount, aCount - 1 ) ) & ~3;
+    int d = INT_MAX;
+    int limit = INT_MAX;
+
+    auto checkEdge = [&]( int aEdge )
+    {
+        d = std::min( d, SEG( aPoints[aEdge], aPoints[nextPoint( aEdge, aCount )] ).Distance( aP ) );
+        limit = d > INT_MAX - DISTANCE_MARGIN ? INT_MAX : d + DISTANCE_MARGIN;
+    };
+
+    // A first pass finds the edge with the nearest box, likely the nearest edge or close to
+    // it: the second pass then checks only the few edges that can be nearer
+    if( vectorEdges > 0 )
+    {
+        __m128i minBound = _mm_set1_epi32( INT_MAX );
+        __m128i minEdge = _mm_setzero_si128();
+        __m128i edges = _mm_setr_epi32( 0, 1, 2, 3 );
+
+        for( int i = 0; i < vectorEdges; i += 4 )
+        {
+            __m128i bound = edgeBounds( aPoints + i, px, py );
+            __m128i nearer = _mm_cmplt_epi32( bound, minBound );
+
+            minBound = _mm_or_si128( _mm_and_si128( nearer, bound ),
+                                     _mm_andnot_si128( nearer, minBound ) );
+            minEdge = _mm_or_si128( _mm_and_si128( nearer, edges ),
+                                    _mm_andnot_si128( nearer, minEdge ) );
+            edges = _mm_add_epi32( edges, _mm_set1_epi32( 4 ) );
+        }
+
+        int bounds[4];
+        int nearest[4];
+
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( bounds ), minBound );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( nearest ), minEdge );
+
+        checkEdge( nearest[std::min_element( bounds, bounds + 4 ) - bounds] );
+    }
+
+    for( int i = 0; i < vectorEdges && d > 0; i += 4 )
+    {
+        __m128i bound = edgeBounds( aPoints + i, px, py );
+        int     nearMask = _mm_movemask_ps(
+                _mm_castsi128_ps( _mm_cmplt_epi32( bound, _mm_set1_epi32( limit ) ) ) );
+
+        if( !nearMask )
+            continue;
+
+        // The limit gets lower with each edge checked: the bounds are compared to it again
+        int bounds[4];
+
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( bounds ), bound );
+
+        for( int k = 0; nearMask; nearMask >>= 1, k++ )
+        {
+            if( ( nearMask & 1 ) && bounds[k] < limit )
+                checkEdge( i + k );
+        }
+    }
+
+    for( int i = vectorEdges; i < aEdgeCount && d > 0; i++ )
+        checkEdge( i );
+
+    return d;
+}
+
+
+const char* EDGE_KERNELS::InstructionSet()
+{
+    return "SSE2";
+}
+
+#else
+
+bool EDGE_KERNELS::OddRayCrossings( const VECTOR2I* aPoints, int aCount, const VECTOR2I& aP )
+{
+    return OddRayCrossingsScalar( aPoints, aCount, aP );
+}
+
+
+int EDGE_KERNELS::MinDistance( const VECTOR2I* aPoints, int aCount, int aEdgeCount,
+                               const VECTOR2I& aP )
+{
+    return MinDistanceScalar( aPoints, aCount, aEdgeCount, aP );
+}
+
+
+const char* EDGE_KERNELS::InstructionSet()
+{
+    return "scalar";
+}
+
+#endif
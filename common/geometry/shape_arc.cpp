@@ -237,35 +237,39 @@ int SHAPE_ARC::GetRadius() const
     return (m_p0 - m_pc).EuclideanNorm();
 }
 
-const SHAPE_LINE_CHAIN SHAPE_ARC::ConvertToPolyline( double aAccuracy ) const
+int SHAPE_ARC::GetPolylineSegmentCount( double aAccuracy ) const
 {
-    SHAPE_LINE_CHAIN rv;
     double r = GetRadius();
-    double sa = GetStartAngle();
-    auto c = GetCenter();
-    int n;
 
     if( r == 0.0 )
-    {
-        n = 0;
-    }
-    else
-    {
-        n = GetArcToSegmentCount( r, aAccuracy, m_centralAngle );
-    }
+        return 0;
 
-    for( int i = 0; i <= n ; i++ )
-    {
-        double a = sa;
+    return GetArcToSegmentCount( r, aAccuracy, m_centralAngle );
+}
+
+
+const VECTOR2I SHAPE_ARC::GetPolylinePoint( int aIndex, int aSegmentCount ) const
+{
+    double r = GetRadius();
+    double a = GetStartAngle();
+    auto c = GetCenter();
 
-        if( n != 0 )
-            a += m_centralAngle * (double) i / (double) n;
+    if( aSegmentCount != 0 )
+        a += m_centralAngle * (double) aIndex / (double) aSegmentCount;
 
-        double x = c.x + r * cos( a * M_PI / 180.0 );
-        double y = c.y + r * sin( a * M_PI / 180.0 );
+    double x = c.x + r * cos( a * M_PI / 180.0 );
+    double y = c.y + r * sin( a * M_PI / 180.0 );
 
-        rv.Append( (int) x, (int) y );
-    }
+    return VECTOR2I( (int) x, (int) y );
+}
+
+
+const SHAPE_LINE_CHAIN SHAPE_ARC::ConvertToPolyline( double aAccuracy ) const
+{
+    // The chain keeps the arc, and builds the points when they are first read
+    SHAPE_LINE_CHAIN rv;
+
+    rv.Append( *this, aAccuracy );
 
     return rv;
 }
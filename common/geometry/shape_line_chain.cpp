@@ -23,13 +23,415 @@
  */
 
 #include <algorithm>
+#include <climits>
 
 #include <geometry/shape_line_chain.h>
+#include <geometry/edge_kernels.h>
 #include <geometry/shape_circle.h>
+#include <geometry/rtree.h>
 #include <trigo.h>
 #include "clipper.hpp"
 
 
+/**
+ * R-tree of the edges of a line chain.  Edge i joins the points i and i + 1, and the last
+ * edge joins the last point to the first one, whether the chain is closed or not: the
+ * queries skip it for an open chain.
+ */
+class SHAPE_LINE_CHAIN_EDGE_INDEX
+{
+public:
+    SHAPE_LINE_CHAIN_EDGE_INDEX( const std::vector<VECTOR2I>& aPoints )
+    {
+        std::vector<int> edges( aPoints.size() );
+
+        for( size_t ii = 0; ii < edges.size(); ++ii )
+            edges[ii] = ii;
+
+        m_bbox.Compute( aPoints );
+
+        m_tree.BulkLoad( edges, [&aPoints]( int aEdge, int* aMin, int* aMax )
+                {
+                    const VECTOR2I& a = aPoints[aEdge];
+                    const VECTOR2I& b = aPoints[( aEdge + 1 ) % aPoints.size()];
+
+                    aMin[0] = std::min( a.x, b.x );
+                    aMin[1] = std::min( a.y, b.y );
+                    aMax[0] = std::max( a.x, b.x );
+                    aMax[1] = std::max( a.y, b.y );
+                } );
+    }
+
+    /**
+     * Calls aVisitor( edge ) for the edges whose bounding box intersects the box of the
+     * points aA and aB inflated by aMargin, until it returns false.
+     */
+    template <class VISITOR>
+    void Query( const VECTOR2I& aA, const VECTOR2I& aB, int64_t aMargin, VISITOR aVisitor ) const
+    {
+        auto clamp = []( int64_t aValue )
+        {
+            return (int) std::max<int64_t>( INT_MIN, std::min<int64_t>( INT_MAX, aValue ) );
+        };
+
+        int min[2] = { clamp( (int64_t) std::min( aA.x, aB.x ) - aMargin ),
+                       clamp( (int64_t) std::min( aA.y, aB.y ) - aMargin ) };
+        int max[2] = { clamp( (int64_t) std::max( aA.x, aB.x ) + aMargin ),
+                       clamp( (int64_t) std::max( aA.y, aB.y ) + aMargin ) };
+
+        m_tree.Search( min, max, aVisitor );
+    }
+
+    ///> Returns the bounding box of the points
+    const BOX2I& BBox() const
+    {
+        return m_bbox;
+    }
+
+private:
+    BOX2I m_bbox;
+
+    // Searching does not change the tree, but RTree::Search() is not const
+    mutable RTree<int, int, 2, double> m_tree;
+};
+
+
+namespace
+{
+
+/**
+ * Returns the bounding box of the points of an arc, which unlike SHAPE_ARC::BBox() does
+ * not hold its center.
+ */
+BOX2I arcBBox( const SHAPE_ARC& aArc )
+{
+    BOX2I        bbox( aArc.GetP0(), VECTOR2I( 0, 0 ) );
+    const double startAngle = aArc.GetStartAngle();
+    const double centralAngle = aArc.GetCentralAngle();
+    const int    radius = aArc.GetRadius();
+
+    bbox.Merge( aArc.GetP1() );
+
+    // The extreme points of the circle in the arc
+    for( int quadrant = -8; quadrant <= 8; quadrant++ )
+    {
+        double angle = quadrant * 90.0;
+
+        if( ( angle - startAngle ) * ( angle - startAngle - centralAngle ) > 0.0 )
+            continue;
+
+        switch( ( quadrant + 8 ) % 4 )
+        {
+        case 0: bbox.Merge( aArc.GetCenter() + VECTOR2I( radius, 0 ) ); break;
+        case 1: bbox.Merge( aArc.GetCenter() + VECTOR2I( 0, radius ) ); break;
+        case 2: bbox.Merge( aArc.GetCenter() + VECTOR2I( -radius, 0 ) ); break;
+        case 3: bbox.Merge( aArc.GetCenter() + VECTOR2I( 0, -radius ) ); break;
+        }
+    }
+
+    // For the rounding of the points of the segments
+    bbox.Inflate( 1 );
+
+    return bbox;
+}
+
+
+/**
+ * Returns true if aSeg is closer to the arc aArc than aClearance, or crosses it
+ */
+bool arcCollide( const SHAPE_ARC& aArc, const SEG& aSeg, int aClearance )
+{
+    const VECTOR2D c( aArc.GetCenter() );
+    const VECTOR2D p0( aArc.GetP0() );
+    const VECTOR2D p1( aArc.GetP1() );
+    const VECTOR2D a( aSeg.A );
+    const VECTOR2D d = VECTOR2D( aSeg.B ) - a;
+    const double   r = ( p0 - c ).EuclideanNorm();
+    const double   startAngle = aArc.GetStartAngle();
+    const double   centralAngle = aArc.GetCentralAngle();
+    const double   clearance = aClearance;
+
+    // Is the direction of aP from the center in the arc?
+    auto inArc = [&]( const VECTOR2D& aP ) -> bool
+    {
+        if( std::abs( centralAngle ) >= 360.0 )
+            return true;
+
+        double angle = atan2( aP.y - c.y, aP.x - c.x ) * 180.0 / M_PI - startAngle;
+
+        if( centralAngle < 0.0 )
+            angle = -angle;
+
+        angle = fmod( angle, 360.0 );
+
+        if( angle < 0.0 )
+            angle += 360.0;
+
+        return angle <= std::abs( centralAngle );
+    };
+
+    auto pointDistance = [&]( const VECTOR2D& aP ) -> double
+    {
+        if( inArc( aP ) )
+            return std::abs( ( aP - c ).EuclideanNorm() - r );
+
+        return std::min( ( aP - p0 ).EuclideanNorm(), ( aP - p1 ).EuclideanNorm() );
+    };
+
+    // The closest points are an end of the segment or of the arc, the foot of the
+    // perpendicular from the center to the segment, or a crossing
+    if( pointDistance( a ) < clearance || pointDistance( a + d ) < clearance )
+        return true;
+
+    SEG::ecoord clearanceSq = (SEG::ecoord) aClearance * aClearance;
+
+    if( aSeg.SquaredDistance( aArc.GetP0() ) < clearanceSq
+            || aSeg.SquaredDistance( aArc.GetP1() ) < clearanceSq )
+        return true;
+
+    const double lengthSq = d.SquaredEuclideanNorm();
+
+    if( lengthSq == 0.0 )
+        return false;
+
+    const double t = ( c - a ).Dot( d ) / lengthSq;
+
+    if( t > 0.0 && t < 1.0 && pointDistance( a + d * t ) < clearance )
+        return true;
+
+    // Crossings of the line of the segment and the circle
+    const double b = ( a - c ).Dot( d );
+    const double disc = b * b - lengthSq * ( ( a - c ).SquaredEuclideanNorm() - r * r );
+
+    if( disc < 0.0 )
+        return false;
+
+    for( double sign : { -1.0, 1.0 } )
+    {
+        const double u = ( -b + sign * sqrt( disc ) ) / lengthSq;
+
+        if( u >= 0.0 && u <= 1.0 && inArc( a + d * u ) )
+            return true;
+    }
+
+    return false;
+}
+
+} // namespace
+
+
+SHAPE_LINE_CHAIN::POINTS::~POINTS()
+{
+    delete m_edgeIndex.load();
+}
+
+
+const SHAPE_LINE_CHAIN_EDGE_INDEX* SHAPE_LINE_CHAIN::edgeIndex() const
+{
+    if( PointCount() < EDGE_INDEX_MIN_POINTS )
+        return nullptr;
+
+    SHAPE_LINE_CHAIN_EDGE_INDEX* index = m_points->m_edgeIndex.load( std::memory_order_acquire );
+
+    if( index )
+        return index;
+
+    // The copies of the chain may be read by several threads, which may all build the index:
+    // the first one stored is kept.
+    SHAPE_LINE_CHAIN_EDGE_INDEX* built = new SHAPE_LINE_CHAIN_EDGE_INDEX( points() );
+
+    if( m_points->m_edgeIndex.compare_exchange_strong( index, built, std::memory_order_acq_rel ) )
+        return built;
+
+    delete built;
+    return index;
+}
+
+
+void SHAPE_LINE_CHAIN::dropEdgeIndex()
+{
+    delete m_points->m_edgeIndex.exchange( nullptr );
+}
+
+
+const std::vector<VECTOR2I>& SHAPE_LINE_CHAIN::POINTS::polyline() const
+{
+    // The copies of the chain may be read by several threads
+    if( m_polylineValid.load( std::memory_order_acquire ) )
+        return m_polyline;
+
+    std::lock_guard<std::mutex> lock( m_polylineLock );
+
+    if( !m_polylineValid.load( std::memory_order_relaxed ) )
+    {
+        size_t next = 0;
+
+        for( const CHAIN_ARC& arc : m_arcs )
+        {
+            m_polyline.insert( m_polyline.end(), m_points.begin() + next,
+                               m_points.begin() + arc.m_position );
+            next = arc.m_position;
+
+            // The points of Append( arc.m_arc.ConvertToPolyline() )
+            for( int i = 0; i <= arc.m_segmentCount; i++ )
+            {
+                VECTOR2I p = arc.m_arc.GetPolylinePoint( i, arc.m_segmentCount );
+
+                if( m_polyline.empty() || m_polyline.back() != p )
+                    m_polyline.push_back( p );
+            }
+        }
+
+        m_polyline.insert( m_polyline.end(), m_points.begin() + next, m_points.end() );
+        m_polylineValid.store( true, std::memory_order_release );
+    }
+
+    return m_polyline;
+}
+
+
+SHAPE_LINE_CHAIN::POINTS& SHAPE_LINE_CHAIN::mutableArcs()
+{
+    if( !m_points )
+    {
+        m_points = std::make_shared<POINTS>();
+    }
+    else if( m_points.use_count() > 1 )
+    {
+        m_points = std::make_shared<POINTS>( m_points->m_points, m_points->m_arcs );
+    }
+    else
+    {
+        dropEdgeIndex();
+        m_points->m_polyline.clear();
+        m_points->m_polylineValid.store( false, std::memory_order_relaxed );
+    }
+
+    return *m_points;
+}
+
+
+const VECTOR2I& SHAPE_LINE_CHAIN::arcsLastPoint() const
+{
+    const CHAIN_ARC& arc = m_points->m_arcs.back();
+
+    if( arc.m_position == m_points->m_points.size() )
+        return arc.m_end;
+
+    return m_points->m_points.back();
+}
+
+
+void SHAPE_LINE_CHAIN::Append( const SHAPE_ARC& aArc, double aAccuracy )
+{
+    CHAIN_ARC arc;
+
+    arc.m_arc = aArc;
+    arc.m_segmentCount = aArc.GetPolylineSegmentCount( aAccuracy );
+    arc.m_end = aArc.GetPolylinePoint( arc.m_segmentCount, arc.m_segmentCount );
+
+    if( !ArcCount() && PointCount() == 0 )
+        m_bbox = arcBBox( aArc );
+    else
+        m_bbox.Merge( arcBBox( aArc ) );
+
+    POINTS& points = mutableArcs();
+
+    arc.m_position = points.m_points.size();
+    points.m_arcs.push_back( arc );
+}
+
+
+void SHAPE_LINE_CHAIN::appendToArcs( const VECTOR2I& aP, bool aAllowDuplication )
+{
+    if( aAllowDuplication || arcsLastPoint() != aP )
+    {
+        mutableArcs().m_points.push_back( aP );
+        m_bbox.Merge( aP );
+    }
+}
+
+
+void SHAPE_LINE_CHAIN::appendToArcs( const SHAPE_LINE_CHAIN& aOtherLine )
+{
+    // Held, so that appending the chain to itself copies the points first
+    std::shared_ptr<const POINTS> otherPoints = aOtherLine.m_points;
+
+    if( !otherPoints )
+        return;
+
+    // Same points as appending the points of aOtherLine: all of them but the first one,
+    // if it is the last point of this chain
+    const POINTS& other = *otherPoints;
+    size_t        next = 0;
+    bool          first = true;
+
+    auto appendPoints = [&]( size_t aEnd )
+    {
+        for( ; next < aEnd; next++ )
+        {
+            Append( other.m_points[next], !first );
+            first = false;
+        }
+    };
+
+    for( const CHAIN_ARC& arc : other.m_arcs )
+    {
+        appendPoints( arc.m_position );
+
+        if( !ArcCount() && PointCount() == 0 )
+            m_bbox = arcBBox( arc.m_arc );
+        else
+            m_bbox.Merge( arcBBox( arc.m_arc ) );
+
+        POINTS& points = mutableArcs();
+
+        points.m_arcs.push_back( arc );
+        points.m_arcs.back().m_position = points.m_points.size();
+        first = false;
+    }
+
+    appendPoints( other.m_points.size() );
+}
+
+
+void SHAPE_LINE_CHAIN::moveArcs( const VECTOR2I& aVector )
+{
+    POINTS& points = mutableArcs();
+
+    for( VECTOR2I& p : points.m_points )
+        p += aVector;
+
+    for( CHAIN_ARC& arc : points.m_arcs )
+    {
+        arc.m_arc.Move( aVector );
+        arc.m_end = arc.m_arc.GetPolylinePoint( arc.m_segmentCount, arc.m_segmentCount );
+    }
+}
+
+
+const BOX2I SHAPE_LINE_CHAIN::arcsBBox() const
+{
+    BOX2I bbox;
+    bool  empty = m_points->m_points.empty();
+
+    if( !empty )
+        bbox.Compute( m_points->m_points );
+
+    for( const CHAIN_ARC& arc : m_points->m_arcs )
+    {
+        if( empty )
+            bbox = arcBBox( arc.m_arc );
+        else
+            bbox.Merge( arcBBox( arc.m_arc ) );
+
+        empty = false;
+    }
+
+    return bbox;
+}
+
+
 ClipperLib::Path SHAPE_LINE_CHAIN::convertToClipper( bool aRequiredOrientation ) const
 {
     ClipperLib::Path c_path;
@@ -57,32 +459,109 @@ bool SHAPE_LINE_CHAIN::Collide( const VECTOR2I& aP, int aClearance ) const
 
 void SHAPE_LINE_CHAIN::Rotate( double aAngle, const VECTOR2I& aCenter )
 {
-    for( std::vector<VECTOR2I>::iterator i = m_points.begin(); i != m_points.end(); ++i )
+    if( PointCount() == 0 )
+        return;
+
+    for( VECTOR2I& p : mutablePoints() )
     {
-        (*i) -= aCenter;
-        (*i) = (*i).Rotate( aAngle );
-        (*i) += aCenter;
+        p -= aCenter;
+        p = p.Rotate( aAngle );
+        p += aCenter;
     }
 }
 
 
 bool SHAPE_LINE_CHAIN::Collide( const SEG& aSeg, int aClearance ) const
 {
+    if( ArcCount() )
+        return collideArcs( aSeg, aClearance );
+
     BOX2I box_a( aSeg.A, aSeg.B - aSeg.A );
     BOX2I::ecoord_type dist_sq = (BOX2I::ecoord_type) aClearance * aClearance;
 
-    for( int i = 0; i < SegmentCount(); i++ )
+    auto collide = [&]( int aEdge ) -> bool
     {
-        const SEG& s = CSegment( i );
+        const SEG& s = CSegment( aEdge );
         BOX2I box_b( s.A, s.B - s.A );
 
         BOX2I::ecoord_type d = box_a.SquaredDistance( box_b );
 
-        if( d < dist_sq )
+        return d < dist_sq && s.Collide( aSeg, aClearance );
+    };
+
+    if( const SHAPE_LINE_CHAIN_EDGE_INDEX* index = edgeIndex() )
+    {
+        int  segCount = SegmentCount();
+        bool found = false;
+
+        index->Query( aSeg.A, aSeg.B, aClearance,
+                [&]( int aEdge )
+                {
+                    found = aEdge < segCount && collide( aEdge );
+                    return !found;
+                } );
+
+        return found;
+    }
+
+    for( int i = 0; i < SegmentCount(); i++ )
+    {
+        if( collide( i ) )
+            return true;
+    }
+
+    return false;
+}
+
+
+bool SHAPE_LINE_CHAIN::collideArcs( const SEG& aSeg, int aClearance ) const
+{
+    const POINTS&  points = *m_points;
+    const VECTOR2I* last = nullptr;
+    size_t         next = 0;
+
+    // The segments between the points, and from the last point before each arc to its first
+    // point
+    auto collideUntil = [&]( size_t aEnd, const VECTOR2I* aP ) -> bool
+    {
+        for( ; next < aEnd; next++ )
         {
-            if( s.Collide( aSeg, aClearance ) )
+            if( last && SEG( *last, points.m_points[next] ).Collide( aSeg, aClearance ) )
                 return true;
+
+            last = &points.m_points[next];
         }
+
+        return aP && last && SEG( *last, *aP ).Collide( aSeg, aClearance );
+    };
+
+    VECTOR2I first;
+
+    for( const CHAIN_ARC& arc : points.m_arcs )
+    {
+        VECTOR2I start = arc.m_arc.GetPolylinePoint( 0, arc.m_segmentCount );
+
+        if( collideUntil( arc.m_position, &start ) )
+            return true;
+
+        if( !last )
+            first = start;
+
+        if( arcCollide( arc.m_arc, aSeg, aClearance ) )
+            return true;
+
+        last = &arc.m_end;
+    }
+
+    if( collideUntil( points.m_points.size(), nullptr ) )
+        return true;
+
+    if( m_closed )
+    {
+        if( points.m_arcs.front().m_position > 0 )
+            first = points.m_points.front();
+
+        return SEG( *last, first ).Collide( aSeg, aClearance );
     }
 
     return false;
@@ -91,9 +570,10 @@ bool SHAPE_LINE_CHAIN::Collide( const SEG& aSeg, int aClearance ) const
 
 const SHAPE_LINE_CHAIN SHAPE_LINE_CHAIN::Reverse() const
 {
-    SHAPE_LINE_CHAIN a( *this );
+    SHAPE_LINE_CHAIN a;
 
-    reverse( a.m_points.begin(), a.m_points.end() );
+    a.m_points = std::make_shared<POINTS>(
+            std::vector<VECTOR2I>( points().rbegin(), points().rend() ) );
     a.m_closed = m_closed;
 
     return a;
@@ -119,12 +599,14 @@ void SHAPE_LINE_CHAIN::Replace( int aStartIndex, int aEndIndex, const VECTOR2I&
     if( aStartIndex < 0 )
         aStartIndex += PointCount();
 
+    std::vector<VECTOR2I>& points = mutablePoints();
+
     if( aStartIndex == aEndIndex )
-        m_points[aStartIndex] = aP;
+        points[aStartIndex] = aP;
     else
     {
-        m_points.erase( m_points.begin() + aStartIndex + 1, m_points.begin() + aEndIndex + 1 );
-        m_points[aStartIndex] = aP;
+        points.erase( points.begin() + aStartIndex + 1, points.begin() + aEndIndex + 1 );
+        points[aStartIndex] = aP;
     }
 }
 
@@ -137,8 +619,13 @@ void SHAPE_LINE_CHAIN::Replace( int aStartIndex, int aEndIndex, const SHAPE_LINE
     if( aStartIndex < 0 )
         aStartIndex += PointCount();
 
-    m_points.erase( m_points.begin() + aStartIndex, m_points.begin() + aEndIndex + 1 );
-    m_points.insert( m_points.begin() + aStartIndex, aLine.m_points.begin(), aLine.m_points.end() );
+    // aLine may be this chain: its points are kept alive until they are inserted
+    std::shared_ptr<POINTS>                lineStorage = aLine.m_points;
+    const std::vector<VECTOR2I>&           linePoints = aLine.points();
+    std::vector<VECTOR2I>&                 points = mutablePoints();
+
+    points.erase( points.begin() + aStartIndex, points.begin() + aEndIndex + 1 );
+    points.insert( points.begin() + aStartIndex, linePoints.begin(), linePoints.end() );
 }
 
 
@@ -150,19 +637,81 @@ void SHAPE_LINE_CHAIN::Remove( int aStartIndex, int aEndIndex )
     if( aStartIndex < 0 )
         aStartIndex += PointCount();
 
-    m_points.erase( m_points.begin() + aStartIndex, m_points.begin() + aEndIndex + 1 );
+    std::vector<VECTOR2I>& points = mutablePoints();
+
+    points.erase( points.begin() + aStartIndex, points.begin() + aEndIndex + 1 );
 }
 
 
-int SHAPE_LINE_CHAIN::Distance( const VECTOR2I& aP, bool aOutlineOnly ) const
+/**
+ * Returns the minimum of aDistance( edge ) over the edges of a chain, by searching the edge
+ * index in growing boxes around aA and aB: an edge closer than the margin of a box has its
+ * bounding box in it.
+ */
+template <class DISTANCE>
+static int indexedMinDistance( const SHAPE_LINE_CHAIN_EDGE_INDEX& aIndex, int aSegCount,
+                               const VECTOR2I& aA, const VECTOR2I& aB, DISTANCE aDistance )
 {
-    int d = INT_MAX;
+    // A start margin about the size of an edge, so that the first box holds a few edges
+    const BOX2I& bbox = aIndex.BBox();
+    int64_t      margin = std::max<int64_t>( 1, std::max( bbox.GetWidth(), bbox.GetHeight() )
+                                                        / std::max( 1, aSegCount ) );
+    int64_t maxMargin = (int64_t) INT_MAX * 4;
+    int     d = INT_MAX;
+
+    while( true )
+    {
+        aIndex.Query( aA, aB, margin,
+                [&]( int aEdge )
+                {
+                    if( aEdge < aSegCount )
+                        d = std::min( d, aDistance( aEdge ) );
+
+                    return d > 0;
+                } );
+
+        if( d <= margin || margin >= maxMargin )
+            return d;
 
+        // An edge was found: the next box is the last one needed
+        margin = ( d < INT_MAX ) ? d : margin * 4;
+    }
+}
+
+
+int SHAPE_LINE_CHAIN::Distance( const VECTOR2I& aP, bool aOutlineOnly ) const
+{
     if( IsClosed() && PointInside( aP ) && !aOutlineOnly )
         return 0;
 
-    for( int s = 0; s < SegmentCount(); s++ )
-        d = std::min( d, CSegment( s ).Distance( aP ) );
+    if( const SHAPE_LINE_CHAIN_EDGE_INDEX* index = edgeIndex() )
+    {
+        return indexedMinDistance( *index, SegmentCount(), aP, aP,
+                                   [&]( int aEdge )
+                                   {
+                                       return CSegment( aEdge ).Distance( aP );
+                                   } );
+    }
+
+    return EDGE_KERNELS::MinDistance( CPoints().data(), PointCount(), SegmentCount(), aP );
+}
+
+
+int SHAPE_LINE_CHAIN::Distance( const SEG& aSeg ) const
+{
+    int d = INT_MAX;
+
+    if( const SHAPE_LINE_CHAIN_EDGE_INDEX* index = edgeIndex() )
+    {
+        return indexedMinDistance( *index, SegmentCount(), aSeg.A, aSeg.B,
+                                   [&]( int aEdge )
+                                   {
+                                       return CSegment( aEdge ).Distance( aSeg );
+                                   } );
+    }
+
+    for( int s = 0; s < SegmentCount() && d > 0; s++ )
+        d = std::min( d, CSegment( s ).Distance( aSeg ) );
 
     return d;
 }
@@ -197,7 +746,9 @@ int SHAPE_LINE_CHAIN::Split( const VECTOR2I& aP )
 
     if( ii >= 0 )
     {
-        m_points.insert( m_points.begin() + ii + 1, aP );
+        std::vector<VECTOR2I>& points = mutablePoints();
+
+        points.insert( points.begin() + ii + 1, aP );
 
         return ii + 1;
     }
@@ -237,7 +788,7 @@ const SHAPE_LINE_CHAIN SHAPE_LINE_CHAIN::Slice( int aStartIndex, int aEndIndex )
         aStartIndex += PointCount();
 
     for( int i = aStartIndex; i <= aEndIndex; i++ )
-        rv.Append( m_points[i] );
+        rv.Append( CPoint( i ) );
 
     return rv;
 }
@@ -377,10 +928,10 @@ bool SHAPE_LINE_CHAIN::PointInside( const VECTOR2I& aPt, int aAccuracy, bool aUs
     const std::vector<VECTOR2I>& points = CPoints();
     int pointCount = points.size();
 
-    for( int i = 0; i < pointCount; )
+    auto crossEdge = [&]( int aEdge )
     {
-        const auto p1 = points[ i++ ];
-        const auto p2 = points[ i == pointCount ? 0 : i ];
+        const auto p1 = points[ aEdge ];
+        const auto p2 = points[ aEdge + 1 == pointCount ? 0 : aEdge + 1 ];
         const auto diff = p2 - p1;
 
         if( diff.y != 0 )
@@ -390,6 +941,24 @@ bool SHAPE_LINE_CHAIN::PointInside( const VECTOR2I& aPt, int aAccuracy, bool aUs
             if( ( ( p1.y > aPt.y ) != ( p2.y > aPt.y ) ) && ( aPt.x - p1.x < d ) )
                 inside = !inside;
         }
+    };
+
+    if( const SHAPE_LINE_CHAIN_EDGE_INDEX* index = edgeIndex() )
+    {
+        // Only the edges whose bounding box crosses the ray can be crossed
+        VECTOR2I rayEnd( std::max( aPt.x, index->BBox().GetRight() ), aPt.y );
+
+        index->Query( aPt - VECTOR2I( 1, 0 ), rayEnd, 0,
+                [&]( int aEdge )
+                {
+                    crossEdge( aEdge );
+                    return true;
+                } );
+    }
+    else
+    {
+        // Same test as crossEdge(), on several edges at a time
+        inside = EDGE_KERNELS::OddRayCrossings( points.data(), pointCount, aPt );
     }
 
     // If accuracy is 0 then we need to make sure the point isn't actually on the edge.
@@ -417,18 +986,38 @@ int SHAPE_LINE_CHAIN::EdgeContainingPoint( const VECTOR2I& aPt, int aAccuracy )
 
 	else if( PointCount() == 1 )
     {
-	    VECTOR2I dist = m_points[0] - aPt;
+	    VECTOR2I dist = CPoint( 0 ) - aPt;
 	    return ( hypot( dist.x, dist.y ) <= aAccuracy + 1 ) ? 0 : -1;
     }
 
-    for( int i = 0; i < SegmentCount(); i++ )
+    auto containsPoint = [&]( int aEdge )
     {
-        const SEG s = CSegment( i );
+        const SEG s = CSegment( aEdge );
 
-        if( s.A == aPt || s.B == aPt )
-            return i;
+        return s.A == aPt || s.B == aPt || s.Distance( aPt ) <= aAccuracy + 1;
+    };
+
+    if( const SHAPE_LINE_CHAIN_EDGE_INDEX* index = edgeIndex() )
+    {
+        // The first edge containing the point is returned, as by the linear search
+        int segCount = SegmentCount();
+        int found = -1;
 
-        if( s.Distance( aPt ) <= aAccuracy + 1 )
+        index->Query( aPt, aPt, (int64_t) aAccuracy + 2,
+                [&]( int aEdge )
+                {
+                    if( aEdge < segCount && ( found < 0 || aEdge < found ) && containsPoint( aEdge ) )
+                        found = aEdge;
+
+                    return true;
+                } );
+
+        return found;
+    }
+
+    for( int i = 0; i < SegmentCount(); i++ )
+    {
+        if( containsPoint( i ) )
             return i;
     }
 
@@ -442,16 +1031,33 @@ bool SHAPE_LINE_CHAIN::CheckClearance( const VECTOR2I& aP, const int aDist) cons
         return false;
 
     else if( PointCount() == 1 )
-        return m_points[0] == aP;
+        return CPoint( 0 ) == aP;
 
-    for( int i = 0; i < SegmentCount(); i++ )
+    auto closeTo = [&]( int aEdge )
     {
-        const SEG s = CSegment( i );
+        const SEG s = CSegment( aEdge );
 
-        if( s.A == aP || s.B == aP )
-            return true;
+        return s.A == aP || s.B == aP || s.Distance( aP ) <= aDist;
+    };
 
-        if( s.Distance( aP ) <= aDist )
+    if( const SHAPE_LINE_CHAIN_EDGE_INDEX* index = edgeIndex() )
+    {
+        int  segCount = SegmentCount();
+        bool found = false;
+
+        index->Query( aP, aP, (int64_t) aDist + 1,
+                [&]( int aEdge )
+                {
+                    found = aEdge < segCount && closeTo( aEdge );
+                    return !found;
+                } );
+
+        return found;
+    }
+
+    for( int i = 0; i < SegmentCount(); i++ )
+    {
+        if( closeTo( i ) )
             return true;
     }
 
@@ -517,8 +1123,8 @@ SHAPE_LINE_CHAIN& SHAPE_LINE_CHAIN::Simplify()
     }
     else if( PointCount() == 2 )
     {
-        if( m_points[0] == m_points[1] )
-            m_points.pop_back();
+        if( CPoint( 0 ) == CPoint( 1 ) )
+            mutablePoints().pop_back();
 
         return *this;
     }
@@ -538,7 +1144,9 @@ SHAPE_LINE_CHAIN& SHAPE_LINE_CHAIN::Simplify()
         i = j;
     }
 
-    m_points.clear();
+    // The simplified points replace the points, which may be shared with other chains
+    m_points = std::make_shared<POINTS>();
+    std::vector<VECTOR2I>& points = m_points->m_points;
     np = pts_unique.size();
 
     i = 0;
@@ -553,14 +1161,14 @@ SHAPE_LINE_CHAIN& SHAPE_LINE_CHAIN::Simplify()
         while( n < np - 2 && SEG( p0, p1 ).LineDistance( pts_unique[n + 2] ) <= 1 )
             n++;
 
-        m_points.push_back( p0 );
+        points.push_back( p0 );
 
         if( n > i )
             i = n;
 
         if( n == np )
         {
-            m_points.push_back( pts_unique[n - 1] );
+            points.push_back( pts_unique[n - 1] );
             return *this;
         }
 
@@ -568,9 +1176,9 @@ SHAPE_LINE_CHAIN& SHAPE_LINE_CHAIN::Simplify()
     }
 
     if( np > 1 )
-        m_points.push_back( pts_unique[np - 2] );
+        points.push_back( pts_unique[np - 2] );
 
-    m_points.push_back( pts_unique[np - 1] );
+    points.push_back( pts_unique[np - 1] );
 
     return *this;
 }
@@ -620,10 +1228,10 @@ const std::string SHAPE_LINE_CHAIN::Format() const
 {
     std::stringstream ss;
 
-    ss << m_points.size() << " " << ( m_closed ? 1 : 0 ) << " ";
+    ss << PointCount() << " " << ( m_closed ? 1 : 0 ) << " ";
 
     for( int i = 0; i < PointCount(); i++ )
-        ss << m_points[i].x << " " << m_points[i].y << " "; // Format() << " ";
+        ss << CPoint( i ).x << " " << CPoint( i ).y << " "; // Format() << " ";
 
     return ss.str();
 }
@@ -635,7 +1243,7 @@ bool SHAPE_LINE_CHAIN::CompareGeometry ( const SHAPE_LINE_CHAIN & aOther ) const
     a.Simplify();
     b.Simplify();
 
-    if( a.m_points.size() != b.m_points.size() )
+    if( a.PointCount() != b.PointCount() )
         return false;
 
     for( int i = 0; i < a.PointCount(); i++)
@@ -661,7 +1269,7 @@ bool SHAPE_LINE_CHAIN::Parse( std::stringstream& aStream )
 {
     int n_pts;
 
-    m_points.clear();
+    m_points.reset();
     aStream >> n_pts;
 
     // Rough sanity check, just make sure the loop bounds aren't absolutely outlandish
@@ -675,7 +1283,7 @@ bool SHAPE_LINE_CHAIN::Parse( std::stringstream& aStream )
         int x, y;
         aStream >> x;
         aStream >> y;
-        m_points.push_back( VECTOR2I( x, y ) );
+        mutablePoints().push_back( VECTOR2I( x, y ) );
     }
 
     return true;
@@ -713,12 +1321,13 @@ double SHAPE_LINE_CHAIN::Area() const
     if( !m_closed )
         return 0.0;
 
+    const std::vector<VECTOR2I>& pts = points();
     double area = 0.0;
-    int size = m_points.size();
+    int size = pts.size();
 
     for( int i = 0, j = size - 1; i < size; ++i )
     {
-        area += ( (double) m_points[j].x + m_points[i].x ) * ( (double) m_points[j].y - m_points[i].y );
+        area += ( (double) pts[j].x + pts[i].x ) * ( (double) pts[j].y - pts[i].y );
         j = i;
     }
 
@@ -32,12 +32,18 @@
 #include <set>
 #include <list>
 #include <algorithm>
+#include <climits>
+#include <deque>
+#include <unordered_map>
 #include <unordered_set>
 #include <memory>
 
 #include <md5_hash.h>
 #include <map>
 
+#include <advanced_config.h>
+#include <thread_pool.h>
+
 #include <make_unique.h>
 
 #include <geometry/geometry_utils.h>
@@ -45,6 +51,7 @@
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_poly_set.h>
 #include <geometry/polygon_triangulation.h>
+#include <geometry/rtree.h>
 
 using namespace ClipperLib;
 
@@ -59,13 +66,41 @@ SHAPE_POLY_SET::SHAPE_POLY_SET( const SHAPE_POLY_SET& aOther, bool aDeepCopy ) :
 {
     if( aOther.IsTriangulationUpToDate() )
     {
-        for( unsigned i = 0; i < aOther.TriangulatedPolyCount(); i++ )
-            m_triangulatedPolys.push_back(
-                    std::make_unique<TRIANGULATED_POLYGON>( *aOther.TriangulatedPolygon( i ) ) );
+        // The triangulations are never changed once built, so they are shared by default
+        if( aDeepCopy )
+        {
+            for( unsigned i = 0; i < aOther.TriangulatedPolyCount(); i++ )
+                m_triangulatedPolys.push_back(
+                        std::make_shared<TRIANGULATED_POLYGON>( *aOther.TriangulatedPolygon( i ) ) );
+        }
+        else
+        {
+            m_triangulatedPolys = aOther.m_triangulatedPolys;
+            m_polyTriangulations = aOther.m_polyTriangulations;
+        }
 
         m_hash = aOther.GetHash();
         m_triangulationValid = true;
     }
+    else if( !aDeepCopy )
+    {
+        // The copy can still reuse the triangulation of the unchanged polygons
+        m_polyTriangulations = aOther.m_polyTriangulations;
+    }
+}
+
+
+SHAPE_POLY_SET::SHAPE_POLY_SET( SHAPE_POLY_SET&& aOther ) noexcept :
+    SHAPE( SH_POLY_SET ),
+    m_polys( std::move( aOther.m_polys ) ),
+    m_triangulatedPolys( std::move( aOther.m_triangulatedPolys ) ),
+    m_polyTriangulations( std::move( aOther.m_polyTriangulations ) ),
+    m_triangulationValid( aOther.m_triangulationValid ),
+    m_hash( aOther.m_hash )
+{
+    aOther.m_polyTriangulations.clear();
+    aOther.m_triangulationValid = false;
+    aOther.m_hash = MD5_HASH{};
 }
 
 
@@ -91,11 +126,11 @@ bool SHAPE_POLY_SET::GetRelativeIndices( int aGlobalIdx,
 
     for( polygonIdx = 0; polygonIdx < OutlineCount(); polygonIdx++ )
     {
-        const POLYGON currentPolygon = CPolygon( polygonIdx );
+        const POLYGON& currentPolygon = CPolygon( polygonIdx );
 
         for( contourIdx = 0; contourIdx < currentPolygon.size(); contourIdx++ )
         {
-            SHAPE_LINE_CHAIN currentContour = currentPolygon[contourIdx];
+            const SHAPE_LINE_CHAIN& currentContour = currentPolygon[contourIdx];
             int totalPoints = currentContour.PointCount();
 
             for( vertexIdx = 0; vertexIdx < totalPoints; vertexIdx++ )
@@ -169,8 +204,8 @@ int SHAPE_POLY_SET::NewOutline()
     POLYGON poly;
 
     empty_path.SetClosed( true );
-    poly.push_back( empty_path );
-    m_polys.push_back( poly );
+    poly.push_back( std::move( empty_path ) );
+    m_polys.push_back( std::move( poly ) );
     return m_polys.size() - 1;
 }
 
@@ -260,16 +295,14 @@ int SHAPE_POLY_SET::VertexCount( int aOutline, int aHole  ) const
 }
 
 
-SHAPE_POLY_SET SHAPE_POLY_SET::Subset( int aFirstPolygon, int aLastPolygon )
+SHAPE_POLY_SET SHAPE_POLY_SET::Subset( int aFirstPolygon, int aLastPolygon ) const
 {
     assert( aFirstPolygon >= 0 && aLastPolygon <= OutlineCount() );
 
     SHAPE_POLY_SET newPolySet;
 
-    for( int index = aFirstPolygon; index < aLastPolygon; index++ )
-    {
-        newPolySet.m_polys.push_back( Polygon( index ) );
-    }
+    // The contours share their points with this set
+    newPolySet.m_polys.assign( m_polys.begin() + aFirstPolygon, m_polys.begin() + aLastPolygon );
 
     return newPolySet;
 }
@@ -443,7 +476,7 @@ int SHAPE_POLY_SET::AddOutline( const SHAPE_LINE_CHAIN& aOutline )
 
     poly.push_back( aOutline );
 
-    m_polys.push_back( poly );
+    m_polys.push_back( std::move( poly ) );
 
     return m_polys.size() - 1;
 }
@@ -477,6 +510,28 @@ void SHAPE_POLY_SET::booleanOp( ClipperLib::ClipType aType,
         const SHAPE_POLY_SET& aShape,
         const SHAPE_POLY_SET& aOtherShape,
         POLYGON_MODE aFastMode )
+{
+    int minPoints = ADVANCED_CFG::GetCfg().m_parallelBooleanMinPoints;
+
+    // A xor does not split: its result depends on all the polygons at each point.  The
+    // choice does not depend on the thread count, so that the results (fills, plots...)
+    // are the same on all machines.
+    if( aType != ctXor && minPoints > 0
+            && aShape.TotalVertices() + aOtherShape.TotalVertices() >= minPoints )
+    {
+        parallelBooleanOp( aType, aShape, aOtherShape, aFastMode );
+    }
+    else
+    {
+        clipperBooleanOp( aType, aShape, aOtherShape, aFastMode );
+    }
+}
+
+
+void SHAPE_POLY_SET::clipperBooleanOp( ClipperLib::ClipType aType,
+        const SHAPE_POLY_SET& aShape,
+        const SHAPE_POLY_SET& aOtherShape,
+        POLYGON_MODE aFastMode )
 {
     Clipper c;
 
@@ -502,6 +557,272 @@ void SHAPE_POLY_SET::booleanOp( ClipperLib::ClipType aType,
 }
 
 
+void SHAPE_POLY_SET::BandedBooleanOp( ClipperLib::ClipType aType,
+        const SHAPE_POLY_SET& a,
+        const SHAPE_POLY_SET& b,
+        POLYGON_MODE aFastMode,
+        size_t aMaxThreads )
+{
+    assert( aType != ctXor );
+
+    parallelBooleanOp( aType, a, b, aFastMode, aMaxThreads );
+}
+
+
+void SHAPE_POLY_SET::parallelBooleanOp( ClipperLib::ClipType aType,
+        const SHAPE_POLY_SET& aShape,
+        const SHAPE_POLY_SET& aOtherShape,
+        POLYGON_MODE aFastMode,
+        size_t aMaxThreads )
+{
+    struct ITEM
+    {
+        const POLYGON* m_poly;
+        BOX2I          m_bbox;
+        int            m_points;
+    };
+
+    auto makeItems = []( const SHAPE_POLY_SET& aSet, std::vector<ITEM>& aItems )
+    {
+        for( const POLYGON& poly : aSet.m_polys )
+        {
+            if( poly.empty() )
+                continue;
+
+            ITEM item = { &poly, poly[0].BBox(), 0 };
+
+            for( const SHAPE_LINE_CHAIN& path : poly )
+                item.m_points += path.PointCount();
+
+            aItems.push_back( item );
+        }
+    };
+
+    std::vector<ITEM> items;
+    std::vector<ITEM> others;
+
+    makeItems( aShape, items );
+    makeItems( aOtherShape, aType == ctUnion ? items : others );
+
+    // A few bands per thread of usual machines, to even out their costs.  The split gives
+    // the polygon and vertex order of the result: it must not depend on the machine.
+    const size_t bandCount = 16;
+
+    // When aShape has too few polygons to fill the bands, such as a zone outline minus the
+    // pads, it is cut into strips spreading the polygons of aOtherShape.  The polygons of a
+    // union are not cut: the strips would have to be merged before the union.
+    bool strips = items.size() < bandCount;
+
+    if( items.empty() || ( strips && ( aType == ctUnion || others.size() < bandCount ) ) )
+    {
+        clipperBooleanOp( aType, aShape, aOtherShape, aFastMode );
+        return;
+    }
+
+    BOX2I extent = items[0].m_bbox;
+
+    for( const ITEM& item : items )
+        extent.Merge( item.m_bbox );
+
+    extent.Inflate( 1 );
+
+    bool alongX = extent.GetWidth() >= extent.GetHeight();
+
+    auto center = [alongX]( const BOX2I& aBox )
+    {
+        return alongX ? aBox.Centre().x : aBox.Centre().y;
+    };
+
+    // The polygons split into bands of about the same number of points
+    std::vector<ITEM>& banded = strips ? others : items;
+    int                totalPoints = 0;
+
+    std::sort( banded.begin(), banded.end(),
+               [&]( const ITEM& aA, const ITEM& aB )
+               {
+                   return center( aA.m_bbox ) < center( aB.m_bbox );
+               } );
+
+    for( const ITEM& item : banded )
+        totalPoints += item.m_points;
+
+    int                         bandPoints = std::max( 1, (int) ( totalPoints / bandCount ) );
+    std::vector<SHAPE_POLY_SET> subjects( 1 );
+    std::vector<BOX2I>          bandBoxes( 1, banded[0].m_bbox );
+    int                         points = 0;
+
+    for( const ITEM& item : banded )
+    {
+        if( points >= bandPoints * (int) subjects.size() && subjects.size() < bandCount )
+        {
+            subjects.emplace_back();
+            bandBoxes.push_back( item.m_bbox );
+        }
+
+        if( !strips )
+            subjects.back().m_polys.push_back( *item.m_poly );
+
+        bandBoxes.back().Merge( item.m_bbox );
+        points += item.m_points;
+    }
+
+    if( strips )
+    {
+        // The strips cross the whole extent, and are cut between the bands of polygons
+        std::vector<int> cuts = { alongX ? extent.GetX() : extent.GetY() };
+
+        for( size_t ii = 1; ii < bandBoxes.size(); ++ii )
+        {
+            int cut = center( bandBoxes[ii] );
+
+            if( cut > cuts.back() && cut < ( alongX ? extent.GetRight() : extent.GetBottom() ) )
+                cuts.push_back( cut );
+        }
+
+        cuts.push_back( alongX ? extent.GetRight() : extent.GetBottom() );
+
+        subjects.assign( cuts.size() - 1, SHAPE_POLY_SET() );
+        bandBoxes.clear();
+
+        for( size_t ii = 0; ii + 1 < cuts.size(); ++ii )
+        {
+            if( alongX )
+            {
+                bandBoxes.emplace_back( VECTOR2I( cuts[ii], extent.GetY() ),
+                                        VECTOR2I( cuts[ii + 1] - cuts[ii], extent.GetHeight() ) );
+            }
+            else
+            {
+                bandBoxes.emplace_back( VECTOR2I( extent.GetX(), cuts[ii] ),
+                                        VECTOR2I( extent.GetWidth(), cuts[ii + 1] - cuts[ii] ) );
+            }
+        }
+    }
+
+    std::vector<SHAPE_POLY_SET> results( subjects.size() );
+
+    THREAD_POOL::GetPool().ParallelFor( subjects.size(),
+            [&]( size_t aBand )
+            {
+                const BOX2I& box = bandBoxes[aBand];
+
+                if( strips )
+                {
+                    SHAPE_POLY_SET strip;
+
+                    strip.NewOutline();
+                    strip.Append( box.GetX(), box.GetY() );
+                    strip.Append( box.GetRight(), box.GetY() );
+                    strip.Append( box.GetRight(), box.GetBottom() );
+                    strip.Append( box.GetX(), box.GetBottom() );
+
+                    subjects[aBand].clipperBooleanOp( ctIntersection, aShape, strip, aFastMode );
+                }
+
+                // The polygons not overlapping the band do not change its result.  The box is
+                // inflated to keep the ones touching it.
+                SHAPE_POLY_SET clips;
+                BOX2I          clipBox = box;
+
+                clipBox.Inflate( 1 );
+
+                for( const ITEM& other : others )
+                {
+                    if( clipBox.Intersects( other.m_bbox ) )
+                        clips.m_polys.push_back( *other.m_poly );
+                }
+
+                results[aBand].clipperBooleanOp( aType, subjects[aBand], clips, aFastMode );
+            },
+            1, aMaxThreads );
+
+    // The bands are merged with their neighbours, so that most of their polygons are away
+    // from the other band
+    while( results.size() > 1 )
+    {
+        std::vector<SHAPE_POLY_SET> merged( ( results.size() + 1 ) / 2 );
+
+        THREAD_POOL::GetPool().ParallelFor( merged.size(),
+                [&]( size_t aPair )
+                {
+                    if( 2 * aPair + 1 < results.size() )
+                    {
+                        merged[aPair].mergeBands( results[2 * aPair], results[2 * aPair + 1],
+                                                  alongX, aFastMode );
+                    }
+                    else
+                    {
+                        merged[aPair] = std::move( results[2 * aPair] );
+                    }
+                },
+                1, aMaxThreads );
+
+        results = std::move( merged );
+    }
+
+    m_polys = std::move( results[0].m_polys );
+}
+
+
+void SHAPE_POLY_SET::mergeBands( const SHAPE_POLY_SET& aA, const SHAPE_POLY_SET& aB,
+                                 bool aAlongX, POLYGON_MODE aFastMode )
+{
+    auto start = [aAlongX]( const BOX2I& aBox )
+    {
+        return aAlongX ? aBox.GetX() : aBox.GetY();
+    };
+
+    auto end = [aAlongX]( const BOX2I& aBox )
+    {
+        return aAlongX ? aBox.GetRight() : aBox.GetBottom();
+    };
+
+    int aEnd = INT_MIN;
+    int bStart = INT_MAX;
+
+    for( const POLYGON& poly : aA.m_polys )
+        aEnd = std::max( aEnd, end( poly[0].BBox() ) );
+
+    for( const POLYGON& poly : aB.m_polys )
+        bStart = std::min( bStart, start( poly[0].BBox() ) );
+
+    SHAPE_POLY_SET seamA;
+    SHAPE_POLY_SET seamB;
+
+    m_polys.clear();
+
+    // The polygons of each set do not overlap each other: the ones away from the other set
+    // by more than a unit are already part of the union
+    for( const POLYGON& poly : aA.m_polys )
+    {
+        if( (int64_t) end( poly[0].BBox() ) + 1 < bStart )
+            m_polys.push_back( poly );
+        else
+            seamA.m_polys.push_back( poly );
+    }
+
+    for( const POLYGON& poly : aB.m_polys )
+    {
+        if( (int64_t) start( poly[0].BBox() ) - 1 > aEnd )
+            m_polys.push_back( poly );
+        else
+            seamB.m_polys.push_back( poly );
+    }
+
+    if( seamA.m_polys.empty() || seamB.m_polys.empty() )
+    {
+        m_polys.insert( m_polys.end(), seamA.m_polys.begin(), seamA.m_polys.end() );
+        m_polys.insert( m_polys.end(), seamB.m_polys.begin(), seamB.m_polys.end() );
+        return;
+    }
+
+    SHAPE_POLY_SET seam;
+
+    seam.clipperBooleanOp( ctUnion, seamA, seamB, aFastMode );
+    m_polys.insert( m_polys.end(), seam.m_polys.begin(), seam.m_polys.end() );
+}
+
+
 void SHAPE_POLY_SET::BooleanAdd( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode )
 {
     booleanOp( ctUnion, b, aFastMode );
@@ -622,7 +943,7 @@ void SHAPE_POLY_SET::importTree( PolyTree* tree )
             for( unsigned int i = 0; i < n->Childs.size(); i++ )
                 paths.push_back( n->Childs[i]->Contour );
 
-            m_polys.push_back( paths );
+            m_polys.push_back( std::move( paths ) );
         }
     }
 }
@@ -630,18 +951,12 @@ void SHAPE_POLY_SET::importTree( PolyTree* tree )
 
 struct FractureEdge
 {
-    FractureEdge( int y = 0 ) :
-        m_connected( false ),
-        m_next( NULL )
-    {
-        m_p1.x = m_p2.y = y;
-    }
-
-    FractureEdge( bool connected, const VECTOR2I& p1, const VECTOR2I& p2 ) :
+    FractureEdge( bool connected, const VECTOR2I& p1, const VECTOR2I& p2, int index ) :
         m_connected( connected ),
         m_p1( p1 ),
         m_p2( p2 ),
-        m_next( NULL )
+        m_next( NULL ),
+        m_index( index )
     {
     }
 
@@ -653,58 +968,124 @@ struct FractureEdge
     bool m_connected;
     VECTOR2I m_p1, m_p2;
     FractureEdge* m_next;
+    int m_index;        ///< creation order, which breaks the ties between the nearest edges
 };
 
 
-typedef std::vector<FractureEdge*> FractureEdgeSet;
+/**
+ * The edges of a polygon being fractured.  The connected edges (the outline, and the holes
+ * already bridged to it) are in an R-tree, to find the edge left of a hole in logarithmic
+ * time instead of testing all the edges.
+ */
+class FRACTURE_EDGES
+{
+public:
+    FRACTURE_EDGES( const BOX2I& aOutlineBBox ) :
+        m_xMin( aOutlineBBox.GetX() ),
+        m_initialWindow( std::max<int64_t>( aOutlineBBox.GetWidth() / 1024, 1 ) )
+    {
+    }
 
+    FractureEdge* Add( bool aConnected, const VECTOR2I& aP1, const VECTOR2I& aP2 )
+    {
+        m_edges.emplace_back( false, aP1, aP2, (int) m_edges.size() );
 
-static int processEdge( FractureEdgeSet& edges, FractureEdge* edge )
-{
-    int x   = edge->m_p1.x;
-    int y   = edge->m_p1.y;
-    int min_dist    = std::numeric_limits<int>::max();
-    int x_nearest   = 0;
+        if( aConnected )
+            Connect( &m_edges.back() );
 
-    FractureEdge* e_nearest = NULL;
+        return &m_edges.back();
+    }
 
-    for( FractureEdgeSet::iterator i = edges.begin(); i != edges.end(); ++i )
+    void Connect( FractureEdge* aEdge )
     {
-        if( !(*i)->matches( y ) )
-            continue;
+        aEdge->m_connected = true;
 
-        int x_intersect;
+        int min[2] = { std::min( aEdge->m_p1.x, aEdge->m_p2.x ),
+                       std::min( aEdge->m_p1.y, aEdge->m_p2.y ) };
+        int max[2] = { std::max( aEdge->m_p1.x, aEdge->m_p2.x ),
+                       std::max( aEdge->m_p1.y, aEdge->m_p2.y ) };
 
-        if( (*i)->m_p1.y == (*i)->m_p2.y ) // horizontal edge
-            x_intersect = std::max( (*i)->m_p1.x, (*i)->m_p2.x );
-        else
-            x_intersect = (*i)->m_p1.x + rescale( (*i)->m_p2.x - (*i)->m_p1.x, y - (*i)->m_p1.y,
-                    (*i)->m_p2.y - (*i)->m_p1.y );
+        m_connected.Insert( min, max, aEdge );
+    }
+
+    /**
+     * Finds the connected edge crossed first by a ray going from aP towards -x, the first
+     * created one if several edges are crossed at the same point.
+     * @return the edge or nullptr, and the x of the crossing in aXNearest
+     */
+    FractureEdge* Nearest( const VECTOR2I& aP, int& aXNearest )
+    {
+        FractureEdge* nearest = nullptr;
+        int           minDist = std::numeric_limits<int>::max();
+
+        auto visitor = [&]( FractureEdge* aEdge ) -> bool
+        {
+            if( !aEdge->matches( aP.y ) )
+                return true;
+
+            int x_intersect;
+
+            if( aEdge->m_p1.y == aEdge->m_p2.y ) // horizontal edge
+                x_intersect = std::max( aEdge->m_p1.x, aEdge->m_p2.x );
+            else
+                x_intersect = aEdge->m_p1.x + rescale( aEdge->m_p2.x - aEdge->m_p1.x,
+                                                       aP.y - aEdge->m_p1.y,
+                                                       aEdge->m_p2.y - aEdge->m_p1.y );
+
+            int dist = ( aP.x - x_intersect );
 
-        int dist = ( x - x_intersect );
+            if( dist >= 0 && ( dist < minDist
+                               || ( dist == minDist && aEdge->m_index < nearest->m_index ) ) )
+            {
+                minDist = dist;
+                aXNearest = x_intersect;
+                nearest = aEdge;
+            }
+
+            return true;
+        };
 
-        if( dist >= 0 && dist < min_dist && (*i)->m_connected )
+        // Edges crossed at a distance d are in any window wider than d: search windows
+        // of increasing widths, until the nearest edge is within the window.  The edges
+        // which were shortened after their insertion are still found, with the bounding
+        // box of their full length.
+        for( int64_t window = m_initialWindow; ; window *= 2 )
         {
-            min_dist    = dist;
-            x_nearest   = x_intersect;
-            e_nearest   = (*i);
+            int min[2] = { (int) std::max<int64_t>( (int64_t) aP.x - window, INT_MIN ), aP.y };
+            int max[2] = { aP.x, aP.y };
+
+            m_connected.Search( min, max, visitor );
+
+            if( ( nearest && minDist <= window ) || min[0] <= m_xMin )
+                return nearest;
         }
     }
 
+    ///> All the edges, in creation order
+    std::deque<FractureEdge>               m_edges;
+
+private:
+    RTree<FractureEdge*, int, 2, double>   m_connected;
+    int                                    m_xMin;
+    int64_t                                m_initialWindow;
+};
+
+
+static int processEdge( FRACTURE_EDGES& edges, FractureEdge* edge )
+{
+    int x   = edge->m_p1.x;
+    int y   = edge->m_p1.y;
+    int x_nearest   = 0;
+
+    FractureEdge* e_nearest = edges.Nearest( VECTOR2I( x, y ), x_nearest );
+
     if( e_nearest && e_nearest->m_connected )
     {
         int count = 0;
 
-        FractureEdge* lead1 =
-            new FractureEdge( true, VECTOR2I( x_nearest, y ), VECTOR2I( x, y ) );
-        FractureEdge* lead2 =
-            new FractureEdge( true, VECTOR2I( x, y ), VECTOR2I( x_nearest, y ) );
-        FractureEdge* split_2 =
-            new FractureEdge( true, VECTOR2I( x_nearest, y ), e_nearest->m_p2 );
-
-        edges.push_back( split_2 );
-        edges.push_back( lead1 );
-        edges.push_back( lead2 );
+        FractureEdge* split_2 = edges.Add( true, VECTOR2I( x_nearest, y ), e_nearest->m_p2 );
+        FractureEdge* lead1 = edges.Add( true, VECTOR2I( x_nearest, y ), VECTOR2I( x, y ) );
+        FractureEdge* lead2 = edges.Add( true, VECTOR2I( x, y ), VECTOR2I( x_nearest, y ) );
 
         FractureEdge* link = e_nearest->m_next;
 
@@ -716,11 +1097,11 @@ static int processEdge( FractureEdgeSet& edges, FractureEdge* edge )
 
         for( last = edge; last->m_next != edge; last = last->m_next )
         {
-            last->m_connected = true;
+            edges.Connect( last );
             count++;
         }
 
-        last->m_connected = true;
+        edges.Connect( last );
         last->m_next    = lead2;
         lead2->m_next   = split_2;
         split_2->m_next = link;
@@ -734,8 +1115,6 @@ static int processEdge( FractureEdgeSet& edges, FractureEdge* edge )
 
 void SHAPE_POLY_SET::fractureSingle( POLYGON& paths )
 {
-    FractureEdgeSet edges;
-    FractureEdgeSet border_edges;
     FractureEdge*   root = NULL;
 
     bool first = true;
@@ -743,14 +1122,18 @@ void SHAPE_POLY_SET::fractureSingle( POLYGON& paths )
     if( paths.size() == 1 )
         return;
 
-    int num_unconnected = 0;
+    FRACTURE_EDGES edges( paths[0].BBox() );
+
+    // The left-most edge of each hole, sorted by x: the holes are merged with the outline
+    // from left to right
+    std::vector<FractureEdge*> border_edges;
 
     for( const SHAPE_LINE_CHAIN& path : paths )
     {
         const std::vector<VECTOR2I>& points = path.CPoints();
         int pointCount = points.size();
 
-        FractureEdge* prev = NULL, * first_edge = NULL;
+        FractureEdge* prev = NULL, * first_edge = NULL, * border_edge = NULL;
 
         int x_min = std::numeric_limits<int>::max();
 
@@ -764,8 +1147,8 @@ void SHAPE_POLY_SET::fractureSingle( POLYGON& paths )
         {
             // Do not use path.CPoint() here; open-coding it using the local variables "points"
             // and "pointCount" gives a non-trivial performance boost to zone fill times.
-            FractureEdge* fe = new FractureEdge( first, points[ i ],
-                                                        points[ i+1 == pointCount ? 0 : i+1 ] );
+            FractureEdge* fe = edges.Add( first, points[ i ],
+                                          points[ i+1 == pointCount ? 0 : i+1 ] );
 
             if( !root )
                 root = fe;
@@ -780,42 +1163,26 @@ void SHAPE_POLY_SET::fractureSingle( POLYGON& paths )
                 fe->m_next = first_edge;
 
             prev = fe;
-            edges.push_back( fe );
 
-            if( !first )
-            {
-                if( fe->m_p1.x == x_min )
-                    border_edges.push_back( fe );
-            }
-
-            if( !fe->m_connected )
-                num_unconnected++;
+            if( !first && !border_edge && fe->m_p1.x == x_min )
+                border_edge = fe;
         }
 
+        if( border_edge )
+            border_edges.push_back( border_edge );
+
         first = false;    // first path is always the outline
     }
 
-    // keep connecting holes to the main outline, until there's no holes left...
-    while( num_unconnected > 0 )
-    {
-        int x_min = std::numeric_limits<int>::max();
-
-        FractureEdge* smallestX = NULL;
+    std::stable_sort( border_edges.begin(), border_edges.end(),
+                      []( const FractureEdge* aA, const FractureEdge* aB )
+                      {
+                          return aA->m_p1.x < aB->m_p1.x;
+                      } );
 
-        // find the left-most hole edge and merge with the outline
-        for( FractureEdge* border_edge : border_edges )
-        {
-            int xt = border_edge->m_p1.x;
-
-            if( ( xt < x_min ) && !border_edge->m_connected )
-            {
-                x_min = xt;
-                smallestX = border_edge;
-            }
-        }
-
-        num_unconnected -= processEdge( edges, smallestX );
-    }
+    // keep connecting holes to the main outline, until there's no holes left...
+    for( FractureEdge* border_edge : border_edges )
+        processEdge( edges, border_edge );
 
     paths.clear();
     SHAPE_LINE_CHAIN newPath;
@@ -829,9 +1196,6 @@ void SHAPE_POLY_SET::fractureSingle( POLYGON& paths )
 
     newPath.Append( e->m_p1 );
 
-    for( FractureEdge* edge : edges )
-        delete edge;
-
     paths.push_back( std::move( newPath ) );
 }
 
@@ -1149,10 +1513,10 @@ bool SHAPE_POLY_SET::Parse( std::stringstream& aStream )
                 outline.Append( p );
             }
 
-            paths.push_back( outline );
+            paths.push_back( std::move( outline ) );
         }
 
-        m_polys.push_back( paths );
+        m_polys.push_back( std::move( paths ) );
     }
 
     return true;
@@ -1195,29 +1559,21 @@ bool SHAPE_POLY_SET::PointOnEdge( const VECTOR2I& aP ) const
 
 bool SHAPE_POLY_SET::Collide( const SEG& aSeg, int aClearance ) const
 {
-
-    SHAPE_POLY_SET polySet = SHAPE_POLY_SET( *this );
-
-    // Inflate the polygon if necessary.
-    if( aClearance > 0 )
-    {
-        // fixme: the number of arc segments should not be hardcoded
-        polySet.Inflate( aClearance, 8 );
-    }
-
-    // We are going to check to see if the segment crosses an external
-    // boundary.  However, if the full segment is inside the polyset, this
-    // will not be true.  So we first test to see if one of the points is
-    // inside.  If true, then we collide
-    if( polySet.Contains( aSeg.A ) )
+    // We are going to check to see if the segment comes closer than the clearance to an
+    // edge.  However, if the full segment is inside the polyset, this will not be true.
+    // So we first test to see if one of the points is inside.  If true, then we collide
+    if( Contains( aSeg.A ) )
         return true;
 
-    for( SEGMENT_ITERATOR it = ( (SHAPE_POLY_SET*) this )->IterateSegmentsWithHoles(); it; it++ )
+    // A segment crossing or touching an edge collides even without clearance.  The edges
+    // are tested through the edge index of the large outlines.
+    for( const POLYGON& polygon : m_polys )
     {
-        SEG polygonEdge = *it;
-
-        if( polygonEdge.Intersect( aSeg, true ) )
-            return true;
+        for( const SHAPE_LINE_CHAIN& lineChain : polygon )
+        {
+            if( lineChain.Collide( aSeg, std::max( aClearance, 1 ) ) )
+                return true;
+        }
     }
 
     return false;
@@ -1226,17 +1582,24 @@ bool SHAPE_POLY_SET::Collide( const SEG& aSeg, int aClearance ) const
 
 bool SHAPE_POLY_SET::Collide( const VECTOR2I& aP, int aClearance ) const
 {
-    SHAPE_POLY_SET polySet = SHAPE_POLY_SET( *this );
+    if( Contains( aP ) )
+        return true;
 
-    // Inflate the polygon if necessary.
-    if( aClearance > 0 )
+    if( aClearance <= 0 )
+        return false;
+
+    // The point is outside of the polygon: it collides if it is closer than the clearance
+    // to an edge
+    for( const POLYGON& polygon : m_polys )
     {
-        // fixme: the number of arc segments should not be hardcoded
-        polySet.Inflate( aClearance, 8 );
+        for( const SHAPE_LINE_CHAIN& lineChain : polygon )
+        {
+            if( lineChain.Collide( aP, aClearance ) )
+                return true;
+        }
     }
 
-    // There is a collision if and only if the point is inside of the polygon.
-    return polySet.Contains( aP );
+    return false;
 }
 
 
@@ -1528,19 +1891,14 @@ int SHAPE_POLY_SET::DistanceToPolygon( VECTOR2I aPoint, int aPolygonIndex )
     if( containsSingle( aPoint, aPolygonIndex, 1 ) )
         return 0;
 
-    SEGMENT_ITERATOR iterator = IterateSegmentsWithHoles( aPolygonIndex );
+    int minDistance = INT_MAX;
 
-    SEG polygonEdge = *iterator;
-    int minDistance = polygonEdge.Distance( aPoint );
-
-    for( iterator++; iterator && minDistance > 0; iterator++ )
+    for( const SHAPE_LINE_CHAIN& lineChain : m_polys[aPolygonIndex] )
     {
-        polygonEdge = *iterator;
-
-        int currentDistance = polygonEdge.Distance( aPoint );
+        minDistance = std::min( minDistance, lineChain.Distance( aPoint, true ) );
 
-        if( currentDistance < minDistance )
-            minDistance = currentDistance;
+        if( minDistance == 0 )
+            break;
     }
 
     return minDistance;
@@ -1556,19 +1914,14 @@ int SHAPE_POLY_SET::DistanceToPolygon( const SEG& aSegment, int aPolygonIndex, i
     if( containsSingle( aSegment.A, aPolygonIndex, 1 ) )
         return 0;
 
-    SEGMENT_ITERATOR iterator = IterateSegmentsWithHoles( aPolygonIndex );
+    int minDistance = INT_MAX;
 
-    SEG polygonEdge = *iterator;
-    int minDistance = polygonEdge.Distance( aSegment );
-
-    for( iterator++; iterator && minDistance > 0; iterator++ )
+    for( const SHAPE_LINE_CHAIN& lineChain : m_polys[aPolygonIndex] )
     {
-        polygonEdge = *iterator;
-
-        int currentDistance = polygonEdge.Distance( aSegment );
+        minDistance = std::min( minDistance, lineChain.Distance( aSegment ) );
 
-        if( currentDistance < minDistance )
-            minDistance = currentDistance;
+        if( minDistance == 0 )
+            break;
     }
 
     // Take into account the width of the segment
@@ -1825,10 +2178,35 @@ SHAPE_POLY_SET &SHAPE_POLY_SET::operator=( const SHAPE_POLY_SET& aOther )
     static_cast<SHAPE&>(*this) = aOther;
     m_polys = aOther.m_polys;
 
-    // reset poly cache:
+    // reset poly cache, keeping the triangulations of the polygons for the next
+    // CacheTriangulation() call
     m_hash = MD5_HASH{};
     m_triangulationValid = false;
     m_triangulatedPolys.clear();
+
+    if( &aOther != this && !aOther.m_polyTriangulations.empty() )
+        m_polyTriangulations = aOther.m_polyTriangulations;
+
+    return *this;
+}
+
+
+SHAPE_POLY_SET& SHAPE_POLY_SET::operator=( SHAPE_POLY_SET&& aOther ) noexcept
+{
+    static_cast<SHAPE&>(*this) = aOther;
+    m_polys = std::move( aOther.m_polys );
+
+    // The triangulation of the moved set is still valid for its outlines
+    m_triangulatedPolys = std::move( aOther.m_triangulatedPolys );
+    m_polyTriangulations = std::move( aOther.m_polyTriangulations );
+    m_triangulationValid = aOther.m_triangulationValid;
+    m_hash = aOther.m_hash;
+
+    aOther.m_polys.clear();
+    aOther.m_triangulatedPolys.clear();
+    aOther.m_polyTriangulations.clear();
+    aOther.m_triangulationValid = false;
+    aOther.m_hash = MD5_HASH{};
     return *this;
 }
 
@@ -1877,18 +2255,65 @@ void SHAPE_POLY_SET::CacheTriangulation()
     if( !recalculate )
         return;
 
-    SHAPE_POLY_SET tmpSet = *this;
+    // The polygons found in the previous triangulations keep their triangles
+    std::unordered_map<std::string, TRIANGULATION*> previous;
 
-    if( tmpSet.HasHoles() )
-        tmpSet.Fracture( PM_FAST );
+    for( POLYGON_TRIANGULATION& polyTriangulation : m_polyTriangulations )
+        previous.emplace( polyTriangulation.m_hash.Format(), &polyTriangulation.m_triangulation );
+
+    std::vector<POLYGON_TRIANGULATION> polyTriangulations( m_polys.size() );
 
     m_triangulatedPolys.clear();
+
+    for( size_t i = 0; i < m_polys.size(); i++ )
+    {
+        POLYGON_TRIANGULATION& polyTriangulation = polyTriangulations[i];
+
+        polyTriangulation.m_hash = polygonChecksum( m_polys[i] );
+
+        auto it = previous.find( polyTriangulation.m_hash.Format() );
+
+        if( it != previous.end() )
+            polyTriangulation.m_triangulation = *it->second;
+        else
+            triangulatePolygon( m_polys[i], polyTriangulation.m_triangulation );
+
+        m_triangulatedPolys.insert( m_triangulatedPolys.end(),
+                                    polyTriangulation.m_triangulation.begin(),
+                                    polyTriangulation.m_triangulation.end() );
+    }
+
+    m_polyTriangulations = std::move( polyTriangulations );
     m_triangulationValid = true;
+    m_hash = checksum();
+}
+
+
+void SHAPE_POLY_SET::ReuseTriangulations( const SHAPE_POLY_SET& aOther )
+{
+    if( &aOther == this || aOther.m_polyTriangulations.empty() || IsTriangulationUpToDate() )
+        return;
+
+    m_polyTriangulations.insert( m_polyTriangulations.end(),
+                                 aOther.m_polyTriangulations.begin(),
+                                 aOther.m_polyTriangulations.end() );
+}
+
+
+void SHAPE_POLY_SET::triangulatePolygon( const POLYGON& aPoly, TRIANGULATION& aTriangulation )
+{
+    SHAPE_POLY_SET tmpSet;
+
+    tmpSet.m_polys.push_back( aPoly );
+
+    if( tmpSet.HasHoles() )
+        tmpSet.Fracture( PM_FAST );
 
     while( tmpSet.OutlineCount() > 0 )
     {
-        m_triangulatedPolys.push_back( std::make_unique<TRIANGULATED_POLYGON>() );
-        PolygonTriangulation tess( *m_triangulatedPolys.back() );
+        auto triangulated = std::make_shared<TRIANGULATED_POLYGON>();
+        aTriangulation.push_back( triangulated );
+        PolygonTriangulation tess( *triangulated );
 
         // If the tesselation fails, we re-fracture the polygon, which will
         // first simplify the system before fracturing and removing the holes
@@ -1896,16 +2321,34 @@ void SHAPE_POLY_SET::CacheTriangulation()
         if( !tess.TesselatePolygon( tmpSet.Polygon( 0 ).front() ) )
         {
             tmpSet.Fracture( PM_FAST );
-            m_triangulationValid = false;
             continue;
         }
 
         tmpSet.DeletePolygon( 0 );
-        m_triangulationValid = true;
     }
+}
+
+
+MD5_HASH SHAPE_POLY_SET::polygonChecksum( const POLYGON& aPoly )
+{
+    MD5_HASH hash;
+
+    hash.Hash( aPoly.size() );
+
+    for( const SHAPE_LINE_CHAIN& lc : aPoly )
+    {
+        hash.Hash( lc.PointCount() );
 
-    if( m_triangulationValid )
-        m_hash = checksum();
+        for( const VECTOR2I& pt : lc.CPoints() )
+        {
+            hash.Hash( pt.x );
+            hash.Hash( pt.y );
+        }
+    }
+
+    hash.Finalize();
+
+    return hash;
 }
 
 
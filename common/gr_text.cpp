@@ -89,6 +89,8 @@ int Clamp_Text_PenSize( int aPenSize, wxSize aSize, bool aBold )
 
 int GraphicTextWidth( const wxString& aText, const wxSize& aSize, bool aItalic, bool aBold )
 {
+    std::lock_guard<std::mutex> lock( basic_gal_lock );
+
     basic_gal.SetFontItalic( aItalic );
     basic_gal.SetFontBold( aBold );
     basic_gal.SetGlyphSize( VECTOR2D( aSize ) );
@@ -140,6 +142,8 @@ void GRText( wxDC* aDC, const wxPoint& aPos, COLOR4D aColor, const wxString& aTe
         fill_mode = false;
     }
 
+    std::lock_guard<std::mutex> lock( basic_gal_lock );
+
     basic_gal.SetIsFill( fill_mode );
     basic_gal.SetLineWidth( aWidth );
 
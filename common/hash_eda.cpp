@@ -28,84 +28,162 @@
 #include <class_text_mod.h>
 #include <class_edge_mod.h>
 #include <class_pad.h>
-
-#include <functional>
+#include <class_track.h>
+#include <class_drawsegment.h>
+#include <class_pcb_text.h>
+#include <class_zone.h>
 
 using namespace std;
 
+static size_t hash_item( const EDA_ITEM* aItem, int aFlags, bool aCached );
+
+
 // Common calculation part for all BOARD_ITEMs
 static inline size_t hash_board_item( const BOARD_ITEM* aItem, int aFlags )
 {
     size_t ret = 0;
 
     if( aFlags & LAYER )
-        ret ^= hash<unsigned long long>{}( aItem->GetLayerSet().to_ullong() );
+        hash_combine( ret, aItem->GetLayerSet().to_ullong() );
 
     return ret;
 }
 
 
-size_t hash_eda( const EDA_ITEM* aItem, int aFlags )
+static inline void hash_point( size_t& aSeed, const wxPoint& aPoint )
 {
-    size_t ret = 0xa82de1c0;
+    hash_combine( aSeed, aPoint.x );
+    hash_combine( aSeed, aPoint.y );
+}
 
-    switch( aItem->Type() )
+
+static void hash_poly_set( size_t& aSeed, const SHAPE_POLY_SET& aPolySet )
+{
+    hash_combine( aSeed, aPolySet.OutlineCount() );
+
+    for( auto it = aPolySet.CIterateWithHoles(); it; ++it )
     {
-    case PCB_MODULE_T:
-        {
-            const MODULE* module = static_cast<const MODULE*>( aItem );
+        hash_combine( aSeed, it->x );
+        hash_combine( aSeed, it->y );
+        hash_combine( aSeed, it.IsEndContour() );
+    }
+}
 
-            ret ^= hash_board_item( module, aFlags );
 
-            if( aFlags & POSITION )
-            {
-                ret ^= hash<int>{}( module->GetPosition().x );
-                ret ^= hash<int>{}( module->GetPosition().y );
-            }
+static void hash_text( size_t& aSeed, const EDA_TEXT* aText )
+{
+    hash_combine( aSeed, aText->GetText().ToStdString() );
+    hash_combine( aSeed, aText->IsItalic() );
+    hash_combine( aSeed, aText->IsBold() );
+    hash_combine( aSeed, aText->IsMirrored() );
+    hash_combine( aSeed, aText->IsVisible() );
+    hash_combine( aSeed, aText->IsMultilineAllowed() );
+    hash_combine( aSeed, aText->GetTextWidth() );
+    hash_combine( aSeed, aText->GetTextHeight() );
+    hash_combine( aSeed, aText->GetThickness() );
+    hash_combine( aSeed, static_cast<int>( aText->GetHorizJustify() ) );
+    hash_combine( aSeed, static_cast<int>( aText->GetVertJustify() ) );
+}
 
-            if( aFlags & ROTATION )
-                ret ^= hash<double>{}( module->GetOrientation() );
 
-            for( auto i : module->GraphicalItems() )
-                ret ^= hash_eda( i, aFlags );
+static void hash_drawsegment( size_t& aSeed, const DRAWSEGMENT* aSegment )
+{
+    hash_combine( aSeed, static_cast<int>( aSegment->GetShape() ) );
+    hash_combine( aSeed, aSegment->GetWidth() );
 
-            for( auto i : module->Pads() )
-                ret ^= hash_eda( static_cast<EDA_ITEM*>( i ), aFlags );
-        }
+    if( aSegment->GetShape() == S_POLYGON )
+        hash_poly_set( aSeed, aSegment->GetPolyShape() );
+}
+
+
+// The items of a footprint are summed, so their order does not matter
+static size_t hash_module( const MODULE* aModule, int aFlags, bool aCached )
+{
+    size_t ret = hash_board_item( aModule, aFlags );
+    size_t items = 0;
+
+    if( aFlags & POSITION )
+        hash_point( ret, aModule->GetPosition() );
+
+    if( aFlags & ROTATION )
+        hash_combine( ret, aModule->GetOrientation() );
+
+    auto hashChild = [&]( const BOARD_ITEM* aChild )
+    {
+        items += aCached ? hash_eda_cached( aChild ) : hash_item( aChild, aFlags, false );
+    };
+
+    hashChild( &aModule->Reference() );
+    hashChild( &aModule->Value() );
+
+    for( auto i : aModule->GraphicalItems() )
+        hashChild( i );
+
+    for( auto i : aModule->Pads() )
+        hashChild( i );
+
+    hash_combine( ret, items );
+
+    return ret;
+}
+
+
+static size_t hash_item( const EDA_ITEM* aItem, int aFlags, bool aCached )
+{
+    size_t ret = 0xa82de1c0;
+
+    hash_combine( ret, static_cast<int>( aItem->Type() ) );
+
+    switch( aItem->Type() )
+    {
+    case PCB_MODULE_T:
+        hash_combine( ret, hash_module( static_cast<const MODULE*>( aItem ), aFlags, aCached ) );
         break;
 
     case PCB_PAD_T:
         {
             const D_PAD* pad = static_cast<const D_PAD*>( aItem );
-            ret ^= hash_board_item( pad, aFlags );
-            ret ^= hash<int>{}( pad->GetShape() << 16 );
-            ret ^= hash<int>{}( pad->GetDrillShape() << 18 );
-            ret ^= hash<int>{}( pad->GetSize().x << 8 );
-            ret ^= hash<int>{}( pad->GetSize().y << 9 );
-            ret ^= hash<int>{}( pad->GetOffset().x << 6 );
-            ret ^= hash<int>{}( pad->GetOffset().y << 7 );
-            ret ^= hash<int>{}( pad->GetDelta().x << 4 );
-            ret ^= hash<int>{}( pad->GetDelta().y << 5 );
+            const MODULE* module = pad->GetParent();
+
+            hash_combine( ret, hash_board_item( pad, aFlags ) );
+            hash_combine( ret, static_cast<int>( pad->GetShape() ) );
+            hash_combine( ret, static_cast<int>( pad->GetDrillShape() ) );
+            hash_combine( ret, static_cast<int>( pad->GetAttribute() ) );
+            hash_combine( ret, pad->GetSize().x );
+            hash_combine( ret, pad->GetSize().y );
+            hash_combine( ret, pad->GetDrillSize().x );
+            hash_combine( ret, pad->GetDrillSize().y );
+            hash_point( ret, pad->GetOffset() );
+            hash_combine( ret, pad->GetDelta().x );
+            hash_combine( ret, pad->GetDelta().y );
+            hash_combine( ret, pad->GetRoundRectRadiusRatio() );
+            hash_combine( ret, pad->GetChamferRectRatio() );
+            hash_combine( ret, pad->GetChamferPositions() );
+
+            if( pad->GetShape() == PAD_SHAPE_CUSTOM )
+            {
+                hash_combine( ret, static_cast<int>( pad->GetCustomShapeInZoneOpt() ) );
+                hash_poly_set( ret, pad->GetCustomShapeAsPolygon() );
+            }
 
             if( aFlags & POSITION )
             {
                 if( aFlags & REL_COORD )
-                {
-                    ret ^= hash<int>{}( pad->GetPos0().x );
-                    ret ^= hash<int>{}( pad->GetPos0().y );
-                }
+                    hash_point( ret, pad->GetPos0() );
                 else
-                {
-                    ret ^= hash<int>{}( pad->GetPosition().x );
-                    ret ^= hash<int>{}( pad->GetPosition().y );
-                }
+                    hash_point( ret, pad->GetPosition() );
             }
 
             if( aFlags & ROTATION )
-                ret ^= hash<double>{}( pad->GetOrientation() );
+            {
+                if( ( aFlags & REL_COORD ) && module )
+                    hash_combine( ret, pad->GetOrientation() - module->GetOrientation() );
+                else
+                    hash_combine( ret, pad->GetOrientation() );
+            }
 
             if( aFlags & NET )
-                ret ^= hash<int>{}( pad->GetNetCode() << 6 );
+                hash_combine( ret, pad->GetNetCode() );
         }
         break;
 
@@ -119,70 +197,170 @@ size_t hash_eda( const EDA_ITEM* aItem, int aFlags )
             if( !( aFlags & VALUE ) && text->GetType() == TEXTE_MODULE::TEXT_is_VALUE )
                 break;
 
-            ret ^= hash_board_item( text, aFlags );
-            ret ^= hash<string>{}( text->GetText().ToStdString() );
-            ret ^= hash<bool>{}( text->IsItalic() );
-            ret ^= hash<bool>{}( text->IsBold() );
-            ret ^= hash<bool>{}( text->IsMirrored() );
-            ret ^= hash<int>{}( text->GetTextWidth() );
-            ret ^= hash<int>{}( text->GetTextHeight() );
-            ret ^= hash<int>{}( text->GetHorizJustify() );
-            ret ^= hash<int>{}( text->GetVertJustify() );
+            hash_combine( ret, hash_board_item( text, aFlags ) );
+            hash_combine( ret, static_cast<int>( text->GetType() ) );
+            hash_text( ret, text );
 
             if( aFlags & POSITION )
             {
                 if( aFlags & REL_COORD )
-                {
-                    ret ^= hash<int>{}( text->GetPos0().x );
-                    ret ^= hash<int>{}( text->GetPos0().y );
-                }
+                    hash_point( ret, text->GetPos0() );
                 else
-                {
-                    ret ^= hash<int>{}( text->GetPosition().x );
-                    ret ^= hash<int>{}( text->GetPosition().y );
-                }
+                    hash_point( ret, text->GetPosition() );
             }
 
+            // The angle of a footprint text is relative to its footprint
             if( aFlags & ROTATION )
-                ret ^= hash<double>{}( text->GetTextAngle() );
+                hash_combine( ret, text->GetTextAngle() );
         }
         break;
 
     case PCB_MODULE_EDGE_T:
         {
             const EDGE_MODULE* segment = static_cast<const EDGE_MODULE*>( aItem );
-            ret ^= hash_board_item( segment, aFlags );
-            ret ^= hash<int>{}( segment->GetType() );
-            ret ^= hash<int>{}( segment->GetShape() );
-            ret ^= hash<int>{}( segment->GetWidth() );
-            ret ^= hash<int>{}( segment->GetRadius() );
+            hash_combine( ret, hash_board_item( segment, aFlags ) );
+            hash_drawsegment( ret, segment );
 
             if( aFlags & POSITION )
             {
                 if( aFlags & REL_COORD )
                 {
-                    ret ^= hash<int>{}( segment->GetStart0().x );
-                    ret ^= hash<int>{}( segment->GetStart0().y );
-                    ret ^= hash<int>{}( segment->GetEnd0().x );
-                    ret ^= hash<int>{}( segment->GetEnd0().y );
+                    hash_point( ret, segment->GetStart0() );
+                    hash_point( ret, segment->GetEnd0() );
+                    hash_point( ret, segment->GetBezier0_C1() );
+                    hash_point( ret, segment->GetBezier0_C2() );
                 }
                 else
                 {
-                    ret ^= hash<int>{}( segment->GetStart().x );
-                    ret ^= hash<int>{}( segment->GetStart().y );
-                    ret ^= hash<int>{}( segment->GetEnd().x );
-                    ret ^= hash<int>{}( segment->GetEnd().y );
+                    hash_point( ret, segment->GetStart() );
+                    hash_point( ret, segment->GetEnd() );
+                    hash_point( ret, segment->GetBezControl1() );
+                    hash_point( ret, segment->GetBezControl2() );
                 }
             }
 
             if( aFlags & ROTATION )
-                ret ^= hash<double>{}( segment->GetAngle() );
+                hash_combine( ret, segment->GetAngle() );
+        }
+        break;
+
+    case PCB_LINE_T:
+        {
+            const DRAWSEGMENT* segment = static_cast<const DRAWSEGMENT*>( aItem );
+            hash_combine( ret, hash_board_item( segment, aFlags ) );
+            hash_drawsegment( ret, segment );
+
+            if( aFlags & POSITION )
+            {
+                hash_point( ret, segment->GetStart() );
+                hash_point( ret, segment->GetEnd() );
+                hash_point( ret, segment->GetBezControl1() );
+                hash_point( ret, segment->GetBezControl2() );
+            }
+
+            if( aFlags & ROTATION )
+                hash_combine( ret, segment->GetAngle() );
+        }
+        break;
+
+    case PCB_TEXT_T:
+        {
+            const TEXTE_PCB* text = static_cast<const TEXTE_PCB*>( aItem );
+            hash_combine( ret, hash_board_item( text, aFlags ) );
+            hash_text( ret, text );
+
+            if( aFlags & POSITION )
+                hash_point( ret, text->GetTextPos() );
+
+            if( aFlags & ROTATION )
+                hash_combine( ret, text->GetTextAngle() );
+        }
+        break;
+
+    case PCB_TRACE_T:
+    case PCB_VIA_T:
+        {
+            const TRACK* track = static_cast<const TRACK*>( aItem );
+            hash_combine( ret, hash_board_item( track, aFlags ) );
+            hash_combine( ret, track->GetWidth() );
+
+            if( aFlags & POSITION )
+            {
+                hash_point( ret, track->GetStart() );
+                hash_point( ret, track->GetEnd() );
+            }
+
+            if( aFlags & NET )
+                hash_combine( ret, track->GetNetCode() );
+
+            if( const VIA* via = dyn_cast<const VIA*>( track ) )
+            {
+                hash_combine( ret, static_cast<int>( via->GetViaType() ) );
+                hash_combine( ret, via->GetDrill() );
+            }
+        }
+        break;
+
+    // The fill of a zone is built from its settings and outline, so it is not hashed
+    case PCB_ZONE_AREA_T:
+        {
+            const ZONE_CONTAINER* zone = static_cast<const ZONE_CONTAINER*>( aItem );
+            hash_combine( ret, hash_board_item( zone, aFlags ) );
+            hash_combine( ret, zone->GetPriority() );
+            hash_combine( ret, zone->GetZoneClearance() );
+            hash_combine( ret, zone->GetMinThickness() );
+            hash_combine( ret, static_cast<int>( zone->GetPadConnection() ) );
+            hash_combine( ret, zone->GetThermalReliefGap() );
+            hash_combine( ret, zone->GetThermalReliefCopperBridge() );
+            hash_combine( ret, zone->GetCornerSmoothingType() );
+            hash_combine( ret, zone->GetCornerRadius() );
+            hash_combine( ret, static_cast<int>( zone->GetFillMode() ) );
+            hash_combine( ret, zone->GetHatchFillTypeThickness() );
+            hash_combine( ret, zone->GetHatchFillTypeGap() );
+            hash_combine( ret, zone->GetHatchFillTypeOrientation() );
+            hash_combine( ret, zone->GetHatchFillTypeSmoothingLevel() );
+            hash_combine( ret, zone->GetHatchFillTypeSmoothingValue() );
+            hash_combine( ret, zone->GetIsKeepout() );
+            hash_combine( ret, zone->GetDoNotAllowCopperPour() );
+            hash_combine( ret, zone->GetDoNotAllowVias() );
+            hash_combine( ret, zone->GetDoNotAllowTracks() );
+
+            if( aFlags & POSITION )
+                hash_poly_set( ret, *zone->Outline() );
+
+            if( aFlags & NET )
+                hash_combine( ret, zone->GetNetCode() );
         }
         break;
 
     default:
-        wxASSERT_MSG( false, "Unhandled type in function hashModItem() (exporter_gencad.cpp)" );
+        wxASSERT_MSG( false, "Unhandled type in function hash_eda()" );
     }
 
     return ret;
 }
+
+
+size_t hash_eda( const EDA_ITEM* aItem, int aFlags )
+{
+    return hash_item( aItem, aFlags, false );
+}
+
+
+size_t hash_eda_cached( const EDA_ITEM* aItem )
+{
+    size_t ret = aItem->GetCachedHash();
+
+    if( ret )
+        return ret;
+
+    ret = hash_item( aItem, HASH_FLAGS::ALL, true );
+
+    // 0 stands for a hash to be computed
+    if( ret == 0 )
+        ret = 1;
+
+    aItem->SetCachedHash( ret );
+
+    return ret;
+}
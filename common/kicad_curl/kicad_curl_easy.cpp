@@ -25,6 +25,8 @@
 #include <kicad_curl/kicad_curl.h>
 #include <kicad_curl/kicad_curl_easy.h>
 
+#include <algorithm>
+#include <cctype>
 #include <cstddef>
 #include <exception>
 #include <stdarg.h>
@@ -44,6 +46,23 @@ static size_t write_callback( void* contents, size_t size, size_t nmemb, void* u
 }
 
 
+static size_t header_callback( char* contents, size_t size, size_t nitems, void* userp )
+{
+    size_t realsize = size * nitems;
+
+    std::string* p = (std::string*) userp;
+
+    // A status line starts the headers of each response, i.e. after a redirect:
+    // only keep the headers of the last one.
+    if( realsize >= 5 && std::equal( contents, contents + 5, "HTTP/" ) )
+        p->clear();
+
+    p->append( contents, realsize );
+
+    return realsize;
+}
+
+
 KICAD_CURL_EASY::KICAD_CURL_EASY() :
     m_headers( NULL )
 {
@@ -62,6 +81,8 @@ KICAD_CURL_EASY::KICAD_CURL_EASY() :
 
     curl_easy_setopt( m_CURL, CURLOPT_WRITEFUNCTION, write_callback );
     curl_easy_setopt( m_CURL, CURLOPT_WRITEDATA, (void*) &m_buffer );
+    curl_easy_setopt( m_CURL, CURLOPT_HEADERFUNCTION, header_callback );
+    curl_easy_setopt( m_CURL, CURLOPT_HEADERDATA, (void*) &m_response_headers );
 }
 
 
@@ -83,6 +104,7 @@ void KICAD_CURL_EASY::Perform()
 
     // bonus: retain worst case memory allocation, should re-use occur
     m_buffer.clear();
+    m_response_headers.clear();
 
     CURLcode res = curl_easy_perform( m_CURL );
 
@@ -95,6 +117,48 @@ void KICAD_CURL_EASY::Perform()
 }
 
 
+long KICAD_CURL_EASY::GetResponseCode()
+{
+    long code = 0;
+
+    curl_easy_getinfo( m_CURL, CURLINFO_RESPONSE_CODE, &code );
+
+    return code;
+}
+
+
+std::string KICAD_CURL_EASY::GetResponseHeader( const std::string& aName ) const
+{
+    auto lower = []( std::string aText )
+    {
+        std::transform( aText.begin(), aText.end(), aText.begin(),
+                        []( unsigned char c ) { return (char) std::tolower( c ); } );
+        return aText;
+    };
+
+    const std::string name = lower( aName ) + ':';
+    std::istringstream lines( m_response_headers );
+    std::string line;
+
+    while( std::getline( lines, line ) )
+    {
+        if( line.size() <= name.size() || lower( line.substr( 0, name.size() ) ) != name )
+            continue;
+
+        // Trim the spaces after the colon and the CR ending the line
+        size_t first = line.find_first_not_of( " \t", name.size() );
+        size_t last = line.find_last_not_of( " \t\r" );
+
+        if( first == std::string::npos || last < first )
+            return std::string();
+
+        return line.substr( first, last - first + 1 );
+    }
+
+    return std::string();
+}
+
+
 void KICAD_CURL_EASY::SetHeader( const std::string& aName, const std::string& aValue )
 {
     std::string header = aName + ':' + aValue;
@@ -227,7 +227,8 @@ void LIB_TABLE_ROW::SetOptions( const wxString& aOptions )
 
 
 LIB_TABLE::LIB_TABLE( LIB_TABLE* aFallBackTable ) :
-    fallBack( aFallBackTable )
+    fallBack( aFallBackTable ),
+    m_version( 0 )
 {
     // not copying fall back, simply search aFallBackTable separately
     // if "nickName not found".
@@ -288,47 +289,75 @@ wxString LIB_TABLE::GetFullURI( const wxString& aNickname, bool aExpandEnvVars )
 }
 
 
-LIB_TABLE_ROW* LIB_TABLE::findRow( const wxString& aNickName ) const
+void LIB_TABLE::ensureFlatIndex() const
 {
-    LIB_TABLE* cur = (LIB_TABLE*) this;
+    const LIB_TABLE* cur = this;
+    size_t           depth = 0;
+    bool             valid = !m_flatIndexVersions.empty();
 
-    do
+    for( ; valid && cur; cur = cur->fallBack, ++depth )
     {
-        cur->ensureIndex();
+        valid = depth < m_flatIndexVersions.size()
+                && m_flatIndexVersions[depth].first == cur
+                && m_flatIndexVersions[depth].second == cur->m_version;
+    }
 
-        INDEX_CITER it = cur->nickIndex.find( aNickName );
+    if( valid && depth == m_flatIndexVersions.size() )
+        return;
 
-        if( it != cur->nickIndex.end() )
-        {
-            return &cur->rows[it->second];  // found
-        }
+    m_flatIndex.clear();
+    m_flatIndexVersions.clear();
 
-        // not found, search fall back table(s), if any
-    } while( ( cur = cur->fallBack ) != 0 );
+    // A nickname hides the same nickname in the next tables of the chain, and in the
+    // next rows of the same table, as in nickIndex.
+    for( cur = this; cur; cur = cur->fallBack )
+    {
+        m_flatIndexVersions.emplace_back( cur, cur->m_version );
 
-    return nullptr; // not found
+        for( unsigned i = 0; i < cur->rows.size(); ++i )
+            m_flatIndex.emplace( cur->rows[i].GetNickName(),
+                                 std::make_pair( (LIB_TABLE*) cur, (int) i ) );
+    }
 }
 
 
-LIB_TABLE_ROW* LIB_TABLE::findRow( const wxString& aNickName )
+LIB_TABLE_ROW* LIB_TABLE::findRow( const wxString& aNickName ) const
 {
-    LIB_TABLE* cur = (LIB_TABLE*) this;
+    std::lock_guard<std::mutex> lock( m_flatIndexLock );
 
-    do
+    ensureFlatIndex();
+
+    FLAT_INDEX::const_iterator it = m_flatIndex.find( aNickName );
+
+    if( it == m_flatIndex.end() )
+        return nullptr; // not found
+
+    LIB_TABLE* table = it->second.first;
+    unsigned   index = it->second.second;
+
+    // The lib table editor changes the rows of its tables directly: check the row is
+    // still the one indexed, and index the tables again if not.
+    if( index >= table->rows.size() || table->rows[index].GetNickName() != aNickName )
     {
-        cur->ensureIndex();
+        m_flatIndexVersions.clear();
+        ensureFlatIndex();
 
-        INDEX_ITER it = cur->nickIndex.find( aNickName );
+        it = m_flatIndex.find( aNickName );
 
-        if( it != cur->nickIndex.end() )
-        {
-            return &cur->rows[it->second];  // found
-        }
+        if( it == m_flatIndex.end() )
+            return nullptr;
 
-        // not found, search fall back table(s), if any
-    } while( ( cur = cur->fallBack ) != 0 );
+        table = it->second.first;
+        index = it->second.second;
+    }
 
-    return nullptr; // not found
+    return &table->rows[index];  // found
+}
+
+
+LIB_TABLE_ROW* LIB_TABLE::findRow( const wxString& aNickName )
+{
+    return static_cast<const LIB_TABLE*>( this )->findRow( aNickName );
 }
 
 
@@ -412,12 +441,14 @@ bool LIB_TABLE::InsertRow( LIB_TABLE_ROW* aRow, bool doReplace )
     {
         rows.push_back( aRow );
         nickIndex.insert( INDEX_VALUE( aRow->GetNickName(), rows.size() - 1 ) );
+        ++m_version;
         return true;
     }
 
     if( doReplace )
     {
         rows.replace( it->second, aRow );
+        ++m_version;
         return true;
     }
 
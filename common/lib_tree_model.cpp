@@ -28,14 +28,6 @@
 #include <pgm_base.h>
 #include <kicad_string.h>
 
-// Each node gets this lowest score initially, without any matches applied.
-// Matches will then increase this score depending on match quality.  This way,
-// an empty search string will result in all components being displayed as they
-// have the minimum score. However, in that case, we avoid expanding all the
-// nodes asd the result is very unspecific.
-static const unsigned kLowestDefaultScore = 1;
-
-
 // Creates a score depending on the position of a string match. If the position
 // is 0 (= prefix match), this returns the maximum score. This degrades until
 // pos == max, which returns a score of 0; Evertyhing else beyond that is just
@@ -145,7 +137,7 @@ LIB_TREE_NODE_UNIT::LIB_TREE_NODE_UNIT( LIB_TREE_NODE* aParent, LIB_TREE_ITEM* a
     LibId = aParent->LibId;
 
     Name = namePrefix + " " + aItem->GetUnitReference( aUnit );
-    Desc = wxEmptyString;
+    Desc = COMPACT_STRING();
     MatchName = wxEmptyString;
 
     IntrinsicRank = -aUnit;
@@ -161,7 +153,7 @@ LIB_TREE_NODE_LIB_ID::LIB_TREE_NODE_LIB_ID( LIB_TREE_NODE* aParent, LIB_TREE_ITE
     LibId.SetLibItemName( aItem->GetName () );
 
     Name = aItem->GetName();
-    Desc = aItem->GetDescription();
+    Desc = aItem->GetCompactDescription();
 
     MatchName = aItem->GetName();
     SearchText = aItem->GetSearchText();
@@ -191,7 +183,7 @@ void LIB_TREE_NODE_LIB_ID::Update( LIB_TREE_ITEM* aItem )
 
     LibId.SetLibNickname( aItem->GetLibId().GetLibNickname() );
 
-    Desc = aItem->GetDescription();
+    Desc = aItem->GetCompactDescription();
 
     SearchText = aItem->GetSearchText();
     Normalized = false;
@@ -206,15 +198,26 @@ void LIB_TREE_NODE_LIB_ID::Update( LIB_TREE_ITEM* aItem )
 
 void LIB_TREE_NODE_LIB_ID::UpdateScore( EDA_COMBINED_MATCHER& aMatcher )
 {
-    if( Score <= 0 )
-        return; // Leaf nodes without scores are out of the game.
+    Normalize();
+    Score = MatchScore( aMatcher, Score );
+}
+
 
+void LIB_TREE_NODE_LIB_ID::Normalize()
+{
     if( !Normalized )
     {
         MatchName = MatchName.Lower();
-        SearchText = SearchText.Lower();
+        SearchText = SearchText.wx_str().Lower();
         Normalized = true;
     }
+}
+
+
+int LIB_TREE_NODE_LIB_ID::MatchScore( EDA_COMBINED_MATCHER& aMatcher, int aScore ) const
+{
+    if( aScore <= 0 )
+        return aScore; // Leaf nodes without scores are out of the game.
 
     // Keywords and description we only count if the match string is at
     // least two characters long. That avoids spurious, low quality
@@ -224,18 +227,18 @@ void LIB_TREE_NODE_LIB_ID::UpdateScore( EDA_COMBINED_MATCHER& aMatcher )
 
     if( aMatcher.GetPattern() == MatchName )
     {
-        Score += 1000;  // exact match. High score :)
+        aScore += 1000;  // exact match. High score :)
     }
     else if( aMatcher.Find( MatchName, matchers_fired, found_pos ) )
     {
         // Substring match. The earlier in the string the better.
-        Score += matchPosScore( found_pos, 20 ) + 20;
+        aScore += matchPosScore( found_pos, 20 ) + 20;
     }
     else if( aMatcher.Find( Parent->MatchName, matchers_fired, found_pos ) )
     {
-        Score += 19;   // parent name matches.         score += 19
+        aScore += 19;   // parent name matches.         score += 19
     }
-    else if( aMatcher.Find( SearchText, matchers_fired, found_pos ) )
+    else if( aMatcher.Find( SearchText.wx_str(), matchers_fired, found_pos ) )
     {
         // If we have a very short search term (like one or two letters),
         // we don't want to accumulate scores if they just happen to be in
@@ -245,17 +248,17 @@ void LIB_TREE_NODE_LIB_ID::UpdateScore( EDA_COMBINED_MATCHER& aMatcher )
         {
             // For longer terms, we add scores 1..18 for positional match
             // (higher in the front, where the keywords are).
-            Score += matchPosScore( found_pos, 17 ) + 1;
+            aScore += matchPosScore( found_pos, 17 ) + 1;
         }
     }
     else
     {
         // No match. That's it for this item.
-        Score = 0;
+        aScore = 0;
     }
 
     // More matchers = better match
-    Score += 2 * matchers_fired;
+    return aScore + 2 * matchers_fired;
 }
 
 
@@ -296,22 +299,29 @@ void LIB_TREE_NODE_LIB::UpdateScore( EDA_COMBINED_MATCHER& aMatcher )
     else
     {
         // No children; we are a leaf.
-        int found_pos = EDA_PATTERN_NOT_FOUND;
-        int matchers_fired = 0;
+        Score = MatchScore( aMatcher, Score );
+    }
+}
 
-        if( aMatcher.GetPattern() == MatchName )
-        {
-            Score += 1000;  // exact match. High score :)
-        }
-        else if( aMatcher.Find( MatchName, matchers_fired, found_pos ) )
-        {
-            // Substring match. The earlier in the string the better.
-            Score += matchPosScore( found_pos, 20 ) + 20;
-        }
 
-        // More matchers = better match
-        Score += 2 * matchers_fired;
+int LIB_TREE_NODE_LIB::MatchScore( EDA_COMBINED_MATCHER& aMatcher, int aScore ) const
+{
+    int score = 0;
+    int found_pos = EDA_PATTERN_NOT_FOUND;
+    int matchers_fired = 0;
+
+    if( aMatcher.GetPattern() == MatchName )
+    {
+        score += 1000;  // exact match. High score :)
     }
+    else if( aMatcher.Find( MatchName, matchers_fired, found_pos ) )
+    {
+        // Substring match. The earlier in the string the better.
+        score += matchPosScore( found_pos, 20 ) + 20;
+    }
+
+    // More matchers = better match
+    return score + 2 * matchers_fired;
 }
 
 
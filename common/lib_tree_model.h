@@ -31,6 +31,14 @@
 class EDA_COMBINED_MATCHER;
 
 
+// Each node gets this lowest score initially, without any matches applied.
+// Matches will then increase this score depending on match quality.  This way,
+// an empty search string will result in all components being displayed as they
+// have the minimum score. However, in that case, we avoid expanding all the
+// nodes asd the result is very unspecific.
+static const int kLowestDefaultScore = 1;
+
+
 /**
  * Model class in the component selector Model-View-Adapter (mediated MVC)
  * architecture. The other pieces are in:
@@ -94,11 +102,11 @@ public:
     /// The score of an item resulting from the search algorithm.
     int Score;
 
-    wxString    Name;        ///< Actual name of the part
-    wxString    Desc;        ///< Description to be displayed
-    wxString    MatchName;   ///< Normalized name for matching
-    wxString    SearchText;  ///< Descriptive text to search
-    bool        Normalized;  ///< Support for lazy normalization.
+    wxString        Name;        ///< Actual name of the part
+    COMPACT_STRING  Desc;        ///< Description to be displayed, shared with the item
+    wxString        MatchName;   ///< Normalized name for matching
+    COMPACT_STRING  SearchText;  ///< Descriptive text to search
+    bool            Normalized;  ///< Support for lazy normalization.
 
 
     LIB_ID      LibId;       ///< LIB_ID determined by the parent library nickname and alias name.
@@ -114,6 +122,25 @@ public:
      */
     virtual void UpdateScore( EDA_COMBINED_MATCHER& aMatcher ) = 0;
 
+    /**
+     * Compute the score of a leaf node for one more search term, without changing the
+     * node, so it can be called outside of the UI thread.  Normalize() must have been
+     * called.
+     *
+     * @param aMatcher  an EDA_COMBINED_MATCHER initialized with the search term
+     * @param aScore    the score accumulated for the previous search terms
+     * @return the new score
+     */
+    virtual int MatchScore( EDA_COMBINED_MATCHER& aMatcher, int aScore ) const
+    {
+        return aScore;
+    }
+
+    /**
+     * Normalize the text searched in this node to lowercase, if not already done.
+     */
+    virtual void Normalize() {}
+
     /**
      * Initialize score to kLowestDefaultScore, recursively.
      */
@@ -214,6 +241,10 @@ public:
      */
     virtual void UpdateScore( EDA_COMBINED_MATCHER& aMatcher ) override;
 
+    virtual int MatchScore( EDA_COMBINED_MATCHER& aMatcher, int aScore ) const override;
+
+    virtual void Normalize() override;
+
 protected:
     /**
      * Add a new unit to the component and return it.
@@ -255,6 +286,11 @@ public:
     LIB_TREE_NODE_LIB_ID& AddItem( LIB_TREE_ITEM* aItem );
 
     virtual void UpdateScore( EDA_COMBINED_MATCHER& aMatcher ) override;
+
+    /**
+     * Score the library itself, when it has no children.  The previous score is ignored.
+     */
+    virtual int MatchScore( EDA_COMBINED_MATCHER& aMatcher, int aScore ) const override;
 };
 
 
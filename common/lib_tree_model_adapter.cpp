@@ -22,6 +22,7 @@
 #include <lib_tree_model_adapter.h>
 
 #include <eda_pattern_match.h>
+#include <thread_pool.h>
 
 #include <wx/progdlg.h>
 #include <wx/tokenzr.h>
@@ -77,12 +78,18 @@ LIB_TREE_MODEL_ADAPTER::LIB_TREE_MODEL_ADAPTER()
      m_freeze( 0 ),
      m_col_part( nullptr ),
      m_col_desc( nullptr ),
-     m_widget( nullptr )
+     m_widget( nullptr ),
+     m_searchCancelled( false ),
+     m_searchFiltered( false ),
+     m_searchPending( false ),
+     m_syncNeedsRebuild( false )
 {}
 
 
 LIB_TREE_MODEL_ADAPTER::~LIB_TREE_MODEL_ADAPTER()
-{}
+{
+    CancelSearch();
+}
 
 
 void LIB_TREE_MODEL_ADAPTER::SetFilter( CMP_FILTER_TYPE aFilter )
@@ -119,6 +126,8 @@ void LIB_TREE_MODEL_ADAPTER::DoAddLibrary( wxString const& aNodeName, wxString c
                                            std::vector<LIB_TREE_ITEM*> const& aItemList,
                                            bool presorted )
 {
+    InvalidateSearchIndex();
+
     auto& lib_node = m_tree.AddLib( aNodeName, aDesc );
 
     lib_node.VisLen = wxTheApp->GetTopWindow()->GetTextExtent( lib_node.Name ).x;
@@ -138,16 +147,162 @@ void LIB_TREE_MODEL_ADAPTER::DoAddLibrary( wxString const& aNodeName, wxString c
 
 void LIB_TREE_MODEL_ADAPTER::UpdateSearchString( wxString const& aSearch )
 {
-    m_tree.ResetScore();
+    CancelSearch();
+
+    m_searchFiltered = wxStringTokenizer( aSearch ).HasMoreTokens();
+
+    if( m_searchFiltered && !m_searchIndex.IsBuilt() )
+        m_searchIndex.Build( m_tree );
+
+    m_searchIndex.Score( aSearch, m_searchScores, m_searchCancelled );
+
+    ShowSearchResults();
+}
+
+
+void LIB_TREE_MODEL_ADAPTER::StartSearch( wxString const& aSearch )
+{
+    m_pendingSearch = aSearch;
+    m_searchPending = true;
+
+    // The next keystroke cancels the search of the previous one
+    if( m_searchWorker.valid() )
+        m_searchCancelled = true;
+    else
+        LaunchSearch();
+}
+
+
+bool LIB_TREE_MODEL_ADAPTER::PollSearch()
+{
+    if( m_searchWorker.valid() )
+    {
+        if( m_searchWorker.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready )
+            return false;
+
+        bool finished = m_searchWorker.get();
+
+        if( finished && !m_searchPending )
+            ShowSearchResults();
+    }
+
+    if( !m_searchPending )
+        return true;
+
+    LaunchSearch();
+    return false;
+}
+
+
+void LIB_TREE_MODEL_ADAPTER::CancelSearch()
+{
+    m_searchPending = false;
+
+    if( m_searchWorker.valid() )
+    {
+        m_searchCancelled = true;
+        m_searchWorker.get();
+    }
+
+    m_searchCancelled = false;
+}
+
+
+void LIB_TREE_MODEL_ADAPTER::InvalidateSearchIndex()
+{
+    // The search thread reads the nodes
+    CancelSearch();
+    m_searchIndex.Clear();
+}
 
-    wxStringTokenizer tokenizer( aSearch );
 
-    while( tokenizer.HasMoreTokens() )
+void LIB_TREE_MODEL_ADAPTER::beginSyncChanges()
+{
+    // Changes left from a synchronization whose view was not updated can't be patched
+    if( !m_syncChanged.empty() || !m_syncRemoved.empty() )
+        m_syncNeedsRebuild = true;
+
+    m_syncChanged.clear();
+    m_syncRemoved.clear();
+}
+
+
+LIB_TREE_NODE::PTR_VECTOR::iterator LIB_TREE_MODEL_ADAPTER::detachNode(
+        LIB_TREE_NODE::PTR_VECTOR& aChildren, LIB_TREE_NODE::PTR_VECTOR::iterator aIt )
+{
+    m_syncRemoved.push_back( std::move( *aIt ) );
+    return aChildren.erase( aIt );
+}
+
+
+bool LIB_TREE_MODEL_ADAPTER::NotifySyncChanges()
+{
+    bool rebuild = m_syncNeedsRebuild || m_searchFiltered || !m_widget;
+
+    if( !rebuild )
     {
-        const wxString term = tokenizer.GetNextToken().Lower();
-        EDA_COMBINED_MATCHER matcher( term );
+        // The removed nodes are still alive: some platforms ask for their parent
+        for( auto& node : m_syncRemoved )
+        {
+            wxDataViewItem item = ToItem( node.get() );
+            ItemDeleted( GetParent( item ), item );
+        }
 
-        m_tree.UpdateScore( matcher );
+        for( LIB_TREE_NODE* node : m_syncChanged )
+            ItemChanged( ToItem( node ) );
+    }
+
+    m_syncChanged.clear();
+    m_syncRemoved.clear();
+    m_syncNeedsRebuild = false;
+
+    return rebuild;
+}
+
+
+void LIB_TREE_MODEL_ADAPTER::LaunchSearch()
+{
+    wxString search = m_pendingSearch;
+    bool     filtered = wxStringTokenizer( search ).HasMoreTokens();
+
+    m_searchPending = false;
+    m_searchCancelled = false;
+    m_searchFiltered = filtered;
+
+    // The nodes are only read by the search thread, and their scores are applied by
+    // ShowSearchResults() in the UI thread
+    m_searchWorker = THREAD_POOL::GetPool().Async( [this, search, filtered]() -> bool
+            {
+                if( filtered && !m_searchIndex.IsBuilt() )
+                    m_searchIndex.Build( m_tree );
+
+                return m_searchIndex.Score( search, m_searchScores, m_searchCancelled );
+            } );
+}
+
+
+void LIB_TREE_MODEL_ADAPTER::ShowSearchResults()
+{
+    m_tree.ResetScore();
+
+    if( m_searchFiltered )
+    {
+        const std::vector<LIB_TREE_NODE*>& leaves = m_searchIndex.GetLeaves();
+
+        for( size_t ii = 0; ii < leaves.size(); ++ii )
+            leaves[ii]->Score = m_searchScores[ii];
+
+        // A library scores its best item
+        for( auto& lib : m_tree.Children )
+        {
+            if( lib->Children.empty() )
+                continue;
+
+            lib->Score = 0;
+
+            for( auto& child : lib->Children )
+                lib->Score = std::max( lib->Score, child->Score );
+        }
     }
 
     m_tree.SortNodes();
@@ -161,6 +316,11 @@ void LIB_TREE_MODEL_ADAPTER::UpdateSearchString( wxString const& aSearch )
         // https://bugs.launchpad.net/kicad/+bug/1756255
         m_widget->UnselectAll();
 
+        // The view is rebuilt: the changes of a synchronization don't need a notification
+        m_syncChanged.clear();
+        m_syncRemoved.clear();
+        m_syncNeedsRebuild = false;
+
         Cleared();
 #ifndef __WINDOWS__
         // The fastest method to update wxDataViewCtrl is to rebuild from
@@ -342,7 +502,7 @@ void LIB_TREE_MODEL_ADAPTER::GetValue( wxVariant&              aVariant,
         aVariant = node->Name;
         break;
     case 1:
-        aVariant = node->Desc;
+        aVariant = node->Desc.wx_str();
         break;
     }
 }
@@ -24,11 +24,13 @@
 
 #include <lib_id.h>
 #include <lib_tree_model.h>
+#include <lib_tree_search_index.h>
 #include <wx/hashmap.h>
 #include <wx/dataview.h>
 #include <wx/headerctrl.h>
 #include <vector>
 #include <functional>
+#include <future>
 
 /**
  * Adapter class in the component selector Model-View-Adapter (mediated MVC)
@@ -68,6 +70,7 @@
  * Quick summary of methods used by the View:
  *
  * - `UpdateSearchString()` - pass in the user's search text
+ * - `StartSearch()` / `PollSearch()` - the same, searching in a background thread
  * - `AttachTo()` - pass in the wxDataViewCtrl
  * - `GetAliasFor()` - get the LIB_ALIAS* for a selected item
  * - `GetUnitFor()` - get the unit for a selected item
@@ -174,6 +177,28 @@ public:
      */
     void UpdateSearchString( wxString const& aSearch );
 
+    /**
+     * Start searching for the search string provided by the user in a background
+     * thread.  A search still running is cancelled: it is restarted with aSearch as
+     * soon as it stops.  The results are shown by PollSearch().
+     *
+     * @param aSearch   full, unprocessed search text
+     */
+    void StartSearch( wxString const& aSearch );
+
+    /**
+     * Check the progress of the search started by StartSearch(), and show its results
+     * once it is finished.  To be called periodically from the UI thread.
+     *
+     * @return true when no search is running anymore
+     */
+    bool PollSearch();
+
+    /**
+     * Cancel the search started by StartSearch(), and wait for it to stop.
+     */
+    void CancelSearch();
+
     /**
      * Attach to a wxDataViewCtrl and initialize it. This will set up columns
      * and associate the model via the adapter.
@@ -254,6 +279,17 @@ public:
     // Allows subclasses to nominate a context menu handler.
     virtual TOOL_INTERACTIVE* GetContextMenuTool() { return nullptr; }
 
+    /**
+     * Notify the view of the nodes changed and removed by the last synchronization of the
+     * tree, so that their rows are patched instead of rebuilding the whole view.
+     *
+     * The rows of added nodes cannot be inserted at their sorted position on all platforms,
+     * and a tree filtered by a search has to be scored again: the view must then be rebuilt.
+     *
+     * @return true if the view must be rebuilt by LIB_TREE::Regenerate()
+     */
+    bool NotifySyncChanges();
+
 protected:
     static wxDataViewItem ToItem( LIB_TREE_NODE const* aNode );
     static LIB_TREE_NODE const* ToNode( wxDataViewItem aItem );
@@ -263,6 +299,30 @@ protected:
 
     LIB_TREE_MODEL_ADAPTER();
 
+    /**
+     * Drop the search index, which is rebuilt at the next search.  Must be called before
+     * modifying the nodes of m_tree.
+     */
+    void InvalidateSearchIndex();
+
+    /**
+     * Start recording the changes of a synchronization, for NotifySyncChanges().
+     */
+    void beginSyncChanges();
+
+    /**
+     * Remove the node aIt from aChildren, keeping it alive until the view is notified of
+     * its removal.
+     *
+     * @return the iterator following aIt
+     */
+    LIB_TREE_NODE::PTR_VECTOR::iterator detachNode( LIB_TREE_NODE::PTR_VECTOR& aChildren,
+                                                    LIB_TREE_NODE::PTR_VECTOR::iterator aIt );
+
+    void nodeChanged( LIB_TREE_NODE* aNode ) { m_syncChanged.push_back( aNode ); }
+
+    void nodeAdded() { m_syncNeedsRebuild = true; }
+
     /**
      * Check whether a container has columns too
      */
@@ -329,6 +389,29 @@ private:
     wxDataViewColumn*   m_col_desc;
     wxDataViewCtrl*     m_widget;
 
+    LIB_TREE_SEARCH_INDEX m_searchIndex;        ///< built at the first search
+    std::future<bool>   m_searchWorker;         ///< the search in progress, if valid
+    std::atomic<bool>   m_searchCancelled;
+    std::vector<int>    m_searchScores;         ///< the leaf scores found by the search
+    bool                m_searchFiltered;       ///< false if the search text has no term
+    wxString            m_pendingSearch;        ///< the search to start after the current one
+    bool                m_searchPending;
+
+    ///> The changes of the last synchronization, not yet notified to the view
+    std::vector<LIB_TREE_NODE*> m_syncChanged;
+    LIB_TREE_NODE::PTR_VECTOR   m_syncRemoved;
+    bool                        m_syncNeedsRebuild;
+
+    /**
+     * Start searching for m_pendingSearch in the thread pool.
+     */
+    void LaunchSearch();
+
+    /**
+     * Apply the scores of the last search to the tree, and update the view.
+     */
+    void ShowSearchResults();
+
     /**
      * Compute the width required for the given column of a node and its
      * children.
@@ -0,0 +1,233 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file lib_tree_search_index.cpp
+ */
+
+#include <lib_tree_search_index.h>
+
+#include <algorithm>
+#include <iterator>
+
+#include <eda_pattern_match.h>
+#include <lib_tree_model.h>
+
+#include <wx/tokenzr.h>
+
+
+// The number of leaves scored between two checks of the cancel flag
+static const size_t CANCEL_CHECK_INTERVAL = 256;
+
+// The terms using one of these chars can be a regular expression, a wildcard or a
+// relational pattern: they can match nodes which do not contain their trigrams
+static const wxString patternChars = wxT( ".*+?^${}()|[]\\<>=:" );
+
+
+// Unicode code points have 21 bits: three of them fit in a trigram
+static inline uint64_t makeTrigram( uint64_t aC0, uint64_t aC1, uint64_t aC2 )
+{
+    return ( aC0 << 42 ) | ( aC1 << 21 ) | aC2;
+}
+
+
+// Returns the trigrams of aText, sorted and without duplicates
+static std::vector<uint64_t> getTrigrams( const wxString& aText )
+{
+    std::vector<uint64_t> trigrams;
+    uint64_t c0 = 0, c1 = 0;
+    int      count = 0;
+
+    for( wxString::const_iterator it = aText.begin(); it != aText.end(); ++it )
+    {
+        uint64_t c2 = wxUniChar( *it ).GetValue();
+
+        if( ++count >= 3 )
+            trigrams.push_back( makeTrigram( c0, c1, c2 ) );
+
+        c0 = c1;
+        c1 = c2;
+    }
+
+    std::sort( trigrams.begin(), trigrams.end() );
+    trigrams.erase( std::unique( trigrams.begin(), trigrams.end() ), trigrams.end() );
+
+    return trigrams;
+}
+
+
+void LIB_TREE_SEARCH_INDEX::Build( LIB_TREE_NODE_ROOT& aRoot )
+{
+    Clear();
+
+    for( auto& lib : aRoot.Children )
+    {
+        if( lib->Children.empty() )
+        {
+            // No children: the library is a leaf
+            addTrigrams( lib->MatchName, m_leaves.size(), m_leafPostings );
+            m_leaves.push_back( lib.get() );
+            continue;
+        }
+
+        addTrigrams( lib->MatchName, m_libs.size(), m_libPostings );
+        m_libs.push_back( lib.get() );
+        m_libFirstLeaf.push_back( m_leaves.size() );
+
+        for( auto& item : lib->Children )
+        {
+            item->Normalize();
+            addTrigrams( item->MatchName, m_leaves.size(), m_leafPostings );
+            addTrigrams( item->SearchText.wx_str(), m_leaves.size(), m_leafPostings );
+            m_leaves.push_back( item.get() );
+        }
+    }
+
+    m_libFirstLeaf.push_back( m_leaves.size() );
+    m_built = true;
+}
+
+
+void LIB_TREE_SEARCH_INDEX::Clear()
+{
+    m_built = false;
+    m_leaves.clear();
+    m_leafPostings.clear();
+    m_libs.clear();
+    m_libFirstLeaf.clear();
+    m_libPostings.clear();
+}
+
+
+void LIB_TREE_SEARCH_INDEX::addTrigrams( const wxString& aText, int aIndex,
+                                         POSTINGS& aPostings )
+{
+    for( TRIGRAM trigram : getTrigrams( aText ) )
+    {
+        std::vector<int>& posting = aPostings[trigram];
+
+        // The nodes are indexed in order, so the postings stay sorted
+        if( posting.empty() || posting.back() != aIndex )
+            posting.push_back( aIndex );
+    }
+}
+
+
+std::vector<int> LIB_TREE_SEARCH_INDEX::lookup( const POSTINGS& aPostings,
+                                                const wxString& aTerm )
+{
+    std::vector<const std::vector<int>*> postings;
+
+    for( TRIGRAM trigram : getTrigrams( aTerm ) )
+    {
+        auto it = aPostings.find( trigram );
+
+        if( it == aPostings.end() )
+            return std::vector<int>();
+
+        postings.push_back( &it->second );
+    }
+
+    if( postings.empty() )
+        return std::vector<int>();
+
+    // Intersect from the shortest posting, to keep the intermediate results small
+    std::sort( postings.begin(), postings.end(),
+               []( const std::vector<int>* a, const std::vector<int>* b )
+               {
+                   return a->size() < b->size();
+               } );
+
+    std::vector<int> result = *postings[0];
+    std::vector<int> buffer;
+
+    for( size_t ii = 1; ii < postings.size() && !result.empty(); ++ii )
+    {
+        buffer.clear();
+        std::set_intersection( result.begin(), result.end(),
+                               postings[ii]->begin(), postings[ii]->end(),
+                               std::back_inserter( buffer ) );
+        result.swap( buffer );
+    }
+
+    return result;
+}
+
+
+bool LIB_TREE_SEARCH_INDEX::findCandidates( const wxString& aTerm,
+                                            std::vector<char>& aCandidates ) const
+{
+    if( aTerm.length() < 3 )
+        return false;
+
+    for( wxString::const_iterator it = aTerm.begin(); it != aTerm.end(); ++it )
+    {
+        if( patternChars.Find( *it ) != wxNOT_FOUND )
+            return false;
+    }
+
+    aCandidates.assign( m_leaves.size(), 0 );
+
+    for( int leaf : lookup( m_leafPostings, aTerm ) )
+        aCandidates[leaf] = 1;
+
+    // The items match the name of their library too
+    for( int lib : lookup( m_libPostings, aTerm ) )
+    {
+        for( int leaf = m_libFirstLeaf[lib]; leaf < m_libFirstLeaf[lib + 1]; ++leaf )
+            aCandidates[leaf] = 1;
+    }
+
+    return true;
+}
+
+
+bool LIB_TREE_SEARCH_INDEX::Score( const wxString& aSearch, std::vector<int>& aScores,
+                                   const std::atomic<bool>& aCancelled ) const
+{
+    aScores.assign( m_leaves.size(), kLowestDefaultScore );
+
+    wxStringTokenizer tokenizer( aSearch );
+    std::vector<char> candidates;
+
+    while( tokenizer.HasMoreTokens() )
+    {
+        const wxString term = tokenizer.GetNextToken().Lower();
+        EDA_COMBINED_MATCHER matcher( term );
+        bool indexed = findCandidates( term, candidates );
+
+        for( size_t ii = 0; ii < m_leaves.size(); ++ii )
+        {
+            if( ii % CANCEL_CHECK_INTERVAL == 0 && aCancelled )
+                return false;
+
+            // A node missing a trigram of the term cannot match it
+            if( indexed && !candidates[ii] )
+                aScores[ii] = 0;
+            else
+                aScores[ii] = m_leaves[ii]->MatchScore( matcher, aScores[ii] );
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,114 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file lib_tree_search_index.h
+ */
+
+#ifndef LIB_TREE_SEARCH_INDEX_H
+#define LIB_TREE_SEARCH_INDEX_H
+
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <wx/string.h>
+
+class LIB_TREE_NODE;
+class LIB_TREE_NODE_ROOT;
+
+
+/**
+ * Trigram index of the text searched in the leaf nodes of a library tree (the names,
+ * keywords and descriptions), so that a search term only has to be matched against the
+ * nodes containing all the trigrams of the term.
+ *
+ * The terms using wildcard, regular expression or relational syntax, and the terms shorter
+ * than a trigram, cannot be looked up: all the nodes are matched against them, as before.
+ *
+ * The index keeps pointers to the nodes: it must be cleared when the tree is modified.
+ */
+class LIB_TREE_SEARCH_INDEX
+{
+public:
+    LIB_TREE_SEARCH_INDEX() :
+        m_built( false )
+    {
+    }
+
+    /**
+     * Index the leaf nodes of aRoot.  The nodes are normalized to lowercase.
+     */
+    void Build( LIB_TREE_NODE_ROOT& aRoot );
+
+    void Clear();
+
+    bool IsBuilt() const { return m_built; }
+
+    /**
+     * @return the indexed nodes: the items of the libraries, and the libraries having no items
+     */
+    const std::vector<LIB_TREE_NODE*>& GetLeaves() const { return m_leaves; }
+
+    /**
+     * Compute the scores of the leaves for the search text aSearch, like the
+     * LIB_TREE_NODE::UpdateScore() calls for each term, without changing the nodes.
+     *
+     * @param aScores receives the score of each leaf, in GetLeaves() order
+     * @param aCancelled is polled to stop the search early
+     * @return false if the search was cancelled
+     */
+    bool Score( const wxString& aSearch, std::vector<int>& aScores,
+                const std::atomic<bool>& aCancelled ) const;
+
+private:
+    typedef uint64_t TRIGRAM;
+    typedef std::unordered_map<TRIGRAM, std::vector<int>> POSTINGS;
+
+    ///> Add the index aIndex to the postings of the trigrams of aText
+    static void addTrigrams( const wxString& aText, int aIndex, POSTINGS& aPostings );
+
+    /**
+     * Find the indices of aPostings containing all the trigrams of aTerm.
+     */
+    static std::vector<int> lookup( const POSTINGS& aPostings, const wxString& aTerm );
+
+    /**
+     * Flag the leaves which can match aTerm.
+     * @return false if aTerm cannot be looked up in the index
+     */
+    bool findCandidates( const wxString& aTerm, std::vector<char>& aCandidates ) const;
+
+    bool                        m_built;
+    std::vector<LIB_TREE_NODE*> m_leaves;
+    POSTINGS                    m_leafPostings;     ///< leaf names and search texts
+
+    ///> The libraries having items, whose name is also matched by their items
+    std::vector<LIB_TREE_NODE*> m_libs;
+    std::vector<int>            m_libFirstLeaf;     ///< the items of m_libs[i] are the leaves
+                                                    ///< m_libFirstLeaf[i] to m_libFirstLeaf[i+1]
+    POSTINGS                    m_libPostings;
+};
+
+#endif  // LIB_TREE_SEARCH_INDEX_H
@@ -20,6 +20,9 @@
 
 #include <libeval/numeric_evaluator.h>
 
+#include <mutex>
+#include <tuple>
+
 /* The (generated) lemon parser is written in C.
  * In order to keep its symbol from the global namespace include the parser code with
  * a C++ namespace.
@@ -43,6 +46,23 @@ namespace numEval
 } /* namespace numEval */
 
 
+/* The results of the expressions without variables, shared by all the evaluators: a dialog
+ * evaluates the same few expressions (mostly plain values) in many fields.  The key is the
+ * default units, the decimal separator of the locale and the input text.
+ */
+struct CACHED_RESULT
+{
+    std::string result;
+    bool        parseError;
+};
+
+typedef std::tuple<int, char, wxString> RESULT_KEY;
+
+static const size_t                         MAX_CACHED_RESULTS = 4096;
+static std::mutex                           resultCacheLock;
+static std::map<RESULT_KEY, CACHED_RESULT>  resultCache;
+
+
 NUMERIC_EVALUATOR::NUMERIC_EVALUATOR( EDA_UNITS_T aUnits, bool aUseMils )
 {
     struct lconv* lc = localeconv();
@@ -50,6 +70,7 @@ NUMERIC_EVALUATOR::NUMERIC_EVALUATOR( EDA_UNITS_T aUnits, bool aUseMils )
 
     m_parseError = false;
     m_parseFinished = false;
+    m_usesVariables = false;
 
     m_parser = numEval::ParseAlloc( malloc );
 
@@ -131,6 +152,7 @@ bool NUMERIC_EVALUATOR::Process( const wxString& aString )
     newString( aString );
     m_parseError = false;
     m_parseFinished = false;
+    m_usesVariables = false;
     Token tok;
 
     if( aString.IsEmpty() )
@@ -139,6 +161,9 @@ bool NUMERIC_EVALUATOR::Process( const wxString& aString )
         return true;
     }
 
+    if( restoreCachedResult( aString ) )
+        return !m_parseError;
+
     do
     {
         tok = getToken();
@@ -152,10 +177,44 @@ bool NUMERIC_EVALUATOR::Process( const wxString& aString )
         }
     } while( tok.token );
 
+    if( !m_usesVariables )
+        cacheResult( aString );
+
     return !m_parseError;
 }
 
 
+bool NUMERIC_EVALUATOR::restoreCachedResult( const wxString& aString )
+{
+    std::lock_guard<std::mutex> lock( resultCacheLock );
+
+    auto it = resultCache.find( RESULT_KEY( (int) m_defaultUnits, m_localeDecimalSeparator,
+                                            aString ) );
+
+    if( it == resultCache.end() )
+        return false;
+
+    snprintf( m_token.token, m_token.OutLen, "%s", it->second.result.c_str() );
+    m_parseError = it->second.parseError;
+    m_parseFinished = true;
+    return true;
+}
+
+
+void NUMERIC_EVALUATOR::cacheResult( const wxString& aString )
+{
+    std::lock_guard<std::mutex> lock( resultCacheLock );
+
+    // The cache is not worth an eviction policy: it only grows past its size for a
+    // program evaluating many different expressions, which starts again from scratch
+    if( resultCache.size() >= MAX_CACHED_RESULTS )
+        resultCache.clear();
+
+    resultCache[ RESULT_KEY( (int) m_defaultUnits, m_localeDecimalSeparator, aString ) ] =
+            { m_token.token, m_parseError };
+}
+
+
 void NUMERIC_EVALUATOR::newString( const wxString& aString )
 {
     Clear();
@@ -164,9 +223,11 @@ void NUMERIC_EVALUATOR::newString( const wxString& aString )
 
     m_token.token = reinterpret_cast<decltype( m_token.token )>( malloc( TokenStat::OutLen + 1 ) );
     strcpy( m_token.token, "0" );
-    m_token.inputLen = aString.length();
+    // The tokenizer reads a copy, as the buffer returned by mb_str() is a temporary
+    m_inputBuffer = std::string( aString.mb_str() );
+    m_token.inputLen = m_inputBuffer.size();
     m_token.pos = 0;
-    m_token.input = aString.mb_str();
+    m_token.input = m_inputBuffer.c_str();
 
     m_parseFinished = false;
 }
@@ -331,6 +392,8 @@ NUMERIC_EVALUATOR::Token NUMERIC_EVALUATOR::getToken()
     else if( isalpha( ch ))
     {
         // VAR
+        m_usesVariables = true;
+
         const char* cptr = &m_token.input[ m_token.pos ];
         cptr++;
 
@@ -99,19 +99,10 @@ std::string MD5_HASH::Format()
     // Build a hexadecimal string from the 16 bytes of MD5_HASH:
     for( int ii = 0; ii < 16; ++ii )
     {
-        char lsb = ( m_hash[ii] & 0x0F ) + '0';
+        static const char hexDigits[] = "0123456789ABCDEF";
 
-        if( lsb > '9' )
-            lsb += 'A'-'9';
-
-        char msb = ( ( m_hash[ii] >> 4 ) & 0x0F ) + '0';
-
-        if( msb > '9' )
-            msb += 'A'-'9';
-
-         data += msb;
-         data += lsb;
-         data += ' ';
+        data += hexDigits[( m_hash[ii] >> 4 ) & 0x0F];
+        data += hexDigits[m_hash[ii] & 0x0F];
     }
 
     return data;
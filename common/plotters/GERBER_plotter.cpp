@@ -61,6 +61,8 @@ GERBER_PLOTTER::GERBER_PLOTTER()
     m_gerberUnitFmt = 6;
     m_useX2format = true;
     m_useNetAttributes = true;
+    m_optimizedOutput = false;
+    m_lastDevPosValid = false;
 }
 
 
@@ -100,9 +102,27 @@ void GERBER_PLOTTER::SetGerberCoordinatesFormat( int aResolution, bool aUseInche
 
 void GERBER_PLOTTER::emitDcode( const DPOINT& pt, int dcode )
 {
+    wxPoint pos( KiROUND( pt.x ), KiROUND( pt.y ) );
 
-    fprintf( outputFile, "X%dY%dD%02d*\n",
-	    KiROUND( pt.x ), KiROUND( pt.y ), dcode );
+    if( !m_optimizedOutput || !m_lastDevPosValid )
+    {
+        fprintf( outputFile, "X%dY%dD%02d*\n", pos.x, pos.y, dcode );
+    }
+    else
+    {
+        // Coordinates are modal: the ones which did not change can be omitted
+        // (at least one is written)
+        if( pos.x != m_lastDevPos.x || pos.y == m_lastDevPos.y )
+            fprintf( outputFile, "X%d", pos.x );
+
+        if( pos.y != m_lastDevPos.y )
+            fprintf( outputFile, "Y%d", pos.y );
+
+        fprintf( outputFile, "D%02d*\n", dcode );
+    }
+
+    m_lastDevPos = pos;
+    m_lastDevPosValid = true;
 }
 
 
@@ -169,6 +189,7 @@ bool GERBER_PLOTTER::StartPlot()
     wxASSERT( outputFile );
 
     finalFile = outputFile;     // the actual gerber file will be created later
+    m_lastDevPosValid = false;
 
     // Create a temporary filename to store gerber file
     // note tmpfile() does not work under Vista and W7 in user mode
@@ -287,32 +308,27 @@ void GERBER_PLOTTER::SetCurrentLineWidth( int width, void* aData )
 }
 
 
-std::vector<APERTURE>::iterator GERBER_PLOTTER::getAperture( const wxSize& aSize,
-                        APERTURE::APERTURE_TYPE aType, int aApertureAttribute )
+std::vector<APERTURE>::iterator GERBER_PLOTTER::getAperture( const wxSize& aSize, int aRadius,
+                        double aRotation, APERTURE::APERTURE_TYPE aType, int aApertureAttribute )
 {
-    int last_D_code = 9;
+    APERTURE_KEY key = { aType, aSize, aApertureAttribute, aRadius, aRotation };
 
     // Search an existing aperture
-    std::vector<APERTURE>::iterator tool = apertures.begin();
-
-    while( tool != apertures.end() )
-    {
-        last_D_code = tool->m_DCode;
-
-        if( (tool->m_Type == aType) && (tool->m_Size == aSize) &&
-            (tool->m_ApertureAttribute == aApertureAttribute) )
-            return tool;
+    auto it = m_apertureIndex.find( key );
 
-        ++tool;
-    }
+    if( it != m_apertureIndex.end() )
+        return apertures.begin() + it->second;
 
     // Allocate a new aperture
     APERTURE new_tool;
     new_tool.m_Size  = aSize;
     new_tool.m_Type  = aType;
-    new_tool.m_DCode = last_D_code + 1;
+    new_tool.m_DCode = apertures.empty() ? FIRST_DCODE_VALUE : apertures.back().m_DCode + 1;
     new_tool.m_ApertureAttribute = aApertureAttribute;
+    new_tool.m_Radius = aRadius;
+    new_tool.m_Rotation = aRotation;
 
+    m_apertureIndex[key] = apertures.size();
     apertures.push_back( new_tool );
 
     return apertures.end() - 1;
@@ -320,12 +336,15 @@ std::vector<APERTURE>::iterator GERBER_PLOTTER::getAperture( const wxSize& aSize
 
 
 void GERBER_PLOTTER::selectAperture( const wxSize&           aSize,
+                                     int aRadius, double aRotation,
                                      APERTURE::APERTURE_TYPE aType,
                                      int aApertureAttribute )
 {
     bool change = ( currentAperture == apertures.end() ) ||
                   ( currentAperture->m_Type != aType ) ||
-                  ( currentAperture->m_Size != aSize );
+                  ( currentAperture->m_Size != aSize ) ||
+                  ( currentAperture->m_Radius != aRadius ) ||
+                  ( currentAperture->m_Rotation != aRotation );
 
     if( !m_useNetAttributes )
         aApertureAttribute = 0;
@@ -335,7 +354,7 @@ void GERBER_PLOTTER::selectAperture( const wxSize&           aSize,
     if( change )
     {
         // Pick an existing aperture or create a new one
-        currentAperture = getAperture( aSize, aType, aApertureAttribute );
+        currentAperture = getAperture( aSize, aRadius, aRotation, aType, aApertureAttribute );
         fprintf( outputFile, "D%d*\n", currentAperture->m_DCode );
     }
 }
@@ -364,6 +383,9 @@ void GERBER_PLOTTER::writeApertureList()
 
         int attribute = tool->m_ApertureAttribute;
 
+        // The macro of an aperture macro must be defined before the aperture
+        writeApertureMacro( *tool, fscale );
+
         if( attribute != m_apertureAttribute )
         {
             fputs( GBR_APERTURE_METADATA::FormatAttribute(
@@ -401,6 +423,12 @@ void GERBER_PLOTTER::writeApertureList()
 	            tool->m_Size.x * fscale,
 		    tool->m_Size.y * fscale );
             break;
+
+        case APERTURE::RotRect:
+        case APERTURE::RotOval:
+        case APERTURE::RoundRect:
+            sprintf( text, "AM%d*%%\n", tool->m_DCode );
+            break;
         }
 
         fputs( cbuf, outputFile );
@@ -423,6 +451,117 @@ void GERBER_PLOTTER::writeApertureList()
 }
 
 
+void GERBER_PLOTTER::writeApertureMacro( const APERTURE& aTool, double aScale )
+{
+    if( aTool.m_Type != APERTURE::RotRect && aTool.m_Type != APERTURE::RotOval
+            && aTool.m_Type != APERTURE::RoundRect )
+        return;
+
+    // The macros use only the center line (21) and the circle (1) primitives.  The centers
+    // of the circles are rotated here, as the rotation of circles is not known by all the
+    // readers.
+    double w = aTool.m_Size.x * aScale;
+    double h = aTool.m_Size.y * aScale;
+    double rot = aTool.m_Rotation;
+    double cosRot = cos( DEG2RAD( rot ) );
+    double sinRot = sin( DEG2RAD( rot ) );
+
+    std::string primitives;
+    char        cbuf[256];
+
+    auto centerLine = [&]( double aWidth, double aHeight )
+    {
+        if( aWidth > 0 && aHeight > 0 )
+        {
+            sprintf( cbuf, "21,1,%#f,%#f,0,0,%#f*\n", aWidth, aHeight, rot );
+            primitives += cbuf;
+        }
+    };
+
+    auto circle = [&]( double aDiameter, double aX, double aY )
+    {
+        sprintf( cbuf, "1,1,%#f,%#f,%#f*\n", aDiameter,
+                 aX * cosRot - aY * sinRot, aX * sinRot + aY * cosRot );
+        primitives += cbuf;
+    };
+
+    switch( aTool.m_Type )
+    {
+    case APERTURE::RotRect:
+        centerLine( w, h );
+        break;
+
+    case APERTURE::RotOval:
+        if( w > h )
+        {
+            centerLine( w - h, h );
+            circle( h, ( w - h ) / 2, 0 );
+            circle( h, -( w - h ) / 2, 0 );
+        }
+        else
+        {
+            centerLine( w, h - w );
+            circle( w, 0, ( h - w ) / 2 );
+            circle( w, 0, -( h - w ) / 2 );
+        }
+        break;
+
+    case APERTURE::RoundRect:
+    {
+        double r = aTool.m_Radius * aScale;
+
+        centerLine( w, h - 2 * r );
+        centerLine( w - 2 * r, h );
+
+        if( r > 0 )
+        {
+            circle( 2 * r, w / 2 - r, h / 2 - r );
+            circle( 2 * r, -w / 2 + r, h / 2 - r );
+            circle( 2 * r, -w / 2 + r, -h / 2 + r );
+            circle( 2 * r, w / 2 - r, -h / 2 + r );
+        }
+    }
+        break;
+
+    default:
+        break;
+    }
+
+    if( primitives.empty() )    // Should not occur
+        centerLine( std::max( w, 1e-6 ), std::max( h, 1e-6 ) );
+
+    // The last primitive ends the macro
+    primitives.insert( primitives.size() - 1, "%" );
+
+    fprintf( outputFile, "%%AMAM%d*\n%s", aTool.m_DCode, primitives.c_str() );
+}
+
+
+void GERBER_PLOTTER::flashApertureMacro( const wxPoint& aPos, const wxSize& aSize, int aRadius,
+                                         double aOrient, APERTURE::APERTURE_TYPE aType,
+                                         void* aData )
+{
+    GBR_METADATA* gbr_metadata = static_cast<GBR_METADATA*>( aData );
+
+    // The shapes are symmetric: the same aperture is used for the opposite orientations.
+    // The gerber Y axis is upwards, so the orientation is counterclockwise, like in gerber
+    // files (the gerber plotter is never mirrored).
+    double rotation = fmod( aOrient / 10.0, 180.0 );
+
+    if( rotation < 0 )
+        rotation += 180.0;
+
+    DPOINT pos_dev = userToDeviceCoordinates( aPos );
+    int aperture_attrib = gbr_metadata ? gbr_metadata->GetApertureAttrib() : 0;
+    selectAperture( aSize, aRadius, rotation, aType, aperture_attrib );
+
+    if( gbr_metadata )
+        formatNetAttribute( &gbr_metadata->m_NetlistMetadata );
+
+    emitDcode( pos_dev, 3 );
+}
+
+
 void GERBER_PLOTTER::PenTo( const wxPoint& aPos, char plume )
 {
     wxASSERT( outputFile );
@@ -494,14 +633,59 @@ void GERBER_PLOTTER::Arc( const wxPoint& aCenter, double aStAngle, double aEndAn
              KiROUND( devEnd.x ), KiROUND( devEnd.y ),
              KiROUND( devCenter.x ), KiROUND( devCenter.y ) );
 
+    m_lastDevPos = wxPoint( KiROUND( devEnd.x ), KiROUND( devEnd.y ) );
+
     fprintf( outputFile, "G01*\n" ); // Back to linear interpol (perhaps useless here).
 }
 
 
+/**
+ * Remove the duplicate corners, and the corners in the middle of a straight line, from
+ * aCornerList.  The first and the last corners are kept.
+ */
+static void removeRedundantCorners( const std::vector<wxPoint>& aCornerList,
+                                    std::vector<wxPoint>& aResult )
+{
+    aResult.clear();
+    aResult.reserve( aCornerList.size() );
+
+    for( unsigned ii = 0; ii < aCornerList.size(); ii++ )
+    {
+        const wxPoint& corner = aCornerList[ii];
+
+        if( !aResult.empty() && aResult.back() == corner )
+            continue;
+
+        // Remove the last kept corner if it is between the one before and this one,
+        // on a straight line in the same direction
+        if( aResult.size() >= 2 )
+        {
+            const wxPoint& a = aResult[aResult.size() - 2];
+            const wxPoint& b = aResult.back();
+            int64_t abx = b.x - a.x, aby = b.y - a.y;
+            int64_t bcx = corner.x - b.x, bcy = corner.y - b.y;
+
+            if( abx * bcy == aby * bcx && abx * bcx + aby * bcy > 0 )
+                aResult.pop_back();
+        }
+
+        aResult.push_back( corner );
+    }
+}
+
+
 void GERBER_PLOTTER:: PlotPoly( const std::vector< wxPoint >& aCornerList,
                                FILL_T aFill, int aWidth, void * aData )
 {
-    if( aCornerList.size() <= 1 )
+    std::vector<wxPoint> optimizedCornerList;
+
+    if( m_optimizedOutput )
+        removeRedundantCorners( aCornerList, optimizedCornerList );
+
+    const std::vector<wxPoint>& cornerList = m_optimizedOutput ? optimizedCornerList
+                                                               : aCornerList;
+
+    if( cornerList.size() <= 1 )
         return;
 
     // Gerber format does not know filled polygons with thick outline
@@ -518,27 +702,27 @@ void GERBER_PLOTTER:: PlotPoly( const std::vector< wxPoint >& aCornerList,
     {
         fputs( "G36*\n", outputFile );
 
-        MoveTo( aCornerList[0] );
+        MoveTo( cornerList[0] );
         fputs( "G01*\n", outputFile );      // Set linear interpolation.
 
-        for( unsigned ii = 1; ii < aCornerList.size(); ii++ )
-            LineTo( aCornerList[ii] );
+        for( unsigned ii = 1; ii < cornerList.size(); ii++ )
+            LineTo( cornerList[ii] );
 
-        FinishTo( aCornerList[0] );
+        FinishTo( cornerList[0] );
         fputs( "G37*\n", outputFile );
     }
 
     if( aWidth > 0 )
     {
-        MoveTo( aCornerList[0] );
+        MoveTo( cornerList[0] );
 
-        for( unsigned ii = 1; ii < aCornerList.size(); ii++ )
-            LineTo( aCornerList[ii] );
+        for( unsigned ii = 1; ii < cornerList.size(); ii++ )
+            LineTo( cornerList[ii] );
 
         // Ensure the thick outline is closed for filled polygons
         // (if not filled, could be only a polyline)
-        if( aFill && ( aCornerList[aCornerList.size()-1] != aCornerList[0] ) )
-            LineTo( aCornerList[0] );
+        if( aFill && ( cornerList[cornerList.size()-1] != cornerList[0] ) )
+            LineTo( cornerList[0] );
 
         PenFinish();
     }
@@ -692,6 +876,10 @@ void GERBER_PLOTTER::FlashPadOval( const wxPoint& pos, const wxSize& aSize, doub
 
         emitDcode( pos_dev, 3 );
     }
+    else if( m_optimizedOutput && trace_mode == FILLED )
+    {
+        flashApertureMacro( pos, size, 0, orient, APERTURE::RotOval, aData );
+    }
     else /* Plot pad as a segment. */
     {
         if( size.x > size.y )
@@ -792,6 +980,11 @@ void GERBER_PLOTTER::FlashPadRect( const wxPoint& pos, const wxSize& aSize,
         break;
 
     default: // plot pad shape as polygon
+        if( m_optimizedOutput && trace_mode == FILLED )
+        {
+            flashApertureMacro( pos, size, 0, orient, APERTURE::RotRect, aData );
+            break;
+        }
 	{
 	    // XXX to do: use an aperture macro to declare the rotated pad
 	    wxPoint coord[4];
@@ -821,6 +1014,12 @@ void GERBER_PLOTTER::FlashPadRoundRect( const wxPoint& aPadPos, const wxSize& aS
                                      EDA_DRAW_MODE_T aTraceMode, void* aData )
 
 {
+    if( m_optimizedOutput && aTraceMode == FILLED )
+    {
+        flashApertureMacro( aPadPos, aSize, aCornerRadius, aOrient, APERTURE::RoundRect, aData );
+        return;
+    }
+
     GBR_METADATA gbr_metadata;
 
     if( aData )
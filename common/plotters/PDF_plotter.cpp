@@ -36,6 +36,8 @@
 #include <plotter.h>
 #include <macros.h>
 #include <kicad_string.h>
+#include <advanced_config.h>
+#include <thread_pool.h>
 #include <wx/zstream.h>
 #include <wx/mstream.h>
 
@@ -486,14 +488,12 @@ int PDF_PLOTTER::startPdfStream(int handle)
 {
     wxASSERT( outputFile );
     wxASSERT( !workFile );
-    handle = startPdfObject( handle );
 
-    // This is guaranteed to be handle+1 but needs to be allocated since
-    // you could allocate more object during stream preparation
-    streamLengthHandle = allocPdfObject();
-    fprintf( outputFile,
-             "<< /Length %d 0 R /Filter /FlateDecode >>\n" // Length is deferred
-             "stream\n", handle + 1 );
+    // The object is written when the stream is compressed, see flushPdfStreams()
+    if( handle < 0 )
+        handle = allocPdfObject();
+
+    streamHandle = handle;
 
     // Open a temporary file to accumulate the stream
     workFilename = filename + wxT(".tmp");
@@ -504,7 +504,8 @@ int PDF_PLOTTER::startPdfStream(int handle)
 
 
 /**
- * Finish the current PDF stream (writes the deferred length, too)
+ * Finish the current PDF stream.  The streams are compressed and written by
+ * batches, a few at a time on the worker threads
  */
 void PDF_PLOTTER::closePdfStream()
 {
@@ -518,51 +519,77 @@ void PDF_PLOTTER::closePdfStream()
         return;
     }
 
-    // Rewind the file, read in the page stream and DEFLATE it
+    // Rewind the file and read in the page stream
+    PENDING_STREAM pending;
+    pending.m_Handle = streamHandle;
+    pending.m_Data.resize( stream_len );
+
     fseek( workFile, 0, SEEK_SET );
-    unsigned char *inbuf = new unsigned char[stream_len];
 
-    int rc = fread( inbuf, 1, stream_len, workFile );
-    wxASSERT( rc == stream_len );
-    (void) rc;
+    if( stream_len > 0 )
+    {
+        int rc = fread( &pending.m_Data[0], 1, stream_len, workFile );
+        wxASSERT( rc == stream_len );
+        (void) rc;
+    }
 
     // We are done with the temporary file, junk it
     fclose( workFile );
     workFile = 0;
     ::wxRemoveFile( workFilename );
 
-    // NULL means memos owns the memory, but provide a hint on optimum size needed.
-    wxMemoryOutputStream    memos( NULL, std::max( 2000l, stream_len ) ) ;
+    pendingStreams.push_back( std::move( pending ) );
 
-    {
-        /* Somewhat standard parameters to compress in DEFLATE. The PDF spec is
-         * misleading, it says it wants a DEFLATE stream but it really want a ZLIB
-         * stream! (a DEFLATE stream would be generated with -15 instead of 15)
-         * rc = deflateInit2( &zstrm, Z_BEST_COMPRESSION, Z_DEFLATED, 15,
-         *                    8, Z_DEFAULT_STRATEGY );
-         */
+    // Keep at most one page per thread in memory
+    if( pendingStreams.size() >= std::max<size_t>( THREAD_POOL::GetPool().GetThreadCount(), 1 ) )
+        flushPdfStreams();
+}
 
-        wxZlibOutputStream      zos( memos, wxZ_BEST_COMPRESSION, wxZLIB_ZLIB );
 
-        zos.Write( inbuf, stream_len );
+void PDF_PLOTTER::flushPdfStreams()
+{
+    int level = ADVANCED_CFG::GetCfg().m_pdfCompressionLevel;
 
-        delete[] inbuf;
+    THREAD_POOL::GetPool().ParallelFor( pendingStreams.size(),
+            [&]( size_t i )
+            {
+                std::string& data = pendingStreams[i].m_Data;
 
-    }   // flush the zip stream using zos destructor
+                // NULL means memos owns the memory, but provide a hint on optimum size needed.
+                wxMemoryOutputStream memos( NULL, std::max<size_t>( 2000, data.size() ) );
 
-    wxStreamBuffer* sb = memos.GetOutputStreamBuffer();
+                {
+                    /* Somewhat standard parameters to compress in DEFLATE. The PDF spec is
+                     * misleading, it says it wants a DEFLATE stream but it really want a ZLIB
+                     * stream! (a DEFLATE stream would be generated with -15 instead of 15)
+                     * rc = deflateInit2( &zstrm, Z_BEST_COMPRESSION, Z_DEFLATED, 15,
+                     *                    8, Z_DEFAULT_STRATEGY );
+                     */
 
-    unsigned out_count = sb->Tell();
+                    wxZlibOutputStream zos( memos, level, wxZLIB_ZLIB );
 
-    fwrite( sb->GetBufferStart(), 1, out_count, outputFile );
+                    zos.Write( data.data(), data.size() );
 
-    fputs( "endstream\n", outputFile );
-    closePdfObject();
+                }   // flush the zip stream using zos destructor
 
-    // Writing the deferred length as an indirect object
-    startPdfObject( streamLengthHandle );
-    fprintf( outputFile, "%u\n", out_count );
-    closePdfObject();
+                wxStreamBuffer* sb = memos.GetOutputStreamBuffer();
+
+                data.assign( (const char*) sb->GetBufferStart(), sb->Tell() );
+            },
+            1 );
+
+    for( const PENDING_STREAM& stream : pendingStreams )
+    {
+        startPdfObject( stream.m_Handle );
+        fprintf( outputFile,
+                 "<< /Length %u /Filter /FlateDecode >>\n"
+                 "stream\n", (unsigned) stream.m_Data.size() );
+        fwrite( stream.m_Data.data(), 1, stream.m_Data.size(), outputFile );
+        fputs( "endstream\n", outputFile );
+        closePdfObject();
+    }
+
+    pendingStreams.clear();
 }
 
 /**
@@ -617,14 +644,12 @@ void PDF_PLOTTER::ClosePage()
              "<<\n"
              "/Type /Page\n"
              "/Parent %d 0 R\n"
-             "/Resources <<\n"
-             "    /ProcSet [/PDF /Text /ImageC /ImageB]\n"
-             "    /Font %d 0 R >>\n"
+             "/Resources %d 0 R\n"
              "/MediaBox [0 0 %d %d]\n"
              "/Contents %d 0 R\n"
              ">>\n",
              pageTreeHandle,
-             fontResDictHandle,
+             pageResDictHandle,
              int( ceil( psPaperSize.x * BIGPTsPERMIL ) ),
              int( ceil( psPaperSize.y * BIGPTsPERMIL ) ),
              pageStreamHandle );
@@ -659,6 +684,8 @@ bool PDF_PLOTTER::StartPlot()
     /* In the same way, the font resource dictionary is used by every page
        (it *could* be inherited via the Pages tree */
     fontResDictHandle = allocPdfObject();
+    pageResDictHandle = allocPdfObject();
+    pendingStreams.clear();
 
     /* Now, the PDF is read from the end, (more or less)... so we start
        with the page stream for page 1. Other more important stuff is written
@@ -674,6 +701,7 @@ bool PDF_PLOTTER::EndPlot()
 
     // Close the current page (often the only one)
     ClosePage();
+    flushPdfStreams();
 
     /* We need to declare the resources we're using (fonts in particular)
        The useful standard one is the Helvetica family. Adding external fonts
@@ -719,6 +747,15 @@ bool PDF_PLOTTER::EndPlot()
     fputs( ">>\n", outputFile );
     closePdfObject();
 
+    // The resource dictionary of the pages
+    startPdfObject( pageResDictHandle );
+    fprintf( outputFile,
+             "<<\n"
+             "/ProcSet [/PDF /Text /ImageC /ImageB]\n"
+             "/Font %d 0 R\n"
+             ">>\n", fontResDictHandle );
+    closePdfObject();
+
     /* The page tree: it's a B-tree but luckily we only have few pages!
        So we use just an array... The handle was allocated at the beginning,
        now we instantiate the corresponding object */
@@ -136,7 +136,7 @@ void PSLIKE_PLOTTER::FlashPadCircle( const wxPoint& aPadPos, int aDiameter,
 void PSLIKE_PLOTTER::FlashPadRect( const wxPoint& aPadPos, const wxSize& aSize,
                                    double aPadOrient, EDA_DRAW_MODE_T aTraceMode, void* aData )
 {
-    static std::vector< wxPoint > cornerList;
+    std::vector< wxPoint > cornerList;
     wxSize size( aSize );
     cornerList.clear();
 
@@ -254,7 +254,7 @@ void PSLIKE_PLOTTER::FlashPadCustom( const wxPoint& aPadPos, const wxSize& aSize
 void PSLIKE_PLOTTER::FlashPadTrapez( const wxPoint& aPadPos, const wxPoint *aCorners,
                                      double aPadOrient, EDA_DRAW_MODE_T aTraceMode, void* aData )
 {
-    static std::vector< wxPoint > cornerList;
+    std::vector< wxPoint > cornerList;
     cornerList.clear();
 
     for( int ii = 0; ii < 4; ii++ )
@@ -100,6 +100,11 @@
 #include <macros.h>
 #include <kicad_string.h>
 
+#include <cstdarg>
+
+
+/// The output is written to the file by chunks of this size, at least
+#define SVG_OUTPUT_BUFFER_SIZE ( 1 << 20 )
 
 
 /**
@@ -167,6 +172,68 @@ SVG_PLOTTER::SVG_PLOTTER()
     m_pen_rgb_color = 0;                // current color value (black)
     m_brush_rgb_color = 0;              // current color value (black)
     m_dashed = false;
+    m_output = &m_outputBuffer;
+    m_useSymbols = false;
+}
+
+
+void SVG_PLOTTER::emitPrintf( const char* aFormat, ... )
+{
+    char    buffer[256];
+    va_list args;
+
+    va_start( args, aFormat );
+    int len = vsnprintf( buffer, sizeof( buffer ), aFormat, args );
+    va_end( args );
+
+    if( len < 0 )
+        return;
+
+    if( len < (int) sizeof( buffer ) )
+    {
+        m_output->append( buffer, len );
+    }
+    else
+    {
+        std::vector<char> largeBuffer( len + 1 );
+
+        va_start( args, aFormat );
+        vsnprintf( largeBuffer.data(), largeBuffer.size(), aFormat, args );
+        va_end( args );
+
+        m_output->append( largeBuffer.data(), len );
+    }
+
+    if( m_outputBuffer.size() >= SVG_OUTPUT_BUFFER_SIZE )
+        flushOutput();
+}
+
+
+void SVG_PLOTTER::emitPuts( const char* aText )
+{
+    m_output->append( aText );
+
+    if( m_outputBuffer.size() >= SVG_OUTPUT_BUFFER_SIZE )
+        flushOutput();
+}
+
+
+void SVG_PLOTTER::flushPath()
+{
+    if( m_pathData.empty() )
+        return;
+
+    emitPuts( "<path d=\"" );
+    emitPuts( m_pathData.c_str() );
+    emitPuts( "\" />\n" );
+    m_pathData.clear();
+}
+
+
+void SVG_PLOTTER::flushOutput()
+{
+    fwrite( m_outputBuffer.data(), 1, m_outputBuffer.size(), outputFile );
+    m_outputBuffer.clear();
 }
 
 
@@ -209,61 +276,65 @@ void SVG_PLOTTER::setFillMode( FILL_T fill )
 void SVG_PLOTTER::setSVGPlotStyle( bool aIsGroup, const std::string& aExtraStyle )
 {
     if( aIsGroup )
-        fputs( "</g>\n<g ", outputFile );
+    {
+        // The path being merged has the style of the group being closed
+        flushPath();
+        emitPuts( "</g>\n<g " );
+    }
 
     // output the background fill color
-    fprintf( outputFile, "style=\"fill:#%6.6lX; ", m_brush_rgb_color );
+    emitPrintf( "style=\"fill:#%6.6lX; ", m_brush_rgb_color );
 
     switch( m_fillMode )
     {
     case NO_FILL:
-        fputs( "fill-opacity:0.0; ", outputFile );
+        emitPuts( "fill-opacity:0.0; " );
         break;
 
     case FILLED_SHAPE:
-        fputs( "fill-opacity:1.0; ", outputFile );
+        emitPuts( "fill-opacity:1.0; " );
         break;
 
     case FILLED_WITH_BG_BODYCOLOR:
-        fputs( "fill-opacity:0.6; ", outputFile );
+        emitPuts( "fill-opacity:0.6; " );
         break;
     }
 
     double pen_w = userToDeviceSize( GetCurrentLineWidth() );
-    fprintf( outputFile, "\nstroke:#%6.6lX; stroke-width:%g; stroke-opacity:1; \n",
-             m_pen_rgb_color, pen_w  );
-    fputs( "stroke-linecap:round; stroke-linejoin:round;", outputFile );
+    emitPrintf( "\nstroke:#%6.6lX; stroke-width:%g; stroke-opacity:1; \n",
+                m_pen_rgb_color, pen_w  );
+    emitPuts( "stroke-linecap:round; stroke-linejoin:round;" );
 
     switch( m_dashed )
     {
     case PLOTDASHTYPE_DASH:
-        fprintf( outputFile, "stroke-dasharray:%g,%g;",
-                 GetDashMarkLenIU(), GetDashGapLenIU() );
+        emitPrintf( "stroke-dasharray:%g,%g;",
+                    GetDashMarkLenIU(), GetDashGapLenIU() );
         break;
     case PLOTDASHTYPE_DOT:
-        fprintf( outputFile, "stroke-dasharray:%g,%g;",
-                 GetDotMarkLenIU(), GetDashGapLenIU() );
+        emitPrintf( "stroke-dasharray:%g,%g;",
+                    GetDotMarkLenIU(), GetDashGapLenIU() );
         break;
     case PLOTDASHTYPE_DASHDOT:
-        fprintf( outputFile, "stroke-dasharray:%g,%g,%g,%g;",
-                GetDashMarkLenIU(), GetDashGapLenIU(), GetDotMarkLenIU(), GetDashGapLenIU() );
+        emitPrintf( "stroke-dasharray:%g,%g,%g,%g;",
+                    GetDashMarkLenIU(), GetDashGapLenIU(), GetDotMarkLenIU(), GetDashGapLenIU() );
         break;
     }
 
     if( aExtraStyle.length() )
     {
-        fputs( aExtraStyle.c_str(), outputFile );
+        emitPuts( aExtraStyle.c_str() );
     }
 
-    fputs( "\"", outputFile );
+    emitPuts( "\"" );
 
     if( aIsGroup )
     {
-        fputs( ">", outputFile );
+        emitPuts( ">" );
         m_graphics_changed = false;
     }
 
-    fputs( "\n", outputFile );
+    emitPuts( "\n" );
 }
 
 /* Set the current line width (in IUs) for the next plot
@@ -292,22 +363,98 @@ void SVG_PLOTTER::StartBlock( void* aData )
 {
     std::string* idstr = reinterpret_cast<std::string*>( aData );
 
-    fputs( "<g ", outputFile );
+    flushPath();
+
+    emitPuts( "<g " );
     if( idstr )
-        fprintf( outputFile, "id=\"%s\"", idstr->c_str() );
+        emitPrintf( "id=\"%s\"", idstr->c_str() );
 
-    fprintf( outputFile, ">\n" );
+    emitPuts( ">\n" );
 }
 
 
 void SVG_PLOTTER::EndBlock( void* aData )
 {
-    fprintf( outputFile, "</g>\n" );
+    flushPath();
+
+    emitPuts( "</g>\n" );
 
     m_graphics_changed = true;
 }
 
 
+void SVG_PLOTTER::StartSymbol( const wxPoint& aOrigin )
+{
+    if( !m_useSymbols )
+    {
+        StartBlock( NULL );
+        return;
+    }
+
+    wxASSERT( m_output == &m_outputBuffer );
+
+    flushPath();
+
+    // The items of the block are plotted relative to its origin, so that the
+    // identical blocks have identical bodies
+    m_symbolOrigin = aOrigin;
+    m_savedPlotOffset = plotOffset;
+    plotOffset += aOrigin;
+
+    m_symbolBody.clear();
+    m_output = &m_symbolBody;
+
+    // The body must not depend on the style of the group it is used in
+    m_graphics_changed = true;
+}
+
+
+void SVG_PLOTTER::EndSymbol()
+{
+    if( !m_useSymbols )
+    {
+        EndBlock( NULL );
+        return;
+    }
+
+    flushPath();
+
+    m_output = &m_outputBuffer;
+    plotOffset = m_savedPlotOffset;
+    m_graphics_changed = true;
+
+    if( m_symbolBody.empty() )
+        return;
+
+    auto it = m_symbols.find( m_symbolBody );
+    int  id;
+
+    if( it != m_symbols.end() )
+    {
+        id = it->second;
+    }
+    else
+    {
+        id = (int) m_symbols.size();
+
+        // The body starts by closing this group when it sets its first style
+        emitPrintf( "<symbol id=\"sym%d\" overflow=\"visible\">\n<g>\n", id );
+        emitPuts( m_symbolBody.c_str() );
+        emitPuts( "</g>\n</symbol>\n" );
+
+        m_symbols.emplace( std::move( m_symbolBody ), id );
+    }
+
+    DPOINT offset = userToDeviceCoordinates( m_symbolOrigin )
+                    - userToDeviceCoordinates( wxPoint( 0, 0 ) );
+
+    emitPrintf( "<use xlink:href=\"#sym%d\" transform=\"translate(%g %g)\" />\n",
+                id, offset.x, offset.y );
+
+    m_symbolBody.clear();
+}
+
+
 /* initialize m_red, m_green, m_blue ( 0 ... 255)
  * from reduced values r, g ,b ( 0.0 to 1.0 )
  */
@@ -361,23 +508,22 @@ void SVG_PLOTTER::Rect( const wxPoint& p1, const wxPoint& p2, FILL_T fill, int w
 
     setFillMode( fill );
     SetCurrentLineWidth( width );
+    flushPath();
 
     // Rectangles having a 0 size value for height or width are just not drawn on Inscape,
     // so use a line when happens.
     if( rect_dev.GetSize().x == 0.0 || rect_dev.GetSize().y == 0.0 )    // Draw a line
-        fprintf( outputFile,
-                 "<line x1=\"%g\" y1=\"%g\" x2=\"%g\" y2=\"%g\" />\n",
-                 rect_dev.GetPosition().x, rect_dev.GetPosition().y,
-                 rect_dev.GetEnd().x, rect_dev.GetEnd().y
-                 );
+        emitPrintf( "<line x1=\"%g\" y1=\"%g\" x2=\"%g\" y2=\"%g\" />\n",
+                    rect_dev.GetPosition().x, rect_dev.GetPosition().y,
+                    rect_dev.GetEnd().x, rect_dev.GetEnd().y
+                    );
 
     else
-        fprintf( outputFile,
-                 "<rect x=\"%g\" y=\"%g\" width=\"%g\" height=\"%g\" rx=\"%g\" />\n",
-                 rect_dev.GetPosition().x, rect_dev.GetPosition().y,
-                 rect_dev.GetSize().x, rect_dev.GetSize().y,
-                 0.0   // radius of rounded corners
-                 );
+        emitPrintf( "<rect x=\"%g\" y=\"%g\" width=\"%g\" height=\"%g\" rx=\"%g\" />\n",
+                    rect_dev.GetPosition().x, rect_dev.GetPosition().y,
+                    rect_dev.GetSize().x, rect_dev.GetSize().y,
+                    0.0   // radius of rounded corners
+                    );
 }
 
 
@@ -398,9 +544,13 @@ void SVG_PLOTTER::Circle( const wxPoint& pos, int diametre, FILL_T fill, int wid
         radius = userToDeviceSize( ( diametre / 2.0 ) + ( width / 2.0 ) );
     }
 
-    fprintf( outputFile,
-             "<circle cx=\"%g\" cy=\"%g\" r=\"%g\" /> \n",
-             pos_dev.x, pos_dev.y, radius );
+    // The circle is merged in the current path, as two half circles
+    char buffer[256];
+
+    snprintf( buffer, sizeof( buffer ), "M%g %g a%g %g 0 1 0 %g 0 a%g %g 0 1 0 %g 0 \n",
+              pos_dev.x - radius, pos_dev.y, radius, radius, radius * 2,
+              radius, radius, -radius * 2 );
+    m_pathData.append( buffer );
 }
 
 
@@ -487,10 +637,14 @@ void SVG_PLOTTER::Arc( const wxPoint& centre, double StAngle, double EndAngle, i
     // flag arc size (0 = small arc > 180 deg, 1 = large arc > 180 deg),
     // sweep arc ( 0 = CCW, 1 = CW),
     // end point
-    fprintf( outputFile, "<path d=\"M%g %g A%g %g 0.0 %d %d %g %g \" />\n",
-             start.x, start.y, radius_dev, radius_dev,
-             flg_arc, flg_sweep,
-             end.x, end.y  );
+    // The arc is merged in the current path
+    char buffer[256];
+
+    snprintf( buffer, sizeof( buffer ), "M%g %g A%g %g 0.0 %d %d %g %g \n",
+              start.x, start.y, radius_dev, radius_dev,
+              flg_arc, flg_sweep,
+              end.x, end.y  );
+    m_pathData.append( buffer );
 }
 
 
@@ -502,7 +656,10 @@ void SVG_PLOTTER::PlotPoly( const std::vector<wxPoint>& aCornerList,
 
     setFillMode( aFill );
     SetCurrentLineWidth( aWidth );
-    fprintf( outputFile, "<path ");
+
+    // The polygon has its own fill rule: it is never merged
+    flushPath();
+    emitPuts( "<path " );
 
     switch( aFill )
     {
@@ -517,15 +674,15 @@ void SVG_PLOTTER::PlotPoly( const std::vector<wxPoint>& aCornerList,
     }
 
     DPOINT pos = userToDeviceCoordinates( aCornerList[0] );
-    fprintf( outputFile, "d=\"M %d,%d\n", (int) pos.x, (int) pos.y );
+    emitPrintf( "d=\"M %d,%d\n", (int) pos.x, (int) pos.y );
 
     for( unsigned ii = 1; ii < aCornerList.size(); ii++ )
     {
         pos = userToDeviceCoordinates( aCornerList[ii] );
-        fprintf( outputFile, "%d,%d\n", (int) pos.x, (int) pos.y );
+        emitPrintf( "%d,%d\n", (int) pos.x, (int) pos.y );
     }
 
-    fprintf( outputFile, "Z\" /> \n" );
+    emitPuts( "Z\" /> \n" );
 }
 
 
@@ -551,7 +708,7 @@ void SVG_PLOTTER::PenTo( const wxPoint& pos, char plume )
     {
         if( penState != 'Z' )
         {
-            fputs( "\" />\n", outputFile );
+            // The lines stay in the current path, to be merged with the next items
             penState        = 'Z';
             penLastpos.x    = -1;
             penLastpos.y    = -1;
@@ -572,14 +729,16 @@ void SVG_PLOTTER::PenTo( const wxPoint& pos, char plume )
             setSVGPlotStyle();
         }
 
-        fprintf( outputFile, "<path d=\"M%d %d\n",
-                 (int) pos_dev.x, (int) pos_dev.y );
+        char buffer[64];
+        snprintf( buffer, sizeof( buffer ), "M%d %d\n", (int) pos_dev.x, (int) pos_dev.y );
+        m_pathData.append( buffer );
     }
     else if( penState != plume || pos != penLastpos )
     {
         DPOINT pos_dev = userToDeviceCoordinates( pos );
-        fprintf( outputFile, "L%d %d\n",
-                 (int) pos_dev.x, (int) pos_dev.y );
+        char   buffer[64];
+        snprintf( buffer, sizeof( buffer ), "L%d %d\n", (int) pos_dev.x, (int) pos_dev.y );
+        m_pathData.append( buffer );
     }
 
     penState    = plume;
@@ -602,24 +761,29 @@ bool SVG_PLOTTER::StartPlot()
         " <!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\" \n",
         " \"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\"> \n",
         "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\" \n",
+        "    xmlns:xlink=\"http://www.w3.org/1999/xlink\" \n",
         NULL
     };
 
+    m_outputBuffer.clear();
+    m_output = &m_outputBuffer;
+    m_pathData.clear();
+    m_symbols.clear();
+
     // Write header.
     for( int ii = 0; header[ii] != NULL; ii++ )
     {
-        fputs( header[ii], outputFile );
+        emitPuts( header[ii] );
     }
 
     // Write viewport pos and size
     wxPoint origin;    // TODO set to actual value
-    fprintf( outputFile,
-             "    width=\"%gcm\" height=\"%gcm\" viewBox=\"%d %d %d %d \">\n",
-             (double) paperSize.x / m_IUsPerDecimil * 2.54 / 10000,
-             (double) paperSize.y / m_IUsPerDecimil * 2.54 / 10000,
-             origin.x, origin.y,
-             (int) ( paperSize.x / m_IUsPerDecimil ),
-             (int) ( paperSize.y / m_IUsPerDecimil) );
+    emitPrintf( "    width=\"%gcm\" height=\"%gcm\" viewBox=\"%d %d %d %d \">\n",
+                (double) paperSize.x / m_IUsPerDecimil * 2.54 / 10000,
+                (double) paperSize.y / m_IUsPerDecimil * 2.54 / 10000,
+                origin.x, origin.y,
+                (int) ( paperSize.x / m_IUsPerDecimil ),
+                (int) ( paperSize.y / m_IUsPerDecimil) );
 
     // Write title
     char    date_buf[250];
@@ -627,29 +791,29 @@ bool SVG_PLOTTER::StartPlot()
     strftime( date_buf, 250, "%Y/%m/%d %H:%M:%S",
               localtime( &ltime ) );
 
-    fprintf( outputFile,
-             "<title>SVG Picture created as %s date %s </title>\n",
-             TO_UTF8( XmlEsc( wxFileName( filename ).GetFullName() ) ), date_buf );
+    emitPrintf( "<title>SVG Picture created as %s date %s </title>\n",
+                TO_UTF8( XmlEsc( wxFileName( filename ).GetFullName() ) ), date_buf );
     // End of header
-    fprintf( outputFile, "  <desc>Picture generated by %s </desc>\n",
-             TO_UTF8( XmlEsc( creator ) ) );
+    emitPrintf( "  <desc>Picture generated by %s </desc>\n",
+                TO_UTF8( XmlEsc( creator ) ) );
 
     // output the pen and brush color (RVB values in hex) and opacity
     double opacity = 1.0;      // 0.0 (transparent to 1.0 (solid)
-    fprintf( outputFile,
-             "<g style=\"fill:#%6.6lX; fill-opacity:%g;stroke:#%6.6lX; stroke-opacity:%g;\n",
-             m_brush_rgb_color, opacity, m_pen_rgb_color, opacity );
+    emitPrintf( "<g style=\"fill:#%6.6lX; fill-opacity:%g;stroke:#%6.6lX; stroke-opacity:%g;\n",
+                m_brush_rgb_color, opacity, m_pen_rgb_color, opacity );
 
     // output the pen cap and line joint
-    fputs( "stroke-linecap:round; stroke-linejoin:round; \"\n", outputFile );
-    fputs( " transform=\"translate(0 0) scale(1 1)\">\n", outputFile );
+    emitPuts( "stroke-linecap:round; stroke-linejoin:round; \"\n" );
+    emitPuts( " transform=\"translate(0 0) scale(1 1)\">\n" );
     return true;
 }
 
 
 bool SVG_PLOTTER::EndPlot()
 {
-    fputs( "</g> \n</svg>\n", outputFile );
+    flushPath();
+    emitPuts( "</g> \n</svg>\n" );
+    flushOutput();
     fclose( outputFile );
     outputFile = NULL;
 
@@ -676,10 +840,11 @@ void SVG_PLOTTER::Text( const wxPoint&              aPos,
 
     // TODO: see if the postscript native text code can be used in SVG plotter
 
-    fprintf( outputFile,
-             "<g class=\"stroked-text\"><desc>%s</desc>\n",
-             TO_UTF8( XmlEsc( aText ) ) );
+    flushPath();
+    emitPrintf( "<g class=\"stroked-text\"><desc>%s</desc>\n",
+                TO_UTF8( XmlEsc( aText ) ) );
     PLOTTER::Text( aPos, aColor, aText, aOrient, aSize, aH_justify, aV_justify,
                    aWidth, aItalic, aBold, aMultilineAllowed );
-    fputs( "</g>", outputFile );
+    flushPath();
+    emitPuts( "</g>" );
 }
@@ -0,0 +1,214 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file profile_registry.cpp
+ */
+
+#include <profile_registry.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+
+static const char* traceFileVariable = "KICAD_PROFILE_TRACE";
+
+
+std::atomic<bool> PROF_REGISTRY::m_enabled( std::getenv( traceFileVariable ) != nullptr );
+
+
+// The times of the trace are counted from the start of the program
+static const PROF_REGISTRY::CLOCK::time_point programStart = PROF_REGISTRY::CLOCK::now();
+
+
+static void writeTraceAtExit()
+{
+    const char* fileName = std::getenv( traceFileVariable );
+
+    if( fileName && *fileName )
+        PROF_REGISTRY::Get().WriteTrace( std::string( fileName ) );
+}
+
+
+// The registry is never destroyed, as the scopes of static objects destructors may still
+// record their times.
+PROF_REGISTRY& PROF_REGISTRY::Get()
+{
+    static PROF_REGISTRY* registry = new PROF_REGISTRY;
+    return *registry;
+}
+
+
+PROF_REGISTRY::PROF_REGISTRY() :
+    m_origin( programStart )
+{
+    if( std::getenv( traceFileVariable ) )
+        std::atexit( writeTraceAtExit );
+}
+
+
+void PROF_REGISTRY::Enable( bool aEnable )
+{
+    m_enabled.store( aEnable );
+}
+
+
+void PROF_REGISTRY::Clear()
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    m_events.clear();
+    m_totals.clear();
+}
+
+
+static int threadIndex()
+{
+    static std::atomic<int> nextIndex( 0 );
+    thread_local int        index = nextIndex++;
+
+    return index;
+}
+
+
+void PROF_REGISTRY::Record( const std::string& aName, const std::string& aPath,
+                            CLOCK::time_point aStart, CLOCK::time_point aEnd )
+{
+    using US = std::chrono::microseconds;
+    using MS = std::chrono::duration<double, std::milli>;
+
+    int    thread = threadIndex();
+    double ms = std::chrono::duration_cast<MS>( aEnd - aStart ).count();
+
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    if( m_events.size() < MAX_EVENTS )
+    {
+        m_events.push_back( { aName, thread,
+                              std::chrono::duration_cast<US>( aStart - m_origin ).count(),
+                              std::chrono::duration_cast<US>( aEnd - aStart ).count() } );
+    }
+
+    auto it = m_totals.find( aPath );
+
+    if( it == m_totals.end() )
+        it = m_totals.emplace( aPath, TOTAL{ 0, 0.0, 0.0 } ).first;
+
+    it->second.m_count++;
+    it->second.m_totalMs += ms;
+    it->second.m_maxMs = std::max( it->second.m_maxMs, ms );
+}
+
+
+static std::string jsonString( const std::string& aStr )
+{
+    std::string escaped = "\"";
+
+    for( char c : aStr )
+    {
+        switch( c )
+        {
+        case '"':  escaped += "\\\""; break;
+        case '\\': escaped += "\\\\"; break;
+        case '\n': escaped += "\\n";  break;
+        default:   escaped += c;
+        }
+    }
+
+    return escaped + "\"";
+}
+
+
+void PROF_REGISTRY::WriteTrace( std::ostream& aStream )
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    aStream << "{\n\"displayTimeUnit\": \"ms\",\n\"traceEvents\": [\n";
+
+    for( size_t ii = 0; ii < m_events.size(); ++ii )
+    {
+        const EVENT& event = m_events[ii];
+
+        aStream << "{ \"name\": " << jsonString( event.m_name ) << ", \"ph\": \"X\", "
+                << "\"pid\": 1, \"tid\": " << event.m_thread << ", "
+                << "\"ts\": " << event.m_startUs << ", \"dur\": " << event.m_durationUs << " }"
+                << ( ii + 1 < m_events.size() ? ",\n" : "\n" );
+    }
+
+    aStream << "],\n\"scopes\": [\n";
+
+    size_t ii = 0;
+
+    for( const auto& total : m_totals )
+    {
+        aStream << "{ \"path\": " << jsonString( total.first ) << ", "
+                << "\"count\": " << total.second.m_count << ", "
+                << "\"total_ms\": " << total.second.m_totalMs << ", "
+                << "\"max_ms\": " << total.second.m_maxMs << " }"
+                << ( ++ii < m_totals.size() ? ",\n" : "\n" );
+    }
+
+    aStream << "]\n}\n";
+}
+
+
+bool PROF_REGISTRY::WriteTrace( const std::string& aFileName )
+{
+    std::ofstream file( aFileName );
+
+    if( !file )
+        return false;
+
+    WriteTrace( file );
+    return file.good();
+}
+
+
+// The path of the scopes running on each thread, as "outer/inner"
+static thread_local std::string scopePath;
+
+
+void PROF_SCOPE::begin( const std::string& aName )
+{
+    m_parentPathLength = scopePath.size();
+
+    if( !scopePath.empty() )
+        scopePath += '/';
+
+    scopePath += aName;
+    m_start = PROF_REGISTRY::CLOCK::now();
+}
+
+
+void PROF_SCOPE::end()
+{
+    PROF_REGISTRY::CLOCK::time_point stop = PROF_REGISTRY::CLOCK::now();
+
+    size_t      nameStart = m_parentPathLength ? m_parentPathLength + 1 : 0;
+    std::string name = scopePath.substr( nameStart );
+
+    PROF_REGISTRY::Get().Record( name, scopePath, m_start, stop );
+
+    scopePath.resize( m_parentPathLength );
+}
@@ -101,6 +101,61 @@ REPORTER& NULL_REPORTER::Report( const wxString& aText, SEVERITY aSeverity )
     return *this;
 }
 
+void QUEUED_REPORTER::queue( const wxString& aText, SEVERITY aSeverity, LOCATION aLocation )
+{
+    MESSAGE message;
+    message.m_text = aText;
+    message.m_severity = aSeverity;
+    message.m_location = aLocation;
+
+    m_queue.move_push( std::move( message ) );
+    m_hasMessage.store( true );
+}
+
+
+REPORTER& QUEUED_REPORTER::Report( const wxString& aText, SEVERITY aSeverity )
+{
+    queue( aText, aSeverity, LOC_BODY );
+    return *this;
+}
+
+
+REPORTER& QUEUED_REPORTER::ReportTail( const wxString& aText, SEVERITY aSeverity )
+{
+    queue( aText, aSeverity, LOC_TAIL );
+    return *this;
+}
+
+
+REPORTER& QUEUED_REPORTER::ReportHead( const wxString& aText, SEVERITY aSeverity )
+{
+    queue( aText, aSeverity, LOC_HEAD );
+    return *this;
+}
+
+
+void QUEUED_REPORTER::Flush()
+{
+    MESSAGE message;
+
+    while( m_queue.pop( message ) )
+    {
+        switch( message.m_location )
+        {
+        case LOC_HEAD: m_target.ReportHead( message.m_text, message.m_severity ); break;
+        case LOC_TAIL: m_target.ReportTail( message.m_text, message.m_severity ); break;
+        default:       m_target.Report( message.m_text, message.m_severity );     break;
+        }
+    }
+}
+
+
+bool QUEUED_REPORTER::HasMessage() const
+{
+    return m_hasMessage.load();
+}
+
+
 REPORTER& NULL_REPORTER::GetInstance()
 {
     static REPORTER* s_nullReporter = NULL;
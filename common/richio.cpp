@@ -23,6 +23,7 @@
  */
 
 
+#include <algorithm>
 #include <cstdarg>
 #include <config.h> // HAVE_FGETC_NOLOCK
 
@@ -225,6 +226,108 @@ char* FILE_LINE_READER::ReadLine()
 }
 
 
+WHOLE_FILE_LINE_READER::WHOLE_FILE_LINE_READER( const wxString& aFileName,
+            unsigned aStartingLineNumber, unsigned aMaxLineLength ) :
+    LINE_READER( 0 ),       // no line buffer, the lines are returned in place
+    m_size( 0 ), m_ndx( 0 )
+{
+    m_maxLineLength = aMaxLineLength;
+
+    // Binary mode, for fread() to give the file size.  The lexers skip the '\r' of the
+    // DOS line endings anyway.
+    FILE* fp = wxFopen( aFileName, wxT( "rb" ) );
+
+    if( !fp )
+    {
+        wxString msg = wxString::Format(
+            _( "Unable to open filename \"%s\" for reading" ), aFileName.GetData() );
+        THROW_IO_ERROR( msg );
+    }
+
+    bool ok = fseek( fp, 0, SEEK_END ) == 0;
+    long size = ok ? ftell( fp ) : -1;
+
+    if( size > 0 && fseek( fp, 0, SEEK_SET ) == 0 )
+    {
+        m_buffer.resize( size + 1 );
+        m_size = fread( m_buffer.data(), 1, size, fp );
+        ok = m_size == (size_t) size;
+    }
+    else
+    {
+        ok = ok && size == 0;
+    }
+
+    fclose( fp );
+
+    if( !ok )
+    {
+        wxString msg = wxString::Format(
+            _( "Unable to read file \"%s\"" ), aFileName.GetData() );
+        THROW_IO_ERROR( msg );
+    }
+
+    m_buffer.resize( m_size + 1 );
+    m_buffer[m_size] = 0;
+    m_nextChar = m_buffer[0];
+
+    // an empty line until the first ReadLine()
+    m_line = &m_buffer[m_size];
+
+    m_source  = aFileName;
+    m_lineNum = aStartingLineNumber;
+}
+
+
+WHOLE_FILE_LINE_READER::~WHOLE_FILE_LINE_READER()
+{
+    // m_line points in m_buffer, it is not owned
+    m_line = NULL;
+}
+
+
+char* WHOLE_FILE_LINE_READER::ReadLine()
+{
+    // restore the first byte of this line, replaced by the nul of the previous line
+    m_buffer[m_ndx] = m_nextChar;
+
+    const char* begin = &m_buffer[m_ndx];
+    const char* nl = (const char*) memchr( begin, '\n', m_size - m_ndx );
+
+    size_t end = nl ? nl - m_buffer.data() + 1 : m_size;
+
+    m_length = end - m_ndx;
+
+    if( m_length >= m_maxLineLength )
+        THROW_IO_ERROR( _( "Maximum line length exceeded" ) );
+
+    m_line = &m_buffer[m_ndx];
+    m_nextChar = m_buffer[end];
+    m_buffer[end] = 0;
+    m_ndx = end;
+
+    // m_lineNum is incremented even if there was no line read, because this
+    // leads to better error reporting when we hit an end of file.
+    ++m_lineNum;
+
+    return m_length ? m_line : NULL;
+}
+
+
+void WHOLE_FILE_LINE_READER::Rewind()
+{
+    m_buffer[m_ndx] = m_nextChar;
+
+    m_ndx = 0;
+    m_nextChar = m_buffer[0];
+
+    // an empty line until the first ReadLine()
+    m_line = &m_buffer[m_size];
+    m_length = 0;
+    m_lineNum = 0;
+}
+
+
 STRING_LINE_READER::STRING_LINE_READER( const std::string& aString, const wxString& aSource ):
     LINE_READER( LINE_READER_LINE_DEFAULT_MAX ),
     m_lines( aString ), m_ndx( 0 )
@@ -412,10 +515,14 @@ int OUTPUTFORMATTER::Print( int nestLevel, const char* fmt, ... )
     int result = 0;
     int total  = 0;
 
-    for( int i=0; i<nestLevel;  ++i )
+    // The indentation is written by blocks of spaces, instead of formatting each level.
+    static const char spaces[] = "                                ";     // 32 spaces
+
+    for( int width = nestLevel * NESTWIDTH; width > 0; width -= sizeof( spaces ) - 1 )
     {
         // no error checking needed, an exception indicates an error.
-        result = sprint( "%*c", NESTWIDTH, ' ' );
+        result = std::min<int>( width, sizeof( spaces ) - 1 );
+        write( spaces, result );
 
         total += result;
     }
@@ -504,6 +611,8 @@ void STRING_FORMATTER::StripUseless()
 
 //-----<FILE_OUTPUTFORMATTER>----------------------------------------
 
+#define FILE_OUTPUTFORMATTER_BUFFER_SIZE    ( 256 * 1024 )
+
 FILE_OUTPUTFORMATTER::FILE_OUTPUTFORMATTER( const wxString& aFileName, const wxChar* aMode,
                                             char aQuoteChar ):
     OUTPUTFORMATTER( OUTPUTFMTBUFZ, aQuoteChar ),
@@ -513,6 +622,10 @@ FILE_OUTPUTFORMATTER::FILE_OUTPUTFORMATTER( const wxString& aFileName, const wxC
 
     if( !m_fp )
         THROW_IO_ERROR( strerror( errno ) );
+
+    // The lines are written by small pieces: a big stdio buffer saves most of the writes
+    // to the file.
+    setvbuf( m_fp, NULL, _IOFBF, FILE_OUTPUTFORMATTER_BUFFER_SIZE );
 }
 
 
@@ -31,6 +31,9 @@
 #include <richio.h>                        // StrPrintf
 #include <kicad_string.h>
 
+#include <cfloat>
+#include <cstdint>
+
 
 /**
  * Illegal file name characters used to insure file names will be valid on all supported
@@ -295,6 +298,73 @@ wxString EscapedHTML( const wxString& aString )
 }
 
 
+double StrToDouble( const char* aText, char** aEndPtr )
+{
+    // The powers of ten which are exact doubles
+    static const double powersOf10[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    const char* cur = aText;
+    bool        negative = false;
+
+    if( *cur == '+' || *cur == '-' )
+        negative = *cur++ == '-';
+
+    uint64_t    mantissa = 0;
+    int         digits = 0;         // significant digits, without the leading zeros
+    int         exponent = 0;
+    bool        hasDigits = false;
+    bool        fraction = false;
+
+    for( ;; ++cur )
+    {
+        if( *cur >= '0' && *cur <= '9' )
+        {
+            hasDigits = true;
+
+            if( mantissa || *cur != '0' )
+            {
+                if( ++digits <= 15 )
+                    mantissa = mantissa * 10 + ( *cur - '0' );
+            }
+
+            if( fraction )
+                --exponent;
+        }
+        else if( *cur == '.' && !fraction )
+        {
+            fraction = true;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    // The mantissa and the power of ten are exact doubles, and the division is correctly
+    // rounded, as strtod() is, when the floating point operations have no extra precision.
+    // Leave the exponents, hexadecimal numbers, infinities and NaNs to strtod().
+    bool fastPath = hasDigits && digits <= 15 && exponent >= -22
+                    && *cur != 'e' && *cur != 'E' && *cur != 'x' && *cur != 'X';
+
+#if !defined( FLT_EVAL_METHOD ) || FLT_EVAL_METHOD != 0
+    fastPath = false;
+#endif
+
+    if( !fastPath )
+        return strtod( aText, aEndPtr );
+
+    double value = (double) mantissa / powersOf10[-exponent];
+
+    if( aEndPtr )
+        *aEndPtr = const_cast<char*>( cur );
+
+    return negative ? -value : value;
+}
+
+
 char* StrPurge( char* text )
 {
     static const char whitespace[] = " \t\n\r\f\v";
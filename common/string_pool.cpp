@@ -0,0 +1,82 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file string_pool.cpp
+ */
+
+#include <string_pool.h>
+
+#include <mutex>
+#include <unordered_set>
+
+#include <common.h>
+
+
+COMPACT_STRING::COMPACT_STRING( const wxString& aText )
+{
+    if( !aText.IsEmpty() )
+        m_text = std::make_shared<const std::string>( (const char*) aText.utf8_str() );
+}
+
+
+wxString COMPACT_STRING::wx_str() const
+{
+    if( !m_text )
+        return wxEmptyString;
+
+    return wxString( m_text->c_str(), wxConvUTF8 );
+}
+
+
+// The pool is built on first use, and never destroyed so that the interned strings
+// outlive the static objects referring to them.
+static std::unordered_set<wxString>& stringPool()
+{
+    static std::unordered_set<wxString>* pool = new std::unordered_set<wxString>;
+    return *pool;
+}
+
+
+static std::mutex stringPoolLock;
+
+
+// The elements of an unordered_set are not moved by a rehash: their addresses are stable
+static const wxString* intern( const wxString& aText )
+{
+    std::lock_guard<std::mutex> lock( stringPoolLock );
+
+    return &*stringPool().insert( aText ).first;
+}
+
+
+INTERNED_STRING::INTERNED_STRING() :
+    m_text( intern( wxEmptyString ) )
+{
+}
+
+
+INTERNED_STRING::INTERNED_STRING( const wxString& aText ) :
+    m_text( intern( aText ) )
+{
+}
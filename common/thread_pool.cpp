@@ -0,0 +1,287 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <thread_pool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <advanced_config.h>
+
+
+// The pool and the index of the worker running on this thread, if any
+static thread_local THREAD_POOL* t_pool = nullptr;
+static thread_local size_t       t_worker = 0;
+
+
+THREAD_POOL& THREAD_POOL::GetPool()
+{
+    // The pool is never destroyed: joining its workers from a static destructor can
+    // deadlock when a kiface is unloaded.  The workers end with the process.
+    static THREAD_POOL* pool = nullptr;
+    static std::once_flag created;
+
+    std::call_once( created, []()
+            {
+                size_t threads = GetCoreCount();
+                int    maxThreads = ADVANCED_CFG::GetCfg().m_maxWorkerThreads;
+
+                if( maxThreads > 0 )
+                    threads = std::min<size_t>( threads, maxThreads );
+
+                pool = new THREAD_POOL( threads );
+            } );
+
+    return *pool;
+}
+
+
+size_t THREAD_POOL::GetCoreCount()
+{
+#ifdef __linux__
+    cpu_set_t allowed;
+
+    if( sched_getaffinity( 0, sizeof( allowed ), &allowed ) == 0 && CPU_COUNT( &allowed ) > 0 )
+        return CPU_COUNT( &allowed );
+#endif
+
+    return std::max<size_t>( 1, std::thread::hardware_concurrency() );
+}
+
+
+THREAD_POOL::THREAD_POOL( size_t aThreadCount ) :
+        m_pending( 0 ),
+        m_nextQueue( 0 )
+{
+    for( size_t ii = 0; ii < aThreadCount; ++ii )
+        m_queues.emplace_back( new QUEUE );
+
+    for( size_t ii = 0; ii < aThreadCount; ++ii )
+        m_workers.emplace_back( &THREAD_POOL::workerLoop, this, ii );
+
+#ifdef __linux__
+    // Each worker is pinned to one of the allowed cores, in turn
+    cpu_set_t allowed;
+
+    if( ADVANCED_CFG::GetCfg().m_pinWorkerThreads
+            && sched_getaffinity( 0, sizeof( allowed ), &allowed ) == 0 )
+    {
+        std::vector<int> cores;
+
+        for( int cpu = 0; cpu < CPU_SETSIZE; ++cpu )
+        {
+            if( CPU_ISSET( cpu, &allowed ) )
+                cores.push_back( cpu );
+        }
+
+        for( size_t ii = 0; ii < m_workers.size() && !cores.empty(); ++ii )
+        {
+            cpu_set_t core;
+            CPU_ZERO( &core );
+            CPU_SET( cores[ii % cores.size()], &core );
+            pthread_setaffinity_np( m_workers[ii].native_handle(), sizeof( core ), &core );
+        }
+    }
+#endif
+}
+
+
+void THREAD_POOL::Submit( TASK aTask )
+{
+    size_t queue = ( t_pool == this ) ? t_worker : m_nextQueue++ % m_queues.size();
+
+    // The task is counted before it is queued, so that the count never drops below zero
+    {
+        std::lock_guard<std::mutex> lock( m_wakeLock );
+        m_pending++;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( m_queues[queue]->m_lock );
+        m_queues[queue]->m_tasks.push_back( std::move( aTask ) );
+    }
+
+    m_wake.notify_one();
+}
+
+
+bool THREAD_POOL::popTask( size_t aWorker, TASK& aTask )
+{
+    bool found = false;
+
+    // The last task of its own queue is the most recent one, whose data is likely still
+    // in the cache.  The oldest tasks of the other queues are stolen first.
+    {
+        QUEUE&                      own = *m_queues[aWorker];
+        std::lock_guard<std::mutex> lock( own.m_lock );
+
+        if( !own.m_tasks.empty() )
+        {
+            aTask = std::move( own.m_tasks.back() );
+            own.m_tasks.pop_back();
+            found = true;
+        }
+    }
+
+    for( size_t ii = 1; !found && ii < m_queues.size(); ++ii )
+    {
+        QUEUE&                      other = *m_queues[( aWorker + ii ) % m_queues.size()];
+        std::lock_guard<std::mutex> lock( other.m_lock );
+
+        if( !other.m_tasks.empty() )
+        {
+            aTask = std::move( other.m_tasks.front() );
+            other.m_tasks.pop_front();
+            found = true;
+        }
+    }
+
+    if( found )
+    {
+        std::lock_guard<std::mutex> lock( m_wakeLock );
+        m_pending--;
+    }
+
+    return found;
+}
+
+
+void THREAD_POOL::workerLoop( size_t aWorker )
+{
+    t_pool = this;
+    t_worker = aWorker;
+
+    TASK task;
+
+    while( true )
+    {
+        if( popTask( aWorker, task ) )
+        {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock( m_wakeLock );
+        m_wake.wait( lock, [this]() { return m_pending > 0; } );
+    }
+}
+
+
+void THREAD_POOL::ParallelFor( size_t aCount, const std::function<void( size_t )>& aWork,
+                               size_t aChunkSize, size_t aMaxThreads,
+                               const std::function<void()>& aWaiting )
+{
+    if( aCount == 0 )
+        return;
+
+    // A worker has to run the loop too: the other workers could all be waiting for it
+    bool   callerWorks = !aWaiting || t_pool == this;
+    size_t threads = GetThreadCount() + ( callerWorks && t_pool != this ? 1 : 0 );
+
+    if( aMaxThreads > 0 )
+        threads = std::min( threads, aMaxThreads );
+
+    threads = std::max<size_t>( 1, threads );
+
+    if( aChunkSize == 0 )
+        aChunkSize = std::max<size_t>( 1, aCount / ( threads * 4 ) );
+
+    size_t chunkCount = ( aCount + aChunkSize - 1 ) / aChunkSize;
+    size_t helpers = std::min( threads, chunkCount ) - ( callerWorks ? 1 : 0 );
+
+    if( helpers == 0 )
+    {
+        for( size_t ii = 0; ii < aCount; ++ii )
+            aWork( ii );
+
+        return;
+    }
+
+    struct LOOP
+    {
+        std::atomic<size_t>     m_nextChunk { 0 };
+        std::mutex              m_lock;
+        std::condition_variable m_done;
+        size_t                  m_doneChunks = 0;
+        std::exception_ptr      m_error;
+    };
+
+    auto loop = std::make_shared<LOOP>();
+
+    // A helper starting after the end of the loop finds no chunk left, and does not use
+    // aWork any more: only the loop state is shared with it.
+    auto run = [loop, &aWork, aCount, aChunkSize, chunkCount]()
+    {
+        for( size_t chunk = loop->m_nextChunk++; chunk < chunkCount; chunk = loop->m_nextChunk++ )
+        {
+            size_t last = std::min( aCount, ( chunk + 1 ) * aChunkSize );
+
+            try
+            {
+                for( size_t ii = chunk * aChunkSize; ii < last; ++ii )
+                    aWork( ii );
+            }
+            catch( ... )
+            {
+                std::lock_guard<std::mutex> lock( loop->m_lock );
+
+                if( !loop->m_error )
+                    loop->m_error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock( loop->m_lock );
+
+            if( ++loop->m_doneChunks == chunkCount )
+                loop->m_done.notify_all();
+        }
+    };
+
+    for( size_t ii = 0; ii < helpers; ++ii )
+        Submit( run );
+
+    if( callerWorks )
+        run();
+
+    std::unique_lock<std::mutex> lock( loop->m_lock );
+
+    while( loop->m_doneChunks < chunkCount )
+    {
+        loop->m_done.wait_for( lock, std::chrono::milliseconds( 100 ) );
+
+        if( aWaiting && loop->m_doneChunks < chunkCount )
+        {
+            lock.unlock();
+            aWaiting();
+            lock.lock();
+        }
+    }
+
+    if( loop->m_error )
+        std::rethrow_exception( loop->m_error );
+}
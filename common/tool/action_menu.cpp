@@ -123,7 +123,7 @@ void ACTION_MENU::DisplayTitle( bool aDisplay )
             Insert( 0, new wxMenuItem( this, wxID_NONE, m_title, wxEmptyString, wxITEM_NORMAL ) );
 
             if( m_icon )
-                AddBitmapToMenuItem( FindItemByPosition( 0 ), KiBitmap( m_icon ) );
+                AddBitmapToMenuItem( FindItemByPosition( 0 ), m_icon );
 
             m_titleDisplayed = true;
         }
@@ -138,7 +138,7 @@ wxMenuItem* ACTION_MENU::Add( const wxString& aLabel, int aId, const BITMAP_OPAQ
     wxMenuItem* item = new wxMenuItem( this, aId, aLabel, wxEmptyString, wxITEM_NORMAL );
 
     if( aIcon )
-        AddBitmapToMenuItem( item, KiBitmap( aIcon ) );
+        AddBitmapToMenuItem( item, aIcon );
 
     return Append( item );
 }
@@ -152,7 +152,7 @@ wxMenuItem* ACTION_MENU::Add( const wxString& aLabel, const wxString& aTooltip,
     wxMenuItem* item = new wxMenuItem( this, aId, aLabel, aTooltip, wxITEM_NORMAL );
 
     if( aIcon )
-        AddBitmapToMenuItem( item, KiBitmap( aIcon ) );
+        AddBitmapToMenuItem( item, aIcon );
 
     return Append( item );
 }
@@ -168,7 +168,7 @@ wxMenuItem* ACTION_MENU::Add( const TOOL_ACTION& aAction, bool aIsCheckmarkEntry
                                        aIsCheckmarkEntry ? wxITEM_CHECK : wxITEM_NORMAL );
 
     if( icon )
-        AddBitmapToMenuItem( item, KiBitmap( icon ) );
+        AddBitmapToMenuItem( item, icon );
 
     m_toolActions[getMenuId( aAction )] = &aAction;
 
@@ -187,7 +187,7 @@ wxMenuItem* ACTION_MENU::Add( ACTION_MENU* aMenu )
     if( aMenu->m_icon )
     {
         wxMenuItem* newItem = new wxMenuItem( this, -1, menuCopy->m_title );
-        AddBitmapToMenuItem( newItem, KiBitmap( aMenu->m_icon ) );
+        AddBitmapToMenuItem( newItem, aMenu->m_icon );
         newItem->SetSubMenu( menuCopy );
         return Append( newItem );
     }
@@ -63,11 +63,9 @@ void CONDITIONAL_MENU::AddItem( int aId, const wxString& aText, const wxString&
                                 BITMAP_DEF aIcon, const SELECTION_CONDITION& aCondition,
                                 int aOrder )
 {
+    // The icon is only set on the copies of the item made by Evaluate()
     wxMenuItem* item = new wxMenuItem( nullptr, aId, aText, aTooltip, wxITEM_NORMAL );
 
-    if( aIcon )
-        AddBitmapToMenuItem( item, KiBitmap( aIcon ) );
-
     addEntry( ENTRY( item, aIcon, aCondition, aOrder, false ) );
 }
 
@@ -76,11 +74,9 @@ void CONDITIONAL_MENU::AddCheckItem( int aId, const wxString& aText, const wxStr
                                      BITMAP_DEF aIcon, const SELECTION_CONDITION& aCondition,
                                      int aOrder )
 {
+    // The icon is only set on the copies of the item made by Evaluate()
     wxMenuItem* item = new wxMenuItem( nullptr, aId, aText, aTooltip, wxITEM_CHECK );
 
-    if( aIcon )
-        AddBitmapToMenuItem( item, KiBitmap( aIcon ) );
-
     addEntry( ENTRY( item, aIcon, aCondition, aOrder, true ) );
 }
 
@@ -169,7 +165,7 @@ void CONDITIONAL_MENU::Evaluate( SELECTION& aSelection )
                                            entry.wxItem()->GetKind() );
 
                 if( entry.GetIcon() )
-                    AddBitmapToMenuItem( menuItem, KiBitmap( entry.GetIcon() ) );
+                    AddBitmapToMenuItem( menuItem, entry.GetIcon() );
 
                 // the wxMenuItem must be append only after the bitmap is set:
                 Append( menuItem );
@@ -37,6 +37,7 @@
 #include <pcbnew_id.h>
 
 #include <core/optional.h>
+#include <advanced_config.h>
 
 
 ///> Stores information about a mouse button state
@@ -143,6 +144,20 @@ void TOOL_DISPATCHER::ResetState()
 {
     for( BUTTON_STATE* st : m_buttons )
         st->Reset();
+
+    m_pendingMotion = NULLOPT;
+}
+
+
+void TOOL_DISPATCHER::dispatchPendingMotion()
+{
+    if( !m_pendingMotion )
+        return;
+
+    TOOL_EVENT evt = *m_pendingMotion;
+    m_pendingMotion = NULLOPT;
+
+    m_toolMgr->ProcessEvent( evt );
 }
 
 
@@ -239,6 +254,7 @@ bool TOOL_DISPATCHER::handleMouseButton( wxEvent& aEvent, int aIndex, bool aMoti
     if( evt )
     {
         evt->SetMousePosition( isClick ? st->downPosition : m_lastMousePos );
+        dispatchPendingMotion();
         m_toolMgr->ProcessEvent( *evt );
 
         return true;
@@ -460,11 +476,24 @@ void TOOL_DISPATCHER::DispatchWxEvent( wxEvent& aEvent )
     }
 
     bool handled = false;
+    bool hasEvent = !!evt;
+
+    // A burst of motion events is sent to the tools as its last one, once the event loop
+    // has no other event to process
+    if( evt && type == wxEVT_MOTION && ADVANCED_CFG::GetCfg().m_coalesceMouseMotion )
+    {
+        if( !m_pendingMotion )
+            CallAfter( &TOOL_DISPATCHER::dispatchPendingMotion );
+
+        m_pendingMotion = evt;
+        evt = NULLOPT;
+    }
 
     if( evt )
     {
         wxLogTrace( kicadTraceToolStack, "TOOL_DISPATCHER::DispatchWxEvent %s", evt->Format() );
 
+        dispatchPendingMotion();
         handled = m_toolMgr->ProcessEvent( *evt );
 
         // ESC is the special key for canceling tools, and is therefore seen as handled
@@ -486,7 +515,7 @@ void TOOL_DISPATCHER::DispatchWxEvent( wxEvent& aEvent )
     // (PAGE_UP, PAGE_DOWN) have predefined actions (like move thumbtrack cursor), and we do
     // not want these actions executed (most are handled by KiCad)
 
-    if( !evt || type == wxEVT_LEFT_DOWN )
+    if( !hasEvent || type == wxEVT_LEFT_DOWN )
         aEvent.Skip();
 
     // Not handled wxEVT_CHAR must be Skipped (sent to GUI).
@@ -504,6 +533,7 @@ void TOOL_DISPATCHER::DispatchWxCommand( wxCommandEvent& aEvent )
     {
         wxLogTrace( kicadTraceToolStack, "TOOL_DISPATCHER::DispatchWxCommand %s", evt->Format() );
 
+        dispatchPendingMotion();
         m_toolMgr->ProcessEvent( *evt );
     }
     else
@@ -65,6 +65,7 @@ struct TOOL_MANAGER::TOOL_STATE
         wakeupEvent = aState.wakeupEvent;
         waitEvents = aState.waitEvents;
         transitions = aState.transitions;
+        transitionCategories = aState.transitionCategories;
         vcSettings = aState.vcSettings;
         // do not copy stateStack
     }
@@ -107,6 +108,10 @@ struct TOOL_MANAGER::TOOL_STATE
     /// upon the event reception
     std::vector<TRANSITION> transitions;
 
+    /// Union of the categories of the events in the transitions, so the tools with no
+    /// transition for the category of an event are skipped without matching each of them
+    int transitionCategories;
+
     /// VIEW_CONTROLS settings to preserve settings when the tools are switched
     KIGFX::VC_SETTINGS vcSettings;
 
@@ -122,6 +127,7 @@ struct TOOL_MANAGER::TOOL_STATE
         wakeupEvent = aState.wakeupEvent;
         waitEvents = aState.waitEvents;
         transitions = aState.transitions;
+        transitionCategories = aState.transitionCategories;
         vcSettings = aState.vcSettings;
         // do not copy stateStack
         return *this;
@@ -187,6 +193,7 @@ private:
         contextMenuTrigger = CMENU_OFF;
         vcSettings.Reset();
         transitions.clear();
+        transitionCategories = 0;
     }
 };
 
@@ -490,12 +497,18 @@ void TOOL_MANAGER::ScheduleNextState( TOOL_BASE* aTool, TOOL_STATE_FUNC& aHandle
     TOOL_STATE* st = m_toolState[aTool];
 
     st->transitions.emplace_back( TRANSITION( aConditions, aHandler ) );
+
+    for( auto it = aConditions.cbegin(); it != aConditions.cend(); ++it )
+        st->transitionCategories |= it->Category();
 }
 
 
 void TOOL_MANAGER::ClearTransitions( TOOL_BASE* aTool )
 {
-    m_toolState[aTool]->transitions.clear();
+    TOOL_STATE* st = m_toolState[aTool];
+
+    st->transitions.clear();
+    st->transitionCategories = 0;
 }
 
 
@@ -590,7 +603,7 @@ bool TOOL_MANAGER::dispatchInternal( const TOOL_EVENT& aEvent )
 
         // no state handler in progress - check if there are any transitions (defined by
         // Go() method that match the event.
-        if( !st->transitions.empty() )
+        if( ( st->transitionCategories & aEvent.Category() ) && !st->transitions.empty() )
         {
             for( TRANSITION& tr : st->transitions )
             {
@@ -614,6 +627,7 @@ bool TOOL_MANAGER::dispatchInternal( const TOOL_EVENT& aEvent )
 
                     // as the state changes, the transition table has to be set up again
                     st->transitions.clear();
+                    st->transitionCategories = 0;
 
                     wxLogTrace( kicadTraceToolStack,
                             "TOOL_MANAGER::dispatchInternal Running tool %s for event: %s",
@@ -39,6 +39,7 @@
 
 #ifdef __WXDEBUG__
 #include <profile.h>
+#include <profile_registry.h>
 #endif /* __WXDEBUG__  */
 
 namespace KIGFX {
@@ -90,6 +91,7 @@ private:
     int     m_flags;            ///< Visibility flags
     int     m_requiredUpdate;   ///< Flag required for updating
     int     m_drawPriority;     ///< Order to draw this item in a layer, lowest first
+    BOX2I   m_bbox;             ///< Bounding box of the item in the layer R-trees
 
     ///> Helper for storing cached items group ids
     typedef std::pair<int, int> GroupPair;
@@ -117,6 +119,38 @@ private:
         return -1;
     }
 
+    /**
+     * Function getProxyGroup()
+     * Returns the group id of the simplified geometry for the given layer, or -1 in case it was
+     * not cached before. Proxy groups are stored next to the regular ones, with shifted layer
+     * numbers.
+     */
+    int getProxyGroup( int aLayer ) const
+    {
+        return getGroup( aLayer + VIEW::VIEW_MAX_LAYERS );
+    }
+
+    /**
+     * Function releaseProxyGroup()
+     * Forgets the group id of the simplified geometry for the given layer.
+     *
+     * @return the group id to be deleted or -1 if there was none.
+     */
+    int releaseProxyGroup( int aLayer )
+    {
+        for( int i = 0; i < m_groupsSize; ++i )
+        {
+            if( m_groups[i].first == aLayer + VIEW::VIEW_MAX_LAYERS )
+            {
+                int group = m_groups[i].second;
+                m_groups[i].second = -1;
+                return group;
+            }
+        }
+
+        return -1;
+    }
+
     /**
      * Function getAllGroups()
      * Returns all group ids for the item (collected from all layers the item occupies).
@@ -202,7 +236,9 @@ private:
     {
         for( int i = 0; i < m_groupsSize; ++i )
         {
-            int orig_layer = m_groups[i].first;
+            // Proxy groups keep their shift
+            int shift = m_groups[i].first >= VIEW::VIEW_MAX_LAYERS ? VIEW::VIEW_MAX_LAYERS : 0;
+            int orig_layer = m_groups[i].first - shift;
             int new_layer = orig_layer;
 
             try
@@ -211,7 +247,7 @@ private:
             }
             catch( const std::out_of_range& ) {}
 
-            m_groups[i].first = new_layer;
+            m_groups[i].first = new_layer + shift;
         }
     }
 
@@ -293,7 +329,11 @@ VIEW::VIEW( bool aIsDynamic ) :
     m_dynamic( aIsDynamic ),
     m_useDrawPriority( false ),
     m_nextDrawPriority( 0 ),
-    m_reverseDrawOrder( false )
+    m_reverseDrawOrder( false ),
+    m_isClipped( false ),
+    m_redrawStats(),
+    m_bulkAdd( false ),
+    m_bulkUpdate( false )
 {
     // Set m_boundary to define the max area size. The default area size
     // is defined here as the max value of a int.
@@ -339,6 +379,7 @@ void VIEW::AddLayer( int aLayer, bool aDisplayOnly )
         m_layers[aLayer].visible        = true;
         m_layers[aLayer].displayOnly    = aDisplayOnly;
         m_layers[aLayer].target         = TARGET_CACHED;
+        m_layers[aLayer].hasDeferredItems = false;
     }
 }
 
@@ -358,14 +399,22 @@ void VIEW::Add( VIEW_ITEM* aItem, int aDrawPriority )
 
     aItem->ViewGetLayers( layers, layers_count );
     aItem->viewPrivData()->saveLayers( layers, layers_count );
+    aItem->viewPrivData()->m_bbox = aItem->ViewBBox();
 
-    m_allItems->push_back( aItem );
+    // An item removed and added again in a bulk update is still in the list
+    if( !m_bulkUpdate || m_bulkRemoved.erase( aItem ) == 0 )
+        m_allItems->push_back( aItem );
 
     for( int i = 0; i < layers_count; ++i )
     {
         VIEW_LAYER& l = m_layers[layers[i]];
-        l.items->Insert( aItem );
-        MarkTargetDirty( l.target );
+
+        if( m_bulkAdd )
+            l.bulkItems.push_back( aItem );
+        else
+            l.items->Insert( aItem );
+
+        markTargetDirtyArea( l.target, aItem->viewPrivData()->m_bbox );
     }
 
     SetVisible( aItem, true );
@@ -373,6 +422,118 @@ void VIEW::Add( VIEW_ITEM* aItem, int aDrawPriority )
 }
 
 
+void VIEW::EndBulkAdd()
+{
+    m_bulkAdd = false;
+
+    BOX2I all;
+    all.SetMaximum();
+
+    for( auto& i : m_layers )
+    {
+        VIEW_LAYER& l = i.second;
+
+        if( l.bulkItems.empty() && l.bulkRemoved.empty() )
+            continue;
+
+        // The items already in the tree are packed together with the new ones
+        auto collect = [&l]( VIEW_ITEM* aItem ) -> bool
+                {
+                    if( !l.bulkRemoved.count( aItem ) )
+                        l.bulkItems.push_back( aItem );
+
+                    return true;
+                };
+
+        l.items->Query( all, collect );
+        l.items->BulkLoad( l.bulkItems );
+
+        std::vector<VIEW_ITEM*>().swap( l.bulkItems );
+        l.bulkRemoved.clear();
+    }
+}
+
+
+void VIEW::EndBulkUpdate()
+{
+    m_bulkUpdate = false;
+
+    if( !m_bulkRemoved.empty() )
+    {
+        m_allItems->erase( std::remove_if( m_allItems->begin(), m_allItems->end(),
+                                           [this]( VIEW_ITEM* aItem )
+                                           {
+                                               return m_bulkRemoved.count( aItem ) > 0;
+                                           } ),
+                           m_allItems->end() );
+
+        m_bulkRemoved.clear();
+    }
+
+    // The items waiting for a new bounding box or new layers are indexed again with the
+    // others, and are only painted again by UpdateItems().  The items just added are already
+    // waiting to be indexed.
+    for( VIEW_ITEM* item : *m_allItems )
+    {
+        auto viewData = item->viewPrivData();
+
+        if( !viewData || ( viewData->m_requiredUpdate & INITIAL_ADD )
+                || !( viewData->m_requiredUpdate & ( GEOMETRY | LAYERS ) ) )
+            continue;
+
+        bool newLayers = viewData->m_requiredUpdate & LAYERS;
+        int  layers[VIEW_MAX_LAYERS], layers_count;
+
+        BOX2I dirtyArea = viewData->m_bbox;
+        viewData->m_bbox = item->ViewBBox();
+        dirtyArea.Merge( viewData->m_bbox );
+
+        viewData->getLayers( layers, layers_count );
+
+        for( int i = 0; i < layers_count; ++i )
+        {
+            VIEW_LAYER& l = m_layers[layers[i]];
+            l.bulkRemoved.insert( item );
+            markTargetDirtyArea( l.target, dirtyArea );
+
+            if( newLayers && IsCached( l.id ) )
+            {
+                int prevGroup = viewData->getGroup( layers[i] );
+
+                if( prevGroup >= 0 )
+                {
+                    m_gal->DeleteGroup( prevGroup );
+                    viewData->setGroup( l.id, -1 );
+                }
+
+                int proxyGroup = viewData->releaseProxyGroup( l.id );
+
+                if( proxyGroup >= 0 )
+                    m_gal->DeleteGroup( proxyGroup );
+            }
+        }
+
+        if( newLayers )
+        {
+            item->ViewGetLayers( layers, layers_count );
+            viewData->saveLayers( layers, layers_count );
+        }
+
+        for( int i = 0; i < layers_count; ++i )
+        {
+            VIEW_LAYER& l = m_layers[layers[i]];
+            l.bulkItems.push_back( item );
+            markTargetDirtyArea( l.target, dirtyArea );
+        }
+
+        viewData->m_requiredUpdate &= ~( GEOMETRY | LAYERS );
+        viewData->m_requiredUpdate |= REPAINT;
+    }
+
+    EndBulkAdd();
+}
+
+
 void VIEW::Remove( VIEW_ITEM* aItem )
 {
     if( !aItem )
@@ -384,13 +545,23 @@ void VIEW::Remove( VIEW_ITEM* aItem )
         return;
 
     wxCHECK( viewData->m_view == this, /*void*/ );
-    auto item = std::find( m_allItems->begin(), m_allItems->end(), aItem );
 
-    if( item != m_allItems->end() )
+    if( m_bulkUpdate )
     {
-        m_allItems->erase( item );
+        // The removed items leave the list all at once in EndBulkUpdate()
+        m_bulkRemoved.insert( aItem );
         viewData->clearUpdateFlags();
     }
+    else
+    {
+        auto item = std::find( m_allItems->begin(), m_allItems->end(), aItem );
+
+        if( item != m_allItems->end() )
+        {
+            m_allItems->erase( item );
+            viewData->clearUpdateFlags();
+        }
+    }
 
     int layers[VIEW::VIEW_MAX_LAYERS], layers_count;
     viewData->getLayers( layers, layers_count );
@@ -398,14 +569,28 @@ void VIEW::Remove( VIEW_ITEM* aItem )
     for( int i = 0; i < layers_count; ++i )
     {
         VIEW_LAYER& l = m_layers[layers[i]];
-        l.items->Remove( aItem );
-        MarkTargetDirty( l.target );
+
+        if( m_bulkAdd )
+            l.bulkItems.erase( std::remove( l.bulkItems.begin(), l.bulkItems.end(), aItem ),
+                               l.bulkItems.end() );
+
+        if( m_bulkUpdate )
+            l.bulkRemoved.insert( aItem );
+        else
+            l.items->Remove( aItem );
+
+        markTargetDirtyArea( l.target, viewData->m_bbox );
 
         // Clear the GAL cache
         int prevGroup = viewData->getGroup( layers[i] );
 
         if( prevGroup >= 0 )
             m_gal->DeleteGroup( prevGroup );
+
+        int proxyGroup = viewData->releaseProxyGroup( layers[i] );
+
+        if( proxyGroup >= 0 )
+            m_gal->DeleteGroup( proxyGroup );
     }
 
     viewData->deleteGroups();
@@ -472,6 +657,20 @@ int VIEW::Query( const BOX2I& aRect, std::vector<LAYER_ITEM_PAIR>& aResult ) con
 }
 
 
+int VIEW::QueryAllLayers( const BOX2I& aRect, std::vector<LAYER_ITEM_PAIR>& aResult ) const
+{
+    std::vector<VIEW_LAYER*>::const_reverse_iterator i;
+
+    for( i = m_orderedLayers.rbegin(); i != m_orderedLayers.rend(); ++i )
+    {
+        queryVisitor<std::vector<LAYER_ITEM_PAIR> > visitor( aResult, ( *i )->id );
+        ( *i )->items->Query( aRect, visitor );
+    }
+
+    return aResult.size();
+}
+
+
 VECTOR2D VIEW::ToWorld( const VECTOR2D& aCoord, bool aAbsolute ) const
 {
     const MATRIX3x3D& matrix = m_gal->GetScreenWorldMatrix();
@@ -762,6 +961,11 @@ struct VIEW::updateItemsColor
         if( group >= 0 )
             gal->ChangeGroupColor( group, color );
 
+        int proxyGroup = aItem->viewPrivData()->getProxyGroup( layer );
+
+        if( proxyGroup >= 0 )
+            gal->ChangeGroupColor( proxyGroup, color );
+
         return true;
     }
 
@@ -815,6 +1019,11 @@ void VIEW::UpdateAllLayersColor()
 
                 if( group >= 0 )
                     m_gal->ChangeGroupColor( group, color );
+
+                int proxyGroup = viewData->getProxyGroup( layers[i] );
+
+                if( proxyGroup >= 0 )
+                    m_gal->ChangeGroupColor( proxyGroup, color );
             }
         }
     }
@@ -837,6 +1046,11 @@ struct VIEW::changeItemsDepth
         if( group >= 0 )
             gal->ChangeGroupDepth( group, depth );
 
+        int proxyGroup = aItem->viewPrivData()->getProxyGroup( layer );
+
+        if( proxyGroup >= 0 )
+            gal->ChangeGroupDepth( proxyGroup, depth );
+
         return true;
     }
 
@@ -942,9 +1156,13 @@ void VIEW::UpdateAllLayersOrder()
             for( int i = 0; i < layers_count; ++i )
             {
                 int group = viewData->getGroup( layers[i] );
+                int proxyGroup = viewData->getProxyGroup( layers[i] );
 
                 if( group >= 0 )
                     m_gal->ChangeGroupDepth( group, m_layers[layers[i]].renderingOrder );
+
+                if( proxyGroup >= 0 )
+                    m_gal->ChangeGroupDepth( proxyGroup, m_layers[layers[i]].renderingOrder );
             }
         }
     }
@@ -966,12 +1184,16 @@ struct VIEW::drawItem
     {
         wxCHECK( aItem->viewPrivData(), false );
 
+        view->m_redrawStats.m_queriedItems++;
+
         // Conditions that have to be fulfilled for an item to be drawn
         bool drawCondition = aItem->viewPrivData()->isRenderable() &&
                              aItem->ViewGetLOD( layer, view ) < view->m_scale;
         if( !drawCondition )
             return true;
 
+        view->m_redrawStats.m_drawnItems++;
+
         if( useDrawPriority )
             drawItems.push_back( aItem );
         else
@@ -1012,6 +1234,7 @@ void VIEW::redrawRect( const BOX2I& aRect )
         {
             drawItem drawFunc( this, l->id, m_useDrawPriority, m_reverseDrawOrder );
 
+            m_redrawStats.m_layers++;
             m_gal->SetTarget( l->target );
             m_gal->SetLayerDepth( l->renderingOrder );
             l->items->Query( aRect, drawFunc );
@@ -1032,6 +1255,20 @@ void VIEW::draw( VIEW_ITEM* aItem, int aLayer, bool aImmediate )
 
     if( IsCached( aLayer ) && !aImmediate )
     {
+        if( isProxyDrawn( aItem, aLayer ) )
+        {
+            int proxyGroup = viewData->getProxyGroup( aLayer );
+
+            if( proxyGroup >= 0 )
+            {
+                m_gal->DrawGroup( proxyGroup );
+                return;
+            }
+
+            // Proxies are created on demand, until then the full geometry is drawn
+            Update( aItem, PROXY );
+        }
+
         // Draw using cached information or create one
         int group = viewData->getGroup( aLayer );
 
@@ -1043,6 +1280,9 @@ void VIEW::draw( VIEW_ITEM* aItem, int aLayer, bool aImmediate )
     else
     {
         // Immediate mode
+        if( isProxyDrawn( aItem, aLayer ) && m_painter->DrawProxy( aItem, aLayer ) )
+            return;
+
         if( !m_painter->Draw( aItem, aLayer ) )
             aItem->ViewDraw( aLayer, this );  // Alternative drawing method
     }
@@ -1094,6 +1334,12 @@ struct VIEW::recacheItem
             gal->DeleteGroup( group );
 
         viewData->setGroup( layer, -1 );
+
+        int proxyGroup = viewData->releaseProxyGroup( layer );
+
+        if( proxyGroup >= 0 )
+            gal->DeleteGroup( proxyGroup );
+
         view->Update( aItem );
 
         return true;
@@ -1112,7 +1358,13 @@ void VIEW::Clear()
     m_allItems->clear();
 
     for( LAYER_MAP_ITER i = m_layers.begin(); i != m_layers.end(); ++i )
+    {
         i->second.items->RemoveAll();
+        i->second.bulkItems.clear();
+        i->second.bulkRemoved.clear();
+    }
+
+    m_bulkRemoved.clear();
 
     m_nextDrawPriority = 0;
 
@@ -1129,7 +1381,15 @@ void VIEW::ClearTargets()
         m_gal->ClearTarget( TARGET_NONCACHED );
         m_gal->ClearTarget( TARGET_CACHED );
 
-        MarkDirty();
+        if( m_isClipped )
+        {
+            for( int i = 0; i < TARGETS_NUMBER; ++i )
+                markTargetDirtyArea( i, m_clipArea );
+        }
+        else
+        {
+            MarkDirty();
+        }
     }
 
     if( IsTargetDirty( TARGET_OVERLAY ) )
@@ -1141,6 +1401,8 @@ void VIEW::ClearTargets()
 
 void VIEW::Redraw()
 {
+    PROF_SCOPE profScope( "view redraw" );
+
 #ifdef __WXDEBUG__
     PROF_COUNTER totalRealTime;
 #endif /* __WXDEBUG__ */
@@ -1152,13 +1414,26 @@ void VIEW::Redraw()
     rect.Normalize();
     BOX2I recti( rect.GetPosition(), rect.GetSize() );
 
+    m_redrawStats = REDRAW_STATS();
+
     // The view rtree uses integer positions.  Large screens can overflow
     // this size so in this case, simply set the rectangle to the full rtree
     if( rect.GetWidth() > std::numeric_limits<int>::max() ||
             rect.GetHeight() > std::numeric_limits<int>::max() )
         recti.SetMaximum();
 
-    redrawRect( recti );
+    if( m_isClipped )
+    {
+        recti = m_clipArea;
+        m_isClipped = false;
+        redrawRect( recti );
+        m_gal->ResetClipRect();
+    }
+    else
+    {
+        redrawRect( recti );
+    }
+
     // All targets were redrawn, so nothing is dirty
     markTargetClean( TARGET_CACHED );
     markTargetClean( TARGET_NONCACHED );
@@ -1171,6 +1446,75 @@ void VIEW::Redraw()
 }
 
 
+bool VIEW::ClipToDirtyArea()
+{
+    BOX2D screen( ToWorld( VECTOR2D( 0, 0 ) ),
+                  ToWorld( m_gal->GetScreenPixelSize() ) - ToWorld( VECTOR2D( 0, 0 ) ) );
+    BOX2D area;
+    bool  dirty = false;
+
+    screen.Normalize();
+
+    for( int i = 0; i < TARGETS_NUMBER; ++i )
+    {
+        if( !m_dirtyTargets[i] )
+            continue;
+
+        const BOX2I& targetArea = m_dirtyAreas[i];
+        BOX2D        targetAreaD( targetArea.GetPosition(), targetArea.GetSize() );
+
+        if( dirty )
+            area.Merge( targetAreaD );
+        else
+            area = targetAreaD;
+
+        dirty = true;
+    }
+
+    if( !dirty )
+        return false;
+
+    // Antialiasing and line caps may reach a little outside of the bounding boxes
+    double margin = ToWorld( 4.0 );
+    area.Inflate( margin, margin );
+
+    if( !area.Intersects( screen ) )
+        area = BOX2D( screen.GetPosition(), VECTOR2D( 0, 0 ) );
+    else
+        area = area.Intersect( screen );
+
+    // Redrawing most of the screen gains nothing over redrawing it entirely
+    if( area.GetWidth() * area.GetHeight() > 0.5 * screen.GetWidth() * screen.GetHeight() )
+        return false;
+
+    if( !m_gal->SetClipRect( area ) )
+        return false;
+
+    m_clipArea = BOX2I( VECTOR2I( KiROUND( area.GetX() ) - 1, KiROUND( area.GetY() ) - 1 ),
+                        VECTOR2I( KiROUND( area.GetWidth() ) + 2,
+                                  KiROUND( area.GetHeight() ) + 2 ) );
+    m_isClipped = true;
+
+    return true;
+}
+
+
+void VIEW::markTargetDirtyArea( int aTarget, const BOX2I& aArea )
+{
+    wxCHECK( aTarget < TARGETS_NUMBER, /* void */ );
+
+    if( !m_dirtyTargets[aTarget] )
+    {
+        m_dirtyTargets[aTarget] = true;
+        m_dirtyAreas[aTarget] = aArea;
+    }
+    else
+    {
+        m_dirtyAreas[aTarget].Merge( aArea );
+    }
+}
+
+
 const VECTOR2I& VIEW::GetScreenPixelSize() const
 {
     return m_gal->GetScreenPixelSize();
@@ -1212,6 +1556,9 @@ void VIEW::clearGroupCache()
 
 void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags )
 {
+    // The area covered by the item before the update has to be redrawn as well
+    BOX2I dirtyArea = aItem->viewPrivData()->m_bbox;
+
     if( aUpdateFlags & INITIAL_ADD )
     {
         // Don't update layers or bbox, since it was done in VIEW::Add()
@@ -1234,6 +1581,8 @@ void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags )
     int layers[VIEW_MAX_LAYERS], layers_count;
     aItem->ViewGetLayers( layers, layers_count );
 
+    dirtyArea.Merge( aItem->viewPrivData()->m_bbox );
+
     // Iterate through layers used by the item and recache it immediately
     for( int i = 0; i < layers_count; ++i )
     {
@@ -1242,13 +1591,22 @@ void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags )
         if( IsCached( layerId ) )
         {
             if( aUpdateFlags & ( GEOMETRY | LAYERS | REPAINT ) )
-                updateItemGeometry( aItem, layerId );
+            {
+                // Painting items that cannot be seen is postponed until their layer is shown
+                if( m_layers[layerId].visible )
+                    updateItemGeometry( aItem, layerId );
+                else
+                    deferItemGeometry( aItem, layerId );
+            }
             else if( aUpdateFlags & COLOR )
                 updateItemColor( aItem, layerId );
+
+            if( ( aUpdateFlags & PROXY ) && m_layers[layerId].visible )
+                updateProxyGeometry( aItem, layerId );
         }
 
         // Mark those layers as dirty, so the VIEW will be refreshed
-        MarkTargetDirty( m_layers[layerId].target );
+        markTargetDirtyArea( m_layers[layerId].target, dirtyArea );
     }
 
     aItem->viewPrivData()->clearUpdateFlags();
@@ -1303,12 +1661,17 @@ void VIEW::updateItemGeometry( VIEW_ITEM* aItem, int aLayer )
     m_gal->SetTarget( l.target );
     m_gal->SetLayerDepth( l.renderingOrder );
 
-    // Redraw the item from scratch
+    // Redraw the item from scratch, the proxy is created again when it is needed
     int group = viewData->getGroup( aLayer );
 
     if( group >= 0 )
         m_gal->DeleteGroup( group );
 
+    int proxyGroup = viewData->releaseProxyGroup( aLayer );
+
+    if( proxyGroup >= 0 )
+        m_gal->DeleteGroup( proxyGroup );
+
     group = m_gal->BeginGroup();
     viewData->setGroup( aLayer, group );
 
@@ -1319,10 +1682,101 @@ void VIEW::updateItemGeometry( VIEW_ITEM* aItem, int aLayer )
 }
 
 
+void VIEW::deferItemGeometry( VIEW_ITEM* aItem, int aLayer )
+{
+    auto viewData = aItem->viewPrivData();
+    wxCHECK( (unsigned) aLayer < m_layers.size(), /*void*/ );
+
+    if( !viewData )
+        return;
+
+    int group = viewData->getGroup( aLayer );
+
+    if( group >= 0 )
+        m_gal->DeleteGroup( group );
+
+    viewData->setGroup( aLayer, -1 );
+    m_layers.at( aLayer ).hasDeferredItems = true;
+
+    int proxyGroup = viewData->releaseProxyGroup( aLayer );
+
+    if( proxyGroup >= 0 )
+        m_gal->DeleteGroup( proxyGroup );
+}
+
+
+void VIEW::updateProxyGeometry( VIEW_ITEM* aItem, int aLayer )
+{
+    auto viewData = aItem->viewPrivData();
+    wxCHECK( (unsigned) aLayer < m_layers.size(), /*void*/ );
+
+    if( !viewData || viewData->getProxyGroup( aLayer ) >= 0 )
+        return;
+
+    if( aItem->ViewGetProxyLOD( aLayer, this ) == 0 )
+        return;
+
+    VIEW_LAYER& l = m_layers.at( aLayer );
+
+    m_gal->SetTarget( l.target );
+    m_gal->SetLayerDepth( l.renderingOrder );
+
+    int group = m_gal->BeginGroup();
+    bool drawn = m_painter->DrawProxy( static_cast<EDA_ITEM*>( aItem ), aLayer );
+    m_gal->EndGroup();
+
+    if( !drawn )
+    {
+        // The painter does not simplify the item, keep drawing its full geometry
+        m_gal->DeleteGroup( group );
+        return;
+    }
+
+    viewData->setGroup( aLayer + VIEW_MAX_LAYERS, group );
+}
+
+
+bool VIEW::isProxyDrawn( const VIEW_ITEM* aItem, int aLayer )
+{
+    // Printouts always use the full geometry
+    if( m_printMode > 0 )
+        return false;
+
+    return aItem->ViewGetProxyLOD( aLayer, this ) >= m_scale;
+}
+
+
+void VIEW::updateDeferredItems( int aLayer )
+{
+    VIEW_LAYER& l = m_layers.at( aLayer );
+    BOX2I r;
+
+    r.SetMaximum();
+
+    auto visitor = [&]( VIEW_ITEM* aItem ) -> bool
+    {
+        auto viewData = aItem->viewPrivData();
+
+        if( viewData && viewData->getGroup( aLayer ) < 0 )
+            Update( aItem, REPAINT );
+
+        return true;
+    };
+
+    l.items->Query( r, visitor );
+    l.hasDeferredItems = false;
+}
+
+
 void VIEW::updateBbox( VIEW_ITEM* aItem )
 {
+    auto viewData = aItem->viewPrivData();
     int layers[VIEW_MAX_LAYERS], layers_count;
 
+    BOX2I dirtyArea = viewData->m_bbox;
+    viewData->m_bbox = aItem->ViewBBox();
+    dirtyArea.Merge( viewData->m_bbox );
+
     aItem->ViewGetLayers( layers, layers_count );
 
     for( int i = 0; i < layers_count; ++i )
@@ -1330,7 +1784,7 @@ void VIEW::updateBbox( VIEW_ITEM* aItem )
         VIEW_LAYER& l = m_layers[layers[i]];
         l.items->Remove( aItem );
         l.items->Insert( aItem );
-        MarkTargetDirty( l.target );
+        markTargetDirtyArea( l.target, dirtyArea );
     }
 }
 
@@ -1343,6 +1797,10 @@ void VIEW::updateLayers( VIEW_ITEM* aItem )
     if( !viewData )
         return;
 
+    BOX2I dirtyArea = viewData->m_bbox;
+    viewData->m_bbox = aItem->ViewBBox();
+    dirtyArea.Merge( viewData->m_bbox );
+
     // Remove the item from previous layer set
     viewData->getLayers( layers, layers_count );
 
@@ -1350,7 +1808,7 @@ void VIEW::updateLayers( VIEW_ITEM* aItem )
     {
         VIEW_LAYER& l = m_layers[layers[i]];
         l.items->Remove( aItem );
-        MarkTargetDirty( l.target );
+        markTargetDirtyArea( l.target, dirtyArea );
 
         if( IsCached( l.id ) )
         {
@@ -1362,6 +1820,11 @@ void VIEW::updateLayers( VIEW_ITEM* aItem )
                 m_gal->DeleteGroup( prevGroup );
                 viewData->setGroup( l.id, -1 );
             }
+
+            int proxyGroup = viewData->releaseProxyGroup( l.id );
+
+            if( proxyGroup >= 0 )
+                m_gal->DeleteGroup( proxyGroup );
         }
     }
 
@@ -1373,7 +1836,7 @@ void VIEW::updateLayers( VIEW_ITEM* aItem )
     {
         VIEW_LAYER& l = m_layers[layers[i]];
         l.items->Insert( aItem );
-        MarkTargetDirty( l.target );
+        markTargetDirtyArea( l.target, dirtyArea );
     }
 }
 
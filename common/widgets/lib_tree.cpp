@@ -112,6 +112,9 @@ LIB_TREE::LIB_TREE( wxWindow* aParent, LIB_TABLE* aLibTable, LIB_TREE_MODEL_ADAP
 
     Bind( COMPONENT_PRESELECTED, &LIB_TREE::onPreselect, this );
 
+    m_search_timer.SetOwner( this );
+    Bind( wxEVT_TIMER, &LIB_TREE::onSearchTimer, this, m_search_timer.GetId() );
+
     // If wxTextCtrl::SetHint() is called before binding wxEVT_TEXT, the event
     // handler will intermittently fire.
     if( m_query_ctrl )
@@ -138,6 +141,15 @@ LIB_TREE::LIB_TREE( wxWindow* aParent, LIB_TABLE* aLibTable, LIB_TREE_MODEL_ADAP
 }
 
 
+LIB_TREE::~LIB_TREE()
+{
+    m_search_timer.Stop();
+
+    // The adapter can outlive the tree: do not leave a search running for nothing
+    m_adapter->CancelSearch();
+}
+
+
 LIB_ID LIB_TREE::GetSelectedLibId( int* aUnit ) const
 {
     auto sel = m_tree_ctrl->GetSelection();
@@ -183,6 +195,9 @@ void LIB_TREE::Regenerate( bool aKeepState )
 {
     STATE current;
 
+    // The search running in the background is replaced by this one
+    m_search_timer.Stop();
+
     // Store the state
     if( aKeepState )
         m_unfilteredState = getState();
@@ -297,7 +312,12 @@ void LIB_TREE::setState( const STATE& aState )
 
 void LIB_TREE::onQueryText( wxCommandEvent& aEvent )
 {
-    Regenerate( false );
+    // Searching large libraries takes a while: search in the background, so that the
+    // next keystroke is not delayed, and just cancels the search in progress
+    m_adapter->StartSearch( m_query_ctrl->GetValue() );
+
+    if( !m_search_timer.IsRunning() )
+        m_search_timer.Start( 20 );
 
     // Required to avoid interaction with SetHint()
     // See documentation for wxTextEntry::SetHint
@@ -305,8 +325,22 @@ void LIB_TREE::onQueryText( wxCommandEvent& aEvent )
 }
 
 
+void LIB_TREE::onSearchTimer( wxTimerEvent& aEvent )
+{
+    if( m_adapter->PollSearch() )
+    {
+        m_search_timer.Stop();
+        postPreselectEvent();
+    }
+}
+
+
 void LIB_TREE::onQueryEnter( wxCommandEvent& aEvent )
 {
+    // Select from the results of the whole query
+    if( m_search_timer.IsRunning() )
+        Regenerate( false );
+
     if( GetSelectedLibId().IsValid() )
         postSelectEvent();
 }
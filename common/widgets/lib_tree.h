@@ -26,6 +26,7 @@
 #define LIB_TREE_H
 
 #include <wx/panel.h>
+#include <wx/timer.h>
 #include <lib_tree_model_adapter.h>
 
 class wxDataViewCtrl;
@@ -58,6 +59,8 @@ public:
     LIB_TREE( wxWindow* aParent, LIB_TABLE* aLibTable, LIB_TREE_MODEL_ADAPTER::PTR& aAdapter,
               WIDGETS aWidgets = ALL, wxHtmlWindow *aDetails = nullptr );
 
+    ~LIB_TREE();
+
     /**
      * For multi-unit components, if the user selects the component itself
      * rather than picking an individual unit, 0 will be returned in aUnit.
@@ -145,6 +148,7 @@ protected:
     void setState( const STATE& aState );
 
     void onQueryText( wxCommandEvent& aEvent );
+    void onSearchTimer( wxTimerEvent& aEvent );
     void onQueryEnter( wxCommandEvent& aEvent );
     void onQueryCharHook( wxKeyEvent& aEvent );
 
@@ -163,6 +167,9 @@ protected:
     wxDataViewCtrl* m_tree_ctrl;
     wxHtmlWindow*   m_details_ctrl;
 
+    ///> Polls the search running in the background while typing the query
+    wxTimer         m_search_timer;
+
     ///> State of the widget before any filters applied
     STATE m_unfilteredState;
 };
@@ -39,6 +39,7 @@
 #include <wx/image.h>
 #include <wx/tipwin.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>   // used only for debug
 #include <ctime>    // used for representation of x axes involving date
@@ -696,38 +697,7 @@ void mpFXY::Plot( wxDC& dc, mpWindow& w )
         }
         else
         {
-            wxCoord x0, y0;
-            bool first = true;
-
-            while( GetNextXY( x, y ) )
-            {
-                double px = m_scaleX->TransformToPlot( x );
-                double py = m_scaleY->TransformToPlot( y );
-
-                wxCoord x1 = w.x2p( px );
-                wxCoord y1 = w.y2p( py );
-
-                if( first )
-                {
-                    first = false;
-                    x0 = x1;
-                    y0 = y1;
-                    continue;
-                }
-
-                if( x0 == x1 )      // continue until a new X coordinate is reached
-                    continue;
-
-                bool outDown = ( y0 > maxYpx ) && ( y1 > maxYpx );
-                bool outUp = ( y0 < minYpx ) && ( y1 < minYpx );
-                bool outLeft = ( x1 < startPx ) && ( x0 < startPx );
-                bool outRight = ( x1 > endPx ) && ( x0 > endPx );
-                if( !( outUp || outDown || outLeft || outRight ) )
-                    dc.DrawLine( x0, y0, x1, y1 );
-
-                x0 = x1;
-                y0 = y1;
-            }
+            PlotContinuous( dc, w, startPx, endPx, minYpx, maxYpx );
         }
 
         if( !m_name.IsEmpty() && m_showName )
@@ -773,6 +743,45 @@ void mpFXY::Plot( wxDC& dc, mpWindow& w )
 }
 
 
+void mpFXY::PlotContinuous( wxDC& dc, mpWindow& w, wxCoord startPx, wxCoord endPx,
+                            wxCoord minYpx, wxCoord maxYpx )
+{
+    double  x, y;
+    wxCoord x0, y0;
+    bool    first = true;
+
+    while( GetNextXY( x, y ) )
+    {
+        double px = m_scaleX->TransformToPlot( x );
+        double py = m_scaleY->TransformToPlot( y );
+
+        wxCoord x1 = w.x2p( px );
+        wxCoord y1 = w.y2p( py );
+
+        if( first )
+        {
+            first = false;
+            x0 = x1;
+            y0 = y1;
+            continue;
+        }
+
+        if( x0 == x1 )      // continue until a new X coordinate is reached
+            continue;
+
+        bool outDown = ( y0 > maxYpx ) && ( y1 > maxYpx );
+        bool outUp = ( y0 < minYpx ) && ( y1 < minYpx );
+        bool outLeft = ( x1 < startPx ) && ( x0 < startPx );
+        bool outRight = ( x1 > endPx ) && ( x0 > endPx );
+        if( !( outUp || outDown || outLeft || outRight ) )
+            dc.DrawLine( x0, y0, x1, y1 );
+
+        x0 = x1;
+        y0 = y1;
+    }
+}
+
+
 // -----------------------------------------------------------------------------
 // mpProfile implementation
 // -----------------------------------------------------------------------------
@@ -3267,6 +3276,8 @@ mpFXYVector::mpFXYVector( const wxString& name, int flags ) : mpFXY( name, flags
     m_minY  = -1;
     m_maxY  = 1;
     m_type  = mpLAYER_PLOT;
+    m_minMaxSize = 0;
+    m_sortedX = true;
 }
 
 
@@ -3347,6 +3358,9 @@ void mpFXYVector::Clear()
 {
     m_xs.clear();
     m_ys.clear();
+    m_minMaxLevels.clear();
+    m_minMaxSize = 0;
+    m_sortedX = true;
 }
 
 
@@ -3363,6 +3377,10 @@ void mpFXYVector::SetData( const std::vector<double>& xs, const std::vector<doub
     m_xs    = xs;
     m_ys    = ys;
 
+    m_minMaxLevels.clear();
+    m_minMaxSize = 0;
+    m_sortedX = true;
+
     // printf("FXYVector::setData %d %d\n", xs.size(), ys.size());
 
     // Update internal variables for the bounding box.
@@ -3406,6 +3424,230 @@ void mpFXYVector::SetData( const std::vector<double>& xs, const std::vector<doub
 }
 
 
+// Number of buckets (or samples) of a level of mpFXYVector::m_minMaxLevels in a bucket
+// of the next one
+static const size_t MINMAX_RATIO = 4;
+
+// Fewest samples per pixel column to read the min/max buckets rather than the samples
+static const size_t MINMAX_MIN_SAMPLES = 8;
+
+
+void mpFXYVector::UpdateMinMaxLevels()
+{
+    const size_t count = std::min( m_xs.size(), m_ys.size() );
+
+    // The samples are only appended to while a simulation runs, otherwise they are replaced
+    if( count < m_minMaxSize )
+    {
+        m_minMaxLevels.clear();
+        m_minMaxSize = 0;
+        m_sortedX = true;
+    }
+
+    for( size_t i = std::max<size_t>( m_minMaxSize, 1 ); i < count && m_sortedX; ++i )
+    {
+        if( m_xs[i] < m_xs[i - 1] )
+            m_sortedX = false;
+    }
+
+    size_t levels = 0;
+
+    for( size_t bucketSize = MINMAX_RATIO; bucketSize < count; bucketSize *= MINMAX_RATIO )
+    {
+        if( levels == m_minMaxLevels.size() )
+            m_minMaxLevels.emplace_back();
+
+        std::vector<std::pair<double, double> >& buckets = m_minMaxLevels[levels];
+
+        // The last bucket built may have been partial: build it again
+        size_t firstBucket = std::min( buckets.size(), m_minMaxSize / bucketSize );
+        size_t bucketCount = ( count + bucketSize - 1 ) / bucketSize;
+
+        buckets.resize( firstBucket );
+        buckets.reserve( bucketCount );
+
+        for( size_t b = firstBucket; b < bucketCount; ++b )
+        {
+            size_t first = b * MINMAX_RATIO;
+            double lo, hi;
+
+            if( levels == 0 )
+            {
+                size_t last = std::min( first + MINMAX_RATIO, count );
+
+                lo = hi = m_ys[first];
+
+                for( size_t i = first + 1; i < last; ++i )
+                {
+                    lo = std::min( lo, m_ys[i] );
+                    hi = std::max( hi, m_ys[i] );
+                }
+            }
+            else
+            {
+                const std::vector<std::pair<double, double> >& lower = m_minMaxLevels[levels - 1];
+                size_t last = std::min( first + MINMAX_RATIO, lower.size() );
+
+                lo = lower[first].first;
+                hi = lower[first].second;
+
+                for( size_t i = first + 1; i < last; ++i )
+                {
+                    lo = std::min( lo, lower[i].first );
+                    hi = std::max( hi, lower[i].second );
+                }
+            }
+
+            buckets.emplace_back( lo, hi );
+        }
+
+        levels++;
+    }
+
+    m_minMaxLevels.resize( levels );
+    m_minMaxSize = count;
+}
+
+
+void mpFXYVector::PlotContinuous( wxDC& dc, mpWindow& w, wxCoord startPx, wxCoord endPx,
+                                  wxCoord minYpx, wxCoord maxYpx )
+{
+    UpdateMinMaxLevels();
+
+    const size_t count = std::min( m_xs.size(), m_ys.size() );
+
+    if( !m_sortedX || count < 2 )
+    {
+        mpFXY::PlotContinuous( dc, w, startPx, endPx, minYpx, maxYpx );
+        return;
+    }
+
+    auto xToPx = [&]( size_t aIndex ) -> wxCoord
+    {
+        return w.x2p( m_scaleX->TransformToPlot( m_xs[aIndex] ) );
+    };
+
+    auto yToPx = [&]( double aY ) -> wxCoord
+    {
+        return w.y2p( m_scaleY->TransformToPlot( aY ) );
+    };
+
+    auto drawLine = [&]( wxCoord x0, wxCoord y0, wxCoord x1, wxCoord y1 )
+    {
+        bool outDown = ( y0 > maxYpx ) && ( y1 > maxYpx );
+        bool outUp = ( y0 < minYpx ) && ( y1 < minYpx );
+        bool outLeft = ( x1 < startPx ) && ( x0 < startPx );
+        bool outRight = ( x1 > endPx ) && ( x0 > endPx );
+
+        if( !( outUp || outDown || outLeft || outRight ) )
+            dc.DrawLine( x0, y0, x1, y1 );
+    };
+
+    // Visible samples, with the last one left of the plot and the first one right of it
+    size_t lo = 0, hi = count;
+
+    while( lo < hi )
+    {
+        size_t mid = ( lo + hi ) / 2;
+
+        if( xToPx( mid ) < startPx )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    size_t begin = lo > 0 ? lo - 1 : 0;
+
+    hi = count;
+
+    while( lo < hi )
+    {
+        size_t mid = ( lo + hi ) / 2;
+
+        if( xToPx( mid ) <= endPx )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    size_t end = std::min( lo + 1, count );
+
+    // Coarsest level with at least two buckets per pixel column
+    size_t samplesPerColumn = ( end - begin ) / std::max<wxCoord>( endPx - startPx + 1, 1 );
+    size_t bucketSize = 1;
+    const std::vector<std::pair<double, double> >* buckets = nullptr;
+
+    if( samplesPerColumn >= MINMAX_MIN_SAMPLES )
+    {
+        for( const auto& level : m_minMaxLevels )
+        {
+            if( bucketSize * MINMAX_RATIO * 2 > samplesPerColumn )
+                break;
+
+            bucketSize *= MINMAX_RATIO;
+            buckets = &level;
+        }
+    }
+
+    // Each pixel column is drawn as a vertical line between the extremes of its samples,
+    // joined to the previous column from its last sample to the first one of this column
+    bool    first = true;
+    wxCoord columnX = 0, firstY = 0, lastY = 0, minY = 0, maxY = 0;
+    wxCoord prevX = 0, prevY = 0;
+
+    auto drawColumn = [&]()
+    {
+        if( !first )
+            drawLine( prevX, prevY, columnX, firstY );
+
+        if( minY != maxY )
+            drawLine( columnX, minY, columnX, maxY );
+
+        first = false;
+        prevX = columnX;
+        prevY = lastY;
+    };
+
+    bool inColumn = false;
+
+    for( size_t b = begin / bucketSize; b * bucketSize < end; ++b )
+    {
+        size_t  firstSample = b * bucketSize;
+        size_t  lastSample = std::min( firstSample + bucketSize, count ) - 1;
+        wxCoord x = xToPx( firstSample );
+        wxCoord y0 = yToPx( m_ys[firstSample] );
+        wxCoord y1 = buckets ? yToPx( m_ys[lastSample] ) : y0;
+        wxCoord yMin = buckets ? yToPx( ( *buckets )[b].first ) : y0;
+        wxCoord yMax = buckets ? yToPx( ( *buckets )[b].second ) : y0;
+
+        // The Y axis may be upside down in pixels
+        if( yMin > yMax )
+            std::swap( yMin, yMax );
+
+        if( inColumn && x == columnX )
+        {
+            lastY = y1;
+            minY = std::min( minY, yMin );
+            maxY = std::max( maxY, yMax );
+            continue;
+        }
+
+        if( inColumn )
+            drawColumn();
+
+        inColumn = true;
+        columnX = x;
+        firstY = y0;
+        lastY = y1;
+        minY = yMin;
+        maxY = yMax;
+    }
+
+    if( inColumn )
+        drawColumn();
+}
+
+
 // -----------------------------------------------------------------------------
 // mpText - provided by Val Greene
 // -----------------------------------------------------------------------------
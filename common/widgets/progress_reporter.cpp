@@ -51,8 +51,7 @@ void PROGRESS_REPORTER::AdvancePhase( )
 
 void PROGRESS_REPORTER::Report( const wxString& aMessage )
 {
-    std::lock_guard<std::mutex> guard( m_mutex );
-    m_rptMessage = aMessage;
+    m_messages.push( aMessage );
 }
 
 
@@ -62,9 +61,9 @@ void PROGRESS_REPORTER::SetMaxProgress( int aMaxProgress )
 }
 
 
-void PROGRESS_REPORTER::AdvanceProgress()
+void PROGRESS_REPORTER::AdvanceProgress( int aCount )
 {
-    m_progress.fetch_add( 1 );
+    m_progress.fetch_add( aCount );
 }
 
 
@@ -77,6 +76,18 @@ int PROGRESS_REPORTER::currentProgress() const
 }
 
 
+const wxString& PROGRESS_REPORTER::currentMessage()
+{
+    wxString message;
+
+    // Only the last message is shown
+    while( m_messages.pop( message ) )
+        m_rptMessage = message;
+
+    return m_rptMessage;
+}
+
+
 bool PROGRESS_REPORTER::KeepRefreshing( bool aWait )
 {
     if( aWait )
@@ -125,14 +136,8 @@ bool WX_PROGRESS_REPORTER::updateUI()
     if( cur < 0 || cur > 1000 )
         cur = 0;
 
-    wxString message;
-    {
-        std::lock_guard<std::mutex> guard( m_mutex );
-        message = m_rptMessage;
-    }
-
     SetRange( 1000 );
-    return wxProgressDialog::Update( cur, message );
+    return wxProgressDialog::Update( cur, currentMessage() );
 }
 
 
@@ -151,6 +156,9 @@ bool GAUGE_PROGRESS_REPORTER::updateUI()
     if( cur < 0 || cur > 1000 )
         cur = 0;
 
+    // A gauge shows no message, but the queue is emptied all the same
+    currentMessage();
+
     wxGauge::SetValue( cur );
     wxEventLoopBase::GetActive()->YieldFor(wxEVT_CATEGORY_UI);
 
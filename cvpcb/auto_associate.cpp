@@ -44,6 +44,9 @@
 #include <cvpcb_mainframe.h>
 #include <listboxes.h>
 #include <auto_associate.h>
+#include <thread_pool.h>
+
+#include <unordered_map>
 
 #define QUOTE   '\''
 
@@ -187,19 +190,55 @@ void CVPCB_MAINFRAME::AutomaticFootprintMatching( wxCommandEvent& event )
     msg.Printf( _( "%lu footprint/cmp equivalences found." ), (unsigned long)equiv_List.size() );
     SetStatusText( msg, 0 );
 
+    // Resolve the footprints once: the components are matched in the thread pool, which
+    // cannot use FOOTPRINT_LIST::GetModuleInfo() (a linear search, which can assert).
+    std::unordered_map<wxString, const FOOTPRINT_INFO*> modules;
+
+    for( auto& fp : m_FootprintsList->GetList() )
+        modules.emplace( fp->GetLibNickname() + wxT( ":" ) + fp->GetFootprintName(), fp.get() );
+
+    auto findModule = [&]( const wxString& aFootprintName ) -> const FOOTPRINT_INFO*
+    {
+        auto it = modules.find( aFootprintName );
+        return it == modules.end() ? nullptr : it->second;
+    };
+
+    // Group the equivalences by component value (case insensitive), keeping their order
+    std::unordered_map<wxString, std::vector<unsigned>> equivByValue;
+    std::vector<const FOOTPRINT_INFO*> equivModules( equiv_List.size() );
+    std::vector<char>                  equivIsUnique( equiv_List.size() );
+
+    for( unsigned idx = 0; idx < equiv_List.size(); idx++ )
+    {
+        FOOTPRINT_EQUIVALENCE& equivItem = equiv_List[idx];
+
+        equivByValue[ equivItem.m_ComponentValue.Lower() ].push_back( idx );
+        equivModules[idx] = findModule( equivItem.m_FootprintFPID );
+
+        unsigned next = idx+1;
+        int  previous = idx-1;
+
+        equivIsUnique[idx] = !( next < equiv_List.size() &&
+                                equivItem.m_ComponentValue == equiv_List[next].m_ComponentValue )
+                          && !( previous >= 0 &&
+                                equivItem.m_ComponentValue == equiv_List[previous].m_ComponentValue );
+    }
+
     // Now, associate each free component with a footprint, when the association
-    // is found in list
-    m_skipComponentSelect = true;
-    error_msg.Empty();
+    // is found in list.  The associations are chosen in the thread pool, then set here.
+    std::vector<wxString> choices( m_netlist.GetCount() );
+    std::vector<wxString> errors( m_netlist.GetCount() );
 
-    for( unsigned kk = 0;  kk < m_netlist.GetCount();  kk++ )
+    auto matchComponent = [&]( size_t kk )
     {
         COMPONENT* component = m_netlist.GetComponent( kk );
-
+        wxString&  error = errors[kk];
         bool found = false;
 
         if( !component->GetFPID().empty() ) // the component has already a footprint
-            continue;
+            return;
+
+        auto equivs = equivByValue.find( component->GetValue().Lower() );
 
         // Here a first attempt is made. We can have multiple equivItem of the same value.
         // When happens, using the footprint filter of components can remove the ambiguity by
@@ -207,79 +246,66 @@ void CVPCB_MAINFRAME::AutomaticFootprintMatching( wxCommandEvent& event )
         // non-polar caps for example)
         wxString fpid_candidate;
 
-        for( unsigned idx = 0; idx < equiv_List.size(); idx++ )
+        if( equivs != equivByValue.end() )
         {
-            FOOTPRINT_EQUIVALENCE& equivItem = equiv_List[idx];
-
-            if( equivItem.m_ComponentValue.CmpNoCase( component->GetValue() ) != 0 )
-                continue;
-
-            const FOOTPRINT_INFO *module = m_FootprintsList->GetModuleInfo( equivItem.m_FootprintFPID );
-
-            bool equ_is_unique = true;
-            unsigned next = idx+1;
-            int  previous = idx-1;
-
-            if( next < equiv_List.size() &&
-                equivItem.m_ComponentValue == equiv_List[next].m_ComponentValue )
-                equ_is_unique = false;
-
-            if( previous >= 0 &&
-                equivItem.m_ComponentValue == equiv_List[previous].m_ComponentValue )
-                equ_is_unique = false;
-
-            // If the equivalence is unique, no ambiguity: use the association
-            if( module && equ_is_unique )
+            for( unsigned idx : equivs->second )
             {
-                SetNewPkg( equivItem.m_FootprintFPID, kk );
-                found = true;
-                break;
-            }
+                FOOTPRINT_EQUIVALENCE& equivItem = equiv_List[idx];
+                const FOOTPRINT_INFO* module = equivModules[idx];
 
-            // Store the first candidate found in list, when equivalence is not unique
-            // We use it later.
-            if( module && fpid_candidate.IsEmpty() )
-                fpid_candidate = equivItem.m_FootprintFPID;
+                // If the equivalence is unique, no ambiguity: use the association
+                if( module && equivIsUnique[idx] )
+                {
+                    choices[kk] = equivItem.m_FootprintFPID;
+                    return;
+                }
 
-            // The equivalence is not unique: use the footprint filter to try to remove
-            // ambiguity
-            // if the footprint filter does not remove ambiguity, we will use fpid_candidate
-            if( module )
-            {
-                size_t filtercount = component->GetFootprintFilters().GetCount();
-                found = ( 0 == filtercount ); // if no entries, do not filter
+                // Store the first candidate found in list, when equivalence is not unique
+                // We use it later.
+                if( module && fpid_candidate.IsEmpty() )
+                    fpid_candidate = equivItem.m_FootprintFPID;
 
-                for( size_t jj = 0; jj < filtercount && !found; jj++ )
+                // The equivalence is not unique: use the footprint filter to try to remove
+                // ambiguity
+                // if the footprint filter does not remove ambiguity, we will use fpid_candidate
+                if( module )
                 {
-                    found = module->GetFootprintName().Matches( component->GetFootprintFilters()[jj] );
+                    size_t filtercount = component->GetFootprintFilters().GetCount();
+                    found = ( 0 == filtercount ); // if no entries, do not filter
+
+                    for( size_t jj = 0; jj < filtercount && !found; jj++ )
+                    {
+                        found = module->GetFootprintName().Matches(
+                                        component->GetFootprintFilters()[jj] );
+                    }
                 }
-            }
-            else
-            {
-                msg.Printf( _( "Component %s: footprint %s not found in any of the project "
-                               "footprint libraries." ),
-                            GetChars( component->GetReference() ),
-                            GetChars( equivItem.m_FootprintFPID ) );
+                else
+                {
+                    wxString msg;
 
-                if( ! error_msg.IsEmpty() )
-                    error_msg << wxT("\n\n");
+                    msg.Printf( _( "Component %s: footprint %s not found in any of the project "
+                                   "footprint libraries." ),
+                                GetChars( component->GetReference() ),
+                                GetChars( equivItem.m_FootprintFPID ) );
 
-                error_msg += msg;
-            }
+                    if( ! error.IsEmpty() )
+                        error << wxT("\n\n");
 
-            if( found )
-            {
-                SetNewPkg( equivItem.m_FootprintFPID, kk );
-                break;
+                    error += msg;
+                }
+
+                if( found )
+                {
+                    choices[kk] = equivItem.m_FootprintFPID;
+                    return;
+                }
             }
         }
 
-        if( found )
-            continue;
-        else if( !fpid_candidate.IsEmpty() )
+        if( !fpid_candidate.IsEmpty() )
         {
-            SetNewPkg( fpid_candidate, kk );
-            continue;
+            choices[kk] = fpid_candidate;
+            return;
         }
 
         // obviously the last chance: there's only one filter matching one footprint
@@ -287,13 +313,28 @@ void CVPCB_MAINFRAME::AutomaticFootprintMatching( wxCommandEvent& event )
         {
             // we do not need to analyze wildcards: single footprint do not
             // contain them and if there are wildcards it just will not match any
-            const FOOTPRINT_INFO* module = m_FootprintsList->GetModuleInfo( component->GetFootprintFilters()[0] );
+            if( findModule( component->GetFootprintFilters()[0] ) )
+                choices[kk] = component->GetFootprintFilters()[0];
+        }
+    };
 
-            if( module )
-            {
-                SetNewPkg( component->GetFootprintFilters()[0], kk );
-            }
+    THREAD_POOL::GetPool().ParallelFor( m_netlist.GetCount(), matchComponent );
+
+    m_skipComponentSelect = true;
+    error_msg.Empty();
+
+    for( unsigned kk = 0;  kk < m_netlist.GetCount();  kk++ )
+    {
+        if( !errors[kk].IsEmpty() )
+        {
+            if( ! error_msg.IsEmpty() )
+                error_msg << wxT("\n\n");
+
+            error_msg += errors[kk];
         }
+
+        if( !choices[kk].IsEmpty() )
+            SetNewPkg( choices[kk], kk );
     }
 
     if( !error_msg.IsEmpty() )
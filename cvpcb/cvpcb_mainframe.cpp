@@ -39,6 +39,7 @@
 #include <cvpcb.h>
 #include <listboxes.h>
 #include <wx/statline.h>
+#include <wx/textfile.h>
 #include <invoke_pcb_dialog.h>
 #include <display_footprints_frame.h>
 #include <cvpcb_id.h>
@@ -238,6 +239,13 @@ CVPCB_MAINFRAME::~CVPCB_MAINFRAME()
                                     wxMouseEventHandler( CVPCB_MAINFRAME::OnFootprintRightClick ),
                                     NULL, this );
 
+    // Save the footprint info, so the next session only reads the libraries which changed
+    if( m_FootprintsList )
+    {
+        wxTextFile footprintInfoCache( Prj().GetProjectPath() + "fp-info-cache" );
+        m_FootprintsList->WriteCacheToFile( &footprintInfoCache );
+    }
+
     m_auimgr.UnInit();
 }
 
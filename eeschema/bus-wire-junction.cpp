@@ -63,9 +63,11 @@ bool SCH_EDIT_FRAME::TestDanglingEnds()
     for( SCH_ITEM* item = GetScreen()->GetDrawList().begin(); item; item = item->Next() )
         item->GetEndPoints( endPoints );
 
+    DANGLING_END_INDEX endPointIndex( endPoints );
+
     for( SCH_ITEM* item = GetScreen()->GetDrawList().begin(); item; item = item->Next() )
     {
-        if( item->UpdateDanglingState( endPoints ) )
+        if( item->UpdateDanglingState( endPointIndex ) )
         {
             GetCanvas()->GetView()->Update( item, KIGFX::REPAINT );
             hasStateChanged = true;
@@ -150,6 +152,10 @@ bool SCH_EDIT_FRAME::SchematicCleanUp( SCH_SCREEN* aScreen )
 
     BreakSegmentsOnJunctions( aScreen );
 
+    // The items are only flagged, added and removed from here, so the junction tests can use
+    // the index of the screen
+    SCH_SCREEN_INDEXED_QUERIES indexedQueries( aScreen );
+
     for( item = aScreen->GetDrawItems(); item; item = item->Next() )
     {
         if( ( item->Type() != SCH_LINE_T )
@@ -141,7 +141,7 @@ public:
         description = aDescription;
     }
 
-    const wxString& GetDescription() override { return description; }
+    wxString GetDescription() override { return description; }
 
     void SetKeyWords( const wxString& aKeyWords )
     {
@@ -32,7 +32,10 @@
 
 #include <wx/regex.h>
 #include <algorithm>
+#include <map>
+#include <set>
 #include <vector>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <fctsys.h>
@@ -238,39 +241,47 @@ int SCH_REFERENCE_LIST::GetLastReference( int aIndex, int aMinValue )
 }
 
 
-int SCH_REFERENCE_LIST::CreateFirstFreeRefId( std::vector<int>& aIdList, int aFirstValue )
+/**
+ * The reference numbers in use for a reference prefix, as a bitset.  The first number which
+ * may still be free is remembered for each minimum value, so that allocating numbers in
+ * sequence does not rescan the numbers in use.
+ */
+class REF_NUMBER_SET
 {
-    int expectedId = aFirstValue;
+public:
+    void Insert( int aNumber )
+    {
+        if( aNumber < 0 )
+            return;
 
-    // We search for expected Id a value >= aFirstValue.
-    // Skip existing Id < aFirstValue
-    unsigned ii = 0;
+        if( (size_t) aNumber >= m_used.size() )
+            m_used.resize( aNumber + 1, false );
 
-    for( ; ii < aIdList.size(); ii++ )
-    {
-        if( expectedId <= aIdList[ii] )
-            break;
+        m_used[aNumber] = true;
     }
 
-    // Ids are sorted by increasing value, from aFirstValue
-    // So we search from aFirstValue the first not used value, i.e. the first hole in list.
-    for( ; ii < aIdList.size(); ii++ )
+    /**
+     * @return the first number not in use greater than or equal to \a aMinValue, which is
+     *         added to the numbers in use.
+     */
+    int AllocateFirstFree( int aMinValue )
     {
-        if( expectedId != aIdList[ii] )    // This id is not yet used.
-        {
-            // Insert this free Id, in order to keep list sorted
-            aIdList.insert( aIdList.begin() + ii, expectedId );
-            return expectedId;
-        }
+        auto it = m_firstCandidate.find( aMinValue );
+        int  number = ( it == m_firstCandidate.end() ) ? std::max( aMinValue, 0 ) : it->second;
+
+        while( (size_t) number < m_used.size() && m_used[number] )
+            number++;
 
-        expectedId++;
+        Insert( number );
+        m_firstCandidate[aMinValue] = number + 1;
+
+        return number;
     }
 
-    // All existing Id are tested, and all values are found in use.
-    // So Create a new one.
-    aIdList.push_back( expectedId );
-    return expectedId;
-}
+private:
+    std::vector<bool>  m_used;
+    std::map<int, int> m_firstCandidate;   ///< The first number to test, by minimum value
+};
 
 
 // A helper function to build a full reference string of a SCH_REFERENCE item
@@ -294,33 +305,75 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
     if ( componentFlatList.size() == 0 )
         return;
 
-    int LastReferenceNumber = 0;
     int NumberOfUnits, Unit;
 
-    /* calculate index of the first component with the same reference prefix
-     * than the current component.  All components having the same reference
-     * prefix will receive a reference number with consecutive values:
-     * IC .. will be set to IC4, IC4, IC5 ...
-     */
-    unsigned first = 0;
+    // All the lookups below are built in a single pass over the list, so that only the new
+    // components cost some work: re-annotating a large design which has only a few new
+    // components does not rescan the whole list for each of its components.
 
-    // calculate the last used number for this reference prefix:
-#ifdef USE_OLD_ALGO
-    int minRefId = 0;
+    // The reference numbers in use, by reference prefix.  All components having the same
+    // reference prefix receive the first free numbers from the minimum value of their sheet.
+    std::unordered_map<std::string, REF_NUMBER_SET> refsInUse;
 
-    // when using sheet number, ensure ref number >= sheet number* aSheetIntervalId
-    if( aUseSheetNum )
-        minRefId = componentFlatList[first].m_SheetNum * aSheetIntervalId;
+    // The units of the annotated components, to find the missing units of a package.
+    std::unordered_map<std::string, int> annotatedUnits;
 
-    LastReferenceNumber = GetLastReference( first, minRefId );
-#else
-    int minRefId;
+    // The new components, by reference prefix, value and library symbol name, in list order.
+    std::unordered_map<std::string, std::set<unsigned>> newComponents;
 
-    // when using sheet number, ensure ref number >= sheet number* aSheetIntervalId
-    if( aUseSheetNum )
-        minRefId = componentFlatList[first].m_SheetNum * aSheetIntervalId + 1;
-    else
-        minRefId = aStartNumber + 1;
+    // The components of the list, by component object, in list order.
+    std::unordered_map<SCH_COMPONENT*, std::vector<unsigned>> instances;
+
+    // The locked multi-unit lists, by component object.
+    std::unordered_map<SCH_COMPONENT*,
+                       std::vector<std::pair<SCH_REFERENCE*, SCH_REFERENCE_LIST*>>> lockedLists;
+
+    auto unitKey = []( const SCH_REFERENCE& aItem, int aUnit ) -> std::string
+    {
+        return std::string( aItem.GetRefStr() ) + '\t' + std::to_string( aItem.m_NumRef )
+               + '\t' + std::to_string( aUnit );
+    };
+
+    auto partKey = []( const SCH_REFERENCE& aItem ) -> std::string
+    {
+        return std::string( aItem.GetRefStr() ) + '\t' + TO_UTF8( aItem.m_Value->GetText() )
+               + '\t' + aItem.m_RootCmp->GetLibId().GetLibItemName().c_str();
+    };
+
+    auto addUnit = [&]( const SCH_REFERENCE& aItem )
+    {
+        annotatedUnits[ unitKey( aItem, aItem.m_Unit ) ]++;
+    };
+
+    auto removeUnit = [&]( const SCH_REFERENCE& aItem )
+    {
+        auto it = annotatedUnits.find( unitKey( aItem, aItem.m_Unit ) );
+
+        if( it != annotatedUnits.end() && --it->second == 0 )
+            annotatedUnits.erase( it );
+    };
+
+    for( unsigned ii = 0; ii < componentFlatList.size(); ii++ )
+    {
+        SCH_REFERENCE& item = componentFlatList[ii];
+
+        refsInUse[ item.GetRefStr() ].Insert( item.m_NumRef );
+        instances[ item.GetComp() ].push_back( ii );
+
+        if( item.m_IsNew )
+            newComponents[ partKey( item ) ].insert( ii );
+        else
+            addUnit( item );
+    }
+
+    for( SCH_MULTI_UNIT_REFERENCE_MAP::value_type& pair : aLockedUnitMap )
+    {
+        for( unsigned thisRefI = 0; thisRefI < pair.second.GetCount(); ++thisRefI )
+        {
+            SCH_REFERENCE& thisRef = pair.second[thisRefI];
+            lockedLists[ thisRef.GetComp() ].emplace_back( &thisRef, &pair.second );
+        }
+    }
 
     // For multi units components, when "keep order of multi unit" option is selected,
     // store the list of already used full references.
@@ -334,11 +387,6 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
     // inUseRefs keep trace of previously allocated references
     std::unordered_set<wxString> inUseRefs;
 
-    // This is the list of all Id already in use for a given reference prefix.
-    // Will be refilled for each new reference prefix.
-    std::vector<int>idList;
-    GetRefsInUse( first, idList, minRefId );
-#endif
     for( unsigned ii = 0; ii < componentFlatList.size(); ii++ )
     {
         if( componentFlatList[ii].m_Flag )
@@ -346,64 +394,42 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
 
         // Check whether this component is in aLockedUnitMap.
         SCH_REFERENCE_LIST* lockedList = NULL;
-        for( SCH_MULTI_UNIT_REFERENCE_MAP::value_type& pair : aLockedUnitMap )
-        {
-            unsigned n_refs = pair.second.GetCount();
+        auto locked = lockedLists.find( componentFlatList[ii].GetComp() );
 
-            for( unsigned thisRefI = 0; thisRefI < n_refs; ++thisRefI )
+        if( locked != lockedLists.end() )
+        {
+            for( auto& entry : locked->second )
             {
-                SCH_REFERENCE &thisRef = pair.second[thisRefI];
-
-                if( thisRef.IsSameInstance( componentFlatList[ii] ) )
+                if( entry.first->IsSameInstance( componentFlatList[ii] ) )
                 {
-                    lockedList = &pair.second;
+                    lockedList = entry.second;
                     break;
                 }
             }
-            if( lockedList != NULL ) break;
         }
 
-        if(  ( componentFlatList[first].CompareRef( componentFlatList[ii] ) != 0 )
-          || ( aUseSheetNum && ( componentFlatList[first].m_SheetNum != componentFlatList[ii].m_SheetNum ) )  )
-        {
-            // New reference found: we need a new ref number for this reference
-            first = ii;
-#ifdef USE_OLD_ALGO
-            minRefId = 0;
+        // when using sheet number, ensure ref number >= sheet number* aSheetIntervalId
+        int minRefId;
 
-            // when using sheet number, ensure ref number >= sheet number* aSheetIntervalId
-            if( aUseSheetNum )
-                minRefId = componentFlatList[ii].m_SheetNum * aSheetIntervalId;
-
-            LastReferenceNumber = GetLastReference( ii, minRefId );
-
-#else
-            // when using sheet number, ensure ref number >= sheet number* aSheetIntervalId
-            if( aUseSheetNum )
-                minRefId = componentFlatList[ii].m_SheetNum * aSheetIntervalId + 1;
-            else
-                minRefId = aStartNumber + 1;
+        if( aUseSheetNum )
+            minRefId = componentFlatList[ii].m_SheetNum * aSheetIntervalId + 1;
+        else
+            minRefId = aStartNumber + 1;
 
-            GetRefsInUse( first, idList, minRefId );
-#endif
-        }
+        REF_NUMBER_SET& idList = refsInUse[ componentFlatList[ii].GetRefStr() ];
 
         // Annotation of one part per package components (trivial case).
         if( componentFlatList[ii].GetLibPart()->GetUnitCount() <= 1 )
         {
             if( componentFlatList[ii].m_IsNew )
-            {
-#ifdef USE_OLD_ALGO
-                LastReferenceNumber++;
-#else
-                LastReferenceNumber = CreateFirstFreeRefId( idList, minRefId );
-#endif
-                componentFlatList[ii].m_NumRef = LastReferenceNumber;
-            }
+                componentFlatList[ii].m_NumRef = idList.AllocateFirstFree( minRefId );
+            else
+                removeUnit( componentFlatList[ii] );
 
             componentFlatList[ii].m_Unit  = 1;
             componentFlatList[ii].m_Flag  = 1;
             componentFlatList[ii].m_IsNew = false;
+            addUnit( componentFlatList[ii] );
             continue;
         }
 
@@ -412,12 +438,7 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
 
         if( componentFlatList[ii].m_IsNew )
         {
-#ifdef USE_OLD_ALGO
-            LastReferenceNumber++;
-#else
-            LastReferenceNumber = CreateFirstFreeRefId( idList, minRefId );
-#endif
-            componentFlatList[ii].m_NumRef = LastReferenceNumber;
+            componentFlatList[ii].m_NumRef = idList.AllocateFirstFree( minRefId );
 
             if( !componentFlatList[ii].IsUnitsLocked() )
                 componentFlatList[ii].m_Unit = 1;
@@ -438,7 +459,14 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                 if( thisRef.IsSameInstance( componentFlatList[ii] ) )
                 {
                     // This is the component we're currently annotating. Hold the unit!
+                    if( !componentFlatList[ii].m_IsNew )
+                        removeUnit( componentFlatList[ii] );
+
                     componentFlatList[ii].m_Unit = thisRef.m_Unit;
+
+                    if( !componentFlatList[ii].m_IsNew )
+                        addUnit( componentFlatList[ii] );
+
                     // lock this new full reference
                     inUseRefs.insert( buildFullReference( componentFlatList[ii] ) );
                 }
@@ -450,8 +478,18 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                     continue;
 
                 // Find the matching component
-                for( unsigned jj = ii + 1; jj < componentFlatList.size(); jj++ )
+                auto instance = instances.find( thisRef.GetComp() );
+
+                if( instance == instances.end() )
+                    continue;
+
+                const std::vector<unsigned>& candidates = instance->second;
+
+                for( auto it = std::upper_bound( candidates.begin(), candidates.end(), ii );
+                     it != candidates.end(); ++it )
                 {
+                    unsigned jj = *it;
+
                     if( ! thisRef.IsSameInstance( componentFlatList[jj] ) )
                         continue;
 
@@ -462,10 +500,14 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                     // multiunits components have duplicate references)
                     if( inUseRefs.find( ref_candidate ) == inUseRefs.end() )
                     {
+                        if( !componentFlatList[jj].m_IsNew )
+                            removeUnit( componentFlatList[jj] );
+
                         componentFlatList[jj].m_NumRef = componentFlatList[ii].m_NumRef;
                         componentFlatList[jj].m_Unit = thisRef.m_Unit;
                         componentFlatList[jj].m_IsNew = false;
                         componentFlatList[jj].m_Flag = 1;
+                        addUnit( componentFlatList[jj] );
                         // lock this new full reference
                         inUseRefs.insert( ref_candidate );
                         break;
@@ -479,33 +521,32 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
             * we search for others parts that have the same value and the same
             * reference prefix (ref without ref number)
             */
+            auto candidates = newComponents.find( partKey( componentFlatList[ii] ) );
+
+            if( candidates == newComponents.end() )
+                continue;
+
             for( Unit = 1; Unit <= NumberOfUnits; Unit++ )
             {
                 if( componentFlatList[ii].m_Unit == Unit )
                     continue;
 
-                int found = FindUnit( ii, Unit );
-
-                if( found >= 0 )
+                if( annotatedUnits.count( unitKey( componentFlatList[ii], Unit ) ) )
                     continue; // this unit exists for this reference (unit already annotated)
 
                 // Search a component to annotate ( same prefix, same value, not annotated)
-                for( unsigned jj = ii + 1; jj < componentFlatList.size(); jj++ )
-                {
-                    if( componentFlatList[jj].m_Flag )    // already tested
-                        continue;
+                std::set<unsigned>& newList = candidates->second;
 
-                    if( componentFlatList[ii].CompareRef( componentFlatList[jj] ) != 0 )
-                        continue;
-
-                    if( componentFlatList[jj].CompareValue( componentFlatList[ii] ) != 0 )
-                        continue;
-
-                    if( componentFlatList[jj].CompareLibName( componentFlatList[ii] ) != 0 )
-                        continue;
+                for( auto it = newList.upper_bound( ii ); it != newList.end(); )
+                {
+                    unsigned jj = *it;
 
-                    if( !componentFlatList[jj].m_IsNew )
+                    // already tested
+                    if( componentFlatList[jj].m_Flag || !componentFlatList[jj].m_IsNew )
+                    {
+                        it = newList.erase( it );
                         continue;
+                    }
 
                     // Component without reference number found, annotate it if possible
                     if( !componentFlatList[jj].IsUnitsLocked()
@@ -515,8 +556,12 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                         componentFlatList[jj].m_Unit   = Unit;
                         componentFlatList[jj].m_Flag   = 1;
                         componentFlatList[jj].m_IsNew  = false;
+                        addUnit( componentFlatList[jj] );
+                        newList.erase( it );
                         break;
                     }
+
+                    ++it;
                 }
             }
         }
@@ -19,13 +19,14 @@
  */
 
 #include <list>
-#include <thread>
 #include <algorithm>
-#include <future>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <profile.h>
 
+#include <boost/functional/hash.hpp>
+
 #include <advanced_config.h>
 #include <common.h>
 #include <erc.h>
@@ -38,6 +39,7 @@
 #include <sch_sheet.h>
 #include <sch_sheet_path.h>
 #include <sch_text.h>
+#include <thread_pool.h>
 
 #include <connection_graph.h>
 
@@ -369,6 +371,7 @@ void CONNECTION_GRAPH::Reset()
     m_net_name_to_subgraphs_map.clear();
     m_local_label_cache.clear();
     m_global_label_cache.clear();
+    m_screen_signatures.clear();
     m_last_net_code = 1;
     m_last_bus_code = 1;
     m_last_subgraph_code = 1;
@@ -380,8 +383,33 @@ void CONNECTION_GRAPH::Recalculate( SCH_SHEET_LIST aSheetList, bool aUncondition
     PROF_COUNTER recalc_time;
     PROF_COUNTER update_items;
 
-    if( aUnconditional )
-        Reset();
+    // The graphical connections between the items are found again only on the screens whose
+    // connectable items changed since the last update
+    std::unordered_map<SCH_SCREEN*, size_t> signatures;
+    std::unordered_set<SCH_SCREEN*>         changed_screens;
+
+    for( const auto& sheet : aSheetList )
+    {
+        SCH_SCREEN* screen = sheet.LastScreen();
+
+        if( signatures.count( screen ) )
+            continue;
+
+        bool   dirty = false;
+        size_t signature = screenSignature( screen, dirty );
+        auto   previous = m_screen_signatures.find( screen );
+
+        if( aUnconditional || dirty || previous == m_screen_signatures.end()
+                || previous->second != signature )
+        {
+            changed_screens.insert( screen );
+        }
+
+        signatures[ screen ] = signature;
+    }
+
+    Reset();
+    m_screen_signatures = std::move( signatures );
 
     for( const auto& sheet : aSheetList )
     {
@@ -390,16 +418,16 @@ void CONNECTION_GRAPH::Recalculate( SCH_SHEET_LIST aSheetList, bool aUncondition
         for( auto item = sheet.LastScreen()->GetDrawItems();
              item; item = item->Next() )
         {
-            if( item->IsConnectable() &&
-                ( aUnconditional || item->IsConnectivityDirty() ) )
-            {
+            if( item->IsConnectable() )
                 items.push_back( item );
-            }
         }
 
-        updateItemConnectivity( sheet, items );
+        updateItemConnectivity( sheet, items, !changed_screens.count( sheet.LastScreen() ) );
     }
 
+    wxLogTrace( "CONN_PROFILE", "%lu of %lu screens changed", changed_screens.size(),
+                m_screen_signatures.size() );
+
     update_items.Stop();
     wxLogTrace( "CONN_PROFILE", "UpdateItemConnectivity() %0.4f ms", update_items.msecs() );
 
@@ -435,16 +463,71 @@ void CONNECTION_GRAPH::Recalculate( SCH_SHEET_LIST aSheetList, bool aUncondition
 }
 
 
+size_t CONNECTION_GRAPH::screenSignature( SCH_SCREEN* aScreen, bool& aDirty )
+{
+    size_t signature = 0;
+
+    auto hash_point = [&signature]( const wxPoint& aPoint )
+    {
+        boost::hash_combine( signature, aPoint.x );
+        boost::hash_combine( signature, aPoint.y );
+    };
+
+    for( SCH_ITEM* item = aScreen->GetDrawItems(); item; item = item->Next() )
+    {
+        if( !item->IsConnectable() )
+            continue;
+
+        if( item->IsConnectivityDirty() )
+            aDirty = true;
+
+        std::vector<wxPoint> points;
+        item->GetConnectionPoints( points );
+
+        boost::hash_combine( signature, item );
+        boost::hash_combine( signature, static_cast<int>( item->GetLayer() ) );
+
+        for( const wxPoint& point : points )
+            hash_point( point );
+
+        // The graphical connections are made to the pins of the components and sheets
+        if( item->Type() == SCH_COMPONENT_T )
+        {
+            for( SCH_PIN& pin : static_cast<SCH_COMPONENT*>( item )->GetPins() )
+            {
+                boost::hash_combine( signature, &pin );
+                boost::hash_combine( signature, pin.GetLibPin() );
+            }
+        }
+        else if( item->Type() == SCH_SHEET_T )
+        {
+            for( SCH_SHEET_PIN& pin : static_cast<SCH_SHEET*>( item )->GetPins() )
+            {
+                boost::hash_combine( signature, &pin );
+                hash_point( pin.GetTextPos() );
+            }
+        }
+    }
+
+    return signature;
+}
+
+
 void CONNECTION_GRAPH::updateItemConnectivity( SCH_SHEET_PATH aSheet,
-                                               std::vector<SCH_ITEM*> aItemList )
+                                               std::vector<SCH_ITEM*> aItemList,
+                                               bool aKeepConnectedItems )
 {
     std::unordered_map< wxPoint, std::vector<SCH_ITEM*> > connection_map;
 
     for( auto item : aItemList )
     {
         std::vector< wxPoint > points;
-        item->GetConnectionPoints( points );
-        item->ConnectedItems().clear();
+
+        if( !aKeepConnectedItems )
+        {
+            item->GetConnectionPoints( points );
+            item->ConnectedItems().clear();
+        }
 
         if( item->Type() == SCH_SHEET_T )
         {
@@ -455,10 +538,14 @@ void CONNECTION_GRAPH::updateItemConnectivity( SCH_SHEET_PATH aSheet,
                     pin.InitializeConnection( aSheet );
                 }
 
-                pin.ConnectedItems().clear();
                 pin.Connection( aSheet )->Reset();
 
-                connection_map[ pin.GetTextPos() ].push_back( &pin );
+                if( !aKeepConnectedItems )
+                {
+                    pin.ConnectedItems().clear();
+                    connection_map[ pin.GetTextPos() ].push_back( &pin );
+                }
+
                 m_items.insert( &pin );
             }
         }
@@ -478,14 +565,18 @@ void CONNECTION_GRAPH::updateItemConnectivity( SCH_SHEET_PATH aSheet,
 
                 // because calling the first time is not thread-safe
                 pin.GetDefaultNetName( aSheet );
-                pin.ConnectedItems().clear();
 
                 // Invisible power pins need to be post-processed later
 
                 if( pin.IsPowerConnection() && !pin.IsVisible() )
                     m_invisible_power_pins.emplace_back( std::make_pair( aSheet, &pin ) );
 
-                connection_map[ pos ].push_back( &pin );
+                if( !aKeepConnectedItems )
+                {
+                    pin.ConnectedItems().clear();
+                    connection_map[ pos ].push_back( &pin );
+                }
+
                 m_items.insert( &pin );
             }
         }
@@ -733,12 +824,6 @@ void CONNECTION_GRAPH::buildConnectionGraph()
 
     // Resolve drivers for subgraphs and propagate connectivity info
 
-    // We don't want to spin up a new thread for fewer than 8 nets (overhead costs)
-    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
-            ( m_subgraphs.size() + 3 ) / 4 );
-
-    std::atomic<size_t> nextSubgraph( 0 );
-    std::vector<std::future<size_t>> returns( parallelThreadCount );
     std::vector<CONNECTION_SUBGRAPH*> dirty_graphs;
 
     std::copy_if( m_subgraphs.begin(), m_subgraphs.end(), std::back_inserter( dirty_graphs ),
@@ -746,106 +831,93 @@ void CONNECTION_GRAPH::buildConnectionGraph()
                       return candidate->m_dirty;
                   } );
 
-    auto update_lambda = [&nextSubgraph, &dirty_graphs]() -> size_t
+    auto update_lambda = [&dirty_graphs]( size_t subgraphId )
     {
-        for( size_t subgraphId = nextSubgraph++; subgraphId < dirty_graphs.size(); subgraphId = nextSubgraph++ )
-        {
-            auto subgraph = dirty_graphs[subgraphId];
+        auto subgraph = dirty_graphs[subgraphId];
 
-            if( !subgraph->m_dirty )
-                continue;
+        if( !subgraph->m_dirty )
+            return;
 
-            // Special processing for some items
-            for( auto item : subgraph->m_items )
+        // Special processing for some items
+        for( auto item : subgraph->m_items )
+        {
+            switch( item->Type() )
             {
-                switch( item->Type() )
-                {
-                case SCH_NO_CONNECT_T:
-                    subgraph->m_no_connect = item;
-                    break;
+            case SCH_NO_CONNECT_T:
+                subgraph->m_no_connect = item;
+                break;
 
-                case SCH_BUS_WIRE_ENTRY_T:
-                    subgraph->m_bus_entry = item;
-                    break;
+            case SCH_BUS_WIRE_ENTRY_T:
+                subgraph->m_bus_entry = item;
+                break;
 
-                case SCH_PIN_T:
-                {
-                    auto pin = static_cast<SCH_PIN*>( item );
+            case SCH_PIN_T:
+            {
+                auto pin = static_cast<SCH_PIN*>( item );
 
-                    if( pin->GetType() == PIN_NC )
-                        subgraph->m_no_connect = item;
+                if( pin->GetType() == PIN_NC )
+                    subgraph->m_no_connect = item;
 
-                    break;
-                }
+                break;
+            }
 
-                default:
-                    break;
-                }
+            default:
+                break;
             }
+        }
 
-            if( !subgraph->ResolveDrivers() )
+        if( !subgraph->ResolveDrivers() )
+        {
+            subgraph->m_dirty = false;
+        }
+        else
+        {
+            // Now the subgraph has only one driver
+            SCH_ITEM* driver = subgraph->m_driver;
+            SCH_SHEET_PATH sheet = subgraph->m_sheet;
+            SCH_CONNECTION* connection = driver->Connection( sheet );
+
+            // TODO(JE) This should live in SCH_CONNECTION probably
+            switch( driver->Type() )
             {
-                subgraph->m_dirty = false;
+            case SCH_LABEL_T:
+            case SCH_GLOBAL_LABEL_T:
+            case SCH_HIER_LABEL_T:
+            {
+                auto text = static_cast<SCH_TEXT*>( driver );
+                connection->ConfigureFromLabel( text->GetShownText() );
+                break;
             }
-            else
+            case SCH_SHEET_PIN_T:
             {
-                // Now the subgraph has only one driver
-                SCH_ITEM* driver = subgraph->m_driver;
-                SCH_SHEET_PATH sheet = subgraph->m_sheet;
-                SCH_CONNECTION* connection = driver->Connection( sheet );
-
-                // TODO(JE) This should live in SCH_CONNECTION probably
-                switch( driver->Type() )
-                {
-                case SCH_LABEL_T:
-                case SCH_GLOBAL_LABEL_T:
-                case SCH_HIER_LABEL_T:
-                {
-                    auto text = static_cast<SCH_TEXT*>( driver );
-                    connection->ConfigureFromLabel( text->GetShownText() );
-                    break;
-                }
-                case SCH_SHEET_PIN_T:
-                {
-                    auto pin = static_cast<SCH_SHEET_PIN*>( driver );
-                    connection->ConfigureFromLabel( pin->GetShownText() );
-                    break;
-                }
-                case SCH_PIN_T:
-                {
-                    auto pin = static_cast<SCH_PIN*>( driver );
-                    // NOTE(JE) GetDefaultNetName is not thread-safe.
-                    connection->ConfigureFromLabel( pin->GetDefaultNetName( sheet ) );
+                auto pin = static_cast<SCH_SHEET_PIN*>( driver );
+                connection->ConfigureFromLabel( pin->GetShownText() );
+                break;
+            }
+            case SCH_PIN_T:
+            {
+                auto pin = static_cast<SCH_PIN*>( driver );
+                // NOTE(JE) GetDefaultNetName is not thread-safe.
+                connection->ConfigureFromLabel( pin->GetDefaultNetName( sheet ) );
 
-                    break;
-                }
-                default:
-                    wxLogTrace( "CONN", "Driver type unsupported: %s",
-                                driver->GetSelectMenuText( MILLIMETRES ) );
-                    break;
-                }
+                break;
+            }
+            default:
+                wxLogTrace( "CONN", "Driver type unsupported: %s",
+                            driver->GetSelectMenuText( MILLIMETRES ) );
+                break;
+            }
 
-                connection->SetDriver( driver );
-                connection->ClearDirty();
+            connection->SetDriver( driver );
+            connection->ClearDirty();
 
-                subgraph->m_dirty = false;
-            }
+            subgraph->m_dirty = false;
         }
-
-        return 1;
     };
 
-    if( parallelThreadCount == 1 )
-        update_lambda();
-    else
-    {
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-            returns[ii] = std::async( std::launch::async, update_lambda );
-
-        // Finalize the threads
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-            returns[ii].wait();
-    }
+    // We don't want to spin up a new thread for fewer than 8 nets (overhead costs)
+    THREAD_POOL::GetPool().ParallelFor( dirty_graphs.size(), update_lambda, 1,
+                                        ( m_subgraphs.size() + 3 ) / 4 );
 
     // Now discard any non-driven subgraphs from further consideration
 
@@ -1784,10 +1856,26 @@ int CONNECTION_GRAPH::RunERC( const ERC_SETTINGS& aSettings, bool aCreateMarkers
 {
     int error_count = 0;
 
-    for( auto&& subgraph : m_subgraphs )
+    enum ERC_TEST
     {
-        // Graph is supposed to be up-to-date before calling RunERC()
-        wxASSERT( !subgraph->m_dirty );
+        ERC_DRIVERS             = 1 << 0,
+        ERC_BUS_TO_NET          = 1 << 1,
+        ERC_BUS_ENTRY           = 1 << 2,
+        ERC_BUS_TO_BUS          = 1 << 3,
+        ERC_NO_CONNECTS         = 1 << 4,
+        ERC_LABELS              = 1 << 5
+    };
+
+    // The tests of each subgraph are independent, so they run on several threads, without
+    // creating the markers.  The failed tests are then run again in sequence to create the
+    // markers, so that the markers are the same and in the same order as when running the
+    // tests in sequence.
+    std::vector<int> failed_tests( m_subgraphs.size(), 0 );
+
+    auto run_tests = [&]( size_t aIndex )
+    {
+        CONNECTION_SUBGRAPH* subgraph = m_subgraphs[aIndex];
+        int&                 failed = failed_tests[aIndex];
 
         /**
          * NOTE:
@@ -1800,29 +1888,75 @@ int CONNECTION_GRAPH::RunERC( const ERC_SETTINGS& aSettings, bool aCreateMarkers
          * format due to their TestDanglingEnds() implementation.
          */
 
-        if( aSettings.check_bus_driver_conflicts &&
-            !subgraph->ResolveDrivers( aCreateMarkers ) )
-            error_count++;
+        if( aSettings.check_bus_driver_conflicts )
+        {
+            // Only the subgraphs with several drivers can have conflicting drivers
+            bool resolved = subgraph->ResolveDrivers( false );
+
+            if( aCreateMarkers ? subgraph->m_multiple_drivers : !resolved )
+                failed |= ERC_DRIVERS;
+        }
 
         if( aSettings.check_bus_to_net_conflicts &&
-            !ercCheckBusToNetConflicts( subgraph, aCreateMarkers ) )
-            error_count++;
+            !ercCheckBusToNetConflicts( subgraph, false ) )
+            failed |= ERC_BUS_TO_NET;
 
         if( aSettings.check_bus_entry_conflicts &&
-            !ercCheckBusToBusEntryConflicts( subgraph, aCreateMarkers ) )
-            error_count++;
+            !ercCheckBusToBusEntryConflicts( subgraph, false ) )
+            failed |= ERC_BUS_ENTRY;
 
         if( aSettings.check_bus_to_bus_conflicts &&
-            !ercCheckBusToBusConflicts( subgraph, aCreateMarkers ) )
-            error_count++;
+            !ercCheckBusToBusConflicts( subgraph, false ) )
+            failed |= ERC_BUS_TO_BUS;
 
         // The following checks are always performed since they don't currently
         // have an option exposed to the user
 
-        if( !ercCheckNoConnects( subgraph, aCreateMarkers ) )
+        if( !ercCheckNoConnects( subgraph, false ) )
+            failed |= ERC_NO_CONNECTS;
+
+        if( !ercCheckLabels( subgraph, false, aSettings.check_unique_global_labels ) )
+            failed |= ERC_LABELS;
+    };
+
+    THREAD_POOL::GetPool().ParallelFor( m_subgraphs.size(), run_tests );
+
+    for( size_t ii = 0; ii < m_subgraphs.size(); ii++ )
+    {
+        CONNECTION_SUBGRAPH* subgraph = m_subgraphs[ii];
+        int                  failed = failed_tests[ii];
+
+        // Graph is supposed to be up-to-date before calling RunERC()
+        wxASSERT( !subgraph->m_dirty );
+
+        if( !failed )
+            continue;
+
+        if( !aCreateMarkers )
+        {
+            for( int test = failed; test; test &= test - 1 )
+                error_count++;
+
+            continue;
+        }
+
+        if( ( failed & ERC_DRIVERS ) && !subgraph->ResolveDrivers( true ) )
+            error_count++;
+
+        if( ( failed & ERC_BUS_TO_NET ) && !ercCheckBusToNetConflicts( subgraph, true ) )
+            error_count++;
+
+        if( ( failed & ERC_BUS_ENTRY ) && !ercCheckBusToBusEntryConflicts( subgraph, true ) )
+            error_count++;
+
+        if( ( failed & ERC_BUS_TO_BUS ) && !ercCheckBusToBusConflicts( subgraph, true ) )
+            error_count++;
+
+        if( ( failed & ERC_NO_CONNECTS ) && !ercCheckNoConnects( subgraph, true ) )
             error_count++;
 
-        if( !ercCheckLabels( subgraph, aCreateMarkers, aSettings.check_unique_global_labels ) )
+        if( ( failed & ERC_LABELS )
+                && !ercCheckLabels( subgraph, true, aSettings.check_unique_global_labels ) )
             error_count++;
     }
 
@@ -39,6 +39,7 @@
 class SCH_EDIT_FRAME;
 class SCH_HIERLABEL;
 class SCH_PIN;
+class SCH_SCREEN;
 class SCH_SHEET_PIN;
 
 
@@ -206,7 +207,11 @@ public:
     /**
      * Updates the connection graph for the given list of sheets.
      *
-     * @param aSheetList is the list of possibly modified sheets
+     * The graph is built again from the items of all the sheets, but unless \a aUnconditional,
+     * the graphical connections of the screens whose connectable items did not change since
+     * the last update are kept.
+     *
+     * @param aSheetList is the list of all the sheets of the schematic
      * @param aUnconditional is true if an unconditional full recalculation should be done
      */
     void Recalculate( SCH_SHEET_LIST aSheetList, bool aUnconditional = false );
@@ -275,6 +280,9 @@ private:
     std::unordered_map<wxString,
                        std::vector<CONNECTION_SUBGRAPH*>> m_net_name_to_subgraphs_map;
 
+    /// The connectable items of each screen at the last update, see screenSignature()
+    std::unordered_map<SCH_SCREEN*, size_t> m_screen_signatures;
+
     int m_last_net_code;
 
     int m_last_bus_code;
@@ -312,9 +320,22 @@ private:
      *
      * @param aSheet is the path to the sheet of all items in the list
      * @param aItemList is a list of items to consider
+     * @param aKeepConnectedItems is true to only reset the connections of the items, keeping
+     *                            their graphical connections from the previous update
      */
     void updateItemConnectivity( SCH_SHEET_PATH aSheet,
-                                 std::vector<SCH_ITEM*> aItemList );
+                                 std::vector<SCH_ITEM*> aItemList,
+                                 bool aKeepConnectedItems = false );
+
+    /**
+     * Hashes the connectable items of a screen, with the pins of its components and sheets,
+     * to find the screens whose items were added, removed or replaced since the last update.
+     *
+     * @param aScreen is the screen to hash
+     * @param aDirty is set to true if an item of the screen has a dirty connectivity
+     * @return the signature of the connectable items of the screen
+     */
+    static size_t screenSignature( SCH_SCREEN* aScreen, bool& aDirty );
 
     /**
      * Generates the connection graph (after all item connectivity has been updated)
@@ -329,6 +329,25 @@ void SCH_EDIT_FRAME::SendMessageToPCBNEW( EDA_ITEM* aObjectToSync, SCH_COMPONENT
 }
 
 
+void SCH_EDIT_FRAME::SendCrossProbeParts( const wxArrayString& aReferences )
+{
+    if( aReferences.IsEmpty() )
+        return;
+
+    if( Kiface().IsSingle() )
+    {
+        std::string packet = StrPrintf( "$PART: \"%s\"", TO_UTF8( aReferences[0] ) );
+        SendCommand( MSG_TO_PCB, packet.c_str() );
+    }
+    else
+    {
+        // The separators in the references are escaped by wxJoin()
+        std::string packet = StrPrintf( "$PARTS: \"%s\"", TO_UTF8( wxJoin( aReferences, ',' ) ) );
+        Kiway().ExpressMail( FRAME_PCB, MAIL_CROSS_PROBE, packet, this );
+    }
+}
+
+
 void SCH_EDIT_FRAME::SendCrossProbeNetName( const wxString& aNetName )
 {
     // The command is a keyword followed by a quoted string.
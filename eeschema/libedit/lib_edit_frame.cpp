@@ -594,7 +594,9 @@ void LIB_EDIT_FRAME::SyncLibraries( bool aShowProgress )
                 m_treePane->GetLibTree()->Unselect();
         }
 
-        m_treePane->Regenerate();
+        // The rows of the changed symbols are patched when the tree view allows it
+        if( m_libMgr->GetAdapter()->NotifySyncChanges() )
+            m_treePane->Regenerate();
 
         // Try to select the parent library, in case the part is not found
         if( !found && selected.IsValid() )
@@ -326,39 +326,31 @@ void NETLIST_EXPORTER::findAllUnitsOfComponent( SCH_COMPONENT* aComponent,
         LIB_PART* aEntry, SCH_SHEET_PATH* aSheetPath )
 {
     wxString    ref = aComponent->GetRef( aSheetPath );
-    wxString    ref2;
 
-    SCH_SHEET_LIST sheetList( g_RootSheet );
+    const SCH_INSTANCE_TABLE&                  instanceTable = SCH_INSTANCE_TABLE::Get();
+    std::vector<const SCH_COMPONENT_INSTANCE*> units;
 
-    for( unsigned i = 0;  i < sheetList.size();  i++ )
+    instanceTable.FindReference( ref, units );
+
+    for( const SCH_COMPONENT_INSTANCE* instance : units )
     {
-        for( EDA_ITEM* item = sheetList[i].LastDrawList();  item;  item = item->Next() )
-        {
-            if( item->Type() != SCH_COMPONENT_T )
-                continue;
+        SCH_COMPONENT*  comp2 = instance->m_Component;
+        SCH_SHEET_PATH  sheet = instanceTable.GetSheets()[ instance->m_SheetIndex ];
 
-            SCH_COMPONENT*  comp2 = (SCH_COMPONENT*) item;
+        int unit2 = comp2->GetUnitSelection( &sheet );  // slow
 
-            ref2 = comp2->GetRef( &sheetList[i] );
+        for( LIB_PIN* pin = aEntry->GetNextPin();  pin;  pin = aEntry->GetNextPin( pin ) )
+        {
+            wxASSERT( pin->Type() == LIB_PIN_T );
 
-            if( ref2.CmpNoCase( ref ) != 0 )
+            if( pin->GetUnit() && pin->GetUnit() != unit2 )
                 continue;
 
-            int unit2 = comp2->GetUnitSelection( &sheetList[i] );  // slow
-
-            for( LIB_PIN* pin = aEntry->GetNextPin();  pin;  pin = aEntry->GetNextPin( pin ) )
-            {
-                wxASSERT( pin->Type() == LIB_PIN_T );
-
-                if( pin->GetUnit() && pin->GetUnit() != unit2 )
-                    continue;
-
-                if( pin->GetConvert() && pin->GetConvert() != comp2->GetConvert() )
-                    continue;
+            if( pin->GetConvert() && pin->GetConvert() != comp2->GetConvert() )
+                continue;
 
-                // A suitable pin is found: add it to the current list
-                addPinToComponentPinList( comp2, &sheetList[i], pin );
-            }
+            // A suitable pin is found: add it to the current list
+            addPinToComponentPinList( comp2, &sheet, pin );
         }
     }
 }
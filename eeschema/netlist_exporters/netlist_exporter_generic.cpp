@@ -106,52 +106,44 @@ void NETLIST_EXPORTER_GENERIC::addComponentFields( XNODE* xcomp, SCH_COMPONENT*
 
         wxString    ref = comp->GetRef( aSheet );
 
-        SCH_SHEET_LIST sheetList( g_RootSheet );
+        const SCH_INSTANCE_TABLE&                  instanceTable = SCH_INSTANCE_TABLE::Get();
+        std::vector<const SCH_COMPONENT_INSTANCE*> units;
         int minUnit = comp->GetUnit();
 
-        for( unsigned i = 0;  i < sheetList.size();  i++ )
-        {
-            for( EDA_ITEM* item = sheetList[i].LastDrawList();  item;  item = item->Next() )
-            {
-                if( item->Type() != SCH_COMPONENT_T )
-                    continue;
-
-                SCH_COMPONENT*  comp2 = (SCH_COMPONENT*) item;
+        instanceTable.FindReference( ref, units );
 
-                wxString ref2 = comp2->GetRef( &sheetList[i] );
+        for( const SCH_COMPONENT_INSTANCE* instance : units )
+        {
+            SCH_COMPONENT*  comp2 = instance->m_Component;
 
-                if( ref2.CmpNoCase( ref ) != 0 )
-                    continue;
+            int unit = comp2->GetUnit();
 
-                int unit = comp2->GetUnit();
+            // The lowest unit number wins.  User should only set fields in any one unit.
+            // remark: IsVoid() returns true for empty strings or the "~" string (empty field value)
+            if( !comp2->GetField( VALUE )->IsVoid()
+                    && ( unit < minUnit || fields.value.IsEmpty() ) )
+                fields.value = comp2->GetField( VALUE )->GetText();
 
-                // The lowest unit number wins.  User should only set fields in any one unit.
-                // remark: IsVoid() returns true for empty strings or the "~" string (empty field value)
-                if( !comp2->GetField( VALUE )->IsVoid()
-                        && ( unit < minUnit || fields.value.IsEmpty() ) )
-                    fields.value = comp2->GetField( VALUE )->GetText();
+            if( !comp2->GetField( FOOTPRINT )->IsVoid()
+                    && ( unit < minUnit || fields.footprint.IsEmpty() ) )
+                fields.footprint = comp2->GetField( FOOTPRINT )->GetText();
 
-                if( !comp2->GetField( FOOTPRINT )->IsVoid()
-                        && ( unit < minUnit || fields.footprint.IsEmpty() ) )
-                    fields.footprint = comp2->GetField( FOOTPRINT )->GetText();
+            if( !comp2->GetField( DATASHEET )->IsVoid()
+                    && ( unit < minUnit || fields.datasheet.IsEmpty() ) )
+                fields.datasheet = comp2->GetField( DATASHEET )->GetText();
 
-                if( !comp2->GetField( DATASHEET )->IsVoid()
-                        && ( unit < minUnit || fields.datasheet.IsEmpty() ) )
-                    fields.datasheet = comp2->GetField( DATASHEET )->GetText();
+            for( int fldNdx = MANDATORY_FIELDS;  fldNdx < comp2->GetFieldCount();  ++fldNdx )
+            {
+                SCH_FIELD* f = comp2->GetField( fldNdx );
 
-                for( int fldNdx = MANDATORY_FIELDS;  fldNdx < comp2->GetFieldCount();  ++fldNdx )
+                if( f->GetText().size()
+                    && ( unit < minUnit || fields.f.count( f->GetName() ) == 0 ) )
                 {
-                    SCH_FIELD* f = comp2->GetField( fldNdx );
-
-                    if( f->GetText().size()
-                        && ( unit < minUnit || fields.f.count( f->GetName() ) == 0 ) )
-                    {
-                        fields.f[ f->GetName() ] = f->GetText();
-                    }
+                    fields.f[ f->GetName() ] = f->GetText();
                 }
-
-                minUnit = std::min( unit, minUnit );
             }
+
+            minUnit = std::min( unit, minUnit );
         }
 
     }
@@ -240,16 +240,14 @@ NETLIST_OBJECT_LIST* SCH_EDIT_FRAME::BuildNetListBase( bool updateStatusText )
     // Ensure netlist is up to date
     RecalculateConnections();
 
-    // I own this list until I return it to the new owner.
-    std::unique_ptr<NETLIST_OBJECT_LIST> ret( new NETLIST_OBJECT_LIST() );
-
     // Creates the flattened sheet list:
     SCH_SHEET_LIST aSheets( g_RootSheet );
 
-    // Build netlist info
-    bool success = ret->BuildNetListInfo( aSheets );
+    // Build netlist info, or copy it when the schematic did not change since the last build.
+    // I own this list until I return it to the new owner.
+    std::unique_ptr<NETLIST_OBJECT_LIST> ret( m_netlistCache->Build( aSheets ) );
 
-    if( !success )
+    if( ret->empty() )
     {
         if( updateStatusText )
             SetStatusText( _( "No Objects" ) );
@@ -440,6 +440,27 @@ wxString NETLIST_OBJECT::GetShortNetName( bool adoptTimestamp ) const
  * used to build a net name (something like Cmp<REF>_Pad<PAD_NAME>
  * @param aCandidate = the connected item candidate
  */
+bool NETLIST_OBJECT::IsSameItem( const NETLIST_OBJECT& aOther ) const
+{
+    return m_Type == aOther.m_Type
+        && m_Comp == aOther.m_Comp
+        && m_Link == aOther.m_Link
+        && m_Flag == aOther.m_Flag
+        && m_ElectricalPinType == aOther.m_ElectricalPinType
+        && m_BusNetCode == aOther.m_BusNetCode
+        && m_Member == aOther.m_Member
+        && m_ConnectionType == aOther.m_ConnectionType
+        && m_Start == aOther.m_Start
+        && m_End == aOther.m_End
+        && m_netCode == aOther.m_netCode
+        && m_netNameCandidate == aOther.m_netNameCandidate
+        && m_PinNum == aOther.m_PinNum
+        && m_Label == aOther.m_Label
+        && m_SheetPath == aOther.m_SheetPath
+        && m_SheetPathInclude == aOther.m_SheetPathInclude;
+}
+
+
 void NETLIST_OBJECT::SetNetNameCandidate( NETLIST_OBJECT* aCandidate )
 {
     switch( aCandidate->m_Type )
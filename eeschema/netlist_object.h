@@ -32,6 +32,8 @@
 #define NETLIST_OBJECT_H
 
 
+#include <memory>
+
 #include <sch_sheet_path.h>
 #include <lib_pin.h>
 #include <sch_item.h>
@@ -177,6 +179,14 @@ public:
      */
     bool HasNetNameCandidate() { return m_netNameCandidate != NULL; }
 
+    NETLIST_OBJECT* GetNetNameCandidate() const { return m_netNameCandidate; }
+
+    /**
+     * @return true if this item and \a aOther were created from the same schematic item, at
+     * the same place, with the same texts and the same connection state.
+     */
+    bool IsSameItem( const NETLIST_OBJECT& aOther ) const;
+
     /**
      * Function GetPinNum
      * returns a pin number in wxString form.  Pin numbers are not always
@@ -327,6 +337,24 @@ public:
      */
     bool BuildNetListInfo( SCH_SHEET_LIST& aSheets );
 
+    /**
+     * Add the connected objects of the sheets of \a aSheets to the list, without
+     * connecting them.  This is the first step of BuildNetListInfo().
+     */
+    void CollectNetListItems( SCH_SHEET_LIST& aSheets );
+
+    /**
+     * Connect the objects of the list, added by CollectNetListItems().  This is the
+     * second step of BuildNetListInfo().
+     * @return true if OK, false is not item found
+     */
+    bool ConnectNetListItems();
+
+    /**
+     * @return a copy of the list and of its objects.  The caller owns it.
+     */
+    NETLIST_OBJECT_LIST* Clone() const;
+
     /**
      * Acces to an item in list
      */
@@ -509,6 +537,36 @@ private:
 };
 
 
+/**
+ * Class NETLIST_OBJECT_LIST_CACHE
+ * keeps the last list built by NETLIST_OBJECT_LIST::BuildNetListInfo(), with a copy of
+ * the objects it was built from.  When the objects collected from the schematic are the
+ * same, the connections are not computed again and the last list is copied.
+ */
+class NETLIST_OBJECT_LIST_CACHE
+{
+public:
+    /**
+     * Build the list of connected objects of \a aSheets, or copy it from the cache.
+     * @return the list, owned by the caller
+     */
+    NETLIST_OBJECT_LIST* Build( SCH_SHEET_LIST& aSheets );
+
+    void Clear();
+
+private:
+    /// The reference and the "in netlist" flag of the component of each pin, which
+    /// give the names of the nets without labels.
+    typedef std::vector<std::pair<wxString, bool>> PIN_REFERENCES;
+
+    static PIN_REFERENCES pinReferences( const NETLIST_OBJECT_LIST& aItems );
+
+    std::unique_ptr<NETLIST_OBJECT_LIST> m_items;       // collected objects, not connected
+    PIN_REFERENCES                       m_references;  // pin references of m_items
+    std::unique_ptr<NETLIST_OBJECT_LIST> m_netlist;     // list built from m_items
+};
+
+
 /**
  * Function IsBusLabel
  * test if \a aLabel has a bus notation.
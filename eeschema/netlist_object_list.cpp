@@ -39,6 +39,7 @@
 #include <sch_sheet.h>
 #include <sch_screen.h>
 #include <algorithm>
+#include <unordered_map>
 
 #define IS_WIRE false
 #define IS_BUS true
@@ -79,18 +80,30 @@ void NETLIST_OBJECT_LIST::SortListbySheet()
 
 bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
 {
-    SCH_SHEET_PATH* sheet;
+    CollectNetListItems( aSheets );
+
+    return ConnectNetListItems();
+}
+
 
+void NETLIST_OBJECT_LIST::CollectNetListItems( SCH_SHEET_LIST& aSheets )
+{
     // Fill list with connected items from the flattened sheet list
     for( unsigned i = 0; i < aSheets.size();  i++ )
     {
-        sheet = &aSheets[i];
+        SCH_SHEET_PATH* sheet = &aSheets[i];
 
         for( SCH_ITEM* item = sheet->LastScreen()->GetDrawItems(); item; item = item->Next() )
         {
             item->GetNetListItem( *this, sheet );
         }
     }
+}
+
+
+bool NETLIST_OBJECT_LIST::ConnectNetListItems()
+{
+    SCH_SHEET_PATH* sheet;
 
     if( size() == 0 )
         return false;
@@ -282,6 +295,91 @@ bool NETLIST_OBJECT_LIST::BuildNetListInfo( SCH_SHEET_LIST& aSheets )
     return true;
 }
 
+NETLIST_OBJECT_LIST* NETLIST_OBJECT_LIST::Clone() const
+{
+    std::unique_ptr<NETLIST_OBJECT_LIST> list( new NETLIST_OBJECT_LIST() );
+    std::unordered_map<const NETLIST_OBJECT*, NETLIST_OBJECT*> clones;
+
+    list->m_lastNetCode = m_lastNetCode;
+    list->m_lastBusNetCode = m_lastBusNetCode;
+    list->reserve( size() );
+
+    for( NETLIST_OBJECT* item : *this )
+    {
+        NETLIST_OBJECT* clone = new NETLIST_OBJECT( *item );
+
+        list->push_back( clone );
+        clones[ item ] = clone;
+    }
+
+    // The net name candidates are objects of the list
+    for( NETLIST_OBJECT* clone : *list )
+    {
+        if( clone->GetNetNameCandidate() )
+            clone->SetNetNameCandidate( clones.at( clone->GetNetNameCandidate() ) );
+    }
+
+    return list.release();
+}
+
+
+NETLIST_OBJECT_LIST* NETLIST_OBJECT_LIST_CACHE::Build( SCH_SHEET_LIST& aSheets )
+{
+    std::unique_ptr<NETLIST_OBJECT_LIST> list( new NETLIST_OBJECT_LIST() );
+
+    list->CollectNetListItems( aSheets );
+
+    PIN_REFERENCES references = pinReferences( *list );
+
+    if( m_netlist && m_items->size() == list->size() && m_references == references
+            && std::equal( list->begin(), list->end(), m_items->begin(),
+                           []( const NETLIST_OBJECT* aItem, const NETLIST_OBJECT* aCached )
+                           {
+                               return aItem->IsSameItem( *aCached );
+                           } ) )
+    {
+        return m_netlist->Clone();
+    }
+
+    m_items.reset( list->Clone() );
+    m_references = std::move( references );
+
+    list->ConnectNetListItems();
+
+    m_netlist.reset( list->Clone() );
+
+    return list.release();
+}
+
+
+void NETLIST_OBJECT_LIST_CACHE::Clear()
+{
+    m_items.reset();
+    m_references.clear();
+    m_netlist.reset();
+}
+
+
+NETLIST_OBJECT_LIST_CACHE::PIN_REFERENCES NETLIST_OBJECT_LIST_CACHE::pinReferences(
+        const NETLIST_OBJECT_LIST& aItems )
+{
+    PIN_REFERENCES references;
+
+    for( NETLIST_OBJECT* item : aItems )
+    {
+        SCH_COMPONENT* component = item->GetComponentParent();
+
+        if( item->m_Type == NET_PIN && component )
+        {
+            references.emplace_back( component->GetRef( &item->m_SheetPath ),
+                                     component->IsInNetlist() );
+        }
+    }
+
+    return references;
+}
+
+
 // Helper function to give a priority to sort labels:
 // NET_PINLABEL, NET_GLOBBUSLABELMEMBER and NET_GLOBLABEL are global labels
 // and the priority is high
@@ -340,6 +340,11 @@ void SCH_BASE_FRAME::CenterScreen( const wxPoint& aCenterPoint, bool aWarpPointe
 
 void SCH_BASE_FRAME::HardRedraw()
 {
+    auto painter = static_cast<KIGFX::SCH_PAINTER*>( GetCanvas()->GetView()->GetPainter() );
+
+    // The library symbols may have been reloaded
+    painter->ClearSymbolCache();
+
     GetCanvas()->GetView()->UpdateAllItems( KIGFX::ALL );
     GetCanvas()->ForceRefresh();
 }
@@ -437,6 +442,10 @@ void SCH_BASE_FRAME::SyncView()
 {
     auto gs = GetScreen()->GetGridSize();
     GetCanvas()->GetGAL()->SetGridSize( VECTOR2D( gs.x, gs.y ));
+
+    auto painter = static_cast<KIGFX::SCH_PAINTER*>( GetCanvas()->GetView()->GetPainter() );
+    painter->ClearSymbolCache();
+
     GetCanvas()->GetView()->UpdateAllItems( KIGFX::ALL );
 }
 
@@ -187,55 +187,30 @@ void SCH_BUS_ENTRY_BASE::Rotate( wxPoint aPosition )
 }
 
 
-bool SCH_BUS_WIRE_ENTRY::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList )
+bool SCH_BUS_WIRE_ENTRY::UpdateDanglingState( const DANGLING_END_INDEX& aIndex )
 {
     bool previousStateStart = m_isDanglingStart;
     bool previousStateEnd = m_isDanglingEnd;
 
     m_isDanglingStart = m_isDanglingEnd = true;
 
-    // Wires and buses are stored in the list as a pair, start and end. This
-    // variable holds the start position from one iteration so it can be used
-    // when the end position is found.
-    wxPoint seg_start;
-
     // Store the connection type and state for the start (0) and end (1)
     bool has_wire[2] = { false };
     bool has_bus[2] = { false };
+    wxPoint ends[2] = { m_pos, m_End() };
 
-    for( DANGLING_END_ITEM& each_item : aItemList )
+    for( int ii = 0; ii < 2; ii++ )
     {
-        if( each_item.GetItem() == this )
-            continue;
-
-        switch( each_item.GetType() )
-        {
-        case WIRE_START_END:
-        case BUS_START_END:
-            seg_start = each_item.GetPosition();
-            break;
-
-        case WIRE_END_END:
-            if( IsPointOnSegment( seg_start, each_item.GetPosition(), m_pos ) )
-                has_wire[0] = true;
-
-            if( IsPointOnSegment( seg_start, each_item.GetPosition(), m_End() ) )
-                has_wire[1] = true;
-
-            break;
-
-        case BUS_END_END:
-            if( IsPointOnSegment( seg_start, each_item.GetPosition(), m_pos ) )
-                has_bus[0] = true;
-
-            if( IsPointOnSegment( seg_start, each_item.GetPosition(), m_End() ) )
-                has_bus[1] = true;
-
-            break;
-
-        default:
-            break;
-        }
+        aIndex.VisitSegmentsAt( ends[ii],
+                [&]( const DANGLING_END_ITEM& aStart, const DANGLING_END_ITEM& aEnd ) -> bool
+                {
+                    if( aStart.GetType() == WIRE_START_END )
+                        has_wire[ii] = true;
+                    else
+                        has_bus[ii] = true;
+
+                    return !has_wire[ii] || !has_bus[ii];
+                } );
     }
 
     /**
@@ -253,38 +228,30 @@ bool SCH_BUS_WIRE_ENTRY::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aI
 }
 
 
-bool SCH_BUS_BUS_ENTRY::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList )
+bool SCH_BUS_BUS_ENTRY::UpdateDanglingState( const DANGLING_END_INDEX& aIndex )
 {
     bool previousStateStart = m_isDanglingStart;
     bool previousStateEnd = m_isDanglingEnd;
 
     m_isDanglingStart = m_isDanglingEnd = true;
 
-    // Wires and buses are stored in the list as a pair, start and end. This
-    // variable holds the start position from one iteration so it can be used
-    // when the end position is found.
-    wxPoint seg_start;
+    aIndex.VisitSegmentsAt( m_pos,
+            [&]( const DANGLING_END_ITEM& aStart, const DANGLING_END_ITEM& aEnd ) -> bool
+            {
+                if( aStart.GetType() == BUS_START_END )
+                    m_isDanglingStart = false;
 
-    for( DANGLING_END_ITEM& each_item : aItemList )
-    {
-        if( each_item.GetItem() == this )
-            continue;
-
-        switch( each_item.GetType() )
-        {
-        case BUS_START_END:
-            seg_start = each_item.GetPosition();
-            break;
-        case BUS_END_END:
-            if( IsPointOnSegment( seg_start, each_item.GetPosition(), m_pos ) )
-                m_isDanglingStart = false;
-            if( IsPointOnSegment( seg_start, each_item.GetPosition(), m_End() ) )
-                m_isDanglingEnd = false;
-            break;
-        default:
-            break;
-        }
-    }
+                return m_isDanglingStart;
+            } );
+
+    aIndex.VisitSegmentsAt( m_End(),
+            [&]( const DANGLING_END_ITEM& aStart, const DANGLING_END_ITEM& aEnd ) -> bool
+            {
+                if( aStart.GetType() == BUS_START_END )
+                    m_isDanglingEnd = false;
+
+                return m_isDanglingEnd;
+            } );
 
     return (previousStateStart != m_isDanglingStart) || (previousStateEnd != m_isDanglingEnd);
 }
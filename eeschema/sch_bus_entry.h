@@ -155,7 +155,7 @@ public:
 
     BITMAP_DEF GetMenuImage() const override;
 
-    bool UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList ) override;
+    bool UpdateDanglingState( const DANGLING_END_INDEX& aIndex ) override;
 
     /**
      * Pointer to the bus item (usually a bus wire) connected to this bus-wire
@@ -194,7 +194,7 @@ public:
 
     BITMAP_DEF GetMenuImage() const override;
 
-    bool UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList ) override;
+    bool UpdateDanglingState( const DANGLING_END_INDEX& aIndex ) override;
 
     /**
      * Pointer to the bus items (usually bus wires) connected to this bus-bus
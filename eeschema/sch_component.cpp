@@ -593,6 +593,7 @@ void SCH_COMPONENT::AddHierarchicalReference( const wxString& aPath, const wxStr
     h_ref = aPath + wxT( " " ) + aRef;
     h_ref << wxT( " " ) << aMulti;
     m_PathsAndReferences.Add( h_ref );
+    SCH_INSTANCE_TABLE::Invalidate();
 }
 
 
@@ -686,6 +687,8 @@ void SCH_COMPONENT::SetRef( const SCH_SHEET_PATH* sheet, const wxString& ref )
 
     if( notInArray )
         AddHierarchicalReference( path, ref, m_unit );
+    else
+        SCH_INSTANCE_TABLE::Invalidate();
 
     SCH_FIELD* rf = GetField( REFERENCE );
 
@@ -752,6 +755,8 @@ void SCH_COMPONENT::SetTimeStamp( timestamp_t aNewTimeStamp )
 
     for( wxString& entry : m_PathsAndReferences )
         entry.Replace( string_oldtimestamp.GetData(), string_timestamp.GetData() );
+
+    SCH_INSTANCE_TABLE::Invalidate();
 }
 
 
@@ -1028,6 +1033,7 @@ void SCH_COMPONENT::SwapData( SCH_ITEM* aItem )
     component->m_transform = tmp;
 
     std::swap( m_PathsAndReferences, component->m_PathsAndReferences );
+    SCH_INSTANCE_TABLE::Invalidate();
 }
 
 
@@ -1077,6 +1083,7 @@ void SCH_COMPONENT::ClearAnnotation( SCH_SHEET_PATH* aSheetPath )
     // But this call cannot made here.
     m_Fields[REFERENCE].SetText( defRef ); //for drawing.
 
+    SCH_INSTANCE_TABLE::Invalidate();
     SetModified();
 }
 
@@ -1539,7 +1546,7 @@ void SCH_COMPONENT::GetEndPoints( std::vector <DANGLING_END_ITEM>& aItemList )
 }
 
 
-bool SCH_COMPONENT::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList )
+bool SCH_COMPONENT::UpdateDanglingState( const DANGLING_END_INDEX& aIndex )
 {
     bool changed = false;
 
@@ -1550,37 +1557,33 @@ bool SCH_COMPONENT::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemLi
 
         wxPoint pos = m_transform.TransformCoordinate( pin.GetPosition() ) + m_Pos;
 
-        for( DANGLING_END_ITEM& each_item : aItemList )
-        {
-            // Some people like to stack pins on top of each other in a symbol to indicate
-            // internal connection. While technically connected, it is not particularly useful
-            // to display them that way, so skip any pins that are in the same symbol as this
-            // one.
-            if( each_item.GetParent() == this )
-                continue;
-
-            switch( each_item.GetType() )
-            {
-            case PIN_END:
-            case LABEL_END:
-            case SHEET_LABEL_END:
-            case WIRE_START_END:
-            case WIRE_END_END:
-            case NO_CONNECT_END:
-            case JUNCTION_END:
-
-                if( pos == each_item.GetPosition() )
-                    pin.SetIsDangling( false );
-
-                break;
-
-            default:
-                break;
-            }
-
-            if( !pin.IsDangling() )
-                break;
-        }
+        aIndex.VisitEndsAt( pos, [&]( const DANGLING_END_ITEM& each_item ) -> bool
+                {
+                    // Some people like to stack pins on top of each other in a symbol to
+                    // indicate internal connection. While technically connected, it is not
+                    // particularly useful to display them that way, so skip any pins that
+                    // are in the same symbol as this one.
+                    if( each_item.GetParent() == this )
+                        return true;
+
+                    switch( each_item.GetType() )
+                    {
+                    case PIN_END:
+                    case LABEL_END:
+                    case SHEET_LABEL_END:
+                    case WIRE_START_END:
+                    case WIRE_END_END:
+                    case NO_CONNECT_END:
+                    case JUNCTION_END:
+                        pin.SetIsDangling( false );
+                        break;
+
+                    default:
+                        break;
+                    }
+
+                    return pin.IsDangling();
+                } );
 
         changed = ( changed || ( previousState != pin.IsDangling() ) );
     }
@@ -1803,6 +1806,7 @@ SCH_COMPONENT& SCH_COMPONENT::operator=( const SCH_ITEM& aItem )
         m_transform = c->m_transform;
 
         m_PathsAndReferences = c->m_PathsAndReferences;
+        SCH_INSTANCE_TABLE::Invalidate();
 
         m_Fields    = c->m_Fields;    // std::vector's assignment operator
 
@@ -568,7 +568,7 @@ public:
      *
      * @return true if any pin's state has changed.
      */
-    bool UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList ) override;
+    bool UpdateDanglingState( const DANGLING_END_INDEX& aIndex ) override;
 
     wxPoint GetPinPhysicalPosition( const LIB_PIN* Pin ) const;
 
@@ -25,6 +25,7 @@
 
 #include <wx/filename.h>
 #include <wx/tokenzr.h>
+#include <exception>
 #include <memory>
 #include <algorithm>
 
@@ -56,6 +57,7 @@
 #include <symbol_lib_table.h>
 #include <sch_legacy_plugin.h>
 #include <sch_eagle_plugin.h>
+#include <thread_pool.h>
 
 
 
@@ -1297,7 +1299,21 @@ EAGLE_LIBRARY* SCH_EAGLE_PLUGIN::loadLibrary( wxXmlNode* aLibraryNode,
         symbolNode = symbolNode->GetNext();
     }
 
-    // Loop through the devicesets and load each of them
+    // The symbols of the devices only read the XML tree: the devices are listed with the
+    // nodes of their gates, their symbols are built in parallel, then saved in the file order.
+    struct DEVICE_SYMBOL
+    {
+        wxString                                       m_name;
+        wxString                                       m_prefix;
+        EDEVICE                                        m_device;
+        std::vector<std::pair<wxXmlNode*, wxString>>   m_gates;   // symbol node, gate name
+        std::unique_ptr<LIB_PART>                      m_part;
+        std::exception_ptr                             m_error;
+    };
+
+    std::vector<DEVICE_SYMBOL> devices;
+
+    // Loop through the devicesets and list their devices
     wxXmlNode* devicesetNode = getChildrenNodes( libraryChildren, "devicesets" );
 
     while( devicesetNode )
@@ -1325,26 +1341,11 @@ EAGLE_LIBRARY* SCH_EAGLE_PLUGIN::loadLibrary( wxXmlNode* aLibraryNode,
             if( edevice.package )
                 aEagleLibrary->package[symbolName] = edevice.package.Get();
 
-            // Create KiCad symbol.
-            unique_ptr<LIB_PART> kpart( new LIB_PART( symbolName ) );
+            devices.push_back( { symbolName, prefix, edevice, {}, nullptr, nullptr } );
 
             // Process each gate in the deviceset for this device.
             wxXmlNode* gateNode = getChildrenNodes( aDeviceSetChildren, "gates" );
-            int gates_count = countChildren( aDeviceSetChildren["gates"], "gate" );
-            kpart->SetUnitCount( gates_count );
-            kpart->LockUnits( true );
-
-            LIB_FIELD* reference = kpart->GetField( REFERENCE );
-
-            if( prefix.length() == 0 )
-                reference->SetVisible( false );
-            else
-                // If there is no footprint assigned, then prepend the reference value
-                // with a hash character to mute netlist updater complaints
-                reference->SetText( edevice.package ? prefix : '#' + prefix );
-
             int gateindex = 1;
-            bool ispower = false;
 
             while( gateNode )
             {
@@ -1352,30 +1353,78 @@ EAGLE_LIBRARY* SCH_EAGLE_PLUGIN::loadLibrary( wxXmlNode* aLibraryNode,
 
                 aEagleLibrary->GateUnit[edeviceset.name + edevice.name + egate.name] = gateindex;
 
-                ispower = loadSymbol( aEagleLibrary->SymbolNodes[egate.symbol],
-                        kpart, &edevice, gateindex, egate.name );
+                devices.back().m_gates.emplace_back( aEagleLibrary->SymbolNodes[egate.symbol],
+                                                     egate.name );
 
                 gateindex++;
                 gateNode = gateNode->GetNext();
             }    // gateNode
 
-            kpart->SetUnitCount( gates_count );
-
-            if( gates_count == 1 && ispower )
-                kpart->SetPower();
-
-            wxString name = fixSymbolName( kpart->GetName() );
-            kpart->SetName( name );
-            m_pi->SaveSymbol( getLibFileName().GetFullPath(), new LIB_PART( *kpart.get() ),
-                              m_properties.get() );
-            aEagleLibrary->KiCadSymbols.insert( name, kpart.release() );
-
             deviceNode = deviceNode->GetNext();
         }    // devicenode
 
         devicesetNode = devicesetNode->GetNext();
     }    // devicesetNode
 
+    THREAD_POOL::GetPool().ParallelFor( devices.size(),
+            [&]( size_t aIndex )
+            {
+                DEVICE_SYMBOL& device = devices[aIndex];
+
+                try
+                {
+                    // Create KiCad symbol.
+                    unique_ptr<LIB_PART> kpart( new LIB_PART( device.m_name ) );
+                    int gates_count = device.m_gates.size();
+
+                    kpart->SetUnitCount( gates_count );
+                    kpart->LockUnits( true );
+
+                    LIB_FIELD* reference = kpart->GetField( REFERENCE );
+
+                    if( device.m_prefix.length() == 0 )
+                        reference->SetVisible( false );
+                    else
+                        // If there is no footprint assigned, then prepend the reference value
+                        // with a hash character to mute netlist updater complaints
+                        reference->SetText( device.m_device.package ? device.m_prefix
+                                                                    : '#' + device.m_prefix );
+
+                    int gateindex = 1;
+                    bool ispower = false;
+
+                    for( const auto& gate : device.m_gates )
+                    {
+                        ispower = loadSymbol( gate.first, kpart, &device.m_device, gateindex,
+                                              gate.second );
+                        gateindex++;
+                    }
+
+                    kpart->SetUnitCount( gates_count );
+
+                    if( gates_count == 1 && ispower )
+                        kpart->SetPower();
+
+                    device.m_part = std::move( kpart );
+                }
+                catch( ... )
+                {
+                    device.m_error = std::current_exception();
+                }
+            } );
+
+    for( DEVICE_SYMBOL& device : devices )
+    {
+        if( device.m_error )
+            std::rethrow_exception( device.m_error );
+
+        wxString name = fixSymbolName( device.m_part->GetName() );
+        device.m_part->SetName( name );
+        m_pi->SaveSymbol( getLibFileName().GetFullPath(), new LIB_PART( *device.m_part.get() ),
+                          m_properties.get() );
+        aEagleLibrary->KiCadSymbols.insert( name, device.m_part.release() );
+    }
+
     return aEagleLibrary;
 }
 
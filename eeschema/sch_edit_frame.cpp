@@ -67,6 +67,7 @@
 #include <tools/sch_editor_control.h>
 #include <wildcards_and_files_ext.h>
 #include <connection_graph.h>
+#include <netlist_object.h>
 #include <sch_painter.h>
 
 #include <gal/graphics_abstraction_layer.h>
@@ -241,6 +242,7 @@ SCH_EDIT_FRAME::SCH_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ):
     m_printSheetReference = true;
     SetShowPageLimits( true );
     m_undoItem = NULL;
+    m_netlistCache = new NETLIST_OBJECT_LIST_CACHE();
     m_hasAutoSave = true;
     m_showIllegalSymbolLibDialog = true;
     m_FrameSize = ConvertDialogToPixels( wxSize( 500, 350 ) );    // default in case of no prefs
@@ -313,6 +315,7 @@ SCH_EDIT_FRAME::~SCH_EDIT_FRAME()
     delete g_CurrentSheet;          // a SCH_SHEET_PATH, on the heap.
     delete g_ConnectionGraph;
     delete m_undoItem;
+    delete m_netlistCache;
     delete g_RootSheet;
 
     g_CurrentSheet = nullptr;
@@ -1082,7 +1085,7 @@ void SCH_EDIT_FRAME::RecalculateConnections( bool aDoCleanup )
     timer.Stop();
     wxLogTrace( "CONN_PROFILE", "SchematicCleanUp() %0.4f ms", timer.msecs() );
 
-    g_ConnectionGraph->Recalculate( list, true );
+    g_ConnectionGraph->Recalculate( list, !ADVANCED_CFG::GetCfg().m_incrementalConnectivity );
 }
 
 
@@ -52,6 +52,7 @@ class DIALOG_SCH_FIND;
 class wxFindDialogEvent;
 class wxFindReplaceData;
 class RESCUER;
+class NETLIST_OBJECT_LIST_CACHE;
 
 
 /// enum used in RotationMiroir()
@@ -112,6 +113,7 @@ private:
     SCH_ITEM*               m_item_to_repeat;     ///< Last item to insert by the repeat command.
     int                     m_repeatLabelDelta;   ///< Repeat label number increment step.
     SCH_ITEM*               m_undoItem;           ///< Copy of the current item being edited.
+    NETLIST_OBJECT_LIST_CACHE* m_netlistCache;    ///< Last list built by BuildNetListBase().
     wxString                m_simulatorCommand;   ///< Command line used to call the circuit
                                                   ///< simulator (gnucap, spice, ...)
     wxString                m_netListerCommand;   ///< Command line to call a custom net list
@@ -396,6 +398,18 @@ public:
      */
     void SendMessageToPCBNEW( EDA_ITEM* aObjectToSync, SCH_COMPONENT* aPart );
 
+    /**
+     * Send the references of several components to Pcbnew in a single message, to select all
+     * their footprints:
+     * - $PARTS: "ref1,ref2,..."
+     *
+     * The list does not fit in the buffer of the socket connection: when Eeschema runs
+     * standalone, only the first component is sent.
+     *
+     * @param aReferences are the component references.
+     */
+    void SendCrossProbeParts( const wxArrayString& aReferences );
+
     /**
      * Sends a net name to pcbnew for highlighting
      *
@@ -36,6 +36,90 @@
 #include <sch_sheet.h>
 #include <sch_pin.h>
 #include <general.h>
+#include <trigo.h>
+#include <geometry/rtree.h>
+
+#include <algorithm>
+
+
+class DANGLING_END_INDEX::SEGMENT_TREE : public RTree<size_t, int, 2, double>
+{
+};
+
+
+DANGLING_END_INDEX::DANGLING_END_INDEX( const std::vector<DANGLING_END_ITEM>& aItemList ) :
+    m_items( aItemList ),
+    m_segments( new SEGMENT_TREE() )
+{
+    for( size_t ii = 0; ii < m_items.size(); ii++ )
+    {
+        const DANGLING_END_ITEM& item = m_items[ii];
+
+        m_ends[ item.GetPosition() ].push_back( ii );
+
+        // Wires and buses are stored in the list as a pair, start and end.
+        if( ( item.GetType() != WIRE_START_END && item.GetType() != BUS_START_END )
+                || ii + 1 >= m_items.size() )
+            continue;
+
+        const wxPoint& start = item.GetPosition();
+        const wxPoint& end = m_items[ii + 1].GetPosition();
+        int min[2] = { std::min( start.x, end.x ), std::min( start.y, end.y ) };
+        int max[2] = { std::max( start.x, end.x ), std::max( start.y, end.y ) };
+
+        m_segments->Insert( min, max, ii );
+    }
+}
+
+
+DANGLING_END_INDEX::~DANGLING_END_INDEX()
+{
+}
+
+
+void DANGLING_END_INDEX::VisitEndsAt( const wxPoint& aPosition,
+        const std::function<bool( const DANGLING_END_ITEM& )>& aVisitor ) const
+{
+    auto it = m_ends.find( aPosition );
+
+    if( it == m_ends.end() )
+        return;
+
+    for( size_t ii : it->second )
+    {
+        if( !aVisitor( m_items[ii] ) )
+            return;
+    }
+}
+
+
+void DANGLING_END_INDEX::VisitSegmentsAt( const wxPoint& aPosition,
+        const std::function<bool( const DANGLING_END_ITEM& aStart,
+                                  const DANGLING_END_ITEM& aEnd )>& aVisitor ) const
+{
+    std::vector<size_t> starts;
+    int pos[2] = { aPosition.x, aPosition.y };
+
+    m_segments->Search( pos, pos,
+            [&]( const size_t& aStart ) -> bool
+            {
+                if( IsPointOnSegment( m_items[aStart].GetPosition(),
+                                      m_items[aStart + 1].GetPosition(), aPosition ) )
+                {
+                    starts.push_back( aStart );
+                }
+
+                return true;
+            } );
+
+    std::sort( starts.begin(), starts.end() );
+
+    for( size_t ii : starts )
+    {
+        if( !aVisitor( m_items[ii], m_items[ii + 1] ) )
+            return;
+    }
+}
 
 
 /* Constructor and destructor for SCH_ITEM */
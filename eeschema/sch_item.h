@@ -25,6 +25,8 @@
 #ifndef SCH_ITEM_H
 #define SCH_ITEM_H
 
+#include <functional>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -104,6 +106,50 @@ public:
 };
 
 
+/**
+ * Class DANGLING_END_INDEX
+ * indexes a list of DANGLING_END_ITEMs by position, so that the dangling state of an item
+ * is updated from the end points and the wire and bus segments at its connection points
+ * rather than by scanning the whole list.
+ *
+ * The list must outlive the index and must not be modified while it is indexed.
+ */
+class DANGLING_END_INDEX
+{
+public:
+    DANGLING_END_INDEX( const std::vector<DANGLING_END_ITEM>& aItemList );
+
+    ~DANGLING_END_INDEX();
+
+    const std::vector<DANGLING_END_ITEM>& GetItems() const { return m_items; }
+
+    /**
+     * Visit the end points at \a aPosition in the order of the list, until \a aVisitor
+     * returns false.
+     */
+    void VisitEndsAt( const wxPoint& aPosition,
+                      const std::function<bool( const DANGLING_END_ITEM& )>& aVisitor ) const;
+
+    /**
+     * Visit the wire and bus segments passing through \a aPosition in the order of the list,
+     * until \a aVisitor returns false.
+     *
+     * Each segment is given as the pair of its WIRE_START_END or BUS_START_END item and of
+     * the end item which follows it in the list.
+     */
+    void VisitSegmentsAt( const wxPoint& aPosition,
+                          const std::function<bool( const DANGLING_END_ITEM& aStart,
+                                                    const DANGLING_END_ITEM& aEnd )>& aVisitor ) const;
+
+private:
+    class SEGMENT_TREE;
+
+    const std::vector<DANGLING_END_ITEM>&             m_items;
+    std::unordered_map<wxPoint, std::vector<size_t>>  m_ends;      ///< list indices by position
+    std::unique_ptr<SEGMENT_TREE>                     m_segments;  ///< segment start indices
+};
+
+
 /**
  * Class SCH_ITEM
  * is a base class for any item which can be embedded within the SCHEMATIC
@@ -282,10 +328,10 @@ public:
      * always returns false.  Only override the method if the item can be tested for a
      * dangling state.
      *
-     * @param aItemList - List of items to test item against.
+     * @param aIndex - The indexed list of items to test item against.
      * @return True if the dangling state has changed from it's current setting.
      */
-    virtual bool UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList ) { return false; }
+    virtual bool UpdateDanglingState( const DANGLING_END_INDEX& aIndex ) { return false; }
 
     virtual bool IsDangling() const { return false; }
 
@@ -22,6 +22,7 @@
 
 #include <ctype.h>
 #include <algorithm>
+#include <unordered_map>
 #include <boost/algorithm/string/join.hpp>
 
 #include <wx/mstream.h>
@@ -461,6 +462,40 @@ static void parseQuotedString( wxString& aString, LINE_READER& aReader,
 }
 
 
+/**
+ * A #FILE_LINE_READER which knows the file offset of its current line, so that a symbol
+ * library file can be read again from a given line.
+ */
+class SYMBOL_FILE_READER : public FILE_LINE_READER
+{
+public:
+    SYMBOL_FILE_READER( const wxString& aFileName ) :
+        FILE_LINE_READER( aFileName ),
+        m_lineOffset( 0 )
+    {
+    }
+
+    char* ReadLine() override
+    {
+        m_lineOffset = ftell( m_fp );
+        return FILE_LINE_READER::ReadLine();
+    }
+
+    /// Return the file offset of the current line.
+    long LineOffset() const { return m_lineOffset; }
+
+    /// Make the next ReadLine() read line number \a aLineNumber from file offset \a aOffset.
+    void Seek( long aOffset, unsigned aLineNumber )
+    {
+        fseek( m_fp, aOffset, SEEK_SET );
+        m_lineNum = aLineNumber - 1;
+    }
+
+private:
+    long m_lineOffset;
+};
+
+
 /**
  * A cache assistant for the part library portion of the #SCH_PLUGIN API, and only for the
  * #SCH_LEGACY_PLUGIN, so therefore is private to this implementation file, i.e. not placed
@@ -480,7 +515,20 @@ class SCH_LEGACY_PLUGIN_CACHE
     int             m_versionMinor;
     int             m_libType;      // Is this cache a component or symbol library.
 
+    /// Location in the library file of a symbol whose body, i.e. its drawing items and
+    /// footprint filters, is not loaded yet.
+    struct PART_BODY
+    {
+        long     m_offset;          // File offset of the DEF line of the symbol.
+        unsigned m_lineNumber;      // Line number of the DEF line of the symbol.
+    };
+
+    std::unordered_map<LIB_PART*, PART_BODY> m_partBodies;  // Bodies not loaded yet.
+
     void                  loadHeader( FILE_LINE_READER& aReader );
+    void                  loadPartBody( LIB_PART* aPart );
+    void                  loadPartBodies();
+    static void           skipSection( LINE_READER& aReader, const char* aEndToken );
     static void           loadAliases( std::unique_ptr<LIB_PART>& aPart, LINE_READER& aReader );
     static void           loadField( std::unique_ptr<LIB_PART>& aPart, LINE_READER& aReader );
     static void           loadDrawEntries( std::unique_ptr<LIB_PART>& aPart, LINE_READER& aReader,
@@ -552,7 +600,13 @@ public:
 
     wxString GetFileName() const { return m_libFileName.GetFullPath(); }
 
-    static LIB_PART* LoadPart( LINE_READER& aReader, int aMajorVersion, int aMinorVersion );
+    /**
+     * Read one DEF/ENDDEF symbol entry.
+     *
+     * @param aSkipBody skips the drawing items and the footprint filters of the symbol.
+     */
+    static LIB_PART* LoadPart( LINE_READER& aReader, int aMajorVersion, int aMinorVersion,
+                               bool aSkipBody = false );
     static void      SaveSymbol( LIB_PART* aSymbol, OUTPUTFORMATTER& aFormatter );
 };
 
@@ -2394,6 +2448,7 @@ LIB_ALIAS* SCH_LEGACY_PLUGIN_CACHE::removeAlias( LIB_ALIAS* aAlias )
 
     if( !alias )
     {
+        m_partBodies.erase( part );
         delete part;
 
         if( m_aliases.size() > 1 )
@@ -2455,7 +2510,7 @@ void SCH_LEGACY_PLUGIN_CACHE::Load()
     wxLogTrace( traceSchLegacyPlugin, "Loading legacy symbol file \"%s\"",
                 m_libFileName.GetFullPath() );
 
-    FILE_LINE_READER reader( m_libFileName.GetFullPath() );
+    SYMBOL_FILE_READER reader( m_libFileName.GetFullPath() );
 
     if( !reader.ReadLine() )
         THROW_IO_ERROR( _( "unexpected end of file" ) );
@@ -2509,8 +2564,13 @@ void SCH_LEGACY_PLUGIN_CACHE::Load()
 
         if( strCompare( "DEF", line ) )
         {
-            // Read one DEF/ENDDEF part entry from library:
-            LIB_PART * part = LoadPart( reader, m_versionMajor, m_versionMinor );
+            PART_BODY body = { reader.LineOffset(), reader.LineNumber() };
+
+            // Read one DEF/ENDDEF part entry from library.  Its drawing items and footprint
+            // filters are only loaded when the symbol itself is requested.
+            LIB_PART * part = LoadPart( reader, m_versionMajor, m_versionMinor, true );
+
+            m_partBodies[part] = body;
 
             // Add aliases to cache
             for( size_t ii = 0; ii < part->GetAliasCount(); ++ii )
@@ -2692,7 +2752,7 @@ void SCH_LEGACY_PLUGIN_CACHE::loadHeader( FILE_LINE_READER& aReader )
 
 
 LIB_PART* SCH_LEGACY_PLUGIN_CACHE::LoadPart( LINE_READER& aReader, int aMajorVersion,
-                                             int aMinorVersion )
+                                             int aMinorVersion, bool aSkipBody )
 {
     const char* line = aReader.Line();
 
@@ -2853,9 +2913,19 @@ LIB_PART* SCH_LEGACY_PLUGIN_CACHE::LoadPart( LINE_READER& aReader, int aMajorVer
         else if( *line == 'F' )                          // Fields
             loadField( part, aReader );
         else if( strCompare( "DRAW", line, &line ) )     // Drawing objects.
-            loadDrawEntries( part, aReader, aMajorVersion, aMinorVersion );
+        {
+            if( aSkipBody )
+                skipSection( aReader, "ENDDRAW" );
+            else
+                loadDrawEntries( part, aReader, aMajorVersion, aMinorVersion );
+        }
         else if( strCompare( "$FPLIST", line, &line ) )  // Footprint filter list
-            loadFootprintFilters( part, aReader );
+        {
+            if( aSkipBody )
+                skipSection( aReader, "$ENDFPLIST" );
+            else
+                loadFootprintFilters( part, aReader );
+        }
         else if( strCompare( "ENDDEF", line, &line ) )   // End of part description
         {
             return part.release();
@@ -2868,6 +2938,87 @@ LIB_PART* SCH_LEGACY_PLUGIN_CACHE::LoadPart( LINE_READER& aReader, int aMajorVer
 }
 
 
+void SCH_LEGACY_PLUGIN_CACHE::skipSection( LINE_READER& aReader, const char* aEndToken )
+{
+    const char* line = aReader.ReadLine();
+
+    while( line )
+    {
+        if( strCompare( aEndToken, line ) )
+            return;
+
+        line = aReader.ReadLine();
+    }
+
+    SCH_PARSE_ERROR( "file ended prematurely while loading symbol", aReader, line );
+}
+
+
+void SCH_LEGACY_PLUGIN_CACHE::loadPartBody( LIB_PART* aPart )
+{
+    auto it = m_partBodies.find( aPart );
+
+    if( it == m_partBodies.end() )
+        return;
+
+    PART_BODY body = it->second;
+
+    // Forget the body first, so that a parse error does not load the same items twice.
+    m_partBodies.erase( it );
+
+    LOCALE_IO          toggle;     // toggles on, then off, the C locale.
+    SYMBOL_FILE_READER reader( m_fileName );
+
+    reader.Seek( body.m_offset, body.m_lineNumber );
+
+    const char* line = reader.ReadLine();
+
+    if( !line || !strCompare( "DEF", line ) )
+    {
+        THROW_IO_ERROR( wxString::Format( _( "Symbol \"%s\" not found at line %u of "
+                                             "library file \"%s\"." ),
+                                          aPart->GetName(), body.m_lineNumber, m_fileName ) );
+    }
+
+    // The draw entry parsers expect to own the part, which belongs to its aliases here.
+    std::unique_ptr<LIB_PART> part( aPart );
+
+    try
+    {
+        line = reader.ReadLine();
+
+        while( line )
+        {
+            if( strCompare( "DRAW", line ) )
+                loadDrawEntries( part, reader, m_versionMajor, m_versionMinor );
+            else if( strCompare( "$FPLIST", line ) )
+                loadFootprintFilters( part, reader );
+            else if( strCompare( "ENDDEF", line ) )
+                break;
+
+            line = reader.ReadLine();
+        }
+
+        if( !line )
+            SCH_PARSE_ERROR( "missing ENDDEF", reader, line );
+    }
+    catch( ... )
+    {
+        part.release();
+        throw;
+    }
+
+    part.release();
+}
+
+
+void SCH_LEGACY_PLUGIN_CACHE::loadPartBodies()
+{
+    while( !m_partBodies.empty() )
+        loadPartBody( m_partBodies.begin()->first );
+}
+
+
 #if 0
 bool SCH_LEGACY_PLUGIN_CACHE::checkForDuplicates( wxString& aAliasName )
 {
@@ -3627,6 +3778,10 @@ void SCH_LEGACY_PLUGIN_CACHE::Save( bool aSaveDocFile )
     if( !m_isModified )
         return;
 
+    // The symbol bodies which are not loaded yet are read from the library file, which is
+    // about to be overwritten.
+    loadPartBodies();
+
     // Write through symlinks, don't replace them
     wxFileName fn = GetRealFile();
 
@@ -4156,6 +4311,7 @@ void SCH_LEGACY_PLUGIN_CACHE::DeleteAlias( const wxString& aAliasName )
 
     if( !alias )
     {
+        m_partBodies.erase( part );
         delete part;
 
         if( m_aliases.size() > 1 )
@@ -4273,6 +4429,8 @@ void SCH_LEGACY_PLUGIN::EnumerateSymbolLib( std::vector<LIB_ALIAS*>& aAliasList,
 
     bool powerSymbolsOnly = ( aProperties &&
                               aProperties->find( SYMBOL_LIB_TABLE::PropPowerSymsOnly ) != aProperties->end() );
+    bool headersOnly = ( aProperties &&
+                         aProperties->find( SYMBOL_LIB_TABLE::PropHeadersOnly ) != aProperties->end() );
     cacheLib( aLibraryPath );
 
     const LIB_ALIAS_MAP& aliases = m_cache->m_aliases;
@@ -4280,7 +4438,12 @@ void SCH_LEGACY_PLUGIN::EnumerateSymbolLib( std::vector<LIB_ALIAS*>& aAliasList,
     for( LIB_ALIAS_MAP::const_iterator it = aliases.begin();  it != aliases.end();  ++it )
     {
         if( !powerSymbolsOnly || it->second->GetPart()->IsPower() )
+        {
+            if( !headersOnly )
+                m_cache->loadPartBody( it->second->GetPart() );
+
             aAliasList.push_back( it->second );
+        }
     }
 }
 
@@ -4299,6 +4462,8 @@ LIB_ALIAS* SCH_LEGACY_PLUGIN::LoadSymbol( const wxString& aLibraryPath, const wx
     if( it == m_cache->m_aliases.end() )
         return NULL;
 
+    m_cache->loadPartBody( it->second->GetPart() );
+
     return it->second;
 }
 
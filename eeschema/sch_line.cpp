@@ -521,7 +521,7 @@ void SCH_LINE::GetEndPoints( std::vector <DANGLING_END_ITEM>& aItemList )
 }
 
 
-bool SCH_LINE::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList )
+bool SCH_LINE::UpdateDanglingState( const DANGLING_END_INDEX& aIndex )
 {
     bool previousStartState = m_startIsDangling;
     bool previousEndState = m_endIsDangling;
@@ -530,25 +530,31 @@ bool SCH_LINE::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList )
 
     if( GetLayer() == LAYER_WIRE )
     {
-        for( DANGLING_END_ITEM item : aItemList )
+        auto isWireEnd = [this]( const DANGLING_END_ITEM& aItem ) -> bool
         {
-            if( item.GetItem() == this )
-                continue;
+            if( aItem.GetItem() == this )
+                return false;
 
-            if(     item.GetType() == BUS_START_END ||
-                    item.GetType() == BUS_END_END  ||
-                    item.GetType() == BUS_ENTRY_END )
-                continue;
+            return  aItem.GetType() != BUS_START_END &&
+                    aItem.GetType() != BUS_END_END &&
+                    aItem.GetType() != BUS_ENTRY_END;
+        };
 
-            if( m_start == item.GetPosition() )
-                m_startIsDangling = false;
+        aIndex.VisitEndsAt( m_start, [&]( const DANGLING_END_ITEM& aItem ) -> bool
+                {
+                    if( isWireEnd( aItem ) )
+                        m_startIsDangling = false;
 
-            if( m_end == item.GetPosition() )
-                m_endIsDangling = false;
+                    return m_startIsDangling;
+                } );
 
-            if( (m_startIsDangling == false) && (m_endIsDangling == false) )
-                break;
-        }
+        aIndex.VisitEndsAt( m_end, [&]( const DANGLING_END_ITEM& aItem ) -> bool
+                {
+                    if( isWireEnd( aItem ) )
+                        m_endIsDangling = false;
+
+                    return m_endIsDangling;
+                } );
     }
     else if( GetLayer() == LAYER_BUS || GetLayer() == LAYER_NOTES )
     {
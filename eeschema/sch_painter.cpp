@@ -138,6 +138,17 @@ SCH_PAINTER::SCH_PAINTER( GAL* aGal ) :
 { }
 
 
+SCH_PAINTER::~SCH_PAINTER()
+{
+}
+
+
+void SCH_PAINTER::ClearSymbolCache()
+{
+    m_symbolCache.clear();
+}
+
+
 #define HANDLE_ITEM( type_id, type_name ) \
     case type_id: draw( (type_name *) item, aLayer ); break
 
@@ -1169,6 +1180,43 @@ static void orientPart( LIB_PART* part, int orientation )
 }
 
 
+SCH_PAINTER::CACHED_SYMBOL& SCH_PAINTER::getCachedSymbol( LIB_PART* aPart, int aOrientation,
+                                                          int aUnit, int aConvert )
+{
+    CACHED_SYMBOL& cached = m_symbolCache[ SYMBOL_CACHE_KEY( aPart, aOrientation, aUnit,
+                                                             aConvert ) ];
+
+    // The library symbol may have been deleted (and another one allocated at its address),
+    // or edited since it was copied.
+    if( cached.m_part
+            && !cached.m_source.expired()
+            && cached.m_sourceDate == aPart->GetDateLastEdition()
+            && cached.m_sourceItemCount == aPart->GetDrawItems().size() )
+    {
+        return cached;
+    }
+
+    cached.m_source = aPart->SharedPtr();
+    cached.m_sourceDate = aPart->GetDateLastEdition();
+    cached.m_sourceItemCount = aPart->GetDrawItems().size();
+
+    // Copy the source so we can re-orient it.
+    cached.m_part.reset( new LIB_PART( *aPart ) );
+
+    orientPart( cached.m_part.get(), aOrientation );
+
+    cached.m_itemFlags.clear();
+
+    for( auto& item : cached.m_part->GetDrawItems() )
+        cached.m_itemFlags.push_back( item.GetFlags() );
+
+    cached.m_pins.clear();
+    cached.m_part->GetPins( cached.m_pins, aUnit, aConvert );
+
+    return cached;
+}
+
+
 void SCH_PAINTER::draw( SCH_COMPONENT *aComp, int aLayer )
 {
     PART_SPTR originalPartSptr = aComp->GetPartRef().lock();
@@ -1176,27 +1224,30 @@ void SCH_PAINTER::draw( SCH_COMPONENT *aComp, int aLayer )
     // Use dummy part if the actual couldn't be found (or couldn't be locked).
     LIB_PART* originalPart = originalPartSptr ? originalPartSptr.get() : dummy();
 
-    // Copy the source so we can re-orient and translate it.
-    LIB_PART tempPart( *originalPart );
+    // The oriented symbol is shared by the components using it: only their flags are set
+    // before drawing it, at the position of the component.
+    CACHED_SYMBOL& cached = getCachedSymbol( originalPart, aComp->GetOrientation(),
+                                             aComp->GetUnit(), aComp->GetConvert() );
+    LIB_PART*      tempPart = cached.m_part.get();
 
-    tempPart.SetFlags( aComp->GetFlags() );
+    tempPart->ClearFlags();
+    tempPart->SetFlags( aComp->GetFlags() );
 
-    orientPart( &tempPart, aComp->GetOrientation());
+    size_t ii = 0;
 
-    for( auto& tempItem : tempPart.GetDrawItems() )
+    for( auto& tempItem : tempPart->GetDrawItems() )
     {
+        tempItem.ClearFlags();
+        tempItem.SetFlags( cached.m_itemFlags[ ii++ ] );
         tempItem.SetFlags( aComp->GetFlags() );     // SELECTED, HIGHLIGHTED, BRIGHTENED
-        tempItem.MoveTo( tempItem.GetPosition() + (wxPoint) mapCoords( aComp->GetPosition()));
     }
 
     // Copy the pin info from the component to the temp pins
-    LIB_PINS tempPins;
-    tempPart.GetPins( tempPins, aComp->GetUnit(), aComp->GetConvert() );
     const SCH_PINS& compPins = aComp->GetPins();
 
-    for( unsigned i = 0; i < tempPins.size() && i < compPins.size(); ++ i )
+    for( unsigned i = 0; i < cached.m_pins.size() && i < compPins.size(); ++ i )
     {
-        LIB_PIN* tempPin = tempPins[ i ];
+        LIB_PIN* tempPin = cached.m_pins[ i ];
         const SCH_PIN& compPin = compPins[ i ];
 
         tempPin->ClearFlags();
@@ -1206,7 +1257,12 @@ void SCH_PAINTER::draw( SCH_COMPONENT *aComp, int aLayer )
             tempPin->SetFlags( IS_DANGLING );
     }
 
-    draw( &tempPart, aLayer, false, aComp->GetUnit(), aComp->GetConvert() );
+    m_gal->Save();
+    m_gal->Translate( aComp->GetPosition() );
+
+    draw( tempPart, aLayer, false, aComp->GetUnit(), aComp->GetConvert() );
+
+    m_gal->Restore();
 
     // The fields are SCH_COMPONENT-specific so don't need to be copied/oriented/translated
     std::vector<SCH_FIELD*> fields;
@@ -29,6 +29,10 @@
 
 #include <painter.h>
 
+#include <map>
+#include <memory>
+#include <tuple>
+
 
 class LIB_RECTANGLE;
 class LIB_PIN;
@@ -117,6 +121,7 @@ class SCH_PAINTER : public PAINTER
 {
 public:
     SCH_PAINTER( GAL* aGal );
+    ~SCH_PAINTER();
 
     /// @copydoc PAINTER::Draw()
     virtual bool Draw( const VIEW_ITEM*, int ) override;
@@ -133,6 +138,12 @@ public:
         return &m_schSettings;
     }
 
+    /**
+     * Drops the oriented symbols kept to draw the components, e.g. when their library
+     * symbols were reloaded.
+     */
+    void ClearSymbolCache();
+
 private:
 	void draw( LIB_RECTANGLE* aRect, int aLayer );
 	void draw( LIB_PIN* aPin, int aLayer );
@@ -172,7 +183,29 @@ private:
 
     void triLine ( const VECTOR2D &a, const VECTOR2D &b, const VECTOR2D &c );
 
+    /**
+     * A library symbol oriented as a component, at the origin, shared by all the components
+     * with the same symbol, orientation, unit and convert.
+     */
+    struct CACHED_SYMBOL
+    {
+        PART_REF                  m_source;     // Expires when the library symbol is deleted
+        timestamp_t               m_sourceDate;
+        size_t                    m_sourceItemCount;
+        std::unique_ptr<LIB_PART> m_part;
+        std::vector<STATUS_FLAGS> m_itemFlags;  // Flags of the items before a component's
+        LIB_PINS                  m_pins;       // Pins of the unit and convert
+    };
+
+    ///> Key of the cached symbols: symbol, orientation, unit and convert
+    typedef std::tuple<LIB_PART*, int, int, int> SYMBOL_CACHE_KEY;
+
+    CACHED_SYMBOL& getCachedSymbol( LIB_PART* aPart, int aOrientation, int aUnit,
+                                    int aConvert );
+
     SCH_RENDER_SETTINGS m_schSettings;
+
+    std::map<SYMBOL_CACHE_KEY, CACHED_SYMBOL> m_symbolCache;
 };
 
 }; // namespace KIGFX
@@ -56,6 +56,7 @@
 #include <lib_pin.h>
 #include <symbol_lib_table.h>
 #include <tool/common_tools.h>
+#include <thread_pool.h>
 
 #include <thread>
 #include <algorithm>
@@ -107,6 +108,8 @@ SCH_SCREEN::SCH_SCREEN( KIWAY* aKiway ) :
     m_paper( wxT( "A4" ) )
 {
     m_modification_sync = 0;
+    m_indexDepth = 0;
+    m_indexNextOrder = 0;
 
     SetZoom( 32 );
 
@@ -159,9 +162,16 @@ void SCH_SCREEN::Append( SCH_SCREEN* aScreen )
 {
     wxCHECK_RET( aScreen, "Invalid screen object." );
 
+    if( m_index )
+    {
+        for( SCH_ITEM* item = aScreen->m_drawList.begin(); item; item = item->Next() )
+            indexItem( item );
+    }
+
     // No need to decend the hierarchy.  Once the top level screen is copied, all of it's
     // children are copied as well.
     m_drawList.Append( aScreen->m_drawList );
+    SCH_INSTANCE_TABLE::Invalidate();
 
     // This screen owns the objects now.  This prevents the object from being delete when
     // aSheet is deleted.
@@ -182,13 +192,133 @@ void SCH_SCREEN::Clear()
 
 void SCH_SCREEN::FreeDrawList()
 {
+    if( m_index )
+    {
+        m_index->RemoveAll();
+        m_indexEntries.clear();
+    }
+
     m_drawList.DeleteAll();
+    SCH_INSTANCE_TABLE::Invalidate();
 }
 
 
 void SCH_SCREEN::Remove( SCH_ITEM* aItem )
 {
+    if( m_index )
+        unindexItem( aItem );
+
     m_drawList.Remove( aItem );
+    SCH_INSTANCE_TABLE::Invalidate();
+}
+
+
+void SCH_SCREEN::BeginIndexedQueries()
+{
+    if( m_indexDepth++ > 0 )
+        return;
+
+    m_index.reset( new ITEM_RTREE() );
+    m_indexNextOrder = 0;
+
+    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+        indexItem( item );
+}
+
+
+void SCH_SCREEN::EndIndexedQueries()
+{
+    wxCHECK_RET( m_indexDepth > 0, wxT( "Screen items are not indexed." ) );
+
+    if( --m_indexDepth > 0 )
+        return;
+
+    m_index.reset();
+    m_indexEntries.clear();
+}
+
+
+void SCH_SCREEN::indexItem( SCH_ITEM* aItem )
+{
+    // The box of the item with its fields, its sheet pins and its connection points, large
+    // enough for the minimum accuracy of the hit tests.
+    EDA_RECT             box = aItem->GetBoundingBox();
+    std::vector<wxPoint> points;
+
+    aItem->GetConnectionPoints( points );
+
+    for( const wxPoint& point : points )
+        box.Merge( point );
+
+    if( aItem->Type() == SCH_SHEET_T )
+    {
+        for( SCH_SHEET_PIN& pin : static_cast<SCH_SHEET*>( aItem )->GetPins() )
+            box.Merge( pin.GetBoundingBox() );
+    }
+
+    box.Normalize();
+    box.Inflate( aItem->GetPenSize() + GetDefaultLineThickness() + 4 );
+
+    int min[2] = { box.GetX(), box.GetY() };
+    int max[2] = { box.GetRight(), box.GetBottom() };
+
+    if( m_indexEntries.count( aItem ) )
+        unindexItem( aItem );
+
+    m_index->Insert( min, max, aItem );
+    m_indexEntries[aItem] = { box, m_indexNextOrder++ };
+}
+
+
+void SCH_SCREEN::unindexItem( SCH_ITEM* aItem )
+{
+    auto it = m_indexEntries.find( aItem );
+
+    if( it == m_indexEntries.end() )
+        return;
+
+    const EDA_RECT& box = it->second.m_box;
+    int             min[2] = { box.GetX(), box.GetY() };
+    int             max[2] = { box.GetRight(), box.GetBottom() };
+
+    m_index->Remove( min, max, aItem );
+    m_indexEntries.erase( it );
+}
+
+
+void SCH_SCREEN::visitItemsAt( const wxPoint& aPosition, int aAccuracy,
+                               const std::function<bool( SCH_ITEM* )>& aVisitor ) const
+{
+    if( !m_index )
+    {
+        for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+        {
+            if( !aVisitor( item ) )
+                return;
+        }
+
+        return;
+    }
+
+    std::vector<std::pair<unsigned, SCH_ITEM*>> items;
+    int min[2] = { aPosition.x - aAccuracy, aPosition.y - aAccuracy };
+    int max[2] = { aPosition.x + aAccuracy, aPosition.y + aAccuracy };
+
+    m_index->Search( min, max,
+            [&]( SCH_ITEM* const& aItem ) -> bool
+            {
+                items.emplace_back( m_indexEntries.at( aItem ).m_order, aItem );
+                return true;
+            } );
+
+    // Visit them as the draw list would, for the queries returning the first match
+    std::sort( items.begin(), items.end() );
+
+    for( const std::pair<unsigned, SCH_ITEM*>& item : items )
+    {
+        if( !aVisitor( item.second ) )
+            return;
+    }
 }
 
 
@@ -209,7 +339,7 @@ void SCH_SCREEN::DeleteItem( SCH_ITEM* aItem )
     }
     else
     {
-        m_drawList.Remove( aItem );
+        Remove( aItem );
         delete aItem;
     }
 }
@@ -233,46 +363,59 @@ bool SCH_SCREEN::CheckIfOnDrawList( SCH_ITEM* aItem )
 
 SCH_ITEM* SCH_SCREEN::GetItem( const wxPoint& aPosition, int aAccuracy, KICAD_T aType ) const
 {
-    KICAD_T types[] = { aType, EOT };
-
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
-    {
-        switch( item->Type() )
-        {
-        case SCH_COMPONENT_T:
-        {
-            SCH_COMPONENT* component = (SCH_COMPONENT*) item;
+    KICAD_T   types[] = { aType, EOT };
+    SCH_ITEM* found = NULL;
 
-            for( int i = REFERENCE; i < component->GetFieldCount(); i++ )
+    visitItemsAt( aPosition, aAccuracy,
+            [&]( SCH_ITEM* item ) -> bool
             {
-                SCH_FIELD* field = component->GetField( i );
+                switch( item->Type() )
+                {
+                case SCH_COMPONENT_T:
+                {
+                    SCH_COMPONENT* component = (SCH_COMPONENT*) item;
 
-                if( field->IsType( types ) && field->HitTest( aPosition, aAccuracy ) )
-                    return field;
-            }
+                    for( int i = REFERENCE; i < component->GetFieldCount(); i++ )
+                    {
+                        SCH_FIELD* field = component->GetField( i );
 
-            break;
-        }
-        case SCH_SHEET_T:
-        {
-            SCH_SHEET* sheet = (SCH_SHEET*)item;
+                        if( field->IsType( types ) && field->HitTest( aPosition, aAccuracy ) )
+                        {
+                            found = field;
+                            return false;
+                        }
+                    }
+
+                    break;
+                }
+                case SCH_SHEET_T:
+                {
+                    SCH_SHEET* sheet = (SCH_SHEET*)item;
 
-            SCH_SHEET_PIN* pin = sheet->GetPin( aPosition );
+                    SCH_SHEET_PIN* pin = sheet->GetPin( aPosition );
 
-            if( pin && pin->IsType( types ) )
-                return pin;
+                    if( pin && pin->IsType( types ) )
+                    {
+                        found = pin;
+                        return false;
+                    }
 
-            break;
-        }
-        default:
-            break;
-        }
+                    break;
+                }
+                default:
+                    break;
+                }
 
-        if( item->IsType( types ) && item->HitTest( aPosition, aAccuracy ) )
-            return item;
-    }
+                if( item->IsType( types ) && item->HitTest( aPosition, aAccuracy ) )
+                {
+                    found = item;
+                    return false;
+                }
 
-    return NULL;
+                return true;
+            } );
+
+    return found;
 }
 
 
@@ -298,6 +441,12 @@ void SCH_SCREEN::ReplaceWires( DLIST< SCH_ITEM >& aWireList )
         }
     }
 
+    if( m_index )
+    {
+        for( item = aWireList.begin(); item; item = item->Next() )
+            indexItem( item );
+    }
+
     m_drawList.Append( aWireList );
 }
 
@@ -353,26 +502,36 @@ bool SCH_SCREEN::IsJunctionNeeded( const wxPoint& aPosition, bool aNew )
     int     pin_count = 0;
 
     std::vector<SCH_LINE*> lines[ sizeof( layers ) ];
+    bool    has_junction = false;
 
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
-    {
-        if( item->GetEditFlags() & STRUCT_DELETED )
-            continue;
+    visitItemsAt( aPosition, 0,
+            [&]( SCH_ITEM* item ) -> bool
+            {
+                if( item->GetEditFlags() & STRUCT_DELETED )
+                    return true;
+
+                if( aNew && ( item->Type() == SCH_JUNCTION_T ) && ( item->HitTest( aPosition ) ) )
+                {
+                    has_junction = true;
+                    return false;
+                }
 
-        if( aNew && ( item->Type() == SCH_JUNCTION_T ) && ( item->HitTest( aPosition ) ) )
-            return false;
+                if( ( item->Type() == SCH_LINE_T ) && ( item->HitTest( aPosition, 0 ) ) )
+                {
+                    if( item->GetLayer() == LAYER_WIRE )
+                        lines[ WIRES ].push_back( (SCH_LINE*) item );
+                    else if( item->GetLayer() == LAYER_BUS )
+                        lines[ BUSSES ].push_back( (SCH_LINE*) item );
+                }
 
-        if( ( item->Type() == SCH_LINE_T ) && ( item->HitTest( aPosition, 0 ) ) )
-        {
-            if( item->GetLayer() == LAYER_WIRE )
-                lines[ WIRES ].push_back( (SCH_LINE*) item );
-            else if( item->GetLayer() == LAYER_BUS )
-                lines[ BUSSES ].push_back( (SCH_LINE*) item );
-        }
+                if( ( item->Type() == SCH_COMPONENT_T ) && ( item->IsConnected( aPosition ) ) )
+                    pin_count++;
 
-        if( ( item->Type() == SCH_COMPONENT_T ) && ( item->IsConnected( aPosition ) ) )
-            pin_count++;
-    }
+                return true;
+            } );
+
+    if( has_junction )
+        return false;
 
     for( int i : { WIRES, BUSSES } )
     {
@@ -620,51 +779,48 @@ void SCH_SCREEN::ClearDrawingState()
 LIB_PIN* SCH_SCREEN::GetPin( const wxPoint& aPosition, SCH_COMPONENT** aComponent,
                              bool aEndPointOnly ) const
 {
-    SCH_ITEM*       item;
     SCH_COMPONENT*  component = NULL;
     LIB_PIN*        pin = NULL;
 
-    for( item = m_drawList.begin(); item; item = item->Next() )
-    {
-        if( item->Type() != SCH_COMPONENT_T )
-            continue;
+    visitItemsAt( aPosition, 0,
+            [&]( SCH_ITEM* item ) -> bool
+            {
+                if( item->Type() != SCH_COMPONENT_T )
+                    return true;
 
-        component = (SCH_COMPONENT*) item;
+                component = (SCH_COMPONENT*) item;
 
-        if( aEndPointOnly )
-        {
-            pin = NULL;
+                if( aEndPointOnly )
+                {
+                    pin = NULL;
 
-            auto part = component->GetPartRef().lock();
+                    auto part = component->GetPartRef().lock();
 
-            if( !part )
-                continue;
+                    if( !part )
+                        return true;
 
-            for( pin = part->GetNextPin(); pin; pin = part->GetNextPin( pin ) )
-            {
-                // Skip items not used for this part.
-                if( component->GetUnit() && pin->GetUnit() &&
-                    ( pin->GetUnit() != component->GetUnit() ) )
-                    continue;
+                    for( pin = part->GetNextPin(); pin; pin = part->GetNextPin( pin ) )
+                    {
+                        // Skip items not used for this part.
+                        if( component->GetUnit() && pin->GetUnit() &&
+                            ( pin->GetUnit() != component->GetUnit() ) )
+                            continue;
 
-                if( component->GetConvert() && pin->GetConvert() &&
-                    ( pin->GetConvert() != component->GetConvert() ) )
-                    continue;
+                        if( component->GetConvert() && pin->GetConvert() &&
+                            ( pin->GetConvert() != component->GetConvert() ) )
+                            continue;
 
-                if(component->GetPinPhysicalPosition( pin ) == aPosition )
-                    break;
-            }
-            if( pin )
-                break;
-        }
-        else
-        {
-            pin = (LIB_PIN*) component->GetDrawItem( aPosition, LIB_PIN_T );
+                        if(component->GetPinPhysicalPosition( pin ) == aPosition )
+                            break;
+                    }
+                }
+                else
+                {
+                    pin = (LIB_PIN*) component->GetDrawItem( aPosition, LIB_PIN_T );
+                }
 
-            if( pin )
-                break;
-        }
-    }
+                return pin == NULL;
+            } );
 
     if( pin && aComponent )
         *aComponent = component;
@@ -694,17 +850,17 @@ SCH_SHEET_PIN* SCH_SCREEN::GetSheetLabel( const wxPoint& aPosition )
 {
     SCH_SHEET_PIN* sheetPin = NULL;
 
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
-    {
-        if( item->Type() != SCH_SHEET_T )
-            continue;
+    visitItemsAt( aPosition, 0,
+            [&]( SCH_ITEM* item ) -> bool
+            {
+                if( item->Type() != SCH_SHEET_T )
+                    return true;
 
-        SCH_SHEET* sheet = (SCH_SHEET*) item;
-        sheetPin = sheet->GetPin( aPosition );
+                SCH_SHEET* sheet = (SCH_SHEET*) item;
+                sheetPin = sheet->GetPin( aPosition );
 
-        if( sheetPin )
-            break;
-    }
+                return sheetPin == NULL;
+            } );
 
     return sheetPin;
 }
@@ -712,17 +868,19 @@ SCH_SHEET_PIN* SCH_SCREEN::GetSheetLabel( const wxPoint& aPosition )
 
 int SCH_SCREEN::CountConnectedItems( const wxPoint& aPos, bool aTestJunctions ) const
 {
-    SCH_ITEM* item;
     int       count = 0;
 
-    for( item = m_drawList.begin(); item; item = item->Next() )
-    {
-        if( item->Type() == SCH_JUNCTION_T  && !aTestJunctions )
-            continue;
+    visitItemsAt( aPos, 0,
+            [&]( SCH_ITEM* item ) -> bool
+            {
+                if( item->Type() == SCH_JUNCTION_T  && !aTestJunctions )
+                    return true;
 
-        if( item->IsConnected( aPos ) )
-            count++;
-    }
+                if( item->IsConnected( aPos ) )
+                    count++;
+
+                return true;
+            } );
 
     return count;
 }
@@ -787,9 +945,11 @@ bool SCH_SCREEN::TestDanglingEnds()
     for( item = m_drawList.begin(); item; item = item->Next() )
         item->GetEndPoints( endPoints );
 
+    DANGLING_END_INDEX endPointIndex( endPoints );
+
     for( item = m_drawList.begin(); item; item = item->Next() )
     {
-        if( item->UpdateDanglingState( endPoints ) )
+        if( item->UpdateDanglingState( endPointIndex ) )
         {
             hasStateChanged = true;
         }
@@ -802,69 +962,90 @@ bool SCH_SCREEN::TestDanglingEnds()
 SCH_LINE* SCH_SCREEN::GetWireOrBus( const wxPoint& aPosition )
 {
     static KICAD_T types[] = { SCH_LINE_LOCATE_WIRE_T, SCH_LINE_LOCATE_BUS_T, EOT };
+    SCH_LINE*      found = nullptr;
 
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
-    {
-        if( item->IsType( types ) && item->HitTest( aPosition ) )
-            return (SCH_LINE*) item;
-    }
+    visitItemsAt( aPosition, 0,
+            [&]( SCH_ITEM* item ) -> bool
+            {
+                if( item->IsType( types ) && item->HitTest( aPosition ) )
+                {
+                    found = (SCH_LINE*) item;
+                    return false;
+                }
 
-    return nullptr;
+                return true;
+            } );
+
+    return found;
 }
 
 
 SCH_LINE* SCH_SCREEN::GetLine( const wxPoint& aPosition, int aAccuracy, int aLayer,
                                SCH_LINE_TEST_T aSearchType )
 {
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
-    {
-        if( item->Type() != SCH_LINE_T )
-            continue;
+    SCH_LINE* found = NULL;
 
-        if( item->GetLayer() != aLayer )
-            continue;
+    visitItemsAt( aPosition, aAccuracy,
+            [&]( SCH_ITEM* item ) -> bool
+            {
+                if( item->Type() != SCH_LINE_T )
+                    return true;
 
-        if( !item->HitTest( aPosition, aAccuracy ) )
-            continue;
+                if( item->GetLayer() != aLayer )
+                    return true;
 
-        switch( aSearchType )
-        {
-        case ENTIRE_LENGTH_T:
-            return (SCH_LINE*) item;
+                if( !item->HitTest( aPosition, aAccuracy ) )
+                    return true;
 
-        case EXCLUDE_END_POINTS_T:
-            if( !( (SCH_LINE*) item )->IsEndPoint( aPosition ) )
-                return (SCH_LINE*) item;
-            break;
+                switch( aSearchType )
+                {
+                case ENTIRE_LENGTH_T:
+                    found = (SCH_LINE*) item;
+                    break;
 
-        case END_POINTS_ONLY_T:
-            if( ( (SCH_LINE*) item )->IsEndPoint( aPosition ) )
-                return (SCH_LINE*) item;
-        }
-    }
+                case EXCLUDE_END_POINTS_T:
+                    if( !( (SCH_LINE*) item )->IsEndPoint( aPosition ) )
+                        found = (SCH_LINE*) item;
+                    break;
 
-    return NULL;
+                case END_POINTS_ONLY_T:
+                    if( ( (SCH_LINE*) item )->IsEndPoint( aPosition ) )
+                        found = (SCH_LINE*) item;
+                }
+
+                return found == NULL;
+            } );
+
+    return found;
 }
 
 
 SCH_TEXT* SCH_SCREEN::GetLabel( const wxPoint& aPosition, int aAccuracy )
 {
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
-    {
-        switch( item->Type() )
-        {
-        case SCH_LABEL_T:
-        case SCH_GLOBAL_LABEL_T:
-        case SCH_HIER_LABEL_T:
-            if( item->HitTest( aPosition, aAccuracy ) )
-                return (SCH_TEXT*) item;
+    SCH_TEXT* found = NULL;
 
-        default:
-            ;
-        }
-    }
+    visitItemsAt( aPosition, aAccuracy,
+            [&]( SCH_ITEM* item ) -> bool
+            {
+                switch( item->Type() )
+                {
+                case SCH_LABEL_T:
+                case SCH_GLOBAL_LABEL_T:
+                case SCH_HIER_LABEL_T:
+                    if( item->HitTest( aPosition, aAccuracy ) )
+                    {
+                        found = (SCH_TEXT*) item;
+                        return false;
+                    }
+
+                default:
+                    ;
+                }
 
-    return NULL;
+                return true;
+            } );
+
+    return found;
 }
 
 
@@ -1155,6 +1336,9 @@ int SCH_SCREENS::ReplaceDuplicateTimeStamps()
         }
     }
 
+    if( count )
+        SCH_INSTANCE_TABLE::Invalidate();
+
     return count;
 }
 
@@ -1227,32 +1411,12 @@ void SCH_SCREENS::TestDanglingEnds()
     for( SCH_SCREEN* screen = GetFirst(); screen; screen = GetNext() )
         screens.push_back( screen );
 
-    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
-            screens.size() );
-
-    std::atomic<size_t> nextScreen( 0 );
-    std::vector<std::future<size_t>> returns( parallelThreadCount );
-
-    auto update_lambda = [&screens, &nextScreen]() -> size_t
-    {
-        for( auto i = nextScreen++; i < screens.size(); i = nextScreen++ )
-            screens[i]->TestDanglingEnds();
-
-        return 1;
-    };
-
-    if( parallelThreadCount == 1 )
-        update_lambda();
-    else
-    {
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-            returns[ii] = std::async( std::launch::async, update_lambda );
-
-        // Finalize the threads
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-            returns[ii].wait();
-    }
-
+    THREAD_POOL::GetPool().ParallelFor( screens.size(),
+            [&screens]( size_t i )
+            {
+                screens[i]->TestDanglingEnds();
+            },
+            1 );
 }
 
 
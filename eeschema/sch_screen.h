@@ -25,6 +25,9 @@
 #ifndef SCREEN_H
 #define SCREEN_H
 
+#include <functional>
+#include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include <macros.h>
 #include <dlist.h>
@@ -36,6 +39,7 @@
 #include <kiway_holder.h>
 #include <sch_marker.h>
 #include <bus_alias.h>
+#include <geometry/rtree.h>
 
 
 class LIB_PIN;
@@ -94,6 +98,30 @@ private:
     /// List of bus aliases stored in this screen
     std::unordered_set< std::shared_ptr< BUS_ALIAS > > m_aliases;
 
+    /// The box of an item in m_index, and its rank in m_drawList
+    struct INDEX_ENTRY
+    {
+        EDA_RECT m_box;
+        unsigned m_order;
+    };
+
+    typedef RTree<SCH_ITEM*, int, 2, double> ITEM_RTREE;
+
+    std::unique_ptr<ITEM_RTREE> m_index;        ///< the items by position, while indexed
+    std::unordered_map<SCH_ITEM*, INDEX_ENTRY> m_indexEntries;
+    unsigned    m_indexDepth;                   ///< nesting of BeginIndexedQueries()
+    unsigned    m_indexNextOrder;               ///< rank of the next appended item
+
+    void indexItem( SCH_ITEM* aItem );
+    void unindexItem( SCH_ITEM* aItem );
+
+    /**
+     * Call \a aVisitor for the items which may be within \a aAccuracy of \a aPosition, in the
+     * order of the draw list, until it returns false.  Without index, all the items are visited.
+     */
+    void visitItemsAt( const wxPoint& aPosition, int aAccuracy,
+                       const std::function<bool( SCH_ITEM* )>& aVisitor ) const;
+
 public:
 
     /**
@@ -150,6 +178,10 @@ public:
     {
         m_drawList.Append( aItem );
         --m_modification_sync;
+        SCH_INSTANCE_TABLE::Invalidate();
+
+        if( m_index )
+            indexItem( aItem );
     }
 
     /**
@@ -171,10 +203,30 @@ public:
      */
     void Append( DLIST< SCH_ITEM >& aList )
     {
+        if( m_index )
+        {
+            for( SCH_ITEM* item = aList.begin(); item; item = item->Next() )
+                indexItem( item );
+        }
+
         m_drawList.Append( aList );
         --m_modification_sync;
+        SCH_INSTANCE_TABLE::Invalidate();
     }
 
+    /**
+     * Index the items by their position, so that the position queries (GetItem(), GetPin(),
+     * GetLine(), GetLabel(), IsJunctionNeeded(), IsTerminalPoint(), CountConnectedItems()...)
+     * do not walk the whole draw list, until the matching EndIndexedQueries().  The calls can
+     * be nested.
+     *
+     * Meanwhile the items must be appended and removed through the screen, and must not be
+     * moved or resized, as the index keeps their bounding boxes.
+     */
+    void BeginIndexedQueries();
+
+    void EndIndexedQueries();
+
     /**
      * Delete all draw items and clears the project settings.
      */
@@ -478,6 +530,28 @@ public:
 };
 
 
+/**
+ * Index the items of a screen while in scope, see SCH_SCREEN::BeginIndexedQueries().
+ */
+class SCH_SCREEN_INDEXED_QUERIES
+{
+public:
+    SCH_SCREEN_INDEXED_QUERIES( SCH_SCREEN* aScreen ) :
+        m_screen( aScreen )
+    {
+        m_screen->BeginIndexedQueries();
+    }
+
+    ~SCH_SCREEN_INDEXED_QUERIES()
+    {
+        m_screen->EndIndexedQueries();
+    }
+
+private:
+    SCH_SCREEN* m_screen;
+};
+
+
 /**
  * Container class that holds multiple #SCH_SCREEN objects in a hierarchy.
  *
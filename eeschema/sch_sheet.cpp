@@ -83,6 +83,8 @@ SCH_SHEET::SCH_SHEET( const SCH_SHEET& aSheet ) :
 
 SCH_SHEET::~SCH_SHEET()
 {
+    SCH_INSTANCE_TABLE::Invalidate();
+
     // also, look at the associated sheet & its reference count
     // perhaps it should be deleted also.
     if( m_screen )
@@ -121,6 +123,8 @@ void SCH_SHEET::SetScreen( SCH_SCREEN* aScreen )
 
     if( m_screen )
         m_screen->IncRefCount();
+
+    SCH_INSTANCE_TABLE::Invalidate();
 }
 
 
@@ -768,12 +772,12 @@ void SCH_SHEET::GetEndPoints( std::vector <DANGLING_END_ITEM>& aItemList )
 }
 
 
-bool SCH_SHEET::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList )
+bool SCH_SHEET::UpdateDanglingState( const DANGLING_END_INDEX& aIndex )
 {
     bool changed = false;
 
     for( SCH_SHEET_PIN& pinsheet : GetPins() )
-        changed |= pinsheet.UpdateDanglingState( aItemList );
+        changed |= pinsheet.UpdateDanglingState( aIndex );
 
     return changed;
 }
@@ -501,7 +501,7 @@ public:
 
     void GetEndPoints( std::vector <DANGLING_END_ITEM>& aItemList ) override;
 
-    bool UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList ) override;
+    bool UpdateDanglingState( const DANGLING_END_INDEX& aIndex ) override;
 
     bool IsConnectable() const override { return true; }
 
@@ -452,7 +452,10 @@ SCH_SHEET_LIST::SCH_SHEET_LIST( SCH_SHEET* aSheet )
 {
     m_isRootSheet = false;
 
-    if( aSheet != NULL )
+    // The full hierarchy is shared by the instance table rather than walked again.
+    if( aSheet != NULL && aSheet == g_RootSheet && wxIsMainThread() )
+        *this = SCH_INSTANCE_TABLE::Get().GetSheets();
+    else if( aSheet != NULL )
         BuildSheetList( aSheet );
 }
 
@@ -819,3 +822,61 @@ SCH_SHEET_PATH* SCH_SHEET_LIST::FindSheetForScreen( SCH_SCREEN* aScreen )
 
     return nullptr;
 }
+
+
+std::unique_ptr<SCH_INSTANCE_TABLE> SCH_INSTANCE_TABLE::s_table;
+std::atomic<unsigned> SCH_INSTANCE_TABLE::s_revision( 0 );
+
+
+SCH_INSTANCE_TABLE::SCH_INSTANCE_TABLE( SCH_SHEET* aRoot ) :
+    m_root( aRoot ),
+    m_revision( 0 )
+{
+    if( aRoot )
+        m_sheets.BuildSheetList( aRoot );
+
+    for( unsigned ii = 0; ii < m_sheets.size(); ii++ )
+    {
+        SCH_SHEET_PATH& sheet = m_sheets[ii];
+
+        for( SCH_ITEM* item = sheet.LastDrawList(); item; item = item->Next() )
+        {
+            if( item->Type() != SCH_COMPONENT_T )
+                continue;
+
+            SCH_COMPONENT* component = static_cast<SCH_COMPONENT*>( item );
+            wxString       reference = component->GetRef( &sheet );
+
+            m_references[ reference.Upper() ].push_back( m_instances.size() );
+            m_instances.push_back( { component, ii, reference } );
+        }
+    }
+
+    // GetRef() sets the default reference of the components which have none on a sheet path,
+    // which invalidates the table: it is up to date with these references.
+    m_revision = s_revision;
+}
+
+
+const SCH_INSTANCE_TABLE& SCH_INSTANCE_TABLE::Get()
+{
+    wxASSERT( wxIsMainThread() );
+
+    if( !s_table || s_table->m_root != g_RootSheet || s_table->m_revision != s_revision )
+        s_table.reset( new SCH_INSTANCE_TABLE( g_RootSheet ) );
+
+    return *s_table;
+}
+
+
+void SCH_INSTANCE_TABLE::FindReference( const wxString& aReference,
+                                        std::vector<const SCH_COMPONENT_INSTANCE*>& aInstances ) const
+{
+    auto it = m_references.find( aReference.Upper() );
+
+    if( it == m_references.end() )
+        return;
+
+    for( size_t ii : it->second )
+        aInstances.push_back( &m_instances[ii] );
+}
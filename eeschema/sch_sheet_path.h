@@ -33,7 +33,10 @@
 
 #include <base_struct.h>
 
+#include <atomic>
 #include <map>
+#include <memory>
+#include <unordered_map>
 
 
 /** Info about complex hierarchies handling:
@@ -545,4 +548,69 @@ public:
     void BuildSheetList( SCH_SHEET* aSheet );
 };
 
+
+/**
+ * A component instance of the flattened hierarchy.
+ */
+struct SCH_COMPONENT_INSTANCE
+{
+    SCH_COMPONENT* m_Component;
+    unsigned       m_SheetIndex;    ///< The index of the sheet path in the table sheet list.
+    wxString       m_Reference;     ///< The reference of the component on this sheet path.
+};
+
+
+/**
+ * Class SCH_INSTANCE_TABLE
+ * is the flattened hierarchy of #g_RootSheet: its sheet paths and the component instances
+ * used on each of them, with their references.
+ *
+ * Annotation, netlisting, the connection graph and the BOM tools walk the same hierarchy
+ * many times for a single command.  The table is built once and shared by all of them until
+ * an edit of the hierarchy, of a screen item list or of a component reference calls
+ * Invalidate().
+ */
+class SCH_INSTANCE_TABLE
+{
+public:
+    /**
+     * Function Get
+     * returns the table of the current hierarchy, rebuilt if it is out of date.  The table is
+     * valid until the next call.  It must only be used from the main thread.
+     */
+    static const SCH_INSTANCE_TABLE& Get();
+
+    /**
+     * Function Invalidate
+     * marks the table out of date.  It can be called from any thread.
+     */
+    static void Invalidate() { s_revision++; }
+
+    const SCH_SHEET_LIST& GetSheets() const { return m_sheets; }
+
+    const std::vector<SCH_COMPONENT_INSTANCE>& GetInstances() const { return m_instances; }
+
+    /**
+     * Function FindReference
+     * appends the component instances whose reference is \a aReference, regardless of the
+     * case, to \a aInstances in hierarchy order.
+     */
+    void FindReference( const wxString& aReference,
+                        std::vector<const SCH_COMPONENT_INSTANCE*>& aInstances ) const;
+
+private:
+    SCH_INSTANCE_TABLE( SCH_SHEET* aRoot );
+
+    SCH_SHEET*                                          m_root;
+    unsigned                                            m_revision;
+    SCH_SHEET_LIST                                      m_sheets;
+    std::vector<SCH_COMPONENT_INSTANCE>                 m_instances;
+
+    /// The indices of #m_instances, by upper case reference.
+    std::unordered_map<wxString, std::vector<size_t>>   m_references;
+
+    static std::unique_ptr<SCH_INSTANCE_TABLE>          s_table;
+    static std::atomic<unsigned>                        s_revision;
+};
+
 #endif // CLASS_DRAWSHEET_PATH_H
@@ -140,6 +140,7 @@ void SCH_TEXT::IncrementLabel( int aIncrement )
 {
     IncrementLabelMember( m_Text, aIncrement );
     m_shown_text = UnescapeString( m_Text );
+    invalidateTextBox();
 }
 
 
@@ -333,7 +334,7 @@ void SCH_TEXT::GetEndPoints( std::vector <DANGLING_END_ITEM>& aItemList )
 }
 
 
-bool SCH_TEXT::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList )
+bool SCH_TEXT::UpdateDanglingState( const DANGLING_END_INDEX& aIndex )
 {
     // Normal text labels cannot be tested for dangling ends.
     if( Type() == SCH_TEXT_T )
@@ -343,71 +344,71 @@ bool SCH_TEXT::UpdateDanglingState( std::vector<DANGLING_END_ITEM>& aItemList )
     m_isDangling = true;
     m_connectionType = CONNECTION_NONE;
 
-    for( unsigned ii = 0; ii < aItemList.size(); ii++ )
-    {
-        DANGLING_END_ITEM& item = aItemList[ii];
+    // The label is connected by the first item of the list which touches it: an end point
+    // at the text position or a wire or bus segment passing through it.
+    const DANGLING_END_ITEM* connected = nullptr;
 
-        if( item.GetItem() == this )
-            continue;
+    aIndex.VisitEndsAt( GetTextPos(), [&]( const DANGLING_END_ITEM& item ) -> bool
+            {
+                if( item.GetItem() == this )
+                    return true;
 
-        switch( item.GetType() )
-        {
-        case PIN_END:
-        case LABEL_END:
-        case SHEET_LABEL_END:
-        case NO_CONNECT_END:
-            if( GetTextPos() == item.GetPosition() )
+                switch( item.GetType() )
+                {
+                case PIN_END:
+                case LABEL_END:
+                case SHEET_LABEL_END:
+                case NO_CONNECT_END:
+                    connected = &item;
+                    return false;
+
+                default:
+                    return true;
+                }
+            } );
+
+    aIndex.VisitSegmentsAt( GetTextPos(),
+            [&]( const DANGLING_END_ITEM& start, const DANGLING_END_ITEM& end ) -> bool
             {
-                m_isDangling = false;
+                if( start.GetItem() == this )
+                    return true;
 
-                if( item.GetType() != PIN_END )
-                    m_connected_items.insert( static_cast< SCH_ITEM* >( item.GetItem() ) );
-            }
+                // Both lookups visit the items in list order.
+                if( !connected || &start < connected )
+                    connected = &start;
 
-            break;
+                return false;
+            } );
 
+    if( connected )
+    {
+        m_isDangling = false;
 
+        switch( connected->GetType() )
+        {
         case BUS_START_END:
-            m_connectionType = CONNECTION_BUS;
-            // fall through
-
         case WIRE_START_END:
         {
-            // These schematic items have created 2 DANGLING_END_ITEM one per end.  But being
-            // a paranoid programmer, I'll check just in case.
-            ii++;
-
-            wxCHECK_MSG( ii < aItemList.size(), previousState != m_isDangling,
-                         wxT( "Dangling end type list overflow.  Bad programmer!" ) );
-
-            DANGLING_END_ITEM & nextItem = aItemList[ii];
-            m_isDangling = !IsPointOnSegment( item.GetPosition(), nextItem.GetPosition(), GetTextPos() );
-
-            if( !m_isDangling )
-            {
-                if( m_connectionType != CONNECTION_BUS )
-                    m_connectionType = CONNECTION_NET;
-
-                // Add the line to the connected items, since it won't be picked
-                // up by a search of intersecting connection points
-                auto sch_item = static_cast< SCH_ITEM* >( item.GetItem() );
-                AddConnectionTo( sch_item );
-                sch_item->AddConnectionTo( this );
-            }
+            m_connectionType = ( connected->GetType() == BUS_START_END ) ? CONNECTION_BUS
+                                                                         : CONNECTION_NET;
+
+            // Add the line to the connected items, since it won't be picked
+            // up by a search of intersecting connection points
+            auto sch_item = static_cast< SCH_ITEM* >( connected->GetItem() );
+            AddConnectionTo( sch_item );
+            sch_item->AddConnectionTo( this );
         }
             break;
 
-        default:
+        case PIN_END:
             break;
-        }
 
-        if( !m_isDangling )
+        default:
+            m_connected_items.insert( static_cast< SCH_ITEM* >( connected->GetItem() ) );
             break;
+        }
     }
 
-    if( m_isDangling )
-        m_connectionType = CONNECTION_NONE;
-
     return previousState != m_isDangling;
 }
 
@@ -357,7 +357,8 @@ void NGSPICE::init_dll()
     m_ngSpice_AllVecs = (ngSpice_AllVecs) m_dll.GetSymbol( "ngSpice_AllVecs" );
     m_ngSpice_Running = (ngSpice_Running) m_dll.GetSymbol( "ngSpice_running" ); // it is not a typo
 
-    m_ngSpice_Init( &cbSendChar, &cbSendStat, &cbControlledExit, NULL, NULL, &cbBGThreadRunning, this );
+    m_ngSpice_Init( &cbSendChar, &cbSendStat, &cbControlledExit, &cbSendData, &cbSendInitData,
+                    &cbBGThreadRunning, this );
 
     // Load a custom spinit file, to fix the problem with loading .cm files
     // Switch to the executable directory, so the relative paths are correct
@@ -528,6 +529,56 @@ int NGSPICE::cbControlledExit( int status, bool immediate, bool exit_upon_quit,
 }
 
 
+int NGSPICE::cbSendInitData( pvecinfoall vecs, int id, void* user )
+{
+    NGSPICE* sim = reinterpret_cast<NGSPICE*>( user );
+    std::vector<string> names;
+    int scale = vecs->veccount > 0 ? 0 : -1;    // ngspice usually sends the scale first
+
+    for( int i = 0; i < vecs->veccount; i++ )
+        names.emplace_back( vecs->vecs[i]->vecname );
+
+    // The scale is the vector the others refer to
+    for( int i = 0; i < vecs->veccount; i++ )
+    {
+        if( !vecs->vecs[i]->pdvecscale )
+            continue;
+
+        for( int j = 0; j < vecs->veccount; j++ )
+        {
+            if( vecs->vecs[j]->pdvec == vecs->vecs[i]->pdvecscale )
+                scale = j;
+        }
+
+        break;
+    }
+
+    sim->m_streamRow.resize( names.size() );
+    sim->m_stream.Start( names, scale );
+
+    return 0;
+}
+
+
+int NGSPICE::cbSendData( pvecvaluesall vecs, int count, int id, void* user )
+{
+    NGSPICE* sim = reinterpret_cast<NGSPICE*>( user );
+
+    if( vecs->veccount != (int) sim->m_streamRow.size() )
+        return 0;
+
+    for( int i = 0; i < vecs->veccount; i++ )
+        sim->m_streamRow[i] = vecs->vecsa[i]->creal;
+
+    sim->m_stream.Push( sim->m_streamRow.data() );
+
+    if( sim->m_reporter && sim->m_stream.ShouldNotify() )
+        sim->m_reporter->OnSimData( sim );
+
+    return 0;
+}
+
+
 void NGSPICE::validate()
 {
     if( m_error )
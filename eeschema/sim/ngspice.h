@@ -26,6 +26,7 @@
 #define NGSPICE_H
 
 #include "spice_simulator.h"
+#include "sim_stream.h"
 
 #include <wx/dynlib.h>
 #include <ngspice/sharedspice.h>
@@ -77,6 +78,12 @@ public:
     ///> @copydoc SPICE_SIMULATOR::GetNetlist()
     virtual const std::string GetNetlist() const override;
 
+    ///> @copydoc SPICE_SIMULATOR::GetStream()
+    SIM_STREAM* GetStream() override
+    {
+        return &m_stream;
+    }
+
 private:
     void init();
 
@@ -119,6 +126,8 @@ private:
     static int cbSendStat( char* what, int id, void* user );
     static int cbBGThreadRunning( bool is_running, int id, void* user );
     static int cbControlledExit( int status, bool immediate, bool exit_upon_quit, int id, void* user );
+    static int cbSendInitData( pvecinfoall vecs, int id, void* user );
+    static int cbSendData( pvecvaluesall vecs, int count, int id, void* user );
 
     // Assures ngspice is in a valid state and reinitializes it if need be
     void validate();
@@ -131,6 +140,12 @@ private:
 
     ///> current netlist
     std::string m_netlist;
+
+    ///> Values sent by the simulation thread while it runs
+    SIM_STREAM m_stream;
+
+    ///> Row of values pushed to m_stream, used by the simulation thread only
+    std::vector<double> m_streamRow;
 };
 
 #endif /* NGSPICE_H */
@@ -40,6 +40,7 @@
 #include "sim_plot_panel.h"
 #include "spice_simulator.h"
 #include "spice_reporter.h"
+#include "sim_stream.h"
 #include <menus_helpers.h>
 #include <tool/tool_manager.h>
 #include <tools/ee_actions.h>
@@ -95,6 +96,11 @@ public:
         wxQueueEvent( m_parent, event );
     }
 
+    void OnSimData( SPICE_SIMULATOR* aObject ) override
+    {
+        wxQueueEvent( m_parent, new wxCommandEvent( EVT_SIM_DATA ) );
+    }
+
 private:
     SIM_PLOT_FRAME* m_parent;
 };
@@ -117,7 +123,8 @@ TRACE_DESC::TRACE_DESC( const NETLIST_EXPORTER_PSPICE_SIM& aExporter, const wxSt
 wxString SIM_PLOT_FRAME::m_savedWorkbooksPath;
 
 SIM_PLOT_FRAME::SIM_PLOT_FRAME( KIWAY* aKiway, wxWindow* aParent )
-    : SIM_PLOT_FRAME_BASE( aParent ), m_lastSimPlot( nullptr )
+    : SIM_PLOT_FRAME_BASE( aParent ), m_lastSimPlot( nullptr ), m_streamRun( -1 ),
+      m_streamScale( -1 )
 {
     SetKiway( this, aKiway );
     m_signalsIconColorList = NULL;
@@ -166,6 +173,7 @@ SIM_PLOT_FRAME::SIM_PLOT_FRAME( KIWAY* aKiway, wxWindow* aParent )
     Connect( EVT_SIM_REPORT, wxCommandEventHandler( SIM_PLOT_FRAME::onSimReport ), NULL, this );
     Connect( EVT_SIM_STARTED, wxCommandEventHandler( SIM_PLOT_FRAME::onSimStarted ), NULL, this );
     Connect( EVT_SIM_FINISHED, wxCommandEventHandler( SIM_PLOT_FRAME::onSimFinished ), NULL, this );
+    Connect( EVT_SIM_DATA, wxCommandEventHandler( SIM_PLOT_FRAME::onSimData ), NULL, this );
     Connect( EVT_SIM_CURSOR_UPDATE, wxCommandEventHandler( SIM_PLOT_FRAME::onCursorUpdate ), NULL, this );
 
     // Toolbar buttons
@@ -322,7 +330,7 @@ void SIM_PLOT_FRAME::setIconsForMenuItems()
         {
             // Modify the bitmap
             menu->Remove( item );
-            AddBitmapToMenuItem( item, KiBitmap( bm_list[ii].m_Bitmap ) );
+            AddBitmapToMenuItem( item, bm_list[ii].m_Bitmap );
             // Insert item to its the initial index
             menu->Insert( mpos, item );
         }
@@ -1373,6 +1381,81 @@ void SIM_PLOT_FRAME::onSimFinished( wxCommandEvent& aEvent )
 }
 
 
+void SIM_PLOT_FRAME::onSimData( wxCommandEvent& aEvent )
+{
+    SIM_STREAM* stream = m_simulator ? m_simulator->GetStream() : nullptr;
+
+    if( !stream )
+        return;
+
+    // Always read the values, so the buffer does not fill up
+    std::vector<double> rows;
+    int                 run;
+    size_t              count = stream->Pop( rows, run );
+    SIM_PLOT_PANEL*     plotPanel = CurrentPlot();
+
+    // Only the transient traces are drawn while the simulation runs: the other ones are
+    // converted (to dB or degrees) or split (DC sweeps) once complete
+    if( !count || !plotPanel || plotPanel->GetType() != ST_TRANSIENT
+            || m_exporter->GetSimType() != ST_TRANSIENT )
+    {
+        return;
+    }
+
+    if( run != m_streamRun )
+    {
+        m_streamRun = run;
+        m_streamScale = stream->GetScale();
+        m_streamTraces.clear();
+
+        for( const auto& trace : m_plots[plotPanel].m_traces )
+        {
+            const TRACE_DESC& desc = trace.second;
+            wxString          vector = m_exporter->GetSpiceVector( desc.GetName(),
+                                                                   desc.GetType(),
+                                                                   desc.GetParam() );
+            int               index = stream->FindVector( vector.ToStdString() );
+            TRACE*            plotTrace = plotPanel->GetTrace( trace.first );
+
+            if( index < 0 || !plotTrace )
+                continue;
+
+            // Draw the new run from its start
+            plotTrace->SetData( std::vector<double>(), std::vector<double>() );
+            m_streamTraces.emplace_back( trace.first, index );
+        }
+
+        // The vectors of a newer run were found: wait for its own values
+        if( stream->GetRun() != run )
+        {
+            m_streamRun = -1;
+            return;
+        }
+    }
+
+    size_t rowSize = rows.size() / count;
+
+    if( m_streamScale < 0 || m_streamTraces.empty() )
+        return;
+
+    std::vector<double> xs( count ), ys( count );
+
+    for( size_t ii = 0; ii < count; ++ii )
+        xs[ii] = rows[ii * rowSize + m_streamScale];
+
+    for( const auto& trace : m_streamTraces )
+    {
+        for( size_t ii = 0; ii < count; ++ii )
+            ys[ii] = rows[ii * rowSize + trace.second];
+
+        plotPanel->AppendTraceData( trace.first, count, xs.data(), ys.data() );
+    }
+
+    plotPanel->ResetScales();
+    plotPanel->UpdateAll();
+}
+
+
 void SIM_PLOT_FRAME::onSimUpdate( wxCommandEvent& aEvent )
 {
     if( IsSimulationRunning() )
@@ -1448,3 +1531,4 @@ wxDEFINE_EVENT( EVT_SIM_REPORT, wxCommandEvent );
 
 wxDEFINE_EVENT( EVT_SIM_STARTED, wxCommandEvent );
 wxDEFINE_EVENT( EVT_SIM_FINISHED, wxCommandEvent );
+wxDEFINE_EVENT( EVT_SIM_DATA, wxCommandEvent );
@@ -45,6 +45,7 @@
 #include <list>
 #include <memory>
 #include <map>
+#include <vector>
 
 class SCH_EDIT_FRAME;
 class SCH_COMPONENT;
@@ -280,6 +281,9 @@ private:
     void onSimStarted( wxCommandEvent& aEvent );
     void onSimFinished( wxCommandEvent& aEvent );
 
+    ///> Adds the values sent by the running simulation to the traces of the current plot
+    void onSimData( wxCommandEvent& aEvent );
+
     // adjust the sash dimension of splitter windows after reading
     // the config settings
     // must be called after the config settings are read, and once the
@@ -344,6 +348,12 @@ private:
     ///> Panel that was used as the most recent one for simulations
     SIM_PLOT_PANEL* m_lastSimPlot;
 
+    ///> Run of the simulator stream the traces were updated from, and the indices of the
+    ///> streamed vectors of the X axis and of each trace of the current plot
+    int m_streamRun;
+    int m_streamScale;
+    std::vector<std::pair<wxString, int>> m_streamTraces;
+
     ///> imagelists uset to add a small coloured icon to signal names
     ///> and cursors name, the same color as the corresponding signal traces
     wxImageList* m_signalsIconColorList;
@@ -365,5 +375,6 @@ wxDECLARE_EVENT( EVT_SIM_REPORT, wxCommandEvent );
 // Notifications
 wxDECLARE_EVENT( EVT_SIM_STARTED, wxCommandEvent );
 wxDECLARE_EVENT( EVT_SIM_FINISHED, wxCommandEvent );
+wxDECLARE_EVENT( EVT_SIM_DATA, wxCommandEvent );
 
 #endif // __sim_plot_frame__
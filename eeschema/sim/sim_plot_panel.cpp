@@ -361,6 +361,34 @@ void CURSOR::UpdateReference()
 }
 
 
+void TRACE::AppendData( const double* aX, const double* aY, size_t aPoints )
+{
+    if( !aPoints )
+        return;
+
+    if( m_cursor )
+        m_cursor->Update();
+
+    // The bounding box of an empty trace is not the one of its points
+    if( m_xs.empty() )
+    {
+        m_minX = m_maxX = aX[0];
+        m_minY = m_maxY = aY[0];
+    }
+
+    for( size_t i = 0; i < aPoints; i++ )
+    {
+        m_minX = std::min( m_minX, aX[i] );
+        m_maxX = std::max( m_maxX, aX[i] );
+        m_minY = std::min( m_minY, aY[i] );
+        m_maxY = std::max( m_maxY, aY[i] );
+    }
+
+    m_xs.insert( m_xs.end(), aX, aX + aPoints );
+    m_ys.insert( m_ys.end(), aY, aY + aPoints );
+}
+
+
 SIM_PLOT_PANEL::SIM_PLOT_PANEL( SIM_TYPE aType, wxWindow* parent, wxWindowID id, const wxPoint& pos,
                 const wxSize& size, long style, const wxString& name )
     : mpWindow( parent, id, pos, size, style ), m_colorIdx( 0 ),
@@ -541,6 +569,19 @@ bool SIM_PLOT_PANEL::AddTrace( const wxString& aName, int aPoints,
 }
 
 
+bool SIM_PLOT_PANEL::AppendTraceData( const wxString& aName, int aPoints, const double* aX,
+        const double* aY )
+{
+    TRACE* trace = GetTrace( aName );
+
+    if( !trace )
+        return false;
+
+    trace->AppendData( aX, aY, aPoints );
+    return true;
+}
+
+
 bool SIM_PLOT_PANEL::DeleteTrace( const wxString& aName )
 {
     auto it = m_traces.find( aName );
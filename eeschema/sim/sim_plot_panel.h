@@ -108,6 +108,13 @@ public:
         mpFXYVector::SetData( aX, aY );
     }
 
+    /**
+     * @brief Adds points at the end of the trace, e.g. while the simulation is running,
+     * without copying the points already there.
+     * @param aPoints is the number of values of aX and aY.
+     */
+    void AppendData( const double* aX, const double* aY, size_t aPoints );
+
     const std::vector<double>& GetDataX() const
     {
         return m_xs;
@@ -193,6 +200,13 @@ public:
     bool AddTrace( const wxString& aName, int aPoints,
             const double* aX, const double* aY, SIM_PLOT_TYPE aFlags );
 
+    /**
+     * @brief Adds points at the end of an existing trace.  The plot is not refreshed.
+     * @return false if there is no trace aName.
+     */
+    bool AppendTraceData( const wxString& aName, int aPoints, const double* aX,
+            const double* aY );
+
     bool DeleteTrace( const wxString& aName );
 
     void DeleteAllTraces();
@@ -0,0 +1,175 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * https://www.gnu.org/licenses/gpl-3.0.html
+ * or you may search the http://www.gnu.org website for the version 3 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "sim_stream.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+
+constexpr size_t SIM_STREAM::DEFAULT_CAPACITY;
+constexpr std::chrono::milliseconds SIM_STREAM::NOTIFY_PERIOD;
+
+
+SIM_STREAM::SIM_STREAM( size_t aCapacity ) :
+    m_scale( -1 ),
+    m_capacity( aCapacity ),
+    m_rowSize( 0 ),
+    m_rows( 0 ),
+    m_head( 0 ),
+    m_tail( 0 ),
+    m_dropped( 0 ),
+    m_run( 0 ),
+    m_notified( false )
+{
+}
+
+
+void SIM_STREAM::Start( const std::vector<std::string>& aNames, int aScale )
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    m_names = aNames;
+    m_scale = aScale;
+    m_rowSize = aNames.size();
+    m_rows = m_rowSize ? std::max<size_t>( 1, m_capacity / m_rowSize ) : 0;
+    m_values.resize( m_rows * m_rowSize );
+
+    m_head.store( 0 );
+    m_tail.store( 0 );
+    m_dropped.store( 0 );
+    m_notified.store( false );
+    m_lastNotify = std::chrono::steady_clock::time_point();
+    m_run++;
+}
+
+
+bool SIM_STREAM::Push( const double* aValues )
+{
+    size_t head = m_head.load( std::memory_order_relaxed );
+
+    if( !m_rows || head - m_tail.load( std::memory_order_acquire ) >= m_rows )
+    {
+        m_dropped++;
+        return false;
+    }
+
+    std::copy( aValues, aValues + m_rowSize, &m_values[( head % m_rows ) * m_rowSize] );
+    m_head.store( head + 1, std::memory_order_release );
+
+    return true;
+}
+
+
+bool SIM_STREAM::ShouldNotify()
+{
+    auto now = std::chrono::steady_clock::now();
+
+    if( m_notified.load() || now - m_lastNotify < NOTIFY_PERIOD )
+        return false;
+
+    m_lastNotify = now;
+    m_notified.store( true );
+    return true;
+}
+
+
+size_t SIM_STREAM::Pop( std::vector<double>& aRows, int& aRun, size_t aMaxRows )
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    aRun = m_run.load();
+
+    // Rows pushed from now on notify the GUI thread again
+    m_notified.store( false );
+
+    size_t tail = m_tail.load( std::memory_order_relaxed );
+    size_t count = std::min( m_head.load( std::memory_order_acquire ) - tail, aMaxRows );
+
+    aRows.reserve( aRows.size() + count * m_rowSize );
+
+    for( size_t ii = 0; ii < count; ++ii )
+    {
+        const double* row = &m_values[( ( tail + ii ) % m_rows ) * m_rowSize];
+        aRows.insert( aRows.end(), row, row + m_rowSize );
+    }
+
+    m_tail.store( tail + count, std::memory_order_release );
+
+    return count;
+}
+
+
+size_t SIM_STREAM::GetRowSize() const
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    return m_rowSize;
+}
+
+
+int SIM_STREAM::GetScale() const
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    return m_scale;
+}
+
+
+static bool equalNoCase( const std::string& aFirst, const std::string& aSecond )
+{
+    return aFirst.size() == aSecond.size()
+           && std::equal( aFirst.begin(), aFirst.end(), aSecond.begin(),
+                          []( char a, char b )
+                          {
+                              return std::tolower( (unsigned char) a )
+                                     == std::tolower( (unsigned char) b );
+                          } );
+}
+
+
+int SIM_STREAM::FindVector( const std::string& aName ) const
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    // ngspice names the voltage of node "x" either "V(x)" or "x"
+    std::string node;
+
+    if( aName.size() > 3 && ( aName[0] == 'V' || aName[0] == 'v' ) && aName[1] == '('
+            && aName.back() == ')' )
+    {
+        node = aName.substr( 2, aName.size() - 3 );
+    }
+
+    for( size_t ii = 0; ii < m_names.size(); ++ii )
+    {
+        if( equalNoCase( m_names[ii], aName )
+                || ( !node.empty() && equalNoCase( m_names[ii], node ) ) )
+        {
+            return (int) ii;
+        }
+    }
+
+    return -1;
+}
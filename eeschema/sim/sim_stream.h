@@ -0,0 +1,125 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * https://www.gnu.org/licenses/gpl-3.0.html
+ * or you may search the http://www.gnu.org website for the version 3 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef SIM_STREAM_H
+#define SIM_STREAM_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Ring buffer of the values sent by the simulator thread while it runs, one row of
+ * values (one per vector) for each point of the simulation, read by the GUI thread to
+ * update the plots before the simulation ends.
+ *
+ * The simulator thread is the only writer, and the GUI thread the only reader: the rows are
+ * pushed and popped without locks.  When the buffer is full, the new rows are dropped: the
+ * whole vectors are read from the simulator once it has finished anyway.
+ */
+class SIM_STREAM
+{
+public:
+    ///> Number of values kept at most (the rows are as long as the number of vectors)
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 20;
+
+    ///> Shortest time between two notifications of the GUI thread
+    static constexpr std::chrono::milliseconds NOTIFY_PERIOD{ 100 };
+
+    SIM_STREAM( size_t aCapacity = DEFAULT_CAPACITY );
+
+    /**
+     * @brief Starts a new run of the simulation (simulator thread).  The rows not read yet
+     * are dropped.
+     * @param aNames are the names of the vectors of each row.
+     * @param aScale is the index of the vector of the X axis, or -1 if there is none.
+     */
+    void Start( const std::vector<std::string>& aNames, int aScale );
+
+    /**
+     * @brief Adds the values of one point of the simulation (simulator thread).
+     * @param aValues are the values of each vector.
+     * @return false if the buffer is full and the row was dropped.
+     */
+    bool Push( const double* aValues );
+
+    /**
+     * @brief Checks if the GUI thread should be told there are new rows (simulator thread):
+     * it is told at most once every NOTIFY_PERIOD, and not again until it has read them.
+     */
+    bool ShouldNotify();
+
+    /**
+     * @brief Moves up to aMaxRows rows to the end of aRows (GUI thread).
+     * @param aRun is set to the number of the run the rows belong to.
+     * @return the number of rows moved.
+     */
+    size_t Pop( std::vector<double>& aRows, int& aRun, size_t aMaxRows = SIZE_MAX );
+
+    ///> Number of the current run, incremented by each Start()
+    int GetRun() const
+    {
+        return m_run.load();
+    }
+
+    ///> Number of values of each row, i.e. of vectors of the current run
+    size_t GetRowSize() const;
+
+    ///> Index of the vector of the X axis, or -1
+    int GetScale() const;
+
+    ///> Number of rows dropped in the current run since the buffer was full
+    size_t GetDropped() const
+    {
+        return m_dropped.load();
+    }
+
+    /**
+     * @brief Finds the vector of a plot, given in Spice convention (e.g. V(3), @r1[i]).
+     * The voltages of the nodes may be sent without "V(...)".
+     * @return the index of the vector in the rows, or -1 if it is not streamed.
+     */
+    int FindVector( const std::string& aName ) const;
+
+private:
+    mutable std::mutex       m_lock;       // Guards the names, and Start() against Pop()
+    std::vector<std::string> m_names;
+    int                      m_scale;
+    size_t                   m_capacity;   // In values
+    size_t                   m_rowSize;
+    size_t                   m_rows;       // Number of rows of m_values
+    std::vector<double>      m_values;
+
+    std::atomic<size_t> m_head;            // Rows pushed since Start()
+    std::atomic<size_t> m_tail;            // Rows popped since Start()
+    std::atomic<size_t> m_dropped;
+    std::atomic<int>    m_run;
+    std::atomic<bool>   m_notified;        // Cleared by Pop()
+
+    std::chrono::steady_clock::time_point m_lastNotify;
+};
+
+#endif /* SIM_STREAM_H */
@@ -46,6 +46,11 @@ public:
     }
 
     virtual void OnSimStateChange( SPICE_SIMULATOR* aObject, SIM_STATE aNewState ) = 0;
+
+    ///> Called from the simulator thread when new values are in SPICE_SIMULATOR::GetStream()
+    virtual void OnSimData( SPICE_SIMULATOR* aObject )
+    {
+    }
 };
 
 #endif /* SPICE_REPORTER_H */
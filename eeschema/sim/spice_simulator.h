@@ -34,6 +34,7 @@
 
 class SPICE_REPORTER;
 class SPICE_SIMULATOR;
+class SIM_STREAM;
 
 typedef std::complex<double> COMPLEX;
 
@@ -142,6 +143,16 @@ public:
      */
     virtual const std::string GetNetlist() const = 0;
 
+    /**
+     * @brief Returns the buffer of the values sent by the simulator while it runs, to update
+     * the plots before the end of the simulation.
+     * @return The buffer, or nullptr if the simulator does not send its values while running.
+     */
+    virtual SIM_STREAM* GetStream()
+    {
+        return nullptr;
+    }
+
 protected:
     ///> Reporter object to receive simulation log
     SPICE_REPORTER* m_reporter;
@@ -0,0 +1,143 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <wx/intl.h>
+
+#include <symbol_async_loader.h>
+
+#include <ki_exception.h>
+#include <symbol_lib_table.h>
+#include <thread_pool.h>
+#include <widgets/progress_reporter.h>
+
+
+SYMBOL_ASYNC_LOADER::SYMBOL_ASYNC_LOADER( const std::vector<wxString>& aNicknames,
+                                          SYMBOL_LIB_TABLE* aTable, bool aOnlyPowerSymbols,
+                                          PROGRESS_REPORTER* aReporter ) :
+        m_nicknames( aNicknames ),
+        m_table( aTable ),
+        m_onlyPowerSymbols( aOnlyPowerSymbols ),
+        m_reporter( aReporter ),
+        m_libErrors( aNicknames.size() ),
+        m_finished( 0 )
+{
+}
+
+
+SYMBOL_ASYNC_LOADER::~SYMBOL_ASYNC_LOADER()
+{
+    // The workers use the members of the loader
+    for( auto& result : m_results )
+    {
+        if( result.valid() )
+            result.wait();
+    }
+}
+
+
+void SYMBOL_ASYNC_LOADER::Start()
+{
+    if( m_reporter )
+        m_reporter->SetMaxProgress( m_nicknames.size() );
+
+    // Find the rows on this thread: the table indexes its rows and creates their plugins
+    // on the first look up.
+    for( size_t ii = 0; ii < m_nicknames.size(); ++ii )
+    {
+        try
+        {
+            m_table->FindRow( m_nicknames[ii] );
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            m_libErrors[ii] = ioe.What();
+        }
+    }
+
+    for( size_t ii = 0; ii < m_nicknames.size(); ++ii )
+    {
+        m_results.push_back( THREAD_POOL::GetPool().Async( [this, ii]()
+                                                           {
+                                                               return loadLibrary( ii );
+                                                           } ) );
+    }
+}
+
+
+bool SYMBOL_ASYNC_LOADER::Done() const
+{
+    return m_finished.load() >= m_nicknames.size();
+}
+
+
+std::vector<std::vector<LIB_ALIAS*>> SYMBOL_ASYNC_LOADER::Join()
+{
+    std::vector<std::vector<LIB_ALIAS*>> aliases;
+
+    for( auto& result : m_results )
+        aliases.push_back( result.get() );
+
+    m_results.clear();
+    m_errors.clear();
+
+    for( size_t ii = 0; ii < m_nicknames.size(); ++ii )
+    {
+        if( m_libErrors[ii].IsEmpty() )
+            continue;
+
+        if( !m_errors.IsEmpty() )
+            m_errors += "\n";
+
+        m_errors += wxString::Format( _( "Error loading symbol library %s.\n\n%s" ),
+                                      m_nicknames[ii], m_libErrors[ii] );
+    }
+
+    return aliases;
+}
+
+
+std::vector<LIB_ALIAS*> SYMBOL_ASYNC_LOADER::loadLibrary( size_t aIndex )
+{
+    std::vector<LIB_ALIAS*> aliases;
+
+    if( m_libErrors[aIndex].IsEmpty() )
+    {
+        try
+        {
+            // The tree only shows the names and descriptions of the symbols
+            m_table->LoadSymbolLib( aliases, m_nicknames[aIndex], m_onlyPowerSymbols, true );
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            aliases.clear();
+            m_libErrors[aIndex] = ioe.What();
+        }
+    }
+
+    m_finished.fetch_add( 1 );
+
+    if( m_reporter )
+        m_reporter->AdvanceProgress();
+
+    return aliases;
+}
@@ -0,0 +1,100 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef SYMBOL_ASYNC_LOADER_H
+#define SYMBOL_ASYNC_LOADER_H
+
+#include <atomic>
+#include <future>
+#include <vector>
+
+#include <wx/string.h>
+
+class LIB_ALIAS;
+class PROGRESS_REPORTER;
+class SYMBOL_LIB_TABLE;
+
+
+/**
+ * Load the symbol libraries of a #SYMBOL_LIB_TABLE on the workers of the #THREAD_POOL,
+ * as #FOOTPRINT_ASYNC_LOADER does for the footprint libraries.
+ *
+ * The libraries are loaded with SYMBOL_LIB_TABLE::LoadSymbolLib(), without the symbol
+ * bodies.  The rows of the table must not be changed until Join() returned.
+ *
+ * The caller must hold a #LOCALE_IO from Start() to Join(): the locale is global, and it
+ * cannot be switched by the workers.
+ */
+class SYMBOL_ASYNC_LOADER
+{
+public:
+    /**
+     * @param aNicknames are the nicknames of the libraries to load.
+     * @param aTable is the table of the libraries.
+     * @param aOnlyPowerSymbols is a flag to load only the power symbols.
+     * @param aReporter is advanced by one step for each loaded library.  It can be nullptr.
+     */
+    SYMBOL_ASYNC_LOADER( const std::vector<wxString>& aNicknames, SYMBOL_LIB_TABLE* aTable,
+                         bool aOnlyPowerSymbols = false, PROGRESS_REPORTER* aReporter = nullptr );
+
+    ~SYMBOL_ASYNC_LOADER();
+
+    /**
+     * Queue the loading of the libraries on the thread pool.
+     */
+    void Start();
+
+    /**
+     * @return true when all the libraries are loaded.
+     */
+    bool Done() const;
+
+    /**
+     * Wait until all the libraries are loaded.
+     *
+     * @return the aliases of each library, in the order of the nicknames.  The list of a
+     *         library which could not be loaded is empty.
+     */
+    std::vector<std::vector<LIB_ALIAS*>> Join();
+
+    /**
+     * @return the messages of the libraries which could not be loaded, after Join().
+     */
+    const wxString& GetErrors() const { return m_errors; }
+
+private:
+    ///> Load the library number aIndex, and return its aliases.
+    std::vector<LIB_ALIAS*> loadLibrary( size_t aIndex );
+
+    std::vector<wxString>  m_nicknames;
+    SYMBOL_LIB_TABLE*      m_table;
+    bool                   m_onlyPowerSymbols;
+    PROGRESS_REPORTER*     m_reporter;
+
+    std::vector<std::future<std::vector<LIB_ALIAS*>>> m_results;
+    std::vector<wxString>  m_libErrors;     ///< error message of each library, if any
+    std::atomic<size_t>    m_finished;      ///< count of the loaded libraries
+    wxString               m_errors;
+};
+
+#endif // SYMBOL_ASYNC_LOADER_H
@@ -111,6 +111,7 @@ public:
 
     static const char* PropPowerSymsOnly;
     static const char* PropNonPowerSymsOnly;
+    static const char* PropHeadersOnly;
 
     virtual void Parse( LIB_TABLE_LEXER* aLexer ) override;
 
@@ -157,8 +158,21 @@ public:
     void EnumerateSymbolLib( const wxString& aNickname, wxArrayString& aAliasNames,
                              bool aPowerSymbolsOnly = false );
 
+    /**
+     * Return the symbol aliases contained within the library given by @a aNickname.
+     *
+     * @param aAliasList is a reference to a list for the aliases.
+     * @param aNickname is a locator for the "library", it is a "name" in LIB_TABLE_ROW.
+     * @param aPowerSymbolsOnly is a flag to load only power symbols.
+     * @param aHeadersOnly is a flag to skip the drawing items and the footprint filters of
+     *                     the symbols when the library plugin can load them later.  Use it
+     *                     when only the names, the fields and the descriptions are needed.
+     *                     LoadSymbol() always returns a complete symbol.
+     *
+     * @throw IO_ERROR if the library cannot be found or loaded.
+     */
     void LoadSymbolLib( std::vector<LIB_ALIAS*>& aAliasList, const wxString& aNickname,
-                        bool aPowerSymbolsOnly = false );
+                        bool aPowerSymbolsOnly = false, bool aHeadersOnly = false );
 
     /**
      * Load a #LIB_ALIAS having @a aAliasName from the library given by @a aNickname.
@@ -20,12 +20,14 @@
  */
 
 #include <wx/tokenzr.h>
-#include <wx/progdlg.h>
 
+#include <common.h>
 #include <eda_pattern_match.h>
+#include <symbol_async_loader.h>
 #include <symbol_lib_table.h>
 #include <class_libentry.h>
 #include <generate_alias_info.h>
+#include <widgets/progress_reporter.h>
 
 #include <symbol_tree_model_adapter.h>
 
@@ -53,36 +55,57 @@ SYMBOL_TREE_MODEL_ADAPTER::~SYMBOL_TREE_MODEL_ADAPTER()
 void SYMBOL_TREE_MODEL_ADAPTER::AddLibraries( const std::vector<wxString>& aNicknames,
                                               wxWindow* aParent )
 {
-    wxProgressDialog* prg = nullptr;
-    wxLongLong        nextUpdate = wxGetUTCTimeMillis() + (PROGRESS_INTERVAL_MILLIS / 2);
+    std::unique_ptr<WX_PROGRESS_REPORTER> progressReporter;
 
     if( m_show_progress )
     {
-        prg = new wxProgressDialog( _( "Loading Symbol Libraries" ), wxEmptyString,
-                                    aNicknames.size(), aParent );
+        progressReporter.reset( new WX_PROGRESS_REPORTER( aParent,
+                                                          _( "Loading Symbol Libraries" ),
+                                                          1, false ) );
+        progressReporter->Report( _( "Loading Symbol Libraries" ) );
     }
 
-    unsigned int ii = 0;
+    std::vector<std::vector<LIB_ALIAS*>> aliases;
+    wxString                             errors;
 
-    for( const auto& nickname : aNicknames )
     {
-        if( prg && wxGetUTCTimeMillis() > nextUpdate )
+        // The libraries are parsed by the workers, which cannot switch the global locale
+        LOCALE_IO           toggle;
+        SYMBOL_ASYNC_LOADER loader( aNicknames, m_libs, GetFilter() == CMP_FILTER_POWER,
+                                    progressReporter.get() );
+
+        loader.Start();
+
+        while( !loader.Done() )
         {
-            prg->Update( ii, wxString::Format( _( "Loading library \"%s\"" ), nickname ) );
-            nextUpdate = wxGetUTCTimeMillis() + PROGRESS_INTERVAL_MILLIS;
+            if( progressReporter )
+                progressReporter->KeepRefreshing();
+
+            wxMilliSleep( PROGRESS_INTERVAL_MILLIS );
         }
 
-        AddLibrary( nickname );
-        ii++;
+        aliases = loader.Join();
+        errors = loader.GetErrors();
     }
 
-    m_tree.AssignIntrinsicRanks();
+    if( !errors.IsEmpty() )
+        wxLogError( "%s", errors );
 
-    if( prg )
+    for( size_t ii = 0; ii < aNicknames.size(); ++ii )
     {
-        prg->Destroy();
-        m_show_progress = false;
+        if( aliases[ii].size() > 0 )
+        {
+            std::vector<LIB_TREE_ITEM*> comp_list( aliases[ii].begin(), aliases[ii].end() );
+
+            DoAddLibrary( aNicknames[ii], m_libs->GetDescription( aNicknames[ii] ), comp_list,
+                          false );
+        }
     }
+
+    m_tree.AssignIntrinsicRanks();
+
+    if( progressReporter )
+        m_show_progress = false;
 }
 
 
@@ -94,7 +117,8 @@ void SYMBOL_TREE_MODEL_ADAPTER::AddLibrary( wxString const& aLibNickname )
 
     try
     {
-        m_libs->LoadSymbolLib( alias_list, aLibNickname, onlyPowerSymbols );
+        // The tree only shows the names and descriptions of the symbols
+        m_libs->LoadSymbolLib( alias_list, aLibNickname, onlyPowerSymbols, true );
     }
     catch( const IO_ERROR& ioe )
     {
@@ -30,6 +30,8 @@
 #include <tool/tool_manager.h>
 #include <tools/lib_control.h>
 
+#include <unordered_map>
+
 
 LIB_TREE_MODEL_ADAPTER::PTR SYMBOL_TREE_SYNCHRONIZING_ADAPTER::Create( LIB_EDIT_FRAME* aParent,
                                                                        LIB_MANAGER* aLibMgr )
@@ -75,6 +77,9 @@ void SYMBOL_TREE_SYNCHRONIZING_ADAPTER::Sync( bool aForce,
     m_lastSyncHash = libMgrHash;
     int i = 0, max = GetLibrariesCount();
 
+    InvalidateSearchIndex();
+    beginSyncChanges();
+
     // Process already stored libraries
     for( auto it = m_tree.Children.begin(); it != m_tree.Children.end(); /* iteration inside */ )
     {
@@ -118,6 +123,7 @@ void SYMBOL_TREE_SYNCHRONIZING_ADAPTER::Sync( bool aForce,
             SYMBOL_LIB_TABLE_ROW* library = m_libMgr->GetLibrary( libName );
 
             auto& lib_node = m_tree.AddLib( libName, library->GetDescr() );
+            nodeAdded();
             updateLibrary( lib_node );
         }
     }
@@ -149,38 +155,51 @@ void SYMBOL_TREE_SYNCHRONIZING_ADAPTER::updateLibrary( LIB_TREE_NODE_LIB& aLibNo
         // add a new library
         for( auto alias : m_libMgr->GetAliases( aLibNode.Name ) )
             aLibNode.AddItem( alias );
+
+        nodeAdded();
     }
     else if( hashIt->second != m_libMgr->GetLibraryHash( aLibNode.Name ) )
     {
         // update an existing library
         std::list<LIB_ALIAS*> aliases = m_libMgr->GetAliases( aLibNode.Name );
+        std::unordered_map<wxString, LIB_ALIAS*> unmatched;
+
+        for( auto alias : aliases )
+            unmatched.emplace( alias->GetName(), alias );
 
         // remove the common part from the aliases list
         for( auto nodeIt = aLibNode.Children.begin(); nodeIt != aLibNode.Children.end(); /**/ )
         {
-            auto aliasIt = std::find_if( aliases.begin(), aliases.end(),
-                    [&] ( const LIB_ALIAS* a ) {
-                        return a->GetName() == (*nodeIt)->Name;
-                    } );
+            auto aliasIt = unmatched.find( (*nodeIt)->Name );
 
-            if( aliasIt != aliases.end() )
+            if( aliasIt != unmatched.end() )
             {
                 // alias exists both in the component tree and the library manager,
                 // update only the node data
-                static_cast<LIB_TREE_NODE_LIB_ID*>( nodeIt->get() )->Update( *aliasIt );
-                aliases.erase( aliasIt );
+                static_cast<LIB_TREE_NODE_LIB_ID*>( nodeIt->get() )->Update( aliasIt->second );
+                nodeChanged( nodeIt->get() );
+                unmatched.erase( aliasIt );
                 ++nodeIt;
             }
             else
             {
                 // node does not exist in the library manager, remove the corresponding node
-                nodeIt = aLibNode.Children.erase( nodeIt );
+                nodeIt = detachNode( aLibNode.Children, nodeIt );
             }
         }
 
-        // now the aliases list contains only new aliases that need to be added to the tree
+        // now the unmatched aliases are new aliases that need to be added to the tree
         for( auto alias : aliases )
-            aLibNode.AddItem( alias );
+        {
+            if( unmatched.count( alias->GetName() ) )
+            {
+                aLibNode.AddItem( alias );
+                nodeAdded();
+            }
+        }
+
+        // the library row shows whether the library is modified
+        nodeChanged( &aLibNode );
     }
 
     aLibNode.AssignIntrinsicRanks();
@@ -193,8 +212,7 @@ LIB_TREE_NODE::PTR_VECTOR::iterator SYMBOL_TREE_SYNCHRONIZING_ADAPTER::deleteLib
 {
     LIB_TREE_NODE* node = aLibNodeIt->get();
     m_libHashes.erase( node->Name );
-    auto it = m_tree.Children.erase( aLibNodeIt );
-    return it;
+    return detachNode( m_tree.Children, aLibNodeIt );
 }
 
 
@@ -238,10 +256,10 @@ void SYMBOL_TREE_SYNCHRONIZING_ADAPTER::GetValue( wxVariant& aVariant, wxDataVie
             if( alias )
                 aVariant = alias->GetDescription();
             else
-                aVariant = node->Desc;
+                aVariant = node->Desc.wx_str();
         }
         else
-            aVariant = node->Desc;
+            aVariant = node->Desc.wx_str();
         break;
 
     default:    // column == -1 is used for default Compare function
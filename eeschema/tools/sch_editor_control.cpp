@@ -21,11 +21,14 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <set>
+
 #include <fctsys.h>
 #include <kiway.h>
 #include <sch_view.h>
 #include <sch_edit_frame.h>
 #include <sch_sheet.h>
+#include <sch_component.h>
 #include <connection_graph.h>
 #include <erc.h>
 #include <eeschema_id.h>
@@ -370,22 +373,39 @@ void SCH_EDITOR_CONTROL::doCrossProbeSchToPcb( const TOOL_EVENT& aEvent, bool aF
         return;
 
     EE_SELECTION_TOOL* selTool = m_toolMgr->GetTool<EE_SELECTION_TOOL>();
+    EE_SELECTION&      selection = aForce ? selTool->RequestSelection() : selTool->GetSelection();
     SCH_ITEM*          item = nullptr;
     SCH_COMPONENT*     component = nullptr;
 
-    if( aForce )
-    {
-        EE_SELECTION& selection = selTool->RequestSelection();
+    if( selection.GetSize() >= 1 )
+        item = (SCH_ITEM*) selection.Front();
 
-        if( selection.GetSize() >= 1 )
-            item = (SCH_ITEM*) selection.Front();
-    }
-    else
+    if( selection.GetSize() > 1 )
     {
-        EE_SELECTION& selection = selTool->GetSelection();
+        // Send all the selected components at once instead of only the first one
+        wxArrayString            references;
+        std::set<SCH_COMPONENT*> components;
+
+        for( EDA_ITEM* selected : selection )
+        {
+            if( selected->Type() == SCH_COMPONENT_T )
+                component = static_cast<SCH_COMPONENT*>( selected );
+            else if( selected->Type() == SCH_FIELD_T || selected->Type() == SCH_PIN_T )
+                component = dynamic_cast<SCH_COMPONENT*>( selected->GetParent() );
+            else
+                component = nullptr;
+
+            if( component && components.insert( component ).second )
+                references.Add( component->GetField( REFERENCE )->GetText() );
+        }
+
+        if( references.size() > 1 )
+        {
+            m_frame->SendCrossProbeParts( references );
+            return;
+        }
 
-        if( selection.GetSize() >= 1 )
-            item = (SCH_ITEM*) selection.Front();
+        component = nullptr;
     }
 
     if( !item )
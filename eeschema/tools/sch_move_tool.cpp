@@ -222,8 +222,10 @@ int SCH_MOVE_TOOL::Main( const TOOL_EVENT& aEvent )
                     for( EDA_ITEM* item : selection )
                         static_cast<SCH_ITEM*>( item )->GetEndPoints( internalPoints );
 
+                    DANGLING_END_INDEX internalPointIndex( internalPoints );
+
                     for( EDA_ITEM* item : selection )
-                        static_cast<SCH_ITEM*>( item )->UpdateDanglingState( internalPoints );
+                        static_cast<SCH_ITEM*>( item )->UpdateDanglingState( internalPointIndex );
                 }
                 // Generic setup
                 //
@@ -43,6 +43,7 @@
 
 #include <wx/log.h>
 #include <X2_gerber_attributes.h>
+#include <gerber_line_reader.h>
 
 /*
  * class X2_ATTRIBUTE
@@ -89,8 +90,7 @@ void X2_ATTRIBUTE::DbgListPrms()
         wxLogMessage( m_Prms.Item( ii ) );
 }
 
-bool X2_ATTRIBUTE::ParseAttribCmd( FILE* aFile, char *aBuffer, int aBuffSize, char* &aText,
-                                   int& aLineNum )
+bool X2_ATTRIBUTE::ParseAttribCmd( GERBER_LINE_READER* aReader, char* &aText, int& aLineNum )
 {
     // parse a TF command and fill m_Prms by the parameters found.
     // the "%TF" (start of command) is already read by the caller
@@ -133,9 +133,11 @@ bool X2_ATTRIBUTE::ParseAttribCmd( FILE* aFile, char *aBuffer, int aBuffSize, ch
         }
 
         // end of current line, read another one.
-        if( aBuffer && aFile )
+        if( aReader )
         {
-            if( fgets( aBuffer, aBuffSize, aFile ) == NULL )
+            aText = aReader->ReadLine();
+
+            if( aText == NULL )
             {
                 // end of file
                 ok = false;
@@ -143,7 +145,6 @@ bool X2_ATTRIBUTE::ParseAttribCmd( FILE* aFile, char *aBuffer, int aBuffSize, ch
             }
 
             aLineNum++;
-            aText = aBuffer;
         }
         else
             return ok;
@@ -46,6 +46,8 @@
 
 #include <wx/arrstr.h>
 
+class GERBER_LINE_READER;
+
 /**
  * class X2_ATTRIBUTE
  * The attribute value consists of a number of substrings separated by a comma
@@ -90,16 +92,15 @@ public:
     /**
      * parse a TF command terminated with a % and fill m_Prms
      * by the parameters found.
-     * @param aFile = a FILE* ptr to the current Gerber file.
-     * @param aBuffer = the buffer containing current Gerber data (can be null)
-     * @param aBuffSize = the size of the buffer
-     * @param aText = a pointer to the first char to read from Gerber data stored in aBuffer
+     * @param aReader = the reader of the current Gerber file, to read the next lines
+     *  of the command (can be null)
+     * @param aText = a pointer to the first char to read from the current line of aReader
      *  After parsing, text points the last char of the command line ('%') (X2 mode)
-     *  or the end of line if the line does not contain '%' or aBuffer == NULL (X1 mode)
-     * @param aLineNum = a point to the current line number of aFile
+     *  or the end of line if the line does not contain '%' or aReader == NULL (X1 mode)
+     * @param aLineNum = a point to the current line number of aReader
      * @return true if no error.
      */
-    bool ParseAttribCmd( FILE* aFile, char *aBuffer, int aBuffSize, char* &aText, int& aLineNum );
+    bool ParseAttribCmd( GERBER_LINE_READER* aReader, char* &aText, int& aLineNum );
 
     /**
      * Debug function: pring using wxLogMessage le list of parameters
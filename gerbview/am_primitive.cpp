@@ -106,7 +106,9 @@ void AM_PRIMITIVE::DrawBasicShape( const GERBER_DRAW_ITEM* aParent,
                             aShapeBuffer.Append( polybuffer[0].x, polybuffer[0].y );}
 
     // Draw the primitive shape for flashed items.
-    static std::vector<wxPoint> polybuffer;     // create a static buffer to avoid a lot of memory reallocation
+    // create a static buffer to avoid a lot of memory reallocation (one for each thread, as
+    // several files can be loaded at once)
+    static thread_local std::vector<wxPoint> polybuffer;
     polybuffer.clear();
 
     wxPoint curPos = aShapePos;
@@ -775,11 +777,26 @@ int AM_PRIMITIVE::GetShapeDim( const GERBER_DRAW_ITEM* aParent )
 
 SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* aParent,
                                                        wxPoint aShapePos )
+{
+    BuildApertureMacroShape( aParent, aShapePos, m_shape );
+
+    m_boundingBox = EDA_RECT( wxPoint( 0, 0 ), wxSize( 1, 1 ) );
+    auto bb = m_shape.BBox();
+    wxPoint center( bb.Centre().x, bb.Centre().y );
+    m_boundingBox.Move( aParent->GetABPosition( center ) );
+    m_boundingBox.Inflate( bb.GetWidth() / 2, bb.GetHeight() / 2 );
+
+    return &m_shape;
+}
+
+
+void APERTURE_MACRO::BuildApertureMacroShape( const GERBER_DRAW_ITEM* aParent,
+                                              wxPoint aShapePos, SHAPE_POLY_SET& aShape )
 {
     SHAPE_POLY_SET holeBuffer;
     bool hasHole = false;
 
-    m_shape.RemoveAllContours();
+    aShape.RemoveAllContours();
 
     for( AM_PRIMITIVES::iterator prim_macro = primitives.begin();
          prim_macro != primitives.end(); ++prim_macro )
@@ -788,14 +805,14 @@ SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* a
             continue;
 
         if( prim_macro->IsAMPrimitiveExposureOn( aParent ) )
-            prim_macro->DrawBasicShape( aParent, m_shape, aShapePos );
+            prim_macro->DrawBasicShape( aParent, aShape, aShapePos );
         else
         {
             prim_macro->DrawBasicShape( aParent, holeBuffer, aShapePos );
 
             if( holeBuffer.OutlineCount() )     // we have a new hole in shape: remove the hole
             {
-                m_shape.BooleanSubtract( holeBuffer, SHAPE_POLY_SET::PM_FAST );
+                aShape.BooleanSubtract( holeBuffer, SHAPE_POLY_SET::PM_FAST );
                 holeBuffer.RemoveAllContours();
                 hasHole = true;
             }
@@ -805,15 +822,7 @@ SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* a
     // If a hole is defined inside a polygon, we must fracture the polygon
     // to be able to drawn it (i.e link holes by overlapping edges)
     if( hasHole )
-        m_shape.Fracture( SHAPE_POLY_SET::PM_FAST );
-
-    m_boundingBox = EDA_RECT( wxPoint( 0, 0 ), wxSize( 1, 1 ) );
-    auto bb = m_shape.BBox();
-    wxPoint center( bb.Centre().x, bb.Centre().y );
-    m_boundingBox.Move( aParent->GetABPosition( center ) );
-    m_boundingBox.Inflate( bb.GetWidth() / 2, bb.GetHeight() / 2 );
-
-    return &m_shape;
+        aShape.Fracture( SHAPE_POLY_SET::PM_FAST );
 }
 
 
@@ -199,6 +199,18 @@ struct APERTURE_MACRO
      */
     SHAPE_POLY_SET* GetApertureMacroShape( const GERBER_DRAW_ITEM* aParent, wxPoint aShapePos );
 
+    /**
+     * Function BuildApertureMacroShape
+     * Calculate the same shape as GetApertureMacroShape(), in aShape.
+     * Unlike GetApertureMacroShape(), it does not change the macro, so it can be called
+     * from a worker thread while the macro is drawn.
+     * @param aParent = the parent GERBER_DRAW_ITEM which is actually drawn
+     * @param aShapePos = the actual shape position
+     * @param aShape = the buffer receiving the shape
+     */
+    void BuildApertureMacroShape( const GERBER_DRAW_ITEM* aParent, wxPoint aShapePos,
+                                  SHAPE_POLY_SET& aShape );
+
    /**
      * Function DrawApertureMacroShape
      * Draw the primitive shape for flashed items.
@@ -25,9 +25,11 @@
 /**
  * @file clear_gbr_drawlayers.cpp
  * @brief erase a given or all draw layers, an free memory relative to the cleared layer(s)
+ * or to the hidden layers
  */
 
 #include <fctsys.h>
+#include <common.h>
 #include <confirm.h>
 #include <gerbview_frame.h>
 #include <gerber_file_image.h>
@@ -35,6 +37,8 @@
 #include <gerbview_layer_widget.h>
 #include <view/view.h>
 #include <tool/tool_manager.h>
+#include <thread_pool.h>
+#include <html_messagebox.h>
 
 bool GERBVIEW_FRAME::Clear_DrawLayers( bool query )
 {
@@ -52,6 +56,7 @@ bool GERBVIEW_FRAME::Clear_DrawLayers( bool query )
         if( m_toolManager )
             m_toolManager->ResetTools( TOOL_BASE::MODEL_RELOAD );
 
+        ClearLayersComparison();
         GetCanvas()->GetView()->Clear();
 
         // Reinit the worksheet view, cleared by GetView()->Clear():
@@ -88,3 +93,104 @@ void GERBVIEW_FRAME::Erase_Current_DrawLayer( bool query )
     syncLayerBox();
     GetCanvas()->Refresh();
 }
+
+
+int GERBVIEW_FRAME::UnloadHiddenLayers()
+{
+    LSET visible = GetVisibleLayers();
+    int  count = 0;
+
+    // The selection can hold items of the hidden layers
+    if( m_toolManager )
+        m_toolManager->ResetTools( TOOL_BASE::MODEL_RELOAD );
+
+    for( unsigned layer = 0; layer < ImagesMaxCount(); ++layer )
+    {
+        GERBER_FILE_IMAGE* gerber = GetGbrImage( layer );
+
+        if( !gerber || visible[layer] || gerber->IsUnloaded() || !gerber->CanUnload() )
+            continue;
+
+        if( gerber->IsCompositeShown() )
+        {
+            GetCanvas()->GetView()->Remove( gerber );
+            gerber->SetCompositeShown( false );
+        }
+
+        // The deleted items are removed from the view
+        gerber->Unload();
+        count++;
+    }
+
+    return count;
+}
+
+
+void GERBVIEW_FRAME::ReloadLayers( LSET aLayerMask )
+{
+    std::vector<int>                layers;
+    std::vector<GERBER_FILE_IMAGE*> unloaded;
+
+    for( unsigned layer = 0; layer < ImagesMaxCount(); ++layer )
+    {
+        GERBER_FILE_IMAGE* gerber = GetGbrImage( layer );
+
+        if( gerber && gerber->IsUnloaded() && aLayerMask[layer] )
+        {
+            layers.push_back( layer );
+            unloaded.push_back( gerber );
+        }
+    }
+
+    if( unloaded.empty() )
+        return;
+
+    std::vector<GERBER_FILE_IMAGE*> reloaded( unloaded.size(), nullptr );
+
+    {
+        wxBusyCursor dummy;
+        LOCALE_IO    toggleIo;     // Switched once for all the threads
+
+        THREAD_POOL::GetPool().ParallelFor( unloaded.size(),
+                [&]( size_t aIndex )
+                {
+                    reloaded[aIndex] = unloaded[aIndex]->Reload();
+                },
+                1 );
+    }
+
+    wxString msg;
+
+    for( size_t ii = 0; ii < unloaded.size(); ++ii )
+    {
+        GERBER_FILE_IMAGE* gerber = reloaded[ii];
+
+        // The file has been deleted since it was unloaded: the layer stays empty
+        if( !gerber )
+        {
+            msg << "<b>" << _( "Unable to read file:" ) << "</b><br>"
+                << unloaded[ii]->m_FileName << "<br>";
+            continue;
+        }
+
+        gerber->m_IsVisible = unloaded[ii]->m_IsVisible;
+        gerber->m_Selected_Tool = unloaded[ii]->m_Selected_Tool;
+        GetImagesList()->AddGbrImage( gerber, layers[ii] );
+        delete unloaded[ii];
+
+        if( GetCanvas() )
+        {
+            for( GERBER_DRAW_ITEM* item : gerber->GetItems() )
+                GetCanvas()->GetView()->Add( (KIGFX::VIEW_ITEM*) item );
+        }
+    }
+
+    StartCompositeShapes();
+
+    if( !msg.IsEmpty() )
+    {
+        HTML_MESSAGE_BOX mbox( this, _( "Errors" ) );
+        mbox.ListSet( msg );
+        mbox.ShowModal();
+    }
+}
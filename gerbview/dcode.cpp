@@ -87,6 +87,7 @@ void D_CODE::Clear_D_CODE_Data()
     m_Rotation   = 0.0;
     m_EdgesCount = 0;
     m_Polygon.RemoveAllContours();
+    m_macroShapeValid = false;
 }
 
 
@@ -149,6 +150,34 @@ int D_CODE::GetShapeDim( GERBER_DRAW_ITEM* aParent )
 }
 
 
+// The length of the vectors used to identify the transform of the flashes of a macro shape
+#define MACRO_SHAPE_PROBE 1000000
+
+const SHAPE_POLY_SET& D_CODE::GetMacroShape( const GERBER_DRAW_ITEM* aParent )
+{
+    wxASSERT( m_Macro );
+
+    // The transform of aParent (axis swap, mirroring, scale and rotation) is identified
+    // by the images of two vectors; the offsets do not matter, as the shape is relative
+    // to the flash position.
+    wxPoint origin = aParent->GetABPosition( wxPoint( 0, 0 ) );
+    wxPoint axisA = aParent->GetABPosition( wxPoint( MACRO_SHAPE_PROBE, 0 ) ) - origin;
+    wxPoint axisB = aParent->GetABPosition( wxPoint( 0, MACRO_SHAPE_PROBE ) ) - origin;
+
+    if( !m_macroShapeValid || axisA != m_macroShapeAxisA || axisB != m_macroShapeAxisB )
+    {
+        m_macroShape = *m_Macro->GetApertureMacroShape( aParent, wxPoint( 0, 0 ) );
+        m_macroShape.Move( VECTOR2I( -origin.x, -origin.y ) );
+
+        m_macroShapeAxisA = axisA;
+        m_macroShapeAxisB = axisB;
+        m_macroShapeValid = true;
+    }
+
+    return m_macroShape;
+}
+
+
 void D_CODE::DrawFlashedShape(  GERBER_DRAW_ITEM* aParent,
                                 EDA_RECT* aClipBox, wxDC* aDC, COLOR4D aColor,
                                 wxPoint aShapePos, bool aFilledShape )
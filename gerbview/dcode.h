@@ -90,6 +90,15 @@ private:
      */
     std::vector<double>   m_am_params;
 
+    /**
+     * The shape of the aperture macro, relative to the flash position, built by
+     * GetMacroShape() for the transform identified by m_macroShapeAxisA and B.
+     */
+    SHAPE_POLY_SET        m_macroShape;
+    bool                  m_macroShapeValid;
+    wxPoint               m_macroShapeAxisA;
+    wxPoint               m_macroShapeAxisB;
+
 public:
     wxSize                m_Size;           ///< Horizontal and vertical dimensions.
     APERTURE_T            m_Shape;          ///< shape ( Line, rectangle, circle , oval .. )
@@ -122,6 +131,7 @@ public:
     void AppendParam( double aValue )
     {
         m_am_params.push_back( aValue );
+        m_macroShapeValid = false;
     }
 
     /**
@@ -151,11 +161,22 @@ public:
     void SetMacro( APERTURE_MACRO* aMacro )
     {
         m_Macro = aMacro;
+        m_macroShapeValid = false;
     }
 
 
     APERTURE_MACRO* GetMacro() const { return m_Macro; }
 
+    /**
+     * Function GetMacroShape
+     * returns the shape of the aperture macro of this D_CODE, for the flashed item aParent.
+     * The shape is relative to the flash position, aParent->GetABPosition( aParent->m_Start ),
+     * and is built only once for all the flashes sharing the same transform (usually all
+     * the flashes of the D_CODE), instead of evaluating the macro parameters for each one.
+     * @param aParent = a GERBER_DRAW_ITEM flashing this D_CODE
+     */
+    const SHAPE_POLY_SET& GetMacroShape( const GERBER_DRAW_ITEM* aParent );
+
     /**
      * Function ShowApertureType
      * returns a character string telling what type of aperture type \a aType is.
@@ -88,6 +88,9 @@ private:
 
     wxPrintout* createPrintout( const wxString& aTitle ) override
     {
+        // The hidden layers can be printed
+        m_parent->ReloadLayers( settings()->m_layerSet );
+
         return new GERBVIEW_PRINTOUT( m_parent->GetGerberLayout(), *settings(),
                                       m_parent->GetCanvas()->GetView(), aTitle );
     }
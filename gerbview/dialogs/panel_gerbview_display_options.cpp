@@ -99,6 +99,8 @@ bool PANEL_GERBVIEW_DISPLAY_OPTIONS::TransferDataFromWindow()
     if( needs_repaint )
         view->UpdateAllItems( KIGFX::REPAINT );
 
+    m_Parent->SyncCompositeShapes();
+
     m_Parent->GetCanvas()->Refresh();
 
     return true;
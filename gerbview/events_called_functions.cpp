@@ -25,6 +25,7 @@
 #include <fctsys.h>
 #include <pgm_base.h>
 #include <gestfich.h>
+#include <confirm.h>
 #include <gerbview.h>
 #include <gerbview_frame.h>
 #include <gerbview_id.h>
@@ -76,10 +77,13 @@ BEGIN_EVENT_TABLE( GERBVIEW_FRAME, EDA_DRAW_FRAME )
 
     // menu Postprocess
     EVT_MENU( ID_GERBVIEW_SHOW_LIST_DCODES, GERBVIEW_FRAME::Process_Special_Functions )
+    EVT_MENU( ID_GERBVIEW_SHOW_MEMORY_USAGE, GERBVIEW_FRAME::Process_Special_Functions )
+    EVT_MENU( ID_GERBVIEW_COMPARE_LAYERS, GERBVIEW_FRAME::Process_Special_Functions )
     EVT_MENU( ID_GERBVIEW_SHOW_SOURCE, GERBVIEW_FRAME::OnShowGerberSourceFile )
 
     // menu Miscellaneous
     EVT_MENU( ID_GERBVIEW_ERASE_CURR_LAYER, GERBVIEW_FRAME::Process_Special_Functions )
+    EVT_MENU( ID_GERBVIEW_UNLOAD_HIDDEN_LAYERS, GERBVIEW_FRAME::Process_Special_Functions )
 
     EVT_COMBOBOX( ID_TOOLBARH_GERBVIEW_SELECT_ACTIVE_LAYER, GERBVIEW_FRAME::OnSelectActiveLayer )
 
@@ -135,6 +139,19 @@ void GERBVIEW_FRAME::Process_Special_Functions( wxCommandEvent& event )
         Liste_D_Codes();
         break;
 
+    case ID_GERBVIEW_SHOW_MEMORY_USAGE:
+        ListMemoryUsage();
+        break;
+
+    case ID_GERBVIEW_COMPARE_LAYERS:
+        CompareLayers();
+        break;
+
+    case ID_GERBVIEW_UNLOAD_HIDDEN_LAYERS:
+        if( UnloadHiddenLayers() == 0 )
+            DisplayInfoMessage( this, _( "No hidden layer can be unloaded." ) );
+        break;
+
     case ID_HIGHLIGHT_CMP_ITEMS:
         m_SelComponentBox->SetStringSelection( currItem->GetNetAttributes().m_Cmpref );
         break;
@@ -151,6 +168,7 @@ void GERBVIEW_FRAME::Process_Special_Functions( wxCommandEvent& event )
         m_SelComponentBox->SetSelection( 0 );
         m_SelNetnameBox->SetSelection( 0 );
         m_SelAperAttributesBox->SetSelection( 0 );
+        ClearLayersComparison();
 
         if( GetGbrImage( GetActiveLayer() ) )
             GetGbrImage( GetActiveLayer() )->m_Selected_Tool = 0;
@@ -185,6 +203,7 @@ void GERBVIEW_FRAME::OnSelectHighlightChoice( wxCommandEvent& event )
 
     }
 
+    SyncCompositeShapes();
     GetCanvas()->GetView()->UpdateAllItems( KIGFX::COLOR );
     GetCanvas()->Refresh();
 }
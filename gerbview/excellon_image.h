@@ -171,6 +171,9 @@ public: EXCELLON_IMAGE( int layer ) :
      */
     bool LoadFile( const wxString& aFullFileName );
 
+    ///> @copydoc GERBER_FILE_IMAGE::Reload()
+    virtual GERBER_FILE_IMAGE* Reload() const override;
+
 private:
     bool Execute_HEADER_And_M_Command( char*& text );
     bool Select_Tool( char*& text );
@@ -75,7 +75,12 @@
 #include <X2_gerber_attributes.h>
 #include <view/view.h>
 
+#include <algorithm>
+#include <cctype>
 #include <cmath>
+#include <cstring>
+
+#include <wx/filename.h>
 
 #include <html_messagebox.h>
 
@@ -241,6 +246,89 @@ static EXCELLON_CMD excellon_G_CmdList[] =
 };
 
 
+// Drill files are mostly made of coordinate lines, but the commands are searched for
+// each line of the header and each tool change, route or slot: instead of comparing
+// the text with each name of the lists, the candidates are indexed once.
+
+// The commands of excellonHeaderCmdList, indexed by their first char, in list order
+// (the first matching name wins, as in the list)
+struct EXCELLON_HEADER_CMD_INDEX
+{
+    std::vector<EXCELLON_CMD*> m_ByFirstChar[256];
+
+    EXCELLON_HEADER_CMD_INDEX()
+    {
+        for( EXCELLON_CMD* cmd = excellonHeaderCmdList; !cmd->m_Name.empty(); cmd++ )
+            m_ByFirstChar[(unsigned char) cmd->m_Name[0]].push_back( cmd );
+    }
+};
+
+
+// The commands of excellon_G_CmdList, indexed by their number Gnn
+struct EXCELLON_G_CMD_INDEX
+{
+    EXCELLON_CMD* m_ByNumber[100];
+
+    EXCELLON_G_CMD_INDEX()
+    {
+        std::fill( std::begin( m_ByNumber ), std::end( m_ByNumber ), nullptr );
+
+        for( EXCELLON_CMD* cmd = excellon_G_CmdList; !cmd->m_Name.empty(); cmd++ )
+        {
+            int num = ( cmd->m_Name[1] - '0' ) * 10 + cmd->m_Name[2] - '0';
+
+            if( !m_ByNumber[num] )      // the first one in list wins
+                m_ByNumber[num] = cmd;
+        }
+    }
+};
+
+
+/**
+ * Search the header or M command at the beginning of aText.
+ * @return the command, or NULL if unknown.  aText is moved after the command name.
+ */
+static EXCELLON_CMD* findHeaderCommand( char*& aText )
+{
+    // Built once, by the first reader (the files can be read in parallel)
+    static const EXCELLON_HEADER_CMD_INDEX index;
+
+    for( EXCELLON_CMD* candidate : index.m_ByFirstChar[(unsigned char) *aText] )
+    {
+        size_t len = candidate->m_Name.size();
+
+        if( strncmp( candidate->m_Name.c_str(), aText, len ) == 0 )
+        {
+            aText += len;
+            return candidate;
+        }
+    }
+
+    return NULL;
+}
+
+
+/**
+ * Search the G command (G followed by 2 digits) at the beginning of aText.
+ * @return the command, or NULL if unknown.  aText is moved after the command name.
+ */
+static EXCELLON_CMD* findGCommand( char*& aText )
+{
+    static const EXCELLON_G_CMD_INDEX index;
+
+    if( aText[0] != 'G' || !isdigit( (unsigned char) aText[1] )
+            || !isdigit( (unsigned char) aText[2] ) )
+        return NULL;
+
+    EXCELLON_CMD* cmd = index.m_ByNumber[( aText[1] - '0' ) * 10 + aText[2] - '0'];
+
+    if( cmd )
+        aText += 3;
+
+    return cmd;
+}
+
+
 bool GERBVIEW_FRAME::Read_EXCELLON_File( const wxString& aFullFileName )
 {
     wxString msg;
@@ -284,13 +372,28 @@ bool GERBVIEW_FRAME::Read_EXCELLON_File( const wxString& aFullFileName )
 
     if( GetCanvas() )
     {
-        for( GERBER_DRAW_ITEM* item = drill_layer->GetItemsList(); item; item = item->Next() )
+        for( GERBER_DRAW_ITEM* item : drill_layer->GetItems() )
             GetCanvas()->GetView()->Add( (KIGFX::VIEW_ITEM*) item );
     }
 
     return success;
 }
 
+
+GERBER_FILE_IMAGE* EXCELLON_IMAGE::Reload() const
+{
+    EXCELLON_IMAGE* image = new EXCELLON_IMAGE( m_GraphicLayer );
+
+    if( !image->LoadFile( m_FileName ) )
+    {
+        delete image;
+        return NULL;
+    }
+
+    return image;
+}
+
+
 /*
  * Read a EXCELLON file.
  * Gerber classes are used because there is likeness between Gerber files
@@ -310,25 +413,23 @@ bool EXCELLON_IMAGE::LoadFile( const wxString & aFullFileName )
     ResetDefaultValues();
     ClearMessageList();
 
-    m_Current_File = wxFopen( aFullFileName, "rt" );
-
-    if( m_Current_File == NULL )
+    // Read the whole file at once: large drill files have a few hundred thousand lines
+    if( !m_lineReader.Open( aFullFileName ) )
         return false;
 
     wxString msg;
     m_FileName = aFullFileName;
+    m_FileTime = wxFileName( aFullFileName ).GetModificationTime();
 
     LOCALE_IO toggleIo;
 
-    // FILE_LINE_READER will close the file.
-    FILE_LINE_READER excellonReader( m_Current_File, m_FileName );
-
     while( true )
     {
-        if( excellonReader.ReadLine() == 0 )
+        char* line = m_lineReader.ReadLine();
+
+        if( line == NULL )
             break;
 
-        char* line = excellonReader.Line();
         char* text = StrPurge( line );
 
         if( *text == ';' || *text == 0 )       // comment: skip line or empty malformed line
@@ -379,11 +480,13 @@ bool EXCELLON_IMAGE::LoadFile( const wxString & aFullFileName )
         }
     }
 
+    m_lineReader.Close();
+
     // Add our file attribute, to identify the drill file
     X2_ATTRIBUTE dummy;
     char* text = (char*)file_attribute;
     int dummyline = 0;
-    dummy.ParseAttribCmd( NULL, NULL, 0, text, dummyline );
+    dummy.ParseAttribCmd( NULL, text, dummyline );
     delete m_FileFunction;
     m_FileFunction = new X2_ATTRIBUTE_FILEFUNCTION( dummy );
 
@@ -395,26 +498,9 @@ bool EXCELLON_IMAGE::LoadFile( const wxString & aFullFileName )
 
 bool EXCELLON_IMAGE::Execute_HEADER_And_M_Command( char*& text )
 {
-    EXCELLON_CMD* cmd = NULL;
+    EXCELLON_CMD* cmd = findHeaderCommand( text );
     wxString      msg;
 
-    // Search command in list
-    for( unsigned ii = 0; ; ii++ )
-    {
-        EXCELLON_CMD* candidate = &excellonHeaderCmdList[ii];
-        int len = candidate->m_Name.size();
-
-        if( len == 0 )                                                  // End of list reached
-            break;
-
-        if( candidate->m_Name.compare( 0, len, text, len ) == 0 )       // found.
-        {
-            cmd   = candidate;
-            text += len;
-            break;
-        }
-    }
-
     if( !cmd )
     {
         msg.Printf( _( "Unknown Excellon command &lt;%s&gt;" ), text );
@@ -664,8 +750,7 @@ bool EXCELLON_IMAGE::Execute_Drill_Command( char*& text )
                     return false;
                 }
 
-                gbritem = new GERBER_DRAW_ITEM( this );
-                m_Drawings.Append( gbritem );
+                gbritem = m_Drawings.Add( this );
 
                 if( m_SlotOn )  // Oblong hole
                 {
@@ -737,29 +822,10 @@ bool EXCELLON_IMAGE::Select_Tool( char*& text )
 
 bool EXCELLON_IMAGE::Execute_EXCELLON_G_Command( char*& text )
 {
-    EXCELLON_CMD* cmd     = NULL;
-    bool          success = false;
-    int           id = DRILL_G_UNKNOWN;
-
-    // Search command in list
-    EXCELLON_CMD* candidate;
-    char * gcmd = text;         // gcmd points the G command, for error messages.
-
-    for( unsigned ii = 0; ; ii++ )
-    {
-        candidate = &excellon_G_CmdList[ii];
-        int len = candidate->m_Name.size();
-        if( len == 0 )                                                  // End of list reached
-            break;
-        if( candidate->m_Name.compare( 0, len, text, len ) == 0 )       // found.
-        {
-            cmd     = candidate;
-            text   += len;
-            success = true;
-            id = cmd->m_Code;
-            break;
-        }
-    }
+    char*         gcmd = text;  // gcmd points the G command, for error messages.
+    EXCELLON_CMD* cmd = findGCommand( text );
+    bool          success = cmd != NULL;
+    int           id = cmd ? cmd->m_Code : DRILL_G_UNKNOWN;
 
     switch( id )
     {
@@ -898,7 +964,7 @@ void EXCELLON_IMAGE::FinishRouteCommand()
 
     for( size_t ii = 1; ii < m_RoutePositions.size(); ii++ )
     {
-        GERBER_DRAW_ITEM* gbritem = new GERBER_DRAW_ITEM( this );
+        GERBER_DRAW_ITEM* gbritem = m_Drawings.Add( this );
 
         if( m_RoutePositions[ii].m_rmode == 0 )     // linear routing
         {
@@ -925,8 +991,6 @@ void EXCELLON_IMAGE::FinishRouteCommand()
                          false );
         }
 
-        m_Drawings.Append( gbritem );
-
         StepAndRepeatItem( *gbritem );
     }
 
@@ -27,6 +27,9 @@
  * @brief Export the layers to Pcbnew.
  */
 
+#include <map>
+#include <memory>
+#include <set>
 #include <vector>
 
 #include <fctsys.h>
@@ -41,6 +44,7 @@
 #include <select_layers_to_pcb.h>
 #include <build_version.h>
 #include <wildcards_and_files_ext.h>
+#include <richio.h>
 
 
 // Imported function
@@ -52,13 +56,31 @@ extern const wxString GetPCBDefaultLayerName( LAYER_NUM aLayerNumber );
 class GBR_TO_PCB_EXPORTER
 {
 private:
+    /**
+     * A straight line being merged with the next collinear lines of the same layer and
+     * width, before being written as a track or a graphic line.
+     */
+    struct PENDING_LINE
+    {
+        bool      m_valid;
+        bool      m_isCopper;
+        wxPoint   m_start;
+        wxPoint   m_end;
+        int       m_width;
+        LAYER_NUM m_layer;
+    };
+
     GERBVIEW_FRAME*         m_gerbview_frame;   // the main gerber frame
     wxString                m_pcb_file_name;    // BOARD file to write to
-    FILE*                   m_fp;               // the board file
+    std::unique_ptr<FILE_OUTPUTFORMATTER> m_out; // the board file (buffered)
     int                     m_pcbCopperLayersCount;
-    std::vector<wxPoint>    m_vias_coordinates; // list of already generated vias,
+    std::set<std::pair<int, int>> m_vias_coordinates; // already generated vias,
                                                 // used to export only once a via
                                                 // having a given coordinate
+    std::vector<std::string> m_layerNames;      // the board layer names, by layer number
+    PENDING_LINE            m_pendingLine;
+    std::map<LAYER_NUM, SHAPE_POLY_SET> m_regions; // the polygons of each layer, merged
+                                                // and written at the end of the export
 public:
     GBR_TO_PCB_EXPORTER( GERBVIEW_FRAME* aFrame, const wxString& aFileName );
     ~GBR_TO_PCB_EXPORTER();
@@ -78,11 +100,21 @@ private:
     void    export_non_copper_item( GERBER_DRAW_ITEM* aGbrItem, LAYER_NUM aLayer );
 
     /**
-     * write a non copper polygon item to the board file.
-     * @param aGbrItem = the Gerber item (line, arc) to export
-     * @param aLayer = the technical layer to use
+     * adds a polygon item to the regions of aLayer, written by writePcbRegions().
+     * @param aGbrItem = the Gerber item (polygon) to export
+     * @param aLayer = the layer to use
+     */
+    void    addPcbPolygonItem( GERBER_DRAW_ITEM* aGbrItem, LAYER_NUM aLayer );
+
+    /**
+     * writes the regions of each layer, the overlapping polygons being merged.
+     */
+    void    writePcbRegions();
+
+    /**
+     * write a polygon outline to the board file.
      */
-    void    writePcbPolygonItem( GERBER_DRAW_ITEM* aGbrItem, LAYER_NUM aLayer );
+    void    writePcbPolygon( const SHAPE_LINE_CHAIN& aPoly, LAYER_NUM aLayer );
 
     /**
      * write a track or via) to the board file.
@@ -131,6 +163,27 @@ private:
     void    writeCopperLineItem( wxPoint& aStart, wxPoint& aEnd,
                                  int aWidth, LAYER_NUM aLayer );
 
+    /**
+     * function addLineItem
+     * merges a straight line with the pending line when it continues it, and writes the
+     * pending line otherwise.  Lines drawn by many short collinear strokes, and the dots
+     * at their ends, give one board item.
+     */
+    void    addLineItem( bool aIsCopper, const wxPoint& aStart, const wxPoint& aEnd,
+                         int aWidth, LAYER_NUM aLayer );
+
+    /**
+     * function flushLineItem
+     * writes the pending line, if any
+     */
+    void    flushLineItem();
+
+    /// @return the name of a board layer, in the board file encoding
+    const char* layerName( LAYER_NUM aLayer ) const
+    {
+        return m_layerNames[aLayer].c_str();
+    }
+
     /**
      * function writePcbHeader
      * Write a very basic header to the board file
@@ -152,8 +205,12 @@ GBR_TO_PCB_EXPORTER::GBR_TO_PCB_EXPORTER( GERBVIEW_FRAME* aFrame, const wxString
 {
     m_gerbview_frame    = aFrame;
     m_pcb_file_name     = aFileName;
-    m_fp                = NULL;
     m_pcbCopperLayersCount = 2;
+    m_pendingLine.m_valid = false;
+
+    // Converting the layer names once saves a conversion for each item
+    for( int ii = 0; ii < PCB_LAYER_ID_COUNT; ii++ )
+        m_layerNames.push_back( TO_UTF8( GetPCBDefaultLayerName( ii ) ) );
 }
 
 
@@ -185,6 +242,9 @@ void GERBVIEW_FRAME::ExportDataInPcbnewFormat( wxCommandEvent& event )
         return;
     }
 
+    // The unloaded layers are exported too
+    ReloadLayers( LSET::AllLayersMask() );
+
     wxString        fileName;
     wxString        path = m_mruPath;
 
@@ -219,9 +279,11 @@ bool GBR_TO_PCB_EXPORTER::ExportPcb( LAYER_NUM* aLayerLookUpTable, int aCopperLa
 {
     LOCALE_IO   toggle;     // toggles on, then off, the C locale.
 
-    m_fp = wxFopen( m_pcb_file_name, wxT( "wt" ) );
-
-    if( m_fp == NULL )
+    try
+    {
+        m_out.reset( new FILE_OUTPUTFORMATTER( m_pcb_file_name ) );
+    }
+    catch( const IO_ERROR& )
     {
         wxString msg;
         msg.Printf( _( "Cannot create file \"%s\"" ), GetChars( m_pcb_file_name ) );
@@ -231,57 +293,69 @@ bool GBR_TO_PCB_EXPORTER::ExportPcb( LAYER_NUM* aLayerLookUpTable, int aCopperLa
 
     m_pcbCopperLayersCount = aCopperLayers;
 
-    writePcbHeader( aLayerLookUpTable );
+    // The formatter throws an IO_ERROR if the file cannot be written (disk full...)
+    try
+    {
+        writePcbHeader( aLayerLookUpTable );
 
-    // create an image of gerber data
-    // First: non copper layers:
-    const int pcbCopperLayerMax = 31;
-    GERBER_FILE_IMAGE_LIST* images = m_gerbview_frame->GetGerberLayout()->GetImagesList();
+        // create an image of gerber data
+        // First: non copper layers:
+        const int pcbCopperLayerMax = 31;
+        GERBER_FILE_IMAGE_LIST* images = m_gerbview_frame->GetGerberLayout()->GetImagesList();
 
-    for( unsigned layer = 0; layer < images->ImagesMaxCount(); ++layer )
-    {
-        GERBER_FILE_IMAGE* gerber = images->GetGbrImage( layer );
+        for( unsigned layer = 0; layer < images->ImagesMaxCount(); ++layer )
+        {
+            GERBER_FILE_IMAGE* gerber = images->GetGbrImage( layer );
 
-        if( gerber == NULL )    // Graphic layer not yet used
-            continue;
+            if( gerber == NULL )    // Graphic layer not yet used
+                continue;
 
-        LAYER_NUM pcb_layer_number = aLayerLookUpTable[layer];
+            LAYER_NUM pcb_layer_number = aLayerLookUpTable[layer];
 
-        if( !IsPcbLayer( pcb_layer_number ) )
-            continue;
+            if( !IsPcbLayer( pcb_layer_number ) )
+                continue;
 
-        if( pcb_layer_number <= pcbCopperLayerMax ) // copper layer
-            continue;
+            if( pcb_layer_number <= pcbCopperLayerMax ) // copper layer
+                continue;
 
-        GERBER_DRAW_ITEM* gerb_item = gerber->GetItemsList();
+            for( GERBER_DRAW_ITEM* gerb_item : gerber->GetItems() )
+                export_non_copper_item( gerb_item, pcb_layer_number );
 
-        for( ; gerb_item; gerb_item = gerb_item->Next() )
-            export_non_copper_item( gerb_item, pcb_layer_number );
-    }
+            flushLineItem();
+        }
 
-    // Copper layers
-    for( unsigned layer = 0; layer < images->ImagesMaxCount(); ++layer )
-    {
-        GERBER_FILE_IMAGE* gerber = images->GetGbrImage( layer );
+        // Copper layers
+        for( unsigned layer = 0; layer < images->ImagesMaxCount(); ++layer )
+        {
+            GERBER_FILE_IMAGE* gerber = images->GetGbrImage( layer );
 
-        if( gerber == NULL )    // Graphic layer not yet used
-            continue;
+            if( gerber == NULL )    // Graphic layer not yet used
+                continue;
 
-        LAYER_NUM pcb_layer_number = aLayerLookUpTable[layer];
+            LAYER_NUM pcb_layer_number = aLayerLookUpTable[layer];
 
-        if( pcb_layer_number < 0 || pcb_layer_number > pcbCopperLayerMax )
-            continue;
+            if( pcb_layer_number < 0 || pcb_layer_number > pcbCopperLayerMax )
+                continue;
+
+            for( GERBER_DRAW_ITEM* gerb_item : gerber->GetItems() )
+                export_copper_item( gerb_item, pcb_layer_number );
 
-        GERBER_DRAW_ITEM* gerb_item = gerber->GetItemsList();
+            flushLineItem();
+        }
+
+        writePcbRegions();
 
-        for( ; gerb_item; gerb_item = gerb_item->Next() )
-            export_copper_item( gerb_item, pcb_layer_number );
+        m_out->Print( 0, ")\n" );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        m_out.reset();
+        DisplayError( m_gerbview_frame, ioe.What() );
+        return false;
     }
 
-    fprintf( m_fp, ")\n" );
+    m_out.reset();     // closes the file
 
-    fclose( m_fp );
-    m_fp = NULL;
     return true;
 }
 
@@ -296,7 +370,7 @@ void GBR_TO_PCB_EXPORTER::export_non_copper_item( GERBER_DRAW_ITEM* aGbrItem, LA
 
     if( aGbrItem->m_Shape == GBR_POLYGON )
     {
-        writePcbPolygonItem( aGbrItem, aLayer );
+        addPcbPolygonItem( aGbrItem, aLayer );
         return;
     }
 
@@ -319,7 +393,16 @@ void GBR_TO_PCB_EXPORTER::export_non_copper_item( GERBER_DRAW_ITEM* aGbrItem, LA
     // Reverse Y axis:
     seg_start.y = -seg_start.y;
     seg_end.y = -seg_end.y;
-    writePcbLineItem( isArc, seg_start, seg_end, aGbrItem->m_Size.x, aLayer, angle );
+
+    if( isArc )
+    {
+        flushLineItem();
+        writePcbLineItem( isArc, seg_start, seg_end, aGbrItem->m_Size.x, aLayer, angle );
+    }
+    else
+    {
+        addLineItem( false, seg_start, seg_end, aGbrItem->m_Size.x, aLayer );
+    }
 }
 
 
@@ -341,7 +424,7 @@ void GBR_TO_PCB_EXPORTER::export_copper_item( GERBER_DRAW_ITEM* aGbrItem, LAYER_
     case GBR_POLYGON:
         // Currently: Pcbnew does not really handle polygons on copper layers (no DRC test).
         // However, we can export them if the purpose of this export is to help recreate a board
-        writePcbPolygonItem( aGbrItem, aLayer );
+        addPcbPolygonItem( aGbrItem, aLayer );
         break;
 
     default:
@@ -369,13 +452,72 @@ void GBR_TO_PCB_EXPORTER::export_segline_copper_item( GERBER_DRAW_ITEM* aGbrItem
 void GBR_TO_PCB_EXPORTER::writeCopperLineItem( wxPoint& aStart, wxPoint& aEnd,
                                                int aWidth, LAYER_NUM aLayer )
 {
-  fprintf( m_fp, "(segment (start %s %s) (end %s %s) (width %s) (layer %s) (net 0))\n",
-                  Double2Str( MapToPcbUnits(aStart.x) ).c_str(),
-                  Double2Str( MapToPcbUnits(aStart.y) ).c_str(),
-                  Double2Str( MapToPcbUnits(aEnd.x) ).c_str(),
-                  Double2Str( MapToPcbUnits(aEnd.y) ).c_str(),
-                  Double2Str( MapToPcbUnits( aWidth ) ).c_str(),
-                  TO_UTF8( GetPCBDefaultLayerName( aLayer ) ) );
+    addLineItem( true, aStart, aEnd, aWidth, aLayer );
+}
+
+
+void GBR_TO_PCB_EXPORTER::addLineItem( bool aIsCopper, const wxPoint& aStart,
+                                       const wxPoint& aEnd, int aWidth, LAYER_NUM aLayer )
+{
+    PENDING_LINE& line = m_pendingLine;
+
+    if( line.m_valid && line.m_isCopper == aIsCopper && line.m_layer == aLayer
+            && line.m_width == aWidth )
+    {
+        // A dot at an end of the pending line is covered by its round end
+        if( aStart == aEnd && ( aStart == line.m_start || aStart == line.m_end ) )
+            return;
+
+        if( aStart == line.m_end )
+        {
+            int64_t dx1 = line.m_end.x - line.m_start.x;
+            int64_t dy1 = line.m_end.y - line.m_start.y;
+            int64_t dx2 = aEnd.x - aStart.x;
+            int64_t dy2 = aEnd.y - aStart.y;
+
+            // Same direction: the line goes on
+            if( dx1 * dy2 == dy1 * dx2 && dx1 * dx2 + dy1 * dy2 > 0 )
+            {
+                line.m_end = aEnd;
+                return;
+            }
+        }
+    }
+
+    flushLineItem();
+
+    line.m_valid = true;
+    line.m_isCopper = aIsCopper;
+    line.m_start = aStart;
+    line.m_end = aEnd;
+    line.m_width = aWidth;
+    line.m_layer = aLayer;
+}
+
+
+void GBR_TO_PCB_EXPORTER::flushLineItem()
+{
+    PENDING_LINE& line = m_pendingLine;
+
+    if( !line.m_valid )
+        return;
+
+    line.m_valid = false;
+
+    if( line.m_isCopper )
+    {
+        m_out->Print( 0, "(segment (start %s %s) (end %s %s) (width %s) (layer %s) (net 0))\n",
+                      Double2Str( MapToPcbUnits( line.m_start.x ) ).c_str(),
+                      Double2Str( MapToPcbUnits( line.m_start.y ) ).c_str(),
+                      Double2Str( MapToPcbUnits( line.m_end.x ) ).c_str(),
+                      Double2Str( MapToPcbUnits( line.m_end.y ) ).c_str(),
+                      Double2Str( MapToPcbUnits( line.m_width ) ).c_str(),
+                      layerName( line.m_layer ) );
+    }
+    else
+    {
+        writePcbLineItem( false, line.m_start, line.m_end, line.m_width, line.m_layer );
+    }
 }
 
 
@@ -439,14 +581,9 @@ void GBR_TO_PCB_EXPORTER::export_segarc_copper_item( GERBER_DRAW_ITEM* aGbrItem,
  */
 void GBR_TO_PCB_EXPORTER::export_flashed_copper_item( GERBER_DRAW_ITEM* aGbrItem )
 {
-    // First, explore already created vias, before creating a new via
-    for( unsigned ii = 0; ii < m_vias_coordinates.size(); ii++ )
-    {
-        if( m_vias_coordinates[ii] == aGbrItem->m_Start ) // Already created
-            return;
-    }
-
-    m_vias_coordinates.push_back( aGbrItem->m_Start );
+    // Do not create again an already created via
+    if( !m_vias_coordinates.emplace( aGbrItem->m_Start.x, aGbrItem->m_Start.y ).second )
+        return;
 
     wxPoint via_pos = aGbrItem->m_Start;
     int width   = (aGbrItem->m_Size.x + aGbrItem->m_Size.y) / 2;
@@ -454,23 +591,21 @@ void GBR_TO_PCB_EXPORTER::export_flashed_copper_item( GERBER_DRAW_ITEM* aGbrItem
     via_pos.y = -via_pos.y;
 
     // Layers are Front to Back
-    fprintf( m_fp, " (via (at %s %s) (size %s)",
+    m_out->Print( 0, " (via (at %s %s) (size %s)",
                   Double2Str( MapToPcbUnits(via_pos.x) ).c_str(),
                   Double2Str( MapToPcbUnits(via_pos.y) ).c_str(),
                   Double2Str( MapToPcbUnits( width ) ).c_str() );
 
-    fprintf( m_fp, " (layers %s %s))\n",
-                  TO_UTF8( GetPCBDefaultLayerName( F_Cu ) ),
-                  TO_UTF8( GetPCBDefaultLayerName( B_Cu ) ) );
+    m_out->Print( 0, " (layers %s %s))\n", layerName( F_Cu ), layerName( B_Cu ) );
 }
 
 void GBR_TO_PCB_EXPORTER::writePcbHeader( LAYER_NUM* aLayerLookUpTable )
 {
-    fprintf( m_fp, "(kicad_pcb (version 4) (host Gerbview \"%s\")\n\n",
-             TO_UTF8( GetBuildVersion() ) );
+    m_out->Print( 0, "(kicad_pcb (version 4) (host Gerbview \"%s\")\n\n",
+                  TO_UTF8( GetBuildVersion() ) );
 
     // Write layers section
-    fprintf( m_fp, "  (layers \n" );
+    m_out->Print( 0, "  (layers \n" );
 
     for( int ii = 0; ii < m_pcbCopperLayersCount; ii++ )
     {
@@ -479,18 +614,18 @@ void GBR_TO_PCB_EXPORTER::writePcbHeader( LAYER_NUM* aLayerLookUpTable )
         if( ii == m_pcbCopperLayersCount-1)
             id = B_Cu;
 
-        fprintf( m_fp, "    (%d %s signal)\n", id, TO_UTF8( GetPCBDefaultLayerName( id ) ) );
+        m_out->Print( 0, "    (%d %s signal)\n", id, layerName( id ) );
     }
 
     for( int ii = B_Adhes; ii < PCB_LAYER_ID_COUNT; ii++ )
     {
-        if( GetPCBDefaultLayerName( ii ).IsEmpty() )    // Layer not available for export
+        if( m_layerNames[ii].empty() )    // Layer not available for export
             continue;
 
-        fprintf( m_fp, "    (%d %s user)\n", ii, TO_UTF8( GetPCBDefaultLayerName( ii ) ) );
+        m_out->Print( 0, "    (%d %s user)\n", ii, layerName( ii ) );
     }
 
-    fprintf( m_fp, "  )\n\n" );
+    m_out->Print( 0, "  )\n\n" );
 }
 
 
@@ -499,54 +634,79 @@ void GBR_TO_PCB_EXPORTER::writePcbLineItem( bool aIsArc, wxPoint& aStart, wxPoin
 {
     if( aIsArc && ( aAngle == 360.0 ||  aAngle == 0 ) )
     {
-        fprintf( m_fp, "(gr_circle (center %s %s) (end %s %s)(layer %s) (width %s))\n",
+        m_out->Print( 0, "(gr_circle (center %s %s) (end %s %s)(layer %s) (width %s))\n",
                  Double2Str( MapToPcbUnits(aStart.x) ).c_str(),
                  Double2Str( MapToPcbUnits(aStart.y) ).c_str(),
                  Double2Str( MapToPcbUnits(aEnd.x) ).c_str(),
                  Double2Str( MapToPcbUnits(aEnd.y) ).c_str(),
-                 TO_UTF8( GetPCBDefaultLayerName( aLayer ) ),
+                 layerName( aLayer ),
                  Double2Str( MapToPcbUnits( aWidth ) ).c_str()
                  );
     }
     else if( aIsArc )
     {
-        fprintf( m_fp, "(gr_arc (start %s %s) (end %s %s) (angle %s)(layer %s) (width %s))\n",
+        m_out->Print( 0, "(gr_arc (start %s %s) (end %s %s) (angle %s)(layer %s) (width %s))\n",
                  Double2Str( MapToPcbUnits(aStart.x) ).c_str(),
                  Double2Str( MapToPcbUnits(aStart.y) ).c_str(),
                  Double2Str( MapToPcbUnits(aEnd.x) ).c_str(),
                  Double2Str( MapToPcbUnits(aEnd.y) ).c_str(),
                  Double2Str( aAngle ).c_str(),
-                 TO_UTF8( GetPCBDefaultLayerName( aLayer ) ),
+                 layerName( aLayer ),
                  Double2Str( MapToPcbUnits( aWidth ) ).c_str()
                  );
     }
     else
     {
-        fprintf( m_fp, "(gr_line (start %s %s) (end %s %s)(layer %s) (width %s))\n",
+        m_out->Print( 0, "(gr_line (start %s %s) (end %s %s)(layer %s) (width %s))\n",
                  Double2Str( MapToPcbUnits(aStart.x) ).c_str(),
                  Double2Str( MapToPcbUnits(aStart.y) ).c_str(),
                  Double2Str( MapToPcbUnits(aEnd.x) ).c_str(),
                  Double2Str( MapToPcbUnits(aEnd.y) ).c_str(),
-                 TO_UTF8( GetPCBDefaultLayerName( aLayer ) ),
+                 layerName( aLayer ),
                  Double2Str( MapToPcbUnits( aWidth ) ).c_str()
                  );
     }
 }
 
 
-void GBR_TO_PCB_EXPORTER::writePcbPolygonItem( GERBER_DRAW_ITEM* aGbrItem, LAYER_NUM aLayer )
+void GBR_TO_PCB_EXPORTER::addPcbPolygonItem( GERBER_DRAW_ITEM* aGbrItem, LAYER_NUM aLayer )
 {
-    fprintf( m_fp, "(gr_poly (pts " );
+    if( aGbrItem->m_Polygon.OutlineCount() == 0 )
+        return;
+
+    m_regions[aLayer].AddOutline( aGbrItem->m_Polygon.COutline( 0 ) );
+}
 
-    SHAPE_POLY_SET polys = aGbrItem->m_Polygon;
-    SHAPE_LINE_CHAIN& poly = polys.Outline( 0 );
+
+void GBR_TO_PCB_EXPORTER::writePcbRegions()
+{
+    for( auto& region : m_regions )
+    {
+        SHAPE_POLY_SET& polys = region.second;
+
+        // Adjacent and overlapping regions (e.g. the pieces of a copper pour) give one
+        // polygon.  Board polygons have no holes: they are linked to their outline.
+        polys.Simplify( SHAPE_POLY_SET::PM_FAST );
+        polys.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+        for( int ii = 0; ii < polys.OutlineCount(); ii++ )
+            writePcbPolygon( polys.COutline( ii ), region.first );
+    }
+
+    m_regions.clear();
+}
+
+
+void GBR_TO_PCB_EXPORTER::writePcbPolygon( const SHAPE_LINE_CHAIN& aPoly, LAYER_NUM aLayer )
+{
+    m_out->Print( 0, "(gr_poly (pts " );
 
     #define MAX_COORD_CNT 4
     int jj = MAX_COORD_CNT;
-    int cnt_max = poly.PointCount() -1;
+    int cnt_max = aPoly.PointCount() -1;
 
     // Do not generate last corner, if it is the same point as the first point:
-    if( poly.Point( 0 ) == poly.Point( cnt_max ) )
+    if( aPoly.CPoint( 0 ) == aPoly.CPoint( cnt_max ) )
         cnt_max--;
 
     for( int ii = 0; ii <= cnt_max; ii++ )
@@ -554,19 +714,18 @@ void GBR_TO_PCB_EXPORTER::writePcbPolygonItem( GERBER_DRAW_ITEM* aGbrItem, LAYER
         if( --jj == 0 )
         {
             jj = MAX_COORD_CNT;
-            fprintf( m_fp, "\n" );
+            m_out->Print( 0, "\n" );
         }
 
-        fprintf( m_fp, " (xy %s %s)",
-                 Double2Str( MapToPcbUnits( poly.Point( ii ).x ) ).c_str(),
-                 Double2Str( MapToPcbUnits( -poly.Point( ii ).y ) ).c_str() );
+        m_out->Print( 0, " (xy %s %s)",
+                      Double2Str( MapToPcbUnits( aPoly.CPoint( ii ).x ) ).c_str(),
+                      Double2Str( MapToPcbUnits( -aPoly.CPoint( ii ).y ) ).c_str() );
     }
 
-    fprintf( m_fp, ")" );
+    m_out->Print( 0, ")" );
 
     if( jj != MAX_COORD_CNT )
-        fprintf( m_fp, "\n" );
+        m_out->Print( 0, "\n" );
 
-    fprintf( m_fp, "(layer %s) (width 0) )\n",
-             TO_UTF8( GetPCBDefaultLayerName( aLayer ) ) );
+    m_out->Print( 0, "(layer %s) (width 0) )\n", layerName( aLayer ) );
 }
@@ -37,6 +37,10 @@
 #include <gerbview_layer_widget.h>
 #include <wildcards_and_files_ext.h>
 #include <widgets/progress_reporter.h>
+#include <thread_pool.h>
+#include <view/view.h>
+
+#include <atomic>
 
 // HTML Messages used more than one time:
 #define MSG_NO_MORE_LAYER\
@@ -254,6 +258,17 @@ bool GERBVIEW_FRAME::LoadGerberFiles( const wxString& aFullFileName )
 }
 
 
+/**
+ * A Gerber or drill file loaded by loadListOfGerberAndDrillFiles()
+ */
+struct GERBER_FILE_LOAD_JOB
+{
+    wxString           m_FileName;
+    bool               m_IsDrill;   ///< true for a NC drill file
+    GERBER_FILE_IMAGE* m_Image;     ///< the loaded image, NULL if the file cannot be read
+};
+
+
 bool GERBVIEW_FRAME::loadListOfGerberAndDrillFiles( const wxString& aPath,
                                             const wxArrayString& aFilenameList,
                                             const std::vector<int>* aFileType )
@@ -269,11 +284,7 @@ bool GERBVIEW_FRAME::loadListOfGerberAndDrillFiles( const wxString& aPath,
     wxString msg;
     WX_STRING_REPORTER reporter( &msg );
 
-    // Show progress dialog after 1 second of loading
-    static const long long progressShowDelay = 1000;
-
-    auto startTime = wxGetUTCTimeMillis();
-    std::unique_ptr<WX_PROGRESS_REPORTER> progress = nullptr;
+    std::vector<GERBER_FILE_LOAD_JOB> jobs;
 
     for( unsigned ii = 0; ii < aFilenameList.GetCount(); ii++ )
     {
@@ -294,62 +305,159 @@ bool GERBVIEW_FRAME::loadListOfGerberAndDrillFiles( const wxString& aPath,
             continue;
         }
 
-        if( !progress && wxGetUTCTimeMillis() - startTime > progressShowDelay )
-        {
-            progress = std::make_unique<WX_PROGRESS_REPORTER>( this,
-                            _( "Loading Gerber files..." ), 1, false );
-            progress->SetMaxProgress( aFilenameList.GetCount() - 1 );
-            progress->Report( _("Loading Gerber files..." ) );
-        }
-        else if( progress )
+        GERBER_FILE_LOAD_JOB job;
+        job.m_FileName = filename.GetFullPath();
+        job.m_IsDrill = aFileType && (*aFileType)[ii] == 1;
+        job.m_Image = NULL;
+        jobs.push_back( job );
+    }
+
+    // The files are independent, so they are read at once, each one in its own image.
+    // The images are put on their layers afterwards, in the order of the list.
+    // Show progress dialog after 1 second of loading
+    static const long long progressShowDelay = 1000;
+
+    auto startTime = wxGetUTCTimeMillis();
+    std::unique_ptr<WX_PROGRESS_REPORTER> progress = nullptr;
+    std::atomic<int> loadedCount( 0 );
+    int shownCount = 0;
+
+    {
+        LOCALE_IO toggleIo;     // Switched once for all the threads
+
+        THREAD_POOL::GetPool().ParallelFor( jobs.size(),
+                [&]( size_t aIndex )
+                {
+                    GERBER_FILE_LOAD_JOB& job = jobs[aIndex];
+                    bool                  ok;
+
+                    // The layer is set when the image is put in the list
+                    if( job.m_IsDrill )
+                    {
+                        EXCELLON_IMAGE* drill = new EXCELLON_IMAGE( 0 );
+                        job.m_Image = drill;
+                        ok = drill->LoadFile( job.m_FileName );
+                    }
+                    else
+                    {
+                        job.m_Image = new GERBER_FILE_IMAGE( 0 );
+                        ok = job.m_Image->LoadGerberFile( job.m_FileName );
+                    }
+
+                    if( !ok )
+                    {
+                        delete job.m_Image;
+                        job.m_Image = NULL;
+                    }
+
+                    ++loadedCount;
+                },
+                1, 0,
+                [&]()
+                {
+                    if( !progress && wxGetUTCTimeMillis() - startTime > progressShowDelay )
+                    {
+                        progress = std::make_unique<WX_PROGRESS_REPORTER>( this,
+                                        _( "Loading Gerber files..." ), 1, false );
+                        progress->SetMaxProgress( jobs.size() );
+                        progress->Report( _("Loading Gerber files..." ) );
+                    }
+
+                    if( !progress )
+                        return;
+
+                    for( ; shownCount < loadedCount; ++shownCount )
+                        progress->AdvanceProgress();
+
+                    progress->KeepRefreshing();
+                } );
+    }
+
+    progress.reset();
+
+    for( unsigned ii = 0; ii < jobs.size(); ii++ )
+    {
+        GERBER_FILE_LOAD_JOB& job = jobs[ii];
+        GERBER_FILE_IMAGE*    image = job.m_Image;
+
+        if( !image )
         {
-            progress->KeepRefreshing();
+            wxString error;
+            error << "<b>" << _( "Unable to read file:" ) << "</b><br>"
+                  << job.m_FileName << "<br>";
+            reporter.Report( error, REPORTER::RPT_ERROR );
+            success = false;
+            continue;
         }
 
-        m_lastFileName = filename.GetFullPath();
+        m_lastFileName = job.m_FileName;
 
         SetActiveLayer( layer, false );
 
+        // If the layer contains old gerber or nc drill data, remove it
+        if( GetGbrImage( layer ) )
+            Erase_Current_DrawLayer( false );
+
+        image->m_GraphicLayer = layer;
+        GetImagesList()->AddGbrImage( image, layer );
+
         visibility[ layer ] = true;
 
-        if( aFileType && (*aFileType)[ii] == 1 )
+        if( job.m_IsDrill )
+            UpdateFileHistory( m_lastFileName, &m_drillFileHistory );
+        else
+            UpdateFileHistory( m_lastFileName );
+
+        // Display errors list
+        if( image->GetMessages().size() > 0 )
         {
-            LoadExcellonFiles( filename.GetFullPath() );
-            layer = GetActiveLayer();   // Loading NC drill file changes the active layer
+            reporter.Report( wxString::Format( "<b>%s</b><br>", m_lastFileName ),
+                             REPORTER::RPT_WARNING );
+
+            for( const wxString& message : image->GetMessages() )
+                reporter.Report( message + "<br>", REPORTER::RPT_WARNING );
         }
-        else
+
+        /* if the gerber file is only a RS274D file
+         * (i.e. without any aperture information, but with items), warn the user:
+         */
+        if( !job.m_IsDrill && !image->m_Has_DCode && !image->GetItems().IsEmpty() )
         {
-            if( Read_GERBER_File( filename.GetFullPath() ) )
-            {
-                UpdateFileHistory( m_lastFileName );
+            wxString warning;
+            warning << "<b>" << m_lastFileName << "</b><br>"
+                    << _( "Warning: this file has no D-Code definition.  It is perhaps an "
+                          "old RS274D file.  Therefore the size of items is undefined." )
+                    << "<br>";
+            reporter.Report( warning, REPORTER::RPT_WARNING );
+        }
 
-                layer = getNextAvailableLayer( layer );
+        if( GetCanvas() )
+        {
+            for( GERBER_DRAW_ITEM* item : image->GetItems() )
+                GetCanvas()->GetView()->Add( (KIGFX::VIEW_ITEM*) item );
+        }
 
-                if( layer == NO_AVAILABLE_LAYERS && ii < aFilenameList.GetCount()-1 )
-                {
-                    success = false;
-                    reporter.Report( MSG_NO_MORE_LAYER, REPORTER::RPT_ERROR );
+        layer = getNextAvailableLayer( layer );
 
-                    // Report the name of not loaded files:
-                    ii += 1;
-                    while( ii < aFilenameList.GetCount() )
-                    {
-                        filename = aFilenameList[ii++];
-                        wxString txt = wxString::Format( MSG_NOT_LOADED, filename.GetFullName() );
-                        reporter.Report( txt, REPORTER::RPT_ERROR );
-                    }
-                    break;
-                }
+        if( layer == NO_AVAILABLE_LAYERS && ii < jobs.size() - 1 )
+        {
+            success = false;
+            reporter.Report( MSG_NO_MORE_LAYER, REPORTER::RPT_ERROR );
 
-                SetActiveLayer( layer, false );
+            // Report the name of not loaded files:
+            while( ++ii < jobs.size() )
+            {
+                filename = jobs[ii].m_FileName;
+                wxString txt = wxString::Format( MSG_NOT_LOADED, filename.GetFullName() );
+                reporter.Report( txt, REPORTER::RPT_ERROR );
+                delete jobs[ii].m_Image;
             }
-        }
 
-        if( progress )
-            progress->AdvanceProgress();
+            break;
+        }
     }
 
-    if( !success )
+    if( !msg.IsEmpty() )
     {
         wxSafeYield();  // Allows slice of time to redraw the screen
                         // to refresh widgets, before displaying messages
@@ -375,6 +483,8 @@ bool GERBVIEW_FRAME::loadListOfGerberAndDrillFiles( const wxString& aPath,
     m_LayersManager->UpdateLayerIcons();
     syncLayerBox( true );
 
+    StartCompositeShapes();
+
     GetCanvas()->Refresh();
 
     return success;
@@ -421,67 +531,12 @@ bool GERBVIEW_FRAME::LoadExcellonFiles( const wxString& aFullFileName )
     }
 
     // Read Excellon drill files: each file is loaded on a new GerbView layer
-    bool success = true;
-    int layer = GetActiveLayer();
-
-    // Manage errors when loading files
-    wxString msg;
-    WX_STRING_REPORTER reporter( &msg );
-
-    for( unsigned ii = 0; ii < filenamesList.GetCount(); ii++ )
-    {
-        filename = filenamesList[ii];
+    std::vector<int> fileTypes( filenamesList.GetCount(), 1 );
 
-        if( !filename.IsAbsolute() )
-            filename.SetPath( currentPath );
-
-        m_lastFileName = filename.GetFullPath();
-
-        SetActiveLayer( layer, false );
-
-        if( Read_EXCELLON_File( filename.GetFullPath() ) )
-        {
-            // Update the list of recent drill files.
-            UpdateFileHistory( filename.GetFullPath(), &m_drillFileHistory );
-
-            layer = getNextAvailableLayer( layer );
-
-            if( layer == NO_AVAILABLE_LAYERS && ii < filenamesList.GetCount()-1 )
-            {
-                success = false;
-                reporter.Report( MSG_NO_MORE_LAYER, REPORTER::RPT_ERROR );
-
-                // Report the name of not loaded files:
-                ii += 1;
-                while( ii < filenamesList.GetCount() )
-                {
-                    filename = filenamesList[ii++];
-                    wxString txt = wxString::Format( MSG_NOT_LOADED, filename.GetFullName() );
-                    reporter.Report( txt, REPORTER::RPT_ERROR );
-                }
-                break;
-            }
-
-            SetActiveLayer( layer, false );
-        }
-    }
-
-    if( !success )
-    {
-        HTML_MESSAGE_BOX mbox( this, _( "Errors" ) );
-        mbox.ListSet( msg );
-        mbox.ShowModal();
-    }
-
-    Zoom_Automatique( false );
-
-    // Synchronize layers tools with actual active layer:
-    ReFillLayerWidget();
-    SetActiveLayer( GetActiveLayer() );
-    m_LayersManager->UpdateLayerIcons();
-    syncLayerBox();
+    // Set the busy cursor
+    wxBusyCursor wait;
 
-    return success;
+    return loadListOfGerberAndDrillFiles( currentPath, filenamesList, &fileTypes );
 }
 
 
@@ -623,8 +678,13 @@ bool GERBVIEW_FRAME::unarchiveFiles( const wxString& aFullFileName, REPORTER* aR
             GERBER_FILE_IMAGE* gerber_image = GetGbrImage( layer );
 
             if( gerber_image )
+            {
                 gerber_image->m_FileName = fname;
 
+                // The temporary file is deleted: the image cannot be read again
+                gerber_image->m_FileTime = wxDateTime();
+            }
+
             layer = getNextAvailableLayer( layer );
             SetActiveLayer( layer, false );
         }
@@ -59,7 +59,7 @@ EDA_RECT GBR_LAYOUT::ComputeBoundingBox() const
         if( gerber == NULL )    // Graphic layer not yet used
             continue;
 
-        for( GERBER_DRAW_ITEM* item = gerber->GetItemsList(); item; item = item->Next() )
+        for( GERBER_DRAW_ITEM* item : gerber->GetItems() )
         {
             if( first_item )
             {
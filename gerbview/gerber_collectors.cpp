@@ -19,6 +19,11 @@
 
 #include "gerber_collectors.h"
 
+#include <gerber_draw_item.h>
+#include <view/view.h>
+
+#include <algorithm>
+
 const KICAD_T GERBER_COLLECTOR::AllItems[] = {
     GERBER_IMAGE_LIST_T,
     GERBER_IMAGE_T,
@@ -67,3 +72,51 @@ void GERBER_COLLECTOR::Collect( EDA_ITEM* aItem, const KICAD_T aScanList[],
     // record the length of the primary list before concatenating on to it.
     m_PrimaryLength = m_List.size();
 }
+
+
+void GERBER_COLLECTOR::Collect( const KIGFX::VIEW* aView, const wxPoint& aRefPos )
+{
+    Empty();        // empty the collection, primary criteria list
+
+    SetRefPos( aRefPos );
+
+    // The items whose bounding box is near aRefPos are the only ones which can be hit
+    BOX2I box( VECTOR2I( aRefPos ), VECTOR2I( 0, 0 ) );
+    box.Inflate( GERBER_DRAW_ITEM::MIN_HIT_TEST_RADIUS );
+
+    std::vector<KIGFX::VIEW::LAYER_ITEM_PAIR> candidates;
+    std::vector<GERBER_DRAW_ITEM*>            items;
+
+    aView->Query( box, candidates );
+
+    for( const KIGFX::VIEW::LAYER_ITEM_PAIR& candidate : candidates )
+    {
+        GERBER_DRAW_ITEM* item = dynamic_cast<GERBER_DRAW_ITEM*>( candidate.first );
+
+        if( item )
+            items.push_back( item );
+    }
+
+    // An item is found twice when its D-Code layer is visible
+    std::sort( items.begin(), items.end(),
+               []( const GERBER_DRAW_ITEM* aA, const GERBER_DRAW_ITEM* aB )
+               {
+                   if( aA->GetLayer() != aB->GetLayer() )
+                       return aA->GetLayer() < aB->GetLayer();
+
+                   return aA < aB;
+               } );
+
+    items.erase( std::unique( items.begin(), items.end() ), items.end() );
+
+    for( GERBER_DRAW_ITEM* item : items )
+    {
+        if( item->HitTest( aRefPos ) )
+            Append( item );
+    }
+
+    SetTimeNow();               // when snapshot was taken
+
+    // record the length of the primary list before concatenating on to it.
+    m_PrimaryLength = m_List.size();
+}
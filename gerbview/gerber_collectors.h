@@ -22,6 +22,11 @@
 
 #include <collector.h>
 
+namespace KIGFX
+{
+    class VIEW;
+}
+
 /**
  * Class GERBER_COLLECTOR
  * is intended for use when the right click button is pressed, or when the
@@ -129,6 +134,17 @@ public:
      */
     void Collect( EDA_ITEM* aItem, const KICAD_T aScanList[],
                  const wxPoint& aRefPos/*, const COLLECTORS_GUIDE& aGuide */);
+
+    /**
+     * Function Collect
+     * collects the GERBER_DRAW_ITEMs of the visible layers of aView hit by aRefPos.
+     * Only the items found near aRefPos in the R-tree of aView are hit tested, instead
+     * of all the items of all the images.
+     * The items are sorted by graphic layer, like the items collected by a scan.
+     * @param aView The VIEW which shows the gerber items
+     * @param aRefPos A wxPoint to use in hit-testing.
+     */
+    void Collect( const KIGFX::VIEW* aView, const wxPoint& aRefPos );
 };
 
 #endif
@@ -0,0 +1,532 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file gerber_compare.cpp
+ */
+
+#include <fctsys.h>
+#include <gerber_compare.h>
+#include <gerber_file_image.h>
+#include <thread_pool.h>
+#include <widgets/progress_reporter.h>
+#include <gal/graphics_abstraction_layer.h>
+#include <view/view.h>
+
+#include <algorithm>
+#include <cmath>
+
+
+// The tiles are squares of TILE_SIZE pixels: two masks of a tile hold in the cache
+#define TILE_SIZE 256
+
+
+GERBER_IMAGE_COMPARE::GERBER_IMAGE_COMPARE( int aPixelSize ) :
+    m_pixelSize( std::max( aPixelSize, 1 ) ),
+    m_differentPixels( 0 ),
+    m_cancelled( false )
+{
+}
+
+
+double GERBER_IMAGE_COMPARE::GetPixelCount( GERBER_FILE_IMAGE* aReference,
+                                            GERBER_FILE_IMAGE* aCompared ) const
+{
+    BOX2I area;
+    bool  empty = true;
+
+    for( GERBER_FILE_IMAGE* image : { aReference, aCompared } )
+    {
+        for( GERBER_DRAW_ITEM* item : image->GetItems() )
+        {
+            if( empty )
+                area = item->ViewBBox();
+            else
+                area.Merge( item->ViewBBox() );
+
+            empty = false;
+        }
+    }
+
+    if( empty )
+        return 0.0;
+
+    return ( double( area.GetWidth() ) / m_pixelSize + 3 )
+           * ( double( area.GetHeight() ) / m_pixelSize + 3 );
+}
+
+
+bool GERBER_IMAGE_COMPARE::runParallel( size_t aCount,
+                                        const std::function<void( size_t )>& aWork,
+                                        PROGRESS_REPORTER* aProgress )
+{
+    if( aProgress )
+        aProgress->SetMaxProgress( aCount );
+
+    THREAD_POOL::GetPool().ParallelFor( aCount,
+            [&]( size_t aIndex )
+            {
+                if( m_cancelled )
+                    return;
+
+                aWork( aIndex );
+
+                if( aProgress )
+                    aProgress->AdvanceProgress();
+            },
+            0, 0,
+            [&]()
+            {
+                if( aProgress && !aProgress->KeepRefreshing() )
+                    m_cancelled = true;
+            } );
+
+    return !m_cancelled;
+}
+
+
+bool GERBER_IMAGE_COMPARE::convertItems( GERBER_FILE_IMAGE* aImage,
+                                         std::vector<RASTER_ITEM>& aItems,
+                                         PROGRESS_REPORTER* aProgress )
+{
+    std::vector<GERBER_DRAW_ITEM*> drawItems;
+
+    drawItems.reserve( aImage->GetItems().GetCount() );
+
+    for( GERBER_DRAW_ITEM* item : aImage->GetItems() )
+        drawItems.push_back( item );
+
+    // TransformItemToPolygon() only reads the items once their shapes are prepared
+    aImage->PrepareItemShapes();
+    aItems.resize( drawItems.size() );
+
+    return runParallel( drawItems.size(),
+            [&]( size_t aIndex )
+            {
+                RASTER_ITEM& item = aItems[aIndex];
+
+                GERBER_FILE_IMAGE::TransformItemToPolygon( drawItems[aIndex], item.m_Shape );
+                item.m_BBox = item.m_Shape.BBox();
+                item.m_Clear = drawItems[aIndex]->HasNegativeItems();
+            },
+            aProgress );
+}
+
+
+void GERBER_IMAGE_COMPARE::rasterizePolygon( const SHAPE_POLY_SET::POLYGON& aPolygon,
+                                             const BOX2I& aTile, unsigned char aValue,
+                                             std::vector<unsigned char>& aMask ) const
+{
+    struct EDGE
+    {
+        double m_yMin, m_yMax;
+        double m_x;         ///< x at m_yMin
+        double m_slope;     ///< dx / dy
+    };
+
+    std::vector<EDGE> edges;
+    double            yMin = HUGE_VAL;
+    double            yMax = -HUGE_VAL;
+
+    // Pixel coordinates, the pixel centers being at integer + 0.5
+    auto toPixelX = [&]( int aX ) { return double( aX - m_origin.x ) / m_pixelSize; };
+    auto toPixelY = [&]( int aY ) { return double( aY - m_origin.y ) / m_pixelSize; };
+
+    for( const SHAPE_LINE_CHAIN& chain : aPolygon )
+    {
+        int count = chain.PointCount();
+
+        for( int ii = 0; ii < count; ii++ )
+        {
+            const VECTOR2I& a = chain.CPoint( ii );
+            const VECTOR2I& b = chain.CPoint( ( ii + 1 ) % count );
+
+            if( a.y == b.y )
+                continue;
+
+            const VECTOR2I& low = a.y < b.y ? a : b;
+            const VECTOR2I& high = a.y < b.y ? b : a;
+            EDGE            edge;
+
+            edge.m_yMin = toPixelY( low.y );
+            edge.m_yMax = toPixelY( high.y );
+            edge.m_x = toPixelX( low.x );
+            edge.m_slope = double( high.x - low.x ) / ( high.y - low.y );
+            edges.push_back( edge );
+
+            yMin = std::min( yMin, edge.m_yMin );
+            yMax = std::max( yMax, edge.m_yMax );
+        }
+    }
+
+    if( edges.empty() )
+        return;
+
+    // The rows whose center is inside the polygon, clipped to the tile
+    int rowStart = std::max( (int) std::ceil( yMin - 0.5 ), aTile.GetY() );
+    int rowEnd = std::min( (int) std::ceil( yMax - 0.5 ), aTile.GetBottom() );
+
+    std::vector<double> crossings;
+
+    for( int row = rowStart; row < rowEnd; row++ )
+    {
+        double y = row + 0.5;
+
+        crossings.clear();
+
+        for( const EDGE& edge : edges )
+        {
+            if( y >= edge.m_yMin && y < edge.m_yMax )
+                crossings.push_back( edge.m_x + ( y - edge.m_yMin ) * edge.m_slope );
+        }
+
+        std::sort( crossings.begin(), crossings.end() );
+
+        unsigned char* line = aMask.data() + size_t( row - aTile.GetY() ) * aTile.GetWidth();
+
+        // Even-odd rule: the holes of the polygon are outside
+        for( size_t ii = 1; ii < crossings.size(); ii += 2 )
+        {
+            int colStart = std::max( (int) std::ceil( crossings[ii - 1] - 0.5 ), aTile.GetX() );
+            int colEnd = std::min( (int) std::ceil( crossings[ii] - 0.5 ), aTile.GetRight() );
+
+            for( int col = colStart; col < colEnd; col++ )
+                line[col - aTile.GetX()] = aValue;
+        }
+    }
+}
+
+
+void GERBER_IMAGE_COMPARE::rasterize( const std::vector<RASTER_ITEM>& aItems,
+                                      const std::vector<int>& aIndices, const BOX2I& aTile,
+                                      std::vector<unsigned char>& aMask ) const
+{
+    for( int index : aIndices )
+    {
+        const RASTER_ITEM& item = aItems[index];
+
+        // The polygons of an item can overlap: each one is painted by itself
+        for( int ii = 0; ii < item.m_Shape.OutlineCount(); ii++ )
+            rasterizePolygon( item.m_Shape.CPolygon( ii ), aTile, item.m_Clear ? 0 : 1, aMask );
+    }
+}
+
+
+void GERBER_IMAGE_COMPARE::buildArea( const std::vector<BOX2I>& aRects,
+                                      SHAPE_POLY_SET& aArea ) const
+{
+    aArea.RemoveAllContours();
+
+    for( const BOX2I& rect : aRects )
+    {
+        VECTOR2I start = m_origin + rect.GetPosition() * m_pixelSize;
+        VECTOR2I end = m_origin + rect.GetEnd() * m_pixelSize;
+
+        aArea.NewOutline();
+        aArea.Append( start.x, start.y );
+        aArea.Append( end.x, start.y );
+        aArea.Append( end.x, end.y );
+        aArea.Append( start.x, end.y );
+    }
+
+    // Merge the rectangles of the pixels in regions
+    aArea.Simplify( SHAPE_POLY_SET::PM_FAST );
+}
+
+
+bool GERBER_IMAGE_COMPARE::Compare( GERBER_FILE_IMAGE* aReference,
+                                    GERBER_FILE_IMAGE* aCompared,
+                                    PROGRESS_REPORTER* aProgress )
+{
+    std::vector<RASTER_ITEM> items[2];
+    GERBER_FILE_IMAGE*       images[2] = { aReference, aCompared };
+
+    m_removed.RemoveAllContours();
+    m_added.RemoveAllContours();
+    m_differentPixels = 0;
+    m_cancelled = false;
+
+    for( int ii = 0; ii < 2; ii++ )
+    {
+        if( aProgress )
+        {
+            aProgress->BeginPhase( ii );
+            aProgress->Report( ii == 0 ? _( "Converting reference items..." )
+                                       : _( "Converting compared items..." ) );
+        }
+
+        if( !convertItems( images[ii], items[ii], aProgress ) )
+            return false;
+    }
+
+    // The grid covers both images, with a margin of one pixel
+    BOX2I area;
+    bool  empty = true;
+
+    for( const std::vector<RASTER_ITEM>& list : items )
+    {
+        for( const RASTER_ITEM& item : list )
+        {
+            if( item.m_Shape.OutlineCount() == 0 )
+                continue;
+
+            if( empty )
+                area = item.m_BBox;
+            else
+                area.Merge( item.m_BBox );
+
+            empty = false;
+        }
+    }
+
+    if( empty )
+        return true;
+
+    m_origin = area.GetPosition() - VECTOR2I( m_pixelSize, m_pixelSize );
+
+    int cols = area.GetWidth() / m_pixelSize + 3;
+    int rows = area.GetHeight() / m_pixelSize + 3;
+    int tileCols = ( cols + TILE_SIZE - 1 ) / TILE_SIZE;
+    int tileRows = ( rows + TILE_SIZE - 1 ) / TILE_SIZE;
+
+    // The items overlapping each tile, in the file order
+    std::vector<std::vector<int>> bins[2];
+
+    for( int ii = 0; ii < 2; ii++ )
+    {
+        bins[ii].resize( size_t( tileCols ) * tileRows );
+
+        for( size_t index = 0; index < items[ii].size(); index++ )
+        {
+            const BOX2I& bbox = items[ii][index].m_BBox;
+
+            if( items[ii][index].m_Shape.OutlineCount() == 0 )
+                continue;
+
+            int colStart = ( bbox.GetX() - m_origin.x ) / m_pixelSize / TILE_SIZE;
+            int colEnd = ( bbox.GetRight() - m_origin.x ) / m_pixelSize / TILE_SIZE;
+            int rowStart = ( bbox.GetY() - m_origin.y ) / m_pixelSize / TILE_SIZE;
+            int rowEnd = ( bbox.GetBottom() - m_origin.y ) / m_pixelSize / TILE_SIZE;
+
+            for( int row = rowStart; row <= rowEnd && row < tileRows; row++ )
+            {
+                for( int col = colStart; col <= colEnd && col < tileCols; col++ )
+                    bins[ii][size_t( row ) * tileCols + col].push_back( index );
+            }
+        }
+    }
+
+    if( aProgress )
+    {
+        aProgress->BeginPhase( 2 );
+        aProgress->Report( _( "Comparing..." ) );
+    }
+
+    std::vector<TILE_RESULT> results( size_t( tileCols ) * tileRows );
+
+    bool ok = runParallel( results.size(),
+            [&]( size_t aIndex )
+            {
+                BOX2I tile( VECTOR2I( int( aIndex % tileCols ) * TILE_SIZE,
+                                      int( aIndex / tileCols ) * TILE_SIZE ),
+                            VECTOR2I( TILE_SIZE, TILE_SIZE ) );
+                tile.SetSize( std::min( TILE_SIZE, cols - tile.GetX() ),
+                              std::min( TILE_SIZE, rows - tile.GetY() ) );
+
+                TILE_RESULT& result = results[aIndex];
+                std::vector<unsigned char> masks[2];
+
+                result.m_Count = 0;
+
+                for( int ii = 0; ii < 2; ii++ )
+                {
+                    // The background of a negative image is dark
+                    masks[ii].assign( size_t( tile.GetWidth() ) * tile.GetHeight(),
+                                      images[ii]->m_ImageNegative ? 1 : 0 );
+                    rasterize( items[ii], bins[ii][aIndex], tile, masks[ii] );
+                }
+
+                // The runs of different pixels are merged with the same runs of the previous
+                // row, making rectangles.  A run is (first column, end column, first row).
+                struct RUN { int m_start, m_end, m_row; };
+
+                std::vector<RUN> open[2], next[2];
+
+                auto closeRun = [&]( int aType, const RUN& aRun, int aEndRow )
+                {
+                    BOX2I rect( VECTOR2I( tile.GetX() + aRun.m_start,
+                                          tile.GetY() + aRun.m_row ),
+                                VECTOR2I( aRun.m_end - aRun.m_start, aEndRow - aRun.m_row ) );
+
+                    ( aType == 0 ? result.m_Removed : result.m_Added ).push_back( rect );
+                };
+
+                for( int row = 0; row <= tile.GetHeight(); row++ )
+                {
+                    for( int type = 0; type < 2; type++ )
+                        next[type].clear();
+
+                    if( row < tile.GetHeight() )
+                    {
+                        size_t               offset = size_t( row ) * tile.GetWidth();
+                        const unsigned char* ref = masks[0].data() + offset;
+                        const unsigned char* cmp = masks[1].data() + offset;
+
+                        for( int col = 0; col < tile.GetWidth(); )
+                        {
+                            if( ref[col] == cmp[col] )
+                            {
+                                col++;
+                                continue;
+                            }
+
+                            // Type 0: removed (dark in the reference only), 1: added
+                            int type = ref[col] ? 0 : 1;
+                            int start = col;
+
+                            while( col < tile.GetWidth() && ref[col] != cmp[col]
+                                    && ( ref[col] ? 0 : 1 ) == type )
+                            {
+                                col++;
+                            }
+
+                            result.m_Count += col - start;
+                            next[type].push_back( { start, col, row } );
+                        }
+                    }
+
+                    // Both lists are sorted by column
+                    for( int type = 0; type < 2; type++ )
+                    {
+                        size_t jj = 0;
+
+                        for( RUN& run : next[type] )
+                        {
+                            while( jj < open[type].size()
+                                    && open[type][jj].m_start < run.m_start )
+                            {
+                                closeRun( type, open[type][jj++], row );
+                            }
+
+                            if( jj < open[type].size() && open[type][jj].m_start == run.m_start
+                                    && open[type][jj].m_end == run.m_end )
+                            {
+                                run.m_row = open[type][jj++].m_row;
+                            }
+                        }
+
+                        while( jj < open[type].size() )
+                            closeRun( type, open[type][jj++], row );
+
+                        open[type].swap( next[type] );
+                    }
+                }
+            },
+            aProgress );
+
+    if( !ok )
+        return false;
+
+    std::vector<BOX2I> removed, added;
+
+    for( const TILE_RESULT& result : results )
+    {
+        removed.insert( removed.end(), result.m_Removed.begin(), result.m_Removed.end() );
+        added.insert( added.end(), result.m_Added.begin(), result.m_Added.end() );
+        m_differentPixels += result.m_Count;
+    }
+
+    buildArea( removed, m_removed );
+    buildArea( added, m_added );
+
+    return true;
+}
+
+
+GERBER_COMPARE_ITEM::GERBER_COMPARE_ITEM( const GERBER_IMAGE_COMPARE& aCompare ) :
+    EDA_ITEM( NOT_USED ),    // Never added to anything - just shown
+    m_removed( aCompare.GetRemovedArea() ),
+    m_added( aCompare.GetAddedArea() ),
+    m_removedFill( aCompare.GetRemovedArea() ),
+    m_addedFill( aCompare.GetAddedArea() )
+{
+    for( SHAPE_POLY_SET* fill : { &m_removedFill, &m_addedFill } )
+    {
+        fill->Fracture( SHAPE_POLY_SET::PM_FAST );
+        fill->CacheTriangulation();
+    }
+}
+
+
+const BOX2I GERBER_COMPARE_ITEM::ViewBBox() const
+{
+    if( m_removed.OutlineCount() == 0 )
+        return m_added.BBox();
+
+    BOX2I bbox = m_removed.BBox();
+
+    if( m_added.OutlineCount() )
+        bbox.Merge( m_added.BBox() );
+
+    return bbox;
+}
+
+
+void GERBER_COMPARE_ITEM::ViewGetLayers( int aLayers[], int& aCount ) const
+{
+    aLayers[0] = LAYER_GP_OVERLAY;
+    aCount = 1;
+}
+
+
+void GERBER_COMPARE_ITEM::drawArea( KIGFX::GAL* aGal, const SHAPE_POLY_SET& aOutlines,
+                                    const SHAPE_POLY_SET& aFill, const COLOR4D& aColor ) const
+{
+    aGal->SetIsFill( true );
+    aGal->SetIsStroke( false );
+    aGal->SetFillColor( aColor.WithAlpha( 0.4 ) );
+    aGal->DrawPolygon( aFill );
+
+    // A constant width on screen
+    aGal->SetIsFill( false );
+    aGal->SetIsStroke( true );
+    aGal->SetStrokeColor( aColor );
+    aGal->SetLineWidth( 2.0 / aGal->GetWorldScale() );
+
+    for( int ii = 0; ii < aOutlines.OutlineCount(); ii++ )
+    {
+        aGal->DrawPolyline( aOutlines.COutline( ii ) );
+
+        for( int jj = 0; jj < aOutlines.HoleCount( ii ); jj++ )
+            aGal->DrawPolyline( aOutlines.CHole( ii, jj ) );
+    }
+}
+
+
+void GERBER_COMPARE_ITEM::ViewDraw( int aLayer, KIGFX::VIEW* aView ) const
+{
+    KIGFX::GAL* gal = aView->GetGAL();
+
+    drawArea( gal, m_removed, m_removedFill, COLOR4D( RED ) );
+    drawArea( gal, m_added, m_addedFill, COLOR4D( GREEN ) );
+}
@@ -0,0 +1,184 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file gerber_compare.h
+ */
+
+#ifndef GERBER_COMPARE_H
+#define GERBER_COMPARE_H
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include <base_struct.h>
+#include <geometry/shape_poly_set.h>
+#include <gal/color4d.h>
+
+class GERBER_FILE_IMAGE;
+class GERBER_DRAW_ITEM;
+class PROGRESS_REPORTER;
+
+using KIGFX::COLOR4D;
+
+
+/**
+ * Compares the dark areas of two gerber images, as drawn in filled mode.
+ *
+ * Both images are rasterized on the same grid, by square tiles.  The items of an image are
+ * painted in the file order, the dark items setting their pixels and the clear items
+ * clearing them, so no polygon boolean operation is needed whatever the item count.  The
+ * tiles are independent: they are rasterized and compared in the thread pool.  The pixels
+ * dark in only one image are merged in rectangles, then in the regions returned by
+ * GetRemovedArea() and GetAddedArea().
+ */
+class GERBER_IMAGE_COMPARE
+{
+public:
+    /**
+     * @param aPixelSize = the size of the pixels, in internal units.  Smaller differences
+     * can be missed, and differences of the size of a pixel can be found along the edges.
+     */
+    GERBER_IMAGE_COMPARE( int aPixelSize );
+
+    /**
+     * @return the count of pixels of the area covered by aReference and aCompared, to
+     * check the resolution is sensible before comparing
+     */
+    double GetPixelCount( GERBER_FILE_IMAGE* aReference, GERBER_FILE_IMAGE* aCompared ) const;
+
+    /**
+     * Function Compare
+     * compares aCompared to aReference.  Must be called from the main thread, which
+     * refreshes aProgress while the thread pool works.
+     * @param aProgress = the progress reporter, which can cancel the comparison, or NULL
+     * @return false if the comparison was cancelled
+     */
+    bool Compare( GERBER_FILE_IMAGE* aReference, GERBER_FILE_IMAGE* aCompared,
+                  PROGRESS_REPORTER* aProgress );
+
+    /**
+     * @return the area dark in the reference image only
+     */
+    const SHAPE_POLY_SET& GetRemovedArea() const { return m_removed; }
+
+    /**
+     * @return the area dark in the compared image only
+     */
+    const SHAPE_POLY_SET& GetAddedArea() const { return m_added; }
+
+    /**
+     * @return the count of pixels dark in one image only
+     */
+    long long GetDifferentPixelCount() const { return m_differentPixels; }
+
+private:
+    ///> An item of an image, converted to polygons
+    struct RASTER_ITEM
+    {
+        SHAPE_POLY_SET m_Shape;
+        BOX2I          m_BBox;
+        bool           m_Clear;     ///< true for a clear (negative) item
+    };
+
+    ///> The differences found in a tile, in pixel coordinates of the grid
+    struct TILE_RESULT
+    {
+        std::vector<BOX2I> m_Removed;
+        std::vector<BOX2I> m_Added;
+        long long          m_Count;
+    };
+
+    bool convertItems( GERBER_FILE_IMAGE* aImage, std::vector<RASTER_ITEM>& aItems,
+                       PROGRESS_REPORTER* aProgress );
+
+    /**
+     * Paints the items aIndices of aItems in the tile aTile (in pixels) of aMask.
+     */
+    void rasterize( const std::vector<RASTER_ITEM>& aItems, const std::vector<int>& aIndices,
+                    const BOX2I& aTile, std::vector<unsigned char>& aMask ) const;
+
+    void rasterizePolygon( const SHAPE_POLY_SET::POLYGON& aPolygon, const BOX2I& aTile,
+                           unsigned char aValue, std::vector<unsigned char>& aMask ) const;
+
+    /**
+     * Builds the regions of the pixel rectangles aRects, in internal units
+     */
+    void buildArea( const std::vector<BOX2I>& aRects, SHAPE_POLY_SET& aArea ) const;
+
+    /**
+     * Runs aWork for aCount indices in the thread pool, refreshing aProgress
+     * @return false if cancelled by aProgress
+     */
+    bool runParallel( size_t aCount, const std::function<void( size_t )>& aWork,
+                      PROGRESS_REPORTER* aProgress );
+
+    int               m_pixelSize;
+    VECTOR2I          m_origin;     ///< the corner of the grid, in internal units
+    SHAPE_POLY_SET    m_removed;
+    SHAPE_POLY_SET    m_added;
+    long long         m_differentPixels;
+    std::atomic<bool> m_cancelled;
+};
+
+
+/**
+ * Shows the result of a GERBER_IMAGE_COMPARE above the layers: the removed area in red and
+ * the added area in green.  The outlines are drawn with a constant width on screen, so the
+ * smallest differences stay visible when zooming out.
+ */
+class GERBER_COMPARE_ITEM : public EDA_ITEM
+{
+public:
+    GERBER_COMPARE_ITEM( const GERBER_IMAGE_COMPARE& aCompare );
+
+    wxString GetClass() const override
+    {
+        return wxT( "GERBER_COMPARE_ITEM" );
+    }
+
+    ///> @copydoc VIEW_ITEM::ViewBBox()
+    const BOX2I ViewBBox() const override;
+
+    ///> @copydoc VIEW_ITEM::ViewGetLayers()
+    void ViewGetLayers( int aLayers[], int& aCount ) const override;
+
+    ///> @copydoc VIEW_ITEM::ViewDraw()
+    void ViewDraw( int aLayer, KIGFX::VIEW* aView ) const override;
+
+#if defined(DEBUG)
+    void Show( int nestLevel, std::ostream& os ) const override { ShowDummy( os ); }
+#endif
+
+private:
+    void drawArea( KIGFX::GAL* aGal, const SHAPE_POLY_SET& aOutlines,
+                   const SHAPE_POLY_SET& aFill, const COLOR4D& aColor ) const;
+
+    SHAPE_POLY_SET m_removed;           ///< the outlines of the regions
+    SHAPE_POLY_SET m_added;
+    SHAPE_POLY_SET m_removedFill;       ///< the regions, fractured and triangulated
+    SHAPE_POLY_SET m_addedFill;
+};
+
+#endif  // GERBER_COMPARE_H
@@ -35,6 +35,9 @@
 #include <gerber_file_image_list.h>
 #include <kicad_string.h>
 
+const int GERBER_DRAW_ITEM::MIN_HIT_TEST_RADIUS = Millimeter2iu( 0.01 );
+
+
 GERBER_DRAW_ITEM::GERBER_DRAW_ITEM( GERBER_FILE_IMAGE* aGerberImageFile ) :
     EDA_ITEM( (EDA_ITEM*)NULL, GERBER_DRAW_ITEM_T )
 {
@@ -60,16 +63,11 @@ GERBER_DRAW_ITEM::~GERBER_DRAW_ITEM()
 }
 
 
-void GERBER_DRAW_ITEM::SetNetAttributes( const GBR_NETLIST_METADATA& aNetAttributes )
+const GBR_NETLIST_METADATA& GERBER_DRAW_ITEM::GetNetAttributes() const
 {
-    m_netAttributes = aNetAttributes;
-
-    if( ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_CMP ) ||
-        ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_PAD ) )
-        m_GerberImageFile->m_ComponentsList.insert( std::make_pair( m_netAttributes.m_Cmpref, 0 ) );
+    static const GBR_NETLIST_METADATA noAttributes;
 
-    if( ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_NET ) )
-        m_GerberImageFile->m_NetnamesList.insert( std::make_pair( m_netAttributes.m_Netname, 0 ) );
+    return m_netAttributes ? *m_netAttributes : noAttributes;
 }
 
 
@@ -353,10 +351,11 @@ const EDA_RECT GERBER_DRAW_ITEM::GetBoundingBox() const
     {
         if( code )
         {
-            // Update the shape drawings and the bounding box coordiantes:
-            code->GetMacro()->GetApertureMacroShape( this, m_Start );
-            // now the bounding box is valid:
-            bbox = code->GetMacro()->GetBoundingBox();
+            BOX2I   shapeBox = code->GetMacroShape( this ).BBox();
+            wxPoint pos = GetABPosition( m_Start );
+
+            bbox = EDA_RECT( wxPoint( shapeBox.GetX() + pos.x, shapeBox.GetY() + pos.y ),
+                             wxSize( shapeBox.GetWidth(), shapeBox.GetHeight() ) );
         }
         break;
     }
@@ -699,32 +698,34 @@ void GERBER_DRAW_ITEM::GetMsgPanelInfo( EDA_UNITS_T aUnits, std::vector< MSG_PAN
     aList.push_back( MSG_PANEL_ITEM( _( "AB axis" ), msg, DARKRED ) );
 
     // Display net info, if exists
-    if( m_netAttributes.m_NetAttribType == GBR_NETLIST_METADATA::GBR_NETINFO_UNSPECIFIED )
+    const GBR_NETLIST_METADATA& netAttributes = GetNetAttributes();
+
+    if( netAttributes.m_NetAttribType == GBR_NETLIST_METADATA::GBR_NETINFO_UNSPECIFIED )
         return;
 
     // Build full net info:
     wxString net_msg;
     wxString cmp_pad_msg;
 
-    if( ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_NET ) )
+    if( ( netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_NET ) )
     {
         net_msg = _( "Net:" );
         net_msg << " ";
 
-        if( m_netAttributes.m_Netname.IsEmpty() )
+        if( netAttributes.m_Netname.IsEmpty() )
             net_msg << "<no net>";
         else
-            net_msg << UnescapeString( m_netAttributes.m_Netname );
+            net_msg << UnescapeString( netAttributes.m_Netname );
     }
 
-    if( ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_PAD ) )
+    if( ( netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_PAD ) )
     {
         cmp_pad_msg.Printf( _( "Cmp: %s;  Pad: %s" ),
-                                m_netAttributes.m_Cmpref,
-                                m_netAttributes.m_Padname );
+                                netAttributes.m_Cmpref,
+                                netAttributes.m_Padname );
     }
 
-    else if( ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_CMP ) )
+    else if( ( netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_CMP ) )
     {
         cmp_pad_msg = _( "Cmp:" );
         cmp_pad_msg << " " << m_netAttributes.m_Cmpref;
@@ -765,7 +766,7 @@ BITMAP_DEF GERBER_DRAW_ITEM::GetMenuImage() const
 bool GERBER_DRAW_ITEM::HitTest( const wxPoint& aRefPos, int aAccuracy ) const
 {
     // In case the item has a very tiny width defined, allow it to be selected
-    const int MIN_HIT_TEST_RADIUS = Millimeter2iu( 0.01 );
+    // (see MIN_HIT_TEST_RADIUS)
 
     // calculate aRefPos in XY gerber axis:
     wxPoint ref_pos = GetXYPosition( aRefPos );
@@ -826,9 +827,9 @@ bool GERBER_DRAW_ITEM::HitTest( const wxPoint& aRefPos, int aAccuracy ) const
         }
 
     case GBR_SPOT_MACRO:
-        // Aperture macro polygons are already in absolute coordinates
-        auto p = GetDcodeDescr()->GetMacro()->GetApertureMacroShape( this, m_Start );
-        return p->Contains( VECTOR2I( aRefPos ), -1, aAccuracy );
+        // Aperture macro polygons are relative to the flash position
+        const SHAPE_POLY_SET& p = GetDcodeDescr()->GetMacroShape( this );
+        return p.Contains( VECTOR2I( aRefPos - GetABPosition( m_Start ) ), -1, aAccuracy );
     }
 
     // TODO: a better analyze of the shape (perhaps create a D_CODE::HitTest for flashed items)
@@ -911,7 +912,7 @@ unsigned int GERBER_DRAW_ITEM::ViewGetLOD( int aLayer, KIGFX::VIEW* aView ) cons
         switch( m_Shape )
         {
         case GBR_SPOT_MACRO:
-            size = GetDcodeDescr()->GetMacro()->GetBoundingBox().GetWidth();
+            size = GetDcodeDescr()->GetMacroShape( this ).BBox().GetWidth();
             break;
 
         case GBR_ARC:
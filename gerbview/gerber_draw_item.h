@@ -30,13 +30,15 @@
 #define GERBER_DRAW_ITEM_H
 
 #include <base_struct.h>
-#include <dlist.h>
 #include <layers_id_colors_and_visibility.h>
 #include <gr_basic.h>
 #include <gbr_netlist_metadata.h>
 #include <dcode.h>
 #include <geometry/shape_poly_set.h>
 
+#include <memory>
+#include <vector>
+
 class GERBER_FILE_IMAGE;
 class GBR_LAYOUT;
 class D_CODE;
@@ -68,13 +70,6 @@ enum Gbr_Basic_Shapes {
 
 class GERBER_DRAW_ITEM : public EDA_ITEM
 {
-    // make SetNext() and SetBack() private so that they may not be called from anywhere.
-    // list management is done on GERBER_DRAW_ITEMs using DLIST<GERBER_DRAW_ITEM> only.
-private:
-    void SetNext( EDA_ITEM* aNext )       { Pnext = aNext; }
-    void SetBack( EDA_ITEM* aBack )       { Pback = aBack; }
-
-
 public:
     bool               m_UnitsMetric;       // store here the gerber units (inch/mm).  Used
                                             // only to calculate aperture macros shapes sizes
@@ -111,19 +106,27 @@ private:
     wxRealPoint m_drawScale;                // A and B scaling factor
     wxPoint     m_layerOffset;              // Offset for A and B axis, from OF parameter
     double      m_lyrRotation;              // Fine rotation, from OR parameter, in degrees
-    GBR_NETLIST_METADATA m_netAttributes;   ///< the string given by a %TO attribute set in aperture
-                                            ///< (dcode). Stored in each item, because %TO is
-                                            ///< a dynamic object attribute
+    std::shared_ptr<const GBR_NETLIST_METADATA> m_netAttributes;
+                                            ///< the string given by a %TO attribute set in
+                                            ///< aperture (dcode). Stored in each item, because
+                                            ///< %TO is a dynamic object attribute, and shared
+                                            ///< by the items drawn with the same attributes.
+                                            ///< NULL if no attribute
 
 public:
+    /// The distance from the items at which HitTest() hits them, at least, so that
+    /// the items with a very tiny width can be selected
+    static const int MIN_HIT_TEST_RADIUS;
+
     GERBER_DRAW_ITEM( GERBER_FILE_IMAGE* aGerberparams );
     ~GERBER_DRAW_ITEM();
 
-    GERBER_DRAW_ITEM* Next() const { return static_cast<GERBER_DRAW_ITEM*>( Pnext ); }
-    GERBER_DRAW_ITEM* Back() const { return static_cast<GERBER_DRAW_ITEM*>( Pback ); }
+    void SetNetAttributes( const std::shared_ptr<const GBR_NETLIST_METADATA>& aNetAttributes )
+    {
+        m_netAttributes = aNetAttributes;
+    }
 
-    void SetNetAttributes( const GBR_NETLIST_METADATA& aNetAttributes );
-    const GBR_NETLIST_METADATA& GetNetAttributes() const { return m_netAttributes; }
+    const GBR_NETLIST_METADATA& GetNetAttributes() const;
 
     /**
      * Function GetLayer
@@ -282,28 +285,6 @@ public:
         return wxT( "GERBER_DRAW_ITEM" );
     }
 
-    /**
-     * Function UnLink
-     * detaches this object from its owner.
-     */
-    void UnLink()
-    {
-        DLIST<GERBER_DRAW_ITEM>* list = (DLIST<GERBER_DRAW_ITEM>*) GetList();
-        wxASSERT( list );
-
-        if( list )
-            list->Remove( this );
-    }
-
-    /**
-     * Function DeleteStructure
-     * deletes this object after UnLink()ing it from its owner.
-     */
-    void DeleteStructure()
-    {
-        UnLink();
-        delete this;
-    }
 #if defined(DEBUG)
     void Show( int nestLevel, std::ostream& os ) const override;
 #endif
@@ -328,6 +309,134 @@ public:
 };
 
 
+/**
+ * The draw items of a gerber image, in the file order.
+ *
+ * A layer can have millions of items, so they are not allocated one by one, but stored in
+ * blocks of consecutive items.  An item is never moved once added, so the view and the
+ * selection can keep pointers to it.  Iterating over the list gives the item pointers.
+ */
+class GERBER_DRAW_ITEMS
+{
+public:
+    class ITERATOR
+    {
+    public:
+        ITERATOR( const GERBER_DRAW_ITEMS* aList, size_t aBlock, size_t aIndex ) :
+                m_list( aList ),
+                m_block( aBlock ),
+                m_index( aIndex )
+        {
+        }
+
+        GERBER_DRAW_ITEM* operator*() const
+        {
+            return const_cast<GERBER_DRAW_ITEM*>( &m_list->m_blocks[m_block][m_index] );
+        }
+
+        ITERATOR& operator++()
+        {
+            if( ++m_index == m_list->m_blocks[m_block].size() )
+            {
+                ++m_block;
+                m_index = 0;
+            }
+
+            return *this;
+        }
+
+        bool operator!=( const ITERATOR& aOther ) const
+        {
+            return m_block != aOther.m_block || m_index != aOther.m_index;
+        }
+
+    private:
+        const GERBER_DRAW_ITEMS* m_list;
+        size_t                   m_block;
+        size_t                   m_index;
+    };
+
+    GERBER_DRAW_ITEMS() :
+            m_count( 0 )
+    {
+    }
+
+    GERBER_DRAW_ITEMS( const GERBER_DRAW_ITEMS& ) = delete;
+    GERBER_DRAW_ITEMS& operator=( const GERBER_DRAW_ITEMS& ) = delete;
+
+    /**
+     * Constructs a new item at the end of the list
+     * @param aArgs are the arguments of the GERBER_DRAW_ITEM constructor
+     * @return the new item, owned by the list
+     */
+    template <typename... ARGS>
+    GERBER_DRAW_ITEM* Add( ARGS&&... aArgs )
+    {
+        // The blocks grow with the list, up to MAX_BLOCK_SIZE items.  The capacity of a
+        // block is reserved once, so its items never move.
+        if( m_blocks.empty() || m_blocks.back().size() == m_blocks.back().capacity() )
+        {
+            size_t blockSize = m_count < MIN_BLOCK_SIZE ? MIN_BLOCK_SIZE : m_count;
+
+            m_blocks.emplace_back();
+            m_blocks.back().reserve( blockSize < MAX_BLOCK_SIZE ? blockSize : MAX_BLOCK_SIZE );
+        }
+
+        m_blocks.back().emplace_back( std::forward<ARGS>( aArgs )... );
+        ++m_count;
+
+        return &m_blocks.back().back();
+    }
+
+    /**
+     * @return the last item, NULL if the list is empty
+     */
+    GERBER_DRAW_ITEM* GetLast()
+    {
+        return m_count ? &m_blocks.back().back() : NULL;
+    }
+
+    size_t GetCount() const { return m_count; }
+
+    bool IsEmpty() const { return m_count == 0; }
+
+    /**
+     * @return the count of items the blocks can hold, used to measure their memory
+     */
+    size_t GetCapacity() const
+    {
+        size_t capacity = 0;
+
+        for( const std::vector<GERBER_DRAW_ITEM>& block : m_blocks )
+            capacity += block.capacity();
+
+        return capacity;
+    }
+
+    /**
+     * Deletes all the items
+     */
+    void Clear()
+    {
+        m_blocks.clear();
+        m_count = 0;
+    }
+
+    ITERATOR begin() const { return ITERATOR( this, 0, 0 ); }
+    ITERATOR end() const { return ITERATOR( this, m_blocks.size(), 0 ); }
+
+private:
+    enum : size_t
+    {
+        MIN_BLOCK_SIZE = 64,
+        MAX_BLOCK_SIZE = 4096
+    };
+
+    std::vector<std::vector<GERBER_DRAW_ITEM>> m_blocks;
+    size_t                                     m_count;
+};
+
+
 class GERBER_NEGATIVE_IMAGE_BACKDROP : public EDA_ITEM
 {
 
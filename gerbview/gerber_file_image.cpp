@@ -31,6 +31,9 @@
 #include <common.h>
 #include <macros.h>
 #include <convert_to_biu.h>
+#include <convert_basic_shapes_to_polygon.h>
+#include <trigo.h>
+#include <thread_pool.h>
 #include <gerbview.h>
 #include <gerbview_frame.h>
 #include <gerber_file_image.h>
@@ -38,6 +41,8 @@
 #include <algorithm>
 #include <map>
 
+#include <wx/filename.h>
+
 
 /**
  * Function scaletoIU
@@ -95,6 +100,10 @@ GERBER_FILE_IMAGE::GERBER_FILE_IMAGE( int aLayer ) :
 
     m_Selected_Tool = 0;
     m_FileFunction = NULL;          // file function parameters
+    m_hasCompositeShape = false;
+    m_compositeShown = false;
+    m_compositeCancelled = false;
+    m_unloaded = false;
 
     ResetDefaultValues();
 
@@ -105,7 +114,14 @@ GERBER_FILE_IMAGE::GERBER_FILE_IMAGE( int aLayer ) :
 
 GERBER_FILE_IMAGE::~GERBER_FILE_IMAGE()
 {
-    m_Drawings.DeleteAll();
+    // The worker reads the items: stop it before deleting them
+    if( m_compositeWorker.valid() )
+    {
+        m_compositeCancelled = true;
+        m_compositeWorker.wait();
+    }
+
+    m_Drawings.Clear();
 
     for( unsigned ii = 0; ii < arrayDim( m_Aperture_List ); ii++ )
     {
@@ -115,13 +131,22 @@ GERBER_FILE_IMAGE::~GERBER_FILE_IMAGE()
     delete m_FileFunction;
 }
 
-/*
- * Function GetItemsList
- * returns the first GERBER_DRAW_ITEM * item of the items list
- */
-GERBER_DRAW_ITEM * GERBER_FILE_IMAGE::GetItemsList()
+const std::shared_ptr<const GBR_NETLIST_METADATA>& GERBER_FILE_IMAGE::GetSharedNetAttributes()
 {
-    return m_Drawings;
+    if( !m_sharedNetAttributes
+            && m_NetAttributeDict.m_NetAttribType != GBR_NETLIST_METADATA::GBR_NETINFO_UNSPECIFIED )
+    {
+        m_sharedNetAttributes = std::make_shared<const GBR_NETLIST_METADATA>( m_NetAttributeDict );
+
+        if( ( m_NetAttributeDict.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_CMP ) ||
+            ( m_NetAttributeDict.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_PAD ) )
+            m_ComponentsList.insert( std::make_pair( m_NetAttributeDict.m_Cmpref, 0 ) );
+
+        if( ( m_NetAttributeDict.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_NET ) )
+            m_NetnamesList.insert( std::make_pair( m_NetAttributeDict.m_Netname, 0 ) );
+    }
+
+    return m_sharedNetAttributes;
 }
 
 
@@ -177,6 +202,7 @@ void GERBER_FILE_IMAGE::ResetDefaultValues()
     m_InUse         = false;
     m_GBRLayerParams.ResetDefaultValues();
     m_FileName.Empty();
+    m_FileTime = wxDateTime();
     m_ImageName     = wxT( "no name" );             // Image name from the IN command
     m_ImageNegative = false;                        // true = Negative image
     m_IsX2_file     = false;                        // true only if a %TF, %TA or %TD command
@@ -222,7 +248,6 @@ void GERBER_FILE_IMAGE::ResetDefaultValues()
     m_LastArcDataType = ARC_INFO_TYPE_NONE;         // Extra coordinate info type for arcs
                                                     // (radius or IJ center coord)
     m_LineNum = 0;                                  // line number in file being read
-    m_Current_File    = NULL;                       // Gerber file to read
     m_PolygonFillMode = false;
     m_PolygonFillModeState = 0;
     m_Selected_Tool = 0;
@@ -244,7 +269,7 @@ bool GERBER_FILE_IMAGE::HasNegativeItems()
         else
         {
             m_hasNegativeItems = 0;
-            for( GERBER_DRAW_ITEM* item = GetItemsList(); item; item = item->Next() )
+            for( GERBER_DRAW_ITEM* item : GetItems() )
             {
                 if( item->GetLayer() != m_GraphicLayer )
                     continue;
@@ -259,6 +284,302 @@ bool GERBER_FILE_IMAGE::HasNegativeItems()
     return m_hasNegativeItems == 1;
 }
 
+
+void GERBER_FILE_IMAGE::PrepareItemShapes()
+{
+    for( unsigned ii = 0; ii < arrayDim( m_Aperture_List ); ii++ )
+    {
+        D_CODE* code = m_Aperture_List[ii];
+
+        if( code && code->m_Shape != APT_MACRO && code->m_Polygon.OutlineCount() == 0 )
+            code->ConvertShapeToPolygon();
+    }
+
+    for( GERBER_DRAW_ITEM* item : m_Drawings )
+    {
+        if( item->m_Shape != GBR_SEGMENT || item->m_Polygon.OutlineCount() )
+            continue;
+
+        D_CODE* code = item->GetDcodeDescr();
+
+        if( code && code->m_Shape == APT_RECT )
+            item->ConvertSegmentToPolygon();
+    }
+}
+
+
+void GERBER_FILE_IMAGE::TransformItemToPolygon( const GERBER_DRAW_ITEM* aItem,
+                                                SHAPE_POLY_SET& aShape )
+{
+    SHAPE_POLY_SET itemShape;
+    D_CODE*        code = aItem->GetDcodeDescr();
+
+    switch( aItem->m_Shape )
+    {
+    case GBR_POLYGON:
+        // Degenerated polygons are drawn as lines: they have no area
+        if( aItem->m_Polygon.OutlineCount() == 0 || aItem->m_Polygon.COutline( 0 ).PointCount() < 3 )
+            return;
+
+        itemShape = aItem->m_Polygon;
+        break;
+
+    case GBR_SEGMENT:
+        if( code && code->m_Shape == APT_RECT )
+        {
+            itemShape = aItem->m_Polygon;
+            break;
+        }
+
+        TransformRoundedEndsSegmentToPolygon( aShape, aItem->GetABPosition( aItem->m_Start ),
+                                              aItem->GetABPosition( aItem->m_End ),
+                                              ARC_HIGH_DEF, aItem->m_Size.x );
+        return;
+
+    case GBR_CIRCLE:
+        TransformCircleToPolygon( aShape, aItem->GetABPosition( aItem->m_Start ),
+                                  KiROUND( GetLineLength( aItem->m_Start, aItem->m_End ) ),
+                                  ARC_HIGH_DEF );
+        return;
+
+    case GBR_ARC:
+    {
+        // Same angles as the painter: from m_End to m_Start, in the AB coordinates
+        wxPoint  center = aItem->GetABPosition( aItem->m_ArcCentre );
+        wxPoint  arcStart = aItem->GetABPosition( aItem->m_End );
+        VECTOR2D startVec = VECTOR2D( arcStart - center );
+        VECTOR2D endVec = VECTOR2D( aItem->GetABPosition( aItem->m_Start ) - center );
+        double   startAngle = startVec.Angle();
+        double   endAngle = endVec.Angle();
+
+        if( startAngle > endAngle )
+            endAngle += 2 * M_PI;
+
+        if( aItem->m_Start == aItem->m_End )
+            endAngle = startAngle + 2 * M_PI;
+
+        TransformArcToPolygon( aShape, center, arcStart, RAD2DECIDEG( endAngle - startAngle ),
+                               ARC_HIGH_DEF, aItem->m_Size.x );
+        return;
+    }
+
+    case GBR_SPOT_CIRCLE:
+    case GBR_SPOT_RECT:
+    case GBR_SPOT_OVAL:
+    case GBR_SPOT_POLY:
+        if( !code )
+            return;
+
+        itemShape = code->m_Polygon;
+        itemShape.Move( VECTOR2I( aItem->m_Start ) );
+        break;
+
+    case GBR_SPOT_MACRO:
+        // The D_CODE cache of GetMacroShape() is used by the painter: build a copy
+        if( !code || !code->GetMacro() )
+            return;
+
+        code->GetMacro()->BuildApertureMacroShape( aItem, aItem->m_Start, itemShape );
+        aShape.Append( itemShape );
+        return;
+
+    default:
+        return;
+    }
+
+    for( auto it = itemShape.IterateWithHoles(); it; ++it )
+        *it = aItem->GetABPosition( *it );
+
+    aShape.Append( itemShape );
+}
+
+
+bool GERBER_FILE_IMAGE::BuildCompositeShape( SHAPE_POLY_SET& aShape,
+                                             const std::atomic<bool>& aCancelled )
+{
+    std::vector<const GERBER_DRAW_ITEM*> run;
+    bool                                 runIsClear = false;
+    SHAPE_POLY_SET                       runShape;
+
+    aShape.RemoveAllContours();
+
+    // Merges the items of the current run, and adds them to (or removes them from) aShape
+    auto flushRun = [&]()
+    {
+        runShape.RemoveAllContours();
+
+        TransformShapesToPolygon( runShape, run.size(),
+                [&run, &aCancelled]( size_t aIndex, SHAPE_POLY_SET& aBuffer )
+                {
+                    if( !aCancelled )
+                        TransformItemToPolygon( run[aIndex], aBuffer );
+                } );
+
+        if( runIsClear )
+            aShape.BooleanSubtract( runShape, SHAPE_POLY_SET::PM_FAST );
+        else
+            aShape.BooleanAdd( runShape, SHAPE_POLY_SET::PM_FAST );
+
+        run.clear();
+    };
+
+    for( GERBER_DRAW_ITEM* item : m_Drawings )
+    {
+        bool isClear = item->HasNegativeItems();
+
+        if( isClear != runIsClear && !run.empty() )
+        {
+            if( aCancelled )
+                return false;
+
+            flushRun();
+        }
+
+        runIsClear = isClear;
+        run.push_back( item );
+    }
+
+    if( !run.empty() )
+    {
+        if( aCancelled )
+            return false;
+
+        flushRun();
+    }
+
+    if( aCancelled )
+        return false;
+
+    aShape.Fracture( SHAPE_POLY_SET::PM_FAST );
+    aShape.CacheTriangulation();
+
+    return true;
+}
+
+
+bool GERBER_FILE_IMAGE::StartCompositeShape()
+{
+    // The painter draws the items of negative images as they are
+    if( m_compositeWorker.valid() || m_unloaded || m_ImageNegative || !HasNegativeItems() )
+        return false;
+
+    // The worker only reads the items
+    PrepareItemShapes();
+
+    m_compositeCancelled = false;
+    m_compositeWorker = THREAD_POOL::GetPool().Async( [this]() -> bool
+    {
+        return BuildCompositeShape( m_pendingCompositeShape, m_compositeCancelled );
+    } );
+
+    return true;
+}
+
+
+bool GERBER_FILE_IMAGE::UpdateCompositeShape()
+{
+    if( !m_compositeWorker.valid()
+            || m_compositeWorker.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready )
+    {
+        return false;
+    }
+
+    if( !m_compositeWorker.get() )
+        return false;
+
+    m_compositeShape = std::move( m_pendingCompositeShape );
+    m_hasCompositeShape = true;
+
+    return true;
+}
+
+
+size_t GERBER_FILE_IMAGE::GetMemoryUsage() const
+{
+    size_t usage = sizeof( *this ) + m_Drawings.GetCapacity() * sizeof( GERBER_DRAW_ITEM );
+
+    for( GERBER_DRAW_ITEM* item : m_Drawings )
+        usage += item->m_Polygon.TotalVertices() * sizeof( VECTOR2I );
+
+    for( unsigned ii = 0; ii < arrayDim( m_Aperture_List ); ii++ )
+    {
+        const D_CODE* code = m_Aperture_List[ii];
+
+        if( code )
+            usage += sizeof( D_CODE ) + code->m_Polygon.TotalVertices() * sizeof( VECTOR2I );
+    }
+
+    // The triangulation of the composite shape is about as large as its outlines
+    usage += 2 * m_compositeShape.TotalVertices() * sizeof( VECTOR2I );
+
+    return usage;
+}
+
+
+bool GERBER_FILE_IMAGE::CanUnload() const
+{
+    wxFileName fn( m_FileName );
+
+    return m_FileTime.IsValid() && fn.FileExists() && fn.GetModificationTime() == m_FileTime;
+}
+
+
+void GERBER_FILE_IMAGE::Unload()
+{
+    wxASSERT( !m_compositeShown );
+
+    // The worker reads the items: stop it before deleting them
+    if( m_compositeWorker.valid() )
+    {
+        m_compositeCancelled = true;
+        m_compositeWorker.wait();
+        m_compositeWorker = std::future<bool>();
+    }
+
+    m_compositeShape = SHAPE_POLY_SET();
+    m_pendingCompositeShape = SHAPE_POLY_SET();
+    m_hasCompositeShape = false;
+
+    m_Drawings.Clear();
+
+    for( unsigned ii = 0; ii < arrayDim( m_Aperture_List ); ii++ )
+    {
+        delete m_Aperture_List[ii];
+        m_Aperture_List[ii] = NULL;
+    }
+
+    m_aperture_macros.clear();
+    m_sharedNetAttributes.reset();
+    m_unloaded = true;
+}
+
+
+GERBER_FILE_IMAGE* GERBER_FILE_IMAGE::Reload() const
+{
+    GERBER_FILE_IMAGE* image = new GERBER_FILE_IMAGE( m_GraphicLayer );
+
+    if( !image->LoadGerberFile( m_FileName ) )
+    {
+        delete image;
+        return NULL;
+    }
+
+    return image;
+}
+
+
+const BOX2I GERBER_FILE_IMAGE::ViewBBox() const
+{
+    return m_compositeShape.BBox();
+}
+
+
+void GERBER_FILE_IMAGE::ViewGetLayers( int aLayers[], int& aCount ) const
+{
+    aCount = 1;
+    aLayers[0] = GERBER_DRAW_LAYER( m_GraphicLayer );
+}
+
 int GERBER_FILE_IMAGE::GetDcodesCount()
 {
     int count = 0;
@@ -312,14 +633,13 @@ void GERBER_FILE_IMAGE::StepAndRepeatItem( const GERBER_DRAW_ITEM& aItem )
             // create duplicate only if ii or jj > 0
             if( jj == 0 && ii == 0 )
                 continue;
-            GERBER_DRAW_ITEM* dupItem = new GERBER_DRAW_ITEM( aItem );
+            GERBER_DRAW_ITEM* dupItem = m_Drawings.Add( aItem );
             wxPoint           move_vector;
             move_vector.x = scaletoIU( ii * GetLayerParams().m_StepForRepeat.x,
                                    GetLayerParams().m_StepForRepeatMetric );
             move_vector.y = scaletoIU( jj * GetLayerParams().m_StepForRepeat.y,
                                    GetLayerParams().m_StepForRepeatMetric );
             dupItem->MoveXY( move_vector );
-            m_Drawings.Append( dupItem );
         }
     }
 }
@@ -383,6 +703,7 @@ void GERBER_FILE_IMAGE::RemoveAttribute( X2_ATTRIBUTE& aAttribute )
      * only this attribute is cleared
      */
     m_NetAttributeDict.ClearAttribute( &aAttribute.GetPrm( 1 ) );
+    NetAttributesChanged();
 
     if( aAttribute.GetPrm( 1 ).IsEmpty() || aAttribute.GetPrm( 1 ) == ".AperFunction" )
         m_AperFunction.Clear();
@@ -412,7 +733,14 @@ SEARCH_RESULT GERBER_FILE_IMAGE::Visit( INSPECTOR inspector, void* testData, con
             break;
 
         case GERBER_DRAW_ITEM_T:
-            result = IterateForward( &m_Drawings[0], inspector, testData, p );
+            for( GERBER_DRAW_ITEM* item : m_Drawings )
+            {
+                result = item->Visit( inspector, testData, p );
+
+                if( result == SEARCH_QUIT )
+                    break;
+            }
+
             ++p;
             break;
 
@@ -25,13 +25,18 @@
 #ifndef GERBER_FILE_IMAGE_H
 #define GERBER_FILE_IMAGE_H
 
+#include <atomic>
+#include <future>
 #include <vector>
 #include <set>
 
+#include <wx/datetime.h>
+
 #include <dcode.h>
 #include <gerber_draw_item.h>
 #include <am_primitive.h>
 #include <gbr_netlist_metadata.h>
+#include <gerber_line_reader.h>
 
 // An useful macro used when reading gerber files;
 #define IsNumber( x ) ( ( ( (x) >= '0' ) && ( (x) <='9' ) )   \
@@ -112,7 +117,7 @@ class GERBER_FILE_IMAGE : public EDA_ITEM
     GERBER_LAYER       m_GBRLayerParams; // hold params for the current gerber layer
 
 public:
-    DLIST<GERBER_DRAW_ITEM> m_Drawings;                         // linked list of Gerber Items to draw
+    GERBER_DRAW_ITEMS  m_Drawings;                              // list of Gerber Items to draw
 
     bool               m_InUse;                                 // true if this image is currently in use
                                                                 // (a file is loaded in it)
@@ -120,6 +125,7 @@ public:
                                                                 // false if it must be not drawn
     COLOR4D            m_PositiveDrawColor;                     // The color used to draw positive items
     wxString           m_FileName;                              // Full File Name for this layer
+    wxDateTime         m_FileTime;                              // Modification time of the file when read
     wxString           m_ImageName;                             // Image name, from IN <name>* command
     bool               m_IsX2_file;                             // true if a X2 gerber attribute was found in file
     X2_ATTRIBUTE_FILEFUNCTION* m_FileFunction;                  // file function parameters, found in a %TF command
@@ -157,7 +163,7 @@ public:
     bool               m_LastCoordIsIJPos;                      // true if a IJ coord was read (for arcs & circles )
     int                m_ArcRadius;                             // A value ( = radius in circular routing in Excellon files )
     LAST_EXTRA_ARC_DATA_TYPE m_LastArcDataType;                 // Identifier for arc data type (IJ (center) or A## (radius))
-    FILE*              m_Current_File;                          // Current file to read
+    GERBER_LINE_READER m_lineReader;                            // Current file to read (Gerber and Excellon files)
 
     int                m_Selected_Tool;                         // For hightlight: current selected Dcode
     bool               m_Has_DCode;                             // true = DCodes in file
@@ -170,6 +176,8 @@ public:
 
     GBR_NETLIST_METADATA m_NetAttributeDict;                    // the net attributes set by a %TO.CN, %TO.C and/or %TO.N
                                                                 // add object attribute command.
+                                                                // Call NetAttributesChanged() after
+                                                                // changing them.
     wxString          m_AperFunction;                           // the aperture function set by a %TA.AperFunction, xxx
                                                                 // (stores thre xxx value).
 
@@ -178,6 +186,7 @@ public:
 
 private:
     wxArrayString      m_messagesList;                          // A list of messages created when reading a file
+    std::shared_ptr<const GBR_NETLIST_METADATA> m_sharedNetAttributes; // see GetSharedNetAttributes()
     int                m_hasNegativeItems;                      // true if the image is negative or has some negative items
                                                                 // Used to optimize drawing, because when there are no
                                                                 // negative items screen refresh does not need
@@ -185,31 +194,35 @@ private:
                                                                 // -1 = negative items are
                                                                 // 0 = no negative items found
                                                                 // 1 = have negative items found
+
+    SHAPE_POLY_SET     m_compositeShape;                        // dark area of the image, see BuildCompositeShape()
+    bool               m_hasCompositeShape;                     // true once m_compositeShape is built
+    bool               m_compositeShown;                        // true if drawn instead of the items
+    SHAPE_POLY_SET     m_pendingCompositeShape;                 // written by m_compositeWorker
+    std::atomic<bool>  m_compositeCancelled;
+    std::future<bool>  m_compositeWorker;                       // builds m_pendingCompositeShape
+    bool               m_unloaded;                              // true if the items are freed, see Unload()
     /**
      * test for an end of line
      * if a end of line is found:
      *   read a new line
-     * @param aBuff = buffer (size = GERBER_BUFZ) to fill with a new line
-     * @param aText = pointer to the last useful char in aBuff
+     * @param aText = pointer to the last useful char of the current line
      *          on return: points the beginning of the next line.
-     * @param aBuffSize = the size in bytes of aBuff
-     * @param aFile = the opened GERBER file to read
      * @return a pointer to the beginning of the next line or NULL if end of file
     */
-    char* GetNextLine( char *aBuff, unsigned int aBuffSize, char* aText, FILE* aFile );
+    char* GetNextLine( char* aText );
 
-    bool GetEndOfBlock( char* aBuff, unsigned int aBuffSize, char*& aText, FILE* aGerberFile );
+    bool GetEndOfBlock( char*& aText );
 
     /**
       * reads a single RS274X command terminated with a %
      */
-    bool ReadRS274XCommand( char *aBuff, unsigned int aBuffSize, char*& aText );
+    bool ReadRS274XCommand( char*& aText );
 
     /**
      * executes a RS274X command
      */
-    bool ExecuteRS274XCommand( int aCommand, char* aBuff,
-                               unsigned int aBuffSize, char*& aText );
+    bool ExecuteRS274XCommand( int aCommand, char*& aText );
 
     /**
      * reads two bytes of data and assembles them into an int with the first
@@ -223,16 +236,12 @@ private:
 
     /**
      * reads in an aperture macro and saves it in m_aperture_macros.
-     * @param aBuff a character buffer at least GERBER_BUFZ long that can be
-     *          used to read successive lines from the gerber file.
+     * The next lines of the macro are read from m_lineReader.
      * @param text A reference to a character pointer which gives the initial
      *              text to read from.
-     * @param aBuffSize is the size of aBuff
-     * @param gerber_file Which file to read from for continuation.
      * @return bool - true if a macro was read in successfully, else false.
      */
-    bool ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
-                            char* & text, FILE * gerber_file );
+    bool ReadApertureMacro( char* & text );
 
     // functions to execute G commands or D basic commands:
     bool    Execute_G_Command( char*& text, int G_command );
@@ -270,10 +279,24 @@ public:
     COLOR4D GetPositiveDrawColor() const { return m_PositiveDrawColor; }
 
     /**
-     * Function GetItemsList
-     * @return the first GERBER_DRAW_ITEM * item of the items list
+     * Function GetItems
+     * @return the list of the draw items of the image
+     */
+    GERBER_DRAW_ITEMS& GetItems() { return m_Drawings; }
+
+    /**
+     * Function GetSharedNetAttributes
+     * @return a copy of the current net attributes (m_NetAttributeDict) shared by all the
+     * items drawn until they change, or NULL if there is no attribute
+     */
+    const std::shared_ptr<const GBR_NETLIST_METADATA>& GetSharedNetAttributes();
+
+    /**
+     * Function NetAttributesChanged
+     * must be called after changing m_NetAttributeDict, so that the next items do not share
+     * the attributes of the previous ones
      */
-    GERBER_DRAW_ITEM * GetItemsList();
+    void NetAttributesChanged() { m_sharedNetAttributes.reset(); }
 
     /**
      * Function GetLayerParams
@@ -292,6 +315,103 @@ public:
      */
     bool HasNegativeItems();
 
+    /**
+     * Function PrepareItemShapes
+     * builds the polygons the painter builds when drawing (the shapes of the D_CODEs and of
+     * the segments drawn by a rectangular aperture), so TransformItemToPolygon() only reads
+     * the items.  Must be called from the main thread.
+     */
+    void PrepareItemShapes();
+
+    /**
+     * Function TransformItemToPolygon
+     * appends the shape of aItem, as drawn by the painter in filled mode, to aShape (in AB
+     * coordinates).  Only reads aItem, once PrepareItemShapes() was called for its image.
+     */
+    static void TransformItemToPolygon( const GERBER_DRAW_ITEM* aItem, SHAPE_POLY_SET& aShape );
+
+    /**
+     * Function BuildCompositeShape
+     * builds the dark area of the image: the items are merged in file order, and each run
+     * of clear (negative) items is subtracted from the dark items drawn before it.
+     * The items are only read, so it can run in a worker thread.
+     * @param aShape = the buffer receiving the area, fractured
+     * @param aCancelled = polled to stop early
+     * @return false if stopped by aCancelled
+     */
+    bool BuildCompositeShape( SHAPE_POLY_SET& aShape, const std::atomic<bool>& aCancelled );
+
+    /**
+     * Function StartCompositeShape
+     * starts building the composite shape of an image having negative items in a worker
+     * thread.  Must be called from the main thread, once the file is loaded.
+     * @return false if the image does not need a composite shape
+     */
+    bool StartCompositeShape();
+
+    /**
+     * Function UpdateCompositeShape
+     * takes the composite shape when its worker has finished.
+     * @return true if the composite shape has just become available
+     */
+    bool UpdateCompositeShape();
+
+    /**
+     * @return true while the worker of StartCompositeShape() is running
+     */
+    bool IsCompositeShapePending() const { return m_compositeWorker.valid(); }
+
+    bool HasCompositeShape() const { return m_hasCompositeShape; }
+
+    const SHAPE_POLY_SET& GetCompositeShape() const { return m_compositeShape; }
+
+    /**
+     * Function SetCompositeShown
+     * selects whether the composite shape is drawn (the image being in the VIEW) instead of
+     * the dark and clear items of the image.  The caller updates the VIEW.
+     */
+    void SetCompositeShown( bool aShown ) { m_compositeShown = aShown; }
+
+    bool IsCompositeShown() const { return m_compositeShown; }
+
+    /**
+     * Function GetMemoryUsage
+     * @return an estimate of the memory used by the image, its items and their shapes,
+     * in bytes
+     */
+    size_t GetMemoryUsage() const;
+
+    /**
+     * Function CanUnload
+     * @return true if the file of the image can be read again by Reload(): it still exists
+     * and has not been modified since it was read.  A file extracted from a zip archive
+     * is a temporary file, so such an image cannot be unloaded.
+     */
+    bool CanUnload() const;
+
+    /**
+     * Function Unload
+     * frees the items and the apertures of the image, keeping the file name, the X2
+     * attributes and the highlight lists used by the layers manager and the toolbars.
+     * The composite shape must not be in the VIEW.
+     */
+    void Unload();
+
+    bool IsUnloaded() const { return m_unloaded; }
+
+    /**
+     * Function Reload
+     * reads again the file of the image in a new image.  Can run in a worker thread.
+     * @return the new image, or NULL if the file cannot be read
+     */
+    virtual GERBER_FILE_IMAGE* Reload() const;
+
+    ///> @copydoc VIEW_ITEM::ViewBBox()
+    virtual const BOX2I ViewBBox() const override;
+
+    ///> @copydoc VIEW_ITEM::ViewGetLayers()
+    virtual void ViewGetLayers( int aLayers[], int& aCount ) const override;
+
     /**
      * Function ClearMessageList
      * Clear the message list
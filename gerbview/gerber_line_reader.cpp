@@ -0,0 +1,100 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file gerber_line_reader.cpp
+ */
+
+#include <gerber_line_reader.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include <wx/filefn.h>
+
+
+// The size of the blocks read from the file
+#define READ_BLOCK_SIZE ( 1024 * 1024 )
+
+
+bool GERBER_LINE_READER::Open( const wxString& aFileName )
+{
+    Close();
+
+    FILE* file = wxFopen( aFileName, wxT( "rb" ) );
+
+    if( file == NULL )
+        return false;
+
+    size_t count;
+
+    do
+    {
+        size_t size = m_data.size();
+
+        m_data.resize( size + READ_BLOCK_SIZE );
+        count = fread( m_data.data() + size, 1, READ_BLOCK_SIZE, file );
+        m_data.resize( size + count );
+    } while( count == READ_BLOCK_SIZE );
+
+    fclose( file );
+
+    m_data.push_back( 0 );
+
+    return true;
+}
+
+
+void GERBER_LINE_READER::Close()
+{
+    // swap() actually releases the memory, unlike clear()
+    std::vector<char>().swap( m_data );
+    m_next = 0;
+    m_line = nullptr;
+}
+
+
+char* GERBER_LINE_READER::ReadLine()
+{
+    // Only the final 0 is left (or nothing, if the reader is closed)
+    if( m_next + 1 >= m_data.size() )
+        return nullptr;
+
+    char*  line = m_data.data() + m_next;
+    size_t remaining = m_data.size() - 1 - m_next;
+    char*  end = (char*) memchr( line, '\n', remaining );
+
+    if( end )
+    {
+        *end = 0;
+        m_next += end - line + 1;
+    }
+    else
+    {
+        m_next += remaining;
+    }
+
+    m_line = line;
+
+    return line;
+}
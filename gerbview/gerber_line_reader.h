@@ -0,0 +1,81 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file gerber_line_reader.h
+ */
+
+#ifndef GERBER_LINE_READER_H
+#define GERBER_LINE_READER_H
+
+#include <vector>
+
+#include <wx/string.h>
+
+/**
+ * Reads the lines of a Gerber file from a copy of the whole file in memory.
+ *
+ * The file is read by large blocks, and each line is terminated in place when it is
+ * read, so reading a line neither copies it nor limits its length, unlike fgets() in
+ * a fixed size buffer.
+ */
+class GERBER_LINE_READER
+{
+public:
+    GERBER_LINE_READER() :
+        m_next( 0 ),
+        m_line( nullptr )
+    {
+    }
+
+    /**
+     * Read the whole file aFileName in memory.
+     * @return false if the file cannot be opened.
+     */
+    bool Open( const wxString& aFileName );
+
+    /**
+     * Release the data of the file.
+     */
+    void Close();
+
+    /**
+     * Terminate the next line of the file in place.
+     * @return the beginning of this line, without its '\n' terminator,
+     * or nullptr at the end of the file.
+     */
+    char* ReadLine();
+
+    /**
+     * @return the line returned by the last ReadLine() call (for messages),
+     * or an empty string.
+     */
+    const char* Line() const { return m_line ? m_line : ""; }
+
+private:
+    std::vector<char> m_data;   ///< the file, followed by a 0
+    size_t            m_next;   ///< the offset of the next line in m_data
+    char*             m_line;   ///< the last line returned by ReadLine()
+};
+
+#endif  // GERBER_LINE_READER_H
@@ -35,6 +35,7 @@
 #include <gerbview_id.h>
 #include <gerber_file_image.h>
 #include <gerber_file_image_list.h>
+#include <gerber_compare.h>
 #include <dialog_helpers.h>
 #include <DCodeSelectionbox.h>
 #include <gerbview_layer_widget.h>
@@ -52,6 +53,10 @@
 #include <view/view.h>
 #include <gerbview_painter.h>
 #include <geometry/shape_poly_set.h>
+#include <widgets/progress_reporter.h>
+#include <confirm.h>
+
+#include <wx/textdlg.h>
 
 
 // Config keywords
@@ -88,6 +93,12 @@ GERBVIEW_FRAME::GERBVIEW_FRAME( KIWAY* aKiway, wxWindow* aParent ):
     m_displayMode   = 0;
     m_AboutTitle = "GerbView";
 
+    m_comparePixelSize = KiROUND( 0.01 * IU_PER_MM );
+
+    m_compositeTimer.SetOwner( this );
+    Connect( m_compositeTimer.GetId(), wxEVT_TIMER,
+             wxTimerEventHandler( GERBVIEW_FRAME::onCompositeTimer ), NULL, this );
+
     SHAPE_POLY_SET dummy;   // A ugly trick to force the linker to include
                             // some methods in code and avoid link errors
 
@@ -223,6 +234,7 @@ GERBVIEW_FRAME::GERBVIEW_FRAME( KIWAY* aKiway, wxWindow* aParent ):
 
 GERBVIEW_FRAME::~GERBVIEW_FRAME()
 {
+    ClearLayersComparison();
     GetCanvas()->GetView()->Clear();
 
     GetGerberLayout()->GetImagesList()->DeleteAllImages();
@@ -233,6 +245,7 @@ GERBVIEW_FRAME::~GERBVIEW_FRAME()
 void GERBVIEW_FRAME::OnCloseWindow( wxCloseEvent& Event )
 {
     GetCanvas()->StopDrawing();
+    ClearLayersComparison();
     GetCanvas()->GetView()->Clear();
 
     if( m_toolManager )
@@ -276,24 +289,45 @@ bool GERBVIEW_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
         const unsigned limit = std::min( unsigned( aFileSet.size() ),
                                          unsigned( GERBER_DRAWLAYERS_COUNT ) );
 
-        int layer = 0;
+        // The Gerber and drill files are loaded at once, from the first layer.  A job file
+        // replaces the files loaded before it.
+        wxArrayString    filenames;
+        std::vector<int> fileTypes;
+        bool             jobFileLoaded = false;
 
-        for( unsigned i = 0; i < limit; ++i, ++layer )
+        for( unsigned i = 0; i < limit; ++i )
         {
-            SetActiveLayer( layer );
-
             // Try to guess the type of file by its ext
             // if it is .drl (Kicad files), .nc or .xnc it is a drill file
             wxFileName fn( aFileSet[i] );
             wxString ext = fn.GetExt();
 
+            if( ext == GerberJobFileExtension )
+            {
+                LoadGerberJobFile( aFileSet[i] );
+                jobFileLoaded = true;
+                filenames.Clear();
+                fileTypes.clear();
+                continue;
+            }
+
+            fn.MakeAbsolute();
+            filenames.Add( fn.GetFullPath() );
+            m_mruPath = fn.GetPath();
+
             if( ext == DrillFileExtension ||    // our Excellon format
                 ext == "nc" || ext == "xnc" )   // alternate ext for Excellon format
-                LoadExcellonFiles( aFileSet[i] );
-            else if( ext == GerberJobFileExtension )
-                LoadGerberJobFile( aFileSet[i] );
+                fileTypes.push_back( 1 );
             else
-                LoadGerberFiles( aFileSet[i] );
+                fileTypes.push_back( 0 );
+        }
+
+        if( !filenames.IsEmpty() )
+        {
+            SetActiveLayer( jobFileLoaded ? getNextAvailableLayer() : 0 );
+
+            wxBusyCursor wait;
+            loadListOfGerberAndDrillFiles( wxEmptyString, filenames, &fileTypes );
         }
     }
 
@@ -443,10 +477,10 @@ void GERBVIEW_FRAME::SetElementVisibility( int aLayerID, bool aNewState )
 
         view->UpdateAllItemsConditionally( KIGFX::REPAINT, []( KIGFX::VIEW_ITEM* aItem )
         {
-            auto item = static_cast<GERBER_DRAW_ITEM*>( aItem );
+            auto item = dynamic_cast<GERBER_DRAW_ITEM*>( aItem );
 
             // GetLayerPolarity() returns true for negative items
-            return item->GetLayerPolarity();
+            return item && item->GetLayerPolarity();
         } );
         break;
     }
@@ -477,6 +511,7 @@ void GERBVIEW_FRAME::SetElementVisibility( int aLayerID, bool aNewState )
     }
 
     applyDisplaySettingsToGAL();
+    SyncCompositeShapes();
     m_LayersManager->SetRenderState( aLayerID, aNewState );
 }
 
@@ -493,6 +528,88 @@ void GERBVIEW_FRAME::applyDisplaySettingsToGAL()
 }
 
 
+void GERBVIEW_FRAME::StartCompositeShapes()
+{
+    bool started = false;
+
+    for( unsigned layer = 0; layer < ImagesMaxCount(); ++layer )
+    {
+        GERBER_FILE_IMAGE* gerber = GetGbrImage( layer );
+
+        if( gerber && gerber->StartCompositeShape() )
+            started = true;
+    }
+
+    if( started )
+        m_compositeTimer.Start( 100 );
+}
+
+
+void GERBVIEW_FRAME::onCompositeTimer( wxTimerEvent& aEvent )
+{
+    bool pending = false;
+    bool updated = false;
+
+    for( unsigned layer = 0; layer < ImagesMaxCount(); ++layer )
+    {
+        GERBER_FILE_IMAGE* gerber = GetGbrImage( layer );
+
+        if( !gerber )
+            continue;
+
+        if( gerber->UpdateCompositeShape() )
+            updated = true;
+
+        if( gerber->IsCompositeShapePending() )
+            pending = true;
+    }
+
+    if( !pending )
+        m_compositeTimer.Stop();
+
+    if( updated )
+        SyncCompositeShapes();
+}
+
+
+void GERBVIEW_FRAME::SyncCompositeShapes()
+{
+    auto view = GetCanvas()->GetView();
+    auto painter = static_cast<KIGFX::GERBVIEW_PAINTER*>( view->GetPainter() );
+    bool canShow = painter->GetSettings()->CanShowCompositeShapes();
+    bool changed = false;
+
+    for( unsigned layer = 0; layer < ImagesMaxCount(); ++layer )
+    {
+        GERBER_FILE_IMAGE* gerber = GetGbrImage( layer );
+
+        if( !gerber )
+            continue;
+
+        bool show = canShow && gerber->HasCompositeShape();
+
+        if( show == gerber->IsCompositeShown() )
+            continue;
+
+        gerber->SetCompositeShown( show );
+
+        if( show )
+            view->Add( gerber );
+        else
+            view->Remove( gerber );
+
+        // The items of the image are drawn (or skipped) again
+        for( GERBER_DRAW_ITEM* item : gerber->GetItems() )
+            view->Update( item, KIGFX::REPAINT );
+
+        changed = true;
+    }
+
+    if( changed )
+        GetCanvas()->Refresh();
+}
+
+
 int GERBVIEW_FRAME::getNextAvailableLayer( int aLayer ) const
 {
     int layer = aLayer;
@@ -606,6 +723,170 @@ void GERBVIEW_FRAME::Liste_D_Codes()
 }
 
 
+void GERBVIEW_FRAME::ListMemoryUsage()
+{
+    wxString      line;
+    wxArrayString list;
+    size_t        totalItems = 0;
+    size_t        totalUsage = 0;
+
+    for( int layer = 0; layer < (int)ImagesMaxCount(); ++layer )
+    {
+        GERBER_FILE_IMAGE* gerber = GetGbrImage( layer );
+
+        if( gerber == NULL )
+            continue;
+
+        size_t items = gerber->GetItems().GetCount();
+        size_t usage = gerber->GetMemoryUsage();
+
+        line.Printf( wxT( "layer %2.2d:   %s   %lu items   %.2f MB" ),
+                     layer + 1,
+                     GetImagesList()->GetDisplayName( layer, true ),
+                     (unsigned long) items,
+                     usage / ( 1024.0 * 1024.0 ) );
+
+        if( gerber->IsUnloaded() )
+            line += _( " (unloaded)" );
+        else if( !IsLayerVisible( layer ) && !gerber->CanUnload() )
+            line += _( " (cannot be unloaded)" );
+
+        list.Add( line );
+        totalItems += items;
+        totalUsage += usage;
+    }
+
+    line.Printf( wxT( "total:   %lu items   %.2f MB" ), (unsigned long) totalItems,
+                 totalUsage / ( 1024.0 * 1024.0 ) );
+    list.Add( line );
+
+    wxSingleChoiceDialog    dlg( this, wxEmptyString, _( "Memory Usage" ), list, (void**) NULL,
+                                 wxCHOICEDLG_STYLE & ~wxCANCEL );
+
+    dlg.ShowModal();
+}
+
+
+void GERBVIEW_FRAME::CompareLayers()
+{
+    int reference = GetActiveLayer();
+
+    if( GetGbrImage( reference ) == NULL )
+    {
+        DisplayError( this, _( "No file is loaded on the active layer." ) );
+        return;
+    }
+
+    wxArrayString    names;
+    std::vector<int> layers;
+
+    for( int layer = 0; layer < (int)ImagesMaxCount(); ++layer )
+    {
+        if( layer != reference && GetGbrImage( layer ) )
+        {
+            names.Add( GetImagesList()->GetDisplayName( layer ) );
+            layers.push_back( layer );
+        }
+    }
+
+    if( layers.empty() )
+    {
+        DisplayError( this, _( "Load another file to compare with the active layer." ) );
+        return;
+    }
+
+    wxSingleChoiceDialog layerDlg( this, _( "Compare the active layer with:" ),
+                                   _( "Compare Layers" ), names );
+
+    if( layerDlg.ShowModal() != wxID_OK )
+        return;
+
+    int compared = layers[layerDlg.GetSelection()];
+
+    wxTextEntryDialog sizeDlg( this, _( "Pixel size (the smallest difference found):" ),
+                               _( "Compare Layers" ),
+                               StringFromValue( GetUserUnits(), m_comparePixelSize, true ) );
+
+    if( sizeDlg.ShowModal() != wxID_OK )
+        return;
+
+    int pixelSize = ValueFromString( GetUserUnits(), sizeDlg.GetValue() );
+
+    if( pixelSize <= 0 )
+    {
+        DisplayError( this, _( "The pixel size must be greater than 0." ) );
+        return;
+    }
+
+    m_comparePixelSize = pixelSize;
+
+    // The layers can have been unloaded while hidden
+    LSET layerMask;
+    layerMask.set( reference );
+    layerMask.set( compared );
+    ReloadLayers( layerMask );
+
+    GERBER_IMAGE_COMPARE compare( pixelSize );
+
+    // Beyond that, the comparison of the tiles takes minutes
+    static const double maxPixels = 1e9;
+
+    if( compare.GetPixelCount( GetGbrImage( reference ), GetGbrImage( compared ) ) > maxPixels
+            && !IsOK( this, _( "The pixel size is very small for the size of the layers.\n"
+                               "The comparison can be very long.  Continue?" ) ) )
+    {
+        return;
+    }
+
+    ClearLayersComparison();
+
+    bool ok;
+
+    {
+        WX_PROGRESS_REPORTER progress( this, _( "Compare Layers" ), 3 );
+        ok = compare.Compare( GetGbrImage( reference ), GetGbrImage( compared ), &progress );
+    }
+
+    if( !ok )
+        return;
+
+    if( compare.GetDifferentPixelCount() == 0 )
+    {
+        DisplayInfoMessage( this, _( "No difference found at this pixel size." ) );
+        return;
+    }
+
+    m_compareItem = std::make_unique<GERBER_COMPARE_ITEM>( compare );
+    GetCanvas()->GetView()->Add( m_compareItem.get() );
+    GetCanvas()->Refresh();
+
+    double pixelArea = double( pixelSize ) * pixelSize;
+    double unitsArea = GetUserUnits() == INCHES ? IU_PER_MILS * 1000 : IU_PER_MM;
+
+    unitsArea *= unitsArea;
+
+    wxString msg;
+    msg.Printf( _( "%d areas removed (in red), %d areas added (in green).\n"
+                   "Total area of the differences: %.4f %s." ),
+                compare.GetRemovedArea().OutlineCount(),
+                compare.GetAddedArea().OutlineCount(),
+                compare.GetDifferentPixelCount() * pixelArea / unitsArea,
+                GetUserUnits() == INCHES ? wxT( "sq. in" ) : wxT( "sq. mm" ) );
+    DisplayInfoMessage( this, msg );
+}
+
+
+void GERBVIEW_FRAME::ClearLayersComparison()
+{
+    if( !m_compareItem )
+        return;
+
+    GetCanvas()->GetView()->Remove( m_compareItem.get() );
+    m_compareItem.reset();
+    GetCanvas()->Refresh();
+}
+
+
 void GERBVIEW_FRAME::SortLayersByX2Attributes()
 {
     auto remapping = GetImagesList()->SortImagesByZOrder();
@@ -639,6 +920,7 @@ void GERBVIEW_FRAME::UpdateDisplayOptions( const GBR_DISPLAY_OPTIONS& aOptions )
     m_DisplayOptions = aOptions;
 
     applyDisplaySettingsToGAL();
+    SyncCompositeShapes();
 
     auto view = GetCanvas()->GetView();
 
@@ -646,7 +928,10 @@ void GERBVIEW_FRAME::UpdateDisplayOptions( const GBR_DISPLAY_OPTIONS& aOptions )
     {
         view->UpdateAllItemsConditionally( KIGFX::REPAINT, []( KIGFX::VIEW_ITEM* aItem )
         {
-            auto item = static_cast<GERBER_DRAW_ITEM*>( aItem );
+            auto item = dynamic_cast<GERBER_DRAW_ITEM*>( aItem );
+
+            if( !item )
+                return false;
 
             switch( item->m_Shape )
             {
@@ -666,7 +951,10 @@ void GERBVIEW_FRAME::UpdateDisplayOptions( const GBR_DISPLAY_OPTIONS& aOptions )
     {
         view->UpdateAllItemsConditionally( KIGFX::REPAINT, []( KIGFX::VIEW_ITEM* aItem )
         {
-            auto item = static_cast<GERBER_DRAW_ITEM*>( aItem );
+            auto item = dynamic_cast<GERBER_DRAW_ITEM*>( aItem );
+
+            if( !item )
+                return false;
 
             switch( item->m_Shape )
             {
@@ -684,9 +972,9 @@ void GERBVIEW_FRAME::UpdateDisplayOptions( const GBR_DISPLAY_OPTIONS& aOptions )
     {
         view->UpdateAllItemsConditionally( KIGFX::REPAINT, []( KIGFX::VIEW_ITEM* aItem )
         {
-            auto item = static_cast<GERBER_DRAW_ITEM*>( aItem );
+            auto item = dynamic_cast<GERBER_DRAW_ITEM*>( aItem );
 
-            return ( item->m_Shape == GBR_POLYGON );
+            return item && ( item->m_Shape == GBR_POLYGON );
         } );
     }
 
@@ -789,6 +1077,9 @@ LSET GERBVIEW_FRAME::GetVisibleLayers() const
 
 void GERBVIEW_FRAME::SetVisibleLayers( LSET aLayerMask )
 {
+    // The layers unloaded while hidden are read again when shown
+    ReloadLayers( aLayerMask );
+
     if( GetCanvas() )
     {
         for( int i = 0; i < GERBER_DRAWLAYERS_COUNT; i++ )
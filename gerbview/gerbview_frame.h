@@ -34,6 +34,9 @@
 #include <page_info.h>
 #include <gbr_display_options.h>
 #include <colors_design_settings.h>
+#include <wx/timer.h>
+
+#include <memory>
 
 extern COLORS_DESIGN_SETTINGS g_ColorsSettings;
 
@@ -45,6 +48,7 @@ class GBR_LAYER_BOX_SELECTOR;
 class GERBER_DRAW_ITEM;
 class GERBER_FILE_IMAGE;
 class GERBER_FILE_IMAGE_LIST;
+class GERBER_COMPARE_ITEM;
 class REPORTER;
 
 
@@ -171,6 +175,11 @@ private:
 
     bool            m_show_layer_manager_tools;
 
+    wxTimer         m_compositeTimer;   // picks up the composite shapes built in background
+
+    int             m_comparePixelSize; // the resolution of the last layer comparison
+    std::unique_ptr<GERBER_COMPARE_ITEM> m_compareItem;   // the result shown by CompareLayers()
+
     void            updateComponentListSelectBox();
     void            updateNetnameListSelectBox();
     void            updateAperAttributesSelectBox();
@@ -185,8 +194,13 @@ private:
     /// Updates the GAL with display settings changes
     void applyDisplaySettingsToGAL();
 
+    /// Takes the composite shapes whose worker has finished
+    void onCompositeTimer( wxTimerEvent& aEvent );
+
     /**
-     * Loads a list of Gerber and NC drill files and updates the view based on them
+     * Loads a list of Gerber and NC drill files and updates the view based on them.
+     * The files are read at once on the thread pool, then put on the layers in the order
+     * of the list, from the active layer.
      * @param aPath is the base path for the filenames if they are relative
      * @param aFilenameList is a list of filenames to load
      * @param aFileType is a list of type of files to load (0 = Gerber, 1 = NC drill)
@@ -548,10 +562,40 @@ public:
      */
     void Liste_D_Codes();
 
+    /**
+     * Shows the item count and the estimated memory used by each loaded layer
+     */
+    void ListMemoryUsage();
+
+    /**
+     * Compares the active layer with a layer chosen by the user, at a chosen resolution,
+     * and shows the areas dark in only one of them (see GERBER_IMAGE_COMPARE).
+     */
+    void CompareLayers();
+
+    /**
+     * Removes the result of CompareLayers() from the view
+     */
+    void ClearLayersComparison();
+
     // PCB handling
     bool Clear_DrawLayers( bool query );
     void Erase_Current_DrawLayer( bool query );
 
+    /**
+     * Frees the items of the hidden layers, which are read again from their file when they
+     * are shown (see ReloadLayers()).  The layers whose file has been modified or deleted
+     * since it was read stay loaded.
+     * @return the count of unloaded layers
+     */
+    int UnloadHiddenLayers();
+
+    /**
+     * Reads again the files of the layers freed by UnloadHiddenLayers()
+     * @param aLayerMask = the layers to reload (the other ones are left unloaded)
+     */
+    void ReloadLayers( LSET aLayerMask );
+
     void SortLayersByX2Attributes();
 
     /**
@@ -560,6 +604,19 @@ public:
      */
     void UpdateDisplayOptions( const GBR_DISPLAY_OPTIONS& aOptions );
 
+    /**
+     * Starts building in background the composite shapes of the loaded images having
+     * negative items (see GERBER_FILE_IMAGE::BuildCompositeShape()).
+     */
+    void StartCompositeShapes();
+
+    /**
+     * Draws the composite shapes of the images instead of their items when they look the
+     * same with the current render settings, and the items otherwise.  To be called after
+     * changing the display options or the highlighted items.
+     */
+    void SyncCompositeShapes();
+
     // Conversion function
     void ExportDataInPcbnewFormat( wxCommandEvent& event );
 
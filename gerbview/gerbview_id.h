@@ -41,6 +41,9 @@ enum gerbview_ids
     ID_MAIN_MENUBAR = ID_END_LIST,
 
     ID_GERBVIEW_SHOW_LIST_DCODES,
+    ID_GERBVIEW_SHOW_MEMORY_USAGE,
+    ID_GERBVIEW_COMPARE_LAYERS,
+    ID_GERBVIEW_UNLOAD_HIDDEN_LAYERS,
     ID_GERBVIEW_LOAD_DRILL_FILE,
     ID_GERBVIEW_LOAD_JOB_FILE,
     ID_GERBVIEW_LOAD_ZIP_ARCHIVE_FILE,
@@ -175,6 +175,10 @@ bool GERBVIEW_PAINTER::Draw( const VIEW_ITEM* aItem, int aLayer )
         draw( static_cast<GERBER_DRAW_ITEM*>( const_cast<EDA_ITEM*>( item ) ), aLayer );
         break;
 
+    case GERBER_IMAGE_T:
+        draw( static_cast<const GERBER_FILE_IMAGE*>( item ), aLayer );
+        break;
+
     default:
         // Painter does not know how to draw the object
         return false;
@@ -226,6 +230,11 @@ void GERBVIEW_PAINTER::draw( /*const*/ GERBER_DRAW_ITEM* aItem, int aLayer )
         return;
     }
 
+    // The dark area of the image is drawn by the image itself, the clear items removed
+    if( aItem->m_GerberImageFile->IsCompositeShown() && !aItem->IsSelected()
+            && !aItem->IsBrightened() )
+        return;
+
     color = m_gerbviewSettings.GetColor( aItem, aLayer );
 
     // TODO: Should brightened color be a preference?
@@ -394,6 +403,23 @@ void GERBVIEW_PAINTER::draw( /*const*/ GERBER_DRAW_ITEM* aItem, int aLayer )
 }
 
 
+void GERBVIEW_PAINTER::draw( const GERBER_FILE_IMAGE* aImage, int aLayer )
+{
+    if( !aImage->IsCompositeShown() )
+        return;
+
+    COLOR4D color = m_gerbviewSettings.GetColor( aImage, aLayer );
+
+    m_gal->SetNegativeDrawMode( false );
+    m_gal->SetIsFill( true );
+    m_gal->SetIsStroke( false );
+    m_gal->SetFillColor( color );
+
+    // The composite shape is fractured and triangulated by its worker
+    m_gal->DrawPolygon( aImage->GetCompositeShape() );
+}
+
+
 void GERBVIEW_PAINTER::drawPolygon( GERBER_DRAW_ITEM* aParent,
                                     SHAPE_POLY_SET& aPolygon,
                                     bool aFilled )
@@ -547,20 +573,25 @@ void GERBVIEW_PAINTER::drawFlashedShape( GERBER_DRAW_ITEM* aItem, bool aFilled )
 void GERBVIEW_PAINTER::drawApertureMacro( GERBER_DRAW_ITEM* aParent, bool aFilled )
 {
     D_CODE* code = aParent->GetDcodeDescr();
-    APERTURE_MACRO* macro = code->GetMacro();
 
-    SHAPE_POLY_SET* macroShape = macro->GetApertureMacroShape( aParent, aParent->m_Start );
+    // The shape is shared by the flashes of the D_CODE: draw it at the flash position
+    const SHAPE_POLY_SET& macroShape = code->GetMacroShape( aParent );
 
     if( !m_gerbviewSettings.m_polygonFill )
         m_gal->SetLineWidth( m_gerbviewSettings.m_outlineWidth );
 
+    m_gal->Save();
+    m_gal->Translate( VECTOR2D( aParent->GetABPosition( aParent->m_Start ) ) );
+
     if( !aFilled )
     {
-        for( int i = 0; i < macroShape->OutlineCount(); i++ )
-            m_gal->DrawPolyline( macroShape->COutline( i ) );
+        for( int i = 0; i < macroShape.OutlineCount(); i++ )
+            m_gal->DrawPolyline( macroShape.COutline( i ) );
     }
     else
-        m_gal->DrawPolygon( *macroShape );
+        m_gal->DrawPolygon( macroShape );
+
+    m_gal->Restore();
 }
 
 
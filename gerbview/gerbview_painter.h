@@ -128,6 +128,18 @@ public:
         return m_diffMode;
     }
 
+    /**
+     * @return true if the composite shapes of the images (see
+     * GERBER_FILE_IMAGE::BuildCompositeShape()) look like their items: the items are
+     * filled, the negative items are not shown and nothing is highlighted.
+     */
+    bool CanShowCompositeShapes() const
+    {
+        return m_spotFill && m_lineFill && m_polygonFill && !m_showNegativeItems
+                && m_componentHighlightString.IsEmpty() && m_netHighlightString.IsEmpty()
+                && m_attributeHighlightString.IsEmpty();
+    }
+
     /// If set to anything but an empty string, will highlight items with matching component
     wxString m_componentHighlightString;
 
@@ -190,6 +202,7 @@ protected:
 
     // Drawing functions
     void draw( /*const*/ GERBER_DRAW_ITEM* aVia, int aLayer );
+    void draw( const GERBER_FILE_IMAGE* aImage, int aLayer );
 
     /// Helper routine to draw a polygon
     void drawPolygon( GERBER_DRAW_ITEM* aParent, SHAPE_POLY_SET& aPolygon, bool aFilled );
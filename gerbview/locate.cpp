@@ -34,6 +34,7 @@
 #include <gerbview_frame.h>
 #include <gerber_file_image.h>
 #include <gerber_file_image_list.h>
+#include <gerber_collectors.h>
 
 
 /* locate a gerber item and return a pointer to it.
@@ -53,11 +54,39 @@ GERBER_DRAW_ITEM* GERBVIEW_FRAME::Locate( const wxPoint& aPosition, int aTypeloc
 
     GERBER_DRAW_ITEM* gerb_item = nullptr;
 
+    if( GetCanvas() )
+    {
+        // Hit test only the items near ref, found in the VIEW R-tree.
+        // The collected items are sorted by layer, so the first one on a visible layer
+        // is the one found by a search on all layers
+        GERBER_COLLECTOR collector;
+
+        collector.Collect( GetCanvas()->GetView(), ref );
+
+        for( int ii = 0; ii < collector.GetCount(); ++ii )
+        {
+            GERBER_DRAW_ITEM*  item = static_cast<GERBER_DRAW_ITEM*>( collector[ii] );
+            GERBER_FILE_IMAGE* image = GetGbrImage( item->GetLayer() );
+
+            if( image == nullptr || !image->m_IsVisible )
+                continue;
+
+            // Search first on active layer
+            if( item->GetLayer() == GetActiveLayer() )
+            {
+                gerb_item = item;
+                break;
+            }
+
+            if( gerb_item == nullptr )
+                gerb_item = item;
+        }
+    }
     // Search first on active layer
     // A not used graphic layer can be selected. So gerber can be NULL
-    if( gerber && gerber->m_IsVisible )
+    else if( gerber && gerber->m_IsVisible )
     {
-        for( auto item = gerber->GetItemsList(); item; item = item->Next() )
+        for( GERBER_DRAW_ITEM* item : gerber->GetItems() )
         {
             if( item->HitTest( ref ) )
             {
@@ -67,7 +96,7 @@ GERBER_DRAW_ITEM* GERBVIEW_FRAME::Locate( const wxPoint& aPosition, int aTypeloc
         }
     }
 
-    if( gerb_item == nullptr ) // Search on all layers
+    if( gerb_item == nullptr && !GetCanvas() ) // Search on all layers
     {
         for( layer = 0; layer < (int)ImagesMaxCount(); ++layer )
         {
@@ -82,7 +111,7 @@ GERBER_DRAW_ITEM* GERBVIEW_FRAME::Locate( const wxPoint& aPosition, int aTypeloc
             if( layer == GetActiveLayer() )
                 continue;
 
-            for( auto item = gerber->GetItemsList(); item; item = item->Next() )
+            for( GERBER_DRAW_ITEM* item : gerber->GetItems() )
             {
                 if( item->HitTest( ref ) )
                 {
@@ -230,12 +230,23 @@ void GERBVIEW_FRAME::ReCreateMenuBar()
     toolsMenu->Add( _( "&Show Source..." ), _( "Show source file for the current layer" ),
                     ID_GERBVIEW_SHOW_SOURCE, tools_xpm );
 
+    toolsMenu->Add( _( "&Memory Usage..." ), _( "List the memory used by each layer" ),
+                    ID_GERBVIEW_SHOW_MEMORY_USAGE, tools_xpm );
+
     toolsMenu->Add( ACTIONS::measureTool );
 
+    toolsMenu->Add( _( "&Compare Layers..." ),
+                    _( "Show the differences between the active layer and another layer" ),
+                    ID_GERBVIEW_COMPARE_LAYERS, tools_xpm );
+
     toolsMenu->AppendSeparator();
     toolsMenu->Add( _( "Clear Current Layer..." ), _( "Clear the selected graphic layer" ),
                     ID_GERBVIEW_ERASE_CURR_LAYER, delete_sheet_xpm );
 
+    toolsMenu->Add( _( "&Unload Hidden Layers" ),
+                    _( "Free the memory of the hidden layers, read again when shown" ),
+                    ID_GERBVIEW_UNLOAD_HIDDEN_LAYERS, delete_sheet_xpm );
+
     //-- Preferences menu -----------------------------------------------
     //
     auto acceleratedGraphicsCondition = [ this ] ( const SELECTION& aSel ) {
@@ -35,6 +35,9 @@
 #include <html_messagebox.h>
 #include <macros.h>
 
+#include <wx/filename.h>
+
+
 /* Read a gerber file, RS274D, RS274X or RS274X2 format.
  */
 bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
@@ -77,7 +80,7 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
     /* if the gerber file is only a RS274D file
      * (i.e. without any aperture information, but with items), warn the user:
      */
-    if( !gerber->m_Has_DCode && gerber->GetItemsList() )
+    if( !gerber->m_Has_DCode && !gerber->GetItems().IsEmpty() )
     {
         msg = _("Warning: this file has no D-Code definition\n"
                 "It is perhaps an old RS274D file\n"
@@ -93,7 +96,7 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
             // (maybe convert geometry into positives?)
         }
 
-        for( auto item = gerber->GetItemsList(); item; item = item->Next() )
+        for( GERBER_DRAW_ITEM* item : gerber->GetItems() )
             GetCanvas()->GetView()->Add( (KIGFX::VIEW_ITEM*) item );
     }
 
@@ -102,12 +105,6 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
 
 
 
-// size of a single line of text from a gerber file.
-// warning: some files can have *very long* lines, so the buffer must be large.
-#define GERBER_BUFZ 1000000
-// A large buffer to store one line
-static char lineBuffer[GERBER_BUFZ+1];
-
 bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
 {
     int      G_command = 0;        // command number for G commands like G04
@@ -118,12 +115,11 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
     ResetDefaultValues();
 
     // Read the gerber file */
-    m_Current_File = wxFopen( aFullFileName, wxT( "rt" ) );
-
-    if( m_Current_File == 0 )
+    if( !m_lineReader.Open( aFullFileName ) )
         return false;
 
     m_FileName = aFullFileName;
+    m_FileTime = wxFileName( aFullFileName ).GetModificationTime();
 
     LOCALE_IO toggleIo;
 
@@ -131,11 +127,13 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
 
     while( true )
     {
-        if( fgets( lineBuffer, GERBER_BUFZ, m_Current_File ) == NULL )
+        char* line = m_lineReader.ReadLine();
+
+        if( line == NULL )
             break;
 
         m_LineNum++;
-        text = StrPurge( lineBuffer );
+        text = StrPurge( line );
 
         while( text && *text )
         {
@@ -192,7 +190,7 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
                 if( m_CommandState != ENTER_RS274X_CMD )
                 {
                     m_CommandState = ENTER_RS274X_CMD;
-                    ReadRS274XCommand( lineBuffer, GERBER_BUFZ, text );
+                    ReadRS274XCommand( text );
                 }
                 else        //Error
                 {
@@ -211,7 +209,7 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
         }
     }
 
-    fclose( m_Current_File );
+    m_lineReader.Close();
 
     m_InUse = true;
 
@@ -28,6 +28,9 @@
 #include <gerber_file_image.h>
 #include <base_units.h>
 
+#include <algorithm>
+#include <cstring>
+
 
 /* These routines read the text string point from Text.
  * On exit, Text points the beginning of the sequence unread
@@ -69,14 +72,126 @@ int scaletoIU( double aCoord, bool isMetric )
 }
 
 
+// The powers of 10 used to add or remove digits of the integer coordinates
+#define POW10_LIST_SIZE 19
+static const long long pow10_list[POW10_LIST_SIZE] =
+{
+    1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL, 100000000LL,
+    1000000000LL, 10000000000LL, 100000000000LL, 1000000000000LL, 10000000000000LL,
+    100000000000000LL, 1000000000000000LL, 10000000000000000LL, 100000000000000000LL,
+    1000000000000000000LL
+};
+
+
+/*
+ * A number of a coordinate, read by readCoordNumber()
+ */
+struct COORD_NUMBER
+{
+    long long m_Integer;    // the value of the number, without its decimal part
+    double    m_Float;      // the value of the number, if it has a decimal point
+    int       m_Digits;     // the count of digits (sign and decimal point are not counted)
+    bool      m_HasPoint;   // true if the number has a decimal point
+};
+
+
+/*
+ * Function readCoordNumber
+ * reads the number of a coordinate, like 12550, -0.5 or +1.25, and advances Text after it.
+ * The integer value is accumulated while the digits are read, so the text of the number
+ * is converted only when it has a decimal point.
+ */
+static COORD_NUMBER readCoordNumber( char*& Text )
+{
+    COORD_NUMBER number = { 0, 0.0, 0, false };
+    char*        start = Text;
+    bool         negative = false;
+    bool         inInteger = true;      // false after the integer part, like atoi
+
+    if( *Text == '-' || *Text == '+' )
+        negative = *Text++ == '-';
+
+    for( ; IsNumber( *Text ); Text++ )
+    {
+        if( (*Text >= '0') && (*Text <= '9') )
+        {
+            number.m_Digits++;
+
+            if( inInteger && number.m_Digits < POW10_LIST_SIZE )
+                number.m_Integer = number.m_Integer * 10 + ( *Text - '0' );
+        }
+        else
+        {
+            if( *Text == '.' )
+                number.m_HasPoint = true;
+
+            inInteger = false;
+        }
+    }
+
+    if( negative )
+        number.m_Integer = -number.m_Integer;
+
+    if( number.m_HasPoint )
+    {
+        char line[256];
+        int  len = std::min( int( Text - start ), int( sizeof( line ) ) - 1 );
+
+        memcpy( line, start, len );
+        line[len] = 0;
+        number.m_Float = atof( line );
+    }
+    else
+    {
+        number.m_Float = (double) number.m_Integer;
+    }
+
+    return number;
+}
+
+
+/*
+ * Function scaleIntegerCoord
+ * converts the integer number of a X, Y, I or J coordinate to Gerbview internal units
+ * @param aNumber = the number to convert
+ * @param aFmtScale = the count of digits of the decimal part, in the file format
+ * @param aFmtLen = the count of digits of the number, in the file format
+ * @param aNoTrailingZeros = true if the missing trailing zeros must be added
+ * @param aTruncate = true if the extra digits must be removed (Excellon mode)
+ * @param aMetric = true if the coordinates are in mm
+ */
+static int scaleIntegerCoord( const COORD_NUMBER& aNumber, int aFmtScale, int aFmtLen,
+                              bool aNoTrailingZeros, bool aTruncate, bool aMetric )
+{
+    long long value = aNumber.m_Integer;
+
+    if( aNoTrailingZeros )
+    {
+        // no trailing zero format, we need to add missing zeros.
+        if( aNumber.m_Digits < aFmtLen )
+            value *= pow10_list[ std::min( aFmtLen - aNumber.m_Digits, POW10_LIST_SIZE - 1 ) ];
+
+        // Truncate the extra digits if the len is more than expected
+        // because the conversion to internal units expect exactly
+        // aFmtLen digits
+        if( aTruncate && aNumber.m_Digits > aFmtLen )
+            value /= pow10_list[ std::min( aNumber.m_Digits - aFmtLen, POW10_LIST_SIZE - 1 ) ];
+    }
+
+    double real_scale = scale_list[aFmtScale];
+
+    if( aMetric )
+        real_scale = real_scale / 25.4;
+
+    return KiROUND( value * real_scale );
+}
+
+
 wxPoint GERBER_FILE_IMAGE::ReadXYCoord( char*& Text, bool aExcellonMode )
 {
     wxPoint pos;
-    int     type_coord = 0, current_coord, nbdigits;
+    int     type_coord = 0, current_coord;
     bool    is_float   = false;
-    char*   text;
-    char    line[256];
-
 
     if( m_Relative )
         pos.x = pos.y = 0;
@@ -86,74 +201,35 @@ wxPoint GERBER_FILE_IMAGE::ReadXYCoord( char*& Text, bool aExcellonMode )
     if( Text == NULL )
         return pos;
 
-    text = line;
     while( *Text )
     {
         if( (*Text == 'X') || (*Text == 'Y') || (*Text == 'A') )
         {
             type_coord = *Text;
             Text++;
-            text     = line;
-            nbdigits = 0;
-
-            while( IsNumber( *Text ) )
-            {
-                if( *Text == '.' )  // Force decimat format if reading a floating point number
-                    is_float = true;
 
-                // count digits only (sign and decimal point are not counted)
-                if( (*Text >= '0') && (*Text <='9') )
-                    nbdigits++;
-                *(text++) = *(Text++);
-            }
+            COORD_NUMBER number = readCoordNumber( Text );
 
-            *text = 0;
+            // Force decimal format if reading a floating point number
+            if( number.m_HasPoint )
+                is_float = true;
 
             if( is_float )
             {
                 // When X or Y (or A) values are float numbers, they are given in mm or inches
                 if( m_GerbMetric )  // units are mm
-                    current_coord = KiROUND( atof( line ) * IU_PER_MILS / 0.0254 );
+                    current_coord = KiROUND( number.m_Float * IU_PER_MILS / 0.0254 );
                 else    // units are inches
-                    current_coord = KiROUND( atof( line ) * IU_PER_MILS * 1000 );
+                    current_coord = KiROUND( number.m_Float * IU_PER_MILS * 1000 );
             }
             else
             {
                 int fmt_scale = (type_coord == 'X') ? m_FmtScale.x : m_FmtScale.y;
+                int digit_count = (type_coord == 'X') ? m_FmtLen.x : m_FmtLen.y;
 
-                if( m_NoTrailingZeros )
-                {
-                    // no trailing zero format, we need to add missing zeros.
-                    int digit_count = (type_coord == 'X') ? m_FmtLen.x : m_FmtLen.y;
-
-                    while( nbdigits < digit_count )
-                    {
-                        *(text++) = '0';
-                        nbdigits++;
-                    }
-
-                    if( aExcellonMode )
-                    {
-                        // Truncate the extra digits if the len is more than expected
-                        // because the conversion to internal units expect exactly
-                        // digit_count digits
-                        while( nbdigits > digit_count )
-                        {
-                            *(text--) = 0;
-                            nbdigits--;
-                        }
-                    }
-
-                    *text = 0;
-                }
-
-                current_coord = atoi( line );
-                double real_scale = scale_list[fmt_scale];
-
-                if( m_GerbMetric )
-                    real_scale = real_scale / 25.4;
-
-                current_coord = KiROUND( current_coord * real_scale );
+                current_coord = scaleIntegerCoord( number, fmt_scale, digit_count,
+                                                   m_NoTrailingZeros, aExcellonMode,
+                                                   m_GerbMetric );
             }
 
             if( type_coord == 'X' )
@@ -191,70 +267,41 @@ wxPoint GERBER_FILE_IMAGE::ReadIJCoord( char*& Text )
 {
     wxPoint pos( 0, 0 );
 
-    int     type_coord = 0, current_coord, nbdigits;
+    int     type_coord = 0, current_coord;
     bool    is_float   = false;
-    char*   text;
-    char    line[256];
 
     if( Text == NULL )
         return pos;
 
-    text = line;
     while( *Text )
     {
         if( (*Text == 'I') || (*Text == 'J') )
         {
             type_coord = *Text;
             Text++;
-            text     = line;
-            nbdigits = 0;
-            while( IsNumber( *Text ) )
-            {
-                if( *Text == '.' )
-                    is_float = true;
 
-                // count digits only (sign and decimal point are not counted)
-                if( (*Text >= '0') && (*Text <='9') )
-                    nbdigits++;
+            COORD_NUMBER number = readCoordNumber( Text );
 
-                *(text++) = *(Text++);
-            }
+            if( number.m_HasPoint )
+                is_float = true;
 
-            *text = 0;
             if( is_float )
             {
                 // When X or Y values are float numbers, they are given in mm or inches
                 if( m_GerbMetric )  // units are mm
-                    current_coord = KiROUND( atof( line ) * IU_PER_MILS / 0.0254 );
+                    current_coord = KiROUND( number.m_Float * IU_PER_MILS / 0.0254 );
                 else    // units are inches
-                    current_coord = KiROUND( atof( line ) * IU_PER_MILS * 1000 );
+                    current_coord = KiROUND( number.m_Float * IU_PER_MILS * 1000 );
             }
             else
             {
                 int fmt_scale =
                     (type_coord == 'I') ? m_FmtScale.x : m_FmtScale.y;
+                int min_digit =
+                    (type_coord == 'I') ? m_FmtLen.x : m_FmtLen.y;
 
-                if( m_NoTrailingZeros )
-                {
-                    int min_digit =
-                        (type_coord == 'I') ? m_FmtLen.x : m_FmtLen.y;
-                    while( nbdigits < min_digit )
-                    {
-                        *(text++) = '0';
-                        nbdigits++;
-                    }
-
-                    *text = 0;
-                }
-
-                current_coord = atoi( line );
-
-                double real_scale = scale_list[fmt_scale];
-
-                if( m_GerbMetric )
-                    real_scale = real_scale / 25.4;
-
-                current_coord = KiROUND( current_coord * real_scale );
+                current_coord = scaleIntegerCoord( number, fmt_scale, min_digit,
+                                                   m_NoTrailingZeros, false, m_GerbMetric );
             }
             if( type_coord == 'I' )
                 pos.x = current_coord;
@@ -113,7 +113,7 @@ void fillFlashedGBRITEM(  GERBER_DRAW_ITEM* aGbrItem,
     aGbrItem->m_DCode = Dcode_index;
     aGbrItem->SetLayerPolarity( aLayerNegative );
     aGbrItem->m_Flashed = true;
-    aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->m_NetAttributeDict );
+    aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->GetSharedNetAttributes() );
 
     switch( aAperture )
     {
@@ -137,8 +137,8 @@ void fillFlashedGBRITEM(  GERBER_DRAW_ITEM* aGbrItem,
     case APT_MACRO:
         aGbrItem->m_Shape = GBR_SPOT_MACRO;
 
-        // Cache the bounding box for aperture macros
-        aGbrItem->GetDcodeDescr()->GetMacro()->GetApertureMacroShape( aGbrItem, aPos );
+        // Build the shape shared by the flashes of the macro, while loading
+        aGbrItem->GetDcodeDescr()->GetMacroShape( aGbrItem );
         break;
     }
 }
@@ -172,7 +172,7 @@ void fillLineGBRITEM(  GERBER_DRAW_ITEM* aGbrItem,
     aGbrItem->m_DCode = Dcode_index;
     aGbrItem->SetLayerPolarity( aLayerNegative );
 
-    aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->m_NetAttributeDict );
+    aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->GetSharedNetAttributes() );
 }
 
 
@@ -217,7 +217,7 @@ void fillArcGBRITEM(  GERBER_DRAW_ITEM* aGbrItem, int Dcode_index,
     aGbrItem->m_Flashed = false;
 
     if( aGbrItem->m_GerberImageFile )
-        aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->m_NetAttributeDict );
+        aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->GetSharedNetAttributes() );
 
     if( aMultiquadrant )
         center = aStart + aRelCenter;
@@ -339,8 +339,9 @@ static void fillArcPOLY(  GERBER_DRAW_ITEM* aGbrItem,
 {
     /* in order to calculate arc parameters, we use fillArcGBRITEM
      * so we muse create a dummy track and use its geometric parameters
+     * (one for each thread, as several files can be loaded at once)
      */
-    static GERBER_DRAW_ITEM dummyGbrItem( NULL );
+    static thread_local GERBER_DRAW_ITEM dummyGbrItem( NULL );
 
     aGbrItem->SetLayerPolarity( aLayerNegative );
 
@@ -348,7 +349,7 @@ static void fillArcPOLY(  GERBER_DRAW_ITEM* aGbrItem,
                      aStart, aEnd, rel_center, wxSize(0, 0),
                      aClockwise, aMultiquadrant, aLayerNegative );
 
-    aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->m_NetAttributeDict );
+    aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->GetSharedNetAttributes() );
 
     wxPoint   center;
     center = dummyGbrItem.m_ArcCentre;
@@ -549,7 +550,7 @@ bool GERBER_FILE_IMAGE::Execute_G_Command( char*& text, int G_command )
         break;
 
     case GC_TURN_OFF_POLY_FILL:
-        if( m_Exposure && GetItemsList() )    // End of polygon
+        if( m_Exposure && !m_Drawings.IsEmpty() )    // End of polygon
         {
             GERBER_DRAW_ITEM * gbritem = m_Drawings.GetLast();
             gbritem->m_Polygon.Append( gbritem->m_Polygon.Vertex( 0 ) );
@@ -615,8 +616,7 @@ bool GERBER_FILE_IMAGE::Execute_DCODE_Command( char*& text, int D_commande )
             if( !m_Exposure )   // Start a new polygon outline:
             {
                 m_Exposure = true;
-                gbritem    = new GERBER_DRAW_ITEM( this );
-                m_Drawings.Append( gbritem );
+                gbritem = m_Drawings.Add( this );
                 gbritem->m_Shape = GBR_POLYGON;
                 gbritem->m_Flashed = false;
             }
@@ -653,7 +653,7 @@ bool GERBER_FILE_IMAGE::Execute_DCODE_Command( char*& text, int D_commande )
             break;
 
         case 2:     // code D2: exposure OFF (i.e. "move to")
-            if( m_Exposure && GetItemsList() )    // End of polygon
+            if( m_Exposure && !m_Drawings.IsEmpty() )    // End of polygon
             {
                 gbritem = m_Drawings.GetLast();
                 gbritem->m_Polygon.Append( gbritem->m_Polygon.Vertex( 0 ) );
@@ -686,8 +686,7 @@ bool GERBER_FILE_IMAGE::Execute_DCODE_Command( char*& text, int D_commande )
             switch( m_Iterpolation )
             {
             case GERB_INTERPOL_LINEAR_1X:
-                gbritem = new GERBER_DRAW_ITEM( this );
-                m_Drawings.Append( gbritem );
+                gbritem = m_Drawings.Add( this );
 
                 fillLineGBRITEM( gbritem, dcode, m_PreviousPos,
                                  m_CurrentPos, size, GetLayerParams().m_LayerNegative );
@@ -696,8 +695,7 @@ bool GERBER_FILE_IMAGE::Execute_DCODE_Command( char*& text, int D_commande )
 
             case GERB_INTERPOL_ARC_NEG:
             case GERB_INTERPOL_ARC_POS:
-                gbritem = new GERBER_DRAW_ITEM( this );
-                m_Drawings.Append( gbritem );
+                gbritem = m_Drawings.Add( this );
 
                 if( m_LastCoordIsIJPos )
                 {
@@ -741,8 +739,7 @@ bool GERBER_FILE_IMAGE::Execute_DCODE_Command( char*& text, int D_commande )
                 aperture = tool->m_Shape;
             }
 
-            gbritem = new GERBER_DRAW_ITEM( this );
-            m_Drawings.Append( gbritem );
+            gbritem = m_Drawings.Add( this );
             fillFlashedGBRITEM( gbritem, aperture, dcode, m_CurrentPos,
                                 size, GetLayerParams().m_LayerNegative );
             StepAndRepeatItem( *gbritem );
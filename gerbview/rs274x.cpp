@@ -183,7 +183,7 @@ static const wxString fromGerberString( const wxString& aGbrString )
     return text;
 }
 
-bool GERBER_FILE_IMAGE::ReadRS274XCommand( char *aBuff, unsigned int aBuffSize, char*& aText )
+bool GERBER_FILE_IMAGE::ReadRS274XCommand( char*& aText )
 {
     bool ok = true;
     int  code_command;
@@ -213,7 +213,7 @@ bool GERBER_FILE_IMAGE::ReadRS274XCommand( char *aBuff, unsigned int aBuffSize,
 
             default:
                 code_command = ReadXCommandID( aText );
-                ok = ExecuteRS274XCommand( code_command, aBuff, aBuffSize, aText );
+                ok = ExecuteRS274XCommand( code_command, aText );
                 if( !ok )
                     goto exit;
                 break;
@@ -221,14 +221,15 @@ bool GERBER_FILE_IMAGE::ReadRS274XCommand( char *aBuff, unsigned int aBuffSize,
         }
 
         // end of current line, read another one.
-        if( fgets( aBuff, aBuffSize, m_Current_File ) == NULL )
+        aText = m_lineReader.ReadLine();
+
+        if( aText == NULL )
         {
             // end of file
             ok = false;
             break;
         }
         m_LineNum++;
-        aText = aBuff;
     }
 
 exit:
@@ -236,8 +237,7 @@ exit:
 }
 
 
-bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
-                                              unsigned int aBuffSize, char*& aText )
+bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char*& aText )
 {
     int      code;
     int      seq_len;    // not used, just provided
@@ -269,7 +269,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
 
             case 'D':       // Non-standard option for all zeros (leading + tailing)
                 msg.Printf( _( "RS274X: Invalid GERBER format command '%c' at line %d: \"%s\"" ),
-                        'D', m_LineNum, aBuff );
+                        'D', m_LineNum, m_lineReader.Line() );
                 AddMessageToList( msg );
                 msg.Printf( _("GERBER file \"%s\" may not display as intended." ),
                         m_FileName.ToAscii() );
@@ -354,7 +354,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
                 msg.Printf( wxT( "Unknown id (%c) in FS command" ),
                            *aText );
                 AddMessageToList( msg );
-                GetEndOfBlock( aBuff, aBuffSize, aText, m_Current_File );
+                GetEndOfBlock( aText );
                 ok = false;
                 break;
             }
@@ -408,7 +408,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
         m_IsX2_file = true;
     {
         X2_ATTRIBUTE dummy;
-        dummy.ParseAttribCmd( m_Current_File, aBuff, aBuffSize, aText, m_LineNum );
+        dummy.ParseAttribCmd( &m_lineReader, aText, m_LineNum );
 
         if( dummy.IsFileFunction() )
         {
@@ -429,7 +429,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
     case APERTURE_ATTRIBUTE:    // Command %TA
         {
         X2_ATTRIBUTE dummy;
-        dummy.ParseAttribCmd( m_Current_File, aBuff, aBuffSize, aText, m_LineNum );
+        dummy.ParseAttribCmd( &m_lineReader, aText, m_LineNum );
 
         if( dummy.GetAttribute() == ".AperFunction" )
         {
@@ -446,7 +446,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
         {
         X2_ATTRIBUTE dummy;
 
-        dummy.ParseAttribCmd( m_Current_File, aBuff, aBuffSize, aText, m_LineNum );
+        dummy.ParseAttribCmd( &m_lineReader, aText, m_LineNum );
 
         if( dummy.GetAttribute() == ".N" )
         {
@@ -464,13 +464,15 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
             m_NetAttributeDict.m_Cmpref = fromGerberString( dummy.GetPrm( 1 ) );
             m_NetAttributeDict.m_Padname = fromGerberString( dummy.GetPrm( 2 ) );
         }
+
+        NetAttributesChanged();
         }
         break;
 
     case REMOVE_APERTURE_ATTRIBUTE:    // Command %TD ...
         {
         X2_ATTRIBUTE dummy;
-        dummy.ParseAttribCmd( m_Current_File, aBuff, aBuffSize, aText, m_LineNum );
+        dummy.ParseAttribCmd( &m_lineReader, aText, m_LineNum );
         RemoveAttribute( dummy );
         }
         break;
@@ -683,7 +685,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
     case AP_MACRO:  // lines like %AMMYMACRO*
                     // 5,1,8,0,0,1.08239X$1,22.5*
                     // %
-        /*ok = */ReadApertureMacro( aBuff, aBuffSize, aText, m_Current_File );
+        /*ok = */ReadApertureMacro( aText );
         break;
 
     case AP_DEFINITION:
@@ -891,17 +893,17 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
 
     (void) seq_len;     // quiet g++, or delete the unused variable.
 
-    ok = GetEndOfBlock( aBuff, aBuffSize, aText, m_Current_File );
+    ok = GetEndOfBlock( aText );
 
     return ok;
 }
 
 
-bool GERBER_FILE_IMAGE::GetEndOfBlock( char* aBuff, unsigned int aBuffSize, char*& aText, FILE* gerber_file )
+bool GERBER_FILE_IMAGE::GetEndOfBlock( char*& aText )
 {
     for( ; ; )
     {
-        while( (aText < aBuff + aBuffSize) && *aText )
+        while( *aText )
         {
             if( *aText == '*' )
                 return true;
@@ -912,18 +914,19 @@ bool GERBER_FILE_IMAGE::GetEndOfBlock( char* aBuff, unsigned int aBuffSize, char
             aText++;
         }
 
-        if( fgets( aBuff, aBuffSize, gerber_file ) == NULL )
+        aText = m_lineReader.ReadLine();
+
+        if( aText == NULL )
             break;
 
         m_LineNum++;
-        aText = aBuff;
     }
 
     return false;
 }
 
 
-char* GERBER_FILE_IMAGE::GetNextLine( char *aBuff, unsigned int aBuffSize, char* aText, FILE* aFile )
+char* GERBER_FILE_IMAGE::GetNextLine( char* aText )
 {
     for( ; ; )
     {
@@ -935,12 +938,13 @@ char* GERBER_FILE_IMAGE::GetNextLine( char *aBuff, unsigned int aBuffSize, char*
                 ++aText;
                 break;
 
-            case 0:    // End of text found in aBuff: Read a new string
-                if( fgets( aBuff, aBuffSize, aFile ) == NULL )
+            case 0:    // End of text found in the current line: Read a new line
+                aText = m_lineReader.ReadLine();
+
+                if( aText == NULL )
                     return NULL;
 
                 m_LineNum++;
-                aText = aBuff;
                 return aText;
 
             default:
@@ -951,9 +955,7 @@ char* GERBER_FILE_IMAGE::GetNextLine( char *aBuff, unsigned int aBuffSize, char*
 }
 
 
-bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
-                                char*&    aText,
-                                FILE*     gerber_file )
+bool GERBER_FILE_IMAGE::ReadApertureMacro( char*& aText )
 {
     wxString       msg;
     APERTURE_MACRO am;
@@ -976,7 +978,7 @@ bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
         if( *aText == '*' )
             ++aText;
 
-        aText = GetNextLine( aBuff, aBuffSize, aText, gerber_file );
+        aText = GetNextLine( aText );
 
         if( aText == NULL )  // End of File
             return false;
@@ -1002,7 +1004,7 @@ bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
         {
             am.m_localparamStack.push_back( AM_PARAM() );
             AM_PARAM& param = am.m_localparamStack.back();
-            aText = GetNextLine(  aBuff, aBuffSize, aText, gerber_file );
+            aText = GetNextLine( aText );
             if( aText == NULL)   // End of File
                 return false;
             param.ReadParam( aText );
@@ -1011,7 +1013,7 @@ bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
         else if( !isdigit(*aText)  )     // Ill. symbol
         {
             msg.Printf( wxT( "RS274X: Aperture Macro \"%s\": ill. symbol, line: \"%s\"" ),
-                        GetChars( am.name ), GetChars( FROM_UTF8( aBuff ) ) );
+                        GetChars( am.name ), GetChars( FROM_UTF8( m_lineReader.Line() ) ) );
             AddMessageToList( msg );
             primitive_type = AMP_COMMENT;
         }
@@ -1066,7 +1068,7 @@ bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
 
         default:
             msg.Printf( wxT( "RS274X: Aperture Macro \"%s\": Invalid primitive id code %d, line %d: \"%s\"" ),
-                        GetChars( am.name ), primitive_type, m_LineNum, GetChars( FROM_UTF8( aBuff ) ) );
+                        GetChars( am.name ), primitive_type, m_LineNum, GetChars( FROM_UTF8( m_lineReader.Line() ) ) );
             AddMessageToList( msg );
             return false;
         }
@@ -1084,7 +1086,7 @@ bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
 
             AM_PARAM& param = prim.params.back();
 
-            aText = GetNextLine( aBuff, aBuffSize, aText, gerber_file );
+            aText = GetNextLine( aText );
 
             if( aText == NULL)   // End of File
                 return false;
@@ -1117,7 +1119,7 @@ bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
 
                 AM_PARAM& param = prim.params.back();
 
-                aText = GetNextLine( aBuff, aBuffSize, aText, gerber_file );
+                aText = GetNextLine( aText );
 
                 if( aText == NULL )  // End of File
                     return false;
@@ -57,6 +57,7 @@ int GERBVIEW_CONTROL::HighlightControl( const TOOL_EVENT& aEvent )
         m_frame->m_SelComponentBox->SetSelection( 0 );
         m_frame->m_SelNetnameBox->SetSelection( 0 );
         m_frame->m_SelAperAttributesBox->SetSelection( 0 );
+        m_frame->ClearLayersComparison();
 
         settings->m_netHighlightString = "";
         settings->m_componentHighlightString = "";
@@ -85,6 +86,7 @@ int GERBVIEW_CONTROL::HighlightControl( const TOOL_EVENT& aEvent )
         }
     }
 
+    m_frame->SyncCompositeShapes();
     m_frame->GetCanvas()->GetView()->UpdateAllItems( KIGFX::COLOR );
     m_frame->GetCanvas()->Refresh();
 
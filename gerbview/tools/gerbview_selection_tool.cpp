@@ -253,9 +253,8 @@ bool GERBVIEW_SELECTION_TOOL::selectPoint( const VECTOR2I& aWhere, bool aOnDrag
 {
     EDA_ITEM* item = NULL;
     GERBER_COLLECTOR collector;
-    EDA_ITEM* model = getModel<EDA_ITEM>();
 
-    collector.Collect( model, GERBER_COLLECTOR::AllItems, wxPoint( aWhere.x, aWhere.y ) );
+    collector.Collect( getView(), wxPoint( aWhere.x, aWhere.y ) );
 
     // Remove unselectable items
     for( int i = collector.GetCount() - 1; i >= 0; --i )
@@ -0,0 +1,158 @@
+#! /usr/bin/awk -f
+#
+# awk script to decode the glyphs of the newstroke font into the tables read by STROKE_FONT,
+# so the strokes are not decoded at run time:
+#
+# awk -f fontdecode.awk ../../common/newstroke_font.cpp >../../common/newstroke_glyphs.cpp
+
+BEGIN {
+	code0 = 82        # ascii code for R
+	font_offset = -10 # the FONT_OFFSET of the old run time decoding
+
+	for( i = 32; i < 127; i++ )
+		ord[sprintf( "%c", i )] = i
+
+	glyph_count = 0
+	stroke_count = 0
+	point_count = 0
+}
+
+# Each glyph is a string on its own line
+/^[ \t]*"/ {
+	line = $0
+	sub( /^[ \t]*"/, "", line )
+	match( line, /"[^"]*$/ )
+	line = substr( line, 1, RSTART - 1 )
+
+	# Unescape the string
+	s = ""
+	for( i = 1; i <= length( line ); i++ )
+	{
+		c = substr( line, i, 1 )
+
+		if( c == "\\" )
+		{
+			i++
+			c = substr( line, i, 1 )
+		}
+
+		s = s c
+	}
+
+	start_x = ord[substr( s, 1, 1 )] - code0
+	end_x = ord[substr( s, 2, 1 )] - code0
+	min_y = 0
+	max_y = 0
+	first_stroke = stroke_count
+	pen_down = 0
+	points = ""
+	strokes = ""
+	glyph_points = 0
+
+	for( i = 3; i < length( s ); i += 2 )
+	{
+		cx = substr( s, i, 1 )
+		cy = substr( s, i + 1, 1 )
+
+		if( cx == " " && cy == "R" )
+		{
+			# Raise pen
+			pen_down = 0
+			continue
+		}
+
+		if( !pen_down )
+		{
+			if( stroke_count > first_stroke && ( stroke_count - first_stroke ) % 10 == 0 )
+				strokes = strokes "\n                   "
+			else if( stroke_count > first_stroke )
+				strokes = strokes " "
+
+			strokes = strokes point_count ","
+			stroke_count++
+			pen_down = 1
+		}
+
+		x = ord[cx] - code0 - start_x
+		y = ord[cy] - code0 + font_offset
+
+		if( y < min_y )
+			min_y = y
+
+		if( y > max_y )
+			max_y = y
+
+		# Keep the lines of the tables short
+		if( glyph_points && glyph_points % 8 == 0 )
+			points = points "\n                   "
+		else if( glyph_points )
+			points = points " "
+
+		points = points sprintf( "%3d, %3d,", x, y )
+		glyph_points++
+		point_count++
+	}
+
+	code = sprintf( "U+%X", glyph_count + 32 )
+	code = sprintf( "%-8s", code )
+
+	if( points != "" )
+		point_lines = point_lines "    /* " code " */ " points "\n"
+
+	if( strokes != "" )
+		stroke_lines = stroke_lines "    /* " code " */ " strokes "\n"
+
+	glyph_lines = glyph_lines sprintf( "    { %5d, %2d, %3d, %3d, %3d }, /* %s */\n",
+	                                   first_stroke, stroke_count - first_stroke,
+	                                   end_x - start_x, min_y, max_y, code )
+	glyph_count++
+}
+
+END {
+	print "/*"
+	print " * newstroke_glyphs.cpp - glyphs of newstroke_font.cpp decoded by"
+	print " * helpers/tools_to_build_newstroke-font/fontdecode.awk: do not edit."
+	print " *"
+	print " * This program source code file is part of KiCad, a free EDA CAD application."
+	print " *"
+	print " * Copyright (C) 2010 vladimir uryvaev <vovanius@bk.ru>"
+	print " * Copyright (C) 1992-2019 KiCad Developers, see AUTHORS.txt for contributors."
+	print " *"
+	print " * This program is free software; you can redistribute it and/or"
+	print " * modify it under the terms of the GNU General Public License"
+	print " * as published by the Free Software Foundation; either version 2"
+	print " * of the License, or (at your option) any later version."
+	print " *"
+	print " * This program is distributed in the hope that it will be useful,"
+	print " * but WITHOUT ANY WARRANTY; without even the implied warranty of"
+	print " * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the"
+	print " * GNU General Public License for more details."
+	print " *"
+	print " * You should have received a copy of the GNU General Public License"
+	print " * along with this program; if not, you may find one here:"
+	print " * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html"
+	print " * or you may search the http://www.gnu.org website for the version 2 license,"
+	print " * or you may write to the Free Software Foundation, Inc.,"
+	print " * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA"
+	print " */"
+	print ""
+	print "#include <newstroke_font.h>"
+	print ""
+	print "const signed char newstroke_points[] ="
+	print "{"
+	printf "%s", point_lines
+	print "};"
+	print ""
+	print "const int newstroke_strokes[] ="
+	print "{"
+	printf "%s", stroke_lines
+	print "    " point_count
+	print "};"
+	print ""
+	print "const NEWSTROKE_GLYPH newstroke_glyphs[] ="
+	print "{"
+	printf "%s", glyph_lines
+	print "};"
+	print ""
+	print "const int newstroke_glyph_count = " glyph_count ";"
+}
@@ -84,6 +84,187 @@ public:
      */
     bool m_forceThickOutlinesInZones;
 
+    /**
+     * Run the track clearance DRC on several threads
+     * default = true
+     */
+    bool m_parallelTrackDrc;
+
+    /**
+     * Run the DRC on the changed area of the board after each edit
+     * default = false
+     */
+    bool m_realTimeDrc;
+
+    /**
+     * Refill the zones affected by the changed items after each edit
+     * default = false
+     */
+    bool m_autoRefillZones;
+
+    /**
+     * Build the automatic zone refills in a worker thread, keeping the current fills
+     * displayed until the new ones are ready
+     * default = false
+     */
+    bool m_backgroundZoneFill;
+
+    /**
+     * Maximum number of worker threads of the shared thread pool
+     * default = 0 (one thread per core)
+     */
+    int m_maxWorkerThreads;
+
+    /**
+     * Maximum number of threads of the zone fills, the connectivity updates, the DRC, the
+     * 3D viewer and the footprint library loading, each within the shared thread pool
+     * default = 0 (no limit but the pool)
+     */
+    int m_maxZoneFillThreads;
+    int m_maxConnectivityThreads;
+    int m_maxDrcThreads;
+    int m_max3DThreads;
+    int m_maxLibraryLoadThreads;
+
+    /**
+     * Run each worker thread of the shared thread pool on its own core, among the cores the
+     * program is allowed to run on
+     * default = false
+     */
+    bool m_pinWorkerThreads;
+
+    /**
+     * Compute the ratsnest of each net only when it is drawn or read
+     * default = false
+     */
+    bool m_lazyRatsnest;
+
+    /**
+     * Show the timings and item counts of the last connectivity update in the board
+     * message panel
+     * default = false
+     */
+    bool m_showConnectivityStats;
+
+    /**
+     * Minimum number of points of the polygon boolean operations run on several threads
+     * default = 50000, 0 to always use a single thread
+     */
+    int m_parallelBooleanMinPoints;
+
+    /**
+     * Minimum number of footprints, tracks and zones of the boards parsed on several threads
+     * default = 1000, 0 to always use a single thread
+     */
+    int m_parallelBoardLoadMinItems;
+
+    /**
+     * Parse the footprint files of the libraries only when their footprint is used
+     * default = false
+     */
+    bool m_lazyFootprintLoad;
+
+    /**
+     * Write the auto save files of the boards as binary snapshots
+     * default = false
+     */
+    bool m_snapshotAutoSave;
+
+    /**
+     * Save the boards on a background thread
+     * default = false
+     */
+    bool m_backgroundSave;
+
+    /**
+     * Only find again the graphical connections of the changed sheets in the schematic editor
+     * default = true
+     */
+    bool m_incrementalConnectivity;
+
+    /**
+     * Show the frame time and the drawing statistics of the last frame on the GAL canvases
+     * default = false
+     */
+    bool m_showRenderStats;
+
+    /**
+     * Rasterize the Cairo canvas in horizontal bands on the worker threads
+     * default = false
+     */
+    bool m_parallelCairoDrawing;
+
+    /**
+     * Keep the router world between the routing sessions and update it from the board commits
+     * default = true
+     */
+    bool m_incrementalRouterSync;
+
+    /**
+     * Walk around the obstacles in both winding directions at the same time when routing
+     * default = true
+     */
+    bool m_parallelWalkaround;
+
+    /**
+     * Rebuild only the changed layers of the 3D viewer after a board commit
+     * default = true
+     */
+    bool m_incremental3DViewUpdate;
+
+    /**
+     * Draw decimated meshes of the 3D models which are small on the screen in the
+     * OpenGL 3D viewer
+     * default = true
+     */
+    bool m_model3DLevelOfDetail;
+
+    /**
+     * Plot the solder mask by merging only the clusters of close shapes, and flashing
+     * the isolated pads and vias
+     * default = true
+     */
+    bool m_fastSolderMaskPlot;
+
+    /**
+     * The zlib compression level of the PDF page streams, from 0 to 9
+     * default = 6
+     */
+    int m_pdfCompressionLevel;
+
+    /**
+     * Write smaller Gerber files, using aperture macros for the rotated and round rect pads
+     * default = false
+     */
+    bool m_optimizedGerberOutput;
+
+    /**
+     * Write the repeated footprint graphics of the SVG plots as uses of a single symbol
+     * default = false
+     */
+    bool m_svgPlotSymbols;
+
+    /**
+     * Dispatch only the last of the mouse motion events received faster than the tools
+     * handle them
+     * default = false
+     */
+    bool m_coalesceMouseMotion;
+
+    /**
+     * Allocate the items of the boards being loaded from an arena per board, freed at once
+     * when the board is closed
+     * default = false
+     */
+    bool m_boardItemArena;
+
+    /**
+     * Step, in grid cells, of the coarse pass of the footprint autoplacer, refined on the
+     * whole grid around its best positions
+     * default = 4 (1 tries every grid position)
+     */
+    int m_autoplaceCoarseStep;
+
     /**
      * Helper to determine if legacy canvas is allowed (according to platform
      * and config)
@@ -77,6 +77,7 @@ private:
     bool        m_FlagModified;     ///< Indicates current drawing has been modified.
     bool        m_FlagSave;         ///< Indicates automatic file save.
     int         m_UndoRedoCountMax; ///< undo/Redo command Max depth
+    int         m_UndoRedoMemoryMax; ///< undo/Redo memory budget in megabytes, 0 for no budget
 
     /**
      * The cross hair position in logical (drawing) units.  The cross hair is not the cursor
@@ -104,6 +105,12 @@ private:
 
     //----</Old public API now is private, and migratory>------------------------
 
+    /**
+     * Delete the oldest commands of aList going over the undo/redo memory budget.  The
+     * newest command is always kept.
+     */
+    void trimUndoORRedoList( UNDO_REDO_CONTAINER& aList );
+
 
 public:
     static  wxString m_PageLayoutDescrFileName; ///< the name of the page layout descr file,
@@ -160,6 +167,16 @@ public:
      */
     virtual void ClearUndoORRedoList( UNDO_REDO_CONTAINER& aList, int aItemCount = -1 ) = 0;
 
+    /**
+     * Estimate the memory held by a command of the undo/redo lists: the copies of the
+     * changed items and the deleted items it owns.  Used to keep the lists in their
+     * memory budget; screens not giving an estimate have no budget.
+     */
+    virtual size_t GetCommandMemorySize( const PICKED_ITEMS_LIST& aCommand ) const
+    {
+        return 0;
+    }
+
     /**
      * Function ClearUndoRedoList
      * clear undo and redo list, using ClearUndoORRedoList()
@@ -221,6 +238,13 @@ public:
         }
     }
 
+    int GetMaxUndoMemory() const { return m_UndoRedoMemoryMax; }
+
+    void SetMaxUndoMemory( int aMegaBytes )
+    {
+        m_UndoRedoMemoryMax = aMegaBytes > 0 ? aMegaBytes : 0;
+    }
+
     void SetModify()        { m_FlagModified = true; }
     void ClrModify()        { m_FlagModified = false; }
     void SetSave()          { m_FlagSave = true; }
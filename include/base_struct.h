@@ -186,6 +186,9 @@ protected:
     /// Flag bits for editing and other uses.
     STATUS_FLAGS  m_Flags;
 
+    /// Content hash cached by hash_eda_cached(), 0 when it has to be computed again.
+    mutable size_t m_contentHash;
+
 private:
 
     void initVars();
@@ -246,6 +249,16 @@ public:
 
     void SetModified();
 
+    /**
+     * Function InvalidateHash
+     * drops the content hash cached for this item and its parents, which hash their
+     * children.  To be called once the item is changed; SetModified() calls it.
+     */
+    void InvalidateHash();
+
+    size_t GetCachedHash() const { return m_contentHash; }
+    void SetCachedHash( size_t aHash ) const { m_contentHash = aHash; }
+
     int GetState( int type ) const
     {
         return m_Status & type;
@@ -25,6 +25,8 @@
 #ifndef BASIC_GAL_H
 #define BASIC_GAL_H
 
+#include <mutex>
+
 #include <eda_rect.h>
 
 #include <gal/stroke_font.h>
@@ -118,6 +120,8 @@ public:
      */
     virtual void DrawPolyline( const std::deque<VECTOR2D>& aPointList ) override;
 
+    virtual void DrawPolyline( const VECTOR2D aPointList[], int aListSize ) override;
+
     /** Start and end points are defined as 2D-Vectors.
      * @param aStartPoint   is the start point of the line.
      * @param aEndPoint     is the end point of the line.
@@ -149,6 +153,9 @@ private:
     // Apply the roation/translation transform to aPoint
     const VECTOR2D transform( const VECTOR2D& aPoint ) const;
 
+    // Draw, plot or convert a polyline whose corners are already transformed
+    void doDrawPolyline( std::vector<wxPoint>& aLocalPointList );
+
     // A clip box, to clip drawings in a wxDC (mandatory to avoid draw issues)
     EDA_RECT  m_clipBox;        // The clip box
     bool      m_isClipped;      // Allows/disallows clipping
@@ -167,4 +174,7 @@ private:
 
 extern BASIC_GAL basic_gal;
 
+///> Serializes the users of basic_gal, which keeps the attributes of the last text
+extern std::mutex basic_gal_lock;
+
 #endif      // define BASIC_GAL_H
@@ -0,0 +1,124 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file board_item_arena.h
+ */
+
+#ifndef BOARD_ITEM_ARENA_H
+#define BOARD_ITEM_ARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * Class BOARD_ITEM_ARENA
+ *
+ * Holds the memory of the items read with a board file: the items are carved out of large
+ * chunks instead of being allocated one by one, and the chunks are freed together once the
+ * board and all the items of the arena are deleted.  Deleting an item of the arena only runs
+ * its destructor; its memory is not reused.
+ *
+ * The items are allocated from an arena while a SCOPE of this arena is active on the calling
+ * thread, and from the heap otherwise.  Each block starts with a header telling where it
+ * comes from, so the items may be deleted anywhere, and may outlive their board (e.g. in the
+ * undo list or the clipboard).
+ */
+class BOARD_ITEM_ARENA
+{
+public:
+    BOARD_ITEM_ARENA();
+
+    /**
+     * Function Release()
+     * Drops the reference of the owner of the arena.  The chunks are freed when the last
+     * item of the arena is deleted, or now if there is none.
+     */
+    void Release();
+
+    /**
+     * Function Allocate()
+     * Returns a block of aSize bytes, from the arena of the active scope of the calling
+     * thread if there is one, from the heap otherwise.
+     */
+    static void* Allocate( size_t aSize );
+
+    /**
+     * Function Deallocate()
+     * Gives back a block returned by Allocate().
+     */
+    static void Deallocate( void* aBlock );
+
+    /**
+     * Class SCOPE
+     * Makes the items created by the calling thread be allocated from an arena, for the
+     * lifetime of the scope.  A scope of a NULL arena allocates from the heap.
+     */
+    class SCOPE
+    {
+    public:
+        SCOPE( BOARD_ITEM_ARENA* aArena );
+        ~SCOPE();
+
+    private:
+        friend class BOARD_ITEM_ARENA;
+
+        BOARD_ITEM_ARENA* m_arena;
+        SCOPE*            m_previous;
+
+        ///> Free part of the current chunk of this scope
+        char*             m_cursor;
+        char*             m_end;
+    };
+
+private:
+    ///> The arena is deleted by the release of its last reference
+    ~BOARD_ITEM_ARENA() {}
+
+    ///> Returns a new chunk of CHUNK_SIZE bytes
+    char* newChunk();
+
+    void unref();
+
+    ///> Size of the header of the blocks, keeping the items aligned
+    static const size_t HEADER_SIZE = 16;
+
+    static const size_t CHUNK_SIZE = 1 << 20;
+
+    ///> Larger blocks are allocated from the heap
+    static const size_t MAX_BLOCK_SIZE = CHUNK_SIZE / 16;
+
+    ///> One reference for the owner, and one for each block allocated from the arena
+    std::atomic<size_t> m_refCount;
+
+    std::mutex m_chunksLock;
+    std::vector<std::unique_ptr<char[]>> m_chunks;
+
+    ///> Active scope of each thread
+    static thread_local SCOPE* m_scope;
+};
+
+#endif    // BOARD_ITEM_ARENA_H
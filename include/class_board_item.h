@@ -35,6 +35,7 @@
 #include <convert_to_biu.h>
 #include <gr_basic.h>
 #include <layers_id_colors_and_visibility.h>
+#include <board_item_arena.h>
 
 
 class BOARD;
@@ -85,6 +86,17 @@ public:
     // Do not create a copy constructor & operator=.
     // The ones generated by the compiler are adequate.
 
+    ///> Items are allocated from the arena of the board being read, if there is one
+    static void* operator new( size_t aSize )
+    {
+        return BOARD_ITEM_ARENA::Allocate( aSize );
+    }
+
+    static void operator delete( void* aBlock )
+    {
+        BOARD_ITEM_ARENA::Deallocate( aBlock );
+    }
+
     virtual const wxPoint GetPosition() const = 0;
 
     /**
@@ -169,6 +181,17 @@ public:
      */
     virtual void SwapData( BOARD_ITEM* aImage );
 
+    /**
+     * Function InvalidateHashes
+     * drops the content hashes cached for the item, its parents and the items it owns.
+     * To be called when the item is changed by a path which does not change its children
+     * through their own setters (undo, commits of a parent...)
+     */
+    virtual void InvalidateHashes()
+    {
+        InvalidateHash();
+    }
+
     /**
      * Function IsOnLayer
      * tests to see if this object is on the given layer.  Is virtual so
@@ -227,6 +227,12 @@ protected:
     /// Last timestamp when the panel was refreshed
     wxLongLong               m_lastRefresh;
 
+    /// Duration of the last onPaint() call, in milliseconds
+    double                   m_lastFrameTime;
+
+    /// Duration of the last VIEW::Redraw() call, in milliseconds
+    double                   m_lastRedrawTime;
+
     /// Is there a redraw event requested?
     bool                     m_pendingRefresh;
 
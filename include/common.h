@@ -43,8 +43,13 @@
 #include <gal/color4d.h>
 
 #include <atomic>
+#include <locale.h>
 #include <memory>
 
+#if defined( __APPLE__ )
+#include <xlocale.h>        // locale_t
+#endif
+
 // C++11 "polyfill" for the C++14 std::make_unique function
 #include "make_unique.h"
 
@@ -188,6 +193,39 @@ private:
     // The locale in use before switching to the "C" locale
     // (the locale can be set by user, and is not always the system locale)
     std::string m_user_locale;
+
+    // The calling thread has its own "C" locale (see THREAD_LOCALE_IO): nothing to do
+    bool m_threadLocale;
+};
+
+
+/**
+ * Instantiate a "C" numeric locale for the calling thread only, within a scope.
+ *
+ * Unlike LOCALE_IO, the other threads keep the user locale, so a worker thread can read
+ * or write files while the UI goes on.  The LOCALE_IO objects created meanwhile by the
+ * same thread (by the plugins, for instance) leave the global locale alone.
+ */
+class THREAD_LOCALE_IO
+{
+public:
+    THREAD_LOCALE_IO();
+    ~THREAD_LOCALE_IO();
+
+    ///> @return true if the calling thread is in the scope of a THREAD_LOCALE_IO
+    static bool IsActive() { return m_depth > 0; }
+
+private:
+    // allow for nesting of THREAD_LOCALE_IO instantiations in a thread
+    static thread_local int m_depth;
+
+#if defined( _WIN32 )
+    int         m_threadConfig;     // the previous _configthreadlocale() setting
+    std::string m_user_locale;
+#else
+    locale_t    m_cLocale;
+    locale_t    m_userLocale;       // the locale of the thread before switching
+#endif
 };
 
 /**
@@ -29,6 +29,7 @@
  * @file convert_basic_shapes_to_polygon.h
  */
 
+#include <functional>
 #include <vector>
 
 #include <fctsys.h>
@@ -87,6 +88,24 @@ void TransformOvalClearanceToPolygon( SHAPE_POLY_SET& aCornerBuffer,
                                 int aError );
 
 
+/**
+ * Function TransformConvexPolygonToRoundedPolygon
+ * convert a convex polygon inflated by aRadius, with rounded corners, to a polygon.
+ * This gives the same shape as SHAPE_POLY_SET::Inflate() with round corners, but it is
+ * built directly, without Clipper: the corners of the polygon are the centres of the arcs.
+ * Like for Inflate(), the arc points are on the circle, so the polygon is inside the actual
+ * shape: give a radius calculated with a correction factor to have it outside.
+ * @param aCornerBuffer = a buffer to store the polygon
+ * @param aCorners = the corners of the convex polygon, in any orientation
+ * @param aCornerCount = the number of corners (1 gives a circle, 2 an oval)
+ * @param aRadius = the inflate value (must be >= 0)
+ * @param aCircleSegmentsCount = the number of segments to approximate a full circle
+ */
+void TransformConvexPolygonToRoundedPolygon( SHAPE_POLY_SET& aCornerBuffer,
+                                             const wxPoint* aCorners, int aCornerCount,
+                                             int aRadius, int aCircleSegmentsCount );
+
+
 /**
  * Helper function GetRoundRectCornerCenters
  * Has meaning only for rounded rect
@@ -176,4 +195,18 @@ void TransformRingToPolygon( SHAPE_POLY_SET& aCornerBuffer,
                             wxPoint aCentre, int aRadius,
                             int aError, int aWidth );
 
+/**
+ * Function TransformShapesToPolygon
+ * convert many shapes (for instance all the pads and vias of a board) to polygons
+ * in one pass.  Big lists are converted by chunks on the worker threads, each chunk
+ * having its own buffer, and the polygons are appended to aCornerBuffer in the index
+ * order: the result does not depend on the number of threads.
+ * @param aCornerBuffer = a buffer to store the polygons
+ * @param aCount = the number of shapes
+ * @param aTransform = the conversion of a shape: aTransform( i, aBuffer ) appends the
+ *  polygons of shape i to aBuffer.  It can be called from several threads at once.
+ */
+void TransformShapesToPolygon( SHAPE_POLY_SET& aCornerBuffer, size_t aCount,
+        const std::function<void( size_t aIndex, SHAPE_POLY_SET& aBuffer )>& aTransform );
+
 #endif     // CONVERT_BASIC_SHAPES_TO_POLYGON_H
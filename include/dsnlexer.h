@@ -42,6 +42,47 @@ struct KEYWORD
     const char* name;       ///< unique keyword.
     int         token;      ///< a zero based index into an array of KEYWORDs
 };
+
+
+/**
+ * Struct KEYWORD_HASH
+ * is a perfect hash of a KEYWORD table, generated along with the table by the
+ * TokenList2DsnLexer CMake script.  The Hash() of a text selects a bucket, and the
+ * displacement of the bucket gives the only slot where the text can be a keyword.
+ */
+struct KEYWORD_HASH
+{
+    unsigned              bucketCount;
+    unsigned              slotCount;
+    const unsigned short* displacements;    ///< slot displacement of each bucket
+    const short*          slots;            ///< keyword index of each slot, -1 if free
+
+    /**
+     * Function Hash
+     * must stay the same as the hash computed by TokenList2DsnLexer.cmake.
+     */
+    static unsigned Hash( const char* aText, size_t aLength )
+    {
+        unsigned hash = 5381;
+
+        for( size_t ii = 0; ii < aLength; ++ii )
+            hash = ( hash * 33 + (unsigned char) aText[ii] ) % 16777213;
+
+        return hash;
+    }
+
+    /**
+     * Function Slot
+     * @return the index of the only keyword \a aText can be, or -1.
+     */
+    int Slot( const char* aText, size_t aLength ) const
+    {
+        unsigned hash = Hash( aText, aLength );
+        unsigned slot = ( hash / bucketCount + displacements[hash % bucketCount] ) % slotCount;
+
+        return slots[slot];
+    }
+};
 #endif
 
 // something like this macro can be used to help initialize a KEYWORD table.
@@ -111,6 +152,7 @@ protected:
     const KEYWORD*      keywords;               ///< table sorted by CMake for bsearch()
     unsigned            keywordCount;           ///< count of keywords table
     KEYWORD_MAP         keyword_hash;           ///< fast, specialized "C string" hashtable
+    const KEYWORD_HASH* keywordPerfectHash;     ///< generated with keywords, replaces keyword_hash
 
     void init();
 
@@ -169,9 +211,11 @@ public:
      * @param aKeywordCount is the count of tokens in aKeywordTable.
      * @param aFile is an open file, which will be closed when this is destructed.
      * @param aFileName is the name of the file
+     * @param aKeywordHash is the perfect hash of aKeywordTable, if any.
      */
     DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
-              FILE* aFile, const wxString& aFileName );
+              FILE* aFile, const wxString& aFileName,
+              const KEYWORD_HASH* aKeywordHash = NULL );
 
     /**
      * Constructor ( const KEYWORD*, unsigned, const std::string&, const wxString& )
@@ -182,9 +226,11 @@ public:
      * @param aKeywordCount is the count of tokens in aKeywordTable.
      * @param aSExpression is text to feed through a STRING_LINE_READER
      * @param aSource is a description of aSExpression, used for error reporting.
+     * @param aKeywordHash is the perfect hash of aKeywordTable, if any.
      */
     DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
-              const std::string& aSExpression, const wxString& aSource = wxEmptyString );
+              const std::string& aSExpression, const wxString& aSource = wxEmptyString,
+              const KEYWORD_HASH* aKeywordHash = NULL );
 
     /**
      * Constructor ( const std::string&, const wxString& )
@@ -209,9 +255,12 @@ public:
      *
      * @param aLineReader is any subclassed instance of LINE_READER, such as
      *  STRING_LINE_READER or FILE_LINE_READER.  No ownership is taken.
+     *
+     * @param aKeywordHash is the perfect hash of aKeywordTable, if any.  Without it, a
+     *  hashtable of the keywords is built.
      */
     DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
-              LINE_READER* aLineReader = NULL );
+              LINE_READER* aLineReader = NULL, const KEYWORD_HASH* aKeywordHash = NULL );
 
     virtual ~DSNLEXER();
 
@@ -48,6 +48,7 @@ namespace KIGFX
 
 #define DEFAULT_MAX_UNDO_ITEMS 0
 #define ABS_MAX_UNDO_ITEMS (INT_MAX / 2)
+#define DEFAULT_MAX_UNDO_MEMORY 1024    // megabytes
 #define LIB_EDIT_FRAME_NAME                 wxT( "LibeditFrame" )
 #define SCH_EDIT_FRAME_NAME                 wxT( "SchematicFrame" )
 #define PL_EDITOR_FRAME_NAME                wxT( "PlEditorFrame" )
@@ -107,6 +108,8 @@ protected:
                                             // gives 1.0 when the board/schematic is at scale = 1
     int                m_UndoRedoCountMax;  // Default Undo/Redo command Max depth, to be handed
                                             // to screens
+    int                m_UndoRedoMemoryMax; // Default Undo/Redo memory budget in megabytes, to
+                                            // be handed to screens
     bool               m_PolarCoords;       // For those frames that support polar coordinates
 
     TOOL_DISPATCHER*   m_toolDispatcher;
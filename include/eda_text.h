@@ -139,7 +139,11 @@ public:
      * sets pen width.
      * @param aNewThickness is the new pen width
      */
-    void SetThickness( int aNewThickness )      { m_e.penwidth = aNewThickness; };
+    void SetThickness( int aNewThickness )
+    {
+        m_e.penwidth = aNewThickness;
+        m_textBoxValid = false;
+    };
 
     /**
      * Function GetThickness
@@ -169,7 +173,11 @@ public:
     void SetVisible( bool aVisible )            { m_e.Bit( TE_VISIBLE, aVisible ); }
     bool IsVisible() const                      { return m_e.Bit( TE_VISIBLE ); }
 
-    void SetMirrored( bool isMirrored )         { m_e.Bit( TE_MIRROR, isMirrored ); }
+    void SetMirrored( bool isMirrored )
+    {
+        m_e.Bit( TE_MIRROR, isMirrored );
+        m_textBoxValid = false;
+    }
     bool IsMirrored() const                     { return m_e.Bit( TE_MIRROR ); }
 
     /**
@@ -178,14 +186,27 @@ public:
      *  if ok to use only single line text.  (Single line is faster in
      *  calculations than multiline.)
      */
-    void SetMultilineAllowed( bool aAllow )     { m_e.Bit( TE_MULTILINE, aAllow ); }
+    void SetMultilineAllowed( bool aAllow )
+    {
+        m_e.Bit( TE_MULTILINE, aAllow );
+        m_textBoxValid = false;
+    }
     bool IsMultilineAllowed() const             { return m_e.Bit( TE_MULTILINE ); }
 
     EDA_TEXT_HJUSTIFY_T GetHorizJustify() const { return EDA_TEXT_HJUSTIFY_T( m_e.hjustify ); };
     EDA_TEXT_VJUSTIFY_T GetVertJustify() const  { return EDA_TEXT_VJUSTIFY_T( m_e.vjustify ); };
 
-    void SetHorizJustify( EDA_TEXT_HJUSTIFY_T aType )   { m_e.hjustify = aType; };
-    void SetVertJustify( EDA_TEXT_VJUSTIFY_T aType )    { m_e.vjustify = aType; };
+    void SetHorizJustify( EDA_TEXT_HJUSTIFY_T aType )
+    {
+        m_e.hjustify = aType;
+        m_textBoxValid = false;
+    };
+
+    void SetVertJustify( EDA_TEXT_VJUSTIFY_T aType )
+    {
+        m_e.vjustify = aType;
+        m_textBoxValid = false;
+    };
 
     /**
      * Function SetEffects
@@ -205,13 +226,25 @@ public:
 
     bool IsDefaultFormatting() const;
 
-    void SetTextSize( const wxSize& aNewSize )  { m_e.size = aNewSize; };
+    void SetTextSize( const wxSize& aNewSize )
+    {
+        m_e.size = aNewSize;
+        m_textBoxValid = false;
+    };
     const wxSize& GetTextSize() const           { return m_e.size; };
 
-    void SetTextWidth( int aWidth )             { m_e.size.x = aWidth; }
+    void SetTextWidth( int aWidth )
+    {
+        m_e.size.x = aWidth;
+        m_textBoxValid = false;
+    }
     int GetTextWidth() const                    { return m_e.size.x; }
 
-    void SetTextHeight( int aHeight )           { m_e.size.y = aHeight; }
+    void SetTextHeight( int aHeight )
+    {
+        m_e.size.y = aHeight;
+        m_textBoxValid = false;
+    }
     int GetTextHeight() const                   { return m_e.size.y; }
 
     void SetTextPos( const wxPoint& aPoint )    { m_e.pos = aPoint; }
@@ -306,6 +339,8 @@ public:
      * @param aThickness Overrides the current penwidth when greater than 0.
      * This is needed when the current penwidth is 0 and a default penwidth is used.
      * @param aInvertY Invert the Y axis when calculating bounding box.
+     * The area of the full text with its own penwidth is cached: moving the text keeps it,
+     * changing the text, its size, penwidth, justification or mirroring computes it again.
      */
     EDA_RECT GetTextBox( int aLine = -1, int aThickness = -1, bool aInvertY = false ) const;
 
@@ -358,7 +393,18 @@ protected:
     /// Cache of unescaped text for efficient access
     wxString    m_shown_text;
 
+    /**
+     * Function invalidateTextBox
+     * has to be called by the derived classes changing m_shown_text directly.
+     */
+    void invalidateTextBox()                    { m_textBoxValid = false; }
+
 private:
+    /**
+     * Function calcTextBox
+     * computes the area returned by GetTextBox().
+     */
+    EDA_RECT calcTextBox( int aLine, int aThickness, bool aInvertY ) const;
     /**
      * Function printOneLineOfText
      * Used to print each line of this EDA_TEXT, that can be multiline
@@ -376,6 +422,11 @@ private:
     // Private text effects data. API above provides accessor funcs.
     TEXT_EFFECTS    m_e;
 
+    /// Area of the full text, relative to the text position, cached by GetTextBox()
+    mutable EDA_RECT m_textBox;
+    mutable bool     m_textBoxValid;
+    mutable bool     m_textBoxItalic;   ///< italic state of the stroke font used by m_textBox
+
     /// EDA_TEXT effects bools
     enum TE_FLAGS {
         // start at zero, sequence is irrelevant
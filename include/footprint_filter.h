@@ -28,6 +28,9 @@
 /**
  * Footprint display filter. Takes a list of footprints and filtering settings,
  * and provides an iterable view of the filtered data.
+ *
+ * The footprints are matched all at once, in the thread pool, when the view is iterated
+ * after a change of the settings.
  */
 class FOOTPRINT_FILTER
 {
@@ -97,16 +100,6 @@ public:
 
         size_t            m_pos;
         FOOTPRINT_FILTER* m_filter;
-
-        /**
-         * Check if the stored component matches an item by footprint filter.
-         */
-        bool FootprintFilterMatch( FOOTPRINT_INFO& aItem );
-
-        /**
-         * Check if the stored component matches an item by pin count.
-         */
-        bool PinCountMatch( FOOTPRINT_INFO& aItem );
     };
 
     /**
@@ -134,15 +127,38 @@ private:
         FILTERING_BY_NAME               = 0x0008
     };
 
+    /**
+     * The compiled patterns.  A wxRegEx keeps the state of its last match, so each thread
+     * matching the footprints uses its own copy.
+     */
+    struct MATCHERS
+    {
+        EDA_PATTERN_MATCH_WILDCARD                      m_filter;
+        std::vector<std::unique_ptr<EDA_PATTERN_MATCH>> m_footprint_filters;
+    };
+
+    void buildMatchers( MATCHERS& aMatchers ) const;
+
+    /**
+     * Check if aItem matches all the filter criteria.
+     */
+    bool match( FOOTPRINT_INFO& aItem, const MATCHERS& aMatchers ) const;
+
+    /**
+     * Match the whole list in the thread pool, if the list or the criteria changed.
+     */
+    void updateMatches();
+
     FOOTPRINT_LIST* m_list;
 
     wxString                    m_lib_name;
     wxString                    m_filter_pattern;
     int                         m_pin_count;
     int                         m_filter_type;
-    EDA_PATTERN_MATCH_WILDCARD  m_filter;
+    wxArrayString               m_footprint_filters;    ///< lowercase patterns
 
-    std::vector<std::unique_ptr<EDA_PATTERN_MATCH>> m_footprint_filters;
+    std::vector<char>           m_matches;          ///< the match of each item of m_list
+    bool                        m_matches_valid;
 };
 
 #endif // FOOTPRINT_FILTER_H
@@ -37,6 +37,7 @@
 #include <kicad_string.h>
 #include <sync_queue.h>
 #include <lib_tree_item.h>
+#include <string_pool.h>
 
 #include <atomic>
 #include <functional>
@@ -91,13 +92,19 @@ public:
         return LIB_ID( m_nickname, m_fpname );
     }
 
-    const wxString& GetDescription() override
+    wxString GetDescription() override
     {
         ensure_loaded();
         return m_doc;
     }
 
-    const wxString& GetKeywords()
+    COMPACT_STRING GetCompactDescription() override
+    {
+        ensure_loaded();
+        return m_doc;
+    }
+
+    wxString GetKeywords()
     {
         ensure_loaded();
         return m_keywords;
@@ -140,7 +147,30 @@ public:
      */
     bool InLibrary( const wxString& aLibrary ) const;
 
+    /**
+     * @return the footprint name in lowercase, as matched by the footprint filters.
+     */
+    const wxString& GetFilterName() const
+    {
+        return m_filter_name;
+    }
+
+    /**
+     * @return "nickname:name" in lowercase, as matched by the footprint filters giving
+     *         a library name.  Built on request, as few filters give a library name.
+     */
+    wxString GetFilterLibId() const
+    {
+        return m_nickname.Get().Lower() + wxT( ":" ) + m_filter_name;
+    }
+
 protected:
+    /// Build the lowercase key matched by the filters, once the names are set.
+    void setFilterKeys()
+    {
+        m_filter_name = m_fpname.Lower();
+    }
+
     void ensure_loaded()
     {
         if( !m_loaded )
@@ -154,20 +184,23 @@ protected:
 
     bool m_loaded;
 
-    wxString m_nickname;         ///< library as known in FP_LIB_TABLE
-    wxString m_fpname;           ///< Module name.
-    int      m_num;              ///< Order number in the display list.
-    unsigned m_pad_count;        ///< Number of pads
-    unsigned m_unique_pad_count; ///< Number of unique pads
-    wxString m_doc;              ///< Footprint description.
-    wxString m_keywords;         ///< Footprint keywords.
+    INTERNED_STRING m_nickname;         ///< library as known in FP_LIB_TABLE, shared by
+                                        ///< the footprints of the library
+    wxString        m_fpname;           ///< Module name.
+    int             m_num;              ///< Order number in the display list.
+    unsigned        m_pad_count;        ///< Number of pads
+    unsigned        m_unique_pad_count; ///< Number of unique pads
+    COMPACT_STRING  m_doc;              ///< Footprint description, shared with the
+                                        ///< library tree nodes.
+    COMPACT_STRING  m_keywords;         ///< Footprint keywords.
+    wxString        m_filter_name;      ///< Lowercase module name.
 };
 
 
 /// FOOTPRINT object list sort function.
 inline bool operator<( const FOOTPRINT_INFO& item1, const FOOTPRINT_INFO& item2 )
 {
-    int retv = StrNumCmp( item1.m_nickname, item2.m_nickname, false );
+    int retv = StrNumCmp( item1.m_nickname.Get(), item2.m_nickname.Get(), false );
 
     if( retv != 0 )
         return retv < 0;
@@ -36,6 +36,7 @@
 #include <cairo.h>
 #include <boost/smart_ptr/shared_array.hpp>
 #include <deque>
+#include <functional>
 
 namespace KIGFX
 {
@@ -75,6 +76,31 @@ public:
     /// @copydoc COMPOSITOR::Present()
     virtual void Present() override;
 
+    /**
+     * Function SetClipRect()
+     * Restricts drawing to all buffers and ClearBuffer() to a rectangle, until ResetClip()
+     * is called.
+     *
+     * @param aX, aY, aWidth, aHeight is the rectangle in screen coordinates.
+     */
+    void SetClipRect( int aX, int aY, int aWidth, int aHeight );
+
+    /**
+     * Function ResetClip()
+     * Removes the restriction set by SetClipRect().
+     */
+    void ResetClip();
+
+    /**
+     * Function DrawBands()
+     * Splits the current buffer (or its clip rectangle) in horizontal bands, and runs aDraw
+     * for each band on the worker threads.  Every call gets its own context, that draws only
+     * to its band but uses the coordinates of the whole buffer.
+     *
+     * @param aDraw is the drawing function, it is called from several threads at once.
+     */
+    void DrawBands( const std::function<void( cairo_t* aContext )>& aDraw );
+
     void SetAntialiasingMode( CAIRO_ANTIALIASING_MODE aMode ); // clears all buffers
     CAIRO_ANTIALIASING_MODE GetAntialiasingMode() const
     {
@@ -135,6 +161,10 @@ protected:
 
     cairo_antialias_t       m_currentAntialiasingMode;
 
+    bool m_clipped;                     ///< Is drawing restricted to the clip rectangle?
+    int  m_clipX, m_clipY;              ///< Origin of the clip rectangle
+    int  m_clipWidth, m_clipHeight;     ///< Size of the clip rectangle
+
     /**
      * Function clean()
      * performs freeing of resources.
@@ -301,6 +301,30 @@ protected:
     unsigned int                groupCounter;       ///< Counter used for generating keys for groups
     GROUP*                      currentGroup;       ///< Currently used group
 
+    /// Drawing attributes changed by the commands of the groups
+    struct GROUP_STATE
+    {
+        bool    isFillEnabled;
+        bool    isStrokeEnabled;
+        COLOR4D fillColor;
+        COLOR4D strokeColor;
+    };
+
+    /**
+     * @brief Executes the commands of a group on a context.
+     *
+     * The groups are only read, so they may be drawn on several contexts at the same time.
+     *
+     * @param aContext is the context to draw on, or NULL to only follow the attributes.
+     * @param aGroup is the group to be drawn.
+     * @param aState holds the drawing attributes, it is updated by the group commands.
+     */
+    void drawGroup( cairo_t* aContext, const GROUP& aGroup, GROUP_STATE& aState ) const;
+
+    /// Executes a group command that draws or changes the context
+    void drawGroupElement( cairo_t* aContext, const GROUP_ELEMENT& aElement,
+                           const GROUP_STATE& aState ) const;
+
     double lineWidth;
     double linePixelWidth;
     double lineWidthInPixels;
@@ -393,6 +417,16 @@ public:
 
     virtual void ClearTarget( RENDER_TARGET aTarget ) override;
 
+    virtual bool SetClipRect( const BOX2D& aRect ) override;
+
+    virtual void ResetClipRect() override;
+
+    virtual void DrawGroup( int aGroupNumber ) override;
+
+    virtual void ChangeGroupColor( int aGroupNumber, const COLOR4D& aNewColor ) override;
+
+    virtual void DeleteGroup( int aGroupNumber ) override;
+
     /**
      * Function PostPaint
      * posts an event to m_paint_listener.  A post is used so that the actual drawing
@@ -424,6 +458,19 @@ protected:
     unsigned int            overlayBuffer;          ///< Handle to the overlay buffer
     RENDER_TARGET           currentTarget;          ///< Current rendering target
     bool                    validCompositor;        ///< Compositor initialization flag
+    bool                    emptyBuffers;           ///< Buffers do not contain a full frame yet
+
+    /// Group drawn on the cached target, waiting to be drawn by drawDeferredGroups()
+    struct DEFERRED_GROUP
+    {
+        const GROUP*        group;                  ///< Commands of the group
+        GROUP_STATE         state;                  ///< Attributes when it was drawn
+        cairo_matrix_t      matrix;                 ///< Context matrix when it was drawn
+        cairo_operator_t    op;                     ///< Context operator when it was drawn
+    };
+
+    bool                    parallelDrawing;        ///< Draw the cached groups in parallel bands
+    std::vector<DEFERRED_GROUP> deferredGroups;     ///< Groups waiting to be drawn
 
     // Variables related to wxWidgets
     wxWindow*               parentWindow;           ///< Parent window
@@ -461,6 +508,9 @@ protected:
     /// Prepare the compositor
     void setCompositor();
 
+    /// Draw the deferred groups in bands of the current buffer, on the worker threads
+    void drawDeferredGroups();
+
     // Event handlers
     /**
      * @brief Paint event handler.
@@ -32,6 +32,7 @@
 #include <limits>
 
 #include <math/matrix3x3.h>
+#include <math/box2.h>
 
 #include <gal/color4d.h>
 #include <gal/definitions.h>
@@ -65,6 +66,18 @@ class GAL : GAL_DISPLAY_OPTIONS_OBSERVER
     friend class GAL_DRAWING_CONTEXT;
 
 public:
+    ///> Counters of the work done by the GAL while drawing a frame
+    struct RENDER_STATS
+    {
+        int    m_drawCalls;             ///< Number of draw calls issued to the GPU
+        int    m_drawnVertices;         ///< Number of vertices sent to the draw calls
+        int    m_cachedVertices;        ///< Number of vertices stored in the cached container
+        int    m_cachedCapacity;        ///< Size of the cached container, in vertices
+        int    m_noncachedVertices;     ///< Number of vertices drawn from the noncached container
+        int    m_overlayVertices;       ///< Number of vertices drawn from the overlay container
+        size_t m_gpuMemory;             ///< Size of the vertex and index buffers, in bytes
+    };
+
     // Constructor / Destructor
     GAL( GAL_DISPLAY_OPTIONS& aOptions );
     virtual ~GAL();
@@ -831,6 +844,29 @@ public:
      */
     virtual void ClearTarget( RENDER_TARGET aTarget ) {};
 
+    /**
+     * @brief Restricts clearing and drawing of all targets to a rectangle, so the rest of
+     * the previous frame is kept on the screen.
+     *
+     * @param aRect is the rectangle in world coordinates.
+     * @return false if the GAL is not able to keep the rest of the previous frame, in which case
+     * the whole screen has to be redrawn.
+     */
+    virtual bool SetClipRect( const BOX2D& aRect ) { return false; };
+
+    /**
+     * @brief Removes the restriction set by SetClipRect().
+     */
+    virtual void ResetClipRect() {};
+
+    /**
+     * @brief Returns the counters of the last drawn frame.
+     *
+     * The counters are reset when a new frame is started, they are zero for GALs that do not
+     * collect them.
+     */
+    virtual RENDER_STATS GetRenderStats() const { return RENDER_STATS(); };
+
     /**
      * @brief Sets negative draw mode in the renderer
      *
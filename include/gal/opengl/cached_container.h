@@ -87,12 +87,18 @@ protected:
     typedef std::pair<unsigned int, unsigned int> CHUNK;
     typedef std::multimap<unsigned int, unsigned int> FREE_CHUNK_MAP;
 
+    ///> Maps offset of free memory chunks to their entries in the FREE_CHUNK_MAP
+    typedef std::map<unsigned int, FREE_CHUNK_MAP::iterator> FREE_CHUNK_OFFSETS;
+
     /// List of all the stored items
     typedef std::set<VERTEX_ITEM*> ITEMS;
 
     ///> Stores size & offset of free chunks.
     FREE_CHUNK_MAP  m_freeChunks;
 
+    ///> The same free chunks sorted by offset, to find the neighbours of a chunk
+    FREE_CHUNK_OFFSETS m_freeChunkOffsets;
+
     ///> Stored VERTEX_ITEMs
     ITEMS m_items;
 
@@ -132,12 +138,6 @@ protected:
      */
     void defragment( VERTEX* aTarget );
 
-    /**
-     * Looks for consecutive free memory chunks and merges them, decreasing fragmentation of
-     * memory.
-     */
-    void mergeFreeChunks();
-
     /**
      * Returns the size of a chunk.
      *
@@ -163,11 +163,27 @@ protected:
      */
     void addFreeChunk( unsigned int aOffset, unsigned int aSize );
 
-private:
+    /**
+     * Replaces all the free chunks with a single one. The free space counter is not modified.
+     */
+    void resetFreeChunks( unsigned int aOffset, unsigned int aSize );
+
     /// Debug & test functions
     void showFreeChunks();
     void showUsedChunks();
     void test();
+
+private:
+    /**
+     * Stores a free chunk, merging it with the free chunks directly before and after it, so
+     * the free space does not split into chunks too small to be reused.
+     */
+    void insertFreeChunk( unsigned int aOffset, unsigned int aSize );
+
+    /**
+     * Removes a free chunk from both the size and the offset maps.
+     */
+    void removeFreeChunk( FREE_CHUNK_MAP::iterator aChunk );
 };
 } // namespace KIGFX
 
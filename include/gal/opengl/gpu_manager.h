@@ -85,9 +85,40 @@ public:
      */
     void EnableDepthTest( bool aEnabled );
 
+    /**
+     * Function GetDrawCalls()
+     * Returns the number of draw calls issued since the last BeginDrawing().
+     */
+    unsigned int GetDrawCalls() const
+    {
+        return m_drawCalls;
+    }
+
+    /**
+     * Function GetDrawnVertices()
+     * Returns the number of vertices drawn since the last BeginDrawing().
+     */
+    unsigned int GetDrawnVertices() const
+    {
+        return m_drawnVertices;
+    }
+
+    /**
+     * Function GetGpuMemory()
+     * Returns the size of the buffers allocated in the GPU memory for the stored data, in bytes.
+     */
+    virtual size_t GetGpuMemory() const = 0;
+
 protected:
     GPU_MANAGER( VERTEX_CONTAINER* aContainer );
 
+    ///> Clears the draw call and vertex counters
+    void resetStats()
+    {
+        m_drawCalls = 0;
+        m_drawnVertices = 0;
+    }
+
     ///> Drawing status flag.
     bool m_isDrawing;
 
@@ -102,6 +133,12 @@ protected:
 
     ///> true: enable Z test when drawing
     bool m_enableDepthTest;
+
+    ///> Number of draw calls issued since the last BeginDrawing()
+    unsigned int m_drawCalls;
+
+    ///> Number of vertices drawn since the last BeginDrawing()
+    unsigned int m_drawnVertices;
 };
 
 
@@ -123,6 +160,9 @@ public:
     ///> @copydoc GPU_MANAGER::EndDrawing()
     virtual void EndDrawing() override;
 
+    ///> @copydoc GPU_MANAGER::GetGpuMemory()
+    virtual size_t GetGpuMemory() const override;
+
     ///> Maps vertex buffer stored in GPU memory.
     void Map();
 
@@ -157,6 +197,7 @@ class GPU_NONCACHED_MANAGER : public GPU_MANAGER
 {
 public:
     GPU_NONCACHED_MANAGER( VERTEX_CONTAINER* aContainer );
+    ~GPU_NONCACHED_MANAGER();
 
     ///> @copydoc GPU_MANAGER::BeginDrawing()
     virtual void BeginDrawing() override;
@@ -169,6 +210,19 @@ public:
 
     ///> @copydoc GPU_MANAGER::EndDrawing()
     virtual void EndDrawing() override;
+
+    ///> @copydoc GPU_MANAGER::GetGpuMemory()
+    virtual size_t GetGpuMemory() const override;
+
+protected:
+    ///> Uploads the vertices to the streaming buffer, detaching its previous storage
+    void uploadVertices( const VERTEX* aVertices, unsigned int aSize );
+
+    ///> Handle to the buffer the vertices are streamed through, 0 if not created yet
+    GLuint m_vertexBuffer;
+
+    ///> Size of the streaming buffer storage, expressed in vertices
+    unsigned int m_vertexBufferCapacity;
 };
 } // namespace KIGFX
 #endif /* GPU_MANAGER_H_ */
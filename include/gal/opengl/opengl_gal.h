@@ -233,6 +233,9 @@ public:
     /// @copydoc GAL::ClearTarget()
     virtual void ClearTarget( RENDER_TARGET aTarget ) override;
 
+    /// @copydoc GAL::GetRenderStats()
+    virtual RENDER_STATS GetRenderStats() const override;
+
     /// @copydoc GAL::SetNegativeDrawMode()
     virtual void SetNegativeDrawMode( bool aSetting ) override {}
 
@@ -121,6 +121,15 @@ public:
         return m_currentSize;
     }
 
+    /**
+     * Function GetUsedSize()
+     * returns amount of vertices that are actually allocated in the container.
+     */
+    unsigned int GetUsedSize() const
+    {
+        return usedSpace();
+    }
+
     /**
      * Returns information about the container cache state.
      * @return True in case the vertices have to be reuploaded.
@@ -134,6 +134,24 @@ public:
      */
     bool Vertices( const VERTEX aVertices[], unsigned int aSize );
 
+    /**
+     * Function Circle()
+     * adds the triangle that is shaded into a circle by the circle shaders, using the currently
+     * set color. The three vertices differ only by the index of the triangle corner, so the
+     * transformation is applied once and the other two vertices are copied from the first one.
+     * The shader set by Shader() is changed.
+     *
+     * @param aX is the X coordinate of the circle center.
+     * @param aY is the Y coordinate of the circle center.
+     * @param aZ is the Z coordinate of the circle center.
+     * @param aShaderType is SHADER_FILLED_CIRCLE or SHADER_STROKED_CIRCLE.
+     * @param aRadius is the circle radius.
+     * @param aWidth is the line width of a stroked circle.
+     * @return True if successful, false otherwise.
+     */
+    bool Circle( GLfloat aX, GLfloat aY, GLfloat aZ, GLfloat aShaderType,
+                 GLfloat aRadius, GLfloat aWidth = 0.0f );
+
     /**
      * Function Color()
      * changes currently used color that will be applied to newly added vertices.
@@ -355,6 +373,24 @@ public:
      */
     void EnableDepthTest( bool aEnabled );
 
+    /**
+     * Function GetContainer()
+     * returns the container that stores the vertices.
+     */
+    const VERTEX_CONTAINER* GetContainer() const
+    {
+        return m_container.get();
+    }
+
+    /**
+     * Function GetGpuManager()
+     * returns the GPU manager that draws the stored vertices.
+     */
+    const GPU_MANAGER* GetGpuManager() const
+    {
+        return m_gpu.get();
+    }
+
 protected:
     /**
      * Function putVertex()
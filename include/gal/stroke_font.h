@@ -42,9 +42,6 @@ namespace KIGFX
 {
 class GAL;
 
-typedef std::deque< std::deque<VECTOR2D> > GLYPH;
-typedef std::vector<GLYPH>                 GLYPH_LIST;
-
 /**
  * @brief Class STROKE_FONT implements stroke font drawing.
  *
@@ -59,13 +56,12 @@ public:
     STROKE_FONT( GAL* aGal );
 
     /**
-     * @brief Load the new stroke font.
+     * @brief Load the new stroke font.  The glyphs are read from the tables decoded from the
+     * font at build time (see newstroke_font.h), so there is nothing to decode.
      *
-     * @param aNewStrokeFont is the pointer to the font data.
-     * @param aNewStrokeFontSize is the size of the font data.
      * @return True, if the font was successfully loaded, else false.
      */
-    bool LoadNewStrokeFont( const char* const aNewStrokeFont[], int aNewStrokeFontSize );
+    bool LoadNewStrokeFont();
 
     /**
      * @brief Draw a string.
@@ -117,8 +113,21 @@ public:
 
 private:
     GAL*                m_gal;                  ///< Pointer to the GAL
-    GLYPH_LIST          m_glyphs;               ///< Glyph list
-    std::vector<BOX2D>  m_glyphBoundingBoxes;   ///< Bounding boxes of the glyphs
+    int                 m_glyphCount;           ///< Number of glyphs of the font
+
+    /// Strokes of a glyph scaled to a glyph size and style, stored as runs of points
+    struct SCALED_GLYPH
+    {
+        unsigned              generation;       ///< m_scaledGeneration the glyph was scaled for
+        std::vector<VECTOR2D> points;           ///< Points of all strokes
+        std::vector<int>      runs;             ///< Number of points of each stroke
+    };
+
+    std::vector<SCALED_GLYPH> m_scaledGlyphs;   ///< Glyphs scaled for the last used style
+    unsigned            m_scaledGeneration;     ///< Incremented whenever the style changes
+    VECTOR2D            m_scaledSize;           ///< Glyph size of m_scaledGlyphs
+    bool                m_scaledItalic;         ///< Italic style of m_scaledGlyphs
+    std::vector<VECTOR2D> m_strokeBuffer;       ///< Stroke points moved to the glyph position
 
     /**
      * @brief Compute the X and Y size of a given text. The text is expected to be
@@ -144,13 +153,23 @@ private:
     int getInterline() const;
 
     /**
-     * @brief Compute the bounding box of a given glyph.
+     * @brief Returns the bounding box of a glyph: its advance and the vertical extent of its
+     * strokes and base line, for a unit glyph size.
+     *
+     * @param aIndex is the glyph index.
+     */
+    BOX2D glyphBoundingBox( int aIndex ) const;
+
+    /**
+     * @brief Returns the strokes of a glyph scaled to a glyph size and style. Texts usually
+     * share a few sizes, so the glyphs are kept until another size or style is requested.
      *
-     * @param aGlyph is the glyph.
-     * @param aGlyphBoundingX is the x-component of the bounding box size.
-     * @return is the complete bounding box size.
+     * @param aIndex is the glyph index.
+     * @param aGlyphSize is the glyph size, with a negative width for mirrored text.
+     * @param aItalic tells if the strokes are slanted.
+     * @return the scaled glyph, valid until the next call.
      */
-    BOX2D computeBoundingBox( const GLYPH& aGlyph, const VECTOR2D& aGlyphBoundingX ) const;
+    const SCALED_GLYPH& scaledGlyph( int aIndex, const VECTOR2D& aGlyphSize, bool aItalic );
 
     /**
      * @brief Draws a single line of text. Multiline texts should be split before using the
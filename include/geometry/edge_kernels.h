@@ -0,0 +1,65 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file edge_kernels.h
+ * @brief tests of one point against all the edges of a line chain.
+ *
+ * The edges are the segments between consecutive points of an array, edge aCount - 1
+ * joining the last point to the first one.  When the target has SSE2, the kernels test four
+ * edges at a time with approximations, and run the exact code only on the edges that they
+ * cannot decide: the results are the same as the scalar versions, which are kept for the
+ * other targets and as a reference.
+ */
+
+#ifndef EDGE_KERNELS_H
+#define EDGE_KERNELS_H
+
+#include <math/vector2d.h>
+
+namespace EDGE_KERNELS
+{
+
+/**
+ * @return true if an odd number of the aCount edges of the closed chain aPoints cross the
+ * ray going from aP towards +x, with the crossing rule of SHAPE_LINE_CHAIN::PointInside().
+ */
+bool OddRayCrossings( const VECTOR2I* aPoints, int aCount, const VECTOR2I& aP );
+
+/**
+ * @return the minimum of SEG::Distance( aP ) over the first aEdgeCount edges of aPoints
+ * (aCount - 1 for an open chain, aCount for a closed one), or INT_MAX if there is none.
+ */
+int MinDistance( const VECTOR2I* aPoints, int aCount, int aEdgeCount, const VECTOR2I& aP );
+
+///> Scalar version of OddRayCrossings()
+bool OddRayCrossingsScalar( const VECTOR2I* aPoints, int aCount, const VECTOR2I& aP );
+
+///> Scalar version of MinDistance()
+int MinDistanceScalar( const VECTOR2I* aPoints, int aCount, int aEdgeCount, const VECTOR2I& aP );
+
+///> @return the name of the instruction set used by the kernels, "SSE2" or "scalar"
+const char* InstructionSet();
+
+} // namespace EDGE_KERNELS
+
+#endif // EDGE_KERNELS_H
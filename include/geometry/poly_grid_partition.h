@@ -29,6 +29,7 @@
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_rect.h>
 
+#include <cassert>
 #include <vector>
 #include <algorithm>
 #include <unordered_map>
@@ -146,18 +147,16 @@ enum HASH_FLAG
         return py;
     }
 
-    void build( const SHAPE_LINE_CHAIN& aPolyOutline, int gridSize )
+    void build( const SHAPE_LINE_CHAIN* aPolyOutline, int gridSize )
     {
         m_outline = aPolyOutline;
 
         //if (orientation(m_outline) < 0)
-        //    m_outline = m_outline.Reverse();
+        //    m_outline = m_outline->Reverse();
 
-        m_bbox = m_outline.BBox();
+        m_bbox = m_outline->BBox();
         m_gridSize = gridSize;
 
-        m_outline.SetClosed( true );
-
         m_grid.reserve( gridSize * gridSize );
 
         for( int y = 0; y < gridSize; y++ )
@@ -171,13 +170,13 @@ enum HASH_FLAG
         VECTOR2I    ref_v( 0, 1 );
         VECTOR2I    ref_h( 0, 1 );
 
-        m_flags.reserve( m_outline.SegmentCount() );
+        m_flags.reserve( m_outline->SegmentCount() );
 
         std::unordered_map<SEG, int, segHash, segsEqual> edgeSet;
 
-        for( int i = 0; i<m_outline.SegmentCount(); i++ )
+        for( int i = 0; i<m_outline->SegmentCount(); i++ )
         {
-            SEG edge = m_outline.CSegment( i );
+            SEG edge = m_outline->CSegment( i );
 
             if( edgeSet.find( edge ) == edgeSet.end() )
             {
@@ -189,9 +188,9 @@ enum HASH_FLAG
             }
         }
 
-        for( int i = 0; i<m_outline.SegmentCount(); i++ )
+        for( int i = 0; i<m_outline->SegmentCount(); i++ )
         {
-            auto    edge    = m_outline.CSegment( i );
+            auto    edge    = m_outline->CSegment( i );
             auto    dir     = edge.B - edge.A;
             int     flags   = 0;
 
@@ -308,7 +307,7 @@ enum HASH_FLAG
 
         for( auto index : cell )
         {
-            const SEG& edge = m_outline.CSegment( index );
+            const SEG& edge = m_outline->CSegment( index );
 
 
             if( m_flags[index] == 0 )
@@ -377,11 +376,26 @@ enum HASH_FLAG
 
 public:
 
-    POLY_GRID_PARTITION( const SHAPE_LINE_CHAIN& aPolyOutline, int gridSize )
+    POLY_GRID_PARTITION( const SHAPE_LINE_CHAIN& aPolyOutline, int gridSize ) :
+        m_ownOutline( aPolyOutline )
     {
+        m_ownOutline.SetClosed( true );
+        build( &m_ownOutline, gridSize );
+    }
+
+    /**
+     * Builds the partition of aPolyOutline without copying it.  The outline must be closed,
+     * and must not be changed or deleted while the partition is used.
+     */
+    POLY_GRID_PARTITION( const SHAPE_LINE_CHAIN* aPolyOutline, int gridSize )
+    {
+        assert( aPolyOutline->IsClosed() );
         build( aPolyOutline, gridSize );
     }
 
+    POLY_GRID_PARTITION( const POLY_GRID_PARTITION& ) = delete;
+    POLY_GRID_PARTITION& operator=( const POLY_GRID_PARTITION& ) = delete;
+
     int containsPoint( const VECTOR2I& aP, bool debug = false ) const
     {
         const auto gridPoint = poly2grid( aP );
@@ -468,7 +482,7 @@ public:
                 const auto& cell = m_grid [ m_gridSize * gy + gx];
                 for ( auto index : cell )
                 {
-                    const auto& seg = m_outline.CSegment(index);
+                    const auto& seg = m_outline->CSegment(index);
 
                     if ( seg.SquaredDistance(aP) <= dist )
                         return true;
@@ -498,9 +512,23 @@ public:
         return m_bbox;
     }
 
+    ///> Returns the memory used by the partition, in bytes
+    size_t MemoryUsage() const
+    {
+        size_t bytes = sizeof( *this ) + m_ownOutline.PointCount() * sizeof( VECTOR2I )
+                       + m_flags.capacity() * sizeof( int )
+                       + m_grid.capacity() * sizeof( EDGE_LIST );
+
+        for( const EDGE_LIST& cell : m_grid )
+            bytes += cell.capacity() * sizeof( int );
+
+        return bytes;
+    }
+
 private:
     int m_gridSize;
-    SHAPE_LINE_CHAIN m_outline;
+    SHAPE_LINE_CHAIN m_ownOutline;          ///< the outline, when it is copied
+    const SHAPE_LINE_CHAIN* m_outline;
     BOX2I m_bbox;
     std::vector<int> m_flags;
     std::vector<EDGE_LIST> m_grid;
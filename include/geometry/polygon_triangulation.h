@@ -69,6 +69,8 @@ private:
                 i( aIndex ), x( aX ), y( aY ), parent( aParent )
         {
         }
+        // Only for the storage in std::vector, as the blocks are never reallocated
+        Vertex( const Vertex& ) = default;
         Vertex& operator=( const Vertex& ) = delete;
         Vertex& operator=( Vertex&& ) = delete;
 
@@ -92,10 +94,8 @@ private:
          */
         Vertex* split( Vertex* b )
         {
-            parent->m_vertices.emplace_back( i, x, y, parent );
-            Vertex* a2 = &parent->m_vertices.back();
-            parent->m_vertices.emplace_back( b->i, b->x, b->y, parent );
-            Vertex* b2 = &parent->m_vertices.back();
+            Vertex* a2 = parent->newVertex( i, x, y );
+            Vertex* b2 = parent->newVertex( b->i, b->x, b->y );
             Vertex* an = next;
             Vertex* bp = b->prev;
 
@@ -176,7 +176,7 @@ private:
          */
         void zSort()
         {
-            std::deque<Vertex*> queue;
+            std::vector<Vertex*> queue;
 
             queue.push_back( this );
 
@@ -229,10 +229,38 @@ private:
         Vertex* nextZ = nullptr;
     };
 
+    ///> Number of vertices of the blocks holding the vertices added by the splits
+    static constexpr size_t SPLIT_BLOCK_SIZE = 256;
+
     BOX2I m_bbox;
-    std::deque<Vertex> m_vertices;
+
+    /**
+     * The vertices, in blocks which are never reallocated so that the links stay valid.
+     * The first block holds the points of the polygon sorted by z-order, so that the
+     * z-order walks of isEar() read contiguous memory, and the next ones the vertices added
+     * by the splits.
+     */
+    std::vector<std::vector<Vertex>> m_vertexBlocks;
     SHAPE_POLY_SET::TRIANGULATED_POLYGON& m_result;
 
+    /**
+     * Function newVertex
+     * Allocates a vertex at the end of the last block, starting a new block when it is full.
+     */
+    Vertex* newVertex( size_t aIndex, double aX, double aY )
+    {
+        if( m_vertexBlocks.empty()
+                || m_vertexBlocks.back().size() == m_vertexBlocks.back().capacity() )
+        {
+            m_vertexBlocks.emplace_back();
+            m_vertexBlocks.back().reserve( SPLIT_BLOCK_SIZE );
+        }
+
+        m_vertexBlocks.back().emplace_back( aIndex, aX, aY, this );
+
+        return &m_vertexBlocks.back().back();
+    }
+
     /**
      * Calculate the Morton code of the Vertex
      * http://www.graphics.stanford.edu/~seander/bithacks.html#InterleaveBMN
@@ -300,7 +328,7 @@ private:
      */
     Vertex* createList( const ClipperLib::Path& aPath )
     {
-        Vertex* tail = nullptr;
+        std::vector<VECTOR2I> ring;
         double sum = 0.0;
         auto len = aPath.size();
 
@@ -313,27 +341,23 @@ private:
             sum += ( ( p2.X - p1.X ) * ( p2.Y + p1.Y ) );
         }
 
+        ring.reserve( len );
+
         if( sum <= 0.0 )
         {
             for( auto point : aPath )
-                tail = insertVertex( VECTOR2I( point.X, point.Y ), tail );
+                ring.emplace_back( point.X, point.Y );
         }
         else
         {
             for( size_t i = 0; i < len; i++ )
             {
                 auto p = aPath.at( len - i - 1 );
-                tail = insertVertex( VECTOR2I( p.X, p.Y ), tail );
+                ring.emplace_back( p.X, p.Y );
             }
         }
 
-        if( tail && ( *tail == *tail->next ) )
-        {
-            tail->next->remove();
-        }
-
-        return tail;
-
+        return linkList( ring );
     }
 
     /**
@@ -343,7 +367,7 @@ private:
      */
     Vertex* createList( const SHAPE_LINE_CHAIN& points )
     {
-        Vertex* tail = nullptr;
+        std::vector<VECTOR2I> ring;
         double sum = 0.0;
 
         // Check for winding order
@@ -355,14 +379,70 @@ private:
             sum += ( ( p2.x - p1.x ) * ( p2.y + p1.y ) );
         }
 
+        ring.reserve( points.PointCount() );
+
         if( sum > 0.0 )
             for( int i = points.PointCount() - 1; i >= 0; i--)
-                tail = insertVertex( points.CPoint( i ), tail );
+                ring.push_back( points.CPoint( i ) );
         else
             for( int i = 0; i < points.PointCount(); i++ )
-                tail = insertVertex( points.CPoint( i ), tail );
+                ring.push_back( points.CPoint( i ) );
+
+        return linkList( ring );
+    }
+
+    /**
+     * Function linkList
+     * Adds the points of aRing to the result, and links their vertices into a circular,
+     * doubly-linked list.  The vertices are allocated in one block, in z-order.
+     * Returns the vertex of the last point
+     */
+    Vertex* linkList( const std::vector<VECTOR2I>& aRing )
+    {
+        const size_t len = aRing.size();
+
+        if( !len )
+            return nullptr;
+
+        std::vector<int32_t> z( len );
+        std::vector<size_t>  order( len );
 
-        if( tail && ( *tail == *tail->next ) )
+        for( size_t i = 0; i < len; i++ )
+        {
+            z[i] = zOrder( aRing[i].x, aRing[i].y );
+            order[i] = i;
+        }
+
+        std::sort( order.begin(), order.end(), [&z]( size_t a, size_t b )
+        {
+            return z[a] < z[b];
+        } );
+
+        const size_t first = m_result.GetVertexCount();
+        std::vector<Vertex*> ring( len );
+
+        for( const VECTOR2I& pt : aRing )
+            m_result.AddVertex( pt );
+
+        // A block of its own for the points, even if the last one has some room left
+        m_vertexBlocks.emplace_back();
+        m_vertexBlocks.back().reserve( len );
+
+        for( size_t i : order )
+        {
+            ring[i] = newVertex( first + i, aRing[i].x, aRing[i].y );
+            ring[i]->z = z[i];
+        }
+
+        for( size_t i = 0; i < len; i++ )
+        {
+            ring[i]->next = ring[ ( i + 1 ) < len ? i + 1 : 0 ];
+            ring[i]->prev = ring[ i ? i - 1 : len - 1 ];
+        }
+
+        Vertex* tail = ring.back();
+
+        if( *tail == *tail->next )
         {
             tail->next->remove();
         }
@@ -623,34 +703,6 @@ private:
             return area( a, b, a->prev ) < 0 || area( a, a->next, b ) < 0;
     }
 
-    /**
-     * Function insertVertex
-     * Creates an entry in the vertices lookup and optionally inserts the newly
-     * created vertex into an existing linked list.
-     * Returns a pointer to the newly created vertex
-     */
-    Vertex* insertVertex( const VECTOR2I& pt, Vertex* last )
-    {
-        m_result.AddVertex( pt );
-        m_vertices.emplace_back( m_result.GetVertexCount() - 1, pt.x, pt.y, this );
-
-        Vertex* p = &m_vertices.back();
-        if( !last )
-        {
-            p->prev = p;
-            p->next = p;
-        }
-        else
-        {
-            p->next = last->next;
-            p->prev = last;
-            last->next->prev = p;
-            last->next = p;
-        }
-        return p;
-    }
-
-
 public:
 
     bool TesselatePolygon( const SHAPE_LINE_CHAIN& aPoly )
@@ -671,7 +723,7 @@ public:
         firstVertex->updateList();
 
         auto retval = earcutList( firstVertex );
-        m_vertices.clear();
+        m_vertexBlocks.clear();
         return retval;
     }
 };
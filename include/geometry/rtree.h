@@ -32,6 +32,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <vector>
 
 #define ASSERT assert    // RTree uses ASSERT( condition )
 
@@ -109,6 +110,26 @@ public:
                  const ELEMTYPE     a_max[NUMDIMS],
                  const DATATYPE&    a_dataId );
 
+    /// Replace the contents of the tree by a set of entries, packed by sort-tile-recursive.
+    /// This is much faster than inserting the entries one at a time, and gives nodes with
+    /// less overlap.
+    /// \param a_data The data Ids of the entries
+    /// \param a_bounds Called as a_bounds( dataId, min, max ) to get the bounding rect
+    /// of an entry
+    template <class BOUNDS>
+    void BulkLoad( const std::vector<DATATYPE>& a_data, BOUNDS a_bounds )
+    {
+        std::vector<Branch> branches( a_data.size() );
+
+        for( size_t ii = 0; ii < a_data.size(); ++ii )
+        {
+            a_bounds( a_data[ii], branches[ii].m_rect.m_min, branches[ii].m_rect.m_max );
+            branches[ii].m_data = a_data[ii];
+        }
+
+        BulkLoad( branches );
+    }
+
     /// Remove entry
     /// \param a_min Min of bounding rect
     /// \param a_max Max of bounding rect
@@ -438,6 +459,8 @@ protected:
                                    Node**           a_newNode,
                                    int              a_level );
     bool            InsertRect( Rect* a_rect, const DATATYPE& a_id, Node** a_root, int a_level );
+    void            BulkLoad( std::vector<Branch>& a_branches );
+    void            SortTiles( Branch* a_branches, size_t a_count, int a_axis );
     Rect            NodeCover( Node* a_node );
     bool            AddBranch( Branch* a_branch, Node* a_node, Node** a_newNode );
     void            DisconnectBranch( Node* a_node, int a_index );
@@ -660,6 +683,81 @@ void RTREE_QUAL::Insert( const ELEMTYPE     a_min[NUMDIMS],
 }
 
 
+// Builds the tree bottom up: the entries are sorted into tiles of MAXNODES neighbours,
+// which become the leaves, and the nodes of each level are packed the same way until
+// a single root is left.
+RTREE_TEMPLATE
+void RTREE_QUAL::BulkLoad( std::vector<Branch>& a_branches )
+{
+    Reset();
+
+    int level = 0;
+
+    do
+    {
+        SortTiles( a_branches.data(), a_branches.size(), 0 );
+
+        size_t count = a_branches.size();
+        size_t nodeCount = std::max<size_t>( 1, ( count + MAXNODES - 1 ) / MAXNODES );
+        std::vector<Branch> parents( nodeCount );
+        size_t next = 0;
+
+        for( size_t ii = 0; ii < nodeCount; ++ii )
+        {
+            size_t last = std::min( count, ( ii + 1 ) * MAXNODES );
+
+            // The last two nodes share their branches when the last one would be too empty
+            if( ii + 2 == nodeCount && count - last < (size_t) MINNODES )
+                last = ii * MAXNODES + ( count - ii * MAXNODES ) / 2;
+
+            Node* node = AllocNode();
+
+            node->m_level = level;
+
+            for( ; next < last; ++next )
+                node->m_branch[node->m_count++] = a_branches[next];
+
+            parents[ii].m_rect = NodeCover( node );
+            parents[ii].m_child = node;
+        }
+
+        a_branches.swap( parents );
+        level++;
+    } while( a_branches.size() > 1 );
+
+    m_root = a_branches[0].m_child;
+}
+
+
+// Sorts the branches along a_axis, cuts them into slabs, and sorts each slab along the
+// next axes.  The slabs hold a whole number of nodes, so that consecutive runs of MAXNODES
+// branches are close to each other.
+RTREE_TEMPLATE
+void RTREE_QUAL::SortTiles( Branch* a_branches, size_t a_count, int a_axis )
+{
+    if( a_count <= MAXNODES )
+        return;
+
+    std::sort( a_branches, a_branches + a_count,
+               [a_axis]( const Branch& a, const Branch& b )
+               {
+                   // Compare the centers, without overflowing ELEMTYPE
+                   return (ELEMTYPEREAL) a.m_rect.m_min[a_axis] + a.m_rect.m_max[a_axis]
+                          < (ELEMTYPEREAL) b.m_rect.m_min[a_axis] + b.m_rect.m_max[a_axis];
+               } );
+
+    if( a_axis == NUMDIMS - 1 )
+        return;
+
+    size_t nodeCount = ( a_count + MAXNODES - 1 ) / MAXNODES;
+    size_t slabCount = (size_t) ceil( pow( (double) nodeCount, 1.0 / ( NUMDIMS - a_axis ) ) );
+    size_t slabSize = MAXNODES * ( ( nodeCount + slabCount - 1 ) / slabCount );
+
+    for( size_t first = 0; first < a_count; first += slabSize )
+        SortTiles( a_branches + first, std::min( slabSize, a_count - first ), a_axis + 1 );
+}
+
+
 RTREE_TEMPLATE
 bool RTREE_QUAL::Remove( const ELEMTYPE     a_min[NUMDIMS],
                          const ELEMTYPE     a_max[NUMDIMS],
@@ -120,10 +120,21 @@ public:
      *      Other programs should call this using explicit accuracy values
      *      TODO: unify KiCad internal units
      *
-     * @return a SHAPE_LINE_CHAIN
+     * @return a SHAPE_LINE_CHAIN, which keeps the arc until its points are first read
      */
     const SHAPE_LINE_CHAIN ConvertToPolyline( double aAccuracy = 500.0 ) const;
 
+    /**
+     * @return the number of segments of the polyline approximating the arc within aAccuracy
+     */
+    int GetPolylineSegmentCount( double aAccuracy ) const;
+
+    /**
+     * @return the aIndex-th of the aSegmentCount + 1 points of the polyline approximating
+     * the arc with aSegmentCount segments
+     */
+    const VECTOR2I GetPolylinePoint( int aIndex, int aSegmentCount ) const;
+
 private:
 
     bool ccw( const VECTOR2I& aA, const VECTOR2I& aB, const VECTOR2I& aC ) const
@@ -26,6 +26,9 @@
 #ifndef __SHAPE_LINE_CHAIN
 #define __SHAPE_LINE_CHAIN
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <sstream>
 
@@ -34,9 +37,12 @@
 #include <math/vector2d.h>
 #include <geometry/shape.h>
 #include <geometry/seg.h>
+#include <geometry/shape_arc.h>
 
 #include <clipper.hpp>
 
+class SHAPE_LINE_CHAIN_EDGE_INDEX;
+
 /**
  * Class SHAPE_LINE_CHAIN
  *
@@ -45,6 +51,19 @@
  * class in pcbnew.
  *
  * SHAPE_LINE_CHAIN class shall not be used for polygons!
+ *
+ * The points are shared by the copies of a line chain, and copied only when one of the
+ * copies is changed, so that copying the contours of large polygons is cheap.  A reference
+ * returned by Point() or LastPoint() is only valid until the chain is copied.
+ *
+ * The edges of the chains of EDGE_INDEX_MIN_POINTS points or more are indexed in an R-tree
+ * by the first collision, distance or point inside test, so that the next tests do not visit
+ * all the edges.  The index is shared by the copies too, and dropped by any change.
+ *
+ * A chain can also keep arcs, appended by Append( const SHAPE_ARC& ).  The points of their
+ * segments are built only when the points of the chain are first read, so building, copying,
+ * moving and testing the chain for collisions with Collide() are done with the arcs.  Any other
+ * change of the points replaces the arcs by their segments.
  */
 class SHAPE_LINE_CHAIN : public SHAPE
 {
@@ -70,6 +89,9 @@ public:
 
     typedef std::vector<INTERSECTION> INTERSECTIONS;
 
+    ///> Number of points from which the edges of a chain are indexed
+    static const int EDGE_INDEX_MIN_POINTS = 128;
+
     /**
      * Constructor
      * Initializes an empty line chain.
@@ -82,9 +104,22 @@ public:
      * Copy Constructor
      */
     SHAPE_LINE_CHAIN( const SHAPE_LINE_CHAIN& aShape ) :
-        SHAPE( SH_LINE_CHAIN ), m_points( aShape.m_points ), m_closed( aShape.m_closed )
+        SHAPE( SH_LINE_CHAIN ),
+        m_points( aShape.m_points ),
+        m_closed( aShape.m_closed ),
+        m_bbox( aShape.m_bbox )
     {}
 
+    SHAPE_LINE_CHAIN( SHAPE_LINE_CHAIN&& aShape ) noexcept :
+        SHAPE( SH_LINE_CHAIN ),
+        m_points( std::move( aShape.m_points ) ),
+        m_closed( aShape.m_closed ),
+        m_bbox( aShape.m_bbox )
+    {}
+
+    SHAPE_LINE_CHAIN& operator=( const SHAPE_LINE_CHAIN& aShape ) = default;
+    SHAPE_LINE_CHAIN& operator=( SHAPE_LINE_CHAIN&& aShape ) = default;
+
     /**
      * Constructor
      * Initializes a 2-point line chain (a single segment)
@@ -92,28 +127,19 @@ public:
     SHAPE_LINE_CHAIN( const VECTOR2I& aA, const VECTOR2I& aB ) :
         SHAPE( SH_LINE_CHAIN ), m_closed( false )
     {
-        m_points.resize( 2 );
-        m_points[0] = aA;
-        m_points[1] = aB;
+        mutablePoints() = { aA, aB };
     }
 
     SHAPE_LINE_CHAIN( const VECTOR2I& aA, const VECTOR2I& aB, const VECTOR2I& aC ) :
         SHAPE( SH_LINE_CHAIN ), m_closed( false )
     {
-        m_points.resize( 3 );
-        m_points[0] = aA;
-        m_points[1] = aB;
-        m_points[2] = aC;
+        mutablePoints() = { aA, aB, aC };
     }
 
     SHAPE_LINE_CHAIN( const VECTOR2I& aA, const VECTOR2I& aB, const VECTOR2I& aC, const VECTOR2I& aD ) :
         SHAPE( SH_LINE_CHAIN ), m_closed( false )
     {
-        m_points.resize( 4 );
-        m_points[0] = aA;
-        m_points[1] = aB;
-        m_points[2] = aC;
-        m_points[3] = aD;
+        mutablePoints() = { aA, aB, aC, aD };
     }
 
 
@@ -121,20 +147,19 @@ public:
         SHAPE( SH_LINE_CHAIN ),
         m_closed( false )
     {
-        m_points.resize( aCount );
-
-        for( int i = 0; i < aCount; i++ )
-            m_points[i] = *aV++;
+        mutablePoints().assign( aV, aV + aCount );
     }
 
     SHAPE_LINE_CHAIN( const ClipperLib::Path& aPath ) :
         SHAPE( SH_LINE_CHAIN ),
         m_closed( true )
     {
-        m_points.reserve( aPath.size() );
+        std::vector<VECTOR2I>& points = mutablePoints();
+
+        points.reserve( aPath.size() );
 
         for( const auto& point : aPath )
-            m_points.emplace_back( point.X, point.Y );
+            points.emplace_back( point.X, point.Y );
     }
 
     ~SHAPE_LINE_CHAIN()
@@ -148,10 +173,30 @@ public:
      */
     void Clear()
     {
-        m_points.clear();
+        m_points.reset();
         m_closed = false;
     }
 
+    /**
+     * Function ArcCount()
+     *
+     * Returns the number of arcs kept by the chain, see Append( const SHAPE_ARC& ).
+     */
+    int ArcCount() const
+    {
+        return m_points ? m_points->m_arcs.size() : 0;
+    }
+
+    /**
+     * Function CArc()
+     *
+     * Returns the aIndex-th arc kept by the chain.
+     */
+    const SHAPE_ARC& CArc( int aIndex ) const
+    {
+        return m_points->m_arcs[aIndex].m_arc;
+    }
+
     /**
      * Function SetClosed()
      *
@@ -182,7 +227,7 @@ public:
      */
     int SegmentCount() const
     {
-        int c = m_points.size() - 1;
+        int c = points().size() - 1;
         if( m_closed )
             c++;
 
@@ -197,7 +242,7 @@ public:
      */
     int PointCount() const
     {
-        return m_points.size();
+        return points().size();
     }
 
     /**
@@ -210,13 +255,7 @@ public:
      */
     SEG Segment( int aIndex )
     {
-        if( aIndex < 0 )
-            aIndex += SegmentCount();
-
-        if( aIndex == (int)( m_points.size() - 1 ) && m_closed )
-            return SEG( m_points[aIndex], m_points[0], aIndex );
-        else
-            return SEG( m_points[aIndex], m_points[aIndex + 1], aIndex );
+        return CSegment( aIndex );
     }
 
     /**
@@ -232,12 +271,12 @@ public:
         if( aIndex < 0 )
             aIndex += SegmentCount();
 
-        if( aIndex == (int)( m_points.size() - 1 ) && m_closed )
-            return SEG( const_cast<VECTOR2I&>( m_points[aIndex] ),
-                        const_cast<VECTOR2I&>( m_points[0] ), aIndex );
+        const std::vector<VECTOR2I>& pts = points();
+
+        if( aIndex == (int)( pts.size() - 1 ) && m_closed )
+            return SEG( pts[aIndex], pts[0], aIndex );
         else
-            return SEG( const_cast<VECTOR2I&>( m_points[aIndex] ),
-                        const_cast<VECTOR2I&>( m_points[aIndex + 1] ), aIndex );
+            return SEG( pts[aIndex], pts[aIndex + 1], aIndex );
     }
 
     /**
@@ -252,7 +291,7 @@ public:
         if( aIndex < 0 )
             aIndex += PointCount();
 
-        return m_points[aIndex];
+        return mutablePoints()[aIndex];
     }
 
     /**
@@ -269,12 +308,12 @@ public:
         else if( aIndex >= PointCount() )
             aIndex -= PointCount();
 
-        return m_points[aIndex];
+        return points()[aIndex];
     }
 
     const std::vector<VECTOR2I>& CPoints() const
     {
-        return m_points;
+        return points();
     }
 
     /**
@@ -282,7 +321,7 @@ public:
      */
     VECTOR2I& LastPoint()
     {
-        return m_points[PointCount() - 1];
+        return mutablePoints()[PointCount() - 1];
     }
 
     /**
@@ -290,14 +329,18 @@ public:
      */
     const VECTOR2I& CLastPoint() const
     {
-        return m_points[PointCount() - 1];
+        return points()[PointCount() - 1];
     }
 
     /// @copydoc SHAPE::BBox()
     const BOX2I BBox( int aClearance = 0 ) const override
     {
         BOX2I bbox;
-        bbox.Compute( m_points );
+
+        if( ArcCount() )
+            bbox = arcsBBox();
+        else
+            bbox.Compute( points() );
 
         if( aClearance != 0 )
             bbox.Inflate( aClearance );
@@ -307,7 +350,7 @@ public:
 
     void GenerateBBoxCache()
     {
-        m_bbox.Compute( m_points );
+        m_bbox = BBox();
     }
 
     /**
@@ -339,6 +382,15 @@ public:
      */
     int Distance( const VECTOR2I& aP, bool aOutlineOnly = false ) const;
 
+    /**
+     * Function Distance()
+     *
+     * Computes the minimum distance between the edges of the line chain and a segment aSeg.
+     * @param aSeg the segment
+     * @return minimum distance.
+     */
+    int Distance( const SEG& aSeg ) const;
+
     /**
      * Function Reverse()
      *
@@ -382,12 +434,18 @@ public:
      */
     void Append( const VECTOR2I& aP, bool aAllowDuplication = false )
     {
-        if( m_points.size() == 0 )
+        if( ArcCount() )
+        {
+            appendToArcs( aP, aAllowDuplication );
+            return;
+        }
+
+        if( PointCount() == 0 )
             m_bbox = BOX2I( aP, VECTOR2I( 0, 0 ) );
 
-        if( m_points.size() == 0 || aAllowDuplication || CPoint( -1 ) != aP )
+        if( PointCount() == 0 || aAllowDuplication || CPoint( -1 ) != aP )
         {
-            m_points.push_back( aP );
+            mutablePoints().push_back( aP );
             m_bbox.Merge( aP );
         }
     }
@@ -400,27 +458,48 @@ public:
      */
     void Append( const SHAPE_LINE_CHAIN& aOtherLine )
     {
+        if( ArcCount() || aOtherLine.ArcCount() )
+        {
+            appendToArcs( aOtherLine );
+            return;
+        }
+
         if( aOtherLine.PointCount() == 0 )
             return;
 
-        else if( PointCount() == 0 || aOtherLine.CPoint( 0 ) != CPoint( -1 ) )
+        std::vector<VECTOR2I>& points = mutablePoints();
+
+        if( points.empty() || aOtherLine.CPoint( 0 ) != points.back() )
         {
             const VECTOR2I p = aOtherLine.CPoint( 0 );
-            m_points.push_back( p );
+            points.push_back( p );
             m_bbox.Merge( p );
         }
 
         for( int i = 1; i < aOtherLine.PointCount(); i++ )
         {
             const VECTOR2I p = aOtherLine.CPoint( i );
-            m_points.push_back( p );
+            points.push_back( p );
             m_bbox.Merge( p );
         }
     }
 
+    /**
+     * Function Append()
+     *
+     * Appends an arc at the end of the line chain, which gets the points of
+     * aArc.ConvertToPolyline( aAccuracy ).  The chain keeps the arc until its points
+     * are changed.
+     * @param aArc the arc to be appended
+     * @param aAccuracy maximum divergence of the segments from the arc
+     */
+    void Append( const SHAPE_ARC& aArc, double aAccuracy = 500.0 );
+
     void Insert( int aVertex, const VECTOR2I& aP )
     {
-        m_points.insert( m_points.begin() + aVertex, aP );
+        std::vector<VECTOR2I>& points = mutablePoints();
+
+        points.insert( points.begin() + aVertex, aP );
     }
 
     /**
@@ -663,8 +742,17 @@ public:
 
     void Move( const VECTOR2I& aVector ) override
     {
-        for( std::vector<VECTOR2I>::iterator i = m_points.begin(); i != m_points.end(); ++i )
-            (*i) += aVector;
+        if( ArcCount() )
+        {
+            moveArcs( aVector );
+            return;
+        }
+
+        if( PointCount() == 0 )
+            return;
+
+        for( VECTOR2I& p : mutablePoints() )
+            p += aVector;
     }
 
     /**
@@ -685,8 +773,98 @@ public:
     double Area() const;
 
 private:
-    /// array of vertices
-    std::vector<VECTOR2I> m_points;
+    ///> An arc kept by a chain
+    struct CHAIN_ARC
+    {
+        SHAPE_ARC m_arc;
+        int       m_segmentCount;   ///< number of segments of the arc in the points
+        size_t    m_position;       ///< number of points of POINTS::m_points before the arc
+        VECTOR2I  m_end;            ///< last point of the segments
+    };
+
+    ///> The points of a chain, shared with its copies
+    struct POINTS
+    {
+        POINTS()
+        {}
+
+        POINTS( std::vector<VECTOR2I> aPoints, std::vector<CHAIN_ARC> aArcs = {} ) :
+            m_points( std::move( aPoints ) ),
+            m_arcs( std::move( aArcs ) )
+        {}
+
+        ~POINTS();
+
+        ///> Returns the points of a chain with arcs, built on the first call
+        const std::vector<VECTOR2I>& polyline() const;
+
+        ///> The points of the chain, or the points appended between its arcs if it has any
+        std::vector<VECTOR2I> m_points;
+
+        std::vector<CHAIN_ARC> m_arcs;
+
+        ///> Points of a chain with arcs, built by polyline()
+        mutable std::vector<VECTOR2I> m_polyline;
+        mutable std::atomic<bool>     m_polylineValid { false };
+        mutable std::mutex            m_polylineLock;
+
+        ///> Index of the edges, built by edgeIndex() and dropped by dropEdgeIndex()
+        mutable std::atomic<SHAPE_LINE_CHAIN_EDGE_INDEX*> m_edgeIndex { nullptr };
+    };
+
+    ///> Returns the points, for reading only
+    const std::vector<VECTOR2I>& points() const
+    {
+        static const std::vector<VECTOR2I> empty;
+
+        if( !m_points )
+            return empty;
+
+        return m_points->m_arcs.empty() ? m_points->m_points : m_points->polyline();
+    }
+
+    ///> Returns the points for a change, copied first if they are shared with another chain.
+    ///> The arcs are replaced by their segments.
+    std::vector<VECTOR2I>& mutablePoints()
+    {
+        if( !m_points )
+            m_points = std::make_shared<POINTS>();
+        else if( !m_points->m_arcs.empty() )
+            m_points = std::make_shared<POINTS>( m_points->polyline() );
+        else if( m_points.use_count() > 1 )
+            m_points = std::make_shared<POINTS>( m_points->m_points );
+        else if( m_points->m_edgeIndex.load( std::memory_order_relaxed ) )
+            dropEdgeIndex();
+
+        return m_points->m_points;
+    }
+
+    ///> Returns the index of the edges, built on the first call, or nullptr if the chain has
+    ///> too few points to be indexed
+    const SHAPE_LINE_CHAIN_EDGE_INDEX* edgeIndex() const;
+
+    void dropEdgeIndex();
+
+    ///> Returns the points and the arcs for a change keeping the arcs, copied first if they
+    ///> are shared with another chain
+    POINTS& mutableArcs();
+
+    ///> Returns the last point of a chain with arcs
+    const VECTOR2I& arcsLastPoint() const;
+
+    ///> Appends to a chain with arcs, or appends a chain with arcs
+    void appendToArcs( const VECTOR2I& aP, bool aAllowDuplication );
+    void appendToArcs( const SHAPE_LINE_CHAIN& aOtherLine );
+
+    void moveArcs( const VECTOR2I& aVector );
+
+    const BOX2I arcsBBox() const;
+
+    ///> Collide() for a chain with arcs, testing the arcs instead of their segments
+    bool collideArcs( const SEG& aSeg, int aClearance ) const;
+
+    /// array of vertices, shared with the copies of the chain (null when empty)
+    std::shared_ptr<POINTS> m_points;
 
     /// is the line chain closed?
     bool m_closed;
@@ -171,7 +171,7 @@ class SHAPE_POLY_SET : public SHAPE
                 if( m_currentPolygon != m_poly->OutlineCount() - 1 )
                     return false;
 
-                auto currentPolygon = m_poly->CPolygon( m_currentPolygon );
+                const POLYGON& currentPolygon = m_poly->CPolygon( m_currentPolygon );
 
                 return m_currentContour < (int) currentPolygon.size() - 1
                            || m_currentVertex < currentPolygon[m_currentContour].PointCount();
@@ -231,7 +231,7 @@ class SHAPE_POLY_SET : public SHAPE
 
             T& Get()
             {
-                return m_poly->Polygon( m_currentPolygon )[m_currentContour].Point( m_currentVertex );
+                return get( static_cast<T*>( nullptr ) );
             }
 
             T& operator*()
@@ -263,6 +263,17 @@ class SHAPE_POLY_SET : public SHAPE
         private:
             friend class SHAPE_POLY_SET;
 
+            ///> The const iterators read the points without unsharing them from other sets
+            VECTOR2I& get( VECTOR2I* )
+            {
+                return m_poly->Polygon( m_currentPolygon )[m_currentContour].Point( m_currentVertex );
+            }
+
+            const VECTOR2I& get( const VECTOR2I* )
+            {
+                return m_poly->CPolygon( m_currentPolygon )[m_currentContour].CPoint( m_currentVertex );
+            }
+
             SHAPE_POLY_SET* m_poly;
             int m_currentPolygon;
             int m_currentContour;
@@ -429,12 +440,20 @@ class SHAPE_POLY_SET : public SHAPE
 
         /**
          * Copy constructor SHAPE_POLY_SET
-         * Performs a deep copy of \p aOther into \p this.
+         * Copies \p aOther into \p this.  The contours share their points with \p aOther
+         * until one of the sets changes them, so the copy itself does not copy any vertex.
          * @param aOther is the SHAPE_POLY_SET object that will be copied.
-         * @param aDeepCopy if true, make new copies of the triangulated unique_ptr vector
+         * @param aDeepCopy if true, make new copies of the triangulated polygons instead of
+         *                  sharing them
          */
         SHAPE_POLY_SET( const SHAPE_POLY_SET& aOther, bool aDeepCopy = false );
 
+        /**
+         * Move constructor SHAPE_POLY_SET
+         * Takes the outlines and the triangulation of \p aOther, which is left empty.
+         */
+        SHAPE_POLY_SET( SHAPE_POLY_SET&& aOther ) noexcept;
+
         ~SHAPE_POLY_SET();
 
         /**
@@ -591,9 +610,9 @@ class SHAPE_POLY_SET : public SHAPE
          * @return SHAPE_POLY_SET - a set containing the polygons between aFirstPolygon (included)
          *                        and aLastPolygon (excluded).
          */
-        SHAPE_POLY_SET Subset( int aFirstPolygon, int aLastPolygon );
+        SHAPE_POLY_SET Subset( int aFirstPolygon, int aLastPolygon ) const;
 
-        SHAPE_POLY_SET UnitSet( int aPolygonIndex )
+        SHAPE_POLY_SET UnitSet( int aPolygonIndex ) const
         {
             return Subset( aPolygonIndex, aPolygonIndex + 1 );
         }
@@ -864,6 +883,17 @@ class SHAPE_POLY_SET : public SHAPE
         void BooleanIntersection( const SHAPE_POLY_SET& a, const SHAPE_POLY_SET& b,
                                   POLYGON_MODE aFastMode );
 
+        /**
+         * Performs the boolean operation aType (not a xor) between a and b as it is done for
+         * big sets, split into bands run on at most aMaxThreads threads (0 for the whole
+         * pool), and stores the result in itself.  The bands only depend on the sets, so
+         * the result does not depend on the thread count.  BooleanAdd() and the others use
+         * it for big sets: this is meant for the tests.
+         */
+        void BandedBooleanOp( ClipperLib::ClipType aType, const SHAPE_POLY_SET& a,
+                              const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode,
+                              size_t aMaxThreads = 0 );
+
         enum CORNER_STRATEGY
         {
             ALLOW_ACUTE_CORNERS,
@@ -1198,6 +1228,33 @@ class SHAPE_POLY_SET : public SHAPE
         void booleanOp( ClipperLib::ClipType aType, const SHAPE_POLY_SET& aShape,
                         const SHAPE_POLY_SET& aOtherShape, POLYGON_MODE aFastMode );
 
+        ///> Runs the boolean operation in a single Clipper call
+        void clipperBooleanOp( ClipperLib::ClipType aType, const SHAPE_POLY_SET& aShape,
+                               const SHAPE_POLY_SET& aOtherShape, POLYGON_MODE aFastMode );
+
+        /**
+         * Runs the boolean operation of large sets on the thread pool.  The polygons are split
+         * into bands along the longest side of the set, holding about the same number of
+         * points: all the polygons for a union, the ones of aShape otherwise, each band being
+         * combined with the polygons of aOtherShape overlapping it.  When aShape has only a
+         * few polygons, it is cut into strips holding the bands of aOtherShape instead.  The
+         * results of the bands are then merged two by two.
+         *
+         * The number of bands is fixed, so the result is the same on all machines.
+         * @param aMaxThreads limits the number of threads (0 for the whole pool)
+         */
+        void parallelBooleanOp( ClipperLib::ClipType aType, const SHAPE_POLY_SET& aShape,
+                                const SHAPE_POLY_SET& aOtherShape, POLYGON_MODE aFastMode,
+                                size_t aMaxThreads = 0 );
+
+        /**
+         * Sets this to the union of aA and aB, which are unions themselves.  Their polygons
+         * which cannot touch the other set, as they are before or after all of its polygons
+         * along the axis of the bands, are copied without going through Clipper.
+         */
+        void mergeBands( const SHAPE_POLY_SET& aA, const SHAPE_POLY_SET& aB, bool aAlongX,
+                         POLYGON_MODE aFastMode );
+
         bool pointInPolygon( const VECTOR2I& aP, const SHAPE_LINE_CHAIN& aPath,
                              bool aIgnoreEdges, bool aUseBBoxCaches = false ) const;
 
@@ -1259,17 +1316,50 @@ class SHAPE_POLY_SET : public SHAPE
     public:
 
         SHAPE_POLY_SET& operator=( const SHAPE_POLY_SET& );
+        SHAPE_POLY_SET& operator=( SHAPE_POLY_SET&& ) noexcept;
 
+        /**
+         * Triangulates the polygons of the set, if they changed since the last call.  Only
+         * the polygons which are not found unchanged in the previous triangulation, or in
+         * the one given to ReuseTriangulations(), are triangulated again.
+         */
         void CacheTriangulation();
         bool IsTriangulationUpToDate() const;
 
+        /**
+         * Keeps the triangulations of the polygons of \p aOther, for the next call to
+         * CacheTriangulation() to reuse them for the same polygons of this set (e.g. the
+         * islands of a zone which did not change with a refill).
+         */
+        void ReuseTriangulations( const SHAPE_POLY_SET& aOther );
+
         MD5_HASH GetHash() const;
 
     private:
 
         MD5_HASH checksum() const;
 
-        std::vector<std::unique_ptr<TRIANGULATED_POLYGON>> m_triangulatedPolys;
+        ///> Returns the hash of the outline and the holes of a polygon
+        static MD5_HASH polygonChecksum( const POLYGON& aPoly );
+
+        typedef std::vector<std::shared_ptr<const TRIANGULATED_POLYGON>> TRIANGULATION;
+
+        ///> Triangulates aPoly, appending the triangulated polygons to aTriangulation
+        static void triangulatePolygon( const POLYGON& aPoly, TRIANGULATION& aTriangulation );
+
+        ///> Triangulation of one polygon, kept while the polygon does not change
+        struct POLYGON_TRIANGULATION
+        {
+            MD5_HASH      m_hash;           ///< polygonChecksum() of the triangulated polygon
+            TRIANGULATION m_triangulation;
+        };
+
+        ///> Triangulations, shared with the copies of the set as they are never changed
+        TRIANGULATION m_triangulatedPolys;
+
+        ///> Triangulation of each polygon when up to date, and the candidates to reuse
+        ///> otherwise.  m_triangulatedPolys is their concatenation.
+        std::vector<POLYGON_TRIANGULATION> m_polyTriangulations;
         bool m_triangulationValid = false;
         MD5_HASH m_hash;
 
@@ -26,7 +26,11 @@
  * @brief Hashing functions for EDA_ITEMs.
  */
 
+#ifndef HASH_EDA_H
+#define HASH_EDA_H
+
 #include <cstdlib>
+#include <functional>
 
 class EDA_ITEM;
 
@@ -46,9 +50,34 @@ enum HASH_FLAGS
     ALL         = 0xff
 };
 
+/**
+ * Mixes the hash of aValue into aSeed, as boost::hash_combine() does.  Unlike a xor of the
+ * hashes, the result depends on the order of the values and equal values do not cancel out.
+ */
+template <typename T>
+inline void hash_combine( std::size_t& aSeed, const T& aValue )
+{
+    aSeed ^= std::hash<T>{}( aValue ) + 0x9e3779b9 + ( aSeed << 6 ) + ( aSeed >> 2 );
+}
+
 /*
  * Calculates hash of an EDA_ITEM.
  * @param aItem is the item for which the hash will be computed.
  * @return Hash value.
  */
 std::size_t hash_eda( const EDA_ITEM* aItem, int aFlags = HASH_FLAGS::ALL );
+
+/**
+ * Calculates the hash of an EDA_ITEM with all the HASH_FLAGS, the items of a footprint
+ * included, and caches it in the item until EDA_ITEM::InvalidateHash() is called.
+ *
+ * The items of a footprint are hashed in the coordinates of the footprint, so their cached
+ * hashes are still valid once the footprint is moved.  The hash is a fingerprint of the
+ * contents to detect changes between two runs of a tool, not a unique identifier.
+ * It must not be called from several threads at once on the same items.
+ * @param aItem is the item for which the hash will be computed.
+ * @return Hash value, never 0.
+ */
+std::size_t hash_eda_cached( const EDA_ITEM* aItem );
+
+#endif    // HASH_EDA_H
@@ -126,6 +126,22 @@ public:
         return m_buffer;
     }
 
+    /**
+     * Function GetResponseCode
+     * returns the HTTP status code of the last response of Perform(), i.e. 304 for a
+     * conditional request whose cached copy is still valid.
+     */
+    long GetResponseCode();
+
+    /**
+     * Function GetResponseHeader
+     * returns the value of a header of the last response of Perform(), after redirects.
+     *
+     * @param aName is the header name without the colon, compared case insensitively
+     * @return std::string - the header value, or an empty string if not received
+     */
+    std::string GetResponseHeader( const std::string& aName ) const;
+
 private:
     /**
      * Function setOption
@@ -141,6 +157,7 @@ private:
     CURL*           m_CURL;
     curl_slist*     m_headers;
     std::string     m_buffer;
+    std::string     m_response_headers;     ///< the header lines of the last response
 };
 
 #endif // KICAD_CURL_EASY_H_
@@ -94,6 +94,22 @@ std::string EscapedUTF8( const wxString& aString );
  */
 wxString EscapedHTML( const wxString& aString );
 
+/**
+ * Convert the decimal number at the start of \a aText to a double, as strtod() does, but
+ * without depending on the locale for the usual decimal numbers of the board and footprint
+ * files.
+ *
+ * The numbers with up to 15 significant digits and no exponent are converted exactly, by a
+ * single floating point operation.  The other ones go through strtod(), so the result is
+ * always the one strtod() gives in the C locale.
+ *
+ * @param aText is the text to convert.
+ * @param aEndPtr, if not NULL, gets the end of the converted text, or \a aText if there
+ *  is no number.
+ * @return the converted number, or 0 if there is no number.
+ */
+double StrToDouble( const char* aText, char** aEndPtr );
+
 /**
  * Read one line line from \a aFile.
  *
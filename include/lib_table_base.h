@@ -27,6 +27,10 @@
 #define _LIB_TABLE_BASE_H_
 
 #include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <boost/interprocess/exceptions.hpp>
 #include <boost/ptr_container/ptr_vector.hpp>
@@ -313,6 +317,7 @@ public:
     {
         rows.clear();
         nickIndex.clear();
+        ++m_version;
     }
 
     /**
@@ -426,6 +431,7 @@ public:
             if( *iter == *aRow )
             {
                 rows.erase( iter, iter + 1 );
+                ++m_version;
                 return true;
             }
         }
@@ -506,6 +512,8 @@ protected:
 
         for( LIB_TABLE_ROWS_ITER it = rows.begin(); it != rows.end(); ++it )
             nickIndex.insert( INDEX_VALUE( it->GetNickName(), it - rows.begin() ) );
+
+        ++m_version;
     }
 
     void ensureIndex()
@@ -529,6 +537,25 @@ protected:
     INDEX nickIndex;
 
     LIB_TABLE* fallBack;
+
+private:
+    /**
+     * Rebuild m_flatIndex if a table of the fall back chain was modified since it was built.
+     * Must be called with m_flatIndexLock held.
+     */
+    void ensureFlatIndex() const;
+
+    /// The rows of this table and of its fall back tables by nickname, so that a lookup is
+    /// a single hash search whatever the length of the chain.  An entry is the table holding
+    /// the row and the row index in this table.
+    typedef std::unordered_map<wxString, std::pair<LIB_TABLE*, int>> FLAT_INDEX;
+
+    /// incremented on each change of the rows through the LIB_TABLE API
+    unsigned    m_version;
+
+    mutable FLAT_INDEX  m_flatIndex;
+    mutable std::vector<std::pair<const LIB_TABLE*, unsigned>> m_flatIndexVersions;
+    mutable std::mutex  m_flatIndexLock;    ///< the libraries are loaded from several threads
 };
 
 #endif  // _LIB_TABLE_BASE_H_
@@ -28,6 +28,7 @@
 #include <base_struct.h>
 #include <lib_id.h>
 #include <import_export.h>
+#include <string_pool.h>
 
 /**
  * A mix-in to provide polymorphism between items stored in libraries (symbols, aliases
@@ -44,7 +45,13 @@ public:
     virtual const wxString& GetName() const = 0;
     virtual wxString GetLibNickname() const = 0;
 
-    virtual const wxString& GetDescription() = 0;
+    virtual wxString GetDescription() = 0;
+
+    /**
+     * @return the description, as stored in the library tree nodes.  Items keeping their
+     * description in a COMPACT_STRING return it, so that the nodes share it.
+     */
+    virtual COMPACT_STRING GetCompactDescription() { return GetDescription(); }
 
     virtual wxString GetSearchText() { return wxEmptyString; }
 
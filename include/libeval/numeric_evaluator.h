@@ -154,6 +154,12 @@ protected:
     /* Used by processing loop */
     void parse( int token, numEval::TokenType value );
 
+    /* Result cache for the expressions without variables, whose result only depends on
+     * their text and the units.  Returns true if aString was found and its result restored.
+     */
+    bool restoreCachedResult( const wxString& aString );
+    void cacheResult( const wxString& aString );
+
 private:
     void* m_parser; // the current lemon parser state machine
 
@@ -175,6 +181,12 @@ private:
     bool m_parseError;
     bool m_parseFinished;
 
+    /* Set by the tokenizer when the input reads or assigns a variable */
+    bool m_usesVariables;
+
+    /* The input string, as converted for the tokenizer */
+    std::string m_inputBuffer;
+
     Unit m_defaultUnits;      // Default unit for values
 
     wxString m_originalText;
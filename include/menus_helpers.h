@@ -51,6 +51,12 @@ void AddMenuLanguageList( CONDITIONAL_MENU* aMasterMenu, TOOL_INTERACTIVE* aCont
  */
 void AddBitmapToMenuItem( wxMenuItem* aMenu, const wxBitmap& aImage );
 
+/**
+ * Add the bitmap aImage to a menuitem, as above.  aImage is decoded only if the images
+ * are shown in the menus.
+ */
+void AddBitmapToMenuItem( wxMenuItem* aMenu, BITMAP_DEF aImage );
+
 
 /**
  * Function AddMenuItem
@@ -32,4 +32,27 @@
 extern const char* const newstroke_font[];        //The font
 extern const int         newstroke_font_bufsize;  //font buffer size
 
+/**
+ * Glyph of newstroke_font, decoded into the tables of newstroke_glyphs.cpp by
+ * helpers/tools_to_build_newstroke-font/fontdecode.awk.  The coordinates are in font units,
+ * the x ones from the left side of the glyph and the y ones from the base line.
+ */
+struct NEWSTROKE_GLYPH
+{
+    int m_FirstStroke;      ///< Index of the first stroke of the glyph in newstroke_strokes
+    int m_StrokeCount;      ///< Number of strokes of the glyph
+    int m_Width;            ///< Advance of the glyph
+    int m_MinY;             ///< Lowest y of the strokes and the base line
+    int m_MaxY;             ///< Highest y of the strokes and the base line
+};
+
+/**
+ * The glyphs, in the order of newstroke_font.  The points of the stroke i are the x, y pairs
+ * newstroke_strokes[i] to newstroke_strokes[i + 1] (excluded) of newstroke_points.
+ */
+extern const NEWSTROKE_GLYPH newstroke_glyphs[];
+extern const int             newstroke_glyph_count;
+extern const int             newstroke_strokes[];
+extern const signed char     newstroke_points[];
+
 #endif /* __NEWSTROKE_FONT_H__ */
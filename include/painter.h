@@ -359,6 +359,19 @@ public:
      */
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) = 0;
 
+    /**
+     * Function DrawProxy
+     * Draws a simplified representation of an item, used instead of Draw() when the VIEW is
+     * zoomed out below the level returned by VIEW_ITEM::ViewGetProxyLOD().
+     * @param aItem is an item to be drawn.
+     * @param aLayer is the currently rendered layer.
+     * @return false if the painter has no proxy for the item, so it is drawn with Draw().
+     */
+    virtual bool DrawProxy( const VIEW_ITEM* aItem, int aLayer )
+    {
+        return false;
+    }
+
 protected:
     /// Instance of graphic abstraction layer that gives an interface to call
     /// commands used to draw (eg. DrawLine, DrawCircle, etc.)
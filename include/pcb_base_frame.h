@@ -33,6 +33,7 @@
 
 
 #include <vector>
+#include <core/optional.h>
 #include <boost/interprocess/exceptions.hpp>
 
 #include <eda_draw_frame.h>
@@ -78,6 +79,9 @@ protected:
 
     PCB_GENERAL_SETTINGS m_configSettings;
 
+    ///> The layers changed since the last update of the 3D view, if only some were changed
+    OPT<LSET>            m_changed3DLayers;
+
     void updateZoomSelectBox();
     virtual void unitsChangeRefresh() override;
 
@@ -114,6 +118,13 @@ public:
      */
     virtual void Update3DView( bool aForceReload, const wxString* aTitle = nullptr );
 
+    /**
+     * Restrict the next update of the 3D view without forced reload to some layers.
+     * The layers of several calls are merged until the 3D view is updated.
+     * @param aLayers = the layers of the board items changed
+     */
+    void SetChanged3DLayers( const LSET& aLayers );
+
     /**
      * Function LoadFootprint
      * attempts to load \a aFootprintId from the footprint library table.
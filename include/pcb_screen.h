@@ -76,6 +76,12 @@ public:
      * So this function can be called to remove old commands
      */
     void ClearUndoORRedoList( UNDO_REDO_CONTAINER& aList, int aItemCount = -1 ) override;
+
+    /**
+     * Estimate the memory held by an undo/redo command, from the copies of the modified
+     * items and the deleted items it owns.  Moved, rotated and flipped items hold none.
+     */
+    size_t GetCommandMemorySize( const PICKED_ITEMS_LIST& aCommand ) const override;
 };
 
 #endif  // PCB_SCREEN_H
@@ -33,6 +33,7 @@
 #define PLOT_COMMON_H_
 
 #include <vector>
+#include <unordered_map>
 #include <math/box2.h>
 #include <gr_text.h>
 #include <page_info.h>
@@ -818,7 +819,7 @@ public:
     PDF_PLOTTER() : pageStreamHandle( 0 ), workFile( NULL )
     {
         // Avoid non initialized variables:
-        pageStreamHandle = streamLengthHandle = fontResDictHandle = 0;
+        pageStreamHandle = streamHandle = fontResDictHandle = pageResDictHandle = 0;
         pageTreeHandle = 0;
     }
 
@@ -891,14 +892,30 @@ protected:
     void closePdfObject();
     int startPdfStream(int handle = -1);
     void closePdfStream();
+
+    /**
+     * Compress the pending streams on the worker threads, and write them
+     */
+    void flushPdfStreams();
+
     int pageTreeHandle;		 /// Handle to the root of the page tree object
     int fontResDictHandle;	 /// Font resource dictionary
+    int pageResDictHandle;       /// Resource dictionary shared by all the pages
     std::vector<int> pageHandles;/// Handles to the page objects
     int pageStreamHandle;	 /// Handle of the page content object
-    int streamLengthHandle;      /// Handle to the deferred stream length
+    int streamHandle;            /// Handle of the stream being written in workFile
     wxString workFilename;
     FILE* workFile;  	         /// Temporary file to costruct the stream before zipping
     std::vector<long> xrefTable; /// The PDF xref offset table
+
+    /// A closed stream, not yet compressed and written
+    struct PENDING_STREAM
+    {
+        int         m_Handle;
+        std::string m_Data;
+    };
+
+    std::vector<PENDING_STREAM> pendingStreams;
 };
 
 class SVG_PLOTTER : public PSLIKE_PLOTTER
@@ -955,6 +972,27 @@ public:
      */
     virtual void EndBlock( void* aData ) override;
 
+    /**
+     * Function UseSymbols
+     * when enabled, the symbol blocks (see StartSymbol()) are written once as a SVG
+     * symbol, and every identical block as a use of this symbol.
+     * When disabled, they are written as usual blocks
+     */
+    void UseSymbols( bool aEnable ) { m_useSymbols = aEnable; }
+
+    /**
+     * calling this function starts a block of drawing items which may be repeated
+     * elsewhere in the plot, like the graphics of a footprint
+     * @param aOrigin is the anchor of the block in IUs: the identical blocks are the
+     * ones having the same items relative to their anchor
+     */
+    void StartSymbol( const wxPoint& aOrigin );
+
+    /**
+     * calling this function ends a block started by StartSymbol()
+     */
+    void EndSymbol();
+
     virtual void Text( const wxPoint&              aPos,
                        const COLOR4D               aColor,
                        const wxString&             aText,
@@ -969,6 +1007,18 @@ public:
                        void* aData = NULL ) override;
 
 protected:
+    std::string  m_outputBuffer;    // the output not yet written to the file
+    std::string* m_output;          // where the output goes: m_outputBuffer, or
+                                    // m_symbolBody inside a symbol block
+    std::string  m_pathData;        // the data of the path being merged: the consecutive
+                                    // lines, arcs and circles of the same style
+
+    bool         m_useSymbols;      // see UseSymbols()
+    std::string  m_symbolBody;      // the items of the current symbol block
+    wxPoint      m_symbolOrigin;    // the anchor of the current symbol block
+    wxPoint      m_savedPlotOffset; // plotOffset outside of the symbol blocks
+    std::unordered_map<std::string, int> m_symbols;  // the written symbols, by body
+
     FILL_T m_fillMode;              // true if the current contour
                                     // rect, arc, circle, polygon must be filled
     long m_pen_rgb_color;           // current rgb color value: each color has
@@ -1006,6 +1056,25 @@ protected:
      * prepare parameters for setSVGPlotStyle()
      */
     void setFillMode( FILL_T fill );
+
+    /**
+     * functions emitPrintf() and emitPuts()
+     * write to the output buffer (or to the current symbol block), like fprintf and fputs
+     */
+    void emitPrintf( const char* aFormat, ... );
+    void emitPuts( const char* aText );
+
+    /**
+     * function flushPath()
+     * write the path being merged, if any
+     */
+    void flushPath();
+
+    /**
+     * function flushOutput()
+     * write the output buffer to the file
+     */
+    void flushOutput();
 };
 
 /* Class to handle a D_CODE when plotting a board : */
@@ -1018,7 +1087,11 @@ public:
         Circle   = 1,
         Rect     = 2,
         Plotting = 3,
-        Oval     = 4
+        Oval     = 4,
+        // Aperture macros, used by the optimized output
+        RotRect   = 5,        // rotated rect
+        RotOval   = 6,        // rotated oval
+        RoundRect = 7         // round rect, rotated or not
     };
 
     wxSize        m_Size;     // horiz and Vert size
@@ -1027,6 +1100,8 @@ public:
     int           m_ApertureAttribute;  // the attribute attached to this aperture
                                         // Only one attribute is allowed by aperture
                                         // 0 = no specific aperture attribute
+    int           m_Radius;   // corner radius of RoundRect apertures
+    double        m_Rotation; // rotation in degrees of the aperture macros
 };
 
 
@@ -1159,6 +1234,13 @@ public:
     void UseX2format( bool aEnable ) { m_useX2format = aEnable; }
     void UseX2NetAttributes( bool aEnable ) { m_useNetAttributes = aEnable; }
 
+    /**
+     * Write smaller files: the rotated and round rect pads are flashed with aperture macros
+     * instead of being drawn as regions, the redundant corners of the polygons are removed,
+     * and the coordinates which do not change are not repeated.
+     */
+    void UseOptimizedOutput( bool aEnable ) { m_optimizedOutput = aEnable; }
+
     /**
      * calling this function allows one to define the beginning of a group
      * of drawing items (used in X2 format with netlist attributes)
@@ -1181,7 +1263,25 @@ protected:
      * write the DCode selection on gerber file
      */
     void selectAperture( const wxSize& aSize, APERTURE::APERTURE_TYPE aType,
-                         int aApertureAttribute );
+                         int aApertureAttribute )
+    {
+        selectAperture( aSize, 0, 0.0, aType, aApertureAttribute );
+    }
+
+    /**
+     * Same as above, for the aperture macros
+     * @param aRadius = the corner radius of RoundRect apertures
+     * @param aRotation = the rotation in degrees of the aperture macros
+     */
+    void selectAperture( const wxSize& aSize, int aRadius, double aRotation,
+                         APERTURE::APERTURE_TYPE aType, int aApertureAttribute );
+
+    /**
+     * Flash an aperture macro (optimized output only)
+     * @param aOrient = the orientation of the pad in 0.1 degrees
+     */
+    void flashApertureMacro( const wxPoint& aPos, const wxSize& aSize, int aRadius,
+                             double aOrient, APERTURE::APERTURE_TYPE aType, void* aData );
 
     /**
      * Emit a D-Code record, using proper conversions
@@ -1213,8 +1313,8 @@ protected:
      * @param aApertureAttribute = an aperture attribute of the tool (a tool can have onlu one attribute)
      * 0 = no specific attribute
      */
-    std::vector<APERTURE>::iterator getAperture( const wxSize& aSize,
-                    APERTURE::APERTURE_TYPE aType, int aApertureAttribute );
+    std::vector<APERTURE>::iterator getAperture( const wxSize& aSize, int aRadius,
+                    double aRotation, APERTURE::APERTURE_TYPE aType, int aApertureAttribute );
 
     // the attributes dictionnary created/modifed by %TO, attached the objects, when they are created
     // by D01, D03 G36/G37 commands
@@ -1237,9 +1337,49 @@ protected:
      */
     void writeApertureList();
 
+    /**
+     * Write the macro definition of an aperture macro
+     * @param aScale = the scale from IUs to the gerber units
+     */
+    void writeApertureMacro( const APERTURE& aTool, double aScale );
+
     std::vector<APERTURE>           apertures;
     std::vector<APERTURE>::iterator currentAperture;
 
+    /// The key of an aperture in m_apertureIndex: its type, size and attribute
+    struct APERTURE_KEY
+    {
+        APERTURE::APERTURE_TYPE m_Type;
+        wxSize                  m_Size;
+        int                     m_ApertureAttribute;
+        int                     m_Radius;
+        double                  m_Rotation;
+
+        bool operator==( const APERTURE_KEY& aOther ) const
+        {
+            return m_Type == aOther.m_Type && m_Size == aOther.m_Size
+                   && m_ApertureAttribute == aOther.m_ApertureAttribute
+                   && m_Radius == aOther.m_Radius && m_Rotation == aOther.m_Rotation;
+        }
+    };
+
+    struct APERTURE_KEY_HASH
+    {
+        size_t operator()( const APERTURE_KEY& aKey ) const
+        {
+            size_t seed = std::hash<int>()( aKey.m_Size.x );
+            seed ^= std::hash<int>()( aKey.m_Size.y ) + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+            seed ^= std::hash<int>()( aKey.m_Type * 256 + aKey.m_ApertureAttribute )
+                    + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+            seed ^= std::hash<double>()( aKey.m_Rotation ) + std::hash<int>()( aKey.m_Radius )
+                    + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+            return seed;
+        }
+    };
+
+    /// The index in apertures of each aperture, so getAperture does not search the list
+    std::unordered_map<APERTURE_KEY, size_t, APERTURE_KEY_HASH> m_apertureIndex;
+
     bool     m_gerberUnitInch;  // true if the gerber units are inches, false for mm
     int      m_gerberUnitFmt;   // number of digits in mantissa.
                                 // usually 6 in Inches and 5 or 6  in mm
@@ -1248,6 +1388,10 @@ protected:
                                 // If false (X1 format), these attributes will be added as comments.
     bool    m_useNetAttributes; // In recent gerber files, netlist info can be added.
                                 // It will be added if this param is true, using X2 or X1 format
+    bool    m_optimizedOutput;  // see UseOptimizedOutput()
+
+    wxPoint m_lastDevPos;       // the current point in the file, in gerber units
+    bool    m_lastDevPosValid;  // false until the current point is set
 };
 
 
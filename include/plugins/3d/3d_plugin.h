@@ -131,4 +131,13 @@ KICAD_PLUGIN_EXPORT bool CanRender( void );
  */
 KICAD_PLUGIN_EXPORT SCENEGRAPH* Load( char const* aFileName );
 
+/**
+ * Function IsThreadSafe
+ * is optional: a plugin which does not export it is called by one thread at a time.
+ *
+ * @return true if Load() may be called by several threads at once, that is the plugin
+ * has no global state and does not change the locale of the process
+ */
+KICAD_PLUGIN_EXPORT bool IsThreadSafe( void );
+
 #endif  // PLUGIN_3D_H
@@ -0,0 +1,165 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file profile_registry.h
+ * @brief Named scopes timed for the whole program, exported as a Chrome trace.
+ */
+
+#ifndef PROFILE_REGISTRY_H
+#define PROFILE_REGISTRY_H
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Class PROF_REGISTRY
+ *
+ * Collects the times of the PROF_SCOPEs of all the threads: each run of a scope is kept as
+ * an event of a Chrome trace (see chrome://tracing), and its time is added to the totals of
+ * its path, i.e. the names of the scopes it is nested in on its thread.
+ *
+ * Recording is off unless the KICAD_PROFILE_TRACE environment variable gives the file the
+ * trace is written to when the program exits.  When it is off, a scope costs a test.
+ */
+class PROF_REGISTRY
+{
+public:
+    using CLOCK = std::chrono::steady_clock;
+
+    static PROF_REGISTRY& Get();
+
+    static bool IsEnabled()
+    {
+        return m_enabled.load( std::memory_order_relaxed );
+    }
+
+    /**
+     * Starts or stops the recording.  The events already recorded are kept.
+     */
+    void Enable( bool aEnable );
+
+    /**
+     * Drops all the events and totals recorded
+     */
+    void Clear();
+
+    /**
+     * Writes the events as a Chrome trace, with the totals of each scope path in its
+     * "scopes" member.
+     */
+    void WriteTrace( std::ostream& aStream );
+
+    /**
+     * Writes the trace to aFileName.
+     * @return false if the file cannot be written
+     */
+    bool WriteTrace( const std::string& aFileName );
+
+    ///> Called at the end of a scope
+    void Record( const std::string& aName, const std::string& aPath, CLOCK::time_point aStart,
+                 CLOCK::time_point aEnd );
+
+private:
+    PROF_REGISTRY();
+
+    struct EVENT
+    {
+        std::string m_name;
+        int         m_thread;
+        long long   m_startUs;
+        long long   m_durationUs;
+    };
+
+    struct TOTAL
+    {
+        long long m_count;
+        double    m_totalMs;
+        double    m_maxMs;
+    };
+
+    ///> Events kept at most; the totals are still updated once there are more
+    static const size_t MAX_EVENTS = 1000000;
+
+    static std::atomic<bool> m_enabled;
+
+    std::mutex                   m_lock;
+    CLOCK::time_point            m_origin;
+    std::vector<EVENT>           m_events;
+    std::map<std::string, TOTAL> m_totals;
+};
+
+
+/**
+ * Class PROF_SCOPE
+ *
+ * Times the enclosing scope under aName for the PROF_REGISTRY, when it is recording.
+ * For example:
+ *
+ * void ZONE_FILLER::Fill(...)
+ * {
+ *     PROF_SCOPE scope( "zone fill" );
+ *     ...
+ * }
+ */
+class PROF_SCOPE
+{
+public:
+    PROF_SCOPE( const char* aName ) :
+        m_active( PROF_REGISTRY::IsEnabled() )
+    {
+        if( m_active )
+            begin( aName );
+    }
+
+    PROF_SCOPE( const std::string& aName ) :
+        m_active( PROF_REGISTRY::IsEnabled() )
+    {
+        if( m_active )
+            begin( aName );
+    }
+
+    ~PROF_SCOPE()
+    {
+        if( m_active )
+            end();
+    }
+
+private:
+    PROF_SCOPE( const PROF_SCOPE& ) = delete;
+    PROF_SCOPE& operator=( const PROF_SCOPE& ) = delete;
+
+    void begin( const std::string& aName );
+    void end();
+
+    bool                              m_active;
+    size_t                            m_parentPathLength;
+    PROF_REGISTRY::CLOCK::time_point m_start;
+};
+
+#endif    // PROFILE_REGISTRY_H
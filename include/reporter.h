@@ -25,8 +25,12 @@
 #ifndef _REPORTER_H_
 #define _REPORTER_H_
 
+#include <atomic>
+
 #include <wx/string.h>
 
+#include <sync_queue.h>
+
 /**
  * @file reporter.h
  * @author Wayne Stambaugh
@@ -203,6 +207,53 @@ public:
     bool HasMessage() const override;
 };
 
+/**
+ * Class QUEUED_REPORTER
+ *
+ * A reporter for the worker threads: the messages are queued without waiting on a lock, and
+ * passed in their order to another reporter, which usually writes to a widget, when Flush()
+ * is called from the main thread (e.g. on idle, or when a PROGRESS_REPORTER is refreshed).
+ */
+class QUEUED_REPORTER : public REPORTER
+{
+public:
+    QUEUED_REPORTER( REPORTER& aTarget ) :
+        REPORTER(),
+        m_target( aTarget ),
+        m_hasMessage( false )
+    {
+    }
+
+    REPORTER& Report( const wxString& aText, SEVERITY aSeverity = RPT_UNDEFINED ) override;
+
+    REPORTER& ReportTail( const wxString& aText, SEVERITY aSeverity = RPT_UNDEFINED ) override;
+
+    REPORTER& ReportHead( const wxString& aText, SEVERITY aSeverity = RPT_UNDEFINED ) override;
+
+    /**
+     * Function Flush
+     * passes the queued messages to the target reporter.
+     * *MUST* only be called from the main thread.
+     */
+    void Flush();
+
+    bool HasMessage() const override;
+
+private:
+    struct MESSAGE
+    {
+        wxString m_text;
+        SEVERITY m_severity = RPT_UNDEFINED;
+        LOCATION m_location = LOC_BODY;
+    };
+
+    void queue( const wxString& aText, SEVERITY aSeverity, LOCATION aLocation );
+
+    REPORTER&            m_target;
+    MPSC_QUEUE<MESSAGE>  m_queue;
+    std::atomic<bool>    m_hasMessage;
+};
+
 /**
  * Class NULL_REPORTER
  *
@@ -247,6 +247,54 @@ public:
 };
 
 
+/**
+ * Class WHOLE_FILE_LINE_READER
+ * is a LINE_READER that reads a file into memory in one go, and then returns each line
+ * in place in this buffer, without copying it into a line buffer.  This is the fastest
+ * way to read the big board and footprint files, at the cost of keeping the whole file
+ * in memory while reading it.
+ *
+ * The returned line is nul terminated as for the other LINE_READERs: its trailing nul
+ * temporarily replaces the first byte of the next line, which is restored on the next
+ * ReadLine().  Thus the line is only valid until the next ReadLine().
+ */
+class WHOLE_FILE_LINE_READER : public LINE_READER
+{
+protected:
+    std::vector<char>   m_buffer;   ///< the file contents, followed by a nul
+    size_t              m_size;     ///< no. bytes of the file contents
+    size_t              m_ndx;      ///< offset of the next line in m_buffer
+    char                m_nextChar; ///< first byte of the next line, replaced by a nul
+
+public:
+
+    /**
+     * Constructor WHOLE_FILE_LINE_READER
+     * reads the whole file @a aFileName into memory.
+     *
+     * @param aFileName is the name of the file to read and to use for error reporting purposes.
+     * @param aStartingLineNumber is the initial line number to report on error, see
+     *  FILE_LINE_READER.
+     * @param aMaxLineLength is the maximum allowed length of a line.
+     *
+     * @throw IO_ERROR if @a aFileName cannot be opened or read.
+     */
+    WHOLE_FILE_LINE_READER( const wxString& aFileName,
+            unsigned aStartingLineNumber = 0,
+            unsigned aMaxLineLength = LINE_READER_LINE_DEFAULT_MAX );
+
+    ~WHOLE_FILE_LINE_READER();
+
+    char* ReadLine() override;
+
+    /**
+     * Function Rewind
+     * goes back to the start of the file and resets the line number back to zero.
+     */
+    void Rewind();
+};
+
+
 /**
  * Class STRING_LINE_READER
  * is a LINE_READER that reads from a multiline 8 bit wide std::string
@@ -0,0 +1,94 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file string_pool.h
+ * @brief Compact storage for the strings held by many library items.
+ */
+
+#ifndef STRING_POOL_H
+#define STRING_POOL_H
+
+#include <memory>
+#include <string>
+
+#include <wx/string.h>
+
+
+/**
+ * Class COMPACT_STRING
+ * is an immutable string stored in UTF8, and shared by its copies.
+ *
+ * The texts of the library items (descriptions, keywords...) are mostly ASCII: UTF8 stores
+ * them in a quarter of the memory of a wxString where wchar_t has 32 bits.  Copying a
+ * COMPACT_STRING only shares the text, so the library tree nodes do not duplicate the
+ * texts of their items.  The text is converted when read as a wxString.
+ */
+class COMPACT_STRING
+{
+public:
+    COMPACT_STRING() {}
+
+    COMPACT_STRING( const wxString& aText );
+
+    bool IsEmpty() const { return !m_text || m_text->empty(); }
+
+    /// @return the UTF8 text
+    const char* c_str() const { return m_text ? m_text->c_str() : ""; }
+
+    wxString wx_str() const;
+
+    operator wxString () const { return wx_str(); }
+
+private:
+    std::shared_ptr<const std::string> m_text;     ///< null for an empty string
+};
+
+
+/**
+ * Class INTERNED_STRING
+ * refers to a string stored once in a process wide pool, for the few distinct strings
+ * repeated in many objects, like the library nicknames of the footprints.
+ *
+ * The pooled strings are never freed: only a small set of strings must be interned.
+ * Interning is thread safe; the interned strings are immutable.
+ */
+class INTERNED_STRING
+{
+public:
+    INTERNED_STRING();
+
+    INTERNED_STRING( const wxString& aText );
+
+    const wxString& Get() const { return *m_text; }
+
+    operator const wxString& () const { return *m_text; }
+
+    bool operator==( const INTERNED_STRING& aOther ) const { return m_text == aOther.m_text; }
+    bool operator!=( const INTERNED_STRING& aOther ) const { return m_text != aOther.m_text; }
+
+private:
+    const wxString* m_text;
+};
+
+#endif  // STRING_POOL_H
@@ -20,6 +20,7 @@
 #ifndef SYNC_QUEUE_H
 #define SYNC_QUEUE_H
 
+#include <atomic>
 #include <mutex>
 #include <queue>
 
@@ -111,4 +112,108 @@ public:
     }
 };
 
+
+/**
+ * Lock-free queue for many producer threads and a single consumer thread, e.g. worker threads
+ * reporting to the main thread.  Pushing never waits on a lock, but popping *MUST* only be
+ * done from one thread at a time.
+ *
+ * The values are kept in a list of nodes from the oldest to the newest: a producer swaps the
+ * newest node atomically, then links it to the previous one, so a value just pushed may not
+ * be popped yet until its link is written.
+ */
+template <typename T> class MPSC_QUEUE
+{
+    struct NODE
+    {
+        NODE() :
+            m_next( nullptr )
+        {
+        }
+
+        NODE( T&& aValue ) :
+            m_next( nullptr ),
+            m_value( std::move( aValue ) )
+        {
+        }
+
+        std::atomic<NODE*> m_next;
+        T                  m_value;
+    };
+
+    ///> The newest node, swapped by the producers
+    std::atomic<NODE*> m_head;
+
+    ///> The node before the oldest value, whose own value was already popped
+    NODE*              m_tail;
+
+public:
+    MPSC_QUEUE() :
+        m_tail( new NODE )
+    {
+        m_head.store( m_tail );
+    }
+
+    MPSC_QUEUE( const MPSC_QUEUE& ) = delete;
+    MPSC_QUEUE& operator=( const MPSC_QUEUE& ) = delete;
+
+    ~MPSC_QUEUE()
+    {
+        while( m_tail )
+        {
+            NODE* next = m_tail->m_next.load();
+            delete m_tail;
+            m_tail = next;
+        }
+    }
+
+    /**
+     * Push a value onto the queue, from any thread.
+     */
+    void push( T const& aValue )
+    {
+        T copy( aValue );
+        move_push( std::move( copy ) );
+    }
+
+    /**
+     * Move a value onto the queue, from any thread.
+     */
+    void move_push( T&& aValue )
+    {
+        NODE* node = new NODE( std::move( aValue ) );
+        NODE* prev = m_head.exchange( node, std::memory_order_acq_rel );
+
+        prev->m_next.store( node, std::memory_order_release );
+    }
+
+    /**
+     * Pop the oldest value off the queue into the provided variable.  If the queue is empty,
+     * the variable is not touched.  Only from the consumer thread.
+     *
+     * @return true iff a value was popped.
+     */
+    bool pop( T& aReceiver )
+    {
+        NODE* next = m_tail->m_next.load( std::memory_order_acquire );
+
+        if( !next )
+            return false;
+
+        aReceiver = std::move( next->m_value );
+
+        delete m_tail;
+        m_tail = next;
+        return true;
+    }
+
+    /**
+     * Return true iff there is no value to pop.  Only from the consumer thread.
+     */
+    bool empty() const
+    {
+        return m_tail->m_next.load( std::memory_order_acquire ) == nullptr;
+    }
+};
+
 #endif // SYNC_QUEUE_H
@@ -0,0 +1,150 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A pool of worker threads shared by the parallel parts of the interactive operations
+ * (connectivity, ratsnest, zone fills...), so that they do not create threads on each call,
+ * and do not use more threads than cores when they overlap.  There is one pool in each
+ * binary linking the common library.
+ *
+ * Each worker has its own task queue.  A task submitted by a worker goes to its own queue,
+ * and idle workers steal tasks from the other queues.
+ *
+ * Long running jobs, which would keep a worker busy for the whole session, should use
+ * their own thread instead.  A task must not wait for a future of another task: all the
+ * workers could be waiting.  ParallelFor() can be nested, as the calling thread also
+ * runs the loop.
+ */
+class THREAD_POOL
+{
+public:
+    typedef std::function<void()> TASK;
+
+    /**
+     * @return the pool of the program.  Its thread count is set by the MaxWorkerThreads
+     * advanced setting, and defaults to the number of cores the program may run on.
+     */
+    static THREAD_POOL& GetPool();
+
+    /**
+     * @return the number of cores the program may run on, which is less than the number of
+     * cores of the machine when its affinity is restricted (e.g. by taskset or a cgroup)
+     */
+    static size_t GetCoreCount();
+
+    size_t GetThreadCount() const
+    {
+        return m_workers.size();
+    }
+
+    /**
+     * @return the number of threads a job may use: the thread count of the pool, limited to
+     * aLimit if it is positive.  aLimit is usually the ADVANCED_CFG limit of the job.
+     */
+    size_t GetThreadCount( int aLimit ) const
+    {
+        return aLimit > 0 ? std::min<size_t>( m_workers.size(), aLimit ) : m_workers.size();
+    }
+
+    /**
+     * Queues aTask, to be run by one of the workers.
+     */
+    void Submit( TASK aTask );
+
+    /**
+     * Queues aFunc, and returns a future to wait for its result.
+     */
+    template <typename FUNC>
+    auto Async( FUNC aFunc ) -> std::future<decltype( aFunc() )>
+    {
+        typedef decltype( aFunc() ) RESULT;
+
+        auto task = std::make_shared<std::packaged_task<RESULT()>>( std::move( aFunc ) );
+        std::future<RESULT> result = task->get_future();
+
+        Submit( [task]()
+                {
+                    ( *task )();
+                } );
+
+        return result;
+    }
+
+    /**
+     * Runs aWork( i ) for each i of [0, aCount) on the workers, and returns when all of
+     * them are done.  The indices are taken by chunks of aChunkSize by the threads.
+     *
+     * The calling thread runs chunks too, unless aWaiting is set and the caller is not a
+     * worker: aWaiting is then called about every 100 ms while waiting for the workers, for
+     * instance to refresh a progress reporter.  An exception thrown by aWork is thrown
+     * again to the caller.
+     *
+     * @param aChunkSize is the number of indices taken at a time, 0 to split the loop into
+     * a few chunks per thread
+     * @param aMaxThreads limits the number of threads running the loop (0 for no limit)
+     */
+    void ParallelFor( size_t aCount, const std::function<void( size_t )>& aWork,
+                      size_t aChunkSize = 0, size_t aMaxThreads = 0,
+                      const std::function<void()>& aWaiting = nullptr );
+
+private:
+    THREAD_POOL( size_t aThreadCount );
+
+    THREAD_POOL( const THREAD_POOL& ) = delete;
+    THREAD_POOL& operator=( const THREAD_POOL& ) = delete;
+
+    struct QUEUE
+    {
+        std::mutex       m_lock;
+        std::deque<TASK> m_tasks;
+    };
+
+    ///> Pops a task of the worker queue, or steals one from the other queues
+    bool popTask( size_t aWorker, TASK& aTask );
+
+    void workerLoop( size_t aWorker );
+
+    std::vector<std::unique_ptr<QUEUE>> m_queues;
+    std::vector<std::thread>            m_workers;
+
+    std::mutex              m_wakeLock;
+    std::condition_variable m_wake;
+    size_t                  m_pending;      ///< queued tasks, protected by m_wakeLock
+
+    std::atomic<size_t>     m_nextQueue;    ///< round robin of the tasks from other threads
+};
+
+#endif // THREAD_POOL_H
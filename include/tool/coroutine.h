@@ -33,6 +33,65 @@
 
 #include <system/libcontext.h>
 #include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * Class COROUTINE_STACK_POOL
+ * Keeps the stacks of the finished coroutines, so the next ones do not have to allocate
+ * (and page in) their own.  A tool runs a new coroutine for each event starting one of its
+ * handlers, so the stacks are reused all the time.
+ */
+class COROUTINE_STACK_POOL
+{
+public:
+    ///< @return a stack of aSize bytes, from the pool if there is one
+    static std::unique_ptr<char[]> Get( size_t aSize )
+    {
+        {
+            std::lock_guard<std::mutex> lock( mutex() );
+
+            if( aSize == c_stackSize && !stacks().empty() )
+            {
+                std::unique_ptr<char[]> stack = std::move( stacks().back() );
+                stacks().pop_back();
+                return stack;
+            }
+        }
+
+        return std::unique_ptr<char[]>( new char[aSize] );
+    }
+
+    ///< Gives back a stack of aSize bytes; it is freed if the pool is full
+    static void Release( std::unique_ptr<char[]> aStack, size_t aSize )
+    {
+        std::lock_guard<std::mutex> lock( mutex() );
+
+        if( aStack && aSize == c_stackSize && stacks().size() < c_maxStacks )
+            stacks().push_back( std::move( aStack ) );
+    }
+
+    ///< Size of the pooled stacks
+    static constexpr size_t c_stackSize = 2000000;
+
+private:
+    ///< Stacks kept at most; more are only needed by deeply nested tools
+    static constexpr size_t c_maxStacks = 8;
+
+    // Never destroyed, as coroutines may be finished by static objects destructors
+    static std::vector<std::unique_ptr<char[]>>& stacks()
+    {
+        static std::vector<std::unique_ptr<char[]>>* pool =
+                new std::vector<std::unique_ptr<char[]>>;
+        return *pool;
+    }
+
+    static std::mutex& mutex()
+    {
+        static std::mutex* lock = new std::mutex;
+        return *lock;
+    }
+};
 
 /**
  *  Class COROUNTINE.
@@ -145,6 +204,9 @@ public:
 
     ~COROUTINE()
     {
+        #ifndef LIBCONTEXT_HAS_OWN_STACK
+        COROUTINE_STACK_POOL::Release( std::move( m_stack ), c_defaultStackSize );
+        #endif
     }
 
 public:
@@ -299,7 +361,7 @@ private:
 
         #ifndef LIBCONTEXT_HAS_OWN_STACK
         // fixme: Clean up stack stuff. Add a guard
-        m_stack.reset( new char[stackSize] );
+        m_stack = COROUTINE_STACK_POOL::Get( stackSize );
 
         // align to 16 bytes
         sp = (void*)((((ptrdiff_t) m_stack.get()) + stackSize - 0xf) & (~0x0f));
@@ -366,7 +428,7 @@ private:
         }
     }
 
-    static constexpr int c_defaultStackSize = 2000000;    // fixme: make configurable
+    static constexpr int c_defaultStackSize = COROUTINE_STACK_POOL::c_stackSize; // fixme: make configurable
 
     ///< coroutine stack
     std::unique_ptr<char[]> m_stack;
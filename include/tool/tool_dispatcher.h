@@ -98,6 +98,9 @@ private:
     ///> Handles mouse related events (click, motion, dragging).
     bool handleMouseButton( wxEvent& aEvent, int aIndex, bool aMotion );
 
+    ///> Sends the coalesced motion event to the tools, if there is one.
+    void dispatchPendingMotion();
+
     ///> Saves the state of key modifiers (Alt, Ctrl and so on).
     static int decodeModifiers( const wxKeyboardState* aState )
     {
@@ -124,6 +127,9 @@ private:
     ///> State of mouse buttons.
     std::vector<BUTTON_STATE*> m_buttons;
 
+    ///> Last motion event not sent to the tools yet, when the motion events are coalesced.
+    OPT<TOOL_EVENT> m_pendingMotion;
+
     ///> Returns the instance of VIEW, used by the application.
     KIGFX::VIEW* getView();
 
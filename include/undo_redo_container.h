@@ -129,6 +129,8 @@ public:
                                    * UR_UNSPECIFIED */
     wxPoint m_TransformPoint;     /* used to undo redo command by the same command: usually
                                    * need to know the rotate point or the move vector */
+    size_t  m_MemorySize;         /* estimated memory held by the command, set when it is
+                                   * pushed to an undo/redo list */
 
 private:
     std::vector <ITEM_PICKER> m_ItemsList;
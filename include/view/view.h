@@ -28,6 +28,7 @@
 #include <vector>
 #include <set>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 
 #include <math/box2.h>
@@ -65,6 +66,19 @@ public:
 
     typedef std::pair<VIEW_ITEM*, int> LAYER_ITEM_PAIR;
 
+    ///> Counters of the work done by the last Redraw()
+    struct REDRAW_STATS
+    {
+        ///> Number of layers that were redrawn
+        int m_layers;
+
+        ///> Number of items returned by the layer queries
+        int m_queriedItems;
+
+        ///> Number of items that passed the visibility and LOD tests
+        int m_drawnItems;
+    };
+
     /**
      * Constructor.
      * @param aIsDynamic decides whether we are creating a static or a dynamic VIEW.
@@ -88,6 +102,43 @@ public:
      */
     virtual void Add( VIEW_ITEM* aItem, int aDrawPriority = -1 );
 
+    /**
+     * Function BeginBulkAdd()
+     * Items added between BeginBulkAdd() and EndBulkAdd() are indexed all at once by
+     * EndBulkAdd(), which is much faster than indexing them one by one and gives better
+     * balanced layer trees.  The items cannot be queried nor updated in between.
+     */
+    void BeginBulkAdd()
+    {
+        m_bulkAdd = true;
+    }
+
+    /**
+     * Function EndBulkAdd()
+     * Indexes the items added since BeginBulkAdd(), together with the items already present.
+     */
+    void EndBulkAdd();
+
+    /**
+     * Function BeginBulkUpdate()
+     * Items added, removed, or updated in geometry or layers between BeginBulkUpdate() and
+     * EndBulkUpdate() are indexed all at once by EndBulkUpdate(), instead of leaving and
+     * entering the layer trees one by one.  This is much faster for large changes.  The items
+     * cannot be queried in between.
+     */
+    void BeginBulkUpdate()
+    {
+        m_bulkAdd = true;
+        m_bulkUpdate = true;
+    }
+
+    /**
+     * Function EndBulkUpdate()
+     * Indexes again the layers changed since BeginBulkUpdate().  The updated items are
+     * painted again by the next UpdateItems().
+     */
+    void EndBulkUpdate();
+
     /**
      * Function Remove()
      * Removes a VIEW_ITEM from the view.
@@ -107,6 +158,17 @@ public:
      */
     virtual int Query( const BOX2I& aRect, std::vector<LAYER_ITEM_PAIR>& aResult ) const;
 
+    /**
+     * Function QueryAllLayers()
+     * Finds all items that touch or are within the rectangle aRect, as Query() does, but
+     * on all the layers: the hidden and display only ones too.  Used to look up the model
+     * items near a point whatever their visibility.
+     * @param aRect area to search for items
+     * @param aResult result of the search, containing VIEW_ITEMs associated with their layers.
+     * @return Number of found items.
+     */
+    int QueryAllLayers( const BOX2I& aRect, std::vector<LAYER_ITEM_PAIR>& aResult ) const;
+
     /**
      * Sets the item visibility.
      *
@@ -416,6 +478,9 @@ public:
             // Target has to be redrawn after changing its visibility
             MarkTargetDirty( m_layers[aLayer].target );
             m_layers[aLayer].visible = aVisible;
+
+            if( aVisible && m_layers[aLayer].hasDeferredItems )
+                updateDeferredItems( aLayer );
         }
     }
 
@@ -538,12 +603,30 @@ public:
      */
     void ClearTargets();
 
+    /**
+     * Function ClipToDirtyArea()
+     * Restricts the following ClearTargets() and Redraw() to the area of the items updated since
+     * the last redraw, if no target has to be redrawn entirely and the GAL is able to restrict
+     * its drawing. The restriction is removed by Redraw().
+     * @return true if only a part of the screen is going to be redrawn.
+     */
+    bool ClipToDirtyArea();
+
     /**
      * Function Redraw()
      * Immediately redraws the whole view.
      */
     virtual void Redraw();
 
+    /**
+     * Function GetRedrawStats()
+     * Returns the counters of the work done by the last Redraw().
+     */
+    const REDRAW_STATS& GetRedrawStats() const
+    {
+        return m_redrawStats;
+    }
+
     /**
      * Function RecacheAllItems()
      * Rebuilds GAL display lists.
@@ -597,6 +680,7 @@ public:
     {
         wxCHECK( aTarget < TARGETS_NUMBER, /* void */ );
         m_dirtyTargets[aTarget] = true;
+        m_dirtyAreas[aTarget].SetMaximum();
     }
 
     /// Returns true if the layer is cached
@@ -621,7 +705,7 @@ public:
     void MarkDirty()
     {
         for( int i = 0; i < TARGETS_NUMBER; ++i )
-            m_dirtyTargets[i] = true;
+            MarkTargetDirty( i );
     }
 
     /**
@@ -721,6 +805,9 @@ protected:
         int                     id;              ///< layer ID
         RENDER_TARGET           target;          ///< where the layer should be rendered
         std::set<int>           requiredLayers;  ///< layers that have to be enabled to show the layer
+        bool                    hasDeferredItems; ///< are there items waiting for their geometry?
+        std::vector<VIEW_ITEM*> bulkItems;       ///< items waiting to be indexed by EndBulkAdd()
+        std::unordered_set<VIEW_ITEM*> bulkRemoved; ///< items leaving the tree at EndBulkUpdate()
     };
 
     // Convenience typedefs
@@ -742,6 +829,9 @@ protected:
     ///* Redraws contents within rect aRect
     void redrawRect( const BOX2I& aRect );
 
+    /// Marks a part of a target as dirty, unless the whole target is dirty already
+    void markTargetDirtyArea( int aTarget, const BOX2I& aArea );
+
     inline void markTargetClean( int aTarget )
     {
         wxCHECK( aTarget < TARGETS_NUMBER, /* void */ );
@@ -801,6 +891,21 @@ protected:
     /// Updates all informations needed to draw an item
     void updateItemGeometry( VIEW_ITEM* aItem, int aLayer );
 
+    /**
+     * Drops the cached geometry of an item on a hidden layer, instead of drawing it again.
+     * The geometry is created when the layer is shown (see updateDeferredItems()).
+     */
+    void deferItemGeometry( VIEW_ITEM* aItem, int aLayer );
+
+    /// Requests an update of the items on a layer that have no cached geometry
+    void updateDeferredItems( int aLayer );
+
+    /// Creates the cached proxy of an item, used when zoomed out (see PAINTER::DrawProxy())
+    void updateProxyGeometry( VIEW_ITEM* aItem, int aLayer );
+
+    /// Returns true if an item is drawn with its proxy at the current scale
+    bool isProxyDrawn( const VIEW_ITEM* aItem, int aLayer );
+
     /// Updates bounding box of an item
     void updateBbox( VIEW_ITEM* aItem );
 
@@ -865,6 +970,27 @@ protected:
     /// Flags to mark targets as dirty, so they have to be redrawn on the next refresh event
     bool m_dirtyTargets[TARGETS_NUMBER];
 
+    /// Part of each dirty target to be redrawn, the maximal box if the whole target is dirty
+    BOX2I m_dirtyAreas[TARGETS_NUMBER];
+
+    /// Area the redraw is restricted to by ClipToDirtyArea()
+    BOX2I m_clipArea;
+
+    /// Is the redraw restricted to m_clipArea?
+    bool m_isClipped;
+
+    /// Counters of the last Redraw()
+    REDRAW_STATS m_redrawStats;
+
+    /// Are the added items collected until EndBulkAdd()?
+    bool m_bulkAdd;
+
+    /// Are the removed and updated items collected until EndBulkUpdate()?
+    bool m_bulkUpdate;
+
+    /// Items removed since BeginBulkUpdate(), still in m_allItems
+    std::unordered_set<VIEW_ITEM*> m_bulkRemoved;
+
     /// Rendering order modifier for layers that are marked as top layers
     static const int TOP_LAYER_MODIFIER;
 
@@ -58,7 +58,8 @@ enum VIEW_UPDATE_FLAGS {
     LAYERS      = 0x08,     /// Layers have changed
     INITIAL_ADD = 0x10,     /// Item is being added to the view
     REPAINT     = 0x20,     /// Item needs to be redrawn
-    ALL         = 0xef      /// All except INITIAL_ADD
+    PROXY       = 0x100,    /// Simplified geometry of the item is needed (see ViewGetProxyLOD())
+    ALL         = 0xef      /// All except INITIAL_ADD and PROXY
 };
 
 /**
@@ -143,6 +144,20 @@ public:
         return 0;
     }
 
+    /**
+     * Function ViewGetProxyLOD()
+     * Returns the minimal VIEW scale at which the item is drawn with its full geometry on a given
+     * layer. At lower scales it is drawn with a simplified proxy instead (see PAINTER::DrawProxy()).
+     * @param aLayer: current drawing layer
+     * @param aView: pointer to the VIEW device we are drawing on
+     * @return the level of detail of the full geometry. 0 never uses the proxy.
+     */
+    virtual unsigned int ViewGetProxyLOD( int aLayer, VIEW* aView ) const
+    {
+        // By default always draw the full geometry
+        return 0;
+    }
+
 public:
 
     VIEW_ITEM_DATA* viewPrivData() const
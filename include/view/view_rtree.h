@@ -55,6 +55,24 @@ public:
         VIEW_RTREE_BASE::Insert( mmin, mmax, aItem );
     }
 
+    /**
+     * Function BulkLoad()
+     * Replaces the contents of the tree by aItems.  Packing all the items at once is much
+     * faster than inserting them one by one, and gives a better balanced tree.
+     */
+    void BulkLoad( const std::vector<VIEW_ITEM*>& aItems )
+    {
+        VIEW_RTREE_BASE::BulkLoad( aItems, []( VIEW_ITEM* aItem, int* aMin, int* aMax )
+                {
+                    const BOX2I& bbox = aItem->ViewBBox();
+
+                    aMin[0] = bbox.GetX();
+                    aMin[1] = bbox.GetY();
+                    aMax[0] = bbox.GetRight();
+                    aMax[1] = bbox.GetBottom();
+                } );
+    }
+
     /**
      * Function Remove()
      * Removes an item from the tree. Removal is done by comparing pointers, attepmting to remove a copy
@@ -635,6 +635,12 @@ protected:
      */
     void UpdateViewBoundary( wxCoord xnew, wxCoord ynew );
 
+    /** Draws the locus as a continuous line, within the given pixel limits.
+     *  This implementation draws a line to each point changing the X pixel coordinate.
+     */
+    virtual void PlotContinuous( wxDC& dc, mpWindow& w, wxCoord startPx, wxCoord endPx,
+                                 wxCoord minYpx, wxCoord maxYpx );
+
     DECLARE_DYNAMIC_CLASS( mpFXY )
 };
 
@@ -1572,6 +1578,34 @@ protected:
      */
     double m_minX, m_maxX, m_minY, m_maxY;
 
+    /** Minimum and maximum Y values of the samples in buckets of 4, 16, 64... samples
+     *  (level 0, 1, 2...), so that a continuous line is drawn with a few lines per pixel
+     *  column whatever the number of samples.  Built when plotting, for the samples added
+     *  since the last plot only.
+     */
+    std::vector<std::vector<std::pair<double, double> > > m_minMaxLevels;
+
+    /** Number of samples m_minMaxLevels was built for
+     */
+    size_t m_minMaxSize;
+
+    /** True if the X values never decrease, so the visible samples and the samples of each
+     *  pixel column can be found by bisection
+     */
+    bool m_sortedX;
+
+    /** Extends m_minMaxLevels to the samples added since it was built
+     */
+    void UpdateMinMaxLevels();
+
+    /** Draws the samples of each pixel column as a vertical line from their minimum to
+     *  their maximum, read from the coarsest level of m_minMaxLevels with several buckets
+     *  per column, so the drawing time depends on the width of the plot and not on the
+     *  number of samples.
+     */
+    void PlotContinuous( wxDC& dc, mpWindow& w, wxCoord startPx, wxCoord endPx,
+                         wxCoord minYpx, wxCoord maxYpx ) override;
+
     /** Rewind value enumeration with mpFXY::GetNextXY.
      *  Overridden in this implementation.
      */
@@ -25,17 +25,19 @@
 #ifndef __PROGRESS_REPORTER
 #define __PROGRESS_REPORTER
 
-#include <mutex>
 #include <atomic>
 
+#include <sync_queue.h>
+
 #include <wx/progdlg.h>
 #include <wx/gauge.h>
 
 /**
  * A progress reporter for use in multi-threaded environments.  The various advancement
- * and message methods can be called from sub-threads.  The KeepRefreshing method *MUST*
- * be called only from the main thread (primarily a MSW requirement, which won't allow
- * access to UI objects allocated from a separate thread).
+ * and message methods can be called from sub-threads, and never wait on a lock: the messages
+ * are queued until the UI is updated.  The KeepRefreshing method *MUST* be called only from
+ * the main thread (primarily a MSW requirement, which won't allow access to UI objects
+ * allocated from a separate thread).
  */
 class PROGRESS_REPORTER
 {
@@ -66,9 +68,10 @@ class PROGRESS_REPORTER
         void SetMaxProgress( int aMaxProgress );
 
         /**
-         * Increment the progress bar length (inside the current virtual zone)
+         * Increment the progress bar length (inside the current virtual zone) by aCount,
+         * e.g. once for a whole chunk of a parallel loop
          */
-        void AdvanceProgress();
+        void AdvanceProgress( int aCount = 1 );
 
         /**
          * Update the UI dialog.  *MUST* only be called from the main thread.
@@ -88,10 +91,20 @@ class PROGRESS_REPORTER
 
         int currentProgress() const;
 
+        /**
+         * Returns the last message reported, after emptying the queue of the reported ones.
+         * *MUST* only be called from the main thread.
+         */
+        const wxString& currentMessage();
+
         virtual bool updateUI() = 0;
 
+        ///> The messages reported since the last update of the UI
+        MPSC_QUEUE<wxString> m_messages;
+
+        ///> The last message, only read and written by the main thread
         wxString           m_rptMessage;
-        mutable std::mutex m_mutex;
+
         std::atomic_int    m_phase;
         std::atomic_int    m_numPhases;
         std::atomic_int    m_progress;
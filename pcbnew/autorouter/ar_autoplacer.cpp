@@ -25,6 +25,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <tuple>
+
 #include <fctsys.h>
 #include <confirm.h>
 #include <pcbnew.h>
@@ -41,6 +43,8 @@
 #include <connectivity/connectivity_data.h>
 #include <ratsnest_data.h>
 #include <widgets/progress_reporter.h>
+#include <advanced_config.h>
+#include <thread_pool.h>
 #include "ar_matrix.h"
 #include "ar_cell.h"
 #include "ar_autoplacer.h"
@@ -144,6 +148,8 @@ int AR_AUTOPLACER::genPlacementRoutingMatrix()
         memcpy( m_matrix.m_BoardSide[AR_SIDE_TOP], m_matrix.m_BoardSide[AR_SIDE_BOTTOM],
                 nbCells * sizeof(AR_MATRIX::MATRIX_CELL) );
 
+    m_matrix.InvalidatePlacementMaps();
+
     return 1;
 }
 
@@ -431,7 +437,7 @@ void AR_AUTOPLACER::genModuleOnRoutingMatrix( MODULE* Module )
  *
  * Returns OUT_OF_BOARD, or OCCUPED_By_MODULE or FREE_CELL if OK
  */
-int AR_AUTOPLACER::testRectangle( const EDA_RECT& aRect, int side )
+int AR_AUTOPLACER::testRectangle( const EDA_RECT& aRect, int side ) const
 {
     EDA_RECT rect = aRect;
 
@@ -466,21 +472,12 @@ int AR_AUTOPLACER::testRectangle( const EDA_RECT& aRect, int side )
     if( col_max >= ( m_matrix.m_Ncols - 1 ) )
         col_max = m_matrix.m_Ncols - 1;
 
-    for( int row = row_min; row <= row_max; row++ )
+    switch( m_matrix.TestPlacementArea( row_min, row_max, col_min, col_max, side ) )
     {
-        for( int col = col_min; col <= col_max; col++ )
-        {
-            unsigned int data = m_matrix.GetCell( row, col, side );
-
-            if( ( data & CELL_IS_ZONE ) == 0 )
-                return AR_OUT_OF_BOARD;
-
-            if( (data & CELL_IS_MODULE) )
-                return AR_OCCUIPED_BY_MODULE;
-        }
+    case AR_MATRIX::PLACEMENT_OUT_OF_BOARD: return AR_OUT_OF_BOARD;
+    case AR_MATRIX::PLACEMENT_ON_MODULE:    return AR_OCCUIPED_BY_MODULE;
+    default:                                return AR_FREE_CELL;
     }
-
-    return AR_FREE_CELL;
 }
 
 int AR_AUTOPLACER::testModuleByPolygon( MODULE* aModule, int aSide, const wxPoint& aOffset )
@@ -504,7 +501,7 @@ int AR_AUTOPLACER::testModuleByPolygon( MODULE* aModule, int aSide, const wxPoin
  * aRect):
  * (Sum of cells in terms of distance)
  */
-unsigned int AR_AUTOPLACER::calculateKeepOutArea( const EDA_RECT& aRect, int side )
+unsigned int AR_AUTOPLACER::calculateKeepOutArea( const EDA_RECT& aRect, int side ) const
 {
     wxPoint start   = aRect.GetOrigin();
     wxPoint end     = aRect.GetEnd();
@@ -535,21 +532,9 @@ unsigned int AR_AUTOPLACER::calculateKeepOutArea( const EDA_RECT& aRect, int sid
     if( col_max >= ( m_matrix.m_Ncols - 1 ) )
         col_max = m_matrix.m_Ncols - 1;
 
-    unsigned int keepOutCost = 0;
-
-    for( int row = row_min; row <= row_max; row++ )
-    {
-        for( int col = col_min; col <= col_max; col++ )
-        {
-            // m_matrix.GetDist returns the "cost" of the cell
-            // at position (row, col)
-            // in autoplace this is the cost of the cell, if it is
-            // inside aRect
-            keepOutCost += m_matrix.GetDist( row, col, side );
-        }
-    }
-
-    return keepOutCost;
+    // The distance of a cell is its "cost" in autoplace: the keep out cost is the sum of
+    // the costs of the cells inside aRect
+    return m_matrix.GetDistSum( row_min, row_max, col_min, col_max, side );
 }
 
 
@@ -557,7 +542,8 @@ unsigned int AR_AUTOPLACER::calculateKeepOutArea( const EDA_RECT& aRect, int sid
  * Returns the value TstRectangle().
  * Module is known by its bounding box
  */
-int AR_AUTOPLACER::testModuleOnBoard( MODULE* aModule, bool TstOtherSide, const wxPoint& aOffset )
+int AR_AUTOPLACER::testModuleOnBoard( MODULE* aModule, bool TstOtherSide,
+                                      const wxPoint& aOffset ) const
 {
     int side = AR_SIDE_TOP;
     int otherside = AR_SIDE_BOTTOM;
@@ -570,8 +556,6 @@ int AR_AUTOPLACER::testModuleOnBoard( MODULE* aModule, bool TstOtherSide, const
     EDA_RECT    fpBBox = aModule->GetFootprintRect();
     fpBBox.Move( -aOffset );
 
-    buildFpAreas( aModule, 0 );
-
     int diag = //testModuleByPolygon( aModule, side, aOffset );
         testRectangle( fpBBox, side );
 //printf("test %p diag %d\n", aModule, diag);fflush(0);
@@ -594,17 +578,55 @@ int AR_AUTOPLACER::testModuleOnBoard( MODULE* aModule, bool TstOtherSide, const
 }
 
 
+double AR_AUTOPLACER::scorePlacement( MODULE* aModule, bool aTstOtherSide,
+                                      const wxPoint& aOffset ) const
+{
+    int keepOutCost = testModuleOnBoard( aModule, aTstOtherSide, aOffset );
+
+    if( keepOutCost < 0 )    // i.e. if the module cannot be put here
+        return -1.0;
+
+    return computePlacementRatsnestCost( aModule, aOffset ) + keepOutCost;
+}
+
+
+namespace
+{
+
+/// A position of the footprint on the placement grid, and its score (negative if the
+/// footprint cannot be put there)
+struct PLACEMENT_SCORE
+{
+    double m_score = -1.0;
+    int    m_col = 0;
+    int    m_row = 0;
+};
+
+
+/**
+ * @return true if aCandidate is a better position than aBest.  On equal scores the last
+ * position in the column by column order wins, as when the grid was tried in this order.
+ */
+bool isBetterPlacement( const PLACEMENT_SCORE& aCandidate, const PLACEMENT_SCORE& aBest )
+{
+    if( aCandidate.m_score < 0 )
+        return false;
+
+    if( aBest.m_score < 0 || aCandidate.m_score != aBest.m_score )
+        return aBest.m_score < 0 || aCandidate.m_score < aBest.m_score;
+
+    return std::tie( aCandidate.m_col, aCandidate.m_row ) > std::tie( aBest.m_col, aBest.m_row );
+}
+
+}
+
+
 int AR_AUTOPLACER::getOptimalModulePlacement(MODULE* aModule)
 {
-    int     error = 1;
-    wxPoint LastPosOK;
-    double  min_cost, curr_cost, Score;
     bool    TstOtherSide;
 
     aModule->CalculateBoundingBox();
 
-    LastPosOK = m_matrix.m_BrdBox.GetOrigin();
-
     wxPoint     mod_pos = aModule->GetPosition();
     EDA_RECT    fpBBox  = aModule->GetFootprintRect();
 
@@ -622,9 +644,6 @@ int AR_AUTOPLACER::getOptimalModulePlacement(MODULE* aModule)
     initialPos.x    -= initialPos.x % m_matrix.m_GridRouting;
     initialPos.y    -= initialPos.y % m_matrix.m_GridRouting;
 
-    m_curPosition = initialPos;
-    auto moduleOffset = mod_pos - m_curPosition;
-
     /* Examine pads, and set TstOtherSide to true if a footprint
      * has at least 1 pad through.
      */
@@ -644,54 +663,145 @@ int AR_AUTOPLACER::getOptimalModulePlacement(MODULE* aModule)
         }
     }
 
-    fpBBox.SetOrigin( fpBBoxOrg + m_curPosition );
+    buildFpAreas( aModule, 0 );
+
+    // The placement tests read the occupancy and distance maps, built once for all the
+    // positions
+    m_matrix.UpdatePlacementMaps();
+
+    // The positions tried are initialPos + (col, row) * grid, below xylimit
+    int grid = m_matrix.m_GridRouting;
+    int colCount = std::max( 0, ( xylimit.x - initialPos.x + grid - 1 ) / grid );
+    int rowCount = std::max( 0, ( xylimit.y - initialPos.y + grid - 1 ) / grid );
+
+    // The matrix and the board are not changed while the positions are scored, so the
+    // positions are scored on the worker threads, each one keeping its own best position.
+    auto score =
+            [&]( int aCol, int aRow ) -> PLACEMENT_SCORE
+            {
+                wxPoint pos( initialPos.x + aCol * grid, initialPos.y + aRow * grid );
+
+                return { scorePlacement( aModule, TstOtherSide, mod_pos - pos ), aCol, aRow };
+            };
+
+    // Scores the grid positions every aStep cells, column by column.  The valid positions
+    // are also added to aValid if it is not null.
+    auto scanGrid =
+            [&]( int aStep, std::vector<PLACEMENT_SCORE>* aValid ) -> PLACEMENT_SCORE
+            {
+                size_t columns = ( colCount + aStep - 1 ) / aStep;
 
-    min_cost = -1.0;
-//    m_frame->SetStatusText( wxT( "Score ??, pos ??" ) );
+                std::vector<PLACEMENT_SCORE>              bestOfColumn( columns );
+                std::vector<std::vector<PLACEMENT_SCORE>> validOfColumn( aValid ? columns : 0 );
+
+                THREAD_POOL::GetPool().ParallelFor( columns,
+                        [&]( size_t aColumn )
+                        {
+                            for( int row = 0; row < rowCount; row += aStep )
+                            {
+                                PLACEMENT_SCORE candidate = score( aColumn * aStep, row );
+
+                                if( candidate.m_score < 0 )
+                                    continue;
+
+                                if( aValid )
+                                    validOfColumn[aColumn].push_back( candidate );
+
+                                if( isBetterPlacement( candidate, bestOfColumn[aColumn] ) )
+                                    bestOfColumn[aColumn] = candidate;
+                            }
+                        }, 1 );
+
+                PLACEMENT_SCORE best;
+
+                for( size_t ii = 0; ii < columns; ++ii )
+                {
+                    if( isBetterPlacement( bestOfColumn[ii], best ) )
+                        best = bestOfColumn[ii];
+
+                    if( aValid )
+                        aValid->insert( aValid->end(), validOfColumn[ii].begin(),
+                                        validOfColumn[ii].end() );
+                }
 
+                return best;
+            };
 
-    for( ; m_curPosition.x < xylimit.x; m_curPosition.x += m_matrix.m_GridRouting )
+    int             step = ADVANCED_CFG::GetCfg().m_autoplaceCoarseStep;
+    PLACEMENT_SCORE best;
+
+    if( step > 1 && colCount > 2 * step && rowCount > 2 * step )
     {
-        m_curPosition.y = initialPos.y;
+        // Coarse pass: try the positions every step cells, then try every cell around the
+        // best coarse positions only
+        const size_t                 refinedCount = 8;
+        std::vector<PLACEMENT_SCORE> coarse;
 
-        for( ; m_curPosition.y < xylimit.y; m_curPosition.y += m_matrix.m_GridRouting )
-        {
+        best = scanGrid( step, &coarse );
 
-            fpBBox.SetOrigin( fpBBoxOrg + m_curPosition );
-            moduleOffset = mod_pos - m_curPosition;
-            int keepOutCost = testModuleOnBoard( aModule, TstOtherSide, moduleOffset );
+        size_t kept = std::min( refinedCount, coarse.size() );
 
-            if( keepOutCost >= 0 )    // i.e. if the module can be put here
-            {
-                error = 0;
-                // m_frame->build_ratsnest_module( aModule ); // fixme
-                curr_cost   = computePlacementRatsnestCost( aModule, moduleOffset );
-                Score       = curr_cost + keepOutCost;
+        std::partial_sort( coarse.begin(), coarse.begin() + kept, coarse.end(),
+                           []( const PLACEMENT_SCORE& a, const PLACEMENT_SCORE& b )
+                           {
+                               return isBetterPlacement( a, b );
+                           } );
 
-                if( (min_cost >= Score ) || (min_cost < 0 ) )
+        std::vector<std::pair<int, int>> cells;
+
+        for( size_t ii = 0; ii < kept; ++ii )
+        {
+            for( int col = std::max( 0, coarse[ii].m_col - step + 1 );
+                    col < std::min( colCount, coarse[ii].m_col + step ); ++col )
+            {
+                for( int row = std::max( 0, coarse[ii].m_row - step + 1 );
+                        row < std::min( rowCount, coarse[ii].m_row + step ); ++row )
                 {
-                    LastPosOK   = m_curPosition;
-                    min_cost    = Score;
-                    wxString msg;
-/*                    msg.Printf( wxT( "Score %g, pos %s, %s" ),
-                                min_cost,
-                                GetChars( ::CoordinateToString( LastPosOK.x ) ),
-                                GetChars( ::CoordinateToString( LastPosOK.y ) ) );
-                    m_frame->SetStatusText( msg );*/
+                    cells.emplace_back( col, row );
                 }
             }
         }
+
+        // The windows of close coarse positions overlap
+        std::sort( cells.begin(), cells.end() );
+        cells.erase( std::unique( cells.begin(), cells.end() ), cells.end() );
+
+        std::vector<PLACEMENT_SCORE> refined( cells.size() );
+
+        THREAD_POOL::GetPool().ParallelFor( cells.size(),
+                [&]( size_t ii )
+                {
+                    refined[ii] = score( cells[ii].first, cells[ii].second );
+                } );
+
+        for( const PLACEMENT_SCORE& candidate : refined )
+        {
+            if( isBetterPlacement( candidate, best ) )
+                best = candidate;
+        }
+
+        // The coarse grid may miss all the free places of a crowded board
+        if( best.m_score < 0 )
+            best = scanGrid( 1, nullptr );
+    }
+    else
+    {
+        best = scanGrid( 1, nullptr );
     }
 
     // Regeneration of the modified variable.
-    m_curPosition = LastPosOK;
+    if( best.m_score >= 0 )
+        m_curPosition = initialPos + wxPoint( best.m_col * grid, best.m_row * grid );
+    else
+        m_curPosition = m_matrix.m_BrdBox.GetOrigin();
 
-    m_minCost = min_cost;
-    return error;
+    m_minCost = best.m_score;
+    return best.m_score < 0 ? 1 : 0;
 }
 
 
-const D_PAD* AR_AUTOPLACER::nearestPad( MODULE *aRefModule, D_PAD* aRefPad, const wxPoint& aOffset)
+const D_PAD* AR_AUTOPLACER::nearestPad( MODULE *aRefModule, D_PAD* aRefPad,
+                                        const wxPoint& aOffset ) const
 {
     const D_PAD* nearest = nullptr;
     int64_t nearestDist = INT64_MAX;
@@ -723,7 +833,8 @@ const D_PAD* AR_AUTOPLACER::nearestPad( MODULE *aRefModule, D_PAD* aRefPad, cons
 }
 
 
-double AR_AUTOPLACER::computePlacementRatsnestCost( MODULE *aModule, const wxPoint& aOffset )
+double AR_AUTOPLACER::computePlacementRatsnestCost( MODULE *aModule,
+                                                    const wxPoint& aOffset ) const
 {
     double  curr_cost;
     VECTOR2I start;      // start point of a ratsnest
@@ -103,12 +103,21 @@ private:
     bool         fillMatrix();
     void         genModuleOnRoutingMatrix( MODULE* Module );
 
-    int          testRectangle( const EDA_RECT& aRect, int side );
+    int          testRectangle( const EDA_RECT& aRect, int side ) const;
     int          testModuleByPolygon( MODULE* aModule,int aSide, const wxPoint& aOffset );
-    unsigned int calculateKeepOutArea( const EDA_RECT& aRect, int side );
-    int          testModuleOnBoard( MODULE* aModule, bool TstOtherSide, const wxPoint& aOffset );
+    unsigned int calculateKeepOutArea( const EDA_RECT& aRect, int side ) const;
+    int          testModuleOnBoard( MODULE* aModule, bool TstOtherSide,
+                                    const wxPoint& aOffset ) const;
     int          getOptimalModulePlacement( MODULE* aModule );
-    double       computePlacementRatsnestCost( MODULE* aModule, const wxPoint& aOffset );
+    double       computePlacementRatsnestCost( MODULE* aModule, const wxPoint& aOffset ) const;
+
+    /**
+     * @return the cost of moving aModule by -aOffset: its keep out cost plus the cost of its
+     * ratsnest, or a negative value if it cannot be placed there.  Only reads the matrix and
+     * the board, so it can be run on several threads at once.
+     */
+    double       scorePlacement( MODULE* aModule, bool aTstOtherSide,
+                                 const wxPoint& aOffset ) const;
 
     /**
      * Find the "best" module place. The criteria are:
@@ -118,7 +127,7 @@ private:
     MODULE*      pickModule();
 
     void         placeModule( MODULE* aModule, bool aDoNotRecreateRatsnest, const wxPoint& aPos );
-    const D_PAD* nearestPad( MODULE* aRefModule, D_PAD* aRefPad, const wxPoint& aOffset );
+    const D_PAD* nearestPad( MODULE* aRefModule, D_PAD* aRefPad, const wxPoint& aOffset ) const;
 
     // Add a polygonal shape (rectangle) to m_fpAreaFront and/or m_fpAreaBack
     void         addFpBody( wxPoint aStart, wxPoint aEnd, LSET aLayerMask );
@@ -40,8 +40,9 @@ AR_MATRIX::AR_MATRIX()
 {
     m_BoardSide[0] = m_BoardSide[1] = nullptr;
     m_DistSide[0] = m_DistSide[1] = nullptr;
-    m_DirSide[0] = m_DirSide[1] = nullptr;
     m_opWriteCell = nullptr;
+    m_placementWords = 0;
+    m_placementMapsValid = false;
     m_InitMatrixDone = false;
     m_Nrows = 0;
     m_Ncols = 0;
@@ -104,7 +105,6 @@ int AR_MATRIX::InitRoutingMatrix()
     {
         m_BoardSide[side] = nullptr;
         m_DistSide[side] = nullptr;
-        m_DirSide[side] = nullptr;
 
         // allocate matrix & initialize everything to empty
         m_BoardSide[side] = (MATRIX_CELL*) operator new( ii * sizeof( MATRIX_CELL ) );
@@ -120,18 +120,12 @@ int AR_MATRIX::InitRoutingMatrix()
         if( m_DistSide[side] == nullptr )
             return -1;
 
-        // allocate Dir (chars)
-        m_DirSide[side] = (char*) operator new( ii );
-        memset( m_DirSide[side], 0, ii );
-
-        if( m_DirSide[side] == nullptr )
-            return -1;
-
         side = AR_SIDE_TOP;
     }
 
-    m_MemSize =
-            m_RouteCount * ii * ( sizeof( MATRIX_CELL ) + sizeof( DIST_CELL ) + sizeof( char ) );
+    m_placementMapsValid = false;
+
+    m_MemSize = m_RouteCount * ii * ( sizeof( MATRIX_CELL ) + sizeof( DIST_CELL ) );
 
     return m_MemSize;
 }
@@ -145,12 +139,9 @@ void AR_MATRIX::UnInitRoutingMatrix()
 
     for( ii = 0; ii < AR_MAX_ROUTING_LAYERS_COUNT; ii++ )
     {
-        // de-allocate Dir matrix
-        if( m_DirSide[ii] )
-        {
-            delete m_DirSide[ii];
-            m_DirSide[ii] = nullptr;
-        }
+        m_outOfBoardBits[ii].clear();
+        m_moduleBits[ii].clear();
+        m_distSums[ii].clear();
 
         // de-allocate Distances matrix
         if( m_DistSide[ii] )
@@ -168,6 +159,8 @@ void AR_MATRIX::UnInitRoutingMatrix()
     }
 
     m_Nrows = m_Ncols = 0;
+    m_placementWords = 0;
+    m_placementMapsValid = false;
 }
 
 // Initialize m_opWriteCell member to make the aLogicOp
@@ -191,7 +184,7 @@ void AR_MATRIX::SetCellOperation( AR_MATRIX::CELL_OP aLogicOp )
 
 /* return the value stored in a cell
  */
-AR_MATRIX::MATRIX_CELL AR_MATRIX::GetCell( int aRow, int aCol, int aSide )
+AR_MATRIX::MATRIX_CELL AR_MATRIX::GetCell( int aRow, int aCol, int aSide ) const
 {
     MATRIX_CELL* p;
 
@@ -208,6 +201,7 @@ void AR_MATRIX::SetCell( int aRow, int aCol, int aSide, MATRIX_CELL x )
 
     p = m_BoardSide[aSide];
     p[aRow * m_Ncols + aCol] = x;
+    m_placementMapsValid = false;
 }
 
 
@@ -219,6 +213,7 @@ void AR_MATRIX::OrCell( int aRow, int aCol, int aSide, MATRIX_CELL x )
 
     p = m_BoardSide[aSide];
     p[aRow * m_Ncols + aCol] |= x;
+    m_placementMapsValid = false;
 }
 
 
@@ -230,6 +225,7 @@ void AR_MATRIX::XorCell( int aRow, int aCol, int aSide, MATRIX_CELL x )
 
     p = m_BoardSide[aSide];
     p[aRow * m_Ncols + aCol] ^= x;
+    m_placementMapsValid = false;
 }
 
 
@@ -241,6 +237,7 @@ void AR_MATRIX::AndCell( int aRow, int aCol, int aSide, MATRIX_CELL x )
 
     p = m_BoardSide[aSide];
     p[aRow * m_Ncols + aCol] &= x;
+    m_placementMapsValid = false;
 }
 
 
@@ -252,11 +249,12 @@ void AR_MATRIX::AddCell( int aRow, int aCol, int aSide, MATRIX_CELL x )
 
     p = m_BoardSide[aSide];
     p[aRow * m_Ncols + aCol] += x;
+    m_placementMapsValid = false;
 }
 
 
 // fetch distance cell
-AR_MATRIX::DIST_CELL AR_MATRIX::GetDist( int aRow, int aCol, int aSide ) // fetch distance cell
+AR_MATRIX::DIST_CELL AR_MATRIX::GetDist( int aRow, int aCol, int aSide ) const // fetch distance cell
 {
     DIST_CELL* p;
 
@@ -272,28 +270,121 @@ void AR_MATRIX::SetDist( int aRow, int aCol, int aSide, DIST_CELL x )
 
     p = m_DistSide[aSide];
     p[aRow * m_Ncols + aCol] = x;
+    m_placementMapsValid = false;
 }
 
 
-// fetch direction cell
-int AR_MATRIX::GetDir( int aRow, int aCol, int aSide )
+void AR_MATRIX::UpdatePlacementMaps()
 {
-    DIR_CELL* p;
+    if( m_placementMapsValid )
+        return;
+
+    m_placementWords = ( m_Ncols + 63 ) / 64;
+
+    for( int side = 0; side < AR_MAX_ROUTING_LAYERS_COUNT; side++ )
+    {
+        if( !m_BoardSide[side] || !m_DistSide[side] )
+            continue;
+
+        std::vector<uint64_t>& outOfBoard = m_outOfBoardBits[side];
+        std::vector<uint64_t>& modules = m_moduleBits[side];
+        std::vector<uint32_t>& sums = m_distSums[side];
+
+        outOfBoard.assign( (size_t) m_Nrows * m_placementWords, 0 );
+        modules.assign( (size_t) m_Nrows * m_placementWords, 0 );
+        sums.assign( (size_t) ( m_Nrows + 1 ) * ( m_Ncols + 1 ), 0 );
 
-    p = m_DirSide[aSide];
-    return (int) ( p[aRow * m_Ncols + aCol] );
+        for( int row = 0; row < m_Nrows; row++ )
+        {
+            const MATRIX_CELL* cells = m_BoardSide[side] + row * m_Ncols;
+            const DIST_CELL*   dists = m_DistSide[side] + row * m_Ncols;
+            uint64_t*          outOfBoardRow = &outOfBoard[(size_t) row * m_placementWords];
+            uint64_t*          modulesRow = &modules[(size_t) row * m_placementWords];
+            uint32_t*          sumsAbove = &sums[(size_t) row * ( m_Ncols + 1 )];
+            uint32_t*          sumsRow = sumsAbove + m_Ncols + 1;
+            uint32_t           rowSum = 0;
+
+            for( int col = 0; col < m_Ncols; col++ )
+            {
+                uint64_t bit = uint64_t( 1 ) << ( col % 64 );
+
+                if( ( cells[col] & CELL_IS_ZONE ) == 0 )
+                    outOfBoardRow[col / 64] |= bit;
+
+                if( cells[col] & CELL_IS_MODULE )
+                    modulesRow[col / 64] |= bit;
+
+                // Unsigned sums wrap around as the sums of the cells did
+                rowSum += (uint32_t) dists[col];
+                sumsRow[col + 1] = sumsAbove[col + 1] + rowSum;
+            }
+        }
+    }
+
+    m_placementMapsValid = true;
 }
 
 
-// store direction cell
-void AR_MATRIX::SetDir( int aRow, int aCol, int aSide, int x )
+AR_MATRIX::PLACEMENT_TEST AR_MATRIX::TestPlacementArea( int aRowMin, int aRowMax, int aColMin,
+                                                        int aColMax, int aSide ) const
 {
-    DIR_CELL* p;
+    wxASSERT( m_placementMapsValid );
+
+    if( aRowMin > aRowMax || aColMin > aColMax )
+        return PLACEMENT_FREE;
+
+    const uint64_t all = ~uint64_t( 0 );
+    int            firstWord = aColMin / 64;
+    int            lastWord = aColMax / 64;
 
-    p = m_DirSide[aSide];
-    p[aRow * m_Ncols + aCol] = (char) x;
+    for( int row = aRowMin; row <= aRowMax; row++ )
+    {
+        const uint64_t* outOfBoard = &m_outOfBoardBits[aSide][(size_t) row * m_placementWords];
+        const uint64_t* modules = &m_moduleBits[aSide][(size_t) row * m_placementWords];
+
+        for( int word = firstWord; word <= lastWord; word++ )
+        {
+            uint64_t mask = all;
+
+            if( word == firstWord )
+                mask &= all << ( aColMin % 64 );
+
+            if( word == lastWord )
+                mask &= all >> ( 63 - aColMax % 64 );
+
+            uint64_t blocked = ( outOfBoard[word] | modules[word] ) & mask;
+
+            if( blocked )
+            {
+                // The first blocked cell of the row, out of the board before being occupied
+                uint64_t first = blocked & ( ~blocked + 1 );
+
+                return ( outOfBoard[word] & first ) ? PLACEMENT_OUT_OF_BOARD
+                                                    : PLACEMENT_ON_MODULE;
+            }
+        }
+    }
+
+    return PLACEMENT_FREE;
 }
 
+
+unsigned int AR_MATRIX::GetDistSum( int aRowMin, int aRowMax, int aColMin, int aColMax,
+                                    int aSide ) const
+{
+    wxASSERT( m_placementMapsValid );
+
+    if( aRowMin > aRowMax || aColMin > aColMax )
+        return 0;
+
+    const std::vector<uint32_t>& sums = m_distSums[aSide];
+    size_t                       stride = m_Ncols + 1;
+
+    return sums[( aRowMax + 1 ) * stride + aColMax + 1] - sums[aRowMin * stride + aColMax + 1]
+           - sums[( aRowMax + 1 ) * stride + aColMin] + sums[aRowMin * stride + aColMin];
+}
+
+
 /* The tables of distances and keep out areas are established on the basis of a
  * 50 units grid size (the pitch between the cells is 50 units).
  * The actual distance could be computed by a scaling factor, but this is
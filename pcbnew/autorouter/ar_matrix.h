@@ -29,6 +29,9 @@
 #ifndef __AR_MATRIX_H
 #define __AR_MATRIX_H
 
+#include <cstdint>
+#include <vector>
+
 #include <eda_rect.h>
 #include <layers_id_colors_and_visibility.h>
 
@@ -51,13 +54,10 @@ class AR_MATRIX
 public:
     typedef unsigned char MATRIX_CELL;
     typedef int           DIST_CELL;
-    typedef char          DIR_CELL;
 
     MATRIX_CELL* m_BoardSide[AR_MAX_ROUTING_LAYERS_COUNT]; // the image map of 2 board sides
     DIST_CELL*   m_DistSide[AR_MAX_ROUTING_LAYERS_COUNT];  // the image map of 2 board sides:
                                                            // distance to cells
-    DIR_CELL* m_DirSide[AR_MAX_ROUTING_LAYERS_COUNT];      // the image map of 2 board sides:
-                                                           // pointers back to source
     bool     m_InitMatrixDone;
     int      m_RoutingLayersCount; // Number of layers for autorouting (0 or 1)
     int      m_GridRouting;        // Size of grid for autoplace/autoroute
@@ -73,6 +73,16 @@ private:
     // a pointer to the current selected cell operation
     void ( AR_MATRIX::*m_opWriteCell )( int aRow, int aCol, int aSide, MATRIX_CELL aCell );
 
+    // The placement maps of each side, built from the cells by UpdatePlacementMaps():
+    // one bit per cell outside of the board (without CELL_IS_ZONE) and one bit per cell
+    // with CELL_IS_MODULE, packed in rows of m_placementWords words, and the summed-area
+    // table of the distances, of ( m_Nrows + 1 ) rows of ( m_Ncols + 1 ) sums
+    std::vector<uint64_t> m_outOfBoardBits[AR_MAX_ROUTING_LAYERS_COUNT];
+    std::vector<uint64_t> m_moduleBits[AR_MAX_ROUTING_LAYERS_COUNT];
+    std::vector<uint32_t> m_distSums[AR_MAX_ROUTING_LAYERS_COUNT];
+    int                   m_placementWords;
+    bool                  m_placementMapsValid;    // false once a cell or distance is changed
+
 public:
     enum CELL_OP
     {
@@ -125,16 +135,53 @@ public:
     void SetCellOperation( CELL_OP aLogicOp );
 
     // functions to read/write one cell ( point on grid routing matrix:
-    MATRIX_CELL GetCell( int aRow, int aCol, int aSide );
+    MATRIX_CELL GetCell( int aRow, int aCol, int aSide ) const;
     void        SetCell( int aRow, int aCol, int aSide, MATRIX_CELL aCell );
     void        OrCell( int aRow, int aCol, int aSide, MATRIX_CELL aCell );
     void        XorCell( int aRow, int aCol, int aSide, MATRIX_CELL aCell );
     void        AndCell( int aRow, int aCol, int aSide, MATRIX_CELL aCell );
     void        AddCell( int aRow, int aCol, int aSide, MATRIX_CELL aCell );
-    DIST_CELL   GetDist( int aRow, int aCol, int aSide );
+    DIST_CELL   GetDist( int aRow, int aCol, int aSide ) const;
     void        SetDist( int aRow, int aCol, int aSide, DIST_CELL );
-    int         GetDir( int aRow, int aCol, int aSide );
-    void        SetDir( int aRow, int aCol, int aSide, int aDir );
+
+    enum PLACEMENT_TEST
+    {
+        PLACEMENT_FREE = 0,
+        PLACEMENT_OUT_OF_BOARD,
+        PLACEMENT_ON_MODULE
+    };
+
+    /**
+     * Function UpdatePlacementMaps
+     * builds the maps read by TestPlacementArea() and GetDistSum() again if a cell or a
+     * distance was changed since they were built.  Must be called after the matrix is
+     * changed, and before the placement tests, which do not build them.
+     */
+    void        UpdatePlacementMaps();
+
+    /**
+     * Function InvalidatePlacementMaps
+     * is called when m_BoardSide or m_DistSide are written directly
+     */
+    void        InvalidatePlacementMaps() { m_placementMapsValid = false; }
+
+    /**
+     * Function TestPlacementArea
+     * tests the cells of rows aRowMin to aRowMax and columns aColMin to aColMax of aSide,
+     * 64 cells at a time.
+     * @return PLACEMENT_OUT_OF_BOARD or PLACEMENT_ON_MODULE for the first cell (row by row)
+     * outside of the board or occupied by a module, or PLACEMENT_FREE
+     */
+    PLACEMENT_TEST TestPlacementArea( int aRowMin, int aRowMax, int aColMin, int aColMax,
+                                      int aSide ) const;
+
+    /**
+     * Function GetDistSum
+     * @return the sum of the distances of the cells of rows aRowMin to aRowMax and columns
+     * aColMin to aColMax of aSide (modulo 2^32), from the summed-area table
+     */
+    unsigned int GetDistSum( int aRowMin, int aRowMax, int aColMin, int aColMax,
+                             int aSide ) const;
 
     // calculate distance (with penalty) of a trace through a cell
     int CalcDist( int x, int y, int z, int side );
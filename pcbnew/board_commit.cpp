@@ -31,13 +31,87 @@
 #include <board_commit.h>
 #include <tools/pcb_tool_base.h>
 #include <tools/pcb_actions.h>
+#include <tools/drc.h>
+#include <tools/zone_filler_tool.h>
+#include <router/router_tool.h>
+#include <router/length_tuner_tool.h>
 #include <connectivity/connectivity_data.h>
+#include <advanced_config.h>
 
 #include <functional>
 using namespace std::placeholders;
 
 #include "pcb_draw_panel_gal.h"
 
+/// Number of changes from which a commit indexes the changed items in the view all at once
+static const size_t BULK_VIEW_UPDATE_THRESHOLD = 100;
+
+/**
+ * Returns the layers on which an item is shown by the 3D viewer.  The drilled pads are
+ * also in the copper layers, which hold the holes.
+ */
+static LSET layersIn3DView( const BOARD_ITEM* aItem )
+{
+    if( aItem->Type() == PCB_PAD_T )
+    {
+        const D_PAD* pad = static_cast<const D_PAD*>( aItem );
+        LSET layers = pad->GetLayerSet();
+
+        if( pad->GetDrillSize().x > 0 )
+            layers |= LSET::AllCuMask();
+
+        return layers;
+    }
+
+    if( aItem->Type() != PCB_MODULE_T )
+        return aItem->GetLayerSet();
+
+    const MODULE* module = static_cast<const MODULE*>( aItem );
+    LSET layers = module->Reference().GetLayerSet() | module->Value().GetLayerSet();
+
+    for( const D_PAD* pad : module->Pads() )
+        layers |= layersIn3DView( pad );
+
+    for( const BOARD_ITEM* item : module->GraphicalItems() )
+        layers |= item->GetLayerSet();
+
+    return layers;
+}
+
+
+/**
+ * Checks that aItem is aCopy moved by aOffset, and nothing else: a move is enough to undo
+ * the change then.  The nets are compared as the connectivity may have changed them after
+ * the move.
+ */
+static bool isTranslatedCopy( const BOARD_ITEM* aItem, const BOARD_ITEM* aCopy,
+                              const wxPoint& aOffset )
+{
+    if( aItem->Type() != aCopy->Type() || aItem->GetLayerSet() != aCopy->GetLayerSet() )
+        return false;
+
+    if( aItem->GetPosition() != aCopy->GetPosition() + aOffset )
+        return false;
+
+    if( aItem->IsConnected()
+            && static_cast<const BOARD_CONNECTED_ITEM*>( aItem )->GetNetCode()
+                    != static_cast<const BOARD_CONNECTED_ITEM*>( aCopy )->GetNetCode() )
+        return false;
+
+    if( aItem->Type() == PCB_MODULE_T
+            && static_cast<const MODULE*>( aItem )->GetOrientation()
+                    != static_cast<const MODULE*>( aCopy )->GetOrientation() )
+        return false;
+
+    EDA_RECT bbox = aCopy->GetBoundingBox();
+    bbox.Move( aOffset );
+
+    EDA_RECT itemBBox = aItem->GetBoundingBox();
+
+    return bbox.GetOrigin() == itemBBox.GetOrigin() && bbox.GetSize() == itemBBox.GetSize();
+}
+
+
 BOARD_COMMIT::BOARD_COMMIT( PCB_TOOL_BASE* aTool )
 {
     m_toolMgr = aTool->GetManager();
@@ -71,12 +145,87 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
     if( Empty() )
         return;
 
+    // The DRC re-tests the area of the changed items once the commit is done
+    DRC* drc = nullptr;
+
+    if( !m_editModules && ADVANCED_CFG::GetCfg().m_realTimeDrc )
+        drc = m_toolMgr->GetTool<DRC>();
+
+    // The zones depending on the changed items are refilled on request, or after the commit
+    ZONE_FILLER_TOOL* zoneFiller = nullptr;
+
+    if( !m_editModules )
+        zoneFiller = m_toolMgr->GetTool<ZONE_FILLER_TOOL>();
+
+    // The router worlds kept between the routing sessions follow the changed items
+    std::vector<PNS::TOOL_BASE*> routerTools;
+
+    if( !m_editModules && ADVANCED_CFG::GetCfg().m_incrementalRouterSync )
+    {
+        routerTools.push_back( m_toolMgr->GetTool<ROUTER_TOOL>() );
+        routerTools.push_back( m_toolMgr->GetTool<LENGTH_TUNER_TOOL>() );
+    }
+
+    // The 3D viewer rebuilds only the layers of the changed items
+    OPT<LSET> changed3DLayers;
+
+    if( !m_editModules && ADVANCED_CFG::GetCfg().m_incremental3DViewUpdate )
+        changed3DLayers = LSET();
+
+    // The items of large commits (global edits, deletion of a layer...) are indexed again by
+    // the view all at once.  The connectivity is recomputed once by RecalculateRatsnest().
+    bool bulkViewUpdate = m_changes.size() >= BULK_VIEW_UPDATE_THRESHOLD;
+
+    if( bulkViewUpdate )
+        view->BeginBulkUpdate();
+
     for( COMMIT_LINE& ent : m_changes )
     {
         int changeType = ent.m_type & CHT_TYPE;
         int changeFlags = ent.m_type & CHT_FLAGS;
         BOARD_ITEM* boardItem = static_cast<BOARD_ITEM*>( ent.m_item );
 
+        // The tools change the items before they are committed, the footprints often through
+        // their pads and texts
+        boardItem->InvalidateHashes();
+
+        // The footprints keep their area, which is outdated if their items were changed directly
+        if( boardItem->Type() == PCB_MODULE_T )
+            static_cast<MODULE*>( boardItem )->CalculateBoundingBox();
+        else if( boardItem->GetParent() && boardItem->GetParent()->Type() == PCB_MODULE_T )
+            static_cast<MODULE*>( boardItem->GetParent() )->CalculateBoundingBox();
+
+        if( drc && boardItem->Type() != PCB_MARKER_T )
+        {
+            drc->MarkAreaDirty( boardItem->GetBoundingBox() );
+
+            // The item may have been moved away from its old position
+            if( ent.m_copy )
+                drc->MarkAreaDirty( static_cast<BOARD_ITEM*>( ent.m_copy )->GetBoundingBox() );
+        }
+
+        if( zoneFiller && boardItem->Type() != PCB_MARKER_T )
+        {
+            zoneFiller->MarkItemDirty( boardItem );
+
+            if( ent.m_copy )
+                zoneFiller->MarkItemDirty( static_cast<BOARD_ITEM*>( ent.m_copy ) );
+        }
+
+        for( PNS::TOOL_BASE* routerTool : routerTools )
+        {
+            if( routerTool && boardItem->Type() != PCB_MARKER_T )
+                routerTool->MarkItemDirty( boardItem );
+        }
+
+        if( changed3DLayers && boardItem->Type() != PCB_MARKER_T )
+        {
+            *changed3DLayers |= layersIn3DView( boardItem );
+
+            if( ent.m_copy )
+                *changed3DLayers |= layersIn3DView( static_cast<BOARD_ITEM*>( ent.m_copy ) );
+        }
+
         // Module items need to be saved in the undo buffer before modification
         if( m_editModules )
         {
@@ -267,6 +416,12 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
 
                 auto boardItem = static_cast<BOARD_ITEM*>( ent.m_item );
 
+                for( PNS::TOOL_BASE* routerTool : routerTools )
+                {
+                    if( routerTool )
+                        routerTool->MarkItemDirty( boardItem );
+                }
+
                 if( aCreateUndoEntry )
                 {
                     ITEM_PICKER itemWrapper( boardItem, UR_CHANGED );
@@ -284,18 +439,60 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
         }
     }
 
+    if( bulkViewUpdate )
+        view->EndBulkUpdate();
+
+    wxPoint transformPoint;
+
+    if( !m_editModules && aCreateUndoEntry && m_translation )
+    {
+        // The items only moved keep their move in the undo list, not a copy of them
+        for( unsigned ii = 0; ii < undoList.GetCount(); ++ii )
+        {
+            BOARD_ITEM* item = static_cast<BOARD_ITEM*>( undoList.GetPickedItem( ii ) );
+            BOARD_ITEM* copy = static_cast<BOARD_ITEM*>( undoList.GetPickedItemLink( ii ) );
+
+            if( undoList.GetPickedItemStatus( ii ) != UR_CHANGED || !copy
+                    || !isTranslatedCopy( item, copy, *m_translation ) )
+                continue;
+
+            undoList.SetPickedItemStatus( UR_MOVED, ii );
+            undoList.SetPickedItemLink( nullptr, ii );
+            delete copy;
+        }
+
+        transformPoint = *m_translation;
+    }
+
     if( !m_editModules && aCreateUndoEntry )
-        frame->SaveCopyInUndoList( undoList, UR_UNSPECIFIED );
+        frame->SaveCopyInUndoList( undoList, UR_UNSPECIFIED, transformPoint );
 
     if( TOOL_MANAGER* toolMgr = frame->GetToolManager() )
         toolMgr->PostEvent( { TC_MESSAGE, TA_MODEL_CHANGE, AS_GLOBAL } );
 
     if( aSetDirtyBit )
+    {
+        if( changed3DLayers )
+            frame->SetChanged3DLayers( *changed3DLayers );
+
         frame->OnModify();
+    }
 
     frame->UpdateMsgPanel();
 
     clear();
+    m_translation = NULLOPT;
+
+    if( zoneFiller && ADVANCED_CFG::GetCfg().m_autoRefillZones && zoneFiller->HasDirtyZones() )
+    {
+        if( ADVANCED_CFG::GetCfg().m_backgroundZoneFill )
+            zoneFiller->RefillDirtyZonesInBackground();
+        else
+            zoneFiller->RefillDirtyZones( frame );
+    }
+
+    if( drc && drc->HasDirtyAreas() )
+        drc->RunIncrementalTests();
 }
 
 
@@ -356,6 +553,7 @@ void BOARD_COMMIT::Revert()
             connectivity->Remove( item );
 
             item->SwapData( copy );
+            item->InvalidateHashes();
 
             view->Add( item );
             connectivity->Add( item );
@@ -376,4 +574,5 @@ void BOARD_COMMIT::Revert()
     selTool->RebuildSelection();
 
     clear();
+    m_translation = NULLOPT;
 }
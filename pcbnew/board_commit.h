@@ -26,6 +26,7 @@
 #define __BOARD_COMMIT_H
 
 #include <commit.h>
+#include <core/optional.h>
 
 class BOARD_ITEM;
 class PICKED_ITEMS_LIST;
@@ -47,9 +48,20 @@ public:
 
     virtual void Revert() override;
 
+    /**
+     * Declare that the modified items of the commit were only moved by aOffset since they
+     * were staged.  Push() then saves their move in the undo list instead of their copies.
+     * The translation is forgotten by Push() and Revert().
+     */
+    void SetTranslation( const wxPoint& aOffset )
+    {
+        m_translation = aOffset;
+    }
+
 private:
     TOOL_MANAGER* m_toolMgr;
     bool m_editModules;
+    OPT<wxPoint> m_translation;
     virtual EDA_ITEM* parentObject( EDA_ITEM* aItem ) const override;
 };
 
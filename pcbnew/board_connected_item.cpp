@@ -71,6 +71,8 @@ bool BOARD_CONNECTED_ITEM::SetNetCode( int aNetCode, bool aNoAssert )
     if( !aNoAssert )
         assert( m_netinfo );
 
+    InvalidateHash();
+
     // Add only if it was previously added to the ratsnest
     //if( addRatsnest )
     //    connectivity->Add( this );
@@ -90,6 +90,7 @@ public:
     {
         assert( aNetInfo->GetBoard() == GetBoard() );
         m_netinfo = aNetInfo;
+        InvalidateHash();
     }
 
     /**
@@ -0,0 +1,128 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <new>
+
+#include <board_item_arena.h>
+
+
+thread_local BOARD_ITEM_ARENA::SCOPE* BOARD_ITEM_ARENA::m_scope = nullptr;
+
+
+BOARD_ITEM_ARENA::BOARD_ITEM_ARENA() :
+    m_refCount( 1 )
+{
+}
+
+
+void BOARD_ITEM_ARENA::Release()
+{
+    unref();
+}
+
+
+void BOARD_ITEM_ARENA::unref()
+{
+    if( --m_refCount == 0 )
+        delete this;
+}
+
+
+char* BOARD_ITEM_ARENA::newChunk()
+{
+    std::lock_guard<std::mutex> lock( m_chunksLock );
+
+    m_chunks.emplace_back( new char[CHUNK_SIZE] );
+    return m_chunks.back().get();
+}
+
+
+void* BOARD_ITEM_ARENA::Allocate( size_t aSize )
+{
+    SCOPE* scope = m_scope;
+    char*  block;
+
+    // Keep the next block aligned as the header
+    size_t size = HEADER_SIZE + ( ( aSize + HEADER_SIZE - 1 ) & ~( HEADER_SIZE - 1 ) );
+
+    if( scope && scope->m_arena && size <= MAX_BLOCK_SIZE )
+    {
+        if( (size_t) ( scope->m_end - scope->m_cursor ) < size )
+        {
+            scope->m_cursor = scope->m_arena->newChunk();
+            scope->m_end = scope->m_cursor + CHUNK_SIZE;
+        }
+
+        block = scope->m_cursor;
+        scope->m_cursor += size;
+        scope->m_arena->m_refCount++;
+
+        *reinterpret_cast<BOARD_ITEM_ARENA**>( block ) = scope->m_arena;
+    }
+    else
+    {
+        block = static_cast<char*>( ::operator new( HEADER_SIZE + aSize ) );
+
+        *reinterpret_cast<BOARD_ITEM_ARENA**>( block ) = nullptr;
+    }
+
+    return block + HEADER_SIZE;
+}
+
+
+void BOARD_ITEM_ARENA::Deallocate( void* aBlock )
+{
+    if( !aBlock )
+        return;
+
+    char*             block = static_cast<char*>( aBlock ) - HEADER_SIZE;
+    BOARD_ITEM_ARENA* arena = *reinterpret_cast<BOARD_ITEM_ARENA**>( block );
+
+    if( arena )
+        arena->unref();
+    else
+        ::operator delete( block );
+}
+
+
+BOARD_ITEM_ARENA::SCOPE::SCOPE( BOARD_ITEM_ARENA* aArena ) :
+    m_arena( aArena ),
+    m_previous( BOARD_ITEM_ARENA::m_scope ),
+    m_cursor( nullptr ),
+    m_end( nullptr )
+{
+    // The arena cannot go away while its chunk is in use
+    if( m_arena )
+        m_arena->m_refCount++;
+
+    BOARD_ITEM_ARENA::m_scope = this;
+}
+
+
+BOARD_ITEM_ARENA::SCOPE::~SCOPE()
+{
+    BOARD_ITEM_ARENA::m_scope = m_previous;
+
+    if( m_arena )
+        m_arena->unref();
+}
@@ -322,7 +322,7 @@ void ZONE_CONTAINER::TransformSolidAreasShapesToPolygonSet(
         return;
 
     // add filled areas polygons
-    aCornerBuffer.Append( m_FilledPolysList );
+    aCornerBuffer.Append( *m_FilledPolysList );
     auto board = GetBoard();
     int maxError = ARC_HIGH_DEF;
 
@@ -330,9 +330,9 @@ void ZONE_CONTAINER::TransformSolidAreasShapesToPolygonSet(
         maxError = board->GetDesignSettings().m_MaxError;
 
     // add filled areas outlines, which are drawn with thick lines
-    for( int i = 0; i < m_FilledPolysList.OutlineCount(); i++ )
+    for( int i = 0; i < m_FilledPolysList->OutlineCount(); i++ )
     {
-        const SHAPE_LINE_CHAIN& path = m_FilledPolysList.COutline( i );
+        const SHAPE_LINE_CHAIN& path = m_FilledPolysList->COutline( i );
 
         for( int j = 0; j < path.PointCount(); j++ )
         {
@@ -619,23 +619,34 @@ void D_PAD::TransformShapeWithClearanceToPolygon(
         wxPoint corners[4];
         BuildPadPolygon( corners, wxSize( 0, 0 ), angle );
 
-        SHAPE_POLY_SET outline;
-        outline.NewOutline();
-
         for( int ii = 0; ii < 4; ii++ )
-        {
             corners[ii] += padShapePos;
-            outline.Append( corners[ii].x, corners[ii].y );
-        }
 
         int    numSegs = std::max( GetArcToSegmentCount( aClearanceValue, aError, 360.0 ),
                                    pad_min_seg_per_circle_count );
         double correction = GetCircletoPolyCorrectionFactor( numSegs );
 
         int rounding_radius = KiROUND( aClearanceValue * correction );
-        outline.Inflate( rounding_radius, numSegs );
 
-        aCornerBuffer.Append( outline );
+        // The pad shape is convex: the clearance outline is built directly, without
+        // Clipper, unless the clearance is negative
+        if( rounding_radius >= 0 )
+        {
+            TransformConvexPolygonToRoundedPolygon( aCornerBuffer, corners, 4, rounding_radius,
+                                                    numSegs );
+        }
+        else
+        {
+            SHAPE_POLY_SET outline;
+            outline.NewOutline();
+
+            for( int ii = 0; ii < 4; ii++ )
+                outline.Append( corners[ii].x, corners[ii].y );
+
+            outline.Inflate( rounding_radius, numSegs );
+
+            aCornerBuffer.Append( outline );
+        }
     }
         break;
 
@@ -774,6 +785,6 @@ void ZONE_CONTAINER::TransformShapeWithClearanceToPolygon(
 {
     wxASSERT_MSG( !ignoreLineWidth, "IgnoreLineWidth has no meaning for zones." );
 
-    aCornerBuffer = m_FilledPolysList;
+    aCornerBuffer = *m_FilledPolysList;
     aCornerBuffer.Simplify( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
 }
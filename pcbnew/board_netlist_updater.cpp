@@ -216,14 +216,23 @@ MODULE* BOARD_NETLIST_UPDATER::replaceComponent( NETLIST& aNetlist, MODULE* aPcb
 }
 
 
+MODULE* BOARD_NETLIST_UPDATER::copyBeforeChange( MODULE* aPcbComponent, MODULE* aCopy )
+{
+    // Create a copy only if the module has not been added during this update, and only once
+    // it is known to change: most of the footprints are left as they are.
+    if( aCopy || m_commit.GetStatus( aPcbComponent ) )
+        return aCopy;
+
+    return (MODULE*) aPcbComponent->Clone();
+}
+
+
 bool BOARD_NETLIST_UPDATER::updateComponentParameters( MODULE* aPcbComponent,
                                                        COMPONENT* aNewComponent )
 {
     wxString msg;
-
-    // Create a copy only if the module has not been added during this update
-    MODULE* copy = m_commit.GetStatus( aPcbComponent ) ? nullptr : (MODULE*) aPcbComponent->Clone();
-    bool changed = false;
+    MODULE*  copy = nullptr;
+    bool     changed = false;
 
     // Test for reference designator field change.
     if( aPcbComponent->GetReference() != aNewComponent->GetReference() )
@@ -236,6 +245,7 @@ bool BOARD_NETLIST_UPDATER::updateComponentParameters( MODULE* aPcbComponent,
         if ( !m_isDryRun )
         {
             changed = true;
+            copy = copyBeforeChange( aPcbComponent, copy );
             aPcbComponent->SetReference( aNewComponent->GetReference() );
         }
     }
@@ -252,6 +262,7 @@ bool BOARD_NETLIST_UPDATER::updateComponentParameters( MODULE* aPcbComponent,
         if( !m_isDryRun )
         {
             changed = true;
+            copy = copyBeforeChange( aPcbComponent, copy );
             aPcbComponent->SetValue( aNewComponent->GetValue() );
         }
     }
@@ -268,6 +279,7 @@ bool BOARD_NETLIST_UPDATER::updateComponentParameters( MODULE* aPcbComponent,
         if( !m_isDryRun )
         {
             changed = true;
+            copy = copyBeforeChange( aPcbComponent, copy );
             aPcbComponent->SetPath( aNewComponent->GetTimeStamp() );
         }
     }
@@ -285,15 +297,23 @@ bool BOARD_NETLIST_UPDATER::updateComponentPadConnections( MODULE* aPcbComponent
                                                            COMPONENT* aNewComponent )
 {
     wxString msg;
+    MODULE*  copy = nullptr;
+    bool     changed = false;
+
+    // The nets of the component by pin name, not to search them for each pad
+    std::map<wxString, const COMPONENT_NET*> componentNets;
 
-    // Create a copy only if the module has not been added during this update
-    MODULE* copy = m_commit.GetStatus( aPcbComponent ) ? nullptr : (MODULE*) aPcbComponent->Clone();
-    bool changed = false;
+    for( unsigned ii = 0; ii < aNewComponent->GetNetCount(); ii++ )
+    {
+        const COMPONENT_NET& componentNet = aNewComponent->GetNet( ii );
+        componentNets.emplace( componentNet.GetPinName(), &componentNet );
+    }
 
     // At this point, the component footprint is updated.  Now update the nets.
     for( auto pad : aPcbComponent->Pads() )
     {
-        COMPONENT_NET net = aNewComponent->GetNet( pad->GetName() );
+        auto          it = componentNets.find( pad->GetName() );
+        COMPONENT_NET net = it != componentNets.end() ? *it->second : COMPONENT_NET();
 
         // Test if new footprint pad has no net (pads not on copper layers have no net).
         if( !net.IsValid() || !pad->IsOnCopperLayer() )
@@ -308,8 +328,12 @@ bool BOARD_NETLIST_UPDATER::updateComponentPadConnections( MODULE* aPcbComponent
 
             if( !m_isDryRun )
             {
-                changed = true;
-                pad->SetNetCode( NETINFO_LIST::UNCONNECTED );
+                if( pad->GetNetCode() != NETINFO_LIST::UNCONNECTED )
+                {
+                    changed = true;
+                    copy = copyBeforeChange( aPcbComponent, copy );
+                    pad->SetNetCode( NETINFO_LIST::UNCONNECTED );
+                }
             }
             else
                 cacheNetname( pad, wxEmptyString );
@@ -370,6 +394,7 @@ bool BOARD_NETLIST_UPDATER::updateComponentPadConnections( MODULE* aPcbComponent
                 if( !m_isDryRun )
                 {
                     changed = true;
+                    copy = copyBeforeChange( aPcbComponent, copy );
                     pad->SetNet( netinfo );
                 }
                 else
@@ -530,18 +555,25 @@ bool BOARD_NETLIST_UPDATER::updateCopperZoneNets( NETLIST& aNetlist )
 
 bool BOARD_NETLIST_UPDATER::deleteUnusedComponents( NETLIST& aNetlist )
 {
-    wxString msg;
-    const COMPONENT* component;
+    wxString           msg;
+    std::set<wxString> componentKeys;
 
-    for( auto module : m_board->Modules() )
+    // Look the footprints up in the keys of the components, not in the whole netlist
+    for( unsigned ii = 0; ii < aNetlist.GetCount(); ii++ )
     {
+        const COMPONENT* component = aNetlist.GetComponent( ii );
 
         if( m_lookupByTimestamp )
-            component = aNetlist.GetComponentByTimeStamp( module->GetPath() );
+            componentKeys.insert( component->GetTimeStamp() );
         else
-            component = aNetlist.GetComponentByReference( module->GetReference() );
+            componentKeys.insert( component->GetReference() );
+    }
+
+    for( auto module : m_board->Modules() )
+    {
+        const wxString& key = m_lookupByTimestamp ? module->GetPath() : module->GetReference();
 
-        if( component == NULL )
+        if( componentKeys.count( key ) == 0 )
         {
             if( module->IsLocked() )
             {
@@ -690,7 +722,19 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
     m_errorCount = 0;
     m_warningCount = 0;
     m_newFootprintsCount = 0;
-    MODULE* lastPreexistingFootprint = m_board->Modules().empty() ? NULL : m_board->Modules().back();
+
+    // The footprints already on the board, by path or by reference (without case), so the
+    // components are not compared with each footprint.  The footprints added for the
+    // components are not looked up.
+    std::map<wxString, std::vector<MODULE*>> footprintsByKey;
+
+    for( auto footprint : m_board->Modules() )
+    {
+        if( m_lookupByTimestamp )
+            footprintsByKey[ footprint->GetPath() ].push_back( footprint );
+        else
+            footprintsByKey[ footprint->GetReference().Lower() ].push_back( footprint );
+    }
 
     cacheCopperZoneConnections();
 
@@ -716,19 +760,13 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
                     component->GetFPID().Format().wx_str() );
         m_reporter->Report( msg, REPORTER::RPT_INFO );
 
-        for( auto footprint : m_board->Modules() )
-        {
-            bool     match = false;
+        auto matches = footprintsByKey.find( m_lookupByTimestamp
+                                                     ? component->GetTimeStamp()
+                                                     : component->GetReference().Lower() );
 
-            if( footprint )
-            {
-                if( m_lookupByTimestamp )
-                    match = footprint->GetPath() == component->GetTimeStamp();
-                else
-                    match = footprint->GetReference().CmpNoCase( component->GetReference() ) == 0;
-            }
-
-            if( match )
+        if( matches != footprintsByKey.end() )
+        {
+            for( MODULE* footprint : matches->second )
             {
                 tmp = footprint;
 
@@ -743,12 +781,6 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 
                 matchCount++;
             }
-
-            if( footprint == lastPreexistingFootprint )
-            {
-                // No sense going through the newly-created footprints: end of loop
-                break;
-            }
         }
 
         if( matchCount == 0 )
@@ -776,8 +808,9 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 
     if( !m_isDryRun )
     {
+        // The commit updates the connectivity of the changed items only, and recomputes the
+        // ratsnest once for all of them.
         m_commit.Push( _( "Update netlist" ) );
-        m_board->GetConnectivity()->Build( m_board );
         testConnectivity( aNetlist );
 
         // Now the connectivity data is rebuilt, we can delete single pads nets
@@ -135,6 +135,12 @@ private:
     wxPoint estimateComponentInsertionPosition();
     MODULE* addNewComponent( COMPONENT* aComponent );
     MODULE* replaceComponent( NETLIST& aNetlist, MODULE* aPcbComponent, COMPONENT* aNewComponent );
+
+    /**
+     * Returns the copy of aPcbComponent to stage in the commit before changing it: aCopy if
+     * it is already made, or nullptr if the footprint was added or replaced by this update.
+     */
+    MODULE* copyBeforeChange( MODULE* aPcbComponent, MODULE* aCopy );
     bool updateComponentParameters( MODULE* aPcbComponent, COMPONENT* aNewComponent );
     bool updateComponentPadConnections( MODULE* aPcbComponent, COMPONENT* aNewComponent );
     void cacheCopperZoneConnections();
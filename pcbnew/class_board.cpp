@@ -32,6 +32,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <unordered_map>
 #include <fctsys.h>
 #include <common.h>
 #include <kicad_string.h>
@@ -51,6 +52,7 @@
 #include <class_drawsegment.h>
 #include <class_pcb_target.h>
 #include <connectivity/connectivity_data.h>
+#include <advanced_config.h>
 
 
 /**
@@ -107,10 +109,15 @@ BOARD::BOARD() :
 
     m_generalSettings = &dummyGeneralSettings;
 
+    m_modulesByRefValid = false;
+
+    m_itemArena = NULL;
+
     m_CurrentZoneContour = NULL;            // This ZONE_CONTAINER handle the
                                             // zone contour currently in progress
 
     BuildListOfNets();                      // prepare pad and netlist containers.
+    BuildNetClearances();
 
     for( LAYER_NUM layer = 0; layer < PCB_LAYER_ID_COUNT; ++layer )
     {
@@ -151,6 +158,19 @@ BOARD::~BOARD()
 
     delete m_CurrentZoneContour;
     m_CurrentZoneContour = NULL;
+
+    // The chunks are freed with the last item, once the containers are destroyed
+    if( m_itemArena )
+        m_itemArena->Release();
+}
+
+
+BOARD_ITEM_ARENA* BOARD::UseItemArena()
+{
+    if( !m_itemArena )
+        m_itemArena = new BOARD_ITEM_ARENA;
+
+    return m_itemArena;
 }
 
 
@@ -569,6 +589,15 @@ void BOARD::Add( BOARD_ITEM* aBoardItem, ADD_MODE aMode )
         else
             m_modules.push_front( (MODULE*) aBoardItem );
 
+        if( m_modulesByRefValid )
+        {
+            MODULE* module = (MODULE*) aBoardItem;
+
+            // A module sharing the reference of another one keeps it
+            if( m_modulesByRef.emplace( module->GetReference(), module ).second )
+                m_moduleRefs[ module ] = module->GetReference();
+        }
+
         break;
 
     case PCB_DIMENSION_T:
@@ -641,9 +670,24 @@ void BOARD::Remove( BOARD_ITEM* aBoardItem )
         break;
 
     case PCB_MODULE_T:
+    {
         m_modules.erase( std::remove_if( m_modules.begin(), m_modules.end(),
                 [aBoardItem]( BOARD_ITEM* aItem ) { return aItem == aBoardItem; } ) );
+
+        auto it = m_moduleRefs.find( (MODULE*) aBoardItem );
+
+        if( it != m_moduleRefs.end() )
+        {
+            auto entry = m_modulesByRef.find( it->second );
+
+            if( entry != m_modulesByRef.end() && entry->second == aBoardItem )
+                m_modulesByRef.erase( entry );
+
+            m_moduleRefs.erase( it );
+        }
+
         break;
+    }
 
     case PCB_TRACE_T:
     case PCB_VIA_T:
@@ -861,6 +905,40 @@ void BOARD::GetMsgPanelInfo( EDA_UNITS_T aUnits, std::vector< MSG_PANEL_ITEM >&
 
     txt.Printf( wxT( "%d" ), GetConnectivity()->GetUnconnectedCount() );
     aList.push_back( MSG_PANEL_ITEM( _( "Unrouted" ), txt, BLUE ) );
+
+    if( ADVANCED_CFG::GetCfg().m_showConnectivityStats )
+    {
+        const CONNECTIVITY_STATS& stats = GetConnectivity()->GetStats();
+
+        auto addTime = [&]( const wxString& aLabel, CONNECTIVITY_STATS::DURATION aTime )
+        {
+            txt.Printf( wxT( "%.2f ms" ), aTime.count() / 1000.0 );
+            aList.push_back( MSG_PANEL_ITEM( aLabel, txt, BROWN ) );
+        };
+
+        addTime( _( "Build" ), stats.m_build );
+
+        txt.Printf( wxT( "%d / %d" ), stats.m_dirtyItems, stats.m_items );
+        aList.push_back( MSG_PANEL_ITEM( _( "Searched Items" ), txt, DARKGREEN ) );
+
+        addTime( _( "Search" ), stats.m_searchConnections );
+
+        txt.Printf( wxT( "%d" ), stats.m_clusters );
+        aList.push_back( MSG_PANEL_ITEM( _( "Clusters" ), txt, DARKGREEN ) );
+
+        addTime( _( "Cluster Search" ), stats.m_searchClusters );
+        addTime( _( "Propagation" ), stats.m_propagateNets );
+
+        txt.Printf( wxT( "%d" ), stats.m_ratsnestNets );
+        aList.push_back( MSG_PANEL_ITEM( _( "Ratsnest Nets" ), txt, DARKGREEN ) );
+
+        addTime( _( "Ratsnest" ), stats.m_updateRatsnest );
+        addTime( _( "Update" ), stats.m_recalculateRatsnest );
+
+        txt.Printf( wxT( "%d / %d (%.1f kB)" ), stats.m_zonePartitions, stats.m_zoneItems,
+                    stats.m_zonePartitionBytes / 1024.0 );
+        aList.push_back( MSG_PANEL_ITEM( _( "Zone Partitions" ), txt, DARKGREEN ) );
+    }
 }
 
 
@@ -1064,29 +1142,48 @@ NETINFO_ITEM* BOARD::FindNet( const wxString& aNetname ) const
 
 MODULE* BOARD::FindModuleByReference( const wxString& aReference ) const
 {
-    MODULE* found = nullptr;
+    if( !m_modulesByRefValid )
+    {
+        m_modulesByRef.clear();
+        m_moduleRefs.clear();
 
-    // search only for MODULES
-    static const KICAD_T scanTypes[] = { PCB_MODULE_T, EOT };
+        for( MODULE* module : m_modules )
+        {
+            if( m_modulesByRef.emplace( module->GetReference(), module ).second )
+                m_moduleRefs[ module ] = module->GetReference();
+        }
 
-    INSPECTOR_FUNC inspector = [&] ( EDA_ITEM* item, void* testData )
+        m_modulesByRefValid = true;
+    }
+
+    auto it = m_modulesByRef.find( aReference );
+
+    if( it != m_modulesByRef.end() && it->second->GetReference() == aReference )
+        return it->second;
+
+    // The module may have been renamed since it was indexed: look for it, and index it
+    // under its new reference
+    for( MODULE* module : m_modules )
     {
-        MODULE* module = (MODULE*) item;
+        if( module->GetReference() != aReference )
+            continue;
+
+        auto ref = m_moduleRefs.find( module );
 
-        if( aReference == module->GetReference() )
+        if( ref != m_moduleRefs.end() )
         {
-            found = module;
-            return SEARCH_QUIT;
-        }
+            auto entry = m_modulesByRef.find( ref->second );
 
-        return SEARCH_CONTINUE;
-    };
+            if( entry != m_modulesByRef.end() && entry->second == module )
+                m_modulesByRef.erase( entry );
+        }
 
-    // visit this BOARD with the above inspector
-    BOARD* nonconstMe = (BOARD*) this;
-    nonconstMe->Visit( inspector, NULL, scanTypes );
+        m_modulesByRef[ aReference ] = module;
+        m_moduleRefs[ module ] = aReference;
+        return module;
+    }
 
-    return found;
+    return nullptr;
 }
 
 
@@ -1251,6 +1348,9 @@ D_PAD* BOARD::GetPad( const wxPoint& aPosition, LSET aLayerSet )
     if( !aLayerSet.any() )
         aLayerSet = LSET::AllCuMask();
 
+    if( D_PAD* pad = m_connectivity->GetPadAt( aPosition, aLayerSet ) )
+        return pad;
+
     for( auto module : m_modules )
     {
         D_PAD* pad = NULL;
@@ -1673,6 +1773,90 @@ BOARD_ITEM* BOARD::Duplicate( const BOARD_ITEM* aItem,
 }
 
 
+BOARD* BOARD::CloneForSave() const
+{
+    BOARD* copy = new BOARD();
+
+    copy->m_fileName = m_fileName;
+    copy->m_fileFormatVersionAtLoad = m_fileFormatVersionAtLoad;
+    copy->m_paper = m_paper;
+    copy->m_titles = m_titles;
+    copy->m_plotOptions = m_plotOptions;
+    copy->m_zoneSettings = m_zoneSettings;
+
+    for( LAYER_NUM layer = 0; layer < PCB_LAYER_ID_COUNT; ++layer )
+        copy->m_Layer[layer] = m_Layer[layer];
+
+    // The net classes are shared pointers: copy them too, they can be edited during the save
+    copy->m_designSettings = m_designSettings;
+    copy->m_designSettings.m_NetClasses.CopyFrom( m_designSettings.m_NetClasses );
+
+    // The net codes of the copy can differ, the nets are matched by pointer
+    std::unordered_map<const NETINFO_ITEM*, NETINFO_ITEM*> netMap;
+
+    for( NETINFO_ITEM* net : m_NetInfo )
+    {
+        NETINFO_ITEM* netCopy = copy->m_NetInfo.GetNetItem( net->GetNetname() );
+
+        if( !netCopy )
+        {
+            netCopy = new NETINFO_ITEM( copy, net->GetNetname(), net->GetNet() );
+            copy->m_NetInfo.AppendNet( netCopy );
+        }
+
+        netCopy->SetClass( copy->m_designSettings.m_NetClasses.Find( net->GetClassName() ) );
+        netMap[ net ] = netCopy;
+    }
+
+    auto setNet = [&netMap]( BOARD_CONNECTED_ITEM* aItem )
+    {
+        auto it = netMap.find( aItem->GetNet() );
+
+        // Orphaned items stay orphaned
+        if( it != netMap.end() )
+            aItem->SetNet( it->second );
+    };
+
+    // The items are stored directly: adding them to the connectivity of the copy is not
+    // needed to save it.
+    for( MODULE* module : m_modules )
+    {
+        MODULE* moduleCopy = static_cast<MODULE*>( module->Clone() );
+        moduleCopy->SetParent( copy );
+
+        for( D_PAD* pad : moduleCopy->Pads() )
+            setNet( pad );
+
+        copy->m_modules.push_back( moduleCopy );
+    }
+
+    for( BOARD_ITEM* item : m_drawings )
+    {
+        BOARD_ITEM* itemCopy = static_cast<BOARD_ITEM*>( item->Clone() );
+        itemCopy->SetParent( copy );
+        copy->m_drawings.push_back( itemCopy );
+    }
+
+    for( TRACK* track : m_tracks )
+    {
+        TRACK* trackCopy = static_cast<TRACK*>( track->Clone() );
+        trackCopy->SetParent( copy );
+        setNet( trackCopy );
+        copy->m_tracks.push_back( trackCopy );
+    }
+
+    for( ZONE_CONTAINER* zone : m_ZoneDescriptorList )
+    {
+        ZONE_CONTAINER* zoneCopy = static_cast<ZONE_CONTAINER*>( zone->Clone() );
+        zoneCopy->SetParent( copy );
+        setNet( zoneCopy );
+        copy->m_ZoneDescriptorList.push_back( zoneCopy );
+    }
+
+    return copy;
+}
+
+
 /* Extracts the board outlines and build a closed polygon
  * from lines, arcs and circle items on edge cut layer
  * Any closed outline inside the main outline is a hole
@@ -1712,6 +1896,20 @@ const std::vector<D_PAD*> BOARD::GetPads()
 }
 
 
+int BOARD::GetBiggestClearanceValue() const
+{
+    int clearance = GetDesignSettings().GetBiggestClearanceValue();
+
+    for( MODULE* mod : Modules() )
+    {
+        for( D_PAD* pad : mod->Pads() )
+            clearance = std::max( clearance, pad->GetClearance( NULL ) );
+    }
+
+    return clearance;
+}
+
+
 unsigned BOARD::GetPadCount()
 {
     unsigned retval = 0;
@@ -41,6 +41,7 @@
 #include <zone_settings.h>
 
 #include <memory>
+#include <unordered_map>
 
 using std::unique_ptr;
 
@@ -199,6 +200,19 @@ private:
     PCB_PLOT_PARAMS         m_plotOptions;
     NETINFO_LIST            m_NetInfo;              ///< net info list (name, design constraints ..
 
+    /// The modules by reference, for FindModuleByReference(), and the reference of each.
+    /// The board is not told of the reference changes: the entries are checked when used.
+    mutable std::unordered_map<wxString, MODULE*>       m_modulesByRef;
+    mutable std::unordered_map<const MODULE*, wxString> m_moduleRefs;
+    mutable bool                                        m_modulesByRefValid;
+
+    /// netclass clearance of each net, indexed by netcode, see BuildNetClearances()
+    std::vector<int>        m_netClearances;
+    int                     m_defaultNetClearance;  ///< clearance of the default netclass
+
+    /// memory of the items read into this board, NULL if they come from the heap
+    BOARD_ITEM_ARENA*       m_itemArena;
+
 
     // The default copy constructor & operator= are inadequate,
     // either write one or do not use it at all
@@ -224,6 +238,17 @@ public:
 
     const wxString &GetFileName() const { return m_fileName; }
 
+    /**
+     * Function UseItemArena
+     * creates the arena of the items read into this board, if there is none yet.  The
+     * readers allocate the items from it within a BOARD_ITEM_ARENA::SCOPE.
+     * @return the arena of the board
+     */
+    BOARD_ITEM_ARENA* UseItemArena();
+
+    /// @return the arena of the items read into this board, or NULL if there is none
+    BOARD_ITEM_ARENA* GetItemArena() const { return m_itemArena; }
+
     TRACKS& Tracks()
     {
         return m_tracks;
@@ -296,12 +321,27 @@ public:
             delete mod;
 
         m_modules.clear();
+        m_modulesByRef.clear();
+        m_moduleRefs.clear();
+        m_modulesByRefValid = false;
     }
 
     BOARD_ITEM* GetItem( void* aWeakReference );
 
     BOARD_ITEM* Duplicate( const BOARD_ITEM* aItem, bool aAddToBoard = false );
 
+    /**
+     * Function CloneForSave
+     * creates a copy of the board holding everything the board file formatters write:
+     * the settings, the nets, the net classes and copies of the modules, drawings, tracks
+     * and zones.  The copy shares nothing mutable with this board, so it can be saved on
+     * another thread while this board is edited.  Its items are not added to its
+     * connectivity data, and the markers are not copied.
+     *
+     * @return the new board, owned by the caller.
+     */
+    BOARD* CloneForSave() const;
+
     /**
      * Function GetConnectivity()
      * returns list of missing connections between components/tracks.
@@ -726,6 +766,14 @@ public:
      */
     const std::vector<D_PAD*> GetPads();
 
+    /**
+     * Function GetBiggestClearanceValue
+     * @return the biggest clearance of the board items: the biggest net class clearance,
+     * or the biggest local clearance of the pads and footprints, which can exceed it.
+     * This is the distance to search around an item for the items it can collide with.
+     */
+    int GetBiggestClearanceValue() const;
+
     void BuildListOfNets()
     {
         m_NetInfo.buildListOfNets();
@@ -836,8 +884,8 @@ public:
     /**
      * Function FindModuleByReference
      * searches for a MODULE within this board with the given
-     * reference designator.  Finds only the first one, if there
-     * is more than one such MODULE.
+     * reference designator.  Finds only one, if there is more than
+     * one such MODULE.  The modules are looked up by hash.
      * @param aReference The reference designator of the MODULE to find.
      * @return MODULE* - If found, the MODULE having the given reference
      *  designator, else NULL.
@@ -873,6 +921,28 @@ public:
      */
     void SynchronizeNetsAndNetClasses();
 
+    /**
+     * Function BuildNetClearances
+     * builds the per net clearance table used by GetNetClearance().  The table is rebuilt
+     * by SynchronizeNetsAndNetClasses(), and should be rebuilt before a long run of
+     * clearance lookups (DRC, router) if netclasses were edited since.
+     */
+    void BuildNetClearances();
+
+    /**
+     * Function GetNetClearance
+     * @return the netclass clearance of a net without any netclass lookup.  This is the
+     * value of BOARD_CONNECTED_ITEM::GetClearance() for items without a local clearance.
+     * Unknown nets and net 0 use the default netclass clearance.
+     */
+    int GetNetClearance( int aNetCode ) const
+    {
+        if( aNetCode > 0 && aNetCode < (int) m_netClearances.size() )
+            return m_netClearances[aNetCode];
+
+        return m_defaultNetClearance;
+    }
+
     /***************************************************************************/
 
     wxString GetClass() const override
@@ -1067,7 +1137,9 @@ public:
 
     /**
      * Function GetPad
-     * finds a pad \a aPosition on \a aLayer.
+     * finds a pad \a aPosition on \a aLayer.  The copper pads are looked up in the spatial
+     * index of the connectivity, the others (or the ones unknown to the connectivity, such
+     * as pads added by scripts to a module of the board) by a scan of the modules.
      *
      * @param aPosition A wxPoint object containing the position to hit test.
      * @param aLayerMask A layer or layers to mask the hit test.
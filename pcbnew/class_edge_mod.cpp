@@ -451,6 +451,13 @@ unsigned int EDGE_MODULE::ViewGetLOD( int aLayer, KIGFX::VIEW* aView ) const
     if( IsParentFlipped() && !aView->IsLayerVisible( LAYER_MOD_BK ) )
         return HIDE;
 
+    // Replaced by the footprint impostor when zoomed out, except in printouts
+    if( m_Parent && m_Parent->Type() == PCB_MODULE_T && aView->GetPrintMode() <= 0 )
+    {
+        auto module = static_cast<const MODULE*>( m_Parent );
+        return module->ViewGetProxyLOD( IsParentFlipped() ? LAYER_MOD_BK : LAYER_MOD_FR, aView );
+    }
+
     // Other layers are shown without any conditions
     return 0;
 }
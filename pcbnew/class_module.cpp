@@ -52,8 +52,10 @@ MODULE::MODULE( BOARD* parent ) :
     m_Attributs    = MOD_DEFAULT;
     m_Layer        = F_Cu;
     m_Orient       = 0;
+    m_BoundaryBoxValid = false;
     m_ModuleStatus = MODULE_PADS_LOCKED;
     m_arflag = 0;
+    m_courtyardOk = true;
     m_CntRot90 = m_CntRot180 = 0;
     m_Link     = 0;
     m_LastEditTime  = 0;
@@ -82,6 +84,7 @@ MODULE::MODULE( const MODULE& aModule ) :
     m_ModuleStatus = aModule.m_ModuleStatus;
     m_Orient = aModule.m_Orient;
     m_BoundaryBox = aModule.m_BoundaryBox;
+    m_BoundaryBoxValid = false;
     m_CntRot90 = aModule.m_CntRot90;
     m_CntRot180 = aModule.m_CntRot180;
     m_LastEditTime = aModule.m_LastEditTime;
@@ -131,6 +134,7 @@ MODULE::MODULE( const MODULE& aModule ) :
     m_KeyWord = aModule.m_KeyWord;
 
     m_arflag = 0;
+    m_courtyardOk = true;
 
     // Ensure auxiliary data is up to date
     CalculateBoundingBox();
@@ -158,6 +162,7 @@ MODULE& MODULE::operator=( const MODULE& aOther )
     m_ModuleStatus  = aOther.m_ModuleStatus;
     m_Orient        = aOther.m_Orient;
     m_BoundaryBox   = aOther.m_BoundaryBox;
+    m_BoundaryBoxValid = false;
     m_CntRot90      = aOther.m_CntRot90;
     m_CntRot180     = aOther.m_CntRot180;
     m_LastEditTime  = aOther.m_LastEditTime;
@@ -262,6 +267,16 @@ void MODULE::Add( BOARD_ITEM* aBoardItem, ADD_MODE aMode )
     }
 
     aBoardItem->SetParent( this );
+    m_BoundaryBoxValid = false;
+    InvalidateHash();
+}
+
+
+void MODULE::InvalidateHashes()
+{
+    // The pads, texts and drawings are often changed through their footprint
+    RunOnChildren( []( BOARD_ITEM* aItem ) { aItem->InvalidateHash(); } );
+    InvalidateHash();
 }
 
 
@@ -309,6 +324,9 @@ void MODULE::Remove( BOARD_ITEM* aBoardItem )
         wxFAIL_MSG( msg );
     }
     }
+
+    m_BoundaryBoxValid = false;
+    InvalidateHash();
 }
 
 
@@ -344,19 +362,42 @@ void MODULE::Print( PCB_BASE_FRAME* aFrame, wxDC* aDC, const wxPoint& aOffset )
 
 void MODULE::CalculateBoundingBox()
 {
-    m_BoundaryBox = GetFootprintRect();
+    m_BoundaryBox = calcFootprintRect();
+    m_BoundaryBoxValid = true;
 }
 
 
 double MODULE::GetArea( int aPadding ) const
 {
-    double w = std::abs( m_BoundaryBox.GetWidth() ) + aPadding;
-    double h = std::abs( m_BoundaryBox.GetHeight() ) + aPadding;
+    EDA_RECT bbox = GetFootprintRect();
+
+    double w = std::abs( bbox.GetWidth() ) + aPadding;
+    double h = std::abs( bbox.GetHeight() ) + aPadding;
     return w * h;
 }
 
 
 EDA_RECT MODULE::GetFootprintRect() const
+{
+    if( !m_BoundaryBoxValid )
+    {
+        m_BoundaryBox = calcFootprintRect();
+        m_BoundaryBoxValid = true;
+    }
+
+#ifdef DEBUG
+    // The items of the footprint were changed directly without CalculateBoundingBox()
+    EDA_RECT check = calcFootprintRect();
+    wxASSERT_MSG( m_BoundaryBox.GetOrigin() == check.GetOrigin()
+                          && m_BoundaryBox.GetSize() == check.GetSize(),
+                  wxT( "MODULE::GetFootprintRect(): stale cached bounding box" ) );
+#endif
+
+    return m_BoundaryBox;
+}
+
+
+EDA_RECT MODULE::calcFootprintRect() const
 {
     EDA_RECT area;
 
@@ -526,7 +567,7 @@ void MODULE::GetMsgPanelInfo( EDA_UNITS_T aUnits, std::vector< MSG_PANEL_ITEM >&
 
 bool MODULE::HitTest( const wxPoint& aPosition, int aAccuracy ) const
 {
-    EDA_RECT rect = m_BoundaryBox;
+    EDA_RECT rect = GetFootprintRect();
     return rect.Inflate( aAccuracy ).Contains( aPosition );
 }
 
@@ -543,7 +584,7 @@ bool MODULE::HitTest( const EDA_RECT& aRect, bool aContained, int aAccuracy ) co
     arect.Inflate( aAccuracy );
 
     if( aContained )
-        return arect.Contains( m_BoundaryBox );
+        return arect.Contains( GetFootprintRect() );
     else
     {
         // If the rect does not intersect the bounding box, skip any tests
@@ -879,11 +920,26 @@ unsigned int MODULE::ViewGetLOD( int aLayer, KIGFX::VIEW* aView ) const
     int layer = ( m_Layer == F_Cu ) ? LAYER_MOD_FR :
                 ( m_Layer == B_Cu ) ? LAYER_MOD_BK : LAYER_ANCHOR;
 
-    // Currently it is only for anchor layer
-    if( aView->IsLayerVisible( layer ) )
-        return 3;
+    if( !aView->IsLayerVisible( layer ) )
+        return std::numeric_limits<unsigned int>::max();
 
-    return std::numeric_limits<unsigned int>::max();
+    // Only the anchor depends on the zoom, the footprint layer holds the impostor
+    // (see ViewGetProxyLOD())
+    return aLayer == LAYER_ANCHOR ? 3 : 0;
+}
+
+
+unsigned int MODULE::ViewGetProxyLOD( int aLayer, KIGFX::VIEW* aView ) const
+{
+    if( aLayer != LAYER_MOD_FR && aLayer != LAYER_MOD_BK )
+        return 0;
+
+    // Footprints only a few pixels wide are drawn as the outline of their area instead of
+    // their graphic items, which are hidden at the same scale (see EDGE_MODULE::ViewGetLOD())
+    EDA_RECT bbox = GetFootprintRect();
+    int      size = std::max( bbox.GetWidth(), bbox.GetHeight() );
+
+    return Millimeter2iu( 4 ) / ( size + 1 );
 }
 
 
@@ -1156,7 +1212,10 @@ BOARD_ITEM* MODULE::Duplicate( const BOARD_ITEM* aItem,
         new_pad = new D_PAD( *static_cast<const D_PAD*>( aItem ) );
 
         if( aAddToModule )
+        {
             m_pads.push_back( new_pad );
+            m_BoundaryBoxValid = false;
+        }
 
         new_item = new_pad;
         break;
@@ -1316,23 +1375,58 @@ extern bool ConvertOutlineToPolygon( std::vector<DRAWSEGMENT*>& aSegList, SHAPE_
 
 bool MODULE::BuildPolyCourtyard()
 {
-    m_poly_courtyard_front.RemoveAllContours();
-    m_poly_courtyard_back.RemoveAllContours();
     // Build the courtyard area from graphic items on the courtyard.
     // Only PCB_MODULE_EDGE_T have meaning, graphic texts are ignored.
     // Collect items:
     std::vector< DRAWSEGMENT* > list_front;
     std::vector< DRAWSEGMENT* > list_back;
+    std::vector<int>            signature;
+
+    auto addPoint = [&]( const wxPoint& aPoint )
+    {
+        signature.push_back( aPoint.x );
+        signature.push_back( aPoint.y );
+    };
+
+    // Some shapes (polygons) are not stored in board coordinates
+    addPoint( m_Pos );
+    signature.push_back( KiROUND( m_Orient ) );
 
     for( auto item : GraphicalItems() )
     {
-        if( item->GetLayer() == B_CrtYd && item->Type() == PCB_MODULE_EDGE_T )
-            list_back.push_back( static_cast< DRAWSEGMENT* > ( item ) );
+        if( item->Type() != PCB_MODULE_EDGE_T
+                || ( item->GetLayer() != B_CrtYd && item->GetLayer() != F_CrtYd ) )
+            continue;
+
+        DRAWSEGMENT* segment = static_cast< DRAWSEGMENT* >( item );
 
-        if( item->GetLayer() == F_CrtYd && item->Type() == PCB_MODULE_EDGE_T )
-            list_front.push_back( static_cast< DRAWSEGMENT* > ( item ) );
+        if( item->GetLayer() == B_CrtYd )
+            list_back.push_back( segment );
+        else
+            list_front.push_back( segment );
+
+        // Everything the polygon is built from, in board coordinates
+        signature.push_back( segment->GetLayer() );
+        signature.push_back( segment->GetShape() );
+        signature.push_back( KiROUND( segment->GetAngle() ) );
+        addPoint( segment->GetStart() );
+        addPoint( segment->GetEnd() );
+        addPoint( segment->GetBezControl1() );
+        addPoint( segment->GetBezControl2() );
+
+        for( auto iter = segment->GetPolyShape().CIterate(); iter; iter++ )
+            addPoint( wxPoint( iter->x, iter->y ) );
     }
 
+    if( signature == m_courtyardSignature )
+        return m_courtyardOk;
+
+    m_courtyardSignature = std::move( signature );
+    m_courtyardOk = true;
+
+    m_poly_courtyard_front.RemoveAllContours();
+    m_poly_courtyard_back.RemoveAllContours();
+
     // Note: if no item found on courtyard layers, return true.
     // false is returned only when the shape defined on courtyard layers
     // is not convertible to a polygon
@@ -1357,6 +1451,8 @@ bool MODULE::BuildPolyCourtyard()
                                         error_msg) );
     }
 
+    m_courtyardOk = success;
+
     return success;
 }
 
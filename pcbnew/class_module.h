@@ -141,12 +141,16 @@ public:
     /**
      * Function CalculateBoundingBox
      * calculates the bounding box in board coordinates.
+     * The footprint keeps its bounding box when its pads or graphic items are changed directly
+     * (and not through the footprint): this has to be called after such changes.
      */
     void CalculateBoundingBox();
 
     /**
      * Function GetFootprintRect()
      * Returns the area of the module footprint excluding any text.
+     * The area is cached, and computed again only after the footprint was moved, rotated,
+     * flipped, or its items were added, removed or recalculated by CalculateBoundingBox().
      * @return EDA_RECT - The rectangle containing the footprint.
      */
     EDA_RECT GetFootprintRect() const;
@@ -565,6 +569,8 @@ public:
      */
     void RunOnChildren( const std::function<void (BOARD_ITEM*)>& aFunction );
 
+    void InvalidateHashes() override;
+
     /**
      * Returns a set of all layers that this module has drawings on
      * similar to ViewGetLayers()
@@ -579,6 +585,8 @@ public:
 
     virtual unsigned int ViewGetLOD( int aLayer, KIGFX::VIEW* aView ) const override;
 
+    virtual unsigned int ViewGetProxyLOD( int aLayer, KIGFX::VIEW* aView ) const override;
+
     virtual const BOX2I ViewBBox() const override;
 
     /**
@@ -638,7 +646,9 @@ public:
     SHAPE_POLY_SET& GetPolyCourtyardBack() { return m_poly_courtyard_back; }
 
     /** Used in DRC to build the courtyard area (a complex polygon)
-     * from graphic items put on the courtyard
+     * from graphic items put on the courtyard.
+     * The polygons are kept until the courtyard items change (or the footprint moves),
+     * so calling this function again is cheap.
      * @return true if OK, or no courtyard defined,
      * false only if the polygon cannot be built due to amalformed courtyard shape
      * The polygon cannot be built if segments/arcs on courtyard layers
@@ -653,6 +663,11 @@ public:
 #endif
 
 private:
+    /**
+     * Function calcFootprintRect
+     * computes the area of the footprint excluding any text, cached by GetFootprintRect().
+     */
+    EDA_RECT calcFootprintRect() const;
 
     /// BOARD_ITEMs for drawings on the board, owned by pointer.
     DRAWINGS                m_drawings;
@@ -668,7 +683,8 @@ private:
     LIB_ID m_fpid;                      ///< The #LIB_ID of the MODULE.
     int m_Attributs;                    ///< Flag bits ( see Mod_Attribut )
     int m_ModuleStatus;                 ///< For autoplace: flags (LOCKED, AUTOPLACED)
-    EDA_RECT m_BoundaryBox;             ///< Bounding box : coordinates on board, real orientation.
+    mutable EDA_RECT m_BoundaryBox;     ///< Bounding box : coordinates on board, real orientation.
+    mutable bool m_BoundaryBoxValid;    ///< false when m_BoundaryBox has to be computed again
 
     // The final margin is the sum of these 2 values
     int m_ThermalWidth;
@@ -699,6 +715,11 @@ private:
     /// Note also a footprint can have courtyards on bot board sides
     SHAPE_POLY_SET m_poly_courtyard_front;
     SHAPE_POLY_SET m_poly_courtyard_back;
+
+    /// The courtyard items the courtyard polygons were built from, and the result of that
+    /// build, so BuildPolyCourtyard() only rebuilds them when the courtyard changed
+    std::vector<int> m_courtyardSignature;
+    bool             m_courtyardOk;
 };
 
 #endif     // MODULE_H_
@@ -96,6 +96,7 @@ D_PAD::D_PAD( MODULE* parent ) :
     SetSubRatsnest( 0 );                       // used in ratsnest calculations
 
     m_boundingRadius      = -1;
+    m_shapeBoundingBoxValid = false;
 }
 
 
@@ -225,6 +226,29 @@ void D_PAD::SetRoundRectCornerRadius( double aRadius )
 
 
 const EDA_RECT D_PAD::GetBoundingBox() const
+{
+    if( !m_shapeBoundingBoxValid )
+    {
+        m_shapeBoundingBox = calcBoundingBox();
+        m_shapeBoundingBox.Move( -m_Pos );
+        m_shapeBoundingBoxValid = true;
+    }
+
+    EDA_RECT area = m_shapeBoundingBox;
+    area.Move( m_Pos );
+
+#ifdef DEBUG
+    // A setter of the shape not invalidating the cache would leave a stale box here
+    EDA_RECT check = calcBoundingBox();
+    wxASSERT_MSG( area.GetOrigin() == check.GetOrigin() && area.GetSize() == check.GetSize(),
+                  wxT( "D_PAD::GetBoundingBox(): stale cached bounding box" ) );
+#endif
+
+    return area;
+}
+
+
+EDA_RECT D_PAD::calcBoundingBox() const
 {
     EDA_RECT area;
     wxPoint quadrant1, quadrant2, quadrant3, quadrant4;
@@ -431,6 +455,7 @@ void D_PAD::SetOrientation( double aAngle )
 {
     NORMALIZE_ANGLE_POS( aAngle );
     m_Orient = aAngle;
+    m_shapeBoundingBoxValid = false;
 }
 
 
@@ -463,6 +488,7 @@ void D_PAD::Flip( const wxPoint& aCentre, bool aFlipLeftRight )
     FlipPrimitives();
 
     // m_boundingRadius = -1;  the shape has not been changed
+    m_shapeBoundingBoxValid = false;
 }
 
 
@@ -532,6 +558,8 @@ void D_PAD::MirrorXPrimitives( int aX )
         for( int ii = 0; ii < poly.PointCount(); ++ii )
             MIRROR( poly.Point( ii ).x, 0 );
     }
+
+    m_shapeBoundingBoxValid = false;
 }
 
 
@@ -1209,6 +1237,7 @@ void D_PAD::Rotate( const wxPoint& aRotCentre, double aAngle )
     RotatePoint( &m_Pos, aRotCentre, aAngle );
 
     m_Orient = NormalizeAngle360Min( m_Orient + aAngle );
+    m_shapeBoundingBoxValid = false;
 
     SetLocalCoord();
 }
@@ -219,7 +219,12 @@ public:
      * @return the shape of this pad.
      */
     PAD_SHAPE_T GetShape() const                { return m_padShape; }
-    void SetShape( PAD_SHAPE_T aShape )         { m_padShape = aShape; m_boundingRadius = -1; }
+    void SetShape( PAD_SHAPE_T aShape )
+    {
+        m_padShape = aShape;
+        m_boundingRadius = -1;
+        m_shapeBoundingBoxValid = false;
+    }
 
     void SetPosition( const wxPoint& aPos ) override { m_Pos = aPos; }
     const wxPoint GetPosition() const override { return m_Pos; }
@@ -259,6 +264,7 @@ public:
     {
         m_anchorPadShape = ( aShape ==  PAD_SHAPE_RECT ) ? PAD_SHAPE_RECT : PAD_SHAPE_CIRCLE;
         m_boundingRadius = -1;
+        m_shapeBoundingBoxValid = false;
     }
 
     /**
@@ -280,16 +286,26 @@ public:
     void SetY0( int y )                         { m_Pos0.y = y; }
     void SetX0( int x )                         { m_Pos0.x = x; }
 
-    void SetSize( const wxSize& aSize )         { m_Size = aSize;  m_boundingRadius = -1; }
+    void SetSize( const wxSize& aSize )
+    {
+        m_Size = aSize;
+        m_boundingRadius = -1;
+        m_shapeBoundingBoxValid = false;
+    }
     const wxSize& GetSize() const               { return m_Size; }
 
-    void SetDelta( const wxSize& aSize )        { m_DeltaSize = aSize;  m_boundingRadius = -1; }
+    void SetDelta( const wxSize& aSize )
+    {
+        m_DeltaSize = aSize;
+        m_boundingRadius = -1;
+        m_shapeBoundingBoxValid = false;
+    }
     const wxSize& GetDelta() const              { return m_DeltaSize; }
 
     void SetDrillSize( const wxSize& aSize )    { m_Drill = aSize; }
     const wxSize& GetDrillSize() const          { return m_Drill; }
 
-    void SetOffset( const wxPoint& aOffset )    { m_Offset = aOffset; }
+    void SetOffset( const wxPoint& aOffset )    { m_Offset = aOffset; m_shapeBoundingBoxValid = false; }
     const wxPoint& GetOffset() const            { return m_Offset; }
 
     /**
@@ -724,7 +740,10 @@ public:
         return wxT( "PAD" );
     }
 
-    // Virtual function:
+    /**
+     * The bounding box of the shape is cached relative to the pad position: moving the pad
+     * keeps it, any other change of the shape (size, orientation, offset...) recomputes it.
+     */
     const EDA_RECT GetBoundingBox() const override;
 
     ///> Set absolute coordinates.
@@ -812,6 +831,12 @@ private:
      */
     int boundingRadius() const;
 
+    /**
+     * Function calcBoundingBox
+     * returns the bounding box of the pad shape, computed at the pad position.
+     */
+    EDA_RECT calcBoundingBox() const;
+
     bool buildCustomPadPolygon( SHAPE_POLY_SET* aMergedPolygon, int aError );
 
 private:    // Private variable members:
@@ -819,6 +844,9 @@ private:    // Private variable members:
     // Actually computed and cached on demand by the accessor
     mutable int m_boundingRadius;  ///< radius of the circle containing the pad shape
 
+    mutable EDA_RECT m_shapeBoundingBox;    ///< bounding box of the shape, relative to m_Pos
+    mutable bool     m_shapeBoundingBoxValid;
+
     wxString    m_name;
 
     // TODO: Remove m_Pos from Pad or make private.  View positions calculated from m_Pos0
@@ -181,3 +181,10 @@ void TEXTE_PCB::SwapData( BOARD_ITEM* aImage )
 
     std::swap( *((TEXTE_PCB*) this), *((TEXTE_PCB*) aImage) );
 }
+
+
+unsigned int TEXTE_PCB::ViewGetProxyLOD( int aLayer, KIGFX::VIEW* aView ) const
+{
+    // Text only a few pixels high is drawn as a bar
+    return Millimeter2iu( 1 ) / ( GetTextHeight() + 1 );
+}
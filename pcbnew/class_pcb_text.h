@@ -124,6 +124,8 @@ public:
 
     virtual void SwapData( BOARD_ITEM* aImage ) override;
 
+    virtual unsigned int ViewGetProxyLOD( int aLayer, KIGFX::VIEW* aView ) const override;
+
 #if defined(DEBUG)
     virtual void Show( int nestLevel, std::ostream& os ) const override { ShowDummy( os ); }
 #endif
@@ -486,6 +486,13 @@ unsigned int TEXTE_MODULE::ViewGetLOD( int aLayer, KIGFX::VIEW* aView ) const
 }
 
 
+unsigned int TEXTE_MODULE::ViewGetProxyLOD( int aLayer, KIGFX::VIEW* aView ) const
+{
+    // Text only a few pixels high is drawn as a bar
+    return Millimeter2iu( 1 ) / ( GetTextHeight() + 1 );
+}
+
+
 wxString TEXTE_MODULE::GetShownText() const
 {
     /* First order optimization: no % means that no processing is
@@ -224,6 +224,8 @@ public:
 
     virtual unsigned int ViewGetLOD( int aLayer, KIGFX::VIEW* aView ) const override;
 
+    virtual unsigned int ViewGetProxyLOD( int aLayer, KIGFX::VIEW* aView ) const override;
+
 #if defined(DEBUG)
     virtual void Show( int nestLevel, std::ostream& os ) const override { ShowDummy( os ); }
 #endif
@@ -66,6 +66,7 @@ ZONE_CONTAINER::ZONE_CONTAINER( BOARD* aBoard ) :
     m_cornerRadius = 0;
     SetLocalFlags( 0 );                         // flags tempoarry used in zone calculations
     m_Poly = new SHAPE_POLY_SET();              // Outlines
+    m_FilledPolysList = std::make_shared<SHAPE_POLY_SET>();
     m_FilledPolysUseThickness = true;           // set the "old" way to build filled polygon areas (before 6.0.x)
     aBoard->GetZoneSettings().ExportSetting( *this );
 
@@ -92,8 +93,9 @@ ZONE_CONTAINER::ZONE_CONTAINER( const ZONE_CONTAINER& aZone ) :
     m_PadConnection = aZone.m_PadConnection;
     m_ThermalReliefGap = aZone.m_ThermalReliefGap;
     m_ThermalReliefCopperBridge = aZone.m_ThermalReliefCopperBridge;
-    m_FilledPolysList.Append( aZone.m_FilledPolysList );
+    m_FilledPolysList = aZone.m_FilledPolysList;  // shared until changed
     m_FillSegmList = aZone.m_FillSegmList;      // vector <> copy
+    m_fillFingerprint = aZone.m_fillFingerprint;
 
     m_isKeepout = aZone.m_isKeepout;
     m_doNotAllowCopperPour = aZone.m_doNotAllowCopperPour;
@@ -133,10 +135,10 @@ ZONE_CONTAINER& ZONE_CONTAINER::operator=( const ZONE_CONTAINER& aOther )
     SetHatchStyle( aOther.GetHatchStyle() );
     SetHatchPitch( aOther.GetHatchPitch() );
     m_HatchLines = aOther.m_HatchLines;     // copy vector <SEG>
-    m_FilledPolysList.RemoveAllContours();
-    m_FilledPolysList.Append( aOther.m_FilledPolysList );
+    m_FilledPolysList = aOther.m_FilledPolysList;     // shared until changed
     m_FillSegmList.clear();
     m_FillSegmList = aOther.m_FillSegmList;
+    m_fillFingerprint = aOther.m_fillFingerprint;
 
     SetLayerSet( aOther.GetLayerSet() );
 
@@ -159,11 +161,12 @@ EDA_ITEM* ZONE_CONTAINER::Clone() const
 
 bool ZONE_CONTAINER::UnFill()
 {
-    bool change = ( !m_FilledPolysList.IsEmpty() || m_FillSegmList.size() > 0 );
+    bool change = ( !m_FilledPolysList->IsEmpty() || m_FillSegmList.size() > 0 );
 
-    m_FilledPolysList.RemoveAllContours();
+    m_FilledPolysList = std::make_shared<SHAPE_POLY_SET>();
     m_FillSegmList.clear();
     m_IsFilled = false;
+    m_fillFingerprint.clear();
 
     return change;
 }
@@ -264,6 +267,14 @@ void ZONE_CONTAINER::ViewGetLayers( int aLayers[], int& aCount ) const
 }
 
 
+unsigned int ZONE_CONTAINER::ViewGetProxyLOD( int aLayer, KIGFX::VIEW* aView ) const
+{
+    // Once the minimum thickness is a few pixels wide, the filling is drawn with outlines
+    // decimated by a quarter of it (see PCB_PAINTER::DrawProxy())
+    return Millimeter2iu( 1 ) / ( m_ZoneMinThickness + 1 );
+}
+
+
 bool ZONE_CONTAINER::IsOnLayer( PCB_LAYER_ID aLayer ) const
 {
     if( GetIsKeepout() )
@@ -400,7 +411,7 @@ void ZONE_CONTAINER::PrintFilledArea( PCB_BASE_FRAME* aFrame, wxDC* DC, const wx
     if( displ_opts->m_DisplayZonesMode == 1 )     // Do not show filled areas
         return;
 
-    if( m_FilledPolysList.IsEmpty() )  // Nothing to draw
+    if( m_FilledPolysList->IsEmpty() )  // Nothing to draw
         return;
 
     if( brd->IsLayerVisible( GetLayer() ) == false )
@@ -408,9 +419,9 @@ void ZONE_CONTAINER::PrintFilledArea( PCB_BASE_FRAME* aFrame, wxDC* DC, const wx
 
     color.a = 0.588;
 
-    for( int ic = 0; ic < m_FilledPolysList.OutlineCount(); ic++ )
+    for( int ic = 0; ic < m_FilledPolysList->OutlineCount(); ic++ )
     {
-        const SHAPE_LINE_CHAIN& path = m_FilledPolysList.COutline( ic );
+        const SHAPE_LINE_CHAIN& path = m_FilledPolysList->COutline( ic );
 
         CornersBuffer.clear();
 
@@ -642,7 +653,7 @@ int ZONE_CONTAINER::GetClearance( BOARD_CONNECTED_ITEM* aItem ) const
 
 bool ZONE_CONTAINER::HitTestFilledArea( const wxPoint& aRefPos ) const
 {
-    return m_FilledPolysList.Contains( VECTOR2I( aRefPos.x, aRefPos.y ) );
+    return m_FilledPolysList->Contains( VECTOR2I( aRefPos.x, aRefPos.y ) );
 }
 
 
@@ -725,9 +736,9 @@ void ZONE_CONTAINER::GetMsgPanelInfo( EDA_UNITS_T aUnits, std::vector< MSG_PANEL
     msg.Printf( wxT( "%d" ), (int) m_HatchLines.size() );
     aList.emplace_back( MSG_PANEL_ITEM( _( "Hatch Lines" ), msg, BLUE ) );
 
-    if( !m_FilledPolysList.IsEmpty() )
+    if( !m_FilledPolysList->IsEmpty() )
     {
-        msg.Printf( wxT( "%d" ), m_FilledPolysList.TotalVertices() );
+        msg.Printf( wxT( "%d" ), m_FilledPolysList->TotalVertices() );
         aList.emplace_back( MSG_PANEL_ITEM( _( "Corner Count" ), msg, BLUE ) );
     }
 }
@@ -742,7 +753,7 @@ void ZONE_CONTAINER::Move( const wxPoint& offset )
 
     Hatch();
 
-    m_FilledPolysList.Move( offset );
+    ownFilledPolysList().Move( offset );
 
     for( SEG& seg : m_FillSegmList )
     {
@@ -782,7 +793,7 @@ void ZONE_CONTAINER::Rotate( const wxPoint& centre, double angle )
     Hatch();
 
     /* rotate filled areas: */
-    for( auto ic = m_FilledPolysList.Iterate(); ic; ++ic )
+    for( auto ic = ownFilledPolysList().Iterate(); ic; ++ic )
         RotatePoint( &ic->x, &ic->y, centre.x, centre.y, angle );
 
     for( unsigned ic = 0; ic < m_FillSegmList.size(); ic++ )
@@ -825,7 +836,7 @@ void ZONE_CONTAINER::Mirror( const wxPoint& aMirrorRef, bool aMirrorLeftRight )
 
     Hatch();
 
-    for( auto ic = m_FilledPolysList.Iterate(); ic; ++ic )
+    for( auto ic = ownFilledPolysList().Iterate(); ic; ++ic )
     {
         if( aMirrorLeftRight )
             ic->x = ( aMirrorRef.x - ic->x ) + aMirrorRef.x;
@@ -1154,7 +1165,17 @@ void ZONE_CONTAINER::SwapData( BOARD_ITEM* aImage )
 
 void ZONE_CONTAINER::CacheTriangulation()
 {
-    m_FilledPolysList.CacheTriangulation();
+    // The triangulation does not change the polygons, so shared ones are not copied
+    m_FilledPolysList->CacheTriangulation();
+}
+
+
+SHAPE_POLY_SET& ZONE_CONTAINER::ownFilledPolysList()
+{
+    if( m_FilledPolysList.use_count() > 1 )
+        m_FilledPolysList = std::make_shared<SHAPE_POLY_SET>( *m_FilledPolysList );
+
+    return *m_FilledPolysList;
 }
 
 
@@ -30,6 +30,7 @@
 #define CLASS_ZONE_H_
 
 
+#include <memory>
 #include <vector>
 #include <gr_basic.h>
 #include <class_board_item.h>
@@ -146,6 +147,8 @@ public:
 
     virtual void ViewGetLayers( int aLayers[], int& aCount ) const override;
 
+    virtual unsigned int ViewGetProxyLOD( int aLayer, KIGFX::VIEW* aView ) const override;
+
     void SetFillMode( ZONE_FILL_MODE aFillMode ) { m_FillMode = aFillMode; }
     ZONE_FILL_MODE GetFillMode() const { return m_FillMode; }
 
@@ -532,7 +535,7 @@ public:
      */
     void ClearFilledPolysList()
     {
-        m_FilledPolysList.RemoveAllContours();
+        m_FilledPolysList = std::make_shared<SHAPE_POLY_SET>();
     }
 
    /**
@@ -541,6 +544,17 @@ public:
      * @return Reference to the list of filled polygons.
      */
     const SHAPE_POLY_SET& GetFilledPolysList() const
+    {
+        return *m_FilledPolysList;
+    }
+
+    /**
+     * Function GetSharedFilledPolysList
+     * returns the list of filled polygons, shared with the zone.  The list is never modified
+     * once shared: the zone makes its own copy before changing it, and a new list is made
+     * when it is refilled.
+     */
+    std::shared_ptr<const SHAPE_POLY_SET> GetSharedFilledPolysList() const
     {
         return m_FilledPolysList;
     }
@@ -552,11 +566,17 @@ public:
 
    /**
      * Function SetFilledPolysList
-     * sets the list of filled polygons.
+     * sets the list of filled polygons.  The polygons which did not change keep their
+     * triangulation.
      */
     void SetFilledPolysList( SHAPE_POLY_SET& aPolysList )
     {
-        m_FilledPolysList = aPolysList;
+        auto previous = m_FilledPolysList;
+
+        m_FilledPolysList = std::make_shared<SHAPE_POLY_SET>( aPolysList );
+
+        if( previous )
+            m_FilledPolysList->ReuseTriangulations( *previous );
     }
 
     /**
@@ -689,7 +709,14 @@ public:
      *  in m_filledPolysHash.
      *  Used in zone filling calculations, to know if m_FilledPolysList is up to date.
      */
-    void BuildHashValue() { m_filledPolysHash = m_FilledPolysList.GetHash(); }
+    void BuildHashValue() { m_filledPolysHash = m_FilledPolysList->GetHash(); }
+
+    /**
+     * @return the fingerprint of the fill inputs stored when the zone was filled, or an
+     * empty string if unknown.  See ZONE_FILLER::BuildFillFingerprint().
+     */
+    const std::string& GetFillFingerprint() const { return m_fillFingerprint; }
+    void SetFillFingerprint( const std::string& aFingerprint ) { m_fillFingerprint = aFingerprint; }
 
 
 
@@ -700,6 +727,8 @@ public:
     virtual void SwapData( BOARD_ITEM* aImage ) override;
 
 private:
+    ///> Returns the filled polygons to be changed, copying them first if they are shared
+    SHAPE_POLY_SET& ownFilledPolysList();
 
     SHAPE_POLY_SET*       m_Poly;                ///< Outline of the zone.
     int                   m_cornerSmoothingType;
@@ -787,11 +816,15 @@ private:
      * a polygon equivalent to m_Poly, without holes but with extra outline segment
      * connecting "holes" with external main outline.  In complex cases an outline
      * described by m_Poly can have many filled areas
+     * The list is shared by the copies of the zone and by the connectivity, and is copied
+     * by ownFilledPolysList() before being changed.
      */
-    SHAPE_POLY_SET        m_FilledPolysList;
+    std::shared_ptr<SHAPE_POLY_SET> m_FilledPolysList;
     SHAPE_POLY_SET        m_RawPolysList;
     MD5_HASH              m_filledPolysHash;    // A hash value used in zone filling calculations
                                                 // to see if the filled areas are up to date
+    std::string           m_fillFingerprint;    // Fingerprint of the fill inputs, saved with
+                                                // the filled areas
 
     HATCH_STYLE           m_hatchStyle;     // hatch style, see enum above
     int                   m_hatchPitch;     // for DIAGONAL_EDGE, distance between 2 hatch lines
@@ -30,6 +30,10 @@
 #include <class_track.h>
 #include <class_marker_pcb.h>
 #include <class_zone.h>
+#include <class_board.h>
+
+#include <algorithm>
+#include <unordered_set>
 
 
 /* This module contains out of line member functions for classes given in
@@ -486,7 +490,10 @@ void GENERAL_COLLECTOR::Collect( BOARD_ITEM* aItem, const KICAD_T aScanList[],
     // the Inspect() function.
     SetRefPos( aRefPos );
 
-    aItem->Visit( m_inspector, NULL, m_ScanTypes );
+    if( aGuide.GetView() && aItem->Type() == PCB_T )
+        inspectNearbyItems( static_cast<BOARD*>( aItem ), aGuide.GetView() );
+    else
+        aItem->Visit( m_inspector, NULL, m_ScanTypes );
 
     SetTimeNow();               // when snapshot was taken
 
@@ -501,6 +508,51 @@ void GENERAL_COLLECTOR::Collect( BOARD_ITEM* aItem, const KICAD_T aScanList[],
 }
 
 
+void GENERAL_COLLECTOR::inspectNearbyItems( BOARD* aBoard, KIGFX::VIEW* aView )
+{
+    // The view bounding boxes hold the items shapes; the margin covers the tolerance of the
+    // zone corners and edges hit tests.
+    int   margin = KiROUND( 10 * m_Guide->OnePixelInIU() ) + 1;
+    BOX2I area( VECTOR2I( m_RefPos.x - margin, m_RefPos.y - margin ),
+                VECTOR2I( 2 * margin, 2 * margin ) );
+
+    std::vector<KIGFX::VIEW::LAYER_ITEM_PAIR> found;
+    aView->QueryAllLayers( area, found );
+
+    // An item is found once per layer, and the view also holds items not on the board
+    std::unordered_set<BOARD_ITEM*> seen;
+    std::vector<std::pair<int, BOARD_ITEM*>> candidates;
+
+    for( const KIGFX::VIEW::LAYER_ITEM_PAIR& pair : found )
+    {
+        BOARD_ITEM* item = dynamic_cast<BOARD_ITEM*>( pair.first );
+
+        if( !item || !seen.insert( item ).second || item->GetBoard() != aBoard )
+            continue;
+
+        for( int rank = 0; m_ScanTypes[rank] != EOT; ++rank )
+        {
+            if( m_ScanTypes[rank] == item->Type() )
+            {
+                candidates.emplace_back( rank, item );
+                break;
+            }
+        }
+    }
+
+    // Visit() collects the items by scan list order
+    std::stable_sort( candidates.begin(), candidates.end(),
+                      []( const std::pair<int, BOARD_ITEM*>& a,
+                          const std::pair<int, BOARD_ITEM*>& b )
+                      {
+                          return a.first < b.first;
+                      } );
+
+    for( const std::pair<int, BOARD_ITEM*>& candidate : candidates )
+        Inspect( candidate.second, NULL );
+}
+
+
 SEARCH_RESULT PCB_TYPE_COLLECTOR::Inspect( EDA_ITEM* testItem, void* testData )
 {
     // The Visit() function only visits the testItem if its type was in the
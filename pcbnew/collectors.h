@@ -191,6 +191,12 @@ public:
 
     virtual     double OnePixelInIU() const = 0;
 
+    /**
+     * @return the view showing the board, whose spatial index is used to find the items
+     *         near the collection point, or nullptr to scan all the items
+     */
+    virtual     KIGFX::VIEW* GetView() const { return nullptr; }
+
     /**
      * @return bool - true if Inspect() should use BOARD_ITEM::HitTest()
      *             or false if Inspect() should use BOARD_ITEM::BoundsTest().
@@ -375,6 +381,13 @@ public:
      */
     void Collect( BOARD_ITEM* aItem, const KICAD_T aScanList[],
                  const wxPoint& aRefPos, const COLLECTORS_GUIDE& aGuide );
+
+private:
+    /**
+     * Inspect the items of aBoard found near the reference point in the spatial index of
+     * aView, in the priority order of the scan list, instead of visiting all of them.
+     */
+    void inspectNearbyItems( BOARD* aBoard, KIGFX::VIEW* aView );
 };
 
 
@@ -418,6 +431,8 @@ private:
 
     double  m_OnePixelInIU;
 
+    KIGFX::VIEW* m_View;
+
 public:
 
     /**
@@ -466,6 +481,7 @@ public:
         m_IgnoreZoneFills           = true;
 
         m_OnePixelInIU              = aView->ToWorld( one, false ).x;
+        m_View                      = aView;
     }
 
     /**
@@ -610,6 +626,8 @@ public:
     void SetIgnoreZoneFills( bool ignore ) { m_IgnoreZoneFills = ignore; }
 
     double OnePixelInIU() const override { return m_OnePixelInIU; }
+
+    KIGFX::VIEW* GetView() const override { return m_View; }
 };
 
 
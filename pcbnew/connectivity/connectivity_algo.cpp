@@ -26,21 +26,55 @@
 #include <widgets/progress_reporter.h>
 #include <geometry/geometry_utils.h>
 #include <board_commit.h>
+#include <thread_pool.h>
+#include <advanced_config.h>
+#include <profile.h>
+#include <profile_registry.h>
 
-#include <thread>
 #include <mutex>
 #include <algorithm>
-#include <future>
+#include <unordered_set>
 
-#ifdef PROFILE
-#include <profile.h>
-#endif
+
+///> @return true if aNet is flagged in aNets; nets out of the list are not known yet
+static bool isNetFlagged( const std::vector<bool>& aNets, int aNet )
+{
+    if( aNet < 0 )
+        return false;
+
+    return aNet >= (int) aNets.size() || aNets[aNet];
+}
+
+
+static void flagNet( std::vector<bool>& aNets, int aNet )
+{
+    if( aNet < 0 )
+        return;
+
+    if( (int) aNets.size() <= aNet )
+    {
+        int lastNet = aNets.size() - 1;
+
+        if( lastNet < 0 )
+            lastNet = 0;
+
+        aNets.resize( aNet + 1 );
+
+        for( int i = lastNet; i < aNet + 1; i++ )
+            aNets[i] = true;
+    }
+
+    aNets[aNet] = true;
+}
 
 
 bool CN_CONNECTIVITY_ALGO::Remove( BOARD_ITEM* aItem )
 {
     markItemNetAsDirty( aItem );
 
+    // Removing an item can split the clusters of the items it connects, whatever their net
+    markConnectedNetsAsDirty( aItem );
+
     switch( aItem->Type() )
     {
     case PCB_MODULE_T:
@@ -110,6 +144,34 @@ void CN_CONNECTIVITY_ALGO::markItemNetAsDirty( const BOARD_ITEM* aItem )
 }
 
 
+void CN_CONNECTIVITY_ALGO::markConnectedNetsAsDirty( const BOARD_ITEM* aItem )
+{
+    auto markEntry = [this]( const BOARD_CONNECTED_ITEM* aConnectedItem )
+    {
+        auto entry = m_itemMap.find( aConnectedItem );
+
+        if( entry == m_itemMap.end() )
+            return;
+
+        for( CN_ITEM* item : entry->second.m_items )
+        {
+            for( CN_ITEM* connected : item->ConnectedItems() )
+                MarkNetAsDirty( connected->Net() );
+        }
+    };
+
+    if( aItem->IsConnected() )
+    {
+        markEntry( static_cast<const BOARD_CONNECTED_ITEM*>( aItem ) );
+    }
+    else if( aItem->Type() == PCB_MODULE_T )
+    {
+        for( auto pad : static_cast<const MODULE*>( aItem )->Pads() )
+            markEntry( pad );
+    }
+}
+
+
 bool CN_CONNECTIVITY_ALGO::Add( BOARD_ITEM* aItem )
 {
     if( !aItem->IsOnCopperLayer() )
@@ -190,6 +252,8 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
     printf("Search start\n");
 #endif
 
+    SCOPED_PROF_COUNTER<CONNECTIVITY_STATS::DURATION> timer( m_stats.m_searchConnections );
+
 #ifdef PROFILE
     PROF_COUNTER garbage_collection( "garbage-collection" );
 #endif
@@ -198,6 +262,28 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
 
     m_itemList.RemoveInvalidItems( garbage );
 
+    // The ratsnest clusters holding the removed items have to be rebuilt.  The net of an
+    // item can have been changed before it was removed, so it is not always marked dirty.
+    if( !garbage.empty() )
+    {
+        std::unordered_set<const CN_ITEM*> removed( garbage.begin(), garbage.end() );
+
+        for( const auto& cluster : m_ratsnestClusters )
+        {
+            if( isNetFlagged( m_staleClusterNets, cluster->OriginNet() ) )
+                continue;
+
+            for( auto item : *cluster )
+            {
+                if( removed.count( item ) )
+                {
+                    flagNet( m_staleClusterNets, cluster->OriginNet() );
+                    break;
+                }
+            }
+        }
+    }
+
     for( auto item : garbage )
         delete item;
 
@@ -210,6 +296,9 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
     std::copy_if( m_itemList.begin(), m_itemList.end(), std::back_inserter( dirtyItems ),
             [] ( CN_ITEM* aItem ) { return aItem->Dirty(); } );
 
+    m_stats.m_items = m_itemList.Size();
+    m_stats.m_dirtyItems = dirtyItems.size();
+
     if( m_progressReporter )
     {
         m_progressReporter->SetMaxProgress( dirtyItems.size() );
@@ -218,48 +307,28 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
 
     if( m_itemList.IsDirty() )
     {
-        size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
-                ( dirtyItems.size() + 7 ) / 8 );
-
-        std::atomic<size_t> nextItem( 0 );
-        std::vector<std::future<size_t>> returns( parallelThreadCount );
+        PROGRESS_REPORTER* reporter = m_progressReporter;
 
-        auto conn_lambda = [&nextItem, &dirtyItems]
-                            ( CN_LIST* aItemList, PROGRESS_REPORTER* aReporter) -> size_t
-        {
-            for( size_t i = nextItem++; i < dirtyItems.size(); i = nextItem++ )
-            {
-                CN_VISITOR visitor( dirtyItems[i] );
-                aItemList->FindNearby( dirtyItems[i], visitor );
-
-                if( aReporter )
-                    aReporter->AdvanceProgress();
-            }
-
-            return 1;
-        };
+        // Here we balance returns with a 100ms timeout to allow UI updating
+        std::function<void()> refresh;
 
-        if( parallelThreadCount <= 1 )
-            conn_lambda( &m_itemList, m_progressReporter );
-        else
-        {
-            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-                returns[ii] = std::async( std::launch::async, conn_lambda,
-                        &m_itemList, m_progressReporter );
+        if( reporter )
+            refresh = [reporter]() { reporter->KeepRefreshing(); };
 
-            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-            {
-                // Here we balance returns with a 100ms timeout to allow UI updating
-                std::future_status status;
-                do
+        THREAD_POOL::GetPool().ParallelFor( dirtyItems.size(),
+                [&]( size_t i )
                 {
-                    if( m_progressReporter )
-                        m_progressReporter->KeepRefreshing();
-
-                    status = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
-                } while( status != std::future_status::ready );
-            }
-        }
+                    CN_VISITOR visitor( dirtyItems[i] );
+                    m_itemList.FindNearby( dirtyItems[i], visitor );
+
+                    // The progress is advanced once per chunk of 8 items, at its last item
+                    if( reporter && ( i % 8 == 7 || i + 1 == dirtyItems.size() ) )
+                        reporter->AdvanceProgress( i % 8 + 1 );
+                },
+                8, std::min<size_t>( ( dirtyItems.size() + 7 ) / 8,
+                        THREAD_POOL::GetPool().GetThreadCount(
+                                ADVANCED_CFG::GetCfg().m_maxConnectivityThreads ) ),
+                refresh );
 
         if( m_progressReporter )
             m_progressReporter->KeepRefreshing();
@@ -292,17 +361,32 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
 
 const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode,
         const KICAD_T aTypes[], int aSingleNet )
+{
+    return searchClusters( aMode, aTypes, aSingleNet, nullptr );
+}
+
+
+const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::searchClusters( CLUSTER_SEARCH_MODE aMode,
+        const KICAD_T aTypes[], int aSingleNet, const std::vector<bool>* aRootNets )
 {
     bool withinAnyNet = ( aMode != CSM_PROPAGATE );
 
     std::deque<CN_ITEM*> Q;
-    CN_ITEM* head = nullptr;
+    std::vector<CN_ITEM*> roots;
     CLUSTERS clusters;
 
     if( m_itemList.IsDirty() )
         searchConnections();
 
-    auto addToSearchList = [&head, withinAnyNet, aSingleNet, aTypes] ( CN_ITEM *aItem )
+    // The connection search is timed on its own
+    SCOPED_PROF_COUNTER<CONNECTIVITY_STATS::DURATION> timer( m_stats.m_searchClusters );
+
+    auto isRootNet = [aRootNets] ( int aNet )
+    {
+        return !aRootNets || isNetFlagged( *aRootNets, aNet );
+    };
+
+    auto addToSearchList = [&roots, &isRootNet, withinAnyNet, aSingleNet, aTypes] ( CN_ITEM *aItem )
     {
         if( withinAnyNet && aItem->Net() <= 0 )
             return;
@@ -313,6 +397,10 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
         if( aSingleNet >=0 && aItem->Net() != aSingleNet )
             return;
 
+        // When searching within nets, the items of the other nets are never reached
+        if( withinAnyNet && !isRootNet( aItem->Net() ) )
+            return;
+
         bool found = false;
 
         for( int i = 0; aTypes[i] != EOT; i++ )
@@ -327,27 +415,24 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
         if( !found )
             return;
 
-        aItem->ListClear();
         aItem->SetVisited( false );
 
-        if( !head )
-            head = aItem;
-        else
-            head->ListInsert( aItem );
+        if( isRootNet( aItem->Net() ) )
+            roots.push_back( aItem );
     };
 
     std::for_each( m_itemList.begin(), m_itemList.end(), addToSearchList );
 
-    while( head )
+    for( CN_ITEM* root : roots )
     {
+        if( root->Visited() )
+            continue;
+
         CN_CLUSTER_PTR cluster ( new CN_CLUSTER() );
 
         Q.clear();
-        CN_ITEM* root = head;
         root->SetVisited ( true );
 
-        head = root->ListRemove();
-
         Q.push_back( root );
 
         while( Q.size() )
@@ -366,7 +451,6 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
                 {
                     n->SetVisited( true );
                     Q.push_back( n );
-                    head = n->ListRemove();
                 }
             }
         }
@@ -379,6 +463,8 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
         return a->OriginNet() < b->OriginNet();
     } );
 
+    m_stats.m_clusters = clusters.size();
+
 #ifdef CONNECTIVITY_DEBUG
     printf("Active clusters: %d\n", clusters.size() );
 
@@ -395,6 +481,11 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
 
 void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard )
 {
+    SCOPED_PROF_COUNTER<CONNECTIVITY_STATS::DURATION> timer( m_stats.m_build );
+    PROF_SCOPE profScope( "connectivity build" );
+
+    m_itemList.BeginBulkAdd();
+
     for( int i = 0; i<aBoard->GetAreaCount(); i++ )
     {
         auto zone = aBoard->GetArea( i );
@@ -410,6 +501,8 @@ void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard )
             Add( pad );
     }
 
+    m_itemList.EndBulkAdd();
+
     /*wxLogTrace( "CN", "zones : %lu, pads : %lu vias : %lu tracks : %lu\n",
             m_zoneList.Size(), m_padList.Size(),
             m_viaList.Size(), m_trackList.Size() );*/
@@ -418,6 +511,10 @@ void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard )
 
 void CN_CONNECTIVITY_ALGO::Build( const std::vector<BOARD_ITEM*>& aItems )
 {
+    SCOPED_PROF_COUNTER<CONNECTIVITY_STATS::DURATION> timer( m_stats.m_build );
+
+    m_itemList.BeginBulkAdd();
+
     for( auto item : aItems )
     {
         switch( item->Type() )
@@ -442,11 +539,15 @@ void CN_CONNECTIVITY_ALGO::Build( const std::vector<BOARD_ITEM*>& aItems )
                 break;
         }
     }
+
+    m_itemList.EndBulkAdd();
 }
 
 
 void CN_CONNECTIVITY_ALGO::propagateConnections( BOARD_COMMIT* aCommit )
 {
+    SCOPED_PROF_COUNTER<CONNECTIVITY_STATS::DURATION> timer( m_stats.m_propagateNets );
+
     for( const auto& cluster : m_connClusters )
     {
         if( cluster->IsConflicting() )
@@ -497,11 +598,96 @@ void CN_CONNECTIVITY_ALGO::propagateConnections( BOARD_COMMIT* aCommit )
 
 void CN_CONNECTIVITY_ALGO::PropagateNets( BOARD_COMMIT* aCommit )
 {
-    m_connClusters = SearchClusters( CSM_PROPAGATE );
+    constexpr KICAD_T no_zones[] = { PCB_TRACE_T, PCB_PAD_T, PCB_VIA_T, PCB_MODULE_T, EOT };
+
+    // An item is added, removed or changes net only through Add(), Remove() and the
+    // propagation, which all mark the nets of the clusters they change as dirty
+    m_connClusters = searchClusters( CSM_PROPAGATE, no_zones, -1, &m_dirtyNets );
     propagateConnections( aCommit );
 }
 
 
+bool CN_CONNECTIVITY_ALGO::isIsolatedArea( const CN_ZONE* aArea ) const
+{
+    // Walks the items of the zone net connected to the filled area, nearest first, until a
+    // pad is reached: most areas are connected to a pad of their own, and are left after a
+    // few items.  The visited items are stored locally, so several areas can be checked at
+    // the same time.
+    std::unordered_set<const CN_ITEM*> visited;
+    std::vector<const CN_ITEM*>        queue;
+
+    queue.push_back( aArea );
+    visited.insert( aArea );
+
+    for( size_t next = 0; next < queue.size(); ++next )
+    {
+        const CN_ITEM* current = queue[next];
+
+        if( current->Parent()->Type() == PCB_PAD_T )
+            return false;
+
+        for( CN_ITEM* n : current->ConnectedItems() )
+        {
+            if( n->Net() != aArea->Net() || !n->Valid() )
+                continue;
+
+            if( visited.insert( n ).second )
+                queue.push_back( n );
+        }
+    }
+
+    return true;
+}
+
+
+void CN_CONNECTIVITY_ALGO::findIsolatedIslands( std::vector<CN_ZONE_ISOLATED_ISLAND_LIST>& aZones ) const
+{
+    struct AREA
+    {
+        CN_ZONE_ISOLATED_ISLAND_LIST* m_zone;
+        const CN_ZONE*                m_area;
+    };
+
+    // A single zone can hold most of the filled areas of the board, so the areas rather
+    // than the zones are spread over the threads
+    std::vector<AREA> areas;
+
+    for( CN_ZONE_ISOLATED_ISLAND_LIST& zone : aZones )
+    {
+        auto entry = m_itemMap.find( zone.m_zone );
+
+        if( zone.m_zone->GetFilledPolysList().IsEmpty() || entry == m_itemMap.end() )
+            continue;
+
+        for( CN_ITEM* area : entry->second.m_items )
+        {
+            // Items without net are not searched
+            if( area->Net() > 0 && area->Valid() )
+                areas.push_back( { &zone, static_cast<const CN_ZONE*>( area ) } );
+        }
+    }
+
+    std::vector<char> isolated( areas.size(), 0 );
+    std::function<void()> refresh;
+
+    if( m_progressReporter )
+        refresh = [this]() { m_progressReporter->KeepRefreshing(); };
+
+    THREAD_POOL::GetPool().ParallelFor( areas.size(),
+            [&]( size_t i )
+            {
+                isolated[i] = isIsolatedArea( areas[i].m_area );
+            },
+            0, ADVANCED_CFG::GetCfg().m_maxConnectivityThreads, refresh );
+
+    for( size_t ii = 0; ii < areas.size(); ++ii )
+    {
+        if( isolated[ii] )
+            areas[ii].m_zone->m_islands.push_back( areas[ii].m_area->SubpolyIndex() );
+    }
+}
+
+
 void CN_CONNECTIVITY_ALGO::FindIsolatedCopperIslands( ZONE_CONTAINER* aZone, std::vector<int>& aIslands )
 {
     if( aZone->GetFilledPolysList().IsEmpty() )
@@ -512,21 +698,12 @@ void CN_CONNECTIVITY_ALGO::FindIsolatedCopperIslands( ZONE_CONTAINER* aZone, std
     Remove( aZone );
     Add( aZone );
 
-    m_connClusters = SearchClusters( CSM_CONNECTIVITY_CHECK );
+    if( m_itemList.IsDirty() )
+        searchConnections();
 
-    for( const auto& cluster : m_connClusters )
-    {
-        if( cluster->Contains( aZone ) && cluster->IsOrphaned() )
-        {
-            for( auto z : *cluster )
-            {
-                if( z->Parent() == aZone )
-                {
-                    aIslands.push_back( static_cast<CN_ZONE*>(z)->SubpolyIndex() );
-                }
-            }
-        }
-    }
+    std::vector<CN_ZONE_ISOLATED_ISLAND_LIST> zones = { CN_ZONE_ISOLATED_ISLAND_LIST( aZone ) };
+    findIsolatedIslands( zones );
+    aIslands = std::move( zones[0].m_islands );
 
     wxLogTrace( "CN", "Found %u isolated islands\n", (unsigned)aIslands.size() );
 }
@@ -542,56 +719,83 @@ void CN_CONNECTIVITY_ALGO::FindIsolatedCopperIslands( std::vector<CN_ZONE_ISOLAT
             Add( z.m_zone );
     }
 
-    m_connClusters = SearchClusters( CSM_CONNECTIVITY_CHECK );
-
-    for ( auto& zone : aZones )
-    {
-        if( zone.m_zone->GetFilledPolysList().IsEmpty() )
-            continue;
+    // Only the connections of the changed items are searched again
+    if( m_itemList.IsDirty() )
+        searchConnections();
 
-        for( const auto& cluster : m_connClusters )
-        {
-            if( cluster->Contains( zone.m_zone ) && cluster->IsOrphaned() )
-            {
-                for( auto z : *cluster )
-                {
-                    if( z->Parent() == zone.m_zone )
-                    {
-                        zone.m_islands.push_back( static_cast<CN_ZONE*>(z)->SubpolyIndex() );
-                    }
-                }
-            }
-        }
-    }
+    // Each filled area only needs the items connected to it, so the areas are checked on
+    // several threads instead of searching the clusters of the whole board
+    findIsolatedIslands( aZones );
 }
 
 
 const CN_CONNECTIVITY_ALGO::CLUSTERS& CN_CONNECTIVITY_ALGO::GetClusters()
 {
-    m_ratsnestClusters = SearchClusters( CSM_RATSNEST );
+    constexpr KICAD_T types[] = { PCB_TRACE_T, PCB_PAD_T, PCB_VIA_T, PCB_ZONE_AREA_T, PCB_MODULE_T, EOT };
+
+    // Removing the invalid items can make more clusters stale, so do it first
+    if( m_itemList.IsDirty() )
+        searchConnections();
+
+    // A ratsnest cluster holds the items of a single net, so the clusters of the unchanged
+    // nets are kept
+    CLUSTERS clusters = searchClusters( CSM_RATSNEST, types, -1, &m_staleClusterNets );
+
+    for( const auto& cluster : m_ratsnestClusters )
+    {
+        if( !isNetFlagged( m_staleClusterNets, cluster->OriginNet() ) )
+            clusters.push_back( cluster );
+    }
+
+    std::stable_sort( clusters.begin(), clusters.end(), []( CN_CLUSTER_PTR a, CN_CLUSTER_PTR b ) {
+        return a->OriginNet() < b->OriginNet();
+    } );
+
+    m_ratsnestClusters = std::move( clusters );
+    std::fill( m_staleClusterNets.begin(), m_staleClusterNets.end(), false );
+
     return m_ratsnestClusters;
 }
 
 
 void CN_CONNECTIVITY_ALGO::MarkNetAsDirty( int aNet )
 {
-    if( aNet < 0 )
-        return;
+    flagNet( m_dirtyNets, aNet );
+    flagNet( m_staleClusterNets, aNet );
+
+    // Items are added, removed and change net only along with their net being marked dirty
+    m_netItemsValid = false;
+}
+
 
-    if( (int) m_dirtyNets.size() <= aNet )
+const std::vector<CN_ITEM*>& CN_CONNECTIVITY_ALGO::NetItems( int aNet )
+{
+    static const std::vector<CN_ITEM*> noItems;
+
+    if( !m_netItemsValid )
     {
-        int lastNet = m_dirtyNets.size() - 1;
+        m_netItems.clear();
 
-        if( lastNet < 0 )
-            lastNet = 0;
+        for( CN_ITEM* item : m_itemList )
+        {
+            int net = item->Net();
 
-        m_dirtyNets.resize( aNet + 1 );
+            if( !item->Valid() || net < 0 )
+                continue;
 
-        for( int i = lastNet; i < aNet + 1; i++ )
-            m_dirtyNets[i] = true;
+            if( net >= (int) m_netItems.size() )
+                m_netItems.resize( net + 1 );
+
+            m_netItems[net].push_back( item );
+        }
+
+        m_netItemsValid = true;
     }
 
-    m_dirtyNets[aNet] = true;
+    if( aNet < 0 || aNet >= (int) m_netItems.size() )
+        return noItems;
+
+    return m_netItems[aNet];
 }
 
 
@@ -625,7 +829,7 @@ void CN_VISITOR::checkZoneZoneConnection( CN_ZONE* aZoneA, CN_ZONE* aZoneB )
     if( aZoneB->Net() != aZoneA->Net() )
         return; // we only test zones belonging to the same net
 
-    const auto& outline = refParent->GetFilledPolysList().COutline( aZoneA->SubpolyIndex() );
+    const auto& outline = aZoneA->Outline();
 
     for( int i = 0; i < outline.PointCount(); i++ )
     {
@@ -637,7 +841,7 @@ void CN_VISITOR::checkZoneZoneConnection( CN_ZONE* aZoneA, CN_ZONE* aZoneB )
         }
     }
 
-    const auto& outline2 = testedParent->GetFilledPolysList().COutline( aZoneB->SubpolyIndex() );
+    const auto& outline2 = aZoneB->Outline();
 
     for( int i = 0; i < outline2.PointCount(); i++ )
     {
@@ -716,7 +920,8 @@ void CN_CONNECTIVITY_ALGO::Clear()
     m_connClusters.clear();
     m_itemMap.clear();
     m_itemList.Clear();
-
+    m_netItems.clear();
+    m_netItemsValid = false;
 }
 
 
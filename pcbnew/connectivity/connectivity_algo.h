@@ -64,8 +64,8 @@ public:
         m_target( aTarget ),
         m_weight( aWeight ) {}
 
-    CN_ANCHOR_PTR GetSourceNode() const { return m_source; }
-    CN_ANCHOR_PTR GetTargetNode() const { return m_target; }
+    const CN_ANCHOR_PTR& GetSourceNode() const { return m_source; }
+    const CN_ANCHOR_PTR& GetTargetNode() const { return m_target; }
     int GetWeight() const { return m_weight; }
 
     void SetSourceNode( const CN_ANCHOR_PTR& aNode ) { m_source = aNode; }
@@ -150,7 +150,15 @@ private:
     CLUSTERS m_connClusters;
     CLUSTERS m_ratsnestClusters;
     std::vector<bool> m_dirtyNets;
+
+    // Nets whose ratsnest clusters have to be rebuilt by the next GetClusters() call
+    std::vector<bool> m_staleClusterNets;
     PROGRESS_REPORTER* m_progressReporter = nullptr;
+    CONNECTIVITY_STATS m_stats;
+
+    // Valid items of each net, built by NetItems() and dropped when a net is marked dirty
+    std::vector<std::vector<CN_ITEM*>> m_netItems;
+    bool m_netItemsValid = false;
 
     void    searchConnections();
 
@@ -168,6 +176,24 @@ private:
 
     void markItemNetAsDirty( const BOARD_ITEM* aItem );
 
+    ///> Marks the nets of the items connected to aItem as dirty
+    void markConnectedNetsAsDirty( const BOARD_ITEM* aItem );
+
+    /**
+     * Builds the clusters of items of aTypes.
+     * @param aSingleNet is the only net to search, or -1 for all of them
+     * @param aRootNets, if not null, flags the nets to build the clusters from: only the
+     * clusters holding an item of one of these nets are returned
+     */
+    const CLUSTERS searchClusters( CLUSTER_SEARCH_MODE aMode, const KICAD_T aTypes[],
+                                   int aSingleNet, const std::vector<bool>* aRootNets );
+
+    ///> @return true if no pad is connected to aArea; the connections must be up to date
+    bool isIsolatedArea( const CN_ZONE* aArea ) const;
+
+    ///> Finds the islands of aZones on several threads; the connections must be up to date
+    void findIsolatedIslands( std::vector<CN_ZONE_ISOLATED_ISLAND_LIST>& aZones ) const;
+
 public:
 
     CN_CONNECTIVITY_ALGO() {}
@@ -183,6 +209,16 @@ public:
         return m_itemMap[ aItem ];
     }
 
+    /**
+     * Returns the entry of aItem, or nullptr if it is not in the connectivity.  Unlike
+     * ItemEntry(), it may be called by several threads at once.
+     */
+    const ITEM_MAP_ENTRY* FindItemEntry( const BOARD_CONNECTED_ITEM* aItem ) const
+    {
+        auto it = m_itemMap.find( aItem );
+        return it != m_itemMap.end() ? &it->second : nullptr;
+    }
+
     bool IsNetDirty( int aNet ) const
     {
         if( aNet < 0 )
@@ -225,7 +261,9 @@ public:
     const CLUSTERS  SearchClusters( CLUSTER_SEARCH_MODE aMode );
 
     /**
-     * Propagates nets from pads to other items in clusters
+     * Propagates nets from pads to other items in clusters.  Only the clusters holding an
+     * item of a dirty net are searched: the other ones are unchanged since they were last
+     * propagated.
      * @param aCommit is used to store undo information for items modified by the call
      */
     void    PropagateNets( BOARD_COMMIT* aCommit = nullptr );
@@ -242,15 +280,28 @@ public:
 
     bool    CheckConnectivity( std::vector<CN_DISJOINT_NET_ENTRY>& aReport );
 
+    /**
+     * Returns the clusters of connected items of each net.  Only the clusters of the nets
+     * changed since the previous call are rebuilt.
+     */
     const CLUSTERS& GetClusters();
     int             GetUnconnectedCount();
 
     CN_LIST& ItemList() { return m_itemList; }
 
+    CONNECTIVITY_STATS& Stats() { return m_stats; }
+
     void ForEachAnchor( const std::function<void( CN_ANCHOR& )>& aFunc );
     void ForEachItem( const std::function<void( CN_ITEM& )>& aFunc );
 
     void MarkNetAsDirty( int aNet );
+
+    /**
+     * Returns the valid items of net aNet.  The items of all the nets are indexed on the
+     * first call after a change, so that looking up several nets is not a full scan each.
+     */
+    const std::vector<CN_ITEM*>& NetItems( int aNet );
+
     void SetProgressReporter( PROGRESS_REPORTER* aReporter );
 
 };
@@ -23,17 +23,41 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
-#ifdef PROFILE
-#include <profile.h>
-#endif
-
-#include <thread>
 #include <algorithm>
-#include <future>
+#include <unordered_set>
 
 #include <connectivity/connectivity_data.h>
 #include <connectivity/connectivity_algo.h>
 #include <ratsnest_data.h>
+#include <thread_pool.h>
+#include <advanced_config.h>
+#include <profile.h>
+#include <profile_registry.h>
+
+
+/**
+ * The dynamic ratsnest data of a set of dragged items.  The ratsnest between the dragged
+ * items and the anchors of the other items of their nets do not change while they are
+ * dragged, so they are only built once.
+ */
+struct CONNECTIVITY_DATA::DYNAMIC_RATSNEST
+{
+    struct NET
+    {
+        int                        m_netCode;
+        std::vector<CN_ANCHOR_PTR> m_staticAnchors;     ///< sorted by x
+        std::vector<CN_ANCHOR_PTR> m_movedAnchors;
+    };
+
+    std::vector<BOARD_ITEM*>           m_items;
+    std::unique_ptr<CONNECTIVITY_DATA> m_connData;      ///< connectivity of the dragged items
+    std::vector<NET>                   m_nets;
+    std::vector<CN_EDGE>               m_edges;         ///< ratsnest between the dragged items
+
+    ///> True if the current position of all the dragged anchors can be found
+    bool                               m_canFollow;
+};
+
 
 CONNECTIVITY_DATA::CONNECTIVITY_DATA()
 {
@@ -94,7 +118,30 @@ void CONNECTIVITY_DATA::Build( const std::vector<BOARD_ITEM*>& aItems )
 }
 
 
-void CONNECTIVITY_DATA::updateRatsnest()
+static void updateNets( const std::vector<RN_NET*>& aNets, CONNECTIVITY_STATS& aStats )
+{
+    // Keep the numbers of the last real update when nothing is dirty
+    if( aNets.empty() )
+        return;
+
+    SCOPED_PROF_COUNTER<CONNECTIVITY_STATS::DURATION> timer( aStats.m_updateRatsnest );
+    aStats.m_ratsnestNets = aNets.size();
+
+    // Give each thread at least 8 nets (overhead costs)
+    THREAD_POOL& pool = THREAD_POOL::GetPool();
+    size_t       maxThreads = std::min<size_t>( ( aNets.size() + 7 ) / 8,
+            pool.GetThreadCount( ADVANCED_CFG::GetCfg().m_maxConnectivityThreads ) );
+
+    pool.ParallelFor( aNets.size(),
+            [&]( size_t i )
+            {
+                aNets[i]->Update();
+            },
+            1, maxThreads );
+}
+
+
+void CONNECTIVITY_DATA::updateRatsnest() const
 {
     #ifdef PROFILE
     PROF_COUNTER rnUpdate( "update-ratsnest" );
@@ -103,39 +150,34 @@ void CONNECTIVITY_DATA::updateRatsnest()
 
     // Start with net 1 as net 0 is reserved for not-connected
     // Nets without nodes are also ignored
-    std::copy_if( m_nets.begin() + 1, m_nets.end(), std::back_inserter( dirty_nets ),
-            [] ( RN_NET* aNet ) { return aNet->IsDirty() && aNet->GetNodeCount() > 0; } );
+    if( m_nets.size() > 1 )
+    {
+        std::copy_if( m_nets.begin() + 1, m_nets.end(), std::back_inserter( dirty_nets ),
+                [] ( RN_NET* aNet ) { return aNet->IsDirty() && aNet->GetNodeCount() > 0; } );
+    }
 
-    // We don't want to spin up a new thread for fewer than 8 nets (overhead costs)
-    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
-            ( dirty_nets.size() + 7 ) / 8 );
+    updateNets( dirty_nets, m_connAlgo->Stats() );
 
-    std::atomic<size_t> nextNet( 0 );
-    std::vector<std::future<size_t>> returns( parallelThreadCount );
+    #ifdef PROFILE
+    rnUpdate.Show();
+    #endif /* PROFILE */
+}
 
-    auto update_lambda = [&nextNet, &dirty_nets]() -> size_t
-    {
-        for( size_t i = nextNet++; i < dirty_nets.size(); i = nextNet++ )
-            dirty_nets[i]->Update();
 
-        return 1;
-    };
+void CONNECTIVITY_DATA::UpdateRatsnest( const std::vector<int>& aNets )
+{
+    std::vector<RN_NET*> dirty_nets;
 
-    if( parallelThreadCount == 1 )
-        update_lambda();
-    else
+    for( int net : aNets )
     {
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-            returns[ii] = std::async( std::launch::async, update_lambda );
-
-        // Finalize the ratsnest threads
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-            returns[ii].wait();
+        if( net > 0 && net < (int) m_nets.size() && m_nets[net]->IsDirty()
+                && m_nets[net]->GetNodeCount() > 0 )
+        {
+            dirty_nets.push_back( m_nets[net] );
+        }
     }
 
-    #ifdef PROFILE
-    rnUpdate.Show();
-    #endif /* PROFILE */
+    updateNets( dirty_nets, m_connAlgo->Stats() );
 }
 
 
@@ -149,6 +191,13 @@ void CONNECTIVITY_DATA::addRatsnestCluster( const std::shared_ptr<CN_CLUSTER>& a
 
 void CONNECTIVITY_DATA::RecalculateRatsnest( BOARD_COMMIT* aCommit  )
 {
+    SCOPED_PROF_COUNTER<CONNECTIVITY_STATS::DURATION> timer(
+            m_connAlgo->Stats().m_recalculateRatsnest );
+    PROF_SCOPE profScope( "ratsnest update" );
+
+    // The dynamic ratsnest data refers to the anchors of the ratsnest
+    m_dynamicData.reset();
+
     m_connAlgo->PropagateNets( aCommit );
 
     int lastNet = m_connAlgo->NetCount();
@@ -187,7 +236,38 @@ void CONNECTIVITY_DATA::RecalculateRatsnest( BOARD_COMMIT* aCommit  )
 
     m_connAlgo->ClearDirtyFlags();
 
-    updateRatsnest();
+    // The lazy ratsnest is computed by its users, for the nets they need
+    if( !ADVANCED_CFG::GetCfg().m_lazyRatsnest )
+        updateRatsnest();
+}
+
+
+const CONNECTIVITY_STATS& CONNECTIVITY_DATA::GetStats() const
+{
+    CONNECTIVITY_STATS& stats = m_connAlgo->Stats();
+
+    // The zone partitions are built on demand, so they are counted when asked for
+    stats.m_zoneItems = 0;
+    stats.m_zonePartitions = 0;
+    stats.m_zonePartitionBytes = 0;
+
+    for( CN_ITEM* item : m_connAlgo->ItemList() )
+    {
+        if( !item->Valid() || item->Parent()->Type() != PCB_ZONE_AREA_T )
+            continue;
+
+        size_t bytes = static_cast<CN_ZONE*>( item )->PartitionMemoryUsage();
+
+        stats.m_zoneItems++;
+
+        if( bytes )
+        {
+            stats.m_zonePartitions++;
+            stats.m_zonePartitionBytes += bytes;
+        }
+    }
+
+    return stats;
 }
 
 
@@ -216,7 +296,7 @@ void CONNECTIVITY_DATA::BlockRatsnestItems( const std::vector<BOARD_ITEM*>& aIte
 
             for( auto cnItem : entry.GetItems() )
             {
-                for( auto anchor : cnItem->Anchors() )
+                for( const auto& anchor : cnItem->Anchors() )
                     anchor->SetNoLine( true );
             }
         }
@@ -242,69 +322,220 @@ void CONNECTIVITY_DATA::FindIsolatedCopperIslands( std::vector<CN_ZONE_ISOLATED_
 }
 
 
-void CONNECTIVITY_DATA::ComputeDynamicRatsnest( const std::vector<BOARD_ITEM*>& aItems )
+/**
+ * Finds the position of an anchor of a dragged item, which can have moved since the anchor
+ * was built.  Only the anchors of pads, tracks and vias can be followed.
+ */
+static bool currentAnchorPos( const CN_ANCHOR& aAnchor, VECTOR2I& aPos )
 {
-    m_dynamicRatsnest.clear();
+    BOARD_CONNECTED_ITEM* parent = aAnchor.Parent();
 
-    if( std::none_of( aItems.begin(), aItems.end(), []( const BOARD_ITEM* aItem )
-            { return( aItem->Type() == PCB_TRACE_T || aItem->Type() == PCB_PAD_T ||
-                      aItem->Type() == PCB_ZONE_AREA_T || aItem->Type() == PCB_MODULE_T ||
-                      aItem->Type() == PCB_VIA_T ); } ) )
+    switch( parent->Type() )
     {
-        return ;
+    case PCB_PAD_T:
+        aPos = static_cast<D_PAD*>( parent )->ShapePos();
+        return true;
+
+    case PCB_VIA_T:
+        aPos = static_cast<VIA*>( parent )->GetStart();
+        return true;
+
+    case PCB_TRACE_T:
+    {
+        TRACK* track = static_cast<TRACK*>( parent );
+        bool   isStart = aAnchor.Item()->Anchors()[0].get() == &aAnchor;
+
+        aPos = isStart ? track->GetStart() : track->GetEnd();
+        return true;
     }
 
-    CONNECTIVITY_DATA connData( aItems );
-    BlockRatsnestItems( aItems );
+    default:
+        return false;
+    }
+}
+
+
+/**
+ * Finds the anchor of aAnchors (sorted by x) nearest to aPos, if it is nearer than the
+ * squared distance aDistMax, which is then updated.
+ */
+static bool findNearestAnchor( const std::vector<CN_ANCHOR_PTR>& aAnchors, const VECTOR2I& aPos,
+                               VECTOR2I::extended_type& aDistMax, CN_ANCHOR_PTR& aNearest )
+{
+    bool found = false;
 
-    for( unsigned int nc = 1; nc < connData.m_nets.size(); nc++ )
+    // Returns false when the anchors further in the same direction are all too far
+    auto test = [&]( const CN_ANCHOR_PTR& aAnchor ) -> bool
     {
-        auto dynNet = connData.m_nets[nc];
+        VECTOR2I::extended_type dx = (VECTOR2I::extended_type) aAnchor->Pos().x - aPos.x;
 
-        if( dynNet->GetNodeCount() != 0 )
+        if( dx * dx >= aDistMax )
+            return false;
+
+        auto squaredDist = ( aAnchor->Pos() - aPos ).SquaredEuclideanNorm();
+
+        if( squaredDist < aDistMax )
         {
-            auto ourNet = m_nets[nc];
-            CN_ANCHOR_PTR nodeA, nodeB;
+            found = true;
+            aDistMax = squaredDist;
+            aNearest = aAnchor;
+        }
 
-            if( ourNet->NearestBicoloredPair( *dynNet, nodeA, nodeB ) )
+        return true;
+    };
+
+    auto start = std::lower_bound( aAnchors.begin(), aAnchors.end(), aPos.x,
+            []( const CN_ANCHOR_PTR& aAnchor, int aX )
             {
-                RN_DYNAMIC_LINE l;
-                l.a = nodeA->Pos();
-                l.b = nodeB->Pos();
-                l.netCode = nc;
+                return aAnchor->Pos().x < aX;
+            } );
 
-                m_dynamicRatsnest.push_back( l );
-            }
+    for( auto it = start; it != aAnchors.end() && test( *it ); ++it )
+        ;
+
+    for( auto it = start; it != aAnchors.begin() && test( *( it - 1 ) ); --it )
+        ;
+
+    return found;
+}
+
+
+void CONNECTIVITY_DATA::buildDynamicRatsnest( const std::vector<BOARD_ITEM*>& aItems )
+{
+    m_dynamicData.reset( new DYNAMIC_RATSNEST );
+
+    DYNAMIC_RATSNEST& data = *m_dynamicData;
+    data.m_items = aItems;
+    data.m_connData.reset( new CONNECTIVITY_DATA( aItems ) );
+    data.m_canFollow = true;
+
+    BlockRatsnestItems( aItems );
+
+    const std::vector<RN_NET*>& dynNets = data.m_connData->m_nets;
+
+    for( unsigned int nc = 1; nc < dynNets.size(); nc++ )
+    {
+        RN_NET* dynNet = dynNets[nc];
+
+        if( dynNet->GetNodeCount() == 0 )
+            continue;
+
+        for( const CN_ANCHOR_PTR& anchor : dynNet->GetAllNodes() )
+        {
+            VECTOR2I pos;
+
+            if( !currentAnchorPos( *anchor, pos ) )
+                data.m_canFollow = false;
         }
+
+        if( nc >= m_nets.size() )
+            continue;
+
+        DYNAMIC_RATSNEST::NET net;
+        net.m_netCode = nc;
+        net.m_movedAnchors = dynNet->GetAllNodes();
+
+        for( const CN_ANCHOR_PTR& anchor : m_nets[nc]->GetAllNodes() )
+        {
+            if( !anchor->GetNoLine() )
+                net.m_staticAnchors.push_back( anchor );
+        }
+
+        std::sort( net.m_staticAnchors.begin(), net.m_staticAnchors.end(),
+                []( const CN_ANCHOR_PTR& aA, const CN_ANCHOR_PTR& aB )
+                {
+                    return aA->Pos().x < aB->Pos().x;
+                } );
+
+        data.m_nets.push_back( std::move( net ) );
     }
 
-    for( auto net : connData.m_nets )
+    for( RN_NET* net : dynNets )
     {
         if( !net )
             continue;
 
-        const auto& edges = net->GetUnconnected();
+        for( const CN_EDGE& edge : net->GetUnconnected() )
+            data.m_edges.push_back( edge );
+    }
+}
 
-        if( edges.empty() )
-            continue;
 
-        for( const auto& edge : edges )
+void CONNECTIVITY_DATA::ComputeDynamicRatsnest( const std::vector<BOARD_ITEM*>& aItems )
+{
+    m_dynamicRatsnest.clear();
+
+    if( std::none_of( aItems.begin(), aItems.end(), []( const BOARD_ITEM* aItem )
+            { return( aItem->Type() == PCB_TRACE_T || aItem->Type() == PCB_PAD_T ||
+                      aItem->Type() == PCB_ZONE_AREA_T || aItem->Type() == PCB_MODULE_T ||
+                      aItem->Type() == PCB_VIA_T ); } ) )
+    {
+        return ;
+    }
+
+    // The data is reused while the same items are dragged, unless their anchors cannot be
+    // followed (zones): it is then built again at the new position
+    if( !m_dynamicData || m_dynamicData->m_items != aItems || !m_dynamicData->m_canFollow )
+        buildDynamicRatsnest( aItems );
+
+    const DYNAMIC_RATSNEST& data = *m_dynamicData;
+
+    auto anchorPos = [&data]( const CN_ANCHOR_PTR& aAnchor )
+    {
+        VECTOR2I pos = aAnchor->Pos();
+
+        if( data.m_canFollow )
+            currentAnchorPos( *aAnchor, pos );
+
+        return pos;
+    };
+
+    // Only the links from the dragged anchors to the nearest other anchor of their net
+    // are searched again
+    for( const DYNAMIC_RATSNEST::NET& net : data.m_nets )
+    {
+        VECTOR2I::extended_type distMax = VECTOR2I::ECOORD_MAX;
+        CN_ANCHOR_PTR           nodeA;
+        VECTOR2I                posB;
+        bool                    found = false;
+
+        for( const CN_ANCHOR_PTR& moved : net.m_movedAnchors )
         {
-            const auto& nodeA   = edge.GetSourceNode();
-            const auto& nodeB   = edge.GetTargetNode();
-            RN_DYNAMIC_LINE l;
+            VECTOR2I pos = anchorPos( moved );
+
+            if( findNearestAnchor( net.m_staticAnchors, pos, distMax, nodeA ) )
+            {
+                posB = pos;
+                found = true;
+            }
+        }
 
+        if( found )
+        {
+            RN_DYNAMIC_LINE l;
             l.a = nodeA->Pos();
-            l.b = nodeB->Pos();
-            l.netCode = 0;
+            l.b = posB;
+            l.netCode = net.m_netCode;
+
             m_dynamicRatsnest.push_back( l );
         }
     }
+
+    for( const CN_EDGE& edge : data.m_edges )
+    {
+        RN_DYNAMIC_LINE l;
+
+        l.a = anchorPos( edge.GetSourceNode() );
+        l.b = anchorPos( edge.GetTargetNode() );
+        l.netCode = 0;
+        m_dynamicRatsnest.push_back( l );
+    }
 }
 
 
 void CONNECTIVITY_DATA::ClearDynamicRatsnest()
 {
+    m_dynamicData.reset();
     m_connAlgo->ForEachAnchor( [] ( CN_ANCHOR& anchor ) { anchor.SetNoLine( false ); } );
     HideDynamicRatsnest();
 }
@@ -326,6 +557,8 @@ unsigned int CONNECTIVITY_DATA::GetUnconnectedCount() const
 {
     unsigned int unconnected = 0;
 
+    updateRatsnest();
+
     for( auto net : m_nets )
     {
         if( !net )
@@ -380,40 +613,106 @@ const std::vector<BOARD_CONNECTED_ITEM*> CONNECTIVITY_DATA::GetConnectedItems(
 }
 
 
+///> @return true if aItem is of one of aTypes, or if aTypes is nullptr
+static bool isOfType( const BOARD_ITEM* aItem, const KICAD_T aTypes[] )
+{
+    if( !aTypes )
+        return true;
+
+    for( int i = 0; aTypes[i] > 0; ++i )
+    {
+        wxASSERT( aTypes[i] < MAX_STRUCT_TYPE_ID );
+
+        if( aItem->Type() == aTypes[i] )
+            return true;
+    }
+
+    return false;
+}
+
+
 const std::vector<BOARD_CONNECTED_ITEM*> CONNECTIVITY_DATA::GetNetItems( int aNetCode,
         const KICAD_T aTypes[] ) const
 {
-    std::set<BOARD_CONNECTED_ITEM*> items;
+    std::unordered_set<BOARD_CONNECTED_ITEM*> found;
     std::vector<BOARD_CONNECTED_ITEM*> rv;
 
-    m_connAlgo->ForEachItem( [&items, aNetCode, &aTypes] ( CN_ITEM& aItem )
+    // A zone holds an item for each filled area
+    for( CN_ITEM* item : m_connAlgo->NetItems( aNetCode ) )
     {
-        if( aItem.Valid() && ( aItem.Net() == aNetCode ) )
-        {
-            KICAD_T itemType = aItem.Parent()->Type();
+        if( isOfType( item->Parent(), aTypes ) && found.insert( item->Parent() ).second )
+            rv.push_back( item->Parent() );
+    }
 
-            for( int i = 0; aTypes[i] > 0; ++i )
-            {
-                wxASSERT( aTypes[i] < MAX_STRUCT_TYPE_ID );
+    return rv;
+}
 
-                if( itemType == aTypes[i] )
-                {
-                    items.insert( aItem.Parent() );
-                    break;
-                }
-            }
-        }
-    } );
 
-    std::copy( items.begin(), items.end(), std::back_inserter( rv ) );
+const std::vector<BOARD_CONNECTED_ITEM*> CONNECTIVITY_DATA::GetItemsAt( const VECTOR2I& aPosition,
+        PCB_LAYER_ID aLayer, const KICAD_T aTypes[] ) const
+{
+    std::vector<BOARD_CONNECTED_ITEM*> rv;
+    wxPoint pos( aPosition.x, aPosition.y );
+
+    auto visitor = [&]( CN_ITEM* aItem )
+    {
+        BOARD_CONNECTED_ITEM* parent = aItem->Parent();
+
+        if( !aItem->Valid() || !isOfType( parent, aTypes ) )
+            return true;
+
+        bool hit;
+
+        if( parent->Type() == PCB_ZONE_AREA_T )
+            hit = static_cast<CN_ZONE*>( aItem )->ContainsPoint( aPosition );
+        else
+            hit = parent->IsOnLayer( aLayer ) && parent->HitTest( pos );
+
+        if( hit && std::find( rv.begin(), rv.end(), parent ) == rv.end() )
+            rv.push_back( parent );
+
+        return true;
+    };
+
+    m_connAlgo->ItemList().FindInArea( BOX2I( aPosition, VECTOR2I( 0, 0 ) ),
+                                       LAYER_RANGE( aLayer, aLayer ), visitor );
 
     return rv;
 }
 
 
+D_PAD* CONNECTIVITY_DATA::GetPadAt( const VECTOR2I& aPosition, LSET aLayers ) const
+{
+    D_PAD*  found = nullptr;
+    wxPoint pos( aPosition.x, aPosition.y );
+
+    auto visitor = [&]( CN_ITEM* aItem )
+    {
+        BOARD_CONNECTED_ITEM* parent = aItem->Parent();
+
+        if( !aItem->Valid() || parent->Type() != PCB_PAD_T )
+            return true;
+
+        if( ( parent->GetLayerSet() & aLayers ).any() && parent->HitTest( pos ) )
+        {
+            found = static_cast<D_PAD*>( parent );
+            return false;
+        }
+
+        return true;
+    };
+
+    m_connAlgo->ItemList().FindInArea( BOX2I( aPosition, VECTOR2I( 0, 0 ) ),
+                                       LAYER_RANGE( F_Cu, B_Cu ), visitor );
+
+    return found;
+}
+
+
 bool CONNECTIVITY_DATA::CheckConnectivity( std::vector<CN_DISJOINT_NET_ENTRY>& aReport )
 {
     RecalculateRatsnest();
+    updateRatsnest();
 
     for( auto net : m_nets )
     {
@@ -561,7 +860,7 @@ const std::vector<VECTOR2I> CONNECTIVITY_DATA::NearestUnconnectedTargets(
                 if( item->Valid() && item->Parent()->GetNetCode() == refNet
                     && item->Parent()->Type() != PCB_ZONE_AREA_T )
                 {
-                    for( auto anchor : item->Anchors() )
+                    for( const auto& anchor : item->Anchors() )
                     {
                         anchors.insert( anchor->Pos() );
                     }
@@ -588,6 +887,8 @@ const std::vector<VECTOR2I> CONNECTIVITY_DATA::NearestUnconnectedTargets(
 
 void CONNECTIVITY_DATA::GetUnconnectedEdges( std::vector<CN_EDGE>& aEdges) const
 {
+    updateRatsnest();
+
     for( auto rnNet : m_nets )
     {
         if( rnNet )
@@ -609,7 +910,7 @@ const std::vector<BOARD_CONNECTED_ITEM*> CONNECTIVITY_DATA::GetConnectedItems(
 
     for( auto cnItem : entry.GetItems() )
     {
-        for( auto anchor : cnItem->Anchors() )
+        for( const auto& anchor : cnItem->Anchors() )
         {
             if( anchor->Pos() == aAnchor )
             {
@@ -29,6 +29,7 @@
 
 #include <core/typeinfo.h>
 
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -76,6 +77,31 @@ struct RN_DYNAMIC_LINE
     VECTOR2I a, b;
 };
 
+/**
+ * Timings and sizes of the last run of each step of the connectivity update, so that
+ * slow updates can be reported with real numbers.
+ */
+struct CONNECTIVITY_STATS
+{
+    typedef std::chrono::microseconds DURATION;
+
+    DURATION m_build { 0 };                 ///< adding the items of the board
+    DURATION m_searchConnections { 0 };     ///< finding the connections of the dirty items
+    DURATION m_searchClusters { 0 };
+    DURATION m_propagateNets { 0 };
+    DURATION m_recalculateRatsnest { 0 };   ///< the whole update, ratsnest included
+    DURATION m_updateRatsnest { 0 };        ///< computing the ratsnest of the dirty nets
+
+    int m_items = 0;
+    int m_dirtyItems = 0;                   ///< items searched by searchConnections
+    int m_clusters = 0;                     ///< clusters found by the last search
+    int m_ratsnestNets = 0;                 ///< nets whose ratsnest was computed
+
+    int    m_zoneItems = 0;                 ///< filled polygons of the zones
+    int    m_zonePartitions = 0;            ///< hit test partitions built for them
+    size_t m_zonePartitionBytes = 0;
+};
+
 // a wrapper class encompassing the connectivity computation algorithm and the
 class CONNECTIVITY_DATA
 {
@@ -158,11 +184,18 @@ public:
 
     /**
      * Function RecalculateRatsnest()
-     * Updates the ratsnest for the board.
+     * Updates the ratsnest for the board.  With the LazyRatsnest advanced setting, the
+     * changed nets are only marked dirty, and computed when they are read.
      * @param aCommit is used to save the undo state of items modified by this call
      */
     void RecalculateRatsnest( BOARD_COMMIT* aCommit = nullptr );
 
+    /**
+     * Function UpdateRatsnest()
+     * Computes the dirty ratsnest of the nets in aNets, on several threads.
+     */
+    void UpdateRatsnest( const std::vector<int>& aNets );
+
     /**
      * Function GetUnconnectedCount()
      * Returns the number of remaining edges in the ratsnest.
@@ -198,7 +231,8 @@ public:
     /**
      * Function ComputeDynamicRatsnest()
      * Calculates the temporary dynamic ratsnest (i.e. the ratsnest lines that)
-     * for the set of items aItems.
+     * for the set of items aItems.  While the same items are dragged, only the links
+     * from their anchors to the nearest anchors of the other items are searched again.
      */
     void ComputeDynamicRatsnest( const std::vector<BOARD_ITEM*>& aItems );
 
@@ -220,10 +254,30 @@ public:
      * Function GetNetItems()
      * Returns the list of items that belong to a certain net.
      * @param aNetCode is the net code.
-     * @param aTypes allows one to filter by item types.
+     * @param aTypes allows one to filter by item types (nullptr for all the types).
      */
     const std::vector<BOARD_CONNECTED_ITEM*> GetNetItems( int aNetCode,
-            const KICAD_T aTypes[] ) const;
+            const KICAD_T aTypes[] = nullptr ) const;
+
+    /**
+     * Function GetItemsAt()
+     * Returns the items found at a point of a layer: the tracks, vias and pads whose shape
+     * holds the point, and the zones whose fill holds it.  The items are looked up in the
+     * spatial index of the connectivity.
+     * @param aPosition is the point to test.
+     * @param aLayer is the copper layer to test.
+     * @param aTypes allows one to filter by item types (nullptr for all the types).
+     */
+    const std::vector<BOARD_CONNECTED_ITEM*> GetItemsAt( const VECTOR2I& aPosition,
+            PCB_LAYER_ID aLayer, const KICAD_T aTypes[] = nullptr ) const;
+
+    /**
+     * Function GetPadAt()
+     * Returns a pad whose shape holds a point, and which is on one of aLayers, or nullptr.
+     * The pads are looked up in the spatial index of the connectivity, which holds only
+     * the pads on copper layers.
+     */
+    D_PAD* GetPadAt( const VECTOR2I& aPosition, LSET aLayers ) const;
 
     const std::vector<VECTOR2I> NearestUnconnectedTargets( const BOARD_CONNECTED_ITEM* aRef,
             const VECTOR2I& aPos,
@@ -231,6 +285,10 @@ public:
 
     void BlockRatsnestItems( const std::vector<BOARD_ITEM*>& aItems );
 
+    ///> Returns the profiling data of the last connectivity update, and the current
+    ///> memory used by the zone partitions
+    const CONNECTIVITY_STATS& GetStats() const;
+
     std::shared_ptr<CN_CONNECTIVITY_ALGO> GetConnectivityAlgo() const
     {
         return m_connAlgo;
@@ -250,12 +308,19 @@ public:
 
 private:
 
-    void    updateRatsnest();
+    ///> Computes the ratsnest of all the dirty nets
+    void    updateRatsnest() const;
     void    addRatsnestCluster( const std::shared_ptr<CN_CLUSTER>& aCluster );
 
+    ///> Builds the dynamic ratsnest data kept while the items aItems are dragged
+    void    buildDynamicRatsnest( const std::vector<BOARD_ITEM*>& aItems );
+
+    struct DYNAMIC_RATSNEST;
+
     std::shared_ptr<CN_CONNECTIVITY_ALGO> m_connAlgo;
 
     std::vector<RN_DYNAMIC_LINE> m_dynamicRatsnest;
+    std::unique_ptr<DYNAMIC_RATSNEST> m_dynamicData;
     std::vector<RN_NET*> m_nets;
 
     PROGRESS_REPORTER* m_progressReporter;
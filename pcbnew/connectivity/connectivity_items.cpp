@@ -85,15 +85,31 @@ void CN_ITEM::Dump()
 }
 
 
+void CN_ITEM::SetAnchors( const std::vector<VECTOR2I>& aPositions )
+{
+    // The anchor pointers share the ownership of the block, so the anchors kept by the
+    // ratsnest stay valid as long as one of them is used
+    auto block = std::make_shared<std::vector<CN_ANCHOR>>();
+
+    block->reserve( aPositions.size() );
+
+    for( const VECTOR2I& pos : aPositions )
+        block->emplace_back( pos, this );
+
+    m_anchors.clear();
+    m_anchors.reserve( block->size() );
+
+    for( CN_ANCHOR& anchor : *block )
+        m_anchors.emplace_back( block, &anchor );
+}
+
+
 int CN_ZONE::AnchorCount() const
 {
     if( !Valid() )
         return 0;
 
-    const auto zone = static_cast<const ZONE_CONTAINER*>( Parent() );
-    const auto& outline = zone->GetFilledPolysList().COutline( m_subpolyIndex );
-
-    return outline.PointCount() ? 1 : 0;
+    return Outline().PointCount() ? 1 : 0;
 }
 
 
@@ -102,10 +118,32 @@ const VECTOR2I CN_ZONE::GetAnchor( int n ) const
     if( !Valid() )
         return VECTOR2I();
 
-    const auto zone = static_cast<const ZONE_CONTAINER*> ( Parent() );
-    const auto& outline = zone->GetFilledPolysList().COutline( m_subpolyIndex );
+    return Outline().CPoint( 0 );
+}
+
 
-    return outline.CPoint( 0 );
+POLY_GRID_PARTITION& CN_ZONE::partition() const
+{
+    // The zones are hit tested by several threads during the connection search
+    std::call_once( m_partitionBuilt, [this]()
+            {
+                const SHAPE_LINE_CHAIN& outline = Outline();
+
+                // The filled polygons are closed, and are only referred to
+                if( outline.IsClosed() )
+                    m_cachedPoly.reset( new POLY_GRID_PARTITION( &outline, 16 ) );
+                else
+                    m_cachedPoly.reset( new POLY_GRID_PARTITION( outline, 16 ) );
+            } );
+
+    return *m_cachedPoly;
+}
+
+
+size_t CN_ZONE::PartitionMemoryUsage() const
+{
+    // Not synchronized with partition(): only call it while no connection search runs
+    return m_cachedPoly ? m_cachedPoly->MemoryUsage() : 0;
 }
 
 
@@ -127,7 +165,7 @@ CN_ITEM* CN_LIST::Add( D_PAD* pad )
          return nullptr;
 
      auto item = new CN_ITEM( pad, false, 1 );
-     item->AddAnchor( pad->ShapePos() );
+     item->SetAnchors( { pad->ShapePos() } );
      item->SetLayers( LAYER_RANGE( F_Cu, B_Cu ) );
 
      switch( pad->GetAttribute() )
@@ -162,8 +200,7 @@ CN_ITEM* CN_LIST::Add( D_PAD* pad )
  {
      auto item = new CN_ITEM( track, true );
      m_items.push_back( item );
-     item->AddAnchor( track->GetStart() );
-     item->AddAnchor( track->GetEnd() );
+     item->SetAnchors( { track->GetStart(), track->GetEnd() } );
      item->SetLayer( track->GetLayer() );
      addItemtoTree( item );
      SetDirty();
@@ -175,7 +212,7 @@ CN_ITEM* CN_LIST::Add( D_PAD* pad )
      auto item = new CN_ITEM( via, true, 1 );
 
      m_items.push_back( item );
-     item->AddAnchor( via->GetStart() );
+     item->SetAnchors( { via->GetStart() } );
      item->SetLayers( LAYER_RANGE( F_Cu, B_Cu ) );
      addItemtoTree( item );
      SetDirty();
@@ -191,10 +228,15 @@ CN_ITEM* CN_LIST::Add( D_PAD* pad )
      for( int j = 0; j < polys.OutlineCount(); j++ )
      {
          CN_ZONE* zitem = new CN_ZONE( zone, false, j );
-         const auto& outline = zone->GetFilledPolysList().COutline( j );
+         const auto& outline = zitem->Outline();
+         std::vector<VECTOR2I> anchors;
+
+         anchors.reserve( outline.PointCount() );
 
          for( int k = 0; k < outline.PointCount(); k++ )
-             zitem->AddAnchor( outline.CPoint( k ) );
+             anchors.push_back( outline.CPoint( k ) );
+
+         zitem->SetAnchors( anchors );
 
          m_items.push_back( zitem );
          zitem->SetLayer( zone->GetLayer() );
@@ -109,7 +109,7 @@ public:
         m_cluster = aCluster;
     }
 
-    inline std::shared_ptr<CN_CLUSTER> GetCluster() const
+    inline const std::shared_ptr<CN_CLUSTER>& GetCluster() const
     {
         return m_cluster;
     }
@@ -201,16 +201,17 @@ public:
         m_visited = false;
         m_valid = true;
         m_dirty = true;
-        m_anchors.reserve( 2 );
+        m_anchors.reserve( aAnchorCount );
         m_layers = LAYER_RANGE( 0, PCB_LAYER_ID_COUNT );
     }
 
     virtual ~CN_ITEM() {};
 
-    void AddAnchor( const VECTOR2I& aPos )
-    {
-        m_anchors.emplace_back( std::make_unique<CN_ANCHOR>( aPos, this ) );
-    }
+    /**
+     * Sets the anchors of the item.  They are stored in a single block, shared by all the
+     * anchor pointers of the item, instead of being allocated one by one.
+     */
+    void SetAnchors( const std::vector<VECTOR2I>& aPositions );
 
     CN_ANCHORS& Anchors()
     {
@@ -333,19 +334,21 @@ public:
 
 typedef std::shared_ptr<CN_ITEM> CN_ITEM_PTR;
 
+/**
+ * Class CN_ZONE
+ * A filled polygon of a zone.  The filled polygons are shared with the zone, so that the
+ * connectivity still sees the fill it was built for after the zone is refilled.  The grid
+ * partition used to hit test the polygon is built on the first test.
+ */
 class CN_ZONE : public CN_ITEM
 {
 public:
     CN_ZONE( ZONE_CONTAINER* aParent, bool aCanChangeNet, int aSubpolyIndex ) :
         CN_ITEM( aParent, aCanChangeNet ),
+        m_fill( aParent->GetSharedFilledPolysList() ),
         m_subpolyIndex( aSubpolyIndex )
     {
-        SHAPE_LINE_CHAIN outline = aParent->GetFilledPolysList().COutline( aSubpolyIndex );
-
-        outline.SetClosed( true );
-        outline.Simplify();
-
-        m_cachedPoly.reset( new POLY_GRID_PARTITION( outline, 16 ) );
+        m_bbox = Outline().BBox();
     }
 
     int SubpolyIndex() const
@@ -353,6 +356,11 @@ public:
         return m_subpolyIndex;
     }
 
+    const SHAPE_LINE_CHAIN& Outline() const
+    {
+        return m_fill->COutline( m_subpolyIndex );
+    }
+
     bool ContainsAnchor( const CN_ANCHOR_PTR anchor ) const
     {
         return ContainsPoint( anchor->Pos() );
@@ -362,23 +370,27 @@ public:
     {
         auto zone = static_cast<ZONE_CONTAINER*> ( Parent() );
         int clearance = zone->GetFilledPolysUseThickness() ? zone->GetMinThickness() : 0;
-        return m_cachedPoly->ContainsPoint( p, clearance );
+        return partition().ContainsPoint( p, clearance );
     }
 
     const BOX2I& BBox()
     {
-        if( m_dirty )
-            m_bbox = m_cachedPoly->BBox();
-
         return m_bbox;
     }
 
     virtual int             AnchorCount() const override;
     virtual const VECTOR2I  GetAnchor( int n ) const override;
 
+    ///> Returns the memory used by the hit test partition, 0 if it is not built yet
+    size_t PartitionMemoryUsage() const;
+
 private:
-    std::vector<VECTOR2I> m_testOutlinePoints;
-    std::unique_ptr<POLY_GRID_PARTITION> m_cachedPoly;
+    ///> Returns the hit test partition, building it if needed.  Thread safe.
+    POLY_GRID_PARTITION& partition() const;
+
+    std::shared_ptr<const SHAPE_POLY_SET>        m_fill;
+    mutable std::unique_ptr<POLY_GRID_PARTITION> m_cachedPoly;
+    mutable std::once_flag                       m_partitionBuilt;
     int m_subpolyIndex;
 };
 
@@ -387,6 +399,7 @@ class CN_LIST
 private:
     bool m_dirty;
     bool m_hasInvalid;
+    bool m_deferIndex;
 
     CN_RTREE<CN_ITEM*> m_index;
 
@@ -395,7 +408,8 @@ protected:
 
     void addItemtoTree( CN_ITEM* item )
     {
-        m_index.Insert( item );
+        if( !m_deferIndex )
+            m_index.Insert( item );
     }
 
 public:
@@ -403,6 +417,23 @@ public:
     {
         m_dirty = false;
         m_hasInvalid = false;
+        m_deferIndex = false;
+    }
+
+    /**
+     * Items added between BeginBulkAdd() and EndBulkAdd() are indexed all at once
+     * by EndBulkAdd(), which is much faster than indexing them one by one.  They cannot
+     * be found by FindNearby() in between.
+     */
+    void BeginBulkAdd()
+    {
+        m_deferIndex = true;
+    }
+
+    void EndBulkAdd()
+    {
+        m_deferIndex = false;
+        m_index.BulkLoad( m_items );
     }
 
     void Clear()
@@ -427,6 +458,13 @@ public:
         m_index.Query( aItem->BBox(), aItem->Layers(), aFunc );
     }
 
+    ///> Calls aFunc for each item whose bounding box intersects aArea on aLayers
+    template <class T>
+    void FindInArea( const BOX2I& aArea, const LAYER_RANGE& aLayers, T aFunc )
+    {
+        m_index.Query( aArea, aLayers, aFunc );
+    }
+
     void SetHasInvalid( bool aInvalid = true )
     {
         m_hasInvalid = aInvalid;
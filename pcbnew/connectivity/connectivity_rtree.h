@@ -29,6 +29,8 @@
 
 #include <geometry/rtree.h>
 
+#include <vector>
+
 
 /**
  * Class CN_RTREE -
@@ -65,6 +67,27 @@ public:
         m_tree->Insert( mmin, mmax, aItem );
     }
 
+    /**
+     * Function BulkLoad()
+     * Replaces the contents of the tree by aItems.  Packing all the items at once is much
+     * faster than inserting them one by one, and gives a better balanced tree.
+     */
+    void BulkLoad( const std::vector<T>& aItems )
+    {
+        m_tree->BulkLoad( aItems, []( T aItem, int* aMin, int* aMax )
+                {
+                    const BOX2I&        bbox    = aItem->BBox();
+                    const LAYER_RANGE   layers  = aItem->Layers();
+
+                    aMin[0] = layers.Start();
+                    aMin[1] = bbox.GetX();
+                    aMin[2] = bbox.GetY();
+                    aMax[0] = layers.End();
+                    aMax[1] = bbox.GetRight();
+                    aMax[2] = bbox.GetBottom();
+                } );
+    }
+
     /**
      * Function Remove()
      * Removes an item from the tree. Removal is done by comparing pointers, attempting
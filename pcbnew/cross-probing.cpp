@@ -57,6 +57,7 @@
  * Commands are
  * $PART: "reference"   put cursor on component
  * $PIN: "pin name"  $PART: "reference" put cursor on the footprint pin
+ * $PARTS: "reference,reference,..." select the footprints (references separated as by wxJoin)
  * $NET: "net name" highlight the given net (if highlight tool is active)
  * $CLEAR Clear existing highlight
  * They are a keyword followed by a quoted string.
@@ -73,6 +74,8 @@ void PCB_EDIT_FRAME::ExecuteRemoteCommand( const char* cmdline )
     D_PAD*      pad = NULL;
     BOARD*      pcb = GetBoard();
 
+    std::vector<BOARD_ITEM*> modules;   // footprints of a $PARTS: command
+
     KIGFX::VIEW*            view = m_toolManager->GetView();
     KIGFX::RENDER_SETTINGS* renderSettings = view->GetPainter()->GetSettings();
 
@@ -143,6 +146,30 @@ void PCB_EDIT_FRAME::ExecuteRemoteCommand( const char* cmdline )
 
         SetStatusText( msg );
     }
+    else if( strcmp( idcmd, "$PARTS:" ) == 0 )
+    {
+        pcb->ResetNetHighLight();
+
+        // The list can be longer than line: read it from the whole command
+        const char* first = strchr( cmdline, '"' );
+        const char* last = strrchr( cmdline, '"' );
+
+        if( !first || last <= first )
+            return;
+
+        wxArrayString references = wxSplit( FROM_UTF8( std::string( first + 1, last ).c_str() ),
+                                            ',' );
+
+        for( const wxString& reference : references )
+        {
+            if( MODULE* found = pcb->FindModuleByReference( reference ) )
+                modules.push_back( found );
+        }
+
+        msg.Printf( _( "%d of %d footprints found" ), (int) modules.size(),
+                    (int) references.size() );
+        SetStatusText( msg );
+    }
     else if( strcmp( idcmd, "$SHEET:" ) == 0 )
     {
         msg.Printf( _( "Selecting all from sheet \"%s\"" ), FROM_UTF8( text ) );
@@ -166,7 +193,15 @@ void PCB_EDIT_FRAME::ExecuteRemoteCommand( const char* cmdline )
 
     BOX2I bbox = { { 0, 0 }, { 0, 0 } };
 
-    if( module )
+    if( !modules.empty() )
+    {
+        m_toolManager->RunAction( PCB_ACTIONS::highlightItems, true, (void*) &modules );
+        bbox = modules[0]->GetBoundingBox();
+
+        for( BOARD_ITEM* found : modules )
+            bbox.Merge( found->GetBoundingBox() );
+    }
+    else if( module )
     {
         m_toolManager->RunAction( PCB_ACTIONS::highlightItem, true, (void*) module );
         bbox = module->GetBoundingBox();
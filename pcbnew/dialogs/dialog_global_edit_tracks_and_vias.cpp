@@ -289,6 +289,7 @@ void DIALOG_GLOBAL_EDIT_TRACKS_AND_VIAS::processItem( PICKED_ITEMS_LIST* aUndoLi
             }
 
             aItem->SetLayer( ToLAYER_ID( m_layerBox->GetLayerSelection() ) );
+            aItem->InvalidateHash();
             m_parent->GetBoard()->GetConnectivity()->Update( aItem );
         }
     }
@@ -340,10 +341,17 @@ bool DIALOG_GLOBAL_EDIT_TRACKS_AND_VIAS::TransferDataFromWindow()
 
     if( itemsListPicker.GetCount() > 0 )
     {
-        m_parent->SaveCopyInUndoList( itemsListPicker, UR_CHANGED );
+        // Only the changed items are updated, and indexed again all at once
+        KIGFX::VIEW* view = m_parent->GetCanvas()->GetView();
+
+        view->BeginBulkUpdate();
+
+        for( unsigned ii = 0; ii < itemsListPicker.GetCount(); ++ii )
+            view->Update( itemsListPicker.GetPickedItem( ii ) );
 
-        for( auto segment : m_brd->Tracks() )
-            m_parent->GetCanvas()->GetView()->Update( segment );
+        view->EndBulkUpdate();
+
+        m_parent->SaveCopyInUndoList( itemsListPicker, UR_CHANGED );
     }
 
     return !m_failedDRC;
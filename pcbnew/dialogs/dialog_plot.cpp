@@ -813,6 +813,8 @@ void DIALOG_PLOT::Plot( wxCommandEvent& event )
 
     wxBusyCursor dummy;
 
+    std::vector<PLOT_LAYER_JOB> jobs;
+
     for( LSEQ seq = m_plotOpts.GetLayerSelection().UIOrder();  seq;  ++seq )
     {
         PCB_LAYER_ID layer = *seq;
@@ -838,25 +840,29 @@ void DIALOG_PLOT::Plot( wxCommandEvent& event )
         wxString fullname = fn.GetFullName();
         jobfile_writer.AddGbrFile( layer, fullname );
 
-        LOCALE_IO toggle;
+        PLOT_LAYER_JOB job;
+        job.m_Layer = layer;
+        job.m_FileName = fn.GetFullPath();
+        job.m_Success = false;
+        jobs.push_back( job );
+    }
 
-        PLOTTER*    plotter = StartPlotBoard( board, &m_plotOpts, layer, fn.GetFullPath(), wxEmptyString );
+    // The layers are independent, and are plotted at once
+    PlotBoardLayers( board, m_plotOpts, jobs );
 
-        // Print diags in messages box:
+    // Print diags in messages box:
+    for( const PLOT_LAYER_JOB& job : jobs )
+    {
         wxString msg;
 
-        if( plotter )
+        if( job.m_Success )
         {
-            PlotOneBoardLayer( board, plotter, layer, m_plotOpts );
-            plotter->EndPlot();
-            delete plotter;
-
-            msg.Printf( _( "Plot file \"%s\" created." ), GetChars( fn.GetFullPath() ) );
+            msg.Printf( _( "Plot file \"%s\" created." ), GetChars( job.m_FileName ) );
             reporter.Report( msg, REPORTER::RPT_ACTION );
         }
         else
         {
-            msg.Printf( _( "Unable to create file \"%s\"." ), GetChars( fn.GetFullPath() ) );
+            msg.Printf( _( "Unable to create file \"%s\"." ), GetChars( job.m_FileName ) );
             reporter.Report( msg, REPORTER::RPT_ERROR );
         }
     }
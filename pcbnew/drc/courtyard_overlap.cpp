@@ -34,6 +34,11 @@
 #include <tools/drc.h>
 
 #include <drc/drc_marker_factory.h>
+#include <advanced_config.h>
+#include <thread_pool.h>
+
+#include <algorithm>
+#include <numeric>
 
 
 /**
@@ -96,80 +101,112 @@ bool DRC_COURTYARD_OVERLAP::RunDRC( BOARD& aBoard ) const
 
     wxLogTrace( DRC_COURTYARD_TRACE, "Checking for courtyard overlap" );
 
-    // Now test for overlapping on top layer:
-    SHAPE_POLY_SET courtyard; // temporary storage of the courtyard of current footprint
+    // Test for overlapping on top layer, then on bottom layer
+    if( !testOverlaps( aBoard, true ) )
+        success = false;
+
+    if( !testOverlaps( aBoard, false ) )
+        success = false;
+
+    return success;
+}
+
 
-    for( auto it1 = aBoard.Modules().begin(); it1 != aBoard.Modules().end(); it1++ )
+bool DRC_COURTYARD_OVERLAP::testOverlaps( BOARD& aBoard, bool aFront ) const
+{
+    struct COURTYARD
     {
-        auto footprint = *it1;
+        MODULE*               m_footprint;
+        const SHAPE_POLY_SET* m_poly;
+        BOX2I                 m_bbox;
+    };
 
-        if( footprint->GetPolyCourtyardFront().OutlineCount() == 0 )
-            continue; // No courtyard defined
+    // The footprints which have a courtyard on this side, in board order
+    std::vector<COURTYARD> courtyards;
 
-        for( auto it2 = it1 + 1; it2 != aBoard.Modules().end(); it2++ )
-        {
-            auto candidate = *it2;
+    for( auto footprint : aBoard.Modules() )
+    {
+        SHAPE_POLY_SET& poly = aFront ? footprint->GetPolyCourtyardFront()
+                                      : footprint->GetPolyCourtyardBack();
 
-            if( candidate->GetPolyCourtyardFront().OutlineCount() == 0 )
-                continue; // No courtyard defined
+        if( poly.OutlineCount() == 0 )
+            continue; // No courtyard defined
 
-            courtyard.RemoveAllContours();
-            courtyard.Append( footprint->GetPolyCourtyardFront() );
+        courtyards.push_back( { footprint, &poly, poly.BBox() } );
+    }
 
-            // Build the common area between footprint and the candidate:
-            courtyard.BooleanIntersection(
-                    candidate->GetPolyCourtyardFront(), SHAPE_POLY_SET::PM_FAST );
+    // Courtyards can only overlap if their bounding boxes do: sweep the courtyards
+    // sorted by their left edge to find these pairs
+    std::vector<size_t> byLeft( courtyards.size() );
+    std::iota( byLeft.begin(), byLeft.end(), 0 );
 
-            // If no overlap, courtyard is empty (no common area).
-            // Therefore if a common polygon exists, this is a DRC error
-            if( courtyard.OutlineCount() )
+    std::sort( byLeft.begin(), byLeft.end(),
+            [&]( size_t a, size_t b )
             {
-                //Overlap between footprint and candidate
-                VECTOR2I& pos = courtyard.Vertex( 0, 0, -1 );
-                auto      marker = std::unique_ptr<MARKER_PCB>(
-                        marker_factory.NewMarker( wxPoint( pos.x, pos.y ), footprint, candidate,
-                                DRCE_OVERLAPPING_FOOTPRINTS ) );
-                HandleMarker( std::move( marker ) );
-                success = false;
-            }
+                return courtyards[a].m_bbox.GetLeft() < courtyards[b].m_bbox.GetLeft();
+            } );
+
+    std::vector<std::pair<size_t, size_t>> pairs;
+
+    for( size_t ii = 0; ii < byLeft.size(); ++ii )
+    {
+        const BOX2I& bbox = courtyards[ byLeft[ii] ].m_bbox;
+
+        for( size_t jj = ii + 1; jj < byLeft.size(); ++jj )
+        {
+            const BOX2I& candidate = courtyards[ byLeft[jj] ].m_bbox;
+
+            if( candidate.GetLeft() > bbox.GetRight() )
+                break;
+
+            if( bbox.Intersects( candidate ) )
+                pairs.push_back( std::minmax( byLeft[ii], byLeft[jj] ) );
         }
     }
 
-    // Test for overlapping on bottom layer:
-    for( auto it1 = aBoard.Modules().begin(); it1 != aBoard.Modules().end(); it1++ )
+    // Report the pairs in board order, as the pairwise test always did
+    std::sort( pairs.begin(), pairs.end() );
+
+    // Intersect the courtyards of the candidate pairs on the thread pool.  The polygons are
+    // only read; each pair builds its common area in its own storage.
+    std::vector<char>     overlaps( pairs.size(), 0 );
+    std::vector<VECTOR2I> positions( pairs.size() );
+
+    auto overlap_lambda = [&]( size_t i )
     {
-        auto footprint = *it1;
+        SHAPE_POLY_SET courtyard( *courtyards[ pairs[i].first ].m_poly );
 
-        if( footprint->GetPolyCourtyardBack().OutlineCount() == 0 )
-            continue; // No courtyard defined
+        // Build the common area between footprint and the candidate:
+        courtyard.BooleanIntersection( *courtyards[ pairs[i].second ].m_poly,
+                                       SHAPE_POLY_SET::PM_FAST );
 
-        for( auto it2 = it1 + 1; it2 != aBoard.Modules().end(); it2++ )
+        // If no overlap, courtyard is empty (no common area).
+        // Therefore if a common polygon exists, this is a DRC error
+        if( courtyard.OutlineCount() )
         {
-            auto candidate = *it2;
+            positions[i] = courtyard.Vertex( 0, 0, -1 );
+            overlaps[i] = 1;
+        }
+    };
 
-            if( candidate->GetPolyCourtyardBack().OutlineCount() == 0 )
-                continue; // No courtyard defined
+    THREAD_POOL::GetPool().ParallelFor( pairs.size(), overlap_lambda, 0,
+                                        ADVANCED_CFG::GetCfg().m_maxDrcThreads );
 
-            courtyard.RemoveAllContours();
-            courtyard.Append( footprint->GetPolyCourtyardBack() );
+    const DRC_MARKER_FACTORY& marker_factory = GetMarkerFactory();
+    bool                      success = true;
 
-            // Build the common area between footprint and the candidate:
-            courtyard.BooleanIntersection(
-                    candidate->GetPolyCourtyardBack(), SHAPE_POLY_SET::PM_FAST );
+    for( size_t i = 0; i < pairs.size(); ++i )
+    {
+        if( !overlaps[i] )
+            continue;
 
-            // If no overlap, courtyard is empty (no common area).
-            // Therefore if a common polygon exists, this is a DRC error
-            if( courtyard.OutlineCount() )
-            {
-                //Overlap between footprint and candidate
-                VECTOR2I& pos = courtyard.Vertex( 0, 0, -1 );
-                auto      marker = std::unique_ptr<MARKER_PCB>(
-                        marker_factory.NewMarker( wxPoint( pos.x, pos.y ), footprint, candidate,
-                                DRCE_OVERLAPPING_FOOTPRINTS ) );
-                HandleMarker( std::move( marker ) );
-                success = false;
-            }
-        }
+        //Overlap between footprint and candidate
+        const VECTOR2I& pos = positions[i];
+        auto            marker = std::unique_ptr<MARKER_PCB>( marker_factory.NewMarker(
+                wxPoint( pos.x, pos.y ), courtyards[ pairs[i].first ].m_footprint,
+                courtyards[ pairs[i].second ].m_footprint, DRCE_OVERLAPPING_FOOTPRINTS ) );
+        HandleMarker( std::move( marker ) );
+        success = false;
     }
 
     return success;
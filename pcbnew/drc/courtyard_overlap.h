@@ -39,6 +39,16 @@ public:
             const DRC_MARKER_FACTORY& aMarkerFactory, MARKER_HANDLER aMarkerHandler );
 
     bool RunDRC( BOARD& aBoard ) const override;
+
+private:
+    /**
+     * Test the courtyards of one board side for overlaps.
+     *
+     * The courtyard polygons must have been built.
+     * @param aFront selects the front or the back courtyards
+     * @return true if no overlap was found
+     */
+    bool testOverlaps( BOARD& aBoard, bool aFront ) const;
 };
 
 #endif // DRC_COURTYARD_OVERLAP__H
\ No newline at end of file
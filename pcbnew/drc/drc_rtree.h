@@ -0,0 +1,143 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see change_log.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#ifndef DRC_RTREE__H
+#define DRC_RTREE__H
+
+#include <array>
+#include <functional>
+#include <memory>
+
+#include <math/box2.h>
+#include <layers_id_colors_and_visibility.h>
+
+#include <geometry/rtree.h>
+
+
+/**
+ * Class DRC_RTREE -
+ * Implements an R-tree for fast spatial lookup of board items during DRC.
+ *
+ * Items are bucketed by copper layer: there is one tree per copper layer, and items
+ * spanning several layers (vias, through hole pads) are inserted in each of them.
+ * Non-owning: T is usually a pointer or an index into a list owned by the caller.
+ */
+template< class T >
+class DRC_RTREE
+{
+public:
+    typedef RTree<T, int, 2, double> TREE;
+
+    DRC_RTREE() :
+        m_count( 0 )
+    {
+        for( auto& tree : m_trees )
+            tree.reset( new TREE() );
+    }
+
+    /**
+     * Function Insert()
+     * Inserts an item into the trees of all copper layers in aLayers.
+     */
+    void Insert( const T& aItem, const BOX2I& aBBox, const LSET& aLayers )
+    {
+        BOX2I     bbox = aBBox;
+        bbox.Normalize();
+
+        const int mmin[2] = { bbox.GetX(), bbox.GetY() };
+        const int mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
+
+        for( PCB_LAYER_ID layer : ( aLayers & LSET::AllCuMask() ).Seq() )
+            m_trees[layer]->Insert( mmin, mmax, aItem );
+
+        m_count++;
+    }
+
+    /**
+     * Function RemoveAll()
+     * Removes all items from the trees.
+     */
+    void RemoveAll()
+    {
+        for( auto& tree : m_trees )
+            tree->RemoveAll();
+
+        m_count = 0;
+    }
+
+    /**
+     * Function Query()
+     * Executes aVisitor for each item on one of the copper layers of aLayers whose bounding
+     * box intersects aBounds.  An item on several of these layers is visited once per layer.
+     * The visitor returns false to stop the search.
+     *
+     * Queries do not modify the trees, so several threads can query at the same time.
+     * @return the number of visited items
+     */
+    int Query( const BOX2I& aBounds, const LSET& aLayers,
+               std::function<bool( const T& )> aVisitor ) const
+    {
+        BOX2I     bbox = aBounds;
+        bbox.Normalize();
+
+        const int mmin[2] = { bbox.GetX(), bbox.GetY() };
+        const int mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
+        int       count = 0;
+        bool      stop = false;
+
+        auto visitor =
+                [&]( const T& aItem ) -> bool
+                {
+                    if( !aVisitor( aItem ) )
+                        stop = true;
+
+                    return !stop;
+                };
+
+        for( PCB_LAYER_ID layer : ( aLayers & LSET::AllCuMask() ).Seq() )
+        {
+            count += m_trees[layer]->Search( mmin, mmax, visitor );
+
+            if( stop )
+                break;
+        }
+
+        return count;
+    }
+
+    /**
+     * @return the number of inserted items (an item on several layers is counted once).
+     */
+    size_t size() const
+    {
+        return m_count;
+    }
+
+private:
+    std::array<std::unique_ptr<TREE>, MAX_CU_LAYERS> m_trees;
+    size_t                                           m_count;
+};
+
+
+#endif // DRC_RTREE__H
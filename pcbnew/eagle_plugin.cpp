@@ -51,6 +51,8 @@ Load() TODO's
 */
 
 #include <errno.h>
+#include <exception>
+#include <memory>
 
 #include <wx/string.h>
 #include <wx/xml/xml.h>
@@ -62,6 +64,7 @@ Load() TODO's
 #include <kicad_string.h>
 #include <macros.h>
 #include <properties.h>
+#include <thread_pool.h>
 #include <trigo.h>
 #include <wx/filename.h>
 
@@ -802,24 +805,53 @@ void EAGLE_PLUGIN::loadLibrary( wxXmlNode* aLib, const wxString* aLibName )
     // to instantiate needed MODULES in our BOARD.  Save the MODULE templates in
     // a MODULE_MAP using a single lookup key consisting of libname+pkgname.
 
-    // Get the first package and iterate
-    wxXmlNode* package = packages->GetChildren();
+    // The packages only read the XML tree and the layer map: they are converted in
+    // parallel, then added to the templates in the file order.
+    std::vector<wxXmlNode*> packageNodes;
+    std::vector<wxString>   packageRefs;
 
-    while( package )
+    for( wxXmlNode* package = packages->GetChildren(); package; package = package->GetNext() )
     {
-        m_xpath->push( "package", "name" );
-
         wxString pack_ref = package->GetAttribute( "name" );
         ReplaceIllegalFileNameChars( pack_ref, '_' );
 
+        packageNodes.push_back( package );
+        packageRefs.push_back( pack_ref );
+    }
+
+    std::vector<std::unique_ptr<MODULE>> modules( packageNodes.size() );
+    std::vector<std::exception_ptr>      errors( packageNodes.size() );
+
+    THREAD_POOL::GetPool().ParallelFor( packageNodes.size(),
+            [&]( size_t aIndex )
+            {
+                try
+                {
+                    modules[aIndex].reset( makeModule( packageNodes[aIndex],
+                                                       packageRefs[aIndex] ) );
+                }
+                catch( ... )
+                {
+                    errors[aIndex] = std::current_exception();
+                }
+            } );
+
+    for( size_t ii = 0; ii < packageNodes.size(); ++ii )
+    {
+        m_xpath->push( "package", "name" );
+
+        const wxString& pack_ref = packageRefs[ii];
+
         m_xpath->Value( pack_ref.ToUTF8() );
 
-        wxString key = aLibName ? makeKey( *aLibName, pack_ref ) : pack_ref;
+        // Thrown in this context, for the error message to give the package
+        if( errors[ii] )
+            std::rethrow_exception( errors[ii] );
 
-        MODULE* m = makeModule( package, pack_ref );
+        wxString key = aLibName ? makeKey( *aLibName, pack_ref ) : pack_ref;
 
         // add the templating MODULE to the MODULE template factory "m_templates"
-        std::pair<MODULE_ITER, bool> r = m_templates.insert( {key, m} );
+        std::pair<MODULE_ITER, bool> r = m_templates.insert( {key, modules[ii].get()} );
 
         if( !r.second
             // && !( m_props && m_props->Value( "ignore_duplicates" ) )
@@ -836,9 +868,9 @@ void EAGLE_PLUGIN::loadLibrary( wxXmlNode* aLib, const wxString* aLibName )
             THROW_IO_ERROR( emsg );
         }
 
-        m_xpath->pop();
+        modules[ii].release();
 
-        package = package->GetNext();
+        m_xpath->pop();
     }
 
     m_xpath->pop();     // "packages"
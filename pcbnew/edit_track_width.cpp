@@ -144,6 +144,9 @@ int PCB_EDIT_FRAME::SetTrackSegmentWidth( TRACK*             aTrackItem,
                     via->SetDrillDefault();
             }
         }
+
+        // The track is not committed: the zone fills hash its new size
+        aTrackItem->InvalidateHash();
     }
     else
     {
@@ -41,6 +41,7 @@
 #include <class_module.h>
 #include <class_track.h>
 #include <class_edge_mod.h>
+#include <export_d356.h>
 #include <vector>
 #include <cctype>
 
@@ -348,11 +349,40 @@ static void write_D356_records( std::vector <D356_RECORD> &aRecords,
 }
 
 
+bool WriteD356File( BOARD* aPcb, const wxString& aFullFileName )
+{
+    FILE* file = wxFopen( aFullFileName, wxT( "wt" ) );
+
+    if( file == NULL )
+        return false;
+
+    LOCALE_IO       toggle;     // Switch the locale to standard C
+
+    // This will contain everything needed for the 356 file
+    std::vector <D356_RECORD> d356_records;
+
+    build_via_testpoints( aPcb, d356_records );
+
+    build_pad_testpoints( aPcb, d356_records );
+
+    // Code 00 AFAIK is ASCII, CUST 0 is decimils/degrees
+    // CUST 1 would be metric but gerbtool simply ignores it!
+    fprintf( file, "P  CODE 00\n" );
+    fprintf( file, "P  UNITS CUST 0\n" );
+    fprintf( file, "P  arrayDim   N\n" );
+    write_D356_records( d356_records, file );
+    fprintf( file, "999\n" );
+
+    fclose( file );
+
+    return true;
+}
+
+
 void PCB_EDIT_FRAME::GenD356File( wxCommandEvent& aEvent )
 {
     wxFileName  fn = GetBoard()->GetFileName();
     wxString    msg, ext, wildcard;
-    FILE*       file;
 
     ext = IpcD356FileExtension;
     wildcard = IpcD356FileWildcard();
@@ -367,29 +397,9 @@ void PCB_EDIT_FRAME::GenD356File( wxCommandEvent& aEvent )
     if( dlg.ShowModal() == wxID_CANCEL )
         return;
 
-    if( ( file = wxFopen( dlg.GetPath(), wxT( "wt" ) ) ) == NULL )
+    if( !WriteD356File( GetBoard(), dlg.GetPath() ) )
     {
         msg = _( "Unable to create " ) + dlg.GetPath();
         DisplayError( this, msg ); return;
     }
-
-    LOCALE_IO       toggle;     // Switch the locale to standard C
-
-    // This will contain everything needed for the 356 file
-    std::vector <D356_RECORD> d356_records;
-    BOARD* pcb = GetBoard();
-
-    build_via_testpoints( pcb, d356_records );
-
-    build_pad_testpoints( pcb, d356_records );
-
-    // Code 00 AFAIK is ASCII, CUST 0 is decimils/degrees
-    // CUST 1 would be metric but gerbtool simply ignores it!
-    fprintf( file, "P  CODE 00\n" );
-    fprintf( file, "P  UNITS CUST 0\n" );
-    fprintf( file, "P  arrayDim   N\n" );
-    write_D356_records( d356_records, file );
-    fprintf( file, "999\n" );
-
-    fclose( file );
 }
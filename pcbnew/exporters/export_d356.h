@@ -0,0 +1,44 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file export_d356.h
+ * @brief Export IPC-D-356 test format
+ */
+
+#ifndef EXPORT_D356_H
+#define EXPORT_D356_H
+
+class BOARD;
+class wxString;
+
+/**
+ * Function WriteD356File
+ * writes the IPC-D-356 netlist of the pads and vias of a board.  The board is only read.
+ * @param aPcb = the board to export
+ * @param aFullFileName = the full path of the file to create
+ * @return false if the file could not be created
+ */
+bool WriteD356File( BOARD* aPcb, const wxString& aFullFileName );
+
+#endif  // EXPORT_D356_H
@@ -28,6 +28,8 @@
 #include <exception>
 #include <fstream>
 #include <iomanip>
+#include <memory>
+#include <sstream>
 #include <vector>
 #include <wx/dir.h>
 
@@ -51,6 +53,7 @@
 #include <convert_basic_shapes_to_polygon.h>
 #include <geometry/geometry_utils.h>
 
+#include <thread_pool.h>
 #include <zone_filler.h>
 
 // minimum width (mm) of a VRML line
@@ -419,144 +422,114 @@ static void write_triangle_bag( std::ostream& aOut_file, VRML_COLOR& aColor,
 }
 
 
+/// A layer of the board to tesselate and write out
+struct VRML_LAYER_JOB
+{
+    VRML_LAYER*      m_layer;
+    VRML_LAYER*      m_holes;       ///< the holes to cut out of the layer, or NULL
+    bool             m_holesOnly;
+    VRML_COLOR_INDEX m_color;
+    bool             m_plane;       ///< false for a shell between m_topZ and m_bottomZ
+    bool             m_top;         ///< the plane is visible from above
+    double           m_topZ;
+    double           m_bottomZ;
+    std::string      m_output;      ///< the inlined triangle bag of the layer
+};
+
+
 static void write_layers( MODEL_VRML& aModel, BOARD* aPcb,
     const char* aFileName, OSTREAM* aOutputFile )
 {
-    // VRML_LAYER board;
-    aModel.m_board.Tesselate( &aModel.m_holes );
     double brdz = aModel.m_brd_thickness / 2.0
                   - ( Millimeter2iu( ART_OFFSET / 2.0 ) ) * BOARD_SCALE;
+    double tinOffset = Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE;
 
-    if( USE_INLINES )
-    {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_PCB ),
-                            &aModel.m_board, false, false, brdz, -brdz );
-    }
-    else
-    {
-        create_vrml_shell( aModel.m_OutputPCB, VRML_COLOR_PCB, &aModel.m_board, brdz, -brdz );
-    }
-
-    if( aModel.m_plainPCB )
-    {
-        if( !USE_INLINES )
-            S3D::WriteVRML( aFileName, true, aModel.m_OutputPCB.GetRawPtr(), USE_DEFS, true );
+    std::vector<VRML_LAYER_JOB> jobs;
 
-        return;
-    }
-
-    // VRML_LAYER m_top_copper;
-    aModel.m_top_copper.Tesselate( &aModel.m_holes );
+    jobs.push_back( { &aModel.m_board, &aModel.m_holes, false, VRML_COLOR_PCB,
+                      false, false, brdz, -brdz } );
 
-    if( USE_INLINES )
-    {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_TRACK ),
-                           &aModel.m_top_copper, true, true,
-                           aModel.GetLayerZ( F_Cu ), 0 );
-    }
-    else
+    if( !aModel.m_plainPCB )
     {
-        create_vrml_plane( aModel.m_OutputPCB, VRML_COLOR_TRACK, &aModel.m_top_copper,
-                           aModel.GetLayerZ( F_Cu ), true );
-    }
-
-    // VRML_LAYER m_top_tin;
-    aModel.m_top_tin.Tesselate( &aModel.m_holes );
+        jobs.push_back( { &aModel.m_top_copper, &aModel.m_holes, false, VRML_COLOR_TRACK,
+                          true, true, aModel.GetLayerZ( F_Cu ), 0 } );
+        jobs.push_back( { &aModel.m_top_tin, &aModel.m_holes, false, VRML_COLOR_TIN,
+                          true, true, aModel.GetLayerZ( F_Cu ) + tinOffset, 0 } );
+        jobs.push_back( { &aModel.m_bot_copper, &aModel.m_holes, false, VRML_COLOR_TRACK,
+                          true, false, aModel.GetLayerZ( B_Cu ), 0 } );
+        jobs.push_back( { &aModel.m_bot_tin, &aModel.m_holes, false, VRML_COLOR_TIN,
+                          true, false, aModel.GetLayerZ( B_Cu ) - tinOffset, 0 } );
+        jobs.push_back( { &aModel.m_plated_holes, NULL, true, VRML_COLOR_TIN,
+                          false, false, aModel.GetLayerZ( F_Cu ) + tinOffset,
+                          aModel.GetLayerZ( B_Cu ) - tinOffset } );
+        jobs.push_back( { &aModel.m_top_silk, &aModel.m_holes, false, VRML_COLOR_SILK,
+                          true, true, aModel.GetLayerZ( F_SilkS ), 0 } );
+        jobs.push_back( { &aModel.m_bot_silk, &aModel.m_holes, false, VRML_COLOR_SILK,
+                          true, false, aModel.GetLayerZ( B_SilkS ), 0 } );
+    }
+
+    // The tesselation renumbers the vertices of the holes for the tesselated layer, and
+    // the layer refers to them until it is written out: the board keeps aModel.m_holes,
+    // every other layer gets its own copy so that all of them can be tesselated at once.
+    std::vector<std::unique_ptr<VRML_LAYER>> holesCopies;
+
+    for( size_t i = 1; i < jobs.size(); ++i )
+    {
+        if( !jobs[i].m_holes )
+            continue;
 
-    if( USE_INLINES )
-    {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_TIN ),
-                            &aModel.m_top_tin, true, true,
-                            aModel.GetLayerZ( F_Cu ) + Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE,
-                            0 );
-    }
-    else
-    {
-        create_vrml_plane( aModel.m_OutputPCB, VRML_COLOR_TIN, &aModel.m_top_tin,
-                           aModel.GetLayerZ( F_Cu ) + Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE,
-                           true );
+        holesCopies.emplace_back( new VRML_LAYER );
+        holesCopies.back()->AppendContours( aModel.m_holes );
+        jobs[i].m_holes = holesCopies.back().get();
     }
 
-    // VRML_LAYER m_bot_copper;
-    aModel.m_bot_copper.Tesselate( &aModel.m_holes );
-
-    if( USE_INLINES )
-    {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_TRACK ),
-                            &aModel.m_bot_copper, true, false,
-                            aModel.GetLayerZ( B_Cu ), 0 );
-    }
-    else
-    {
-        create_vrml_plane( aModel.m_OutputPCB, VRML_COLOR_TRACK, &aModel.m_bot_copper,
-                           aModel.GetLayerZ( B_Cu ), false );
-    }
+    // Inlined triangle bags only depend on their own layer: they are formatted by the
+    // workers too, and streamed to the file in one write each
+    THREAD_POOL::GetPool().ParallelFor( jobs.size(),
+            [&]( size_t i )
+            {
+                VRML_LAYER_JOB& job = jobs[i];
 
-    // VRML_LAYER m_bot_tin;
-    aModel.m_bot_tin.Tesselate( &aModel.m_holes );
+                job.m_layer->Tesselate( job.m_holes, job.m_holesOnly );
 
-    if( USE_INLINES )
-    {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_TIN ),
-                            &aModel.m_bot_tin, true, false,
-                            aModel.GetLayerZ( B_Cu )
-                            - Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE,
-                            0 );
-    }
-    else
-    {
-        create_vrml_plane( aModel.m_OutputPCB, VRML_COLOR_TIN, &aModel.m_bot_tin,
-                           aModel.GetLayerZ( B_Cu ) - Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE,
-                           false );
-    }
+                if( !USE_INLINES )
+                    return;
 
-    // VRML_LAYER PTH;
-    aModel.m_plated_holes.Tesselate( NULL, true );
+                std::ostringstream buffer;
+                buffer.imbue( std::locale::classic() );
+                buffer.precision( aOutputFile->precision() );
 
-    if( USE_INLINES )
-    {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_TIN ),
-                            &aModel.m_plated_holes, false, false,
-                            aModel.GetLayerZ( F_Cu ) + Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE,
-                            aModel.GetLayerZ( B_Cu ) - Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE );
-    }
-    else
-    {
-        create_vrml_shell( aModel.m_OutputPCB, VRML_COLOR_TIN, &aModel.m_plated_holes,
-                           aModel.GetLayerZ( F_Cu ) + Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE,
-                           aModel.GetLayerZ( B_Cu ) - Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE );
-    }
+                write_triangle_bag( buffer, aModel.GetColor( job.m_color ), job.m_layer,
+                                    job.m_plane, job.m_top, job.m_topZ, job.m_bottomZ );
 
-    // VRML_LAYER m_top_silk;
-    aModel.m_top_silk.Tesselate( &aModel.m_holes );
+                job.m_output = buffer.str();
+            }, 1 );
 
-    if( USE_INLINES )
-    {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_SILK ), &aModel.m_top_silk,
-                            true, true, aModel.GetLayerZ( F_SilkS ), 0 );
-    }
-    else
+    // The scene graph and the file are built in the layers order
+    for( VRML_LAYER_JOB& job : jobs )
     {
-        create_vrml_plane( aModel.m_OutputPCB, VRML_COLOR_SILK, &aModel.m_top_silk,
-                           aModel.GetLayerZ( F_SilkS ), true );
+        if( USE_INLINES )
+        {
+            aOutputFile->write( job.m_output.data(), job.m_output.size() );
+            job.m_output.clear();
+        }
+        else if( job.m_plane )
+        {
+            create_vrml_plane( aModel.m_OutputPCB, job.m_color, job.m_layer, job.m_topZ,
+                               job.m_top );
+        }
+        else
+        {
+            create_vrml_shell( aModel.m_OutputPCB, job.m_color, job.m_layer, job.m_topZ,
+                               job.m_bottomZ );
+        }
     }
 
-    // VRML_LAYER m_bot_silk;
-    aModel.m_bot_silk.Tesselate( &aModel.m_holes );
-
-    if( USE_INLINES )
-    {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_SILK ), &aModel.m_bot_silk,
-                            true, false, aModel.GetLayerZ( B_SilkS ), 0 );
-    }
-    else
+    if( !USE_INLINES )
     {
-        create_vrml_plane( aModel.m_OutputPCB, VRML_COLOR_SILK, &aModel.m_bot_silk,
-                           aModel.GetLayerZ( B_SilkS ), false );
+        S3D::WriteVRML( aFileName, true, aModel.m_OutputPCB.GetRawPtr(),
+                        aModel.m_plainPCB ? USE_DEFS : true, true );
     }
-
-    if( !USE_INLINES )
-        S3D::WriteVRML( aFileName, true, aModel.m_OutputPCB.GetRawPtr(), true, true );
 }
 
 
@@ -0,0 +1,239 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+/**
+ * @file fabrication_package.cpp
+ * @brief Write the full set of fabrication files of a board at once
+ */
+
+#include <fctsys.h>
+#include <common.h>
+#include <plotter.h>
+#include <reporter.h>
+#include <thread_pool.h>
+#include <wildcards_and_files_ext.h>
+#include <class_board.h>
+#include <class_module.h>
+#include <pcbplot.h>
+#include <gendrill_Excellon_writer.h>
+#include <gerber_jobfile_writer.h>
+#include <export_footprints_placefile.h>
+#include <export_d356.h>
+#include <fabrication_package.h>
+
+#include <functional>
+
+
+FABRICATION_PACKAGE_WRITER::FABRICATION_PACKAGE_WRITER( BOARD* aPcb, REPORTER* aReporter ) :
+        m_pcb( aPcb ),
+        m_reporter( aReporter ),
+        m_plotOpts( aPcb->GetPlotOptions() ),
+        m_unitsMM( true )
+{
+}
+
+
+bool FABRICATION_PACKAGE_WRITER::createPlaceFile( const wxString& aFullFileName, bool aTopSide )
+{
+    PLACE_FILE_EXPORTER exporter( m_pcb, m_unitsMM, false, aTopSide, !aTopSide, false );
+    std::string         data = exporter.GenPositionData();
+
+    FILE* file = wxFopen( aFullFileName, wxT( "wt" ) );
+
+    if( file == NULL )
+        return false;
+
+    fputs( data.c_str(), file );
+    fclose( file );
+
+    return true;
+}
+
+
+bool FABRICATION_PACKAGE_WRITER::CreateFiles()
+{
+    wxString   msg;
+    wxFileName outputDir = wxFileName::DirName( m_plotOpts.GetOutputDirectory() );
+    wxString   boardFilename = m_pcb->GetFileName();
+
+    if( !EnsureFileDirectoryExists( &outputDir, boardFilename, m_reporter ) )
+    {
+        if( m_reporter )
+        {
+            msg.Printf( _( "Could not write plot files to folder \"%s\"." ),
+                        GetChars( outputDir.GetPath() ) );
+            m_reporter->Report( msg, REPORTER::RPT_ERROR );
+        }
+
+        return false;
+    }
+
+    PCB_PLOT_PARAMS plotOpts = m_plotOpts;
+    plotOpts.SetFormat( PLOT_FORMAT_GERBER );
+
+    // The Gerber files, and their list in the job file
+    GERBER_JOBFILE_WRITER       jobfileWriter( m_pcb, m_reporter );
+    std::vector<PLOT_LAYER_JOB> plotJobs;
+
+    for( LSEQ seq = plotOpts.GetLayerSelection().UIOrder();  seq;  ++seq )
+    {
+        PCB_LAYER_ID layer = *seq;
+
+        // Skip the copper layers selected but disabled on the board
+        if( ( LSET::AllCuMask() & ~m_pcb->GetEnabledLayers() )[layer] )
+            continue;
+
+        wxFileName fn( boardFilename );
+        wxString   fileExt = GetDefaultPlotExtension( PLOT_FORMAT_GERBER );
+
+        if( plotOpts.GetUseGerberProtelExtensions() )
+            fileExt = GetGerberProtelExtension( layer );
+
+        BuildPlotFileName( &fn, outputDir.GetPath(), m_pcb->GetLayerName( layer ), fileExt );
+        jobfileWriter.AddGbrFile( layer, fn.GetFullName() );
+
+        PLOT_LAYER_JOB job;
+        job.m_Layer = layer;
+        job.m_FileName = fn.GetFullPath();
+        job.m_Success = false;
+        plotJobs.push_back( job );
+    }
+
+    // The drill files; their holes lists are built once for all the files
+    EXCELLON_WRITER    drillWriter( m_pcb );
+    wxString           drillReport;
+    WX_STRING_REPORTER drillReporter( &drillReport );
+    wxPoint            drillOffset( 0, 0 );
+
+    if( plotOpts.GetUseAuxOrigin() )
+        drillOffset = m_pcb->GetAuxOrigin();
+
+    drillWriter.SetFormat( m_unitsMM );
+    drillWriter.SetOptions( false, false, drillOffset, false );
+
+    // The position files and the netlist
+    wxFileName topPlaceFile( boardFilename );
+    wxFileName bottomPlaceFile( boardFilename );
+    wxFileName d356File( boardFilename );
+
+    topPlaceFile.SetPath( outputDir.GetPath() );
+    topPlaceFile.SetName( topPlaceFile.GetName() + wxT( "-" )
+                          + PLACE_FILE_EXPORTER::GetFrontSideName().c_str() );
+    topPlaceFile.SetExt( FootprintPlaceFileExtension );
+
+    bottomPlaceFile.SetPath( outputDir.GetPath() );
+    bottomPlaceFile.SetName( bottomPlaceFile.GetName() + wxT( "-" )
+                             + PLACE_FILE_EXPORTER::GetBackSideName().c_str() );
+    bottomPlaceFile.SetExt( FootprintPlaceFileExtension );
+
+    d356File.SetPath( outputDir.GetPath() );
+    d356File.SetExt( IpcD356FileExtension );
+
+    bool topPlaceOk = false;
+    bool bottomPlaceOk = false;
+    bool d356Ok = false;
+
+    // The bounding radius of the pads is computed the first time it is used, so it is
+    // computed here before the outputs read the pads at once
+    for( auto module : m_pcb->Modules() )
+    {
+        for( auto pad : module->Pads() )
+            pad->GetBoundingRadius();
+    }
+
+    // Each output is written by its own task; the Gerber and the drill files are also
+    // written at once by their own tasks
+    std::vector<std::function<void()>> outputs = {
+        [&]() { PlotBoardLayers( m_pcb, plotOpts, plotJobs ); },
+        [&]() { drillWriter.CreateDrillandMapFilesSet( outputDir.GetFullPath(), true, false,
+                                                       &drillReporter ); },
+        [&]() { topPlaceOk = createPlaceFile( topPlaceFile.GetFullPath(), true ); },
+        [&]() { bottomPlaceOk = createPlaceFile( bottomPlaceFile.GetFullPath(), false ); },
+        [&]() { d356Ok = WriteD356File( m_pcb, d356File.GetFullPath() ); }
+    };
+
+    {
+        LOCALE_IO toggle;   // Use the standard notation for double numbers in all the threads
+
+        THREAD_POOL::GetPool().ParallelFor( outputs.size(),
+                [&]( size_t aIndex )
+                {
+                    outputs[aIndex]();
+                }, 1 );
+    }
+
+    // The outputs are reported once they are all written, from the calling thread
+    bool success = topPlaceOk && bottomPlaceOk && d356Ok;
+
+    for( const PLOT_LAYER_JOB& job : plotJobs )
+    {
+        success &= job.m_Success;
+
+        if( !m_reporter )
+            continue;
+
+        if( job.m_Success )
+        {
+            msg.Printf( _( "Plot file \"%s\" created." ), GetChars( job.m_FileName ) );
+            m_reporter->Report( msg, REPORTER::RPT_ACTION );
+        }
+        else
+        {
+            msg.Printf( _( "Unable to create file \"%s\"." ), GetChars( job.m_FileName ) );
+            m_reporter->Report( msg, REPORTER::RPT_ERROR );
+        }
+    }
+
+    if( m_reporter )
+    {
+        m_reporter->Report( drillReport );
+
+        const std::pair<wxString, bool> files[] = {
+            { topPlaceFile.GetFullPath(), topPlaceOk },
+            { bottomPlaceFile.GetFullPath(), bottomPlaceOk },
+            { d356File.GetFullPath(), d356Ok }
+        };
+
+        for( const std::pair<wxString, bool>& file : files )
+        {
+            if( file.second )
+            {
+                msg.Printf( _( "File \"%s\" created." ), GetChars( file.first ) );
+                m_reporter->Report( msg, REPORTER::RPT_ACTION );
+            }
+            else
+            {
+                msg.Printf( _( "Unable to create file \"%s\"." ), GetChars( file.first ) );
+                m_reporter->Report( msg, REPORTER::RPT_ERROR );
+            }
+        }
+    }
+
+    // The job file lists the Gerber files, so it is written last
+    wxFileName jobFile( boardFilename );
+    BuildPlotFileName( &jobFile, outputDir.GetPath(), "job", GerberJobFileExtension );
+    success &= jobfileWriter.CreateJobFile( jobFile.GetFullPath() );
+
+    return success;
+}
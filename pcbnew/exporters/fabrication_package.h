@@ -0,0 +1,84 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+/**
+ * @file fabrication_package.h
+ * @brief Write the full set of fabrication files of a board at once
+ */
+
+#ifndef FABRICATION_PACKAGE_H
+#define FABRICATION_PACKAGE_H
+
+#include <pcb_plot_params.h>
+
+class BOARD;
+class REPORTER;
+
+/**
+ * FABRICATION_PACKAGE_WRITER creates all the files a board maker needs, in one directory:
+ *  the Gerber files of the selected layers and the Gerber job file,
+ *  the Excellon drill files,
+ *  the top and bottom footprint position files,
+ *  the IPC-D-356 netlist.
+ *
+ * The outputs are written at once on the thread pool.  The board is only read, and the
+ * zones are plotted as they are filled.
+ */
+class FABRICATION_PACKAGE_WRITER
+{
+public:
+    FABRICATION_PACKAGE_WRITER( BOARD* aPcb, REPORTER* aReporter = nullptr );
+
+    /**
+     * Set the options of the Gerber files, the board plot options by default.  The layer
+     * selection and the output directory of the options are the ones of the package, and
+     * the drill files use their auxiliary origin option.
+     */
+    void SetPlotOptions( const PCB_PLOT_PARAMS& aPlotOpts ) { m_plotOpts = aPlotOpts; }
+
+    /**
+     * Set the units of the drill and position files (mm by default)
+     */
+    void SetUnitsMM( bool aUnitsMM ) { m_unitsMM = aUnitsMM; }
+
+    /**
+     * Function CreateFiles
+     * writes the package.
+     * @return true if all the files were created
+     */
+    bool CreateFiles();
+
+private:
+    /**
+     * Write the position file of the footprints of one side
+     */
+    bool createPlaceFile( const wxString& aFullFileName, bool aTopSide );
+
+    BOARD*          m_pcb;
+    REPORTER*       m_reporter;
+    PCB_PLOT_PARAMS m_plotOpts;
+    bool            m_unitsMM;
+};
+
+#endif  // FABRICATION_PACKAGE_H
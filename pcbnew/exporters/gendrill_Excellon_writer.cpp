@@ -50,6 +50,7 @@
 #include <wildcards_and_files_ext.h>
 #include <reporter.h>
 #include <gbr_metadata.h>
+#include <thread_pool.h>
 
 // Comment/uncomment this to write or not a comment
 // in drill file when PTH and NPTH are merged to flag
@@ -80,62 +81,37 @@ void EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
                                                  bool aGenDrill, bool aGenMap,
                                                  REPORTER * aReporter )
 {
-    wxFileName  fn;
-    wxString    msg;
+    std::vector<DRILL_FILE_JOB> jobs = getDrillFileJobs( aPlotDirectory, aGenDrill, aGenMap );
 
-    std::vector<DRILL_LAYER_PAIR> hole_sets = getUniqueLayerPairs();
+    LOCALE_IO dummy;    // Use the standard notation for double numbers in all the threads
 
-    // append a pair representing the NPTH set of holes, for separate drill files.
-    if( !m_merge_PTH_NPTH )
-        hole_sets.push_back( DRILL_LAYER_PAIR( F_Cu, B_Cu ) );
-
-    for( std::vector<DRILL_LAYER_PAIR>::const_iterator it = hole_sets.begin();
-         it != hole_sets.end();  ++it )
-    {
-        DRILL_LAYER_PAIR  pair = *it;
-        // For separate drill files, the last layer pair is the NPTH drill file.
-        bool doing_npth = m_merge_PTH_NPTH ? false : ( it == hole_sets.end() - 1 );
-
-        buildHolesList( pair, doing_npth );
-
-        // The file is created if it has holes, or if it is the non plated drill file
-        // to be sure the NPTH file is up to date in separate files mode.
-        if( getHolesCount() > 0 || doing_npth )
-        {
-            fn = getDrillFileName( pair, doing_npth, m_merge_PTH_NPTH );
-            fn.SetPath( aPlotDirectory );
-
-            if( aGenDrill )
+    // The files are written at once, each one by its own copy of the writer sharing the
+    // holes lists
+    THREAD_POOL::GetPool().ParallelFor( jobs.size(),
+            [&]( size_t i )
             {
-                wxString fullFilename = fn.GetFullPath();
+                DRILL_FILE_JOB& job = jobs[i];
+                EXCELLON_WRITER writer( *this );
 
-                FILE* file = wxFopen( fullFilename, wxT( "w" ) );
+                writer.buildHolesList( job.m_Pair, job.m_Npth );
 
-                if( file == NULL )
+                if( job.m_Map )
                 {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "** Unable to create %s **\n" ), GetChars( fullFilename ) );
-                        aReporter->Report( msg );
-                    }
-                    break;
+                    job.m_Success = writer.genDrillMapFile( job.m_FileName, m_mapFileFmt );
+                    return;
                 }
-                else
+
+                FILE* file = wxFopen( job.m_FileName, wxT( "w" ) );
+
+                if( file )
                 {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "Create file %s\n" ), GetChars( fullFilename ) );
-                        aReporter->Report( msg );
-                    }
+                    writer.createDrillFile( file, job.m_Pair, job.m_Npth );
+                    job.m_Success = true;
                 }
+            },
+            1 );
 
-                createDrillFile( file, pair, doing_npth );
-            }
-        }
-    }
-
-    if( aGenMap )
-        CreateMapFilesSet( aPlotDirectory, aReporter );
+    reportDrillFileJobs( jobs, aReporter );
 }
 
 
@@ -28,6 +28,7 @@
 #include <class_module.h>
 #include <collectors.h>
 #include <reporter.h>
+#include <thread_pool.h>
 
 #include <gendrill_file_writer_base.h>
 
@@ -69,126 +70,239 @@ static bool CmpHoleSorting( const HOLE_INFO& a, const HOLE_INFO& b )
 }
 
 
-void GENDRILL_WRITER_BASE::buildHolesList( DRILL_LAYER_PAIR aLayerPair,
-                                           bool aGenerateNPTH_list )
+/* Helper function: sort the holes of a list, and build its tool list
+ */
+static void buildToolList( HOLES_LISTS::HOLE_LIST& aList )
 {
-    HOLE_INFO new_hole;
+    std::vector<HOLE_INFO>&  holes = aList.m_Holes;
+    std::vector<DRILL_TOOL>& tools = aList.m_Tools;
 
-    m_holeListBuffer.clear();
-    m_toolListBuffer.clear();
+    // Sort holes per increasing diameter value
+    sort( holes.begin(), holes.end(), CmpHoleSorting );
 
-    wxASSERT( aLayerPair.first < aLayerPair.second );  // fix the caller
+    // build the tool list
+    int last_hole = -1;     // Set to not initialized (this is a value not used
+                            // for holes[ii].m_Hole_Diameter)
+    bool last_notplated_opt = false;
+
+    DRILL_TOOL new_tool( 0, false );
+    unsigned   jj;
 
-    // build hole list for vias
-    if( ! aGenerateNPTH_list )  // vias are always plated !
+    for( unsigned ii = 0; ii < holes.size(); ii++ )
     {
-        for( auto track : m_pcb->Tracks() )
+        if( holes[ii].m_Hole_Diameter != last_hole ||
+            holes[ii].m_Hole_NotPlated != last_notplated_opt )
         {
-            if( track->Type() != PCB_VIA_T )
-                continue;
+            new_tool.m_Diameter = holes[ii].m_Hole_Diameter;
+            new_tool.m_Hole_NotPlated = holes[ii].m_Hole_NotPlated;
+            tools.push_back( new_tool );
+            last_hole = new_tool.m_Diameter;
+            last_notplated_opt = new_tool.m_Hole_NotPlated;
+        }
 
-            auto via = static_cast<VIA*>( track );
-            int hole_sz = via->GetDrillValue();
+        jj = tools.size();
 
-            if( hole_sz == 0 )   // Should not occur.
-                continue;
+        if( jj == 0 )
+            continue;                                        // Should not occurs
 
-            new_hole.m_ItemParent = via;
-            new_hole.m_Tool_Reference = -1;         // Flag value for Not initialized
-            new_hole.m_Hole_Orient    = 0;
-            new_hole.m_Hole_Diameter  = hole_sz;
-            new_hole.m_Hole_NotPlated = false;
-            new_hole.m_Hole_Size.x = new_hole.m_Hole_Size.y = new_hole.m_Hole_Diameter;
+        holes[ii].m_Tool_Reference = jj;          // Tool value Initialized (value >= 1)
 
-            new_hole.m_Hole_Shape = 0;              // hole shape: round
-            new_hole.m_Hole_Pos = via->GetStart();
+        tools.back().m_TotalCount++;
 
-            via->LayerPair( &new_hole.m_Hole_Top_Layer, &new_hole.m_Hole_Bottom_Layer );
+        if( holes[ii].m_Hole_Shape )
+            tools.back().m_OvalCount++;
+    }
+}
 
-            // LayerPair() returns params with m_Hole_Bottom_Layer > m_Hole_Top_Layer
-            // Remember: top layer = 0 and bottom layer = 31 for through hole vias
-            // Any captured via should be from aLayerPair.first to aLayerPair.second exactly.
-            if( new_hole.m_Hole_Top_Layer    != aLayerPair.first ||
-                new_hole.m_Hole_Bottom_Layer != aLayerPair.second )
-                continue;
 
-            m_holeListBuffer.push_back( new_hole );
-        }
+void GENDRILL_WRITER_BASE::buildAllHolesLists()
+{
+    std::shared_ptr<HOLES_LISTS> lists = std::make_shared<HOLES_LISTS>();
+    lists->m_Merge_PTH_NPTH = m_merge_PTH_NPTH;
+
+    HOLE_INFO new_hole;
+
+    // build hole list for vias (vias are always plated !)
+    for( auto track : m_pcb->Tracks() )
+    {
+        if( track->Type() != PCB_VIA_T )
+            continue;
+
+        auto via = static_cast<VIA*>( track );
+        int hole_sz = via->GetDrillValue();
+
+        if( hole_sz == 0 )   // Should not occur.
+            continue;
+
+        new_hole.m_ItemParent = via;
+        new_hole.m_Tool_Reference = -1;         // Flag value for Not initialized
+        new_hole.m_Hole_Orient    = 0;
+        new_hole.m_Hole_Diameter  = hole_sz;
+        new_hole.m_Hole_NotPlated = false;
+        new_hole.m_Hole_Size.x = new_hole.m_Hole_Size.y = new_hole.m_Hole_Diameter;
+
+        new_hole.m_Hole_Shape = 0;              // hole shape: round
+        new_hole.m_Hole_Pos = via->GetStart();
+
+        via->LayerPair( &new_hole.m_Hole_Top_Layer, &new_hole.m_Hole_Bottom_Layer );
+
+        // LayerPair() returns params with m_Hole_Bottom_Layer > m_Hole_Top_Layer
+        // Remember: top layer = 0 and bottom layer = 31 for through hole vias
+        DRILL_LAYER_PAIR pair( new_hole.m_Hole_Top_Layer, new_hole.m_Hole_Bottom_Layer );
+
+        lists->m_Lists[ std::make_pair( pair, false ) ].m_Holes.push_back( new_hole );
     }
 
-    if( aLayerPair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
+    // add holes for thru hole pads
+    DRILL_LAYER_PAIR thru( F_Cu, B_Cu );
+
+    for( auto module : m_pcb->Modules() )
     {
-        // add holes for thru hole pads
-        for( auto module : m_pcb->Modules() )
+        for( auto& pad : module->Pads() )
         {
-            for( auto& pad : module->Pads() )
-            {
-                if( !m_merge_PTH_NPTH )
-                {
-                    if( !aGenerateNPTH_list && pad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED )
-                        continue;
+            if( pad->GetDrillSize().x == 0 )
+                continue;
 
-                    if( aGenerateNPTH_list && pad->GetAttribute() != PAD_ATTRIB_HOLE_NOT_PLATED )
-                        continue;
-                }
+            new_hole.m_ItemParent     = pad;
+            new_hole.m_Hole_NotPlated = (pad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED);
+            new_hole.m_Tool_Reference = -1;         // Flag is: Not initialized
+            new_hole.m_Hole_Orient    = pad->GetOrientation();
+            new_hole.m_Hole_Shape     = 0;           // hole shape: round
+            new_hole.m_Hole_Diameter  = std::min( pad->GetDrillSize().x, pad->GetDrillSize().y );
+            new_hole.m_Hole_Size.x    = new_hole.m_Hole_Size.y = new_hole.m_Hole_Diameter;
 
-                if( pad->GetDrillSize().x == 0 )
-                    continue;
-
-                new_hole.m_ItemParent     = pad;
-                new_hole.m_Hole_NotPlated = (pad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED);
-                new_hole.m_Tool_Reference = -1;         // Flag is: Not initialized
-                new_hole.m_Hole_Orient    = pad->GetOrientation();
-                new_hole.m_Hole_Shape     = 0;           // hole shape: round
-                new_hole.m_Hole_Diameter  = std::min( pad->GetDrillSize().x, pad->GetDrillSize().y );
-                new_hole.m_Hole_Size.x    = new_hole.m_Hole_Size.y = new_hole.m_Hole_Diameter;
-
-                if( pad->GetDrillShape() != PAD_DRILL_SHAPE_CIRCLE )
-                    new_hole.m_Hole_Shape = 1; // oval flag set
-
-                new_hole.m_Hole_Size         = pad->GetDrillSize();
-                new_hole.m_Hole_Pos          = pad->GetPosition();  // hole position
-                new_hole.m_Hole_Bottom_Layer = B_Cu;
-                new_hole.m_Hole_Top_Layer    = F_Cu;    // pad holes are through holes
-                m_holeListBuffer.push_back( new_hole );
+            if( pad->GetDrillShape() != PAD_DRILL_SHAPE_CIRCLE )
+                new_hole.m_Hole_Shape = 1; // oval flag set
+
+            new_hole.m_Hole_Size         = pad->GetDrillSize();
+            new_hole.m_Hole_Pos          = pad->GetPosition();  // hole position
+            new_hole.m_Hole_Bottom_Layer = B_Cu;
+            new_hole.m_Hole_Top_Layer    = F_Cu;    // pad holes are through holes
+
+            if( m_merge_PTH_NPTH )
+            {
+                // All the pads are in the plated list, and in the NPTH list too
+                lists->m_Lists[ std::make_pair( thru, false ) ].m_Holes.push_back( new_hole );
+                lists->m_Lists[ std::make_pair( thru, true ) ].m_Holes.push_back( new_hole );
+            }
+            else
+            {
+                auto key = std::make_pair( thru, new_hole.m_Hole_NotPlated );
+                lists->m_Lists[ key ].m_Holes.push_back( new_hole );
             }
         }
     }
 
-    // Sort holes per increasing diameter value
-    sort( m_holeListBuffer.begin(), m_holeListBuffer.end(), CmpHoleSorting );
+    std::vector<HOLES_LISTS::HOLE_LIST*> toBuild;
 
-    // build the tool list
-    int last_hole = -1;     // Set to not initialized (this is a value not used
-                            // for m_holeListBuffer[ii].m_Hole_Diameter)
-    bool last_notplated_opt = false;
+    for( auto& list : lists->m_Lists )
+        toBuild.push_back( &list.second );
 
-    DRILL_TOOL new_tool( 0, false );
-    unsigned   jj;
+    THREAD_POOL::GetPool().ParallelFor( toBuild.size(),
+            [&]( size_t i )
+            {
+                buildToolList( *toBuild[i] );
+            },
+            1 );
 
-    for( unsigned ii = 0; ii < m_holeListBuffer.size(); ii++ )
+    m_holesLists = lists;
+}
+
+
+void GENDRILL_WRITER_BASE::buildHolesList( DRILL_LAYER_PAIR aLayerPair,
+                                           bool aGenerateNPTH_list )
+{
+    wxASSERT( aLayerPair.first < aLayerPair.second );  // fix the caller
+
+    // The lists are built once, unless the merge option changed
+    if( !m_holesLists || m_holesLists->m_Merge_PTH_NPTH != m_merge_PTH_NPTH )
+        buildAllHolesLists();
+
+    auto it = m_holesLists->m_Lists.find( std::make_pair( aLayerPair, aGenerateNPTH_list ) );
+
+    if( it == m_holesLists->m_Lists.end() )
     {
-        if( m_holeListBuffer[ii].m_Hole_Diameter != last_hole ||
-            m_holeListBuffer[ii].m_Hole_NotPlated != last_notplated_opt )
+        m_holeListBuffer.clear();
+        m_toolListBuffer.clear();
+        return;
+    }
+
+    m_holeListBuffer = it->second.m_Holes;
+    m_toolListBuffer = it->second.m_Tools;
+}
+
+
+std::vector<GENDRILL_WRITER_BASE::DRILL_FILE_JOB> GENDRILL_WRITER_BASE::getDrillFileJobs(
+        const wxString& aPlotDirectory, bool aGenDrill, bool aGenMap )
+{
+    std::vector<DRILL_FILE_JOB> jobs;
+    std::vector<DRILL_LAYER_PAIR> hole_sets = getUniqueLayerPairs();
+
+    // append a pair representing the NPTH set of holes, for separate drill files.
+    if( !m_merge_PTH_NPTH )
+        hole_sets.push_back( DRILL_LAYER_PAIR( F_Cu, B_Cu ) );
+
+    // The drill files, then the map files
+    for( int map = 0; map < 2; ++map )
+    {
+        if( map ? !aGenMap : !aGenDrill )
+            continue;
+
+        for( std::vector<DRILL_LAYER_PAIR>::const_iterator it = hole_sets.begin();
+             it != hole_sets.end();  ++it )
         {
-            new_tool.m_Diameter = m_holeListBuffer[ii].m_Hole_Diameter;
-            new_tool.m_Hole_NotPlated = m_holeListBuffer[ii].m_Hole_NotPlated;
-            m_toolListBuffer.push_back( new_tool );
-            last_hole = new_tool.m_Diameter;
-            last_notplated_opt = new_tool.m_Hole_NotPlated;
+            DRILL_FILE_JOB job;
+            job.m_Pair = *it;
+            // For separate drill files, the last layer pair is the NPTH drill file.
+            job.m_Npth = m_merge_PTH_NPTH ? false : ( it == hole_sets.end() - 1 );
+            job.m_Map = map;
+            job.m_Success = false;
+
+            buildHolesList( job.m_Pair, job.m_Npth );
+
+            // The file is created if it has holes, or if it is the non plated drill file
+            // to be sure the NPTH file is up to date in separate files mode.
+            if( getHolesCount() == 0 && !job.m_Npth )
+                continue;
+
+            wxFileName fn = getDrillFileName( job.m_Pair, job.m_Npth, m_merge_PTH_NPTH );
+            fn.SetPath( aPlotDirectory );
+
+            if( map )
+            {
+                fn.SetExt( wxEmptyString ); // Will be added by GenDrillMap
+                job.m_FileName = fn.GetFullPath() + wxT( "-drl_map" );
+                job.m_FileName << wxT(".") << GetDefaultPlotExtension( m_mapFileFmt );
+            }
+            else
+            {
+                job.m_FileName = fn.GetFullPath();
+            }
+
+            jobs.push_back( job );
         }
+    }
+
+    return jobs;
+}
 
-        jj = m_toolListBuffer.size();
 
-        if( jj == 0 )
-            continue;                                        // Should not occurs
+void GENDRILL_WRITER_BASE::reportDrillFileJobs( const std::vector<DRILL_FILE_JOB>& aJobs,
+                                                REPORTER* aReporter ) const
+{
+    if( !aReporter )
+        return;
 
-        m_holeListBuffer[ii].m_Tool_Reference = jj;          // Tool value Initialized (value >= 1)
+    wxString msg;
 
-        m_toolListBuffer.back().m_TotalCount++;
+    for( const DRILL_FILE_JOB& job : aJobs )
+    {
+        if( job.m_Success )
+            msg.Printf( _( "Create file %s\n" ), job.m_FileName );
+        else
+            msg.Printf( _( "** Unable to create %s **\n" ), job.m_FileName );
 
-        if( m_holeListBuffer[ii].m_Hole_Shape )
-            m_toolListBuffer.back().m_OvalCount++;
+        aReporter->Report( msg );
     }
 }
 
@@ -30,6 +30,8 @@
 #define GENDRILL_FILE_WRITER_BASE_H
 
 #include <vector>
+#include <map>
+#include <memory>
 
 class BOARD_ITEM;
 
@@ -117,6 +119,25 @@ public:
 
 typedef std::pair<PCB_LAYER_ID, PCB_LAYER_ID>   DRILL_LAYER_PAIR;
 
+/* the HOLES_LISTS class stores the sorted holes and the tools of every drill file of a board,
+ * built in one pass over the board
+ */
+class HOLES_LISTS
+{
+public:
+    struct HOLE_LIST
+    {
+        std::vector<HOLE_INFO>  m_Holes;    // sorted by tool
+        std::vector<DRILL_TOOL> m_Tools;
+    };
+
+    bool m_Merge_PTH_NPTH;                  // the merge option the lists were built with
+
+    // The lists, by layer pair and NPTH option
+    std::map<std::pair<DRILL_LAYER_PAIR, bool>, HOLE_LIST> m_Lists;
+};
+
+
 /**
  * GENDRILL_WRITER_BASE is a class to create drill maps and drill report,
  * and a helper class to created drill files.
@@ -146,6 +167,11 @@ protected:
     std::vector<HOLE_INFO>   m_holeListBuffer;          // Buffer containing holes
     std::vector<DRILL_TOOL>  m_toolListBuffer;          // Buffer containing tools
 
+    // The holes lists of all the drill files, built by the first call to buildHolesList().
+    // They are shared by the copies of the writer used to write several files at once.
+    // The board must not be modified during the life of the writer.
+    std::shared_ptr<const HOLES_LISTS> m_holesLists;
+
     PlotFormat               m_mapFileFmt;              // the format of the map drill file,
                                                         // if this map is needed
     const PAGE_INFO*         m_pageInfo;                // the page info used to plot drill maps
@@ -291,6 +317,35 @@ protected:
     void buildHolesList( DRILL_LAYER_PAIR aLayerPair,
                          bool aGenerateNPTH_list );
 
+    /**
+     * Build the holes lists of all the layer pairs in m_holesLists.  The board is walked
+     * once, and the lists are sorted and their tools built on the worker threads.
+     */
+    void buildAllHolesLists();
+
+    /// A file of the drill files set: the drill file or the map file of a holes set
+    struct DRILL_FILE_JOB
+    {
+        DRILL_LAYER_PAIR m_Pair;
+        bool             m_Npth;
+        bool             m_Map;         // true for a drill map, false for a drill file
+        wxString         m_FileName;
+        bool             m_Success;
+    };
+
+    /**
+     * @return the drill files and the map files to create in aPlotDirectory, for the holes
+     * sets having holes, and for the NPTH set in separate files mode
+     */
+    std::vector<DRILL_FILE_JOB> getDrillFileJobs( const wxString& aPlotDirectory,
+                                                  bool aGenDrill, bool aGenMap );
+
+    /**
+     * Report the files created by aJobs, and the files which could not be created
+     */
+    void reportDrillFileJobs( const std::vector<DRILL_FILE_JOB>& aJobs,
+                              REPORTER* aReporter ) const;
+
     int  getHolesCount() const { return m_holeListBuffer.size(); }
 
     /** Helper function.
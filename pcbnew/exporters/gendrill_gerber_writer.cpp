@@ -46,6 +46,7 @@
 #include <reporter.h>
 #include <gbr_metadata.h>
 #include <class_module.h>
+#include <thread_pool.h>
 
 
 GERBER_WRITER::GERBER_WRITER( BOARD* aPcb )
@@ -66,61 +67,29 @@ void GERBER_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
     // Note: In Gerber drill files, NPTH and PTH are always separate files
     m_merge_PTH_NPTH = false;
 
-    wxFileName  fn;
-    wxString    msg;
+    std::vector<DRILL_FILE_JOB> jobs = getDrillFileJobs( aPlotDirectory, aGenDrill, aGenMap );
 
-    std::vector<DRILL_LAYER_PAIR> hole_sets = getUniqueLayerPairs();
+    LOCALE_IO dummy;    // Use the standard notation for double numbers in all the threads
 
-    // append a pair representing the NPTH set of holes, for separate drill files.
-    // (Gerber drill files are separate files for PTH and NPTH)
-    hole_sets.push_back( DRILL_LAYER_PAIR( F_Cu, B_Cu ) );
-
-    for( std::vector<DRILL_LAYER_PAIR>::const_iterator it = hole_sets.begin();
-         it != hole_sets.end();  ++it )
-    {
-        DRILL_LAYER_PAIR  pair = *it;
-        // For separate drill files, the last layer pair is the NPTH drill file.
-        bool doing_npth = ( it == hole_sets.end() - 1 );
-
-        buildHolesList( pair, doing_npth );
+    // The files are written at once, each one by its own copy of the writer sharing the
+    // holes lists
+    THREAD_POOL::GetPool().ParallelFor( jobs.size(),
+            [&]( size_t i )
+            {
+                DRILL_FILE_JOB& job = jobs[i];
+                GERBER_WRITER writer( *this );
 
-        // The file is created if it has holes, or if it is the non plated drill file
-        // to be sure the NPTH file is up to date in separate files mode.
-        if( getHolesCount() > 0 || doing_npth )
-        {
-            fn = getDrillFileName( pair, doing_npth, false );
-            fn.SetPath( aPlotDirectory );
+                writer.buildHolesList( job.m_Pair, job.m_Npth );
 
-            if( aGenDrill )
-            {
-                wxString fullFilename = fn.GetFullPath();
-
-                int result = createDrillFile( fullFilename, doing_npth, pair );
-
-                if( result < 0 )
-                {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "** Unable to create %s **\n" ), fullFilename );
-                        aReporter->Report( msg );
-                    }
-                    break;
-                }
+                if( job.m_Map )
+                    job.m_Success = writer.genDrillMapFile( job.m_FileName, m_mapFileFmt );
                 else
-                {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "Create file %s\n" ), fullFilename );
-                        aReporter->Report( msg );
-                    }
-                }
-
-            }
-        }
-    }
+                    job.m_Success = writer.createDrillFile( job.m_FileName, job.m_Npth,
+                                                            job.m_Pair ) >= 0;
+            },
+            1 );
 
-    if( aGenMap )
-        CreateMapFilesSet( aPlotDirectory, aReporter );
+    reportDrillFileJobs( jobs, aReporter );
 }
 
 // A helper class to transform an oblong hole to a segment
@@ -24,6 +24,7 @@
  */
 
 #include <fctsys.h>
+#include <common.h>
 #include <confirm.h>
 #include <kicad_string.h>
 #include <gestfich.h>
@@ -48,9 +49,13 @@
 
 #include <class_board.h>
 #include <build_version.h>      // LEGACY_BOARD_FILE_VERSION
+#include <advanced_config.h>
 
 #include <wx/stdpaths.h>
 
+#include <chrono>
+#include <future>
+
 
 //#define     USE_INSTRUMENTATION     1
 #define     USE_INSTRUMENTATION     0
@@ -295,7 +300,14 @@ bool PCB_EDIT_FRAME::Files_io_from_id( int id )
 
     case ID_SAVE_BOARD:
         if( !GetBoard()->GetFileName().IsEmpty() )
-            return SavePcbFile( Prj().AbsolutePath( GetBoard()->GetFileName() ) );
+        {
+            wxString fileName = Prj().AbsolutePath( GetBoard()->GetFileName() );
+
+            if( ADVANCED_CFG::GetCfg().m_backgroundSave )
+                return SavePcbFileInBackground( fileName );
+            else
+                return SavePcbFile( fileName );
+        }
         // Fall through
 
     case ID_COPY_BOARD_AS:
@@ -407,6 +419,9 @@ bool PCB_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
 
     wxString fullFileName( aFileSet[0] );
 
+    // The background save reports to the current board
+    WaitBackgroundSave();
+
     // We insist on caller sending us an absolute path, if it does not, we say it's a bug.
     wxASSERT_MSG( wxFileName( fullFileName ).IsAbsolute(), wxT( "Path is not absolute!" ) );
 
@@ -664,6 +679,8 @@ bool PCB_EDIT_FRAME::SavePcbFile( const wxString& aFileName, bool aCreateBackupF
 {
     // please, keep it simple.  prompting goes elsewhere.
 
+    WaitBackgroundSave();
+
     wxFileName  pcbFileName = aFileName;
 
     if( pcbFileName.GetExt() == LegacyPcbFileExtension )
@@ -722,39 +739,199 @@ bool PCB_EDIT_FRAME::SavePcbFile( const wxString& aFileName, bool aCreateBackupF
         return false;
     }
 
-    GetBoard()->SetFileName( pcbFileName.GetFullPath() );
-    UpdateTitle();
-
     // Put the saved file in File History, unless aCreateBackupFile
     // is false.
     // aCreateBackupFile == false is mainly used to write autosave files
     // and not need to have an autosave file in file history
-    if( aCreateBackupFile )
+    onBoardFileSaved( pcbFileName, backupFileName, aCreateBackupFile );
+
+    GetScreen()->ClrModify();
+    GetScreen()->ClrSave();
+    return true;
+}
+
+
+void PCB_EDIT_FRAME::onBoardFileSaved( const wxFileName& aFileName,
+                                       const wxString& aBackupFileName, bool aUpdateFileHistory )
+{
+    GetBoard()->SetFileName( aFileName.GetFullPath() );
+    UpdateTitle();
+
+    if( aUpdateFileHistory )
         UpdateFileHistory( GetBoard()->GetFileName() );
 
     // Delete auto save file on successful save.
-    wxFileName autoSaveFileName = pcbFileName;
+    wxFileName autoSaveFileName = aFileName;
 
-    autoSaveFileName.SetName( GetAutoSaveFilePrefix() + pcbFileName.GetName() );
+    autoSaveFileName.SetName( GetAutoSaveFilePrefix() + aFileName.GetName() );
 
     if( autoSaveFileName.FileExists() )
         wxRemoveFile( autoSaveFileName.GetFullPath() );
 
-    if( !!backupFileName )
-        upperTxt.Printf( _( "Backup file: \"%s\"" ), GetChars( backupFileName ) );
+    wxString    upperTxt;
+    wxString    lowerTxt;
 
-    lowerTxt.Printf( _( "Wrote board file: \"%s\"" ), GetChars( pcbFileName.GetFullPath() ) );
+    if( !!aBackupFileName )
+        upperTxt.Printf( _( "Backup file: \"%s\"" ), GetChars( aBackupFileName ) );
+
+    lowerTxt.Printf( _( "Wrote board file: \"%s\"" ), GetChars( aFileName.GetFullPath() ) );
 
     AppendMsgPanel( upperTxt, lowerTxt, CYAN );
+}
+
+
+bool PCB_EDIT_FRAME::SavePcbFileInBackground( const wxString& aFileName, bool aCreateBackupFile )
+{
+    if( !WaitBackgroundSave() )
+        return false;
+
+    wxFileName  pcbFileName = aFileName;
+
+    if( pcbFileName.GetExt() == LegacyPcbFileExtension )
+        pcbFileName.SetExt( KiCadPcbFileExtension );
+
+    if( !IsWritable( pcbFileName ) )
+    {
+        wxString msg = wxString::Format( _(
+            "No access rights to write to file \"%s\"" ),
+            GetChars( pcbFileName.GetFullPath() )
+            );
+
+        DisplayError( this, msg );
+        return false;
+    }
+
+    wxASSERT( pcbFileName.IsAbsolute() );
+
+    GetBoard()->SynchronizeNetsAndNetClasses();
+
+    // Select default Netclass before writing file.
+    // Useful to save default values in headers
+    SetCurrentNetClass( NETCLASS::Default );
+
+    ClearMsgPanel();
+
+    wxString    lowerTxt;
+
+    // The copy is the only board read by the background thread.  The board is marked saved
+    // now: any later change marks it modified again.
+    std::shared_ptr<BOARD> copy( GetBoard()->CloneForSave() );
 
     GetScreen()->ClrModify();
     GetScreen()->ClrSave();
+
+    m_backgroundSaveFile = pcbFileName.GetFullPath();
+    m_backgroundSaveTmpFile = m_backgroundSaveFile + wxT( ".tmp" );
+    m_backgroundSaveBackup = aCreateBackupFile;
+
+    wxString tmpFileName = m_backgroundSaveTmpFile;
+
+    m_backgroundSave = std::async( std::launch::async,
+            [this, copy, tmpFileName]() -> wxString
+            {
+                wxString error;
+
+                // The C locale is set for this thread only: the UI thread keeps the user
+                // locale, and the LOCALE_IO of the plugin leaves the global locale alone.
+                THREAD_LOCALE_IO toggle;
+
+                try
+                {
+                    PLUGIN::RELEASER    pi( IO_MGR::PluginFind( IO_MGR::KICAD_SEXP ) );
+
+                    pi->Save( tmpFileName, copy.get(), NULL );
+                }
+                catch( const IO_ERROR& ioe )
+                {
+                    error = ioe.What();
+                }
+
+                // CallAfter() queues an event, which is thread safe.  The event is dropped
+                // if the frame is deleted first.
+                CallAfter( [this]()
+                           {
+                               finishBackgroundSave();
+                           } );
+
+                return error;
+            } );
+
+    lowerTxt.Printf( _( "Saving board file: \"%s\"" ), GetChars( m_backgroundSaveFile ) );
+    AppendMsgPanel( wxEmptyString, lowerTxt, CYAN );
+
     return true;
 }
 
 
+bool PCB_EDIT_FRAME::finishBackgroundSave()
+{
+    // The event queued by a save can come after another save was started
+    if( !m_backgroundSave.valid()
+            || m_backgroundSave.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready )
+    {
+        return true;
+    }
+
+    wxString error = m_backgroundSave.get();
+
+    ClearMsgPanel();
+
+    wxFileName  pcbFileName = m_backgroundSaveFile;
+    wxString    backupFileName;
+
+    if( error.IsEmpty() )
+    {
+        if( m_backgroundSaveBackup )
+            backupFileName = createBackupFile( m_backgroundSaveFile );
+
+        if( !wxRenameFile( m_backgroundSaveTmpFile, m_backgroundSaveFile, true ) )
+            error = wxString::Format( _( "Cannot rename \"%s\"." ), m_backgroundSaveTmpFile );
+    }
+
+    if( !error.IsEmpty() )
+    {
+        if( wxFileExists( m_backgroundSaveTmpFile ) )
+            wxRemoveFile( m_backgroundSaveTmpFile );
+
+        // The board was marked saved when the save started
+        GetScreen()->SetModify();
+
+        wxString msg = wxString::Format( _(
+                "Error saving board file \"%s\".\n%s" ),
+                GetChars( m_backgroundSaveFile ),
+                GetChars( error )
+                );
+        DisplayError( this, msg );
+
+        wxString lowerTxt;
+        lowerTxt.Printf( _( "Failed to create \"%s\"" ), GetChars( m_backgroundSaveFile ) );
+
+        AppendMsgPanel( wxEmptyString, lowerTxt, CYAN );
+
+        return false;
+    }
+
+    onBoardFileSaved( pcbFileName, backupFileName, m_backgroundSaveBackup );
+
+    return true;
+}
+
+
+bool PCB_EDIT_FRAME::WaitBackgroundSave()
+{
+    if( !m_backgroundSave.valid() )
+        return true;
+
+    m_backgroundSave.wait();
+
+    return finishBackgroundSave();
+}
+
+
 bool PCB_EDIT_FRAME::SavePcbCopy( const wxString& aFileName )
 {
+    WaitBackgroundSave();
+
     wxFileName  pcbFileName = aFileName;
 
     // Ensure the file ext is the right ext:
@@ -804,8 +981,44 @@ bool PCB_EDIT_FRAME::SavePcbCopy( const wxString& aFileName )
 }
 
 
+bool PCB_EDIT_FRAME::saveBoardSnapshot( const wxString& aFileName )
+{
+    GetBoard()->SynchronizeNetsAndNetClasses();
+
+    // Select default Netclass before writing file.
+    // Useful to save default values in headers
+    SetCurrentNetClass( NETCLASS::Default );
+
+    try
+    {
+        PLUGIN::RELEASER    pi( IO_MGR::PluginFind( IO_MGR::KICAD_SNAPSHOT ) );
+
+        pi->Save( aFileName, GetBoard(), NULL );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        wxString msg = wxString::Format( _(
+                "Error saving board file \"%s\".\n%s" ),
+                GetChars( aFileName ),
+                GetChars( ioe.What() )
+                );
+        DisplayError( this, msg );
+
+        return false;
+    }
+
+    wxLogTrace( traceAutoSave, "Wrote board snapshot <" + aFileName + ">" );
+
+    return true;
+}
+
+
 bool PCB_EDIT_FRAME::doAutoSave()
 {
+    // Do not wait for a background save: it writes the board anyway
+    if( m_backgroundSave.valid() )
+        return false;
+
     wxFileName tmpFileName;
 
     if( GetBoard()->GetFileName().IsEmpty() )
@@ -839,7 +1052,14 @@ bool PCB_EDIT_FRAME::doAutoSave()
 
     wxLogTrace( traceAutoSave, "Creating auto save file <" + autoSaveFileName.GetFullPath() + ">" );
 
-    if( SavePcbFile( autoSaveFileName.GetFullPath(), NO_BACKUP_FILE ) )
+    bool saved;
+
+    if( ADVANCED_CFG::GetCfg().m_snapshotAutoSave )
+        saved = saveBoardSnapshot( autoSaveFileName.GetFullPath() );
+    else
+        saved = SavePcbFile( autoSaveFileName.GetFullPath(), NO_BACKUP_FILE );
+
+    if( saved )
     {
         GetScreen()->SetModify();
         GetBoard()->SetFileName( tmpFileName.GetFullPath() );
@@ -163,6 +163,7 @@ FOOTPRINT_EDIT_FRAME::FOOTPRINT_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent,
 
     SetScreen( new PCB_SCREEN( GetPageSettings().GetSizeIU() ) );
     GetScreen()->SetMaxUndoItems( m_UndoRedoCountMax );
+    GetScreen()->SetMaxUndoMemory( m_UndoRedoMemoryMax );
 
     GetScreen()->AddGrid( m_UserGridSize, EDA_UNITS_T::UNSCALED_UNITS, ID_POPUP_GRID_USER );
     GetScreen()->SetGrid( ID_POPUP_GRID_LEVEL_1000 + m_LastGridSizeId );
@@ -696,8 +697,12 @@ void FOOTPRINT_EDIT_FRAME::SyncLibraryTree( bool aProgress )
     // Sync the LIB_TREE to the FOOTPRINT_INFO list
     adapter->Sync();
 
-    m_treePane->GetLibTree()->Unselect();
-    m_treePane->Regenerate();
+    // The rows of the changed footprints are patched when the tree view allows it
+    if( adapter->NotifySyncChanges() )
+    {
+        m_treePane->GetLibTree()->Unselect();
+        m_treePane->Regenerate();
+    }
 
     if( target.IsValid() )
     {
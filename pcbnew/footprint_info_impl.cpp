@@ -37,11 +37,17 @@
 #include <pgm_base.h>
 #include <wildcards_and_files_ext.h>
 #include <widgets/progress_reporter.h>
+#include <advanced_config.h>
+#include <thread_pool.h>
 
 #include <thread>
 #include <mutex>
 
 
+// The first line of the cache files, identifying their format
+static const wxString cacheFileFormat = wxT( "fp-info-cache 2" );
+
+
 void FOOTPRINT_INFO_IMPL::load()
 {
     FP_LIB_TABLE* fptable = m_owner->GetTable();
@@ -180,22 +186,58 @@ void FOOTPRINT_LIST_IMPL::StartWorkers( FP_LIB_TABLE* aTable, wxString const* aN
     m_loader = aLoader;
     m_lib_table = aTable;
 
+    int maxThreads = ADVANCED_CFG::GetCfg().m_maxLibraryLoadThreads;
+
+    if( maxThreads > 0 )
+        aNThreads = std::min<unsigned>( aNThreads, maxThreads );
+
     // Clear data before reading files
     m_count_finished.store( 0 );
     m_errors.clear();
-    m_list.clear();
     m_threads.clear();
     m_queue_in.clear();
     m_queue_out.clear();
 
+    std::vector<wxString> nicknames;
+
     if( aNickname )
-        m_queue_in.push( *aNickname );
+        nicknames.push_back( *aNickname );
     else
+        nicknames = aTable->GetLogicalLibs();
+
+    // Only read the libraries which changed since they were read (or loaded from the
+    // cache file), and keep the footprints of the others
+    std::map<wxString, long long> unchanged;
+
+    m_read_timestamps.clear();
+
+    for( auto const& nickname : nicknames )
     {
-        for( auto const& nickname : aTable->GetLogicalLibs() )
+        long long timestamp = aTable->GenerateTimestamp( &nickname );
+        auto      it = m_lib_timestamps.find( nickname );
+
+        if( it != m_lib_timestamps.end() && it->second == timestamp )
+        {
+            unchanged[nickname] = timestamp;
+        }
+        else
+        {
+            m_read_timestamps[nickname] = timestamp;
             m_queue_in.push( nickname );
+        }
+    }
+
+    FPILIST kept;
+
+    for( auto& fpinfo : m_list )
+    {
+        if( unchanged.count( fpinfo->GetLibNickname() ) )
+            kept.push_back( std::move( fpinfo ) );
     }
 
+    m_list.swap( kept );
+    m_lib_timestamps.swap( unchanged );
+
     m_loader->m_total_libs = m_queue_in.size();
 
     for( unsigned i = 0; i < aNThreads; ++i )
@@ -251,7 +293,12 @@ bool FOOTPRINT_LIST_IMPL::JoinWorkers()
     SYNC_QUEUE<std::unique_ptr<FOOTPRINT_INFO>> queue_parsed;
     std::vector<std::thread>                    threads;
 
-    for( size_t ii = 0; ii < std::thread::hardware_concurrency() + 1; ++ii )
+    // One more thread than the pool, as the threads also wait for the files
+    int    maxThreads = ADVANCED_CFG::GetCfg().m_maxLibraryLoadThreads;
+    size_t threadCount = maxThreads > 0 ? maxThreads
+                                        : THREAD_POOL::GetPool().GetThreadCount() + 1;
+
+    for( size_t ii = 0; ii < threadCount; ++ii )
     {
         threads.push_back( std::thread( [this, &queue_parsed]() {
             wxString nickname;
@@ -313,6 +360,12 @@ bool FOOTPRINT_LIST_IMPL::JoinWorkers()
     while( queue_parsed.pop( fpi ) )
         m_list.push_back( std::move( fpi ) );
 
+    // The libraries read completely are now up to date
+    if( !m_cancelled )
+        m_lib_timestamps.insert( m_read_timestamps.begin(), m_read_timestamps.end() );
+
+    m_read_timestamps.clear();
+
     std::sort( m_list.begin(), m_list.end(), []( std::unique_ptr<FOOTPRINT_INFO> const& lhs,
                                                  std::unique_ptr<FOOTPRINT_INFO> const& rhs ) -> bool
                                              {
@@ -339,6 +392,14 @@ FOOTPRINT_LIST_IMPL::~FOOTPRINT_LIST_IMPL()
 }
 
 
+long long FOOTPRINT_LIST_IMPL::GetLibraryTimestamp( const wxString& aNickname ) const
+{
+    auto it = m_lib_timestamps.find( aNickname );
+
+    return it == m_lib_timestamps.end() ? 0 : it->second;
+}
+
+
 void FOOTPRINT_LIST_IMPL::WriteCacheToFile( wxTextFile* aCacheFile )
 {
     if( aCacheFile->Exists() )
@@ -351,8 +412,17 @@ void FOOTPRINT_LIST_IMPL::WriteCacheToFile( wxTextFile* aCacheFile )
         aCacheFile->Create();
     }
 
+    aCacheFile->AddLine( cacheFileFormat );
     aCacheFile->AddLine( wxString::Format( "%lld", m_list_timestamp ) );
 
+    aCacheFile->AddLine( wxString::Format( "%u", (unsigned) m_lib_timestamps.size() ) );
+
+    for( auto& lib : m_lib_timestamps )
+    {
+        aCacheFile->AddLine( lib.first );
+        aCacheFile->AddLine( wxString::Format( "%lld", lib.second ) );
+    }
+
     for( auto& fpinfo : m_list )
     {
         aCacheFile->AddLine( fpinfo->GetLibNickname() );
@@ -373,14 +443,29 @@ void FOOTPRINT_LIST_IMPL::ReadCacheFromFile( wxTextFile* aCacheFile )
 {
     m_list_timestamp = 0;
     m_list.clear();
+    m_lib_timestamps.clear();
 
     try
     {
         if( aCacheFile->Exists() )
-        {
             aCacheFile->Open();
 
-            aCacheFile->GetFirstLine().ToLongLong( &m_list_timestamp );
+        // A cache file of an older format is just ignored: it has no library timestamps
+        if( aCacheFile->IsOpened() && aCacheFile->GetFirstLine() == cacheFileFormat )
+        {
+            aCacheFile->GetNextLine().ToLongLong( &m_list_timestamp );
+
+            unsigned long libCount = 0;
+            aCacheFile->GetNextLine().ToULong( &libCount );
+
+            for( unsigned long ii = 0; ii < libCount; ++ii )
+            {
+                wxString  libNickname = aCacheFile->GetNextLine();
+                long long timestamp = 0;
+
+                aCacheFile->GetNextLine().ToLongLong( &timestamp );
+                m_lib_timestamps[libNickname] = timestamp;
+            }
 
             while( aCacheFile->GetCurrentLine() + 6 < aCacheFile->GetLineCount() )
             {
@@ -402,11 +487,16 @@ void FOOTPRINT_LIST_IMPL::ReadCacheFromFile( wxTextFile* aCacheFile )
     {
         // whatever went wrong, invalidate the cache
         m_list_timestamp = 0;
+        m_list.clear();
+        m_lib_timestamps.clear();
     }
 
     // Sanity check: an empty list is very unlikely to be correct.
     if( m_list.size() == 0 )
+    {
         m_list_timestamp = 0;
+        m_lib_timestamps.clear();
+    }
 
     if( aCacheFile->IsOpened() )
         aCacheFile->Close();
@@ -22,6 +22,7 @@
 
 #include <atomic>
 #include <functional>
+#include <map>
 #include <memory>
 #include <thread>
 #include <vector>
@@ -39,6 +40,7 @@ public:
     {
         m_nickname = aNickname;
         m_fpname = aFootprintName;
+        setFilterKeys();
         m_num = 0;
         m_pad_count = 0;
         m_unique_pad_count = 0;
@@ -55,6 +57,7 @@ public:
     {
         m_nickname = aNickname;
         m_fpname = aFootprintName;
+        setFilterKeys();
         m_num = aOrderNum;
         m_pad_count = aPadCount;
         m_unique_pad_count = aUniquePadCount;
@@ -93,6 +96,13 @@ class FOOTPRINT_LIST_IMPL : public FOOTPRINT_LIST
     std::atomic_bool         m_cancelled;
     std::mutex               m_join;
 
+    ///> The timestamps of the libraries whose footprints are in m_list, when they were read.
+    ///> The libraries whose timestamp did not change since are not read again.
+    std::map<wxString, long long> m_lib_timestamps;
+
+    ///> The timestamps of the libraries being read by the workers
+    std::map<wxString, long long> m_read_timestamps;
+
     /**
      * Call aFunc, pushing any IO_ERRORs and std::exceptions it throws onto m_errors.
      *
@@ -120,6 +130,13 @@ public:
     void WriteCacheToFile( wxTextFile* aFile ) override;
     void ReadCacheFromFile( wxTextFile* aFile ) override;
 
+    /**
+     * @return the timestamp of the library \a aNickname when its footprints in the list were
+     *         read, or 0 if they were not read.  The footprints of the library in the list
+     *         don't change while it stays the same.
+     */
+    long long GetLibraryTimestamp( const wxString& aNickname ) const;
+
     bool ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxString* aNickname = nullptr,
                              PROGRESS_REPORTER* aProgressReporter = nullptr ) override;
 };
@@ -30,6 +30,7 @@
 #include <class_module.h>
 #include <class_board.h>
 #include <mutex>
+#include <condition_variable>
 #include <eda_draw_frame.h>
 #include <utility>
 #include <make_unique.h>
@@ -40,6 +41,14 @@
 #include <painter.h>
 #include <pcbnew_id.h>
 
+/// The count of footprints kept loaded, the most recently shown ones
+static const size_t FP_CACHE_SIZE = 32;
+
+/// The count of footprints waiting to be loaded.  When scrolling through a library, the
+/// footprints left before they were loaded are dropped from the queue.
+static const size_t FP_QUEUE_SIZE = 4;
+
+
 /**
  * Threadsafe interface class between loader thread and panel class.
  */
@@ -48,21 +57,31 @@ class FP_THREAD_IFACE
     using CACHE_ENTRY = FOOTPRINT_PREVIEW_PANEL::CACHE_ENTRY;
 
     public:
-        /// Retrieve a cache entry by LIB_ID
+        ~FP_THREAD_IFACE()
+        {
+            for( auto& ent : m_cachedFootprints )
+                delete ent.second.module;
+        }
+
+        /// Retrieve a cache entry by LIB_ID, and mark it as recently used
         OPT<CACHE_ENTRY> GetFromCache( LIB_ID const & aFPID )
         {
             std::lock_guard<std::mutex> lock( m_lock );
             auto it = m_cachedFootprints.find( aFPID );
 
             if( it != m_cachedFootprints.end() )
+            {
+                m_lastUse[aFPID] = ++m_useCount;
                 return it->second;
+            }
             else
                 return NULLOPT;
         }
 
         /**
          * Push an entry to the loading queue and a placeholder to the cache;
-         * return the placeholder.
+         * return the placeholder.  The last pushed entry is loaded first, and the
+         * oldest entries are dropped when the queue is full.
          */
         CACHE_ENTRY AddToQueue( LIB_ID const & aEntry )
         {
@@ -70,17 +89,41 @@ class FP_THREAD_IFACE
 
             CACHE_ENTRY ent = { aEntry, NULL, FPS_LOADING };
             m_cachedFootprints[aEntry] = ent;
-            m_loaderQueue.push_back( ent );
+            m_lastUse[aEntry] = ++m_useCount;
+            m_loaderQueue.push_front( ent );
+
+            size_t ii = m_loaderQueue.size();
+
+            while( ii > 0 && m_loaderQueue.size() > FP_QUEUE_SIZE )
+            {
+                LIB_ID fpid = m_loaderQueue[--ii].fpid;
+
+                if( fpid == m_current_fp )
+                    continue;
+
+                m_cachedFootprints.erase( fpid );
+                m_lastUse.erase( fpid );
+                m_loaderQueue.erase( m_loaderQueue.begin() + ii );
+            }
+
+            m_queueChanged.notify_one();
 
             return ent;
         }
 
-        /// Pop an entry from the queue, or empty option if none is available.
+        /**
+         * Pop an entry from the queue, waiting for one if needed.  Return an empty option
+         * when the panel is gone.
+         */
         OPT<CACHE_ENTRY> PopFromQueue()
         {
-            std::lock_guard<std::mutex> lock( m_lock );
+            std::unique_lock<std::mutex> lock( m_lock );
+
+            m_queueChanged.wait( lock, [this]() {
+                return !m_loaderQueue.empty() || !m_panel;
+            } );
 
-            if( m_loaderQueue.empty() )
+            if( !m_panel )
             {
                 return NULLOPT;
             }
@@ -96,7 +139,68 @@ class FP_THREAD_IFACE
         void AddToCache( CACHE_ENTRY const & aEntry )
         {
             std::lock_guard<std::mutex> lock( m_lock );
+
+            auto it = m_cachedFootprints.find( aEntry.fpid );
+
+            // A footprint dropped from the queue while loading can be loaded twice: keep
+            // the first one, which may be displayed already.
+            if( it != m_cachedFootprints.end() && it->second.status != FPS_LOADING )
+            {
+                if( it->second.module != aEntry.module )
+                    delete aEntry.module;
+
+                return;
+            }
+
             m_cachedFootprints[aEntry.fpid] = aEntry;
+
+            if( !m_lastUse.count( aEntry.fpid ) )
+                m_lastUse[aEntry.fpid] = ++m_useCount;
+        }
+
+        /**
+         * Remove the least recently used footprints from the cache, but the current and the
+         * displayed ones, to keep FP_CACHE_SIZE of them.  The removed modules are returned,
+         * to be deleted by the panel: they may still be in its view.
+         */
+        std::vector<MODULE*> TrimCache( MODULE* aDisplayed )
+        {
+            std::lock_guard<std::mutex> lock( m_lock );
+            std::vector<MODULE*> removed;
+
+            while( m_cachedFootprints.size() > FP_CACHE_SIZE )
+            {
+                auto oldest = m_cachedFootprints.end();
+                unsigned long long oldestUse = 0;
+
+                for( auto it = m_cachedFootprints.begin(); it != m_cachedFootprints.end(); ++it )
+                {
+                    const CACHE_ENTRY& ent = it->second;
+
+                    if( ent.status == FPS_LOADING || ent.fpid == m_current_fp
+                            || ( ent.module && ent.module == aDisplayed ) )
+                        continue;
+
+                    unsigned long long use = m_lastUse[it->first];
+
+                    if( oldest == m_cachedFootprints.end() || use < oldestUse )
+                    {
+                        oldest = it;
+                        oldestUse = use;
+                    }
+                }
+
+                if( oldest == m_cachedFootprints.end() )
+                    break;
+
+                if( oldest->second.module )
+                    removed.push_back( oldest->second.module );
+
+                m_lastUse.erase( oldest->first );
+                m_cachedFootprints.erase( oldest );
+            }
+
+            return removed;
         }
 
         /**
@@ -118,12 +222,14 @@ class FP_THREAD_IFACE
         }
 
         /**
-         * Set the associated panel, for QueueEvent() and GetTable().
+         * Set the associated panel, for QueueEvent() and GetTable().  Clearing it stops
+         * the loader thread.
          */
         void SetPanel( FOOTPRINT_PREVIEW_PANEL* aPanel )
         {
             std::lock_guard<std::mutex> lock( m_lock );
             m_panel = aPanel;
+            m_queueChanged.notify_all();
         }
 
         /**
@@ -166,9 +272,12 @@ class FP_THREAD_IFACE
     private:
         std::deque<CACHE_ENTRY> m_loaderQueue;
         std::map<LIB_ID, CACHE_ENTRY> m_cachedFootprints;
+        std::map<LIB_ID, unsigned long long> m_lastUse;    ///< the last use of each entry
+        unsigned long long m_useCount = 0;
         LIB_ID m_current_fp;
         FOOTPRINT_PREVIEW_PANEL* m_panel = nullptr;
         std::mutex m_lock;
+        std::condition_variable m_queueChanged;
 };
 
 
@@ -229,15 +338,8 @@ public:
 
     virtual void* Entry() override
     {
-        while( m_iface->GetPanel() )
-        {
-            auto ent = m_iface->PopFromQueue();
-
-            if( ent )
-                ProcessEntry( *ent );
-            else
-                wxMilliSleep( 100 );
-        }
+        while( auto ent = m_iface->PopFromQueue() )
+            ProcessEntry( *ent );
 
         return nullptr;
     }
@@ -250,7 +352,8 @@ FOOTPRINT_PREVIEW_PANEL::FOOTPRINT_PREVIEW_PANEL( KIWAY* aKiway, wxWindow* aPare
     : PCB_DRAW_PANEL_GAL ( aParent, -1, wxPoint( 0, 0 ), wxSize(200, 200), *aOpts, aGalType  ),
       KIWAY_HOLDER( aKiway, KIWAY_HOLDER::PANEL ),
       m_DisplayOptions( std::move( aOpts ) ),
-      m_footprintDisplayed( true )
+      m_footprintDisplayed( true ),
+      m_displayedModule( nullptr )
 {
     m_iface = std::make_shared<FP_THREAD_IFACE>();
     m_iface->SetPanel( this );
@@ -278,6 +381,8 @@ FOOTPRINT_PREVIEW_PANEL::FOOTPRINT_PREVIEW_PANEL( KIWAY* aKiway, wxWindow* aPare
 
 FOOTPRINT_PREVIEW_PANEL::~FOOTPRINT_PREVIEW_PANEL( )
 {
+    // The cached modules are deleted with the interface, maybe after the view
+    GetView()->Clear();
     m_iface->SetPanel( nullptr );
 }
 
@@ -288,8 +393,13 @@ FOOTPRINT_PREVIEW_PANEL::CACHE_ENTRY FOOTPRINT_PREVIEW_PANEL::CacheAndReturn( co
 
     if( opt_ent )
         return *opt_ent;
-    else
-        return m_iface->AddToQueue( aFPID );
+
+    CACHE_ENTRY ent = m_iface->AddToQueue( aFPID );
+
+    for( MODULE* module : m_iface->TrimCache( m_displayedModule ) )
+        delete module;
+
+    return ent;
 }
 
 
@@ -342,6 +452,7 @@ void FOOTPRINT_PREVIEW_PANEL::DisplayFootprint ( const LIB_ID& aFPID )
         if ( !m_footprintDisplayed )
         {
             renderFootprint( fpe.module );
+            m_displayedModule = fpe.module;
             m_footprintDisplayed = true;
             Refresh();
         }
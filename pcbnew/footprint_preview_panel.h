@@ -104,6 +104,7 @@ private:
 
     LIB_ID      m_currentFPID;
     bool        m_footprintDisplayed;
+    MODULE*     m_displayedModule;      ///< the module in the view, owned by the cache
 };
 
 #endif
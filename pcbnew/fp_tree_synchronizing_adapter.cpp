@@ -65,6 +65,9 @@ bool FP_TREE_SYNCHRONIZING_ADAPTER::IsContainer( const wxDataViewItem& aItem ) c
 
 void FP_TREE_SYNCHRONIZING_ADAPTER::Sync()
 {
+    InvalidateSearchIndex();
+    beginSyncChanges();
+
     // Process already stored libraries
     for( auto it = m_tree.Children.begin(); it != m_tree.Children.end();   )
     {
@@ -76,7 +79,15 @@ void FP_TREE_SYNCHRONIZING_ADAPTER::Sync()
             continue;
         }
 
-        updateLibrary( *(LIB_TREE_NODE_LIB*) it->get() );
+        // Only the libraries read again since the last sync have changed
+        auto timestampIt = m_libTimestamps.find( name );
+
+        if( timestampIt == m_libTimestamps.end()
+                || timestampIt->second != GFootprintList.GetLibraryTimestamp( name ) )
+        {
+            updateLibrary( *(LIB_TREE_NODE_LIB*) it->get() );
+        }
+
         ++it;
     }
 
@@ -91,6 +102,8 @@ void FP_TREE_SYNCHRONIZING_ADAPTER::Sync()
 
             DoAddLibrary( libName, library->GetDescr(), getFootprints( libName ), true );
             m_libMap.insert( libName  );
+            m_libTimestamps[libName] = GFootprintList.GetLibraryTimestamp( libName );
+            nodeAdded();
         }
     }
 
@@ -108,40 +121,54 @@ int FP_TREE_SYNCHRONIZING_ADAPTER::GetLibrariesCount() const
 void FP_TREE_SYNCHRONIZING_ADAPTER::updateLibrary( LIB_TREE_NODE_LIB& aLibNode )
 {
     std::vector<LIB_TREE_ITEM*> footprints = getFootprints( aLibNode.Name );
+    std::vector<char>           matched( footprints.size(), 0 );
 
-    // remove the common part from the footprints list
+    // flag the common part of the footprints list
     for( auto nodeIt = aLibNode.Children.begin(); nodeIt != aLibNode.Children.end();  )
     {
         // Since the list is sorted we can use a binary search to speed up searches within
         // libraries with lots of footprints.
-        FOOTPRINT_INFO_IMPL dummy( wxEmptyString, (*nodeIt)->Name );
-        auto footprintIt = std::lower_bound( footprints.begin(), footprints.end(), &dummy,
-            []( LIB_TREE_ITEM* a, LIB_TREE_ITEM* b )
+        const wxString& name = (*nodeIt)->Name;
+        auto footprintIt = std::lower_bound( footprints.begin(), footprints.end(), name,
+            []( LIB_TREE_ITEM* a, const wxString& b )
             {
-                return StrNumCmp( a->GetName(), b->GetName(), false ) < 0;
+                return StrNumCmp( a->GetName(), b, false ) < 0;
             } );
 
-        if( footprintIt != footprints.end() && dummy.GetName() == (*footprintIt)->GetName() )
+        size_t index = footprintIt - footprints.begin();
+
+        if( footprintIt != footprints.end() && name == (*footprintIt)->GetName()
+                && !matched[index] )
         {
             // footprint exists both in the lib tree and the footprint info list; just
             // update the node data
             static_cast<LIB_TREE_NODE_LIB_ID*>( nodeIt->get() )->Update( *footprintIt );
-            footprints.erase( footprintIt );
+            nodeChanged( nodeIt->get() );
+            matched[index] = 1;
             ++nodeIt;
         }
         else
         {
             // node does not exist in the library manager, remove the corresponding node
-            nodeIt = aLibNode.Children.erase( nodeIt );
+            nodeIt = detachNode( aLibNode.Children, nodeIt );
+        }
+    }
+
+    // the footprints not flagged are new aliases that need to be added to the tree
+    for( size_t ii = 0; ii < footprints.size(); ++ii )
+    {
+        if( !matched[ii] )
+        {
+            aLibNode.AddItem( footprints[ii] );
+            nodeAdded();
         }
     }
 
-    // now the footprint list contains only new aliases that need to be added to the tree
-    for( auto footprint : footprints )
-        aLibNode.AddItem( footprint );
+    nodeChanged( &aLibNode );
 
     aLibNode.AssignIntrinsicRanks();
     m_libMap.insert( aLibNode.Name );
+    m_libTimestamps[aLibNode.Name] = GFootprintList.GetLibraryTimestamp( aLibNode.Name );
 }
 
 
@@ -150,8 +177,8 @@ LIB_TREE_NODE::PTR_VECTOR::iterator FP_TREE_SYNCHRONIZING_ADAPTER::deleteLibrary
 {
     LIB_TREE_NODE* node = aLibNodeIt->get();
     m_libMap.erase( node->Name );
-    auto it = m_tree.Children.erase( aLibNodeIt );
-    return it;
+    m_libTimestamps.erase( node->Name );
+    return detachNode( m_tree.Children, aLibNodeIt );
 }
 
 
@@ -195,7 +222,7 @@ void FP_TREE_SYNCHRONIZING_ADAPTER::GetValue( wxVariant& aVariant, wxDataViewIte
             aVariant = mod->GetDescription();
         }
         else
-            aVariant = node->Desc;
+            aVariant = node->Desc.wx_str();
         break;
 
     default:    // column == -1 is used for default Compare function
@@ -26,6 +26,7 @@
 #define FP_TREE_SYNCHRONIZING_ADAPTER_H
 
 #include <fp_tree_model_adapter.h>
+#include <map>
 #include <set>
 
 class FOOTPRINT_EDIT_FRAME;
@@ -58,6 +59,9 @@ protected:
 protected:
     FOOTPRINT_EDIT_FRAME*  m_frame;
     std::set<wxString>     m_libMap;   // Set to indicate libraries currently in tree
+
+    ///> The timestamps of the footprints of the libraries in the tree, when they were synced
+    std::map<wxString, long long> m_libTimestamps;
 };
 
 #endif /* FP_TREE_SYNCHRONIZING_ADAPTER_H */
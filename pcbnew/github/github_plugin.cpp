@@ -78,6 +78,10 @@ Vary: Accept-Encoding
 #include <wx/zipstrm.h>
 #include <wx/mstream.h>
 #include <wx/uri.h>
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/stdpaths.h>
+#include <wx/tokenzr.h>
 
 #include <fctsys.h>
 
@@ -97,6 +101,8 @@ using namespace std;
 
 static const char* PRETTY_DIR = "allow_pretty_writing_to_this_dir";
 
+static const wxString ZIP_CACHE_VALIDATORS_EXT = wxT( "validators" );
+
 
 typedef boost::ptr_map< wxString, wxZipEntry >  MODULE_MAP;
 typedef MODULE_MAP::iterator                    MODULE_ITER;
@@ -549,6 +555,143 @@ bool GITHUB_PLUGIN::repoURL_zipURL( const wxString& aRepoURL, std::string* aZipU
 }
 
 
+/**
+ * Function zipCacheDir
+ * returns the directory of the downloaded zip files, created if needed, or an empty
+ * string if it cannot be created:
+ *
+ * 1. OSX: ~/Library/Caches/kicad/github/
+ * 2. Linux: ${XDG_CACHE_HOME}/kicad/github ~/.cache/kicad/github/
+ * 3. MSWin: AppData\Local\kicad\github
+ */
+static const wxString& zipCacheDir()
+{
+    static const wxString dir = []()
+    {
+        wxString cacheDir;
+
+#if defined(_WIN32)
+        wxStandardPaths::Get().UseAppInfo( wxStandardPaths::AppInfo_None );
+        cacheDir = wxStandardPaths::Get().GetUserLocalDataDir();
+        cacheDir.append( "\\kicad\\github" );
+#elif defined(__APPLE)
+        cacheDir = "${HOME}/Library/Caches/kicad/github";
+#else   // assume Linux
+        cacheDir = ExpandEnvVarSubstitutions( "${XDG_CACHE_HOME}" );
+
+        if( cacheDir.empty() || cacheDir == "${XDG_CACHE_HOME}" )
+            cacheDir = "${HOME}/.cache";
+
+        cacheDir.append( "/kicad/github" );
+#endif
+
+        wxFileName fn( ExpandEnvVarSubstitutions( cacheDir ), "" );
+
+        if( !fn.DirExists() && !fn.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+            return wxString();
+
+        return fn.GetPathWithSep();
+    }();
+
+    return dir;
+}
+
+
+/**
+ * Function zipCacheFileName
+ * returns the name of the cached copy of the zip file at aZipURL, without extension,
+ * or an empty string if there is no cache directory.
+ */
+static wxString zipCacheFileName( const std::string& aZipURL )
+{
+    if( zipCacheDir().IsEmpty() )
+        return wxEmptyString;
+
+    // Keep the URL readable in the file name: "https://codeload.github.com/KiCad/
+    // Resistors_SMD.pretty/zip/master" is cached as "codeload.github.com_KiCad_..."
+    wxString name = FROM_UTF8( aZipURL.c_str() ).AfterFirst( ':' );
+
+    for( wxString::iterator it = name.begin(); it != name.end(); ++it )
+    {
+        if( !wxIsalnum( *it ) && *it != '.' && *it != '-' )
+            *it = '_';
+    }
+
+    while( name.StartsWith( "_" ) )     // the "//" after the scheme
+        name.Remove( 0, 1 );
+
+    return zipCacheDir() + name;
+}
+
+
+/**
+ * Function readCachedZip
+ * reads the cached copy of a zip file, and the ETag and Last-Modified headers it was
+ * received with.
+ * @return bool - true if a cached copy was found
+ */
+static bool readCachedZip( const wxString& aCacheName, std::string& aImage,
+                           std::string& aETag, std::string& aLastModified )
+{
+    wxFFile zip( aCacheName + ".zip", "rb" );
+
+    if( !zip.IsOpened() || zip.Length() <= 0 )
+        return false;
+
+    aImage.resize( zip.Length() );
+
+    if( zip.Read( &aImage[0], aImage.size() ) != aImage.size() )
+    {
+        aImage.clear();
+        return false;
+    }
+
+    wxFFile  validators( aCacheName + "." + ZIP_CACHE_VALIDATORS_EXT, "rb" );
+    wxString text;
+
+    if( validators.IsOpened() && validators.ReadAll( &text, wxConvUTF8 ) )
+    {
+        wxStringTokenizer lines( text, "\n", wxTOKEN_RET_EMPTY );
+
+        aETag = TO_UTF8( lines.GetNextToken() );
+        aLastModified = TO_UTF8( lines.GetNextToken() );
+    }
+
+    return true;
+}
+
+
+/**
+ * Function writeCachedZip
+ * stores a zip file, and the ETag and Last-Modified headers it was received with.  Several
+ * plugins can download the same library: the files are written under a temporary name,
+ * then renamed.
+ */
+static void writeCachedZip( const wxString& aCacheName, const std::string& aImage,
+                            const std::string& aETag, const std::string& aLastModified )
+{
+    auto write = [&]( const wxString& aFileName, const char* aData, size_t aSize )
+    {
+        wxString tmpName = wxFileName::CreateTempFileName( aCacheName );
+        wxFFile  file;
+
+        if( tmpName.IsEmpty() || !file.Open( tmpName, "wb" ) )
+            return;
+
+        bool ok = file.Write( aData, aSize ) == aSize;
+        ok = file.Close() && ok;
+
+        if( !ok || !wxRenameFile( tmpName, aFileName, true ) )
+            wxRemoveFile( tmpName );
+    };
+
+    std::string validators = aETag + "\n" + aLastModified + "\n";
+
+    write( aCacheName + ".zip", aImage.data(), aImage.size() );
+    write( aCacheName + "." + ZIP_CACHE_VALIDATORS_EXT, validators.data(), validators.size() );
+}
+
+
 void GITHUB_PLUGIN::remoteGetZip( const wxString& aRepoURL )
 {
     std::string  zip_url;
@@ -562,6 +705,13 @@ void GITHUB_PLUGIN::remoteGetZip( const wxString& aRepoURL )
         THROW_IO_ERROR( msg );
     }
 
+    wxString    cache_name = zipCacheFileName( zip_url );
+    std::string cached_image;
+    std::string etag;
+    std::string last_modified;
+    bool        cached = !cache_name.IsEmpty()
+                         && readCachedZip( cache_name, cached_image, etag, last_modified );
+
     wxLogDebug( wxT( "Attempting to download: " ) + zip_url );
 
     KICAD_CURL_EASY kcurl;      // this can THROW_IO_ERROR
@@ -571,13 +721,27 @@ void GITHUB_PLUGIN::remoteGetZip( const wxString& aRepoURL )
     kcurl.SetHeader( "Accept", "application/zip" );
     kcurl.SetFollowRedirects( true );
 
+    // Only get the zip file if it is not the cached copy
+    if( cached && !etag.empty() )
+        kcurl.SetHeader( "If-None-Match", etag );
+
+    if( cached && !last_modified.empty() )
+        kcurl.SetHeader( "If-Modified-Since", last_modified );
+
     try
     {
         kcurl.Perform();
-        m_zip_image = kcurl.GetBuffer();
     }
     catch( const IO_ERROR& ioe )
     {
+        // Work offline with the cached copy
+        if( cached )
+        {
+            wxLogDebug( wxT( "Using the cached copy of: " ) + zip_url );
+            m_zip_image.swap( cached_image );
+            return;
+        }
+
         // https "GET" has failed, report this to API caller.
         // Note: kcurl.Perform() does not return an error if the file to download is not found
         static const char errorcmd[] = "http GET command failed";  // Do not translate this message
@@ -594,6 +758,14 @@ void GITHUB_PLUGIN::remoteGetZip( const wxString& aRepoURL )
         THROW_IO_ERROR( msg );
     }
 
+    if( cached && kcurl.GetResponseCode() == 304 )     // Not Modified
+    {
+        m_zip_image.swap( cached_image );
+        return;
+    }
+
+    m_zip_image = kcurl.GetBuffer();
+
     // If the zip archive is not existing, the received data is "Not Found" or "404: Not Found",
     // and no error is returned by kcurl.Perform().
     if( ( m_zip_image.compare( 0, 9, "Not Found", 9 ) == 0 ) ||
@@ -604,6 +776,12 @@ void GITHUB_PLUGIN::remoteGetZip( const wxString& aRepoURL )
 
         THROW_IO_ERROR( msg );
     }
+
+    if( !cache_name.IsEmpty() && kcurl.GetResponseCode() == 200 )
+    {
+        writeCachedZip( cache_name, m_zip_image, kcurl.GetResponseHeader( "ETag" ),
+                        kcurl.GetResponseHeader( "Last-Modified" ) );
+    }
 }
 
 #if 0 && defined(STANDALONE)
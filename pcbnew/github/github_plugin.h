@@ -222,6 +222,11 @@ protected:
      * fetches a zip file image from a github repo synchronously.  The byte image
      * is received into the m_input_stream. If the image has already been stored,
      * do nothing.
+     *
+     * The zip files are kept in the user cache directory, along with their ETag and
+     * Last-Modified headers: the request is conditional, and the server does not send
+     * the zip file again if it did not change.  The cached copy is also used when the
+     * server cannot be reached.
      */
     void remoteGetZip( const wxString& aRepoURL );
 
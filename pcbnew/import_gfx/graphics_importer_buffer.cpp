@@ -24,6 +24,8 @@
 
 #include "graphics_importer_buffer.h"
 
+#include <cmath>
+
 using namespace std;
 
 template <typename T, typename... Args>
@@ -32,28 +34,65 @@ static std::unique_ptr<T> make_shape( const Args&... aArguments )
     return std::unique_ptr<T>( new T( aArguments... ) );
 }
 
+constexpr double IMPORTED_LINE::MERGE_TOLERANCE;
+
+
+bool IMPORTED_LINE::Extend( const VECTOR2D& aStart, const VECTOR2D& aEnd, double aWidth )
+{
+    if( aStart != m_end || aWidth != m_width )
+        return false;
+
+    VECTOR2D dir = m_end - m_start;
+    VECTOR2D ext = aEnd - aStart;
+
+    // Zero length segments (dots) are kept, and so are the segments going back
+    if( dir.x == 0.0 && dir.y == 0.0 )
+        return false;
+
+    if( dir.Dot( ext ) <= 0.0 )
+        return false;
+
+    // The current end, which becomes a joint, must stay on the extended line
+    VECTOR2D extended = aEnd - m_start;
+
+    if( std::abs( extended.Cross( dir ) ) > MERGE_TOLERANCE * extended.EuclideanNorm() )
+        return false;
+
+    m_end = aEnd;
+    return true;
+}
+
+
 void GRAPHICS_IMPORTER_BUFFER::AddLine( const VECTOR2D& aStart, const VECTOR2D& aEnd, double aWidth )
 {
-    m_shapes.push_back( make_shape< IMPORTED_LINE >( aStart, aEnd, aWidth ) );
+    // Only a segment following the previous line may extend it
+    bool lastIsLine = !m_lines.empty()
+                      && ( m_shapes.empty() || m_shapes.back().first < m_lines.size() );
+
+    if( lastIsLine && m_lines.back().Extend( aStart, aEnd, aWidth ) )
+        return;
+
+    m_lines.emplace_back( aStart, aEnd, aWidth );
 }
 
 
 void GRAPHICS_IMPORTER_BUFFER::AddCircle( const VECTOR2D& aCenter, double aRadius, double aWidth )
 {
-    m_shapes.push_back( make_shape< IMPORTED_CIRCLE >( aCenter, aRadius, aWidth ) );
+    m_shapes.emplace_back( m_lines.size(), make_shape< IMPORTED_CIRCLE >( aCenter, aRadius, aWidth ) );
 }
 
 
 void GRAPHICS_IMPORTER_BUFFER::AddArc( const VECTOR2D& aCenter, const VECTOR2D& aStart,
                                        double aAngle, double aWidth )
 {
-    m_shapes.push_back( make_shape< IMPORTED_ARC >( aCenter, aStart, aAngle, aWidth ) );
+    m_shapes.emplace_back( m_lines.size(),
+                           make_shape< IMPORTED_ARC >( aCenter, aStart, aAngle, aWidth ) );
 }
 
 
 void GRAPHICS_IMPORTER_BUFFER::AddPolygon( const std::vector< VECTOR2D >& aVertices, double aWidth )
 {
-    m_shapes.push_back( make_shape< IMPORTED_POLYGON >( aVertices, aWidth ) );
+    m_shapes.emplace_back( m_lines.size(), make_shape< IMPORTED_POLYGON >( aVertices, aWidth ) );
 }
 
 
@@ -61,20 +100,34 @@ void GRAPHICS_IMPORTER_BUFFER::AddText( const VECTOR2D& aOrigin, const wxString&
         double aHeight, double aWidth, double aThickness, double aOrientation,
         EDA_TEXT_HJUSTIFY_T aHJustify, EDA_TEXT_VJUSTIFY_T aVJustify )
 {
-    m_shapes.push_back( make_shape< IMPORTED_TEXT >( aOrigin, aText, aHeight, aWidth,
-                            aThickness, aOrientation, aHJustify, aVJustify ) );
+    m_shapes.emplace_back( m_lines.size(),
+                           make_shape< IMPORTED_TEXT >( aOrigin, aText, aHeight, aWidth,
+                                   aThickness, aOrientation, aHJustify, aVJustify ) );
 }
 
 
 void GRAPHICS_IMPORTER_BUFFER::AddSpline( const VECTOR2D& aStart, const VECTOR2D& aBezierControl1,
                 const VECTOR2D& aBezierControl2, const VECTOR2D& aEnd , double aWidth )
 {
-    m_shapes.push_back( make_shape< IMPORTED_SPLINE >( aStart, aBezierControl1, aBezierControl2, aEnd, aWidth ) );
+    m_shapes.emplace_back( m_lines.size(),
+                           make_shape< IMPORTED_SPLINE >( aStart, aBezierControl1,
+                                   aBezierControl2, aEnd, aWidth ) );
 }
 
 
 void GRAPHICS_IMPORTER_BUFFER::ImportTo( GRAPHICS_IMPORTER& aImporter )
 {
+    // The shapes are imported in the order they were added
+    size_t line = 0;
+
     for( auto& shape : m_shapes )
-        shape->ImportTo( aImporter );
+    {
+        for( ; line < shape.first; ++line )
+            m_lines[line].ImportTo( aImporter );
+
+        shape.second->ImportTo( aImporter );
+    }
+
+    for( ; line < m_lines.size(); ++line )
+        m_lines[line].ImportTo( aImporter );
 }
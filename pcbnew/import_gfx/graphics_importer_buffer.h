@@ -28,7 +28,9 @@
 
 #include "graphics_importer.h"
 
-#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
 
 class IMPORTED_SHAPE
 {
@@ -51,9 +53,19 @@ public:
         aImporter.AddLine( m_start, m_end, m_width );
     }
 
+    /**
+     * Extends the line to aEnd, if the segment from aStart to aEnd continues it: it starts at
+     * the end of the line, has the same width and goes on in the same direction.
+     * @return true if the line was extended.
+     */
+    bool Extend( const VECTOR2D& aStart, const VECTOR2D& aEnd, double aWidth );
+
 private:
-    const VECTOR2D m_start;
-    const VECTOR2D m_end;
+    ///> Largest distance (in mm) of a joint of merged segments from the merged line
+    static constexpr double MERGE_TOLERANCE = 1e-6;
+
+    VECTOR2D m_start;
+    VECTOR2D m_end;
     double m_width;
 };
 
@@ -194,8 +206,12 @@ public:
     void ImportTo( GRAPHICS_IMPORTER& aImporter );
 
 protected:
-    ///> List of imported shapes
-    std::list< std::unique_ptr< IMPORTED_SHAPE > > m_shapes;
+    ///> Imported line segments, most of the shapes of mechanical drawings, stored by value.
+    ///> Collinear segments imported one after the other are merged.
+    std::vector< IMPORTED_LINE > m_lines;
+
+    ///> Other imported shapes, with the number of lines imported before each of them
+    std::vector< std::pair< size_t, std::unique_ptr< IMPORTED_SHAPE > > > m_shapes;
 };
 
 #endif /* GRAPHICS_IMPORTER_BUFFER */
@@ -66,11 +66,8 @@ bool SVG_IMPORT_PLUGIN::Load( const wxString& aFileName )
 
     wxCHECK( m_parsedImage, false );
 
-    return true;
-}
-
-bool SVG_IMPORT_PLUGIN::Import()
-{
+    // The paths are converted to shapes in a buffer, which merges the segments continuing
+    // each other, as DXF_IMPORT_PLUGIN does
     for( NSVGshape* shape = m_parsedImage->shapes; shape != NULL; shape = shape->next )
     {
         double lineWidth = shape->strokeWidth;
@@ -82,6 +79,14 @@ bool SVG_IMPORT_PLUGIN::Import()
     return true;
 }
 
+bool SVG_IMPORT_PLUGIN::Import()
+{
+    wxCHECK( m_importer, false );
+    m_internalImporter.ImportTo( *m_importer );
+
+    return true;
+}
+
 
 double SVG_IMPORT_PLUGIN::GetImageHeight() const
 {
@@ -154,16 +159,14 @@ void SVG_IMPORT_PLUGIN::DrawCubicBezierCurve( const float* aPoints,
 
 void SVG_IMPORT_PLUGIN::DrawPolygon( const std::vector< VECTOR2D >& aPoints, double aWidth )
 {
-    m_importer->AddPolygon( aPoints, aWidth );
+    m_internalImporter.AddPolygon( aPoints, aWidth );
 }
 
 
 void SVG_IMPORT_PLUGIN::DrawLineSegments( const std::vector< VECTOR2D >& aPoints, double aWidth )
 {
-    unsigned int numLineStartPoints = aPoints.size() - 1;
-
-    for( unsigned int pointIndex = 0; pointIndex < numLineStartPoints; ++pointIndex )
-        m_importer->AddLine( aPoints[ pointIndex ], aPoints[ pointIndex + 1 ], aWidth );
+    for( size_t pointIndex = 1; pointIndex < aPoints.size(); ++pointIndex )
+        m_internalImporter.AddLine( aPoints[ pointIndex - 1 ], aPoints[ pointIndex ], aWidth );
 }
 
 
@@ -29,6 +29,7 @@
 #include "nanosvg.h"
 
 #include "graphics_import_plugin.h"
+#include "graphics_importer_buffer.h"
 #include <math/vector2d.h>
 #include <wildcards_and_files_ext.h>
 
@@ -77,6 +78,9 @@ private:
 
     struct NSVGimage* m_parsedImage;
 
+    ///> The paths of the image, converted to shapes when loading it
+    GRAPHICS_IMPORTER_BUFFER m_internalImporter;
+
     std::string m_messages;     // messages generated during svg file parsing.
                                 // Each message ends by '\n'
 };
@@ -28,6 +28,7 @@
 #include <io_mgr.h>
 #include <legacy_plugin.h>
 #include <kicad_plugin.h>
+#include <kicad_snapshot_plugin.h>
 #include <eagle_plugin.h>
 #include <pcad2kicadpcb_plugin/pcad_plugin.h>
 #include <gpcb_plugin.h>
@@ -209,3 +210,4 @@ static IO_MGR::REGISTER_PLUGIN registerGithubPlugin( IO_MGR::GITHUB, wxT("Github
 #endif /* BUILD_GITHUB_PLUGIN */
 static IO_MGR::REGISTER_PLUGIN registerLegacyPlugin( IO_MGR::LEGACY, wxT("Legacy"), []() -> PLUGIN* { return new LEGACY_PLUGIN; } );
 static IO_MGR::REGISTER_PLUGIN registerGPCBPlugin( IO_MGR::GEDA_PCB, wxT("GEDA/Pcb"), []() -> PLUGIN* { return new GPCB_PLUGIN; } );
+static IO_MGR::REGISTER_PLUGIN registerKicadSnapshotPlugin( IO_MGR::KICAD_SNAPSHOT, wxT("KiCad snapshot"), []() -> PLUGIN* { return new PCB_SNAPSHOT_IO; } );
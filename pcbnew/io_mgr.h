@@ -63,6 +63,8 @@ public:
 #if defined(BUILD_GITHUB_PLUGIN)
         GITHUB,         ///< Read only http://github.com repo holding pretty footprints
 #endif
+        KICAD_SNAPSHOT, ///< Binary board snapshots of the auto save files.
+
         // add your type here.
 
         // ALTIUM,
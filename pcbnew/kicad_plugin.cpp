@@ -42,6 +42,7 @@
 #include <pcb_plot_params.h>
 #include <zones.h>
 #include <kicad_plugin.h>
+#include <kicad_snapshot_plugin.h>
 #include <pcb_parser.h>
 #include <wx/dir.h>
 #include <wx/filename.h>
@@ -51,6 +52,10 @@
 #include <connectivity/connectivity_data.h>
 #include <convert_basic_shapes_to_polygon.h>    // for enum RECT_CHAMFER_POSITIONS definition
 #include <kiface_i.h>
+#include <advanced_config.h>
+#include <thread_pool.h>
+#include <profile_registry.h>
+#include <algorithm>
 
 using namespace PCB_KEYS_T;
 
@@ -83,22 +88,78 @@ void filterNetClass( const BOARD& aBoard, NETCLASS& aNetClass )
 class FP_CACHE_ITEM
 {
     WX_FILENAME             m_filename;
-    std::unique_ptr<MODULE> m_module;
+    std::unique_ptr<MODULE> m_module;       // NULL until the footprint file is parsed.
+    long long               m_fileTimestamp;    // Of the footprint file when last read
+    long long               m_fileSize;         // or written.
+    bool                    m_saved;            // false until then
 
 public:
     FP_CACHE_ITEM( MODULE* aModule, const WX_FILENAME& aFileName );
 
     const WX_FILENAME& GetFileName() const { return m_filename; }
     const MODULE*      GetModule()   const { return m_module.get(); }
+
+    void SetModule( MODULE* aModule ) { m_module.reset( aModule ); }
+
+    long long GetFileTimestamp() const { return m_fileTimestamp; }
+
+    /**
+     * Function IsSaved
+     * @return true if the footprint is the one of its file, false if it was added or
+     *         replaced since the file was last read or written.
+     */
+    bool IsSaved() const { return m_saved; }
+
+    /**
+     * Function UpdateFileStamp
+     * remembers the modification time and the size of the footprint file, once it has
+     * been read or written.
+     */
+    void UpdateFileStamp();
+
+    /**
+     * Function IsFileModified
+     * @return true if the footprint file was changed, or removed, since the last call to
+     *         UpdateFileStamp().
+     */
+    bool IsFileModified();
+
+private:
+    long long getFileSize() const;
 };
 
 
 FP_CACHE_ITEM::FP_CACHE_ITEM( MODULE* aModule, const WX_FILENAME& aFileName ) :
     m_filename( aFileName ),
-    m_module( aModule )
+    m_module( aModule ),
+    m_fileTimestamp( 0 ),
+    m_fileSize( -1 ),
+    m_saved( false )
 { }
 
 
+void FP_CACHE_ITEM::UpdateFileStamp()
+{
+    m_fileTimestamp = m_filename.GetTimestamp();
+    m_fileSize = getFileSize();
+    m_saved = true;
+}
+
+
+bool FP_CACHE_ITEM::IsFileModified()
+{
+    return m_filename.GetTimestamp() != m_fileTimestamp || getFileSize() != m_fileSize;
+}
+
+
+long long FP_CACHE_ITEM::getFileSize() const
+{
+    wxULongLong size = wxFileName::GetSize( m_filename.GetFullPath() );
+
+    return size == wxInvalidSize ? -1 : (long long) size.GetValue();
+}
+
+
 typedef boost::ptr_map< wxString, FP_CACHE_ITEM >   MODULE_MAP;
 typedef MODULE_MAP::iterator                        MODULE_ITER;
 typedef MODULE_MAP::const_iterator                  MODULE_CITER;
@@ -132,12 +193,38 @@ public:
      * Function Save
      * Save the footprint cache or a single module from it to disk
      *
-     * @param aModule if set, save only this module, otherwise, save the full library
+     * The footprints are formatted and written in the thread pool, each thread using its
+     * own PCB_IO.  The caller must hold a LOCALE_IO.
+     *
+     * @param aModule if set, save only this module, otherwise, save the footprints added or
+     *                replaced since the library was read or last saved
      */
     void Save( MODULE* aModule = NULL );
 
+    /**
+     * Function Load
+     * reads the footprint files of the library.
+     *
+     * When the cache was already loaded, only the footprint files which were added or
+     * changed since then are parsed again, and the footprints whose file was removed are
+     * dropped.
+     *
+     * When ADVANCED_CFG::m_lazyFootprintLoad is set, only the footprint names and the file
+     * timestamps are read: each footprint file is parsed the first time GetModule() asks
+     * for it.
+     */
     void Load();
 
+    /**
+     * Function GetModule
+     * returns the footprint \a aFootprintName, parsing its file if it was not yet.
+     *
+     * @return the footprint or NULL if the library has no such footprint.
+     * @throw IO_ERROR if the footprint file cannot be parsed; the footprint is then removed
+     *        from the cache.
+     */
+    const MODULE* GetModule( const wxString& aFootprintName );
+
     void Remove( const wxString& aFootprintName );
 
     /**
@@ -167,6 +254,10 @@ public:
      * @return true if \a aPath is the same as the cache path.
      */
     bool IsPath( const wxString& aPath ) const;
+
+private:
+    /// Parse the footprint file \a aFileName, and name the footprint after the file.
+    MODULE* parseModule( const WX_FILENAME& aFileName );
 };
 
 
@@ -182,8 +273,6 @@ FP_CACHE::FP_CACHE( PCB_IO* aOwner, const wxString& aLibraryPath )
 
 void FP_CACHE::Save( MODULE* aModule )
 {
-    m_cache_timestamp = 0;
-
     if( !m_lib_path.DirExists() && !m_lib_path.Mkdir() )
     {
         THROW_IO_ERROR( wxString::Format( _( "Cannot create footprint library path \"%s\"" ),
@@ -196,12 +285,27 @@ void FP_CACHE::Save( MODULE* aModule )
                                           m_lib_raw_path ) );
     }
 
+    // A footprint which was never parsed is still the one of its file.
+    std::vector<FP_CACHE_ITEM*> items;
+    std::vector<long long>      oldTimestamps;
+
     for( MODULE_ITER it = m_modules.begin();  it != m_modules.end();  ++it )
     {
-        if( aModule && aModule != it->second->GetModule() )
+        FP_CACHE_ITEM* item = it->second;
+
+        if( !item->GetModule() )
             continue;
 
-        WX_FILENAME fn = it->second->GetFileName();
+        if( aModule ? aModule == item->GetModule() : !item->IsSaved() )
+        {
+            items.push_back( item );
+            oldTimestamps.push_back( item->GetFileTimestamp() );
+        }
+    }
+
+    auto saveItem = []( PCB_IO& aIO, FP_CACHE_ITEM* aItem )
+    {
+        WX_FILENAME fn = aItem->GetFileName();
 
         wxString tempFileName =
 #ifdef USE_TMP_FILE
@@ -217,8 +321,8 @@ void FP_CACHE::Save( MODULE* aModule )
 
             FILE_OUTPUTFORMATTER formatter( tempFileName );
 
-            m_owner->SetOutputFormatter( &formatter );
-            m_owner->Format( (BOARD_ITEM*) it->second->GetModule() );
+            aIO.SetOutputFormatter( &formatter );
+            aIO.Format( (BOARD_ITEM*) aItem->GetModule() );
         }
 
 #ifdef USE_TMP_FILE
@@ -238,10 +342,43 @@ void FP_CACHE::Save( MODULE* aModule )
             THROW_IO_ERROR( msg );
         }
 #endif
-        m_cache_timestamp += fn.GetTimestamp();
+        aItem->UpdateFileStamp();
+    };
+
+    try
+    {
+        if( items.size() == 1 )
+        {
+            saveItem( *m_owner, items[0] );
+        }
+        else if( !items.empty() )
+        {
+            // PCB_IO::Format() prints to the plugin output formatter: each chunk of
+            // footprints is formatted by its own plugin.
+            size_t chunkCount = THREAD_POOL::GetPool().GetThreadCount() * 4 + 1;
+            size_t chunkSize = ( items.size() + chunkCount - 1 ) / chunkCount;
+
+            THREAD_POOL::GetPool().ParallelFor( ( items.size() + chunkSize - 1 ) / chunkSize,
+                    [&]( size_t aChunk )
+                    {
+                        PCB_IO io( m_owner->m_ctl );
+                        size_t end = std::min( items.size(), ( aChunk + 1 ) * chunkSize );
+
+                        for( size_t ii = aChunk * chunkSize; ii < end; ++ii )
+                            saveItem( io, items[ii] );
+                    }, 1 );
+        }
+    }
+    catch( ... )
+    {
+        // Some files may be written: the timestamp can no longer be updated
+        m_cache_dirty = true;
+        throw;
     }
 
-    m_cache_timestamp += m_lib_path.GetModificationTime().GetValue().GetValue();
+    // The timestamp is the sum of the footprint file timestamps, as in GetTimestamp()
+    for( size_t ii = 0; ii < items.size(); ++ii )
+        m_cache_timestamp += items[ii]->GetFileTimestamp() - oldTimestamps[ii];
 
     // If we've saved the full cache, we clear the dirty flag.
     if( !aModule )
@@ -258,6 +395,8 @@ void FP_CACHE::Load()
 
     if( !dir.IsOpened() )
     {
+        m_modules.clear();
+
         wxString msg = wxString::Format( _( "Footprint library path \"%s\" does not exist" ),
                                          m_lib_raw_path );
         THROW_IO_ERROR( msg );
@@ -270,28 +409,39 @@ void FP_CACHE::Load()
     // the filename thereafter.
     WX_FILENAME fn( m_lib_raw_path, wxT( "dummyName" ) );
 
+    bool lazyLoad = ADVANCED_CFG::GetCfg().m_lazyFootprintLoad;
+
+    // The footprints of the previous load whose file did not change are moved to the new
+    // map; the ones left in m_modules have had their file removed.
+    MODULE_MAP modules;
+    wxString   cacheError;
+
     if( dir.GetFirst( &fullName, fileSpec ) )
     {
-        wxString cacheError;
-
         do
         {
             fn.SetFullName( fullName );
 
+            wxString    fpName = fn.GetName();
+            MODULE_ITER it = m_modules.find( fpName );
+
+            if( it != m_modules.end() && !it->second->IsFileModified() )
+            {
+                m_cache_timestamp += it->second->GetFileTimestamp();
+                modules.transfer( it, m_modules );
+                continue;
+            }
+
             // Queue I/O errors so only files that fail to parse don't get loaded.
             try
             {
-                FILE_LINE_READER    reader( fn.GetFullPath() );
+                MODULE*        footprint = lazyLoad ? nullptr : parseModule( fn );
+                FP_CACHE_ITEM* item = new FP_CACHE_ITEM( footprint, fn );
 
-                m_owner->m_parser->SetLineReader( &reader );
+                modules.insert( fpName, item );
 
-                MODULE*     footprint = (MODULE*) m_owner->m_parser->Parse();
-                wxString    fpName = fn.GetName();
-
-                footprint->SetFPID( LIB_ID( wxEmptyString, fpName ) );
-                m_modules.insert( fpName, new FP_CACHE_ITEM( footprint, fn ) );
-
-                m_cache_timestamp += fn.GetTimestamp();
+                item->UpdateFileStamp();
+                m_cache_timestamp += item->GetFileTimestamp();
             }
             catch( const IO_ERROR& ioe )
             {
@@ -301,10 +451,51 @@ void FP_CACHE::Load()
                 cacheError += ioe.What();
             }
         } while( dir.GetNext( &fullName ) );
+    }
+
+    m_modules.swap( modules );
 
-        if( !cacheError.IsEmpty() )
-            THROW_IO_ERROR( cacheError );
+    if( !cacheError.IsEmpty() )
+        THROW_IO_ERROR( cacheError );
+}
+
+
+MODULE* FP_CACHE::parseModule( const WX_FILENAME& aFileName )
+{
+    WHOLE_FILE_LINE_READER reader( aFileName.GetFullPath() );
+
+    m_owner->m_parser->SetLineReader( &reader );
+
+    MODULE* footprint = (MODULE*) m_owner->m_parser->Parse();
+
+    footprint->SetFPID( LIB_ID( wxEmptyString, aFileName.GetName() ) );
+
+    return footprint;
+}
+
+
+const MODULE* FP_CACHE::GetModule( const wxString& aFootprintName )
+{
+    MODULE_ITER it = m_modules.find( aFootprintName );
+
+    if( it == m_modules.end() )
+        return nullptr;
+
+    if( !it->second->GetModule() )
+    {
+        try
+        {
+            it->second->SetModule( parseModule( it->second->GetFileName() ) );
+        }
+        catch( const IO_ERROR& )
+        {
+            // Like the files which fail to parse in Load(), drop the footprint.
+            m_modules.erase( it );
+            throw;
+        }
     }
+
+    return it->second->GetModule();
 }
 
 
@@ -322,6 +513,10 @@ void FP_CACHE::Remove( const wxString& aFootprintName )
 
     // Remove the module from the cache and delete the module file from the library.
     wxString fullPath = it->second->GetFileName().GetFullPath();
+
+    if( it->second->IsSaved() )
+        m_cache_timestamp -= it->second->GetFileTimestamp();
+
     m_modules.erase( aFootprintName );
     wxRemoveFile( fullPath );
 }
@@ -769,11 +964,14 @@ void PCB_IO::format( BOARD* aBoard, int aNestLevel ) const
     // Do not save MARKER_PCBs, they can be regenerated easily.
 
     // Save the tracks and vias.
-    for( auto track : aBoard->Tracks() )
-        Format( track, aNestLevel );
+    if( !( m_ctl & CTL_OMIT_TRACKS ) )
+    {
+        for( auto track : aBoard->Tracks() )
+            Format( track, aNestLevel );
 
-    if( aBoard->Tracks().size() )
-        m_out->Print( 0, "\n" );
+        if( aBoard->Tracks().size() )
+            m_out->Print( 0, "\n" );
+    }
 
     // Save the polygon (which are the newer technology) zones.
     for( int i = 0; i < aBoard->GetAreaCount();  ++i )
@@ -1816,6 +2014,11 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
 
     m_out->Print( 0, ")\n" );
 
+    // Allows reusing the saved fill while it is up to date
+    if( aZone->IsFilled() && !aZone->GetFillFingerprint().empty() )
+        m_out->Print( aNestLevel+1, "(fill_fingerprint %s)\n",
+                      aZone->GetFillFingerprint().c_str() );
+
     int newLine = 0;
 
     if( aZone->GetNumCorners() )
@@ -1869,6 +2072,12 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
 
     }
 
+    if( m_ctl & CTL_OMIT_ZONE_FILLS )
+    {
+        m_out->Print( aNestLevel, ")\n" );
+        return;
+    }
+
     // Save the PolysList (filled areas)
     const SHAPE_POLY_SET& fv = aZone->GetFilledPolysList();
     newLine = 0;
@@ -1965,11 +2174,33 @@ PCB_IO::~PCB_IO()
 
 BOARD* PCB_IO::Load( const wxString& aFileName, BOARD* aAppendToMe, const PROPERTIES* aProperties )
 {
-    FILE_LINE_READER    reader( aFileName );
+    PROF_SCOPE profScope( "board load" );
+
+    // Auto save files may be board snapshots
+    if( PCB_SNAPSHOT_IO::IsSnapshotFile( aFileName ) )
+    {
+        PCB_SNAPSHOT_IO snapshot;
+
+        return snapshot.Load( aFileName, aAppendToMe, aProperties );
+    }
+
+    WHOLE_FILE_LINE_READER reader( aFileName );
 
     init( aProperties );
 
-    m_parser->SetLineReader( &reader );
+    BOARD* board = parseBoard( reader, aAppendToMe );
+
+    // Give the filename to the board if it's new
+    if( !aAppendToMe )
+        board->SetFileName( aFileName );
+
+    return board;
+}
+
+
+BOARD* PCB_IO::parseBoard( LINE_READER& aReader, BOARD* aAppendToMe )
+{
+    m_parser->SetLineReader( &aReader );
     m_parser->SetBoard( aAppendToMe );
 
     BOARD* board;
@@ -1999,10 +2230,6 @@ BOARD* PCB_IO::Load( const wxString& aFileName, BOARD* aAppendToMe, const PROPER
                 m_parser->CurLineNumber(), m_parser->CurOffset() );
     }
 
-    // Give the filename to the board if it's new
-    if( !aAppendToMe )
-        board->SetFileName( aFileName );
-
     return board;
 }
 
@@ -2018,13 +2245,18 @@ void PCB_IO::init( const PROPERTIES* aProperties )
 
 void PCB_IO::validateCache( const wxString& aLibraryPath, bool checkModified )
 {
-    if( !m_cache || !m_cache->IsPath( aLibraryPath ) || ( checkModified && m_cache->IsModified() ) )
+    if( !m_cache || !m_cache->IsPath( aLibraryPath ) )
     {
         // a spectacular episode in memory management:
         delete m_cache;
         m_cache = new FP_CACHE( this, aLibraryPath );
         m_cache->Load();
     }
+    else if( checkModified && m_cache->IsModified() )
+    {
+        // only the footprint files which changed are parsed again
+        m_cache->Load();
+    }
 }
 
 
@@ -2081,14 +2313,15 @@ const MODULE* PCB_IO::getFootprint( const wxString& aLibraryPath,
         // do nothing with the error
     }
 
-    const MODULE_MAP& mods = m_cache->GetModules();
-
-    MODULE_CITER it = mods.find( aFootprintName );
-
-    if( it == mods.end() )
+    try
+    {
+        return m_cache->GetModule( aFootprintName );
+    }
+    catch( const IO_ERROR& )
+    {
+        // a footprint which fails to parse is not in the library, as in FP_CACHE::Load()
         return nullptr;
-
-    return it->second->GetModule();
+    }
 }
 
 
@@ -2135,7 +2368,10 @@ void PCB_IO::FootprintSave( const wxString& aLibraryPath, const MODULE* aFootpri
     // called for saving into a library path.
     m_ctl = CTL_FOR_LIBRARY;
 
-    validateCache( aLibraryPath );
+    // The cache timestamp follows the files written here, so a library saved one footprint
+    // at a time is not scanned for each footprint.  The files changed by someone else are
+    // still found by the next validateCache() checking them.
+    validateCache( aLibraryPath, false );
 
     if( !m_cache->IsWritable() )
     {
@@ -2201,8 +2437,7 @@ void PCB_IO::FootprintSave( const wxString& aLibraryPath, const MODULE* aFootpri
     if( it != mods.end() )
     {
         wxLogTrace( traceKicadPcbPlugin, wxT( "Removing footprint file '%s'." ), fullPath );
-        mods.erase( footprintName );
-        wxRemoveFile( fullPath );
+        m_cache->Remove( footprintName );
     }
 
     // I need my own copy for the cache
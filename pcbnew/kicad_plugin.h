@@ -61,7 +61,8 @@ class TEXTE_PCB;
 //#define SEXPR_BOARD_FILE_VERSION    20190331  // hatched zones and chamfered round rect pads
 //#define SEXPR_BOARD_FILE_VERSION    20190421  // curves in custom pads
 //#define SEXPR_BOARD_FILE_VERSION    20190516  // Remove segment count from zones
-#define SEXPR_BOARD_FILE_VERSION      20190605  // Add layer defaults
+//#define SEXPR_BOARD_FILE_VERSION    20190605  // Add layer defaults
+#define SEXPR_BOARD_FILE_VERSION      20190630  // Add zone fill fingerprint
 
 #define CTL_STD_LAYER_NAMES         (1 << 0)    ///< Use English Standard layer names
 #define CTL_OMIT_NETS               (1 << 1)    ///< Omit pads net names (useless in library)
@@ -71,6 +72,8 @@ class TEXTE_PCB;
 #define CTL_OMIT_AT                 (1 << 5)    ///< Omit position and rotation
                                                 // (always saved with potion 0,0 and rotation = 0 in library)
 //#define CTL_OMIT_HIDE             (1 << 6)    // found and defined in eda_text.h
+#define CTL_OMIT_TRACKS             (1 << 7)    ///< Omit the tracks and vias of the board
+#define CTL_OMIT_ZONE_FILLS         (1 << 8)    ///< Omit the filled areas of the zones
 
 
 // common combinations of the above:
@@ -204,6 +207,14 @@ protected:
 
     void init( const PROPERTIES* aProperties );
 
+    /**
+     * Function parseBoard
+     * parses the s-expression board read by \a aReader.
+     *
+     * @throw IO_ERROR, PARSE_ERROR or FUTURE_FORMAT_ERROR if the board cannot be parsed.
+     */
+    BOARD* parseBoard( LINE_READER& aReader, BOARD* aAppendToMe );
+
     /// formats the board setup information
     void formatSetup( BOARD* aBoard, int aNestLevel = 0 ) const;
 
@@ -0,0 +1,652 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <fctsys.h>
+#include <common.h>
+#include <build_version.h>
+#include <macros.h>
+#include <class_board.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <netinfo.h>
+#include <kicad_snapshot_plugin.h>
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <vector>
+
+
+namespace
+{
+
+const char     SNAPSHOT_MAGIC[8] = { 'K', 'I', 'S', 'N', 'A', 'P', 'S', 'H' };
+const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+
+enum SNAPSHOT_SECTION_T
+{
+    SECTION_BOARD = 1,          ///< The s-expression board, without tracks and zone fills
+    SECTION_NETS,               ///< The names of the nets of the track records
+    SECTION_TRACKS,             ///< SNAPSHOT_TRACK records
+    SECTION_ZONE_FILLS          ///< SNAPSHOT_ZONE_FILL records, each followed by its blobs
+};
+
+
+struct SNAPSHOT_HEADER
+{
+    char     m_magic[8];
+    uint32_t m_version;
+    uint32_t m_byteOrder;
+};
+
+
+struct SNAPSHOT_SECTION
+{
+    uint32_t m_type;
+    uint32_t m_count;           ///< Number of records
+    uint64_t m_size;            ///< Size of the records, without the padding
+};
+
+
+/// A track or a via
+struct SNAPSHOT_TRACK
+{
+    int32_t  m_isVia;
+    int32_t  m_net;             ///< Index of the net in the net section
+    int32_t  m_start[2];
+    int32_t  m_end[2];
+    int32_t  m_width;
+    int32_t  m_layer;           ///< Top layer of the vias
+    int32_t  m_bottomLayer;     ///< Vias only
+    int32_t  m_viaType;         ///< Vias only
+    int32_t  m_drill;           ///< Vias only
+    uint32_t m_timeStamp;
+    uint32_t m_status;
+    uint32_t m_reserved;
+};
+
+
+/**
+ * The filled areas of a zone.  The record is followed by the m_polygonCount polygons: the
+ * number of contours of the polygon, then for each of them its number of points and their
+ * coordinates.  Then come the m_segmentCount fill segments: the coordinates of their ends.
+ */
+struct SNAPSHOT_ZONE_FILL
+{
+    uint32_t m_zone;            ///< Index of the zone in the board
+    uint32_t m_polygonCount;
+    uint32_t m_segmentCount;
+    uint32_t m_reserved;
+};
+
+
+static_assert( sizeof( SNAPSHOT_HEADER ) == 16 && sizeof( SNAPSHOT_SECTION ) == 16
+                       && sizeof( SNAPSHOT_TRACK ) == 56 && sizeof( SNAPSHOT_ZONE_FILL ) == 16,
+               "the snapshot records must not be padded" );
+
+
+size_t paddedSize( size_t aSize )
+{
+    return ( aSize + 7 ) & ~size_t( 7 );
+}
+
+
+template <typename T>
+void append( std::vector<char>& aBuffer, const T& aValue )
+{
+    const char* bytes = reinterpret_cast<const char*>( &aValue );
+
+    aBuffer.insert( aBuffer.end(), bytes, bytes + sizeof( T ) );
+}
+
+
+class SNAPSHOT_WRITER
+{
+public:
+    SNAPSHOT_WRITER( const wxString& aFileName ) :
+        m_filename( aFileName )
+    {
+        m_fp = wxFopen( aFileName, wxT( "wb" ) );
+
+        if( !m_fp )
+        {
+            THROW_IO_ERROR( wxString::Format( _( "Unable to open file \"%s\" for writing" ),
+                                              aFileName ) );
+        }
+    }
+
+    ~SNAPSHOT_WRITER()
+    {
+        if( m_fp )
+            fclose( m_fp );
+    }
+
+    void Write( const void* aData, size_t aSize )
+    {
+        if( aSize && fwrite( aData, 1, aSize, m_fp ) != aSize )
+            throwWriteError();
+    }
+
+    void WriteSection( SNAPSHOT_SECTION_T aType, size_t aCount, const char* aData, size_t aSize )
+    {
+        static const char padding[8] = {};
+
+        SNAPSHOT_SECTION section = { (uint32_t) aType, (uint32_t) aCount, aSize };
+
+        Write( &section, sizeof( section ) );
+        Write( aData, aSize );
+        Write( padding, paddedSize( aSize ) - aSize );
+    }
+
+    void WriteSection( SNAPSHOT_SECTION_T aType, size_t aCount, const std::vector<char>& aData )
+    {
+        WriteSection( aType, aCount, aData.data(), aData.size() );
+    }
+
+    /// Close the file, to catch the errors of the last writes.
+    void Close()
+    {
+        FILE* fp = m_fp;
+
+        m_fp = NULL;
+
+        if( fclose( fp ) != 0 )
+            throwWriteError();
+    }
+
+private:
+    void throwWriteError()
+    {
+        THROW_IO_ERROR( wxString::Format( _( "Unable to write file \"%s\"" ), m_filename ) );
+    }
+
+    wxString m_filename;
+    FILE*    m_fp;
+};
+
+
+/**
+ * Reads the records of a snapshot in memory, and throws an IO_ERROR when they go past the
+ * end of the file or of their section.
+ */
+class SNAPSHOT_READER
+{
+public:
+    SNAPSHOT_READER( const char* aBegin, const char* aEnd, const wxString& aFileName ) :
+        m_next( aBegin ),
+        m_end( aEnd ),
+        m_filename( aFileName )
+    { }
+
+    bool AtEnd() const { return m_next == m_end; }
+
+    const char* ReadBytes( size_t aSize )
+    {
+        if( (size_t) ( m_end - m_next ) < aSize )
+            ThrowCorrupted();
+
+        const char* bytes = m_next;
+
+        m_next += aSize;
+
+        return bytes;
+    }
+
+    template <typename T>
+    T Read()
+    {
+        T value;
+
+        memcpy( &value, ReadBytes( sizeof( T ) ), sizeof( T ) );
+
+        return value;
+    }
+
+    /// Return a reader of the records of the section which starts here.
+    SNAPSHOT_READER ReadSection( const SNAPSHOT_SECTION& aSection )
+    {
+        size_t available = m_end - m_next;
+
+        if( aSection.m_size > available || paddedSize( aSection.m_size ) > available )
+            ThrowCorrupted();
+
+        const char* begin = ReadBytes( paddedSize( aSection.m_size ) );
+
+        return SNAPSHOT_READER( begin, begin + aSection.m_size, m_filename );
+    }
+
+    void ThrowCorrupted() const
+    {
+        THROW_IO_ERROR( wxString::Format( _( "Board snapshot \"%s\" is corrupted" ),
+                                          m_filename ) );
+    }
+
+private:
+    const char* m_next;
+    const char* m_end;
+    wxString    m_filename;
+};
+
+
+std::vector<char> readFile( const wxString& aFileName )
+{
+    FILE* fp = wxFopen( aFileName, wxT( "rb" ) );
+
+    if( !fp )
+    {
+        THROW_IO_ERROR( wxString::Format( _( "Unable to open filename \"%s\" for reading" ),
+                                          aFileName ) );
+    }
+
+    std::vector<char> data;
+
+    bool ok = fseek( fp, 0, SEEK_END ) == 0;
+    long size = ok ? ftell( fp ) : -1;
+
+    if( size > 0 && fseek( fp, 0, SEEK_SET ) == 0 )
+    {
+        data.resize( size );
+        ok = fread( data.data(), 1, size, fp ) == (size_t) size;
+    }
+    else
+    {
+        ok = ok && size == 0;
+    }
+
+    fclose( fp );
+
+    if( !ok )
+        THROW_IO_ERROR( wxString::Format( _( "Unable to read file \"%s\"" ), aFileName ) );
+
+    return data;
+}
+
+} // namespace
+
+
+PCB_SNAPSHOT_IO::PCB_SNAPSHOT_IO() :
+    PCB_IO( CTL_FOR_BOARD | CTL_OMIT_TRACKS | CTL_OMIT_ZONE_FILLS )
+{
+}
+
+
+bool PCB_SNAPSHOT_IO::IsSnapshotFile( const wxString& aFileName )
+{
+    FILE* fp = wxFopen( aFileName, wxT( "rb" ) );
+
+    if( !fp )
+        return false;
+
+    char magic[ sizeof( SNAPSHOT_MAGIC ) ];
+    bool isSnapshot = fread( magic, 1, sizeof( magic ), fp ) == sizeof( magic )
+                      && memcmp( magic, SNAPSHOT_MAGIC, sizeof( magic ) ) == 0;
+
+    fclose( fp );
+
+    return isSnapshot;
+}
+
+
+void PCB_SNAPSHOT_IO::Save( const wxString& aFileName, BOARD* aBoard,
+                            const PROPERTIES* aProperties )
+{
+    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
+
+    init( aProperties );
+
+    m_board = aBoard;       // after init()
+
+    // Prepare net mapping that assures that net codes saved in a file are consecutive integers
+    m_mapping->SetBoard( aBoard );
+
+    // The board, without the tracks and the zone fills given by m_ctl
+    STRING_FORMATTER    formatter;
+
+    m_out = &formatter;     // no ownership
+
+    m_out->Print( 0, "(kicad_pcb (version %d) (host pcbnew %s)\n", SEXPR_BOARD_FILE_VERSION,
+                  formatter.Quotew( GetBuildVersion() ).c_str() );
+
+    Format( aBoard, 1 );
+
+    m_out->Print( 0, ")\n" );
+
+    m_out = &m_sf;
+
+    // The tracks, and the names of their nets
+    std::map<int, int>  netIndices;
+    std::vector<char>   nets;
+    std::vector<char>   tracks;
+
+    tracks.reserve( aBoard->Tracks().size() * sizeof( SNAPSHOT_TRACK ) );
+
+    for( TRACK* track : aBoard->Tracks() )
+    {
+        auto netIndex = netIndices.emplace( track->GetNetCode(), (int) netIndices.size() );
+
+        if( netIndex.second )
+        {
+            std::string netname = TO_UTF8( track->GetNetname() );
+
+            append<uint32_t>( nets, netname.size() );
+            nets.insert( nets.end(), netname.begin(), netname.end() );
+        }
+
+        SNAPSHOT_TRACK record = {};
+
+        record.m_net = netIndex.first->second;
+        record.m_start[0] = track->GetStart().x;
+        record.m_start[1] = track->GetStart().y;
+        record.m_end[0] = track->GetEnd().x;
+        record.m_end[1] = track->GetEnd().y;
+        record.m_width = track->GetWidth();
+        record.m_layer = track->GetLayer();
+        record.m_timeStamp = track->GetTimeStamp();
+        record.m_status = track->GetStatus();
+
+        if( track->Type() == PCB_VIA_T )
+        {
+            const VIA*   via = static_cast<const VIA*>( track );
+            PCB_LAYER_ID top, bottom;
+
+            via->LayerPair( &top, &bottom );
+
+            record.m_isVia = 1;
+            record.m_layer = top;
+            record.m_bottomLayer = bottom;
+            record.m_viaType = via->GetViaType();
+            record.m_drill = via->GetDrill();
+        }
+
+        append( tracks, record );
+    }
+
+    // The filled areas of the zones
+    std::vector<char>   fills;
+    int                 fillCount = 0;
+
+    for( int ii = 0; ii < aBoard->GetAreaCount(); ++ii )
+    {
+        const ZONE_CONTAINER*    zone = aBoard->GetArea( ii );
+        const SHAPE_POLY_SET&    polys = zone->GetFilledPolysList();
+        const ZONE_SEGMENT_FILL& segs = zone->FillSegments();
+
+        if( polys.IsEmpty() && segs.empty() )
+            continue;
+
+        SNAPSHOT_ZONE_FILL record = {};
+
+        record.m_zone = ii;
+        record.m_polygonCount = polys.OutlineCount();
+        record.m_segmentCount = segs.size();
+
+        append( fills, record );
+        fillCount++;
+
+        for( int jj = 0; jj < polys.OutlineCount(); ++jj )
+        {
+            const SHAPE_POLY_SET::POLYGON& polygon = polys.CPolygon( jj );
+
+            append<uint32_t>( fills, polygon.size() );
+
+            for( const SHAPE_LINE_CHAIN& contour : polygon )
+            {
+                append<uint32_t>( fills, contour.PointCount() );
+
+                for( int kk = 0; kk < contour.PointCount(); ++kk )
+                {
+                    const VECTOR2I& pt = contour.CPoint( kk );
+
+                    append<int32_t>( fills, pt.x );
+                    append<int32_t>( fills, pt.y );
+                }
+            }
+        }
+
+        for( const SEG& seg : segs )
+        {
+            append<int32_t>( fills, seg.A.x );
+            append<int32_t>( fills, seg.A.y );
+            append<int32_t>( fills, seg.B.x );
+            append<int32_t>( fills, seg.B.y );
+        }
+    }
+
+    SNAPSHOT_WRITER     file( aFileName );
+    SNAPSHOT_HEADER     header;
+
+    memcpy( header.m_magic, SNAPSHOT_MAGIC, sizeof( header.m_magic ) );
+    header.m_version = SNAPSHOT_FILE_VERSION;
+    header.m_byteOrder = SNAPSHOT_BYTE_ORDER;
+
+    const std::string& board = formatter.GetString();
+
+    file.Write( &header, sizeof( header ) );
+    file.WriteSection( SECTION_BOARD, 1, board.data(), board.size() );
+    file.WriteSection( SECTION_NETS, netIndices.size(), nets );
+    file.WriteSection( SECTION_TRACKS, aBoard->Tracks().size(), tracks );
+    file.WriteSection( SECTION_ZONE_FILLS, fillCount, fills );
+    file.Close();
+}
+
+
+BOARD* PCB_SNAPSHOT_IO::Load( const wxString& aFileName, BOARD* aAppendToMe,
+                              const PROPERTIES* aProperties )
+{
+    std::vector<char> data = readFile( aFileName );
+    SNAPSHOT_READER   file( data.data(), data.data() + data.size(), aFileName );
+    SNAPSHOT_HEADER   header = file.Read<SNAPSHOT_HEADER>();
+
+    if( memcmp( header.m_magic, SNAPSHOT_MAGIC, sizeof( header.m_magic ) ) != 0
+            || header.m_byteOrder != SNAPSHOT_BYTE_ORDER )
+    {
+        THROW_IO_ERROR( wxString::Format( _( "File \"%s\" is not a board snapshot" ),
+                                          aFileName ) );
+    }
+
+    if( header.m_version != SNAPSHOT_FILE_VERSION )
+    {
+        THROW_IO_ERROR( wxString::Format( _( "Board snapshot \"%s\" was written by another "
+                                             "version of Pcbnew" ),
+                                          aFileName ) );
+    }
+
+    init( aProperties );
+
+    BOARD*           board = NULL;
+    int              firstZone = aAppendToMe ? aAppendToMe->GetAreaCount() : 0;
+    std::vector<int> netCodes;
+
+    try
+    {
+        while( !file.AtEnd() )
+        {
+            SNAPSHOT_SECTION section = file.Read<SNAPSHOT_SECTION>();
+            SNAPSHOT_READER  records = file.ReadSection( section );
+
+            // The other sections refer to the items of the board
+            if( ( section.m_type == SECTION_BOARD ) == ( board != NULL ) )
+                file.ThrowCorrupted();
+
+            switch( section.m_type )
+            {
+            case SECTION_BOARD:
+            {
+                std::string         text( records.ReadBytes( section.m_size ), section.m_size );
+                STRING_LINE_READER  reader( text, aFileName );
+
+                board = parseBoard( reader, aAppendToMe );
+                break;
+            }
+
+            case SECTION_NETS:
+                for( uint32_t ii = 0; ii < section.m_count; ++ii )
+                {
+                    uint32_t      length = records.Read<uint32_t>();
+                    const char*   netname = records.ReadBytes( length );
+                    NETINFO_ITEM* net = board->FindNet( wxString::FromUTF8( netname, length ) );
+
+                    netCodes.push_back( net ? net->GetNet() : NETINFO_LIST::UNCONNECTED );
+                }
+
+                break;
+
+            case SECTION_TRACKS:
+                for( uint32_t ii = 0; ii < section.m_count; ++ii )
+                {
+                    SNAPSHOT_TRACK record = records.Read<SNAPSHOT_TRACK>();
+
+                    if( record.m_net < 0 || record.m_net >= (int) netCodes.size()
+                            || !IsCopperLayer( record.m_layer ) )
+                    {
+                        file.ThrowCorrupted();
+                    }
+
+                    TRACK* track;
+
+                    if( record.m_isVia )
+                    {
+                        if( !IsCopperLayer( record.m_bottomLayer )
+                                || ( record.m_viaType != VIA_THROUGH
+                                     && record.m_viaType != VIA_BLIND_BURIED
+                                     && record.m_viaType != VIA_MICROVIA ) )
+                        {
+                            file.ThrowCorrupted();
+                        }
+
+                        VIA* via = new VIA( board );
+
+                        via->SetViaType( (VIATYPE_T) record.m_viaType );
+                        via->SetLayerPair( (PCB_LAYER_ID) record.m_layer,
+                                           (PCB_LAYER_ID) record.m_bottomLayer );
+                        via->SetDrill( record.m_drill );
+
+                        track = via;
+                    }
+                    else
+                    {
+                        track = new TRACK( board );
+
+                        track->SetLayer( (PCB_LAYER_ID) record.m_layer );
+                    }
+
+                    track->SetStart( wxPoint( record.m_start[0], record.m_start[1] ) );
+                    track->SetEnd( wxPoint( record.m_end[0], record.m_end[1] ) );
+                    track->SetWidth( record.m_width );
+                    track->SetNetCode( netCodes[record.m_net], /* aNoAssert */ true );
+                    track->SetTimeStamp( record.m_timeStamp );
+                    track->SetStatus( record.m_status );
+
+                    // The tracks were saved in the order of the board
+                    board->Add( track, ADD_APPEND );
+                }
+
+                break;
+
+            case SECTION_ZONE_FILLS:
+                for( uint32_t ii = 0; ii < section.m_count; ++ii )
+                {
+                    SNAPSHOT_ZONE_FILL record = records.Read<SNAPSHOT_ZONE_FILL>();
+
+                    if( record.m_zone >= (uint32_t) ( board->GetAreaCount() - firstZone ) )
+                        file.ThrowCorrupted();
+
+                    SHAPE_POLY_SET    polys;
+                    ZONE_SEGMENT_FILL segs;
+
+                    for( uint32_t jj = 0; jj < record.m_polygonCount; ++jj )
+                    {
+                        uint32_t contourCount = records.Read<uint32_t>();
+
+                        for( uint32_t kk = 0; kk < contourCount; ++kk )
+                        {
+                            SHAPE_LINE_CHAIN contour;
+                            uint32_t         pointCount = records.Read<uint32_t>();
+
+                            for( uint32_t ll = 0; ll < pointCount; ++ll )
+                            {
+                                int x = records.Read<int32_t>();
+                                int y = records.Read<int32_t>();
+
+                                contour.Append( x, y, true );
+                            }
+
+                            contour.SetClosed( true );
+
+                            if( kk == 0 )
+                                polys.AddOutline( contour );
+                            else
+                                polys.AddHole( contour );
+                        }
+                    }
+
+                    for( uint32_t jj = 0; jj < record.m_segmentCount; ++jj )
+                    {
+                        int ax = records.Read<int32_t>();
+                        int ay = records.Read<int32_t>();
+                        int bx = records.Read<int32_t>();
+                        int by = records.Read<int32_t>();
+
+                        segs.emplace_back( VECTOR2I( ax, ay ), VECTOR2I( bx, by ) );
+                    }
+
+                    ZONE_CONTAINER* zone = board->GetArea( firstZone + record.m_zone );
+
+                    if( !polys.IsEmpty() )
+                        zone->SetFilledPolysList( polys );
+
+                    zone->SetFillSegments( segs );
+                }
+
+                break;
+
+            default:
+                // Any new section bumps SNAPSHOT_FILE_VERSION
+                file.ThrowCorrupted();
+            }
+
+            if( !records.AtEnd() )
+                file.ThrowCorrupted();
+        }
+
+        if( !board )
+            file.ThrowCorrupted();
+    }
+    catch( ... )
+    {
+        if( board != aAppendToMe )
+            delete board;
+
+        throw;
+    }
+
+    // Give the filename to the board if it's new
+    if( !aAppendToMe )
+        board->SetFileName( aFileName );
+
+    // A snapshot stands in for the board file until it is saved again as s-expression.
+    board->SetModified();
+
+    return board;
+}
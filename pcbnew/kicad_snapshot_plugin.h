@@ -0,0 +1,83 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef KICAD_SNAPSHOT_PLUGIN_H_
+#define KICAD_SNAPSHOT_PLUGIN_H_
+
+#include <kicad_plugin.h>
+
+
+/// Current board snapshot file format version.  Snapshots are only meant to be read back
+/// by the same version of Pcbnew, so any change of the layout bumps it.
+#define SNAPSHOT_FILE_VERSION       1
+
+
+/**
+ * Class PCB_SNAPSHOT_IO
+ * is a PLUGIN derivation for saving and loading board snapshots, used for the auto save
+ * files.
+ *
+ * A snapshot is the s-expression board file without its tracks, vias and zone fills,
+ * followed by binary sections holding these, which are the bulk of the big boards:
+ *
+ *  - a 16 bytes header: the "KISNAPSH" magic, the SNAPSHOT_FILE_VERSION and a byte order
+ *    marker, all in the native byte order;
+ *  - sections made of a 16 bytes header (type, record count and byte size) and of their
+ *    records, padded to 8 bytes: the s-expression board, the names of the nets used by the
+ *    tracks, the fixed size track and via records and the filled polygons and segments of
+ *    the zones.
+ *
+ * The .kicad_pcb s-expression format stays the only canonical board format: PCB_IO::Load()
+ * delegates to this plugin when it is given a snapshot, such as a recovered auto save
+ * file, and the loaded board is then marked modified so that it gets saved again as
+ * s-expression.
+ */
+class PCB_SNAPSHOT_IO : public PCB_IO
+{
+public:
+
+    //-----<PLUGIN API>---------------------------------------------------------
+
+    const wxString PluginName() const override
+    {
+        return wxT( "KiCad snapshot" );
+    }
+
+    void Save( const wxString& aFileName, BOARD* aBoard,
+               const PROPERTIES* aProperties = NULL ) override;
+
+    BOARD* Load( const wxString& aFileName, BOARD* aAppendToMe,
+                 const PROPERTIES* aProperties = NULL ) override;
+
+    //-----</PLUGIN API>--------------------------------------------------------
+
+    PCB_SNAPSHOT_IO();
+
+    /**
+     * Function IsSnapshotFile
+     * @return true if \a aFileName starts with the magic of the board snapshots.
+     */
+    static bool IsSnapshotFile( const wxString& aFileName );
+};
+
+#endif  // KICAD_SNAPSHOT_PLUGIN_H_
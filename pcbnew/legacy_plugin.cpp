@@ -87,6 +87,8 @@
 #include <trigo.h>
 #include <build_version.h>
 #include <confirm.h>
+#include <advanced_config.h>
+#include <thread_pool.h>
 
 typedef LEGACY_PLUGIN::BIU      BIU;
 
@@ -430,28 +432,23 @@ void LEGACY_PLUGIN::loadAllSections( bool doAppend )
     // Then follows $EQUIPOT and all the rest
     char* line;
 
+    // The footprints and tracks, which are most of the file, are read first and parsed
+    // before the sections they depend on, or at the end, on several threads for the big
+    // boards.
+    std::vector<BOARD_RECORD> records;
+    bool capture = ADVANCED_CFG::GetCfg().m_parallelBoardLoadMinItems > 0
+                   && THREAD_POOL::GetPool().GetThreadCount() > 1;
+
     while( ( line = READLINE( m_reader ) ) != NULL )
     {
         // put the more frequent ones at the top, but realize TRACKs are loaded as a group
 
         if( TESTLINE( "$MODULE" ) )
         {
-            unique_ptr<MODULE>    module( new MODULE( m_board ) );
-
-            LIB_ID      fpid;
-            std::string fpName = StrPurge( line + SZ( "$MODULE" ) );
-
-            // The footprint names in legacy libraries can contain the '/' and ':'
-            // characters which will cause the FPID parser to choke.
-            ReplaceIllegalFileNameChars( &fpName );
-
-            if( !fpName.empty() )
-                fpid.Parse( fpName, LIB_ID::ID_PCB, true );
-
-            module->SetFPID( fpid );
-
-            loadMODULE( module.get() );
-            m_board->Add( module.release(), ADD_APPEND );
+            if( capture )
+                captureRecords( records, true );
+            else
+                m_board->Add( loadMODULE_SECTION( line ), ADD_APPEND );
         }
 
         else if( TESTLINE( "$DRAWSEGMENT" ) )
@@ -461,6 +458,8 @@ void LEGACY_PLUGIN::loadAllSections( bool doAppend )
 
         else if( TESTLINE( "$EQUIPOT" ) )
         {
+            // The pads and tracks take the nets known when they are read
+            parseRecords( records );
             loadNETINFO_ITEM();
         }
 
@@ -471,7 +470,10 @@ void LEGACY_PLUGIN::loadAllSections( bool doAppend )
 
         else if( TESTLINE( "$TRACK" ) )
         {
-            loadTrackList( PCB_TRACE_T );
+            if( capture )
+                captureRecords( records, false );
+            else
+                loadTrackList( PCB_TRACE_T );
         }
 
         else if( TESTLINE( "$NCLASS" ) )
@@ -502,6 +504,8 @@ void LEGACY_PLUGIN::loadAllSections( bool doAppend )
 
         else if( TESTLINE( "$GENERAL" ) )
         {
+            // The units and the layer count apply to the following sections
+            parseRecords( records );
             loadGENERAL();
         }
 
@@ -514,6 +518,7 @@ void LEGACY_PLUGIN::loadAllSections( bool doAppend )
         {
             if( !doAppend )
             {
+                parseRecords( records );
                 loadSETUP();
             }
             else
@@ -528,13 +533,196 @@ void LEGACY_PLUGIN::loadAllSections( bool doAppend )
         }
 
         else if( TESTLINE( "$EndBOARD" ) )
+        {
+            parseRecords( records );
             return;     // preferred exit
+        }
     }
 
     THROW_IO_ERROR( "Missing '$EndBOARD'" );
 }
 
 
+/**
+ * A STRING_LINE_READER of a part of a file, which gives the line numbers of the file.
+ */
+class RECORD_LINE_READER : public STRING_LINE_READER
+{
+public:
+    RECORD_LINE_READER( const std::string& aText, const wxString& aSource, int aFirstLine ) :
+            STRING_LINE_READER( aText, aSource )
+    {
+        m_lineNum = aFirstLine - 1;
+    }
+};
+
+
+void LEGACY_PLUGIN::captureRecords( std::vector<BOARD_RECORD>& aRecords, bool aModule )
+{
+    char* line = m_reader->Line();
+
+    if( aModule )
+    {
+        aRecords.emplace_back();
+
+        BOARD_RECORD& record = aRecords.back();
+
+        record.m_isModule = true;
+        record.m_lineNumber = m_reader->LineNumber();
+        record.m_itemCount = 1;
+        record.m_text.assign( line, m_reader->Length() );
+
+        // A missing "$EndMODULE" is reported when the record is parsed
+        while( ( line = READLINE( m_reader ) ) != NULL )
+        {
+            record.m_text.append( line, m_reader->Length() );
+
+            if( TESTLINE( "$EndMODULE" ) )
+                break;
+        }
+
+        return;
+    }
+
+    // The tracks are two lines each, up to the "$EndTRACK" line, which ends each record.
+    BOARD_RECORD* record = NULL;
+    int           lineCount = 0;
+
+    while( ( line = READLINE( m_reader ) ) != NULL && line[0] != '$' )
+    {
+        if( !record || lineCount == 2 * TRACK_RECORD_SIZE )
+        {
+            if( record )
+                record->m_text += "$EndTRACK\n";
+
+            aRecords.emplace_back();
+            record = &aRecords.back();
+            record->m_isModule = false;
+            record->m_lineNumber = m_reader->LineNumber();
+            record->m_itemCount = 0;
+            lineCount = 0;
+        }
+
+        record->m_text.append( line, m_reader->Length() );
+
+        if( ++lineCount % 2 == 0 )
+            record->m_itemCount++;
+    }
+
+    if( !line )
+        THROW_IO_ERROR( "Missing '$EndTRACK'" );
+
+    if( record )
+        record->m_text.append( line, m_reader->Length() );
+}
+
+
+void LEGACY_PLUGIN::parseRecord( BOARD_RECORD& aRecord, const wxString& aSource )
+{
+    RECORD_LINE_READER reader( aRecord.m_text, aSource, aRecord.m_lineNumber );
+    LINE_READER*       mainReader = m_reader;
+
+    m_reader = &reader;
+
+    try
+    {
+        if( aRecord.m_isModule )
+        {
+            aRecord.m_items.push_back( loadMODULE_SECTION( READLINE( m_reader ) ) );
+        }
+        else
+        {
+            loadTrackList( PCB_TRACE_T, &aRecord.m_items );
+        }
+    }
+    catch( ... )
+    {
+        aRecord.m_error = std::current_exception();
+    }
+
+    m_reader = mainReader;
+}
+
+
+void LEGACY_PLUGIN::initWorker( const LEGACY_PLUGIN& aPlugin )
+{
+    m_board = aPlugin.m_board;
+    m_props = aPlugin.m_props;
+    m_cu_count = aPlugin.m_cu_count;
+    m_loading_format_version = aPlugin.m_loading_format_version;
+    m_netCodes = aPlugin.m_netCodes;
+    biuToDisk = aPlugin.biuToDisk;
+    diskToBiu = aPlugin.diskToBiu;
+}
+
+
+void LEGACY_PLUGIN::parseRecords( std::vector<BOARD_RECORD>& aRecords )
+{
+    if( aRecords.empty() )
+        return;
+
+    THREAD_POOL& pool = THREAD_POOL::GetPool();
+    size_t       count = aRecords.size();
+    wxString     source = m_reader->GetSource();
+    size_t       itemCount = 0;
+
+    for( const BOARD_RECORD& record : aRecords )
+        itemCount += record.m_itemCount;
+
+    if( itemCount >= (size_t) ADVANCED_CFG::GetCfg().m_parallelBoardLoadMinItems
+            && pool.GetThreadCount() > 1 )
+    {
+        // A few batches of records per thread, each one parsed by its own plugin.  Reading
+        // the footprints and tracks only looks up the nets of the board.
+        size_t batchCount = std::min( count, 4 * pool.GetThreadCount() );
+
+        pool.ParallelFor( batchCount,
+                [&]( size_t aBatch )
+                {
+                    LEGACY_PLUGIN plugin;
+
+                    plugin.initWorker( *this );
+
+                    for( size_t ii = aBatch * count / batchCount;
+                            ii < ( aBatch + 1 ) * count / batchCount; ++ii )
+                    {
+                        plugin.parseRecord( aRecords[ii], source );
+                    }
+                }, 1 );
+    }
+    else
+    {
+        for( BOARD_RECORD& record : aRecords )
+            parseRecord( record, source );
+    }
+
+    // Add the items in the order of the file
+    for( size_t ii = 0; ii < count; ++ii )
+    {
+        BOARD_RECORD& record = aRecords[ii];
+
+        if( record.m_error )
+        {
+            std::exception_ptr error = record.m_error;
+
+            for( size_t jj = ii; jj < count; ++jj )
+            {
+                for( BOARD_ITEM* item : aRecords[jj].m_items )
+                    delete item;
+            }
+
+            aRecords.clear();
+            std::rethrow_exception( error );
+        }
+
+        for( BOARD_ITEM* item : record.m_items )
+            m_board->Add( item, record.m_isModule ? ADD_APPEND : ADD_INSERT );
+    }
+
+    aRecords.clear();
+}
+
+
 void LEGACY_PLUGIN::checkVersion()
 {
     // Read first line and TEST if it is a PCB file format header like this:
@@ -1160,6 +1348,28 @@ void LEGACY_PLUGIN::loadSETUP()
 }
 
 
+MODULE* LEGACY_PLUGIN::loadMODULE_SECTION( char* aLine )
+{
+    unique_ptr<MODULE>    module( new MODULE( m_board ) );
+
+    LIB_ID      fpid;
+    std::string fpName = StrPurge( aLine + SZ( "$MODULE" ) );
+
+    // The footprint names in legacy libraries can contain the '/' and ':'
+    // characters which will cause the FPID parser to choke.
+    ReplaceIllegalFileNameChars( &fpName );
+
+    if( !fpName.empty() )
+        fpid.Parse( fpName, LIB_ID::ID_PCB, true );
+
+    module->SetFPID( fpid );
+
+    loadMODULE( module.get() );
+
+    return module.release();
+}
+
+
 void LEGACY_PLUGIN::loadMODULE( MODULE* aModule )
 {
     char*   line;
@@ -2207,7 +2417,7 @@ void LEGACY_PLUGIN::loadPCB_TEXT()
 }
 
 
-void LEGACY_PLUGIN::loadTrackList( int aStructType )
+void LEGACY_PLUGIN::loadTrackList( int aStructType, std::vector<BOARD_ITEM*>* aItems )
 {
     char*   line;
     char*   saveptr;
@@ -2356,7 +2566,10 @@ void LEGACY_PLUGIN::loadTrackList( int aStructType )
             newTrack->SetNetCode( getNetCode( net_code ) );
             newTrack->SetState( flags, true );
 
-            m_board->Add( newTrack );
+            if( aItems )
+                aItems->push_back( newTrack );
+            else
+                m_board->Add( newTrack );
         }
     }
 
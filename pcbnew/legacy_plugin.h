@@ -28,7 +28,9 @@
 #include <io_mgr.h>
 #include <string>
 #include <layers_id_colors_and_visibility.h>
+#include <exception>
 #include <memory>
+#include <vector>
 
 
 // FOOTPRINT_LIBRARY_HEADER_CNT gives the number of characters to compare to detect
@@ -54,6 +56,7 @@ class TEXTE_MODULE;
 class EDGE_MODULE;
 class TRACK;
 class D_PAD;
+class BOARD_ITEM;
 struct LP_CACHE;
 
 
@@ -183,12 +186,49 @@ protected:
      */
     double degParse( const char* aValue, const char** nptrptr = NULL );
 
+    /**
+     * A footprint, or a part of a track list, of a board, whose lines are read by
+     * captureRecord() to be parsed later, possibly by another thread.
+     */
+    struct BOARD_RECORD
+    {
+        bool                     m_isModule;     ///< true for a $MODULE, false for tracks
+        int                      m_lineNumber;   ///< line number of the first line of m_text
+        int                      m_itemCount;    ///< number of footprints or tracks
+        std::string              m_text;         ///< the lines of the section
+        std::vector<BOARD_ITEM*> m_items;        ///< the parsed items
+        std::exception_ptr       m_error;        ///< the parse error of this record, if any
+    };
+
+    ///> Number of tracks of the track list records
+    static const int TRACK_RECORD_SIZE = 256;
+
     //-----<load/parse functions>-----------------------------------------------
 
     void checkVersion();
 
     void loadAllSections( bool doAppend );
 
+    /**
+     * Read the lines of the $MODULE section or of the track list starting at the current
+     * line, into \a aRecords, without parsing them.  A track list gives one record for
+     * each TRACK_RECORD_SIZE tracks.
+     */
+    void captureRecords( std::vector<BOARD_RECORD>& aRecords, bool aModule );
+
+    ///> Parse a record into its items, with the line numbers of the file
+    void parseRecord( BOARD_RECORD& aRecord, const wxString& aSource );
+
+    ///> Copy the state of \a aPlugin needed to parse the records of its board
+    void initWorker( const LEGACY_PLUGIN& aPlugin );
+
+    /**
+     * Parse the records, on several threads for the big boards, and add their items to the
+     * board in the order of the file.  The records are cleared.
+     * @throw IO_ERROR the first error of the records, once the previous items were added
+     */
+    void parseRecords( std::vector<BOARD_RECORD>& aRecords );
+
 
     void loadGENERAL();
     void loadSETUP();
@@ -205,14 +245,18 @@ protected:
     void loadNETCLASS();
     void loadMODULE( MODULE* aModule );
 
+    ///> Load a footprint from its "$MODULE" header line \a aLine to its "$EndMODULE"
+    MODULE* loadMODULE_SECTION( char* aLine );
+
     /**
      * Function loadTrackList
      * reads a list of segments (Tracks and Vias, or Segzones)
      *
      * @param aStructType is either PCB_TRACE_T to indicate tracks and vias, or NOT_USED
      *                    to indicate oldschool zone segments (which are discarded).
+     * @param aItems receives the tracks and vias instead of the board, if not NULL.
      */
-    void loadTrackList( int aStructType );
+    void loadTrackList( int aStructType, std::vector<BOARD_ITEM*>* aItems = NULL );
 
     void loadZONE_CONTAINER();      // "$CZONE_OUTLINE"
     void loadDIMENSION();           // "$COTATION"
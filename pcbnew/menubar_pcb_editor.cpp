@@ -243,6 +243,7 @@ void PCB_EDIT_FRAME::ReCreateMenuBar()
 
     editMenu->AddSeparator();
     editMenu->AddItem( PCB_ACTIONS::zoneFillAll,            SELECTION_CONDITIONS::ShowAlways );
+    editMenu->AddItem( PCB_ACTIONS::zoneFillDirty,          SELECTION_CONDITIONS::ShowAlways );
     editMenu->AddItem( PCB_ACTIONS::zoneUnfillAll,          SELECTION_CONDITIONS::ShowAlways );
 
     editMenu->AddSeparator();
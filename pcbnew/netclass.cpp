@@ -152,6 +152,17 @@ NETCLASSPTR NETCLASSES::Find( const wxString& aName ) const
 }
 
 
+void NETCLASSES::CopyFrom( const NETCLASSES& aOther )
+{
+    m_default = std::make_shared<NETCLASS>( *aOther.m_default );
+
+    m_NetClasses.clear();
+
+    for( const auto& netclass : aOther.m_NetClasses )
+        m_NetClasses[ netclass.first ] = std::make_shared<NETCLASS>( *netclass.second );
+}
+
+
 void BOARD::SynchronizeNetsAndNetClasses()
 {
     NETCLASSES& netClasses = m_designSettings.m_NetClasses;
@@ -225,6 +236,30 @@ void BOARD::SynchronizeNetsAndNetClasses()
     m_designSettings.SetCustomDiffPairWidth( defaultNetClass->GetDiffPairWidth() );
     m_designSettings.SetCustomDiffPairGap( defaultNetClass->GetDiffPairGap() );
     m_designSettings.SetCustomDiffPairViaGap( defaultNetClass->GetDiffPairViaGap() );
+
+    BuildNetClearances();
+}
+
+
+void BOARD::BuildNetClearances()
+{
+    NETCLASSPTR defaultNetClass = m_designSettings.m_NetClasses.GetDefault();
+    int         maxNetCode = 0;
+
+    m_defaultNetClearance = defaultNetClass->GetClearance();
+
+    for( NETINFO_ITEM* net : m_NetInfo )
+        maxNetCode = std::max( maxNetCode, net->GetNet() );
+
+    m_netClearances.assign( maxNetCode + 1, m_defaultNetClearance );
+
+    for( NETINFO_ITEM* net : m_NetInfo )
+    {
+        NETCLASSPTR netclass = net->GetNetClass();
+
+        if( net->GetNet() > 0 && netclass )
+            m_netClearances[ net->GetNet() ] = netclass->GetClearance();
+    }
 }
 
 
@@ -295,6 +295,13 @@ public:
      */
     NETCLASSPTR Find( const wxString& aName ) const;
 
+    /**
+     * Function CopyFrom
+     * replaces the content of this container by copies of the NETCLASSes of \a aOther,
+     * including the default one, so that they are not shared with \a aOther.
+     */
+    void CopyFrom( const NETCLASSES& aOther );
+
     /// Provide public access to m_NetClasses so it gets swigged.
     NETCLASS_MAP&   NetClasses()       { return m_NetClasses; }
 };
@@ -34,6 +34,9 @@
 #include <netclass.h>
 #include <class_board_item.h>
 
+#include <unordered_map>
+#include <vector>
+
 
 
 class wxDC;
@@ -564,6 +567,11 @@ private:
     NETNAMES_MAP m_netNames;        ///< map of <wxString, NETINFO_ITEM*>, is NETINFO_ITEM owner
     NETCODES_MAP m_netCodes;        ///< map of <int, NETINFO_ITEM*> is NOT owner
 
+    ///> The nets indexed by net code (NULL for the unused codes), and hashed by name, for
+    ///> the lookups.  The maps above keep the order of the iterations.
+    std::vector<NETINFO_ITEM*>                  m_netsByCode;
+    std::unordered_map<wxString, NETINFO_ITEM*> m_netsByName;
+
     int m_newNetCode;               ///< possible value for new net code assignment
 };
 
@@ -58,16 +58,16 @@ void NETINFO_LIST::clear()
 
     m_netNames.clear();
     m_netCodes.clear();
+    m_netsByCode.clear();
+    m_netsByName.clear();
     m_newNetCode = 0;
 }
 
 
 NETINFO_ITEM* NETINFO_LIST::GetNetItem( int aNetCode ) const
 {
-    NETCODES_MAP::const_iterator result = m_netCodes.find( aNetCode );
-
-    if( result != m_netCodes.end() )
-        return (*result).second;
+    if( aNetCode >= 0 && aNetCode < (int) m_netsByCode.size() )
+        return m_netsByCode[aNetCode];
 
     return NULL;
 }
@@ -75,10 +75,10 @@ NETINFO_ITEM* NETINFO_LIST::GetNetItem( int aNetCode ) const
 
 NETINFO_ITEM* NETINFO_LIST::GetNetItem( const wxString& aNetName ) const
 {
-    NETNAMES_MAP::const_iterator result = m_netNames.find( aNetName );
+    auto result = m_netsByName.find( aNetName );
 
-    if( result != m_netNames.end() )
-        return (*result).second;
+    if( result != m_netsByName.end() )
+        return result->second;
 
     return NULL;
 }
@@ -104,6 +104,20 @@ void NETINFO_LIST::RemoveNet( NETINFO_ITEM* aNet )
         }
     }
 
+    for( NETINFO_ITEM*& net : m_netsByCode )
+    {
+        if( net == aNet )
+            net = NULL;
+    }
+
+    while( !m_netsByCode.empty() && !m_netsByCode.back() )
+        m_netsByCode.pop_back();
+
+    auto byName = m_netsByName.find( aNet->GetNetname() );
+
+    if( byName != m_netsByName.end() && byName->second == aNet )
+        m_netsByName.erase( byName );
+
     m_newNetCode = std::min( m_newNetCode, aNet->m_NetCode - 1 );
 }
 
@@ -133,6 +147,12 @@ void NETINFO_LIST::AppendNet( NETINFO_ITEM* aNewElement )
     // add an entry for fast look up by a net name using a map
     m_netNames.insert( std::make_pair( aNewElement->GetNetname(), aNewElement ) );
     m_netCodes.insert( std::make_pair( aNewElement->GetNet(), aNewElement ) );
+
+    if( aNewElement->GetNet() >= (int) m_netsByCode.size() )
+        m_netsByCode.resize( aNewElement->GetNet() + 1, NULL );
+
+    m_netsByCode[ aNewElement->GetNet() ] = aNewElement;
+    m_netsByName[ aNewElement->GetNetname() ] = aNewElement;
 }
 
 
@@ -177,7 +197,7 @@ int NETINFO_LIST::getFreeNetCode()
     do {
         if( m_newNetCode < 0 )
             m_newNetCode = 0;
-    } while( m_netCodes.count( ++m_newNetCode ) != 0 );
+    } while( GetNetItem( ++m_newNetCode ) != NULL );
 
     return m_newNetCode;
 }
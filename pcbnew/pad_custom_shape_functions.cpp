@@ -235,6 +235,7 @@ void D_PAD::DeletePrimitivesList()
 {
     m_basicShapes.clear();
     m_customShapeAsPolygon.RemoveAllContours();
+    m_shapeBoundingBoxValid = false;
 }
 
 
@@ -376,6 +377,7 @@ bool D_PAD::MergePrimitivesAsPolygon( SHAPE_POLY_SET* aMergedPolygon )
         return false;
 
     m_boundingRadius = -1;  // The current bouding radius is no more valid.
+    m_shapeBoundingBoxValid = false;
 
     return aMergedPolygon->OutlineCount() <= 1;
 }
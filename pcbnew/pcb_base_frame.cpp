@@ -124,8 +124,22 @@ void PCB_BASE_FRAME::Update3DView( bool aForceReload, const wxString* aTitle )
         if( aTitle )
             draw3DFrame->SetTitle( *aTitle );
 
-        draw3DFrame->NewDisplay( aForceReload );
+        if( m_changed3DLayers && !aForceReload )
+            draw3DFrame->ReloadLayersRequest( *m_changed3DLayers );
+        else
+            draw3DFrame->NewDisplay( aForceReload );
     }
+
+    m_changed3DLayers = NULLOPT;
+}
+
+
+void PCB_BASE_FRAME::SetChanged3DLayers( const LSET& aLayers )
+{
+    if( m_changed3DLayers )
+        *m_changed3DLayers |= aLayers;
+    else
+        m_changed3DLayers = aLayers;
 }
 
 
@@ -38,11 +38,12 @@
 #include <class_marker_pcb.h>
 #include <pcb_base_frame.h>
 #include <confirm.h>
+#include <thread_pool.h>
+#include <advanced_config.h>
 
 #include <gal/graphics_abstraction_layer.h>
 
 #include <functional>
-#include <thread>
 using namespace std::placeholders;
 
 const LAYER_NUM GAL_LAYER_ORDER[] =
@@ -144,27 +145,26 @@ void PCB_DRAW_PANEL_GAL::DisplayBoard( BOARD* aBoard )
 
     m_view->Clear();
 
-    auto zones = aBoard->Zones();
-    std::atomic<size_t> next( 0 );
-    std::atomic<size_t> count_done( 0 );
-    size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
+    auto         zones = aBoard->Zones();
+    THREAD_POOL& pool = THREAD_POOL::GetPool();
 
-    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-    {
-        std::thread t = std::thread( [ &count_done, &next, &zones ]( )
-        {
-            for( size_t i = next.fetch_add( 1 ); i < zones.size(); i = next.fetch_add( 1 ) )
-                zones[i]->CacheTriangulation();
-
-            count_done++;
-        } );
-
-        t.detach();
-    }
+    // The zones are triangulated on the worker threads while the other items are loaded
+    std::future<void> triangulation = pool.Async( [&pool, &zones]()
+            {
+                pool.ParallelFor( zones.size(),
+                        [&zones]( size_t i )
+                        {
+                            zones[i]->CacheTriangulation();
+                        },
+                        1, ADVANCED_CFG::GetCfg().m_maxZoneFillThreads );
+            } );
 
     if( m_worksheet )
         m_worksheet->SetFileName( TO_UTF8( aBoard->GetFileName() ) );
 
+    // The layer trees are packed once all the items are known
+    m_view->BeginBulkAdd();
+
     // Load drawings
     for( auto drawing : const_cast<BOARD*>(aBoard)->Drawings() )
         m_view->Add( drawing );
@@ -184,8 +184,7 @@ void PCB_DRAW_PANEL_GAL::DisplayBoard( BOARD* aBoard )
     }
 
     // Finalize the triangulation threads
-    while( count_done < parallelThreadCount )
-        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    triangulation.wait();
 
     // Load zones
     for( auto zone : aBoard->Zones() )
@@ -194,6 +193,8 @@ void PCB_DRAW_PANEL_GAL::DisplayBoard( BOARD* aBoard )
     // Ratsnest
     m_ratsnest.reset( new KIGFX::RATSNEST_VIEWITEM( aBoard->GetConnectivity() ) );
     m_view->Add( m_ratsnest.get() );
+
+    m_view->EndBulkAdd();
 }
 
 
@@ -23,6 +23,7 @@
 #include <fctsys.h>
 #include <kiface_i.h>
 #include <pgm_base.h>
+#include <common.h>
 #include <confirm.h>
 #include <pcb_edit_frame.h>
 #include <collectors.h>
@@ -190,6 +191,7 @@ PCB_EDIT_FRAME::PCB_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
     m_hasAutoSave = true;
     m_microWaveToolBar = NULL;
     m_Layers = nullptr;
+    m_backgroundSaveBackup = false;
     m_FrameSize = ConvertDialogToPixels( wxSize( 500, 350 ) );    // default in case of no prefs
 
     // We don't know what state board was in when it was lasat saved, so we have to
@@ -221,6 +223,7 @@ PCB_EDIT_FRAME::PCB_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
 
     SetScreen( new PCB_SCREEN( GetPageSettings().GetSizeIU() ) );
     GetScreen()->SetMaxUndoItems( m_UndoRedoCountMax );
+    GetScreen()->SetMaxUndoMemory( m_UndoRedoMemoryMax );
 
     // PCB drawings start in the upper left corner.
     GetScreen()->m_Center = false;
@@ -342,6 +345,9 @@ PCB_EDIT_FRAME::PCB_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
 
 PCB_EDIT_FRAME::~PCB_EDIT_FRAME()
 {
+    // The background save thread must not outlive the frame
+    if( m_backgroundSave.valid() )
+        m_backgroundSave.wait();
 }
 
 
@@ -466,13 +472,20 @@ void PCB_EDIT_FRAME::OnQuit( wxCommandEvent& event )
 
 void PCB_EDIT_FRAME::OnCloseWindow( wxCloseEvent& Event )
 {
+    // A failed background save marks the board modified again
+    WaitBackgroundSave();
+
     if( GetScreen()->IsModify() && !GetBoard()->IsEmpty() )
     {
         wxFileName fileName = GetBoard()->GetFileName();
         wxString msg = _( "Save changes to \"%s\" before closing?" );
 
         if( !HandleUnsavedChanges( this, wxString::Format( msg, fileName.GetFullName() ),
-                                   [&]()->bool { return Files_io_from_id( ID_SAVE_BOARD ); } ) )
+                                   [&]()->bool
+                                   {
+                                       return Files_io_from_id( ID_SAVE_BOARD )
+                                              && WaitBackgroundSave();
+                                   } ) )
         {
             Event.Veto();
             return;
@@ -22,6 +22,7 @@
 #define  WXPCB_STRUCT_H_
 
 #include <unordered_map>
+#include <future>
 #include <map>
 #include "pcb_base_edit_frame.h"
 #include "config_params.h"
@@ -97,6 +98,12 @@ protected:
 
     wxString          m_lastNetListRead;        ///< Last net list read with relative path.
 
+    // The running background save, see SavePcbFileInBackground()
+    std::future<wxString> m_backgroundSave;         ///< error message, empty on success
+    wxString              m_backgroundSaveFile;     ///< the board file being written
+    wxString              m_backgroundSaveTmpFile;  ///< the file actually written
+    bool                  m_backgroundSaveBackup;   ///< create a backup when done
+
     // The Tool Framework initalization
     void setupTools();
 
@@ -211,6 +218,31 @@ protected:
      */
     bool doAutoSave() override;
 
+    /**
+     * Function saveBoardSnapshot
+     * writes the board as a binary snapshot (see #PCB_SNAPSHOT_IO), for the auto save.
+     *
+     * @return true if the snapshot was written.
+     */
+    bool saveBoardSnapshot( const wxString& aFileName );
+
+    /**
+     * Function finishBackgroundSave
+     * moves the file written by the background save in place and reports the result, if
+     * the background save is over.  It is called on the UI thread.
+     *
+     * @return false if the save failed.
+     */
+    bool finishBackgroundSave();
+
+    /**
+     * Function onBoardFileSaved
+     * updates the board file name, the title, the file history and the message panel after
+     * \a aFileName was written, and removes its auto save file.
+     */
+    void onBoardFileSaved( const wxFileName& aFileName, const wxString& aBackupFileName,
+                           bool aUpdateFileHistory );
+
     /**
      * Function isautoSaveRequired
      * returns true if the board has been modified.
@@ -650,6 +682,28 @@ public:
      */
     bool SavePcbFile( const wxString& aFileName, bool aCreateBackupFile = CREATE_BACKUP_FILE );
 
+    /**
+     * Function SavePcbFileInBackground
+     * writes a copy of the board to \a aFileName on a background thread.  The file is
+     * written under a temporary name and renamed when complete, so \a aFileName is never
+     * left half written.  The board is marked saved now, and marked modified again if the
+     * save fails.  A running background save is waited for first.
+     *
+     * @param aFileName The file name to write.
+     * @param aCreateBackupFile Creates a back of \a aFileName if true.
+     * @return True if the save was started.
+     */
+    bool SavePcbFileInBackground( const wxString& aFileName,
+                                  bool aCreateBackupFile = CREATE_BACKUP_FILE );
+
+    /**
+     * Function WaitBackgroundSave
+     * waits for the running background save, if any, and reports its result.
+     *
+     * @return false if the background save failed.
+     */
+    bool WaitBackgroundSave();
+
     /**
      * Function SavePcbCopy
      * writes the board data structures to \a a aFileName
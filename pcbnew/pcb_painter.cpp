@@ -44,6 +44,7 @@
 #include <gal/graphics_abstraction_layer.h>
 #include <geometry/geometry_utils.h>
 #include <geometry/shape_line_chain.h>
+#include <trigo.h>
 
 
 using namespace KIGFX;
@@ -375,6 +376,46 @@ bool PCB_PAINTER::Draw( const VIEW_ITEM* aItem, int aLayer )
 }
 
 
+bool PCB_PAINTER::DrawProxy( const VIEW_ITEM* aItem, int aLayer )
+{
+    const EDA_ITEM* item = dynamic_cast<const EDA_ITEM*>( aItem );
+
+    if( !item )
+        return false;
+
+    switch( item->Type() )
+    {
+    case PCB_TEXT_T:
+    {
+        const TEXTE_PCB* text = static_cast<const TEXTE_PCB*>( item );
+        drawProxy( text, text->GetTextAngle(), m_pcbSettings.GetColor( text, text->GetLayer() ) );
+        break;
+    }
+
+    case PCB_MODULE_TEXT_T:
+    {
+        const TEXTE_MODULE* text = static_cast<const TEXTE_MODULE*>( item );
+        drawProxy( text, text->GetDrawRotation(), m_pcbSettings.GetColor( text, aLayer ) );
+        break;
+    }
+
+    case PCB_MODULE_T:
+        drawProxy( static_cast<const MODULE*>( item ), aLayer );
+        break;
+
+    case PCB_ZONE_AREA_T:
+        draw( static_cast<const ZONE_CONTAINER*>( item ), aLayer, true );
+        break;
+
+    default:
+        // There is no simplified representation of the object
+        return false;
+    }
+
+    return true;
+}
+
+
 void PCB_PAINTER::draw( const TRACK* aTrack, int aLayer )
 {
     VECTOR2D start( aTrack->GetStart() );
@@ -1031,7 +1072,77 @@ void PCB_PAINTER::draw( const MODULE* aModule, int aLayer )
 }
 
 
-void PCB_PAINTER::draw( const ZONE_CONTAINER* aZone, int aLayer )
+void PCB_PAINTER::drawProxy( const EDA_TEXT* aText, double aOrientation, const COLOR4D& aColor )
+{
+    if( aText->GetShownText().Length() == 0 )
+        return;
+
+    // A bar through the middle of the text box, thinner than the box so that
+    // the lines of text stay apart
+    EDA_RECT box = aText->GetTextBox();
+    wxPoint  start( box.GetX(), box.Centre().y );
+    wxPoint  end( box.GetRight(), box.Centre().y );
+
+    RotatePoint( &start, aText->GetTextPos(), aOrientation );
+    RotatePoint( &end, aText->GetTextPos(), aOrientation );
+
+    m_gal->SetStrokeColor( aColor );
+    m_gal->SetIsFill( false );
+    m_gal->SetIsStroke( true );
+    m_gal->SetLineWidth( std::min( box.GetHeight(), aText->GetTextHeight() ) * 0.6 );
+    m_gal->DrawLine( start, end );
+}
+
+
+void PCB_PAINTER::drawProxy( const MODULE* aModule, int aLayer )
+{
+    // Impostor for the graphic items, hidden at this scale
+    const EDA_RECT area = aModule->GetFootprintRect();
+
+    m_gal->SetStrokeColor( m_pcbSettings.GetColor( aModule, aLayer ) );
+    m_gal->SetIsFill( false );
+    m_gal->SetIsStroke( true );
+    m_gal->SetLineWidth( m_pcbSettings.m_outlineWidth );
+    m_gal->DrawRectangle( VECTOR2D( area.GetOrigin() ), VECTOR2D( area.GetEnd() ) );
+}
+
+
+/**
+ * Drops the vertices of a closed outline that are closer than aTolerance to the previous
+ * vertex kept, unless the outline would degenerate.
+ */
+static SHAPE_LINE_CHAIN decimateOutline( const SHAPE_LINE_CHAIN& aOutline, int aTolerance )
+{
+    if( aOutline.PointCount() <= 3 )
+        return aOutline;
+
+    const SEG::ecoord minDistSq = (SEG::ecoord) aTolerance * aTolerance;
+    SHAPE_LINE_CHAIN  decimated;
+    VECTOR2I          last = aOutline.CPoint( 0 );
+
+    decimated.Append( last );
+
+    for( int i = 1; i < aOutline.PointCount(); ++i )
+    {
+        const VECTOR2I& p = aOutline.CPoint( i );
+
+        if( ( p - last ).SquaredEuclideanNorm() >= minDistSq )
+        {
+            decimated.Append( p );
+            last = p;
+        }
+    }
+
+    if( decimated.PointCount() < 3 )
+        return aOutline;
+
+    decimated.SetClosed( true );
+
+    return decimated;
+}
+
+
+void PCB_PAINTER::draw( const ZONE_CONTAINER* aZone, int aLayer, bool aDecimate )
 {
     if( !aZone->IsOnLayer( (PCB_LAYER_ID) aLayer ) )
         return;
@@ -1082,6 +1193,28 @@ void PCB_PAINTER::draw( const ZONE_CONTAINER* aZone, int aLayer )
 
         // Set up drawing options
         int outline_thickness = aZone->GetFilledPolysUseThickness() ? aZone->GetMinThickness() : 0;
+        SHAPE_POLY_SET decimated;
+
+        if( aDecimate )
+        {
+            // Zoomed out, the minimum thickness takes only a few pixels: decimate the outlines by
+            // a quarter of it and leave out the outline stroke of the filled area
+            int tolerance = aZone->GetMinThickness() / 4;
+
+            for( int ii = 0; ii < polySet.OutlineCount(); ++ii )
+            {
+                int outline = decimated.AddOutline( decimateOutline( polySet.COutline( ii ),
+                                                                     tolerance ) );
+
+                for( int jj = 0; jj < polySet.HoleCount( ii ); ++jj )
+                    decimated.AddHole( decimateOutline( polySet.CHole( ii, jj ), tolerance ),
+                                       outline );
+            }
+
+            if( displayMode == PCB_RENDER_SETTINGS::DZ_SHOW_FILLED )
+                outline_thickness = 0;
+        }
+
         m_gal->SetStrokeColor( color );
         m_gal->SetFillColor( color );
         m_gal->SetLineWidth( outline_thickness );
@@ -1097,7 +1230,7 @@ void PCB_PAINTER::draw( const ZONE_CONTAINER* aZone, int aLayer )
             m_gal->SetIsStroke( true );
         }
 
-        m_gal->DrawPolygon( polySet );
+        m_gal->DrawPolygon( aDecimate ? decimated : polySet );
     }
 
 }
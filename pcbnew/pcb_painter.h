@@ -33,6 +33,7 @@
 
 
 class EDA_ITEM;
+class EDA_TEXT;
 class COLORS_DESIGN_SETTINGS;
 class PCB_DISPLAY_OPTIONS;
 
@@ -243,6 +244,9 @@ public:
     /// @copydoc PAINTER::Draw()
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) override;
 
+    /// @copydoc PAINTER::DrawProxy()
+    virtual bool DrawProxy( const VIEW_ITEM* aItem, int aLayer ) override;
+
 protected:
     PCB_RENDER_SETTINGS m_pcbSettings;
 
@@ -254,11 +258,15 @@ protected:
     void draw( const TEXTE_PCB* aText, int aLayer );
     void draw( const TEXTE_MODULE* aText, int aLayer );
     void draw( const MODULE* aModule, int aLayer );
-    void draw( const ZONE_CONTAINER* aZone, int aLayer );
+    void draw( const ZONE_CONTAINER* aZone, int aLayer, bool aDecimate = false );
     void draw( const DIMENSION* aDimension, int aLayer );
     void draw( const PCB_TARGET* aTarget );
     void draw( const MARKER_PCB* aMarker );
 
+    // Simplified drawing functions used when zoomed out
+    void drawProxy( const EDA_TEXT* aText, double aOrientation, const COLOR4D& aColor );
+    void drawProxy( const MODULE* aModule, int aLayer );
+
     /**
      * Function getLineThickness()
      * Get the thickness to draw for a line (e.g. 0 thickness lines
@@ -31,6 +31,7 @@
 #include <common.h>
 #include <confirm.h>
 #include <macros.h>
+#include <kicad_string.h>
 #include <trigo.h>
 #include <title_block.h>
 
@@ -50,6 +51,9 @@
 #include <zones.h>
 #include <pcb_parser.h>
 #include <convert_basic_shapes_to_polygon.h>    // for RECT_CHAMFER_POSITIONS definition
+#include <advanced_config.h>
+#include <thread_pool.h>
+#include <profile_registry.h>
 
 using namespace PCB_KEYS_T;
 
@@ -129,7 +133,7 @@ double PCB_PARSER::parseDouble()
 
     errno = 0;
 
-    double fval = strtod( CurText(), &tmp );
+    double fval = StrToDouble( CurText(), &tmp );
 
     if( errno )
     {
@@ -460,11 +464,18 @@ BOARD_ITEM* PCB_PARSER::Parse()
     switch( NextTok() )
     {
     case T_kicad_pcb:
+    {
         if( m_board == NULL )
             m_board = new BOARD();
 
+        if( ADVANCED_CFG::GetCfg().m_boardItemArena )
+            m_board->UseItemArena();
+
+        BOARD_ITEM_ARENA::SCOPE arenaScope( m_board->GetItemArena() );
+
         item = (BOARD_ITEM*) parseBOARD();
         break;
+    }
 
     case T_module:
         item = (BOARD_ITEM*) parseMODULE( initial_comments.release() );
@@ -502,85 +513,110 @@ BOARD* PCB_PARSER::parseBOARD_unchecked()
 
     parseHeader();
 
-    for( token = NextTok();  token != T_RIGHT;  token = NextTok() )
+    // The footprints, tracks and zones, which are most of the file, are read first and
+    // parsed at the end, on several threads for the big boards.
+    std::vector<BOARD_RECORD> records;
+    bool captureRecords = ADVANCED_CFG::GetCfg().m_parallelBoardLoadMinItems > 0
+                          && THREAD_POOL::GetPool().GetThreadCount() > 1;
+
+    try
     {
-        if( token != T_LEFT )
-            Expecting( T_LEFT );
+        for( token = NextTok();  token != T_RIGHT;  token = NextTok() )
+        {
+            if( token != T_LEFT )
+                Expecting( T_LEFT );
 
-        token = NextTok();
+            token = NextTok();
 
-        switch( token )
-        {
-        case T_general:
-            parseGeneralSection();
-            break;
+            if( captureRecords
+                    && ( token == T_module || token == T_segment || token == T_via || token == T_zone ) )
+            {
+                records.emplace_back();
+                captureRecord( records.back() );
+                continue;
+            }
 
-        case T_page:
-            parsePAGE_INFO();
-            break;
+            switch( token )
+            {
+            case T_general:
+                parseGeneralSection();
+                break;
 
-        case T_title_block:
-            parseTITLE_BLOCK();
-            break;
+            case T_page:
+                parsePAGE_INFO();
+                break;
 
-        case T_layers:
-            parseLayers();
-            break;
+            case T_title_block:
+                parseTITLE_BLOCK();
+                break;
 
-        case T_setup:
-            parseSetup();
-            break;
+            case T_layers:
+                parseLayers();
+                break;
 
-        case T_net:
-            parseNETINFO_ITEM();
-            break;
+            case T_setup:
+                parseSetup();
+                break;
 
-        case T_net_class:
-            parseNETCLASS();
-            break;
+            case T_net:
+                parseNETINFO_ITEM();
+                break;
 
-        case T_gr_arc:
-        case T_gr_circle:
-        case T_gr_curve:
-        case T_gr_line:
-        case T_gr_poly:
-            m_board->Add( parseDRAWSEGMENT(), ADD_APPEND );
-            break;
+            case T_net_class:
+                parseNETCLASS();
+                break;
 
-        case T_gr_text:
-            m_board->Add( parseTEXTE_PCB(), ADD_APPEND );
-            break;
+            case T_gr_arc:
+            case T_gr_circle:
+            case T_gr_curve:
+            case T_gr_line:
+            case T_gr_poly:
+                m_board->Add( parseDRAWSEGMENT(), ADD_APPEND );
+                break;
 
-        case T_dimension:
-            m_board->Add( parseDIMENSION(), ADD_APPEND );
-            break;
+            case T_gr_text:
+                m_board->Add( parseTEXTE_PCB(), ADD_APPEND );
+                break;
 
-        case T_module:
-            m_board->Add( parseMODULE(), ADD_APPEND );
-            break;
+            case T_dimension:
+                m_board->Add( parseDIMENSION(), ADD_APPEND );
+                break;
 
-        case T_segment:
-            m_board->Add( parseTRACK(), ADD_INSERT );
-            break;
+            case T_module:
+                m_board->Add( parseMODULE(), ADD_APPEND );
+                break;
 
-        case T_via:
-            m_board->Add( parseVIA(), ADD_INSERT );
-            break;
+            case T_segment:
+                m_board->Add( parseTRACK(), ADD_INSERT );
+                break;
 
-        case T_zone:
-            m_board->Add( parseZONE_CONTAINER(), ADD_APPEND );
-            break;
+            case T_via:
+                m_board->Add( parseVIA(), ADD_INSERT );
+                break;
 
-        case T_target:
-            m_board->Add( parsePCB_TARGET(), ADD_APPEND );
-            break;
+            case T_zone:
+                m_board->Add( parseZONE_CONTAINER(), ADD_APPEND );
+                break;
 
-        default:
-            wxString err;
-            err.Printf( _( "Unknown token \"%s\"" ), GetChars( FromUTF8() ) );
-            THROW_PARSE_ERROR( err, CurSource(), CurLine(), CurLineNumber(), CurOffset() );
+            case T_target:
+                m_board->Add( parsePCB_TARGET(), ADD_APPEND );
+                break;
+
+            default:
+                wxString err;
+                err.Printf( _( "Unknown token \"%s\"" ), GetChars( FromUTF8() ) );
+                THROW_PARSE_ERROR( err, CurSource(), CurLine(), CurLineNumber(), CurOffset() );
+            }
         }
     }
+    catch( ... )
+    {
+        // An error in a record before this one is reported first, as when parsing in sequence
+        parseRecords( records );
+        throw;
+    }
+
+    parseRecords( records );
 
     if( m_undefinedLayers.size() > 0 )
     {
@@ -665,6 +701,257 @@ BOARD* PCB_PARSER::parseBOARD_unchecked()
 }
 
 
+/**
+ * A STRING_LINE_READER of a part of a file, which gives the line numbers of the file.
+ */
+class RECORD_LINE_READER : public STRING_LINE_READER
+{
+public:
+    RECORD_LINE_READER( const std::string& aText, const wxString& aSource, int aFirstLine ) :
+            STRING_LINE_READER( aText, aSource )
+    {
+        m_lineNum = aFirstLine - 1;
+    }
+};
+
+
+void PCB_PARSER::captureRecord( BOARD_RECORD& aRecord )
+{
+    aRecord.m_token = CurTok();
+    aRecord.m_lineNumber = CurLineNumber();
+    aRecord.m_item = NULL;
+    aRecord.m_deferred = true;
+
+    // Keep the keyword at its column, so that the errors give the same offsets as when
+    // parsing the file, after its opening parenthesis.
+    const char* line = start + curOffset;
+
+    aRecord.m_text.assign( std::max( curOffset - 1, 0 ), ' ' );
+    aRecord.m_text += '(';
+
+    // Match the parentheses as the lexer would split the tokens: they are separators, except
+    // in the quoted strings, which start a token and end on the same line.
+    int         depth = 1;
+    const char* cur = next;
+
+    for( ;; )
+    {
+        bool inString = false;
+        bool tokenStart = true;
+
+        for( ; cur < limit; ++cur )
+        {
+            if( inString )
+            {
+                if( *cur == '\\' && cur + 1 < limit )
+                    ++cur;
+                else if( *cur == '"' )
+                    inString = false;
+            }
+            else if( *cur == '"' && tokenStart )
+            {
+                inString = true;
+            }
+            else if( *cur == '(' || *cur == ')' )
+            {
+                tokenStart = true;
+
+                if( *cur == ')' && --depth == 0 )
+                {
+                    aRecord.m_text.append( line, cur + 1 );
+                    next = cur + 1;
+                    return;
+                }
+                else if( *cur == '(' )
+                {
+                    ++depth;
+                }
+            }
+            else
+            {
+                tokenStart = (unsigned char) *cur <= ' ';
+            }
+        }
+
+        aRecord.m_text.append( line, limit );
+
+        // At the end of the file, the record is incomplete and reports it when parsed
+        if( readLine() == 0 )
+            break;
+
+        line = start;
+        cur = start;
+
+        // Skip the comment lines, as the lexer does
+        while( cur < limit && (unsigned char) *cur <= ' ' )
+            ++cur;
+
+        if( cur < limit && *cur == '#' )
+            cur = limit;
+    }
+}
+
+
+BOARD_ITEM* PCB_PARSER::parseRecord( const BOARD_RECORD& aRecord, const wxString& aSource )
+{
+    RECORD_LINE_READER reader( aRecord.m_text, aSource, aRecord.m_lineNumber );
+    BOARD_ITEM*        item = NULL;
+
+    PushReader( &reader );
+
+    // a previous record may have failed at its end of file
+    curTok = DSN_NONE;
+
+    try
+    {
+        NeedLEFT();
+        NextTok();
+
+        switch( aRecord.m_token )
+        {
+        case T_module:  item = parseMODULE();         break;
+        case T_segment: item = parseTRACK();          break;
+        case T_via:     item = parseVIA();            break;
+        case T_zone:    item = parseZONE_CONTAINER(); break;
+        default:        wxFAIL_MSG( wxT( "Unexpected record" ) );
+        }
+    }
+    catch( ... )
+    {
+        PopReader();
+        throw;
+    }
+
+    PopReader();
+
+    return item;
+}
+
+
+void PCB_PARSER::initWorker( const PCB_PARSER& aParser )
+{
+    m_board = aParser.m_board;
+    m_layerIndices = aParser.m_layerIndices;
+    m_layerMasks = aParser.m_layerMasks;
+    m_netCodes = aParser.m_netCodes;
+    m_tooRecent = aParser.m_tooRecent;
+    m_requiredVersion = aParser.m_requiredVersion;
+    m_showLegacyZoneWarning = aParser.m_showLegacyZoneWarning;
+    m_deferBoardChanges = false;
+}
+
+
+void PCB_PARSER::parseRecords( std::vector<BOARD_RECORD>& aRecords )
+{
+    PROF_SCOPE   profScope( "parse records" );
+    THREAD_POOL& pool = THREAD_POOL::GetPool();
+    size_t       count = aRecords.size();
+    wxString     source = CurSource();
+
+    if( count >= (size_t) ADVANCED_CFG::GetCfg().m_parallelBoardLoadMinItems
+            && pool.GetThreadCount() > 1 )
+    {
+        // A few batches of records per thread, each one parsed by its own parser.  The items
+        // which need to change the board are left to the main parser.
+        size_t                          batchCount = std::min( count, 4 * pool.GetThreadCount() );
+        std::vector<std::set<wxString>> undefinedLayers( batchCount );
+        std::vector<int>                versions( batchCount, 0 );
+
+        pool.ParallelFor( batchCount,
+                [&]( size_t aBatch )
+                {
+                    BOARD_ITEM_ARENA::SCOPE arenaScope( m_board->GetItemArena() );
+                    PCB_PARSER              parser;
+
+                    parser.initWorker( *this );
+                    parser.m_deferBoardChanges = true;
+
+                    for( size_t ii = aBatch * count / batchCount;
+                            ii < ( aBatch + 1 ) * count / batchCount; ++ii )
+                    {
+                        BOARD_RECORD& record = aRecords[ii];
+
+                        try
+                        {
+                            record.m_item = parser.parseRecord( record, source );
+                            record.m_deferred = false;
+                        }
+                        catch( const DEFERRED_RECORD& )
+                        {
+                        }
+                        catch( ... )
+                        {
+                            record.m_error = std::current_exception();
+                            record.m_deferred = false;
+                        }
+                    }
+
+                    undefinedLayers[aBatch] = std::move( parser.m_undefinedLayers );
+                    versions[aBatch] = parser.m_requiredVersion;
+                }, 1 );
+
+        for( size_t ii = 0; ii < batchCount; ++ii )
+        {
+            m_undefinedLayers.insert( undefinedLayers[ii].begin(), undefinedLayers[ii].end() );
+            m_requiredVersion = std::max( m_requiredVersion, versions[ii] );
+        }
+
+        m_tooRecent = ( m_requiredVersion > SEXPR_BOARD_FILE_VERSION );
+    }
+
+    // Add the items in the order of the file, parsing the remaining records in sequence
+    PCB_PARSER parser;
+
+    parser.initWorker( *this );
+
+    auto updateParser = [&]()
+    {
+        m_netCodes = parser.m_netCodes;
+        m_showLegacyZoneWarning = parser.m_showLegacyZoneWarning;
+        m_undefinedLayers.insert( parser.m_undefinedLayers.begin(),
+                                  parser.m_undefinedLayers.end() );
+        m_requiredVersion = std::max( m_requiredVersion, parser.m_requiredVersion );
+        m_tooRecent = ( m_requiredVersion > SEXPR_BOARD_FILE_VERSION );
+    };
+
+    for( size_t ii = 0; ii < count; ++ii )
+    {
+        BOARD_RECORD& record = aRecords[ii];
+
+        if( record.m_deferred )
+        {
+            try
+            {
+                record.m_item = parser.parseRecord( record, source );
+            }
+            catch( ... )
+            {
+                record.m_error = std::current_exception();
+            }
+        }
+
+        if( record.m_error )
+        {
+            std::exception_ptr error = record.m_error;
+
+            for( size_t jj = ii + 1; jj < count; ++jj )
+                delete aRecords[jj].m_item;
+
+            aRecords.clear();
+            updateParser();
+            std::rethrow_exception( error );
+        }
+
+        bool append = record.m_token == T_module || record.m_token == T_zone;
+
+        m_board->Add( record.m_item, append ? ADD_APPEND : ADD_INSERT );
+    }
+
+    aRecords.clear();
+    updateParser();
+}
+
+
 void PCB_PARSER::parseHeader()
 {
     wxCHECK_RET( CurTok() == T_kicad_pcb,
@@ -3318,6 +3605,9 @@ ZONE_CONTAINER* PCB_PARSER::parseZONE_CONTAINER()
                     if( token == T_segment )    // deprecated
                     {
                         // SEGMENT fill mode no longer supported.  Make sure user is OK with converting them.
+                        if( m_deferBoardChanges )
+                            throw DEFERRED_RECORD();
+
                         if( m_showLegacyZoneWarning )
                         {
                             KIDIALOG dlg( nullptr,
@@ -3508,6 +3798,12 @@ ZONE_CONTAINER* PCB_PARSER::parseZONE_CONTAINER()
             }
             break;
 
+        case T_fill_fingerprint:
+            NeedSYMBOLorNUMBER();
+            zone->SetFillFingerprint( CurText() );
+            NeedRIGHT();
+            break;
+
         case T_fill_segments:
             {
                 ZONE_SEGMENT_FILL segs;
@@ -3533,7 +3829,7 @@ ZONE_CONTAINER* PCB_PARSER::parseZONE_CONTAINER()
 
         default:
             Expecting( "net, layer/layers, tstamp, hatch, priority, connect_pads, min_thickness, "
-                       "fill, polygon, filled_polygon, or fill_segments" );
+                       "fill, fill_fingerprint, polygon, filled_polygon, or fill_segments" );
         }
     }
 
@@ -3572,6 +3868,9 @@ ZONE_CONTAINER* PCB_PARSER::parseZONE_CONTAINER()
             zone->SetNetCode( net->GetNet() );
         else    // Not existing net: add a new net to keep trace of the zone netname
         {
+            if( m_deferBoardChanges )
+                throw DEFERRED_RECORD();
+
             int newnetcode = m_board->GetNetCount();
             net = new NETINFO_ITEM( m_board, netnameFromfile, newnetcode );
             m_board->Add( net );
@@ -36,6 +36,7 @@
 #include <common.h>                             // KiROUND
 #include <convert_to_biu.h>                     // IU_PER_MM
 
+#include <exception>
 #include <unordered_map>
 
 
@@ -78,6 +79,26 @@ class PCB_PARSER : public PCB_LEXER
 
     bool                m_showLegacyZoneWarning;
 
+    ///> true in the parsers of the worker threads, which must not change the board
+    bool                m_deferBoardChanges;
+
+    /**
+     * A footprint, track, via or zone of a board, whose text is read by captureRecord()
+     * to be parsed later, possibly by another thread.
+     */
+    struct BOARD_RECORD
+    {
+        int                 m_token;        ///< T_module, T_segment, T_via or T_zone
+        int                 m_lineNumber;   ///< line number of the first line of m_text
+        std::string         m_text;         ///< the s-expression, at its column in the file
+        BOARD_ITEM*         m_item;         ///< the parsed item, or NULL
+        std::exception_ptr  m_error;        ///< the parse error of this record, if any
+        bool                m_deferred;     ///< true to parse it with the main parser
+    };
+
+    ///> Thrown by the parsers of the worker threads when an item needs to change the board
+    struct DEFERRED_RECORD {};
+
     ///> Converts net code using the mapping table if available,
     ///> otherwise returns unchanged net code if < 0 or if is is out of range
     inline int getNetCode( int aNetCode )
@@ -157,6 +178,39 @@ class PCB_PARSER : public PCB_LEXER
      */
     BOARD*          parseBOARD_unchecked();
 
+    /**
+     * Function captureRecord
+     * reads the text of the current top level s-expression, whose keyword is the current
+     * token, up to its closing parenthesis, without parsing it.
+     */
+    void            captureRecord( BOARD_RECORD& aRecord );
+
+    /**
+     * Function parseRecord
+     * parses the item of @a aRecord, read from @a aSource.
+     *
+     * @throw DEFERRED_RECORD if the item needs to change the board and m_deferBoardChanges
+     *  is set.
+     */
+    BOARD_ITEM*     parseRecord( const BOARD_RECORD& aRecord, const wxString& aSource );
+
+    /**
+     * Function parseRecords
+     * parses the captured records, on several threads when they are many, and adds their
+     * items to the board in the order of the file.
+     *
+     * @param aRecords are the records of the file, in its order.
+     * @throw the error of the first record which fails to parse.
+     */
+    void            parseRecords( std::vector<BOARD_RECORD>& aRecords );
+
+    /**
+     * Function initWorker
+     * copies the board, layer names, net codes and version of @a aParser to this parser,
+     * to parse records of the same board.
+     */
+    void            initWorker( const PCB_PARSER& aParser );
+
 
     /**
      * Function lookUpLayer
@@ -305,7 +359,8 @@ public:
 
     PCB_PARSER( LINE_READER* aReader = NULL ) :
         PCB_LEXER( aReader ),
-        m_board( 0 )
+        m_board( 0 ),
+        m_deferBoardChanges( false )
     {
         init();
     }
@@ -27,6 +27,8 @@
  * @file pcbnew/pcbplot.cpp
  */
 
+#include <algorithm>
+
 #include <fctsys.h>
 #include <plotter.h>
 #include <confirm.h>
@@ -490,6 +492,48 @@ bool PLOT_CONTROLLER::PlotLayer()
 }
 
 
+int PLOT_CONTROLLER::PlotLayers( const LSEQ& aLayers, PlotFormat aFormat )
+{
+    LOCALE_IO toggle;
+
+    GetPlotOptions().SetFormat( aFormat );
+
+    // Ensure that the previous plot is closed
+    ClosePlot();
+
+    wxString outputDirName = GetPlotOptions().GetOutputDirectory() ;
+    wxFileName outputDir = wxFileName::DirName( outputDirName );
+    wxString boardFilename = m_board->GetFileName();
+
+    if( !EnsureFileDirectoryExists( &outputDir, boardFilename ) )
+        return 0;
+
+    std::vector<PLOT_LAYER_JOB> jobs;
+
+    for( PCB_LAYER_ID layer : aLayers )
+    {
+        wxFileName fn( boardFilename );
+        wxString fileExt = GetDefaultPlotExtension( aFormat );
+
+        if( aFormat == PLOT_FORMAT_GERBER && GetPlotOptions().GetUseGerberProtelExtensions() )
+            fileExt = GetGerberProtelExtension( layer );
+
+        BuildPlotFileName( &fn, outputDir.GetPath(), m_board->GetLayerName( layer ), fileExt );
+
+        PLOT_LAYER_JOB job;
+        job.m_Layer = layer;
+        job.m_FileName = fn.GetFullPath();
+        job.m_Success = false;
+        jobs.push_back( job );
+    }
+
+    PlotBoardLayers( m_board, GetPlotOptions(), jobs );
+
+    return std::count_if( jobs.begin(), jobs.end(),
+                          []( const PLOT_LAYER_JOB& aJob ) { return aJob.m_Success; } );
+}
+
+
 void PLOT_CONTROLLER::SetColorMode( bool aColorMode )
 {
     if( !m_plotter )
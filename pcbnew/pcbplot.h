@@ -29,6 +29,7 @@
 #ifndef PCBPLOT_H_
 #define PCBPLOT_H_
 
+#include <vector>
 #include <wx/filename.h>
 #include <pad_shapes.h>
 #include <pcb_plot_params.h>
@@ -102,6 +103,14 @@ public:
 
     // Basic functions to plot a board item
     void SetLayerSet( LSET aLayerMask )     { m_layerMask = aLayerMask; }
+
+    /**
+     * Start and end the block of the graphics of a footprint.  The SVG plotter writes it
+     * as a symbol, shared by the identical footprints, when it uses symbols
+     */
+    void StartFootprintBlock( MODULE* aModule );
+    void EndFootprintBlock();
+
     void Plot_Edges_Modules();
     void Plot_1_EdgeModule( EDGE_MODULE* aEdge );
     void PlotTextModule( TEXTE_MODULE* aTextMod, COLOR4D aColor );
@@ -183,6 +192,29 @@ PLOTTER* StartPlotBoard( BOARD* aBoard,
 void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, PCB_LAYER_ID aLayer,
                         const PCB_PLOT_PARAMS& aPlotOpt );
 
+/**
+ * A layer to plot to its own file with PlotBoardLayers()
+ */
+struct PLOT_LAYER_JOB
+{
+    PCB_LAYER_ID m_Layer;
+    wxString     m_FileName;        ///< the full path of the plot file
+    wxString     m_SheetDesc;
+    bool         m_Success;         ///< set by PlotBoardLayers(), false if the file was not created
+};
+
+/**
+ * Function PlotBoardLayers
+ * plots several layers of a board, each one to its own file and with its own plotter, on the
+ * thread pool.  The board is only read by the plot functions, and must not be modified
+ * before the function returns.
+ * @param aBoard = the board to plot
+ * @param aPlotOpts = the plot options, for all the layers
+ * @param aJobs = the layers and their files; their m_Success flags are set on return
+ */
+void PlotBoardLayers( BOARD* aBoard, const PCB_PLOT_PARAMS& aPlotOpts,
+                      std::vector<PLOT_LAYER_JOB>& aJobs );
+
 /**
  * Function PlotStandardLayer
  * plot copper or technical layers.
@@ -35,6 +35,7 @@
 #include <base_struct.h>
 #include <gr_text.h>
 #include <geometry/geometry_utils.h>
+#include <convert_basic_shapes_to_polygon.h>
 #include <trigo.h>
 #include <pcb_base_frame.h>
 #include <macros.h>
@@ -52,6 +53,13 @@
 #include <pcbnew.h>
 #include <pcbplot.h>
 #include <gbr_metadata.h>
+#include <thread_pool.h>
+#include <profile_registry.h>
+#include <advanced_config.h>
+
+#include <memory>
+#include <mutex>
+#include <numeric>
 
 /*
  * Plot a solder mask layer.  Solder mask layers have a minimum thickness value and cannot be
@@ -88,7 +96,7 @@ void PlotSilkScreen( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
     {
         for( auto Module : aBoard->Modules() )
         {
-            aPlotter->StartBlock( NULL );
+            itemplotter.StartFootprintBlock( Module );
 
             for( auto pad : Module->Pads() )
             {
@@ -108,7 +116,7 @@ void PlotSilkScreen( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                 itemplotter.PlotPad( pad, color, SKETCH );
             }
 
-            aPlotter->EndBlock( NULL );
+            itemplotter.EndFootprintBlock();
         }
     }
 
@@ -149,6 +157,7 @@ void PlotSilkScreen( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
 void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, PCB_LAYER_ID aLayer,
                         const PCB_PLOT_PARAMS& aPlotOpt )
 {
+    PROF_SCOPE      profScope( "plot layer" );
     PCB_PLOT_PARAMS plotOpt = aPlotOpt;
     int soldermask_min_thickness = aBoard->GetDesignSettings().m_SolderMaskMinWidth;
 
@@ -313,19 +322,12 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
         }
     }
 
-    for( auto module : aBoard->Modules() )
-    {
-        for( auto item : module->GraphicalItems() )
-        {
-            if( item->Type() == PCB_MODULE_EDGE_T && aLayerMask[ item->GetLayer() ] )
-                itemplotter.Plot_1_EdgeModule( (EDGE_MODULE*) item );
-        }
-    }
+    itemplotter.Plot_Edges_Modules();
 
     // Plot footprint pads
     for( auto module : aBoard->Modules() )
     {
-        aPlotter->StartBlock( NULL );
+        itemplotter.StartFootprintBlock( module );
 
         for( auto pad : module->Pads() )
         {
@@ -358,6 +360,7 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             extraSize.x += width_adj;
             extraSize.y += width_adj;
             wxSize deltaSize = pad->GetDelta(); // has meaning only for trapezoidal pads
+            wxSize padPlotsDelta = deltaSize;
 
             if( pad->GetShape() == PAD_SHAPE_TRAPEZOID )
             {   // The easy way is to use BuildPadPolygon to calculate
@@ -390,7 +393,7 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
                 else
                     delta.y = coord[1].x - coord[0].x;
 
-                pad->SetDelta( delta );
+                padPlotsDelta = delta;
             }
             else
                 padPlotsSize = pad->GetSize() + extraSize;
@@ -407,30 +410,38 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             if( pad->GetLayerSet()[F_Cu] )
                 color = color.LegacyMix( aBoard->Colors().GetItemColor( LAYER_PAD_FR ) );
 
-            // Temporary set the pad size to the required plot size:
-            wxSize tmppadsize = pad->GetSize();
+            // The pad is plotted at the required plot size from a copy, so that the board is
+            // only read and several layers can be plotted at once
+            std::unique_ptr<D_PAD> resizedPad;
+            D_PAD* plotPad = pad;
+
+            if( pad->GetShape() != PAD_SHAPE_CUSTOM
+                    && ( padPlotsSize != pad->GetSize() || padPlotsDelta != deltaSize ) )
+            {
+                resizedPad.reset( new D_PAD( *pad ) );
+                resizedPad->SetSize( padPlotsSize );
+                resizedPad->SetDelta( padPlotsDelta );
+                plotPad = resizedPad.get();
+            }
 
             switch( pad->GetShape() )
             {
             case PAD_SHAPE_CIRCLE:
             case PAD_SHAPE_OVAL:
-                pad->SetSize( padPlotsSize );
-
                 if( aPlotOpt.GetSkipPlotNPTH_Pads() &&
                     ( aPlotOpt.GetDrillMarksType() == PCB_PLOT_PARAMS::NO_DRILL_SHAPE ) &&
-                    ( pad->GetSize() == pad->GetDrillSize() ) &&
-                    ( pad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED ) )
+                    ( plotPad->GetSize() == plotPad->GetDrillSize() ) &&
+                    ( plotPad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED ) )
                     break;
 
-                itemplotter.PlotPad( pad, color, plotMode );
+                itemplotter.PlotPad( plotPad, color, plotMode );
                 break;
 
             case PAD_SHAPE_TRAPEZOID:
             case PAD_SHAPE_RECT:
             case PAD_SHAPE_ROUNDRECT:
             case PAD_SHAPE_CHAMFERED_RECT:
-                pad->SetSize( padPlotsSize );
-                itemplotter.PlotPad( pad, color, plotMode );
+                itemplotter.PlotPad( plotPad, color, plotMode );
                 break;
 
             case PAD_SHAPE_CUSTOM:
@@ -439,7 +450,7 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
                 // so build a similar pad shape, and inflate/deflate the polygonal shape
                 D_PAD dummy( *pad );
                 SHAPE_POLY_SET shape;
-                pad->MergePrimitivesAsPolygon( &shape );
+                dummy.MergePrimitivesAsPolygon( &shape );
                 // Shape polygon can have holes so use InflateWithLinkedHoles(), not Inflate()
                 // which can create bad shapes if margin.x is < 0
                 int maxError = aBoard->GetDesignSettings().m_MaxError;
@@ -459,12 +470,9 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             }
                 break;
             }
-
-            pad->SetSize( tmppadsize );     // Restore the pad size
-            pad->SetDelta( deltaSize );
         }
 
-        aPlotter->EndBlock( NULL );
+        itemplotter.EndFootprintBlock();
     }
 
     // Plot vias on copper layers, and if aPlotOpt.GetPlotViaOnMaskLayer() is true,
@@ -748,6 +756,238 @@ void PlotLayerOutlines( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
 }
 
 
+/*
+ * The fast path of PlotSolderMaskLayer.  The pads, vias and zones of the layer are grouped
+ * in clusters of items which can be closer than the min width of the solder mask, found
+ * from their bounding boxes.  Each cluster is merged on its own, on the worker threads, and
+ * the pads and vias isolated from any other item are flashed without polygon operations.
+ */
+static void plotSolderMaskClusters( BOARD* aBoard, PLOTTER* aPlotter,
+        BRDITEMS_PLOTTER& aItemPlotter, PCB_LAYER_ID aLayer,
+        const std::vector<std::pair<const BOARD_ITEM*, int>>& aPadsAndVias, int aZoneMargin,
+        int aInflate )
+{
+    int maxError = aBoard->GetDesignSettings().m_MaxError;
+    int numSegs = std::max( GetArcToSegmentCount( aInflate, maxError, 360.0 ), 6 );
+
+    std::vector<ZONE_CONTAINER*> zones;
+
+    for( ZONE_CONTAINER* zone : aBoard->Zones() )
+    {
+        if( zone->GetLayer() == aLayer )
+            zones.push_back( zone );
+    }
+
+    // The items are the pads and vias, then the zones
+    size_t padCount = aPadsAndVias.size();
+    size_t count = padCount + zones.size();
+
+    // The area each item can cover once inflated, with some room for the arc approximation
+    std::vector<EDA_RECT> reach( count );
+
+    for( size_t ii = 0; ii < count; ++ii )
+    {
+        int margin;
+
+        if( ii < padCount )
+        {
+            reach[ii] = aPadsAndVias[ii].first->GetBoundingBox();
+            margin = aPadsAndVias[ii].second;
+        }
+        else
+        {
+            reach[ii] = zones[ii - padCount]->GetBoundingBox();
+            margin = aZoneMargin;
+        }
+
+        reach[ii].Normalize();
+        reach[ii].Inflate( std::max( margin, 0 ) + aInflate + maxError );
+    }
+
+    // Join the items whose areas overlap.  The items are swept from left to right: only the
+    // items starting before the right side of an item can overlap it.
+    std::vector<size_t> parent( count );
+    std::iota( parent.begin(), parent.end(), 0 );
+
+    auto findRoot = [&]( size_t aItem )
+    {
+        while( parent[aItem] != aItem )
+        {
+            parent[aItem] = parent[parent[aItem]];
+            aItem = parent[aItem];
+        }
+
+        return aItem;
+    };
+
+    std::vector<size_t> order( count );
+    std::iota( order.begin(), order.end(), 0 );
+    std::sort( order.begin(), order.end(),
+               [&]( size_t a, size_t b )
+               {
+                   return reach[a].GetX() < reach[b].GetX();
+               } );
+
+    for( size_t ii = 0; ii < count; ++ii )
+    {
+        const EDA_RECT& a = reach[order[ii]];
+
+        for( size_t jj = ii + 1; jj < count && reach[order[jj]].GetX() <= a.GetRight(); ++jj )
+        {
+            const EDA_RECT& b = reach[order[jj]];
+
+            if( b.GetY() <= a.GetBottom() && a.GetY() <= b.GetBottom() )
+                parent[findRoot( order[jj] )] = findRoot( order[ii] );
+        }
+    }
+
+    std::vector<std::vector<size_t>> clusters;
+    std::vector<size_t>              clusterOfRoot( count, SIZE_MAX );
+
+    for( size_t ii = 0; ii < count; ++ii )
+    {
+        size_t& cluster = clusterOfRoot[findRoot( ii )];
+
+        if( cluster == SIZE_MAX )
+        {
+            cluster = clusters.size();
+            clusters.emplace_back();
+        }
+
+        clusters[cluster].push_back( ii );
+    }
+
+    // The isolated vias, and the pads whose shape is an aperture, are flashed
+    EDA_DRAW_MODE_T plotMode = aItemPlotter.GetPlotMode();
+    std::vector<std::vector<size_t>> mergedClusters;
+
+    for( std::vector<size_t>& cluster : clusters )
+    {
+        size_t item = cluster[0];
+
+        if( cluster.size() > 1 || item >= padCount )
+        {
+            mergedClusters.push_back( std::move( cluster ) );
+            continue;
+        }
+
+        int margin = aPadsAndVias[item].second;
+
+        if( const VIA* via = dyn_cast<const VIA*>( aPadsAndVias[item].first ) )
+        {
+            int diameter = via->GetWidth() + 2 * margin;
+
+            if( diameter <= 0 )
+                continue;
+
+            GBR_METADATA gbr_metadata;
+            gbr_metadata.m_NetlistMetadata.m_NotInNet = via->GetNetname().IsEmpty();
+            gbr_metadata.SetNetName( via->GetNetname() );
+
+            COLOR4D color = aBoard->Colors().GetItemColor( LAYER_VIAS + via->GetViaType() );
+            aPlotter->SetColor( color != WHITE ? color : LIGHTGRAY );
+            aPlotter->FlashPadCircle( via->GetStart(), diameter, plotMode, &gbr_metadata );
+            continue;
+        }
+
+        const D_PAD* pad = static_cast<const D_PAD*>( aPadsAndVias[item].first );
+
+        switch( pad->GetShape() )
+        {
+        case PAD_SHAPE_CIRCLE:
+        case PAD_SHAPE_OVAL:
+        case PAD_SHAPE_RECT:
+        case PAD_SHAPE_ROUNDRECT:
+        {
+            D_PAD plotPad( *pad );
+            plotPad.SetSize( pad->GetSize() + wxSize( 2 * margin, 2 * margin ) );
+
+            if( plotPad.GetSize().x <= 0 || plotPad.GetSize().y <= 0 )
+                break;
+
+            COLOR4D color = COLOR4D::BLACK;
+
+            if( pad->GetLayerSet()[B_Cu] )
+               color = aBoard->Colors().GetItemColor( LAYER_PAD_BK );
+
+            if( pad->GetLayerSet()[F_Cu] )
+                color = color.LegacyMix( aBoard->Colors().GetItemColor( LAYER_PAD_FR ) );
+
+            aItemPlotter.PlotPad( &plotPad, color, plotMode );
+        }
+            break;
+
+        default:
+            // Other shapes are plotted as polygons
+            mergedClusters.push_back( std::move( cluster ) );
+            break;
+        }
+    }
+
+    // The zone outlines are built here, GetColinearCorners() is not thread safe
+    std::vector<SHAPE_POLY_SET> zoneAreas( zones.size() );
+    std::vector<SHAPE_POLY_SET> zoneInitialPolys( zones.size() );
+
+    for( size_t ii = 0; ii < zones.size(); ++ii )
+    {
+        std::set<VECTOR2I> colinearCorners;
+        zones[ii]->GetColinearCorners( aBoard, colinearCorners );
+
+        zones[ii]->TransformOutlinesShapeWithClearanceToPolygon( zoneAreas[ii],
+                aInflate + aZoneMargin, false, &colinearCorners );
+        zones[ii]->TransformOutlinesShapeWithClearanceToPolygon( zoneInitialPolys[ii],
+                aZoneMargin, false, &colinearCorners );
+    }
+
+    // Merge each cluster like PlotSolderMaskLayer() merges the whole layer.  The clusters
+    // do not overlap, so their results are only appended.
+    std::vector<SHAPE_POLY_SET> clusterAreas( mergedClusters.size() );
+
+    THREAD_POOL::GetPool().ParallelFor( mergedClusters.size(),
+            [&]( size_t aCluster )
+            {
+                SHAPE_POLY_SET& areas = clusterAreas[aCluster];
+                SHAPE_POLY_SET  initialPolys;
+
+                for( size_t item : mergedClusters[aCluster] )
+                {
+                    if( item < padCount )
+                    {
+                        const BOARD_ITEM* padOrVia = aPadsAndVias[item].first;
+                        int               margin = aPadsAndVias[item].second;
+
+                        padOrVia->TransformShapeWithClearanceToPolygon( initialPolys, margin,
+                                                                        ARC_HIGH_DEF );
+                        padOrVia->TransformShapeWithClearanceToPolygon( areas, margin + aInflate,
+                                                                        ARC_HIGH_DEF );
+                    }
+                    else
+                    {
+                        initialPolys.Append( zoneInitialPolys[item - padCount] );
+                        areas.Append( zoneAreas[item - padCount] );
+                    }
+                }
+
+                areas.BooleanAdd( initialPolys, SHAPE_POLY_SET::PM_FAST );
+                areas.Deflate( aInflate, numSegs );
+                areas.BooleanAdd( initialPolys, SHAPE_POLY_SET::PM_FAST );
+                areas.Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+            },
+            1 );
+
+    SHAPE_POLY_SET areas;
+
+    for( const SHAPE_POLY_SET& clusterArea : clusterAreas )
+        areas.Append( clusterArea );
+
+    ZONE_CONTAINER zone( aBoard );
+    zone.SetMinThickness( 0 );      // trace polygons only
+    zone.SetLayer( aLayer );
+
+    aItemPlotter.PlotFilledAreas( &zone, areas );
+}
+
+
 /* Plot a solder mask layer.
  * Solder mask layers have a minimum thickness value and cannot be drawn like standard layers,
  * unless the minimum thickness is 0.
@@ -760,11 +1000,9 @@ void PlotLayerOutlines( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
  *      mask clearance only (because deflate sometimes creates shape artifacts)
  * 5 - draw result as polygons
  *
- * TODO:
- * make this calculation only for shapes with clearance near than (min width solder mask)
- * (using DRC algo)
- * plot all other shapes by flashing the basing shape
- * (shapes will be better, and calculations faster)
+ * When the FastSolderMaskPlot advanced setting is set, this calculation is made only for the
+ * clusters of shapes closer than the min width solder mask, and the other pads and vias
+ * are flashed (see plotSolderMaskClusters()).
  */
 void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                           const PCB_PLOT_PARAMS& aPlotOpt, int aMinThickness )
@@ -799,13 +1037,17 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
     SHAPE_POLY_SET areas;           // Contains shapes to plot
     SHAPE_POLY_SET initialPolys;    // Contains exact shapes to plot
 
+    // Pads and vias with their clearance, converted in one pass
+    std::vector<std::pair<const BOARD_ITEM*, int>> padsAndVias;
+
     // Plot pads
     for( auto module : aBoard->Modules() )
     {
-        // add shapes with exact size
-        module->TransformPadsShapesWithClearanceToPolygon( layer, initialPolys, 0 );
-        // add shapes inflated by aMinThickness/2
-        module->TransformPadsShapesWithClearanceToPolygon( layer, areas, inflate );
+        for( auto pad : module->Pads() )
+        {
+            if( pad->IsOnLayer( layer ) )
+                padsAndVias.emplace_back( pad, pad->GetSolderMaskMargin() );
+        }
     }
 
     // Plot vias on solder masks, if aPlotOpt.GetPlotViaOnMaskLayer() is true,
@@ -813,7 +1055,6 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
     {
         // The current layer is a solder mask, use the global mask clearance for vias
         int via_clearance = aBoard->GetDesignSettings().m_SolderMaskMargin;
-        int via_margin = via_clearance + inflate;
 
         for( auto track : aBoard->Tracks() )
         {
@@ -834,18 +1075,40 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
             if( !( via_set & aLayerMask ).any() )
                 continue;
 
-            via->TransformShapeWithClearanceToPolygon( areas, via_margin );
-            via->TransformShapeWithClearanceToPolygon( initialPolys, via_clearance );
+            padsAndVias.emplace_back( via, via_clearance );
         }
     }
 
-    // Add filled zone areas.
 #if 0   // Set to 1 if a solder mask margin must be applied to zones on solder mask
     int zone_margin = aBoard->GetDesignSettings().m_SolderMaskMargin;
 #else
     int zone_margin = 0;
 #endif
 
+    if( ADVANCED_CFG::GetCfg().m_fastSolderMaskPlot )
+    {
+        plotSolderMaskClusters( aBoard, aPlotter, itemplotter, layer, padsAndVias, zone_margin,
+                                inflate );
+        return;
+    }
+
+    // add shapes with exact size
+    TransformShapesToPolygon( initialPolys, padsAndVias.size(),
+            [&]( size_t aIndex, SHAPE_POLY_SET& aBuffer )
+            {
+                padsAndVias[aIndex].first->TransformShapeWithClearanceToPolygon( aBuffer,
+                        padsAndVias[aIndex].second, ARC_HIGH_DEF );
+            } );
+
+    // add shapes inflated by aMinThickness/2
+    TransformShapesToPolygon( areas, padsAndVias.size(),
+            [&]( size_t aIndex, SHAPE_POLY_SET& aBuffer )
+            {
+                padsAndVias[aIndex].first->TransformShapeWithClearanceToPolygon( aBuffer,
+                        padsAndVias[aIndex].second + inflate, ARC_HIGH_DEF );
+            } );
+
+    // Add filled zone areas.
     for( ZONE_CONTAINER* zone : aBoard->Zones() )
     {
         if( zone->GetLayer() != layer )
@@ -1051,7 +1314,10 @@ PLOTTER* StartPlotBoard( BOARD *aBoard, PCB_PLOT_PARAMS *aPlotOpts, int aLayer,
         break;
 
     case PLOT_FORMAT_SVG:
-        plotter = new SVG_PLOTTER();
+        SVG_PLOTTER* SVG_plotter;
+        SVG_plotter = new SVG_PLOTTER();
+        SVG_plotter->UseSymbols( ADVANCED_CFG::GetCfg().m_svgPlotSymbols );
+        plotter = SVG_plotter;
         break;
 
     default:
@@ -1081,6 +1347,7 @@ PLOTTER* StartPlotBoard( BOARD *aBoard, PCB_PLOT_PARAMS *aPlotOpts, int aLayer,
             GERBER_PLOTTER* gbrplotter = static_cast <GERBER_PLOTTER*> ( plotter );
             gbrplotter->UseX2format( useX2mode );
             gbrplotter->UseX2NetAttributes( plotOpts.GetIncludeGerberNetlistInfo() );
+            gbrplotter->UseOptimizedOutput( ADVANCED_CFG::GetCfg().m_optimizedGerberOutput );
 
             // Attributes can be added using X2 format or as comment (X1 format)
             AddGerberX2Attribute( plotter, aBoard, aLayer, not useX2mode );
@@ -1113,3 +1380,45 @@ PLOTTER* StartPlotBoard( BOARD *aBoard, PCB_PLOT_PARAMS *aPlotOpts, int aLayer,
     delete plotter;
     return NULL;
 }
+
+
+void PlotBoardLayers( BOARD* aBoard, const PCB_PLOT_PARAMS& aPlotOpts,
+                      std::vector<PLOT_LAYER_JOB>& aJobs )
+{
+    // The locale is switched once for all the threads
+    LOCALE_IO toggle;
+
+    // The bounding radius of the pads is computed the first time it is used
+    for( auto module : aBoard->Modules() )
+    {
+        for( auto pad : module->Pads() )
+            pad->GetBoundingRadius();
+    }
+
+    // The file headers and the page layout use shared data, so the plots are started one at
+    // a time; the layers are then plotted at once
+    std::mutex startLock;
+
+    THREAD_POOL::GetPool().ParallelFor( aJobs.size(),
+            [&]( size_t aIndex )
+            {
+                PLOT_LAYER_JOB& job = aJobs[aIndex];
+                PCB_PLOT_PARAMS plotOpts = aPlotOpts;
+                PLOTTER*        plotter;
+
+                {
+                    std::lock_guard<std::mutex> lock( startLock );
+                    plotter = StartPlotBoard( aBoard, &plotOpts, job.m_Layer, job.m_FileName,
+                                              job.m_SheetDesc );
+                }
+
+                job.m_Success = ( plotter != NULL );
+
+                if( !plotter )
+                    return;
+
+                PlotOneBoardLayer( aBoard, plotter, job.m_Layer, plotOpts );
+                plotter->EndPlot();
+                delete plotter;
+            }, 1 );
+}
@@ -427,17 +427,48 @@ void BRDITEMS_PLOTTER::PlotPcbTarget( PCB_TARGET* aMire )
 
 
 // Plot footprints graphic items (outlines)
+void BRDITEMS_PLOTTER::StartFootprintBlock( MODULE* aModule )
+{
+    if( m_plotter->GetPlotterType() == PLOT_FORMAT_SVG )
+        static_cast<SVG_PLOTTER*>( m_plotter )->StartSymbol( aModule->GetPosition() );
+    else
+        m_plotter->StartBlock( NULL );
+}
+
+
+void BRDITEMS_PLOTTER::EndFootprintBlock()
+{
+    if( m_plotter->GetPlotterType() == PLOT_FORMAT_SVG )
+        static_cast<SVG_PLOTTER*>( m_plotter )->EndSymbol();
+    else
+        m_plotter->EndBlock( NULL );
+}
+
+
 void BRDITEMS_PLOTTER::Plot_Edges_Modules()
 {
     for( auto module : m_board->Modules() )
     {
+        bool blockStarted = false;
+
         for( auto item : module->GraphicalItems() )
         {
             EDGE_MODULE* edge = dyn_cast<EDGE_MODULE*>( item );
 
-            if( edge && m_layerMask[edge->GetLayer()] )
-                Plot_1_EdgeModule( edge );
+            if( !edge || !m_layerMask[edge->GetLayer()] )
+                continue;
+
+            if( !blockStarted )
+            {
+                StartFootprintBlock( module );
+                blockStarted = true;
+            }
+
+            Plot_1_EdgeModule( edge );
         }
+
+        if( blockStarted )
+            EndFootprintBlock();
     }
 }
 
@@ -638,7 +669,7 @@ void BRDITEMS_PLOTTER::PlotFilledAreas( ZONE_CONTAINER* aZone, SHAPE_POLY_SET& p
     }
 
     // We need a buffer to store corners coordinates:
-    static std::vector< wxPoint > cornerList;
+    std::vector< wxPoint > cornerList;
     cornerList.clear();
 
     m_plotter->SetColor( getColor( aZone->GetLayer() ) );
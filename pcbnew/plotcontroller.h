@@ -84,6 +84,15 @@ public:
      */
     bool PlotLayer();
 
+    /** Plot several layers at once, each one on its own plotfile named as by the plot
+     * dialog, from the board filename and the layer name.  The current plot is closed first.
+     * The board must not be modified while the layers are plotted.
+     * @param aLayers are the layers to plot
+     * @param aFormat is the plot file format identifier
+     * @return the number of plotfiles created
+     */
+    int PlotLayers( const LSEQ& aLayers, PlotFormat aFormat );
+
     /**
      * @return the current plot full filename, set by OpenPlotfile
      */
@@ -56,7 +56,7 @@ static bool sortWeight( const CN_EDGE& aEdge1, const CN_EDGE& aEdge2 )
 
 
 static const std::vector<CN_EDGE> kruskalMST( std::list<CN_EDGE>& aEdges,
-        std::vector<CN_ANCHOR_PTR>& aNodes )
+        const std::vector<CN_ANCHOR_PTR>& aNodes )
 {
     unsigned int    nodeNumber = aNodes.size();
     unsigned int    mstExpectedSize = nodeNumber - 1;
@@ -66,14 +66,17 @@ static const std::vector<CN_EDGE> kruskalMST( std::list<CN_EDGE>& aEdges,
     // The output
     std::vector<CN_EDGE> mst;
 
-    // Set tags for marking cycles
-    std::unordered_map<CN_ANCHOR_PTR, int> tags;
+    // Set tags for marking cycles.  The anchors are not shared pointer keys, whose copies
+    // would update the reference counts
+    std::unordered_map<const CN_ANCHOR*, int> tags;
     unsigned int tag = 0;
 
-    for( auto& node : aNodes )
+    tags.reserve( nodeNumber );
+
+    for( const auto& node : aNodes )
     {
         node->SetTag( tag );
-        tags[node] = tag++;
+        tags[node.get()] = tag++;
     }
 
     // Lists of nodes connected together (subtrees) to detect cycles in the graph
@@ -90,8 +93,8 @@ static const std::vector<CN_EDGE> kruskalMST( std::list<CN_EDGE>& aEdges,
         //printf("mstSize %d %d\n", mstSize, mstExpectedSize);
         auto& dt = aEdges.front();
 
-        int srcTag  = tags[dt.GetSourceNode()];
-        int trgTag  = tags[dt.GetTargetNode()];
+        int srcTag  = tags[dt.GetSourceNode().get()];
+        int trgTag  = tags[dt.GetTargetNode().get()];
 
         // Check if by adding this edge we are going to join two different forests
         if( srcTag != trgTag )
@@ -107,7 +110,7 @@ static const std::vector<CN_EDGE> kruskalMST( std::list<CN_EDGE>& aEdges,
             {
                 for( auto it = cycles[trgTag].begin(); it != cycles[trgTag].end(); ++it )
                 {
-                    tags[aNodes[*it]] = srcTag;
+                    tags[aNodes[*it].get()] = srcTag;
                 }
 
                 // Do a copy of edge, but make it RN_EDGE_MST. In contrary to RN_EDGE,
@@ -127,7 +130,7 @@ static const std::vector<CN_EDGE> kruskalMST( std::list<CN_EDGE>& aEdges,
                 // for( auto it : cycles[trgTag] )
                 for( auto it = cycles[trgTag].begin(); it != cycles[trgTag].end(); ++it )
                 {
-                    tags[aNodes[*it]] = srcTag;
+                    tags[aNodes[*it].get()] = srcTag;
                     aNodes[*it]->SetTag( srcTag );
                 }
 
@@ -196,7 +199,7 @@ public:
         m_allNodes.clear();
     }
 
-    void AddNode( CN_ANCHOR_PTR aNode )
+    void AddNode( const CN_ANCHOR_PTR& aNode )
     {
         m_allNodes.push_back( aNode );
     }
@@ -227,15 +230,12 @@ public:
         }
                 );
 
-        CN_ANCHOR_PTR prev, last;
+        const CN_ANCHOR* prev = nullptr;
         int id = 0;
 
-        for( auto n : m_allNodes )
-        {
-            anchorChains.push_back( ANCHOR_LIST() );
-        }
+        anchorChains.resize( m_allNodes.size() );
 
-        for( auto n : m_allNodes )
+        for( const auto& n : m_allNodes )
         {
             if( !prev || prev->Pos() != n->Pos() )
             {
@@ -246,12 +246,12 @@ public:
             }
 
             id++;
-            prev = n;
+            prev = n.get();
         }
 
         int prevId = 0;
 
-        for( auto n : triNodes )
+        for( const auto& n : triNodes )
         {
             for( int i = prevId; i < n->Id(); i++ )
                 anchorChains[prevId].push_back( m_allNodes[ i ] );
@@ -273,8 +273,8 @@ public:
             // and chain the nodes together.
             for(int i = 0; i < (int)triNodes.size() - 1; i++ )
             {
-                auto src = m_allNodes[ triNodes[i]->Id() ];
-                auto dst = m_allNodes[ triNodes[i + 1]->Id() ];
+                const auto& src = m_allNodes[ triNodes[i]->Id() ];
+                const auto& dst = m_allNodes[ triNodes[i + 1]->Id() ];
                 mstEdges.emplace_back( src, dst, getDistance( src, dst ) );
             }
         }
@@ -284,10 +284,10 @@ public:
             triangulator.CreateDelaunay( triNodes.begin(), triNodes.end() );
             triangulator.GetEdges( triangEdges );
 
-            for( auto e : triangEdges )
+            for( const auto& e : triangEdges )
             {
-                auto    src = m_allNodes[ e->GetSourceNode()->Id() ];
-                auto    dst = m_allNodes[ e->GetTargetNode()->Id() ];
+                const auto& src = m_allNodes[ e->GetSourceNode()->Id() ];
+                const auto& dst = m_allNodes[ e->GetTargetNode()->Id() ];
 
                 mstEdges.emplace_back( src, dst, getDistance( src, dst ) );
             }
@@ -325,7 +325,7 @@ RN_NET::RN_NET() : m_dirty( true )
 }
 
 
-void RN_NET::compute()
+void RN_NET::compute() const
 {
     // Special cases do not need complicated algorithms (actually, it does not work well with
     // the Delaunay triangulator)
@@ -358,7 +358,7 @@ void RN_NET::compute()
 
     m_triangulator->Clear();
 
-    for( auto n : m_nodes )
+    for( const auto& n : m_nodes )
     {
         m_triangulator->AddNode( n );
     }
@@ -386,7 +386,7 @@ void RN_NET::compute()
 
 
 
-void RN_NET::Update()
+void RN_NET::Update() const
 {
     compute();
 
@@ -445,9 +445,9 @@ bool RN_NET::NearestBicoloredPair( const RN_NET& aOtherNet, CN_ANCHOR_PTR& aNode
 
     VECTOR2I::extended_type distMax = VECTOR2I::ECOORD_MAX;
 
-    for( auto nodeA : m_nodes )
+    for( const auto& nodeA : m_nodes )
     {
-        for( auto nodeB : aOtherNet.m_nodes )
+        for( const auto& nodeB : aOtherNet.m_nodes )
         {
             if( !nodeA->GetNoLine() )
             {
@@ -92,19 +92,20 @@ public:
 
     /**
      * Function GetUnconnected()
-     * Returns pointer to a vector of edges that makes ratsnest for a given net.
+     * Returns pointer to a vector of edges that makes ratsnest for a given net.  A dirty
+     * ratsnest is recomputed first.
      * @return Pointer to a vector of edges that makes ratsnest for a given net.
      */
     const std::vector<CN_EDGE> GetUnconnected() const
     {
-        return m_rnEdges;
+        return GetEdges();
     }
 
     /**
      * Function Update()
      * Recomputes ratsnest for a net.
      */
-    void Update();
+    void Update() const;
     void Clear();
 
     void AddCluster( std::shared_ptr<CN_CLUSTER> aCluster );
@@ -124,9 +125,19 @@ public:
 
     const std::vector<CN_EDGE>& GetEdges() const
     {
+        // The ratsnest of a net can be left dirty until it is needed (lazy ratsnest)
+        if( m_dirty )
+            Update();
+
         return m_rnEdges;
     }
 
+    ///> Returns the nodes of the net, which are valid even if the ratsnest is dirty.
+    const std::vector<CN_ANCHOR_PTR>& GetAllNodes() const
+    {
+        return m_nodes;
+    }
+
     /**
      * Function GetAllItems()
      * Adds all stored items to a list.
@@ -146,7 +157,7 @@ public:
 
 protected:
     ///> Recomputes ratsnest from scratch.
-    void compute();
+    void compute() const;
 
     ///> Vector of nodes
     std::vector<CN_ANCHOR_PTR> m_nodes;
@@ -155,10 +166,10 @@ protected:
     std::vector<CN_EDGE> m_boardEdges;
 
     ///> Vector of edges that makes ratsnest for a given net.
-    std::vector<CN_EDGE> m_rnEdges;
+    mutable std::vector<CN_EDGE> m_rnEdges;
 
     ///> Flag indicating necessity of recalculation of ratsnest for a net.
-    bool m_dirty;
+    mutable bool m_dirty;
 
     class TRIANGULATOR_STATE;
 
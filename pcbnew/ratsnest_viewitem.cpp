@@ -36,6 +36,7 @@
 #include <layers_id_colors_and_visibility.h>
 #include <pcb_base_frame.h>
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -43,6 +44,45 @@
 
 namespace KIGFX {
 
+constexpr int CROSS_SIZE = 200000;
+
+
+/**
+ * Tells if some ratsnest of a net can be visible in aViewport.  The lines join the nodes
+ * of the net, so they stay in the bounding box of the nodes (however curved), and a line is
+ * not drawn if none of its nodes has a visible local ratsnest.
+ */
+static bool isNetVisible( const RN_NET& aNet, const BOX2I& aViewport )
+{
+    BOX2I bbox;
+    bool  first = true;
+    bool  visible = false;
+
+    for( const CN_ANCHOR_PTR& node : aNet.GetAllNodes() )
+    {
+        if( !node->Valid() )
+            continue;
+
+        if( node->Parent()->GetLocalRatsnestVisible() )
+            visible = true;
+
+        if( first )
+            bbox = BOX2I( node->Pos(), VECTOR2I( 0, 0 ) );
+        else
+            bbox.Merge( node->Pos() );
+
+        first = false;
+    }
+
+    if( !visible )
+        return false;
+
+    bbox.Inflate( std::max( bbox.GetWidth(), bbox.GetHeight() ) / 10 + CROSS_SIZE );
+
+    return bbox.Intersects( aViewport );
+}
+
+
 RATSNEST_VIEWITEM::RATSNEST_VIEWITEM(  std::shared_ptr<CONNECTIVITY_DATA> aData ) :
         EDA_ITEM( NOT_USED ), m_data( std::move(aData) )
 {
@@ -66,8 +106,6 @@ void RATSNEST_VIEWITEM::ViewDraw( int aLayer, KIGFX::VIEW* aView ) const
     if( !lock )
         return;
 
-    constexpr int CROSS_SIZE = 200000;
-
     auto gal = aView->GetGAL();
 	gal->SetIsStroke( true );
     gal->SetIsFill( false );
@@ -108,11 +146,30 @@ void RATSNEST_VIEWITEM::ViewDraw( int aLayer, KIGFX::VIEW* aView ) const
         }
     }
 
+    // With the lazy ratsnest, the dirty nets are only computed if they can be seen
+    BOX2D            viewportD = aView->GetViewport();
+    BOX2I            viewport( VECTOR2I( viewportD.GetPosition() ),
+                               VECTOR2I( viewportD.GetSize() ) );
+    std::vector<int> visibleDirtyNets;
+
+    viewport.Normalize();
+
+    for( int i = 1 /* skip "No Net" at [0] */; i < m_data->GetNetCount(); ++i )
+    {
+        RN_NET* net = m_data->GetRatsnestForNet( i );
+
+        if( net && net->IsDirty() && isNetVisible( *net, viewport ) )
+            visibleDirtyNets.push_back( i );
+    }
+
+    m_data->UpdateRatsnest( visibleDirtyNets );
+
     for( int i = 1 /* skip "No Net" at [0] */; i < m_data->GetNetCount(); ++i )
     {
         RN_NET* net = m_data->GetRatsnestForNet( i );
 
-        if( !net )
+        // The dirty nets left are not visible
+        if( !net || net->IsDirty() )
             continue;
 
         // Draw the "static" ratsnest
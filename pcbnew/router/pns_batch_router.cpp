@@ -0,0 +1,475 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <mutex>
+
+#include <class_board.h>
+#include <class_track.h>
+#include <connectivity/connectivity_data.h>
+#include <connectivity/connectivity_algo.h>
+#include <thread_pool.h>
+
+#include "pns_batch_router.h"
+#include "pns_debug_decorator.h"
+#include "pns_kicad_iface.h"
+#include "pns_line.h"
+#include "pns_node.h"
+#include "pns_placement_algo.h"
+#include "pns_router.h"
+#include "pns_sizes_settings.h"
+
+
+/**
+ * A router interface without a view.  The routed items are added to the board right away,
+ * or only kept in the router world when aCommitToBoard is not set.
+ */
+class BATCH_IFACE : public PNS_KICAD_IFACE
+{
+public:
+    BATCH_IFACE( BOARD* aBoard, bool aCommitToBoard ) :
+        m_board( aBoard ),
+        m_commitToBoard( aCommitToBoard )
+    {
+        SetBoard( aBoard );
+    }
+
+    ~BATCH_IFACE()
+    {
+        for( BOARD_ITEM* item : m_removedItems )
+            delete item;
+    }
+
+    void EraseView() override {}
+    void HideItem( PNS::ITEM* aItem ) override {}
+
+    void DisplayItem( const PNS::ITEM* aItem, int aColor, int aClearance, bool aEdit ) override
+    {
+    }
+
+    void AddItem( PNS::ITEM* aItem ) override
+    {
+        if( !m_commitToBoard )
+            return;
+
+        BOARD_CONNECTED_ITEM* newBI = createBoardItem( aItem );
+
+        if( newBI )
+            m_board->Add( newBI );
+    }
+
+    void RemoveItem( PNS::ITEM* aItem ) override
+    {
+        BOARD_CONNECTED_ITEM* parent = aItem->Parent();
+
+        if( !m_commitToBoard || !parent )
+            return;
+
+        // The items of the router world refer to it until the end of the commit
+        m_board->Remove( parent );
+        m_removedItems.push_back( parent );
+    }
+
+    void Commit() override {}
+    void UpdateNet( int aNetCode ) override {}
+
+    PNS::DEBUG_DECORATOR* GetDebugDecorator() override { return &m_decorator; }
+
+private:
+    BOARD*                   m_board;
+    bool                     m_commitToBoard;
+    std::vector<BOARD_ITEM*> m_removedItems;
+    PNS::DEBUG_DECORATOR     m_decorator;
+};
+
+
+/**
+ * A router with its own world, synchronized with the board when it is created
+ */
+struct PNS_BATCH_ROUTER::WORKER
+{
+    WORKER( BOARD* aBoard, bool aCommitToBoard ) :
+        m_iface( aBoard, aCommitToBoard )
+    {
+    }
+
+    BATCH_IFACE m_iface;
+    PNS::ROUTER m_router;
+};
+
+
+/**
+ * A connection to route, with the items found at its ends
+ */
+struct PNS_BATCH_ROUTER::JOB
+{
+    size_t                     m_connection;
+    VECTOR2I                   m_start;
+    VECTOR2I                   m_end;
+    int                        m_net;
+    int                        m_layer;
+    PNS::SIZES_SETTINGS        m_sizes;
+    BOX2I                      m_area;      ///< the area of the connection, with the clearance
+    std::unique_ptr<PNS::LINE> m_line;      ///< the track routed by a worker, to be committed
+    bool                       m_routed;
+};
+
+
+/**
+ * Finds the item of a net at a point of the world, preferring the pads to the vias and
+ * the vias to the tracks.  Any net is accepted when aNet is negative, and any layer when
+ * aLayer is negative.
+ */
+static PNS::ITEM* findItem( PNS::NODE* aWorld, const VECTOR2I& aP, int aNet, int aLayer )
+{
+    const PNS::ITEM_SET items = aWorld->HitTest( aP );
+    PNS::ITEM*          best = nullptr;
+    int                 bestRank = 0;
+
+    for( PNS::ITEM* item : items.CItems() )
+    {
+        int rank = 0;
+
+        if( item->Net() <= 0 || ( aNet >= 0 && item->Net() != aNet ) )
+            continue;
+
+        if( aLayer >= 0 && !item->Layers().Overlaps( aLayer ) )
+            continue;
+
+        switch( item->Kind() )
+        {
+        case PNS::ITEM::SOLID_T:   rank = 3; break;
+        case PNS::ITEM::VIA_T:     rank = 2; break;
+        case PNS::ITEM::SEGMENT_T: rank = 1; break;
+        default:                   break;
+        }
+
+        if( rank > bestRank )
+        {
+            best = item;
+            bestRank = rank;
+        }
+    }
+
+    return best;
+}
+
+
+PNS_BATCH_ROUTER::PNS_BATCH_ROUTER( BOARD* aBoard ) :
+    m_board( aBoard ),
+    m_parallel( false )
+{
+}
+
+
+PNS_BATCH_ROUTER::~PNS_BATCH_ROUTER()
+{
+}
+
+
+int PNS_BATCH_ROUTER::AddRatsnestConnections( int aNetCode )
+{
+    std::vector<CN_EDGE> edges;
+    int                  count = 0;
+
+    m_board->BuildConnectivity();
+    m_board->GetConnectivity()->GetUnconnectedEdges( edges );
+
+    for( const CN_EDGE& edge : edges )
+    {
+        if( aNetCode >= 0 && edge.GetSourceNode()->Parent()->GetNetCode() != aNetCode )
+            continue;
+
+        VECTOR2I src = edge.GetSourcePos();
+        VECTOR2I dst = edge.GetTargetPos();
+
+        AddConnection( wxPoint( src.x, src.y ), wxPoint( dst.x, dst.y ) );
+        count++;
+    }
+
+    return count;
+}
+
+
+void PNS_BATCH_ROUTER::AddConnection( const wxPoint& aStart, const wxPoint& aEnd )
+{
+    m_connections.push_back( { aStart, aEnd, false } );
+}
+
+
+void PNS_BATCH_ROUTER::ClearConnections()
+{
+    m_connections.clear();
+}
+
+
+bool PNS_BATCH_ROUTER::IsRouted( int aIndex ) const
+{
+    if( aIndex < 0 || aIndex >= (int) m_connections.size() )
+        return false;
+
+    return m_connections[aIndex].m_routed;
+}
+
+
+PNS_BATCH_ROUTER::WORKER* PNS_BATCH_ROUTER::createWorker( bool aCommitToBoard )
+{
+    // Synchronizing a world writes to the board, so the workers are created one at a time
+    WORKER* worker = new WORKER( m_board, aCommitToBoard );
+
+    m_workers.emplace_back( worker );
+
+    worker->m_router.SetInterface( &worker->m_iface );
+    worker->m_router.SetMode( PNS::PNS_MODE_ROUTE_SINGLE );
+    worker->m_router.Settings().SetMode( PNS::RM_Walkaround );
+    worker->m_router.SyncWorld();
+
+    return worker;
+}
+
+
+bool PNS_BATCH_ROUTER::prepareJob( WORKER* aWorker, JOB& aJob )
+{
+    const CONNECTION& conn = m_connections[aJob.m_connection];
+    PNS::NODE*        world = aWorker->m_router.GetWorld();
+
+    aJob.m_start = VECTOR2I( conn.m_start.x, conn.m_start.y );
+    aJob.m_end = VECTOR2I( conn.m_end.x, conn.m_end.y );
+    aJob.m_routed = false;
+
+    PNS::ITEM* startItem = findItem( world, aJob.m_start, -1, -1 );
+
+    if( !startItem )
+        return false;
+
+    aJob.m_net = startItem->Net();
+
+    PNS::ITEM* endItem = findItem( world, aJob.m_end, aJob.m_net, -1 );
+
+    if( !endItem )
+        return false;
+
+    // The track goes on the topmost layer shared by both ends
+    const LAYER_RANGE& a = startItem->Layers();
+    const LAYER_RANGE& b = endItem->Layers();
+
+    aJob.m_layer = std::max( a.Start(), b.Start() );
+
+    if( aJob.m_layer > std::min( a.End(), b.End() ) )
+        return false;
+
+    aJob.m_sizes.Init( m_board, startItem );
+
+    int margin = m_board->GetDesignSettings().GetBiggestClearanceValue()
+                 + aJob.m_sizes.TrackWidth();
+
+    aJob.m_area = BOX2I( aJob.m_start, aJob.m_end - aJob.m_start );
+    aJob.m_area.Normalize();
+    aJob.m_area.Inflate( margin );
+
+    return true;
+}
+
+
+bool PNS_BATCH_ROUTER::routeJob( WORKER* aWorker, JOB& aJob, bool aFix )
+{
+    PNS::ROUTER& router = aWorker->m_router;
+    PNS::NODE*   world = router.GetWorld();
+    PNS::ITEM*   startItem = findItem( world, aJob.m_start, aJob.m_net, aJob.m_layer );
+    PNS::ITEM*   endItem = findItem( world, aJob.m_end, aJob.m_net, aJob.m_layer );
+
+    if( !startItem || !endItem )
+        return false;
+
+    router.UpdateSizes( aJob.m_sizes );
+
+    if( !router.StartRouting( aJob.m_start, startItem, aJob.m_layer ) )
+        return false;
+
+    router.Move( aJob.m_end, endItem );
+
+    bool                reached = false;
+    const PNS::ITEM_SET traces = router.Placer()->Traces();
+
+    if( traces.Size() == 1 && traces[0]->OfKind( PNS::ITEM::LINE_T ) )
+    {
+        const PNS::LINE* trace = static_cast<const PNS::LINE*>( traces[0] );
+
+        // The walkaround stops short of the end when it cannot find a way
+        reached = trace->PointCount() > 1 && trace->CPoint( -1 ) == aJob.m_end;
+
+        if( reached && !aFix )
+            aJob.m_line.reset( new PNS::LINE( *trace, trace->CLine() ) );
+    }
+
+    if( reached && aFix )
+        reached = router.FixRoute( aJob.m_end, endItem, true );
+
+    router.StopRouting();
+
+    return reached;
+}
+
+
+void PNS_BATCH_ROUTER::commitJob( const JOB& aJob )
+{
+    // The first worker adds the track to the board, the others keep their world in sync
+    for( const std::unique_ptr<WORKER>& worker : m_workers )
+    {
+        PNS::NODE* branch = worker->m_router.GetWorld()->Branch();
+        PNS::LINE  line( *aJob.m_line, aJob.m_line->CLine() );
+
+        branch->Add( line );
+        worker->m_router.CommitRouting( branch );
+    }
+}
+
+
+void PNS_BATCH_ROUTER::routeParallel( std::vector<JOB>& aJobs )
+{
+    THREAD_POOL& pool = THREAD_POOL::GetPool();
+    size_t       threadCount = std::min( pool.GetThreadCount() + 1, aJobs.size() );
+    WORKER*      primary = m_workers[0].get();
+
+    std::vector<WORKER*> idle;
+
+    for( size_t ii = 0; ii < threadCount; ++ii )
+        idle.push_back( createWorker( false ) );
+
+    std::vector<JOB*> pending;
+    std::vector<JOB*> colliding;
+
+    for( JOB& job : aJobs )
+        pending.push_back( &job );
+
+    while( !pending.empty() )
+    {
+        // A wave holds connections of different nets, far enough apart not to interact
+        std::vector<JOB*> wave;
+        std::vector<JOB*> rest;
+
+        for( JOB* job : pending )
+        {
+            bool interacts = wave.size() >= threadCount;
+
+            for( size_t ii = 0; ii < wave.size() && !interacts; ++ii )
+            {
+                interacts = wave[ii]->m_net == job->m_net
+                            || wave[ii]->m_area.Intersects( job->m_area );
+            }
+
+            if( interacts )
+                rest.push_back( job );
+            else
+                wave.push_back( job );
+        }
+
+        std::mutex idleLock;
+
+        pool.ParallelFor( wave.size(),
+                [&]( size_t aIndex )
+                {
+                    WORKER* worker;
+
+                    {
+                        std::lock_guard<std::mutex> guard( idleLock );
+                        worker = idle.back();
+                        idle.pop_back();
+                    }
+
+                    routeJob( worker, *wave[aIndex], false );
+
+                    std::lock_guard<std::mutex> guard( idleLock );
+                    idle.push_back( worker );
+                },
+                1, threadCount );
+
+        // The commits are done in the order of the connections, so the results do not
+        // depend on the thread timings
+        for( JOB* job : wave )
+        {
+            if( !job->m_line )
+                continue;
+
+            if( primary->m_router.GetWorld()->CheckColliding( job->m_line.get() ) )
+            {
+                colliding.push_back( job );
+            }
+            else
+            {
+                commitJob( *job );
+                job->m_routed = true;
+            }
+
+            job->m_line.reset();
+        }
+
+        pending.swap( rest );
+    }
+
+    for( JOB* job : colliding )
+        job->m_routed = routeJob( primary, *job, true );
+}
+
+
+int PNS_BATCH_ROUTER::Route()
+{
+    // The board may have changed since the last call
+    m_workers.clear();
+
+    WORKER*          primary = createWorker( true );
+    std::vector<JOB> jobs;
+    int              count = 0;
+
+    for( size_t ii = 0; ii < m_connections.size(); ++ii )
+    {
+        if( m_connections[ii].m_routed )
+            continue;
+
+        JOB job;
+        job.m_connection = ii;
+
+        if( prepareJob( primary, job ) )
+            jobs.push_back( std::move( job ) );
+    }
+
+    if( m_parallel && jobs.size() > 1 && THREAD_POOL::GetPool().GetThreadCount() > 0 )
+    {
+        routeParallel( jobs );
+    }
+    else
+    {
+        for( JOB& job : jobs )
+            job.m_routed = routeJob( primary, job, true );
+    }
+
+    for( const JOB& job : jobs )
+    {
+        if( job.m_routed )
+        {
+            m_connections[job.m_connection].m_routed = true;
+            count++;
+        }
+    }
+
+    m_workers.clear();
+    m_board->BuildConnectivity();
+
+    return count;
+}
@@ -0,0 +1,103 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PNS_BATCH_ROUTER_H
+#define __PNS_BATCH_ROUTER_H
+
+#include <memory>
+#include <vector>
+
+#include <wx/gdicmn.h>
+
+class BOARD;
+
+/**
+ * Class PNS_BATCH_ROUTER
+ *
+ * Routes a list of connections of a board without a view, one after another, with the
+ * walkaround mode of the interactive router.  The world of the router is synchronized
+ * once, and each routed track is added to it and to the board.
+ *
+ * In the parallel mode, connections of different nets whose areas do not overlap are
+ * routed together, each by a router with its own copy of the world.  Their tracks are
+ * checked against the tracks routed before them, and the colliding ones are routed again
+ * one after another.
+ */
+class PNS_BATCH_ROUTER
+{
+public:
+    PNS_BATCH_ROUTER( BOARD* aBoard );
+    ~PNS_BATCH_ROUTER();
+
+    /**
+     * Adds the unconnected ratsnest lines of the board.
+     * @param aNetCode is the net to add the lines of, or -1 for all the nets
+     * @return the number of added connections
+     */
+    int AddRatsnestConnections( int aNetCode = -1 );
+
+    /**
+     * Adds a connection between the items found at two points of the board.  The net is
+     * the one of the item found at aStart.
+     */
+    void AddConnection( const wxPoint& aStart, const wxPoint& aEnd );
+
+    void ClearConnections();
+
+    int GetConnectionCount() const
+    {
+        return (int) m_connections.size();
+    }
+
+    bool IsRouted( int aIndex ) const;
+
+    ///> Enables the parallel routing of the connections which do not interact
+    void SetParallel( bool aParallel ) { m_parallel = aParallel; }
+    bool IsParallel() const { return m_parallel; }
+
+    /**
+     * Routes the connections which are not routed yet, and adds their tracks to the board.
+     * @return the number of connections routed by this call
+     */
+    int Route();
+
+private:
+    struct CONNECTION
+    {
+        wxPoint m_start;
+        wxPoint m_end;
+        bool    m_routed;
+    };
+
+    struct WORKER;
+    struct JOB;
+
+    WORKER* createWorker( bool aCommitToBoard );
+    bool prepareJob( WORKER* aWorker, JOB& aJob );
+    bool routeJob( WORKER* aWorker, JOB& aJob, bool aFix );
+    void commitJob( const JOB& aJob );
+    void routeParallel( std::vector<JOB>& aJobs );
+
+    BOARD*                               m_board;
+    bool                                 m_parallel;
+    std::vector<CONNECTION>              m_connections;
+    std::vector<std::unique_ptr<WORKER>> m_workers;    ///< the first one commits to the board
+};
+
+#endif
@@ -363,6 +363,7 @@ const ITEM_SET DIFF_PAIR_PLACER::Traces()
 void DIFF_PAIR_PLACER::FlipPosture()
 {
     m_startDiagonal = !m_startDiagonal;
+    invalidateGateways();
 
     if( !m_idle )
         Move( m_currentEnd, NULL );
@@ -607,6 +608,7 @@ void DIFF_PAIR_PLACER::initPlacement()
     m_orthoMode = false;
     m_currentEndItem = NULL;
     m_startDiagonal = m_initialDiagonal;
+    invalidateGateways();
 
     NODE* world = Router()->GetWorld();
 
@@ -631,24 +633,42 @@ void DIFF_PAIR_PLACER::initPlacement()
 }
 
 
+void DIFF_PAIR_PLACER::invalidateGateways()
+{
+    m_entryGateways = NULLOPT;
+    m_lastCursorFit = NULLOPT;
+}
+
+
 bool DIFF_PAIR_PLACER::routeHead( const VECTOR2I& aP )
 {
     m_fitOk = false;
 
-    DP_GATEWAYS gwsEntry( gap() );
     DP_GATEWAYS gwsTarget( gap() );
 
     if( !m_prevPair )
         m_prevPair = m_start;
 
-    gwsEntry.BuildFromPrimitivePair( *m_prevPair, m_startDiagonal );
+    if( !m_entryGateways )
+    {
+        m_entryGateways = DP_GATEWAYS( gap() );
+        m_entryGateways->BuildFromPrimitivePair( *m_prevPair, m_startDiagonal );
+    }
 
+    DP_GATEWAYS& gwsEntry = *m_entryGateways;
     DP_PRIMITIVE_PAIR target;
+    bool result;
+
+    m_currentTrace = DIFF_PAIR();
+    m_currentTrace.SetGap( gap() );
+    m_currentTrace.SetLayer( m_currentLayer );
 
     if( findDpPrimitivePair( aP, m_currentEndItem, target ) )
     {
         gwsTarget.BuildFromPrimitivePair( target, m_startDiagonal );
         m_snapOnTarget = true;
+
+        result = gwsEntry.FitGateways( gwsEntry, gwsTarget, m_startDiagonal, m_currentTrace );
     }
     else
     {
@@ -666,29 +686,60 @@ bool DIFF_PAIR_PLACER::routeHead( const VECTOR2I& aP )
         // on the extension of the starting segment pair of the DP)
         int lead_dist = ( fpProj - fp ).EuclideanNorm();
 
-        gwsTarget.SetFitVias( m_placingVia, m_sizes.ViaDiameter(), viaGap() );
+        CURSOR_FIT fit;
+
+        fit.m_fitVias = m_placingVia;
+        fit.m_viaDiameter = m_sizes.ViaDiameter();
+        fit.m_viaGap = viaGap();
 
         // far from the initial segment extension line -> allow a 45-degree obtuse turn
         if( lead_dist > m_sizes.DiffPairGap() + m_sizes.DiffPairWidth() )
         {
-            gwsTarget.BuildForCursor( fp );
+            fit.m_cursor = fp;
+            fit.m_straightDir = VECTOR2I( 0, 0 );
         }
         // close to the initial segment extension line -> keep straight part only, project as close
         // as possible to the cursor
         else
         {
-            gwsTarget.BuildForCursor( fpProj );
-            gwsTarget.FilterByOrientation( DIRECTION_45::ANG_STRAIGHT | DIRECTION_45::ANG_HALF_FULL, DIRECTION_45( dirV ) );
+            fit.m_cursor = fpProj;
+            fit.m_straightDir = dirV;
         }
 
-        m_snapOnTarget = false;
-    }
+        if( m_lastCursorFit && m_lastCursorFit->SameGateways( fit ) )
+        {
+            // Same gateways as the previous move: the fit would give the same head
+            fit = *m_lastCursorFit;
 
-    m_currentTrace = DIFF_PAIR();
-    m_currentTrace.SetGap( gap() );
-    m_currentTrace.SetLayer( m_currentLayer );
+            if( fit.m_ok )
+                m_currentTrace.SetShape( fit.m_p, fit.m_n );
+        }
+        else
+        {
+            gwsTarget.SetFitVias( fit.m_fitVias, fit.m_viaDiameter, fit.m_viaGap );
+            gwsTarget.BuildForCursor( fit.m_cursor );
+
+            if( fit.m_straightDir != VECTOR2I( 0, 0 ) )
+            {
+                gwsTarget.FilterByOrientation( DIRECTION_45::ANG_STRAIGHT | DIRECTION_45::ANG_HALF_FULL,
+                                               DIRECTION_45( fit.m_straightDir ) );
+            }
 
-    bool result = gwsEntry.FitGateways( gwsEntry, gwsTarget, m_startDiagonal, m_currentTrace );
+            fit.m_ok = gwsEntry.FitGateways( gwsEntry, gwsTarget, m_startDiagonal,
+                                             m_currentTrace );
+
+            if( fit.m_ok )
+            {
+                fit.m_p = m_currentTrace.CP();
+                fit.m_n = m_currentTrace.CN();
+            }
+
+            m_lastCursorFit = fit;
+        }
+
+        m_snapOnTarget = false;
+        result = fit.m_ok;
+    }
 
     if( result )
     {
@@ -792,6 +843,7 @@ bool DIFF_PAIR_PLACER::FixRoute( const VECTOR2I& aP, ITEM* aEndItem, bool aForce
     topo.SimplifyLine( &lineN );
 
     m_prevPair = m_currentTrace.EndingPrimitives();
+    invalidateGateways();
 
     Router()->CommitRouting( m_lastNode );
 
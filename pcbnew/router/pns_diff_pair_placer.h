@@ -231,6 +231,9 @@ private:
     bool attemptWalk( NODE* aNode, DIFF_PAIR* aCurrent, DIFF_PAIR& aWalk, bool aPFirst, bool aWindCw, bool aSolidsOnly );
     bool propagateDpHeadForces ( const VECTOR2I& aP, VECTOR2I& aNewP );
 
+    ///> Drops the cached gateways, when the pair the head starts from or the posture changes
+    void invalidateGateways();
+
     enum State {
         RT_START = 0,
         RT_ROUTE = 1,
@@ -249,6 +252,33 @@ private:
     DP_PRIMITIVE_PAIR m_start;
     OPT<DP_PRIMITIVE_PAIR> m_prevPair;
 
+    /**
+     * The head fitted to the gateways around a cursor position.  The gateways only depend
+     * on the fields of the key, so the head is reused while the cursor stays in place.
+     */
+    struct CURSOR_FIT
+    {
+        VECTOR2I m_cursor;
+        VECTOR2I m_straightDir;     ///< orientation the gateways are kept straight to, or 0
+        bool     m_fitVias;
+        int      m_viaDiameter;
+        int      m_viaGap;
+
+        bool             m_ok;
+        SHAPE_LINE_CHAIN m_p, m_n;
+
+        bool SameGateways( const CURSOR_FIT& aOther ) const
+        {
+            return m_cursor == aOther.m_cursor && m_straightDir == aOther.m_straightDir
+                   && m_fitVias == aOther.m_fitVias && m_viaDiameter == aOther.m_viaDiameter
+                   && m_viaGap == aOther.m_viaGap;
+        }
+    };
+
+    ///> The gateways built from m_prevPair, kept until it or the posture changes
+    OPT<DP_GATEWAYS> m_entryGateways;
+    OPT<CURSOR_FIT> m_lastCursorFit;
+
     ///> current algorithm iteration
     int m_iteration;
 
@@ -19,6 +19,8 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include "pns_index.h"
 
 namespace PNS {
@@ -110,8 +112,24 @@ void INDEX::Remove( ITEM* aItem )
     m_allItems.erase( aItem );
     int net = aItem->Net();
 
-    if( net >= 0 && m_netMap.find( net ) != m_netMap.end() )
-        m_netMap[net].remove( aItem );
+    if( net < 0 )
+        return;
+
+    auto netItems = m_netMap.find( net );
+
+    if( netItems == m_netMap.end() )
+        return;
+
+    // The order of the items of a net does not matter, so the removed item is replaced
+    // by the last one
+    NET_ITEMS_LIST& items = netItems->second;
+    auto item = std::find( items.begin(), items.end(), aItem );
+
+    if( item != items.end() )
+    {
+        *item = items.back();
+        items.pop_back();
+    }
 }
 
 void INDEX::Replace( ITEM* aOldItem, ITEM* aNewItem )
@@ -137,10 +155,12 @@ void INDEX::Clear()
 
 INDEX::NET_ITEMS_LIST* INDEX::GetItemsForNet( int aNet )
 {
-    if( m_netMap.find( aNet ) == m_netMap.end() )
+    auto netItems = m_netMap.find( aNet );
+
+    if( netItems == m_netMap.end() )
         return NULL;
 
-    return &m_netMap[aNet];
+    return &netItems->second;
 }
 
 };
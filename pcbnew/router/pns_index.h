@@ -24,7 +24,9 @@
 
 #include <layers_id_colors_and_visibility.h>
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <boost/range/adaptor/map.hpp>
 
@@ -32,6 +34,7 @@
 #include <geometry/shape_index.h>
 
 #include "pns_item.h"
+#include "pns_pool.h"
 
 namespace PNS {
 
@@ -46,13 +49,24 @@ namespace PNS {
 class INDEX
 {
 public:
-    typedef std::list<ITEM*>            NET_ITEMS_LIST;
+    typedef std::vector<ITEM*>          NET_ITEMS_LIST;
     typedef SHAPE_INDEX<ITEM*>          ITEM_SHAPE_INDEX;
     typedef std::unordered_set<ITEM*>   ITEM_SET;
 
     INDEX();
     ~INDEX();
 
+    ///> Indices are allocated from the router POOL
+    static void* operator new( size_t aSize )
+    {
+        return POOL::Alloc( aSize );
+    }
+
+    static void operator delete( void* aBlock, size_t aSize )
+    {
+        POOL::Free( aBlock, aSize );
+    }
+
     /**
      * Function Add()
      *
@@ -155,7 +169,7 @@ private:
     ITEM_SHAPE_INDEX* getSubindex( const ITEM* aItem );
 
     ITEM_SHAPE_INDEX* m_subIndices[MaxSubIndices];
-    std::map<int, NET_ITEMS_LIST> m_netMap;
+    std::unordered_map<int, NET_ITEMS_LIST> m_netMap;
     ITEM_SET m_allItems;
 };
 
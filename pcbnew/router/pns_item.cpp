@@ -27,6 +27,96 @@ typedef VECTOR2I::extended_type ecoord;
 
 namespace PNS {
 
+HULL_CACHE& HULL_CACHE::operator=( const HULL_CACHE& aOther )
+{
+    if( this == &aOther )
+        return *this;
+
+    ENTRY entries[SIZE];
+    int next;
+
+    {
+        std::lock_guard<std::mutex> lock( aOther.m_lock );
+
+        for( int i = 0; i < SIZE; i++ )
+            entries[i] = aOther.m_entries[i];
+
+        next = aOther.m_next;
+    }
+
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    for( int i = 0; i < SIZE; i++ )
+        m_entries[i] = entries[i];
+
+    m_next = next;
+
+    return *this;
+}
+
+
+bool HULL_CACHE::Find( int aClearance, int aWalkaroundThickness, SHAPE_LINE_CHAIN& aHull ) const
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    for( const ENTRY& entry : m_entries )
+    {
+        if( entry.m_valid && entry.m_clearance == aClearance
+                && entry.m_walkaroundThickness == aWalkaroundThickness )
+        {
+            aHull = entry.m_hull;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void HULL_CACHE::Store( int aClearance, int aWalkaroundThickness, const SHAPE_LINE_CHAIN& aHull )
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    ENTRY& entry = m_entries[m_next];
+
+    entry.m_valid = true;
+    entry.m_clearance = aClearance;
+    entry.m_walkaroundThickness = aWalkaroundThickness;
+    entry.m_hull = aHull;
+
+    m_next = ( m_next + 1 ) % SIZE;
+}
+
+
+void HULL_CACHE::Clear()
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    for( ENTRY& entry : m_entries )
+    {
+        entry.m_valid = false;
+        entry.m_hull = SHAPE_LINE_CHAIN();
+    }
+
+    m_next = 0;
+}
+
+
+const SHAPE_LINE_CHAIN ITEM::Hull( int aClearance, int aWalkaroundThickness ) const
+{
+    SHAPE_LINE_CHAIN hull;
+
+    if( m_hullCache.Find( aClearance, aWalkaroundThickness, hull ) )
+        return hull;
+
+    // The chains share their points, so the cached copy costs no more than a reference
+    hull = buildHull( aClearance, aWalkaroundThickness );
+    m_hullCache.Store( aClearance, aWalkaroundThickness, hull );
+
+    return hull;
+}
+
+
 bool ITEM::collideSimple( const ITEM* aOther, int aClearance, bool aNeedMTV, VECTOR2I* aMTV,
                           const NODE* aParentNode, bool aDifferentNetsOnly ) const
 {
@@ -23,12 +23,14 @@
 #define __PNS_ITEM_H
 
 #include <memory>
+#include <mutex>
 #include <math/vector2d.h>
 
 #include <geometry/shape.h>
 #include <geometry/shape_line_chain.h>
 
 #include "pns_layerset.h"
+#include "pns_pool.h"
 
 class BOARD_CONNECTED_ITEM;
 
@@ -44,6 +46,56 @@ enum LineMarker {
 };
 
 
+/**
+ * Class HULL_CACHE
+ *
+ * Keeps the last hulls built for an item, as the same obstacles are walked around with the
+ * same clearance and line width by the successive queries.  The entries are keyed by the
+ * clearance and the walkaround thickness: the owning item clears the cache when its
+ * geometry changes.  The walkaround may query the hulls from several threads.
+ */
+class HULL_CACHE
+{
+public:
+    HULL_CACHE() :
+        m_next( 0 )
+    {}
+
+    HULL_CACHE( const HULL_CACHE& aOther )
+    {
+        *this = aOther;
+    }
+
+    ///> The copies of an item have the same geometry, so they share its hulls
+    HULL_CACHE& operator=( const HULL_CACHE& aOther );
+
+    bool Find( int aClearance, int aWalkaroundThickness, SHAPE_LINE_CHAIN& aHull ) const;
+    void Store( int aClearance, int aWalkaroundThickness, const SHAPE_LINE_CHAIN& aHull );
+    void Clear();
+
+private:
+    static const int SIZE = 2;
+
+    struct ENTRY
+    {
+        ENTRY() :
+            m_valid( false ),
+            m_clearance( 0 ),
+            m_walkaroundThickness( 0 )
+        {}
+
+        bool             m_valid;
+        int              m_clearance;
+        int              m_walkaroundThickness;
+        SHAPE_LINE_CHAIN m_hull;
+    };
+
+    mutable std::mutex m_lock;
+    ENTRY              m_entries[SIZE];
+    int                m_next;          ///< Entry replaced by the next Store()
+};
+
+
 /**
  * Class ITEM
  *
@@ -90,10 +142,22 @@ public:
         m_marker = aOther.m_marker;
         m_rank = aOther.m_rank;
         m_routable = aOther.m_routable;
+        m_hullCache = aOther.m_hullCache;
     }
 
     virtual ~ITEM();
 
+    ///> Items are allocated from the router POOL
+    static void* operator new( size_t aSize )
+    {
+        return POOL::Alloc( aSize );
+    }
+
+    static void operator delete( void* aBlock, size_t aSize )
+    {
+        POOL::Free( aBlock, aSize );
+    }
+
     /**
      * Function Clone()
      *
@@ -105,14 +169,11 @@ public:
      * Function Hull()
      *
      * Returns a convex polygon "hull" of a the item, that is used as the walk-around
-     * path.
+     * path.  The hulls are built by buildHull() and cached.
      * @param aClearance defines how far from the body of the item the hull should be,
      * @param aWalkaroundThickness is the width of the line that walks around this hull.
      */
-    virtual const SHAPE_LINE_CHAIN Hull( int aClearance = 0, int aWalkaroundThickness = 0 ) const
-    {
-        return SHAPE_LINE_CHAIN();
-    }
+    const SHAPE_LINE_CHAIN Hull( int aClearance = 0, int aWalkaroundThickness = 0 ) const;
 
     /**
      * Function Kind()
@@ -245,6 +306,18 @@ private:
                         const NODE* aParentNode, bool aDifferentNetsOnly ) const;
 
 protected:
+    ///> Builds the hull returned by Hull()
+    virtual const SHAPE_LINE_CHAIN buildHull( int aClearance, int aWalkaroundThickness ) const
+    {
+        return SHAPE_LINE_CHAIN();
+    }
+
+    ///> Drops the cached hulls, to be called when the geometry of the item changes
+    void invalidateHull()
+    {
+        m_hullCache.Clear();
+    }
+
     PnsKind                 m_kind;
 
     BOARD_CONNECTED_ITEM*   m_parent;
@@ -256,6 +329,8 @@ protected:
     int                     m_marker;
     int                     m_rank;
     bool                    m_routable;
+
+    mutable HULL_CACHE      m_hullCache;
 };
 
 template< typename T, typename S >
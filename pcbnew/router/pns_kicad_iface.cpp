@@ -109,6 +109,11 @@ PNS_PCBNEW_RULE_RESOLVER::PNS_PCBNEW_RULE_RESOLVER( BOARD* aBoard, PNS::ROUTER*
     PNS::TOPOLOGY topo( world );
     m_netClearanceCache.resize( m_board->GetNetCount() );
 
+    // Netclasses can have been edited since the last synchronization
+    m_board->BuildNetClearances();
+
+    NETCLASSPTR defaultNetClass = m_board->GetDesignSettings().GetDefault();
+
     // Build clearance cache for net classes
     for( unsigned int i = 0; i < m_board->GetNetCount(); i++ )
     {
@@ -120,16 +125,16 @@ PNS_PCBNEW_RULE_RESOLVER::PNS_PCBNEW_RULE_RESOLVER( BOARD* aBoard, PNS::ROUTER*
         CLEARANCE_ENT ent;
         ent.coupledNet = DpCoupledNet( i );
 
-        wxString netClassName = ni->GetClassName();
-        NETCLASSPTR nc = m_board->GetDesignSettings().m_NetClasses.Find( netClassName );
+        // The net points to its netclass, no need for a lookup by name
+        NETCLASSPTR nc = ni->GetNetClass() ? ni->GetNetClass() : defaultNetClass;
 
-        int clearance = nc->GetClearance();
+        int clearance = m_board->GetNetClearance( i );
         ent.clearance = clearance;
         ent.dpClearance = nc->GetDiffPairGap();
         m_netClearanceCache[i] = ent;
 
         wxLogTrace( "PNS", "Add net %u netclass %s clearance %d Diff Pair clearance %d",
-                i, netClassName.mb_str(), clearance, ent.dpClearance );
+                i, nc->GetName().mb_str(), clearance, ent.dpClearance );
     }
 
     // Build clearance cache for pads
@@ -149,16 +154,7 @@ PNS_PCBNEW_RULE_RESOLVER::PNS_PCBNEW_RULE_RESOLVER( BOARD* aBoard, PNS::ROUTER*
         }
     }
 
-    auto defaultRule = m_board->GetDesignSettings().m_NetClasses.Find ("Default");
-
-    if( defaultRule )
-    {
-        m_defaultClearance = defaultRule->GetClearance();
-    }
-    else
-    {
-        m_defaultClearance = Millimeter2iu(0.254);
-    }
+    m_defaultClearance = m_board->GetNetClearance( 0 );
 }
 
 
@@ -531,6 +527,8 @@ PNS_KICAD_IFACE::PNS_KICAD_IFACE()
     m_router = nullptr;
     m_debugDecorator = nullptr;
     m_dispOptions = nullptr;
+    m_incrementalSync = false;
+    m_worldValid = false;
 }
 
 
@@ -928,6 +926,7 @@ bool PNS_KICAD_IFACE::syncTextItem( PNS::NODE* aWorld, EDA_TEXT* aText, PCB_LAYE
         solid->SetShape( new SHAPE_SEGMENT( start, end, textWidth ) );
         solid->SetRoutable( false );
 
+        m_shapeItems[ dynamic_cast<BOARD_ITEM*>( aText ) ].push_back( solid.get() );
         aWorld->Add( std::move( solid ) );
     }
 
@@ -1042,6 +1041,7 @@ bool PNS_KICAD_IFACE::syncGraphicalItem( PNS::NODE* aWorld, DRAWSEGMENT* aItem )
         solid->SetShape( seg );
         solid->SetRoutable( false );
 
+        m_shapeItems[ aItem ].push_back( solid.get() );
         aWorld->Add( std::move( solid ) );
     }
 
@@ -1065,6 +1065,9 @@ void PNS_KICAD_IFACE::SyncWorld( PNS::NODE *aWorld )
         return;
     }
 
+    m_dirtyItems.clear();
+    m_shapeItems.clear();
+
     for( auto gitem : m_board->Drawings() )
     {
         if ( gitem->Type() == PCB_LINE_T )
@@ -1127,13 +1130,148 @@ void PNS_KICAD_IFACE::SyncWorld( PNS::NODE *aWorld )
         }
     }
 
+    syncRules( aWorld, worstPadClearance );
+    m_worldValid = true;
+}
+
+
+bool PNS_KICAD_IFACE::UpdateWorld( PNS::NODE* aWorld )
+{
+    if( !m_board || !m_incrementalSync || !m_worldValid )
+        return false;
+
+    int worstPadClearance = 0;
+
+    // Drop the router items of the dirty board items, whether they still exist or not
+    aWorld->RemoveByParent( m_dirtyItems );
+
+    for( const BOARD_ITEM* item : m_dirtyItems )
+    {
+        auto shapes = m_shapeItems.find( item );
+
+        if( shapes == m_shapeItems.end() )
+            continue;
+
+        for( PNS::ITEM* shape : shapes->second )
+            aWorld->Remove( shape );
+
+        m_shapeItems.erase( shapes );
+    }
+
+    // Then build them again from the items still on the board.  The dirty items are only
+    // compared here, never dereferenced, as the removed ones may have been deleted since.
+    auto isDirty = [&]( const BOARD_ITEM* aItem )
+    {
+        return m_dirtyItems.count( aItem ) > 0;
+    };
+
+    for( auto gitem : m_board->Drawings() )
+    {
+        if( !isDirty( gitem ) )
+            continue;
+
+        if( gitem->Type() == PCB_LINE_T )
+            syncGraphicalItem( aWorld, static_cast<DRAWSEGMENT*>( gitem ) );
+        else if( gitem->Type() == PCB_TEXT_T )
+            syncTextItem( aWorld, static_cast<TEXTE_PCB*>( gitem ), gitem->GetLayer() );
+    }
+
+    for( auto zone : m_board->Zones() )
+    {
+        if( isDirty( zone ) )
+            syncZone( aWorld, zone );
+    }
+
+    for( auto module : m_board->Modules() )
+    {
+        for( auto pad : module->Pads() )
+        {
+            if( isDirty( pad ) )
+            {
+                if( auto solid = syncPad( pad ) )
+                    aWorld->Add( std::move( solid ) );
+            }
+
+            worstPadClearance = std::max( worstPadClearance, pad->GetLocalClearance() );
+        }
+
+        if( isDirty( &module->Reference() ) )
+            syncTextItem( aWorld, &module->Reference(), module->Reference().GetLayer() );
+
+        if( isDirty( &module->Value() ) )
+            syncTextItem( aWorld, &module->Value(), module->Value().GetLayer() );
+
+        if( module->IsNetTie() )
+            continue;
+
+        for( auto mgitem : module->GraphicalItems() )
+        {
+            if( !isDirty( mgitem ) )
+                continue;
+
+            if( mgitem->Type() == PCB_MODULE_EDGE_T )
+                syncGraphicalItem( aWorld, static_cast<DRAWSEGMENT*>( mgitem ) );
+            else if( mgitem->Type() == PCB_MODULE_TEXT_T )
+                syncTextItem( aWorld, dynamic_cast<TEXTE_MODULE*>( mgitem ), mgitem->GetLayer() );
+        }
+    }
+
+    for( auto t : m_board->Tracks() )
+    {
+        if( !isDirty( t ) )
+            continue;
+
+        if( t->Type() == PCB_TRACE_T )
+        {
+            if( auto segment = syncTrack( t ) )
+                aWorld->Add( std::move( segment ) );
+        }
+        else if( t->Type() == PCB_VIA_T )
+        {
+            if( auto via = syncVia( static_cast<VIA*>( t ) ) )
+                aWorld->Add( std::move( via ) );
+        }
+    }
+
+    wxLogTrace( "PNS", "Updated %d dirty items", (int) m_dirtyItems.size() );
+
+    m_dirtyItems.clear();
+
+    // The net classes and the clearances can have been edited since the last synchronization
+    syncRules( aWorld, worstPadClearance );
+    return true;
+}
+
+
+void PNS_KICAD_IFACE::MarkItemDirty( BOARD_ITEM* aItem )
+{
+    m_dirtyItems.insert( aItem );
+
+    if( aItem->Type() == PCB_MODULE_T )
+    {
+        MODULE* module = static_cast<MODULE*>( aItem );
+
+        for( auto pad : module->Pads() )
+            m_dirtyItems.insert( pad );
+
+        for( auto mgitem : module->GraphicalItems() )
+            m_dirtyItems.insert( mgitem );
+
+        m_dirtyItems.insert( &module->Reference() );
+        m_dirtyItems.insert( &module->Value() );
+    }
+}
+
+
+void PNS_KICAD_IFACE::syncRules( PNS::NODE* aWorld, int aWorstPadClearance )
+{
     int worstRuleClearance = m_board->GetDesignSettings().GetBiggestClearanceValue();
 
     delete m_ruleResolver;
     m_ruleResolver = new PNS_PCBNEW_RULE_RESOLVER( m_board, m_router );
 
     aWorld->SetRuleResolver( m_ruleResolver );
-    aWorld->SetMaxClearance( 4 * std::max(worstPadClearance, worstRuleClearance ) );
+    aWorld->SetMaxClearance( 4 * std::max( aWorstPadClearance, worstRuleClearance ) );
 }
 
 
@@ -1227,7 +1365,7 @@ void PNS_KICAD_IFACE::RemoveItem( PNS::ITEM* aItem )
 }
 
 
-void PNS_KICAD_IFACE::AddItem( PNS::ITEM* aItem )
+BOARD_CONNECTED_ITEM* PNS_KICAD_IFACE::createBoardItem( PNS::ITEM* aItem )
 {
     BOARD_CONNECTED_ITEM* newBI = NULL;
 
@@ -1270,9 +1408,18 @@ void PNS_KICAD_IFACE::AddItem( PNS::ITEM* aItem )
     {
         aItem->SetParent( newBI );
         newBI->ClearFlags();
+    }
+
+    return newBI;
+}
 
+
+void PNS_KICAD_IFACE::AddItem( PNS::ITEM* aItem )
+{
+    BOARD_CONNECTED_ITEM* newBI = createBoardItem( aItem );
+
+    if( newBI )
         m_commit->Add( newBI );
-    }
 }
 
 
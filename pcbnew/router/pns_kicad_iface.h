@@ -23,6 +23,8 @@
 #define __PNS_KICAD_IFACE_H
 
 #include <unordered_set>
+#include <unordered_map>
+#include <vector>
 
 #include "pns_router.h"
 
@@ -30,6 +32,7 @@ class PNS_PCBNEW_RULE_RESOLVER;
 class PNS_PCBNEW_DEBUG_DECORATOR;
 
 class BOARD;
+class BOARD_ITEM;
 class BOARD_COMMIT;
 class PCB_DISPLAY_OPTIONS;
 class PCB_TOOL_BASE;
@@ -51,6 +54,18 @@ public:
     void SetBoard( BOARD* aBoard );
     void SetView( KIGFX::VIEW* aView );
     void SyncWorld( PNS::NODE* aWorld ) override;
+    bool UpdateWorld( PNS::NODE* aWorld ) override;
+
+    /**
+     * Records a board item added, changed or removed since the last synchronization, so
+     * UpdateWorld() replaces its router items.  Footprints are expanded to their children,
+     * as they may not exist anymore when the world is updated.
+     */
+    void MarkItemDirty( BOARD_ITEM* aItem );
+
+    ///> Enables UpdateWorld(), when all the board changes are reported to MarkItemDirty().
+    void SetIncrementalSync( bool aEnable ) { m_incrementalSync = aEnable; }
+
     void EraseView() override;
     void HideItem( PNS::ITEM* aItem ) override;
     void DisplayItem( const PNS::ITEM* aItem, int aColor = 0, int aClearance = 0, bool aEdit = false ) override;
@@ -63,6 +78,13 @@ public:
     PNS::RULE_RESOLVER* GetRuleResolver() override;
     PNS::DEBUG_DECORATOR* GetDebugDecorator() override;
 
+protected:
+    /**
+     * Creates the board track or via of a router item, and makes it the parent of the item.
+     * @return the new board item, not added to the board, or NULL for the other kinds of items.
+     */
+    BOARD_CONNECTED_ITEM* createBoardItem( PNS::ITEM* aItem );
+
 private:
     PNS_PCBNEW_RULE_RESOLVER* m_ruleResolver;
     PNS_PCBNEW_DEBUG_DECORATOR* m_debugDecorator;
@@ -73,6 +95,7 @@ private:
     bool syncTextItem( PNS::NODE* aWorld, EDA_TEXT* aText, PCB_LAYER_ID aLayer );
     bool syncGraphicalItem( PNS::NODE* aWorld, DRAWSEGMENT* aItem );
     bool syncZone( PNS::NODE* aWorld, ZONE_CONTAINER* aZone );
+    void syncRules( PNS::NODE* aWorld, int aWorstPadClearance );
 
     KIGFX::VIEW* m_view;
     KIGFX::VIEW_GROUP* m_previewItems;
@@ -83,6 +106,14 @@ private:
     PCB_TOOL_BASE* m_tool;
     std::unique_ptr<BOARD_COMMIT> m_commit;
     PCB_DISPLAY_OPTIONS* m_dispOptions;
+
+    bool m_incrementalSync;
+    bool m_worldValid;                                      ///< The world matches the board,
+                                                            ///< apart from the dirty items
+    std::unordered_set<const BOARD_ITEM*> m_dirtyItems;
+
+    ///> The solids built from the texts and graphics, which have no parent to find them by
+    std::unordered_map<const BOARD_ITEM*, std::vector<PNS::ITEM*>> m_shapeItems;
 };
 
 #endif
@@ -124,6 +124,7 @@ SEGMENT* SEGMENT::Clone() const
     SEGMENT* s = new SEGMENT;
 
     s->m_seg = m_seg;
+    s->m_hullCache = m_hullCache;
     s->m_net = m_net;
     s->m_layers = m_layers;
     s->m_marker = m_marker;
@@ -292,7 +293,7 @@ bool LINE::Walkaround( const SHAPE_LINE_CHAIN& aObstacle, SHAPE_LINE_CHAIN& aPat
 }
 
 
-const SHAPE_LINE_CHAIN SEGMENT::Hull( int aClearance, int aWalkaroundThickness ) const
+const SHAPE_LINE_CHAIN SEGMENT::buildHull( int aClearance, int aWalkaroundThickness ) const
 {
    return SegmentHull( m_seg, aClearance, aWalkaroundThickness );
 }
@@ -139,6 +139,107 @@ void LOGGER::Log( const VECTOR2I& aStart, const VECTOR2I& aEnd,
 }
 
 
+VECTOR2I LOGGER::ItemPosition( const ITEM* aItem )
+{
+    switch( aItem->Kind() )
+    {
+    case ITEM::SEGMENT_T:
+        return static_cast<const SEGMENT*>( aItem )->Seg().A;
+
+    case ITEM::VIA_T:
+        return static_cast<const VIA*>( aItem )->Pos();
+
+    case ITEM::SOLID_T:
+        return static_cast<const SOLID*>( aItem )->Pos();
+
+    case ITEM::LINE_T:
+        return static_cast<const LINE*>( aItem )->CPoint( 0 );
+
+    default:
+        return VECTOR2I( 0, 0 );
+    }
+}
+
+
+void LOGGER::Log( EVENT_TYPE aEvent, const VECTOR2I& aPos, const ITEM* aItem, int aArg )
+{
+    m_theLog << "event " << aEvent << " " << aPos.x << " " << aPos.y << " " << aArg << " ";
+
+    if( aItem )
+    {
+        VECTOR2I itemPos = ItemPosition( aItem );
+
+        m_theLog << aItem->Kind() << " " << aItem->Net() << " " << aItem->Layers().Start()
+                 << " " << aItem->Layers().End() << " " << itemPos.x << " " << itemPos.y;
+    }
+    else
+    {
+        m_theLog << "0 0 0 0 0 0";
+    }
+
+    m_theLog << std::endl;
+}
+
+
+void LOGGER::LogConfig( const std::vector<int>& aValues )
+{
+    m_theLog << "config " << aValues.size();
+
+    for( int value : aValues )
+        m_theLog << " " << value;
+
+    m_theLog << std::endl;
+}
+
+
+bool LOGGER::ParseEvents( std::istream& aStream, std::vector<int>& aConfig,
+                          std::vector<EVENT_ENTRY>& aEvents )
+{
+    std::string line;
+
+    while( std::getline( aStream, line ) )
+    {
+        std::istringstream tokens( line );
+        std::string        tag;
+
+        tokens >> tag;
+
+        if( tag == "config" )
+        {
+            size_t count = 0;
+
+            if( !( tokens >> count ) )
+                return false;
+
+            aConfig.resize( count );
+
+            for( int& value : aConfig )
+            {
+                if( !( tokens >> value ) )
+                    return false;
+            }
+        }
+        else if( tag == "event" )
+        {
+            EVENT_ENTRY evt;
+            int         type;
+
+            tokens >> type >> evt.m_pos.x >> evt.m_pos.y >> evt.m_arg >> evt.m_itemKind
+                   >> evt.m_itemNet >> evt.m_itemLayerStart >> evt.m_itemLayerEnd
+                   >> evt.m_itemPos.x >> evt.m_itemPos.y;
+
+            if( !tokens || type < EVT_START_ROUTE || type > EVT_FLIP_POSTURE )
+                return false;
+
+            evt.m_type = static_cast<EVENT_TYPE>( type );
+            aEvents.push_back( evt );
+        }
+    }
+
+    return true;
+}
+
+
 void LOGGER::dumpShape( const SHAPE* aSh )
 {
     switch( aSh->Type() )
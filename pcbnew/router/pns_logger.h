@@ -23,6 +23,7 @@
 #define __PNS_LOGGER_H
 
 #include <cstdio>
+#include <istream>
 #include <vector>
 #include <string>
 #include <sstream>
@@ -39,6 +40,35 @@ class ITEM;
 class LOGGER
 {
 public:
+    ///> The router calls recorded by ROUTER, which can be replayed on the same board
+    enum EVENT_TYPE
+    {
+        EVT_START_ROUTE = 0,
+        EVT_START_DRAG,
+        EVT_MOVE,
+        EVT_FIX,
+        EVT_STOP,
+        EVT_SWITCH_LAYER,
+        EVT_TOGGLE_VIA,
+        EVT_FLIP_POSTURE
+    };
+
+    /**
+     * A recorded router call.  The item passed to the call is identified by its kind, net,
+     * layers and position, since the items of a replayed world are not the same objects.
+     */
+    struct EVENT_ENTRY
+    {
+        EVENT_TYPE m_type = EVT_MOVE;
+        VECTOR2I   m_pos;
+        int        m_arg = 0;           ///< Layer or drag mode of the call
+        int        m_itemKind = 0;      ///< 0 when the call had no item
+        int        m_itemNet = 0;
+        int        m_itemLayerStart = 0;
+        int        m_itemLayerEnd = 0;
+        VECTOR2I   m_itemPos;
+    };
+
     LOGGER();
     ~LOGGER();
 
@@ -53,6 +83,31 @@ public:
     void Log( const VECTOR2I& aStart, const VECTOR2I& aEnd, int aKind = 0,
               const std::string& aName = std::string() );
 
+    /**
+     * Records a router call as an "event" line, see ParseEvents().
+     */
+    void Log( EVENT_TYPE aEvent, const VECTOR2I& aPos, const ITEM* aItem = nullptr,
+              int aArg = 0 );
+
+    /**
+     * Records the settings a routing session was started with as a "config" line: the
+     * router mode, the routing mode, the track width, the via diameter, drill and type,
+     * the differential pair width and gap and the via layer pair.
+     */
+    void LogConfig( const std::vector<int>& aValues );
+
+    /**
+     * Reads the "config" and "event" lines of a log, skipping the other ones.
+     * @return false if an event or config line is malformed.
+     */
+    static bool ParseEvents( std::istream& aStream, std::vector<int>& aConfig,
+                             std::vector<EVENT_ENTRY>& aEvents );
+
+    /**
+     * @return the position an item is identified by in the event lines.
+     */
+    static VECTOR2I ItemPosition( const ITEM* aItem );
+
 private:
     void dumpShape( const SHAPE* aSh );
 
@@ -40,6 +40,7 @@ MEANDER_PLACER::MEANDER_PLACER( ROUTER* aRouter ) :
     m_initialSegment = NULL;
     m_lastLength = 0;
     m_lastStatus = TOO_SHORT;
+    m_pathLength = -1;
 }
 
 
@@ -85,6 +86,8 @@ bool MEANDER_PLACER::Start( const VECTOR2I& aP, ITEM* aStartItem )
     m_currentWidth = m_originLine.Width();
     m_currentEnd = VECTOR2I( 0, 0 );
 
+    resetMeanderCache();
+
     return true;
 }
 
@@ -104,6 +107,24 @@ int MEANDER_PLACER::origPathLength() const
 }
 
 
+void MEANDER_PLACER::resetMeanderCache()
+{
+    m_pathLength = -1;
+    m_meanderedSegs.clear();
+    m_segmentMeanders.clear();
+}
+
+
+static bool sameMeanderShapes( const MEANDER_SETTINGS& aA, const MEANDER_SETTINGS& aB )
+{
+    return aA.m_minAmplitude == aB.m_minAmplitude && aA.m_maxAmplitude == aB.m_maxAmplitude
+           && aA.m_spacing == aB.m_spacing && aA.m_step == aB.m_step
+           && aA.m_cornerStyle == aB.m_cornerStyle
+           && aA.m_cornerRadiusPercentage == aB.m_cornerRadiusPercentage
+           && aA.m_cornerArcSegments == aB.m_cornerArcSegments;
+}
+
+
 bool MEANDER_PLACER::Move( const VECTOR2I& aP, ITEM* aEndItem )
 {
     return doMove( aP, aEndItem, m_settings.m_targetLength );
@@ -121,19 +142,58 @@ bool MEANDER_PLACER::doMove( const VECTOR2I& aP, ITEM* aEndItem, int aTargetLeng
 
     cutTunedLine( m_originLine.CLine(), m_currentStart, aP, pre, tuned, post );
 
+    m_result.Clear();
     m_result = MEANDERED_LINE( this, false );
     m_result.SetWidth( m_originLine.Width() );
     m_result.SetBaselineOffset( 0 );
 
+    // The meanders fitted on a segment only depend on the segments before it, so the ones of
+    // the segments the cursor has moved past are reused and only the segment under the cursor
+    // is meandered again
+    size_t reused = 0;
+
+    if( sameMeanderShapes( m_meanderedSettings, m_settings ) )
+    {
+        while( reused < m_meanderedSegs.size() && (int) reused < tuned.SegmentCount()
+               && m_meanderedSegs[reused] == tuned.CSegment( reused ) )
+        {
+            reused++;
+        }
+    }
+
+    m_meanderedSegs.resize( reused );
+    m_segmentMeanders.resize( reused );
+    m_meanderedSettings = m_settings;
+
     for( int i = 0; i < tuned.SegmentCount(); i++ )
     {
         const SEG s = tuned.CSegment( i );
+
+        if( i < (int) reused )
+        {
+            for( const MEANDER_SHAPE& m : m_segmentMeanders[i] )
+                m_result.AddMeander( new MEANDER_SHAPE( m ) );
+
+            continue;
+        }
+
+        size_t first = m_result.Meanders().size();
+
         m_result.AddCorner( s.A );
         m_result.MeanderSegment( s );
         m_result.AddCorner( s.B );
+
+        m_meanderedSegs.push_back( s );
+        m_segmentMeanders.emplace_back();
+
+        for( size_t j = first; j < m_result.Meanders().size(); j++ )
+            m_segmentMeanders.back().push_back( *m_result.Meanders()[j] );
     }
 
-    int lineLen = origPathLength();
+    if( m_pathLength < 0 )
+        m_pathLength = origPathLength();
+
+    int lineLen = m_pathLength;
 
     m_lastLength = lineLen;
     m_lastStatus = TUNED;
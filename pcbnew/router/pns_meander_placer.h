@@ -96,6 +96,9 @@ protected:
 
     virtual int origPathLength() const;
 
+    ///> Drops the lengths and meanders kept between the moves, when a new line is tuned
+    void resetMeanderCache();
+
     ///> pointer to world to search colliding items
     NODE* m_world;
 
@@ -115,6 +118,18 @@ protected:
 
     int m_lastLength;
     TUNING_STATUS m_lastStatus;
+
+    ///> length of the tuned path, which does not change while tuning (-1 if not known yet)
+    int m_pathLength;
+
+    ///> the segments of the tuned part of the line, as meandered by the last move
+    std::vector<SEG> m_meanderedSegs;
+
+    ///> the shapes fitted on each of these segments, before the line length was tuned
+    std::vector<std::vector<MEANDER_SHAPE>> m_segmentMeanders;
+
+    ///> the settings these shapes were fitted with
+    MEANDER_SETTINGS m_meanderedSettings;
 };
 
 }
@@ -95,6 +95,8 @@ bool MEANDER_SKEW_PLACER::Start( const VECTOR2I& aP, ITEM* aStartItem )
     else
         m_coupledLength = itemsetLength( m_tunedPathP );
 
+    resetMeanderCache();
+
     return true;
 }
 
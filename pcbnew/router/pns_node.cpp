@@ -27,6 +27,8 @@
 #include <geometry/seg.h>
 #include <geometry/shape_line_chain.h>
 
+#include <board_connected_item.h>
+
 #include "pns_item.h"
 #include "pns_line.h"
 #include "pns_node.h"
@@ -454,6 +456,88 @@ NODE::OPT_OBSTACLE NODE::CheckColliding( const ITEM* aItemA, int aKindMask )
 }
 
 
+std::size_t NODE::CLEAR_SEGMENT_HASH::operator()( const CLEAR_SEGMENT& aSeg ) const
+{
+    using std::hash;
+
+    return ( ( hash<int>()( aSeg.m_a.x ) ^ ( hash<int>()( aSeg.m_a.y ) << 1 ) ) >> 1 )
+           ^ ( hash<int>()( aSeg.m_b.x ) << 1 ) ^ ( hash<int>()( aSeg.m_b.y ) << 2 )
+           ^ ( hash<int>()( aSeg.m_width ) << 3 ) ^ ( hash<int>()( aSeg.m_net ) << 4 );
+}
+
+
+void NODE::invalidateClearSegments()
+{
+    // Removing items cannot make a clear segment collide, adding them can.  The root is never
+    // changed while branches are being checked, so there is no need to lock the cache here.
+    if( isRoot() && !m_clearSegments.empty() )
+        m_clearSegments.clear();
+}
+
+
+bool NODE::CheckCollidingCached( const LINE* aLine, int aKindMask )
+{
+    const SHAPE_LINE_CHAIN& l = aLine->CLine();
+
+    for( int i = 0; i < l.SegmentCount(); i++ )
+    {
+        const SEGMENT s( *aLine, l.CSegment( i ) );
+        OBSTACLES     obs;
+
+        // The items of this branch are not cached, check them first
+        if( !isRoot() )
+        {
+            DEFAULT_OBSTACLE_VISITOR visitor( obs, &s, aKindMask, true );
+
+            visitor.SetCountLimit( 1 );
+            visitor.SetWorld( this, NULL );
+            m_index->Query( &s, m_maxClearance, visitor );
+
+            if( !obs.empty() )
+                return true;
+        }
+
+        const CLEAR_SEGMENT key = { s.Seg().A, s.Seg().B, s.Width(), s.Net(),
+                                    s.Layers().Start(), s.Layers().End(), aKindMask };
+
+        {
+            std::lock_guard<std::mutex> lock( m_root->m_clearSegmentsLock );
+
+            if( m_root->m_clearSegments.count( key ) )
+                continue;
+        }
+
+        // Check all the root items, including the ones this branch overrides, so a clear
+        // segment is clear of the root in any branch
+        if( m_root->QueryColliding( &s, obs, aKindMask, 1 ) == 0 )
+        {
+            std::lock_guard<std::mutex> lock( m_root->m_clearSegmentsLock );
+
+            if( m_root->m_clearSegments.size() >= MaxClearSegments )
+                m_root->m_clearSegments.clear();
+
+            m_root->m_clearSegments.insert( key );
+            continue;
+        }
+
+        // The obstacle may have been removed in this branch
+        obs.clear();
+
+        if( isRoot() || QueryColliding( &s, obs, aKindMask, 1 ) > 0 )
+            return true;
+    }
+
+    if( aLine->EndsWithVia() )
+    {
+        OBSTACLES obs;
+
+        return QueryColliding( &aLine->Via(), obs, aKindMask, 1 ) > 0;
+    }
+
+    return false;
+}
+
+
 bool NODE::CheckColliding( const ITEM* aItemA, const ITEM* aItemB, int aKindMask, int aForceClearance )
 {
     assert( aItemB );
@@ -530,6 +614,7 @@ void NODE::addSolid( SOLID* aSolid )
 {
     linkJoint( aSolid->Pos(), aSolid->Layers(), aSolid->Net(), aSolid );
     m_index->Add( aSolid );
+    invalidateClearSegments();
 }
 
 void NODE::Add( std::unique_ptr< SOLID > aSolid )
@@ -542,6 +627,7 @@ void NODE::addVia( VIA* aVia )
 {
     linkJoint( aVia->Pos(), aVia->Layers(), aVia->Net(), aVia );
     m_index->Add( aVia );
+    invalidateClearSegments();
 }
 
 void NODE::Add( std::unique_ptr< VIA > aVia )
@@ -585,6 +671,7 @@ void NODE::addSegment( SEGMENT* aSeg )
     linkJoint( aSeg->Seg().B, aSeg->Layers(), aSeg->Net(), aSeg );
 
     m_index->Add( aSeg );
+    invalidateClearSegments();
 }
 
 bool NODE::Add( std::unique_ptr< SEGMENT > aSegment, bool aAllowRedundant )
@@ -1262,6 +1349,21 @@ void NODE::RemoveByMarker( int aMarker )
         Remove( item );
 }
 
+
+void NODE::RemoveByParent( const std::unordered_set<const BOARD_ITEM*>& aParents )
+{
+    std::list<ITEM*> garbage;
+
+    for( ITEM* item : *m_index )
+    {
+        if( item->Parent() && aParents.count( item->Parent() ) )
+            garbage.push_back( item );
+    }
+
+    for( ITEM* item : garbage )
+        Remove( item );
+}
+
 SEGMENT* NODE::findRedundantSegment( const VECTOR2I& A, const VECTOR2I& B, const LAYER_RANGE& lr,
                                      int aNet )
 {
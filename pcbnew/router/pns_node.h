@@ -24,6 +24,7 @@
 
 #include <vector>
 #include <list>
+#include <mutex>
 #include <unordered_set>
 #include <unordered_map>
 
@@ -36,6 +37,9 @@
 #include "pns_item.h"
 #include "pns_joint.h"
 #include "pns_itemset.h"
+#include "pns_pool.h"
+
+class BOARD_ITEM;
 
 namespace PNS {
 
@@ -147,6 +151,17 @@ public:
     NODE();
     ~NODE();
 
+    ///> Nodes are allocated from the router POOL
+    static void* operator new( size_t aSize )
+    {
+        return POOL::Alloc( aSize );
+    }
+
+    static void operator delete( void* aBlock, size_t aSize )
+    {
+        POOL::Free( aBlock, aSize );
+    }
+
     ///> Returns the expected clearance between items a and b.
     int GetClearance( const ITEM* aA, const ITEM* aB ) const;
 
@@ -160,12 +175,14 @@ public:
     void SetMaxClearance( int aClearance )
     {
         m_maxClearance = aClearance;
+        invalidateClearSegments();
     }
 
     ///> Assigns a clerance resolution function object
     void SetRuleResolver( RULE_RESOLVER* aFunc )
     {
         m_ruleResolver = aFunc;
+        invalidateClearSegments();
     }
 
     RULE_RESOLVER* GetRuleResolver() const
@@ -260,6 +277,20 @@ public:
                          int            aKindMask = ITEM::ANY_T,
                          int            aForceClearance = -1 );
 
+    /**
+     * Function CheckCollidingCached()
+     *
+     * Checks if a line collides with anything else in the world, like CheckColliding().
+     * The segments found clear of the root items are remembered by the root node until its
+     * items or rules change, so the next checks of these segments from any branch only look
+     * at the items of the branch.  Used by the optimizer, which checks the same candidate
+     * segments many times during a routing session.
+     * @param aLine the line to find collisions with
+     * @param aKindMask mask of obstacle types to take into account
+     * @return true if the line collides.
+     */
+    bool CheckCollidingCached( const LINE* aLine, int aKindMask = ITEM::ANY_T );
+
     /**
      * Function HitTest()
      *
@@ -407,6 +438,9 @@ public:
 
     void RemoveByMarker( int aMarker );
 
+    ///> Removes the items built from any of the board items in aParents.
+    void RemoveByParent( const std::unordered_set<const BOARD_ITEM*>& aParents );
+
     ITEM* FindItemByParent( const BOARD_CONNECTED_ITEM* aParent );
 
     bool HasChildren() const
@@ -423,6 +457,34 @@ public:
 
 private:
     struct DEFAULT_OBSTACLE_VISITOR;
+
+    ///> A segment found clear of the root items, with what its collisions depend on
+    struct CLEAR_SEGMENT
+    {
+        VECTOR2I m_a;
+        VECTOR2I m_b;
+        int      m_width;
+        int      m_net;
+        int      m_layerStart;
+        int      m_layerEnd;
+        int      m_kindMask;
+
+        bool operator==( const CLEAR_SEGMENT& aOther ) const
+        {
+            return m_a == aOther.m_a && m_b == aOther.m_b && m_width == aOther.m_width
+                   && m_net == aOther.m_net && m_layerStart == aOther.m_layerStart
+                   && m_layerEnd == aOther.m_layerEnd && m_kindMask == aOther.m_kindMask;
+        }
+    };
+
+    struct CLEAR_SEGMENT_HASH
+    {
+        std::size_t operator()( const CLEAR_SEGMENT& aSeg ) const;
+    };
+
+    ///> The cache of the clear segments is dropped when it grows past this size
+    static const size_t MaxClearSegments = 65536;
+
     typedef std::unordered_multimap<JOINT::HASH_TAG, JOINT, JOINT::JOINT_TAG_HASH> JOINT_MAP;
     typedef JOINT_MAP::value_type TagJointPair;
 
@@ -453,6 +515,7 @@ private:
 
     void doRemove( ITEM* aItem );
     void unlinkParent();
+    void invalidateClearSegments();
     void releaseChildren();
     void releaseGarbage();
 
@@ -504,6 +567,10 @@ private:
     int m_depth;
 
     std::unordered_set<ITEM*> m_garbageItems;
+
+    ///> segments clear of the items of the root node, see CheckCollidingCached()
+    std::unordered_set<CLEAR_SEGMENT, CLEAR_SEGMENT_HASH> m_clearSegments;
+    std::mutex m_clearSegmentsLock;
 };
 
 }
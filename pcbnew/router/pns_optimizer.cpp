@@ -384,11 +384,16 @@ bool LINE_RESTRICTIONS::Check( int aVertex1, int aVertex2, const SHAPE_LINE_CHAI
 
 bool OPTIMIZER::checkColliding( ITEM* aItem, bool aUpdateCache )
 {
-    CACHE_VISITOR v( aItem, m_world, m_collisionKindMask );
+    // The candidate rewrites are lines, whose segments are checked many times over the
+    // iterations of the optimizer and the moves of the routing session
+    if( aItem->Kind() == ITEM::LINE_T )
+        return m_world->CheckCollidingCached( static_cast<LINE*>( aItem ) );
 
     return static_cast<bool>( m_world->CheckColliding( aItem ) );
 
 #if 0
+    CACHE_VISITOR v( aItem, m_world, m_collisionKindMask );
+
     // something is wrong with the cache, need to investigate.
     m_cache.Query( aItem->Shape(), m_world->GetMaxClearance(), v, false );
 
@@ -0,0 +1,78 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <new>
+
+#include "pns_pool.h"
+
+namespace PNS {
+
+thread_local POOL::FREE_BLOCK* POOL::m_freeLists[POOL::MAX_SIZE / POOL::GRANULARITY] = {};
+
+
+void* POOL::Alloc( size_t aSize )
+{
+    if( aSize == 0 || aSize > MAX_SIZE )
+        return ::operator new( aSize );
+
+    size_t sizeClass = ( aSize - 1 ) / GRANULARITY;
+    FREE_BLOCK* block = m_freeLists[sizeClass];
+
+    if( !block )
+        return ::operator new( ( sizeClass + 1 ) * GRANULARITY );
+
+    m_freeLists[sizeClass] = block->m_next;
+
+    return block;
+}
+
+
+void POOL::Free( void* aBlock, size_t aSize )
+{
+    if( !aBlock )
+        return;
+
+    if( aSize == 0 || aSize > MAX_SIZE )
+    {
+        ::operator delete( aBlock );
+        return;
+    }
+
+    size_t sizeClass = ( aSize - 1 ) / GRANULARITY;
+    FREE_BLOCK* block = static_cast<FREE_BLOCK*>( aBlock );
+
+    block->m_next = m_freeLists[sizeClass];
+    m_freeLists[sizeClass] = block;
+}
+
+
+void POOL::Trim()
+{
+    for( FREE_BLOCK*& list : m_freeLists )
+    {
+        while( list )
+        {
+            FREE_BLOCK* next = list->m_next;
+            ::operator delete( list );
+            list = next;
+        }
+    }
+}
+
+}
@@ -0,0 +1,76 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PNS_POOL_H
+#define __PNS_POOL_H
+
+#include <cstddef>
+
+namespace PNS {
+
+/**
+ * Class POOL
+ *
+ * Recycles the memory of the objects the router creates and destroys at a high rate while
+ * routing: the branched nodes, their indices and the cloned items.  Freed blocks are kept
+ * in a free list per size class and handed out again by the next allocations, so shoving
+ * does not go to the heap for each branch and clone.
+ *
+ * Each thread has its own free lists, as parts of the routing algorithms run on the worker
+ * threads: a block may be freed by another thread than the one which allocated it.
+ */
+class POOL
+{
+public:
+    /**
+     * Function Alloc()
+     * Returns a block of at least aSize bytes, taken from the free lists if possible.
+     */
+    static void* Alloc( size_t aSize );
+
+    /**
+     * Function Free()
+     * Gives back a block returned by Alloc( aSize ), to be reused by the next allocations.
+     */
+    static void Free( void* aBlock, size_t aSize );
+
+    /**
+     * Function Trim()
+     * Returns all the free blocks of the calling thread to the heap.
+     */
+    static void Trim();
+
+private:
+    ///> Sizes are rounded up to multiples of GRANULARITY bytes
+    static const size_t GRANULARITY = 16;
+
+    ///> Larger blocks are not recycled
+    static const size_t MAX_SIZE = 1024;
+
+    struct FREE_BLOCK
+    {
+        FREE_BLOCK* m_next;
+    };
+
+    static thread_local FREE_BLOCK* m_freeLists[MAX_SIZE / GRANULARITY];
+};
+
+}
+
+#endif    // __PNS_POOL_H
@@ -97,6 +97,23 @@ void ROUTER::SyncWorld()
 
 }
 
+
+void ROUTER::UpdateWorld()
+{
+    if( !m_world )
+    {
+        SyncWorld();
+        return;
+    }
+
+    m_world->KillChildren();
+    m_placer.reset();
+
+    if( !m_iface->UpdateWorld( m_world.get() ) )
+        SyncWorld();
+}
+
+
 void ROUTER::ClearWorld()
 {
     if( m_world )
@@ -106,6 +123,9 @@ void ROUTER::ClearWorld()
     }
 
     m_placer.reset();
+
+    // The recycled branches and clones are not needed until the next routing session
+    POOL::Trim();
 }
 
 
@@ -127,6 +147,10 @@ const ITEM_SET ROUTER::QueryHoverItems( const VECTOR2I& aP )
 bool ROUTER::StartDragging( const VECTOR2I& aP, ITEM* aStartItem, int aDragMode )
 {
 
+    m_eventLogger.Clear();
+    logConfig();
+    m_eventLogger.Log( LOGGER::EVT_START_DRAG, aP, aStartItem, aDragMode );
+
     if( aDragMode & DM_FREE_ANGLE )
         m_forceMarkObstaclesMode = true;
     else
@@ -175,6 +199,9 @@ bool ROUTER::isStartingPointRoutable( const VECTOR2I& aWhere, int aLayer )
 
 bool ROUTER::StartRouting( const VECTOR2I& aP, ITEM* aStartItem, int aLayer )
 {
+    m_eventLogger.Clear();
+    logConfig();
+    m_eventLogger.Log( LOGGER::EVT_START_ROUTE, aP, aStartItem, aLayer );
 
     if( ! isStartingPointRoutable( aP, aLayer ) )
     {
@@ -232,6 +259,9 @@ void ROUTER::Move( const VECTOR2I& aP, ITEM* endItem )
 {
     m_currentEnd = aP;
 
+    if( m_state != IDLE )
+        m_eventLogger.Log( LOGGER::EVT_MOVE, aP, endItem );
+
     switch( m_state )
     {
     case ROUTE_TRACK:
@@ -375,6 +405,9 @@ bool ROUTER::FixRoute( const VECTOR2I& aP, ITEM* aEndItem, bool aForceFinish )
 {
     bool rv = false;
 
+    if( m_state != IDLE )
+        m_eventLogger.Log( LOGGER::EVT_FIX, aP, aEndItem, aForceFinish ? 1 : 0 );
+
     switch( m_state )
     {
     case ROUTE_TRACK:
@@ -413,6 +446,8 @@ void ROUTER::StopRouting()
     if( !RoutingInProgress() )
         return;
 
+    m_eventLogger.Log( LOGGER::EVT_STOP, m_currentEnd );
+
     m_placer.reset();
     m_dragger.reset();
 
@@ -428,6 +463,7 @@ void ROUTER::FlipPosture()
 {
     if( m_state == ROUTE_TRACK )
     {
+        m_eventLogger.Log( LOGGER::EVT_FLIP_POSTURE, m_currentEnd );
         m_placer->FlipPosture();
     }
 }
@@ -438,6 +474,7 @@ void ROUTER::SwitchLayer( int aLayer )
     switch( m_state )
     {
     case ROUTE_TRACK:
+        m_eventLogger.Log( LOGGER::EVT_SWITCH_LAYER, m_currentEnd, nullptr, aLayer );
         m_placer->SetLayer( aLayer );
         break;
     default:
@@ -451,6 +488,7 @@ void ROUTER::ToggleViaPlacement()
     if( m_state == ROUTE_TRACK )
     {
         bool toggle = !m_placer->IsPlacingVia();
+        m_eventLogger.Log( LOGGER::EVT_TOGGLE_VIA, m_currentEnd, nullptr, toggle ? 1 : 0 );
         m_placer->ToggleVia( toggle );
     }
 }
@@ -493,6 +531,17 @@ void ROUTER::DumpLog()
 
     if( logger )
         logger->Save( "/tmp/shove.log" );
+
+    m_eventLogger.Save( "/tmp/pns_events.log" );
+}
+
+
+void ROUTER::logConfig()
+{
+    m_eventLogger.LogConfig( { m_mode, m_settings.Mode(), m_sizes.TrackWidth(),
+                               m_sizes.ViaDiameter(), m_sizes.ViaDrill(), m_sizes.ViaType(),
+                               m_sizes.DiffPairWidth(), m_sizes.DiffPairGap(),
+                               m_sizes.GetLayerTop(), m_sizes.GetLayerBottom() } );
 }
 
 
@@ -34,6 +34,7 @@
 #include "pns_sizes_settings.h"
 #include "pns_item.h"
 #include "pns_itemset.h"
+#include "pns_logger.h"
 #include "pns_node.h"
 
 namespace KIGFX
@@ -91,6 +92,7 @@ enum DRAG_MODE
 
         virtual void SetRouter( ROUTER* aRouter ) = 0;
         virtual void SyncWorld( NODE* aNode ) = 0;
+        virtual bool UpdateWorld( NODE* aNode ) = 0;
         virtual void AddItem( ITEM* aItem ) = 0;
         virtual void RemoveItem( ITEM* aItem ) = 0;
         virtual void DisplayItem( const ITEM* aItem, int aColor = -1, int aClearance = -1, bool aEdit = false ) = 0;
@@ -128,6 +130,12 @@ public:
     void ClearWorld();
     void SyncWorld();
 
+    /**
+     * Brings the world up to date with the board changes made since the last synchronization,
+     * falling back to SyncWorld() when the interface cannot update it in place.
+     */
+    void UpdateWorld();
+
     void SetView( KIGFX::VIEW* aView );
 
     bool RoutingInProgress() const;
@@ -160,6 +168,12 @@ public:
 
     void DumpLog();
 
+    /**
+     * @return the calls of the current or last routing session, which the router replay
+     * tool of the QA utilities can run again on the board the session was started on.
+     */
+    LOGGER* EventLogger() { return &m_eventLogger; }
+
     RULE_RESOLVER* GetRuleResolver() const
     {
         return m_iface->GetRuleResolver();
@@ -244,6 +258,8 @@ private:
 
     void highlightCurrent( bool enabled );
 
+    void logConfig();
+
     void markViolations( NODE* aNode, ITEM_SET& aCurrent, NODE::ITEM_VECTOR& aRemoved );
     bool isStartingPointRoutable( const VECTOR2I& aWhere, int aLayer );
 
@@ -271,6 +287,8 @@ private:
 
     wxString m_toolStatusbarName;
     wxString m_failureReason;
+
+    LOGGER m_eventLogger;
 };
 
 }
@@ -83,6 +83,7 @@ public:
     void SetWidth( int aWidth )
     {
         m_seg.SetWidth(aWidth);
+        invalidateHull();
     }
 
     int Width() const
@@ -103,16 +104,16 @@ public:
     void SetEnds( const VECTOR2I& a, const VECTOR2I& b )
     {
         m_seg.SetSeg( SEG ( a, b ) );
+        invalidateHull();
     }
 
     void SwapEnds()
     {
         SEG tmp = m_seg.GetSeg();
         m_seg.SetSeg( SEG (tmp.B , tmp.A ) );
+        invalidateHull();
     }
 
-    const SHAPE_LINE_CHAIN Hull( int aClearance, int aWalkaroundThickness ) const override;
-
     virtual VECTOR2I Anchor( int n ) const override
     {
         if( n == 0 )
@@ -126,6 +127,9 @@ public:
         return 2;
     }
 
+protected:
+    const SHAPE_LINE_CHAIN buildHull( int aClearance, int aWalkaroundThickness ) const override;
+
 private:
     SHAPE_SEGMENT m_seg;
 };
@@ -61,14 +61,13 @@ public:
 
     const SHAPE* Shape() const override { return m_shape; }
 
-    const SHAPE_LINE_CHAIN Hull( int aClearance = 0, int aWalkaroundThickness = 0 ) const override;
-
     void SetShape( SHAPE* shape )
     {
         if( m_shape )
             delete m_shape;
 
         m_shape = shape;
+        invalidateHull();
     }
 
     const VECTOR2I& Pos() const
@@ -101,6 +100,9 @@ public:
         m_offset = aOffset;
     }
 
+protected:
+    const SHAPE_LINE_CHAIN buildHull( int aClearance, int aWalkaroundThickness ) const override;
+
 private:
     VECTOR2I    m_pos;
     SHAPE*      m_shape;
@@ -39,6 +39,7 @@ using namespace std::placeholders;
 #include <dialogs/dialog_track_via_size.h>
 #include <base_units.h>
 #include <bitmaps.h>
+#include <advanced_config.h>
 
 #include <tool/action_menu.h>
 #include <tools/pcb_actions.h>
@@ -88,6 +89,36 @@ TOOL_BASE::~TOOL_BASE()
 
 void TOOL_BASE::Reset( RESET_REASON aReason )
 {
+    if( aReason == MODEL_RELOAD )
+    {
+        // The kept world refers to the items of the previous board
+        delete m_gridHelper;
+        delete m_iface;
+        delete m_router;
+
+        m_gridHelper = nullptr;
+        m_iface = nullptr;
+        m_router = nullptr;
+        return;
+    }
+
+    if( aReason != RUN )
+        return;
+
+    // Only the board editor commits report their changes to the router
+    bool incrementalSync = ADVANCED_CFG::GetCfg().m_incrementalRouterSync
+                                && frame()->IsType( FRAME_PCB );
+
+    if( m_router && incrementalSync )
+    {
+        m_iface->SetDisplayOptions( (PCB_DISPLAY_OPTIONS*) frame()->GetDisplayOptions() );
+
+        m_router->UpdateWorld();
+        m_router->LoadSettings( m_savedSettings );
+        m_router->UpdateSizes( m_savedSizes );
+        return;
+    }
+
     delete m_gridHelper;
     delete m_iface;
     delete m_router;
@@ -97,6 +128,7 @@ void TOOL_BASE::Reset( RESET_REASON aReason )
     m_iface->SetView( getView() );
     m_iface->SetHostTool( this );
     m_iface->SetDisplayOptions( (PCB_DISPLAY_OPTIONS*) frame()->GetDisplayOptions() );
+    m_iface->SetIncrementalSync( incrementalSync );
 
     m_router = new ROUTER;
     m_router->SetInterface( m_iface );
@@ -375,6 +407,14 @@ ROUTER *TOOL_BASE::Router() const
 }
 
 
+void TOOL_BASE::MarkItemDirty( BOARD_ITEM* aItem )
+{
+    // There is no world to update before the first routing session
+    if( m_iface )
+        m_iface->MarkItemDirty( aItem );
+}
+
+
 const VECTOR2I TOOL_BASE::snapToItem( bool aEnabled, ITEM* aItem, VECTOR2I aP)
 {
     VECTOR2I anchor;
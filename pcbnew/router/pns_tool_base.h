@@ -51,6 +51,12 @@ public:
 
     ROUTER* Router() const;
 
+    /**
+     * Notifies the router that a board item was added, changed or removed by a commit, so the
+     * world kept from the previous routing session is updated instead of rebuilt.
+     */
+    void MarkItemDirty( BOARD_ITEM* aItem );
+
 protected:
     bool checkSnap( ITEM* aItem );
     const VECTOR2I snapToItem( bool aEnabled, ITEM* aItem, VECTOR2I aP);
@@ -71,7 +71,7 @@ bool VIA::PushoutForce( NODE* aNode, const VECTOR2I& aDirection, VECTOR2I& aForc
 }
 
 
-const SHAPE_LINE_CHAIN VIA::Hull( int aClearance, int aWalkaroundThickness ) const
+const SHAPE_LINE_CHAIN VIA::buildHull( int aClearance, int aWalkaroundThickness ) const
 {
     int cl = ( aClearance + aWalkaroundThickness / 2 );
 
@@ -91,6 +91,7 @@ VIA* VIA::Clone() const
     v->m_diameter = m_diameter;
     v->m_drill = m_drill;
     v->m_shape = SHAPE_CIRCLE( m_pos, m_diameter / 2 );
+    v->m_hullCache = m_hullCache;
     v->m_rank = m_rank;
     v->m_marker = m_marker;
     v->m_viaType = m_viaType;
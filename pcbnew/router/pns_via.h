@@ -94,6 +94,7 @@ public:
     {
         m_pos = aPos;
         m_shape.SetCenter( aPos );
+        invalidateHull();
     }
 
     VIATYPE_T ViaType() const
@@ -115,6 +116,7 @@ public:
     {
         m_diameter = aDiameter;
         m_shape.SetRadius( m_diameter / 2 );
+        invalidateHull();
     }
 
     int Drill() const
@@ -140,8 +142,6 @@ public:
 
     VIA* Clone() const override;
 
-    const SHAPE_LINE_CHAIN Hull( int aClearance = 0, int aWalkaroundThickness = 0 ) const override;
-
     virtual VECTOR2I Anchor( int n ) const override
     {
         return m_pos;
@@ -154,6 +154,9 @@ public:
 
     OPT_BOX2I ChangedArea( const VIA* aOther ) const;
 
+protected:
+    const SHAPE_LINE_CHAIN buildHull( int aClearance, int aWalkaroundThickness ) const override;
+
 private:
     int m_diameter;
     int m_drill;
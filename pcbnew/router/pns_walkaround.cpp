@@ -19,10 +19,15 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <climits>
+
 #include <core/optional.h>
 
 #include <geometry/shape_line_chain.h>
 
+#include <advanced_config.h>
+#include <thread_pool.h>
+
 #include "pns_walkaround.h"
 #include "pns_optimizer.h"
 #include "pns_utils.h"
@@ -58,6 +63,8 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::singleStep( LINE& aPath,
         aWindingDirection ? m_currentObstacle[0] : m_currentObstacle[1];
 
     bool& prev_recursive = aWindingDirection ? m_recursiveCollision[0] : m_recursiveCollision[1];
+    int& recursive_blockages =
+        aWindingDirection ? m_recursiveBlockageCount[0] : m_recursiveBlockageCount[1];
 
     if( !current_obs )
         return DONE;
@@ -68,9 +75,9 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::singleStep( LINE& aPath,
 
     if( ( current_obs->m_hull ).PointInside( last ) || ( current_obs->m_hull ).PointOnEdge( last ) )
     {
-        m_recursiveBlockageCount++;
+        recursive_blockages++;
 
-        if( m_recursiveBlockageCount < 3 )
+        if( recursive_blockages < 3 )
             aPath.Line().Append( current_obs->m_hull.NearestPoint( last ) );
         else
         {
@@ -144,6 +151,36 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::singleStep( LINE& aPath,
 }
 
 
+bool WALKAROUND::walkStep( LINE& aPath, bool aWindingDirection, int aIteration,
+                           WALKAROUND_STATUS& aStatus, int& aLastIteration )
+{
+    // The other direction was done first: this one is not needed past that iteration
+    if( aIteration > m_stopIteration.load( std::memory_order_relaxed ) )
+        return false;
+
+#ifdef DEBUG
+    m_iteration = aIteration;   // numbers the logged groups
+#endif
+
+    aStatus = singleStep( aPath, aWindingDirection );
+
+    if( aStatus == IN_PROGRESS )
+        return true;
+
+    aLastIteration = aIteration;
+
+    if( aStatus == DONE && !m_forceLongerPath )
+    {
+        int stop = m_stopIteration.load( std::memory_order_relaxed );
+
+        while( aIteration < stop && !m_stopIteration.compare_exchange_weak( stop, aIteration ) )
+            ;
+    }
+
+    return false;
+}
+
+
 WALKAROUND::WALKAROUND_STATUS WALKAROUND::Route( const LINE& aInitialPath,
         LINE& aWalkPath, bool aOptimize )
 {
@@ -164,7 +201,8 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::Route( const LINE& aInitialPath,
     start( aInitialPath );
 
     m_currentObstacle[0] = m_currentObstacle[1] = nearestObstacle( aInitialPath );
-    m_recursiveBlockageCount = 0;
+    m_recursiveBlockageCount[0] = m_recursiveBlockageCount[1] = 0;
+    m_stopIteration = m_iterationLimit;
 
     aWalkPath = aInitialPath;
 
@@ -177,13 +215,62 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::Route( const LINE& aInitialPath,
         m_forceSingleDirection = false;
     }
 
-    while( m_iteration < m_iterationLimit )
+    // The two directions only read the world, so they are walked independently, at the same
+    // time when both are needed.  The first iteration at which the result is known is then
+    // found from the iteration each walk ended at, so the chosen path does not depend on
+    // which thread was faster.
+    WALKAROUND_STATUS status[2] = { s_cw, s_ccw };
+    int lastIteration[2];
+    bool active[2];
+
+    for( int dir = 0; dir < 2; dir++ )
+    {
+        active[dir] = status[dir] != STUCK;
+        lastIteration[dir] = active[dir] ? INT_MAX : 0;
+    }
+
+    auto stepDirection = [&]( size_t aDir, int aIteration )
     {
-        if( s_cw != STUCK )
-            s_cw = singleStep( path_cw, true );
+        LINE& path = aDir == 0 ? path_cw : path_ccw;
+        active[aDir] = walkStep( path, aDir == 0, aIteration, status[aDir], lastIteration[aDir] );
+    };
 
-        if( s_ccw != STUCK )
-            s_ccw = singleStep( path_ccw, false );
+#ifdef DEBUG
+    bool parallel = false;      // the logger is not thread safe
+#else
+    bool parallel = ADVANCED_CFG::GetCfg().m_parallelWalkaround && active[0] && active[1];
+#endif
+
+    if( parallel )
+    {
+        THREAD_POOL::GetPool().ParallelFor( 2,
+                [&]( size_t aDir )
+                {
+                    for( int i = 0; active[aDir] && i < m_iterationLimit; i++ )
+                        stepDirection( aDir, i );
+                }, 1 );
+    }
+    else
+    {
+        for( int i = 0; ( active[0] || active[1] ) && i < m_iterationLimit; i++ )
+        {
+            for( size_t dir = 0; dir < 2; dir++ )
+            {
+                if( active[dir] )
+                    stepDirection( dir, i );
+            }
+        }
+    }
+
+    auto statusAt = [&]( int aDir, int aIteration )
+    {
+        return aIteration >= lastIteration[aDir] ? status[aDir] : IN_PROGRESS;
+    };
+
+    for( m_iteration = 0; m_iteration < m_iterationLimit; m_iteration++ )
+    {
+        s_cw = statusAt( 0, m_iteration );
+        s_ccw = statusAt( 1, m_iteration );
 
         if( ( s_cw == DONE && s_ccw == DONE ) || ( s_cw == STUCK && s_ccw == STUCK ) )
         {
@@ -207,8 +294,6 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::Route( const LINE& aInitialPath,
             aWalkPath = path_ccw;
             break;
         }
-
-        m_iteration++;
     }
 
     if( m_iteration == m_iterationLimit )
@@ -23,6 +23,7 @@
 #define __PNS_WALKAROUND_H
 
 #include <set>
+#include <atomic>
 
 #include "pns_line.h"
 #include "pns_node.h"
@@ -49,7 +50,7 @@ public:
         m_itemMask = ITEM::ANY_T;
 
         // Initialize other members, to avoid uninitialized variables.
-        m_recursiveBlockageCount = 0;
+        m_recursiveBlockageCount[0] = m_recursiveBlockageCount[1] = 0;
         m_recursiveCollision[0] = m_recursiveCollision[1] = false;
         m_iteration = 0;
         m_forceCw = false;
@@ -130,12 +131,22 @@ private:
     void start( const LINE& aInitialPath );
 
     WALKAROUND_STATUS singleStep( LINE& aPath, bool aWindingDirection );
+
+    /**
+     * Steps aPath once around the obstacles in one winding direction, unless the other
+     * direction was done at an earlier iteration.
+     * @param aLastIteration is set to aIteration when the walk ends with aStatus DONE or STUCK
+     * @return true if the walk goes on
+     */
+    bool walkStep( LINE& aPath, bool aWindingDirection, int aIteration,
+                   WALKAROUND_STATUS& aStatus, int& aLastIteration );
     NODE::OPT_OBSTACLE nearestObstacle( const LINE& aPath );
 
     NODE* m_world;
 
-    int m_recursiveBlockageCount;
+    int m_recursiveBlockageCount[2];
     int m_iteration;
+    std::atomic<int> m_stopIteration;   ///< First iteration at which a direction was done
     int m_iterationLimit;
     int m_itemMask;
     bool m_forceSingleDirection, m_forceLongerPath;
@@ -37,6 +37,7 @@
 #include <pcbnew.h>
 
 #include <memory>
+#include <unordered_map>
 
 // all outside the DSN namespace:
 class BOARD;
@@ -2147,6 +2148,20 @@ public:
      */
     static int Compare( PADSTACK* lhs, PADSTACK* rhs );
 
+    /**
+     * Function GetKey
+     * returns a string which is the same for two padstacks only if Compare() finds
+     * them equal, to index them in hash tables.
+     */
+    std::string GetKey()
+    {
+        if( !hash.size() )
+            hash = makeHash();
+
+        // the hash is printable text, it cannot contain the separator
+        return hash + '\0' + padstack_id;
+    }
+
 
     void SetPadstackId( const char* aPadstackId )
     {
@@ -2238,12 +2253,44 @@ class LIBRARY : public ELEM
     PADSTACKS       padstacks;      ///< all except vias, which are in 'vias'
     PADSTACKS       vias;
 
+    /*  The indexes of the images and vias by their hash, so that FindIMAGE() and FindVia()
+        do not compare the new one with all the others.  The images and vias are indexed
+        lazily, because the parser fills them after appending them.
+    */
+    std::unordered_map<std::string, int>    imageIndex;     ///< first image by hash
+    std::unordered_map<std::string, int>    imageIdCount;   ///< no. images by image_id
+    unsigned                                indexedImages;
+    std::unordered_map<std::string, int>    viaIndex;       ///< first via by key
+    unsigned                                indexedVias;
+
+    void indexImages()
+    {
+        for( ; indexedImages < images.size(); ++indexedImages )
+        {
+            IMAGE* image = &images[indexedImages];
+
+            if( !image->hash.size() )
+                image->hash = image->makeHash();
+
+            imageIndex.emplace( image->hash, (int) indexedImages );
+            ++imageIdCount[ image->image_id ];
+        }
+    }
+
+    void indexVias()
+    {
+        for( ; indexedVias < vias.size(); ++indexedVias )
+            viaIndex.emplace( vias[indexedVias].GetKey(), (int) indexedVias );
+    }
+
 public:
 
     LIBRARY( ELEM* aParent, DSN_T aType = T_library ) :
         ELEM( aType, aParent )
     {
         unit = 0;
+        indexedImages = 0;
+        indexedVias = 0;
 //        via_start_index = -1;       // 0 or greater means there is at least one via
     }
     ~LIBRARY()
@@ -2276,21 +2323,22 @@ public:
      */
     int FindIMAGE( IMAGE* aImage )
     {
-        unsigned i;
-        for( i=0;  i<images.size();  ++i )
-        {
-            if( 0 == IMAGE::Compare( aImage, &images[i] ) )
-                return (int) i;
-        }
+        indexImages();
+
+        if( !aImage->hash.size() )
+            aImage->hash = aImage->makeHash();
+
+        auto found = imageIndex.find( aImage->hash );
+
+        if( found != imageIndex.end() )
+            return found->second;
 
         // There is no match to the IMAGE contents, but now generate a unique
         // name for it.
-        int dups = 1;
-        for( i=0;  i<images.size();  ++i )
-        {
-            if( 0 == aImage->image_id.compare( images[i].image_id ) )
-                aImage->duplicated = dups++;
-        }
+        auto dups = imageIdCount.find( aImage->image_id );
+
+        if( dups != imageIdCount.end() )
+            aImage->duplicated = dups->second;
 
         return -1;
     }
@@ -2332,11 +2380,13 @@ public:
      */
     int FindVia( PADSTACK* aVia )
     {
-        for( unsigned i=0;  i<vias.size();  ++i )
-        {
-            if( 0 == PADSTACK::Compare( aVia, &vias[i] ) )
-                return int( i );
-        }
+        indexVias();
+
+        auto found = viaIndex.find( aVia->GetKey() );
+
+        if( found != viaIndex.end() )
+            return found->second;
+
         return -1;
     }
 
@@ -3637,6 +3687,9 @@ class SPECCTRA_DB : public SPECCTRA_LEXER
 
     PADSTACKSET     padstackset;
 
+    /// the padstacks of padstackset by PADSTACK::GetKey(), memory is not owned here
+    std::unordered_map<std::string, PADSTACK*>  padstackIndex;
+
     /// we don't want ownership here permanently, so we don't use boost::ptr_vector
     std::vector<NET*>   nets;
 
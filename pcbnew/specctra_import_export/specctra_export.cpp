@@ -39,6 +39,7 @@
 
 #include <set>                  // std::set
 #include <map>                  // std::map
+#include <unordered_map>        // std::unordered_map
 
 #include <boost/utility.hpp>    // boost::addressof()
 
@@ -217,6 +218,96 @@ static bool isRoundKeepout( D_PAD* aPad )
 }
 
 
+/**
+ * Function makeImageKey
+ * returns a string holding everything makeIMAGE() reads from the module, but the
+ * pad nets.  Two modules with the same key make the same IMAGE, so it is built once.
+ */
+static std::string makeImageKey( MODULE* aModule )
+{
+    char        buf[256];
+    std::string key = aModule->GetFPID().Format().c_str();
+
+    for( auto pad : aModule->Pads() )
+    {
+        snprintf( buf, sizeof( buf ), "\n%d %d %d %d %d %d %d %d %d %d %d %.17g %d %.17g %d ",
+                  pad->GetShape(), pad->GetSize().x, pad->GetSize().y,
+                  pad->GetDelta().x, pad->GetDelta().y,
+                  pad->GetOffset().x, pad->GetOffset().y,
+                  pad->GetDrillSize().x, pad->GetDrillSize().y,
+                  pad->GetPos0().x, pad->GetPos0().y,
+                  pad->GetOrientation() - aModule->GetOrientation(),
+                  pad->GetRoundRectCornerRadius(), pad->GetChamferRectRatio(),
+                  pad->GetChamferPositions() );
+        key += buf;
+        key += pad->GetLayerSet().FmtHex();
+        key += ' ';
+        key += TO_UTF8( pad->GetName() );
+
+        if( pad->GetShape() == PAD_SHAPE_CUSTOM )
+        {
+            // the padstack name holds the bounding box of the pad, which depends on
+            // its orientation on the board
+            snprintf( buf, sizeof( buf ), "\n%.17g", pad->GetOrientation() );
+            key += buf;
+
+            const SHAPE_POLY_SET& polygon = pad->GetCustomShapeAsPolygon();
+
+            for( int ii = 0; polygon.OutlineCount() && ii < polygon.COutline( 0 ).PointCount();
+                 ++ii )
+            {
+                const VECTOR2I& corner = polygon.COutline( 0 ).CPoint( ii );
+
+                snprintf( buf, sizeof( buf ), " %d %d", corner.x, corner.y );
+                key += buf;
+            }
+        }
+    }
+
+    for( auto item : aModule->GraphicalItems() )
+    {
+        EDGE_MODULE* graphic = dyn_cast<EDGE_MODULE*>( item );
+
+        if( !graphic )
+            continue;
+
+        snprintf( buf, sizeof( buf ), "\n%d %d %d %d %d %d %.17g",
+                  graphic->GetShape(), graphic->GetWidth(),
+                  graphic->GetStart0().x, graphic->GetStart0().y,
+                  graphic->GetEnd0().x, graphic->GetEnd0().y,
+                  GetLineLength( graphic->GetStart(), graphic->GetEnd() ) );
+        key += buf;
+    }
+
+    return key;
+}
+
+
+/**
+ * Function getPinNetCodes
+ * returns the net codes of the pins of the IMAGE made by makeIMAGE() for
+ * the module, in the same order.
+ */
+static void getPinNetCodes( MODULE* aModule, std::vector<int>& aNetCodes )
+{
+    static const KICAD_T scanPADs[] = { PCB_PAD_T, EOT };
+    PCB_TYPE_COLLECTOR   moduleItems;
+
+    moduleItems.Collect( aModule, scanPADs );
+    aNetCodes.clear();
+
+    for( int p = 0; p < moduleItems.GetCount(); ++p )
+    {
+        D_PAD* pad = (D_PAD*) moduleItems[p];
+
+        if( isRoundKeepout( pad ) || !( pad->GetLayerSet() & LSET::AllCuMask() ).any() )
+            continue;
+
+        aNetCodes.push_back( pad->GetNetCode() );
+    }
+}
+
+
 /**
  * Function makePath
  * creates a PATH element with a single straight line, a pair of vertices.
@@ -646,18 +737,19 @@ IMAGE* SPECCTRA_DB::makeIMAGE( BOARD* aBoard, MODULE* aModule )
             if( !mask_copper_layers.any() )
                 continue;
 
-            PADSTACK*               padstack = makePADSTACK( aBoard, pad );
-            PADSTACKSET::iterator   iter = padstackset.find( *padstack );
+            PADSTACK*   padstack = makePADSTACK( aBoard, pad );
+            auto        iter = padstackIndex.find( padstack->GetKey() );
 
-            if( iter != padstackset.end() )
+            if( iter != padstackIndex.end() )
             {
                 // padstack is a duplicate, delete it and use the original
                 delete padstack;
-                padstack = (PADSTACK*) *iter.base();    // folklore, be careful here
+                padstack = iter->second;
             }
             else
             {
                 padstackset.insert( padstack );
+                padstackIndex.emplace( padstack->GetKey(), padstack );
             }
 
             PIN* pin = new PIN( image );
@@ -1334,12 +1426,26 @@ void SPECCTRA_DB::FromBOARD( BOARD* aBoard )
         items.Collect( aBoard, scanMODULEs );
 
         padstackset.clear();
+        padstackIndex.clear();
+
+        // the registered IMAGE of the modules already seen, by makeImageKey()
+        std::unordered_map<std::string, IMAGE*> imageCache;
+        std::vector<int>                        pinNetCodes;
 
         for( int m = 0; m<items.GetCount(); ++m )
         {
-            MODULE* module = (MODULE*) items[m];
+            MODULE*     module = (MODULE*) items[m];
+            std::string imageKey = makeImageKey( module );
+            auto        cached = imageCache.find( imageKey );
+            IMAGE*      image;
 
-            IMAGE*  image = makeIMAGE( aBoard, module );
+            if( cached != imageCache.end() )
+                image = cached->second;
+            else
+                image = makeIMAGE( aBoard, module );
+
+            getPinNetCodes( module, pinNetCodes );
+            wxASSERT( pinNetCodes.size() == image->pins.size() );
 
             componentId = TO_UTF8( module->GetReference() );
 
@@ -1355,7 +1461,7 @@ void SPECCTRA_DB::FromBOARD( BOARD* aBoard )
             {
                 PIN*    pin = &image->pins[p];
 
-                int     netcode = pin->kiNetCode;
+                int     netcode = pinNetCodes[p];
 
                 if( netcode > 0 )
                 {
@@ -1371,14 +1477,19 @@ void SPECCTRA_DB::FromBOARD( BOARD* aBoard )
             }
 
 
-            IMAGE* registered = pcb->library->LookupIMAGE( image );
-
-            if( registered != image )
+            if( cached == imageCache.end() )
             {
-                // If our new 'image' is not a unique IMAGE, delete it.
-                // and use the registered one, known as 'image' after this.
-                delete image;
-                image = registered;
+                IMAGE* registered = pcb->library->LookupIMAGE( image );
+
+                if( registered != image )
+                {
+                    // If our new 'image' is not a unique IMAGE, delete it.
+                    // and use the registered one, known as 'image' after this.
+                    delete image;
+                    image = registered;
+                }
+
+                imageCache.emplace( std::move( imageKey ), image );
             }
 
             COMPONENT*  comp = pcb->placement->LookupCOMPONENT( image->GetImageId() );
@@ -1414,6 +1525,8 @@ void SPECCTRA_DB::FromBOARD( BOARD* aBoard )
             pcb->library->AddPadstack( padstack );
         }
 
+        padstackIndex.clear();
+
         // copy our SPECCTRA_DB::nets to the pcb->network
         for( unsigned n = 1; n<nets.size(); ++n )
         {
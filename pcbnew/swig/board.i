@@ -61,6 +61,8 @@ HANDLE_EXCEPTIONS(BOARD::TracksInNetBetweenPoints)
 %include netinfo.i
 %include netclass.i
 %include pcb_plot_params.i
+%include router.i
+%include render_3d.i
 
 %ignore operator++(SCH_LAYER_ID&);
 
@@ -121,8 +123,120 @@ HANDLE_EXCEPTIONS(BOARD::TracksInNetBetweenPoints)
     %}
 }
 
+%{
+#include <class_module.h>
+#include <class_pad.h>
+#include <class_track.h>
+
+/// The bytes of the values of aColumn, for a python array.array
+template <typename T>
+static PyObject* packColumn( const std::vector<T>& aColumn )
+{
+    return PyBytes_FromStringAndSize( reinterpret_cast<const char*>( aColumn.data() ),
+                                      aColumn.size() * sizeof( T ) );
+}
+%}
+
+%pythoncode
+%{
+import array
+
+def _ColumnArrays(names, typecodes, columns):
+    """
+    Return a dictionary of array.array built from the bytes of each column
+    """
+    arrays = {}
+
+    for name, typecode, data in zip(names, typecodes, columns):
+        column = array.array(typecode)
+
+        if hasattr(column, 'frombytes'):
+            column.frombytes(data)
+        else:
+            column.fromstring(data)     # python 2
+
+        arrays[name] = column
+
+    return arrays
+%}
+
 %extend BOARD
 {
+    // The columns of GetTrackArrays(), GetPadArrays() and GetModuleArrays(), made in a single
+    // pass over the board instead of a python wrapper for each item.
+
+    PyObject* packTracks()
+    {
+        std::vector<int> startX, startY, endX, endY, width, layer, net, isVia;
+
+        for( TRACK* track : self->Tracks() )
+        {
+            startX.push_back( track->GetStart().x );
+            startY.push_back( track->GetStart().y );
+            endX.push_back( track->GetEnd().x );
+            endY.push_back( track->GetEnd().y );
+            width.push_back( track->GetWidth() );
+            layer.push_back( track->GetLayer() );
+            net.push_back( track->GetNetCode() );
+            isVia.push_back( track->Type() == PCB_VIA_T );
+        }
+
+        return Py_BuildValue( "(NNNNNNNN)", packColumn( startX ), packColumn( startY ),
+                              packColumn( endX ), packColumn( endY ), packColumn( width ),
+                              packColumn( layer ), packColumn( net ), packColumn( isVia ) );
+    }
+
+    PyObject* packPads()
+    {
+        std::vector<int>    x, y, sizeX, sizeY, drillX, drillY, net, shape, attribute, module;
+        std::vector<double> orientation;
+        int                 moduleIndex = 0;
+
+        for( MODULE* mod : self->Modules() )
+        {
+            for( D_PAD* pad : mod->Pads() )
+            {
+                x.push_back( pad->GetPosition().x );
+                y.push_back( pad->GetPosition().y );
+                sizeX.push_back( pad->GetSize().x );
+                sizeY.push_back( pad->GetSize().y );
+                drillX.push_back( pad->GetDrillSize().x );
+                drillY.push_back( pad->GetDrillSize().y );
+                net.push_back( pad->GetNetCode() );
+                shape.push_back( pad->GetShape() );
+                attribute.push_back( pad->GetAttribute() );
+                module.push_back( moduleIndex );
+                orientation.push_back( pad->GetOrientation() );
+            }
+
+            moduleIndex++;
+        }
+
+        return Py_BuildValue( "(NNNNNNNNNNN)", packColumn( x ), packColumn( y ),
+                              packColumn( sizeX ), packColumn( sizeY ), packColumn( drillX ),
+                              packColumn( drillY ), packColumn( net ), packColumn( shape ),
+                              packColumn( attribute ), packColumn( module ),
+                              packColumn( orientation ) );
+    }
+
+    PyObject* packModules()
+    {
+        std::vector<int>    x, y, layer, padCount;
+        std::vector<double> orientation;
+
+        for( MODULE* mod : self->Modules() )
+        {
+            x.push_back( mod->GetPosition().x );
+            y.push_back( mod->GetPosition().y );
+            layer.push_back( mod->GetLayer() );
+            padCount.push_back( mod->GetPadCount() );
+            orientation.push_back( mod->GetOrientation() );
+        }
+
+        return Py_BuildValue( "(NNNNN)", packColumn( x ), packColumn( y ), packColumn( layer ),
+                              packColumn( padCount ), packColumn( orientation ) );
+    }
+
     // BOARD_ITEM_CONTAINER's interface functions will be implemented by SWIG
     // automatically and inherited by the python wrapper class.
 
@@ -133,6 +247,41 @@ HANDLE_EXCEPTIONS(BOARD::TracksInNetBetweenPoints)
     def GetDrawings(self):            return self.Drawings()
     def GetTracks(self):              return self.Tracks()
 
+    def GetTrackArrays(self):
+        """
+        Return the tracks and vias of the board, in the order of GetTracks(), as a dictionary
+        of array.array columns:
+        start_x, start_y, end_x, end_y, width (internal units), layer, net (net code) and
+        is_via (1 for a via).
+        The arrays support the buffer protocol, e.g. numpy.frombuffer(arrays['width'], 'i')
+        """
+        return _ColumnArrays(
+            ('start_x', 'start_y', 'end_x', 'end_y', 'width', 'layer', 'net', 'is_via'),
+            'iiiiiiii', self.packTracks())
+
+    def GetPadArrays(self):
+        """
+        Return the pads of the board, footprint after footprint in the order of GetModules(),
+        as a dictionary of array.array columns:
+        x, y, size_x, size_y, drill_x, drill_y (internal units), net (net code), shape
+        (PAD_SHAPE_T), attribute (PAD_ATTR_T), module (index of the footprint in GetModules())
+        and orientation (float, in tenths of degree).
+        """
+        return _ColumnArrays(
+            ('x', 'y', 'size_x', 'size_y', 'drill_x', 'drill_y', 'net', 'shape', 'attribute',
+             'module', 'orientation'),
+            'iiiiiiiiiid', self.packPads())
+
+    def GetModuleArrays(self):
+        """
+        Return the footprints of the board, in the order of GetModules(), as a dictionary of
+        array.array columns:
+        x, y (internal units), layer, pad_count and orientation (float, in tenths of degree).
+        """
+        return _ColumnArrays(
+            ('x', 'y', 'layer', 'pad_count', 'orientation'),
+            'iiiid', self.packModules())
+
     def Save(self,filename):
         return SaveBoard(filename,self)
 
@@ -28,6 +28,9 @@
 // this shared_ptr line has to be before include connectivity_data.h.
 %shared_ptr(CONNECTIVITY_DATA)
 
+// the item lists returned by GetNetItems() and GetItemsAt()
+%template(BOARD_CONNECTED_ITEM_Vector) std::vector<BOARD_CONNECTED_ITEM*>;
+
 %include connectivity/connectivity_data.h
 
  
@@ -260,6 +260,19 @@ void PCB_EDIT_FRAME::RunActionPlugin( ACTION_PLUGIN* aActionPlugin )
     aActionPlugin->Run();
     ACTION_PLUGINS::SetActionRunning( false );
 
+    // The plugin changes the items directly, so none of the cached content hashes is trusted
+    for( MODULE* module : currentPcb->Modules() )
+        module->InvalidateHashes();
+
+    for( TRACK* track : currentPcb->Tracks() )
+        track->InvalidateHash();
+
+    for( BOARD_ITEM* item : currentPcb->Drawings() )
+        item->InvalidateHash();
+
+    for( ZONE_CONTAINER* zone : currentPcb->Zones() )
+        zone->InvalidateHash();
+
     // Get back the undo buffer to fix some modifications
     PICKED_ITEMS_LIST* oldBuffer = NULL;
 
@@ -41,6 +41,11 @@
 #include <stdlib.h>
 #include <pcb_draw_panel_gal.h>
 #include <action_plugin.h>
+#include <thread_pool.h>
+#include <3d_rendering/c3d_image_renderer.h>
+#include <fabrication_package.h>
+
+#include <atomic>
 
 static PCB_EDIT_FRAME* s_PcbEditFrame = NULL;
 
@@ -106,6 +111,61 @@ bool SaveBoard( wxString& aFileName, BOARD* aBoard )
 }
 
 
+int Render3DImages( wxArrayString& aBoardFiles, wxArrayString& aImageFiles, int aView,
+                    int aWidth, int aHeight )
+{
+    const size_t count = std::min( aBoardFiles.GetCount(), aImageFiles.GetCount() );
+
+    // The board parsers use the numeric locale of the process, so they run one at a time
+    std::vector<BOARD*> boards( count, nullptr );
+
+    for( size_t i = 0; i < count; ++i )
+    {
+        try
+        {
+            boards[i] = LoadBoard( aBoardFiles[i] );
+        }
+        catch( const IO_ERROR& )
+        {
+        }
+    }
+
+    std::atomic<int> written( 0 );
+
+    THREAD_POOL::GetPool().ParallelFor( count,
+            [&]( size_t i )
+            {
+                if( !boards[i] )
+                    return;
+
+                C3D_IMAGE_RENDERER renderer( boards[i] );
+
+                renderer.SetSize( aWidth, aHeight );
+                renderer.SetView( (C3D_IMAGE_RENDERER::VIEW) aView );
+
+                if( renderer.Render( aImageFiles[i] ) )
+                    ++written;
+            }, 1 );
+
+    for( BOARD* board : boards )
+        delete board;
+
+    return written;
+}
+
+
+bool WriteFabricationPackage( BOARD* aBoard, wxString& aOutputDir )
+{
+    PCB_PLOT_PARAMS plotOpts = aBoard->GetPlotOptions();
+    plotOpts.SetOutputDirectory( aOutputDir );
+
+    FABRICATION_PACKAGE_WRITER writer( aBoard );
+    writer.SetPlotOptions( plotOpts );
+
+    return writer.CreateFiles();
+}
+
+
 bool ExportSpecctraDSN( wxString& aFullFilename )
 {
     if( s_PcbEditFrame )
@@ -49,6 +49,26 @@ BOARD*  LoadBoard( wxString& aFileName );
 // so no option to choose the file format.
 bool    SaveBoard( wxString& aFileName, BOARD* aBoard );
 
+/**
+ * Renders the 3D view of boards to image files with the raytracer, several boards at once
+ * on the thread pool.  Use C3D_IMAGE_RENDERER for more views or options of a board.
+ * @param aBoardFiles are the board files to render
+ * @param aImageFiles are the image files to write, one for each board
+ * @param aView is the view of the boards, a C3D_IMAGE_RENDERER::VIEW
+ * @return the number of images written
+ */
+int     Render3DImages( wxArrayString& aBoardFiles, wxArrayString& aImageFiles, int aView,
+                        int aWidth, int aHeight );
+
+/**
+ * Writes the fabrication files of a board to a directory: the Gerber files of the layers
+ * selected in the board plot options and the Gerber job file, the Excellon drill files, the
+ * footprint position files and the IPC-D-356 netlist.  The files are written at once on the
+ * thread pool.  See FABRICATION_PACKAGE_WRITER.
+ * @return true if all the files were created
+ */
+bool WriteFabricationPackage( BOARD* aBoard, wxString& aOutputDir );
+
 /**
  * will export the current BOARD to a specctra dsn file.
  * See http://www.autotraxeda.com/docs/SPECCTRA/SPECCTRA.pdf for the
@@ -59,10 +59,24 @@
 #include <drc/courtyard_overlap.h>
 #include "zone_filler_tool.h"
 
+#include <advanced_config.h>
+#include <thread_pool.h>
+#include <profile.h>
+#include <profile_registry.h>
+#include <widgets/progress_reporter.h>
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+
 DRC::DRC() :
         PCB_TOOL_BASE( "pcbnew.DRCTool" )
 {
     m_drcDialog  = NULL;
+    m_pcbEditorFrame = nullptr;
+    m_pcb = nullptr;
 
     // establish initial values for everything:
     m_doPad2PadTest     = true;         // enable pad to pad clearance tests
@@ -80,14 +94,11 @@ DRC::DRC() :
     // m_rptFilename set to empty by its constructor
 
     m_currentMarker = NULL;
+    m_progressReporter = nullptr;
+    m_deferViolations = false;
+    m_cancelled = false;
 
-    m_segmAngle  = 0;
-    m_segmLength = 0;
-
-    m_xcliplo = 0;
-    m_ycliplo = 0;
-    m_xcliphi = 0;
-    m_ycliphi = 0;
+    m_parallelTrackTest = ADVANCED_CFG::GetCfg().m_parallelTrackDrc;
 }
 
 
@@ -111,6 +122,8 @@ void DRC::Reset( RESET_REASON aReason )
             DestroyDRCDialog( wxID_OK );
 
         m_pcb = m_pcbEditorFrame->GetBoard();
+        m_dirtyAreas.clear();
+        m_textShapes.clear();
 
         m_markerFactory.SetUnitsProvider( [=]() { return m_pcbEditorFrame->GetUserUnits(); } );
     }
@@ -163,12 +176,107 @@ int DRC::ShowDRCDialog( const TOOL_EVENT& aEvent )
 
 void DRC::addMarkerToPcb( MARKER_PCB* aMarker )
 {
+    if( m_markerHandler )
+    {
+        m_markerHandler( aMarker );
+        return;
+    }
+
     BOARD_COMMIT commit( m_pcbEditorFrame );
     commit.Add( aMarker );
     commit.Push( wxEmptyString, false, false );
 }
 
 
+void DRC::addMarkersToPcb( const std::vector<MARKER_PCB*>& aMarkers )
+{
+    if( m_markerHandler )
+    {
+        for( MARKER_PCB* marker : aMarkers )
+            m_markerHandler( marker );
+
+        return;
+    }
+
+    if( aMarkers.empty() )
+        return;
+
+    BOARD_COMMIT commit( m_pcbEditorFrame );
+
+    for( MARKER_PCB* marker : aMarkers )
+        commit.Add( marker );
+
+    commit.Push( wxEmptyString, false, false );
+}
+
+
+DRC_VIOLATION DRC_VIOLATION::WithZone( TRACK* aTrack, ZONE_CONTAINER* aZone, int aErrorCode )
+{
+    return { WITH_ZONE, aErrorCode, wxPoint(), false, nullptr, aTrack, aZone, SEG() };
+}
+
+
+MARKER_PCB* DRC::newMarker( const DRC_VIOLATION& aViolation ) const
+{
+    const DRC_VIOLATION& v = aViolation;
+    MARKER_PCB*          marker = nullptr;
+
+    switch( v.m_kind )
+    {
+    case DRC_VIOLATION::AT_POSITION:
+        if( v.m_conflictItem )
+            marker = m_markerFactory.NewMarker( v.m_position, v.m_item, v.m_conflictItem,
+                                                v.m_errorCode );
+        else
+            marker = m_markerFactory.NewMarker( v.m_position, v.m_item, v.m_errorCode );
+
+        break;
+
+    case DRC_VIOLATION::ON_SEGMENT:
+        marker = m_markerFactory.NewMarker( v.m_track, v.m_conflictItem, v.m_conflictSeg,
+                                            v.m_errorCode );
+
+        if( v.m_forcePosition )
+            marker->SetPosition( v.m_position );
+
+        break;
+
+    case DRC_VIOLATION::WITH_ZONE:
+        marker = m_markerFactory.NewMarker( v.m_track,
+                                            static_cast<ZONE_CONTAINER*>( v.m_conflictItem ),
+                                            v.m_errorCode );
+        break;
+    }
+
+    return marker;
+}
+
+
+void DRC::addViolationsToPcb( const std::vector<DRC_VIOLATION>& aViolations )
+{
+    if( m_deferViolations )
+    {
+        std::lock_guard<std::mutex> lock( m_pendingViolationsLock );
+        m_pendingViolations.insert( m_pendingViolations.end(), aViolations.begin(),
+                                    aViolations.end() );
+        return;
+    }
+
+    std::vector<MARKER_PCB*> markers;
+
+    for( const DRC_VIOLATION& violation : aViolations )
+        markers.push_back( newMarker( violation ) );
+
+    addMarkersToPcb( markers );
+}
+
+
+EDA_UNITS_T DRC::userUnits() const
+{
+    return m_pcbEditorFrame ? m_pcbEditorFrame->GetUserUnits() : MILLIMETRES;
+}
+
+
 void DRC::DestroyDRCDialog( int aReason )
 {
     if( m_drcDialog )
@@ -183,43 +291,75 @@ void DRC::DestroyDRCDialog( int aReason )
 
 int DRC::TestZoneToZoneOutline( ZONE_CONTAINER* aZone, bool aCreateMarkers )
 {
-    BOARD* board = m_pcbEditorFrame->GetBoard();
-    BOARD_COMMIT commit( m_pcbEditorFrame );
-    int nerrors = 0;
+    if( m_pcbEditorFrame )
+        m_pcb = m_pcbEditorFrame->GetBoard();
 
-    std::vector<SHAPE_POLY_SET> smoothed_polys;
-    smoothed_polys.resize( board->GetAreaCount() );
+    BOARD*                     board = m_pcb;
+    std::vector<bool>          refZones( board->GetAreaCount(), aZone == nullptr );
+    std::vector<DRC_VIOLATION> violations;
 
     for( int ia = 0; ia < board->GetAreaCount(); ia++ )
     {
-        ZONE_CONTAINER*    zoneRef = board->GetArea( ia );
-        std::set<VECTOR2I> colinearCorners;
-        zoneRef->GetColinearCorners( board, colinearCorners );
-
-        zoneRef->BuildSmoothedPoly( smoothed_polys[ia], &colinearCorners );
+        if( board->GetArea( ia ) == aZone )
+            refZones[ia] = true;
     }
 
-    // iterate through all areas
-    for( int ia = 0; ia < board->GetAreaCount(); ia++ )
+    int nerrors = doZoneToZoneOutlineDrc( refZones, aCreateMarkers ? &violations : nullptr );
+
+    if( aCreateMarkers )
+        addViolationsToPcb( violations );
+
+    return nerrors;
+}
+
+
+int DRC::doZoneToZoneOutlineDrc( const std::vector<bool>& aRefZones,
+                                 std::vector<DRC_VIOLATION>* aViolations )
+{
+    BOARD* board = m_pcb;
+    int    zoneCount = board->GetAreaCount();
+
+    struct ZONE_PAIR
+    {
+        int m_testZone;
+        int m_clearance;
+    };
+
+    // Collect the zones to test against each reference zone.  The smoothed outline is
+    // inside the zone outline, so zones whose outline bounding boxes are further apart than
+    // the clearance cannot be in conflict.
+    std::vector<BOX2I> bboxes( zoneCount );
+
+    for( int ia = 0; ia < zoneCount; ia++ )
+        bboxes[ia] = board->GetArea( ia )->GetBoundingBox();
+
+    std::vector<std::vector<ZONE_PAIR>> pairs( zoneCount );
+    std::vector<bool>                   needOutline( zoneCount, false );
+    std::vector<int>                    refList;
+
+    for( int ia = 0; ia < zoneCount; ia++ )
     {
         ZONE_CONTAINER* zoneRef = board->GetArea( ia );
 
         if( !zoneRef->IsOnCopperLayer() )
             continue;
 
-        // When testing only a single area, skip all others
-        if( aZone && ( aZone != zoneRef) )
+        // When testing only some areas, skip all others
+        if( !aRefZones[ia] )
             continue;
 
-        // If we are testing a single zone, then iterate through all other zones
-        // Otherwise, we have already tested the zone combination
-        for( int ia2 = ( aZone ? 0 : ia + 1 ); ia2 < board->GetAreaCount(); ia2++ )
+        // Iterate through all other zones, but skip the reference zones already tested
+        // against this one
+        for( int ia2 = 0; ia2 < zoneCount; ia2++ )
         {
             ZONE_CONTAINER* zoneToTest = board->GetArea( ia2 );
 
             if( zoneRef == zoneToTest )
                 continue;
 
+            if( aRefZones[ia2] && ia2 < ia )
+                continue;
+
             // test for same layer
             if( zoneRef->GetLayer() != zoneToTest->GetLayer() )
                 continue;
@@ -236,8 +376,6 @@ int DRC::TestZoneToZoneOutline( ZONE_CONTAINER* aZone, bool aCreateMarkers )
             if( zoneRef->GetIsKeepout() != zoneToTest->GetIsKeepout() )
                 continue;
 
-            // Examine a candidate zone: compare zoneToTest to zoneRef
-
             // Get clearance used in zone to zone test.  The policy used to
             // obtain that value is now part of the zone object itself by way of
             // ZONE_CONTAINER::GetClearance().
@@ -248,118 +386,266 @@ int DRC::TestZoneToZoneOutline( ZONE_CONTAINER* aZone, bool aCreateMarkers )
             if( zoneRef->GetIsKeepout() )
                 zone2zoneClearance = 1;
 
-            // test for some corners of zoneRef inside zoneToTest
-            for( auto iterator = smoothed_polys[ia].IterateWithHoles(); iterator; iterator++ )
-            {
-                VECTOR2I currentVertex = *iterator;
-                wxPoint pt( currentVertex.x, currentVertex.y );
+            BOX2I area = bboxes[ia];
+            area.Inflate( zone2zoneClearance );
 
-                if( smoothed_polys[ia2].Contains( currentVertex ) )
-                {
-                    if( aCreateMarkers )
-                        commit.Add( m_markerFactory.NewMarker( pt, zoneRef, zoneToTest,
-                                                               DRCE_ZONES_INTERSECT ) );
+            if( !area.Intersects( bboxes[ia2] ) )
+                continue;
 
-                    nerrors++;
-                }
-            }
+            pairs[ia].push_back( { ia2, zone2zoneClearance } );
+            needOutline[ia] = true;
+            needOutline[ia2] = true;
+        }
+
+        if( !pairs[ia].empty() )
+            refList.push_back( ia );
+    }
+
+    if( refList.empty() )
+        return 0;
 
-            // test for some corners of zoneToTest inside zoneRef
-            for( auto iterator = smoothed_polys[ia2].IterateWithHoles(); iterator; iterator++ )
+    // Runs aWork( 0 .. aCount - 1 ) on the thread pool
+    auto runParallel =
+            [&]( size_t aCount, const std::function<void( size_t )>& aWork )
             {
-                VECTOR2I currentVertex = *iterator;
-                wxPoint pt( currentVertex.x, currentVertex.y );
+                THREAD_POOL::GetPool().ParallelFor( aCount,
+                        [&]( size_t i )
+                        {
+                            if( !m_cancelled )
+                                aWork( i );
+                        },
+                        1, ADVANCED_CFG::GetCfg().m_maxDrcThreads );
+            };
+
+    // Build the smoothed outlines once, and only for the zones which are tested.  Building
+    // the outlines and testing them only read the board, so both run on several threads.
+    std::vector<SHAPE_POLY_SET> smoothed_polys( zoneCount );
+    std::vector<int>            outlineList;
+
+    for( int ia = 0; ia < zoneCount; ia++ )
+    {
+        if( needOutline[ia] )
+            outlineList.push_back( ia );
+    }
 
-                if( smoothed_polys[ia].Contains( currentVertex ) )
-                {
-                    if( aCreateMarkers )
-                        commit.Add( m_markerFactory.NewMarker( pt, zoneToTest, zoneRef,
-                                                               DRCE_ZONES_INTERSECT ) );
+    runParallel( outlineList.size(),
+            [&]( size_t aIdx )
+            {
+                ZONE_CONTAINER*    zone = board->GetArea( outlineList[aIdx] );
+                std::set<VECTOR2I> colinearCorners;
 
-                    nerrors++;
-                }
-            }
+                zone->GetColinearCorners( board, colinearCorners );
+                zone->BuildSmoothedPoly( smoothed_polys[outlineList[aIdx]], &colinearCorners );
+            } );
 
-            // Iterate through all the segments of refSmoothedPoly
-            std::set<wxPoint> conflictPoints;
+    // Problems found for each reference zone, merged in zone order when all threads are done
+    std::vector<std::vector<DRC_VIOLATION>> zoneViolations( refList.size() );
+    std::vector<int>                        zoneErrors( refList.size(), 0 );
 
-            for( auto refIt = smoothed_polys[ia].IterateSegmentsWithHoles(); refIt; refIt++ )
+    runParallel( refList.size(),
+            [&]( size_t aIdx )
             {
-                // Build ref segment
-                SEG refSegment = *refIt;
+                int                         ia = refList[aIdx];
+                ZONE_CONTAINER*             zoneRef = board->GetArea( ia );
+                const SHAPE_POLY_SET&       refPoly = smoothed_polys[ia];
+                std::vector<DRC_VIOLATION>& violations = zoneViolations[aIdx];
+                int&                        nerrors = zoneErrors[aIdx];
 
-                // Iterate through all the segments in smoothed_polys[ia2]
-                for( auto testIt = smoothed_polys[ia2].IterateSegmentsWithHoles(); testIt; testIt++ )
+                for( const ZONE_PAIR& pair : pairs[ia] )
                 {
-                    // Build test segment
-                    SEG testSegment = *testIt;
-                    wxPoint pt;
-
-                    int ax1, ay1, ax2, ay2;
-                    ax1 = refSegment.A.x;
-                    ay1 = refSegment.A.y;
-                    ax2 = refSegment.B.x;
-                    ay2 = refSegment.B.y;
-
-                    int bx1, by1, bx2, by2;
-                    bx1 = testSegment.A.x;
-                    by1 = testSegment.A.y;
-                    bx2 = testSegment.B.x;
-                    by2 = testSegment.B.y;
-
-                    int d = GetClearanceBetweenSegments( bx1, by1, bx2, by2,
-                                                         0,
-                                                         ax1, ay1, ax2, ay2,
-                                                         0,
-                                                         zone2zoneClearance,
-                                                         &pt.x, &pt.y );
-
-                    if( d < zone2zoneClearance )
-                        conflictPoints.insert( pt );
+                    ZONE_CONTAINER*       zoneToTest = board->GetArea( pair.m_testZone );
+                    const SHAPE_POLY_SET& testPoly = smoothed_polys[pair.m_testZone];
+                    int                   zone2zoneClearance = pair.m_clearance;
+
+                    // test for some corners of zoneRef inside zoneToTest
+                    for( auto iterator = refPoly.IterateWithHoles(); iterator; iterator++ )
+                    {
+                        VECTOR2I currentVertex = *iterator;
+                        wxPoint pt( currentVertex.x, currentVertex.y );
+
+                        if( testPoly.Contains( currentVertex ) )
+                        {
+                            if( aViolations )
+                            {
+                                violations.push_back( DRC_VIOLATION::AtPosition(
+                                        pt, zoneRef, zoneToTest, DRCE_ZONES_INTERSECT ) );
+                            }
+
+                            nerrors++;
+                        }
+                    }
+
+                    // test for some corners of zoneToTest inside zoneRef
+                    for( auto iterator = testPoly.IterateWithHoles(); iterator; iterator++ )
+                    {
+                        VECTOR2I currentVertex = *iterator;
+                        wxPoint pt( currentVertex.x, currentVertex.y );
+
+                        if( refPoly.Contains( currentVertex ) )
+                        {
+                            if( aViolations )
+                            {
+                                violations.push_back( DRC_VIOLATION::AtPosition(
+                                        pt, zoneToTest, zoneRef, DRCE_ZONES_INTERSECT ) );
+                            }
+
+                            nerrors++;
+                        }
+                    }
+
+                    // Iterate through all the segments of refSmoothedPoly
+                    std::set<wxPoint> conflictPoints;
+
+                    for( auto refIt = refPoly.IterateSegmentsWithHoles(); refIt; refIt++ )
+                    {
+                        // Build ref segment
+                        SEG refSegment = *refIt;
+
+                        // Iterate through all the segments in testPoly
+                        for( auto testIt = testPoly.IterateSegmentsWithHoles(); testIt; testIt++ )
+                        {
+                            // Build test segment
+                            SEG testSegment = *testIt;
+                            wxPoint pt;
+
+                            int ax1, ay1, ax2, ay2;
+                            ax1 = refSegment.A.x;
+                            ay1 = refSegment.A.y;
+                            ax2 = refSegment.B.x;
+                            ay2 = refSegment.B.y;
+
+                            int bx1, by1, bx2, by2;
+                            bx1 = testSegment.A.x;
+                            by1 = testSegment.A.y;
+                            bx2 = testSegment.B.x;
+                            by2 = testSegment.B.y;
+
+                            int d = GetClearanceBetweenSegments( bx1, by1, bx2, by2,
+                                                                 0,
+                                                                 ax1, ay1, ax2, ay2,
+                                                                 0,
+                                                                 zone2zoneClearance,
+                                                                 &pt.x, &pt.y );
+
+                            if( d < zone2zoneClearance )
+                                conflictPoints.insert( pt );
+                        }
+                    }
+
+                    for( wxPoint pt : conflictPoints )
+                    {
+                        if( aViolations )
+                        {
+                            violations.push_back( DRC_VIOLATION::AtPosition(
+                                    pt, zoneRef, zoneToTest, DRCE_ZONES_TOO_CLOSE ) );
+                        }
+
+                        nerrors++;
+                    }
                 }
-            }
+            } );
 
-            for( wxPoint pt : conflictPoints )
-            {
-                if( aCreateMarkers )
-                    commit.Add( m_markerFactory.NewMarker( pt, zoneRef, zoneToTest,
-                                                           DRCE_ZONES_TOO_CLOSE ) );
+    int nerrors = 0;
 
-                nerrors++;
-            }
+    for( size_t ii = 0; ii < refList.size(); ++ii )
+    {
+        nerrors += zoneErrors[ii];
+
+        if( aViolations )
+        {
+            aViolations->insert( aViolations->end(), zoneViolations[ii].begin(),
+                                 zoneViolations[ii].end() );
         }
     }
 
-    if( aCreateMarkers )
-        commit.Push( wxEmptyString, false, false );
-
     return nerrors;
 }
 
 
 void DRC::RunTests( wxTextCtrl* aMessages )
 {
+    PROF_SCOPE profScope( "DRC" );
+
     // be sure m_pcb is the current board, not a old one
     // ( the board can be reloaded )
     m_pcb = m_pcbEditorFrame->GetBoard();
 
-    if( aMessages )
+    // Netclasses can have been edited since the last synchronization
+    m_pcb->BuildNetClearances();
+
+    m_cancelled = false;
+
+    // caller (a wxTopLevelFrame) is the wxDialog or the Pcb Editor frame that call DRC:
+    wxWindow* caller = aMessages ? aMessages->GetParent() : m_pcbEditorFrame;
+
+    auto message = [&]( const wxString& aMessage )
+    {
+        if( aMessages )
+        {
+            aMessages->AppendText( aMessage );
+            wxSafeYield();
+        }
+    };
+
+    // The zone filler has its own progress reporting
+    if( m_refillZones )
+    {
+        message( _( "Refilling all zones...\n" ) );
+        m_toolMgr->GetTool<ZONE_FILLER_TOOL>()->FillAllZones( caller );
+    }
+    else
     {
-        aMessages->AppendText( _( "Board Outline...\n" ) );
-        wxSafeYield();
+        message( _( "Checking zone fills...\n" ) );
+        m_toolMgr->GetTool<ZONE_FILLER_TOOL>()->CheckAllZones( caller );
     }
 
-    testOutline();
+    const int stageCount = 11;
+    WX_PROGRESS_REPORTER reporter( caller, _( "Design Rules Check" ), stageCount );
+
+    // The tests read the board on worker threads: nothing can be edited until they are done
+    // (the progress dialog itself is not app modal, which messes up OSX).
+    wxWindowDisabler disabler( &reporter );
+
+    // The background fills would change the zones under the tests
+    ZONE_FILLER_TOOL* zoneFiller = m_toolMgr->GetTool<ZONE_FILLER_TOOL>();
+
+    struct SUSPEND_BACKGROUND_FILL
+    {
+        SUSPEND_BACKGROUND_FILL( ZONE_FILLER_TOOL* aFiller ) : m_filler( aFiller )
+        {
+            m_filler->SuspendBackgroundFill( true );
+        }
+
+        ~SUSPEND_BACKGROUND_FILL()
+        {
+            m_filler->SuspendBackgroundFill( false );
+        }
+
+        ZONE_FILLER_TOOL* m_filler;
+    } suspendFill( zoneFiller );
+
+    prepareTests();
+
+    m_progressReporter = &reporter;
+
+    message( _( "Board Outline...\n" ) );
+    runStage( _( "Board outline..." ), [&]() { testOutline(); } );
 
     // someone should have cleared the two lists before calling this.
-    if( !testNetClasses() )
+    bool netclassesOk = true;
+
+    message( _( "Netclasses...\n" ) );
+    runStage( _( "Netclasses..." ), [&]() { netclassesOk = testNetClasses(); } );
+
+    if( !netclassesOk )
     {
         // testing the netclasses is a special case because if the netclasses
         // do not pass the BOARD_DESIGN_SETTINGS checks, then every member of a net
         // class (a NET) will cause its items such as tracks, vias, and pads
         // to also fail.  So quit after *all* netclass errors have been reported.
-        if( aMessages )
-            aMessages->AppendText( _( "Aborting\n" ) );
+        message( _( "Aborting\n" ) );
+
+        m_progressReporter = nullptr;
 
         // update the m_drcDialog listboxes
         updatePointers();
@@ -369,151 +655,490 @@ void DRC::RunTests( wxTextCtrl* aMessages )
 
     // test pad to pad clearances, nothing to do with tracks, vias or zones.
     if( m_doPad2PadTest )
+    {
+        message( _( "Pad clearances...\n" ) );
+        runStage( _( "Pad clearances..." ), [&]() { testPad2Pad(); } );
+    }
+
+    // test clearances between drilled holes
+    message( _( "Drill clearances...\n" ) );
+    runStage( _( "Drill clearances..." ), [&]() { testDrilledHoles(); } );
+
+    // test track and via clearances to other tracks, pads, and vias
+    message( _( "Track clearances...\n" ) );
+    runStage( _( "Track clearances..." ), [&]() { testTracks( caller, false ); } );
+
+    // test zone clearances to other zones
+    message( _( "Zone to zone clearances...\n" ) );
+    runStage( _( "Zone to zone clearances..." ), [&]() { testZones(); } );
+
+    // find and gather unconnected pads.  The connectivity is shared with the view, so
+    // this test stays on the main thread.
+    if( m_doUnconnectedTest && !m_cancelled )
+    {
+        message( _( "Unconnected pads...\n" ) );
+        reporter.AdvancePhase();
+        reporter.Report( _( "Unconnected pads..." ) );
+
+        if( !reporter.KeepRefreshing() )
+            m_cancelled = true;
+        else
+            testUnconnected();
+    }
+
+    // find and gather vias, tracks, pads inside keepout areas.
+    if( m_doKeepoutTest )
+    {
+        message( _( "Keepout areas ...\n" ) );
+        runStage( _( "Keepout areas..." ), [&]() { testKeepoutAreas(); } );
+    }
+
+    // find and gather vias, tracks, pads inside text boxes.
+    message( _( "Text and graphic clearances...\n" ) );
+    runStage( _( "Text and graphic clearances..." ), [&]() { testCopperTextAndGraphics(); } );
+
+    // find overlapping courtyard ares.
+    if( m_pcb->GetDesignSettings().m_ProhibitOverlappingCourtyards
+        || m_pcb->GetDesignSettings().m_RequireCourtyards )
+    {
+        message( _( "Courtyard areas...\n" ) );
+        runStage( _( "Courtyard areas..." ), [&]() { doFootprintOverlappingDrc(); } );
+    }
+
+    // Check if there are items on disabled layers
+    message( _( "Items on disabled layers...\n" ) );
+    runStage( _( "Items on disabled layers..." ), [&]() { testDisabledLayers(); } );
+
+    m_progressReporter = nullptr;
+
+    for( DRC_ITEM* footprintItem : m_footprints )
+        delete footprintItem;
+
+    m_footprints.clear();
+    m_footprintsTested = false;
+
+    if( m_testFootprints && !Kiface().IsSingle() && !m_cancelled )
     {
         if( aMessages )
         {
-            aMessages->AppendText( _( "Pad clearances...\n" ) );
-            wxSafeYield();
+            aMessages->AppendText( _( "Checking footprints against schematic...\n" ) );
+            aMessages->Refresh();
         }
 
-        testPad2Pad();
+        NETLIST netlist;
+        m_pcbEditorFrame->FetchNetlistFromSchematic( netlist, PCB_EDIT_FRAME::ANNOTATION_DIALOG );
+
+        if( m_drcDialog )
+            m_drcDialog->Raise();
+
+        TestFootprints( netlist, m_pcb, m_drcDialog->GetUserUnits(), m_footprints );
+        m_footprintsTested = true;
     }
 
-    // test clearances between drilled holes
+    m_drcRun = true;
+
+    // The whole board has been tested
+    if( !m_cancelled )
+        m_dirtyAreas.clear();
+
+    // update the m_drcDialog listboxes
+    updatePointers();
+
     if( aMessages )
     {
-        aMessages->AppendText( _( "Drill clearances...\n" ) );
-        wxSafeYield();
+        // no newline on this one because it is last, don't want the window
+        // to unnecessarily scroll.
+        aMessages->AppendText( m_cancelled ? _( "Cancelled" ) : _( "Finished" ) );
     }
+}
 
-    testDrilledHoles();
 
-    // caller (a wxTopLevelFrame) is the wxDialog or the Pcb Editor frame that call DRC:
-    wxWindow* caller = aMessages ? aMessages->GetParent() : m_pcbEditorFrame;
+void DRC::runStage( const wxString& aMessage, const std::function<void()>& aTest )
+{
+    if( m_cancelled )
+        return;
 
-    if( m_refillZones )
+    PROF_SCOPE profScope( aMessage.ToStdString() );
+
+    m_progressReporter->AdvancePhase();
+    m_progressReporter->Report( aMessage );
+    m_progressReporter->SetMaxProgress( 1 );
+
+    // The test runs on a worker thread, so the UI stays alive.  Its markers are collected
+    // and committed on the main thread when the test is done.
+    std::vector<MARKER_PCB*> markers;
+    std::mutex               markersLock;
+
+    m_markerHandler = [&]( MARKER_PCB* aMarker )
     {
-        if( aMessages )
-            aMessages->AppendText( _( "Refilling all zones...\n" ) );
+        std::lock_guard<std::mutex> lock( markersLock );
+        markers.push_back( aMarker );
+    };
 
-        m_toolMgr->GetTool<ZONE_FILLER_TOOL>()->FillAllZones( caller );
+    // The markers of the track tests are formatted in the user units and translated, which
+    // is not done off the main thread: they are built here when the test is done
+    m_deferViolations = true;
+
+    // The canvas is not repainted while the test reads the items: the painters fill the
+    // same lazy caches of the items (text boxes...)
+    EDA_DRAW_PANEL_GAL* canvas = m_pcbEditorFrame->GetCanvas();
+    canvas->StopDrawing();
+
+    std::future<void> ret = std::async( std::launch::async, aTest );
+
+    // Here we balance the test with a 100ms timeout to allow UI updating
+    while( ret.wait_for( std::chrono::milliseconds( 100 ) ) != std::future_status::ready )
+    {
+        if( !m_cancelled && !m_progressReporter->KeepRefreshing() )
+            m_cancelled = true;     // Aborted by user: the test stops at its next check
     }
-    else
+
+    canvas->StartDrawing();
+    m_markerHandler = nullptr;
+    m_deferViolations = false;
+
+    for( const DRC_VIOLATION& violation : m_pendingViolations )
+        markers.push_back( newMarker( violation ) );
+
+    m_pendingViolations.clear();
+
+    // Show the markers of this test without waiting for the end of the DRC
+    addMarkersToPcb( markers );
+    m_pcbEditorFrame->GetCanvas()->Refresh();
+}
+
+
+void DRC::prepareTests()
+{
+    m_zoneNetPadCounts.clear();
+
+    for( int ii = 0; ii < m_pcb->GetAreaCount(); ii++ )
     {
-        if( aMessages )
-            aMessages->AppendText( _( "Checking zone fills...\n" ) );
+        int netcode = m_pcb->GetArea( ii )->GetNetCode();
 
-        m_toolMgr->GetTool<ZONE_FILLER_TOOL>()->CheckAllZones( caller );
+        if( netcode > 0 && !m_zoneNetPadCounts.count( netcode ) )
+            m_zoneNetPadCounts[ netcode ] = m_pcb->GetConnectivity()->GetPadCount( netcode );
     }
 
-    // test track and via clearances to other tracks, pads, and vias
-    if( aMessages )
+    // Several threads of a test would fill the same caches at once
+    for( MODULE* module : m_pcb->Modules() )
     {
-        aMessages->AppendText( _( "Track clearances...\n" ) );
-        wxSafeYield();
+        for( D_PAD* pad : module->Pads() )
+            pad->GetBoundingBox();
     }
+}
 
-    testTracks( aMessages ? aMessages->GetParent() : m_pcbEditorFrame, true );
 
-    // test zone clearances to other zones
-    if( aMessages )
+void DRC::RunTestsHeadless( BOARD* aBoard, MARKER_HANDLER aHandler,
+                            std::vector<STAGE_REPORT>& aReports )
+{
+    wxCHECK( aBoard && aHandler, /* void */ );
+
+    PROF_SCOPE profScope( "DRC" );
+
+    m_pcb = aBoard;
+    m_pcb->BuildNetClearances();
+
+    size_t markerCount = 0;
+
+    m_markerHandler = [&]( MARKER_PCB* aMarker )
     {
-        aMessages->AppendText( _( "Zone to zone clearances...\n" ) );
-        wxSafeYield();
-    }
+        markerCount++;
+        aHandler( aMarker );
+    };
+
+    auto runStage = [&]( const std::string& aName, size_t aItemCount,
+                         const std::function<void()>& aTest )
+    {
+        STAGE_REPORT report;
+
+        report.m_name = aName;
+        report.m_itemCount = aItemCount;
+        markerCount = 0;
+
+        {
+            SCOPED_PROF_COUNTER<std::chrono::microseconds> timer( report.m_duration );
+            PROF_SCOPE profScope( aName );
+            aTest();
+        }
+
+        report.m_errorCount = markerCount;
+        aReports.push_back( report );
+    };
+
+    prepareTests();
+
+    const size_t padCount = m_pcb->GetPadCount();
+    const size_t trackCount = m_pcb->Tracks().size();
+    const size_t zoneCount = m_pcb->GetAreaCount();
+
+    runStage( "outline", m_pcb->Drawings().size(), [&]() { testOutline(); } );
 
-    testZones();
+    bool netclassesOk = true;
 
-    // find and gather unconnected pads.
-    if( m_doUnconnectedTest )
+    runStage( "netclasses", m_pcb->GetDesignSettings().m_NetClasses.GetCount() + 1,
+              [&]() { netclassesOk = testNetClasses(); } );
+
+    // As in RunTests(), netclass errors would be reported again on every item
+    if( netclassesOk )
     {
-        if( aMessages )
+        if( m_doPad2PadTest )
+            runStage( "pad_clearances", padCount, [&]() { testPad2Pad(); } );
+
+        runStage( "drill_clearances", padCount + trackCount, [&]() { testDrilledHoles(); } );
+
+        runStage( "track_clearances", trackCount, [&]() { testTracks( nullptr, false ); } );
+
+        runStage( "zones", zoneCount, [&]() { testZones(); } );
+
+        if( m_doUnconnectedTest )
         {
-            aMessages->AppendText( _( "Unconnected pads...\n" ) );
-            aMessages->Refresh();
+            runStage( "unconnected", padCount + trackCount, [&]() { testUnconnected(); } );
+            aReports.back().m_errorCount += m_unconnected.size();
+        }
+
+        if( m_doKeepoutTest )
+            runStage( "keepout_areas", zoneCount, [&]() { testKeepoutAreas(); } );
+
+        runStage( "text_and_graphics", m_pcb->Drawings().size(),
+                  [&]() { testCopperTextAndGraphics(); } );
+
+        if( m_pcb->GetDesignSettings().m_ProhibitOverlappingCourtyards
+            || m_pcb->GetDesignSettings().m_RequireCourtyards )
+        {
+            runStage( "courtyards", m_pcb->Modules().size(),
+                      [&]() { doFootprintOverlappingDrc(); } );
         }
 
-        testUnconnected();
+        runStage( "disabled_layers", trackCount + m_pcb->Modules().size() + zoneCount,
+                  [&]() { testDisabledLayers(); } );
     }
 
-    // find and gather vias, tracks, pads inside keepout areas.
-    if( m_doKeepoutTest )
+    m_markerHandler = nullptr;
+    m_dirtyAreas.clear();
+}
+
+
+void DRC::MarkAreaDirty( const BOX2I& aArea )
+{
+    BOX2I area = aArea;
+    area.Normalize();
+    area.Inflate( board()->GetDesignSettings().GetBiggestClearanceValue() );
+
+    // Merge with an existing area when possible, to keep the region test short
+    for( BOX2I& dirty : m_dirtyAreas )
     {
-        if( aMessages )
+        if( dirty.Contains( area ) )
+            return;
+
+        if( area.Contains( dirty ) )
         {
-            aMessages->AppendText( _( "Keepout areas ...\n" ) );
-            aMessages->Refresh();
+            dirty = area;
+            return;
         }
+    }
+
+    m_dirtyAreas.push_back( area );
+}
+
 
-        testKeepoutAreas();
+bool DRC::intersectsDirtyArea( const BOX2I& aArea ) const
+{
+    for( const BOX2I& dirty : m_dirtyAreas )
+    {
+        if( dirty.Intersects( aArea ) )
+            return true;
     }
 
-    // find and gather vias, tracks, pads inside text boxes.
-    if( aMessages )
+    return false;
+}
+
+
+bool DRC::isInDirtyArea( const wxPoint& aPoint ) const
+{
+    for( const BOX2I& dirty : m_dirtyAreas )
     {
-        aMessages->AppendText( _( "Text and graphic clearances...\n" ) );
-        wxSafeYield();
+        if( dirty.Contains( aPoint ) )
+            return true;
     }
 
-    testCopperTextAndGraphics();
+    return false;
+}
 
-    // find overlapping courtyard ares.
-    if( m_pcb->GetDesignSettings().m_ProhibitOverlappingCourtyards
-        || m_pcb->GetDesignSettings().m_RequireCourtyards )
+
+void DRC::RunIncrementalTests()
+{
+    if( !m_pcbEditorFrame || m_dirtyAreas.empty() )
+        return;
+
+    m_pcb = m_pcbEditorFrame->GetBoard();
+    m_pcb->BuildNetClearances();
+
+    std::vector<MARKER_PCB*>    markers;
+    std::vector<DRC_VIOLATION> violations;
+
+    // The error codes of the tests run below: only their markers are replaced, the markers
+    // of the other tests stay until the next full DRC
+    std::set<int> testedCodes;
+
+    auto addTestedCodes = [&]( std::initializer_list<int> aCodes )
     {
-        if( aMessages )
+        testedCodes.insert( aCodes.begin(), aCodes.end() );
+    };
+
+    // The board outline is used by the track to board edge test
+    m_board_outlines.RemoveAllContours();
+    m_pcb->GetBoardPolygonOutlines( m_board_outlines );
+
+    // Tracks: test the tracks of the dirty region against all their neighbours
+    {
+        TRACKS&           tracks = m_pcb->Tracks();
+        std::vector<bool> refTracks( tracks.size(), false );
+
+        for( size_t ii = 0; ii < tracks.size(); ++ii )
+            refTracks[ii] = intersectsDirtyArea( tracks[ii]->GetBoundingBox() );
+
+        // The codes of doTrackDrc()
+        addTestedCodes( { DRCE_TOO_SMALL_MICROVIA, DRCE_TOO_SMALL_MICROVIA_DRILL,
+                          DRCE_TOO_SMALL_VIA, DRCE_TOO_SMALL_VIA_DRILL, DRCE_VIA_HOLE_BIGGER,
+                          DRCE_MICRO_VIA_NOT_ALLOWED, DRCE_BURIED_VIA_NOT_ALLOWED,
+                          DRCE_MICRO_VIA_INCORRECT_LAYER_PAIR, DRCE_TOO_SMALL_TRACK_WIDTH,
+                          DRCE_TRACK_NEAR_THROUGH_HOLE, DRCE_TRACK_NEAR_PAD, DRCE_VIA_NEAR_VIA,
+                          DRCE_VIA_NEAR_TRACK, DRCE_TRACK_NEAR_VIA, DRCE_TRACK_ENDS1,
+                          DRCE_TRACK_ENDS2, DRCE_TRACK_ENDS3, DRCE_TRACK_ENDS4,
+                          DRCE_TRACK_SEGMENTS_TOO_CLOSE, DRCE_TRACKS_CROSSING,
+                          DRCE_ENDS_PROBLEM1, DRCE_ENDS_PROBLEM2, DRCE_ENDS_PROBLEM3,
+                          DRCE_ENDS_PROBLEM4, DRCE_ENDS_PROBLEM5, DRCE_TRACK_NEAR_EDGE } );
+
+        if( m_doZonesTest )
+            addTestedCodes( { DRCE_TRACK_NEAR_ZONE } );
+
+        DRC_RTREE<size_t> trackTree;
+        buildTrackIndex( trackTree );
+
+        int                 maxClearance = m_pcb->GetDesignSettings().GetBiggestClearanceValue();
+        DRC_SEGM_CONTEXT    ctx;
+        std::vector<TRACK*> candidates;
+
+        for( size_t ii = 0; ii < tracks.size(); ++ii )
         {
-            aMessages->AppendText( _( "Courtyard areas...\n" ) );
-            aMessages->Refresh();
+            if( !refTracks[ii] )
+                continue;
+
+            collectTrackCandidates( trackTree, ii, maxClearance, candidates, &refTracks );
+            doTrackDrc( ctx, tracks[ii], candidates, m_doZonesTest, violations );
         }
 
-        doFootprintOverlappingDrc();
+        for( const DRC_VIOLATION& violation : violations )
+            markers.push_back( newMarker( violation ) );
     }
 
-    for( DRC_ITEM* footprintItem : m_footprints )
-        delete footprintItem;
+    // Pads: test the pads of the dirty region against all their neighbours
+    if( m_doPad2PadTest )
+    {
+        std::vector<D_PAD*> sortedPads;
 
-    m_footprints.clear();
-    m_footprintsTested = false;
+        m_pcb->GetSortedPadListByXthenYCoord( sortedPads );
+
+        std::vector<bool> refPads( sortedPads.size(), false );
+
+        for( size_t ii = 0; ii < sortedPads.size(); ++ii )
+            refPads[ii] = intersectsDirtyArea( sortedPads[ii]->GetBoundingBox() );
+
+        doPadListDrc( sortedPads, markers, &refPads );
+        addTestedCodes( { DRCE_HOLE_NEAR_PAD, DRCE_PAD_NEAR_PAD1 } );
+    }
 
-    if( m_testFootprints && !Kiface().IsSingle() )
+    // Zones
     {
-        if( aMessages )
+        std::vector<bool> refZones( m_pcb->GetAreaCount(), false );
+        bool              testZones = false;
+
+        for( int ii = 0; ii < m_pcb->GetAreaCount(); ii++ )
         {
-            aMessages->AppendText( _( "Checking footprints against schematic...\n" ) );
-            aMessages->Refresh();
+            ZONE_CONTAINER* zone = m_pcb->GetArea( ii );
+
+            if( zone->IsOnCopperLayer() && intersectsDirtyArea( zone->GetBoundingBox() ) )
+                refZones[ii] = testZones = true;
         }
 
-        NETLIST netlist;
-        m_pcbEditorFrame->FetchNetlistFromSchematic( netlist, PCB_EDIT_FRAME::ANNOTATION_DIALOG );
+        if( testZones )
+        {
+            std::vector<DRC_VIOLATION> zoneViolations;
 
-        if( m_drcDialog )
-            m_drcDialog->Raise();
+            doZoneToZoneOutlineDrc( refZones, &zoneViolations );
 
-        TestFootprints( netlist, m_pcb, m_drcDialog->GetUserUnits(), m_footprints );
-        m_footprintsTested = true;
+            for( const DRC_VIOLATION& violation : zoneViolations )
+                markers.push_back( newMarker( violation ) );
+        }
+
+        addTestedCodes( { DRCE_ZONES_INTERSECT, DRCE_ZONES_TOO_CLOSE } );
     }
 
-    // Check if there are items on disabled layers
-    testDisabledLayers();
+    // Courtyards: the provider tests the whole board, only the markers of the dirty
+    // region are kept below
+    if( m_pcb->GetDesignSettings().m_ProhibitOverlappingCourtyards
+        || m_pcb->GetDesignSettings().m_RequireCourtyards )
+    {
+        DRC_COURTYARD_OVERLAP drc_overlap(
+                m_markerFactory, [&]( MARKER_PCB* aMarker ) { markers.push_back( aMarker ); } );
 
-    if( aMessages )
+        drc_overlap.RunDRC( *m_pcb );
+        addTestedCodes( { DRCE_OVERLAPPING_FOOTPRINTS, DRCE_MISSING_COURTYARD_IN_FOOTPRINT,
+                          DRCE_MALFORMED_COURTYARD_IN_FOOTPRINT } );
+    }
+
+    // Replace the markers of the tests run above in the dirty region by the new ones
+    std::vector<MARKER_PCB*> oldMarkers;
+
+    for( int ii = 0; ii < m_pcb->GetMARKERCount(); ii++ )
     {
-        aMessages->AppendText( _( "Items on disabled layers...\n" ) );
-        aMessages->Refresh();
+        MARKER_PCB* marker = m_pcb->GetMARKER( ii );
+
+        if( isInDirtyArea( marker->GetPosition() )
+                && testedCodes.count( marker->GetReporter().GetErrorCode() ) )
+        {
+            oldMarkers.push_back( marker );
+        }
     }
 
-    m_drcRun = true;
+    if( !oldMarkers.empty() )
+    {
+        // Clear the selection: it can be one of the deleted markers
+        m_toolMgr->RunAction( PCB_ACTIONS::selectionClear, true );
 
-    // update the m_drcDialog listboxes
-    updatePointers();
+        for( MARKER_PCB* marker : oldMarkers )
+        {
+            view()->Remove( marker );
+            m_pcb->Delete( marker );
+        }
+    }
 
-    if( aMessages )
+    std::vector<MARKER_PCB*> newMarkers;
+
+    for( MARKER_PCB* marker : markers )
     {
-        // no newline on this one because it is last, don't want the window
-        // to unnecessarily scroll.
-        aMessages->AppendText( _( "Finished" ) );
+        if( isInDirtyArea( marker->GetPosition() ) )
+            newMarkers.push_back( marker );
+        else
+            delete marker;
+    }
+
+    // Clear the region before pushing the markers, the commit would run the tests again
+    m_dirtyAreas.clear();
+
+    if( !newMarkers.empty() )
+    {
+        BOARD_COMMIT commit( m_pcbEditorFrame );
+
+        for( MARKER_PCB* marker : newMarkers )
+            commit.Add( marker );
+
+        commit.Push( wxEmptyString, false, false );
     }
+
+    // update the m_drcDialog listboxes
+    updatePointers();
 }
 
 
@@ -542,7 +1167,7 @@ bool DRC::doNetClass( const NETCLASSPTR& nc, wxString& msg )
 
     const BOARD_DESIGN_SETTINGS& g = m_pcb->GetDesignSettings();
 
-#define FmtVal( x ) GetChars( StringFromValue( m_pcbEditorFrame->GetUserUnits(), x ) )
+#define FmtVal( x ) GetChars( StringFromValue( userUnits(), x ) )
 
 #if 0   // set to 1 when (if...) BOARD_DESIGN_SETTINGS has a m_MinClearance value
     if( nc->GetClearance() < g.m_MinClearance )
@@ -650,33 +1275,102 @@ void DRC::testPad2Pad()
 
     m_pcb->GetSortedPadListByXthenYCoord( sortedPads );
 
-    if( sortedPads.empty() )
+    std::vector<MARKER_PCB*> markers;
+
+    doPadListDrc( sortedPads, markers );
+
+    for( MARKER_PCB* marker : markers )
+        addMarkerToPcb( marker );
+}
+
+
+void DRC::doPadListDrc( const std::vector<D_PAD*>& aPads, std::vector<MARKER_PCB*>& aMarkers,
+                        const std::vector<bool>* aRefPads )
+{
+    if( aPads.empty() )
         return;
 
-    // find the max size of the pads (used to stop the test)
-    int max_size = 0;
+    const static LSET all_cu = LSET::AllCuMask();
+
+    // Index the pads by the area where they can collide with another pad.  This is the
+    // bounding circle used by checkClearancePadToPad() for its quick test, and the hole
+    // (which can be offset from the pad shape).  A hole is on all copper layers.
+    DRC_RTREE<size_t>  padTree;
+    std::vector<BOX2I> padAreas( aPads.size() );
+    std::vector<LSET>  padLayers( aPads.size() );
+    int                maxClearance = 0;
 
-    for( D_PAD* pad : sortedPads )
+    for( size_t ii = 0; ii < aPads.size(); ++ii )
     {
-        // GetBoundingRadius() is the radius of the minimum sized circle fully containing the pad
-        int radius = pad->GetBoundingRadius();
+        D_PAD*   pad = aPads[ii];
+        int      radius = pad->GetBoundingRadius();
+        VECTOR2I shapePos( pad->ShapePos() );
+        BOX2I    area( shapePos - VECTOR2I( radius, radius ), VECTOR2I( 2 * radius, 2 * radius ) );
+
+        if( pad->GetDrillSize().x )
+        {
+            int      holeRadius = std::max( pad->GetDrillSize().x, pad->GetDrillSize().y ) / 2;
+            VECTOR2I holePos( pad->GetPosition() );
+
+            area.Merge( BOX2I( holePos - VECTOR2I( holeRadius, holeRadius ),
+                               VECTOR2I( 2 * holeRadius, 2 * holeRadius ) ) );
+            padLayers[ii] = all_cu;
+        }
+        else
+        {
+            padLayers[ii] = pad->GetLayerSet() & all_cu;
+        }
+
+        padAreas[ii] = area;
+        maxClearance = std::max( maxClearance, pad->GetClearance() );
 
-        if( radius > max_size )
-            max_size = radius;
+        padTree.Insert( ii, area, padLayers[ii] );
     }
 
-    // Upper limit of pad list (limit not included)
-    D_PAD** listEnd = &sortedPads[0] + sortedPads.size();
+    std::vector<size_t> found;
+    std::vector<D_PAD*> candidates;
 
-    // Test the pads
-    for( auto& pad : sortedPads )
+    for( size_t ii = 0; ii < aPads.size() && !m_cancelled; ++ii )
     {
-        int x_limit = pad->GetClearance() + pad->GetBoundingRadius() + pad->GetPosition().x;
+        if( aRefPads && !(*aRefPads)[ii] )
+            continue;
+
+        // Each pair of reference pads is tested once, other pads are tested against all
+        // the reference pads
+        BOX2I area = padAreas[ii];
+        area.Inflate( maxClearance );
+
+        found.clear();
+
+        padTree.Query( area, padLayers[ii],
+                [&]( const size_t& aIdx ) -> bool
+                {
+                    bool isRef = !aRefPads || (*aRefPads)[aIdx];
+
+                    if( aIdx > ii || ( aIdx < ii && !isRef ) )
+                        found.push_back( aIdx );
+
+                    return true;
+                } );
+
+        // Keep the list order, so markers do not depend on the tree layout
+        std::sort( found.begin(), found.end() );
+        found.erase( std::unique( found.begin(), found.end() ), found.end() );
+
+        candidates.clear();
+
+        for( size_t idx : found )
+            candidates.push_back( aPads[idx] );
+
+        if( candidates.empty() )
+            continue;
 
-        if( !doPadToPadsDrc( pad, &pad, listEnd, max_size + x_limit ) )
+        D_PAD** listStart = &candidates[0];
+
+        if( !doPadToPadsDrc( aPads[ii], listStart, listStart + candidates.size() ) )
         {
             wxASSERT( m_currentMarker );
-            addMarkerToPcb ( m_currentMarker );
+            aMarkers.push_back( m_currentMarker );
             m_currentMarker = nullptr;
         }
     }
@@ -746,7 +1440,7 @@ void DRC::testDrilledHoles()
             if( KiROUND( GetLineLength( checkHole.m_location, refHole.m_location ) )
                     <  checkHole.m_drillRadius + refHole.m_drillRadius + holeToHoleMin )
             {
-                addMarkerToPcb( new MARKER_PCB( m_pcbEditorFrame->GetUserUnits(),
+                addMarkerToPcb( new MARKER_PCB( userUnits(),
                                                 DRCE_DRILLED_HOLES_TOO_CLOSE, refHole.m_location,
                                                 refHole.m_owner, refHole.m_location,
                                                 checkHole.m_owner, checkHole.m_location ) );
@@ -758,6 +1452,13 @@ void DRC::testDrilledHoles()
 
 void DRC::testTracks( wxWindow *aActiveWindow, bool aShowProgressBar )
 {
+    if( m_parallelTrackTest
+            && THREAD_POOL::GetPool().GetThreadCount( ADVANCED_CFG::GetCfg().m_maxDrcThreads ) > 1 )
+    {
+        testTracksParallel( aActiveWindow, aShowProgressBar );
+        return;
+    }
+
     wxProgressDialog * progressDialog = NULL;
     const int delta = 500;  // This is the number of tests between 2 calls to the
                             // progress bar
@@ -778,8 +1479,23 @@ void DRC::testTracks( wxWindow *aActiveWindow, bool aShowProgressBar )
     int ii = 0;
     count = 0;
 
-    for( auto seg_it = m_pcb->Tracks().begin(); seg_it != m_pcb->Tracks().end(); seg_it++ )
+    DRC_RTREE<size_t> trackTree;
+    buildTrackIndex( trackTree );
+
+    int maxClearance = m_pcb->GetDesignSettings().GetBiggestClearanceValue();
+
+    DRC_SEGM_CONTEXT           ctx;
+    std::vector<TRACK*>        candidates;
+    std::vector<DRC_VIOLATION> violations;
+
+    if( m_progressReporter )
+        m_progressReporter->SetMaxProgress( m_pcb->Tracks().size() );
+
+    for( size_t idx = 0; idx < m_pcb->Tracks().size() && !m_cancelled; idx++ )
     {
+        if( m_progressReporter )
+            m_progressReporter->AdvanceProgress();
+
         if( ii++ > delta )
         {
             ii = 0;
@@ -797,19 +1513,111 @@ void DRC::testTracks( wxWindow *aActiveWindow, bool aShowProgressBar )
             }
         }
 
+        collectTrackCandidates( trackTree, idx, maxClearance, candidates );
+
         // Test new segment against tracks and pads, optionally against copper zones
-        if( !doTrackDrc( *seg_it, seg_it + 1, m_pcb->Tracks().end(), m_doZonesTest ) )
+        if( !doTrackDrc( ctx, m_pcb->Tracks()[idx], candidates, m_doZonesTest, violations ) )
         {
-            if( m_currentMarker )
-            {
-                addMarkerToPcb ( m_currentMarker );
-                m_currentMarker = nullptr;
-            }
+            addViolationsToPcb( violations );
+            violations.clear();
+        }
+    }
+
+    if( progressDialog )
+        progressDialog->Destroy();
+}
+
+
+void DRC::testTracksParallel( wxWindow *aActiveWindow, bool aShowProgressBar )
+{
+    TRACKS&             tracks = m_pcb->Tracks();
+    size_t              count = tracks.size();
+
+    // Problems found for each reference track, merged in track order when all threads are done
+    std::vector<std::vector<DRC_VIOLATION>> trackViolations( count );
+
+    DRC_RTREE<size_t> trackTree;
+    buildTrackIndex( trackTree );
+
+    int maxClearance = m_pcb->GetDesignSettings().GetBiggestClearanceValue();
+
+    // The tracks are tested by chunks, each with its own context
+    const size_t        TRACKS_PER_CHUNK = 32;
+    size_t              chunkCount = ( count + TRACKS_PER_CHUNK - 1 ) / TRACKS_PER_CHUNK;
+    std::atomic<size_t> doneCount( 0 );
+    std::atomic<bool>   cancelled( false );
+
+    if( m_progressReporter )
+        m_progressReporter->SetMaxProgress( count );
+
+    auto drc_lambda = [&]( size_t aChunk )
+    {
+        DRC_SEGM_CONTEXT    ctx;
+        std::vector<TRACK*> candidates;
+        size_t              last = std::min( count, ( aChunk + 1 ) * TRACKS_PER_CHUNK );
+        size_t              num = 0;
+
+        for( size_t i = aChunk * TRACKS_PER_CHUNK; i < last && !cancelled && !m_cancelled; ++i )
+        {
+            collectTrackCandidates( trackTree, i, maxClearance, candidates );
+
+            // Test new segment against tracks and pads, optionally against copper zones
+            doTrackDrc( ctx, tracks[i], candidates, m_doZonesTest, trackViolations[i] );
+
+            num++;
         }
+
+        doneCount += num;
+
+        if( m_progressReporter )
+            m_progressReporter->AdvanceProgress( num );
+    };
+
+    wxProgressDialog * progressDialog = NULL;
+    const int delta = 500;  // This is the number of tests between 2 updates of the
+                            // progress bar
+    int deltamax = count/delta;
+
+    if( aShowProgressBar && deltamax > 3 )
+    {
+        // Do not use wxPD_APP_MODAL style here: it is not necessary and create issues
+        // on OSX
+        progressDialog = new wxProgressDialog( _( "Track clearances" ), wxEmptyString,
+                                               deltamax, aActiveWindow,
+                                               wxPD_AUTO_HIDE | wxPD_CAN_ABORT | wxPD_ELAPSED_TIME );
+        progressDialog->Update( 0, wxEmptyString );
     }
 
+    // The progress dialog is updated about every 100ms while the pool runs the test
+    THREAD_POOL::GetPool().ParallelFor( chunkCount, drc_lambda, 1,
+            ADVANCED_CFG::GetCfg().m_maxDrcThreads,
+            [&]()
+            {
+                if( progressDialog && !cancelled )
+                {
+                    if( !progressDialog->Update( std::min<int>( doneCount / delta, deltamax ),
+                                                 wxEmptyString ) )
+                        cancelled = true;   // Aborted by user
+                }
+            } );
+
     if( progressDialog )
+    {
+#ifdef __WXMAC__
+        // Work around a dialog z-order issue on OS X
+        aActiveWindow->Raise();
+#endif
         progressDialog->Destroy();
+    }
+
+    // Tracks not reached before a cancel have no problems: as in the single thread test,
+    // only the tracks tested before the cancel are reported.
+    std::vector<DRC_VIOLATION> allViolations;
+
+    for( std::vector<DRC_VIOLATION>& violations : trackViolations )
+        allViolations.insert( allViolations.end(), violations.begin(), violations.end() );
+
+    addViolationsToPcb( allViolations );
 }
 
 
@@ -834,7 +1642,7 @@ void DRC::testUnconnected()
         auto src = edge.GetSourcePos();
         auto dst = edge.GetTargetPos();
 
-        m_unconnected.emplace_back( new DRC_ITEM( m_pcbEditorFrame->GetUserUnits(),
+        m_unconnected.emplace_back( new DRC_ITEM( userUnits(),
                                                   DRCE_UNCONNECTED_ITEMS,
                                                   edge.GetSourceNode()->Parent(),
                                                   wxPoint( src.x, src.y ),
@@ -865,7 +1673,13 @@ void DRC::testZones()
         // a netcode < 0 or > 0 and no pad in net  is a error or strange
         // perhaps a "dead" net, which happens when all pads in this net were removed
         // Remark: a netcode < 0 should not happen (this is more a bug somewhere)
-        int pads_in_net = ( netcode > 0 ) ? m_pcb->GetConnectivity()->GetPadCount( netcode ) : 1;
+        int pads_in_net = 1;
+
+        if( netcode > 0 )
+        {
+            auto it = m_zoneNetPadCounts.find( netcode );
+            pads_in_net = it != m_zoneNetPadCounts.end() ? it->second : 0;
+        }
 
         if( ( netcode < 0 ) || pads_in_net == 0 )
         {
@@ -927,31 +1741,128 @@ void DRC::testKeepoutAreas()
 }
 
 
+bool DRC_TEXT_SHAPE::IsValidFor( const EDA_TEXT* aText ) const
+{
+    return m_valid
+        && m_text == aText->GetShownText()
+        && m_pos == aText->GetTextPos()
+        && m_angle == aText->GetTextAngle()
+        && m_size == aText->GetTextSize()
+        && m_thickness == aText->GetThickness()
+        && m_mirrored == aText->IsMirrored()
+        && m_italic == aText->IsItalic()
+        && m_multiline == aText->IsMultilineAllowed()
+        && m_hJustify == aText->GetHorizJustify()
+        && m_vJustify == aText->GetVertJustify();
+}
+
+
+void DRC_TEXT_SHAPE::Build( const EDA_TEXT* aText )
+{
+    m_text = aText->GetShownText();
+    m_pos = aText->GetTextPos();
+    m_angle = aText->GetTextAngle();
+    m_size = aText->GetTextSize();
+    m_thickness = aText->GetThickness();
+    m_mirrored = aText->IsMirrored();
+    m_italic = aText->IsItalic();
+    m_multiline = aText->IsMultilineAllowed();
+    m_hJustify = aText->GetHorizJustify();
+    m_vJustify = aText->GetVertJustify();
+
+    m_segments.clear();
+    aText->TransformTextShapeToSegmentList( m_segments );
+    m_bbox = aText->GetTextBox();
+    m_valid = true;
+}
+
+
+void DRC_COPPER_INDEX::Query( const DRC_RTREE<size_t>& aTree, const BOX2I& aArea,
+                              PCB_LAYER_ID aLayer, std::vector<size_t>& aFound ) const
+{
+    aFound.clear();
+
+    aTree.Query( aArea, LSET( aLayer ),
+                 [&]( const size_t& aIdx ) -> bool
+                 {
+                     aFound.push_back( aIdx );
+                     return true;
+                 } );
+
+    // Keep the board order, so markers do not depend on the tree layout
+    std::sort( aFound.begin(), aFound.end() );
+}
+
+
 void DRC::testCopperTextAndGraphics()
 {
     // Test copper items for clearance violations with vias, tracks and pads
+    DRC_COPPER_INDEX index;
+
+    buildTrackIndex( index.m_tracks );
+
+    index.m_pads = m_pcb->GetPads();
+    // The pads can have a local clearance bigger than the net class ones
+    index.m_maxClearance = m_pcb->GetBiggestClearanceValue();
+
+    for( size_t ii = 0; ii < index.m_pads.size(); ++ii )
+    {
+        D_PAD*   pad = index.m_pads[ii];
+        int      radius = pad->GetBoundingRadius();
+        VECTOR2I shapePos( pad->ShapePos() );
+
+        index.m_padTree.Insert( ii, BOX2I( shapePos - VECTOR2I( radius, radius ),
+                                           VECTOR2I( 2 * radius, 2 * radius ) ),
+                                pad->GetLayerSet() );
+    }
+
+    // Only keep the shapes of the texts which still exist
+    std::map<const EDA_TEXT*, DRC_TEXT_SHAPE> previousShapes;
+    previousShapes.swap( m_textShapes );
+
+    auto testText =
+            [&]( BOARD_ITEM* aTextItem )
+            {
+                EDA_TEXT* text = dynamic_cast<EDA_TEXT*>( aTextItem );
+
+                if( !text )
+                    return;
+
+                auto it = previousShapes.find( text );
+
+                if( it != previousShapes.end() )
+                    m_textShapes[text] = std::move( it->second );
+
+                testCopperTextItem( aTextItem, index );
+            };
 
     for( BOARD_ITEM* brdItem : m_pcb->Drawings() )
     {
+        if( m_cancelled )
+            return;
+
         if( IsCopperLayer( brdItem->GetLayer() ) )
         {
             if( brdItem->Type() == PCB_TEXT_T )
-                testCopperTextItem( brdItem );
+                testText( brdItem );
             else if( brdItem->Type() == PCB_LINE_T )
-                testCopperDrawItem( static_cast<DRAWSEGMENT*>( brdItem ));
+                testCopperDrawItem( static_cast<DRAWSEGMENT*>( brdItem ), index );
         }
     }
 
     for( MODULE* module : m_pcb->Modules() )
     {
+        if( m_cancelled )
+            return;
+
         TEXTE_MODULE& ref = module->Reference();
         TEXTE_MODULE& val = module->Value();
 
         if( ref.IsVisible() && IsCopperLayer( ref.GetLayer() ) )
-            testCopperTextItem( &ref );
+            testText( &ref );
 
         if( val.IsVisible() && IsCopperLayer( val.GetLayer() ) )
-            testCopperTextItem( &val );
+            testText( &val );
 
         if( module->IsNetTie() )
             continue;
@@ -961,16 +1872,16 @@ void DRC::testCopperTextAndGraphics()
             if( IsCopperLayer( item->GetLayer() ) )
             {
                 if( item->Type() == PCB_MODULE_TEXT_T && ( (TEXTE_MODULE*) item )->IsVisible() )
-                    testCopperTextItem( item );
+                    testText( item );
                 else if( item->Type() == PCB_MODULE_EDGE_T )
-                    testCopperDrawItem( static_cast<DRAWSEGMENT*>( item ));
+                    testCopperDrawItem( static_cast<DRAWSEGMENT*>( item ), index );
             }
         }
     }
 }
 
 
-void DRC::testCopperDrawItem( DRAWSEGMENT* aItem )
+void DRC::testCopperDrawItem( DRAWSEGMENT* aItem, const DRC_COPPER_INDEX& aIndex )
 {
     std::vector<SEG> itemShape;
     int itemWidth = aItem->GetWidth();
@@ -1025,13 +1936,29 @@ void DRC::testCopperDrawItem( DRAWSEGMENT* aItem )
         break;
     }
 
-    // Test tracks and vias
-    for( auto track : m_pcb->Tracks() )
+    if( itemShape.empty() )
+        return;
+
+    // Only the items closer than the biggest clearance to the shape can be in conflict
+    BOX2I area( itemShape[0].A, VECTOR2I( 0, 0 ) );
+
+    for( const SEG& itemSeg : itemShape )
     {
-        if( !track->IsOnLayer( aItem->GetLayer() ) )
-            continue;
+        area.Merge( itemSeg.A );
+        area.Merge( itemSeg.B );
+    }
+
+    area.Inflate( itemWidth + aIndex.m_maxClearance );
 
-        int minDist = ( track->GetWidth() + itemWidth ) / 2 + track->GetClearance( NULL );
+    std::vector<size_t> found;
+
+    // Test tracks and vias
+    aIndex.Query( aIndex.m_tracks, area, aItem->GetLayer(), found );
+
+    for( size_t idx : found )
+    {
+        TRACK* track = m_pcb->Tracks()[idx];
+        int    minDist = ( track->GetWidth() + itemWidth ) / 2 + track->GetClearance( NULL );
         SEG trackAsSeg( track->GetStart(), track->GetEnd() );
 
         for( const auto& itemSeg : itemShape )
@@ -1050,10 +1977,11 @@ void DRC::testCopperDrawItem( DRAWSEGMENT* aItem )
     }
 
     // Test pads
-    for( auto pad : m_pcb->GetPads() )
+    aIndex.Query( aIndex.m_padTree, area, aItem->GetLayer(), found );
+
+    for( size_t idx : found )
     {
-        if( !pad->IsOnLayer( aItem->GetLayer() ) )
-            continue;
+        D_PAD* pad = aIndex.m_pads[idx];
 
         // Graphic items are allowed to act as net-ties within their own footprint
         if( pad->GetParent() == aItem->GetParent() )
@@ -1074,32 +2002,42 @@ void DRC::testCopperDrawItem( DRAWSEGMENT* aItem )
 }
 
 
-void DRC::testCopperTextItem( BOARD_ITEM* aTextItem )
+void DRC::testCopperTextItem( BOARD_ITEM* aTextItem, const DRC_COPPER_INDEX& aIndex )
 {
     EDA_TEXT* text = dynamic_cast<EDA_TEXT*>( aTextItem );
 
     if( text == nullptr )
         return;
 
-    std::vector<wxPoint> textShape;      // a buffer to store the text shape (set of segments)
-    int textWidth = text->GetThickness();
+    // Stroking the text is the slow part of the test: the stroke segments are kept
+    // until the text is changed
+    DRC_TEXT_SHAPE& shape = m_textShapes[text];
 
-    // So far the bounding box makes up the text-area
-    text->TransformTextShapeToSegmentList( textShape );
+    if( !shape.IsValidFor( text ) )
+        shape.Build( text );
+
+    const std::vector<wxPoint>& textShape = shape.m_segments;  // the text shape (set of segments)
+    int textWidth = text->GetThickness();
 
     if( textShape.size() == 0 )     // Should not happen (empty text?)
         return;
 
-    EDA_RECT bbox = text->GetTextBox();
+    // So far the bounding box makes up the text-area
+    const EDA_RECT& bbox = shape.m_bbox;
     SHAPE_RECT rect_area( bbox.GetX(), bbox.GetY(), bbox.GetWidth(), bbox.GetHeight() );
 
+    BOX2I area = bbox;
+    area.Inflate( textWidth + aIndex.m_maxClearance );
+
+    std::vector<size_t> found;
+
     // Test tracks and vias
-    for( auto track : m_pcb->Tracks() )
-    {
-        if( !track->IsOnLayer( aTextItem->GetLayer() ) )
-            continue;
+    aIndex.Query( aIndex.m_tracks, area, aTextItem->GetLayer(), found );
 
-        int minDist = ( track->GetWidth() + textWidth ) / 2 + track->GetClearance( NULL );
+    for( size_t idx : found )
+    {
+        TRACK* track = m_pcb->Tracks()[idx];
+        int    minDist = ( track->GetWidth() + textWidth ) / 2 + track->GetClearance( NULL );
         SEG trackAsSeg( track->GetStart(), track->GetEnd() );
 
         // Fast test to detect a trach segment candidate inside the text bounding box
@@ -1124,10 +2062,11 @@ void DRC::testCopperTextItem( BOARD_ITEM* aTextItem )
     }
 
     // Test pads
-    for( auto pad : m_pcb->GetPads() )
+    aIndex.Query( aIndex.m_padTree, area, aTextItem->GetLayer(), found );
+
+    for( size_t idx : found )
     {
-        if( !pad->IsOnLayer( aTextItem->GetLayer() ) )
-            continue;
+        D_PAD* pad = aIndex.m_pads[idx];
 
         // Fast test to detect a pad candidate inside the text bounding box
         // Finer test (time consumming) is made only for pads near the text.
@@ -1172,7 +2111,7 @@ void DRC::testOutline()
 
 void DRC::testDisabledLayers()
 {
-    BOARD* board = m_pcbEditorFrame->GetBoard();
+    BOARD* board = m_pcb;
     wxCHECK( board, /*void*/ );
     LSET disabledLayers = board->GetEnabledLayers().flip();
 
@@ -1207,7 +2146,7 @@ void DRC::testDisabledLayers()
 }
 
 
-bool DRC::doPadToPadsDrc( D_PAD* aRefPad, D_PAD** aStart, D_PAD** aEnd, int x_limit )
+bool DRC::doPadToPadsDrc( D_PAD* aRefPad, D_PAD** aStart, D_PAD** aEnd )
 {
     const static LSET all_cu = LSET::AllCuMask();
 
@@ -1230,6 +2169,8 @@ bool DRC::doPadToPadsDrc( D_PAD* aRefPad, D_PAD** aStart, D_PAD** aEnd, int x_li
     // (a value = 0 means use netclass value)
     dummypad.SetLocalClearance( 1 );
 
+    DRC_SEGM_CONTEXT ctx;
+
     for( D_PAD** pad_list = aStart;  pad_list<aEnd;  ++pad_list )
     {
         D_PAD* pad = *pad_list;
@@ -1237,11 +2178,6 @@ bool DRC::doPadToPadsDrc( D_PAD* aRefPad, D_PAD** aStart, D_PAD** aEnd, int x_li
         if( pad == aRefPad )
             continue;
 
-        // We can stop the test when pad->GetPosition().x > x_limit
-        // because the list is sorted by X values
-        if( pad->GetPosition().x > x_limit )
-            break;
-
         // No problem if pads which are on copper layers are on different copper layers,
         // (pads can be only on a technical layer, to build complex pads)
         // but their hole (if any ) can create DRC error because they are on all
@@ -1276,7 +2212,7 @@ bool DRC::doPadToPadsDrc( D_PAD* aRefPad, D_PAD** aStart, D_PAD** aEnd, int x_li
                                                            PAD_SHAPE_OVAL : PAD_SHAPE_CIRCLE );
                 dummypad.SetOrientation( pad->GetOrientation() );
 
-                if( !checkClearancePadToPad( aRefPad, &dummypad ) )
+                if( !ctx.checkClearancePadToPad( aRefPad, &dummypad ) )
                 {
                     // here we have a drc error on pad!
                     m_currentMarker = m_markerFactory.NewMarker( pad, aRefPad, DRCE_HOLE_NEAR_PAD );
@@ -1292,7 +2228,7 @@ bool DRC::doPadToPadsDrc( D_PAD* aRefPad, D_PAD** aStart, D_PAD** aEnd, int x_li
                                                                PAD_SHAPE_OVAL : PAD_SHAPE_CIRCLE );
                 dummypad.SetOrientation( aRefPad->GetOrientation() );
 
-                if( !checkClearancePadToPad( pad, &dummypad ) )
+                if( !ctx.checkClearancePadToPad( pad, &dummypad ) )
                 {
                     // here we have a drc error on aRefPad!
                     m_currentMarker = m_markerFactory.NewMarker( aRefPad, pad, DRCE_HOLE_NEAR_PAD );
@@ -1327,7 +2263,7 @@ bool DRC::doPadToPadsDrc( D_PAD* aRefPad, D_PAD** aStart, D_PAD** aEnd, int x_li
             continue;
         }
 
-        if( !checkClearancePadToPad( aRefPad, pad ) )
+        if( !ctx.checkClearancePadToPad( aRefPad, pad ) )
         {
             // here we have a drc error!
             m_currentMarker = m_markerFactory.NewMarker( aRefPad, pad, DRCE_PAD_NEAR_PAD1 );
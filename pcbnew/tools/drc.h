@@ -27,12 +27,20 @@
 
 #include <class_board.h>
 #include <class_track.h>
+#include <eda_text.h>
 #include <geometry/seg.h>
 #include <geometry/shape_poly_set.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 #include <tools/pcb_tool_base.h>
 #include <drc/drc_marker_factory.h>
+#include <drc/drc_rtree.h>
 
 #define OK_DRC  0
 #define BAD_DRC 1
@@ -127,6 +135,7 @@ class NETLIST;
 class wxWindow;
 class wxString;
 class wxTextCtrl;
+class PROGRESS_REPORTER;
 
 
 /**
@@ -175,6 +184,210 @@ public:
 typedef std::vector<DRC_ITEM*> DRC_LIST;
 
 
+/**
+ * Working state of the segment relative clearance tests.
+ *
+ * In DRC functions, many calculations are using coordinates relative to the position of
+ * the segment under test (segm to segm DRC, segm to pad DRC).  This state used to live in
+ * the DRC tool itself; it is kept apart so that each thread testing tracks can own its
+ * context.
+ */
+class DRC_SEGM_CONTEXT
+{
+public:
+    DRC_SEGM_CONTEXT() :
+        m_segmAngle( 0 ),
+        m_segmLength( 0 ),
+        m_xcliplo( 0 ),
+        m_ycliplo( 0 ),
+        m_xcliphi( 0 ),
+        m_ycliphi( 0 )
+    {
+    }
+
+    /* Next variables store coordinates relative to the start point of the segment
+     */
+    wxPoint m_padToTestPos; // Position of the pad to compare in drc test segm to pad or pad to pad
+    wxPoint m_segmEnd;      // End point of the reference segment (start point = (0,0) )
+
+    /* Some functions are comparing the ref segm to pads or others segments using
+     * coordinates relative to the ref segment considered as the X axis
+     * so we store the ref segment length (the end point relative to these axis)
+     * and the segment orientation (used to rotate other coordinates)
+     */
+    double m_segmAngle;     // Ref segm orientation in 0,1 degre
+    int m_segmLength;       // length of the reference segment
+
+    /* variables used in checkLine to test DRC segm to segm:
+     * define the area relative to the ref segment that does not contains any other segment
+     */
+    int                 m_xcliplo;
+    int                 m_ycliplo;
+    int                 m_xcliphi;
+    int                 m_ycliphi;
+
+    /**
+     * @param aRefPad The reference pad to check
+     * @param aPad Another pad to check against
+     * @return bool - true if clearance between aRefPad and aPad is >= dist_min, else false
+     */
+    bool checkClearancePadToPad( D_PAD* aRefPad, D_PAD* aPad );
+
+
+    /**
+     * Check the distance from a pad to segment.  This function uses several
+     * instance variable not passed in:
+     *      m_segmLength = length of the segment being tested
+     *      m_segmAngle  = angle of the segment with the X axis;
+     *      m_segmEnd    = end coordinate of the segment
+     *      m_padToTestPos = position of pad relative to the origin of segment
+     * @param aPad Is the pad involved in the check
+     * @param aSegmentWidth width of the segment to test
+     * @param aMinDist Is the minimum clearance needed
+     *
+     * @return true distance >= dist_min,
+     *         false if distance < dist_min
+     */
+    bool checkClearanceSegmToPad( const D_PAD* aPad, int aSegmentWidth, int aMinDist );
+
+
+    /**
+     * Check the distance from a point to a segment.
+     *
+     * The segment is expected starting at 0,0, and on the X axis
+     * (used to test DRC between a segment and a round pad, via or round end of a track
+     * @param aCentre The coordinate of the circle's center
+     * @param aRadius A "keep out" radius centered over the circle
+     * @param aLength The length of the segment (i.e. coordinate of end, because it is on
+     *                the X axis)
+     * @return bool - true if distance >= radius, else
+     *                false when distance < aRadius
+     */
+    static bool checkMarginToCircle( wxPoint aCentre, int aRadius, int aLength );
+
+
+    /**
+     * Function checkLine
+     * (helper function used in drc calculations to see if one track is in contact with
+     *  another track).
+     * Test if a line intersects a bounding box (a rectangle)
+     * The rectangle is defined by m_xcliplo, m_ycliplo and m_xcliphi, m_ycliphi
+     * return true if the line from aSegStart to aSegEnd is outside the bounding box
+     */
+    bool checkLine( wxPoint aSegStart, wxPoint aSegEnd );
+};
+
+
+/**
+ * Stroke segments of a copper text, used by the text to copper clearance test.
+ *
+ * Stroking a text is slow, so the segments are kept as long as the text content and
+ * transform are unchanged.
+ */
+class DRC_TEXT_SHAPE
+{
+public:
+    DRC_TEXT_SHAPE() :
+        m_angle( 0.0 ),
+        m_thickness( 0 ),
+        m_mirrored( false ),
+        m_italic( false ),
+        m_multiline( false ),
+        m_hJustify( GR_TEXT_HJUSTIFY_CENTER ),
+        m_vJustify( GR_TEXT_VJUSTIFY_CENTER ),
+        m_valid( false )
+    {
+    }
+
+    ///> @return true if the segments are the current shape of aText
+    bool IsValidFor( const EDA_TEXT* aText ) const;
+
+    ///> Strokes aText and remembers its content and transform
+    void Build( const EDA_TEXT* aText );
+
+    std::vector<wxPoint> m_segments;    ///< ends of the stroke segments, two by two
+    EDA_RECT             m_bbox;        ///< the text box
+
+private:
+    wxString             m_text;
+    wxPoint              m_pos;
+    double               m_angle;
+    wxSize               m_size;
+    int                  m_thickness;
+    bool                 m_mirrored;
+    bool                 m_italic;
+    bool                 m_multiline;
+    EDA_TEXT_HJUSTIFY_T  m_hJustify;
+    EDA_TEXT_VJUSTIFY_T  m_vJustify;
+    bool                 m_valid;
+};
+
+
+/**
+ * A problem found by the track tests, which can run on several threads.  It only records
+ * the items and positions: its marker, whose messages are translated and formatted in the
+ * user units, is built on the main thread by DRC::newMarker().
+ */
+struct DRC_VIOLATION
+{
+    enum KIND
+    {
+        AT_POSITION,    ///< m_position, m_item and the optional m_conflictItem
+        ON_SEGMENT,     ///< m_track, m_conflictItem and m_conflictSeg
+        WITH_ZONE       ///< m_track and m_conflictItem, a zone
+    };
+
+    KIND        m_kind;
+    int         m_errorCode;
+    wxPoint     m_position;
+    bool        m_forcePosition;    ///< the marker of an ON_SEGMENT problem is at m_position
+    BOARD_ITEM* m_item;
+    TRACK*      m_track;
+    BOARD_ITEM* m_conflictItem;
+    SEG         m_conflictSeg;
+
+    static DRC_VIOLATION AtPosition( const wxPoint& aPos, BOARD_ITEM* aItem,
+                                     BOARD_ITEM* aConflictItem, int aErrorCode )
+    {
+        return { AT_POSITION, aErrorCode, aPos, false, aItem, nullptr, aConflictItem, SEG() };
+    }
+
+    static DRC_VIOLATION OnSegment( TRACK* aTrack, BOARD_ITEM* aConflictItem,
+                                    const SEG& aConflictSeg, int aErrorCode )
+    {
+        return { ON_SEGMENT, aErrorCode, wxPoint(), false, nullptr, aTrack, aConflictItem,
+                 aConflictSeg };
+    }
+
+    static DRC_VIOLATION WithZone( TRACK* aTrack, ZONE_CONTAINER* aZone, int aErrorCode );
+};
+
+
+/**
+ * Spatial index of the board tracks and pads, used to find the copper items near a
+ * text or a graphic item.
+ */
+struct DRC_COPPER_INDEX
+{
+    DRC_COPPER_INDEX() :
+        m_maxClearance( 0 )
+    {
+    }
+
+    DRC_RTREE<size_t>   m_tracks;       ///< indexes in BOARD::Tracks()
+    DRC_RTREE<size_t>   m_padTree;      ///< indexes in m_pads
+    std::vector<D_PAD*> m_pads;
+    int                 m_maxClearance; ///< the biggest clearance of the board, pads included
+
+    /**
+     * Collect the items of aTree on aLayer whose bounding box intersects aArea,
+     * in board order.
+     */
+    void Query( const DRC_RTREE<size_t>& aTree, const BOX2I& aArea, PCB_LAYER_ID aLayer,
+                std::vector<size_t>& aFound ) const;
+};
+
+
 /**
  * Design Rule Checker object that performs all the DRC tests.  The output of
  * the checking goes to the BOARD file in the form of two MARKER lists.  Those
@@ -194,6 +407,20 @@ public:
     /// @copydoc TOOL_INTERACTIVE::Reset()
     void Reset( RESET_REASON aReason ) override;
 
+    /// A callable taking the ownership of a DRC marker
+    typedef std::function<void( MARKER_PCB* )> MARKER_HANDLER;
+
+    /**
+     * The result of one test of RunTestsHeadless().
+     */
+    struct STAGE_REPORT
+    {
+        std::string               m_name;       ///< name of the test, usable as a key
+        size_t                    m_itemCount;  ///< number of items handled by the test
+        size_t                    m_errorCount; ///< markers and unconnected items found
+        std::chrono::microseconds m_duration;   ///< wall-clock time of the test
+    };
+
 private:
 
     //  protected or private functions() are lowercase first character.
@@ -205,33 +432,12 @@ private:
     bool     m_refillZones;             // refill zones if requested (by user).
     bool     m_reportAllTrackErrors;    // Report all tracks errors (or only 4 first errors)
     bool     m_testFootprints;          // Test footprints against schematic
+    bool     m_parallelTrackTest;       // Run the track clearance tests on several threads
 
     wxString m_rptFilename;
 
     MARKER_PCB* m_currentMarker;
 
-    /* In DRC functions, many calculations are using coordinates relative
-     * to the position of the segment under test (segm to segm DRC, segm to pad DRC
-     * Next variables store coordinates relative to the start point of this segment
-     */
-    wxPoint m_padToTestPos; // Position of the pad to compare in drc test segm to pad or pad to pad
-    wxPoint m_segmEnd;      // End point of the reference segment (start point = (0,0) )
-
-    /* Some functions are comparing the ref segm to pads or others segments using
-     * coordinates relative to the ref segment considered as the X axis
-     * so we store the ref segment length (the end point relative to these axis)
-     * and the segment orientation (used to rotate other coordinates)
-     */
-    double m_segmAngle;     // Ref segm orientation in 0,1 degre
-    int m_segmLength;       // length of the reference segment
-
-    /* variables used in checkLine to test DRC segm to segm:
-     * define the area relative to the ref segment that does not contains any other segment
-     */
-    int                 m_xcliplo;
-    int                 m_ycliplo;
-    int                 m_xcliphi;
-    int                 m_ycliphi;
 
     PCB_EDIT_FRAME*     m_pcbEditorFrame;   ///< The pcb frame editor which owns the board
     BOARD*              m_pcb;
@@ -244,6 +450,24 @@ private:
     bool                m_drcRun;
     bool                m_footprintsTested;
 
+    std::vector<BOX2I>  m_dirtyAreas;       ///< areas changed since the last DRC run
+
+    ///> stroke segments of the copper texts, kept between DRC runs
+    std::map<const EDA_TEXT*, DRC_TEXT_SHAPE> m_textShapes;
+    MARKER_HANDLER      m_markerHandler;    ///< receives the markers when there is no frame
+
+    ///> pad counts of the nets of the copper zones, read from the connectivity before the
+    ///> tests run, as the connectivity is only used on the main thread
+    std::map<int, int>  m_zoneNetPadCounts;
+
+    PROGRESS_REPORTER*  m_progressReporter; ///< progress of the running tests, or nullptr
+
+    bool                       m_deferViolations;   ///< a stage of RunTests() is running
+    std::vector<DRC_VIOLATION> m_pendingViolations; ///< found by the running stage
+    std::mutex                 m_pendingViolationsLock;
+
+    std::atomic<bool>   m_cancelled;        ///< the running tests have been cancelled
+
 
     ///> Sets up handlers for various events.
     void setTransitions() override;
@@ -255,9 +479,32 @@ private:
 
     /**
      * Adds a DRC marker to the PCB through the COMMIT mechanism.
+     * Without a frame, the marker is given to m_markerHandler instead.
      */
     void addMarkerToPcb( MARKER_PCB* aMarker );
 
+    /**
+     * Adds several DRC markers to the PCB in a single commit, see addMarkerToPcb().
+     */
+    void addMarkersToPcb( const std::vector<MARKER_PCB*>& aMarkers );
+
+    ///> @return the units of the editor frame, or millimetres without a frame
+    EDA_UNITS_T userUnits() const;
+
+    /**
+     * Runs one test of RunTests() on a worker thread, keeping the progress dialog alive
+     * and checking for cancellation while it runs.  The markers found by the test are
+     * added to the board when it is done.
+     * @param aMessage is the progress dialog message for the test
+     */
+    void runStage( const wxString& aMessage, const std::function<void()>& aTest );
+
+    /**
+     * Reads on the main thread what the tests cannot read on their worker threads: the pad
+     * counts of the zone nets, and the shape bounding boxes which the pads cache lazily.
+     */
+    void prepareTests();
+
     //-----<categorical group tests>-----------------------------------------
 
     /**
@@ -281,8 +528,31 @@ private:
      */
     void testTracks( wxWindow * aActiveWindow, bool aShowProgressBar );
 
+    /**
+     * Perform the DRC on all tracks using a pool of worker threads.
+     *
+     * Each thread owns a DRC_SEGM_CONTEXT and stores the markers found for each track
+     * apart; the markers are added to the board once all tracks are tested, in track
+     * order, so the result does not depend on the thread scheduling.
+     */
+    void testTracksParallel( wxWindow * aActiveWindow, bool aShowProgressBar );
+
     void testPad2Pad();
 
+    /**
+     * Test the clearances between the pads of a list.
+     *
+     * Pads are indexed in a DRC_RTREE, so each pad is only tested against the pads which
+     * are closer than the biggest pad clearance.  Markers follow the list order.
+     *
+     * @param aPads is the list of pads, usually sorted by X then Y coordinate
+     * @param aMarkers receives one marker per reference pad in error
+     * @param aRefPads flags the pads of aPads which are tested as reference pads, or nullptr
+     *                 when all pads are tested
+     */
+    void doPadListDrc( const std::vector<D_PAD*>& aPads, std::vector<MARKER_PCB*>& aMarkers,
+                       const std::vector<bool>* aRefPads = nullptr );
+
     void testDrilledHoles();
 
     void testUnconnected();
@@ -292,9 +562,9 @@ private:
     void testKeepoutAreas();
 
     // aTextItem is type BOARD_ITEM* to accept either TEXTE_PCB or TEXTE_MODULE
-    void testCopperTextItem( BOARD_ITEM* aTextItem );
+    void testCopperTextItem( BOARD_ITEM* aTextItem, const DRC_COPPER_INDEX& aIndex );
 
-    void testCopperDrawItem( DRAWSEGMENT* aDrawing );
+    void testCopperDrawItem( DRAWSEGMENT* aDrawing, const DRC_COPPER_INDEX& aIndex );
 
     void testCopperTextAndGraphics();
 
@@ -313,88 +583,90 @@ private:
     /**
      * Test the clearance between aRefPad and other pads.
      *
-     * The pad list must be sorted by x coordinate.
+     * The caller selects the candidate pads, see doPadListDrc().
      *
      * @param aRefPad is the pad to test
      * @param aStart is the first pad of the list to test against aRefPad
      * @param aEnd is the end of the list and is not included
-     * @param x_limit is used to stop the test
-     * (i.e. when the current pad pos X in list exceeds this limit, because the list
-     * is sorted by X coordinate)
      */
-    bool doPadToPadsDrc( D_PAD* aRefPad, D_PAD** aStart, D_PAD** aEnd, int x_limit );
+    bool doPadToPadsDrc( D_PAD* aRefPad, D_PAD** aStart, D_PAD** aEnd );
 
     /**
-     * Test the current segment.
-     *
-     * @param aRefSeg The segment to test
-     * @param aStartIt the iterator to the first track to test
-     * @param aEndIt the marker for the iterator end
-     * @param aTestZones true if should do copper zones test. This can be very time consumming
-     * @return bool - true if no problems, else false and m_currentMarker is
-     *          filled in with the problem information.
+     * Index all board tracks by their position in BOARD::Tracks(), bucketed by copper layer.
      */
-    bool doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterator aEndIt,
-                     bool aTestZones );
+    void buildTrackIndex( DRC_RTREE<size_t>& aTree );
 
     /**
-     * Test for footprint courtyard overlaps.
+     * Collect the tracks which can be too close to a reference track.
+     *
+     * When all tracks are tested, only the tracks after the reference one in BOARD::Tracks()
+     * are collected, so that each pair of tracks is tested once.  When only some tracks are
+     * tested (aRefTracks is given), the other tracks are collected whatever their position.
+     * The candidates are returned in board order.
+     *
+     * @param aTree the track index built by buildTrackIndex()
+     * @param aRefIdx the position of the reference track in BOARD::Tracks()
+     * @param aMaxClearance the biggest clearance which can apply to the reference track
+     * @param aCandidates receives the tracks whose bounding box is closer than aMaxClearance
+     *                    to the reference track bounding box
+     * @param aRefTracks flags the tracks which are tested as reference tracks, or nullptr
+     *                   when all tracks are tested
      */
-    void doFootprintOverlappingDrc();
-
-    //-----<single tests>----------------------------------------------
+    void collectTrackCandidates( const DRC_RTREE<size_t>& aTree, size_t aRefIdx,
+                                 int aMaxClearance, std::vector<TRACK*>& aCandidates,
+                                 const std::vector<bool>* aRefTracks = nullptr );
 
     /**
-     * @param aRefPad The reference pad to check
-     * @param aPad Another pad to check against
-     * @return bool - true if clearance between aRefPad and aPad is >= dist_min, else false
+     * Test the zones flagged in aRefZones against all other zones.
+     *
+     * The zones are tested on several threads, so only the problems are recorded: see
+     * addViolationsToPcb().
+     *
+     * @param aRefZones is indexed like BOARD::GetArea()
+     * @param aViolations receives the problems found, or can be nullptr to only count errors
+     * @return Errors count
      */
-    bool checkClearancePadToPad( D_PAD* aRefPad, D_PAD* aPad );
+    int doZoneToZoneOutlineDrc( const std::vector<bool>& aRefZones,
+                                std::vector<DRC_VIOLATION>* aViolations );
 
+    ///> @return true if aArea intersects the dirty region
+    bool intersectsDirtyArea( const BOX2I& aArea ) const;
+
+    ///> @return true if aPoint is inside the dirty region
+    bool isInDirtyArea( const wxPoint& aPoint ) const;
 
     /**
-     * Check the distance from a pad to segment.  This function uses several
-     * instance variable not passed in:
-     *      m_segmLength = length of the segment being tested
-     *      m_segmAngle  = angle of the segment with the X axis;
-     *      m_segmEnd    = end coordinate of the segment
-     *      m_padToTestPos = position of pad relative to the origin of segment
-     * @param aPad Is the pad involved in the check
-     * @param aSegmentWidth width of the segment to test
-     * @param aMinDist Is the minimum clearance needed
+     * Test the current segment.
      *
-     * @return true distance >= dist_min,
-     *         false if distance < dist_min
+     * This function does not modify the board and can be called from several threads
+     * at once, provided each one uses its own context.
+     *
+     * @param aCtx The working state of the segment relative tests
+     * @param aRefSeg The segment to test
+     * @param aTracks the tracks to test against aRefSeg
+     * @param aTestZones true if should do copper zones test. This can be very time consumming
+     * @param aViolations receives the problems found, see addViolationsToPcb()
+     * @return bool - true if no problems, else false and aViolations is
+     *          filled in with the problem information.
      */
-    bool checkClearanceSegmToPad( const D_PAD* aPad, int aSegmentWidth, int aMinDist );
+    bool doTrackDrc( DRC_SEGM_CONTEXT& aCtx, TRACK* aRefSeg, const std::vector<TRACK*>& aTracks,
+                     bool aTestZones, std::vector<DRC_VIOLATION>& aViolations );
 
+    ///> @return the marker of aViolation.  To be called on the main thread of the GUI.
+    MARKER_PCB* newMarker( const DRC_VIOLATION& aViolation ) const;
 
     /**
-     * Check the distance from a point to a segment.
-     *
-     * The segment is expected starting at 0,0, and on the X axis
-     * (used to test DRC between a segment and a round pad, via or round end of a track
-     * @param aCentre The coordinate of the circle's center
-     * @param aRadius A "keep out" radius centered over the circle
-     * @param aLength The length of the segment (i.e. coordinate of end, because it is on
-     *                the X axis)
-     * @return bool - true if distance >= radius, else
-     *                false when distance < aRadius
+     * Adds the markers of problems found by doTrackDrc().  In a stage of RunTests(), which
+     * runs on a worker thread, they are kept until runStage() builds their markers on the
+     * main thread.
      */
-    static bool checkMarginToCircle( wxPoint aCentre, int aRadius, int aLength );
-
+    void addViolationsToPcb( const std::vector<DRC_VIOLATION>& aViolations );
 
     /**
-     * Function checkLine
-     * (helper function used in drc calculations to see if one track is in contact with
-     *  another track).
-     * Test if a line intersects a bounding box (a rectangle)
-     * The rectangle is defined by m_xcliplo, m_ycliplo and m_xcliphi, m_ycliphi
-     * return true if the line from aSegStart to aSegEnd is outside the bounding box
+     * Test for footprint courtyard overlaps.
      */
-    bool checkLine( wxPoint aSegStart, wxPoint aSegEnd );
+    void doFootprintOverlappingDrc();
 
-    //-----</single tests>---------------------------------------------
 
 public:
     /**
@@ -448,6 +720,44 @@ public:
      * @param aMessages = a wxTextControl where to display some activity messages. Can be NULL
      */
     void RunTests( wxTextCtrl* aMessages = NULL );
+
+    /**
+     * Run the DRC tests on a board without an editor frame, for batch runs and benchmarks.
+     *
+     * The tests are the ones of RunTests(), except zone refilling and the test of the
+     * footprints against the schematic, which need a frame.  The board is not modified:
+     * the markers are handed to aHandler, and unconnected items are kept in the usual
+     * list.
+     *
+     * @param aBoard is the board to test
+     * @param aHandler takes the ownership of the markers
+     * @param aReports receives one report per test, in the order of the tests
+     */
+    void RunTestsHeadless( BOARD* aBoard, MARKER_HANDLER aHandler,
+                           std::vector<STAGE_REPORT>& aReports );
+
+    /**
+     * Add an area to the dirty region, i.e. the part of the board tested again by the
+     * next RunIncrementalTests() call.  BOARD_COMMIT::Push() adds the bounding boxes of
+     * the items it changed (before and after the change).
+     *
+     * @param aArea is inflated by the biggest clearance to include the items near the
+     *              changed ones
+     */
+    void MarkAreaDirty( const BOX2I& aArea );
+
+    bool HasDirtyAreas() const { return !m_dirtyAreas.empty(); }
+
+    /**
+     * Run the track, pad, zone and courtyard tests only on the items in the dirty region,
+     * then clear that region.
+     *
+     * The markers of these tests inside the dirty region are replaced by the new results.
+     * The markers outside it, and those of the other tests, are kept.  A full RunTests()
+     * remains the reference: this is meant to keep markers up to date on the fly after
+     * small edits.
+     */
+    void RunIncrementalTests();
 };
 
 
@@ -23,6 +23,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
+
 #include <fctsys.h>
 #include <pcb_edit_frame.h>
 #include <trigo.h>
@@ -106,44 +108,66 @@ bool poly2segmentDRC( wxPoint* aTref, int aTrefCount, wxPoint aSegStart, wxPoint
 }
 
 
-#define PUSH_NEW_MARKER_3( a, b, c ) push_back( m_markerFactory.NewMarker( a, b, c ) )
-#define PUSH_NEW_MARKER_4( a, b, c, d ) push_back( m_markerFactory.NewMarker( a, b, c, d ) )
+void DRC::buildTrackIndex( DRC_RTREE<size_t>& aTree )
+{
+    TRACKS& tracks = m_pcb->Tracks();
+
+    aTree.RemoveAll();
 
+    for( size_t ii = 0; ii < tracks.size(); ++ii )
+        aTree.Insert( ii, tracks[ii]->GetBoundingBox(), tracks[ii]->GetLayerSet() );
+}
 
-bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterator aEndIt,
-                      bool aTestZones )
+
+void DRC::collectTrackCandidates( const DRC_RTREE<size_t>& aTree, size_t aRefIdx,
+                                  int aMaxClearance, std::vector<TRACK*>& aCandidates,
+                                  const std::vector<bool>* aRefTracks )
 {
-    TRACK*    track;
-    wxPoint   delta;           // length on X and Y axis of segments
-    wxPoint   shape_pos;
+    TRACKS&             tracks = m_pcb->Tracks();
+    TRACK*              refSeg = tracks[aRefIdx];
+    std::vector<size_t> found;
 
-    std::vector<MARKER_PCB*> markers;
+    // Track bounding boxes include half of the track width, so two tracks can only be
+    // too close if their bounding boxes are closer than the clearance
+    BOX2I area = refSeg->GetBoundingBox();
+    area.Inflate( aMaxClearance );
 
-    auto commitMarkers = [&]()
-    {
-        BOARD_COMMIT commit( m_pcbEditorFrame );
+    aTree.Query( area, refSeg->GetLayerSet(),
+                 [&]( const size_t& aIdx ) -> bool
+                 {
+                     bool isRef = !aRefTracks || (*aRefTracks)[aIdx];
 
-        for( MARKER_PCB* marker : markers )
-            commit.Add( marker );
+                     // Pairs of reference tracks are tested once, from the first track
+                     if( aIdx > aRefIdx || ( aIdx < aRefIdx && !isRef ) )
+                         found.push_back( aIdx );
+
+                     return true;
+                 } );
+
+    // Items on several layers are found once per layer; keep the board order
+    std::sort( found.begin(), found.end() );
+    found.erase( std::unique( found.begin(), found.end() ), found.end() );
+
+    aCandidates.clear();
+
+    for( size_t idx : found )
+        aCandidates.push_back( tracks[idx] );
+}
 
-        commit.Push( wxEmptyString, false, false );
-    };
+
+bool DRC::doTrackDrc( DRC_SEGM_CONTEXT& aCtx, TRACK* aRefSeg, const std::vector<TRACK*>& aTracks,
+                      bool aTestZones, std::vector<DRC_VIOLATION>& aViolations )
+{
+    wxPoint   delta;           // length on X and Y axis of segments
+    wxPoint   shape_pos;
+    size_t    violationCount = aViolations.size();
 
     // Returns false if we should return false from call site, or true to continue
     auto handleNewMarker = [&]() -> bool
     {
-        if( !m_reportAllTrackErrors )
-        {
-            if( markers.size() > 0 )
-                commitMarkers();
-
-            return false;
-        }
-        else
-            return true;
+        return m_reportAllTrackErrors;
     };
 
-    NETCLASSPTR netclass = aRefSeg->GetNetClass();
     BOARD_DESIGN_SETTINGS& dsnSettings = m_pcb->GetDesignSettings();
 
     /* In order to make some calculations more easier or faster,
@@ -151,12 +175,12 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
      */
     wxPoint origin = aRefSeg->GetStart();  // origin will be the origin of other coordinates
 
-    m_segmEnd   = delta = aRefSeg->GetEnd() - origin;
-    m_segmAngle = 0;
+    aCtx.m_segmEnd   = delta = aRefSeg->GetEnd() - origin;
+    aCtx.m_segmAngle = 0;
 
     LSET layerMask = aRefSeg->GetLayerSet();
     int  net_code_ref = aRefSeg->GetNetCode();
-    int  ref_seg_clearance  = netclass->GetClearance();
+    int  ref_seg_clearance  = m_pcb->GetNetClearance( net_code_ref );
     int  ref_seg_width = aRefSeg->GetWidth();
 
 
@@ -174,7 +198,8 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
         {
             if( refvia->GetWidth() < dsnSettings.m_MicroViasMinSize )
             {
-                markers.PUSH_NEW_MARKER_3( refviaPos, refvia, DRCE_TOO_SMALL_MICROVIA );
+                aViolations.push_back( DRC_VIOLATION::AtPosition( refviaPos, refvia, nullptr,
+                                                                  DRCE_TOO_SMALL_MICROVIA ) );
 
                 if( !handleNewMarker() )
                     return false;
@@ -182,7 +207,8 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
 
             if( refvia->GetDrillValue() < dsnSettings.m_MicroViasMinDrill )
             {
-                markers.PUSH_NEW_MARKER_3( refviaPos, refvia, DRCE_TOO_SMALL_MICROVIA_DRILL );
+                aViolations.push_back( DRC_VIOLATION::AtPosition( refviaPos, refvia, nullptr,
+                                                                  DRCE_TOO_SMALL_MICROVIA_DRILL ) );
 
                 if( !handleNewMarker() )
                     return false;
@@ -192,7 +218,8 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
         {
             if( refvia->GetWidth() < dsnSettings.m_ViasMinSize )
             {
-                markers.PUSH_NEW_MARKER_3( refviaPos, refvia, DRCE_TOO_SMALL_VIA );
+                aViolations.push_back( DRC_VIOLATION::AtPosition( refviaPos, refvia, nullptr,
+                                                                  DRCE_TOO_SMALL_VIA ) );
 
                 if( !handleNewMarker() )
                     return false;
@@ -200,7 +227,8 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
 
             if( refvia->GetDrillValue() < dsnSettings.m_ViasMinDrill )
             {
-                markers.PUSH_NEW_MARKER_3( refviaPos, refvia, DRCE_TOO_SMALL_VIA_DRILL );
+                aViolations.push_back( DRC_VIOLATION::AtPosition( refviaPos, refvia, nullptr,
+                                                                  DRCE_TOO_SMALL_VIA_DRILL ) );
 
                 if( !handleNewMarker() )
                     return false;
@@ -212,7 +240,8 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
         // and a default via hole can be bigger than some vias sizes
         if( refvia->GetDrillValue() > refvia->GetWidth() )
         {
-            markers.PUSH_NEW_MARKER_3( refviaPos, refvia, DRCE_VIA_HOLE_BIGGER );
+            aViolations.push_back( DRC_VIOLATION::AtPosition( refviaPos, refvia, nullptr,
+                                                              DRCE_VIA_HOLE_BIGGER ) );
 
             if( !handleNewMarker() )
                 return false;
@@ -221,7 +250,8 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
         // test if the type of via is allowed due to design rules
         if( refvia->GetViaType() == VIA_MICROVIA && !dsnSettings.m_MicroViasAllowed )
         {
-            markers.PUSH_NEW_MARKER_3( refviaPos, refvia, DRCE_MICRO_VIA_NOT_ALLOWED );
+            aViolations.push_back( DRC_VIOLATION::AtPosition( refviaPos, refvia, nullptr,
+                                                              DRCE_MICRO_VIA_NOT_ALLOWED ) );
 
             if( !handleNewMarker() )
                 return false;
@@ -230,7 +260,8 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
         // test if the type of via is allowed due to design rules
         if( refvia->GetViaType() == VIA_BLIND_BURIED && !dsnSettings.m_BlindBuriedViaAllowed )
         {
-            markers.PUSH_NEW_MARKER_3( refviaPos, refvia, DRCE_BURIED_VIA_NOT_ALLOWED );
+            aViolations.push_back( DRC_VIOLATION::AtPosition( refviaPos, refvia, nullptr,
+                                                              DRCE_BURIED_VIA_NOT_ALLOWED ) );
 
             if( !handleNewMarker() )
                 return false;
@@ -256,7 +287,8 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
 
             if( err )
             {
-                markers.PUSH_NEW_MARKER_3( refviaPos, refvia, DRCE_MICRO_VIA_INCORRECT_LAYER_PAIR );
+                aViolations.push_back( DRC_VIOLATION::AtPosition(
+                        refviaPos, refvia, nullptr, DRCE_MICRO_VIA_INCORRECT_LAYER_PAIR ) );
 
                 if( !handleNewMarker() )
                     return false;
@@ -270,7 +302,8 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
         {
             wxPoint refsegMiddle = ( aRefSeg->GetStart() + aRefSeg->GetEnd() ) / 2;
 
-            markers.PUSH_NEW_MARKER_3( refsegMiddle, aRefSeg, DRCE_TOO_SMALL_TRACK_WIDTH );
+            aViolations.push_back( DRC_VIOLATION::AtPosition( refsegMiddle, aRefSeg, nullptr,
+                                                              DRCE_TOO_SMALL_TRACK_WIDTH ) );
 
             if( !handleNewMarker() )
                 return false;
@@ -282,14 +315,14 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
     if( delta.x || delta.y )
     {
         // Compute the segment angle in 0,1 degrees
-        m_segmAngle = ArcTangente( delta.y, delta.x );
+        aCtx.m_segmAngle = ArcTangente( delta.y, delta.x );
 
         // Compute the segment length: we build an equivalent rotated segment,
         // this segment is horizontal, therefore dx = length
-        RotatePoint( &delta, m_segmAngle );    // delta.x = length, delta.y = 0
+        RotatePoint( &delta, aCtx.m_segmAngle );    // delta.x = length, delta.y = 0
     }
 
-    m_segmLength = delta.x;
+    aCtx.m_segmLength = delta.x;
 
     /******************************************/
     /* Phase 1 : test DRC track to pads :     */
@@ -330,11 +363,12 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
                                    PAD_SHAPE_OVAL : PAD_SHAPE_CIRCLE );
                 dummypad.SetOrientation( pad->GetOrientation() );
 
-                m_padToTestPos = dummypad.GetPosition() - origin;
+                aCtx.m_padToTestPos = dummypad.GetPosition() - origin;
 
-                if( !checkClearanceSegmToPad( &dummypad, ref_seg_width, ref_seg_clearance ) )
+                if( !aCtx.checkClearanceSegmToPad( &dummypad, ref_seg_width, ref_seg_clearance ) )
                 {
-                    markers.PUSH_NEW_MARKER_4( aRefSeg, pad, padSeg, DRCE_TRACK_NEAR_THROUGH_HOLE );
+                    aViolations.push_back( DRC_VIOLATION::OnSegment(
+                            aRefSeg, pad, padSeg, DRCE_TRACK_NEAR_THROUGH_HOLE ) );
 
                     if( !handleNewMarker() )
                         return false;
@@ -351,12 +385,13 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
 
             // DRC for the pad
             shape_pos = pad->ShapePos();
-            m_padToTestPos = shape_pos - origin;
+            aCtx.m_padToTestPos = shape_pos - origin;
             int segToPadClearance = std::max( ref_seg_clearance, pad->GetClearance() );
 
-            if( !checkClearanceSegmToPad( pad, ref_seg_width, segToPadClearance ) )
+            if( !aCtx.checkClearanceSegmToPad( pad, ref_seg_width, segToPadClearance ) )
             {
-                markers.PUSH_NEW_MARKER_4( aRefSeg, pad, padSeg, DRCE_TRACK_NEAR_PAD );
+                aViolations.push_back( DRC_VIOLATION::OnSegment( aRefSeg, pad, padSeg,
+                                                                 DRCE_TRACK_NEAR_PAD ) );
 
                 if( !handleNewMarker() )
                     return false;
@@ -374,9 +409,8 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
     wxPoint segStartPoint;
     wxPoint segEndPoint;
 
-    for( auto it = aStartIt; it != aEndIt; it++ )
+    for( TRACK* track : aTracks )
     {
-        track = *it;
         // No problem if segments have the same net code:
         if( net_code_ref == track->GetNetCode() )
             continue;
@@ -387,7 +421,9 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
 
         // the minimum distance = clearance plus half the reference track
         // width plus half the other track's width
-        int w_dist = std::max( ref_seg_clearance, track->GetClearance() );
+        // Tracks have no local clearance: this is TRACK::GetClearance() without the
+        // netclass lookup
+        int w_dist = std::max( ref_seg_clearance, m_pcb->GetNetClearance( track->GetNetCode() ) );
         w_dist += ( ref_seg_width + track->GetWidth() ) / 2;
 
         // Due to many double to int conversions during calculations, which
@@ -409,7 +445,8 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
                 // Test distance between two vias, i.e. two circles, trivial case
                 if( EuclideanNorm( segStartPoint ) < w_dist )
                 {
-                    markers.PUSH_NEW_MARKER_4( pos, aRefSeg, track, DRCE_VIA_NEAR_VIA );
+                    aViolations.push_back( DRC_VIOLATION::AtPosition( pos, aRefSeg, track,
+                                                                      DRCE_VIA_NEAR_VIA ) );
 
                     if( !handleNewMarker() )
                         return false;
@@ -424,9 +461,10 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
                 RotatePoint( &delta, angle );
                 RotatePoint( &segStartPoint, angle );
 
-                if( !checkMarginToCircle( segStartPoint, w_dist, delta.x ) )
+                if( !aCtx.checkMarginToCircle( segStartPoint, w_dist, delta.x ) )
                 {
-                    markers.PUSH_NEW_MARKER_4( pos, aRefSeg, track, DRCE_VIA_NEAR_TRACK );
+                    aViolations.push_back( DRC_VIOLATION::AtPosition( pos, aRefSeg, track,
+                                                                      DRCE_VIA_NEAR_TRACK ) );
 
                     if( !handleNewMarker() )
                         return false;
@@ -442,17 +480,18 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
          */
         segStartPoint = track->GetStart() - origin;
         segEndPoint   = track->GetEnd() - origin;
-        RotatePoint( &segStartPoint, m_segmAngle );
-        RotatePoint( &segEndPoint, m_segmAngle );
+        RotatePoint( &segStartPoint, aCtx.m_segmAngle );
+        RotatePoint( &segEndPoint, aCtx.m_segmAngle );
 
         SEG seg( segStartPoint, segEndPoint );
 
         if( track->Type() == PCB_VIA_T )
         {
-            if( checkMarginToCircle( segStartPoint, w_dist, m_segmLength ) )
+            if( aCtx.checkMarginToCircle( segStartPoint, w_dist, aCtx.m_segmLength ) )
                 continue;
 
-            markers.PUSH_NEW_MARKER_4( aRefSeg, track, seg, DRCE_TRACK_NEAR_VIA );
+            aViolations.push_back( DRC_VIOLATION::OnSegment( aRefSeg, track, seg,
+                                                             DRCE_TRACK_NEAR_VIA ) );
 
             if( !handleNewMarker() )
                 return false;
@@ -471,47 +510,51 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
             if( segStartPoint.x > segEndPoint.x )
                 std::swap( segStartPoint.x, segEndPoint.x );
 
-            if( segStartPoint.x > ( -w_dist ) && segStartPoint.x < ( m_segmLength + w_dist ) )
+            if( segStartPoint.x > ( -w_dist ) && segStartPoint.x < ( aCtx.m_segmLength + w_dist ) )
             {
                 // the start point is inside the reference range
                 //      X........
                 //    O--REF--+
 
                 // Fine test : we consider the rounded shape of each end of the track segment:
-                if( segStartPoint.x >= 0 && segStartPoint.x <= m_segmLength )
+                if( segStartPoint.x >= 0 && segStartPoint.x <= aCtx.m_segmLength )
                 {
-                    markers.PUSH_NEW_MARKER_4( aRefSeg, track, seg, DRCE_TRACK_ENDS1 );
+                    aViolations.push_back( DRC_VIOLATION::OnSegment( aRefSeg, track, seg,
+                                                                     DRCE_TRACK_ENDS1 ) );
 
                     if( !handleNewMarker() )
                         return false;
                 }
 
-                if( !checkMarginToCircle( segStartPoint, w_dist, m_segmLength ) )
+                if( !aCtx.checkMarginToCircle( segStartPoint, w_dist, aCtx.m_segmLength ) )
                 {
-                    markers.PUSH_NEW_MARKER_4( aRefSeg, track, seg, DRCE_TRACK_ENDS2 );
+                    aViolations.push_back( DRC_VIOLATION::OnSegment( aRefSeg, track, seg,
+                                                                     DRCE_TRACK_ENDS2 ) );
 
                     if( !handleNewMarker() )
                         return false;
                 }
             }
 
-            if( segEndPoint.x > ( -w_dist ) && segEndPoint.x < ( m_segmLength + w_dist ) )
+            if( segEndPoint.x > ( -w_dist ) && segEndPoint.x < ( aCtx.m_segmLength + w_dist ) )
             {
                 // the end point is inside the reference range
                 //  .....X
                 //    O--REF--+
                 // Fine test : we consider the rounded shape of the ends
-                if( segEndPoint.x >= 0 && segEndPoint.x <= m_segmLength )
+                if( segEndPoint.x >= 0 && segEndPoint.x <= aCtx.m_segmLength )
                 {
-                    markers.PUSH_NEW_MARKER_4( aRefSeg, track, seg, DRCE_TRACK_ENDS3 );
+                    aViolations.push_back( DRC_VIOLATION::OnSegment( aRefSeg, track, seg,
+                                                                     DRCE_TRACK_ENDS3 ) );
 
                     if( !handleNewMarker() )
                         return false;
                 }
 
-                if( !checkMarginToCircle( segEndPoint, w_dist, m_segmLength ) )
+                if( !aCtx.checkMarginToCircle( segEndPoint, w_dist, aCtx.m_segmLength ) )
                 {
-                    markers.PUSH_NEW_MARKER_4( aRefSeg, track, seg, DRCE_TRACK_ENDS4 );
+                    aViolations.push_back( DRC_VIOLATION::OnSegment( aRefSeg, track, seg,
+                                                                     DRCE_TRACK_ENDS4 ) );
 
                     if( !handleNewMarker() )
                         return false;
@@ -525,7 +568,8 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
                 // handled)
                 //  X.............X
                 //    O--REF--+
-                markers.PUSH_NEW_MARKER_4( aRefSeg, track, seg, DRCE_TRACK_SEGMENTS_TOO_CLOSE );
+                aViolations.push_back( DRC_VIOLATION::OnSegment( aRefSeg, track, seg,
+                                                                 DRCE_TRACK_SEGMENTS_TOO_CLOSE ) );
 
                 if( !handleNewMarker() )
                     return false;
@@ -533,7 +577,7 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
         }
         else if( segStartPoint.x == segEndPoint.x ) // perpendicular segments
         {
-            if( segStartPoint.x <= -w_dist || segStartPoint.x >= m_segmLength + w_dist )
+            if( segStartPoint.x <= -w_dist || segStartPoint.x >= aCtx.m_segmLength + w_dist )
                 continue;
 
             // Test if segments are crossing
@@ -542,26 +586,29 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
 
             if( ( segStartPoint.y < 0 ) && ( segEndPoint.y > 0 ) )
             {
-                MARKER_PCB* m = m_markerFactory.NewMarker( aRefSeg, track, seg,
-                                                           DRCE_TRACKS_CROSSING );
-                m->SetPosition( wxPoint( track->GetStart().x, aRefSeg->GetStart().y ) );
-                markers.push_back( m );
+                DRC_VIOLATION v = DRC_VIOLATION::OnSegment( aRefSeg, track, seg,
+                                                            DRCE_TRACKS_CROSSING );
+                v.m_position = wxPoint( track->GetStart().x, aRefSeg->GetStart().y );
+                v.m_forcePosition = true;
+                aViolations.push_back( v );
 
                 if( !handleNewMarker() )
                     return false;
             }
 
             // At this point the drc error is due to an end near a reference segm end
-            if( !checkMarginToCircle( segStartPoint, w_dist, m_segmLength ) )
+            if( !aCtx.checkMarginToCircle( segStartPoint, w_dist, aCtx.m_segmLength ) )
             {
-                markers.PUSH_NEW_MARKER_4( aRefSeg, track, seg, DRCE_ENDS_PROBLEM1 );
+                aViolations.push_back( DRC_VIOLATION::OnSegment( aRefSeg, track, seg,
+                                                                 DRCE_ENDS_PROBLEM1 ) );
 
                 if( !handleNewMarker() )
                     return false;
             }
-            if( !checkMarginToCircle( segEndPoint, w_dist, m_segmLength ) )
+            if( !aCtx.checkMarginToCircle( segEndPoint, w_dist, aCtx.m_segmLength ) )
             {
-                markers.PUSH_NEW_MARKER_4( aRefSeg, track, seg, DRCE_ENDS_PROBLEM2 );
+                aViolations.push_back( DRC_VIOLATION::OnSegment( aRefSeg, track, seg,
+                                                                 DRCE_ENDS_PROBLEM2 ) );
 
                 if( !handleNewMarker() )
                     return false;
@@ -572,40 +619,41 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
             // calcul de la "surface de securite du segment de reference
             // First rought 'and fast) test : the track segment is like a rectangle
 
-            m_xcliplo = m_ycliplo = -w_dist;
-            m_xcliphi = m_segmLength + w_dist;
-            m_ycliphi = w_dist;
+            aCtx.m_xcliplo = aCtx.m_ycliplo = -w_dist;
+            aCtx.m_xcliphi = aCtx.m_segmLength + w_dist;
+            aCtx.m_ycliphi = w_dist;
 
             // A fine test is needed because a serment is not exactly a
             // rectangle, it has rounded ends
-            if( !checkLine( segStartPoint, segEndPoint ) )
+            if( !aCtx.checkLine( segStartPoint, segEndPoint ) )
             {
                 /* 2eme passe : the track has rounded ends.
                  * we must a fine test for each rounded end and the
                  * rectangular zone
                  */
 
-                m_xcliplo = 0;
-                m_xcliphi = m_segmLength;
+                aCtx.m_xcliplo = 0;
+                aCtx.m_xcliphi = aCtx.m_segmLength;
 
-                if( !checkLine( segStartPoint, segEndPoint ) )
+                if( !aCtx.checkLine( segStartPoint, segEndPoint ) )
                 {
                     wxPoint failurePoint;
-                    MARKER_PCB* m;
+                    DRC_VIOLATION v;
 
                     if( SegmentIntersectsSegment( aRefSeg->GetStart(), aRefSeg->GetEnd(),
                                                   track->GetStart(), track->GetEnd(),
                                                   &failurePoint ) )
                     {
-                        m = m_markerFactory.NewMarker( aRefSeg, track, seg, DRCE_TRACKS_CROSSING );
-                        m->SetPosition( failurePoint );
+                        v = DRC_VIOLATION::OnSegment( aRefSeg, track, seg, DRCE_TRACKS_CROSSING );
+                        v.m_position = failurePoint;
+                        v.m_forcePosition = true;
                     }
                     else
                     {
-                        m = m_markerFactory.NewMarker( aRefSeg, track, seg, DRCE_ENDS_PROBLEM3 );
+                        v = DRC_VIOLATION::OnSegment( aRefSeg, track, seg, DRCE_ENDS_PROBLEM3 );
                     }
 
-                    markers.push_back( m );
+                    aViolations.push_back( v );
 
                     if( !handleNewMarker() )
                         return false;
@@ -632,17 +680,19 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
                     RotatePoint( &relStartPos, angle );
                     RotatePoint( &relEndPos, angle );
 
-                    if( !checkMarginToCircle( relStartPos, w_dist, delta.x ) )
+                    if( !aCtx.checkMarginToCircle( relStartPos, w_dist, delta.x ) )
                     {
-                        markers.PUSH_NEW_MARKER_4( aRefSeg, track, seg, DRCE_ENDS_PROBLEM4 );
+                        aViolations.push_back( DRC_VIOLATION::OnSegment( aRefSeg, track, seg,
+                                                                         DRCE_ENDS_PROBLEM4 ) );
 
                         if( !handleNewMarker() )
                             return false;
                     }
 
-                    if( !checkMarginToCircle( relEndPos, w_dist, delta.x ) )
+                    if( !aCtx.checkMarginToCircle( relEndPos, w_dist, delta.x ) )
                     {
-                        markers.PUSH_NEW_MARKER_4( aRefSeg, track, seg, DRCE_ENDS_PROBLEM5 );
+                        aViolations.push_back( DRC_VIOLATION::OnSegment( aRefSeg, track, seg,
+                                                                         DRCE_ENDS_PROBLEM5 ) );
 
                         if( !handleNewMarker() )
                             return false;
@@ -675,7 +725,8 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
             SHAPE_POLY_SET* outline = const_cast<SHAPE_POLY_SET*>( &zone->GetFilledPolysList() );
 
             if( outline->Distance( refSeg, ref_seg_width ) < clearance )
-                addMarkerToPcb( m_markerFactory.NewMarker( aRefSeg, zone, DRCE_TRACK_NEAR_ZONE ) );
+                aViolations.push_back( DRC_VIOLATION::WithZone( aRefSeg, zone,
+                                                                DRCE_TRACK_NEAR_ZONE ) );
         }
     }
 
@@ -718,10 +769,9 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
                 // Best-efforts search for edge segment
                 BOARD::IterateForward<BOARD_ITEM*>( m_pcb->Drawings(), inspector, nullptr, types );
 
-                if( edge )
-                    markers.PUSH_NEW_MARKER_4( (wxPoint) pt, aRefSeg, edge, DRCE_TRACK_NEAR_EDGE );
-                else
-                    markers.PUSH_NEW_MARKER_3( (wxPoint) pt, aRefSeg, DRCE_TRACK_NEAR_EDGE );
+                // The edge is optional: without it, the marker only shows the track
+                aViolations.push_back( DRC_VIOLATION::AtPosition( (wxPoint) pt, aRefSeg, edge,
+                                                                  DRCE_TRACK_NEAR_EDGE ) );
 
                 if( !handleNewMarker() )
                     return false;
@@ -730,17 +780,11 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
     }
 
 
-    if( markers.size() > 0 )
-    {
-        commitMarkers();
-        return false;
-    }
-    else
-        return true;
+    return aViolations.size() == violationCount;
 }
 
 
-bool DRC::checkClearancePadToPad( D_PAD* aRefPad, D_PAD* aPad )
+bool DRC_SEGM_CONTEXT::checkClearancePadToPad( D_PAD* aRefPad, D_PAD* aPad )
 {
     int     dist;
     double pad_angle;
@@ -1037,7 +1081,7 @@ bool DRC::checkClearancePadToPad( D_PAD* aRefPad, D_PAD* aPad )
  * and its orientation is m_segmAngle (m_segmAngle must be already initialized)
  * and have aSegmentWidth.
  */
-bool DRC::checkClearanceSegmToPad( const D_PAD* aPad, int aSegmentWidth, int aMinDist )
+bool DRC_SEGM_CONTEXT::checkClearanceSegmToPad( const D_PAD* aPad, int aSegmentWidth, int aMinDist )
 {
     // Note:
     // we are using a horizontal segment for test, because we know here
@@ -1348,7 +1392,7 @@ bool DRC::checkClearanceSegmToPad( const D_PAD* aPad, int aSegmentWidth, int aMi
  * and a segment. the segment is expected starting at 0,0, and on the X axis
  * return true if distance >= aRadius
  */
-bool DRC::checkMarginToCircle( wxPoint aCentre, int aRadius, int aLength )
+bool DRC_SEGM_CONTEXT::checkMarginToCircle( wxPoint aCentre, int aRadius, int aLength )
 {
     if( abs( aCentre.y ) >= aRadius )     // trivial case
         return true;
@@ -1401,7 +1445,7 @@ static inline int USCALE( unsigned arg, unsigned num, unsigned den )
  * The rectangle is defined by m_xcliplo, m_ycliplo and m_xcliphi, m_ycliphi
  * return true if the line from aSegStart to aSegEnd is outside the bounding box
  */
-bool DRC::checkLine( wxPoint aSegStart, wxPoint aSegEnd )
+bool DRC_SEGM_CONTEXT::checkLine( wxPoint aSegStart, wxPoint aSegEnd )
 {
 #define WHEN_OUTSIDE return true
 #define WHEN_INSIDE
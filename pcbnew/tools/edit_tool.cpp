@@ -103,6 +103,7 @@ EDIT_TOOL::EDIT_TOOL() :
     PCB_TOOL_BASE( "pcbnew.InteractiveEdit" ),
     m_selectionTool( NULL ),
     m_dragging( false ),
+    m_dragTransformed( false ),
     m_lockedSelected( false )
 {
 }
@@ -289,6 +290,7 @@ int EDIT_TOOL::Main( const TOOL_EVENT& aEvent )
 
     bool        restore_state = false;
     VECTOR2I    totalMovement;
+    VECTOR2I    anchorMovement;     // move to the reference point, at the drag start
     GRID_HELPER grid( editFrame );
     TOOL_EVENT* evt = const_cast<TOOL_EVENT*>( &aEvent );
     VECTOR2I    prevPos;
@@ -349,6 +351,7 @@ int EDIT_TOOL::Main( const TOOL_EVENT& aEvent )
                     break;
 
                 m_dragging = true;
+                m_dragTransformed = false;
 
                 // When editing modules, all items have the same parent
                 if( EditingModules() )
@@ -377,6 +380,7 @@ int EDIT_TOOL::Main( const TOOL_EVENT& aEvent )
                     grid.SetAuxAxes( false );
 
                     auto delta = m_cursor - selection.GetReferencePoint();
+                    anchorMovement = delta;
 
                     // Drag items to the current cursor position
                     for( auto item : selection )
@@ -449,6 +453,8 @@ int EDIT_TOOL::Main( const TOOL_EVENT& aEvent )
                 //editFrame->RestoreCopyFromUndoList( dummy );
                 //
                 // So, instead, reset the position manually
+                m_dragTransformed = true;
+
                 for( auto item : selection )
                 {
                     BOARD_ITEM* i = static_cast<BOARD_ITEM*>( item );
@@ -501,6 +507,13 @@ int EDIT_TOOL::Main( const TOOL_EVENT& aEvent )
     }
     else
     {
+        // Items only moved are restored by moving them back, without keeping their copies
+        if( !m_dragTransformed )
+        {
+            VECTOR2I translation = anchorMovement + totalMovement;
+            m_commit->SetTranslation( wxPoint( translation.x, translation.y ) );
+        }
+
         m_commit->Push( _( "Drag" ) );
     }
 
@@ -620,6 +633,8 @@ int EDIT_TOOL::Rotate( const TOOL_EVENT& aEvent )
 
     if( !m_dragging )
         m_commit->Push( _( "Rotate" ) );
+    else
+        m_dragTransformed = true;
 
     if( selection.IsHover() && !m_dragging )
         m_toolMgr->RunAction( PCB_ACTIONS::selectionClear, true );
@@ -741,6 +756,8 @@ int EDIT_TOOL::Mirror( const TOOL_EVENT& aEvent )
 
     if( !m_dragging )
         m_commit->Push( _( "Mirror" ) );
+    else
+        m_dragTransformed = true;
 
     if( selection.IsHover() && !m_dragging )
         m_toolMgr->RunAction( PCB_ACTIONS::selectionClear, true );
@@ -781,6 +798,8 @@ int EDIT_TOOL::Flip( const TOOL_EVENT& aEvent )
 
     if( !m_dragging )
         m_commit->Push( _( "Flip" ) );
+    else
+        m_dragTransformed = true;
 
     if( selection.IsHover() && !m_dragging )
         m_toolMgr->RunAction( PCB_ACTIONS::selectionClear, true );
@@ -184,6 +184,7 @@ private:
 private:
     SELECTION_TOOL* m_selectionTool;   // Selection tool used for obtaining selected items
     bool            m_dragging;        // Indicates objects are being dragged right now
+    bool            m_dragTransformed; // Dragged objects were also rotated, mirrored or flipped
     bool            m_lockedSelected;  // Determines if we prompt before removing locked objects
     VECTOR2I        m_cursor;          // Last cursor position (needed for getModificationPoint()
                                        // to avoid changes of edit reference point).
@@ -597,6 +597,9 @@ TOOL_ACTION PCB_ACTIONS::highlightNetSelection( "pcbnew.EditorControl.highlightN
 TOOL_ACTION PCB_ACTIONS::highlightItem( "pcbnew.EditorControl.highlightItem",
         AS_GLOBAL );
 
+TOOL_ACTION PCB_ACTIONS::highlightItems( "pcbnew.EditorControl.highlightItems",
+        AS_GLOBAL );
+
 TOOL_ACTION PCB_ACTIONS::showEeschema( "pcbnew.EditorControl.showEeschema",
         AS_GLOBAL, 0, "",
         _( "Switch to Schematic Editor" ), _( "Open schematic in Eeschema" ),
@@ -1072,6 +1075,12 @@ TOOL_ACTION PCB_ACTIONS::zoneFillAll( "pcbnew.ZoneFiller.zoneFillAll",
         _( "Fill All" ), _( "Fill all zones" ),
         fill_zone_xpm );
 
+TOOL_ACTION PCB_ACTIONS::zoneFillDirty( "pcbnew.ZoneFiller.zoneFillDirty",
+        AS_GLOBAL, 0, "",
+        _( "Refill Modified Zones" ),
+        _( "Refill the zones affected by the changes since the last fill" ),
+        fill_zone_xpm );
+
 TOOL_ACTION PCB_ACTIONS::zoneUnfill( "pcbnew.ZoneFiller.zoneUnfill",
         AS_GLOBAL, 0, "",
         _( "Unfill" ), _( "Unfill zone(s)" ),
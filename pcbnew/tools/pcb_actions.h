@@ -292,6 +292,7 @@ public:
     // Zone actions
     static TOOL_ACTION zoneFill;
     static TOOL_ACTION zoneFillAll;
+    static TOOL_ACTION zoneFillDirty;
     static TOOL_ACTION zoneUnfill;
     static TOOL_ACTION zoneUnfillAll;
     static TOOL_ACTION zoneMerge;
@@ -412,6 +413,7 @@ public:
     static TOOL_ACTION highlightNetTool;
     static TOOL_ACTION highlightNetSelection;
     static TOOL_ACTION highlightItem;
+    static TOOL_ACTION highlightItems;
     static TOOL_ACTION drillOrigin;
     static TOOL_ACTION appendBoard;
     static TOOL_ACTION showEeschema;
@@ -70,6 +70,7 @@ public:
 
         Add( PCB_ACTIONS::zoneFill );
         Add( PCB_ACTIONS::zoneFillAll );
+        Add( PCB_ACTIONS::zoneFillDirty );
         Add( PCB_ACTIONS::zoneUnfill );
         Add( PCB_ACTIONS::zoneUnfillAll );
 
@@ -1123,6 +1124,23 @@ int PCB_EDITOR_CONTROL::HighlightItem( const TOOL_EVENT& aEvent )
 }
 
 
+int PCB_EDITOR_CONTROL::HighlightItems( const TOOL_EVENT& aEvent )
+{
+    std::vector<BOARD_ITEM*>* items = aEvent.Parameter<std::vector<BOARD_ITEM*>*>();
+
+    m_probingSchToPcb = true;   // recursion guard
+    {
+        m_toolMgr->RunAction( PCB_ACTIONS::selectionClear, true );
+
+        if( items )
+            m_toolMgr->RunAction( PCB_ACTIONS::selectItems, true, (void*) items );
+    }
+    m_probingSchToPcb = false;
+
+    return 0;
+}
+
+
 void PCB_EDITOR_CONTROL::DoSetDrillOrigin( KIGFX::VIEW* aView, PCB_BASE_FRAME* aFrame,
                                            BOARD_ITEM* originViewItem, const VECTOR2D& aPosition )
 {
@@ -1560,6 +1578,7 @@ void PCB_EDITOR_CONTROL::setTransitions()
     Go( &PCB_EDITOR_CONTROL::HighlightNetTool,       PCB_ACTIONS::highlightNetTool.MakeEvent() );
     Go( &PCB_EDITOR_CONTROL::ClearHighlight,         ACTIONS::cancelInteractive.MakeEvent() );
     Go( &PCB_EDITOR_CONTROL::HighlightItem,          PCB_ACTIONS::highlightItem.MakeEvent() );
+    Go( &PCB_EDITOR_CONTROL::HighlightItems,         PCB_ACTIONS::highlightItems.MakeEvent() );
 
     Go( &PCB_EDITOR_CONTROL::LocalRatsnestTool,      PCB_ACTIONS::localRatsnestTool.MakeEvent() );
     Go( &PCB_EDITOR_CONTROL::HideDynamicRatsnest,    PCB_ACTIONS::hideDynamicRatsnest.MakeEvent() );
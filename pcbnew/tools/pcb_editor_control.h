@@ -128,6 +128,9 @@ public:
     ///> Performs the appropriate action in response to an eeschema cross-probe.
     int HighlightItem( const TOOL_EVENT& aEvent );
 
+    ///> Selects the items of a cross-probe listing several components.
+    int HighlightItems( const TOOL_EVENT& aEvent );
+
     ///> Updates ratsnest for selected items.
     int UpdateSelectionRatsnest( const TOOL_EVENT& aEvent );
 
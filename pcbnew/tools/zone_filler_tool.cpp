@@ -24,6 +24,14 @@
  */
 #include <cstdint>
 #include <thread>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <map>
+#include <mutex>
+#include <class_board.h>
+#include <class_module.h>
+#include <class_track.h>
 #include <class_zone.h>
 #include <connectivity/connectivity_data.h>
 #include <board_commit.h>
@@ -35,21 +43,492 @@
 #include "selection_tool.h"
 #include "zone_filler_tool.h"
 #include "zone_filler.h"
+#include <advanced_config.h>
+#include <view/view.h>
+
+
+/**
+ * A zone refill running in a worker thread.  The worker only uses m_board, a copy of the
+ * items the fills depend on, so the board can be edited meanwhile.
+ */
+struct ZONE_FILLER_TOOL::BACKGROUND_FILL
+{
+    std::unique_ptr<BOARD>       m_board;
+    std::vector<ZONE_CONTAINER*> m_zones;          ///< the zones to fill, on the edited board
+    std::vector<ZONE_CONTAINER*> m_copies;         ///< the same zones, in m_board
+    std::vector<std::string>     m_fingerprints;   ///< fill fingerprints of m_zones
+    std::vector<bool>            m_delivered;      ///< fill moved to the board (or dropped)
+
+    std::atomic<bool>            m_cancelled;
+    std::mutex                   m_lock;
+    std::vector<size_t>          m_filled;         ///< filled copies not delivered yet
+
+    // Last member: it is destroyed first, waiting for the worker
+    std::future<void>            m_worker;
+
+    BACKGROUND_FILL() :
+        m_cancelled( false )
+    {
+    }
+
+    bool IsFinished() const
+    {
+        return m_worker.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready;
+    }
+};
+
+
+/**
+ * Copies the items the fills of aZones depend on to a new board: the items close to the
+ * zones, and the board outlines.  Nets are copied too, so the new board does not refer to
+ * the items of aBoard.
+ * @param aCopies receives the copies of aZones
+ */
+static BOARD* copyFillInputs( BOARD* aBoard, const std::vector<ZONE_CONTAINER*>& aZones,
+                              const std::vector<BOX2I>& aAreas,
+                              std::vector<ZONE_CONTAINER*>& aCopies )
+{
+    BOARD* copy = new BOARD();
+
+    copy->SetDesignSettings( aBoard->GetDesignSettings() );
+    copy->SetEnabledLayers( aBoard->GetEnabledLayers() );
+
+    // The net codes can have gaps, and the copy renumbers them: the copied items are
+    // given the copies of their nets, not their net codes
+    NETINFO_ITEM*                                unconnected = copy->FindNet( 0 );
+    std::map<const NETINFO_ITEM*, NETINFO_ITEM*> netCopies;
+
+    for( const auto& entry : aBoard->GetNetInfo().NetsByNetcode() )
+    {
+        NETINFO_ITEM* net = entry.second;
+
+        if( entry.first == NETINFO_LIST::UNCONNECTED )
+        {
+            netCopies[net] = unconnected;
+            continue;
+        }
+
+        NETINFO_ITEM* netCopy = new NETINFO_ITEM( copy, net->GetNetname() );
+        netCopy->SetClass( net->GetNetClass() );
+        copy->Add( netCopy );
+        netCopies[net] = netCopy;
+    }
+
+    auto copyNet = [&]( BOARD_CONNECTED_ITEM* aItem )
+    {
+        auto it = netCopies.find( aItem->GetNet() );
+
+        // Orphaned items are not connected in the copy
+        aItem->SetNet( it != netCopies.end() ? it->second : unconnected );
+    };
+
+    auto isNeeded = [&]( const BOARD_ITEM* aItem )
+    {
+        BOX2I bbox = aItem->GetBoundingBox();
+        bbox.Normalize();
+
+        for( const BOX2I& area : aAreas )
+        {
+            if( area.Intersects( bbox ) )
+                return true;
+        }
+
+        return false;
+    };
+
+    auto add = [&]( BOARD_ITEM* aItem )
+    {
+        BOARD_ITEM* itemCopy = static_cast<BOARD_ITEM*>( aItem->Clone() );
+
+        copy->Add( itemCopy );
+
+        // Use the nets of the copy
+        if( MODULE* module = dyn_cast<MODULE*>( itemCopy ) )
+        {
+            for( D_PAD* pad : module->Pads() )
+                copyNet( pad );
+        }
+        else if( itemCopy->IsConnected() )
+        {
+            copyNet( static_cast<BOARD_CONNECTED_ITEM*>( itemCopy ) );
+        }
+
+        return itemCopy;
+    };
+
+    for( MODULE* module : aBoard->Modules() )
+    {
+        bool hasOutline = false;
+
+        for( BOARD_ITEM* item : module->GraphicalItems() )
+            hasOutline |= item->GetLayer() == Edge_Cuts;
+
+        if( hasOutline || isNeeded( module ) )
+            add( module );
+    }
+
+    for( TRACK* track : aBoard->Tracks() )
+    {
+        if( isNeeded( track ) )
+            add( track );
+    }
+
+    for( BOARD_ITEM* item : aBoard->Drawings() )
+    {
+        if( item->GetLayer() == Edge_Cuts || isNeeded( item ) )
+            add( item );
+    }
+
+    aCopies.assign( aZones.size(), nullptr );
+
+    for( ZONE_CONTAINER* zone : aBoard->Zones() )
+    {
+        auto it = std::find( aZones.begin(), aZones.end(), zone );
+
+        if( it == aZones.end() && !isNeeded( zone ) )
+            continue;
+
+        ZONE_CONTAINER* zoneCopy = static_cast<ZONE_CONTAINER*>( add( zone ) );
+
+        // Fills are built from the zone outlines only
+        zoneCopy->UnFill();
+
+        if( it != aZones.end() )
+            aCopies[ it - aZones.begin() ] = zoneCopy;
+    }
+
+    return copy;
+}
 
 
 ZONE_FILLER_TOOL::ZONE_FILLER_TOOL() :
-    PCB_TOOL_BASE( "pcbnew.ZoneFiller" )
+    PCB_TOOL_BASE( "pcbnew.ZoneFiller" ),
+    m_filling( false ),
+    m_knockoutCache( new ZONE_KNOCKOUT_CACHE ),
+    m_backgroundFillSuspended( false )
 {
 }
 
 
 ZONE_FILLER_TOOL::~ZONE_FILLER_TOOL()
 {
+    // The copied boards are deleted once their worker has finished the current zone
+    if( m_backgroundFill )
+        m_backgroundFill->m_cancelled = true;
+
+    for( auto& fill : m_cancelledFills )
+        fill->m_cancelled = true;
+}
+
+
+bool ZONE_FILLER_TOOL::Init()
+{
+    m_backgroundFillTimer.SetOwner( this );
+    Connect( m_backgroundFillTimer.GetId(), wxEVT_TIMER,
+             wxTimerEventHandler( ZONE_FILLER_TOOL::backgroundFillTimer ), NULL, this );
+
+    return true;
 }
 
 
 void ZONE_FILLER_TOOL::Reset( RESET_REASON aReason )
 {
+    if( aReason == MODEL_RELOAD )
+    {
+        // The zones of the background fill are not on the new board
+        if( m_backgroundFill )
+        {
+            m_backgroundFill->m_cancelled = true;
+            m_cancelledFills.push_back( std::move( m_backgroundFill ) );
+        }
+
+        m_dirtyAreas.clear();
+        m_knockoutCache->Clear();
+    }
+}
+
+
+void ZONE_FILLER_TOOL::MarkItemDirty( const BOARD_ITEM* aItem )
+{
+    // Changed pads and tracks must be knocked out again, even while filling
+    m_knockoutCache->Invalidate( aItem );
+
+    // Committing the zone fills changes the zones, but not what their fills depend on
+    if( m_filling )
+        return;
+
+    // Pads of a footprint are on the copper layers, whatever the footprint layer
+    LSET layers = aItem->Type() == PCB_MODULE_T ? LSET::AllCuMask() : aItem->GetLayerSet();
+
+    layers &= LSET::AllCuMask();
+
+    if( layers.none() )
+        return;
+
+    BOX2I area = aItem->GetBoundingBox();
+    area.Normalize();
+
+    // Merge with an area which already covers the item, to keep the list short when
+    // the same items are edited again and again
+    for( DIRTY_AREA& dirty : m_dirtyAreas )
+    {
+        if( dirty.m_area.Contains( area ) )
+        {
+            dirty.m_layers |= layers;
+            return;
+        }
+    }
+
+    m_dirtyAreas.push_back( { area, layers } );
+}
+
+
+BOX2I ZONE_FILLER_TOOL::fillArea( const ZONE_CONTAINER* aZone ) const
+{
+    int biggestClearance = board()->GetBiggestClearanceValue();
+
+    // An item changes the fill of a zone if it is closer to the zone outline than
+    // the clearance (the item clearance, pad local ones included, or the zone one)
+    // or the thermal relief gap
+    BOX2I area = aZone->GetBoundingBox();
+    area.Normalize();
+    area.Inflate( std::max( biggestClearance, aZone->GetZoneClearance() )
+                  + aZone->GetThermalReliefGap() + aZone->GetMinThickness() );
+
+    return area;
+}
+
+
+std::vector<ZONE_CONTAINER*> ZONE_FILLER_TOOL::GetDirtyZones() const
+{
+    std::vector<ZONE_CONTAINER*> dirtyZones;
+
+    if( m_dirtyAreas.empty() )
+        return dirtyZones;
+
+    for( ZONE_CONTAINER* zone : board()->Zones() )
+    {
+        if( zone->GetIsKeepout() || !zone->IsOnCopperLayer() )
+            continue;
+
+        BOX2I zoneArea = fillArea( zone );
+
+        for( const DIRTY_AREA& dirty : m_dirtyAreas )
+        {
+            if( ( dirty.m_layers & zone->GetLayerSet() ).any()
+                    && zoneArea.Intersects( dirty.m_area ) )
+            {
+                dirtyZones.push_back( zone );
+                break;
+            }
+        }
+    }
+
+    return dirtyZones;
+}
+
+
+void ZONE_FILLER_TOOL::RefillDirtyZones( wxWindow* aCaller )
+{
+    cancelBackgroundFill();
+
+    BOARD_COMMIT                 commit( this );
+    ZONE_FILLER                  filler( board(), &commit );
+    std::vector<ZONE_CONTAINER*> toFill;
+
+    filler.SetKnockoutCache( m_knockoutCache.get() );
+
+    // The changed items can be away from the copper which is really knocked out of a
+    // zone: zones whose fill inputs are unchanged are kept
+    for( ZONE_CONTAINER* zone : GetDirtyZones() )
+    {
+        if( !filler.IsFillUpToDate( zone ) )
+            toFill.push_back( zone );
+    }
+
+    m_dirtyAreas.clear();
+
+    if( toFill.empty() )
+        return;
+
+    filler.InstallNewProgressReporter( aCaller, _( "Fill Zone" ), 4 );
+
+    m_filling = true;
+    filler.Fill( toFill );
+    m_filling = false;
+
+    canvas()->Refresh();
+}
+
+
+void ZONE_FILLER_TOOL::RefillDirtyZonesInBackground()
+{
+    cancelBackgroundFill();
+
+    ZONE_FILLER filler( board() );
+    auto        fill = std::make_unique<BACKGROUND_FILL>();
+    std::vector<BOX2I> areas;
+
+    // The changed items can be away from the copper which is really knocked out of a
+    // zone: zones whose fill inputs are unchanged are kept
+    for( ZONE_CONTAINER* zone : GetDirtyZones() )
+    {
+        std::string fingerprint = filler.BuildFillFingerprint( zone );
+
+        if( zone->IsFilled() && zone->GetFillFingerprint() == fingerprint )
+            continue;
+
+        fill->m_zones.push_back( zone );
+        fill->m_fingerprints.push_back( fingerprint );
+        areas.push_back( fillArea( zone ) );
+    }
+
+    m_dirtyAreas.clear();
+
+    if( fill->m_zones.empty() )
+        return;
+
+    fill->m_board.reset( copyFillInputs( board(), fill->m_zones, areas, fill->m_copies ) );
+    fill->m_delivered.assign( fill->m_zones.size(), false );
+
+    // The knockout cache is not used: it is keyed by the items of the edited board
+    BACKGROUND_FILL* job = fill.get();
+
+    fill->m_worker = std::async( std::launch::async, [job]()
+    {
+        ZONE_FILLER copyFiller( job->m_board.get() );
+
+        if( job->m_cancelled )
+            return;
+
+        copyFiller.FillWithoutIslands( job->m_copies,
+                [job]( ZONE_CONTAINER* aCopy ) -> bool
+                {
+                    auto it = std::find( job->m_copies.begin(), job->m_copies.end(), aCopy );
+
+                    std::lock_guard<std::mutex> lock( job->m_lock );
+                    job->m_filled.push_back( it - job->m_copies.begin() );
+
+                    return !job->m_cancelled;
+                } );
+    } );
+
+    m_backgroundFill = std::move( fill );
+    m_backgroundFillTimer.Start( 100 );
+}
+
+
+void ZONE_FILLER_TOOL::cancelBackgroundFill()
+{
+    if( !m_backgroundFill )
+        return;
+
+    BACKGROUND_FILL* fill = m_backgroundFill.get();
+    fill->m_cancelled = true;
+
+    const ZONE_CONTAINERS& zones = board()->Zones();
+
+    for( size_t ii = 0; ii < fill->m_zones.size(); ++ii )
+    {
+        ZONE_CONTAINER* zone = fill->m_zones[ii];
+
+        if( !fill->m_delivered[ii] && std::find( zones.begin(), zones.end(), zone ) != zones.end() )
+            MarkItemDirty( zone );
+    }
+
+    m_cancelledFills.push_back( std::move( m_backgroundFill ) );
+}
+
+
+void ZONE_FILLER_TOOL::backgroundFillTimer( wxTimerEvent& aEvent )
+{
+    // Cancelled fills are dropped once their worker has finished
+    m_cancelledFills.erase( std::remove_if( m_cancelledFills.begin(), m_cancelledFills.end(),
+                                            []( const std::unique_ptr<BACKGROUND_FILL>& aFill )
+                                            {
+                                                return aFill->IsFinished();
+                                            } ),
+                            m_cancelledFills.end() );
+
+    if( !m_backgroundFill )
+    {
+        if( m_cancelledFills.empty() )
+            m_backgroundFillTimer.Stop();
+
+        return;
+    }
+
+    // The finished zones stay in the fill until the timer is allowed to deliver them
+    if( m_backgroundFillSuspended )
+        return;
+
+    BACKGROUND_FILL* fill = m_backgroundFill.get();
+    bool             finished = fill->IsFinished();   // checked before taking the fills
+    std::vector<size_t> filled;
+
+    {
+        std::lock_guard<std::mutex> lock( fill->m_lock );
+        filled.swap( fill->m_filled );
+    }
+
+    const ZONE_CONTAINERS&       zones = board()->Zones();
+    std::vector<ZONE_CONTAINER*> updated;
+
+    for( size_t idx : filled )
+    {
+        ZONE_CONTAINER* zone = fill->m_zones[idx];
+        ZONE_CONTAINER* copy = fill->m_copies[idx];
+
+        fill->m_delivered[idx] = true;
+
+        // The zone can have been deleted since the fill was started
+        if( std::find( zones.begin(), zones.end(), zone ) == zones.end() )
+            continue;
+
+        // A zone being edited is refilled after the edit
+        if( zone->GetEditFlags() )
+        {
+            MarkItemDirty( zone );
+            continue;
+        }
+
+        SHAPE_POLY_SET filledPolys = copy->GetFilledPolysList();
+
+        zone->SetFilledPolysUseThickness( copy->GetFilledPolysUseThickness() );
+        zone->SetRawPolysList( copy->RawPolysList() );
+        zone->SetFilledPolysList( filledPolys );
+        zone->SetIsFilled( true );
+        zone->SetFillFingerprint( fill->m_fingerprints[idx] );
+
+        updated.push_back( zone );
+    }
+
+    if( !updated.empty() )
+    {
+        ZONE_FILLER filler( board() );
+
+        // The connectivity is busy: try again on the next tick
+        if( !filler.RemoveInsulatedIslands( updated ) )
+        {
+            std::lock_guard<std::mutex> lock( fill->m_lock );
+            fill->m_filled.insert( fill->m_filled.begin(), filled.begin(), filled.end() );
+            return;
+        }
+
+        for( ZONE_CONTAINER* zone : updated )
+            getView()->Update( zone, KIGFX::ALL );
+
+        frame()->OnModify();
+        canvas()->Refresh();
+    }
+
+    if( finished )
+    {
+        m_backgroundFill.reset();
+
+        if( m_cancelledFills.empty() )
+            m_backgroundFillTimer.Stop();
+    }
 }
 
 
@@ -58,6 +537,8 @@ void ZONE_FILLER_TOOL::CheckAllZones( wxWindow* aCaller )
     if( !getEditFrame<PCB_EDIT_FRAME>()->m_ZoneFillsDirty )
         return;
 
+    cancelBackgroundFill();
+
     std::vector<ZONE_CONTAINER*> toFill;
 
     for( auto zone : board()->Zones() )
@@ -67,9 +548,15 @@ void ZONE_FILLER_TOOL::CheckAllZones( wxWindow* aCaller )
 
     ZONE_FILLER filler( frame()->GetBoard(), &commit );
     filler.InstallNewProgressReporter( aCaller, _( "Checking Zones" ), 4 );
+    filler.SetKnockoutCache( m_knockoutCache.get() );
+
+    m_filling = true;
+    bool filled = filler.Fill( toFill, true );
+    m_filling = false;
 
-    if( filler.Fill( toFill, true ) )
+    if( filled )
     {
+        m_dirtyAreas.clear();
         getEditFrame<PCB_EDIT_FRAME>()->m_ZoneFillsDirty = false;
         canvas()->Refresh();
     }
@@ -87,6 +574,8 @@ void ZONE_FILLER_TOOL::FillAllZones( wxWindow* aCaller )
 {
     std::vector<ZONE_CONTAINER*> toFill;
 
+    cancelBackgroundFill();
+
     BOARD_COMMIT commit( this );
 
     for( auto zone : board()->Zones() )
@@ -94,9 +583,17 @@ void ZONE_FILLER_TOOL::FillAllZones( wxWindow* aCaller )
 
     ZONE_FILLER filler( board(), &commit );
     filler.InstallNewProgressReporter( aCaller, _( "Fill All Zones" ),  4 );
+    filler.SetKnockoutCache( m_knockoutCache.get() );
+
+    m_filling = true;
+    bool filled = filler.Fill( toFill );
+    m_filling = false;
 
-    if( filler.Fill( toFill ) )
+    if( filled )
+    {
         getEditFrame<PCB_EDIT_FRAME>()->m_ZoneFillsDirty = false;
+        m_dirtyAreas.clear();
+    }
 
     canvas()->Refresh();
 
@@ -110,6 +607,8 @@ int ZONE_FILLER_TOOL::ZoneFill( const TOOL_EVENT& aEvent )
 {
     std::vector<ZONE_CONTAINER*> toFill;
 
+    cancelBackgroundFill();
+
     BOARD_COMMIT commit( this );
 
     if( auto passedZone = aEvent.Parameter<ZONE_CONTAINER*>() )
@@ -128,7 +627,11 @@ int ZONE_FILLER_TOOL::ZoneFill( const TOOL_EVENT& aEvent )
 
     ZONE_FILLER filler( board(), &commit );
     filler.InstallNewProgressReporter( frame(), _( "Fill Zone" ), 4 );
+    filler.SetKnockoutCache( m_knockoutCache.get() );
+
+    m_filling = true;
     filler.Fill( toFill );
+    m_filling = false;
 
     canvas()->Refresh();
     return 0;
@@ -142,6 +645,13 @@ int ZONE_FILLER_TOOL::ZoneFillAll( const TOOL_EVENT& aEvent )
 }
 
 
+int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
+{
+    RefillDirtyZones( frame() );
+    return 0;
+}
+
+
 int ZONE_FILLER_TOOL::ZoneUnfill( const TOOL_EVENT& aEvent )
 {
     BOARD_COMMIT commit( this );
@@ -189,6 +699,7 @@ void ZONE_FILLER_TOOL::setTransitions()
     // Zone actions
     Go( &ZONE_FILLER_TOOL::ZoneFill, PCB_ACTIONS::zoneFill.MakeEvent() );
     Go( &ZONE_FILLER_TOOL::ZoneFillAll, PCB_ACTIONS::zoneFillAll.MakeEvent() );
+    Go( &ZONE_FILLER_TOOL::ZoneFillDirty, PCB_ACTIONS::zoneFillDirty.MakeEvent() );
     Go( &ZONE_FILLER_TOOL::ZoneUnfill, PCB_ACTIONS::zoneUnfill.MakeEvent() );
     Go( &ZONE_FILLER_TOOL::ZoneUnfillAll, PCB_ACTIONS::zoneUnfillAll.MakeEvent() );
 }
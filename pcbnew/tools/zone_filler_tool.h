@@ -26,29 +26,80 @@
 #define ZONE_FILLER_TOOL_H
 
 #include <tools/pcb_tool_base.h>
+#include <math/box2.h>
+#include <memory>
+#include <vector>
+#include <wx/timer.h>
 
 
 class PCB_EDIT_FRAME;
+class ZONE_CONTAINER;
+class ZONE_KNOCKOUT_CACHE;
 
 /**
  * Class ZONE_FILLER_TOOL
  *
  * Handles actions specific to filling copper zones.
  */
-class ZONE_FILLER_TOOL : public PCB_TOOL_BASE
+class ZONE_FILLER_TOOL : public wxEvtHandler, public PCB_TOOL_BASE
 {
 public:
     ZONE_FILLER_TOOL();
     ~ZONE_FILLER_TOOL();
 
+    /// @copydoc TOOL_INTERACTIVE::Init()
+    bool Init() override;
+
     /// @copydoc TOOL_INTERACTIVE::Reset()
     void Reset( RESET_REASON aReason ) override;
 
     void CheckAllZones( wxWindow* aCaller );
     void FillAllZones( wxWindow* aCaller );
 
+    /**
+     * Records that aItem has been changed, so the zones whose fill depends on it are
+     * refilled by the next RefillDirtyZones().  Call it with both the old and new state
+     * of a changed item.
+     */
+    void MarkItemDirty( const BOARD_ITEM* aItem );
+
+    ///> @return true if some items have been changed since the last fill
+    bool HasDirtyZones() const
+    {
+        return !m_dirtyAreas.empty();
+    }
+
+    /**
+     * @return the zones whose fill can be changed by the items given to MarkItemDirty():
+     * the zones on a layer of an item, whose outline is closer to the item than the
+     * clearances and thermal relief gaps which can apply.
+     */
+    std::vector<ZONE_CONTAINER*> GetDirtyZones() const;
+
+    ///> Refills the zones returned by GetDirtyZones()
+    void RefillDirtyZones( wxWindow* aCaller );
+
+    /**
+     * Refills the zones returned by GetDirtyZones() in a worker thread, using a copy of the
+     * items their fills depend on.  The current fills stay displayed, and each new fill
+     * replaces the current one as soon as it is ready.  A background fill which is still
+     * running is cancelled first: its remaining zones are refilled with the new ones.
+     * Background fills are not stored in the undo list.
+     */
+    void RefillDirtyZonesInBackground();
+
+    /**
+     * Stops or restarts moving the background fills to the board, e.g. while the DRC reads
+     * the zones.  The fills finished meanwhile are moved when it is restarted.
+     */
+    void SuspendBackgroundFill( bool aSuspend )
+    {
+        m_backgroundFillSuspended = aSuspend;
+    }
+
     int ZoneFill( const TOOL_EVENT& aEvent );
     int ZoneFillAll( const TOOL_EVENT& aEvent );
+    int ZoneFillDirty( const TOOL_EVENT& aEvent );
     int ZoneUnfill( const TOOL_EVENT& aEvent );
     int ZoneUnfillAll( const TOOL_EVENT& aEvent );
 
@@ -58,6 +109,38 @@ private:
 
     ///> Sets up handlers for various events.
     void setTransitions() override;
+
+    ///> @return the area in which an item can change the fill of aZone
+    BOX2I fillArea( const ZONE_CONTAINER* aZone ) const;
+
+    struct BACKGROUND_FILL;
+
+    /**
+     * Stops the background fill.  Its zones which have not been updated yet are marked
+     * dirty to be refilled later.  Fills finished after this call are dropped.
+     */
+    void cancelBackgroundFill();
+
+    ///> Moves the finished background fills to the board
+    void backgroundFillTimer( wxTimerEvent& aEvent );
+
+    ///> Area and copper layers of a changed item
+    struct DIRTY_AREA
+    {
+        BOX2I m_area;
+        LSET  m_layers;
+    };
+
+    std::vector<DIRTY_AREA> m_dirtyAreas;   ///< items changed since the last fill
+    bool                    m_filling;      ///< the zone fills are being committed
+
+    ///> Pad and track knockouts kept between fills
+    std::unique_ptr<ZONE_KNOCKOUT_CACHE> m_knockoutCache;
+
+    std::unique_ptr<BACKGROUND_FILL>              m_backgroundFill;
+    std::vector<std::unique_ptr<BACKGROUND_FILL>> m_cancelledFills; ///< finishing their zone
+    wxTimer                                       m_backgroundFillTimer;
+    bool                                          m_backgroundFillSuspended;
 };
 
 #endif
@@ -0,0 +1,48 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <track_arrays.h>
+
+
+TRACK_ARRAYS::TRACK_ARRAYS( const TRACKS& aTracks ) :
+    m_tracks( aTracks.begin(), aTracks.end() )
+{
+    size_t count = m_tracks.size();
+
+    m_start.reserve( count );
+    m_end.reserve( count );
+    m_width.reserve( count );
+    m_layer.reserve( count );
+    m_netCode.reserve( count );
+    m_type.reserve( count );
+
+    for( TRACK* track : m_tracks )
+    {
+        m_start.push_back( track->GetStart() );
+        m_end.push_back( track->GetEnd() );
+        m_width.push_back( track->GetWidth() );
+        m_layer.push_back( track->GetLayer() );
+        m_netCode.push_back( track->GetNetCode() );
+        m_type.push_back( track->Type() );
+    }
+}
@@ -0,0 +1,84 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file track_arrays.h
+ */
+
+#ifndef TRACK_ARRAYS_H
+#define TRACK_ARRAYS_H
+
+#include <vector>
+
+#include <class_board.h>
+#include <class_track.h>
+
+/**
+ * Class TRACK_ARRAYS
+ *
+ * Packed copy of the tracks and vias of a board: the end points, width, layer, net code and
+ * type of each one in contiguous arrays, for the loops going over all the tracks many times
+ * (e.g. comparing each track with all the others) without dereferencing each TRACK.
+ *
+ * A handle is the index of a track in the arrays, which is its index in the TRACKS the
+ * arrays were built from; Track() returns the TRACK itself.  The arrays are a snapshot:
+ * they must be built again once the tracks are moved, added or removed.
+ */
+class TRACK_ARRAYS
+{
+public:
+    TRACK_ARRAYS( const TRACKS& aTracks );
+
+    size_t Size() const { return m_tracks.size(); }
+
+    TRACK* Track( size_t aHandle ) const { return m_tracks[aHandle]; }
+
+    const wxPoint& Start( size_t aHandle ) const { return m_start[aHandle]; }
+    const wxPoint& End( size_t aHandle ) const { return m_end[aHandle]; }
+    int Width( size_t aHandle ) const { return m_width[aHandle]; }
+    PCB_LAYER_ID Layer( size_t aHandle ) const { return m_layer[aHandle]; }
+    int NetCode( size_t aHandle ) const { return m_netCode[aHandle]; }
+    KICAD_T Type( size_t aHandle ) const { return m_type[aHandle]; }
+
+    /**
+     * Function IsPointOnEnds
+     * returns STARTPOINT and/or ENDPOINT if aPoint is exactly on the start and/or end point
+     * of the track aHandle, as TRACK::IsPointOnEnds( aPoint, 0 ).
+     */
+    STATUS_FLAGS IsPointOnEnds( size_t aHandle, const wxPoint& aPoint ) const
+    {
+        return ( m_start[aHandle] == aPoint ? STARTPOINT : 0 )
+               | ( m_end[aHandle] == aPoint ? ENDPOINT : 0 );
+    }
+
+private:
+    std::vector<TRACK*>       m_tracks;
+    std::vector<wxPoint>      m_start;
+    std::vector<wxPoint>      m_end;
+    std::vector<int>          m_width;
+    std::vector<PCB_LAYER_ID> m_layer;
+    std::vector<int>          m_netCode;
+    std::vector<KICAD_T>      m_type;
+};
+
+#endif    // TRACK_ARRAYS_H
@@ -37,6 +37,11 @@
 #include <tools/pcb_actions.h>
 #include <tools/global_edit_tool.h>
 #include <tracks_cleaner.h>
+#include <track_arrays.h>
+#include <thread_pool.h>
+
+#include <algorithm>
+#include <tuple>
 
 
 /* Install the cleanup dialog frame to know what should be cleaned
@@ -234,21 +239,21 @@ bool TRACKS_CLEANER::cleanupVias()
 bool TRACKS_CLEANER::testTrackEndpointDangling( TRACK* aTrack )
 {
     auto connectivity = m_brd->GetConnectivity();
-    auto items = connectivity->GetConnectivityAlgo()->ItemEntry( aTrack ).GetItems();
+    auto entry = connectivity->GetConnectivityAlgo()->FindItemEntry( aTrack );
 
     // Not in the connectivity system.  This is a bug!
-    if( items.empty() )
+    if( !entry || entry->m_items.empty() )
     {
-        wxASSERT( !items.empty() );
+        wxASSERT( entry && !entry->m_items.empty() );
         return false;
     }
 
-    auto citem = items.front();
+    auto citem = entry->m_items.front();
 
     if( !citem->Valid() )
         return false;
 
-    auto anchors = citem->Anchors();
+    auto& anchors = citem->Anchors();
 
     for( const auto& anchor : anchors )
     {
@@ -275,7 +280,7 @@ bool TRACKS_CLEANER::testTrackEndpointIsNode( TRACK* aTrack, bool aTstStart )
     if( !citem->Valid() )
         return false;
 
-    auto anchors = citem->Anchors();
+    auto& anchors = citem->Anchors();
 
     VECTOR2I refpoint = aTstStart ? aTrack->GetStart() : aTrack->GetEnd();
 
@@ -295,47 +300,78 @@ bool TRACKS_CLEANER::testTrackEndpointIsNode( TRACK* aTrack, bool aTstStart )
 
 bool TRACKS_CLEANER::deleteDanglingTracks()
 {
-    bool item_erased = false;
     bool modified = false;
 
-    do // Iterate when at least one track is deleted
+    // Ensure the connectivity is up to date
+    m_brd->BuildConnectivity();
+
+    auto                connectivity = m_brd->GetConnectivity();
+    std::vector<TRACK*> candidates( m_brd->Tracks().begin(), m_brd->Tracks().end() );
+
+    // Iterate while tracks are deleted: a track connected to a deleted track is perhaps
+    // not connected any more.  Only these tracks are tested again.
+    while( !candidates.empty() )
     {
-        item_erased = false;
-        // Ensure the connectivity is up to date, especially after removind a dangling segment
-        m_brd->BuildConnectivity();
+        // Test if a track (or a via) endpoint is not connected to another track or to a zone.
+        std::vector<char> dangling( candidates.size(), 0 );
+
+        THREAD_POOL::GetPool().ParallelFor( candidates.size(),
+                [&]( size_t aIndex )
+                {
+                    dangling[aIndex] = testTrackEndpointDangling( candidates[aIndex] );
+                } );
 
-        for( TRACK* track : m_brd->Tracks() )
+        std::vector<TRACK*> erased;
+
+        for( size_t ii = 0; ii < candidates.size(); ++ii )
         {
-            bool flag_erase = false; // Start without a good reason to erase it
+            if( !dangling[ii] )
+                continue;
 
-            // Tst if a track (or a via) endpoint is not connected to another track or to a zone.
-            if( testTrackEndpointDangling( track ) )
-                flag_erase = true;
+            TRACK* track = candidates[ii];
 
-            if( flag_erase )
+            if( m_itemsList )
             {
-                if( m_itemsList )
-                {
-                    int code = track->IsTrack() ? DRCE_DANGLING_TRACK : DRCE_DANGLING_VIA;
-                    m_itemsList->emplace_back(
-                            new DRC_ITEM( m_units, code, track, track->GetPosition() ) );
-                }
+                int code = track->IsTrack() ? DRCE_DANGLING_TRACK : DRCE_DANGLING_VIA;
+                m_itemsList->emplace_back(
+                        new DRC_ITEM( m_units, code, track, track->GetPosition() ) );
+            }
 
-                if( !m_dryRun )
-                {
-                    m_brd->Remove( track );
-                    m_commit.Removed( track );
+            // Fix me: In dry run we should disable the track to erase and retry with this
+            // disabled track.  However the connectivity algo does not handle disabled items.
+            if( !m_dryRun )
+                erased.push_back( track );
+        }
 
-                    /* keep iterating, because a track connected to the deleted track
-                     * now perhaps is not connected and should be deleted */
-                    item_erased = true;
-                    modified = true;
-                }
-                // Fix me: In dry run we should disable the track to erase and retry with this disabled track
-                // However the connectivity algo does not handle disabled items.
+        if( erased.empty() )
+            break;
+
+        std::set<TRACK*>    erasedSet( erased.begin(), erased.end() );
+        std::set<TRACK*>    neighbourSet;
+        std::vector<TRACK*> neighbours;
+
+        for( TRACK* track : erased )
+        {
+            for( TRACK* neighbour : connectivity->GetConnectedTracks( track ) )
+            {
+                if( !erasedSet.count( neighbour ) && neighbourSet.insert( neighbour ).second )
+                    neighbours.push_back( neighbour );
             }
         }
-    } while( item_erased ); // A segment was erased: test for some new dangling segments
+
+        for( TRACK* track : erased )
+        {
+            connectivity->Remove( track );
+            m_brd->Remove( track );
+            m_commit.Removed( track );
+        }
+
+        // Update the connections of the nets of the erased tracks only
+        connectivity->RecalculateRatsnest();
+
+        candidates = std::move( neighbours );
+        modified = true;
+    }
 
     return modified;
 }
@@ -403,36 +439,94 @@ bool TRACKS_CLEANER::cleanupSegments()
 
     std::set<BOARD_ITEM*> toRemove;
 
-    // Remove duplicate segments (2 superimposed identical segments):
-    for( auto it = m_brd->Tracks().begin(); it != m_brd->Tracks().end(); it++ )
+    // Remove duplicate segments (2 superimposed identical segments).  A duplicate of a
+    // segment has its two ends on the ends of the segment, so it is found in the ends of
+    // all the tracks, sorted by layer, width and position.
+    struct TRACK_END
     {
-        auto track1 = *it;
+        PCB_LAYER_ID m_layer;
+        int          m_width;
+        wxPoint      m_pos;
+        size_t       m_handle;
 
-        if( track1->Type() != PCB_TRACE_T || ( track1->GetFlags() & IS_DELETED )
-            || track1->IsLocked() )
+        bool operator<( const TRACK_END& aOther ) const
+        {
+            return std::tie( m_layer, m_width, m_pos.x, m_pos.y, m_handle )
+                   < std::tie( aOther.m_layer, aOther.m_width, aOther.m_pos.x, aOther.m_pos.y,
+                               aOther.m_handle );
+        }
+    };
+
+    TRACK_ARRAYS           tracks( m_brd->Tracks() );
+    std::vector<TRACK_END> ends;
+
+    ends.reserve( 2 * tracks.Size() );
+
+    for( size_t ii = 0; ii < tracks.Size(); ++ii )
+    {
+        ends.push_back( { tracks.Layer( ii ), tracks.Width( ii ), tracks.Start( ii ), ii } );
+
+        if( tracks.End( ii ) != tracks.Start( ii ) )
+            ends.push_back( { tracks.Layer( ii ), tracks.Width( ii ), tracks.End( ii ), ii } );
+    }
+
+    std::sort( ends.begin(), ends.end() );
+
+    // The later tracks superimposed on each segment, searched on all the threads
+    std::vector<std::vector<size_t>> duplicates( tracks.Size() );
+
+    THREAD_POOL::GetPool().ParallelFor( tracks.Size(),
+            [&]( size_t ii )
+            {
+                TRACK* track1 = tracks.Track( ii );
+
+                if( tracks.Type( ii ) != PCB_TRACE_T || ( track1->GetFlags() & IS_DELETED )
+                        || track1->IsLocked() )
+                    return;
+
+                for( const wxPoint& pos : { tracks.Start( ii ), tracks.End( ii ) } )
+                {
+                    TRACK_END key = { tracks.Layer( ii ), tracks.Width( ii ), pos, ii + 1 };
+
+                    for( auto it = std::lower_bound( ends.begin(), ends.end(), key );
+                            it != ends.end() && it->m_layer == key.m_layer
+                            && it->m_width == key.m_width && it->m_pos == pos; ++it )
+                    {
+                        size_t jj = it->m_handle;
+
+                        if( tracks.IsPointOnEnds( ii, tracks.Start( jj ) )
+                                && tracks.IsPointOnEnds( ii, tracks.End( jj ) ) )
+                        {
+                            duplicates[ii].push_back( jj );
+                        }
+                    }
+                }
+
+                std::sort( duplicates[ii].begin(), duplicates[ii].end() );
+                duplicates[ii].erase( std::unique( duplicates[ii].begin(), duplicates[ii].end() ),
+                                      duplicates[ii].end() );
+            } );
+
+    for( size_t ii = 0; ii < tracks.Size(); ++ii )
+    {
+        if( tracks.Track( ii )->GetFlags() & IS_DELETED )
             continue;
 
-        for( auto it2 = it + 1; it2 != m_brd->Tracks().end(); it2++ )
+        for( size_t jj : duplicates[ii] )
         {
-            auto track2 = *it2;
+            TRACK* track2 = tracks.Track( jj );
 
             if( track2->GetFlags() & IS_DELETED )
                 continue;
 
-            if( track1->IsPointOnEnds( track2->GetStart() )
-                    && track1->IsPointOnEnds( track2->GetEnd() )
-                    && ( track1->GetWidth() == track2->GetWidth() )
-                    && ( track1->GetLayer() == track2->GetLayer() ) )
+            if( m_itemsList )
             {
-                if( m_itemsList )
-                {
-                    m_itemsList->emplace_back( new DRC_ITEM( m_units, DRCE_DUPLICATE_TRACK, track2,
-                            track2->GetPosition(), nullptr, wxPoint() ) );
-                }
-
-                track2->SetFlags( IS_DELETED );
-                toRemove.insert( track2 );
+                m_itemsList->emplace_back( new DRC_ITEM( m_units, DRCE_DUPLICATE_TRACK, track2,
+                        track2->GetPosition(), nullptr, wxPoint() ) );
             }
+
+            track2->SetFlags( IS_DELETED );
+            toRemove.insert( track2 );
         }
     }
 
@@ -25,6 +25,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
 #include <functional>
 using namespace std::placeholders;
 #include <fctsys.h>
@@ -48,8 +49,12 @@ using namespace std::placeholders;
 #include <tools/selection_tool.h>
 #include <tools/pcbnew_control.h>
 #include <tools/pcb_editor_control.h>
+#include <tools/zone_filler_tool.h>
+#include <router/router_tool.h>
+#include <router/length_tuner_tool.h>
 #include <view/view.h>
 #include <ws_proxy_undo_item.h>
+#include <advanced_config.h>
 
 /* Functions to undo and redo edit commands.
  *  commands to undo are stored in CurrentScreen->m_UndoList
@@ -177,6 +182,9 @@ static void SwapItemData( BOARD_ITEM* aItem, BOARD_ITEM* aImage )
     // Restore pointers and time stamp, to be sure they are not broken
     aItem->SetTimeStamp( timestamp );
     aItem->SetParent( parent );
+
+    aItem->InvalidateHashes();
+    aImage->InvalidateHashes();
 }
 
 void PCB_BASE_EDIT_FRAME::SaveCopyInUndoList( BOARD_ITEM* aItem, UNDO_REDO_T aCommandType,
@@ -277,6 +285,14 @@ void PCB_BASE_EDIT_FRAME::SaveCopyInUndoList( const PICKED_ITEMS_LIST& aItemsLis
 
         wxASSERT( item );
 
+        // The legacy edits change the items once their copy is saved, without committing
+        // them: the content hashes cached for them cannot be trusted anymore.
+        if( BOARD_ITEM* boardItem = dynamic_cast<BOARD_ITEM*>(
+                    commandToUndo->GetPickedItem( ii ) ) )
+        {
+            boardItem->InvalidateHashes();
+        }
+
         switch( command )
         {
         case UR_CHANGED:
@@ -397,6 +413,30 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
     auto view = GetCanvas()->GetView();
     auto connectivity = GetBoard()->GetConnectivity();
 
+    // The zones depending on the restored items are refilled on request, as after a commit
+    ZONE_FILLER_TOOL* zoneFiller = nullptr;
+
+    if( IsType( FRAME_PCB ) )
+        zoneFiller = m_toolManager->GetTool<ZONE_FILLER_TOOL>();
+
+    // The router worlds kept between the routing sessions follow the restored items too
+    std::vector<PNS::TOOL_BASE*> routerTools;
+
+    if( IsType( FRAME_PCB ) && ADVANCED_CFG::GetCfg().m_incrementalRouterSync )
+    {
+        routerTools.push_back( m_toolManager->GetTool<ROUTER_TOOL>() );
+        routerTools.push_back( m_toolManager->GetTool<LENGTH_TUNER_TOOL>() );
+    }
+
+    auto markRouterItem = [&]( BOARD_ITEM* aItem )
+    {
+        for( PNS::TOOL_BASE* routerTool : routerTools )
+        {
+            if( routerTool )
+                routerTool->MarkItemDirty( aItem );
+        }
+    };
+
     // Undo in the reverse order of list creation: (this can allow stacked changes
     // like the same item can be changes and deleted in the same complex command
 
@@ -458,6 +498,21 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
             break;
         }
 
+        bool markZones = zoneFiller && eda_item->Type() != PCB_NETINFO_T
+                            && status != UR_DRILLORIGIN && status != UR_GRIDORIGIN
+                            && status != UR_PAGESETTINGS;
+
+        if( markZones )
+            zoneFiller->MarkItemDirty( (BOARD_ITEM*) eda_item );
+
+        // Footprints swapped with their copy get new pads: mark both the old and the new ones
+        bool markRouter = eda_item->Type() != PCB_NETINFO_T && eda_item->Type() != PCB_MARKER_T
+                            && status != UR_DRILLORIGIN && status != UR_GRIDORIGIN
+                            && status != UR_PAGESETTINGS;
+
+        if( markRouter )
+            markRouterItem( (BOARD_ITEM*) eda_item );
+
         switch( aList->GetPickedItemStatus( ii ) )
         {
         case UR_CHANGED:    /* Exchange old and new data for each item */
@@ -493,6 +548,7 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
         {
             BOARD_ITEM* item = (BOARD_ITEM*) eda_item;
             item->Move( aRedoCommand ? aList->m_TransformPoint : -aList->m_TransformPoint );
+            item->InvalidateHashes();
             view->Update( item, KIGFX::GEOMETRY );
             connectivity->Update( item );
         }
@@ -503,6 +559,7 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
             BOARD_ITEM* item = (BOARD_ITEM*) eda_item;
             item->Rotate( aList->m_TransformPoint,
                           aRedoCommand ? m_rotationAngle : -m_rotationAngle );
+            item->InvalidateHashes();
             view->Update( item, KIGFX::GEOMETRY );
             connectivity->Update( item );
         }
@@ -513,6 +570,7 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
             BOARD_ITEM* item = (BOARD_ITEM*) eda_item;
             item->Rotate( aList->m_TransformPoint,
                           aRedoCommand ? -m_rotationAngle : m_rotationAngle );
+            item->InvalidateHashes();
             view->Update( item, KIGFX::GEOMETRY );
             connectivity->Update( item );
         }
@@ -522,6 +580,7 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
         {
             BOARD_ITEM* item = (BOARD_ITEM*) eda_item;
             item->Flip( aList->m_TransformPoint, m_configSettings.m_FlipLeftRight );
+            item->InvalidateHashes();
             view->Update( item, KIGFX::LAYERS );
             connectivity->Update( item );
         }
@@ -558,6 +617,12 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
                         aList->GetPickedItemStatus( ii ) );
             break;
         }
+
+        if( markZones )
+            zoneFiller->MarkItemDirty( (BOARD_ITEM*) eda_item );
+
+        if( markRouter )
+            markRouterItem( (BOARD_ITEM*) eda_item );
     }
 
     if( not_found )
@@ -579,6 +644,89 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
 
 
 
+/**
+ * Estimates the memory of a board item and of the items it owns.  The geometry shared with
+ * other copies of the item is shared among them.
+ */
+static size_t estimateItemSize( const BOARD_ITEM* aItem )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_MODULE_T:
+    {
+        const MODULE* module = static_cast<const MODULE*>( aItem );
+        size_t size = sizeof( MODULE ) + 2 * sizeof( TEXTE_MODULE );
+
+        size += module->Pads().size() * sizeof( D_PAD );
+
+        for( const BOARD_ITEM* item : module->GraphicalItems() )
+            size += estimateItemSize( item );
+
+        return size;
+    }
+
+    case PCB_ZONE_AREA_T:
+    {
+        const ZONE_CONTAINER* zone = static_cast<const ZONE_CONTAINER*>( aItem );
+        std::shared_ptr<const SHAPE_POLY_SET> fill = zone->GetSharedFilledPolysList();
+        size_t size = sizeof( ZONE_CONTAINER );
+
+        size += zone->Outline()->TotalVertices() * sizeof( VECTOR2I );
+        size += zone->FillSegments().size() * sizeof( SEG );
+
+        // The copy held here is not an owner of the filled polygons
+        long owners = std::max( fill.use_count() - 1, 1L );
+        size += fill->TotalVertices() * sizeof( VECTOR2I ) / owners;
+
+        return size;
+    }
+
+    case PCB_LINE_T:
+    {
+        const DRAWSEGMENT* segment = static_cast<const DRAWSEGMENT*>( aItem );
+        return sizeof( DRAWSEGMENT )
+                + segment->GetPolyShape().TotalVertices() * sizeof( VECTOR2I );
+    }
+
+    case PCB_MODULE_EDGE_T:
+    {
+        const EDGE_MODULE* edge = static_cast<const EDGE_MODULE*>( aItem );
+        return sizeof( EDGE_MODULE ) + edge->GetPolyShape().TotalVertices() * sizeof( VECTOR2I );
+    }
+
+    case PCB_MODULE_TEXT_T: return sizeof( TEXTE_MODULE );
+    case PCB_TEXT_T:        return sizeof( TEXTE_PCB );
+    case PCB_TRACE_T:       return sizeof( TRACK );
+    case PCB_VIA_T:         return sizeof( VIA );
+    case PCB_DIMENSION_T:   return sizeof( DIMENSION );
+    case PCB_TARGET_T:      return sizeof( PCB_TARGET );
+    default:                return sizeof( BOARD_ITEM );
+    }
+}
+
+
+size_t PCB_SCREEN::GetCommandMemorySize( const PICKED_ITEMS_LIST& aCommand ) const
+{
+    size_t size = sizeof( PICKED_ITEMS_LIST ) + aCommand.GetCount() * sizeof( ITEM_PICKER );
+
+    for( unsigned ii = 0; ii < aCommand.GetCount(); ii++ )
+    {
+        ITEM_PICKER picker = aCommand.GetItemWrapper( ii );
+
+        // The links are always owned by the command, the items only once deleted
+        if( BOARD_ITEM* link = dynamic_cast<BOARD_ITEM*>( picker.GetLink() ) )
+            size += estimateItemSize( link );
+
+        BOARD_ITEM* item = dynamic_cast<BOARD_ITEM*>( picker.GetItem() );
+
+        if( item && ( ( picker.GetFlags() & UR_TRANSIENT ) || picker.GetStatus() == UR_DELETED ) )
+            size += estimateItemSize( item );
+    }
+
+    return size;
+}
+
+
 void PCB_SCREEN::ClearUndoORRedoList( UNDO_REDO_CONTAINER& aList, int aItemCount )
 {
     if( aItemCount == 0 )
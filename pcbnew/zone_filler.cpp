@@ -24,10 +24,9 @@
  */
 
 #include <cstdint>
-#include <thread>
 #include <mutex>
 #include <algorithm>
-#include <future>
+#include <deque>
 
 #include <class_board.h>
 #include <class_zone.h>
@@ -42,12 +41,17 @@
 #include <board_commit.h>
 
 #include <widgets/progress_reporter.h>
+#include <profile.h>
+#include <profile_registry.h>
+#include <thread_pool.h>
 
 #include <geometry/shape_poly_set.h>
 #include <geometry/shape_file_io.h>
 #include <geometry/convex_hull.h>
 #include <geometry/geometry_utils.h>
+#include <convert_basic_shapes_to_polygon.h>
 #include <confirm.h>
+#include <hash_eda.h>
 
 #include "zone_filler.h"
 
@@ -81,8 +85,13 @@ static const bool s_DumpZonesWhenFilling = false;
 
 ZONE_FILLER::ZONE_FILLER(  BOARD* aBoard, COMMIT* aCommit ) :
     m_board( aBoard ), m_brdOutlinesValid( false ), m_commit( aCommit ),
-    m_progressReporter( nullptr )
+    m_progressReporter( nullptr ), m_knockoutCache( nullptr ),
+    m_fillStats( nullptr )
 {
+    // The arcs are approximated from the max error of the board, so the segment count of
+    // each arc depends on its radius: a small via gets far fewer segments than a big hole.
+    m_high_def = m_board->GetDesignSettings().m_MaxError;
+    m_low_def = std::min( ARC_LOW_DEF, int( m_high_def*1.5 ) );   // Reasonable value
 }
 
 
@@ -99,14 +108,130 @@ void ZONE_FILLER::InstallNewProgressReporter( wxWindow* aParent, const wxString&
 }
 
 
+bool ZONE_FILLER::filledPolysUseThickness() const
+{
+    if( ADVANCED_CFG::GetCfg().m_forceThickOutlinesInZones )
+        return true;
+
+    return !m_board->GetDesignSettings().m_ZoneUseNoOutlineInFill;
+}
+
+
+void ZONE_FILLER::buildBoardOutline()
+{
+    // The board outlines is used to clip solid areas inside the board (when outlines are valid)
+    m_boardOutline.RemoveAllContours();
+    m_brdOutlinesValid = m_board->GetBoardPolygonOutlines( m_boardOutline );
+}
+
+
+void ZONE_FILLER::removeIslands( CN_ZONE_ISOLATED_ISLAND_LIST& aZone )
+{
+    std::sort( aZone.m_islands.begin(), aZone.m_islands.end(), std::greater<int>() );
+    SHAPE_POLY_SET poly = aZone.m_zone->GetFilledPolysList();
+
+    // Remove solid areas outside the board cutouts and the insulated islands
+    // only zones with net code > 0 can have insulated islands by definition
+    if( aZone.m_zone->GetNetCode() > 0 )
+    {
+        // solid areas outside the board cutouts are also removed, because they are usually
+        // insulated islands
+        for( auto idx : aZone.m_islands )
+        {
+            poly.DeletePolygon( idx );
+        }
+    }
+    // Zones with no net can have areas outside the board cutouts.
+    // By definition, Zones with no net have no isolated island
+    // (in fact all filled areas are isolated islands)
+    // but they can have some areas outside the board cutouts.
+    // A filled area outside the board cutouts has all points outside cutouts,
+    // so we only need to check one point for each filled polygon.
+    // Note also non copper zones are already clipped
+    else if( m_brdOutlinesValid && aZone.m_zone->IsOnCopperLayer() )
+    {
+        for( int idx = 0; idx < poly.OutlineCount(); )
+        {
+            if( poly.Polygon( idx ).empty() ||
+                !m_boardOutline.Contains( poly.Polygon( idx ).front().CPoint( 0 ) ) )
+            {
+                poly.DeletePolygon( idx );
+            }
+            else
+                 idx++;
+        }
+    }
+
+    aZone.m_zone->SetFilledPolysList( poly );
+}
+
+
+void ZONE_FILLER::FillWithoutIslands( const std::vector<ZONE_CONTAINER*>& aZones,
+                                      const std::function<bool( ZONE_CONTAINER* )>& aFilled )
+{
+    bool filledPolyWithOutline = filledPolysUseThickness();
+
+    buildBoardOutline();
+
+    for( ZONE_CONTAINER* zone : aZones )
+    {
+        if( zone->GetIsKeepout() )
+            continue;
+
+        zone->SetFilledPolysUseThickness( filledPolyWithOutline );
+        SHAPE_POLY_SET rawPolys, finalPolys;
+        fillSingleZone( zone, rawPolys, finalPolys );
+
+        zone->SetRawPolysList( rawPolys );
+        zone->SetFilledPolysList( finalPolys );
+        zone->SetIsFilled( true );
+
+        if( !aFilled( zone ) )
+            break;
+    }
+}
+
+
+bool ZONE_FILLER::RemoveInsulatedIslands( const std::vector<ZONE_CONTAINER*>& aZones )
+{
+    std::vector<CN_ZONE_ISOLATED_ISLAND_LIST> islands;
+    auto connectivity = m_board->GetConnectivity();
+
+    std::unique_lock<std::mutex> lock( connectivity->GetLock(), std::try_to_lock );
+
+    if( !lock )
+        return false;
+
+    buildBoardOutline();
+
+    for( ZONE_CONTAINER* zone : aZones )
+        islands.emplace_back( CN_ZONE_ISOLATED_ISLAND_LIST( zone ) );
+
+    connectivity->FindIsolatedCopperIslands( islands );
+
+    for( auto& zone : islands )
+    {
+        removeIslands( zone );
+        zone.m_zone->CacheTriangulation();
+    }
+
+    // There is no commit to update the connectivity: the zones are updated as Fill() does
+    for( ZONE_CONTAINER* zone : aZones )
+        connectivity->Update( zone );
+
+    connectivity->RecalculateRatsnest();
+
+    return true;
+}
+
+
 bool ZONE_FILLER::Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck )
 {
+    PROF_SCOPE profScope( "zone fill" );
+
     std::vector<CN_ZONE_ISOLATED_ISLAND_LIST> toFill;
     auto connectivity = m_board->GetConnectivity();
-    bool filledPolyWithOutline = not m_board->GetDesignSettings().m_ZoneUseNoOutlineInFill;
-
-    if( ADVANCED_CFG::GetCfg().m_forceThickOutlinesInZones )
-        filledPolyWithOutline = true;
+    bool filledPolyWithOutline = filledPolysUseThickness();
 
     std::unique_lock<std::mutex> lock( connectivity->GetLock(), std::try_to_lock );
 
@@ -119,9 +244,10 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck
         m_progressReporter->SetMaxProgress( toFill.size() );
     }
 
-    // The board outlines is used to clip solid areas inside the board (when outlines are valid)
-    m_boardOutline.RemoveAllContours();
-    m_brdOutlinesValid = m_board->GetBoardPolygonOutlines( m_boardOutline );
+    buildBoardOutline();
+
+    // The fingerprints are built before filling, from the fill inputs only
+    std::vector<std::string> fingerprints;
 
     for( auto zone : aZones )
     {
@@ -129,6 +255,14 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck
         if( zone->GetIsKeepout() )
             continue;
 
+        std::string fingerprint = BuildFillFingerprint( zone );
+
+        // A fill built from the same inputs needs neither a refill nor a new triangulation
+        if( aCheck && zone->IsFilled() && zone->GetFillFingerprint() == fingerprint )
+            continue;
+
+        fingerprints.push_back( fingerprint );
+
         if( m_commit )
             m_commit->Modify( zone );
 
@@ -144,55 +278,35 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck
         zone->UnFill();
     }
 
-    std::atomic<size_t> nextItem( 0 );
-    size_t              parallelThreadCount =
-            std::min<size_t>( std::thread::hardware_concurrency(), aZones.size() );
-    std::vector<std::future<size_t>> returns( parallelThreadCount );
-
-    auto fill_lambda = [&] ( PROGRESS_REPORTER* aReporter ) -> size_t
-    {
-        size_t num = 0;
-
-        for( size_t i = nextItem++; i < toFill.size(); i = nextItem++ )
-        {
-            ZONE_CONTAINER* zone = toFill[i].m_zone;
-            zone->SetFilledPolysUseThickness( filledPolyWithOutline );
-            SHAPE_POLY_SET rawPolys, finalPolys;
-            fillSingleZone( zone, rawPolys, finalPolys );
+    std::vector<ZONE_FILL_STATS> stats( m_fillStats ? toFill.size() : 0 );
 
-            zone->SetRawPolysList( rawPolys );
-            zone->SetFilledPolysList( finalPolys );
-            zone->SetIsFilled( true );
+    // Here we balance returns with a 100ms timeout to allow UI updating
+    std::function<void()> refresh;
 
-            if( m_progressReporter )
-                m_progressReporter->AdvanceProgress();
+    if( m_progressReporter )
+        refresh = [this]() { m_progressReporter->KeepRefreshing(); };
 
-            num++;
-        }
+    if( m_knockoutCache )
+        cacheItemHashes();
 
-        return num;
-    };
+    // The knockouts and spokes of each zone are built on the pool too, so the cores left
+    // free when there are fewer zones than cores help with the biggest zones
+    THREAD_POOL::GetPool().ParallelFor( toFill.size(),
+            [&]( size_t i )
+            {
+                ZONE_CONTAINER* zone = toFill[i].m_zone;
+                zone->SetFilledPolysUseThickness( filledPolyWithOutline );
+                SHAPE_POLY_SET rawPolys, finalPolys;
+                fillSingleZone( zone, rawPolys, finalPolys, m_fillStats ? &stats[i] : nullptr );
 
-    if( parallelThreadCount <= 1 )
-        fill_lambda( m_progressReporter );
-    else
-    {
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-            returns[ii] = std::async( std::launch::async, fill_lambda, m_progressReporter );
+                zone->SetRawPolysList( rawPolys );
+                zone->SetFilledPolysList( finalPolys );
+                zone->SetIsFilled( true );
 
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-        {
-            // Here we balance returns with a 100ms timeout to allow UI updating
-            std::future_status status;
-            do
-            {
                 if( m_progressReporter )
-                    m_progressReporter->KeepRefreshing();
-
-                status = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
-            } while( status != std::future_status::ready );
-        }
-    }
+                    m_progressReporter->AdvanceProgress();
+            },
+            1, ADVANCED_CFG::GetCfg().m_maxZoneFillThreads, refresh );
 
     // Now update the connectivity to check for copper islands
     if( m_progressReporter )
@@ -210,44 +324,9 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck
 
     for( auto& zone : toFill )
     {
-        std::sort( zone.m_islands.begin(), zone.m_islands.end(), std::greater<int>() );
-        SHAPE_POLY_SET poly = zone.m_zone->GetFilledPolysList();
-
-        // Remove solid areas outside the board cutouts and the insulated islands
-        // only zones with net code > 0 can have insulated islands by definition
-        if( zone.m_zone->GetNetCode() > 0 )
-        {
-            // solid areas outside the board cutouts are also removed, because they are usually
-            // insulated islands
-            for( auto idx : zone.m_islands )
-            {
-                poly.DeletePolygon( idx );
-            }
-        }
-        // Zones with no net can have areas outside the board cutouts.
-        // By definition, Zones with no net have no isolated island
-        // (in fact all filled areas are isolated islands)
-        // but they can have some areas outside the board cutouts.
-        // A filled area outside the board cutouts has all points outside cutouts,
-        // so we only need to check one point for each filled polygon.
-        // Note also non copper zones are already clipped
-        else if( m_brdOutlinesValid && zone.m_zone->IsOnCopperLayer() )
-        {
-            for( int idx = 0; idx < poly.OutlineCount(); )
-            {
-                if( poly.Polygon( idx ).empty() ||
-                    !m_boardOutline.Contains( poly.Polygon( idx ).front().CPoint( 0 ) ) )
-                {
-                    poly.DeletePolygon( idx );
-                }
-                else
-                     idx++;
-            }
-        }
+        removeIslands( zone );
 
-        zone.m_zone->SetFilledPolysList( poly );
-
-        if( aCheck && zone.m_zone->GetHashValue() != poly.GetHash() )
+        if( aCheck && zone.m_zone->GetHashValue() != zone.m_zone->GetFilledPolysList().GetHash() )
             outOfDate = true;
     }
 
@@ -278,44 +357,20 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck
     }
 
 
-    nextItem = 0;
-
-    auto tri_lambda = [&] ( PROGRESS_REPORTER* aReporter ) -> size_t
-    {
-        size_t num = 0;
-
-        for( size_t i = nextItem++; i < toFill.size(); i = nextItem++ )
-        {
-            toFill[i].m_zone->CacheTriangulation();
-            num++;
-
-            if( m_progressReporter )
-                m_progressReporter->AdvanceProgress();
-        }
+    THREAD_POOL::GetPool().ParallelFor( toFill.size(),
+            [&]( size_t i )
+            {
+                PROF_COUNTER timer;
 
-        return num;
-    };
+                toFill[i].m_zone->CacheTriangulation();
 
-    if( parallelThreadCount <= 1 )
-        tri_lambda( m_progressReporter );
-    else
-    {
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-            returns[ii] = std::async( std::launch::async, tri_lambda, m_progressReporter );
+                if( m_fillStats )
+                    stats[i].m_triangulation = timer.SinceStart<ZONE_FILL_STATS::DURATION>();
 
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-        {
-            // Here we balance returns with a 100ms timeout to allow UI updating
-            std::future_status status;
-            do
-            {
                 if( m_progressReporter )
-                    m_progressReporter->KeepRefreshing();
-
-                status = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
-            } while( status != std::future_status::ready );
-        }
-    }
+                    m_progressReporter->AdvanceProgress();
+            },
+            1, ADVANCED_CFG::GetCfg().m_maxZoneFillThreads, refresh );
 
     if( m_progressReporter )
     {
@@ -326,6 +381,20 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck
 
     connectivity->SetProgressReporter( nullptr );
 
+    for( size_t ii = 0; ii < toFill.size(); ++ii )
+        toFill[ii].m_zone->SetFillFingerprint( fingerprints[ii] );
+
+    if( m_fillStats )
+    {
+        for( size_t ii = 0; ii < toFill.size(); ++ii )
+        {
+            stats[ii].m_zone = toFill[ii].m_zone;
+            stats[ii].m_filledVertices = toFill[ii].m_zone->GetFilledPolysList().TotalVertices();
+        }
+
+        m_fillStats->insert( m_fillStats->end(), stats.begin(), stats.end() );
+    }
+
     if( m_commit )
     {
         m_commit->Push( _( "Fill Zone(s)" ), false );
@@ -342,6 +411,159 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck
 }
 
 
+std::string ZONE_FILLER::BuildFillFingerprint( const ZONE_CONTAINER* aZone ) const
+{
+    // To be changed when the fill algorithm changes, so that older fills are rebuilt
+    const int FILL_ALGORITHM_VERSION = 1;
+
+    MD5_HASH hash;
+
+    auto hashPoint = [&]( const wxPoint& aPt )
+    {
+        hash.Hash( aPt.x );
+        hash.Hash( aPt.y );
+    };
+
+    auto hashDouble = [&]( double aValue )
+    {
+        hash.Hash( (uint8_t*) &aValue, sizeof( aValue ) );
+    };
+
+    // The contents of the items are hashed once, until they are changed
+    auto hashItem = [&]( const BOARD_ITEM* aItem )
+    {
+        size_t itemHash = hash_eda_cached( aItem );
+        hash.Hash( (uint8_t*) &itemHash, sizeof( itemHash ) );
+    };
+
+    auto hashBBox = [&]( const EDA_RECT& aBBox )
+    {
+        hashPoint( aBBox.GetOrigin() );
+        hashPoint( aBBox.GetEnd() );
+    };
+
+    const BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+    bool filledPolyWithOutline = !bds.m_ZoneUseNoOutlineInFill
+                                    || ADVANCED_CFG::GetCfg().m_forceThickOutlinesInZones;
+
+    hash.Hash( FILL_ALGORITHM_VERSION );
+    hash.Hash( bds.m_MaxError );
+    hash.Hash( bds.m_CopperEdgeClearance );
+    hash.Hash( filledPolyWithOutline );
+
+    // The zone itself.  The clearances come from the net classes too, which are not part
+    // of the items.
+    hashItem( aZone );
+    hash.Hash( aZone->GetClearance() );
+
+    // Only the items closer to the zone than the clearances (the pad local ones included)
+    // and thermal gaps change the fill
+    EDA_RECT zoneBBox = aZone->GetBoundingBox();
+    zoneBBox.Inflate( std::max( m_board->GetBiggestClearanceValue(), aZone->GetClearance() )
+                      + aZone->GetThermalReliefGap() );
+
+    for( MODULE* module : m_board->Modules() )
+    {
+        if( !module->GetBoundingBox().Intersects( zoneBBox ) )
+            continue;
+
+        for( D_PAD* pad : module->Pads() )
+        {
+            if( !pad->GetBoundingBox().Intersects( zoneBBox ) )
+                continue;
+
+            // The hash of a pad is in the coordinates of its footprint
+            hashItem( pad );
+            hashPoint( pad->GetPosition() );
+            hashDouble( pad->GetOrientation() );
+            hash.Hash( pad->GetClearance() );
+            hash.Hash( aZone->GetPadConnection( pad ) );
+            hash.Hash( aZone->GetThermalReliefGap( pad ) );
+            hash.Hash( aZone->GetThermalReliefCopperBridge( pad ) );
+        }
+    }
+
+    for( TRACK* track : m_board->Tracks() )
+    {
+        if( !track->IsOnLayer( aZone->GetLayer() ) )
+            continue;
+
+        if( !track->GetBoundingBox().Intersects( zoneBBox ) )
+            continue;
+
+        hashItem( track );
+        hash.Hash( track->GetClearance() );
+    }
+
+    // Graphic items knock out their bounding box (texts) or their shape.  The board edges
+    // also clip the zone, wherever they are.
+    auto hashGraphicItem = [&]( BOARD_ITEM* aItem )
+    {
+        bool onEdge = aItem->IsOnLayer( Edge_Cuts );
+
+        if( !onEdge && !aItem->IsOnLayer( aZone->GetLayer() ) )
+            return;
+
+        if( !onEdge && !aItem->GetBoundingBox().Intersects( zoneBBox ) )
+            return;
+
+        hash.Hash( aItem->Type() );
+        hash.Hash( aItem->GetLayer() );
+        hashBBox( aItem->GetBoundingBox() );
+
+        // The dimensions and targets are known by their bounding box only
+        switch( aItem->Type() )
+        {
+        case PCB_LINE_T:
+        case PCB_TEXT_T:
+        case PCB_MODULE_EDGE_T:
+        case PCB_MODULE_TEXT_T:
+            hashItem( aItem );
+            break;
+
+        default:
+            break;
+        }
+    };
+
+    for( MODULE* module : m_board->Modules() )
+    {
+        hashGraphicItem( &module->Reference() );
+        hashGraphicItem( &module->Value() );
+
+        for( BOARD_ITEM* item : module->GraphicalItems() )
+            hashGraphicItem( item );
+    }
+
+    for( BOARD_ITEM* item : m_board->Drawings() )
+        hashGraphicItem( item );
+
+    // Zones and keepouts sharing a layer can knock out the zone
+    for( ZONE_CONTAINER* zone : m_board->Zones() )
+    {
+        if( zone == aZone || !aZone->CommonLayerExists( zone->GetLayerSet() ) )
+            continue;
+
+        if( !zone->GetBoundingBox().Intersects( zoneBBox ) )
+            continue;
+
+        hashItem( zone );
+        hash.Hash( zone->GetClearance() );
+    }
+
+    hash.Finalize();
+
+    return hash.Format();
+}
+
+
+bool ZONE_FILLER::IsFillUpToDate( const ZONE_CONTAINER* aZone ) const
+{
+    return aZone->IsFilled() && !aZone->GetFillFingerprint().empty()
+            && aZone->GetFillFingerprint() == BuildFillFingerprint( aZone );
+}
+
+
 /**
  * Return true if the given pad has a thermal connection with the given zone.
  */
@@ -417,15 +639,59 @@ void ZONE_FILLER::addKnockout( D_PAD* aPad, int aGap, SHAPE_POLY_SET& aHoles )
     }
     else
     {
-        // Optimizing polygon vertex count: the high definition is used for round
-        // and oval pads (pads with large arcs) but low def for other shapes (with
-        // small arcs)
-        if( aPad->GetShape() == PAD_SHAPE_CIRCLE || aPad->GetShape() == PAD_SHAPE_OVAL ||
-          ( aPad->GetShape() == PAD_SHAPE_ROUNDRECT && aPad->GetRoundRectRadiusRatio() > 0.4 ) )
-            aPad->TransformShapeWithClearanceToPolygon( aHoles, aGap, m_high_def );
-        else
-            aPad->TransformShapeWithClearanceToPolygon( aHoles, aGap, m_low_def );
+        aPad->TransformShapeWithClearanceToPolygon( aHoles, aGap, knockoutMaxError( aPad ) );
+    }
+}
+
+
+int ZONE_FILLER::knockoutMaxError( const BOARD_ITEM* aItem ) const
+{
+    if( aItem->Type() != PCB_PAD_T )
+        return m_low_def;
+
+    const D_PAD* pad = static_cast<const D_PAD*>( aItem );
+
+    // Optimizing polygon vertex count: the high definition is used for round
+    // and oval pads (pads with large arcs) but low def for other shapes (with
+    // small arcs)
+    if( pad->GetShape() == PAD_SHAPE_CUSTOM || pad->GetShape() == PAD_SHAPE_CIRCLE
+            || pad->GetShape() == PAD_SHAPE_OVAL
+            || ( pad->GetShape() == PAD_SHAPE_ROUNDRECT && pad->GetRoundRectRadiusRatio() > 0.4 ) )
+        return m_high_def;
+
+    return m_low_def;
+}
+
+
+size_t ZONE_FILLER::knockoutHash( const BOARD_ITEM* aItem ) const
+{
+    size_t hash = hash_eda_cached( aItem );
+
+    // The hash of a pad is in the coordinates of its footprint
+    if( aItem->Type() == PCB_PAD_T )
+    {
+        const D_PAD* pad = static_cast<const D_PAD*>( aItem );
+
+        hash_combine( hash, pad->GetPosition().x );
+        hash_combine( hash, pad->GetPosition().y );
+        hash_combine( hash, pad->GetOrientation() );
+    }
+
+    return hash;
+}
+
+
+void ZONE_FILLER::cacheItemHashes()
+{
+    // hash_eda_cached() stores the hashes in the items, which is not thread safe
+    for( MODULE* module : m_board->Modules() )
+    {
+        for( D_PAD* pad : module->Pads() )
+            hash_eda_cached( pad );
     }
+
+    for( TRACK* track : m_board->Tracks() )
+        hash_eda_cached( track );
 }
 
 
@@ -471,20 +737,131 @@ void ZONE_FILLER::addKnockout( BOARD_ITEM* aItem, int aGap, bool aIgnoreLineWidt
 }
 
 
+void ZONE_FILLER::buildKnockouts( const std::vector<KNOCKOUT>& aKnockouts,
+                                  SHAPE_POLY_SET& aHoles )
+{
+    TransformShapesToPolygon( aHoles, aKnockouts.size(),
+            [&]( size_t aIndex, SHAPE_POLY_SET& aBuffer )
+            {
+                aKnockouts[aIndex]( aBuffer );
+            } );
+}
+
+
+void ZONE_FILLER::addCachedKnockout( BOARD_ITEM* aItem, int aGap, SHAPE_POLY_SET& aHoles )
+{
+    // The key and the knockout use the same arc approximation error
+    int maxError = knockoutMaxError( aItem );
+
+    auto build = [&]( SHAPE_POLY_SET& aKnockout )
+    {
+        if( aItem->Type() == PCB_PAD_T )
+            addKnockout( static_cast<D_PAD*>( aItem ), aGap, aKnockout );
+        else
+            static_cast<TRACK*>( aItem )->TransformShapeWithClearanceToPolygon( aKnockout, aGap,
+                                                                                maxError );
+    };
+
+    if( !m_knockoutCache )
+    {
+        build( aHoles );
+        return;
+    }
+
+    size_t                                hash = knockoutHash( aItem );
+    std::shared_ptr<const SHAPE_POLY_SET> knockout = m_knockoutCache->Get( hash, aGap, maxError );
+
+    if( !knockout )
+    {
+        auto newKnockout = std::make_shared<SHAPE_POLY_SET>();
+        build( *newKnockout );
+
+        m_knockoutCache->Store( aItem, hash, aGap, maxError, newKnockout );
+        knockout = newKnockout;
+    }
+
+    aHoles.Append( *knockout );
+}
+
+
+std::shared_ptr<const SHAPE_POLY_SET> ZONE_KNOCKOUT_CACHE::Get( size_t aHash, int aGap,
+                                                                int aMaxError )
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    auto it = m_knockouts.find( KEY{ aHash, aGap, aMaxError } );
+
+    if( it == m_knockouts.end() )
+        return nullptr;
+
+    return it->second;
+}
+
+
+void ZONE_KNOCKOUT_CACHE::Store( const BOARD_ITEM* aItem, size_t aHash, int aGap, int aMaxError,
+                                 std::shared_ptr<const SHAPE_POLY_SET> aKnockout )
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    KEY key{ aHash, aGap, aMaxError };
+
+    // Another fill thread can have stored the same knockout meanwhile
+    if( m_knockouts.emplace( key, std::move( aKnockout ) ).second )
+        m_itemKeys[aItem].push_back( key );
+}
+
+
+void ZONE_KNOCKOUT_CACHE::Invalidate( const BOARD_ITEM* aItem )
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    auto invalidate = [&]( const BOARD_ITEM* aCachedItem )
+    {
+        auto it = m_itemKeys.find( aCachedItem );
+
+        if( it == m_itemKeys.end() )
+            return;
+
+        for( const KEY& key : it->second )
+            m_knockouts.erase( key );
+
+        m_itemKeys.erase( it );
+    };
+
+    invalidate( aItem );
+
+    // The pads of a changed footprint are changed too
+    if( aItem->Type() == PCB_MODULE_T )
+    {
+        for( D_PAD* pad : static_cast<const MODULE*>( aItem )->Pads() )
+            invalidate( pad );
+    }
+}
+
+
+void ZONE_KNOCKOUT_CACHE::Clear()
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    m_knockouts.clear();
+    m_itemKeys.clear();
+}
+
+
 /**
- * Removes thermal reliefs from the shape for any pads connected to the zone.  Does NOT add
- * in spokes, which must be done later.
+ * Builds the thermal reliefs to remove from the shape for any pads connected to the zone.
+ * Does NOT add in spokes, which must be done later.
  */
-void ZONE_FILLER::knockoutThermalReliefs( const ZONE_CONTAINER* aZone, SHAPE_POLY_SET& aFill )
+void ZONE_FILLER::buildThermalReliefs( const ZONE_CONTAINER* aZone, SHAPE_POLY_SET& aHoles )
 {
-    SHAPE_POLY_SET holes;
+    std::vector<KNOCKOUT> knockouts;
 
     // Use a dummy pad to calculate relief when a pad has a hole but is not on the zone's
     // copper layer.  The dummy pad has the size and shape of the original pad's hole. We have
     // to give it a parent because some functions expect a non-null parent to find clearance
-    // data, etc.
-    MODULE  dummymodule( m_board );
-    D_PAD   dummypad( &dummymodule );
+    // data, etc.  Each hole has its own dummy pad, as the knockouts are built later.
+    MODULE            dummymodule( m_board );
+    std::deque<D_PAD> dummypads;
 
     for( auto module : m_board->Modules() )
     {
@@ -500,16 +877,29 @@ void ZONE_FILLER::knockoutThermalReliefs( const ZONE_CONTAINER* aZone, SHAPE_POL
                 if( pad->GetDrillSize().x == 0 && pad->GetDrillSize().y == 0 )
                     continue;
 
-                setupDummyPadForHole( pad, dummypad );
-                pad = &dummypad;
+                dummypads.emplace_back( &dummymodule );
+                setupDummyPadForHole( pad, dummypads.back() );
+
+                D_PAD* hole = &dummypads.back();
+                int    gap = aZone->GetThermalReliefGap( hole );
+
+                knockouts.emplace_back( [this, hole, gap]( SHAPE_POLY_SET& aHoles )
+                                        {
+                                            addKnockout( hole, gap, aHoles );
+                                        } );
+                continue;
             }
 
-            addKnockout( pad, aZone->GetThermalReliefGap( pad ), holes );
+            int gap = aZone->GetThermalReliefGap( pad );
+
+            knockouts.emplace_back( [this, pad, gap]( SHAPE_POLY_SET& aHoles )
+                                    {
+                                        addCachedKnockout( pad, gap, aHoles );
+                                    } );
         }
     }
 
-    holes.Simplify( SHAPE_POLY_SET::PM_FAST );
-    aFill.BooleanSubtract( holes, SHAPE_POLY_SET::PM_FAST );
+    buildKnockouts( knockouts, aHoles );
 }
 
 
@@ -530,12 +920,17 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE_CONTAINER* aZone, SHAPE_
     biggest_clearance = std::max( biggest_clearance, zone_clearance );
     zone_boundingbox.Inflate( biggest_clearance );
 
+    // The items are selected here, and their knockouts are built at the end, on several
+    // threads when there are free cores.
+    std::vector<KNOCKOUT> knockouts;
+
     // Use a dummy pad to calculate hole clearance when a pad has a hole but is not on the
     // zone's copper layer.  The dummy pad has the size and shape of the original pad's hole.
     // We have to give it a parent because some functions expect a non-null parent to find
-    // clearance data, etc.
-    MODULE  dummymodule( m_board );
-    D_PAD   dummypad( &dummymodule );
+    // clearance data, etc.  Each knocked out hole keeps its own dummy pad.
+    MODULE            dummymodule( m_board );
+    D_PAD             dummypad( &dummymodule );
+    std::deque<D_PAD> dummypads;
 
     // Add non-connected pad clearances
     //
@@ -543,6 +938,8 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE_CONTAINER* aZone, SHAPE_
     {
         for( auto pad : module->Pads() )
         {
+            bool isHole = false;
+
             if( !pad->IsOnLayer( aZone->GetLayer() ) )
             {
                 if( pad->GetDrillSize().x == 0 && pad->GetDrillSize().y == 0 )
@@ -550,6 +947,7 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE_CONTAINER* aZone, SHAPE_
 
                 setupDummyPadForHole( pad, dummypad );
                 pad = &dummypad;
+                isHole = true;
             }
 
             if( pad->GetNetCode() != aZone->GetNetCode()
@@ -560,8 +958,27 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE_CONTAINER* aZone, SHAPE_
                 EDA_RECT item_boundingbox = pad->GetBoundingBox();
                 item_boundingbox.Inflate( pad->GetClearance() );
 
-                if( item_boundingbox.Intersects( zone_boundingbox ) )
-                    addKnockout( pad, gap, aHoles );
+                if( !item_boundingbox.Intersects( zone_boundingbox ) )
+                    continue;
+
+                if( isHole )
+                {
+                    dummypads.emplace_back( &dummymodule );
+                    setupDummyPadForHole( pad, dummypads.back() );
+
+                    D_PAD* hole = &dummypads.back();
+
+                    knockouts.emplace_back( [this, hole, gap]( SHAPE_POLY_SET& aHoles )
+                                            {
+                                                addKnockout( hole, gap, aHoles );
+                                            } );
+                    continue;
+                }
+
+                knockouts.emplace_back( [this, pad, gap]( SHAPE_POLY_SET& aHoles )
+                                        {
+                                            addCachedKnockout( pad, gap, aHoles );
+                                        } );
             }
         }
     }
@@ -580,7 +997,12 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE_CONTAINER* aZone, SHAPE_
         EDA_RECT item_boundingbox = track->GetBoundingBox();
 
         if( item_boundingbox.Intersects( zone_boundingbox ) )
-            track->TransformShapeWithClearanceToPolygon( aHoles, gap, m_low_def );
+        {
+            knockouts.emplace_back( [this, track, gap]( SHAPE_POLY_SET& aHoles )
+                                    {
+                                        addCachedKnockout( track, gap, aHoles );
+                                    } );
+        }
     }
 
     // Add graphic item clearances.  They are by definition unconnected, and have no clearance
@@ -606,7 +1028,10 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE_CONTAINER* aZone, SHAPE_
             ignoreLineWidth = true;
         }
 
-        addKnockout( aItem, gap, ignoreLineWidth, aHoles );
+        knockouts.emplace_back( [this, aItem, gap, ignoreLineWidth]( SHAPE_POLY_SET& aHoles )
+                                {
+                                    addKnockout( aItem, gap, ignoreLineWidth, aHoles );
+                                } );
     };
 
     for( auto module : m_board->Modules() )
@@ -659,10 +1084,24 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE_CONTAINER* aZone, SHAPE_
             useNetClearance = false;
         }
 
-        zone->TransformOutlinesShapeWithClearanceToPolygon( aHoles, minClearance, useNetClearance );
+        knockouts.emplace_back( [zone, minClearance, useNetClearance]( SHAPE_POLY_SET& aHoles )
+                                {
+                                    zone->TransformOutlinesShapeWithClearanceToPolygon(
+                                            aHoles, minClearance, useNetClearance );
+                                } );
     }
 
-    aHoles.Simplify( SHAPE_POLY_SET::PM_FAST );
+    // The holes are left overlapping: they are merged by the subtract which uses them
+    buildKnockouts( knockouts, aHoles );
+}
+
+
+/**
+ * Adds the time since the previous phase of aTimer to aPhase
+ */
+static void endPhase( PROF_COUNTER& aTimer, ZONE_FILL_STATS::DURATION& aPhase )
+{
+    aPhase += aTimer.SinceStart<ZONE_FILL_STATS::DURATION>( true );
 }
 
 
@@ -681,10 +1120,12 @@ void ZONE_FILLER::computeRawFilledArea( const ZONE_CONTAINER* aZone,
                                         const SHAPE_POLY_SET& aSmoothedOutline,
                                         std::set<VECTOR2I>* aPreserveCorners,
                                         SHAPE_POLY_SET& aRawPolys,
-                                        SHAPE_POLY_SET& aFinalPolys )
+                                        SHAPE_POLY_SET& aFinalPolys,
+                                        ZONE_FILL_STATS* aStats )
 {
-    m_high_def = m_board->GetDesignSettings().m_MaxError;
-    m_low_def = std::min( ARC_LOW_DEF, int( m_high_def*1.5 ) );   // Reasonable value
+    ZONE_FILL_STATS  unused;
+    ZONE_FILL_STATS& stats = aStats ? *aStats : unused;
+    PROF_COUNTER     timer;
 
     // Features which are min_width should survive pruning; features that are *less* than
     // min_width should not.  Therefore we subtract epsilon from the min_width when
@@ -700,32 +1141,49 @@ void ZONE_FILLER::computeRawFilledArea( const ZONE_CONTAINER* aZone,
 
     std::deque<SHAPE_LINE_CHAIN> thermalSpokes;
     SHAPE_POLY_SET clearanceHoles;
+    SHAPE_POLY_SET thermalHoles;
 
     std::unique_ptr<SHAPE_FILE_IO> dumper( new SHAPE_FILE_IO(
                     s_DumpZonesWhenFilling ? "zones_dump.txt" : "", SHAPE_FILE_IO::IOM_APPEND ) );
 
-    aRawPolys = aSmoothedOutline;
-
     if( s_DumpZonesWhenFilling )
         dumper->BeginGroup( "clipper-zone" );
 
-    knockoutThermalReliefs( aZone, aRawPolys );
+    // Each boolean operation is a full Clipper run over all its paths, so the clearance
+    // holes are subtracted once, from the outline, and the result is reused:
+    //   filled area = ( ( outline - clearances - thermal reliefs ) + spokes ) & keepArea
+    // with keepArea = outline - clearances.
+    buildCopperItemClearances( aZone, clearanceHoles );
+    endPhase( timer, stats.m_knockouts );
+
+    SHAPE_POLY_SET keepArea = aSmoothedOutline;
+    keepArea.BooleanSubtract( clearanceHoles, SHAPE_POLY_SET::PM_FAST );
+    endPhase( timer, stats.m_booleans );
 
     if( s_DumpZonesWhenFilling )
-        dumper->Write( &aRawPolys, "solid-areas-minus-thermal-reliefs" );
+        dumper->Write( &keepArea, "solid-areas-minus-clearance-holes" );
 
-    buildCopperItemClearances( aZone, clearanceHoles );
+    buildThermalReliefs( aZone, thermalHoles );
+    endPhase( timer, stats.m_knockouts );
+
+    if( aStats )
+        aStats->m_knockoutVertices = clearanceHoles.TotalVertices() + thermalHoles.TotalVertices();
+
+    // The holes overlap, but the subtract merges them
+    aRawPolys = keepArea;
+    aRawPolys.BooleanSubtract( thermalHoles, SHAPE_POLY_SET::PM_FAST );
+    endPhase( timer, stats.m_booleans );
 
     if( s_DumpZonesWhenFilling )
-        dumper->Write( &aRawPolys, "clearance holes" );
+        dumper->Write( &aRawPolys, "solid-areas-minus-thermal-reliefs" );
 
     buildThermalSpokes( aZone, thermalSpokes );
+    endPhase( timer, stats.m_spokes );
 
     // Create a temporary zone that we can hit-test spoke-ends against.  It's only temporary
-    // because the "real" subtract-clearance-holes has to be done after the spokes are added.
+    // because the spokes must still be clipped to the clearance holes once added.
     static const bool USE_BBOX_CACHES = true;
     SHAPE_POLY_SET testAreas = aRawPolys;
-    testAreas.BooleanSubtract( clearanceHoles, SHAPE_POLY_SET::PM_FAST );
 
     // Prune features that don't meet minimum-width criteria
     if( half_min_width - epsilon > epsilon )
@@ -734,10 +1192,14 @@ void ZONE_FILLER::computeRawFilledArea( const ZONE_CONTAINER* aZone,
         testAreas.Inflate( half_min_width - epsilon, numSegs, cornerStrategy );
     }
 
+    endPhase( timer, stats.m_booleans );
+
     // Spoke-end-testing is hugely expensive so we generate cached bounding-boxes to speed
     // things up a bit.
     testAreas.BuildBBoxCaches();
 
+    bool spokesAdded = false;
+
     for( const SHAPE_LINE_CHAIN& spoke : thermalSpokes )
     {
         const VECTOR2I& testPt = spoke.CPoint( 3 );
@@ -746,6 +1208,7 @@ void ZONE_FILLER::computeRawFilledArea( const ZONE_CONTAINER* aZone,
         if( testAreas.Contains( testPt, -1, 1, USE_BBOX_CACHES ) )
         {
             aRawPolys.AddOutline( spoke );
+            spokesAdded = true;
             continue;
         }
 
@@ -755,20 +1218,23 @@ void ZONE_FILLER::computeRawFilledArea( const ZONE_CONTAINER* aZone,
             if( &other != &spoke && other.PointInside( testPt, 1, USE_BBOX_CACHES  ) )
             {
                 aRawPolys.AddOutline( spoke );
+                spokesAdded = true;
                 break;
             }
         }
     }
 
-    // Ensure previous changes (adding thermal stubs) do not add
-    // filled areas outside the zone boundary
-    aRawPolys.BooleanIntersection( aSmoothedOutline, SHAPE_POLY_SET::PM_FAST );
-    aRawPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
+    endPhase( timer, stats.m_spokes );
+
+    // Ensure previous changes (adding thermal stubs) do not add filled areas outside the
+    // zone boundary or inside the clearance holes.  This also merges the spokes with the
+    // filled areas.
+    if( spokesAdded )
+        aRawPolys.BooleanIntersection( keepArea, SHAPE_POLY_SET::PM_FAST );
 
     if( s_DumpZonesWhenFilling )
         dumper->Write( &aRawPolys, "solid-areas-with-thermal-spokes" );
 
-    aRawPolys.BooleanSubtract( clearanceHoles, SHAPE_POLY_SET::PM_FAST );
     // Prune features that don't meet minimum-width criteria
     if( half_min_width - epsilon > epsilon )
         aRawPolys.Deflate( half_min_width - epsilon, numSegs, cornerStrategy );
@@ -800,7 +1266,10 @@ void ZONE_FILLER::computeRawFilledArea( const ZONE_CONTAINER* aZone,
             aRawPolys.BooleanIntersection( aSmoothedOutline, SHAPE_POLY_SET::PM_FAST );
     }
 
+    endPhase( timer, stats.m_booleans );
+
     aRawPolys.Fracture( SHAPE_POLY_SET::PM_FAST );
+    endPhase( timer, stats.m_fracture );
 
     if( s_DumpZonesWhenFilling )
         dumper->Write( &aRawPolys, "areas_fractured" );
@@ -818,8 +1287,12 @@ void ZONE_FILLER::computeRawFilledArea( const ZONE_CONTAINER* aZone,
  * ( holes are linked by overlapping segments to the main outline)
  */
 bool ZONE_FILLER::fillSingleZone( ZONE_CONTAINER* aZone, SHAPE_POLY_SET& aRawPolys,
-                                  SHAPE_POLY_SET& aFinalPolys )
+                                  SHAPE_POLY_SET& aFinalPolys, ZONE_FILL_STATS* aStats )
 {
+    ZONE_FILL_STATS  unused;
+    ZONE_FILL_STATS& stats = aStats ? *aStats : unused;
+    PROF_COUNTER     timer;
+
     SHAPE_POLY_SET smoothedPoly;
     std::set<VECTOR2I> colinearCorners;
     aZone->GetColinearCorners( m_board, colinearCorners );
@@ -832,9 +1305,15 @@ bool ZONE_FILLER::fillSingleZone( ZONE_CONTAINER* aZone, SHAPE_POLY_SET& aRawPol
     if ( !aZone->BuildSmoothedPoly( smoothedPoly, &colinearCorners ) )
         return false;
 
+    endPhase( timer, stats.m_booleans );
+
+    if( aStats )
+        aStats->m_outlineVertices = smoothedPoly.TotalVertices();
+
     if( aZone->IsOnCopperLayer() )
     {
-        computeRawFilledArea( aZone, smoothedPoly, &colinearCorners, aRawPolys, aFinalPolys );
+        computeRawFilledArea( aZone, smoothedPoly, &colinearCorners, aRawPolys, aFinalPolys,
+                              aStats );
     }
     else
     {
@@ -865,8 +1344,10 @@ bool ZONE_FILLER::fillSingleZone( ZONE_CONTAINER* aZone, SHAPE_POLY_SET& aRawPol
 
         aRawPolys = smoothedPoly;
         aFinalPolys = smoothedPoly;
+        endPhase( timer, stats.m_booleans );
 
         aFinalPolys.Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+        endPhase( timer, stats.m_fracture );
     }
 
     aZone->SetNeedRefill( false );
@@ -890,6 +1371,8 @@ void ZONE_FILLER::buildThermalSpokes( const ZONE_CONTAINER* aZone,
     // us avoid the question.
     int epsilon = KiROUND( IU_PER_MM * 0.04 );  // about 1.5 mil
 
+    std::vector<D_PAD*> pads;
+
     for( auto module : m_board->Modules() )
     {
         for( auto pad : module->Pads() )
@@ -901,94 +1384,245 @@ void ZONE_FILLER::buildThermalSpokes( const ZONE_CONTAINER* aZone,
             if( !pad->IsOnLayer( aZone->GetLayer() ) )
                 continue;
 
-            int thermalReliefGap = aZone->GetThermalReliefGap( pad );
+            pads.push_back( pad );
+        }
+    }
+
+    // The spokes of each pad are built on the worker threads, and appended in the pad order
+    std::vector<std::vector<SHAPE_LINE_CHAIN>> padSpokes( pads.size() );
 
-            // Calculate thermal bridge half width
-            int spoke_w = aZone->GetThermalReliefCopperBridge( pad );
-            // Avoid spoke_w bigger than the smaller pad size, because
-            // it is not possible to create stubs bigger than the pad.
-            // Possible refinement: have a separate size for vertical and horizontal stubs
-            spoke_w = std::min( spoke_w, pad->GetSize().x );
-            spoke_w = std::min( spoke_w, pad->GetSize().y );
+    auto spokes_lambda = [&]( size_t ii )
+    {
+        D_PAD* pad = pads[ii];
+        int thermalReliefGap = aZone->GetThermalReliefGap( pad );
 
-            int spoke_half_w = spoke_w / 2;
+        // Calculate thermal bridge half width
+        int spoke_w = aZone->GetThermalReliefCopperBridge( pad );
+        // Avoid spoke_w bigger than the smaller pad size, because
+        // it is not possible to create stubs bigger than the pad.
+        // Possible refinement: have a separate size for vertical and horizontal stubs
+        spoke_w = std::min( spoke_w, pad->GetSize().x );
+        spoke_w = std::min( spoke_w, pad->GetSize().y );
 
-            // Quick test here to possibly save us some work
-            BOX2I itemBB = pad->GetBoundingBox();
-            itemBB.Inflate( thermalReliefGap + epsilon );
+        int spoke_half_w = spoke_w / 2;
 
-            if( !( itemBB.Intersects( zoneBB ) ) )
-                continue;
+        // Quick test here to possibly save us some work
+        BOX2I itemBB = pad->GetBoundingBox();
+        itemBB.Inflate( thermalReliefGap + epsilon );
 
-            // Thermal spokes consist of segments from the pad center to points just outside
-            // the thermal relief.
-            //
-            // We use the bounding-box to lay out the spokes, but for this to work the
-            // bounding box has to be built at the same rotation as the spokes.
-
-            wxPoint shapePos = pad->ShapePos();
-            wxPoint padPos = pad->GetPosition();
-            double padAngle = pad->GetOrientation();
-            pad->SetOrientation( 0.0 );
-            pad->SetPosition( { 0, 0 } );
-            BOX2I reliefBB = pad->GetBoundingBox();
-            pad->SetPosition( padPos );
-            pad->SetOrientation( padAngle );
+        if( !( itemBB.Intersects( zoneBB ) ) )
+            return;
 
+        // Thermal spokes consist of segments from the pad center to points just outside
+        // the thermal relief.
+        //
+        // We use the bounding-box to lay out the spokes, but for this to work the
+        // bounding box has to be built at the same rotation as the spokes.  Pads are
+        // read by other threads, so a rotated pad is not modified but copied.
+
+        wxPoint shapePos = pad->ShapePos();
+        double padAngle = pad->GetOrientation();
+        BOX2I reliefBB;
+
+        if( padAngle == 0.0 )
+        {
+            reliefBB = itemBB;
+            reliefBB.Move( -pad->GetPosition() );
+        }
+        else
+        {
+            D_PAD unrotated( *pad );
+            unrotated.SetOrientation( 0.0 );
+            unrotated.SetPosition( { 0, 0 } );
+            reliefBB = unrotated.GetBoundingBox();
             reliefBB.Inflate( thermalReliefGap + epsilon );
+        }
 
-            // For circle pads, the thermal spoke orientation is 45 deg
-            if( pad->GetShape() == PAD_SHAPE_CIRCLE )
-                padAngle = s_RoundPadThermalSpokeAngle;
+        // For circle pads, the thermal spoke orientation is 45 deg
+        if( pad->GetShape() == PAD_SHAPE_CIRCLE )
+            padAngle = s_RoundPadThermalSpokeAngle;
 
-            for( int i = 0; i < 4; i++ )
+        for( int i = 0; i < 4; i++ )
+        {
+            SHAPE_LINE_CHAIN spoke;
+            switch( i )
             {
-                SHAPE_LINE_CHAIN spoke;
-                switch( i )
-                {
-                case 0:       // lower stub
-                    spoke.Append( +spoke_half_w,       -spoke_half_w );
-                    spoke.Append( -spoke_half_w,       -spoke_half_w );
-                    spoke.Append( -spoke_half_w,       reliefBB.GetBottom() );
-                    spoke.Append( 0,                   reliefBB.GetBottom() );  // test pt
-                    spoke.Append( +spoke_half_w,       reliefBB.GetBottom() );
-                    break;
-
-                case 1:       // upper stub
-                    spoke.Append( +spoke_half_w,       spoke_half_w );
-                    spoke.Append( -spoke_half_w,       spoke_half_w );
-                    spoke.Append( -spoke_half_w,       reliefBB.GetTop() );
-                    spoke.Append( 0,                   reliefBB.GetTop() );     // test pt
-                    spoke.Append( +spoke_half_w,       reliefBB.GetTop() );
-                    break;
-
-                case 2:       // right stub
-                    spoke.Append( -spoke_half_w,       spoke_half_w );
-                    spoke.Append( -spoke_half_w,       -spoke_half_w );
-                    spoke.Append( reliefBB.GetRight(), -spoke_half_w );
-                    spoke.Append( reliefBB.GetRight(), 0 );                     // test pt
-                    spoke.Append( reliefBB.GetRight(), spoke_half_w );
-                    break;
-
-                case 3:       // left stub
-                    spoke.Append( spoke_half_w,        spoke_half_w );
-                    spoke.Append( spoke_half_w,        -spoke_half_w );
-                    spoke.Append( reliefBB.GetLeft(),  -spoke_half_w );
-                    spoke.Append( reliefBB.GetLeft(),  0 );                     // test pt
-                    spoke.Append( reliefBB.GetLeft(),  spoke_half_w );
-                    break;
-                }
+            case 0:       // lower stub
+                spoke.Append( +spoke_half_w,       -spoke_half_w );
+                spoke.Append( -spoke_half_w,       -spoke_half_w );
+                spoke.Append( -spoke_half_w,       reliefBB.GetBottom() );
+                spoke.Append( 0,                   reliefBB.GetBottom() );  // test pt
+                spoke.Append( +spoke_half_w,       reliefBB.GetBottom() );
+                break;
 
-                for( int j = 0; j < spoke.PointCount(); j++ )
-                {
-                    RotatePoint( spoke.Point( j ), padAngle );
-                    spoke.Point( j ) += shapePos;
-                }
+            case 1:       // upper stub
+                spoke.Append( +spoke_half_w,       spoke_half_w );
+                spoke.Append( -spoke_half_w,       spoke_half_w );
+                spoke.Append( -spoke_half_w,       reliefBB.GetTop() );
+                spoke.Append( 0,                   reliefBB.GetTop() );     // test pt
+                spoke.Append( +spoke_half_w,       reliefBB.GetTop() );
+                break;
 
-                spoke.SetClosed( true );
-                spoke.GenerateBBoxCache();
-                aSpokesList.push_back( std::move( spoke ) );
+            case 2:       // right stub
+                spoke.Append( -spoke_half_w,       spoke_half_w );
+                spoke.Append( -spoke_half_w,       -spoke_half_w );
+                spoke.Append( reliefBB.GetRight(), -spoke_half_w );
+                spoke.Append( reliefBB.GetRight(), 0 );                     // test pt
+                spoke.Append( reliefBB.GetRight(), spoke_half_w );
+                break;
+
+            case 3:       // left stub
+                spoke.Append( spoke_half_w,        spoke_half_w );
+                spoke.Append( spoke_half_w,        -spoke_half_w );
+                spoke.Append( reliefBB.GetLeft(),  -spoke_half_w );
+                spoke.Append( reliefBB.GetLeft(),  0 );                     // test pt
+                spoke.Append( reliefBB.GetLeft(),  spoke_half_w );
+                break;
             }
+
+            for( int j = 0; j < spoke.PointCount(); j++ )
+            {
+                RotatePoint( spoke.Point( j ), padAngle );
+                spoke.Point( j ) += shapePos;
+            }
+
+            spoke.SetClosed( true );
+            spoke.GenerateBBoxCache();
+            padSpokes[ii].push_back( std::move( spoke ) );
+        }
+    };
+
+    THREAD_POOL::GetPool().ParallelFor( pads.size(), spokes_lambda, 64,
+                                        ADVANCED_CFG::GetCfg().m_maxZoneFillThreads );
+
+    for( std::vector<SHAPE_LINE_CHAIN>& spokes : padSpokes )
+    {
+        for( SHAPE_LINE_CHAIN& spoke : spokes )
+            aSpokesList.push_back( std::move( spoke ) );
+    }
+}
+
+
+enum HATCH_CELL
+{
+    HATCH_CELL_OUTSIDE,
+    HATCH_CELL_INSIDE,
+    HATCH_CELL_BOUNDARY     ///< the cell is crossed by the area outline
+};
+
+
+static int64_t floorDiv( int64_t aValue, int64_t aDivisor )
+{
+    int64_t q = aValue / aDivisor;
+    return ( aValue % aDivisor != 0 && ( aValue < 0 ) != ( aDivisor < 0 ) ) ? q - 1 : q;
+}
+
+
+/**
+ * Classifies the cells of a hatch grid against aArea.
+ * Cell ( ix, iy ) is the square of side aCellSize at aOrigin + ( ix, iy ) * aPitch, and its
+ * class is stored in aCells[ iy * aColumns + ix ].
+ *
+ * Cells touched by an edge of aArea are boundary cells.  The other ones are fully inside or
+ * fully outside aArea, and their center is tested with one scanline per row, so the cost is
+ * about the number of cells plus the number of edges, whatever the grid pitch.
+ */
+static void classifyHatchCells( const SHAPE_POLY_SET& aArea, const VECTOR2I& aOrigin,
+                                int aPitch, int aCellSize, int aColumns, int aRows,
+                                std::vector<uint8_t>& aCells )
+{
+    aCells.assign( (size_t) aColumns * aRows, HATCH_CELL_OUTSIDE );
+
+    // Range of the cells which overlap [aMin, aMax] on one axis
+    auto cellRange = [&]( int64_t aMin, int64_t aMax, int64_t aOrg, int aCount,
+                          int& aFirst, int& aLast )
+    {
+        aFirst = (int) std::max<int64_t>( 0, floorDiv( aMin - aOrg - aCellSize, aPitch ) + 1 );
+        aLast = (int) std::min<int64_t>( aCount - 1, floorDiv( aMax - aOrg, aPitch ) );
+    };
+
+    int64_t half = aCellSize / 2;
+    std::vector<std::vector<double>> rowCrossings( aRows );
+
+    auto addEdge = [&]( const SEG& aSeg )
+    {
+        // Mark the boundary cells.  Long edges are split in pieces no longer than aPitch so
+        // that a diagonal edge does not mark all the cells of its bounding box.
+        VECTOR2I delta = aSeg.B - aSeg.A;
+        int      pieces = std::max( 1, KiROUND( delta.EuclideanNorm() / aPitch ) + 1 );
+        VECTOR2I prev = aSeg.A;
+
+        for( int ii = 1; ii <= pieces; ii++ )
+        {
+            VECTOR2I next = ii == pieces ? aSeg.B
+                                         : aSeg.A + VECTOR2I( KiROUND( (double) delta.x * ii / pieces ),
+                                                              KiROUND( (double) delta.y * ii / pieces ) );
+            int x0, x1, y0, y1;
+
+            cellRange( std::min( prev.x, next.x ), std::max( prev.x, next.x ), aOrigin.x,
+                       aColumns, x0, x1 );
+            cellRange( std::min( prev.y, next.y ), std::max( prev.y, next.y ), aOrigin.y,
+                       aRows, y0, y1 );
+
+            for( int iy = y0; iy <= y1; iy++ )
+            {
+                for( int ix = x0; ix <= x1; ix++ )
+                    aCells[ (size_t) iy * aColumns + ix ] = HATCH_CELL_BOUNDARY;
+            }
+
+            prev = next;
+        }
+
+        // Store the crossings of the edge with the scanlines through the cell centers
+        int64_t ymin = std::min( aSeg.A.y, aSeg.B.y );
+        int64_t ymax = std::max( aSeg.A.y, aSeg.B.y );
+
+        if( ymin == ymax )
+            return;
+
+        int first = (int) std::max<int64_t>( 0, floorDiv( ymin - aOrigin.y - half - 1, aPitch ) + 1 );
+        int last = (int) std::min<int64_t>( aRows - 1, floorDiv( ymax - aOrigin.y - half, aPitch ) );
+
+        for( int iy = first; iy <= last; iy++ )
+        {
+            int64_t yc = aOrigin.y + (int64_t) iy * aPitch + half;
+
+            // Half-open rule, so that a scanline through a vertex is crossed once
+            if( ( aSeg.A.y <= yc ) == ( aSeg.B.y <= yc ) )
+                continue;
+
+            double x = aSeg.A.x + (double) ( yc - aSeg.A.y ) * delta.x / delta.y;
+            rowCrossings[iy].push_back( x );
+        }
+    };
+
+    for( int ii = 0; ii < aArea.OutlineCount(); ii++ )
+    {
+        for( const SHAPE_LINE_CHAIN& path : aArea.CPolygon( ii ) )
+        {
+            for( int jj = 0; jj < path.SegmentCount(); jj++ )
+                addEdge( path.CSegment( jj ) );
+        }
+    }
+
+    for( int iy = 0; iy < aRows; iy++ )
+    {
+        std::vector<double>& crossings = rowCrossings[iy];
+        std::sort( crossings.begin(), crossings.end() );
+
+        size_t next = 0;
+
+        for( int ix = 0; ix < aColumns; ix++ )
+        {
+            double xc = aOrigin.x + (double) ix * aPitch + half;
+
+            while( next < crossings.size() && crossings[next] < xc )
+                next++;
+
+            uint8_t& cell = aCells[ (size_t) iy * aColumns + ix ];
+
+            if( cell != HATCH_CELL_BOUNDARY && ( next % 2 ) == 1 )
+                cell = HATCH_CELL_INSIDE;
         }
     }
 }
@@ -1087,53 +1721,64 @@ void ZONE_FILLER::addHatchFillTypeOnZone( const ZONE_CONTAINER* aZone, SHAPE_POL
         }
     }
 
-    // Build holes
-    SHAPE_POLY_SET holes;
+    // Clamp holes to the area of filled zones with a outline thickness
+    // > aZone->GetMinThickness() to be sure the thermal pads can be built
+    int outline_margin = std::max( (aZone->GetMinThickness()*10)/9, linethickness/2 );
+    int numSegs = std::max( GetArcToSegmentCount( outline_margin, m_high_def, 360.0 ), 6 );
+    filledPolys.Deflate( outline_margin, numSegs );
 
-    for( int xx = 0; ; xx++ )
-    {
-        int xpos = xx * gridsize;
+    // Build holes.  Only the holes crossed by the outline of the clamping area have to be
+    // clipped: the other ones are kept as they are, or dropped.  Clipping the whole grid
+    // is very slow for fine hatch pitches, and most holes are not clipped.
+    int columns = bbox.GetWidth() / gridsize + 1;
+    int rows = bbox.GetHeight() / gridsize + 1;
+    std::vector<uint8_t> cells;
 
-        if( xpos > bbox.GetWidth() )
-            break;
+    classifyHatchCells( filledPolys, bbox.GetPosition(), gridsize, hole_size, columns, rows,
+                        cells );
+
+    SHAPE_POLY_SET holes;
+    SHAPE_POLY_SET clippedHoles;
 
-        for( int yy = 0; ; yy++ )
+    for( int yy = 0; yy < rows; yy++ )
+    {
+        for( int xx = 0; xx < columns; xx++ )
         {
-            int ypos = yy * gridsize;
+            uint8_t cell = cells[ (size_t) yy * columns + xx ];
 
-            if( ypos > bbox.GetHeight() )
-                break;
+            if( cell == HATCH_CELL_OUTSIDE )
+                continue;
 
             // Generate hole
             SHAPE_LINE_CHAIN hole( hole_base );
-            hole.Move( VECTOR2I( xpos, ypos ) );
-            holes.AddOutline( hole );
+            hole.Move( bbox.GetPosition() + VECTOR2I( xx * gridsize, yy * gridsize ) );
+
+            if( cell == HATCH_CELL_INSIDE )
+                holes.AddOutline( hole );
+            else
+                clippedHoles.AddOutline( hole );
         }
     }
 
-    holes.Move( bbox.GetPosition() );
-
-    // Clamp holes to the area of filled zones with a outline thickness
-    // > aZone->GetMinThickness() to be sure the thermal pads can be built
-    int outline_margin = std::max( (aZone->GetMinThickness()*10)/9, linethickness/2 );
-    filledPolys.Deflate( outline_margin, 16 );
-    holes.BooleanIntersection( filledPolys, SHAPE_POLY_SET::PM_FAST );
-
-    if( orientation != 0.0 )
-        holes.Rotate( -M_PI/180.0 * orientation, VECTOR2I( 0,0 ) );
+    clippedHoles.BooleanIntersection( filledPolys, SHAPE_POLY_SET::PM_FAST );
 
     // Now filter truncated holes to avoid small holes in pattern
     // It happens for holes near the zone outline
-    for( int ii = 0; ii < holes.OutlineCount(); )
+    for( int ii = 0; ii < clippedHoles.OutlineCount(); )
     {
-        double area = holes.Outline( ii ).Area();
+        double area = clippedHoles.Outline( ii ).Area();
 
         if( area < minimal_hole_area ) // The current hole is too small: remove it
-            holes.DeletePolygon( ii );
+            clippedHoles.DeletePolygon( ii );
         else
             ++ii;
     }
 
+    holes.Append( clippedHoles );
+
+    if( orientation != 0.0 )
+        holes.Rotate( -M_PI/180.0 * orientation, VECTOR2I( 0,0 ) );
+
     // create grid. Use SHAPE_POLY_SET::PM_STRICTLY_SIMPLE to
     // generate strictly simple polygons needed by Gerber files and Fracture()
     aRawPolys.BooleanSubtract( aRawPolys, holes, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
@@ -26,6 +26,11 @@
 #ifndef __ZONE_FILLER_H
 #define __ZONE_FILLER_H
 
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <class_zone.h>
 
@@ -34,6 +39,82 @@ class BOARD;
 class COMMIT;
 class SHAPE_POLY_SET;
 class SHAPE_LINE_CHAIN;
+struct CN_ZONE_ISOLATED_ISLAND_LIST;
+
+
+/**
+ * Keeps the clearance knockouts of the pads and tracks between zone fills.
+ *
+ * A pad is often knocked out of several zones, on several layers, with the same gap, and
+ * most items are unchanged between two refills.  Entries are keyed by the cached contents
+ * hash of the item (see hash_eda_cached()), gap and arc approximation error.  The cache
+ * relies on the invalidation of the hashes by the commits, the undo and SetModified(), as
+ * the fill fingerprints do: an item changed without them (by a script, for instance) keeps
+ * its old hash and gets its old knockout.  The entries of an item are dropped when it is
+ * changed through a commit, so the cache does not grow with the old shapes of the edited
+ * items.
+ * The cache can be used by several fill threads at the same time.
+ */
+class ZONE_KNOCKOUT_CACHE
+{
+public:
+    ///> @return the cached knockout of the item whose contents hash is aHash, or nullptr
+    std::shared_ptr<const SHAPE_POLY_SET> Get( size_t aHash, int aGap, int aMaxError );
+
+    void Store( const BOARD_ITEM* aItem, size_t aHash, int aGap, int aMaxError,
+                std::shared_ptr<const SHAPE_POLY_SET> aKnockout );
+
+    ///> Drops the knockouts of aItem, and of its pads for a footprint
+    void Invalidate( const BOARD_ITEM* aItem );
+
+    void Clear();
+
+private:
+    struct KEY
+    {
+        size_t m_hash;
+        int    m_gap;
+        int    m_maxError;
+
+        bool operator<( const KEY& aOther ) const
+        {
+            if( m_hash != aOther.m_hash )
+                return m_hash < aOther.m_hash;
+
+            if( m_gap != aOther.m_gap )
+                return m_gap < aOther.m_gap;
+
+            return m_maxError < aOther.m_maxError;
+        }
+    };
+
+    std::map<KEY, std::shared_ptr<const SHAPE_POLY_SET>> m_knockouts;
+    std::map<const BOARD_ITEM*, std::vector<KEY>>        m_itemKeys;   ///< entries stored by item
+    std::mutex                                           m_lock;
+};
+
+
+/**
+ * Profiling data of one zone fill, collected when a list is given to
+ * ZONE_FILLER::SetFillStats().  The times are the time spent in each phase of the fill,
+ * on the thread filling the zone.
+ */
+struct ZONE_FILL_STATS
+{
+    typedef std::chrono::nanoseconds DURATION;
+
+    ZONE_CONTAINER* m_zone = nullptr;
+
+    DURATION m_knockouts { 0 };         ///< building the clearance and thermal relief holes
+    DURATION m_booleans { 0 };          ///< boolean ops, inflates, deflates and hatching
+    DURATION m_spokes { 0 };            ///< building and hit-testing the thermal spokes
+    DURATION m_fracture { 0 };
+    DURATION m_triangulation { 0 };
+
+    int m_outlineVertices = 0;          ///< vertices of the smoothed zone outline
+    int m_knockoutVertices = 0;         ///< vertices of the clearance and thermal relief holes
+    int m_filledVertices = 0;           ///< vertices of the final fill, without its islands
+};
 
 
 class ZONE_FILLER
@@ -43,15 +124,87 @@ public:
     ~ZONE_FILLER();
 
     void InstallNewProgressReporter( wxWindow* aParent, const wxString& aTitle, int aNumPhases );
+
+    ///> Uses aCache to keep the pad and track knockouts between fills (can be nullptr)
+    void SetKnockoutCache( ZONE_KNOCKOUT_CACHE* aCache ) { m_knockoutCache = aCache; }
+
+    ///> Appends the profiling data of each zone filled by Fill() to aStats (can be nullptr)
+    void SetFillStats( std::vector<ZONE_FILL_STATS>* aStats ) { m_fillStats = aStats; }
+
+    /**
+     * Fills the zones of aZones.
+     * @param aCheck = true to only check the fills: zones whose fill fingerprint is up to
+     * date are then skipped, the other ones are refilled after a confirmation
+     * @return false if the fill was cancelled
+     */
     bool Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck = false );
 
+    /**
+     * Fills the zones of aZones one after the other, without removing their insulated
+     * islands nor triangulating them.  The board connectivity is not used, so this can run
+     * in a worker thread on a copy of the board.  The zones are not added to the commit.
+     * @param aFilled is called after each zone fill, and returns false to stop filling
+     */
+    void FillWithoutIslands( const std::vector<ZONE_CONTAINER*>& aZones,
+                             const std::function<bool( ZONE_CONTAINER* )>& aFilled );
+
+    /**
+     * Removes the insulated copper islands of zones whose fill has been built by
+     * FillWithoutIslands(), triangulates their fills, and updates the connectivity and
+     * the ratsnest with the new fills.
+     * @return false if the connectivity is busy
+     */
+    bool RemoveInsulatedIslands( const std::vector<ZONE_CONTAINER*>& aZones );
+
+    /**
+     * Build a fingerprint of everything the fill of aZone depends on: the zone outline
+     * and settings, the fill related design settings, and the geometry, nets and
+     * clearances of the items close enough to the zone to change its fill.
+     * The fingerprint is stored with the fill, and saved with it in the board file.
+     */
+    std::string BuildFillFingerprint( const ZONE_CONTAINER* aZone ) const;
+
+    ///> @return true if aZone is filled and its fill fingerprint is still valid
+    bool IsFillUpToDate( const ZONE_CONTAINER* aZone ) const;
+
 private:
 
+    bool filledPolysUseThickness() const;
+
+    void buildBoardOutline();
+
+    ///> Removes the islands found by the connectivity, and the areas outside the board
+    void removeIslands( CN_ZONE_ISOLATED_ISLAND_LIST& aZone );
+
+    ///> Appends the knockout of one item to a set of holes
+    typedef std::function<void( SHAPE_POLY_SET& )> KNOCKOUT;
+
+    /**
+     * Appends the knockouts of aKnockouts to aHoles, in the list order.  Big lists are
+     * built on the worker threads.
+     */
+    void buildKnockouts( const std::vector<KNOCKOUT>& aKnockouts, SHAPE_POLY_SET& aHoles );
+
     void addKnockout( D_PAD* aPad, int aGap, SHAPE_POLY_SET& aHoles );
 
+    ///> @return the arc approximation error of the knockout of a board pad or track
+    int knockoutMaxError( const BOARD_ITEM* aItem ) const;
+
+    /**
+     * @return the key of the knockout of a board pad or track in m_knockoutCache.  The
+     * contents hashes of the items must have been cached by cacheItemHashes().
+     */
+    size_t knockoutHash( const BOARD_ITEM* aItem ) const;
+
+    ///> Caches the contents hashes of the pads and tracks, before the fill threads use them
+    void cacheItemHashes();
+
+    ///> Appends the knockout of a board pad or track, reusing m_knockoutCache if possible
+    void addCachedKnockout( BOARD_ITEM* aItem, int aGap, SHAPE_POLY_SET& aHoles );
+
     void addKnockout( BOARD_ITEM* aItem, int aGap, bool aIgnoreLineWidth, SHAPE_POLY_SET& aHoles );
 
-    void knockoutThermalReliefs( const ZONE_CONTAINER* aZone, SHAPE_POLY_SET& aFill );
+    void buildThermalReliefs( const ZONE_CONTAINER* aZone, SHAPE_POLY_SET& aHoles );
 
     void buildCopperItemClearances( const ZONE_CONTAINER* aZone, SHAPE_POLY_SET& aHoles );
 
@@ -65,11 +218,13 @@ private:
      * BuildFilledSolidAreasPolygons() call this function just after creating the
      *  filled copper area polygon (without clearance areas
      * @param aPcb: the current board
+     * @param aStats: the profiling data of the fill to update (can be nullptr)
      */
     void computeRawFilledArea( const ZONE_CONTAINER* aZone,
                                const SHAPE_POLY_SET& aSmoothedOutline,
                                std::set<VECTOR2I>* aPreserveCorners,
-                               SHAPE_POLY_SET& aRawPolys, SHAPE_POLY_SET& aFinalPolys );
+                               SHAPE_POLY_SET& aRawPolys, SHAPE_POLY_SET& aFinalPolys,
+                               ZONE_FILL_STATS* aStats );
 
     /**
      * Function buildThermalSpokes
@@ -90,9 +245,10 @@ private:
      * (holes are linked to main outline by overlapping segments, and these polygons are shrinked
      * by aZone->GetMinThickness() / 2 to be drawn with a outline thickness = aZone->GetMinThickness()
      * aFinalPolys are polygons that will be drawn on screen and plotted
+     * @param aStats: the profiling data of the fill to update (can be nullptr)
      */
     bool fillSingleZone( ZONE_CONTAINER* aZone, SHAPE_POLY_SET& aRawPolys,
-                         SHAPE_POLY_SET& aFinalPolys );
+                         SHAPE_POLY_SET& aFinalPolys, ZONE_FILL_STATS* aStats = nullptr );
 
     /**
      * for zones having the ZONE_FILL_MODE::ZFM_HATCH_PATTERN, create a grid pattern
@@ -111,6 +267,10 @@ private:
     WX_PROGRESS_REPORTER* m_progressReporter;
     std::unique_ptr<WX_PROGRESS_REPORTER> m_uniqueReporter;
 
+    ZONE_KNOCKOUT_CACHE* m_knockoutCache;
+
+    std::vector<ZONE_FILL_STATS>* m_fillStats;
+
     // m_high_def can be used to define a high definition arc to polygon approximation
     int m_high_def;
 
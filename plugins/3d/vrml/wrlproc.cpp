@@ -21,7 +21,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <wx/filename.h>
 #include <wx/string.h>
@@ -179,6 +182,172 @@ bool WRLPROC::getRawLine( void )
 }
 
 
+// true for the characters which end a glob, see ReadGlob()
+static inline bool isGlobEnd( char aChar )
+{
+    return aChar <= 0x20 || ',' == aChar || '{' == aChar || '}' == aChar
+           || '[' == aChar || ']' == aChar;
+}
+
+
+bool WRLPROC::parseFloat( float& aValue )
+{
+    const char* start = m_buf.c_str() + m_bufpos;
+    const char* cp = start;
+    bool negative = false;
+
+    if( '-' == *cp || '+' == *cp )
+        negative = ( '-' == *cp++ );
+
+    // the significant digits are accumulated in an integer and scaled once; 19 digits
+    // always fit in 64 bits
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool hasDigits = false;
+
+    while( '0' == *cp )
+    {
+        hasDigits = true;
+        ++cp;
+    }
+
+    while( *cp >= '0' && *cp <= '9' )
+    {
+        if( ++digits > 19 )
+            return false;
+
+        mantissa = mantissa * 10 + ( *cp++ - '0' );
+        hasDigits = true;
+    }
+
+    if( '.' == *cp )
+    {
+        ++cp;
+
+        if( 0 == digits )
+        {
+            while( '0' == *cp )
+            {
+                --exponent;
+                hasDigits = true;
+                ++cp;
+            }
+        }
+
+        while( *cp >= '0' && *cp <= '9' )
+        {
+            if( ++digits > 19 )
+                return false;
+
+            mantissa = mantissa * 10 + ( *cp++ - '0' );
+            --exponent;
+            hasDigits = true;
+        }
+    }
+
+    if( !hasDigits )
+        return false;
+
+    if( 'e' == *cp || 'E' == *cp )
+    {
+        ++cp;
+        bool negExp = false;
+
+        if( '-' == *cp || '+' == *cp )
+            negExp = ( '-' == *cp++ );
+
+        if( *cp < '0' || *cp > '9' )
+            return false;
+
+        int exp = 0;
+
+        while( *cp >= '0' && *cp <= '9' )
+        {
+            if( exp > 10000 )
+                return false;
+
+            exp = exp * 10 + ( *cp++ - '0' );
+        }
+
+        exponent += negExp ? -exp : exp;
+    }
+
+    if( !isGlobEnd( *cp ) )
+        return false;
+
+    // the powers of 10 up to 1e22 are exact in a double; the error of the scaling is far
+    // below the precision of the float
+    static const double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+                                    1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+                                    1e20, 1e21, 1e22 };
+
+    double value = (double) mantissa;
+
+    if( 0 == mantissa )
+        value = 0.0;
+    else if( exponent >= 0 && exponent <= 22 )
+        value *= pow10[exponent];
+    else if( exponent < 0 && exponent >= -22 )
+        value /= pow10[-exponent];
+    else
+        value *= std::pow( 10.0, exponent );
+
+    if( value > std::numeric_limits<float>::max() )
+        return false;
+
+    aValue = (float) ( negative ? -value : value );
+
+    // the comma is a special instance of blank space
+    if( ',' == *cp )
+        ++cp;
+
+    m_bufpos += cp - start;
+    return true;
+}
+
+
+bool WRLPROC::parseInt( int& aValue )
+{
+    const char* start = m_buf.c_str() + m_bufpos;
+    const char* cp = start;
+    bool negative = false;
+
+    if( '-' == *cp || '+' == *cp )
+        negative = ( '-' == *cp++ );
+
+    if( *cp < '0' || *cp > '9' )
+        return false;
+
+    int64_t value = 0;
+
+    while( *cp >= '0' && *cp <= '9' )
+    {
+        value = value * 10 + ( *cp++ - '0' );
+
+        if( value > (int64_t) std::numeric_limits<int>::max() + 1 )
+            return false;
+    }
+
+    if( !isGlobEnd( *cp ) )
+        return false;
+
+    if( negative )
+        value = -value;
+
+    if( value > std::numeric_limits<int>::max() )
+        return false;
+
+    aValue = (int) value;
+
+    if( ',' == *cp )
+        ++cp;
+
+    m_bufpos += cp - start;
+    return true;
+}
+
+
 bool WRLPROC::EatSpace( void )
 {
     if( !m_file )
@@ -811,6 +980,9 @@ bool WRLPROC::ReadSFFloat( float& aSFFloat )
             break;
     }
 
+    if( parseFloat( aSFFloat ) )
+        return true;
+
     std::string tmp;
 
     if( !ReadGlob( tmp ) )
@@ -871,6 +1043,9 @@ bool WRLPROC::ReadSFInt( int& aSFInt32 )
             break;
     }
 
+    if( parseInt( aSFInt32 ) )
+        return true;
+
     std::string tmp;
 
     if( !ReadGlob( tmp ) )
@@ -1023,6 +1198,9 @@ bool WRLPROC::ReadSFVec2f( WRLVEC2F& aSFVec2f )
 
     for( int i = 0; i < 2; ++i )
     {
+        if( EatSpace() && parseFloat( tcol[i] ) )
+            continue;
+
         if( !ReadGlob( tmp ) )
         {
             std::ostringstream ostr;
@@ -1095,6 +1273,18 @@ bool WRLPROC::ReadSFVec3f( WRLVEC3F& aSFVec3f )
 
     for( int i = 0; i < 3; ++i )
     {
+        if( EatSpace() && parseFloat( tcol[i] ) )
+        {
+            // ignore any commas
+            if( !EatSpace() )
+                return false;
+
+            if( ',' == m_buf[m_bufpos] )
+                Pop();
+
+            continue;
+        }
+
         if( !ReadGlob( tmp ) )
         {
             std::ostringstream ostr;
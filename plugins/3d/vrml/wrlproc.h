@@ -58,6 +58,14 @@ private:
     // parameters are updated as appropriate.
     bool getRawLine( void );
 
+    // parseFloat and parseInt convert the number at the current position of the buffer
+    // without copying it, and skip it and a following comma as ReadGlob would. They fail
+    // without moving in the buffer on anything unusual (hexadecimal numbers, numbers with
+    // too many digits, numbers out of range, a delimiter missing), which is left to the
+    // stream conversions of the ReadSF* functions and their error messages.
+    bool parseFloat( float& aValue );
+    bool parseInt( int& aValue );
+
 public:
     WRLPROC( LINE_READER* aLineReader );
     ~WRLPROC();
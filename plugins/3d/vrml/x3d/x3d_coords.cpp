@@ -88,43 +88,27 @@ bool X3DCOORDS::Read( wxXmlNode* aNode, X3DNODE* aTopNode, X3D_DICT& aDict )
         else if( pname == "point" )
         {
             // Save points to vector as doubles
-            wxStringTokenizer plist( prop->GetValue() );
-            double point = 0.0;
-            WRLVEC3F pt;
-            int i = 0;
+            std::vector<double> values;
+            bool ok = X3D::ParseMFFloat( prop->GetValue(), values );
 
-            while( plist.HasMoreTokens() )
+            points.reserve( points.size() + values.size() / 3 );
+
+            // note: coordinates are multiplied by 2.54 to retain
+            // legacy behavior of 1 X3D unit = 0.1 inch; the SG*
+            // classes expect all units in mm.
+            for( size_t i = 0; i + 2 < values.size(); i += 3 )
             {
-                if( plist.GetNextToken().ToDouble( &point ) )
-                {
-                    // note: coordinates are multiplied by 2.54 to retain
-                    // legacy behavior of 1 X3D unit = 0.1 inch; the SG*
-                    // classes expect all units in mm.
-                    switch( i % 3 )
-                    {
-                    case 0:
-                        pt.x = point * 2.54;
-                        break;
-
-                    case 1:
-                        pt.y = point * 2.54;
-                        break;
-
-                    case 2:
-                        pt.z = point * 2.54;
-                        points.push_back( pt );
-                        break;
-
-                    }
-                }
-                else
-                {
-                    return false;
-                }
-
-                ++i;
+                WRLVEC3F pt;
+
+                pt.x = values[i] * 2.54;
+                pt.y = values[i + 1] * 2.54;
+                pt.z = values[i + 2] * 2.54;
+                points.push_back( pt );
             }
 
+            if( !ok )
+                return false;
+
         }
     }
 
@@ -122,14 +122,7 @@ void X3DIFACESET::readFields( wxXmlNode* aNode )
         }
         else if( pname == "coordIndex" )
         {
-            wxStringTokenizer indices( prop->GetValue() );
-
-            while( indices.HasMoreTokens() )
-            {
-                long index = 0;
-                indices.GetNextToken().ToLong( &index );
-                coordIndex.push_back( (int) index );
-            }
+            X3D::ParseMFInt( prop->GetValue(), coordIndex );
         }
     }
 
@@ -21,6 +21,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <cstdlib>
 #include <wx/tokenzr.h>
 #include <wx/xml/xml.h>
 
@@ -311,3 +312,69 @@ bool X3D::ParseSFRotation( const wxString& aSource, WRLROTATION& aResult )
 
     return ret;
 }
+
+
+// the delimiters of wxStringTokenizer by default
+static inline bool isX3DSpace( char aChar )
+{
+    return ' ' == aChar || '\t' == aChar || '\r' == aChar || '\n' == aChar;
+}
+
+
+bool X3D::ParseMFFloat( const wxString& aSource, std::vector<double>& aResult )
+{
+    // the field is converted once, instead of a string for each token
+    const wxScopedCharBuffer source = aSource.ToUTF8();
+    const char* cp = source.data();
+
+    while( true )
+    {
+        while( isX3DSpace( *cp ) )
+            ++cp;
+
+        if( '\0' == *cp )
+            return true;
+
+        // strtod() follows the numeric locale, as wxString::ToDouble() does
+        char* end;
+        double value = strtod( cp, &end );
+
+        if( end == cp || ( '\0' != *end && !isX3DSpace( *end ) ) )
+            return false;
+
+        aResult.push_back( value );
+        cp = end;
+    }
+}
+
+
+bool X3D::ParseMFInt( const wxString& aSource, std::vector<int>& aResult )
+{
+    const wxScopedCharBuffer source = aSource.ToUTF8();
+    const char* cp = source.data();
+    bool ok = true;
+
+    while( true )
+    {
+        while( isX3DSpace( *cp ) )
+            ++cp;
+
+        if( '\0' == *cp )
+            return ok;
+
+        char* end;
+        long value = strtol( cp, &end, 10 );
+
+        if( end == cp || ( '\0' != *end && !isX3DSpace( *end ) ) )
+        {
+            value = 0;
+            ok = false;
+
+            while( '\0' != *end && !isX3DSpace( *end ) )
+                ++end;
+        }
+
+        aResult.push_back( (int) value );
+        cp = end;
+    }
+}
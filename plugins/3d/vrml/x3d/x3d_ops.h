@@ -29,6 +29,8 @@
 #ifndef X3D_OPS_H
 #define X3D_OPS_H
 
+#include <vector>
+
 #include "x3d_base.h"
 #include "wrltypes.h"
 
@@ -48,6 +50,13 @@ namespace X3D
     bool ParseSFVec3( const wxString& aSource, WRLVEC3F& aResult );
     bool ParseSFRotation( const wxString& aSource, WRLROTATION& aResult );
 
+    // Parse the white space separated numbers of the large fields (point, coordIndex)
+    // in place, appending them to aResult.  ParseMFFloat stops on the first token which
+    // is not a number; ParseMFInt appends 0 for such tokens.  Both return false if a
+    // token is not a number.
+    bool ParseMFFloat( const wxString& aSource, std::vector<double>& aResult );
+    bool ParseMFInt( const wxString& aSource, std::vector<int>& aResult );
+
 }
 
 #endif  // X3D_OPS_H
@@ -44,6 +44,7 @@ KICAD_PLUGIN_LDR_3D::KICAD_PLUGIN_LDR_3D()
     m_getFileFilter = NULL;
     m_canRender = NULL;
     m_load = NULL;
+    m_isThreadSafe = NULL;
 
     return;
 }
@@ -94,6 +95,10 @@ bool KICAD_PLUGIN_LDR_3D::Open( const wxString& aFullFileName )
     LINK_ITEM( m_canRender, PLUGIN_3D_CAN_RENDER, "CanRender" );
     LINK_ITEM( m_load, PLUGIN_3D_LOAD, "Load" );
 
+    // IsThreadSafe is optional; GetSymbol() would report its absence as an error
+    if( m_PluginLoader.HasSymbol( wxT( "IsThreadSafe" ) ) )
+        LINK_ITEM( m_isThreadSafe, PLUGIN_3D_IS_THREAD_SAFE, "IsThreadSafe" );
+
     #ifdef DEBUG
         bool fail = false;
 
@@ -250,6 +255,7 @@ void KICAD_PLUGIN_LDR_3D::Close( void )
     m_getFileFilter = NULL;
     m_canRender = NULL;
     m_load = NULL;
+    m_isThreadSafe = NULL;
     close();
 
     return;
@@ -428,6 +434,11 @@ bool KICAD_PLUGIN_LDR_3D::CanRender( void )
 
 SCENEGRAPH* KICAD_PLUGIN_LDR_3D::Load( char const* aFileName )
 {
+    // an open plugin is called without changing the state of the loader, so that the
+    // plugins which are thread safe may load several files at once
+    if( ok && m_load )
+        return m_load( aFileName );
+
     m_error.clear();
 
     if( !ok && !reopen() )
@@ -454,3 +465,12 @@ SCENEGRAPH* KICAD_PLUGIN_LDR_3D::Load( char const* aFileName )
 
     return m_load( aFileName );
 }
+
+
+bool KICAD_PLUGIN_LDR_3D::IsThreadSafe( void )
+{
+    if( !ok || NULL == m_isThreadSafe )
+        return false;
+
+    return m_isThreadSafe();
+}
@@ -47,6 +47,8 @@ typedef bool (*PLUGIN_3D_CAN_RENDER) ( void );
 
 typedef SCENEGRAPH* (*PLUGIN_3D_LOAD) ( char const* aFileName );
 
+typedef bool (*PLUGIN_3D_IS_THREAD_SAFE) ( void );
+
 
 class KICAD_PLUGIN_LDR_3D : public KICAD_PLUGIN_LDR
 {
@@ -58,6 +60,7 @@ private:
     PLUGIN_3D_GET_FILE_FILTER       m_getFileFilter;
     PLUGIN_3D_CAN_RENDER            m_canRender;
     PLUGIN_3D_LOAD                  m_load;
+    PLUGIN_3D_IS_THREAD_SAFE        m_isThreadSafe;     // optional
 
 public:
     KICAD_PLUGIN_LDR_3D();
@@ -85,6 +88,10 @@ public:
     bool CanRender( void );
 
     SCENEGRAPH* Load( char const* aFileName );
+
+    // true if the plugin exports IsThreadSafe() and it returns true; the Load() function
+    // of an open plugin may then be called by several threads at once
+    bool IsThreadSafe( void );
 };
 
 #endif  // PLUGINMGR3D_H
@@ -8,11 +8,17 @@
 #include <config.h>
 #endif
 
+#include <errno.h>
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "auxiliary.h"
 #include "curve.h"
 #include "lists.h"
@@ -1496,59 +1502,94 @@ calloc_error:
         goto try_error
 
 /* return 0 on success, 1 on error with errno set. */
-int process_path( path_t* plist, const potrace_param_t* param, progress_t* progress )
+static int process_one_path( path_t* p, const potrace_param_t* param )
 {
-    path_t* p;
-    double  nn = 0, cn = 0;
+    TRY( calc_sums( p->priv ) );
+    TRY( calc_lon( p->priv ) );
+    TRY( bestpolygon( p->priv ) );
+    TRY( adjust_vertices( p->priv ) );
 
-    if( progress->callback )
+    if( p->sign == '-' )
     {
-        /* precompute task size for progress estimates */
-        nn = 0;
-        list_forall( p, plist ) {
-            nn += p->priv->len;
-        }
-        cn = 0;
+        /* reverse orientation of negative paths */
+        reverse( &p->priv->curve );
+    }
+
+    smooth( &p->priv->curve, param->alphamax );
+
+    if( param->opticurve )
+    {
+        TRY( opticurve( p->priv, param->opttolerance ) );
+        p->priv->fcurve = &p->priv->ocurve;
+    }
+    else
+    {
+        p->priv->fcurve = &p->priv->curve;
     }
 
-    /* call downstream function with each path */
+    privcurve_to_curve( p->priv->fcurve, &p->curve );
+
+    return 0;
+
+try_error:
+    return 1;
+}
+
+
+/* return 0 on success, 1 on error with errno set. The paths only use their own data: they
+ * are processed by several threads, and the progress is reported by the calling one. */
+int process_path( path_t* plist, const potrace_param_t* param, progress_t* progress )
+{
+    path_t* p;
+    double  nn = 0;
+    std::vector<path_t*> paths;
+
+    /* precompute task size for progress estimates */
     list_forall( p, plist ) {
-        TRY( calc_sums( p->priv ) );
-        TRY( calc_lon( p->priv ) );
-        TRY( bestpolygon( p->priv ) );
-        TRY( adjust_vertices( p->priv ) );
+        paths.push_back( p );
+        nn += p->priv->len;
+    }
+
+    std::atomic<size_t> next( 0 );
+    std::atomic<long>   done( 0 );  /* length of the paths processed */
+    std::atomic<int>    error( 0 ); /* errno of the first error */
 
-        if( p->sign == '-' )
+    auto processPaths = [&]( bool aReportProgress )
+    {
+        for( size_t i = next++; i < paths.size() && !error; i = next++ )
         {
-            /* reverse orientation of negative paths */
-            reverse( &p->priv->curve );
-        }
+            if( process_one_path( paths[i], param ) )
+            {
+                int expected = 0;
+                error.compare_exchange_strong( expected, errno ? errno : ENOMEM );
+                return;
+            }
 
-        smooth( &p->priv->curve, param->alphamax );
+            done += paths[i]->priv->len;
 
-        if( param->opticurve )
-        {
-            TRY( opticurve( p->priv, param->opttolerance ) );
-            p->priv->fcurve = &p->priv->ocurve;
-        }
-        else
-        {
-            p->priv->fcurve = &p->priv->curve;
+            if( aReportProgress && progress->callback )
+                progress_update( done / nn, progress );
         }
+    };
 
-        privcurve_to_curve( p->priv->fcurve, &p->curve );
+    size_t threadCount = std::min<size_t>( std::thread::hardware_concurrency(), paths.size() );
+    std::vector<std::thread> threads;
 
-        if( progress->callback )
-        {
-            cn += p->priv->len;
-            progress_update( cn / nn, progress );
-        }
+    for( size_t i = 1; i < threadCount; ++i )
+        threads.emplace_back( processPaths, false );
+
+    processPaths( true );
+
+    for( std::thread& thread : threads )
+        thread.join();
+
+    if( error )
+    {
+        errno = error;
+        return 1;
     }
 
     progress_update( 1.0, progress );
 
     return 0;
-
-try_error:
-    return 1;
 }
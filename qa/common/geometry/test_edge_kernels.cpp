@@ -0,0 +1,94 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <geometry/edge_kernels.h>
+
+#include <random>
+#include <vector>
+
+
+namespace
+{
+
+/**
+ * Builds aCount points on a coarse grid, so that many of them are aligned with each other
+ * and with the test points: the cases where the vector kernels fall back to the exact code.
+ */
+std::vector<VECTOR2I> randomGridPoints( int aCount, int aStep, std::mt19937& aRng )
+{
+    std::uniform_int_distribution<int> cell( -10, 10 );
+    std::vector<VECTOR2I>              points;
+
+    for( int ii = 0; ii < aCount; ++ii )
+        points.emplace_back( cell( aRng ) * aStep, cell( aRng ) * aStep );
+
+    return points;
+}
+
+} // namespace
+
+
+/**
+ * Checks that the kernels give the same results as their scalar versions.
+ */
+BOOST_AUTO_TEST_SUITE( EdgeKernels )
+
+
+BOOST_AUTO_TEST_CASE( SameAsScalar )
+{
+    std::mt19937 rng( 7 );
+
+    // Up to coordinates whose distances still fit in an int
+    for( int step : { 1, 3, 1000, 12345678, 50000000 } )
+    {
+        std::uniform_int_distribution<int> coord( -10 * step, 10 * step );
+
+        for( int count : { 0, 1, 2, 3, 4, 5, 7, 8, 9, 31, 33, 64, 200 } )
+        {
+            std::vector<VECTOR2I> points = randomGridPoints( count, step, rng );
+
+            for( int ii = 0; ii < 200; ++ii )
+            {
+                VECTOR2I p( coord( rng ), coord( rng ) );
+
+                // Half of the points on the vertices and grid lines
+                if( ii % 2 )
+                    p = VECTOR2I( p.x / step * step, p.y / step * step );
+
+                BOOST_CHECK_EQUAL( EDGE_KERNELS::OddRayCrossings( points.data(), count, p ),
+                                   EDGE_KERNELS::OddRayCrossingsScalar( points.data(), count,
+                                                                        p ) );
+
+                for( int edges : { count - 1, count } )
+                {
+                    BOOST_CHECK_EQUAL(
+                            EDGE_KERNELS::MinDistance( points.data(), count, edges, p ),
+                            EDGE_KERNELS::MinDistanceScalar( points.data(), count, edges, p ) );
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,133 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+#include <cmath>
+
+
+namespace
+{
+
+/**
+ * A comb of aTeeth teeth, with a ragged back so that its points are not in z-order.
+ */
+SHAPE_LINE_CHAIN comb( int aTeeth )
+{
+    SHAPE_LINE_CHAIN chain;
+
+    for( int ii = 0; ii < aTeeth; ++ii )
+    {
+        chain.Append( ii * 100, 0 );
+        chain.Append( ii * 100 + 50, 1000 + ( ii * 37 ) % 200 );
+    }
+
+    chain.Append( aTeeth * 100, 0 );
+    chain.Append( aTeeth * 100, -500 );
+
+    for( int ii = aTeeth; ii > 0; --ii )
+        chain.Append( ii * 100 - 50, -500 - ( ii * 53 ) % 300 );
+
+    chain.Append( 0, -500 );
+    chain.SetClosed( true );
+
+    return chain;
+}
+
+
+SHAPE_LINE_CHAIN circle( int aRadius, int aCount )
+{
+    SHAPE_LINE_CHAIN chain;
+
+    for( int ii = 0; ii < aCount; ++ii )
+    {
+        double angle = 2.0 * M_PI * ii / aCount;
+        chain.Append( (int) std::lround( aRadius * cos( angle ) ),
+                      (int) std::lround( aRadius * sin( angle ) ) );
+    }
+
+    chain.SetClosed( true );
+
+    return chain;
+}
+
+
+double triangulatedArea( const SHAPE_POLY_SET& aSet )
+{
+    double area = 0.0;
+
+    for( unsigned ii = 0; ii < aSet.TriangulatedPolyCount(); ++ii )
+    {
+        const SHAPE_POLY_SET::TRIANGULATED_POLYGON* tri = aSet.TriangulatedPolygon( ii );
+
+        for( size_t jj = 0; jj < tri->GetTriangleCount(); ++jj )
+        {
+            VECTOR2I a, b, c;
+
+            tri->GetTriangle( jj, a, b, c );
+            area += std::abs( (double) ( b - a ).Cross( c - a ) ) / 2.0;
+        }
+    }
+
+    return area;
+}
+
+} // namespace
+
+
+/**
+ * Checks that the triangles of a polygon set cover the area of its polygons.
+ */
+BOOST_AUTO_TEST_SUITE( PolygonTriangulation )
+
+
+BOOST_AUTO_TEST_CASE( Area )
+{
+    for( int teeth : { 1, 10, 1000 } )
+    {
+        SHAPE_POLY_SET set;
+
+        set.AddOutline( comb( teeth ) );
+        set.CacheTriangulation();
+
+        BOOST_CHECK( set.IsTriangulationUpToDate() );
+        BOOST_CHECK_CLOSE( triangulatedArea( set ), std::abs( set.COutline( 0 ).Area() ), 1e-6 );
+    }
+
+    SHAPE_POLY_SET set;
+
+    set.AddOutline( circle( 1000000, 20000 ) );
+    set.AddHole( circle( 500000, 10000 ) );
+
+    const double area = std::abs( set.COutline( 0 ).Area() )
+                        - std::abs( set.CHole( 0, 0 ).Area() );
+
+    set.CacheTriangulation();
+
+    BOOST_CHECK( set.IsTriangulationUpToDate() );
+    BOOST_CHECK_CLOSE( triangulatedArea( set ), area, 1e-6 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,123 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <geometry/rtree.h>
+
+#include <random>
+#include <set>
+
+
+namespace
+{
+
+struct BOX
+{
+    int m_min[3];
+    int m_max[3];
+};
+
+
+typedef RTree<BOX*, int, 3, double> BOX_TREE;
+
+
+std::set<BOX*> findAll( BOX_TREE& aTree, const int aMin[3], const int aMax[3] )
+{
+    std::set<BOX*> found;
+
+    aTree.Search( aMin, aMax, [&]( BOX* const& aBox )
+            {
+                found.insert( aBox );
+                return true;
+            } );
+
+    return found;
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_SUITE( RTreeBulkLoad )
+
+
+/**
+ * Check that a bulk loaded tree finds the same entries as a tree built by insertion,
+ * and can still be edited afterwards
+ */
+BOOST_AUTO_TEST_CASE( SameAsInsertion )
+{
+    for( int count : { 0, 1, 8, 9, 12, 1000 } )
+    {
+        BOOST_TEST_CONTEXT( "Entry count " << count )
+        {
+            std::mt19937       rng( count );
+            std::vector<BOX>   boxes( count );
+            std::vector<BOX*>  data;
+
+            for( BOX& box : boxes )
+            {
+                box.m_min[0] = rng() % 4;
+                box.m_max[0] = box.m_min[0] + rng() % 2;
+
+                for( int axis = 1; axis < 3; ++axis )
+                {
+                    box.m_min[axis] = (int) ( rng() % 100000 ) - 50000;
+                    box.m_max[axis] = box.m_min[axis] + rng() % 500;
+                }
+
+                data.push_back( &box );
+            }
+
+            BOX_TREE packed;
+            BOX_TREE inserted;
+
+            packed.BulkLoad( data, []( BOX* aBox, int* aMin, int* aMax )
+                    {
+                        std::copy( aBox->m_min, aBox->m_min + 3, aMin );
+                        std::copy( aBox->m_max, aBox->m_max + 3, aMax );
+                    } );
+
+            for( BOX* box : data )
+                inserted.Insert( box->m_min, box->m_max, box );
+
+            BOOST_CHECK_EQUAL( packed.Count(), count );
+
+            for( int query = 0; query < 100; ++query )
+            {
+                const int qmin[3] = { (int) ( rng() % 4 ), (int) ( rng() % 100000 ) - 50000,
+                                      (int) ( rng() % 100000 ) - 50000 };
+                const int qmax[3] = { qmin[0] + 1, qmin[1] + 3000, qmin[2] + 3000 };
+
+                BOOST_CHECK( findAll( packed, qmin, qmax ) == findAll( inserted, qmin, qmax ) );
+            }
+
+            for( int ii = 0; ii < count; ii += 2 )
+                BOOST_CHECK( !packed.Remove( data[ii]->m_min, data[ii]->m_max, data[ii] ) );
+
+            BOOST_CHECK_EQUAL( packed.Count(), count - ( count + 1 ) / 2 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
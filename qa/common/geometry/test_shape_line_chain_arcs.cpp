@@ -0,0 +1,177 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <geometry/shape_arc.h>
+#include <geometry/shape_line_chain.h>
+
+
+namespace
+{
+
+/**
+ * Appends the segments of aArc point by point, as the chains did before keeping the arcs.
+ */
+void appendSegments( SHAPE_LINE_CHAIN& aChain, const SHAPE_ARC& aArc, double aAccuracy )
+{
+    int count = aArc.GetPolylineSegmentCount( aAccuracy );
+
+    for( int ii = 0; ii <= count; ++ii )
+        aChain.Append( aArc.GetPolylinePoint( ii, count ) );
+}
+
+
+bool samePoints( const SHAPE_LINE_CHAIN& aA, const SHAPE_LINE_CHAIN& aB )
+{
+    return aA.CPoints() == aB.CPoints();
+}
+
+} // namespace
+
+
+/**
+ * Checks that the chains keeping arcs have the points of their segments, and test the
+ * collisions against the arcs themselves.
+ */
+BOOST_AUTO_TEST_SUITE( ShapeLineChainArcs )
+
+
+BOOST_AUTO_TEST_CASE( Points )
+{
+    const SHAPE_ARC arcA( VECTOR2I( 0, 0 ), VECTOR2I( 1000000, 0 ), 90.0 );
+    const SHAPE_ARC arcB( VECTOR2I( -2000000, 0 ), VECTOR2I( -2000000, 1000000 ), -180.0 );
+
+    SHAPE_LINE_CHAIN chain;
+    SHAPE_LINE_CHAIN expected;
+
+    for( SHAPE_LINE_CHAIN* c : { &chain, &expected } )
+        c->Append( 1000000, -1000000 );
+
+    chain.Append( arcA, 500.0 );
+    appendSegments( expected, arcA, 500.0 );
+
+    for( SHAPE_LINE_CHAIN* c : { &chain, &expected } )
+        c->Append( -2000000, 1000000 );
+
+    chain.Append( arcB, 5000.0 );
+    appendSegments( expected, arcB, 5000.0 );
+
+    chain.SetClosed( true );
+    expected.SetClosed( true );
+
+    BOOST_CHECK_EQUAL( chain.ArcCount(), 2 );
+    BOOST_CHECK( samePoints( chain, expected ) );
+
+    // Reading the points keeps the arcs, and so does a copy
+    const SHAPE_LINE_CHAIN copy( chain );
+
+    BOOST_CHECK_EQUAL( copy.ArcCount(), 2 );
+    BOOST_CHECK( &copy.CPoints() == &chain.CPoints() );
+
+    for( int ii = 0; ii < expected.PointCount(); ++ii )
+        BOOST_CHECK( chain.BBox().Contains( expected.CPoint( ii ) ) );
+
+    // Appending chains gives the same points with or without the arcs
+    SHAPE_LINE_CHAIN appended = expected;
+    SHAPE_LINE_CHAIN appendedExpected = expected;
+
+    appended.Append( chain );
+    appendedExpected.Append( expected );
+
+    BOOST_CHECK_EQUAL( appended.ArcCount(), 2 );
+    BOOST_CHECK( samePoints( appended, appendedExpected ) );
+
+    appended = chain;
+    appended.Append( appended );
+
+    BOOST_CHECK_EQUAL( appended.ArcCount(), 4 );
+    BOOST_CHECK( samePoints( appended, appendedExpected ) );
+
+    // A change of the points replaces the arcs by their segments
+    chain.Point( 0 ) = VECTOR2I( 0, -1000000 );
+    expected.Point( 0 ) = VECTOR2I( 0, -1000000 );
+
+    BOOST_CHECK_EQUAL( chain.ArcCount(), 0 );
+    BOOST_CHECK( samePoints( chain, expected ) );
+    BOOST_CHECK_EQUAL( copy.ArcCount(), 2 );
+}
+
+
+BOOST_AUTO_TEST_CASE( Move )
+{
+    SHAPE_LINE_CHAIN chain = SHAPE_ARC( VECTOR2I( 0, 0 ), VECTOR2I( 100000, 0 ), 270.0 )
+                                     .ConvertToPolyline( 100.0 );
+    SHAPE_LINE_CHAIN segments( chain.CPoints().data(), chain.PointCount() );
+
+    chain.Move( VECTOR2I( 1234, -5678 ) );
+    segments.Move( VECTOR2I( 1234, -5678 ) );
+
+    BOOST_CHECK_EQUAL( chain.ArcCount(), 1 );
+    BOOST_REQUIRE_EQUAL( chain.PointCount(), segments.PointCount() );
+
+    // The moved arc is divided again, with other roundings
+    for( int ii = 0; ii < chain.PointCount(); ++ii )
+        BOOST_CHECK_LE( ( chain.CPoint( ii ) - segments.CPoint( ii ) ).EuclideanNorm(), 1 );
+}
+
+
+BOOST_AUTO_TEST_CASE( Collide )
+{
+    const SHAPE_ARC  arc( VECTOR2I( 0, 0 ), VECTOR2I( 1000000, 0 ), 90.0 );
+    SHAPE_LINE_CHAIN chain;
+
+    chain.Append( -1000000, -1000000 );
+    chain.Append( arc, 500.0 );
+    chain.Append( -1000000, 1000000 );
+
+    SHAPE_LINE_CHAIN segments( chain.CPoints().data(), chain.PointCount() );
+
+    // 300 outside the arc, in the middle of its first segment: farther from the segment
+    const double   angle = M_PI / 4.0 / arc.GetPolylineSegmentCount( 500.0 );
+    const VECTOR2D dir( cos( angle ), sin( angle ) );
+    const VECTOR2I outside( dir * 1000300.0 );
+    const VECTOR2I along( VECTOR2D( -dir.y, dir.x ) * 1000.0 );
+    const SEG      tangent( outside - along, outside + along );
+
+    BOOST_CHECK( chain.Collide( tangent, 500 ) );
+    BOOST_CHECK( !chain.Collide( tangent, 250 ) );
+    BOOST_CHECK( !segments.Collide( tangent, 500 ) );
+
+    BOOST_CHECK( chain.Collide( outside, 500 ) );
+    BOOST_CHECK( !chain.Collide( outside, 250 ) );
+
+    // Crossing the arc, between its ends, and near its straight parts
+    BOOST_CHECK( chain.Collide( SEG( VECTOR2I( 0, 0 ), VECTOR2I( 2000000, 1000000 ) ), 0 ) );
+    BOOST_CHECK( chain.Collide( VECTOR2I( 0, -500000 + 100 ), 200 ) );
+    BOOST_CHECK( !chain.Collide( VECTOR2I( 0, 0 ), 200 ) );
+
+    // The closing segment
+    BOOST_CHECK( !chain.Collide( VECTOR2I( -1000100, 0 ), 200 ) );
+
+    chain.SetClosed( true );
+
+    BOOST_CHECK( chain.Collide( VECTOR2I( -1000100, 0 ), 200 ) );
+    BOOST_CHECK( chain.ArcCount() == 1 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,157 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <geometry/shape_line_chain.h>
+
+#include <climits>
+#include <cmath>
+#include <random>
+
+
+namespace
+{
+
+/**
+ * Builds a closed star shaped chain of aCount points, with a random radius for each point,
+ * so that it has many concave corners.
+ */
+SHAPE_LINE_CHAIN randomStar( int aCount, std::mt19937& aRng )
+{
+    std::uniform_int_distribution<int> radius( 20000, 100000 );
+    SHAPE_LINE_CHAIN                   chain;
+
+    for( int ii = 0; ii < aCount; ++ii )
+    {
+        double angle = 2 * M_PI * ii / aCount;
+        int    r = radius( aRng );
+
+        chain.Append( VECTOR2I( r * cos( angle ), r * sin( angle ) ) );
+    }
+
+    chain.SetClosed( true );
+    return chain;
+}
+
+
+///> Distance to the edges, computed without the edge index
+int linearDistance( const SHAPE_LINE_CHAIN& aChain, const SEG& aSeg )
+{
+    int d = INT_MAX;
+
+    for( int ii = 0; ii < aChain.SegmentCount(); ++ii )
+        d = std::min( d, aChain.CSegment( ii ).Distance( aSeg ) );
+
+    return d;
+}
+
+
+///> Point inside test by crossings, computed without the edge index
+bool linearInside( const SHAPE_LINE_CHAIN& aChain, const VECTOR2I& aP )
+{
+    int crossings = 0;
+
+    for( int ii = 0; ii < aChain.SegmentCount(); ++ii )
+    {
+        const SEG s = aChain.CSegment( ii );
+
+        if( ( s.A.y > aP.y ) != ( s.B.y > aP.y ) )
+        {
+            double x = s.A.x + (double) ( s.B.x - s.A.x ) * ( aP.y - s.A.y ) / ( s.B.y - s.A.y );
+
+            if( aP.x < x )
+                crossings++;
+        }
+    }
+
+    return crossings % 2 == 1;
+}
+
+} // namespace
+
+
+/**
+ * Checks that the queries on the chains large enough to have an edge index give the same
+ * results as the tests of all the edges.
+ */
+BOOST_AUTO_TEST_SUITE( ShapeLineChainEdgeIndex )
+
+
+BOOST_AUTO_TEST_CASE( SameAsLinear )
+{
+    std::mt19937                       rng( 42 );
+    std::uniform_int_distribution<int> coord( -120000, 120000 );
+    std::uniform_int_distribution<int> length( -5000, 5000 );
+
+    for( int count : { 10, SHAPE_LINE_CHAIN::EDGE_INDEX_MIN_POINTS, 2000 } )
+    {
+        SHAPE_LINE_CHAIN chain = randomStar( count, rng );
+
+        for( int ii = 0; ii < 500; ++ii )
+        {
+            VECTOR2I p( coord( rng ), coord( rng ) );
+            SEG      seg( p, p + VECTOR2I( length( rng ), length( rng ) ) );
+            int      d = linearDistance( chain, seg );
+            int      dp = linearDistance( chain, SEG( p, p ) );
+
+            BOOST_CHECK_EQUAL( chain.Distance( seg ), d );
+            BOOST_CHECK_EQUAL( chain.Distance( p, true ), dp );
+            BOOST_CHECK_EQUAL( chain.Collide( seg, 1000 ), d < 1000 );
+            BOOST_CHECK_EQUAL( chain.CheckClearance( p, 1000 ), dp <= 1000 );
+
+            // Exactly on an edge is ambiguous for the crossings test
+            if( dp > 1 )
+                BOOST_CHECK_EQUAL( chain.PointInside( p ), linearInside( chain, p ) );
+        }
+
+        // The vertices are on the edges ending and starting at them
+        for( int ii = 0; ii < chain.PointCount(); ii += 7 )
+            BOOST_CHECK_EQUAL( chain.EdgeContainingPoint( chain.CPoint( ii ) ),
+                               ii == 0 ? 0 : ii - 1 );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( DroppedOnChange )
+{
+    std::mt19937     rng( 7 );
+    SHAPE_LINE_CHAIN chain = randomStar( 1000, rng );
+    SHAPE_LINE_CHAIN copy( chain );
+
+    BOOST_CHECK( chain.PointInside( VECTOR2I( 0, 0 ) ) );
+
+    // The copy shares the index of the chain until it is changed
+    copy.Move( VECTOR2I( 500000, 0 ) );
+
+    BOOST_CHECK( !copy.PointInside( VECTOR2I( 0, 0 ) ) );
+    BOOST_CHECK( copy.PointInside( VECTOR2I( 500000, 0 ) ) );
+    BOOST_CHECK( chain.PointInside( VECTOR2I( 0, 0 ) ) );
+
+    chain.Move( VECTOR2I( 0, 500000 ) );
+
+    BOOST_CHECK( !chain.PointInside( VECTOR2I( 0, 0 ) ) );
+    BOOST_CHECK( chain.PointInside( VECTOR2I( 0, 500000 ) ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
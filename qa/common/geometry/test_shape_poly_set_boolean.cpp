@@ -0,0 +1,297 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+#include <cmath>
+
+
+namespace
+{
+
+SHAPE_LINE_CHAIN rectangle( int aX, int aY, int aWidth, int aHeight )
+{
+    SHAPE_LINE_CHAIN chain;
+
+    chain.Append( aX, aY );
+    chain.Append( aX + aWidth, aY );
+    chain.Append( aX + aWidth, aY + aHeight );
+    chain.Append( aX, aY + aHeight );
+    chain.SetClosed( true );
+
+    return chain;
+}
+
+
+/**
+ * A grid of aCount x aCount overlapping squares of aSize, aPitch apart: more points than
+ * the threshold of the parallel boolean operations with the default of 50000.
+ */
+SHAPE_POLY_SET squareGrid( int aCount, int aSize, int aPitch )
+{
+    SHAPE_POLY_SET grid;
+
+    for( int ii = 0; ii < aCount; ++ii )
+    {
+        for( int jj = 0; jj < aCount; ++jj )
+            grid.AddOutline( rectangle( ii * aPitch, jj * aPitch, aSize, aSize ) );
+    }
+
+    return grid;
+}
+
+
+double area( const SHAPE_POLY_SET& aSet )
+{
+    double area = 0.0;
+
+    for( int ii = 0; ii < aSet.OutlineCount(); ++ii )
+    {
+        area += std::fabs( aSet.COutline( ii ).Area() );
+
+        for( int jj = 0; jj < aSet.HoleCount( ii ); ++jj )
+            area -= std::fabs( aSet.CHole( ii, jj ).Area() );
+    }
+
+    return area;
+}
+
+
+ClipperLib::Paths toPaths( const SHAPE_POLY_SET& aSet )
+{
+    ClipperLib::Paths paths;
+
+    for( int ii = 0; ii < aSet.OutlineCount(); ++ii )
+    {
+        paths.push_back( aSet.COutline( ii ).convertToClipper( true ) );
+
+        for( int jj = 0; jj < aSet.HoleCount( ii ); ++jj )
+            paths.push_back( aSet.CHole( ii, jj ).convertToClipper( false ) );
+    }
+
+    return paths;
+}
+
+
+/**
+ * @return the result of aType between aA and aB in a single Clipper call, as the small
+ * sets are done
+ */
+ClipperLib::Paths clipperResult( ClipperLib::ClipType aType, const SHAPE_POLY_SET& aA,
+                                 const SHAPE_POLY_SET& aB )
+{
+    ClipperLib::Clipper c;
+    ClipperLib::Paths   result;
+
+    c.AddPaths( toPaths( aA ), ClipperLib::ptSubject, true );
+    c.AddPaths( toPaths( aB ), ClipperLib::ptClip, true );
+    c.Execute( aType, result, ClipperLib::pftNonZero, ClipperLib::pftNonZero );
+
+    return result;
+}
+
+
+/**
+ * @return the area of the parts of aSet and aPaths which are not in both
+ */
+double xorArea( const SHAPE_POLY_SET& aSet, const ClipperLib::Paths& aPaths )
+{
+    ClipperLib::Clipper c;
+    ClipperLib::Paths   difference;
+    double              area = 0.0;
+
+    c.AddPaths( toPaths( aSet ), ClipperLib::ptSubject, true );
+    c.AddPaths( aPaths, ClipperLib::ptClip, true );
+    c.Execute( ClipperLib::ctXor, difference, ClipperLib::pftNonZero, ClipperLib::pftNonZero );
+
+    // The holes have a negative area
+    for( const ClipperLib::Path& path : difference )
+        area += ClipperLib::Area( path );
+
+    return std::fabs( area );
+}
+
+
+/**
+ * Checks that aA and aB have the same polygons, with the same vertices in the same order
+ */
+void checkSameVertices( const SHAPE_POLY_SET& aA, const SHAPE_POLY_SET& aB )
+{
+    BOOST_REQUIRE_EQUAL( aA.OutlineCount(), aB.OutlineCount() );
+
+    auto checkChain = []( const SHAPE_LINE_CHAIN& aChainA, const SHAPE_LINE_CHAIN& aChainB )
+    {
+        BOOST_REQUIRE_EQUAL( aChainA.PointCount(), aChainB.PointCount() );
+
+        for( int ii = 0; ii < aChainA.PointCount(); ++ii )
+            BOOST_REQUIRE( aChainA.CPoint( ii ) == aChainB.CPoint( ii ) );
+    };
+
+    for( int ii = 0; ii < aA.OutlineCount(); ++ii )
+    {
+        checkChain( aA.COutline( ii ), aB.COutline( ii ) );
+
+        BOOST_REQUIRE_EQUAL( aA.HoleCount( ii ), aB.HoleCount( ii ) );
+
+        for( int jj = 0; jj < aA.HoleCount( ii ); ++jj )
+            checkChain( aA.CHole( ii, jj ), aB.CHole( ii, jj ) );
+    }
+}
+
+} // namespace
+
+
+/**
+ * Checks the results of the boolean operations of large sets, which are split into bands
+ * run on several threads.  The sets are over the threshold of the banded operations with
+ * the default settings, whatever the number of cores.
+ */
+BOOST_AUTO_TEST_SUITE( ShapePolySetBoolean )
+
+
+BOOST_AUTO_TEST_CASE( LargeUnion )
+{
+    // The squares cover [0, 962] x [0, 962] without gaps
+    SHAPE_POLY_SET grid = squareGrid( 120, 10, 8 );
+
+    grid.Simplify( SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_EQUAL( grid.OutlineCount(), 1 );
+    BOOST_CHECK_EQUAL( grid.HoleCount( 0 ), 0 );
+    BOOST_CHECK_CLOSE( area( grid ), 962.0 * 962.0, 1e-9 );
+}
+
+
+BOOST_AUTO_TEST_CASE( LargeUnionOfTwoSets )
+{
+    // Squares of 10 with gaps of 2 between them, covered by the bridges of a second set
+    SHAPE_POLY_SET grid = squareGrid( 120, 10, 12 );
+    SHAPE_POLY_SET bridges;
+
+    for( int ii = 0; ii < 119; ++ii )
+    {
+        bridges.AddOutline( rectangle( ii * 12 + 5, 0, 10, 119 * 12 + 10 ) );
+        bridges.AddOutline( rectangle( 0, ii * 12 + 5, 119 * 12 + 10, 10 ) );
+    }
+
+    grid.BooleanAdd( bridges, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+
+    BOOST_CHECK_EQUAL( grid.OutlineCount(), 1 );
+    BOOST_CHECK_EQUAL( grid.HoleCount( 0 ), 0 );
+    BOOST_CHECK_CLOSE( area( grid ), 1438.0 * 1438.0, 1e-9 );
+}
+
+
+BOOST_AUTO_TEST_CASE( LargeSubtractAndIntersect )
+{
+    SHAPE_POLY_SET board;
+    SHAPE_POLY_SET pads = squareGrid( 120, 10, 20 );
+
+    board.AddOutline( rectangle( -100, -100, 2600, 2600 ) );
+
+    SHAPE_POLY_SET knockout = board;
+
+    knockout.BooleanSubtract( pads, SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_EQUAL( knockout.OutlineCount(), 1 );
+    BOOST_CHECK_EQUAL( knockout.HoleCount( 0 ), 120 * 120 );
+    BOOST_CHECK_CLOSE( area( knockout ), 2600.0 * 2600.0 - 120 * 120 * 100.0, 1e-9 );
+
+    // The left half of the board holds 60 columns of pads, the next one touching its edge
+    SHAPE_POLY_SET half = pads;
+    SHAPE_POLY_SET leftSide;
+
+    leftSide.AddOutline( rectangle( -100, -100, 1300, 2600 ) );
+    half.BooleanIntersection( leftSide, SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_EQUAL( half.OutlineCount(), 120 * 60 );
+    BOOST_CHECK_CLOSE( area( half ), 120 * 60 * 100.0, 1e-9 );
+}
+
+
+/**
+ * The banded operations cover the same area as a single Clipper call, whether they split
+ * the polygons into bands (union) or cut the first set into strips (subtraction)
+ */
+BOOST_AUTO_TEST_CASE( BandedMatchesClipper )
+{
+    SHAPE_POLY_SET board;
+    SHAPE_POLY_SET pads = squareGrid( 120, 10, 8 );
+    SHAPE_POLY_SET empty;
+
+    board.AddOutline( rectangle( -100, -100, 1200, 1200 ) );
+
+    SHAPE_POLY_SET merged;
+
+    merged.BandedBooleanOp( ClipperLib::ctUnion, pads, empty, SHAPE_POLY_SET::PM_FAST );
+    BOOST_CHECK_SMALL( xorArea( merged, clipperResult( ClipperLib::ctUnion, pads, empty ) ),
+                       1.0 );
+
+    SHAPE_POLY_SET knockout;
+
+    knockout.BandedBooleanOp( ClipperLib::ctDifference, board, pads, SHAPE_POLY_SET::PM_FAST );
+    BOOST_CHECK_SMALL( xorArea( knockout, clipperResult( ClipperLib::ctDifference, board, pads ) ),
+                       1.0 );
+
+    SHAPE_POLY_SET inside;
+
+    inside.BandedBooleanOp( ClipperLib::ctIntersection, pads, board, SHAPE_POLY_SET::PM_FAST );
+    BOOST_CHECK_SMALL( xorArea( inside, clipperResult( ClipperLib::ctIntersection, pads, board ) ),
+                       1.0 );
+}
+
+
+/**
+ * The split into bands does not depend on the thread count, so the results are the same,
+ * vertex by vertex, on all machines
+ */
+BOOST_AUTO_TEST_CASE( BandedIndependentOfThreadCount )
+{
+    SHAPE_POLY_SET board;
+    SHAPE_POLY_SET pads = squareGrid( 120, 10, 20 );
+
+    board.AddOutline( rectangle( -100, -100, 2600, 2600 ) );
+
+    SHAPE_POLY_SET singleThread;
+    SHAPE_POLY_SET allThreads;
+
+    singleThread.BandedBooleanOp( ClipperLib::ctDifference, board, pads,
+                                  SHAPE_POLY_SET::PM_FAST, 1 );
+    allThreads.BandedBooleanOp( ClipperLib::ctDifference, board, pads,
+                                SHAPE_POLY_SET::PM_FAST, 0 );
+
+    checkSameVertices( singleThread, allThreads );
+
+    SHAPE_POLY_SET grid = squareGrid( 120, 10, 8 );
+    SHAPE_POLY_SET empty;
+
+    singleThread.BandedBooleanOp( ClipperLib::ctUnion, grid, empty, SHAPE_POLY_SET::PM_FAST, 1 );
+    allThreads.BandedBooleanOp( ClipperLib::ctUnion, grid, empty, SHAPE_POLY_SET::PM_FAST, 0 );
+
+    checkSameVertices( singleThread, allThreads );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,190 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+
+namespace
+{
+
+SHAPE_LINE_CHAIN square( int aSize )
+{
+    SHAPE_LINE_CHAIN chain;
+
+    chain.Append( 0, 0 );
+    chain.Append( aSize, 0 );
+    chain.Append( aSize, aSize );
+    chain.Append( 0, aSize );
+    chain.SetClosed( true );
+
+    return chain;
+}
+
+} // namespace
+
+
+/**
+ * Checks that the copies of the line chains and polygon sets, which share their points,
+ * are independent of each other once changed.
+ */
+BOOST_AUTO_TEST_SUITE( ShapePolySetCopy )
+
+
+BOOST_AUTO_TEST_CASE( ChainCopyOnWrite )
+{
+    SHAPE_LINE_CHAIN chain = square( 100 );
+    SHAPE_LINE_CHAIN copy( chain );
+
+    BOOST_CHECK( &copy.CPoints() == &chain.CPoints() );
+
+    copy.Point( 1 ) = VECTOR2I( 50, 50 );
+    copy.Append( 10, 10 );
+
+    BOOST_CHECK( &copy.CPoints() != &chain.CPoints() );
+    BOOST_CHECK_EQUAL( chain.PointCount(), 4 );
+    BOOST_CHECK( chain.CPoint( 1 ) == VECTOR2I( 100, 0 ) );
+    BOOST_CHECK_EQUAL( copy.PointCount(), 5 );
+    BOOST_CHECK( copy.CPoint( 1 ) == VECTOR2I( 50, 50 ) );
+
+    SHAPE_LINE_CHAIN moved( std::move( copy ) );
+
+    BOOST_CHECK_EQUAL( moved.PointCount(), 5 );
+    BOOST_CHECK_EQUAL( copy.PointCount(), 0 );
+}
+
+
+BOOST_AUTO_TEST_CASE( ChainSelfReplace )
+{
+    SHAPE_LINE_CHAIN chain = square( 100 );
+
+    chain.Replace( 1, 1, chain );
+
+    BOOST_CHECK_EQUAL( chain.PointCount(), 7 );
+    BOOST_CHECK( chain.CPoint( 0 ) == VECTOR2I( 0, 0 ) );
+    BOOST_CHECK( chain.CPoint( 1 ) == VECTOR2I( 0, 0 ) );
+    BOOST_CHECK( chain.CPoint( 5 ) == VECTOR2I( 100, 100 ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( SetCopyOnWrite )
+{
+    SHAPE_POLY_SET set;
+
+    set.AddOutline( square( 100 ) );
+    set.AddOutline( square( 200 ) );
+
+    const SHAPE_POLY_SET copy( set );
+
+    BOOST_CHECK( &copy.COutline( 0 ).CPoints() == &set.COutline( 0 ).CPoints() );
+
+    // Reading the copy does not unshare it
+    for( auto it = copy.CIterateWithHoles(); it; it++ )
+        BOOST_CHECK( *it != VECTOR2I( -1, -1 ) );
+
+    BOOST_CHECK( &copy.COutline( 0 ).CPoints() == &set.COutline( 0 ).CPoints() );
+
+    set.Move( VECTOR2I( 10, 10 ) );
+
+    BOOST_CHECK( set.COutline( 0 ).CPoint( 0 ) == VECTOR2I( 10, 10 ) );
+    BOOST_CHECK( copy.COutline( 0 ).CPoint( 0 ) == VECTOR2I( 0, 0 ) );
+    BOOST_CHECK( copy.COutline( 1 ).CPoint( 2 ) == VECTOR2I( 200, 200 ) );
+
+    SHAPE_POLY_SET subset = copy.Subset( 1, 2 );
+
+    BOOST_CHECK_EQUAL( subset.OutlineCount(), 1 );
+    BOOST_CHECK( &subset.COutline( 0 ).CPoints() == &copy.COutline( 1 ).CPoints() );
+}
+
+
+BOOST_AUTO_TEST_CASE( SetMove )
+{
+    SHAPE_POLY_SET set;
+
+    set.AddOutline( square( 100 ) );
+    set.CacheTriangulation();
+
+    SHAPE_POLY_SET moved( std::move( set ) );
+
+    BOOST_CHECK_EQUAL( moved.OutlineCount(), 1 );
+    BOOST_CHECK( moved.IsTriangulationUpToDate() );
+    BOOST_CHECK_EQUAL( set.OutlineCount(), 0 );
+
+    set = std::move( moved );
+
+    BOOST_CHECK_EQUAL( set.OutlineCount(), 1 );
+    BOOST_CHECK( set.IsTriangulationUpToDate() );
+}
+
+
+BOOST_AUTO_TEST_CASE( TriangulationReuse )
+{
+    SHAPE_POLY_SET set;
+
+    set.AddOutline( square( 100 ) );
+    set.AddOutline( square( 200 ) );
+    set.Outline( 1 ).Move( VECTOR2I( 1000, 0 ) );
+    set.CacheTriangulation();
+
+    BOOST_CHECK_EQUAL( set.TriangulatedPolyCount(), 2 );
+
+    const SHAPE_POLY_SET::TRIANGULATED_POLYGON* first = set.TriangulatedPolygon( 0 );
+    const SHAPE_POLY_SET::TRIANGULATED_POLYGON* second = set.TriangulatedPolygon( 1 );
+
+    // Only the changed polygon is triangulated again
+    set.Outline( 1 ).Move( VECTOR2I( 0, 10 ) );
+    set.CacheTriangulation();
+
+    BOOST_CHECK( set.IsTriangulationUpToDate() );
+    BOOST_CHECK( set.TriangulatedPolygon( 0 ) == first );
+    BOOST_CHECK( set.TriangulatedPolygon( 1 ) != second );
+
+    // A new set with some of the same polygons, as given by a refill
+    SHAPE_POLY_SET refill;
+
+    refill.AddOutline( square( 50 ) );
+    refill.AddOutline( square( 100 ) );
+    refill.ReuseTriangulations( set );
+
+    BOOST_CHECK( !refill.IsTriangulationUpToDate() );
+
+    refill.CacheTriangulation();
+
+    BOOST_CHECK( refill.IsTriangulationUpToDate() );
+    BOOST_CHECK_EQUAL( refill.TriangulatedPolyCount(), 2 );
+    BOOST_CHECK( refill.TriangulatedPolygon( 0 ) != first );
+    BOOST_CHECK( refill.TriangulatedPolygon( 1 ) == first );
+
+    // An assignment keeps the triangulations to reuse
+    set = refill;
+
+    BOOST_CHECK( !set.IsTriangulationUpToDate() );
+
+    set.CacheTriangulation();
+
+    BOOST_CHECK( set.TriangulatedPolygon( 1 ) == first );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
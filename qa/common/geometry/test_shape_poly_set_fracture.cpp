@@ -0,0 +1,107 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+
+namespace
+{
+
+SHAPE_LINE_CHAIN square( const VECTOR2I& aCorner, int aSize )
+{
+    SHAPE_LINE_CHAIN chain;
+
+    chain.Append( aCorner );
+    chain.Append( aCorner + VECTOR2I( aSize, 0 ) );
+    chain.Append( aCorner + VECTOR2I( aSize, aSize ) );
+    chain.Append( aCorner + VECTOR2I( 0, aSize ) );
+    chain.SetClosed( true );
+
+    return chain;
+}
+
+
+/**
+ * A square with a grid of aCount x aCount square holes, whose left edges are aligned:
+ * the holes are bridged to each other from left to right.
+ */
+SHAPE_POLY_SET gridWithHoles( int aCount )
+{
+    SHAPE_POLY_SET outline;
+    SHAPE_POLY_SET holes;
+
+    outline.AddOutline( square( VECTOR2I( 0, 0 ), ( aCount + 1 ) * 1000 ) );
+
+    for( int ii = 0; ii < aCount; ++ii )
+    {
+        for( int jj = 0; jj < aCount; ++jj )
+            holes.AddOutline( square( VECTOR2I( 1000 * ii + 700, 1000 * jj + 700 ), 500 ) );
+    }
+
+    outline.BooleanSubtract( holes, SHAPE_POLY_SET::PM_FAST );
+
+    return outline;
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_SUITE( ShapePolySetFracture )
+
+
+BOOST_AUTO_TEST_CASE( ManyHoles )
+{
+    for( int count : { 1, 3, 40 } )
+    {
+        SHAPE_POLY_SET set = gridWithHoles( count );
+
+        BOOST_REQUIRE_EQUAL( set.OutlineCount(), 1 );
+        BOOST_CHECK_EQUAL( set.HoleCount( 0 ), count * count );
+
+        double area = std::abs( set.COutline( 0 ).Area() );
+
+        for( int ii = 0; ii < set.HoleCount( 0 ); ++ii )
+            area -= std::abs( set.CHole( 0, ii ).Area() );
+
+        set.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+        // A single outline, with zero width bridges to the holes
+        BOOST_REQUIRE_EQUAL( set.OutlineCount(), 1 );
+        BOOST_CHECK_EQUAL( set.HoleCount( 0 ), 0 );
+        BOOST_CHECK_CLOSE( std::abs( set.COutline( 0 ).Area() ), area, 1e-9 );
+
+        // The holes are outside of the fractured outline
+        BOOST_CHECK( !set.Contains( VECTOR2I( 950, 950 ) ) );
+        BOOST_CHECK( set.Contains( VECTOR2I( 1350, 1350 ) ) );
+
+        set.Unfracture( SHAPE_POLY_SET::PM_FAST );
+
+        BOOST_REQUIRE_EQUAL( set.OutlineCount(), 1 );
+        BOOST_CHECK_EQUAL( set.HoleCount( 0 ), count * count );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
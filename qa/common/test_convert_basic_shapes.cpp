@@ -0,0 +1,178 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <convert_basic_shapes_to_polygon.h>
+#include <geometry/seg.h>
+
+#include <limits>
+
+
+namespace
+{
+
+///> @return the distance of aP to the edges of the closed polygon aCorners
+int distanceToEdges( const std::vector<wxPoint>& aCorners, const VECTOR2I& aP )
+{
+    int dist = std::numeric_limits<int>::max();
+
+    for( size_t ii = 0; ii < aCorners.size(); ++ii )
+    {
+        const wxPoint& a = aCorners[ii];
+        const wxPoint& b = aCorners[( ii + 1 ) % aCorners.size()];
+
+        dist = std::min( dist, SEG( VECTOR2I( a.x, a.y ), VECTOR2I( b.x, b.y ) ).Distance( aP ) );
+    }
+
+    return dist;
+}
+
+} // namespace
+
+
+/**
+ * Checks the conversions of the basic shapes which do not use Clipper.
+ */
+BOOST_AUTO_TEST_SUITE( ConvertBasicShapes )
+
+
+BOOST_AUTO_TEST_CASE( RoundedConvexPolygon )
+{
+    const int radius = 1000;
+
+    // A trapezoid, in both orientations
+    std::vector<wxPoint> corners = { { 0, 0 }, { 10000, 0 }, { 8000, 5000 }, { 2000, 5000 } };
+
+    for( int pass = 0; pass < 2; ++pass )
+    {
+        SHAPE_POLY_SET rounded;
+        TransformConvexPolygonToRoundedPolygon( rounded, corners.data(), corners.size(), radius,
+                                                32 );
+
+        SHAPE_POLY_SET inflated;
+        inflated.NewOutline();
+
+        for( const wxPoint& corner : corners )
+            inflated.Append( corner.x, corner.y );
+
+        inflated.Inflate( radius, 32 );
+
+        BOOST_REQUIRE_EQUAL( rounded.OutlineCount(), 1 );
+
+        // Same shape as Clipper gives
+        BOOST_CHECK_CLOSE( rounded.COutline( 0 ).Area(), inflated.COutline( 0 ).Area(), 0.1 );
+
+        // All the points are on the rounded outline, up to the rounding of the points and of
+        // the distances
+        for( auto it = rounded.CIterate(); it; it++ )
+            BOOST_CHECK_LE( std::abs( distanceToEdges( corners, *it ) - radius ), 2 );
+
+        std::reverse( corners.begin(), corners.end() );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( RoundedDegeneratePolygons )
+{
+    // A single corner gives a circle, two corners an oval
+    std::vector<wxPoint> corners = { { 0, 0 }, { 0, 0 }, { 5000, 0 } };
+
+    SHAPE_POLY_SET circle;
+    TransformConvexPolygonToRoundedPolygon( circle, corners.data(), 2, 1000, 16 );
+
+    BOOST_CHECK_EQUAL( circle.COutline( 0 ).PointCount(), 16 );
+
+    for( auto it = circle.CIterate(); it; it++ )
+        BOOST_CHECK_LE( std::abs( ( *it ).EuclideanNorm() - 1000 ), 1 );
+
+    SHAPE_POLY_SET oval;
+    TransformConvexPolygonToRoundedPolygon( oval, corners.data(), 3, 1000, 16 );
+
+    BOOST_CHECK_EQUAL( oval.COutline( 0 ).PointCount(), 18 );
+    BOOST_CHECK_EQUAL( oval.BBox().GetWidth(), 7000 );
+
+    // No radius gives the polygon itself
+    SHAPE_POLY_SET polygon;
+    TransformConvexPolygonToRoundedPolygon( polygon, corners.data(), 3, 0, 16 );
+
+    BOOST_CHECK_EQUAL( polygon.COutline( 0 ).PointCount(), 2 );
+}
+
+
+BOOST_AUTO_TEST_CASE( OvalClearance )
+{
+    const int width = 2000;
+
+    SHAPE_POLY_SET oval;
+    TransformOvalClearanceToPolygon( oval, wxPoint( 0, 0 ), wxPoint( 10000, 0 ), width, 10 );
+
+    BOOST_REQUIRE_EQUAL( oval.OutlineCount(), 1 );
+
+    // Clamped to the oval width, and outside the oval
+    BOX2I bbox = oval.BBox();
+
+    BOOST_CHECK_EQUAL( bbox.GetTop(), -width / 2 );
+    BOOST_CHECK_EQUAL( bbox.GetBottom(), width / 2 );
+
+    SEG axis( VECTOR2I( 0, 0 ), VECTOR2I( 10000, 0 ) );
+
+    for( auto it = oval.CIterate(); it; it++ )
+        BOOST_CHECK_GE( axis.Distance( *it ), width / 2 - 1 );
+
+    // The outline is only one unit further than the ends, up to the rounding
+    for( int angle = 0; angle < 3600; angle += 15 )
+    {
+        VECTOR2I onCircle = VECTOR2I( width / 2 - 2, 0 ).Rotate( DECIDEG2RAD( angle ) );
+
+        BOOST_CHECK( oval.Contains( onCircle, -1, 1 ) );
+        BOOST_CHECK( oval.Contains( onCircle + VECTOR2I( 10000, 0 ), -1, 1 ) );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( ShapesInOnePass )
+{
+    // Enough circles to be converted by several chunks, in the index order
+    const size_t count = 1000;
+
+    auto transform = [&]( size_t aIndex, SHAPE_POLY_SET& aBuffer )
+    {
+        TransformCircleToPolygon( aBuffer, wxPoint( aIndex * 1000, 0 ), 100, 10 );
+    };
+
+    SHAPE_POLY_SET circles;
+    TransformShapesToPolygon( circles, count, transform );
+
+    SHAPE_POLY_SET expected;
+
+    for( size_t ii = 0; ii < count; ++ii )
+        transform( ii, expected );
+
+    BOOST_REQUIRE_EQUAL( circles.OutlineCount(), (int) count );
+
+    for( size_t ii = 0; ii < count; ++ii )
+        BOOST_CHECK( circles.COutline( ii ).CompareGeometry( expected.COutline( ii ) ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,73 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <dsnlexer.h>
+#include <lib_table_lexer.h>
+
+#include <cstring>
+
+
+/**
+ * Checks the keyword lookups of the generated lexers, which use a perfect hash of their
+ * keywords.
+ */
+BOOST_AUTO_TEST_SUITE( DsnLexer )
+
+
+BOOST_AUTO_TEST_CASE( GeneratedKeywords )
+{
+    std::string text;
+    std::vector<int> expected;
+
+    for( int token = 0; ; ++token )
+    {
+        const char* name = LIB_TABLE_LEXER::TokenName( (LIB_TABLE_T::T) token );
+
+        if( !strcmp( name, "token too big" ) )
+            break;
+
+        text += std::string( name ) + " ";
+        expected.push_back( token );
+
+        // Not keywords, but close to one
+        text += std::string( name ) + "_ " + std::string( name ).substr( 1 ) + " ";
+        expected.push_back( DSN_SYMBOL );
+        expected.push_back( DSN_SYMBOL );
+    }
+
+    text += "x";
+    expected.push_back( DSN_SYMBOL );
+
+    LIB_TABLE_LEXER lexer( text );
+
+    for( int token : expected )
+        BOOST_CHECK_EQUAL( lexer.NextTok(), token );
+
+    BOOST_CHECK_EQUAL( lexer.NextTok(), DSN_EOF );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
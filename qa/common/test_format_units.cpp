@@ -27,7 +27,10 @@
 #include <base_units.h>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <iostream>
+#include <limits>
 
 struct UnitFixture
 {
@@ -74,5 +77,55 @@ BOOST_AUTO_TEST_CASE( wxPointUnitFormat )
 
 }
 
+/**
+ * Check that the values are formatted as with the printf formats used before the direct
+ * formatting of the digits.
+ */
+BOOST_AUTO_TEST_CASE( IntegerUnitFormat )
+{
+    auto expected = []( int aValue ) -> std::string
+    {
+        char    buf[50];
+        double  engUnits = aValue;
+        int     len;
+
+#ifndef EESCHEMA
+        engUnits /= IU_PER_MM;
+#endif
+
+        if( engUnits != 0.0 && fabs( engUnits ) <= 0.0001 )
+        {
+            len = snprintf( buf, sizeof( buf ), "%.10f", engUnits );
+
+            while( --len > 0 && buf[len] == '0' )
+                buf[len] = '\0';
+
+#ifndef EESCHEMA
+            if( buf[len] == '.' )
+                buf[len] = '\0';
+            else
+#endif
+                ++len;
+        }
+        else
+        {
+            len = snprintf( buf, sizeof( buf ), "%.10g", engUnits );
+        }
+
+        return std::string( buf, len );
+    };
+
+    for( int value = -10000; value <= 10000; ++value )
+        BOOST_CHECK_EQUAL( FormatInternalUnits( value ), expected( value ) );
+
+    const int step = 7654321;
+    const int max = std::numeric_limits<int>::max();
+
+    for( int value = std::numeric_limits<int>::min(); value < max - step; value += step )
+        BOOST_CHECK_EQUAL( FormatInternalUnits( value ), expected( value ) );
+
+    BOOST_CHECK_EQUAL( FormatInternalUnits( max ), expected( max ) );
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
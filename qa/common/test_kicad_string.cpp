@@ -31,6 +31,8 @@
 // Code under test
 #include <kicad_string.h>
 
+#include <cstring>
+
 /**
  * Declare the test suite
  */
@@ -107,4 +109,43 @@ BOOST_AUTO_TEST_CASE( NaturalNumberCompare )
     }
 }
 
+/**
+ * Test the #StrToDouble method, which must give the same doubles as strtod().
+ */
+BOOST_AUTO_TEST_CASE( StringToDouble )
+{
+    const std::vector<std::string> cases = {
+        "", "-", ".", "0", "-0", "1.", ".5", "-12.5)", "0.0000001", "123456.789012345",
+        "1234567890.1234567", "00001.000010000", "1.2.3", "1e5", "-1.5E-3", "0x1A",
+        "inf", " 12", "0.0000000000000000000001", "0.00000000000000000000001",
+    };
+
+    auto check = [&]( const std::string& aText )
+    {
+        char*  end = nullptr;
+        char*  expEnd = nullptr;
+        double value = StrToDouble( aText.c_str(), &end );
+        double expected = strtod( aText.c_str(), &expEnd );
+
+        BOOST_CHECK_MESSAGE( memcmp( &value, &expected, sizeof( double ) ) == 0
+                                     && end == expEnd,
+                             "StrToDouble failed for \"" + aText + "\"" );
+    };
+
+    for( const std::string& c : cases )
+        check( c );
+
+    // The numbers as written by the board formatter, in mm
+    char buf[50];
+
+    for( int iu = -1000000000; iu <= 1000000000; iu += 999983 )
+    {
+        snprintf( buf, sizeof( buf ), "%.10f", iu / 1e6 );
+        check( buf );
+
+        snprintf( buf, sizeof( buf ), "%.16g", iu / 1e6 );
+        check( buf );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
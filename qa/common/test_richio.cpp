@@ -0,0 +1,88 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <richio.h>
+
+#include <wx/filename.h>
+
+#include <cstring>
+
+
+/**
+ * Checks that the line readers give the same lines from the same text.
+ */
+BOOST_AUTO_TEST_SUITE( RichIO )
+
+
+BOOST_AUTO_TEST_CASE( WholeFileLineReader )
+{
+    const std::vector<std::string> cases = {
+        "",
+        "\n",
+        "(kicad_pcb",
+        "(kicad_pcb (version 20171130)\n  (host pcbnew 5.1)\n)\n",
+        "(kicad_pcb\r\n\r\n  (general)\r\n)",
+    };
+
+    const wxString fileName = wxFileName::CreateTempFileName( "richio" );
+
+    for( const std::string& text : cases )
+    {
+        FILE* fp = wxFopen( fileName, "wb" );
+        BOOST_REQUIRE( fp );
+        fwrite( text.data(), 1, text.size(), fp );
+        fclose( fp );
+
+        WHOLE_FILE_LINE_READER reader( fileName );
+
+        // Twice, to check the rewinding
+        for( int pass = 0; pass < 2; ++pass )
+        {
+            STRING_LINE_READER expected( text, "string" );
+
+            while( expected.ReadLine() )
+            {
+                BOOST_REQUIRE( reader.ReadLine() );
+                BOOST_CHECK_EQUAL( reader.Length(), expected.Length() );
+                BOOST_CHECK_EQUAL( reader.Line(), expected.Line() );
+                BOOST_CHECK_EQUAL( reader.LineNumber(), expected.LineNumber() );
+            }
+
+            BOOST_CHECK( !reader.ReadLine() );
+            BOOST_CHECK_EQUAL( reader.Length(), 0 );
+            BOOST_CHECK_EQUAL( strlen( reader.Line() ), 0 );
+
+            reader.Rewind();
+        }
+    }
+
+    wxRemoveFile( fileName );
+
+    BOOST_CHECK_THROW( WHOLE_FILE_LINE_READER reader( fileName ), IO_ERROR );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -23,7 +23,10 @@
 
 #include <qa_utils/utility_program.h>
 
+#include "tools/cached_container_benchmark/cached_container_benchmark.h"
 #include "tools/coroutines/coroutine_tools.h"
+#include "tools/edge_kernels_benchmark/edge_kernels_benchmark.h"
+#include "tools/geometry_benchmark/geometry_benchmark.h"
 #include "tools/io_benchmark/io_benchmark.h"
 #include "tools/sexpr_parser/sexpr_parse.h"
 
@@ -34,7 +37,10 @@
  * it's effective enough. When you have a new tool, add it to this list.
  */
 const static std::vector<KI_TEST::UTILITY_PROGRAM*> known_tools = {
+    &cached_container_benchmark_tool,
     &coroutine_tool,
+    &edge_kernels_benchmark_tool,
+    &geometry_benchmark_tool,
     &io_benchmark_tool,
     &sexpr_parser_tool,
 };
@@ -0,0 +1,262 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "cached_container_benchmark.h"
+
+#include <gal/opengl/cached_container.h>
+#include <gal/opengl/vertex_item.h>
+#include <gal/opengl/vertex_manager.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+
+using namespace KIGFX;
+
+using CLOCK = std::chrono::steady_clock;
+
+
+/**
+ * A cached container keeping the vertices in RAM without any GL buffer, like
+ * CACHED_CONTAINER_RAM, which counts the times it had to be defragmented.
+ */
+class BENCHMARK_CONTAINER : public CACHED_CONTAINER
+{
+public:
+    BENCHMARK_CONTAINER( unsigned int aSize ) :
+        CACHED_CONTAINER( aSize ), m_defragmentations( 0 )
+    {
+        m_vertices = static_cast<VERTEX*>( malloc( aSize * VERTEX_SIZE ) );
+    }
+
+    ~BENCHMARK_CONTAINER()
+    {
+        free( m_vertices );
+    }
+
+    unsigned int GetBufferHandle() const override
+    {
+        return 0;
+    }
+
+    bool IsMapped() const override
+    {
+        return true;
+    }
+
+    void Map() override
+    {
+    }
+
+    void Unmap() override
+    {
+    }
+
+    int GetDefragmentations() const
+    {
+        return m_defragmentations;
+    }
+
+    int GetFreeChunkCount() const
+    {
+        return m_freeChunks.size();
+    }
+
+    unsigned int GetLargestFreeChunk() const
+    {
+        return m_freeChunks.empty() ? 0 : m_freeChunks.rbegin()->first;
+    }
+
+    unsigned int GetUsedSpace() const
+    {
+        return usedSpace();
+    }
+
+    /// Checks the consistency of the container (only in debug builds)
+    void Check()
+    {
+        test();
+    }
+
+protected:
+    bool defragmentResize( unsigned int aNewSize ) override
+    {
+        if( usedSpace() > aNewSize )
+            return false;
+
+        VERTEX* newBufferMem = static_cast<VERTEX*>( malloc( aNewSize * VERTEX_SIZE ) );
+
+        if( !newBufferMem )
+            return false;
+
+        defragment( newBufferMem );
+
+        free( m_vertices );
+        m_vertices = newBufferMem;
+
+        m_freeSpace += ( aNewSize - m_currentSize );
+        m_currentSize = aNewSize;
+
+        resetFreeChunks( m_currentSize - m_freeSpace, m_freeSpace );
+        ++m_defragmentations;
+
+        return true;
+    }
+
+private:
+    int m_defragmentations;
+};
+
+
+/**
+ * Stores an item of aSize vertices, added in a few pieces like the GAL does when drawing
+ * an item made of several shapes.
+ */
+static bool storeItem( BENCHMARK_CONTAINER& aContainer, VERTEX_ITEM& aItem, unsigned int aSize,
+                       std::mt19937& aRng )
+{
+    std::uniform_int_distribution<unsigned int> pieces( 1, 4 );
+    unsigned int                                 count = std::min( pieces( aRng ), aSize );
+
+    aContainer.SetItem( &aItem );
+
+    for( unsigned int ii = 0; ii < count; ++ii )
+    {
+        unsigned int size = aSize / count + ( ii < aSize % count ? 1 : 0 );
+        VERTEX*      vertices = aContainer.Allocate( size );
+
+        if( !vertices )
+            return false;
+
+        memset( vertices, 0, size * VERTEX_SIZE );
+    }
+
+    aContainer.FinishItem();
+
+    return true;
+}
+
+
+int cached_container_benchmark_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 3 )
+    {
+        os << "Usage: " << argv[0] << " <ITEMS> <EDITS>\n\n";
+        os << "Stores <ITEMS> items of random sizes in a cached vertex container, then\n";
+        os << "replaces random items <EDITS> times with items of a new size, like the\n";
+        os << "interactive edits of a board do, and reports the time spent and the\n";
+        os << "fragmentation of the container.\n";
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    int itemCount = std::atoi( argv[1] );
+    int edits = std::atoi( argv[2] );
+
+    if( itemCount < 1 || edits < 0 )
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    std::mt19937 rng( 1 );
+
+    // Mostly small items (vias, pads, track segments), with a few large ones (zones, texts)
+    std::geometric_distribution<unsigned int>    smallSize( 0.05 );
+    std::uniform_int_distribution<unsigned int>  largeSize( 1000, 20000 );
+    std::uniform_int_distribution<int>           percent( 0, 99 );
+    std::uniform_int_distribution<int>           pick( 0, itemCount - 1 );
+
+    auto itemSize = [&]() -> unsigned int
+    {
+        return percent( rng ) == 0 ? largeSize( rng ) : 3 + 3 * smallSize( rng );
+    };
+
+    // The items are not drawn, so a GL free noncached manager is enough to create them
+    VERTEX_MANAGER                            manager( false );
+    BENCHMARK_CONTAINER                       container( 65536 );
+    std::vector<std::unique_ptr<VERTEX_ITEM>> items;
+
+    auto start = CLOCK::now();
+
+    for( int ii = 0; ii < itemCount; ++ii )
+    {
+        items.emplace_back( new VERTEX_ITEM( manager ) );
+
+        if( !storeItem( container, *items.back(), itemSize(), rng ) )
+            return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+    }
+
+    std::chrono::duration<double, std::milli> loadTime = CLOCK::now() - start;
+    int loadDefragmentations = container.GetDefragmentations();
+
+    container.Check();
+
+    start = CLOCK::now();
+
+    for( int ii = 0; ii < edits; ++ii )
+    {
+        VERTEX_ITEM& item = *items[pick( rng )];
+
+        container.Delete( &item );
+
+        if( !storeItem( container, item, itemSize(), rng ) )
+            return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+    }
+
+    std::chrono::duration<double, std::milli> editTime = CLOCK::now() - start;
+
+    container.Check();
+
+    os << "Cached container benchmark" << std::endl;
+    os << "  Items:                " << itemCount << std::endl;
+    os << "  Edits:                " << edits << std::endl;
+    os << std::fixed << std::setprecision( 1 );
+    os << "  Load:                 " << loadTime.count() << " ms, "
+       << loadDefragmentations << " defragmentations" << std::endl;
+    os << "  Edits:                " << editTime.count() << " ms, "
+       << container.GetDefragmentations() - loadDefragmentations << " defragmentations"
+       << std::endl;
+    os << "  Container size:       " << container.GetSize() << " vertices" << std::endl;
+    os << "  Used space:           " << container.GetUsedSpace() << " vertices" << std::endl;
+    os << "  Free chunks:          " << container.GetFreeChunkCount() << std::endl;
+    os << "  Largest free chunk:   " << container.GetLargestFreeChunk() << " vertices"
+       << std::endl;
+
+    for( std::unique_ptr<VERTEX_ITEM>& item : items )
+        container.Delete( item.get() );
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+KI_TEST::UTILITY_PROGRAM cached_container_benchmark_tool = {
+    "cached_container_benchmark",
+    "Benchmark the allocator of the cached vertex container",
+    cached_container_benchmark_func,
+};
@@ -23,12 +23,16 @@
 
 #include "coroutine_tools.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <string>
+#include <vector>
 
 #include <common.h>
 
 #include <tool/coroutine.h>
+#include <tool/tool_event.h>
 
 #include <wx/cmdline.h>
 
@@ -83,6 +87,101 @@ public:
 };
 
 
+using CLOCK = std::chrono::steady_clock;
+
+
+static int countTo( MyCoroutine* aCofunc, int aCount )
+{
+    for( int i = 1; i <= aCount; i++ )
+        aCofunc->KiYield( i );
+
+    return 0;
+}
+
+
+/**
+ * Times the costs of the tool framework: the switches to a coroutine and back, the start
+ * of a coroutine (as a tool handler is started for each event activating it), and the
+ * matching of an event with the transitions of many idle tools.
+ */
+static void runBenchmark( int aCount )
+{
+    // Switches: one coroutine yielding aCount times
+    MyCoroutine switcher;
+    switcher.SetEntry( [&]( int aArg ) { return countTo( &switcher, aArg ); } );
+
+    auto start = CLOCK::now();
+
+    switcher.Call( aCount );
+
+    while( switcher.Running() )
+        switcher.Resume();
+
+    std::chrono::duration<double, std::nano> switchTime = CLOCK::now() - start;
+
+    printf( "Switch (resume and yield):  %10.1f ns\n", switchTime.count() / aCount );
+
+    // Starts: aCount coroutines run to completion; their stacks come from the pool
+    start = CLOCK::now();
+
+    for( int i = 0; i < aCount; i++ )
+    {
+        MyCoroutine cofunc;
+        cofunc.SetEntry( []( int aArg ) { return aArg; } );
+        cofunc.Call( i );
+    }
+
+    std::chrono::duration<double, std::nano> startTime = CLOCK::now() - start;
+
+    printf( "Coroutine start and finish: %10.1f ns\n", startTime.count() / aCount );
+
+    // Transitions: 100 idle tools, each waiting for 10 actions, receiving motion events
+    const int                    toolCount = 100;
+    std::vector<TOOL_EVENT_LIST> transitions( toolCount );
+    std::vector<int>             categories( toolCount, 0 );
+
+    for( int tool = 0; tool < toolCount; tool++ )
+    {
+        for( int action = 0; action < 10; action++ )
+        {
+            TOOL_EVENT evt( TC_COMMAND, TA_ACTION,
+                            "common.Benchmark.action" + std::to_string( tool * 10 + action ) );
+            transitions[tool].Add( evt );
+            categories[tool] |= evt.Category();
+        }
+    }
+
+    TOOL_EVENT motion( TC_MOUSE, TA_MOUSE_MOTION, 0 );
+    int        matches = 0;
+
+    start = CLOCK::now();
+
+    for( int i = 0; i < aCount; i++ )
+    {
+        for( const TOOL_EVENT_LIST& list : transitions )
+            matches += list.Matches( motion ) ? 1 : 0;
+    }
+
+    std::chrono::duration<double, std::nano> matchTime = CLOCK::now() - start;
+
+    start = CLOCK::now();
+
+    for( int i = 0; i < aCount; i++ )
+    {
+        for( int tool = 0; tool < toolCount; tool++ )
+        {
+            if( categories[tool] & motion.Category() )
+                matches += transitions[tool].Matches( motion ) ? 1 : 0;
+        }
+    }
+
+    std::chrono::duration<double, std::nano> maskTime = CLOCK::now() - start;
+
+    printf( "Transitions of %d tools:    %10.1f ns, %.1f ns with the category mask (%d)\n",
+            toolCount, matchTime.count() / aCount, maskTime.count() / aCount, matches );
+}
+
+
 static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
     {
             wxCMD_LINE_SWITCH,
@@ -100,6 +199,14 @@ static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
             wxCMD_LINE_VAL_NUMBER,
             wxCMD_LINE_PARAM_OPTIONAL,
     },
+    {
+            wxCMD_LINE_SWITCH,
+            "b",
+            "benchmark",
+            _( "time the coroutine switches and the event dispatch, counting iterations" ).mb_str(),
+            wxCMD_LINE_VAL_NONE,
+            wxCMD_LINE_PARAM_OPTIONAL,
+    },
     { wxCMD_LINE_NONE }
 };
 
@@ -117,9 +224,16 @@ static int coroutine_main_func( int argc, char** argv )
         return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
     }
 
-    long count = 5;
+    bool benchmark = cl_parser.Found( "benchmark" );
+    long count = benchmark ? 100000 : 5;
     cl_parser.Found( "count", &count );
 
+    if( benchmark )
+    {
+        runBenchmark( std::max( 1, (int) count ) );
+        return KI_TEST::RET_CODES::OK;
+    }
+
     CoroutineExample obj( (int) count );
 
     obj.Run();
@@ -0,0 +1,181 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "edge_kernels_benchmark.h"
+
+#include <geometry/edge_kernels.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+using CLOCK = std::chrono::steady_clock;
+
+
+/**
+ * A kernel under test: returns a value depending on the result of each query, so that
+ * the work is not optimised away, and to check that both versions agree.
+ */
+using KERNEL = std::function<long long( const std::vector<VECTOR2I>&, const VECTOR2I& )>;
+
+
+struct BENCHMARK
+{
+    const char* name;
+    KERNEL      vectorized;
+    KERNEL      scalar;
+};
+
+
+static std::vector<BENCHMARK> benchmarkList =
+{
+    {
+        "point inside (ray crossings)",
+        []( const std::vector<VECTOR2I>& aPts, const VECTOR2I& aP ) -> long long
+        {
+            return EDGE_KERNELS::OddRayCrossings( aPts.data(), aPts.size(), aP );
+        },
+        []( const std::vector<VECTOR2I>& aPts, const VECTOR2I& aP ) -> long long
+        {
+            return EDGE_KERNELS::OddRayCrossingsScalar( aPts.data(), aPts.size(), aP );
+        },
+    },
+    {
+        "distance to point",
+        []( const std::vector<VECTOR2I>& aPts, const VECTOR2I& aP ) -> long long
+        {
+            return EDGE_KERNELS::MinDistance( aPts.data(), aPts.size(), aPts.size(), aP );
+        },
+        []( const std::vector<VECTOR2I>& aPts, const VECTOR2I& aP ) -> long long
+        {
+            return EDGE_KERNELS::MinDistanceScalar( aPts.data(), aPts.size(), aPts.size(), aP );
+        },
+    },
+};
+
+
+/**
+ * A closed star shaped outline of aCount points, like a zone outline with many concave
+ * corners.
+ */
+static std::vector<VECTOR2I> makeOutline( int aCount, std::mt19937& aRng )
+{
+    std::uniform_int_distribution<int> radius( 2000000, 10000000 );
+    std::vector<VECTOR2I>              points;
+
+    for( int ii = 0; ii < aCount; ++ii )
+    {
+        double angle = 2 * M_PI * ii / aCount;
+        int    r = radius( aRng );
+
+        points.emplace_back( r * cos( angle ), r * sin( angle ) );
+    }
+
+    return points;
+}
+
+
+/**
+ * Runs aKernel on all the queries aReps times.
+ * @return the duration in ms, and the sum of the results in aAcc
+ */
+static double runKernel( const KERNEL& aKernel, const std::vector<VECTOR2I>& aPoints,
+                         const std::vector<VECTOR2I>& aQueries, int aReps, long long& aAcc )
+{
+    aAcc = 0;
+    auto start = CLOCK::now();
+
+    for( int rep = 0; rep < aReps; ++rep )
+    {
+        for( const VECTOR2I& p : aQueries )
+            aAcc += aKernel( aPoints, p );
+    }
+
+    std::chrono::duration<double, std::milli> dur = CLOCK::now() - start;
+    return dur.count();
+}
+
+
+int edge_kernels_benchmark_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 3 )
+    {
+        os << "Usage: " << argv[0] << " <POINTS> <REPS>\n\n";
+        os << "Times the edge kernels against their scalar versions, for 1000 queries on an\n";
+        os << "outline of <POINTS> points, repeated <REPS> times.\n";
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    int count = std::atoi( argv[1] );
+    int reps = std::atoi( argv[2] );
+
+    if( count < 3 || reps < 1 )
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    std::mt19937                       rng( 1 );
+    std::uniform_int_distribution<int> coord( -12000000, 12000000 );
+    std::vector<VECTOR2I>              points = makeOutline( count, rng );
+    std::vector<VECTOR2I>              queries;
+
+    for( int ii = 0; ii < 1000; ++ii )
+        queries.emplace_back( coord( rng ), coord( rng ) );
+
+    os << "Edge kernels benchmark (" << EDGE_KERNELS::InstructionSet() << ")" << std::endl;
+    os << "  Points:      " << count << std::endl;
+    os << "  Repetitions: " << reps << std::endl;
+    os << std::endl;
+
+    for( const BENCHMARK& bmark : benchmarkList )
+    {
+        long long accVector, accScalar;
+        double    msVector = runKernel( bmark.vectorized, points, queries, reps, accVector );
+        double    msScalar = runKernel( bmark.scalar, points, queries, reps, accScalar );
+
+        os << std::left << std::setw( 30 ) << bmark.name << std::right << std::fixed
+           << std::setprecision( 1 ) << std::setw( 10 ) << msScalar << " ms scalar, "
+           << std::setw( 10 ) << msVector << " ms, x" << std::setprecision( 2 )
+           << msScalar / std::max( msVector, 1e-3 )
+           << ( accVector == accScalar ? "" : "  RESULTS DIFFER" ) << std::endl;
+
+        if( accVector != accScalar )
+            return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+KI_TEST::UTILITY_PROGRAM edge_kernels_benchmark_tool = {
+    "edge_kernels_benchmark",
+    "Benchmark the vectorized point in polygon and distance kernels",
+    edge_kernels_benchmark_func,
+};
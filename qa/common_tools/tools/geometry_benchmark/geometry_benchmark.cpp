@@ -0,0 +1,421 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "geometry_benchmark.h"
+
+#include <convert_basic_shapes_to_polygon.h>
+#include <geometry/shape_circle.h>
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+#include <geometry/shape_segment.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+
+using CLOCK = std::chrono::steady_clock;
+
+
+/**
+ * The inputs of the benchmarks, shaped like a zone fill: a zone outline, the knockouts of
+ * the items inside it, and the fill of the zone.
+ */
+struct GEOMETRY_INPUTS
+{
+    SHAPE_POLY_SET m_outline;
+    SHAPE_POLY_SET m_knockouts;
+    SHAPE_POLY_SET m_fill;       ///< m_outline - m_knockouts, with holes
+    SHAPE_POLY_SET m_fractured;  ///< m_fill, fractured
+
+    std::vector<SHAPE_CIRCLE>  m_vias;
+    std::vector<SHAPE_SEGMENT> m_tracks;
+};
+
+
+/**
+ * A benchmark: returns a value depending on its result, so that the work is not optimised
+ * away, and to catch the changes of results along with the changes of timings.
+ */
+struct BENCHMARK
+{
+    const char*                                        name;
+    std::function<long long( const GEOMETRY_INPUTS& )> func;
+};
+
+
+static long long vertexCount( const SHAPE_POLY_SET& aSet )
+{
+    return aSet.TotalVertices();
+}
+
+
+static long long holeCount( const SHAPE_POLY_SET& aSet )
+{
+    long long count = 0;
+
+    for( int ii = 0; ii < aSet.OutlineCount(); ++ii )
+        count += aSet.HoleCount( ii );
+
+    return count;
+}
+
+
+static std::vector<BENCHMARK> benchmarkList =
+{
+    {
+        "boolean_add",
+        []( const GEOMETRY_INPUTS& aIn ) -> long long
+        {
+            SHAPE_POLY_SET merged;
+            merged.BooleanAdd( aIn.m_knockouts, aIn.m_outline, SHAPE_POLY_SET::PM_FAST );
+            return vertexCount( merged );
+        },
+    },
+    {
+        "boolean_subtract",
+        []( const GEOMETRY_INPUTS& aIn ) -> long long
+        {
+            SHAPE_POLY_SET fill;
+            fill.BooleanSubtract( aIn.m_outline, aIn.m_knockouts, SHAPE_POLY_SET::PM_FAST );
+            return holeCount( fill );
+        },
+    },
+    {
+        "simplify",
+        []( const GEOMETRY_INPUTS& aIn ) -> long long
+        {
+            SHAPE_POLY_SET knockouts( aIn.m_knockouts );
+            knockouts.Simplify( SHAPE_POLY_SET::PM_FAST );
+            return knockouts.OutlineCount();
+        },
+    },
+    {
+        "boolean_intersection",
+        []( const GEOMETRY_INPUTS& aIn ) -> long long
+        {
+            SHAPE_POLY_SET common;
+            common.BooleanIntersection( aIn.m_outline, aIn.m_knockouts,
+                                        SHAPE_POLY_SET::PM_FAST );
+            return vertexCount( common );
+        },
+    },
+    {
+        "fracture",
+        []( const GEOMETRY_INPUTS& aIn ) -> long long
+        {
+            SHAPE_POLY_SET fill( aIn.m_fill );
+            fill.Fracture( SHAPE_POLY_SET::PM_FAST );
+            return vertexCount( fill );
+        },
+    },
+    {
+        "unfracture",
+        []( const GEOMETRY_INPUTS& aIn ) -> long long
+        {
+            SHAPE_POLY_SET fill( aIn.m_fractured );
+            fill.Unfracture( SHAPE_POLY_SET::PM_FAST );
+            return holeCount( fill );
+        },
+    },
+    {
+        "inflate",
+        []( const GEOMETRY_INPUTS& aIn ) -> long long
+        {
+            SHAPE_POLY_SET fill( aIn.m_fill );
+            fill.Inflate( 100000, 16 );
+            return vertexCount( fill );
+        },
+    },
+    {
+        "deflate",
+        []( const GEOMETRY_INPUTS& aIn ) -> long long
+        {
+            SHAPE_POLY_SET fill( aIn.m_fill );
+            fill.Deflate( 50000, 16 );
+            return vertexCount( fill );
+        },
+    },
+    {
+        "cache_triangulation",
+        []( const GEOMETRY_INPUTS& aIn ) -> long long
+        {
+            SHAPE_POLY_SET fill( aIn.m_fractured, true );
+            fill.CacheTriangulation();
+
+            long long count = 0;
+
+            for( unsigned int ii = 0; ii < fill.TriangulatedPolyCount(); ++ii )
+                count += fill.TriangulatedPolygon( ii )->GetTriangleCount();
+
+            return count;
+        },
+    },
+    {
+        "chain_intersect",
+        []( const GEOMETRY_INPUTS& aIn ) -> long long
+        {
+            // A zig-zag crossing the fill, like a long track
+            BOX2I            bbox = aIn.m_outline.BBox();
+            SHAPE_LINE_CHAIN zigzag;
+
+            for( int ii = 0; ii <= 100; ++ii )
+            {
+                zigzag.Append( bbox.GetX() + bbox.GetWidth() * (long long) ii / 100,
+                               ii % 2 ? bbox.GetY() : bbox.GetBottom() );
+            }
+
+            long long count = 0;
+
+            for( int ii = 0; ii < aIn.m_fractured.OutlineCount(); ++ii )
+            {
+                SHAPE_LINE_CHAIN::INTERSECTIONS intersections;
+                count += aIn.m_fractured.COutline( ii ).Intersect( zigzag, intersections );
+            }
+
+            return count;
+        },
+    },
+    {
+        "point_inside",
+        []( const GEOMETRY_INPUTS& aIn ) -> long long
+        {
+            BOX2I     bbox = aIn.m_outline.BBox();
+            long long count = 0;
+
+            for( int ii = 0; ii < 100; ++ii )
+            {
+                for( int jj = 0; jj < 100; ++jj )
+                {
+                    VECTOR2I p( bbox.GetX() + bbox.GetWidth() * (long long) ii / 100,
+                                bbox.GetY() + bbox.GetHeight() * (long long) jj / 100 );
+
+                    count += aIn.m_fill.Contains( p );
+                }
+            }
+
+            return count;
+        },
+    },
+    {
+        "shape_collide",
+        []( const GEOMETRY_INPUTS& aIn ) -> long long
+        {
+            long long count = 0;
+
+            for( const SHAPE& track : aIn.m_tracks )
+            {
+                for( const SHAPE_CIRCLE& via : aIn.m_vias )
+                    count += track.Collide( &via, 200000 );
+
+                for( const SHAPE_SEGMENT& other : aIn.m_tracks )
+                    count += track.Collide( &other, 200000 );
+            }
+
+            return count;
+        },
+    },
+};
+
+
+/**
+ * Builds inputs like the fill of a 100 x 80 mm zone around a BGA: a field of vias, the
+ * tracks fanning out of it, and columns of SMD pads.  Most knockouts are separate holes
+ * in the fill.
+ */
+static void buildBoardInputs( GEOMETRY_INPUTS& aIn )
+{
+    const int mm = 1000000;
+    const int clearance = mm / 5;
+    const int maxError = 5000;
+
+    aIn.m_outline.NewOutline();
+    aIn.m_outline.Append( 0, 0 );
+    aIn.m_outline.Append( 100 * mm, 0 );
+    aIn.m_outline.Append( 100 * mm, 80 * mm );
+    aIn.m_outline.Append( 0, 80 * mm );
+
+    // A 40 x 40 via field, with a 1 mm pitch
+    for( int ii = 0; ii < 40; ++ii )
+    {
+        for( int jj = 0; jj < 40; ++jj )
+        {
+            wxPoint center( 30 * mm + ii * mm, 20 * mm + jj * mm );
+
+            aIn.m_vias.emplace_back( VECTOR2I( center.x, center.y ), mm / 5 );
+            TransformCircleToPolygon( aIn.m_knockouts, center, mm / 5 + clearance, maxError );
+        }
+    }
+
+    // The tracks leaving the first and last rows of the field
+    for( int ii = 0; ii < 80; ++ii )
+    {
+        bool    top = ii < 40;
+        wxPoint start( 30 * mm + ( ii % 40 ) * mm, top ? 20 * mm : 59 * mm );
+        wxPoint end( 5 * mm + ( ii % 40 ) * 7 * mm / 4, top ? 3 * mm : 77 * mm );
+
+        aIn.m_tracks.emplace_back( VECTOR2I( start.x, start.y ), VECTOR2I( end.x, end.y ),
+                                   mm / 4 );
+        TransformOvalClearanceToPolygon( aIn.m_knockouts, start, end, mm / 4 + 2 * clearance,
+                                         maxError );
+    }
+
+    // Four columns of round rect pads, with a 0.8 mm pitch
+    for( int ii = 0; ii < 300; ++ii )
+    {
+        wxPoint pos( 80 * mm + ( ii / 75 ) * 5 * mm, 10 * mm + ( ii % 75 ) * 4 * mm / 5 );
+
+        TransformRoundChamferedRectToPolygon( aIn.m_knockouts, pos,
+                                              wxSize( mm + 2 * clearance, 3 * mm / 10 + 2 * clearance ),
+                                              0.0, mm / 16 + clearance, 0.0, 0, maxError );
+    }
+}
+
+
+/**
+ * Reads the inputs from aFile, holding polygon sets in the SHAPE_POLY_SET::Format() format:
+ * the first set is the outline and the second one the knockouts.  Without knockouts, the
+ * outline shifted by 1% of its size is used.
+ * @return false if there is no polygon set in the file
+ */
+static bool readInputs( const std::string& aFile, GEOMETRY_INPUTS& aIn )
+{
+    std::ifstream     file( aFile );
+    std::stringstream buffer;
+
+    buffer << file.rdbuf();
+
+    // Skip the shape headers written by SHAPE_FILE_IO
+    std::string                 content = buffer.str();
+    size_t                      pos = content.find( "polyset" );
+    std::vector<SHAPE_POLY_SET> sets;
+
+    while( pos != std::string::npos && sets.size() < 2 )
+    {
+        std::stringstream stream( content.substr( pos ) );
+
+        sets.emplace_back();
+
+        if( !sets.back().Parse( stream ) )
+            return false;
+
+        pos = content.find( "polyset", pos + 1 );
+    }
+
+    if( sets.empty() )
+        return false;
+
+    aIn.m_outline = sets[0];
+
+    if( sets.size() > 1 )
+    {
+        aIn.m_knockouts = sets[1];
+    }
+    else
+    {
+        aIn.m_knockouts = sets[0];
+        aIn.m_knockouts.Move( VECTOR2I( aIn.m_outline.BBox().GetWidth() / 100,
+                                        aIn.m_outline.BBox().GetHeight() / 100 ) );
+    }
+
+    return true;
+}
+
+
+int geometry_benchmark_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 2 )
+    {
+        os << "Usage: " << argv[0] << " <REPS> [FILE]\n\n";
+        os << "Times the geometry operations used by the zone fills, plots and DRC, on the\n";
+        os << "fill of a zone around a BGA, or on the polygon sets of FILE (outline and\n";
+        os << "knockouts, in the SHAPE_POLY_SET::Format() format).\n\n";
+        os << "Prints one line per operation: name, repetitions, ms per repetition and a\n";
+        os << "value depending on the result, which must not change between runs.\n\n";
+        os << "Operations:\n";
+
+        for( const BENCHMARK& bmark : benchmarkList )
+            os << "  " << bmark.name << "\n";
+
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    int             reps = std::atoi( argv[1] );
+    GEOMETRY_INPUTS inputs;
+
+    if( reps < 1 )
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    if( argc > 2 )
+    {
+        if( !readInputs( argv[2], inputs ) )
+        {
+            std::cerr << "No polygon set read from " << argv[2] << std::endl;
+            return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+        }
+    }
+    else
+    {
+        buildBoardInputs( inputs );
+    }
+
+    inputs.m_fill.BooleanSubtract( inputs.m_outline, inputs.m_knockouts,
+                                   SHAPE_POLY_SET::PM_FAST );
+    inputs.m_fractured = inputs.m_fill;
+    inputs.m_fractured.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+    os << "# geometry benchmark: " << vertexCount( inputs.m_fill ) << " vertices, "
+       << holeCount( inputs.m_fill ) << " holes" << std::endl;
+    os << "# name reps ms_per_rep result" << std::endl;
+
+    for( const BENCHMARK& bmark : benchmarkList )
+    {
+        long long result = 0;
+        auto      start = CLOCK::now();
+
+        for( int rep = 0; rep < reps; ++rep )
+            result = bmark.func( inputs );
+
+        std::chrono::duration<double, std::milli> dur = CLOCK::now() - start;
+
+        os << std::left << std::setw( 24 ) << bmark.name << std::right << std::setw( 6 )
+           << reps << std::fixed << std::setprecision( 3 ) << std::setw( 14 )
+           << dur.count() / reps << std::setw( 14 ) << result << std::endl;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+KI_TEST::UTILITY_PROGRAM geometry_benchmark_tool = {
+    "geometry_benchmark",
+    "Benchmark the polygon and shape operations of the geometry library",
+    geometry_benchmark_func,
+};
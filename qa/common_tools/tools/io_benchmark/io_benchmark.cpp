@@ -313,6 +313,8 @@ static std::vector<BENCHMARK> benchmarkList =
     { 'F', bench_fstream_reuse, "std::fstream, reused" },
     { 'r', bench_line_reader<FILE_LINE_READER>, "RichIO FILE_L_R" },
     { 'R', bench_line_reader_reuse<FILE_LINE_READER>, "RichIO FILE_L_R, reused" },
+    { 'a', bench_line_reader<WHOLE_FILE_LINE_READER>, "RichIO WHOLE_FILE_L_R" },
+    { 'A', bench_line_reader_reuse<WHOLE_FILE_LINE_READER>, "RichIO WHOLE_FILE_L_R, reused" },
     { 'n', bench_line_reader<IFSTREAM_LINE_READER>, "std::ifstream L_R" },
     { 'N', bench_line_reader_reuse<IFSTREAM_LINE_READER>, "std::ifstream L_R, reused" },
     { 's', bench_string_lr, "RichIO STRING_L_R"},
@@ -0,0 +1,134 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the symbol libraries of SCH_LEGACY_PLUGIN
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <sch_legacy_plugin.h>
+
+#include <class_libentry.h>
+#include <lib_pin.h>
+#include <properties.h>
+#include <symbol_lib_table.h>
+
+#include "eeschema_test_utils.h"
+
+
+/**
+ * Get a symbol library file from the test data legacy_libs subdir
+ */
+static wxString getLegacyTestLibrary( const wxString& aLibFile )
+{
+    wxFileName fn = KI_TEST::GetEeschemaTestDataDir();
+    fn.AppendDir( "legacy_libs" );
+    fn.SetFullName( aLibFile );
+
+    return fn.GetFullPath();
+}
+
+
+static size_t pinCount( LIB_PART* aPart )
+{
+    LIB_PINS pins;
+    aPart->GetPins( pins );
+
+    return pins.size();
+}
+
+
+BOOST_AUTO_TEST_SUITE( SchLegacyPlugin )
+
+
+/**
+ * Check that the symbol headers can be enumerated without the symbol bodies, and that the
+ * bodies are loaded when the symbols are requested
+ */
+BOOST_AUTO_TEST_CASE( HeadersOnly )
+{
+    SCH_LEGACY_PLUGIN       plugin;
+    const wxString          libPath = getLegacyTestLibrary( "lazy_symbols.lib" );
+    PROPERTIES              props;
+    std::vector<LIB_ALIAS*> aliases;
+
+    props[ SYMBOL_LIB_TABLE::PropHeadersOnly ] = "";
+
+    plugin.EnumerateSymbolLib( aliases, libPath, &props );
+
+    BOOST_REQUIRE_EQUAL( aliases.size(), 3 );
+
+    for( LIB_ALIAS* alias : aliases )
+    {
+        BOOST_CHECK_EQUAL( pinCount( alias->GetPart() ), 0 );
+        BOOST_CHECK_EQUAL( alias->GetPart()->GetFootprints().GetCount(), 0 );
+    }
+
+    LIB_ALIAS* capacitor = plugin.LoadSymbol( libPath, "C_Small" );
+
+    BOOST_REQUIRE( capacitor );
+    BOOST_CHECK( !capacitor->IsRoot() );
+    BOOST_CHECK_EQUAL( capacitor->GetPart()->GetName(), "C" );
+    BOOST_CHECK_EQUAL( pinCount( capacitor->GetPart() ), 2 );
+    BOOST_CHECK_EQUAL( capacitor->GetPart()->GetFootprints().GetCount(), 1 );
+
+    // The other symbol is left alone
+    LIB_ALIAS* resistor = nullptr;
+
+    for( LIB_ALIAS* alias : aliases )
+    {
+        if( alias->GetName() == "R" )
+            resistor = alias;
+    }
+
+    BOOST_REQUIRE( resistor );
+    BOOST_CHECK_EQUAL( pinCount( resistor->GetPart() ), 0 );
+    BOOST_CHECK_EQUAL( resistor->GetPart()->GetValueField().GetText(), "R" );
+}
+
+
+/**
+ * Check that the symbols are complete when the headers only are not requested
+ */
+BOOST_AUTO_TEST_CASE( CompleteSymbols )
+{
+    SCH_LEGACY_PLUGIN       plugin;
+    const wxString          libPath = getLegacyTestLibrary( "lazy_symbols.lib" );
+    std::vector<LIB_ALIAS*> aliases;
+
+    plugin.EnumerateSymbolLib( aliases, libPath );
+
+    BOOST_REQUIRE_EQUAL( aliases.size(), 3 );
+
+    for( LIB_ALIAS* alias : aliases )
+    {
+        BOOST_CHECK_EQUAL( pinCount( alias->GetPart() ), 2 );
+        BOOST_CHECK_EQUAL( alias->GetPart()->GetFootprints().GetCount(), 1 );
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,116 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the position queries of SCH_SCREEN
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <sch_screen.h>
+
+#include <sch_junction.h>
+#include <sch_line.h>
+
+
+class TEST_SCH_SCREEN_FIXTURE
+{
+public:
+    TEST_SCH_SCREEN_FIXTURE() : m_screen( nullptr )
+    {
+        // A grid of wires, with a junction at each crossing
+        for( int ii = 0; ii < 10; ++ii )
+        {
+            SCH_LINE* horizontal = new SCH_LINE( wxPoint( 0, ii * 100 ), LAYER_WIRE );
+            horizontal->SetEndPoint( wxPoint( 900, ii * 100 ) );
+            m_screen.Append( horizontal );
+
+            SCH_LINE* vertical = new SCH_LINE( wxPoint( ii * 100, 0 ), LAYER_WIRE );
+            vertical->SetEndPoint( wxPoint( ii * 100, 900 ) );
+            m_screen.Append( vertical );
+        }
+
+        for( int ii = 0; ii < 10; ++ii )
+        {
+            for( int jj = 0; jj < 10; ++jj )
+                m_screen.Append( new SCH_JUNCTION( wxPoint( ii * 100, jj * 100 ) ) );
+        }
+    }
+
+    SCH_SCREEN m_screen;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( SchScreen, TEST_SCH_SCREEN_FIXTURE )
+
+
+/**
+ * Check the indexed queries give the items of the draw list walk
+ */
+BOOST_AUTO_TEST_CASE( IndexedQueries )
+{
+    std::vector<wxPoint> points = { { 0, 0 }, { 100, 100 }, { 450, 300 }, { 900, 900 },
+                                    { 950, 950 }, { 302, 500 }, { 50, 50 } };
+
+    for( const wxPoint& point : points )
+    {
+        BOOST_TEST_CONTEXT( "Point " << point.x << ", " << point.y )
+        {
+            SCH_ITEM* item = m_screen.GetItem( point );
+            SCH_LINE* wire = m_screen.GetWire( point );
+            int       count = m_screen.CountConnectedItems( point, true );
+            bool      junction = m_screen.IsJunctionNeeded( point );
+
+            SCH_SCREEN_INDEXED_QUERIES indexedQueries( &m_screen );
+
+            BOOST_CHECK_EQUAL( m_screen.GetItem( point ), item );
+            BOOST_CHECK_EQUAL( m_screen.GetWire( point ), wire );
+            BOOST_CHECK_EQUAL( m_screen.CountConnectedItems( point, true ), count );
+            BOOST_CHECK_EQUAL( m_screen.IsJunctionNeeded( point ), junction );
+        }
+    }
+}
+
+
+/**
+ * Check the index follows the items appended and removed through the screen
+ */
+BOOST_AUTO_TEST_CASE( IndexedChanges )
+{
+    SCH_SCREEN_INDEXED_QUERIES indexedQueries( &m_screen );
+
+    wxPoint   point( 1500, 1500 );
+    SCH_ITEM* junction = new SCH_JUNCTION( point );
+
+    BOOST_CHECK( m_screen.GetItem( point ) == nullptr );
+
+    m_screen.Append( junction );
+    BOOST_CHECK_EQUAL( m_screen.GetItem( point ), junction );
+
+    m_screen.DeleteItem( junction );
+    BOOST_CHECK( m_screen.GetItem( point ) == nullptr );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
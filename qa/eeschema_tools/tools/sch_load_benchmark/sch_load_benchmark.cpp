@@ -0,0 +1,212 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "sch_load_benchmark.h"
+
+#include <qa_utils/benchmark_utils.h>
+
+#include <common.h>
+#include <kiway.h>
+#include <pgm_base.h>
+#include <project.h>
+
+#include <connection_graph.h>
+#include <erc.h>
+#include <erc_settings.h>
+#include <general.h>
+#include <sch_io_mgr.h>
+#include <sch_screen.h>
+#include <sch_sheet.h>
+#include <sch_sheet_path.h>
+#include <symbol_lib_table.h>
+#include <wildcards_and_files_ext.h>
+
+#include <wx/filename.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+using CLOCK = std::chrono::steady_clock;
+
+
+int sch_load_benchmark_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 2 )
+    {
+        os << "Usage: " << argv[0] << " <SCHEMATIC> [REPS]\n\n";
+        os << "Loads the root schematic SCHEMATIC of a project the way Eeschema does, and\n";
+        os << "times each phase: loading the sheets, resolving the symbol links, building\n";
+        os << "the connection graph and running its ERC.  The project symbol library table\n";
+        os << "is read from the directory of SCHEMATIC.\n\n";
+        os << "Prints a JSON report with the time and the peak memory after each phase, for\n";
+        os << "each of the REPS loads (1 by default).\n";
+
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    int reps = argc > 2 ? std::atoi( argv[2] ) : 1;
+
+    if( reps < 1 )
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    wxFileName fn( wxString::FromUTF8( argv[1] ) );
+    fn.MakeAbsolute();
+
+    if( !fn.FileExists() )
+    {
+        std::cerr << "Cannot read " << argv[1] << std::endl;
+        return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+    }
+
+    wxFileName pro = fn;
+    pro.SetExt( ProjectFileExtension );
+
+    KIWAY kiway( &Pgm(), KFCTL_STANDALONE );
+
+    // Sets the project path used to find the project symbol library table.
+    kiway.Prj().SetProjectFullName( pro.GetFullPath() );
+
+    ERC_SETTINGS ercSettings;
+    ercSettings.LoadDefaults();
+
+    struct PHASE
+    {
+        const char*                 name;
+        std::function<long long()>  func;   ///< returns the number of items handled
+    };
+
+    SCH_PLUGIN::SCH_PLUGIN_RELEASER pi( SCH_IO_MGR::FindPlugin( SCH_IO_MGR::SCH_LEGACY ) );
+    std::unique_ptr<CONNECTION_GRAPH> graph;
+
+    const std::vector<PHASE> phases = {
+        { "load", [&]() -> long long
+            {
+                g_RootSheet = pi->Load( fn.GetFullPath(), &kiway );
+
+                g_CurrentSheet = new SCH_SHEET_PATH();
+                g_CurrentSheet->push_back( g_RootSheet );
+
+                return SCH_SHEET_LIST( g_RootSheet ).size();
+            } },
+        { "symbol_links", [&]() -> long long
+            {
+                // The libraries are loaded here, as SCH_EDIT_FRAME::OpenProjectFiles() does.
+                kiway.Prj().SchLibs();
+                kiway.Prj().SchSymbolLibTable();
+
+                SCH_SCREENS screens;
+                screens.UpdateSymbolLinks();
+
+                return screens.GetCount();
+            } },
+        { "connectivity", [&]() -> long long
+            {
+                graph.reset( new CONNECTION_GRAPH( nullptr ) );
+                g_ConnectionGraph = graph.get();
+
+                SCH_SHEET_LIST sheets( g_RootSheet );
+                graph->Recalculate( sheets, true );
+
+                return sheets.size();
+            } },
+        { "erc", [&]() -> long long
+            {
+                int errors = TestDuplicateSheetNames( false );
+
+                errors += TestConflictingBusAliases( false );
+                errors += graph->RunERC( ercSettings, false );
+
+                return errors;
+            } },
+    };
+
+    os << "{" << std::endl;
+    os << "  \"schematic\": \""
+       << KI_TEST::JsonEscape( std::string( fn.GetFullPath().ToUTF8() ) ) << "\"," << std::endl;
+    os << "  \"runs\": [" << std::endl;
+
+    for( int rep = 0; rep < reps; ++rep )
+    {
+        os << "    [" << std::endl;
+
+        for( size_t ii = 0; ii < phases.size(); ++ii )
+        {
+            const PHASE& phase = phases[ii];
+            long long    result = 0;
+            auto         start = CLOCK::now();
+
+            try
+            {
+                result = phase.func();
+            }
+            catch( const IO_ERROR& ioe )
+            {
+                std::cerr << ioe.What() << std::endl;
+                return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+            }
+
+            std::chrono::duration<double, std::milli> dur = CLOCK::now() - start;
+
+            os << "      { \"name\": \"" << phase.name << "\", "
+               << "\"time_ms\": " << dur.count() << ", "
+               << "\"peak_memory_kb\": " << KI_TEST::GetPeakMemoryKb() << ", "
+               << "\"result\": " << result << " }"
+               << ( ii + 1 < phases.size() ? "," : "" ) << std::endl;
+        }
+
+        os << "    ]" << ( rep + 1 < reps ? "," : "" ) << std::endl;
+
+        g_ConnectionGraph = nullptr;
+        graph.reset();
+
+        delete g_CurrentSheet;
+        g_CurrentSheet = nullptr;
+
+        delete g_RootSheet;
+        g_RootSheet = nullptr;
+
+        // Load the libraries again in the next run
+        kiway.Prj().SetElem( PROJECT::ELEM_SCH_PART_LIBS, NULL );
+        kiway.Prj().SetElem( PROJECT::ELEM_SYMBOL_LIB_TABLE, NULL );
+    }
+
+    os << "  ]" << std::endl;
+    os << "}" << std::endl;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+KI_TEST::UTILITY_PROGRAM sch_load_benchmark_tool = {
+    "sch_load_benchmark",
+    "Benchmark the loading, the connectivity and the ERC of a schematic",
+    sch_load_benchmark_func,
+};
@@ -0,0 +1,181 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "sym_lib_load_benchmark.h"
+
+#include <qa_utils/benchmark_utils.h>
+#include <qa_utils/lib_search_benchmark.h>
+
+#include <common.h>
+#include <class_libentry.h>
+#include <lib_tree_model.h>
+#include <symbol_async_loader.h>
+#include <symbol_lib_table.h>
+
+#include <wx/filename.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+using CLOCK = std::chrono::steady_clock;
+
+
+/**
+ * Load the symbols of the libraries aNicknames of aTable, as the symbol chooser does, and
+ * print the JSON object of the load named aName.
+ *
+ * @return the aliases of each library
+ */
+static std::vector<std::vector<LIB_ALIAS*>> timeLoad( std::ostream& aStream, const char* aName,
+                                                      SYMBOL_LIB_TABLE& aTable,
+                                                      const std::vector<wxString>& aNicknames,
+                                                      bool aLast )
+{
+    auto start = CLOCK::now();
+
+    SYMBOL_ASYNC_LOADER loader( aNicknames, &aTable );
+    loader.Start();
+
+    std::vector<std::vector<LIB_ALIAS*>> aliases = loader.Join();
+
+    std::chrono::duration<double, std::milli> dur = CLOCK::now() - start;
+    size_t count = 0;
+
+    for( const auto& lib : aliases )
+        count += lib.size();
+
+    aStream << "    { \"name\": \"" << aName << "\", "
+            << "\"time_ms\": " << dur.count() << ", "
+            << "\"symbols\": " << count << ", "
+            << "\"errors\": " << ( loader.GetErrors().IsEmpty() ? "false" : "true" ) << ", "
+            << "\"peak_memory_kb\": " << KI_TEST::GetPeakMemoryKb() << " }"
+            << ( aLast ? "" : "," ) << std::endl;
+
+    if( !loader.GetErrors().IsEmpty() )
+        std::cerr << loader.GetErrors() << std::endl;
+
+    return aliases;
+}
+
+
+int sym_lib_load_benchmark_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 2 )
+    {
+        os << "Usage: " << argv[0] << " <SYM_LIB_TABLE> [REPS] [SEARCHES]\n\n";
+        os << "Loads the symbols of all the libraries of the symbol library table\n";
+        os << "SYM_LIB_TABLE, as the symbol choosers do: a cold load filling the library\n";
+        os << "caches, then a warm load from the library caches.  The environment variables\n";
+        os << "used by the table (KICAD_SYMBOL_DIR...) must be set.\n\n";
+        os << "Then runs each chooser search REPS times (10 by default) on the symbols: the\n";
+        os << "lines of the file SEARCHES, or representative searches by default.\n\n";
+        os << "Prints a JSON report with the load times, the peak memory, the search index\n";
+        os << "build time and the search latency percentiles.\n";
+
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    int reps = argc > 2 ? std::atoi( argv[2] ) : 10;
+
+    if( reps < 1 )
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    std::vector<wxString> searches;
+
+    if( argc > 3 )
+    {
+        if( !KI_TEST::ReadLibSearches( wxString::FromUTF8( argv[3] ), searches ) )
+        {
+            std::cerr << "Cannot read " << argv[3] << std::endl;
+            return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+        }
+    }
+    else
+    {
+        searches = KI_TEST::GetDefaultLibSearches();
+    }
+
+    wxFileName fn( wxString::FromUTF8( argv[1] ) );
+    fn.MakeAbsolute();
+
+    SYMBOL_LIB_TABLE table;
+
+    try
+    {
+        table.Load( fn.GetFullPath() );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        std::cerr << ioe.What() << std::endl;
+        return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+    }
+
+    std::vector<wxString> nicknames = table.GetLogicalLibs();
+
+    os << "{" << std::endl;
+    os << "  \"sym_lib_table\": \""
+       << KI_TEST::JsonEscape( std::string( fn.GetFullPath().ToUTF8() ) ) << "\"," << std::endl;
+    os << "  \"libraries\": " << nicknames.size() << "," << std::endl;
+    os << "  \"loads\": [" << std::endl;
+
+    // The warm load finds the libraries in the caches of the plugins of the table
+    timeLoad( os, "cold", table, nicknames, false );
+    std::vector<std::vector<LIB_ALIAS*>> aliases = timeLoad( os, "warm", table, nicknames, true );
+
+    os << "  ]," << std::endl;
+
+    // Build the tree of the symbol chooser
+    LIB_TREE_NODE_ROOT tree;
+
+    for( size_t ii = 0; ii < nicknames.size(); ++ii )
+    {
+        LIB_TREE_NODE_LIB& lib = tree.AddLib( nicknames[ii], wxEmptyString );
+
+        for( LIB_ALIAS* alias : aliases[ii] )
+            lib.AddItem( alias );
+
+        lib.AssignIntrinsicRanks();
+    }
+
+    tree.AssignIntrinsicRanks();
+
+    os << "  \"search\": {" << std::endl;
+    KI_TEST::PrintLibSearchBenchmark( os, tree, searches, reps, "    " );
+    os << "  }" << std::endl;
+    os << "}" << std::endl;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+KI_TEST::UTILITY_PROGRAM sym_lib_load_benchmark_tool = {
+    "sym_lib_load_benchmark",
+    "Benchmark the loading of the symbol libraries of a table, and the chooser searches",
+    sym_lib_load_benchmark_func,
+};
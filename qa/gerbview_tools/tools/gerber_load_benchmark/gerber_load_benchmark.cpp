@@ -0,0 +1,172 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "gerber_load_benchmark.h"
+
+#include <gerber_file_image.h>
+#include <gerber_line_reader.h>
+
+#include <wx/dir.h>
+#include <wx/filename.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+using CLOCK = std::chrono::steady_clock;
+
+
+/**
+ * @return the Gerber files given on the command line: the files themselves, and the
+ * .gbr files of the directories, sorted by name.
+ */
+static std::vector<wxString> gerberFiles( int argc, char* argv[] )
+{
+    std::vector<wxString> files;
+
+    for( int ii = 0; ii < argc; ++ii )
+    {
+        wxString path = wxString::FromUTF8( argv[ii] );
+
+        if( wxFileName::DirExists( path ) )
+        {
+            wxArrayString dirFiles;
+
+            wxDir::GetAllFiles( path, &dirFiles, wxT( "*.gbr" ), wxDIR_FILES );
+            dirFiles.Sort();
+
+            for( const wxString& file : dirFiles )
+                files.push_back( file );
+        }
+        else
+        {
+            files.push_back( path );
+        }
+    }
+
+    return files;
+}
+
+
+int gerber_load_benchmark_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 3 )
+    {
+        os << "Usage: " << argv[0] << " <REPS> <PATH>...\n\n";
+        os << "Times the reading and the parsing of the Gerber files PATH, or of the .gbr\n";
+        os << "files of the directories PATH, like gerbview/gerber_test_files.\n\n";
+        os << "Prints one line per benchmark: name, repetitions, ms per repetition and a\n";
+        os << "value depending on the result, which must not change between runs.\n";
+
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    int reps = std::atoi( argv[1] );
+
+    if( reps < 1 )
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    std::vector<wxString> files = gerberFiles( argc - 2, argv + 2 );
+
+    for( const wxString& file : files )
+    {
+        if( !wxFileName::FileExists( file ) )
+        {
+            std::cerr << "Cannot read " << file.ToUTF8() << std::endl;
+            return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+        }
+    }
+
+    struct BENCHMARK
+    {
+        const char*                 name;
+        std::function<long long()>  func;
+    };
+
+    const std::vector<BENCHMARK> benchmarks = {
+        { "read_lines", [&]() -> long long
+            {
+                long long lineCount = 0;
+
+                for( const wxString& file : files )
+                {
+                    GERBER_LINE_READER reader;
+
+                    reader.Open( file );
+
+                    while( reader.ReadLine() )
+                        ++lineCount;
+                }
+
+                return lineCount;
+            } },
+        { "load", [&]() -> long long
+            {
+                long long itemCount = 0;
+
+                for( const wxString& file : files )
+                {
+                    GERBER_FILE_IMAGE image( 0 );
+
+                    if( image.LoadGerberFile( file ) )
+                        itemCount += image.GetItems().GetCount();
+                }
+
+                return itemCount;
+            } },
+    };
+
+    os << "# gerber load benchmark: " << files.size() << " files" << std::endl;
+    os << "# name reps ms_per_rep count" << std::endl;
+
+    for( const BENCHMARK& bmark : benchmarks )
+    {
+        long long result = 0;
+        auto      start = CLOCK::now();
+
+        for( int rep = 0; rep < reps; ++rep )
+            result = bmark.func();
+
+        std::chrono::duration<double, std::milli> dur = CLOCK::now() - start;
+
+        os << std::left << std::setw( 24 ) << bmark.name << std::right << std::setw( 6 )
+           << reps << std::fixed << std::setprecision( 3 ) << std::setw( 14 )
+           << dur.count() / reps << std::setw( 14 ) << result << std::endl;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+KI_TEST::UTILITY_PROGRAM gerber_load_benchmark_tool = {
+    "gerber_load_benchmark",
+    "Benchmark the reading and the parsing of Gerber files",
+    gerber_load_benchmark_func,
+};
@@ -496,4 +496,43 @@ BOOST_AUTO_TEST_CASE( OverlapCases )
     }
 }
 
+
+/**
+ * The courtyard polygons are kept between DRC runs: check they follow a moved footprint
+ */
+BOOST_AUTO_TEST_CASE( OverlapAfterMove )
+{
+    const RECT_DEFINITION rect{ { 0, 0 }, { Millimeter2iu( 1 ), Millimeter2iu( 1 ) }, 0, true };
+
+    auto board = MakeBoard( {
+            { "U1", { rect }, { 0, 0 } },
+            { "U2", { rect }, { Millimeter2iu( 3 ), 0 } },
+    } );
+
+    board->SetDesignSettings( GetOverlapCheckDesignSettings() );
+
+    DRC_MARKER_FACTORY                       marker_factory;
+    std::vector<std::unique_ptr<MARKER_PCB>> markers;
+
+    DRC_COURTYARD_OVERLAP drc_overlap( marker_factory, [&]( MARKER_PCB* aMarker ) {
+        markers.push_back( std::unique_ptr<MARKER_PCB>( aMarker ) );
+    } );
+
+    drc_overlap.RunDRC( *board );
+    CheckCollisionsMatchExpected( *board, markers, {} );
+
+    // Move U2 onto U1
+    board->Modules().back()->SetPosition( wxPoint( Millimeter2iu( 0.5 ), 0 ) );
+
+    drc_overlap.RunDRC( *board );
+    CheckCollisionsMatchExpected( *board, markers, { { "U1", "U2" } } );
+
+    // And away again
+    markers.clear();
+    board->Modules().back()->SetPosition( wxPoint( Millimeter2iu( 3 ), 0 ) );
+
+    drc_overlap.RunDRC( *board );
+    CheckCollisionsMatchExpected( *board, markers, {} );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,139 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file test_board_clone_for_save.cpp
+ * Checks that the board copies of the background saves are saved as the board itself
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <macros.h>
+#include <class_board.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <netinfo.h>
+#include <kicad_plugin.h>
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+
+#include <wx/filename.h>
+
+
+struct BOARD_CLONE_FIXTURE
+{
+    BOARD_CLONE_FIXTURE() :
+        m_fileName( wxFileName::CreateTempFileName( wxT( "board" ) ) ),
+        m_copyFileName( wxFileName::CreateTempFileName( wxT( "copy" ) ) )
+    {
+        m_board.Add( new NETINFO_ITEM( &m_board, "GND", 1 ) );
+        m_board.Add( new NETINFO_ITEM( &m_board, "VCC", 2 ) );
+
+        NETCLASSPTR power = std::make_shared<NETCLASS>( "Power" );
+
+        power->SetTrackWidth( 500000 );
+        power->Add( "VCC" );
+        m_board.GetDesignSettings().m_NetClasses.Add( power );
+        m_board.SynchronizeNetsAndNetClasses();
+    }
+
+    ~BOARD_CLONE_FIXTURE()
+    {
+        wxRemoveFile( m_fileName );
+        wxRemoveFile( m_copyFileName );
+    }
+
+    static std::string readFile( const wxString& aFileName )
+    {
+        std::ifstream in( TO_UTF8( aFileName ), std::ios::binary );
+
+        return std::string( std::istreambuf_iterator<char>( in ),
+                            std::istreambuf_iterator<char>() );
+    }
+
+    BOARD    m_board;
+    wxString m_fileName;
+    wxString m_copyFileName;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( BoardCloneForSave, BOARD_CLONE_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( SameFile )
+{
+    TRACK* track = new TRACK( &m_board );
+
+    track->SetStart( wxPoint( 0, 0 ) );
+    track->SetEnd( wxPoint( 1000000, 0 ) );
+    track->SetWidth( 500000 );
+    track->SetLayer( F_Cu );
+    track->SetNetCode( 2 );
+    m_board.Add( track, ADD_APPEND );
+
+    ZONE_CONTAINER* zone = new ZONE_CONTAINER( &m_board );
+
+    zone->SetLayer( B_Cu );
+    zone->SetNetCode( 1 );
+    zone->Outline()->NewOutline();
+    zone->Outline()->Append( 0, 0 );
+    zone->Outline()->Append( 5000000, 0 );
+    zone->Outline()->Append( 5000000, 5000000 );
+    m_board.Add( zone );
+
+    std::unique_ptr<BOARD> copy( m_board.CloneForSave() );
+
+    BOOST_REQUIRE_EQUAL( copy->Tracks().size(), 1 );
+    BOOST_CHECK( copy->Tracks()[0] != track );
+    BOOST_CHECK( copy->Tracks()[0]->GetBoard() == copy.get() );
+    BOOST_CHECK( copy->Tracks()[0]->GetNet()->GetBoard() == copy.get() );
+    BOOST_CHECK( copy->GetArea( 0 )->GetNet()->GetBoard() == copy.get() );
+
+    PCB_IO io;
+
+    io.Save( m_fileName, &m_board );
+    io.Save( m_copyFileName, copy.get() );
+
+    BOOST_CHECK( readFile( m_fileName ) == readFile( m_copyFileName ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( NothingShared )
+{
+    std::unique_ptr<BOARD> copy( m_board.CloneForSave() );
+
+    NETCLASSES& netClasses = m_board.GetDesignSettings().m_NetClasses;
+
+    netClasses.Find( "Power" )->SetTrackWidth( 1000000 );
+    netClasses.GetDefault()->SetClearance( 1000000 );
+
+    NETCLASSES& copyNetClasses = copy->GetDesignSettings().m_NetClasses;
+
+    BOOST_CHECK_EQUAL( copyNetClasses.Find( "Power" )->GetTrackWidth(), 500000 );
+    BOOST_CHECK( copyNetClasses.GetDefault() != netClasses.GetDefault() );
+    BOOST_CHECK( copy->FindNet( "VCC" ) != nullptr );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
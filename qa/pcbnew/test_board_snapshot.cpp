@@ -0,0 +1,181 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file test_board_snapshot.cpp
+ * Checks that the board snapshots of the auto save files are read back as they were written
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <macros.h>
+#include <class_board.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <netinfo.h>
+#include <kicad_plugin.h>
+#include <kicad_snapshot_plugin.h>
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+
+#include <wx/filename.h>
+
+
+struct BOARD_SNAPSHOT_FIXTURE
+{
+    BOARD_SNAPSHOT_FIXTURE() :
+        m_fileName( wxFileName::CreateTempFileName( wxT( "snapshot" ) ) )
+    {
+        m_board.Add( new NETINFO_ITEM( &m_board, "GND", 1 ) );
+        m_board.Add( new NETINFO_ITEM( &m_board, wxString::FromUTF8( "/Net \xc3\xa9" ), 2 ) );
+    }
+
+    ~BOARD_SNAPSHOT_FIXTURE()
+    {
+        wxRemoveFile( m_fileName );
+    }
+
+    BOARD    m_board;
+    wxString m_fileName;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( BoardSnapshot, BOARD_SNAPSHOT_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( TracksAndZoneFills )
+{
+    TRACK* track = new TRACK( &m_board );
+
+    track->SetStart( wxPoint( 0, 0 ) );
+    track->SetEnd( wxPoint( 1000000, -250000 ) );
+    track->SetWidth( 250000 );
+    track->SetLayer( B_Cu );
+    track->SetNetCode( 2 );
+    m_board.Add( track, ADD_APPEND );
+
+    VIA* via = new VIA( &m_board );
+
+    via->SetViaType( VIA_BLIND_BURIED );
+    via->SetLayerPair( F_Cu, In2_Cu );
+    via->SetStart( wxPoint( 1000000, -250000 ) );
+    via->SetEnd( wxPoint( 1000000, -250000 ) );
+    via->SetWidth( 600000 );
+    via->SetDrill( 300000 );
+    via->SetNetCode( 1 );
+    m_board.Add( via, ADD_APPEND );
+
+    ZONE_CONTAINER* zone = new ZONE_CONTAINER( &m_board );
+
+    zone->SetLayer( F_Cu );
+    zone->SetNetCode( 1 );
+    zone->Outline()->NewOutline();
+    zone->Outline()->Append( 0, 0 );
+    zone->Outline()->Append( 5000000, 0 );
+    zone->Outline()->Append( 5000000, 5000000 );
+
+    SHAPE_POLY_SET fill;
+
+    fill.NewOutline();
+    fill.Append( 100000, 100000 );
+    fill.Append( 4900000, 100000 );
+    fill.Append( 4900000, 4900000 );
+    fill.Append( 100000, 4900000 );
+
+    zone->SetFilledPolysList( fill );
+    zone->SetIsFilled( true );
+    m_board.Add( zone );
+
+    PCB_SNAPSHOT_IO snapshot;
+
+    snapshot.Save( m_fileName, &m_board );
+
+    BOOST_CHECK( PCB_SNAPSHOT_IO::IsSnapshotFile( m_fileName ) );
+
+    // The s-expression plugin reads the snapshots too
+    PCB_IO                 io;
+    std::unique_ptr<BOARD> board( io.Load( m_fileName, nullptr ) );
+
+    BOOST_REQUIRE( board );
+    BOOST_CHECK( board->IsModified() );
+    BOOST_REQUIRE_EQUAL( board->Tracks().size(), 2 );
+
+    TRACK* loadedTrack = board->Tracks()[0];
+
+    BOOST_REQUIRE_EQUAL( loadedTrack->Type(), PCB_TRACE_T );
+    BOOST_CHECK( loadedTrack->GetEnd() == wxPoint( 1000000, -250000 ) );
+    BOOST_CHECK_EQUAL( loadedTrack->GetWidth(), 250000 );
+    BOOST_CHECK_EQUAL( loadedTrack->GetLayer(), B_Cu );
+    BOOST_CHECK( loadedTrack->GetNetname() == wxString::FromUTF8( "/Net \xc3\xa9" ) );
+
+    BOOST_REQUIRE_EQUAL( board->Tracks()[1]->Type(), PCB_VIA_T );
+
+    VIA*         loadedVia = static_cast<VIA*>( board->Tracks()[1] );
+    PCB_LAYER_ID top, bottom;
+
+    loadedVia->LayerPair( &top, &bottom );
+
+    BOOST_CHECK_EQUAL( loadedVia->GetViaType(), VIA_BLIND_BURIED );
+    BOOST_CHECK_EQUAL( top, F_Cu );
+    BOOST_CHECK_EQUAL( bottom, In2_Cu );
+    BOOST_CHECK_EQUAL( loadedVia->GetDrill(), 300000 );
+    BOOST_CHECK( loadedVia->GetNetname() == wxString( "GND" ) );
+
+    BOOST_REQUIRE_EQUAL( board->GetAreaCount(), 1 );
+
+    const SHAPE_POLY_SET& loadedFill = board->GetArea( 0 )->GetFilledPolysList();
+
+    BOOST_CHECK( board->GetArea( 0 )->IsFilled() );
+    BOOST_REQUIRE_EQUAL( loadedFill.OutlineCount(), 1 );
+    BOOST_CHECK_EQUAL( loadedFill.COutline( 0 ).PointCount(), 4 );
+    BOOST_CHECK_EQUAL( loadedFill.COutline( 0 ).Area(), fill.COutline( 0 ).Area() );
+}
+
+
+BOOST_AUTO_TEST_CASE( Truncated )
+{
+    PCB_SNAPSHOT_IO snapshot;
+
+    snapshot.Save( m_fileName, &m_board );
+
+    std::string data;
+
+    {
+        std::ifstream in( TO_UTF8( m_fileName ), std::ios::binary );
+        data.assign( std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() );
+    }
+
+    BOOST_REQUIRE_GT( data.size(), 12 );
+
+    // Cut the header of the last section
+    {
+        std::ofstream out( TO_UTF8( m_fileName ), std::ios::binary | std::ios::trunc );
+        out.write( data.data(), data.size() - 12 );
+    }
+
+    BOOST_CHECK_THROW( snapshot.Load( m_fileName, nullptr ), IO_ERROR );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,143 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file test_connectivity_clusters.cpp
+ * Checks that the ratsnest clusters rebuilt for the changed nets only match the clusters
+ * of a full rebuild
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <set>
+
+#include <class_board.h>
+#include <class_track.h>
+#include <netinfo.h>
+
+#include <connectivity/connectivity_algo.h>
+#include <connectivity/connectivity_data.h>
+
+
+/// A cluster, as its net and its board items
+using CLUSTER_ITEMS = std::pair<int, std::set<const BOARD_CONNECTED_ITEM*>>;
+
+
+static std::set<CLUSTER_ITEMS> clusterItems( const CN_CONNECTIVITY_ALGO::CLUSTERS& aClusters )
+{
+    std::set<CLUSTER_ITEMS> clusters;
+
+    for( const auto& cluster : aClusters )
+    {
+        CLUSTER_ITEMS items;
+        items.first = cluster->OriginNet();
+
+        for( auto item : *cluster )
+        {
+            if( item->Valid() )
+                items.second.insert( item->Parent() );
+        }
+
+        clusters.insert( items );
+    }
+
+    return clusters;
+}
+
+
+struct CLUSTERS_TEST_FIXTURE
+{
+    CLUSTERS_TEST_FIXTURE()
+    {
+        m_board.Add( new NETINFO_ITEM( &m_board, "A", 1 ) );
+        m_board.Add( new NETINFO_ITEM( &m_board, "B", 2 ) );
+    }
+
+    TRACK* AddTrack( int aNet, const wxPoint& aStart, const wxPoint& aEnd )
+    {
+        TRACK* track = new TRACK( &m_board );
+
+        track->SetStart( aStart );
+        track->SetEnd( aEnd );
+        track->SetWidth( Millimeter2iu( 0.25 ) );
+        track->SetNetCode( aNet );
+        m_board.Add( track );
+
+        return track;
+    }
+
+    ///> Checks the clusters kept by the board connectivity against a full rebuild
+    void CheckClusters()
+    {
+        auto algo = m_board.GetConnectivity()->GetConnectivityAlgo();
+
+        CN_CONNECTIVITY_ALGO fresh;
+        fresh.Build( &m_board );
+
+        BOOST_CHECK( clusterItems( algo->GetClusters() ) == clusterItems( fresh.GetClusters() ) );
+    }
+
+    BOARD m_board;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( ConnectivityClusters, CLUSTERS_TEST_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( IncrementalClusters )
+{
+    const int mm10 = Millimeter2iu( 10 );
+
+    AddTrack( 1, wxPoint( 0, 0 ), wxPoint( mm10, 0 ) );
+    TRACK* middle = AddTrack( 1, wxPoint( mm10, 0 ), wxPoint( 2 * mm10, 0 ) );
+    TRACK* apart = AddTrack( 1, wxPoint( 3 * mm10, 0 ), wxPoint( 4 * mm10, 0 ) );
+    TRACK* other = AddTrack( 2, wxPoint( 0, mm10 ), wxPoint( mm10, mm10 ) );
+
+    m_board.BuildConnectivity();
+    auto connectivity = m_board.GetConnectivity();
+
+    BOOST_CHECK_EQUAL( connectivity->GetConnectivityAlgo()->GetClusters().size(), 3 );
+    CheckClusters();
+
+    // Joining two clusters of a net
+    apart->SetStart( wxPoint( 2 * mm10, 0 ) );
+    connectivity->Update( apart );
+    CheckClusters();
+
+    BOOST_CHECK_EQUAL( connectivity->GetConnectivityAlgo()->GetClusters().size(), 2 );
+
+    // Changing the net of an item before updating it: the cluster of its previous net
+    // must not be kept
+    other->SetNetCode( 1 );
+    connectivity->Update( other );
+    CheckClusters();
+
+    // Removing an item splits its cluster
+    connectivity->Remove( middle );
+    m_board.Remove( middle );
+    delete middle;
+    CheckClusters();
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,103 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file test_dynamic_ratsnest.cpp
+ * Checks that the dynamic ratsnest reused while items are dragged follows them
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <class_board.h>
+#include <class_track.h>
+#include <netinfo.h>
+
+#include <connectivity/connectivity_data.h>
+
+
+struct DYNAMIC_RATSNEST_FIXTURE
+{
+    DYNAMIC_RATSNEST_FIXTURE()
+    {
+        m_board.Add( new NETINFO_ITEM( &m_board, "A", 1 ) );
+    }
+
+    TRACK* AddTrack( const wxPoint& aStart, const wxPoint& aEnd )
+    {
+        TRACK* track = new TRACK( &m_board );
+
+        track->SetStart( aStart );
+        track->SetEnd( aEnd );
+        track->SetWidth( Millimeter2iu( 0.25 ) );
+        track->SetNetCode( 1 );
+        m_board.Add( track );
+
+        return track;
+    }
+
+    BOARD m_board;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( DynamicRatsnest, DYNAMIC_RATSNEST_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( FollowDraggedTrack )
+{
+    const int mm10 = Millimeter2iu( 10 );
+
+    AddTrack( wxPoint( 0, 0 ), wxPoint( mm10, 0 ) );
+    TRACK* dragged = AddTrack( wxPoint( 3 * mm10, 0 ), wxPoint( 4 * mm10, 0 ) );
+
+    m_board.BuildConnectivity();
+    auto connectivity = m_board.GetConnectivity();
+
+    std::vector<BOARD_ITEM*> items = { dragged };
+
+    connectivity->ComputeDynamicRatsnest( items );
+
+    BOOST_REQUIRE_EQUAL( connectivity->GetDynamicRatsnest().size(), 1 );
+    BOOST_CHECK( connectivity->GetDynamicRatsnest()[0].a == VECTOR2I( mm10, 0 ) );
+    BOOST_CHECK( connectivity->GetDynamicRatsnest()[0].b == VECTOR2I( 3 * mm10, 0 ) );
+
+    // The line follows the dragged track, without building the dynamic ratsnest again
+    dragged->Move( wxPoint( 0, mm10 ) );
+    connectivity->ComputeDynamicRatsnest( items );
+
+    BOOST_REQUIRE_EQUAL( connectivity->GetDynamicRatsnest().size(), 1 );
+    BOOST_CHECK( connectivity->GetDynamicRatsnest()[0].a == VECTOR2I( mm10, 0 ) );
+    BOOST_CHECK( connectivity->GetDynamicRatsnest()[0].b == VECTOR2I( 3 * mm10, mm10 ) );
+
+    // Dragging it to the other side of the static track changes the nearest anchor
+    dragged->Move( wxPoint( -9 * mm10 / 2, -mm10 ) );
+    connectivity->ComputeDynamicRatsnest( items );
+
+    BOOST_REQUIRE_EQUAL( connectivity->GetDynamicRatsnest().size(), 1 );
+    BOOST_CHECK( connectivity->GetDynamicRatsnest()[0].a == VECTOR2I( 0, 0 ) );
+    BOOST_CHECK( connectivity->GetDynamicRatsnest()[0].b == VECTOR2I( -mm10 / 2, 0 ) );
+
+    connectivity->ClearDynamicRatsnest();
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -24,9 +24,16 @@
 #include <qa_utils/utility_program.h>
 
 #include "tools/drc_tool/drc_tool.h"
+#include "tools/fp_lib_load_benchmark/fp_lib_load_benchmark.h"
+#include "tools/model_load_benchmark/model_load_benchmark.h"
+#include "tools/pcb_batch/pcb_batch_tool.h"
+#include "tools/pcb_lexer_benchmark/pcb_lexer_benchmark.h"
 #include "tools/pcb_parser/pcb_parser_tool.h"
 #include "tools/polygon_generator/polygon_generator.h"
 #include "tools/polygon_triangulation/polygon_triangulation.h"
+#include "tools/raytrace_benchmark/raytrace_benchmark.h"
+#include "tools/router_replay/router_replay.h"
+#include "tools/zone_fill/zone_fill_tool.h"
 
 /**
  * List of registered tools.
@@ -36,9 +43,16 @@
  */
 const static std::vector<KI_TEST::UTILITY_PROGRAM*> known_tools = {
     &drc_tool,
+    &fp_lib_load_benchmark_tool,
+    &model_load_benchmark_tool,
+    &pcb_batch_tool,
+    &pcb_lexer_benchmark_tool,
     &pcb_parser_tool,
     &polygon_generator_tool,
     &polygon_triangulation_tool,
+    &raytrace_benchmark_tool,
+    &router_replay_tool,
+    &zone_fill_tool,
 };
 
 
@@ -36,7 +36,9 @@
 // DRC
 #include <drc/courtyard_overlap.h>
 #include <drc/drc_marker_factory.h>
+#include <tools/drc.h>
 
+#include <qa_utils/benchmark_utils.h>
 #include <qa_utils/stdstream_line_reader.h>
 
 
@@ -208,6 +210,83 @@ private:
 };
 
 
+/**
+ * DRC runner for the complete pcbnew DRC (as DRC::RunTests() does it), without a frame.
+ *
+ * The board design settings are used as they are.  A JSON report with the duration,
+ * item count and violation count of each test is printed on stdout, so the output can
+ * be used to follow DRC performance over a set of boards.
+ */
+class DRC_FULL_RUNNER
+{
+public:
+    DRC_FULL_RUNNER( const DRC_RUNNER::EXECUTION_CONTEXT& aExecCtx ) : m_exec_context( aExecCtx )
+    {
+    }
+
+    void Execute( BOARD& aBoard, const std::string& aFilename )
+    {
+        if( m_exec_context.m_verbose )
+            std::cerr << "Running DRC check: Full DRC" << std::endl;
+
+        std::vector<std::unique_ptr<MARKER_PCB>> markers;
+        std::vector<DRC::STAGE_REPORT>           reports;
+        DRC                                      drc;
+        DRC_DURATION                             duration;
+
+        {
+            SCOPED_PROF_COUNTER<DRC_DURATION> timer( duration );
+
+            drc.RunTestsHeadless( &aBoard,
+                    [&]( MARKER_PCB* aMarker )
+                    {
+                        markers.push_back( std::unique_ptr<MARKER_PCB>( aMarker ) );
+                    },
+                    reports );
+        }
+
+        size_t violations = 0;
+
+        std::cout << "{" << std::endl;
+        std::cout << "  \"board\": \"" << KI_TEST::JsonEscape( aFilename ) << "\"," << std::endl;
+        std::cout << "  \"stages\": [" << std::endl;
+
+        for( size_t ii = 0; ii < reports.size(); ++ii )
+        {
+            const DRC::STAGE_REPORT& report = reports[ii];
+
+            std::cout << "    { \"name\": \"" << KI_TEST::JsonEscape( report.m_name ) << "\", "
+                      << "\"items\": " << report.m_itemCount << ", "
+                      << "\"violations\": " << report.m_errorCount << ", "
+                      << "\"time_us\": " << report.m_duration.count() << " }"
+                      << ( ii + 1 < reports.size() ? "," : "" ) << std::endl;
+
+            violations += report.m_errorCount;
+        }
+
+        std::cout << "  ]," << std::endl;
+        std::cout << "  \"violations\": " << violations << "," << std::endl;
+        std::cout << "  \"time_us\": " << duration.count() << std::endl;
+        std::cout << "}" << std::endl;
+
+        // Keep stdout valid JSON
+        if( m_exec_context.m_print_markers )
+        {
+            int index = 0;
+
+            for( const auto& m : markers )
+            {
+                std::cerr << index++ << ": "
+                          << m->GetReporter().ShowReport( EDA_UNITS_T::MILLIMETRES );
+            }
+        }
+    }
+
+private:
+    const DRC_RUNNER::EXECUTION_CONTEXT m_exec_context;
+};
+
+
 static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
     {
             wxCMD_LINE_SWITCH,
@@ -253,6 +332,12 @@ static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
             "courtyard-missing",
             _( "perform courtyard-missing checking" ).mb_str(),
     },
+    {
+            wxCMD_LINE_SWITCH,
+            "f",
+            "full",
+            _( "perform the complete pcbnew DRC and print a JSON report of each test" ).mb_str(),
+    },
     {
             wxCMD_LINE_PARAM,
             nullptr,
@@ -315,6 +400,13 @@ int drc_main_func( int argc, char** argv )
 
     const bool all = cl_parser.Found( "all-checks" );
 
+    // The full DRC runs first, as the other runners replace the board design settings
+    if( cl_parser.Found( "full" ) )
+    {
+        DRC_FULL_RUNNER runner( exec_context );
+        runner.Execute( *board, filename );
+    }
+
     // Run the DRC on the board
     if( all || cl_parser.Found( "courtyard-overlap" ) )
     {
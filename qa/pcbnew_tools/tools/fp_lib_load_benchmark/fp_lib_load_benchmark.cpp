@@ -0,0 +1,168 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "fp_lib_load_benchmark.h"
+
+#include <qa_utils/benchmark_utils.h>
+#include <qa_utils/lib_search_benchmark.h>
+
+#include <common.h>
+#include <footprint_info_impl.h>
+#include <fp_lib_table.h>
+#include <lib_tree_model.h>
+
+#include <wx/filename.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+using CLOCK = std::chrono::steady_clock;
+
+
+/**
+ * Read the footprints of all the libraries of aTable into aList, and print the JSON object
+ * of the load named aName.
+ */
+static void timeLoad( std::ostream& aStream, const char* aName, FP_LIB_TABLE& aTable,
+                      FOOTPRINT_LIST_IMPL& aList, bool aLast )
+{
+    auto start = CLOCK::now();
+
+    aList.ReadFootprintFiles( &aTable );
+
+    std::chrono::duration<double, std::milli> dur = CLOCK::now() - start;
+
+    aStream << "    { \"name\": \"" << aName << "\", "
+            << "\"time_ms\": " << dur.count() << ", "
+            << "\"footprints\": " << aList.GetCount() << ", "
+            << "\"errors\": " << aList.GetErrorCount() << ", "
+            << "\"peak_memory_kb\": " << KI_TEST::GetPeakMemoryKb() << " }"
+            << ( aLast ? "" : "," ) << std::endl;
+
+    while( std::unique_ptr<IO_ERROR> error = aList.PopError() )
+        std::cerr << error->What() << std::endl;
+}
+
+
+int fp_lib_load_benchmark_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 2 )
+    {
+        os << "Usage: " << argv[0] << " <FP_LIB_TABLE> [REPS] [SEARCHES]\n\n";
+        os << "Reads the footprints of all the libraries of the footprint library table\n";
+        os << "FP_LIB_TABLE into a footprint list, as the footprint choosers do: a cold load\n";
+        os << "filling the library caches, then a warm load from the library caches.  The\n";
+        os << "environment variables used by the table (KISYSMOD...) must be set.\n\n";
+        os << "Then runs each chooser search REPS times (10 by default) on the footprints:\n";
+        os << "the lines of the file SEARCHES, or representative searches by default.\n\n";
+        os << "Prints a JSON report with the load times, the peak memory, the search index\n";
+        os << "build time and the search latency percentiles.\n";
+
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    int reps = argc > 2 ? std::atoi( argv[2] ) : 10;
+
+    if( reps < 1 )
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    std::vector<wxString> searches;
+
+    if( argc > 3 )
+    {
+        if( !KI_TEST::ReadLibSearches( wxString::FromUTF8( argv[3] ), searches ) )
+        {
+            std::cerr << "Cannot read " << argv[3] << std::endl;
+            return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+        }
+    }
+    else
+    {
+        searches = KI_TEST::GetDefaultLibSearches();
+    }
+
+    wxFileName fn( wxString::FromUTF8( argv[1] ) );
+    fn.MakeAbsolute();
+
+    FP_LIB_TABLE table;
+
+    try
+    {
+        table.Load( fn.GetFullPath() );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        std::cerr << ioe.What() << std::endl;
+        return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+    }
+
+    // The warm load reads a new list, whose libraries are cached by the plugins of the table
+    FOOTPRINT_LIST_IMPL coldList;
+    FOOTPRINT_LIST_IMPL warmList;
+
+    os << "{" << std::endl;
+    os << "  \"fp_lib_table\": \""
+       << KI_TEST::JsonEscape( std::string( fn.GetFullPath().ToUTF8() ) ) << "\"," << std::endl;
+    os << "  \"libraries\": " << table.GetLogicalLibs().size() << "," << std::endl;
+    os << "  \"loads\": [" << std::endl;
+
+    timeLoad( os, "cold", table, coldList, false );
+    timeLoad( os, "warm", table, warmList, true );
+
+    os << "  ]," << std::endl;
+
+    // Build the tree of the footprint chooser
+    LIB_TREE_NODE_ROOT tree;
+    LIB_TREE_NODE_LIB* lib = nullptr;
+
+    for( const std::unique_ptr<FOOTPRINT_INFO>& footprint : warmList.GetList() )
+    {
+        if( !lib || lib->Name != footprint->GetLibNickname() )
+            lib = &tree.AddLib( footprint->GetLibNickname(), wxEmptyString );
+
+        lib->AddItem( footprint.get() );
+    }
+
+    tree.AssignIntrinsicRanks();
+
+    os << "  \"search\": {" << std::endl;
+    KI_TEST::PrintLibSearchBenchmark( os, tree, searches, reps, "    " );
+    os << "  }" << std::endl;
+    os << "}" << std::endl;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+KI_TEST::UTILITY_PROGRAM fp_lib_load_benchmark_tool = {
+    "fp_lib_load_benchmark",
+    "Benchmark the loading of the footprint libraries of a table, and the chooser searches",
+    fp_lib_load_benchmark_func,
+};
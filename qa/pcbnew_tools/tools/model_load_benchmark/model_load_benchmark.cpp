@@ -0,0 +1,212 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "model_load_benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <common.h>
+#include <profile.h>
+
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+
+#include <plugins/3dapi/c3dmodel.h>
+#include <plugins/3dapi/ifsg_api.h>
+#include <plugins/ldr/3d/pluginldr3D.h>
+
+#include <3d_cache/sg/scenegraph.h>
+
+
+using LOAD_DURATION = std::chrono::microseconds;
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    {
+            wxCMD_LINE_SWITCH,
+            "h",
+            "help",
+            _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE,
+            wxCMD_LINE_OPTION_HELP,
+    },
+    {
+            wxCMD_LINE_SWITCH,
+            "v",
+            "verbose",
+            _( "print the time of each load" ).mb_str(),
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "n",
+            "iterations",
+            _( "number of loads of each model (default 5)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER,
+    },
+    {
+            wxCMD_LINE_PARAM,
+            nullptr,
+            nullptr,
+            _( "3D plugin library, then model files" ).mb_str(),
+            wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_MULTIPLE,
+    },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum MODEL_LOAD_BENCHMARK_RET_CODES
+{
+    PLUGIN_OPEN_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    LOAD_FAILED,
+};
+
+
+/**
+ * Loads 3D model files with a 3D plugin, as the 3D cache does when a model is not cached,
+ * several times, and prints for each model the best time of the plugin and of the
+ * conversion of the scene to render data, with the size of the model.
+ *
+ * The plugin is given by the path of its library, for instance the s3d_plugin_vrml
+ * library of the build tree, so that the plugin being worked on is the one timed.
+ */
+int model_load_benchmark_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program times the loading of 3D models by a plugin." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    if( cl_parser.GetParamCount() < 2 )
+    {
+        cl_parser.Usage();
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    const bool verbose = cl_parser.Found( "verbose" );
+    long       iterations = 5;
+
+    cl_parser.Found( "iterations", &iterations );
+    iterations = std::max( 1L, iterations );
+
+    KICAD_PLUGIN_LDR_3D plugin;
+
+    if( !plugin.Open( cl_parser.GetParam( 0 ) ) )
+    {
+        std::cerr << "Could not open the plugin " << cl_parser.GetParam( 0 ) << std::endl;
+        return MODEL_LOAD_BENCHMARK_RET_CODES::PLUGIN_OPEN_FAILED;
+    }
+
+    for( size_t p = 1; p < cl_parser.GetParamCount(); ++p )
+    {
+        const wxString filename = cl_parser.GetParam( p );
+
+        LOAD_DURATION bestLoad = LOAD_DURATION::max();
+        LOAD_DURATION bestConvert = LOAD_DURATION::max();
+        unsigned int  vertices = 0;
+        unsigned int  triangles = 0;
+
+        for( long ii = 0; ii < iterations; ++ii )
+        {
+            LOAD_DURATION loadDuration( 0 );
+            LOAD_DURATION convertDuration( 0 );
+            SCENEGRAPH*   scene = nullptr;
+            S3DMODEL*     model = nullptr;
+
+            {
+                SCOPED_PROF_COUNTER<LOAD_DURATION> timer( loadDuration );
+                scene = plugin.Load( filename.ToUTF8() );
+            }
+
+            if( !scene )
+            {
+                std::cerr << "Could not load " << filename << std::endl;
+                return MODEL_LOAD_BENCHMARK_RET_CODES::LOAD_FAILED;
+            }
+
+            {
+                SCOPED_PROF_COUNTER<LOAD_DURATION> timer( convertDuration );
+                model = S3D::GetModel( scene );
+            }
+
+            if( model )
+            {
+                vertices = 0;
+                triangles = 0;
+
+                for( unsigned int m = 0; m < model->m_MeshesSize; ++m )
+                {
+                    vertices += model->m_Meshes[m].m_VertexSize;
+                    triangles += model->m_Meshes[m].m_FaceIdxSize / 3;
+                }
+
+                S3D::Destroy3DModel( &model );
+            }
+
+            S3D::DestroyNode( scene );
+
+            if( verbose )
+            {
+                std::cerr << "load " << ii << ": " << loadDuration.count() << "us, convert "
+                          << convertDuration.count() << "us" << std::endl;
+            }
+
+            bestLoad = std::min( bestLoad, loadDuration );
+            bestConvert = std::min( bestConvert, convertDuration );
+        }
+
+        const double megabytes = wxFileName( filename ).GetSize().ToDouble() / ( 1024 * 1024 );
+
+        std::cout << filename << ": " << vertices << " vertices, " << triangles
+                  << " triangles" << std::endl;
+        std::cout << "  Load: " << bestLoad.count() << "us ("
+                  << megabytes * 1e6 / std::max<long long>( 1, bestLoad.count() ) << " MB/s)"
+                  << std::endl;
+        std::cout << "  Convert: " << bestConvert.count() << "us" << std::endl;
+    }
+
+    plugin.Close();
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+/*
+ * Define the tool interface
+ */
+KI_TEST::UTILITY_PROGRAM model_load_benchmark_tool = {
+    "model_load_benchmark",
+    "Time the loading of 3D model files by a 3D plugin",
+    model_load_benchmark_main_func,
+};
@@ -0,0 +1,311 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "pcb_batch_tool.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <common.h>
+#include <profile.h>
+
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+
+#include <class_board.h>
+#include <class_marker_pcb.h>
+#include <class_zone.h>
+#include <kicad_plugin.h>
+#include <plotcontroller.h>
+#include <tools/drc.h>
+#include <zone_filler.h>
+
+#include <qa_utils/benchmark_utils.h>
+
+
+using BATCH_DURATION = std::chrono::microseconds;
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    {
+            wxCMD_LINE_SWITCH,
+            "h",
+            "help",
+            _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE,
+            wxCMD_LINE_OPTION_HELP,
+    },
+    {
+            wxCMD_LINE_SWITCH,
+            "v",
+            "verbose",
+            _( "print the progress of each board" ).mb_str(),
+    },
+    {
+            wxCMD_LINE_SWITCH,
+            "f",
+            "fill",
+            _( "refill the zones" ).mb_str(),
+    },
+    {
+            wxCMD_LINE_SWITCH,
+            "d",
+            "drc",
+            _( "run the complete DRC and count the violations" ).mb_str(),
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "p",
+            "plot-dir",
+            _( "plot the layers selected in the plot settings of each board as Gerber files "
+               "in this directory" ).mb_str(),
+            wxCMD_LINE_VAL_STRING,
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "s",
+            "save-dir",
+            _( "save each board, with its refilled zones, in this directory" ).mb_str(),
+            wxCMD_LINE_VAL_STRING,
+    },
+    {
+            wxCMD_LINE_PARAM,
+            nullptr,
+            nullptr,
+            _( "input files" ).mb_str(),
+            wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_MULTIPLE,
+    },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum PCB_BATCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+/**
+ * What is done to each board
+ */
+struct BATCH_JOB
+{
+    bool     m_verbose = false;
+    bool     m_fill = false;
+    bool     m_drc = false;
+    wxString m_plotDir;
+    wxString m_saveDir;
+};
+
+
+/**
+ * Runs the job on a board, and prints its result as a line of JSON.
+ *
+ * @return false if the board cannot be loaded or saved
+ */
+static bool runJob( const BATCH_JOB& aJob, const wxString& aFilename )
+{
+    std::unique_ptr<BOARD> board;
+    BATCH_DURATION         loadTime( 0 ), fillTime( 0 ), drcTime( 0 );
+    BATCH_DURATION         plotTime( 0 ), saveTime( 0 );
+    size_t                 violations = 0;
+    int                    plotFiles = 0;
+    bool                   ok = true;
+
+    if( aJob.m_verbose )
+        std::cerr << "Loading " << aFilename.ToStdString() << std::endl;
+
+    try
+    {
+        SCOPED_PROF_COUNTER<BATCH_DURATION> timer( loadTime );
+        PCB_IO                              io;
+
+        board.reset( io.Load( aFilename, nullptr ) );
+    }
+    catch( const IO_ERROR& error )
+    {
+        std::cerr << error.What().ToStdString() << std::endl;
+    }
+
+    std::cout << "{ \"board\": \"" << KI_TEST::JsonEscape( aFilename.ToStdString() ) << "\"";
+
+    if( !board )
+    {
+        std::cout << ", \"loaded\": false }" << std::endl;
+        return false;
+    }
+
+    std::cout << ", \"load_us\": " << loadTime.count();
+
+    // The zone fill (islands removal) and the DRC need the connectivity
+    board->BuildConnectivity();
+
+    if( aJob.m_fill )
+    {
+        if( aJob.m_verbose )
+            std::cerr << "Filling " << board->Zones().size() << " zones" << std::endl;
+
+        std::vector<ZONE_CONTAINER*> zones;
+
+        for( ZONE_CONTAINER* zone : board->Zones() )
+        {
+            if( !zone->GetIsKeepout() )
+                zones.push_back( zone );
+        }
+
+        SCOPED_PROF_COUNTER<BATCH_DURATION> timer( fillTime );
+        ZONE_FILLER                         filler( board.get() );
+
+        filler.Fill( zones );
+    }
+
+    if( aJob.m_drc )
+    {
+        if( aJob.m_verbose )
+            std::cerr << "Running the DRC" << std::endl;
+
+        std::vector<DRC::STAGE_REPORT> reports;
+        DRC                            drc;
+
+        {
+            SCOPED_PROF_COUNTER<BATCH_DURATION> timer( drcTime );
+
+            drc.RunTestsHeadless( board.get(),
+                    []( MARKER_PCB* aMarker )
+                    {
+                        delete aMarker;
+                    },
+                    reports );
+        }
+
+        for( const DRC::STAGE_REPORT& report : reports )
+            violations += report.m_errorCount;
+    }
+
+    if( !aJob.m_plotDir.IsEmpty() )
+    {
+        if( aJob.m_verbose )
+            std::cerr << "Plotting to " << aJob.m_plotDir.ToStdString() << std::endl;
+
+        SCOPED_PROF_COUNTER<BATCH_DURATION> timer( plotTime );
+        PLOT_CONTROLLER                     plotter( board.get() );
+        LSET layers = board->GetPlotOptions().GetLayerSelection() & board->GetEnabledLayers();
+
+        plotter.GetPlotOptions() = board->GetPlotOptions();
+        plotter.GetPlotOptions().SetOutputDirectory( aJob.m_plotDir );
+
+        plotFiles = plotter.PlotLayers( layers.Seq(), PLOT_FORMAT_GERBER );
+    }
+
+    if( !aJob.m_saveDir.IsEmpty() )
+    {
+        wxFileName fn( aFilename );
+        fn.SetPath( aJob.m_saveDir );
+
+        try
+        {
+            SCOPED_PROF_COUNTER<BATCH_DURATION> timer( saveTime );
+            PCB_IO                              io;
+
+            io.Save( fn.GetFullPath(), board.get() );
+        }
+        catch( const IO_ERROR& error )
+        {
+            std::cerr << error.What().ToStdString() << std::endl;
+            ok = false;
+        }
+    }
+
+    if( aJob.m_fill )
+        std::cout << ", \"fill_us\": " << fillTime.count();
+
+    if( aJob.m_drc )
+        std::cout << ", \"drc_us\": " << drcTime.count() << ", \"violations\": " << violations;
+
+    if( !aJob.m_plotDir.IsEmpty() )
+        std::cout << ", \"plot_us\": " << plotTime.count() << ", \"plot_files\": " << plotFiles;
+
+    if( !aJob.m_saveDir.IsEmpty() )
+        std::cout << ", \"save_us\": " << saveTime.count() << ", \"saved\": "
+                  << ( ok ? "true" : "false" );
+
+    std::cout << " }" << std::endl;
+
+    return ok;
+}
+
+
+/**
+ * Loads each board given on the command line, then fills its zones, runs the DRC, plots
+ * it and saves it, as requested, without any frame or display.  All the boards are done in
+ * the same process, so the start up is paid once; each step uses all the cores through the
+ * thread pool.
+ *
+ * A line of JSON is printed for each board, with the time of each step, the DRC violation
+ * count and the plot file count.
+ */
+int pcb_batch_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program fills, checks, plots and saves PCB files in "
+                               "batch." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    BATCH_JOB job;
+
+    job.m_verbose = cl_parser.Found( "verbose" );
+    job.m_fill = cl_parser.Found( "fill" );
+    job.m_drc = cl_parser.Found( "drc" );
+    cl_parser.Found( "plot-dir", &job.m_plotDir );
+    cl_parser.Found( "save-dir", &job.m_saveDir );
+
+    bool ok = true;
+
+    for( unsigned ii = 0; ii < cl_parser.GetParamCount(); ++ii )
+        ok &= runJob( job, cl_parser.GetParam( ii ) );
+
+    return ok ? KI_TEST::RET_CODES::OK : PCB_BATCH_RET_CODES::LOAD_FAILED;
+}
+
+
+/*
+ * Define the tool interface
+ */
+KI_TEST::UTILITY_PROGRAM pcb_batch_tool = {
+    "pcb_batch",
+    "Fill, check, plot and save PCBs in batch",
+    pcb_batch_main_func,
+};
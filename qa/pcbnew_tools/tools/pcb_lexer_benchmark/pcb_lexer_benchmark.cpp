@@ -0,0 +1,230 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "pcb_lexer_benchmark.h"
+
+#include <pcb_lexer.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+using CLOCK = std::chrono::steady_clock;
+
+
+/**
+ * A PCB_LEXER giving access to its keyword lookup, which uses the generated perfect hash.
+ */
+class HASH_LEXER : public PCB_LEXER
+{
+public:
+    HASH_LEXER() : PCB_LEXER( std::string(), wxT( "benchmark" ) )
+    {
+    }
+
+    int Find( const std::string& aText )
+    {
+        return findToken( aText );
+    }
+};
+
+
+/**
+ * A DSNLEXER with the keywords of PCB_LEXER but without their perfect hash, so that its
+ * keyword lookup uses the KEYWORD_MAP hashtable.
+ */
+class MAP_LEXER : public DSNLEXER
+{
+public:
+    MAP_LEXER( const std::vector<KEYWORD>& aKeywords ) :
+        DSNLEXER( aKeywords.data(), aKeywords.size(), (LINE_READER*) nullptr )
+    {
+    }
+
+    int Find( const std::string& aText )
+    {
+        return findToken( aText );
+    }
+};
+
+
+/**
+ * @return the keywords of PCB_LEXER, as a KEYWORD table.
+ */
+static std::vector<KEYWORD> pcbKeywords()
+{
+    std::vector<KEYWORD> keywords;
+
+    for( int token = 0; ; ++token )
+    {
+        const char* name = PCB_LEXER::TokenName( (PCB_KEYS_T::T) token );
+
+        if( !strcmp( name, "token too big" ) )
+            break;
+
+        keywords.push_back( { name, token } );
+    }
+
+    return keywords;
+}
+
+
+int pcb_lexer_benchmark_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 3 )
+    {
+        os << "Usage: " << argv[0] << " <REPS> <FILE>\n\n";
+        os << "Times the lexing of the PCB file FILE, and the keyword lookups of its symbols\n";
+        os << "through the generated perfect hash and through the KEYWORD_MAP hashtable.\n\n";
+        os << "Prints one line per benchmark: name, repetitions, ms per repetition and a\n";
+        os << "value depending on the result, which must not change between runs.\n";
+
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    int reps = std::atoi( argv[1] );
+
+    if( reps < 1 )
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    std::string text;
+
+    {
+        std::ifstream in( argv[2], std::ios::binary );
+
+        if( !in )
+        {
+            std::cerr << "Cannot read " << argv[2] << std::endl;
+            return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+        }
+
+        text.assign( std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() );
+    }
+
+    // The symbols and keywords of the file, which are what the lexer looks up
+    std::vector<std::string> symbols;
+
+    try
+    {
+        PCB_LEXER lexer( text, wxString::FromUTF8( argv[2] ) );
+
+        for( int tok = lexer.NextTok(); tok != DSN_EOF; tok = lexer.NextTok() )
+        {
+            if( tok >= 0 || tok == DSN_SYMBOL )
+                symbols.push_back( lexer.CurText() );
+        }
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        std::cerr << ioe.What() << std::endl;
+        return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+    }
+
+    std::vector<KEYWORD> keywords = pcbKeywords();
+    HASH_LEXER           hashLexer;
+    MAP_LEXER            mapLexer( keywords );
+
+    struct BENCHMARK
+    {
+        const char*                 name;
+        std::function<long long()>  func;
+    };
+
+    const std::vector<BENCHMARK> benchmarks = {
+        { "lex", [&]() -> long long
+            {
+                PCB_LEXER lexer( text, wxString::FromUTF8( argv[2] ) );
+                long long keywordCount = 0;
+
+                for( int tok = lexer.NextTok(); tok != DSN_EOF; tok = lexer.NextTok() )
+                {
+                    if( tok >= 0 )
+                        ++keywordCount;
+                }
+
+                return keywordCount;
+            } },
+        { "lookup_perfect_hash", [&]() -> long long
+            {
+                long long keywordCount = 0;
+
+                for( const std::string& symbol : symbols )
+                {
+                    if( hashLexer.Find( symbol ) >= 0 )
+                        ++keywordCount;
+                }
+
+                return keywordCount;
+            } },
+        { "lookup_keyword_map", [&]() -> long long
+            {
+                long long keywordCount = 0;
+
+                for( const std::string& symbol : symbols )
+                {
+                    if( mapLexer.Find( symbol ) >= 0 )
+                        ++keywordCount;
+                }
+
+                return keywordCount;
+            } },
+    };
+
+    os << "# pcb lexer benchmark: " << text.size() << " bytes, " << symbols.size()
+       << " symbols" << std::endl;
+    os << "# name reps ms_per_rep keywords" << std::endl;
+
+    for( const BENCHMARK& bmark : benchmarks )
+    {
+        long long result = 0;
+        auto      start = CLOCK::now();
+
+        for( int rep = 0; rep < reps; ++rep )
+            result = bmark.func();
+
+        std::chrono::duration<double, std::milli> dur = CLOCK::now() - start;
+
+        os << std::left << std::setw( 24 ) << bmark.name << std::right << std::setw( 6 )
+           << reps << std::fixed << std::setprecision( 3 ) << std::setw( 14 )
+           << dur.count() / reps << std::setw( 14 ) << result << std::endl;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+KI_TEST::UTILITY_PROGRAM pcb_lexer_benchmark_tool = {
+    "pcb_lexer_benchmark",
+    "Benchmark the lexing and the keyword lookups of a KiCad PCB file",
+    pcb_lexer_benchmark_func,
+};
@@ -0,0 +1,226 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "raytrace_benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <common.h>
+#include <profile.h>
+
+#include <wx/cmdline.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <class_board.h>
+
+#include <3d_canvas/cinfo3d_visu.h>
+#include <3d_rendering/3d_render_raytracing/c3d_render_raytracing.h>
+
+
+using RENDER_DURATION = std::chrono::microseconds;
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    {
+            wxCMD_LINE_SWITCH,
+            "h",
+            "help",
+            _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE,
+            wxCMD_LINE_OPTION_HELP,
+    },
+    {
+            wxCMD_LINE_SWITCH,
+            "v",
+            "verbose",
+            _( "print the time of each frame" ).mb_str(),
+    },
+    {
+            wxCMD_LINE_SWITCH,
+            "a",
+            "anti-aliasing",
+            _( "render with the anti-aliasing pass" ).mb_str(),
+    },
+    {
+            wxCMD_LINE_SWITCH,
+            "p",
+            "post-processing",
+            _( "render with the post processing passes" ).mb_str(),
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "W",
+            "width",
+            _( "width of the frame in pixels (default 1280)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER,
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "H",
+            "height",
+            _( "height of the frame in pixels (default 720)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER,
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "n",
+            "iterations",
+            _( "number of frames rendered (default 5)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER,
+    },
+    {
+            wxCMD_LINE_PARAM,
+            nullptr,
+            nullptr,
+            _( "input file" ).mb_str(),
+            wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_OPTIONAL,
+    },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum RAYTRACE_BENCHMARK_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+/**
+ * Renders the board with the raytracer of the 3D viewer, from the default camera of the
+ * viewer, several times, and prints the best time of a frame and its number of primary
+ * rays per second.  The scene is built once, before the timed frames.
+ *
+ * The 3D models are not loaded: the scene is the board, and the time is the one of the
+ * tracing and shading code.
+ */
+int raytrace_benchmark_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program times the raytracing render of a PCB file." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    const bool verbose = cl_parser.Found( "verbose" );
+    long       width = 1280;
+    long       height = 720;
+    long       iterations = 5;
+
+    cl_parser.Found( "width", &width );
+    cl_parser.Found( "height", &height );
+    cl_parser.Found( "iterations", &iterations );
+
+    // The raytracer renders blocks of pixels, and needs a few of them
+    width = std::max( 128L, width );
+    height = std::max( 128L, height );
+    iterations = std::max( 1L, iterations );
+
+    std::string filename;
+
+    if( cl_parser.GetParamCount() )
+        filename = cl_parser.GetParam( 0 ).ToStdString();
+
+    std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream( filename );
+
+    if( !board )
+        return RAYTRACE_BENCHMARK_RET_CODES::LOAD_FAILED;
+
+    CINFO3D_VISU settings;
+
+    settings.SetBoard( board.get() );
+    settings.SetFlag( FL_SHOW_BOARD_BODY, true );
+    settings.SetFlag( FL_USE_REALISTIC_MODE, true );
+    settings.SetFlag( FL_SILKSCREEN, true );
+    settings.SetFlag( FL_SOLDERMASK, true );
+    settings.SetFlag( FL_ZONE, true );
+    settings.SetFlag( FL_RENDER_RAYTRACING_SHADOWS, true );
+    settings.SetFlag( FL_RENDER_RAYTRACING_ANTI_ALIASING, cl_parser.Found( "anti-aliasing" ) );
+    settings.SetFlag( FL_RENDER_RAYTRACING_POST_PROCESSING,
+                      cl_parser.Found( "post-processing" ) );
+
+    const wxSize size( width, height );
+
+    settings.CameraGet().SetCurWindowSize( size );
+
+    C3D_RENDER_RAYTRACING renderer( settings );
+    std::vector<GLubyte>  frame;
+
+    // The first frame builds the scene, it is not timed
+    SFVEC2UI frameSize = renderer.RenderToBuffer( size, frame );
+
+    const double rays = (double) frameSize.x * frameSize.y;
+
+    RENDER_DURATION best = RENDER_DURATION::max();
+
+    for( long ii = 0; ii < iterations; ++ii )
+    {
+        RENDER_DURATION duration( 0 );
+
+        {
+            SCOPED_PROF_COUNTER<RENDER_DURATION> timer( duration );
+            renderer.RenderToBuffer( size, frame );
+        }
+
+        if( verbose )
+            std::cerr << "frame " << ii << ": " << duration.count() << "us" << std::endl;
+
+        best = std::min( best, duration );
+    }
+
+    std::cout << "Frame " << frameSize.x << "x" << frameSize.y << ": " << best.count() << "us"
+              << std::endl;
+    std::cout << "Primary rays per second: " << (long long) ( rays * 1e6 / best.count() )
+              << std::endl;
+    std::cout << "Packet kernels: " <<
+#ifdef __SSE2__
+            "SSE2"
+#else
+            "scalar"
+#endif
+              << std::endl;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+/*
+ * Define the tool interface
+ */
+KI_TEST::UTILITY_PROGRAM raytrace_benchmark_tool = {
+    "raytrace_benchmark",
+    "Time the raytracing render of a PCB in the 3D viewer",
+    raytrace_benchmark_main_func,
+};
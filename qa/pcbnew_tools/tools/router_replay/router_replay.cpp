@@ -0,0 +1,442 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "router_replay.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <common.h>
+#include <profile.h>
+
+#include <wx/cmdline.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <class_board.h>
+#include <router/pns_debug_decorator.h>
+#include <router/pns_kicad_iface.h>
+#include <router/pns_logger.h>
+#include <router/pns_placement_algo.h>
+#include <router/pns_router.h>
+
+
+using STEP_DURATION = std::chrono::microseconds;
+using EVENT_ENTRY = PNS::LOGGER::EVENT_ENTRY;
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    {
+            wxCMD_LINE_SWITCH,
+            "h",
+            "help",
+            _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE,
+            wxCMD_LINE_OPTION_HELP,
+    },
+    {
+            wxCMD_LINE_SWITCH,
+            "v",
+            "verbose",
+            _( "print the time of each step" ).mb_str(),
+    },
+    {
+            wxCMD_LINE_SWITCH,
+            "c",
+            "csv",
+            _( "print the result and the time of each step as CSV" ).mb_str(),
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "n",
+            "iterations",
+            _( "number of replays of the session (default 5)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER,
+    },
+    {
+            wxCMD_LINE_PARAM,
+            nullptr,
+            nullptr,
+            _( "board file" ).mb_str(),
+            wxCMD_LINE_VAL_STRING,
+    },
+    {
+            wxCMD_LINE_PARAM,
+            nullptr,
+            nullptr,
+            _( "router event log" ).mb_str(),
+            wxCMD_LINE_VAL_STRING,
+    },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum ROUTER_REPLAY_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    EVENT_LOG_FAILED,
+};
+
+
+/// The number of values of the config line written by PNS::ROUTER
+static const size_t CONFIG_SIZE = 10;
+
+
+static const char* eventName( PNS::LOGGER::EVENT_TYPE aType )
+{
+    switch( aType )
+    {
+    case PNS::LOGGER::EVT_START_ROUTE:  return "start-route";
+    case PNS::LOGGER::EVT_START_DRAG:   return "start-drag";
+    case PNS::LOGGER::EVT_MOVE:         return "move";
+    case PNS::LOGGER::EVT_FIX:          return "fix";
+    case PNS::LOGGER::EVT_STOP:         return "stop";
+    case PNS::LOGGER::EVT_SWITCH_LAYER: return "switch-layer";
+    case PNS::LOGGER::EVT_TOGGLE_VIA:   return "toggle-via";
+    case PNS::LOGGER::EVT_FLIP_POSTURE: return "flip-posture";
+    }
+
+    return "unknown";
+}
+
+
+/**
+ * A router interface without a view or a commit: the routed items only go to the router
+ * world, so the board is left as it was loaded and every replay starts from the same state.
+ */
+class REPLAY_IFACE : public PNS_KICAD_IFACE
+{
+public:
+    void EraseView() override {}
+    void HideItem( PNS::ITEM* aItem ) override {}
+
+    void DisplayItem( const PNS::ITEM* aItem, int aColor, int aClearance, bool aEdit ) override
+    {
+    }
+
+    void AddItem( PNS::ITEM* aItem ) override {}
+    void RemoveItem( PNS::ITEM* aItem ) override {}
+    void Commit() override {}
+    void UpdateNet( int aNetCode ) override {}
+
+    PNS::DEBUG_DECORATOR* GetDebugDecorator() override { return &m_decorator; }
+
+private:
+    PNS::DEBUG_DECORATOR m_decorator;
+};
+
+
+/**
+ * The best of several replays of a step
+ */
+struct STEP_RESULT
+{
+    STEP_DURATION m_time = STEP_DURATION::max();
+    bool          m_ok = true;
+};
+
+
+/**
+ * Finds the item of a recorded call in the node the router is working on.
+ */
+static PNS::ITEM* findItem( PNS::ROUTER& aRouter, const EVENT_ENTRY& aEvent )
+{
+    if( !aEvent.m_itemKind )
+        return nullptr;
+
+    PNS::NODE* node = aRouter.GetWorld();
+
+    if( aRouter.RoutingInProgress() && aRouter.Placer() )
+        node = aRouter.Placer()->CurrentNode();
+
+    std::set<PNS::ITEM*> items;
+    node->AllItemsInNet( aEvent.m_itemNet, items );
+
+    for( PNS::ITEM* item : items )
+    {
+        if( item->Kind() == aEvent.m_itemKind
+                && item->Layers().Start() == aEvent.m_itemLayerStart
+                && item->Layers().End() == aEvent.m_itemLayerEnd
+                && PNS::LOGGER::ItemPosition( item ) == aEvent.m_itemPos )
+        {
+            return item;
+        }
+    }
+
+    return nullptr;
+}
+
+
+static void applyConfig( PNS::ROUTER& aRouter, BOARD* aBoard, const std::vector<int>& aConfig )
+{
+    PNS::SIZES_SETTINGS sizes;
+
+    sizes.Init( aBoard );
+
+    if( aConfig.size() >= CONFIG_SIZE )
+    {
+        aRouter.SetMode( static_cast<PNS::ROUTER_MODE>( aConfig[0] ) );
+        aRouter.Settings().SetMode( static_cast<PNS::PNS_MODE>( aConfig[1] ) );
+        sizes.SetTrackWidth( aConfig[2] );
+        sizes.SetViaDiameter( aConfig[3] );
+        sizes.SetViaDrill( aConfig[4] );
+        sizes.SetViaType( static_cast<VIATYPE_T>( aConfig[5] ) );
+        sizes.SetDiffPairWidth( aConfig[6] );
+        sizes.SetDiffPairGap( aConfig[7] );
+        sizes.ClearLayerPairs();
+        sizes.AddLayerPair( aConfig[8], aConfig[9] );
+    }
+
+    aRouter.UpdateSizes( sizes );
+}
+
+
+/**
+ * Runs the recorded calls on a fresh world and keeps the best time of each step.
+ * @return the number of recorded items which were not found in the world.
+ */
+static int replay( PNS::ROUTER& aRouter, BOARD* aBoard, const std::vector<int>& aConfig,
+                   const std::vector<EVENT_ENTRY>& aEvents, std::vector<STEP_RESULT>& aResults,
+                   STEP_DURATION& aSyncTime )
+{
+    int missingItems = 0;
+
+    {
+        STEP_DURATION syncTime( 0 );
+        SCOPED_PROF_COUNTER<STEP_DURATION> timer( syncTime );
+        aRouter.SyncWorld();
+        aSyncTime = std::min( aSyncTime, syncTime );
+    }
+
+    applyConfig( aRouter, aBoard, aConfig );
+
+    for( size_t ii = 0; ii < aEvents.size(); ++ii )
+    {
+        const EVENT_ENTRY& evt = aEvents[ii];
+        PNS::ITEM*         item = findItem( aRouter, evt );
+        STEP_DURATION      stepTime( 0 );
+        bool               ok = true;
+
+        if( evt.m_itemKind && !item )
+            missingItems++;
+
+        {
+            SCOPED_PROF_COUNTER<STEP_DURATION> timer( stepTime );
+
+            switch( evt.m_type )
+            {
+            case PNS::LOGGER::EVT_START_ROUTE:
+                ok = aRouter.StartRouting( evt.m_pos, item, evt.m_arg );
+                break;
+
+            case PNS::LOGGER::EVT_START_DRAG:
+                ok = aRouter.StartDragging( evt.m_pos, item, evt.m_arg );
+                break;
+
+            case PNS::LOGGER::EVT_MOVE:
+                aRouter.Move( evt.m_pos, item );
+                break;
+
+            case PNS::LOGGER::EVT_FIX:
+                ok = aRouter.FixRoute( evt.m_pos, item, evt.m_arg != 0 );
+                break;
+
+            case PNS::LOGGER::EVT_STOP:
+                aRouter.StopRouting();
+                break;
+
+            case PNS::LOGGER::EVT_SWITCH_LAYER:
+                aRouter.SwitchLayer( evt.m_arg );
+                break;
+
+            case PNS::LOGGER::EVT_TOGGLE_VIA:
+                if( aRouter.IsPlacingVia() != ( evt.m_arg != 0 ) )
+                    aRouter.ToggleViaPlacement();
+
+                break;
+
+            case PNS::LOGGER::EVT_FLIP_POSTURE:
+                aRouter.FlipPosture();
+                break;
+            }
+        }
+
+        aResults[ii].m_time = std::min( aResults[ii].m_time, stepTime );
+        aResults[ii].m_ok = ok;
+    }
+
+    aRouter.StopRouting();
+
+    return missingItems;
+}
+
+
+static void printCsv( const std::vector<EVENT_ENTRY>& aEvents,
+                      const std::vector<STEP_RESULT>& aResults )
+{
+    std::cout << "step,event,x,y,ok,time_us" << std::endl;
+
+    for( size_t ii = 0; ii < aEvents.size(); ++ii )
+    {
+        std::cout << ii << "," << eventName( aEvents[ii].m_type ) << ","
+                  << aEvents[ii].m_pos.x << "," << aEvents[ii].m_pos.y << ","
+                  << ( aResults[ii].m_ok ? 1 : 0 ) << "," << aResults[ii].m_time.count()
+                  << std::endl;
+    }
+}
+
+
+static void printText( const std::vector<EVENT_ENTRY>& aEvents,
+                       const std::vector<STEP_RESULT>& aResults, bool aVerbose )
+{
+    STEP_DURATION totals[PNS::LOGGER::EVT_FLIP_POSTURE + 1] = {};
+    STEP_DURATION worst[PNS::LOGGER::EVT_FLIP_POSTURE + 1] = {};
+    int           counts[PNS::LOGGER::EVT_FLIP_POSTURE + 1] = {};
+    STEP_DURATION total( 0 );
+
+    for( size_t ii = 0; ii < aEvents.size(); ++ii )
+    {
+        int type = aEvents[ii].m_type;
+
+        totals[type] += aResults[ii].m_time;
+        worst[type] = std::max( worst[type], aResults[ii].m_time );
+        counts[type]++;
+        total += aResults[ii].m_time;
+
+        if( aVerbose )
+        {
+            std::cout << "step " << ii << " " << eventName( aEvents[ii].m_type ) << " ("
+                      << aEvents[ii].m_pos.x << ", " << aEvents[ii].m_pos.y << "): "
+                      << aResults[ii].m_time.count() << "us"
+                      << ( aResults[ii].m_ok ? "" : ", failed" ) << std::endl;
+        }
+    }
+
+    for( int type = 0; type <= PNS::LOGGER::EVT_FLIP_POSTURE; ++type )
+    {
+        if( !counts[type] )
+            continue;
+
+        std::cout << eventName( static_cast<PNS::LOGGER::EVENT_TYPE>( type ) ) << ": "
+                  << counts[type] << " steps, " << totals[type].count() << "us, worst "
+                  << worst[type].count() << "us" << std::endl;
+    }
+
+    std::cout << "Session: " << total.count() << "us" << std::endl;
+}
+
+
+/**
+ * Replays a routing session recorded by PNS::ROUTER on the board it was started on, several
+ * times, and prints the best time of each step.  The router runs without a view, and the
+ * routed items are not committed to the board.
+ *
+ * The event log of the last session is written by ROUTER::DumpLog() beside the shove log.
+ * The router settings the session was started with are read from the log; the others are
+ * the defaults.
+ */
+int router_replay_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program replays and times a routing session on a PCB." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    const bool verbose = cl_parser.Found( "verbose" );
+    const bool csv = cl_parser.Found( "csv" );
+    long       iterations = 5;
+
+    cl_parser.Found( "iterations", &iterations );
+    iterations = std::max( 1L, iterations );
+
+    std::unique_ptr<BOARD> board =
+            KI_TEST::ReadBoardFromFileOrStream( cl_parser.GetParam( 0 ).ToStdString() );
+
+    if( !board )
+        return ROUTER_REPLAY_RET_CODES::LOAD_FAILED;
+
+    std::ifstream            logStream( cl_parser.GetParam( 1 ).ToStdString() );
+    std::vector<int>         config;
+    std::vector<EVENT_ENTRY> events;
+
+    if( !logStream || !PNS::LOGGER::ParseEvents( logStream, config, events ) || events.empty() )
+    {
+        std::cerr << "Could not read the router events of "
+                  << cl_parser.GetParam( 1 ).ToStdString() << std::endl;
+        return ROUTER_REPLAY_RET_CODES::EVENT_LOG_FAILED;
+    }
+
+    REPLAY_IFACE iface;
+    PNS::ROUTER  router;
+
+    iface.SetBoard( board.get() );
+    router.SetInterface( &iface );
+
+    std::vector<STEP_RESULT> results( events.size() );
+    STEP_DURATION            syncTime = STEP_DURATION::max();
+    int                      missingItems = 0;
+
+    for( long ii = 0; ii < iterations; ++ii )
+        missingItems = replay( router, board.get(), config, events, results, syncTime );
+
+    if( missingItems )
+    {
+        std::cerr << missingItems << " recorded items were not found on the board"
+                  << std::endl;
+    }
+
+    if( csv )
+    {
+        printCsv( events, results );
+    }
+    else
+    {
+        std::cout << "World sync: " << syncTime.count() << "us" << std::endl;
+        printText( events, results, verbose );
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+/*
+ * Define the tool interface
+ */
+KI_TEST::UTILITY_PROGRAM router_replay_tool = {
+    "router_replay",
+    "Replay and time a recorded routing session on a PCB",
+    router_replay_main_func,
+};
@@ -0,0 +1,290 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "zone_fill_tool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <common.h>
+#include <profile.h>
+
+#include <wx/cmdline.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <class_board.h>
+#include <class_zone.h>
+#include <zone_filler.h>
+
+
+using FILL_DURATION = std::chrono::microseconds;
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    {
+            wxCMD_LINE_SWITCH,
+            "h",
+            "help",
+            _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE,
+            wxCMD_LINE_OPTION_HELP,
+    },
+    {
+            wxCMD_LINE_SWITCH,
+            "v",
+            "verbose",
+            _( "print parsing information" ).mb_str(),
+    },
+    {
+            wxCMD_LINE_SWITCH,
+            "c",
+            "csv",
+            _( "print the phase timings and vertex counts of each zone as CSV" ).mb_str(),
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "n",
+            "iterations",
+            _( "number of fills of each zone (default 5)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER,
+    },
+    {
+            wxCMD_LINE_PARAM,
+            nullptr,
+            nullptr,
+            _( "input file" ).mb_str(),
+            wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_OPTIONAL,
+    },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum ZONE_FILL_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+/**
+ * The best of several fills of a set of zones
+ */
+struct FILL_RESULT
+{
+    FILL_DURATION                m_total = FILL_DURATION::max();
+    std::vector<ZONE_FILL_STATS> m_stats;
+};
+
+
+static long toMicroseconds( ZONE_FILL_STATS::DURATION aDuration )
+{
+    return std::chrono::duration_cast<FILL_DURATION>( aDuration ).count();
+}
+
+
+/**
+ * The CSV output has one row per zone, then the sum of the zone fills and the whole board
+ * fill, whose columns are empty except the total time.
+ */
+static void printCsvHeader()
+{
+    std::cout << "zone,net,layer,total_us,knockouts_us,booleans_us,spokes_us,fracture_us,"
+                 "triangulation_us,outline_vertices,knockout_vertices,filled_vertices"
+              << std::endl;
+}
+
+
+static void printCsvRow( int aIndex, const FILL_RESULT& aResult )
+{
+    const ZONE_FILL_STATS& stats = aResult.m_stats.front();
+    const ZONE_CONTAINER*  zone = stats.m_zone;
+
+    std::cout << aIndex << ",\"" << zone->GetNetname().ToStdString() << "\","
+              << zone->GetLayerName().ToStdString() << "," << aResult.m_total.count() << ","
+              << toMicroseconds( stats.m_knockouts ) << ","
+              << toMicroseconds( stats.m_booleans ) << ","
+              << toMicroseconds( stats.m_spokes ) << ","
+              << toMicroseconds( stats.m_fracture ) << ","
+              << toMicroseconds( stats.m_triangulation ) << ","
+              << stats.m_outlineVertices << "," << stats.m_knockoutVertices << ","
+              << stats.m_filledVertices << std::endl;
+}
+
+
+static void printTextRow( int aIndex, const FILL_RESULT& aResult, bool aVerbose )
+{
+    const ZONE_FILL_STATS& stats = aResult.m_stats.front();
+    const ZONE_CONTAINER*  zone = stats.m_zone;
+
+    std::cout << "zone " << aIndex << " net " << zone->GetNetname().ToStdString()
+              << " layer " << zone->GetLayerName().ToStdString()
+              << ": " << aResult.m_total.count() << "us, "
+              << stats.m_filledVertices << " vertices" << std::endl;
+
+    if( !aVerbose )
+        return;
+
+    std::cout << "    knockouts " << toMicroseconds( stats.m_knockouts ) << "us"
+              << ", booleans " << toMicroseconds( stats.m_booleans ) << "us"
+              << ", spokes " << toMicroseconds( stats.m_spokes ) << "us"
+              << ", fracture " << toMicroseconds( stats.m_fracture ) << "us"
+              << ", triangulation " << toMicroseconds( stats.m_triangulation ) << "us"
+              << std::endl;
+
+    std::cout << "    vertices in: " << stats.m_outlineVertices << " outline, "
+              << stats.m_knockoutVertices << " knockouts; out: " << stats.m_filledVertices
+              << std::endl;
+}
+
+
+/**
+ * Fills each zone of the board alone, then the whole board, several times, and prints the
+ * best time of each.  The vertex count of the fills is printed too: a change in the filler
+ * code which should not change the fills can be checked with it.
+ *
+ * The time of each fill phase is collected by the zone filler, and printed with the
+ * verbose switch.  The CSV output has all of them, so it can be compared between versions.
+ */
+int zone_fill_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program times the zone fills of a PCB file." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    const bool verbose = cl_parser.Found( "verbose" );
+    const bool csv = cl_parser.Found( "csv" );
+    long       iterations = 5;
+
+    cl_parser.Found( "iterations", &iterations );
+    iterations = std::max( 1L, iterations );
+
+    std::string filename;
+
+    if( cl_parser.GetParamCount() )
+        filename = cl_parser.GetParam( 0 ).ToStdString();
+
+    std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream( filename );
+
+    if( !board )
+        return ZONE_FILL_RET_CODES::LOAD_FAILED;
+
+    // The islands removal needs the connectivity
+    board->BuildConnectivity();
+
+    if( verbose )
+        std::cerr << "Filling " << board->Zones().size() << " zones " << iterations
+                  << " times" << std::endl;
+
+    auto bestFill = [&]( const std::vector<ZONE_CONTAINER*>& aZones ) -> FILL_RESULT
+    {
+        FILL_RESULT best;
+
+        for( long ii = 0; ii < iterations; ++ii )
+        {
+            FILL_RESULT result;
+            ZONE_FILLER filler( board.get() );
+
+            filler.SetFillStats( &result.m_stats );
+
+            {
+                SCOPED_PROF_COUNTER<FILL_DURATION> timer( result.m_total );
+                filler.Fill( aZones );
+            }
+
+            if( result.m_total < best.m_total )
+                best = std::move( result );
+        }
+
+        return best;
+    };
+
+    if( csv )
+        printCsvHeader();
+
+    FILL_DURATION zonesTotal( 0 );
+
+    for( size_t ii = 0; ii < board->Zones().size(); ++ii )
+    {
+        ZONE_CONTAINER* zone = board->Zones()[ii];
+
+        if( zone->GetIsKeepout() )
+            continue;
+
+        FILL_RESULT result = bestFill( { zone } );
+        zonesTotal += result.m_total;
+
+        if( result.m_stats.empty() )
+            continue;
+
+        if( csv )
+            printCsvRow( ii, result );
+        else
+            printTextRow( ii, result, verbose );
+    }
+
+    std::vector<ZONE_CONTAINER*> allZones;
+
+    for( ZONE_CONTAINER* zone : board->Zones() )
+    {
+        if( !zone->GetIsKeepout() )
+            allZones.push_back( zone );
+    }
+
+    FILL_DURATION boardTotal = bestFill( allZones ).m_total;
+
+    if( csv )
+    {
+        std::cout << "sum,,," << zonesTotal.count() << ",,,,,,,," << std::endl;
+        std::cout << "board,,," << boardTotal.count() << ",,,,,,,," << std::endl;
+    }
+    else
+    {
+        std::cout << "Sum of the zone fills: " << zonesTotal.count() << "us" << std::endl;
+        std::cout << "Board fill: " << boardTotal.count() << "us" << std::endl;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+/*
+ * Define the tool interface
+ */
+KI_TEST::UTILITY_PROGRAM zone_fill_tool = {
+    "zone_fill",
+    "Time the zone fills of a PCB",
+    zone_fill_main_func,
+};
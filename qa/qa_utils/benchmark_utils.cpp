@@ -0,0 +1,106 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/benchmark_utils.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#if !defined( _WIN32 )
+#include <sys/resource.h>
+#endif
+
+
+long KI_TEST::GetPeakMemoryKb()
+{
+#if defined( _WIN32 )
+    return -1;
+#else
+    struct rusage usage;
+
+    if( getrusage( RUSAGE_SELF, &usage ) != 0 )
+        return -1;
+
+#if defined( __APPLE__ )
+    return usage.ru_maxrss / 1024;     // bytes on macOS
+#else
+    return usage.ru_maxrss;            // kilobytes elsewhere
+#endif
+#endif
+}
+
+
+std::string KI_TEST::JsonEscape( const std::string& aStr )
+{
+    std::string escaped;
+
+    for( char c : aStr )
+    {
+        switch( c )
+        {
+        case '"':  escaped += "\\\""; break;
+        case '\\': escaped += "\\\\"; break;
+        case '\n': escaped += "\\n"; break;
+        case '\t': escaped += "\\t"; break;
+        default:
+            // The other control characters are not allowed in a JSON string
+            if( static_cast<unsigned char>( c ) < 0x20 )
+            {
+                char buf[8];
+                std::snprintf( buf, sizeof( buf ), "\\u%04x", c );
+                escaped += buf;
+            }
+            else
+            {
+                escaped += c;
+            }
+        }
+    }
+
+    return escaped;
+}
+
+
+KI_TEST::LATENCY_PERCENTILES KI_TEST::GetPercentiles( std::vector<double> aSamples )
+{
+    LATENCY_PERCENTILES result = { 0.0, 0.0, 0.0, 0.0 };
+
+    if( aSamples.empty() )
+        return result;
+
+    std::sort( aSamples.begin(), aSamples.end() );
+
+    auto rank = [&]( double aPercent ) -> double
+    {
+        size_t n = (size_t) std::ceil( aPercent / 100.0 * aSamples.size() );
+        return aSamples[ std::max<size_t>( n, 1 ) - 1 ];
+    };
+
+    result.p50 = rank( 50 );
+    result.p90 = rank( 90 );
+    result.p99 = rank( 99 );
+    result.max = aSamples.back();
+
+    return result;
+}
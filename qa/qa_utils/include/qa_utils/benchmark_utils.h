@@ -0,0 +1,66 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file benchmark_utils.h
+ * @brief Helpers shared by the benchmark tools printing JSON reports.
+ */
+
+#ifndef QA_UTILS_BENCHMARK_UTILS_H
+#define QA_UTILS_BENCHMARK_UTILS_H
+
+#include <string>
+#include <vector>
+
+namespace KI_TEST
+{
+
+/**
+ * @return the peak resident memory of the process in kilobytes, or -1 where it is not known.
+ */
+long GetPeakMemoryKb();
+
+/**
+ * Escape a string to be written as a JSON string value
+ */
+std::string JsonEscape( const std::string& aStr );
+
+/**
+ * Percentiles of a set of latencies, in milliseconds
+ */
+struct LATENCY_PERCENTILES
+{
+    double p50;
+    double p90;
+    double p99;
+    double max;
+};
+
+/**
+ * Compute the percentiles of aSamples (nearest rank).  All are zero if aSamples is empty.
+ */
+LATENCY_PERCENTILES GetPercentiles( std::vector<double> aSamples );
+
+} // namespace KI_TEST
+
+#endif // QA_UTILS_BENCHMARK_UTILS_H
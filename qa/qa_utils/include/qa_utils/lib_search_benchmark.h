@@ -0,0 +1,68 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file lib_search_benchmark.h
+ * @brief Timing of the library chooser searches, for the library load benchmarks.
+ */
+
+#ifndef QA_UTILS_LIB_SEARCH_BENCHMARK_H
+#define QA_UTILS_LIB_SEARCH_BENCHMARK_H
+
+#include <ostream>
+#include <vector>
+
+#include <wx/string.h>
+
+class LIB_TREE_NODE_ROOT;
+
+namespace KI_TEST
+{
+
+/**
+ * @return the searches run when none are given: names, values, packages, keywords, and
+ * wildcard and multiple term searches, as typed in the choosers
+ */
+std::vector<wxString> GetDefaultLibSearches();
+
+/**
+ * Read the searches of a file, one per line.  The empty lines are skipped.
+ *
+ * @return false if the file cannot be read
+ */
+bool ReadLibSearches( const wxString& aFileName, std::vector<wxString>& aSearches );
+
+/**
+ * Run each of aSearches aReps times on aTree, as the library choosers do, and print the
+ * result as the members of a JSON object: the time to build the search index, and the
+ * latency percentiles of each search and of all of them.
+ *
+ * @param aIndent is the indentation of the members
+ */
+void PrintLibSearchBenchmark( std::ostream& aStream, LIB_TREE_NODE_ROOT& aTree,
+                              const std::vector<wxString>& aSearches, int aReps,
+                              const std::string& aIndent );
+
+} // namespace KI_TEST
+
+#endif // QA_UTILS_LIB_SEARCH_BENCHMARK_H
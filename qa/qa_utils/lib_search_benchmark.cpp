@@ -0,0 +1,126 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/lib_search_benchmark.h>
+#include <qa_utils/benchmark_utils.h>
+
+#include <lib_tree_model.h>
+#include <lib_tree_search_index.h>
+
+#include <wx/textfile.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+
+using CLOCK = std::chrono::steady_clock;
+
+
+std::vector<wxString> KI_TEST::GetDefaultLibSearches()
+{
+    return {
+        "r", "res", "resistor", "0603", "c_0805", "sot-23", "soic-8", "qfn", "usb",
+        "conn 2x05", "pin header 2.54", "led 5mm", "op amp", "stm32*", "*1117*",
+    };
+}
+
+
+bool KI_TEST::ReadLibSearches( const wxString& aFileName, std::vector<wxString>& aSearches )
+{
+    wxTextFile file( aFileName );
+
+    if( !file.Open() )
+        return false;
+
+    for( wxString line = file.GetFirstLine(); !file.Eof(); line = file.GetNextLine() )
+    {
+        line.Trim( true ).Trim( false );
+
+        if( !line.IsEmpty() )
+            aSearches.push_back( line );
+    }
+
+    return true;
+}
+
+
+static void printPercentiles( std::ostream& aStream, const std::vector<double>& aSamples )
+{
+    KI_TEST::LATENCY_PERCENTILES pc = KI_TEST::GetPercentiles( aSamples );
+
+    aStream << "\"p50_ms\": " << pc.p50 << ", "
+            << "\"p90_ms\": " << pc.p90 << ", "
+            << "\"p99_ms\": " << pc.p99 << ", "
+            << "\"max_ms\": " << pc.max;
+}
+
+
+void KI_TEST::PrintLibSearchBenchmark( std::ostream& aStream, LIB_TREE_NODE_ROOT& aTree,
+                                       const std::vector<wxString>& aSearches, int aReps,
+                                       const std::string& aIndent )
+{
+    LIB_TREE_SEARCH_INDEX index;
+    std::atomic<bool>     cancelled( false );
+    std::vector<int>      scores;
+    std::vector<double>   all;
+
+    // The choosers build the index at the first search
+    auto start = CLOCK::now();
+    index.Build( aTree );
+    std::chrono::duration<double, std::milli> buildTime = CLOCK::now() - start;
+
+    aStream << aIndent << "\"index_build_ms\": " << buildTime.count() << "," << std::endl;
+    aStream << aIndent << "\"searches\": [" << std::endl;
+
+    for( size_t ii = 0; ii < aSearches.size(); ++ii )
+    {
+        std::vector<double> samples;
+        int                 matches = 0;
+
+        for( int rep = 0; rep < aReps; ++rep )
+        {
+            start = CLOCK::now();
+            index.Score( aSearches[ii], scores, cancelled );
+            std::chrono::duration<double, std::milli> dur = CLOCK::now() - start;
+
+            samples.push_back( dur.count() );
+            matches = std::count_if( scores.begin(), scores.end(),
+                                     []( int aScore ) { return aScore > 0; } );
+        }
+
+        all.insert( all.end(), samples.begin(), samples.end() );
+
+        aStream << aIndent << "  { \"search\": \""
+                << JsonEscape( std::string( aSearches[ii].ToUTF8() ) ) << "\", "
+                << "\"matches\": " << matches << ", ";
+        printPercentiles( aStream, samples );
+        aStream << " }" << ( ii + 1 < aSearches.size() ? "," : "" ) << std::endl;
+    }
+
+    aStream << aIndent << "]," << std::endl;
+    aStream << aIndent << "\"all_searches\": { ";
+    printPercentiles( aStream, all );
+    aStream << " }," << std::endl;
+    aStream << aIndent << "\"peak_memory_kb\": " << GetPeakMemoryKb() << std::endl;
+}
@@ -39,6 +39,31 @@ class TestBoardClass(unittest.TestCase):
         pcb.Add(track1)
         self.assertEqual(pcb.Tracks().size(),2)
 
+    def test_pcb_track_arrays(self):
+        tracks = list(self.pcb.GetTracks())
+        arrays = self.pcb.GetTrackArrays()
+
+        self.assertEqual(len(arrays['width']), len(tracks))
+
+        for i, track in enumerate(tracks):
+            self.assertEqual(arrays['start_x'][i], track.GetStart().x)
+            self.assertEqual(arrays['end_y'][i], track.GetEnd().y)
+            self.assertEqual(arrays['width'][i], track.GetWidth())
+            self.assertEqual(arrays['net'][i], track.GetNetCode())
+
+    def test_pcb_pad_arrays(self):
+        pads = [pad for module in self.pcb.GetModules() for pad in module.Pads()]
+        arrays = self.pcb.GetPadArrays()
+
+        self.assertEqual(len(arrays['x']), len(pads))
+
+        for i, pad in enumerate(pads):
+            self.assertEqual(arrays['x'][i], pad.GetPosition().x)
+            self.assertEqual(arrays['size_y'][i], pad.GetSize().y)
+            self.assertEqual(arrays['net'][i], pad.GetNetCode())
+
+        self.assertEqual(len(self.pcb.GetModuleArrays()['x']), len(list(self.pcb.GetModules())))
+
     def test_pcb_bounding_box(self):
         pcb = BOARD()
         track = TRACK(pcb)
@@ -748,6 +748,33 @@ bool VRML_LAYER::AddArc( double aCenterX, double aCenterY, double aStartX, doubl
 }
 
 
+// appends copies of the contours of another layer; returns true if all was fine,
+// false otherwise (this layer was already tesselated)
+bool VRML_LAYER::AppendContours( const VRML_LAYER& aSource )
+{
+    if( fix )
+    {
+        error = "AppendContours(): no more vertices may be added (layer already tesselated)";
+        return false;
+    }
+
+    for( unsigned int i = 0; i < aSource.contours.size(); ++i )
+    {
+        int contour = NewContour( aSource.pth[i] );
+
+        for( int index : *aSource.contours[i] )
+        {
+            const VERTEX_3D* vp = aSource.vertices[index];
+
+            if( !AddVertex( contour, vp->x, vp->y ) )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+
 // tesselates the contours in preparation for a 3D output;
 // returns true if all was fine, false otherwise
 bool VRML_LAYER::Tesselate( VRML_LAYER* holes, bool aHolesOnly )
@@ -324,6 +324,17 @@ public:
     bool AddPolygon( const std::vector< wxRealPoint >& aPolySet,
                                  double aCenterX, double aCenterY, double aAngle );
 
+    /**
+     * Function AppendContours
+     * adds copies of all the contours of another layer, so that layers sharing the same
+     * holes may be tesselated concurrently, each one with its own copy of the holes
+     *
+     * @param aSource is the layer to copy the contours from
+     *
+     * @return bool: true if the contours were added
+     */
+    bool AppendContours( const VRML_LAYER& aSource );
+
     /**
      * Function Tesselate
      * creates a list of outline vertices as well as the
@@ -504,6 +504,14 @@ bool KICADPCB::ComposePCB( bool aComposeVirtual )
         m_pcb->AddOutlineSegment( &lcurve );
     }
 
+    // read the models first, so they are read in parallel and once for all their instances
+    std::vector< std::string > modelFiles;
+
+    for( auto i : m_modules )
+        i->GetModelFileNames( &m_resolver, modelFiles, aComposeVirtual );
+
+    m_pcb->LoadModels( modelFiles );
+
     for( auto i : m_modules )
         i->ComposePCB( m_pcb, &m_resolver, origin, aComposeVirtual );
 
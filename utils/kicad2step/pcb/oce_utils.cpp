@@ -22,9 +22,12 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
 #include <wx/filename.h>
 #include <wx/log.h>
@@ -40,6 +43,7 @@
 #include <IGESData_IGESModel.hxx>
 #include <Interface_Static.hxx>
 #include <Quantity_Color.hxx>
+#include <STEPCAFControl_Controller.hxx>
 #include <STEPCAFControl_Reader.hxx>
 #include <STEPCAFControl_Writer.hxx>
 #include <APIHeaderSection_MakeHeader.hxx>
@@ -67,6 +71,7 @@
 #include <TopoDS_Face.hxx>
 #include <TopoDS_Compound.hxx>
 #include <TopoDS_Builder.hxx>
+#include <TopTools_ListOfShape.hxx>
 
 #include <Standard_Failure.hxx>
 
@@ -86,6 +91,49 @@ static constexpr double BOARD_OFFSET = 0.05;
 // min. length**2 below which 2 points are considered coincident
 static constexpr double MIN_LENGTH2 = MIN_DISTANCE * MIN_DISTANCE;
 
+
+// the files looked for in place of a VRML model, in order of preference
+static std::vector<std::string> getAlternateModels( const std::string& aFileName )
+{
+    wxFileName wrlName( aFileName );
+
+    wxString basePath = wrlName.GetPath();
+    wxString baseName = wrlName.GetName();
+
+    // List of alternate files to look for
+    // Given in order of preference
+    wxArrayString alts;
+
+    // Step files
+    alts.Add( "stp" );
+    alts.Add( "step" );
+    alts.Add( "STP" );
+    alts.Add( "STEP" );
+    alts.Add( "Stp" );
+    alts.Add( "Step" );
+
+    // IGES files
+    alts.Add( "iges" );
+    alts.Add( "IGES" );
+    alts.Add( "igs" );
+    alts.Add( "IGS" );
+
+    //TODO - Other alternative formats?
+
+    std::vector<std::string> files;
+
+    for( auto alt : alts )
+    {
+        wxFileName altFile( basePath, baseName + "." + alt );
+
+        if( altFile.IsOk() && altFile.FileExists() )
+            files.push_back( altFile.GetFullPath().ToStdString() );
+    }
+
+    return files;
+}
+
+
 static void getEndPoints( const KICADCURVE& aCurve, double& spx0, double& spy0,
     double& epx0, double& epy0 )
 {
@@ -804,9 +852,50 @@ bool PCBMODEL::CreatePCB()
         }
     }
 
-    // subtract cutouts (if any)
-    for( auto i : m_cutouts )
-        board = BRepAlgoAPI_Cut( board, i );
+    // subtract cutouts (if any) in a single boolean operation: the holes are gathered in
+    // a compound tool, instead of cutting the board again for each one of them
+    if( !m_cutouts.empty() )
+    {
+        TopoDS_Compound holes;
+        TopoDS_Builder  builder;
+        builder.MakeCompound( holes );
+
+        for( const auto& i : m_cutouts )
+            builder.Add( holes, i );
+
+#if ( defined OCC_VERSION_HEX ) && ( OCC_VERSION_HEX >= 0x070200 )
+        TopTools_ListOfShape arguments;
+        TopTools_ListOfShape tools;
+        arguments.Append( board );
+        tools.Append( holes );
+
+        BRepAlgoAPI_Cut cut;
+        cut.SetArguments( arguments );
+        cut.SetTools( tools );
+        cut.SetRunParallel( Standard_True );
+        cut.Build();
+#else
+        BRepAlgoAPI_Cut cut( board, holes );
+#endif
+
+        if( cut.IsDone() && !cut.Shape().IsNull() )
+        {
+            board = cut.Shape();
+        }
+        else
+        {
+            std::ostringstream ostr;
+#ifdef __WXDEBUG__
+            ostr << __FILE__ << ": " << __FUNCTION__ << ": " << __LINE__ << "\n";
+#endif /* __WXDEBUG */
+            ostr << "  * could not subtract the " << m_cutouts.size()
+                 << " cutouts together; subtracting them one by one\n";
+            wxLogMessage( "%s", ostr.str().c_str() );
+
+            for( const auto& i : m_cutouts )
+                board = BRepAlgoAPI_Cut( board, i );
+        }
+    }
 
     // push the board to the data structure
     m_pcb_label = m_assy->AddComponent( m_assy_label, board );
@@ -908,6 +997,116 @@ bool PCBMODEL::WriteSTEP( const std::string& aFileName )
 }
 
 
+void PCBMODEL::LoadModels( const std::vector<std::string>& aFileNames )
+{
+    struct MODEL_READ
+    {
+        std::string                m_fileName;
+        FormatType                 m_format;
+        Handle( TDocStd_Document ) m_doc;
+        bool                       m_ok;
+    };
+
+    std::vector<MODEL_READ> reads;
+    std::set<std::string>   names;
+
+    for( const std::string& name : aFileNames )
+    {
+        std::string file = name;
+        FormatType  format = fileType( name.c_str() );
+
+        // a VRML model is replaced by the first alternate file (see getModelLabel())
+        if( format == FMT_WRL )
+        {
+            std::vector<std::string> alts = getAlternateModels( name );
+
+            if( alts.empty() )
+                continue;
+
+            file = alts.front();
+            format = fileType( file.c_str() );
+        }
+
+        if( format != FMT_IGES && format != FMT_STEP )
+            continue;
+
+        if( m_models.count( file ) || m_badModels.count( file ) || !names.insert( file ).second )
+            continue;
+
+        reads.push_back( { file, format, Handle( TDocStd_Document )(), false } );
+    }
+
+    // a single model is read by getModelLabel() as well as here
+    if( reads.size() < 2 )
+        return;
+
+    // The translators and their parameters are global: they are set up before the threads
+    // start, so the readers only read them
+    IGESControl_Controller::Init();
+    STEPCAFControl_Controller::Init();
+    Interface_Static::SetIVal( "read.precision.mode", 1 );
+    Interface_Static::SetRVal( "read.precision.val", USER_PREC );
+
+    for( MODEL_READ& read : reads )
+        m_app->NewDocument( "MDTV-XCAF", read.m_doc );
+
+    std::atomic<size_t> nextRead( 0 );
+
+    auto readModels = [&]()
+    {
+        for( size_t i = nextRead++; i < reads.size(); i = nextRead++ )
+        {
+            MODEL_READ& read = reads[i];
+
+            try
+            {
+                if( read.m_format == FMT_IGES )
+                    read.m_ok = readIGES( read.m_doc, read.m_fileName.c_str() );
+                else
+                    read.m_ok = readSTEP( read.m_doc, read.m_fileName.c_str() );
+            }
+            catch( const Standard_Failure& )
+            {
+                read.m_ok = false;
+            }
+        }
+    };
+
+    size_t threadCount = std::min<size_t>( std::max( std::thread::hardware_concurrency(), 1u ),
+                                           reads.size() );
+    std::vector<std::thread> threads;
+
+    for( size_t i = 1; i < threadCount; ++i )
+        threads.emplace_back( readModels );
+
+    readModels();
+
+    for( std::thread& thread : threads )
+        thread.join();
+
+    // the models are moved to the assembly in order, as its labels are not thread safe
+    for( MODEL_READ& read : reads )
+    {
+        TDF_Label label;
+
+        if( !read.m_ok )
+        {
+            std::ostringstream ostr;
+#ifdef __WXDEBUG__
+            ostr << __FILE__ << ": " << __FUNCTION__ << ": " << __LINE__ << "\n";
+#endif /* __WXDEBUG */
+            ostr << "  * " << ( read.m_format == FMT_IGES ? "readIGES()" : "readSTEP()" )
+                 << " failed on filename '" << read.m_fileName << "'\n";
+            wxLogMessage( "%s", ostr.str().c_str() );
+            m_badModels.insert( read.m_fileName );
+            continue;
+        }
+
+        addModel( read.m_fileName, read.m_doc, label );
+    }
+}
+
+
 bool PCBMODEL::getModelLabel( const std::string aFileName, TDF_Label& aLabel )
 {
     MODEL_MAP::const_iterator mm = m_models.find( aFileName );
@@ -920,6 +1119,10 @@ bool PCBMODEL::getModelLabel( const std::string aFileName, TDF_Label& aLabel )
 
     aLabel.Nullify();
 
+    // the failure was reported for the first instance of the model
+    if( m_badModels.count( aFileName ) )
+        return false;
+
     Handle( TDocStd_Document )  doc;
     m_app->NewDocument( "MDTV-XCAF", doc );
 
@@ -936,6 +1139,7 @@ bool PCBMODEL::getModelLabel( const std::string aFileName, TDF_Label& aLabel )
 #endif /* __WXDEBUG */
                 ostr << "  * readIGES() failed on filename '" << aFileName << "'\n";
                 wxLogMessage( "%s", ostr.str().c_str() );
+                m_badModels.insert( aFileName );
                 return false;
             }
             break;
@@ -949,6 +1153,7 @@ bool PCBMODEL::getModelLabel( const std::string aFileName, TDF_Label& aLabel )
 #endif /* __WXDEBUG */
                 ostr << "  * readSTEP() failed on filename '" << aFileName << "'\n";
                 wxLogMessage( "%s", ostr.str().c_str() );
+                m_badModels.insert( aFileName );
                 return false;
             }
             break;
@@ -965,46 +1170,12 @@ bool PCBMODEL::getModelLabel( const std::string aFileName, TDF_Label& aLabel )
              * for THAT file will be associated with the .wrl file
              *
              */
+            for( const std::string& altFileName : getAlternateModels( aFileName ) )
             {
-                wxFileName wrlName( aFileName );
-
-                wxString basePath = wrlName.GetPath();
-                wxString baseName = wrlName.GetName();
-
-                // List of alternate files to look for
-                // Given in order of preference
-                // (Break if match is found)
-                wxArrayString alts;
-
-                // Step files
-                alts.Add( "stp" );
-                alts.Add( "step" );
-                alts.Add( "STP" );
-                alts.Add( "STEP" );
-                alts.Add( "Stp" );
-                alts.Add( "Step" );
-
-                // IGES files
-                alts.Add( "iges" );
-                alts.Add( "IGES" );
-                alts.Add( "igs" );
-                alts.Add( "IGS" );
-
-                //TODO - Other alternative formats?
-
-                for( auto alt : alts )
+                if( getModelLabel( altFileName, aLabel ) )
                 {
-                    wxFileName altFile( basePath, baseName + "." + alt );
-
-                    if( altFile.IsOk() && altFile.FileExists() )
-                    {
-                        std::string altFileName = altFile.GetFullPath().ToStdString();
-
-                        if( getModelLabel( altFileName, aLabel ) )
-                        {
-                            return true;
-                        }
-                    }
+                    m_models.insert( MODEL_DATUM( aFileName, aLabel ) );
+                    return true;
                 }
             }
 
@@ -1013,10 +1184,18 @@ bool PCBMODEL::getModelLabel( const std::string aFileName, TDF_Label& aLabel )
         // TODO: implement IDF and EMN converters
 
         default:
+            m_badModels.insert( aFileName );
             return false;
     }
 
-    aLabel = transferModel( doc, m_doc );
+    return addModel( aFileName, doc, aLabel );
+}
+
+
+bool PCBMODEL::addModel( const std::string& aFileName, Handle( TDocStd_Document )& aDoc,
+                         TDF_Label& aLabel )
+{
+    aLabel = transferModel( aDoc, m_doc );
 
     if( aLabel.IsNull() )
     {
@@ -1026,6 +1205,7 @@ bool PCBMODEL::getModelLabel( const std::string aFileName, TDF_Label& aLabel )
 #endif /* __WXDEBUG */
         ostr << "  * could not transfer model data from file '" << aFileName << "'\n";
         wxLogMessage( "%s", ostr.str().c_str() );
+        m_badModels.insert( aFileName );
         return false;
     }
 
@@ -1108,11 +1288,14 @@ bool PCBMODEL::readIGES( Handle( TDocStd_Document )& doc, const char* fname )
         return false;
 
     // Enable user-defined shape precision
-    if( !Interface_Static::SetIVal( "read.precision.mode", 1 ) )
+    // (only set when needed: LoadModels() sets it before reading models in parallel)
+    if( Interface_Static::IVal( "read.precision.mode" ) != 1
+            && !Interface_Static::SetIVal( "read.precision.mode", 1 ) )
         return false;
 
     // Set the shape conversion precision to USER_PREC (default 0.0001 has too many triangles)
-    if( !Interface_Static::SetRVal( "read.precision.val", USER_PREC ) )
+    if( Interface_Static::RVal( "read.precision.val" ) != USER_PREC
+            && !Interface_Static::SetRVal( "read.precision.val", USER_PREC ) )
         return false;
 
     // set other translation options
@@ -1146,11 +1329,14 @@ bool PCBMODEL::readSTEP( Handle(TDocStd_Document)& doc, const char* fname )
         return false;
 
     // Enable user-defined shape precision
-    if( !Interface_Static::SetIVal( "read.precision.mode", 1 ) )
+    // (only set when needed: LoadModels() sets it before reading models in parallel)
+    if( Interface_Static::IVal( "read.precision.mode" ) != 1
+            && !Interface_Static::SetIVal( "read.precision.mode", 1 ) )
         return false;
 
     // Set the shape conversion precision to USER_PREC (default 0.0001 has too many triangles)
-    if( !Interface_Static::SetRVal( "read.precision.val", USER_PREC ) )
+    if( Interface_Static::RVal( "read.precision.val" ) != USER_PREC
+            && !Interface_Static::SetRVal( "read.precision.val", USER_PREC ) )
         return false;
 
     // set other translation options
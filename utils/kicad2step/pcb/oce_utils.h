@@ -26,6 +26,7 @@
 
 #include <list>
 #include <map>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -88,6 +89,7 @@ class PCBMODEL
     bool                            m_hasPCB;       // set true if CreatePCB() has been invoked
     TDF_Label                       m_pcb_label;    // label for the PCB model
     MODEL_MAP                       m_models;       // map of file names to model labels
+    std::set< std::string >         m_badModels;    // file names of the models which failed
     int                             m_components;   // number of successfully loaded components;
     double                          m_precision;    // model (length unit) numeric precision
     double                          m_angleprec;    // angle numeric precision
@@ -101,6 +103,10 @@ class PCBMODEL
 
     bool getModelLabel( const std::string aFileName, TDF_Label& aLabel );
 
+    // moves a model read from aFileName to the assembly, as the label for all its instances
+    bool addModel( const std::string& aFileName, Handle( TDocStd_Document )& aDoc,
+        TDF_Label& aLabel );
+
     bool getModelLocation( bool aBottom, DOUBLET aPosition, double aRotation,
         TRIPLET aOffset, TRIPLET aOrientation, TopLoc_Location& aLocation );
 
@@ -120,6 +126,10 @@ public:
     // add a pad hole or slot (must be in final position)
     bool AddPadHole( KICADPAD* aPad );
 
+    // read the models of all the components at once, in parallel, before they are added
+    // (the models already loaded and the ones which cannot be read are skipped)
+    void LoadModels( const std::vector<std::string>& aFileNames );
+
     // add a component at the given position and orientation
     bool AddComponent( const std::string& aFileName, const std::string& aRefDes,
         bool aBottom, DOUBLET aPosition, double aRotation,